@@ -1,5 +1,10 @@
 // minihost.cpp
 #include "minihost.h"
+#include "minihost_rt_audit.h"
+#include "minihost_denormal.h"
+#include "minihost_eventlog.h"
+#include "minihost_metrics.h"
+#include "minihost_threads.h"
 
 #include <juce_core/juce_core.h>
 #include <juce_audio_basics/juce_audio_basics.h>
@@ -23,16 +28,24 @@
  #endif
 #endif
 #include <juce_events/juce_events.h>
+#ifndef _WIN32
+#include <dlfcn.h>     // module residency pins for the per-process cache
+#include <sys/mman.h>  // mlock/munlock (mh_set_lock_memory)
+#endif
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstdlib>
 #include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 using namespace juce;
@@ -83,6 +96,7 @@ public:
             auto fut = ready.get_future();
             thread_ = std::thread([this, &ready]()
             {
+                mh_thread_policy_apply(MH_THREAD_ROLE_MESSAGE);
                 // Create the MessageManager on THIS thread so it becomes the
                 // JUCE message thread. We deliberately do NOT call
                 // initialiseJuce_GUI(): that pulls in GUI/display setup which
@@ -99,7 +113,7 @@ public:
                 // condition variable gives immediate wake-up with no polling.
                 for (;;)
                 {
-                    Task t{ nullptr, nullptr };
+                    std::vector<Task> batch;
                     {
                         std::unique_lock<std::mutex> lk(mtx_);
                         cv_.wait(lk, [this] {
@@ -107,17 +121,25 @@ public:
                         });
                         if (queue_.empty())
                             break;   // woken for shutdown with nothing pending
-                        t = queue_.front();
-                        queue_.pop_front();
-                    }
-                    try
-                    {
-                        (*t.fn)();
-                        t.prom->set_value();
+                        // Drain everything pending under a single lock hold:
+                        // when several threads queue thread-affine work at
+                        // once (e.g. a load pool constructing a project's
+                        // plugins), the whole backlog is handled per wakeup
+                        // instead of paying a lock round trip per task.
+                        batch.assign(queue_.begin(), queue_.end());
+                        queue_.clear();
                     }
-                    catch (...)
+                    for (auto& t : batch)
                     {
-                        t.prom->set_exception(std::current_exception());
+                        try
+                        {
+                            (*t.fn)();
+                            t.prom->set_value();
+                        }
+                        catch (...)
+                        {
+                            t.prom->set_exception(std::current_exception());
+                        }
                     }
                 }
                 // Delete the MessageManager on its own (this) thread before the
@@ -171,6 +193,29 @@ public:
         fut.get();   // blocks; rethrows if the task threw
     }
 
+    // Run several closures on the message thread as ONE submission: a
+    // single queue entry, wakeup, and completion signal, instead of a
+    // mutex + condvar round trip per closure. For control bursts like a
+    // session restore (state blob + program + parameter writes) the
+    // cross-thread cost becomes one hop regardless of closure count.
+    // Closures run in order; a throw from one aborts the rest and
+    // rethrows on the caller, matching run()'s behavior.
+    void runBatch(const std::function<void()>* fns, size_t count)
+    {
+        if (count == 0)
+            return;
+        if (count == 1)
+        {
+            run(fns[0]);
+            return;
+        }
+        run([fns, count]()
+        {
+            for (size_t i = 0; i < count; ++i)
+                fns[i]();
+        });
+    }
+
 private:
     MinihostMessageThread() = default;
 
@@ -189,6 +234,211 @@ private:
     std::thread thread_;
 };
 
+// ---------------------------------------------------------------------------
+// Optional satellite marshalling threads ("worker pumps") for
+// multi-instance scaling. JUCE allows exactly one MessageManager per
+// process, so the thread above is a hard serialization point: two
+// heavyweight setStateInformation calls can never overlap, no matter how
+// many cores the box has. Where the platform tolerates it -- headless
+// Linux especially, where there is no real global event loop and the
+// MessageManager exists only to satisfy JUCE's bookkeeping -- plugins can
+// instead be pinned round-robin to one of N worker pumps at open, and all
+// of their thread-affine control work (construction, destruction, state,
+// programs, parameter info) marshals to the pinned pump. Per-plugin
+// thread identity is fully preserved -- one plugin, one thread, for life
+// -- only the "that thread is THE message thread" property is given up.
+// That is why this is strictly opt-in (mh_message_thread_set_pumps or
+// MINIHOST_MESSAGE_PUMPS) and off by default: a plugin that drives
+// Timers or AsyncUpdaters against the real message thread needs the
+// single-thread default. The main message thread keeps existing and
+// keeps owning the MessageManager either way.
+// ---------------------------------------------------------------------------
+class MinihostWorkerPumps
+{
+public:
+    static MinihostWorkerPumps& instance()
+    {
+        static MinihostWorkerPumps inst;
+        return inst;
+    }
+
+    // Set the pump count (0 disables). Must happen before the first
+    // plugin load in pump mode: existing pins cannot be rehashed, so
+    // this returns false once the pumps have started.
+    bool configure(int count)
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (started_)
+            return false;
+        desired_ = count < 0 ? 0 : (count > 64 ? 64 : count);
+        configured_ = true;
+        return true;
+    }
+
+    // Pumps configured (after start: actually running).
+    int activeCount()
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return started_ ? (int) pumps_.size() : desired_;
+    }
+
+    // Round-robin pin for a newly opened plugin; -1 when disabled.
+    // Starts the pump threads on first use.
+    int assign()
+    {
+        if (! running_.load())
+            return -1;
+        start();
+        if (pumps_.empty())
+            return -1;
+        return (int) (nextPin_.fetch_add(1) % pumps_.size());
+    }
+
+    // Queue fn on pump `index`; the returned future completes (or
+    // rethrows) when it has run. Runs inline when the pumps are gone
+    // (process shutdown) or the index is invalid, so a caller can never
+    // block on a thread that no longer exists.
+    std::future<void> post(int index, std::function<void()> fn)
+    {
+        std::unique_ptr<Task> task(new Task());
+        task->fn = std::move(fn);
+        auto fut = task->prom.get_future();
+
+        if (! running_.load() || index < 0 || (size_t) index >= pumps_.size())
+        {
+            try
+            {
+                task->fn();
+                task->prom.set_value();
+            }
+            catch (...)
+            {
+                task->prom.set_exception(std::current_exception());
+            }
+            return fut;
+        }
+
+        Pump& pump = *pumps_[(size_t) index];
+        {
+            std::lock_guard<std::mutex> lk(pump.mtx);
+            pump.queue.push_back(std::move(task));
+        }
+        pump.cv.notify_one();
+        return fut;
+    }
+
+    // Run fn on pump `index` and block until it finishes (rethrows).
+    void run(int index, const std::function<void()>& fn)
+    {
+        post(index, fn).get();
+    }
+
+    // Stop and join every pump (pending tasks are drained first).
+    // Idempotent; called from mh_message_thread_shutdown.
+    void shutdown()
+    {
+        if (! running_.exchange(false))
+            return;
+        for (auto& pump : pumps_)
+        {
+            {
+                std::lock_guard<std::mutex> lk(pump->mtx);
+            }
+            pump->cv.notify_one();
+            if (pump->thread.joinable())
+                pump->thread.join();
+        }
+    }
+
+private:
+    MinihostWorkerPumps() = default;
+
+    struct Task
+    {
+        std::function<void()> fn;
+        std::promise<void> prom;
+    };
+
+    struct Pump
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<std::unique_ptr<Task>> queue;
+        std::thread thread;
+    };
+
+    void start()
+    {
+        std::call_once(startFlag_, [this]()
+        {
+            int count;
+            {
+                std::lock_guard<std::mutex> lk(mtx_);
+                started_ = true;
+                count = desired_;
+                if (! configured_)
+                {
+                    const char* env = std::getenv("MINIHOST_MESSAGE_PUMPS");
+                    if (env != nullptr)
+                    {
+                        count = std::atoi(env);
+                        count = count < 0 ? 0 : (count > 64 ? 64 : count);
+                    }
+                }
+            }
+            if (count <= 0)
+                return;
+            pumps_.reserve((size_t) count);
+            for (int i = 0; i < count; ++i)
+            {
+                pumps_.emplace_back(new Pump());
+                Pump* pump = pumps_.back().get();
+                pump->thread = std::thread([this, pump]()
+                {
+                    mh_thread_policy_apply(MH_THREAD_ROLE_MESSAGE);
+                    pumpLoop(pump);
+                });
+            }
+        });
+    }
+
+    void pumpLoop(Pump* pump)
+    {
+        for (;;)
+        {
+            std::unique_ptr<Task> task;
+            {
+                std::unique_lock<std::mutex> lk(pump->mtx);
+                pump->cv.wait(lk, [this, pump] {
+                    return ! pump->queue.empty() || ! running_.load();
+                });
+                if (pump->queue.empty())
+                    break;   // woken for shutdown with nothing pending
+                task = std::move(pump->queue.front());
+                pump->queue.pop_front();
+            }
+            try
+            {
+                task->fn();
+                task->prom.set_value();
+            }
+            catch (...)
+            {
+                task->prom.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    std::once_flag startFlag_;
+    std::mutex mtx_;
+    bool configured_ = false;
+    bool started_ = false;
+    int desired_ = 0;
+    std::atomic<bool> running_{true};
+    std::atomic<unsigned long long> nextPin_{0};
+    std::vector<std::unique_ptr<Pump>> pumps_;
+};
+
 } // namespace
 
 extern "C" void mh_message_thread_init(void)
@@ -198,9 +448,22 @@ extern "C" void mh_message_thread_init(void)
 
 extern "C" void mh_message_thread_shutdown(void)
 {
+    // Pumps first: a pump task may still marshal work to the message
+    // thread (plugin teardown), never the other way around.
+    MinihostWorkerPumps::instance().shutdown();
     MinihostMessageThread::instance().shutdown();
 }
 
+extern "C" int mh_message_thread_set_pumps(int count)
+{
+    return MinihostWorkerPumps::instance().configure(count) ? 1 : 0;
+}
+
+extern "C" int mh_message_thread_get_pumps(void)
+{
+    return MinihostWorkerPumps::instance().activeCount();
+}
+
 // Run a callable on the JUCE plugin thread and return its result (or void).
 // Wrap the body of any thread-affine control function in this. When the plugin
 // thread is disabled, it runs inline. NOT for the process*() hot path.
@@ -235,40 +498,39 @@ extern "C" const char* mh_api_version_string(void)
     return MH_API_VERSION_STRING;
 }
 
-class MH_PlayHead : public AudioPlayHead
+// Transport state snapshot -- copied atomically via seqlock
+struct MH_TransportState
 {
-public:
-    // Transport state snapshot -- copied atomically via seqlock
-    struct State
-    {
-        bool hasTransport = false;
-        double bpm = 120.0;
-        int timeSigNum = 4;
-        int timeSigDenom = 4;
-        int64_t positionSamples = 0;
-        double positionBeats = 0.0;
-        bool isPlaying = false;
-        bool isRecording = false;
-        bool isLooping = false;
-        int64_t loopStartSamples = 0;
-        int64_t loopEndSamples = 0;
-    };
-
-    double sampleRate = 44100.0;
+    bool hasTransport = false;
+    double bpm = 120.0;
+    int timeSigNum = 4;
+    int timeSigDenom = 4;
+    int64_t positionSamples = 0;
+    double positionBeats = 0.0;
+    bool isPlaying = false;
+    bool isRecording = false;
+    bool isLooping = false;
+    int64_t loopStartSamples = 0;
+    int64_t loopEndSamples = 0;
+};
 
-    // Seqlock: writer increments seq_ before and after updating state_.
-    // Reader retries if seq_ changed during read (ensures torn-read safety
-    // without blocking the audio thread).
-    void write(const State& s)
+// Seqlock cell holding one MH_TransportState. The writer increments
+// seq_ before and after updating state_; readers retry if seq_ changed
+// during the read (torn-read safety without blocking the audio thread).
+// Single writer at a time.
+class MH_TransportCell
+{
+public:
+    void write(const MH_TransportState& s)
     {
         seq_.fetch_add(1, std::memory_order_release);    // odd  = write in progress
         state_ = s;
         seq_.fetch_add(1, std::memory_order_release);    // even = write complete
     }
 
-    State read() const
+    MH_TransportState read() const
     {
-        State s;
+        MH_TransportState s;
         unsigned seq0, seq1;
         do {
             seq0 = seq_.load(std::memory_order_acquire);
@@ -278,6 +540,40 @@ public:
         return s;
     }
 
+private:
+    MH_TransportState state_;
+    std::atomic<unsigned> seq_{0};
+};
+
+// Shared transport cell (mh_shared_transport_*): one seqlock write fans
+// out to every playhead attached via mh_set_transport_shared.
+struct MH_SharedTransport
+{
+    MH_TransportCell cell;
+};
+
+class MH_PlayHead : public AudioPlayHead
+{
+public:
+    using State = MH_TransportState;
+
+    double sampleRate = 44100.0;
+
+    void write(const State& s) { cell_.write(s); }
+
+    // While attached to a shared cell, the plugin's own state is
+    // ignored (it stays in cell_ and resumes on detach).
+    State read() const
+    {
+        const MH_SharedTransport* st = shared_.load(std::memory_order_acquire);
+        return st != nullptr ? st->cell.read() : cell_.read();
+    }
+
+    void attachShared(const MH_SharedTransport* st)
+    {
+        shared_.store(st, std::memory_order_release);
+    }
+
     Optional<PositionInfo> getPosition() const override
     {
         State s = read();
@@ -305,15 +601,100 @@ public:
     }
 
 private:
-    State state_;
-    std::atomic<unsigned> seq_{0};
+    MH_TransportCell cell_;
+    std::atomic<const MH_SharedTransport*> shared_{nullptr};
 };
 
 struct MH_Plugin;
 
+// Bounded lock-free queue for parameter-change records
+// (mh_param_record_*). Producers are wherever JUCE notifies from --
+// the message thread for host/GUI writes, the audio thread for changes
+// the plugin makes during processBlock -- so cells carry a sequence
+// number in the Vyukov style: a producer claims a cell by CAS on the
+// head only when the sequence says it is free, and a full queue
+// rejects the record cleanly (counted in `dropped`) instead of tearing
+// the oldest entry under the reader. The consumer
+// (mh_param_record_fetch) is single-threaded by contract.
+struct ParamRecorder
+{
+    struct Cell
+    {
+        std::atomic<long long> seq{0};
+        MH_ParamRecord rec{};
+    };
+
+    explicit ParamRecorder(int cap)   // cap must be a power of two
+        : cells(new Cell[(size_t) cap]), capacity(cap), mask(cap - 1),
+          t0(std::chrono::steady_clock::now())
+    {
+        for (int i = 0; i < cap; ++i)
+            cells[(size_t) i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    void push(int paramIndex, float value)
+    {
+        long long pos = head.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;)
+        {
+            cell = &cells[(size_t) (pos & mask)];
+            const long long seq = cell->seq.load(std::memory_order_acquire);
+            const long long dif = seq - pos;
+            if (dif == 0)
+            {
+                if (head.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed))
+                    break;
+            }
+            else if (dif < 0)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;     // full; never block, never tear
+            }
+            else
+            {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        cell->rec.time_sec = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+        cell->rec.param_index = paramIndex;
+        cell->rec.value = value;
+        cell->seq.store(pos + 1, std::memory_order_release);
+    }
+
+    bool pop(MH_ParamRecord& out)
+    {
+        const long long pos = tail.load(std::memory_order_relaxed);
+        Cell& cell = cells[(size_t) (pos & mask)];
+        if (cell.seq.load(std::memory_order_acquire) < pos + 1)
+            return false;   // empty
+        out = cell.rec;
+        cell.seq.store(pos + capacity, std::memory_order_release);
+        tail.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::unique_ptr<Cell[]> cells;
+    const int capacity;
+    const long long mask;
+    const std::chrono::steady_clock::time_point t0;
+    std::atomic<long long> head{0};
+    std::atomic<long long> tail{0};
+    std::atomic<long long> dropped{0};
+};
+
 struct MH_Listener : public AudioProcessorListener
 {
-    MH_Plugin* owner = nullptr;
+    // Atomic because a staged standby swap (mh_standby_swap) re-points
+    // it from the audio thread while callbacks may be in flight on the
+    // message thread.
+    std::atomic<MH_Plugin*> owner{nullptr};
+
+    // Defined after MH_Plugin (which they poke).
+    void markParamCacheDirty();
+    void recordParamValue(int paramIndex, float value);
 
     std::atomic<MH_ChangeCallback> changeCb{nullptr};
     std::atomic<void*> changeUserData{nullptr};
@@ -322,15 +703,83 @@ struct MH_Listener : public AudioProcessorListener
     std::atomic<MH_ParamGestureCallback> paramGestureCb{nullptr};
     std::atomic<void*> paramGestureUserData{nullptr};
 
+    // Coalesced value delivery (mh_set_param_value_coalescing). When the
+    // interval is > 0, parameter changes land in a per-parameter
+    // last-writer-wins slot (one relaxed store + one release store, no
+    // locks -- safe from any thread including the audio thread) instead
+    // of invoking the callback per change; a dedicated flush thread
+    // forwards the surviving value of each dirty parameter at the
+    // configured rate. The slot arrays are sized to the parameter count
+    // at enable time and only (re)allocated by
+    // mh_set_param_value_coalescing while the flush thread is stopped.
+    std::atomic<int> coalesceIntervalMs{0};
+    int coalesceCount = 0;
+    std::unique_ptr<std::atomic<float>[]> coalesceValues;
+    std::unique_ptr<std::atomic<unsigned>[]> coalesceDirty;
+    std::atomic<unsigned> coalesceAnyDirty{0};
+    std::thread coalesceThread;
+    std::atomic<bool> coalesceRunning{false};
+
+    // One flush pass: forward the last-written value of every dirty
+    // parameter. Runs on the flush thread, and once more after the
+    // thread is joined (disable / close) so nothing pending is lost.
+    void flushCoalesced()
+    {
+        if (coalesceAnyDirty.exchange(0, std::memory_order_acquire) == 0)
+            return;
+        auto cb = paramValueCb.load(std::memory_order_acquire);
+        MH_Plugin* const own = owner.load(std::memory_order_relaxed);
+        for (int i = 0; i < coalesceCount; ++i)
+        {
+            if (coalesceDirty[(size_t) i].exchange(0, std::memory_order_acquire) == 0)
+                continue;
+            const float v = coalesceValues[(size_t) i].load(std::memory_order_relaxed);
+            if (cb)
+                cb(own, i, v, paramValueUserData.load(std::memory_order_relaxed));
+        }
+    }
+
+    // Stop and join the flush thread if running (no flush here -- callers
+    // decide whether pending changes should still be delivered).
+    void stopCoalesceThread()
+    {
+        if (coalesceRunning.exchange(false))
+        {
+            coalesceIntervalMs.store(0, std::memory_order_release);
+            coalesceThread.join();
+        }
+    }
+
     void audioProcessorParameterChanged(AudioProcessor*, int paramIndex, float newValue) override
     {
+        // Exact gesture capture (mh_param_record_*): runs before the
+        // coalescing branch so an armed recorder sees every change, not
+        // just the coalesced survivors.
+        recordParamValue(paramIndex, newValue);
+
+        // Coalescing enabled: record and return. Indexes beyond the dirty
+        // set (parameter layout grew after enabling) fall through to the
+        // immediate path rather than being dropped.
+        if (coalesceIntervalMs.load(std::memory_order_acquire) > 0
+            && paramIndex >= 0 && paramIndex < coalesceCount)
+        {
+            coalesceValues[(size_t) paramIndex].store(newValue, std::memory_order_relaxed);
+            coalesceDirty[(size_t) paramIndex].store(1, std::memory_order_release);
+            coalesceAnyDirty.store(1, std::memory_order_release);
+            return;
+        }
+
         auto cb = paramValueCb.load(std::memory_order_acquire);
         if (cb)
-            cb(owner, paramIndex, newValue, paramValueUserData.load(std::memory_order_relaxed));
+            cb(owner.load(std::memory_order_relaxed), paramIndex, newValue,
+               paramValueUserData.load(std::memory_order_relaxed));
     }
 
     void audioProcessorChanged(AudioProcessor*, const ChangeDetails& details) override
     {
+        if (details.parameterInfoChanged)
+            markParamCacheDirty();
+
         auto cb = changeCb.load(std::memory_order_acquire);
         if (!cb) return;
 
@@ -341,21 +790,24 @@ struct MH_Listener : public AudioProcessorListener
         if (details.nonParameterStateChanged)  flags |= MH_CHANGE_NON_PARAM_STATE;
 
         if (flags != 0)
-            cb(owner, flags, changeUserData.load(std::memory_order_relaxed));
+            cb(owner.load(std::memory_order_relaxed), flags,
+               changeUserData.load(std::memory_order_relaxed));
     }
 
     void audioProcessorParameterChangeGestureBegin(AudioProcessor*, int paramIndex) override
     {
         auto cb = paramGestureCb.load(std::memory_order_acquire);
         if (cb)
-            cb(owner, paramIndex, 1, paramGestureUserData.load(std::memory_order_relaxed));
+            cb(owner.load(std::memory_order_relaxed), paramIndex, 1,
+               paramGestureUserData.load(std::memory_order_relaxed));
     }
 
     void audioProcessorParameterChangeGestureEnd(AudioProcessor*, int paramIndex) override
     {
         auto cb = paramGestureCb.load(std::memory_order_acquire);
         if (cb)
-            cb(owner, paramIndex, 0, paramGestureUserData.load(std::memory_order_relaxed));
+            cb(owner.load(std::memory_order_relaxed), paramIndex, 0,
+               paramGestureUserData.load(std::memory_order_relaxed));
     }
 };
 
@@ -378,6 +830,12 @@ struct MH_Plugin
     int sidechainCh = 0;  // sidechain input channels (0 if none)
     std::string path;     // plugin file path passed to mh_open / mh_open_ex
 
+    // Worker pump this plugin is pinned to when multi-pump mode is active
+    // (mh_message_thread_set_pumps); -1 = the shared message thread.
+    // Set once at open and never changed: a plugin's thread-affine work
+    // must always land on the same thread for its whole lifetime.
+    int pump = -1;
+
     // Single processing buffer sized to max(inCh + sidechainCh, outCh) channels.
     // JUCE's processBlock contract requires the buffer to have enough channels
     // for both inputs and outputs; sizing to the max handles asymmetric layouts
@@ -392,21 +850,292 @@ struct MH_Plugin
     // Use this for param/state access from UI or control threads
     std::mutex stateMutex;
 
+    // Static parameter metadata captured once after instantiation and
+    // served from here by mh_get_param_info / mh_get_all_param_info --
+    // the JUCE String conversions for name/id/label are expensive enough
+    // to dominate a 3000-parameter listing when done per call. Only
+    // current_value_str is dynamic and re-queried. paramIdIndex maps the
+    // stable parameter ID to its index for mh_find_param_by_id. Guarded
+    // by stateMutex; paramCacheDirty is set by the listener when the
+    // plugin reports parameterInfoChanged and triggers a rebuild on the
+    // next query.
+    std::vector<MH_ParamInfo> paramInfoCache;
+    std::unordered_map<std::string, int> paramIdIndex;
+    std::atomic<bool> paramCacheDirty{false};
+
+    // Automation granularity for mh_process_auto, set from control threads
+    // via mh_set_automation_granularity. Atomics (not stateMutex) because
+    // the audio thread reads them per block and must not take a lock; a
+    // change takes effect on the next mh_process_auto call.
+    std::atomic<int> autoMinSubblock{1};           // >= 1; 1 = sample-accurate
+    std::atomic<int> autoBlockRate{0};             // MH_AUTOMATION_* mode
+
+    // Denormal control (mh_set_denormal_control): every process call
+    // runs under a scoped FTZ/DAZ environment unless opted out.
+    // denormalHits counts process calls that observed a denormal or a
+    // flushed underflow (mh_get_denormal_hits) -- attribution for
+    // block-time spikes during decaying tails. Atomics for the same
+    // reason as the automation fields above.
+    std::atomic<int> denormalControl{1};
+    std::atomic<unsigned long long> denormalHits{0};
+
+    // Bytes of process-buffer memory pinned by mh_set_lock_memory (0
+    // when unpinned). Guarded by stateMutex like the other control-
+    // thread state; the audio thread never reads it.
+    size_t lockedBytes = 0;
+
+    // Host-side parameter smoothing (mh_set_param_smoothing). Changes
+    // addressed at a smoothed parameter become ramp targets instead of
+    // immediate sets: every process call advances each in-flight ramp
+    // one block step and issues a single setValueNotifyingHost, so
+    // smoothed automation never splits the audio block. All fields are
+    // atomics (control threads write config, the audio thread runs the
+    // ramps); the array is allocated once, sized to the parameter count,
+    // and published via the release store of smootherCount.
+    struct ParamSmoother
+    {
+        std::atomic<float> rampMs{0.0f};   // <= 0 = smoothing disabled
+        std::atomic<int>   mode{0};        // MH_SMOOTH_* mode
+        std::atomic<float> target{0.0f};
+        std::atomic<float> current{0.0f};
+        std::atomic<int>   active{0};      // ramp in flight
+    };
+    std::unique_ptr<ParamSmoother[]> smoothers;
+    std::atomic<int> smootherCount{0};     // 0 = never configured
+    std::atomic<int> smoothersActive{0};   // any ramp in flight (block gate)
+
+    // Preset bank cache (mh_prefetch_programs / mh_set_program_fast):
+    // one captured program-state blob per factory program, restored via
+    // setCurrentProgramStateInformation instead of walking the plugin's
+    // program-change machinery on every switch. Guarded by stateMutex.
+    // Empty until prefetched; cleared by mh_clear_program_cache.
+    std::vector<MemoryBlock> programCache;
+
+    // Staged standby swap (mh_standby_swap). The control thread
+    // validates and publishes the standby handle with a release store;
+    // the next process call on this handle adopts it at its block
+    // boundary (adoptStandby) and clears the field. Same pattern as
+    // the chain's pending_replacement.
+    std::atomic<MH_Plugin*> pendingSwap{nullptr};
+
+    // Pool identity (mh_session_acquire): the key this handle was
+    // acquired under, used by mh_session_release to park it under the
+    // same key the next acquire will ask for. Empty for plugins opened
+    // outside the pool.
+    std::string poolKey;
+
+    // Parameter-change recording (mh_param_record_*). The queue is
+    // (re)allocated by mh_param_record_start while disarmed; recordArmed
+    // gates the trampoline's append. On a standby swap the recorder
+    // stays with its handle -- the trampoline reaches it through
+    // listener.owner, which the swap already re-points.
+    std::unique_ptr<ParamRecorder> recorder;
+    std::atomic<int> recordArmed{0};
+
     MH_Plugin()
     {
         listener.owner = this;
     }
 };
 
-// Session owns one AudioPluginFormatManager and reuses it across calls.
-// Protected by a mutex because JUCE's AudioPluginFormatManager is not
-// internally thread-safe.
+void MH_Listener::markParamCacheDirty()
+{
+    if (MH_Plugin* const own = owner.load(std::memory_order_relaxed))
+        own->paramCacheDirty.store(true, std::memory_order_release);
+}
+
+// Append to the owning handle's recorder when armed. One relaxed load
+// and a predicted branch when recording is off.
+void MH_Listener::recordParamValue(int paramIndex, float value)
+{
+    MH_Plugin* const own = owner.load(std::memory_order_relaxed);
+    if (own != nullptr
+        && own->recordArmed.load(std::memory_order_acquire) != 0)
+        own->recorder->push(paramIndex, value);
+}
+
+// Pump-aware variant of runOnMsg: routes to the plugin's pinned worker
+// pump when multi-pump mode assigned one at open, else to the shared
+// message thread. Every per-plugin thread-affine control function should
+// go through this so a pinned plugin only ever sees its own thread.
+namespace {
+template <typename Fn>
+static auto runOnMsgFor(MH_Plugin* p, Fn&& fn) -> decltype(fn())
+{
+    if (p == nullptr || p->pump < 0)
+        return runOnMsg(std::forward<Fn>(fn));
+
+    using R = decltype(fn());
+    if constexpr (std::is_void_v<R>)
+    {
+        MinihostWorkerPumps::instance().run(p->pump, [&]() { fn(); });
+    }
+    else
+    {
+        R result{};
+        MinihostWorkerPumps::instance().run(p->pump, [&]() { result = fn(); });
+        return result;
+    }
+}
+
+// Fan a per-plugin body out across the threads the plugins are pinned
+// to: one posted closure per distinct pump (each walking its own
+// plugins in order), unpinned plugins on the message thread, all groups
+// in flight concurrently. This is what makes bulk state capture/restore
+// actually scale in pump mode -- with N pumps, N heavyweight
+// get/setStateInformation calls proceed at once.
+static void runPerPump(MH_Plugin* const* plugins, int count,
+                       const std::function<void(int)>& body)
+{
+    std::unordered_map<int, std::vector<int>> byPump;
+    std::vector<int> onMain;
+    for (int i = 0; i < count; ++i)
+    {
+        const int pump = plugins[i] != nullptr ? plugins[i]->pump : -1;
+        if (pump >= 0)
+            byPump[pump].push_back(i);
+        else
+            onMain.push_back(i);
+    }
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(byPump.size());
+    for (auto& group : byPump)
+    {
+        const std::vector<int>& indices = group.second;
+        pending.push_back(MinihostWorkerPumps::instance().post(group.first,
+            [&body, indices]()
+            {
+                for (int i : indices)
+                    body(i);
+            }));
+    }
+
+    if (! onMain.empty())
+    {
+        MinihostMessageThread::instance().run([&]()
+        {
+            for (int i : onMain)
+                body(i);
+        });
+    }
+
+    for (auto& f : pending)
+        f.get();
+}
+} // namespace
+
+// Capture the static MH_ParamInfo fields for every parameter and rebuild
+// the ID index. Caller must hold stateMutex and be on the message thread
+// (JUCE String accessors). current_value_str is left empty here -- it is
+// the one dynamic field and is filled in at query time.
+static void rebuildParamInfoCache(MH_Plugin* p)
+{
+    auto& params = p->inst->getParameters();
+    const int n = params.size();
+
+    p->paramInfoCache.assign((size_t) n, MH_ParamInfo{});
+    p->paramIdIndex.clear();
+    p->paramIdIndex.reserve((size_t) n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        auto* param = params.getUnchecked(i);
+        MH_ParamInfo& info = p->paramInfoCache[(size_t) i];
+
+        auto name = param->getName(MH_PARAM_NAME_LEN - 1);
+        std::snprintf(info.name, MH_PARAM_NAME_LEN, "%s", name.toRawUTF8());
+
+        // Stable parameter ID (via HostedAudioProcessorParameter)
+        auto* hosted = p->inst->getHostedParameter(i);
+        if (hosted)
+            std::snprintf(info.id, MH_PARAM_NAME_LEN, "%s",
+                          hosted->getParameterID().toRawUTF8());
+        else
+            info.id[0] = '\0';
+
+        auto label = param->getLabel();
+        std::snprintf(info.label, MH_PARAM_NAME_LEN, "%s", label.toRawUTF8());
+
+        info.current_value_str[0] = '\0';
+
+        // Normalized range (always 0-1 for JUCE parameters)
+        info.min_value = 0.0f;
+        info.max_value = 1.0f;
+        info.default_value = param->getDefaultValue();
+
+        info.num_steps = param->isDiscrete() ? param->getNumSteps() : 0;
+        info.is_automatable = param->isAutomatable() ? 1 : 0;
+        info.is_boolean = param->isBoolean() ? 1 : 0;
+        info.category = static_cast<int>(param->getCategory());
+
+        if (info.id[0] != '\0')
+            p->paramIdIndex.emplace(info.id, i);
+    }
+}
+
+// Session state, sharded for concurrency. JUCE's AudioPluginFormatManager
+// is not internally thread-safe, so each operation needs exclusive access
+// to a manager -- but serializing every probe/open behind one manager
+// turns "thread-safe concurrent session use" into a convoy: 8 threads
+// probing through one session run one at a time. Instead the session
+// holds up to kNumShards (manager, mutex) pairs; each operation acquires
+// one shard for its duration, so concurrent callers fan out across
+// shards and only collide once more than kNumShards operations overlap.
+//
+// Shard 0 is initialized at mh_session_create (preserving the
+// "pre-initialized formats" contract for single-threaded users); the
+// rest lazily, the first time contention actually reaches them, so a
+// serial session never pays for formats it doesn't use.
 struct MH_Session
 {
-    std::mutex mtx;
-    AudioPluginFormatManager fm;
+    struct Shard
+    {
+        std::mutex mtx;
+        AudioPluginFormatManager fm;
+        bool initialized = false;   // guarded by mtx
+    };
+
+    static constexpr int kNumShards = 8;
+    Shard shards[kNumShards];
+    std::atomic<unsigned> rr{0};    // blocking-fallback rotation
+
+    // Shared LV2 context. Resolving an LV2 bundle (re)parses the lilv
+    // world -- every installed .ttl -- once per format-manager
+    // instance, so fanning LV2 opens out across the shards pays that
+    // parse once per shard they touch. All LV2-targeted calls instead
+    // share this one lazily-created manager (holding a single
+    // LV2Format) and serialize behind its mutex: one world, one lock.
+    // Reset by mh_session_refresh_formats so bundles installed after
+    // the first parse become visible.
+   #if JUCE_PLUGINHOST_LV2
+    std::mutex lv2Mtx;
+    std::unique_ptr<AudioPluginFormatManager> lv2Fm;
+   #endif
+
+    // Instance pool (mh_session_acquire / mh_session_release). Parked
+    // instances carry their key in MH_Plugin::poolKey; birth states are
+    // captured per key on the first pooled open so revival can restore
+    // factory defaults. The pool stays small (poolMaxIdle entries), so
+    // a plain vector with linear key scan beats a map. Guarded by
+    // poolMtx; evicted instances are closed OUTSIDE the lock (mh_close
+    // marshals to the plugin thread).
+    struct PooledInstance
+    {
+        MH_Plugin* plugin = nullptr;
+        int64 parkedAtMs = 0;
+    };
+    std::mutex poolMtx;
+    std::vector<PooledInstance> pool;   // parked in order: front = oldest
+    std::unordered_map<std::string, MemoryBlock> poolBirthStates;
+    int poolMaxIdle = 0;                // 0 = pooling disabled
+    int poolTtlMs   = 0;                // 0 = no age limit
 };
 
+// Process-wide block counter (mh_metrics). Registered on first plugin
+// open; -1 (ignored by mh_metric_add) until then.
+static std::atomic<int> g_plugin_blocks_metric{-1};
+
 static void setErr(char* buf, size_t n, const String& msg)
 {
     if (buf == nullptr || n == 0) return;
@@ -441,14 +1170,226 @@ static bool findFirstTypeForFile(AudioPluginFormatManager& fm,
     return foundAny;
 }
 
-static void tryConfigureBusesEx(AudioPluginInstance& inst, int reqIn, int reqOut, int reqSidechain)
+// ---------------------------------------------------------------------------
+// Per-process module cache.
+//
+// Opening N instances of the same bundle in one process used to pay the
+// module discovery cost N times: findAllTypesForFile re-reads the binary,
+// re-parses moduleinfo and re-scans the factory on every call, and once the
+// last instance of a bundle closes, the loader drops the module so the next
+// open dlopens from scratch. The cache fixes both: the resolved
+// PluginDescription is remembered per bundle path (invalidated when the
+// file's size or mtime changes on disk), and on Linux the bundle's shared
+// object is additionally pinned with an extra dlopen reference so the module
+// stays mapped between instances. Second-through-Nth opens of the same
+// bundle therefore skip disk and module init entirely -- the common case for
+// parallel-branch projects holding many instances of one effect.
+//
+// Guarded by its own mutex; entries live until mh_module_cache_clear() or
+// process exit.
+// ---------------------------------------------------------------------------
+struct ModuleCacheEntry
 {
-    // Extended bus configuration with sidechain support
-    inst.enableAllBuses();
+    PluginDescription desc;
+    int64 fileSize = 0;
+    int64 modTime  = 0;        // milliseconds since epoch
+    void* pin      = nullptr;  // extra dlopen reference (Linux only)
+};
 
-    // Main buses (bus 0)
-    if (inst.getBusCount(true) > 0)
-    {
+static std::mutex moduleCacheMutex;
+static std::unordered_map<std::string, ModuleCacheEntry> moduleCache;
+
+#if defined(__linux__)
+// Locate the loadable shared object for a bundle path: a .vst3 bundle
+// carries it under Contents/<arch>-linux/, a bare .so is itself.
+static File findModuleBinary(const File& pluginFile)
+{
+    if (! pluginFile.isDirectory())
+        return pluginFile;
+    Array<File> sos;
+    pluginFile.getChildFile("Contents")
+              .findChildFiles(sos, File::findFiles, true, "*.so");
+    return sos.isEmpty() ? File() : sos.getReference(0);
+}
+#endif
+
+// Best-effort residency pin: an extra dlopen reference on the module
+// binary keeps it mapped after JUCE's own module handle goes away with
+// the last instance. Elsewhere (macOS AU, Windows) the loader's own
+// caching applies and no pin is taken.
+static void pinModule(ModuleCacheEntry& e, const File& pluginFile)
+{
+#if defined(__linux__)
+    File so = findModuleBinary(pluginFile);
+    if (so.existsAsFile())
+        e.pin = dlopen(so.getFullPathName().toRawUTF8(),
+                       RTLD_NOW | RTLD_LOCAL);
+#else
+    (void) e;
+    (void) pluginFile;
+#endif
+}
+
+static void unpinModule(ModuleCacheEntry& e)
+{
+#if defined(__linux__)
+    if (e.pin != nullptr) dlclose(e.pin);
+#endif
+    e.pin = nullptr;
+}
+
+// Cache-aware wrapper around findFirstTypeForFile: serve the resolved
+// description from the cache when the file on disk is unchanged,
+// otherwise discover it and populate the cache.
+static bool findFirstTypeForFileCached(AudioPluginFormatManager& fm,
+                                       const File& pluginFile,
+                                       PluginDescription& outDesc,
+                                       String& err)
+{
+    const std::string key = pluginFile.getFullPathName().toStdString();
+    const int64 size  = pluginFile.getSize();
+    const int64 mtime = pluginFile.getLastModificationTime().toMilliseconds();
+
+    {
+        std::lock_guard<std::mutex> lock(moduleCacheMutex);
+        auto it = moduleCache.find(key);
+        if (it != moduleCache.end())
+        {
+            if (it->second.fileSize == size && it->second.modTime == mtime)
+            {
+                outDesc = it->second.desc;
+                return true;
+            }
+            // Bundle changed on disk (update / reinstall): drop the
+            // stale entry and its pin, then re-discover below.
+            unpinModule(it->second);
+            moduleCache.erase(it);
+        }
+    }
+
+    if (! findFirstTypeForFile(fm, pluginFile, outDesc, err))
+        return false;
+
+    ModuleCacheEntry e;
+    e.desc     = outDesc;
+    e.fileSize = size;
+    e.modTime  = mtime;
+    pinModule(e, pluginFile);
+
+    std::lock_guard<std::mutex> lock(moduleCacheMutex);
+    if (moduleCache.find(key) == moduleCache.end())
+        moduleCache.emplace(key, std::move(e));
+    else
+        unpinModule(e);  // lost a concurrent-discovery race; keep the first
+    return true;
+}
+
+extern "C" int mh_module_cache_size(void)
+{
+    std::lock_guard<std::mutex> lock(moduleCacheMutex);
+    return (int) moduleCache.size();
+}
+
+extern "C" void mh_module_cache_clear(void)
+{
+    std::lock_guard<std::mutex> lock(moduleCacheMutex);
+    for (auto& kv : moduleCache)
+        unpinModule(kv.second);
+    moduleCache.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Negotiated-layout cache (mh_layout_cache_*)
+//
+// checkBusesLayoutSupported round-trips the plugin, and plugins with
+// many bus configurations take seconds to enumerate. Results are pure
+// functions of (plugin identity, version, requested layout), so
+// mh_check_buses_layout memoizes them here; export/import let a host
+// persist the map (the Python plugincache store does) so a daily
+// project reload never re-probes a layout it already negotiated.
+// ---------------------------------------------------------------------------
+
+static std::mutex layoutCacheMutex;
+static std::unordered_map<std::string, int> layoutCache;  // key -> supported
+
+// Key = identifier + version + the exact per-bus channel counts asked
+// for. The version component means a plugin update re-probes instead
+// of trusting answers from the old binary.
+static std::string layoutCacheKey(const PluginDescription& desc,
+                                  const int* input_channels, int num_input_buses,
+                                  const int* output_channels, int num_output_buses)
+{
+    String k = desc.createIdentifierString() + "|" + desc.version + "|i";
+    for (int i = 0; i < num_input_buses; ++i)
+        k << ":" << (input_channels ? input_channels[i] : 0);
+    k << "|o";
+    for (int i = 0; i < num_output_buses; ++i)
+        k << ":" << (output_channels ? output_channels[i] : 0);
+    return k.toStdString();
+}
+
+extern "C" int mh_layout_cache_size(void)
+{
+    std::lock_guard<std::mutex> lock(layoutCacheMutex);
+    return (int) layoutCache.size();
+}
+
+extern "C" void mh_layout_cache_clear(void)
+{
+    std::lock_guard<std::mutex> lock(layoutCacheMutex);
+    layoutCache.clear();
+}
+
+extern "C" int mh_layout_cache_export(char* buf, int buf_size)
+{
+    std::string blob;
+    {
+        std::lock_guard<std::mutex> lock(layoutCacheMutex);
+        for (const auto& kv : layoutCache)
+        {
+            blob += kv.second ? '1' : '0';
+            blob += ' ';
+            blob += kv.first;
+            blob += '\n';
+        }
+    }
+    const int needed = (int) blob.size() + 1;
+    if (buf != nullptr && buf_size >= needed)
+        std::memcpy(buf, blob.c_str(), (size_t) needed);
+    return needed;
+}
+
+extern "C" int mh_layout_cache_import(const char* data)
+{
+    if (data == nullptr) return 0;
+    int imported = 0;
+    std::lock_guard<std::mutex> lock(layoutCacheMutex);
+    for (const char* p = data; *p != '\0'; )
+    {
+        const char* eol = p;
+        while (*eol != '\0' && *eol != '\n') ++eol;
+        // A well-formed line is "<0|1> <key>"; anything else (blank
+        // lines, comments, truncation damage) is skipped, never fatal
+        // -- the cache is an optimization, not a correctness input.
+        if (eol - p >= 3 && (p[0] == '0' || p[0] == '1') && p[1] == ' ')
+        {
+            layoutCache[std::string(p + 2, (size_t)(eol - p - 2))]
+                = (p[0] == '1');
+            ++imported;
+        }
+        p = (*eol == '\n') ? eol + 1 : eol;
+    }
+    return imported;
+}
+
+static void tryConfigureBusesEx(AudioPluginInstance& inst, int reqIn, int reqOut, int reqSidechain)
+{
+    // Extended bus configuration with sidechain support
+    inst.enableAllBuses();
+
+    // Main buses (bus 0)
+    if (inst.getBusCount(true) > 0)
+    {
         if (reqIn > 0)
             inst.setChannelLayoutOfBus(true, 0, AudioChannelSet::canonicalChannelSet(reqIn));
     }
@@ -501,9 +1442,17 @@ extern "C" MH_Plugin* mh_open(const char* plugin_path,
 extern "C" void mh_close(MH_Plugin* p)
 {
     if (! p) return;
-    // Destruction is thread-affine to JUCE's message thread, same as
-    // construction. Marshal there when enabled (inline no-op otherwise).
-    MinihostMessageThread::instance().run([&]()
+    // Stop the coalescing flush thread (if any) before the listener it
+    // reads goes away. Pending changes are dropped -- the plugin is
+    // closing, nobody wants them.
+    p->listener.stopCoalesceThread();
+    // Unpin the process buffers before they are freed: free() does not
+    // munlock, and leaked locks keep counting against RLIMIT_MEMLOCK.
+    mh_set_lock_memory(p, 0);
+    // Destruction is thread-affine to the thread the plugin was built on
+    // -- its pinned pump in multi-pump mode, else JUCE's message thread.
+    // Marshal there when enabled (inline no-op otherwise).
+    runOnMsgFor(p, [&]()
     {
         if (p->inst)
         {
@@ -541,6 +1490,161 @@ extern "C" int mh_get_info(MH_Plugin* p, MH_Info* out_info)
     return 1;
 }
 
+// True when parameter `index` has a smoothing ramp configured. Audio
+// thread; acquire on the count pairs with the release in
+// mh_set_param_smoothing so the array is visible once the count is.
+static inline bool isSmoothedParam(MH_Plugin* p, int index)
+{
+    const int n = p->smootherCount.load(std::memory_order_acquire);
+    return index >= 0 && index < n
+        && p->smoothers[(size_t) index].rampMs.load(std::memory_order_relaxed)
+               > 0.0f;
+}
+
+// Route one automation change at a smoothed parameter: set the ramp
+// target instead of the value. Audio thread.
+static inline void smootherSetTarget(MH_Plugin* p, int index, float value)
+{
+    auto& s = p->smoothers[(size_t) index];
+    s.target.store(jlimit(0.0f, 1.0f, value), std::memory_order_relaxed);
+    s.active.store(1, std::memory_order_relaxed);
+    p->smoothersActive.store(1, std::memory_order_relaxed);
+}
+
+// Advance every in-flight ramp one block step and issue one
+// setValueNotifyingHost per still-moving parameter. Called at the top
+// of each process entry point; costs two atomic loads when nothing is
+// smoothed or no ramp is active. Audio thread only.
+//
+// MH_SMOOTH_LINEAR slews at a constant rate sized so the full
+// normalized range takes ramp_ms; MH_SMOOTH_EXPONENTIAL is a one-pole
+// lag that settles to within ~1% of the target in ramp_ms.
+static void advanceSmoothers(MH_Plugin* p, int nframes)
+{
+    const int n = p->smootherCount.load(std::memory_order_acquire);
+    if (n == 0 || nframes <= 0) return;
+    if (p->smoothersActive.load(std::memory_order_relaxed) == 0) return;
+    if (p->sampleRate <= 0.0) return;
+
+    auto& params = p->inst->getParameters();
+    const double blockMs = 1000.0 * (double) nframes / p->sampleRate;
+    int still_active = 0;
+
+    for (int i = 0; i < n && i < params.size(); ++i)
+    {
+        auto& s = p->smoothers[(size_t) i];
+        if (s.active.load(std::memory_order_relaxed) == 0) continue;
+
+        const float target = s.target.load(std::memory_order_relaxed);
+        const float rampMs = s.rampMs.load(std::memory_order_relaxed);
+        float cur = s.current.load(std::memory_order_relaxed);
+
+        if (rampMs <= 0.0f)
+        {
+            // Smoothing was disabled mid-ramp: finish the move now.
+            cur = target;
+            s.active.store(0, std::memory_order_relaxed);
+        }
+        else if (s.mode.load(std::memory_order_relaxed) == MH_SMOOTH_EXPONENTIAL)
+        {
+            // One-pole step; -ln(0.01) ~= 4.6 puts the value within 1%
+            // of the target after rampMs regardless of block size.
+            const float a = (float) (1.0 - std::exp(-4.6 * blockMs / (double) rampMs));
+            cur += (target - cur) * a;
+        }
+        else
+        {
+            const float step = (float) (blockMs / (double) rampMs);
+            const float d = target - cur;
+            if (std::abs(d) <= step) cur = target;
+            else                     cur += d < 0.0f ? -step : step;
+        }
+
+        if (std::abs(target - cur) < 1.0e-4f)
+        {
+            cur = target;
+            s.active.store(0, std::memory_order_relaxed);
+        }
+        else
+        {
+            ++still_active;
+        }
+        s.current.store(cur, std::memory_order_relaxed);
+        params.getUnchecked(i)->setValueNotifyingHost(jlimit(0.0f, 1.0f, cur));
+    }
+    p->smoothersActive.store(still_active, std::memory_order_relaxed);
+}
+
+// Exchange two atomics the staged-swap way: relaxed is enough because
+// the mh_standby_swap contract forbids concurrent writers while a swap
+// is pending.
+template <typename T>
+static inline void swapAtomicRelaxed(std::atomic<T>& a, std::atomic<T>& b)
+{
+    const T tmp = a.load(std::memory_order_relaxed);
+    a.store(b.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    b.store(tmp, std::memory_order_relaxed);
+}
+
+// Adopt a staged standby swap at a block boundary (mh_standby_swap).
+// Runs at the top of every process entry point and costs one relaxed
+// load when nothing is staged. Everything exchanged here is a pointer
+// or small scalar -- unique_ptr/vector/map swaps and atomic stores, no
+// allocation, no locks -- so the audio thread stays unblocked. The
+// engine instance travels with its pinned pump and its parameter
+// caches; per-handle scratch (process buffers, MIDI staging) and
+// per-handle policy (callbacks, smoothing config, transport, denormal
+// control) stay put. The program cache also stays: its blobs describe
+// the bundle, not the instance, so they apply equally to either side.
+static void adoptStandby(MH_Plugin* p)
+{
+    MH_Plugin* const s = p->pendingSwap.load(std::memory_order_acquire);
+    if (s == nullptr)
+        return;
+
+    std::swap(p->inst, s->inst);
+
+    // The pump pin follows the instance: thread-affine work must keep
+    // landing on the thread the instance was built on.
+    std::swap(p->pump, s->pump);
+
+    // Parameter metadata describes the instance, not the handle.
+    p->paramInfoCache.swap(s->paramInfoCache);
+    p->paramIdIndex.swap(s->paramIdIndex);
+    swapAtomicRelaxed(p->paramCacheDirty, s->paramCacheDirty);
+
+    // Each handle keeps its own transport; re-point the instances.
+    p->inst->setPlayHead(&p->playHead);
+    s->inst->setPlayHead(&s->playHead);
+
+    // The listener trampolines are registered on the instances and
+    // travel with them. Re-point their routing -- owner plus the
+    // callback/user-data pairs -- so events from each instance keep
+    // arriving through the callbacks registered on the handle that now
+    // holds it. (Coalescing is validated off at stage time; its slot
+    // arrays and flush threads never move.)
+    swapAtomicRelaxed(p->listener.owner, s->listener.owner);
+    swapAtomicRelaxed(p->listener.changeCb, s->listener.changeCb);
+    swapAtomicRelaxed(p->listener.changeUserData, s->listener.changeUserData);
+    swapAtomicRelaxed(p->listener.paramValueCb, s->listener.paramValueCb);
+    swapAtomicRelaxed(p->listener.paramValueUserData, s->listener.paramValueUserData);
+    swapAtomicRelaxed(p->listener.paramGestureCb, s->listener.paramGestureCb);
+    swapAtomicRelaxed(p->listener.paramGestureUserData, s->listener.paramGestureUserData);
+
+    // In-flight smoothing ramps were aimed at the departing instances;
+    // cancel them on both sides. The configured ramp times and modes
+    // are host policy and stay with their handles.
+    for (MH_Plugin* h : { p, s })
+    {
+        const int n = h->smootherCount.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i)
+            h->smoothers[(size_t) i].active.store(0, std::memory_order_relaxed);
+        h->smoothersActive.store(0, std::memory_order_relaxed);
+    }
+
+    p->pendingSwap.store(nullptr, std::memory_order_release);
+}
+
 extern "C" int mh_process_midi_io(MH_Plugin* p,
                                   const float* const* inputs,
                                   float* const* outputs,
@@ -552,82 +1656,121 @@ extern "C" int mh_process_midi_io(MH_Plugin* p,
                                   int* num_midi_out)
 {
     if (!p || !p->inst) return 0;
-    if (nframes < 0 || nframes > p->maxBlockSize) return 0;
+    if (nframes < 0) return 0;
+
+    // Pick up a staged standby swap at the block boundary.
+    adoptStandby(p);
+
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(
+        p->denormalControl.load(std::memory_order_relaxed) != 0);
+
+    mh_metric_add(g_plugin_blocks_metric.load(std::memory_order_relaxed), 1);
+    if (num_midi_in > 0)
+        mh_eventlog_record(MH_LOG_MIDI_IN, 0, (unsigned) num_midi_in);
+
+    advanceSmoothers(p, nframes);
 
     auto& buf = p->processBuf;
     const int totalCh = buf.getNumChannels();
-    const size_t bytes = sizeof(float) * (size_t)nframes;
-
-    // Match the buffer's reported sample count to nframes so processBlock
-    // processes the right number of frames. avoidReallocating=true ensures no
-    // heap activity as long as nframes <= maxBlockSize (already validated).
-    buf.setSize(totalCh, nframes, false, false, true);
 
-    // Copy main inputs into the first p->inCh channels of the combined buffer;
-    // zero any remaining channels (sidechain slots, output-only channels when
-    // outCh > inCh). This ensures the plugin sees a buffer with
-    // max(inCh + sidechainCh, outCh) channels of valid data, as JUCE requires.
-    if (inputs)
-    {
-        for (int ch = 0; ch < p->inCh; ++ch)
-            std::memcpy(buf.getWritePointer(ch), inputs[ch], bytes);
-    }
-    else
+    if (num_midi_out)
+        *num_midi_out = 0;
+    int outIdx = 0;
+
+    // Blocks up to maxBlockSize run the loop below exactly once -- the
+    // variable-block fast path (no re-prepare, no reallocation). Larger
+    // blocks are sub-blocked transparently: a plugin prepared with a
+    // smaller maximum than its host's sees maxBlockSize-sized chunks,
+    // with MIDI in/out rebased into and out of each chunk. This is what
+    // lets a graph or chain mix 64-frame live and 2048-frame offline
+    // blocks over plugins opened once at any prepared size.
+    for (int done = 0; done < nframes || (nframes == 0 && done == 0);)
     {
-        for (int ch = 0; ch < p->inCh; ++ch)
+        const int chunk = std::min(nframes - done, p->maxBlockSize);
+        const size_t bytes = sizeof(float) * (size_t)chunk;
+
+        // Match the buffer's reported sample count to the chunk so
+        // processBlock processes the right number of frames.
+        // avoidReallocating=true ensures no heap activity as long as
+        // chunk <= maxBlockSize (guaranteed above).
+        buf.setSize(totalCh, chunk, false, false, true);
+
+        // Copy main inputs into the first p->inCh channels of the combined
+        // buffer; zero any remaining channels (sidechain slots, output-only
+        // channels when outCh > inCh). This ensures the plugin sees a buffer
+        // with max(inCh + sidechainCh, outCh) channels of valid data, as
+        // JUCE requires.
+        if (inputs)
+        {
+            for (int ch = 0; ch < p->inCh; ++ch)
+                std::memcpy(buf.getWritePointer(ch), inputs[ch] + done, bytes);
+        }
+        else
+        {
+            for (int ch = 0; ch < p->inCh; ++ch)
+                std::memset(buf.getWritePointer(ch), 0, bytes);
+        }
+        for (int ch = p->inCh; ch < totalCh; ++ch)
             std::memset(buf.getWritePointer(ch), 0, bytes);
-    }
-    for (int ch = p->inCh; ch < totalCh; ++ch)
-        std::memset(buf.getWritePointer(ch), 0, bytes);
 
-    // Build MIDI input buffer from events
-    p->midi.clear();
-    if (midi_in && num_midi_in > 0)
-    {
-        for (int i = 0; i < num_midi_in; ++i)
+        // Build MIDI input buffer from the events landing in this chunk
+        p->midi.clear();
+        if (midi_in && num_midi_in > 0)
         {
-            const auto& ev = midi_in[i];
-            int samplePos = jlimit(0, nframes - 1, ev.sample_offset);
-            p->midi.addEvent(MidiMessage(ev.status, ev.data1, ev.data2), samplePos);
+            for (int i = 0; i < num_midi_in; ++i)
+            {
+                const auto& ev = midi_in[i];
+                int samplePos = jlimit(0, nframes > 0 ? nframes - 1 : 0,
+                                       ev.sample_offset);
+                if (samplePos < done || samplePos >= done + chunk)
+                    continue;
+                p->midi.addEvent(MidiMessage(ev.status, ev.data1, ev.data2),
+                                 samplePos - done);
+            }
         }
-    }
-
-    p->inst->processBlock(buf, p->midi);
-
-    // Copy outputs back from the first p->outCh channels.
-    if (outputs)
-    {
-        for (int ch = 0; ch < p->outCh; ++ch)
-            std::memcpy(outputs[ch], buf.getReadPointer(ch), bytes);
-    }
 
-    // Extract MIDI output events
-    if (num_midi_out)
-        *num_midi_out = 0;
+        p->inst->processBlock(buf, p->midi);
 
-    if (midi_out && midi_out_capacity > 0)
-    {
-        int outIdx = 0;
-        for (const auto metadata : p->midi)
+        // Copy outputs back from the first p->outCh channels.
+        if (outputs)
         {
-            if (outIdx >= midi_out_capacity)
-                break;
+            for (int ch = 0; ch < p->outCh; ++ch)
+                std::memcpy(outputs[ch] + done, buf.getReadPointer(ch), bytes);
+        }
 
-            auto msg = metadata.getMessage();
-            if (msg.getRawDataSize() >= 1)
+        // Extract MIDI output events, rebased to block-relative offsets
+        if (midi_out && midi_out_capacity > 0)
+        {
+            for (const auto metadata : p->midi)
             {
-                const auto* data = msg.getRawData();
-                midi_out[outIdx].sample_offset = metadata.samplePosition;
-                midi_out[outIdx].status = data[0];
-                midi_out[outIdx].data1 = msg.getRawDataSize() > 1 ? data[1] : 0;
-                midi_out[outIdx].data2 = msg.getRawDataSize() > 2 ? data[2] : 0;
-                ++outIdx;
+                if (outIdx >= midi_out_capacity)
+                    break;
+
+                auto msg = metadata.getMessage();
+                if (msg.getRawDataSize() >= 1)
+                {
+                    const auto* data = msg.getRawData();
+                    midi_out[outIdx].sample_offset = metadata.samplePosition + done;
+                    midi_out[outIdx].status = data[0];
+                    midi_out[outIdx].data1 = msg.getRawDataSize() > 1 ? data[1] : 0;
+                    midi_out[outIdx].data2 = msg.getRawDataSize() > 2 ? data[2] : 0;
+                    ++outIdx;
+                }
             }
         }
-        if (num_midi_out)
-            *num_midi_out = outIdx;
+
+        done += chunk;
+        if (nframes == 0)
+            break;
     }
 
+    if (num_midi_out)
+        *num_midi_out = outIdx;
+
+    if (denormalScope.hit())
+        p->denormalHits.fetch_add(1, std::memory_order_relaxed);
+
     return 1;
 }
 
@@ -652,6 +1795,106 @@ extern "C" int mh_process(MH_Plugin* p,
                               nullptr, 0, nullptr, 0, nullptr);
 }
 
+extern "C" int mh_process_interleaved(MH_Plugin* p,
+                                      const float* in,
+                                      float* out,
+                                      int nframes,
+                                      int channels)
+{
+    if (!p || !p->inst) return 0;
+    if (nframes < 0 || nframes > p->maxBlockSize) return 0;
+    if (channels < 1) return 0;
+
+    // Pick up a staged standby swap at the block boundary.
+    adoptStandby(p);
+
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(
+        p->denormalControl.load(std::memory_order_relaxed) != 0);
+
+    advanceSmoothers(p, nframes);
+
+    auto& buf = p->processBuf;
+    const int totalCh = buf.getNumChannels();
+    const size_t bytes = sizeof(float) * (size_t)nframes;
+
+    buf.setSize(totalCh, nframes, false, false, true);
+
+    // Deinterleave straight into the combined process buffer -- this is the
+    // one input conversion; there is no planar staging copy. Interleaved
+    // channels beyond inCh are ignored, plugin channels beyond `channels`
+    // (and sidechain/output-only slots) see silence.
+    const int copyInCh = channels < p->inCh ? channels : p->inCh;
+    if (in)
+    {
+        if (channels == 2 && copyInCh == 2)
+        {
+            // Stereo fast path: one pass the compiler turns into vector
+            // shuffles (same shape as mh_audio_deinterleave).
+            float* l = buf.getWritePointer(0);
+            float* r = buf.getWritePointer(1);
+            for (int f = 0; f < nframes; ++f)
+            {
+                l[f] = in[f * 2];
+                r[f] = in[f * 2 + 1];
+            }
+        }
+        else
+        {
+            for (int ch = 0; ch < copyInCh; ++ch)
+            {
+                const float* src = in + ch;
+                float* dst = buf.getWritePointer(ch);
+                for (int f = 0; f < nframes; ++f)
+                    dst[f] = src[f * channels];
+            }
+        }
+    }
+    for (int ch = in ? copyInCh : 0; ch < totalCh; ++ch)
+        std::memset(buf.getWritePointer(ch), 0, bytes);
+
+    p->midi.clear();
+    p->inst->processBlock(buf, p->midi);
+
+    // Reinterleave straight from the process buffer; interleaved channels
+    // past outCh are zero-filled so the caller never sees stale data.
+    if (out)
+    {
+        const int copyOutCh = channels < p->outCh ? channels : p->outCh;
+        if (channels == 2 && copyOutCh == 2)
+        {
+            const float* l = buf.getReadPointer(0);
+            const float* r = buf.getReadPointer(1);
+            for (int f = 0; f < nframes; ++f)
+            {
+                out[f * 2] = l[f];
+                out[f * 2 + 1] = r[f];
+            }
+        }
+        else
+        {
+            for (int ch = 0; ch < copyOutCh; ++ch)
+            {
+                const float* src = buf.getReadPointer(ch);
+                float* dst = out + ch;
+                for (int f = 0; f < nframes; ++f)
+                    dst[f * channels] = src[f];
+            }
+            for (int ch = copyOutCh; ch < channels; ++ch)
+            {
+                float* dst = out + ch;
+                for (int f = 0; f < nframes; ++f)
+                    dst[f * channels] = 0.0f;
+            }
+        }
+    }
+
+    if (denormalScope.hit())
+        p->denormalHits.fetch_add(1, std::memory_order_relaxed);
+
+    return 1;
+}
+
 extern "C" int mh_get_num_params(MH_Plugin* p)
 {
     if (!p || !p->inst) return 0;
@@ -676,7 +1919,43 @@ extern "C" int mh_set_param(MH_Plugin* p, int index, float normalized_0_1)
     if (index < 0 || index >= params.size()) return 0;
 
     normalized_0_1 = jlimit(0.0f, 1.0f, normalized_0_1);
+    // Keep a configured smoother coherent with direct sets: jump its
+    // state so a later ramp starts from here, not from a stale value.
+    if (index < p->smootherCount.load(std::memory_order_acquire))
+    {
+        auto& s = p->smoothers[(size_t) index];
+        s.current.store(normalized_0_1, std::memory_order_relaxed);
+        s.target.store(normalized_0_1, std::memory_order_relaxed);
+        s.active.store(0, std::memory_order_relaxed);
+    }
     params.getUnchecked(index)->setValueNotifyingHost(normalized_0_1);
+    unsigned int bits;
+    std::memcpy(&bits, &normalized_0_1, sizeof(bits));
+    mh_eventlog_record(MH_LOG_PARAM_WRITE, (unsigned) index, bits);
+    return 1;
+}
+
+extern "C" int mh_set_params(MH_Plugin* p, const int* indices,
+                             const float* values, int count)
+{
+    if (!p || !p->inst || count < 0) return 0;
+    if (count == 0) return 1;
+    if (!indices || !values) return 0;
+
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+    auto& params = p->inst->getParameters();
+    const int n = params.size();
+
+    // Validate the whole batch up front: a failed call changes nothing.
+    for (int i = 0; i < count; ++i)
+        if (indices[i] < 0 || indices[i] >= n) return 0;
+
+    // setValue (not setValueNotifyingHost): the value still reaches the
+    // plugin, but per-parameter host listener messages are skipped --
+    // that is the point of batching (see header).
+    for (int i = 0; i < count; ++i)
+        params.getUnchecked(indices[i])
+              ->setValue(jlimit(0.0f, 1.0f, values[i]));
     return 1;
 }
 
@@ -684,11 +1963,11 @@ extern "C" int mh_set_param(MH_Plugin* p, int index, float normalized_0_1)
 // Parameter morphing (A/B interpolation over normalized parameter values)
 // ---------------------------------------------------------------------------
 //
-// Composed from the public mh_get_param / mh_set_param / mh_get_num_params
-// entry points, so each per-parameter access takes and releases the state
-// mutex exactly as a direct call would (class-2 thread safety: safe to
-// overlap mh_process). The lerp helpers are pure array math and touch no
-// plugin state.
+// Capture is composed from the public mh_get_param / mh_get_num_params
+// entry points; apply rides on the batched mh_set_params so a snapshot
+// restore takes the state mutex once instead of once per parameter
+// (class-2 thread safety either way: safe to overlap mh_process). The
+// lerp helpers are pure array math and touch no plugin state.
 
 extern "C" int mh_morph_capture(MH_Plugin* p, float* out_values, int capacity)
 {
@@ -705,15 +1984,34 @@ extern "C" int mh_morph_apply(MH_Plugin* p, const float* values, int count)
     if (!p || !p->inst || !values) return 0;
     const int n = mh_get_num_params(p);
     if (count != n) return 0;
-    for (int i = 0; i < n; ++i)
-        mh_set_param(p, i, jlimit(0.0f, 1.0f, values[i]));
-    return 1;
+    if (n == 0) return 1;
+    std::vector<int> indices((size_t) n);
+    for (int i = 0; i < n; ++i) indices[(size_t) i] = i;
+    return mh_set_params(p, indices.data(), values, n);
 }
 
+// Arrays below this size take the scalar path: the vector form makes
+// several passes over the data and its per-call overhead only pays off
+// once the array is comfortably wider than the SIMD registers.
+static constexpr int morphVectorThreshold = 64;
+
 extern "C" int mh_morph_lerp(const float* a, const float* b, float* out,
                              int count, float t)
 {
     if (!a || !b || !out || count < 0) return 0;
+    // FloatVectorOperations is JUCE's portable SIMD layer (SSE/NEON).
+    // The staged form overwrites out before re-reading a, so it is only
+    // valid when out does not alias a; the scalar loop (which reads both
+    // inputs before writing each element) covers that case.
+    if (out != a && count >= morphVectorThreshold)
+    {
+        FloatVectorOperations::copy(out, b, count);
+        FloatVectorOperations::subtract(out, a, count);     // out = b - a
+        FloatVectorOperations::multiply(out, t, count);     // out = (b - a) * t
+        FloatVectorOperations::add(out, a, count);          // out = a + (b - a) * t
+        FloatVectorOperations::clip(out, out, 0.0f, 1.0f, count);
+        return 1;
+    }
     for (int i = 0; i < count; ++i)
         out[i] = jlimit(0.0f, 1.0f, a[i] + (b[i] - a[i]) * t);
     return 1;
@@ -723,6 +2021,17 @@ extern "C" int mh_morph_lerp_per_param(const float* a, const float* b, float* ou
                                        int count, const float* t)
 {
     if (!a || !b || !out || !t || count < 0) return 0;
+    // Same staging as mh_morph_lerp with an elementwise multiply; out
+    // must alias neither a nor t for the vector path.
+    if (out != a && out != t && count >= morphVectorThreshold)
+    {
+        FloatVectorOperations::copy(out, b, count);
+        FloatVectorOperations::subtract(out, a, count);     // out = b - a
+        FloatVectorOperations::multiply(out, t, count);     // out = (b - a) * t
+        FloatVectorOperations::add(out, a, count);          // out = a + (b - a) * t
+        FloatVectorOperations::clip(out, out, 0.0f, 1.0f, count);
+        return 1;
+    }
     for (int i = 0; i < count; ++i)
         out[i] = jlimit(0.0f, 1.0f, a[i] + (b[i] - a[i]) * t[i]);
     return 1;
@@ -740,57 +2049,173 @@ extern "C" int mh_morph(MH_Plugin* p, const float* a, const float* b,
     return mh_morph_apply(p, tmp.data(), n);
 }
 
-extern "C" int mh_get_param_info(MH_Plugin* p, int index, MH_ParamInfo* out_info)
+extern "C" int mh_params_diff(MH_Plugin* p, const float* baseline, int count,
+                              int* changed_indices, float* new_values,
+                              int capacity)
 {
-    if (!p || !p->inst || !out_info) return 0;
-    int result = 0;
-    MinihostMessageThread::instance().run([&]()
+    if (!p || !p->inst || !baseline || count < 0 || capacity < 0) return -1;
+    if (capacity > 0 && (!changed_indices || !new_values)) return -1;
+    const int n = mh_get_num_params(p);
+    if (count != n) return -1;
+
+    // Exact comparison, not an epsilon: the baseline came from
+    // mh_get_param, so an untouched parameter reads back bit-identical
+    // (both values round-tripped the plugin's own quantization).
+    int changed = 0;
+    for (int i = 0; i < n; ++i)
     {
-    std::lock_guard<std::mutex> lock(p->stateMutex);
-    auto& params = p->inst->getParameters();
-    if (index < 0 || index >= params.size()) return;
+        const float cur = mh_get_param(p, i);
+        if (cur == baseline[i]) continue;
+        if (changed < capacity)
+        {
+            changed_indices[changed] = i;
+            new_values[changed] = cur;
+        }
+        ++changed;
+    }
+    return changed;
+}
 
-    auto* param = params.getUnchecked(index);
+// Differential morph pair (mh_morph_pair_*): the active set -- the
+// indices where the two snapshots actually differ -- is computed once
+// at create, so a 60 Hz sweep over a 2000-parameter patch with 12
+// moving parameters writes 12 values per step instead of 2000.
+// Endpoints are stored packed so the per-step lerp runs over active
+// entries only (and still takes mh_morph_lerp's vector path when the
+// set is large).
+struct MH_MorphPair
+{
+    int count = 0;                 // full snapshot length
+    std::vector<int>   indices;    // active set, ascending
+    std::vector<float> a;          // packed endpoints, indices order
+    std::vector<float> b;
+    std::vector<float> scratch;    // per-apply interpolation target
+};
+
+extern "C" MH_MorphPair* mh_morph_pair_create(const float* a, const float* b,
+                                              int count, float epsilon)
+{
+    if (!a || !b || count < 0 || epsilon < 0.0f) return nullptr;
+    auto* pair = new (std::nothrow) MH_MorphPair;
+    if (!pair) return nullptr;
+    pair->count = count;
+    for (int i = 0; i < count; ++i)
+    {
+        // epsilon 0 keeps the exact mh_params_diff comparison (snapshot
+        // values round-trip the plugin's quantization, so identical
+        // parameters compare bit-equal); a positive epsilon also drops
+        // parameters whose endpoints differ by no more than it.
+        if (std::abs(a[i] - b[i]) > epsilon)
+        {
+            pair->indices.push_back(i);
+            pair->a.push_back(a[i]);
+            pair->b.push_back(b[i]);
+        }
+    }
+    pair->scratch.resize(pair->indices.size());
+    return pair;
+}
 
-    // Name
-    auto name = param->getName(MH_PARAM_NAME_LEN - 1);
-    std::snprintf(out_info->name, MH_PARAM_NAME_LEN, "%s", name.toRawUTF8());
+extern "C" void mh_morph_pair_free(MH_MorphPair* pair)
+{
+    delete pair;
+}
 
-    // Stable parameter ID (via HostedAudioProcessorParameter)
-    auto* hosted = p->inst->getHostedParameter(index);
-    if (hosted)
-        std::snprintf(out_info->id, MH_PARAM_NAME_LEN, "%s", hosted->getParameterID().toRawUTF8());
-    else
-        out_info->id[0] = '\0';
+extern "C" int mh_morph_pair_active_count(const MH_MorphPair* pair)
+{
+    return pair ? (int) pair->indices.size() : -1;
+}
 
-    // Label (unit)
-    auto label = param->getLabel();
-    std::snprintf(out_info->label, MH_PARAM_NAME_LEN, "%s", label.toRawUTF8());
+extern "C" int mh_morph_pair_apply(MH_Plugin* p, MH_MorphPair* pair, float t)
+{
+    if (!p || !p->inst || !pair) return 0;
+    if (mh_get_num_params(p) != pair->count) return 0;
+    const int m = (int) pair->indices.size();
+    if (m == 0) return 1;  // identical snapshots: nothing to write
+    if (!mh_morph_lerp(pair->a.data(), pair->b.data(),
+                       pair->scratch.data(), m, t))
+        return 0;
+    return mh_set_params(p, pair->indices.data(), pair->scratch.data(), m);
+}
 
-    // Current value as display string
-    auto valueStr = param->getCurrentValueAsText();
-    std::snprintf(out_info->current_value_str, MH_PARAM_NAME_LEN, "%s", valueStr.toRawUTF8());
+extern "C" int mh_get_param_info(MH_Plugin* p, int index, MH_ParamInfo* out_info)
+{
+    if (!p || !p->inst || !out_info) return 0;
+    int result = 0;
+    runOnMsgFor(p, [&]()
+    {
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+    if (p->paramCacheDirty.exchange(false, std::memory_order_acquire))
+        rebuildParamInfoCache(p);
+    if (index < 0 || index >= (int) p->paramInfoCache.size()) return;
 
-    // Normalized range (always 0-1 for JUCE parameters)
-    out_info->min_value = 0.0f;
-    out_info->max_value = 1.0f;
-    out_info->default_value = param->getDefaultValue();
+    // Static fields from the cache; only the display string is live.
+    *out_info = p->paramInfoCache[(size_t) index];
 
-    // Discrete/continuous info
-    out_info->num_steps = param->isDiscrete() ? param->getNumSteps() : 0;
-    out_info->is_automatable = param->isAutomatable() ? 1 : 0;
-    out_info->is_boolean = param->isBoolean() ? 1 : 0;
-    out_info->category = static_cast<int>(param->getCategory());
+    auto& params = p->inst->getParameters();
+    if (index < params.size())
+    {
+        auto valueStr = params.getUnchecked(index)->getCurrentValueAsText();
+        std::snprintf(out_info->current_value_str, MH_PARAM_NAME_LEN, "%s",
+                      valueStr.toRawUTF8());
+    }
 
     result = 1;
     });
     return result;
 }
 
+extern "C" int mh_get_all_param_info(MH_Plugin* p, MH_ParamInfo* out_infos,
+                                     int capacity)
+{
+    if (!p || !p->inst || !out_infos) return -1;
+    int result = -1;
+    runOnMsgFor(p, [&]()
+    {
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+    if (p->paramCacheDirty.exchange(false, std::memory_order_acquire))
+        rebuildParamInfoCache(p);
+
+    const int n = (int) p->paramInfoCache.size();
+    if (capacity < n) return;
+
+    auto& params = p->inst->getParameters();
+    for (int i = 0; i < n; ++i)
+    {
+        out_infos[i] = p->paramInfoCache[(size_t) i];
+        if (i < params.size())
+        {
+            auto valueStr = params.getUnchecked(i)->getCurrentValueAsText();
+            std::snprintf(out_infos[i].current_value_str, MH_PARAM_NAME_LEN,
+                          "%s", valueStr.toRawUTF8());
+        }
+    }
+    result = n;
+    });
+    return result;
+}
+
+extern "C" int mh_find_param_by_id(MH_Plugin* p, const char* id)
+{
+    if (!p || !p->inst || !id || id[0] == '\0') return -1;
+    int result = -1;
+    runOnMsgFor(p, [&]()
+    {
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+    if (p->paramCacheDirty.exchange(false, std::memory_order_acquire))
+        rebuildParamInfoCache(p);
+
+    auto it = p->paramIdIndex.find(id);
+    if (it != p->paramIdIndex.end())
+        result = it->second;
+    });
+    return result;
+}
+
 extern "C" int mh_get_state_size(MH_Plugin* p)
 {
     if (!p || !p->inst) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         MemoryBlock mb;
@@ -802,7 +2227,7 @@ extern "C" int mh_get_state_size(MH_Plugin* p)
 extern "C" int mh_get_state(MH_Plugin* p, void* buffer, int buffer_size)
 {
     if (!p || !p->inst || !buffer || buffer_size <= 0) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         MemoryBlock mb;
@@ -816,10 +2241,36 @@ extern "C" int mh_get_state(MH_Plugin* p, void* buffer, int buffer_size)
     });
 }
 
+extern "C" int mh_get_state_alloc(MH_Plugin* p, void** out_data, int* out_size)
+{
+    if (out_data) *out_data = nullptr;
+    if (out_size) *out_size = 0;
+    if (!p || !p->inst || !out_data || !out_size) return 0;
+    return runOnMsgFor(p, [&]() -> int
+    {
+        std::lock_guard<std::mutex> lock(p->stateMutex);
+        MemoryBlock mb;
+        p->inst->getStateInformation(mb);
+        if (mb.getSize() == 0) return 0;
+
+        void* copy = std::malloc(mb.getSize());
+        if (!copy) return 0;
+        std::memcpy(copy, mb.getData(), mb.getSize());
+        *out_data = copy;
+        *out_size = (int) mb.getSize();
+        return 1;
+    });
+}
+
+extern "C" void mh_state_free(void* data)
+{
+    std::free(data);
+}
+
 extern "C" int mh_set_state(MH_Plugin* p, const void* data, int data_size)
 {
     if (!p || !p->inst || !data || data_size <= 0) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         p->inst->setStateInformation(data, data_size);
@@ -827,19 +2278,134 @@ extern "C" int mh_set_state(MH_Plugin* p, const void* data, int data_size)
     });
 }
 
-extern "C" int mh_set_transport(MH_Plugin* p, const MH_TransportInfo* transport)
+extern "C" int mh_restore_state(MH_Plugin* p,
+                                const void* state, int state_size,
+                                int program,
+                                const int* param_indices,
+                                const float* param_values,
+                                int param_count)
 {
-    if (!p) return 0;
+    if (!p || !p->inst) return 0;
+    if (state != nullptr && state_size <= 0) return 0;
+    if (param_count < 0) return 0;
+    if (param_count > 0 && (!param_indices || !param_values)) return 0;
+
+    // Queue the three restore steps as one message-thread submission:
+    // calling mh_set_state, mh_set_program and mh_set_params separately
+    // pays a cross-thread round trip per call.
+    int ok = 1;
+    std::function<void()> steps[3];
+    size_t n = 0;
+
+    if (state != nullptr)
+        steps[n++] = [&]()
+        {
+            std::lock_guard<std::mutex> lock(p->stateMutex);
+            p->inst->setStateInformation(state, state_size);
+        };
+
+    if (program >= 0)
+        steps[n++] = [&]()
+        {
+            std::lock_guard<std::mutex> lock(p->stateMutex);
+            if (program >= p->inst->getNumPrograms())
+                ok = 0;
+            else
+                p->inst->setCurrentProgram(program);
+        };
+
+    if (param_count > 0)
+        steps[n++] = [&]()
+        {
+            std::lock_guard<std::mutex> lock(p->stateMutex);
+            auto& params = p->inst->getParameters();
+            for (int i = 0; i < param_count; ++i)
+            {
+                const int idx = param_indices[i];
+                if (idx < 0 || idx >= params.size())
+                {
+                    ok = 0;
+                    continue;
+                }
+                params.getUnchecked(idx)->setValueNotifyingHost(
+                    jlimit(0.0f, 1.0f, param_values[i]));
+            }
+        };
+
+    if (n == 0)
+        return 1;   // nothing to apply
+
+    if (p->pump >= 0)
+        MinihostWorkerPumps::instance().run(p->pump, [&]()
+        {
+            for (size_t i = 0; i < n; ++i)
+                steps[i]();
+        });
+    else
+        MinihostMessageThread::instance().runBatch(steps, n);
+    return ok;
+}
+
+extern "C" int mh_get_states_alloc(MH_Plugin* const* plugins, int count,
+                                   void** out_datas, int* out_sizes)
+{
+    if (!plugins || count <= 0 || !out_datas || !out_sizes) return 0;
+    for (int i = 0; i < count; ++i)
+    {
+        out_datas[i] = nullptr;
+        out_sizes[i] = 0;
+    }
+
+    // One submission per marshalling thread captures every plugin. With
+    // the single message thread the serializations still run back to
+    // back -- plugin state calls are thread-affine, so there is no
+    // second thread they could run on -- but the caller pays one
+    // cross-thread hop (and can pause audio once around the whole
+    // batch) instead of one per plugin. In multi-pump mode the groups
+    // pinned to different pumps serialize concurrently.
+    std::atomic<int> captured{0};
+    runPerPump(plugins, count, [&](int i)
+    {
+        MH_Plugin* p = plugins[i];
+        if (!p || !p->inst) return;
+        std::lock_guard<std::mutex> lock(p->stateMutex);
+        MemoryBlock mb;
+        p->inst->getStateInformation(mb);
+        if (mb.getSize() == 0) return;
+        void* copy = std::malloc(mb.getSize());
+        if (!copy) return;
+        std::memcpy(copy, mb.getData(), mb.getSize());
+        out_datas[i] = copy;
+        out_sizes[i] = (int) mb.getSize();
+        captured.fetch_add(1, std::memory_order_relaxed);
+    });
+    return captured.load();
+}
+
+extern "C" int mh_set_states(MH_Plugin* const* plugins, int count,
+                             const void* const* datas, const int* sizes)
+{
+    if (!plugins || count <= 0 || !datas || !sizes) return 0;
+    std::atomic<int> restored{0};
+    runPerPump(plugins, count, [&](int i)
+    {
+        MH_Plugin* p = plugins[i];
+        if (!p || !p->inst || !datas[i] || sizes[i] <= 0) return;
+        std::lock_guard<std::mutex> lock(p->stateMutex);
+        p->inst->setStateInformation(datas[i], sizes[i]);
+        restored.fetch_add(1, std::memory_order_relaxed);
+    });
+    return restored.load();
+}
 
+static MH_TransportState transportToState(const MH_TransportInfo* transport)
+{
+    MH_TransportState s;
     if (!transport)
     {
-        MH_PlayHead::State s;
         s.hasTransport = false;
-        p->playHead.write(s);
-        return 1;
+        return s;
     }
-
-    MH_PlayHead::State s;
     s.hasTransport = true;
     s.bpm = transport->bpm;
     s.timeSigNum = transport->time_sig_numerator;
@@ -851,8 +2417,38 @@ extern "C" int mh_set_transport(MH_Plugin* p, const MH_TransportInfo* transport)
     s.isLooping = transport->is_looping != 0;
     s.loopStartSamples = transport->loop_start_samples;
     s.loopEndSamples = transport->loop_end_samples;
-    p->playHead.write(s);
+    return s;
+}
+
+extern "C" int mh_set_transport(MH_Plugin* p, const MH_TransportInfo* transport)
+{
+    if (!p) return 0;
+    p->playHead.write(transportToState(transport));
+    return 1;
+}
+
+extern "C" MH_SharedTransport* mh_shared_transport_create(void)
+{
+    return new MH_SharedTransport();
+}
+
+extern "C" void mh_shared_transport_free(MH_SharedTransport* st)
+{
+    delete st;
+}
+
+extern "C" int mh_shared_transport_write(MH_SharedTransport* st,
+                                         const MH_TransportInfo* transport)
+{
+    if (!st) return 0;
+    st->cell.write(transportToState(transport));
+    return 1;
+}
 
+extern "C" int mh_set_transport_shared(MH_Plugin* p, MH_SharedTransport* st)
+{
+    if (!p) return 0;
+    p->playHead.attachShared(st);
     return 1;
 }
 
@@ -913,7 +2509,11 @@ extern "C" int mh_process_auto(MH_Plugin* p,
                                int num_param_changes)
 {
     if (!p || !p->inst) return 0;
-    if (nframes < 0 || nframes > p->maxBlockSize) return 0;
+    if (nframes < 0) return 0;
+
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(
+        p->denormalControl.load(std::memory_order_relaxed) != 0);
 
     // Initialize MIDI output count
     if (num_midi_out)
@@ -928,6 +2528,78 @@ extern "C" int mh_process_auto(MH_Plugin* p,
                                   midi_out, midi_out_capacity, num_midi_out);
     }
 
+    // Block-rate mode: apply every change up front (in order, so the last
+    // change to a parameter wins) and process the whole block in one call.
+    if (p->autoBlockRate.load(std::memory_order_relaxed) == MH_AUTOMATION_BLOCK_RATE)
+    {
+        auto& params = p->inst->getParameters();
+        for (int i = 0; i < num_param_changes; ++i)
+        {
+            const auto& pc = param_changes[i];
+            if (pc.param_index >= 0 && pc.param_index < params.size())
+            {
+                if (isSmoothedParam(p, pc.param_index))
+                {
+                    smootherSetTarget(p, pc.param_index, pc.value);
+                    continue;
+                }
+                float val = jlimit(0.0f, 1.0f, pc.value);
+                params.getUnchecked(pc.param_index)->setValueNotifyingHost(val);
+            }
+        }
+        // mh_process_midi_io advances the smoothing ramps.
+        return mh_process_midi_io(p, inputs, outputs, nframes,
+                                  midi_in, num_midi_in,
+                                  midi_out, midi_out_capacity, num_midi_out);
+    }
+
+    // Smoothed parameters never split the block: their changes become
+    // ramp targets up front (in order, last writer wins) and are skipped
+    // by the chunking below; the ramps then advance one step for the
+    // whole block. When every change this block is smoothed, the loop
+    // degenerates to a single full-size processBlock call.
+    bool any_unsmoothed = false;
+    if (p->smootherCount.load(std::memory_order_acquire) > 0)
+    {
+        for (int i = 0; i < num_param_changes; ++i)
+        {
+            const auto& pc = param_changes[i];
+            if (isSmoothedParam(p, pc.param_index))
+                smootherSetTarget(p, pc.param_index, pc.value);
+            else
+                any_unsmoothed = true;
+        }
+    }
+    else
+    {
+        any_unsmoothed = num_param_changes > 0;
+    }
+    if (!any_unsmoothed)
+    {
+        // Every change was routed to a ramp: hand the intact block to
+        // the plain path, which advances the ramps itself.
+        return mh_process_midi_io(p, inputs, outputs, nframes,
+                                  midi_in, num_midi_in,
+                                  midi_out, midi_out_capacity, num_midi_out);
+    }
+    advanceSmoothers(p, nframes);
+
+    // Coalesce change offsets to the nearest multiple of minSub so dense
+    // automation never splits the block into processBlock calls shorter
+    // than minSub frames. Rounding up past the end of the block would
+    // silently drop the change (callers don't re-send), so offsets are
+    // clamped to the last boundary inside the block. minSub == 1 keeps
+    // offsets exactly as given. Rounding is monotonic, so a sorted change
+    // list stays sorted after coalescing.
+    const int minSub = jmax(1, p->autoMinSubblock.load(std::memory_order_relaxed));
+    const int last_boundary = ((nframes - 1) / minSub) * minSub;
+    auto coalesce = [minSub, last_boundary](int offset)
+    {
+        if (minSub <= 1)
+            return offset;
+        return jmin(((offset + minSub / 2) / minSub) * minSub, last_boundary);
+    };
+
     // Process in chunks, applying parameter changes at the right sample positions
     int current_sample = 0;
     int midi_idx = 0;
@@ -942,11 +2614,14 @@ extern "C" int mh_process_auto(MH_Plugin* p,
         // chunk, chunk_end jumps to nframes, and any later change in this
         // block is silently dropped.
         while (param_idx < num_param_changes &&
-               param_changes[param_idx].sample_offset <= current_sample)
+               coalesce(param_changes[param_idx].sample_offset) <= current_sample)
         {
             const auto& pc = param_changes[param_idx];
             auto& params = p->inst->getParameters();
-            if (pc.param_index >= 0 && pc.param_index < params.size())
+            // Smoothed parameters were routed to their ramps up front;
+            // their entries are consumed here without a set.
+            if (pc.param_index >= 0 && pc.param_index < params.size()
+                && !isSmoothedParam(p, pc.param_index))
             {
                 float val = jlimit(0.0f, 1.0f, pc.value);
                 params.getUnchecked(pc.param_index)->setValueNotifyingHost(val);
@@ -954,19 +2629,33 @@ extern "C" int mh_process_auto(MH_Plugin* p,
             ++param_idx;
         }
 
-        // Chunk boundary = the next still-pending change, or end of buffer.
+        // Chunk boundary = the next still-pending UNSMOOTHED change, or
+        // end of buffer -- smoothed changes never split the block.
         int chunk_end = nframes;
-        if (param_idx < num_param_changes)
+        for (int j = param_idx; j < num_param_changes; ++j)
         {
-            int next_change = param_changes[param_idx].sample_offset;
+            if (isSmoothedParam(p, param_changes[j].param_index))
+                continue;
+            int next_change = coalesce(param_changes[j].sample_offset);
             if (next_change > current_sample && next_change < chunk_end)
                 chunk_end = next_change;
+            break;
         }
 
         int chunk_size = chunk_end - current_sample;
         if (chunk_size <= 0)
             break;
 
+        // Never hand the plugin more than it was prepared for: blocks
+        // larger than maxBlockSize are sub-blocked here just as in
+        // mh_process_midi_io (pending changes simply land in a later
+        // pass of this loop).
+        if (chunk_size > p->maxBlockSize)
+        {
+            chunk_size = p->maxBlockSize;
+            chunk_end = current_sample + chunk_size;
+        }
+
         // Stage chunk inputs into the combined processBuf. Same pattern as
         // mh_process_midi_io: copy main inputs to the first inCh channels,
         // zero any output-only channels above inCh.
@@ -1041,13 +2730,83 @@ extern "C" int mh_process_auto(MH_Plugin* p,
     if (num_midi_out)
         *num_midi_out = midi_out_idx;
 
+    if (denormalScope.hit())
+        p->denormalHits.fetch_add(1, std::memory_order_relaxed);
+
+    return 1;
+}
+
+extern "C" int mh_set_automation_granularity(MH_Plugin* p, int min_subblock_frames, int mode)
+{
+    if (!p) return 0;
+    if (min_subblock_frames < 1) return 0;
+    if (mode != MH_AUTOMATION_SAMPLE_ACCURATE && mode != MH_AUTOMATION_BLOCK_RATE)
+        return 0;
+    p->autoMinSubblock.store(min_subblock_frames, std::memory_order_relaxed);
+    p->autoBlockRate.store(mode, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_get_automation_granularity(MH_Plugin* p, int* min_subblock_frames, int* mode)
+{
+    if (!p) return 0;
+    if (min_subblock_frames)
+        *min_subblock_frames = p->autoMinSubblock.load(std::memory_order_relaxed);
+    if (mode)
+        *mode = p->autoBlockRate.load(std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_set_param_smoothing(MH_Plugin* p, int param_index,
+                                      float ramp_ms, int mode)
+{
+    if (!p || !p->inst) return 0;
+    if (mode != MH_SMOOTH_LINEAR && mode != MH_SMOOTH_EXPONENTIAL) return 0;
+
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+    auto& params = p->inst->getParameters();
+    if (param_index < 0 || param_index >= params.size()) return 0;
+
+    if (!p->smoothers)
+    {
+        // Allocate once, sized to the full parameter set; the release
+        // store of the count publishes the array to the audio thread.
+        p->smoothers.reset(
+            new MH_Plugin::ParamSmoother[(size_t) params.size()]);
+        p->smootherCount.store(params.size(), std::memory_order_release);
+    }
+    // Parameters added after the allocation (parameterInfoChanged) have
+    // no smoother slot and stay unsmoothed.
+    if (param_index >= p->smootherCount.load(std::memory_order_relaxed))
+        return 0;
+
+    auto& s = p->smoothers[(size_t) param_index];
+    const float cur = params.getUnchecked(param_index)->getValue();
+    s.current.store(cur, std::memory_order_relaxed);
+    s.target.store(cur, std::memory_order_relaxed);
+    s.active.store(0, std::memory_order_relaxed);
+    s.mode.store(mode, std::memory_order_relaxed);
+    s.rampMs.store(ramp_ms, std::memory_order_release);
+    return 1;
+}
+
+extern "C" int mh_get_param_smoothing(MH_Plugin* p, int param_index,
+                                      float* ramp_ms, int* mode)
+{
+    if (!p) return 0;
+    if (param_index < 0
+        || param_index >= p->smootherCount.load(std::memory_order_acquire))
+        return 0;
+    auto& s = p->smoothers[(size_t) param_index];
+    if (ramp_ms) *ramp_ms = s.rampMs.load(std::memory_order_relaxed);
+    if (mode)    *mode    = s.mode.load(std::memory_order_relaxed);
     return 1;
 }
 
 extern "C" int mh_reset(MH_Plugin* p)
 {
     if (!p || !p->inst) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         p->inst->reset();
@@ -1058,7 +2817,7 @@ extern "C" int mh_reset(MH_Plugin* p)
 extern "C" int mh_set_non_realtime(MH_Plugin* p, int non_realtime)
 {
     if (!p || !p->inst) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         p->inst->setNonRealtime(non_realtime != 0);
@@ -1066,6 +2825,112 @@ extern "C" int mh_set_non_realtime(MH_Plugin* p, int non_realtime)
     });
 }
 
+extern "C" int mh_warmup(MH_Plugin* p, int blocks)
+{
+    if (!p || !p->inst) return 0;
+    if (blocks < 1) return 0;
+
+    // Non-realtime for the warm passes: glitches don't matter here, and
+    // plugins that defer table builds to their offline path still get
+    // them done now.
+    const bool wasNonRealtime = p->inst->isNonRealtime();
+    if (!wasNonRealtime) mh_set_non_realtime(p, 1);
+
+    // NULL in/out: mh_process_midi_io feeds silence and discards the
+    // output, so no scratch buffers are needed. Full-size blocks touch
+    // the whole prepared working set, pre-faulting its pages.
+    int ok = 1;
+    for (int i = 0; i < blocks && ok; ++i)
+        ok = mh_process_midi_io(p, nullptr, nullptr, p->maxBlockSize,
+                                nullptr, 0, nullptr, 0, nullptr);
+
+    // Clear whatever tail/filter state the warm blocks built up so the
+    // first real block starts from silence.
+    mh_reset(p);
+    if (!wasNonRealtime) mh_set_non_realtime(p, 0);
+    return ok;
+}
+
+extern "C" int mh_set_lock_memory(MH_Plugin* p, int enabled)
+{
+    if (!p) return 0;
+#if defined(_WIN32)
+    (void) enabled;
+    return 0;
+#else
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+
+    // The pinnable host-side ranges: every channel of the float process
+    // buffer and its double mirror, maxBlockSize frames each -- the
+    // pages the copy-in/copy-out path touches on every callback.
+    // Plugin-internal state cannot be enumerated from here; mh_warmup
+    // covers pre-faulting it.
+    struct Range { void* ptr; size_t bytes; };
+    std::vector<Range> ranges;
+    const size_t fbytes
+        = (size_t) p->processBuf.getNumSamples() * sizeof(float);
+    for (int c = 0; c < p->processBuf.getNumChannels(); ++c)
+        ranges.push_back({ p->processBuf.getWritePointer(c), fbytes });
+    const size_t dbytes
+        = (size_t) p->processBufD.getNumSamples() * sizeof(double);
+    for (int c = 0; c < p->processBufD.getNumChannels(); ++c)
+        ranges.push_back({ p->processBufD.getWritePointer(c), dbytes });
+
+    if (!enabled)
+    {
+        if (p->lockedBytes > 0)
+            for (auto& r : ranges)
+                if (r.bytes > 0) munlock(r.ptr, r.bytes);
+        p->lockedBytes = 0;
+        return 1;
+    }
+
+    if (p->lockedBytes > 0) return 1;  // already pinned
+
+    // All-or-nothing: a half-pinned buffer reports misleading residency
+    // figures, so roll back on the first refusal (RLIMIT_MEMLOCK).
+    size_t total = 0;
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+        if (ranges[i].bytes == 0) continue;
+        if (mlock(ranges[i].ptr, ranges[i].bytes) != 0)
+        {
+            for (size_t j = 0; j < i; ++j)
+                if (ranges[j].bytes > 0)
+                    munlock(ranges[j].ptr, ranges[j].bytes);
+            return 0;
+        }
+        total += ranges[i].bytes;
+    }
+    p->lockedBytes = total;
+    return 1;
+#endif
+}
+
+extern "C" long long mh_get_locked_bytes(MH_Plugin* p)
+{
+    if (!p) return -1;
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+    return (long long) p->lockedBytes;
+}
+
+extern "C" int mh_set_denormal_control(MH_Plugin* p, int enabled)
+{
+    if (!p) return 0;
+    p->denormalControl.store(enabled ? 1 : 0, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_get_denormal_control(MH_Plugin* p)
+{
+    return p ? p->denormalControl.load(std::memory_order_relaxed) : 0;
+}
+
+extern "C" unsigned long long mh_get_denormal_hits(MH_Plugin* p)
+{
+    return p ? p->denormalHits.load(std::memory_order_relaxed) : 0;
+}
+
 // Populate a format manager with all supported plugin formats.
 static void initFormatManager(AudioPluginFormatManager& fm)
 {
@@ -1163,10 +3028,81 @@ extern "C" int mh_probe(const char* plugin_path,
     return probeWithFm(fm, plugin_path, out_desc, err_buf, err_buf_size);
 }
 
+extern "C" int mh_probe_batch(const char* const* paths,
+                              int count,
+                              MH_ProbeResult* results,
+                              int concurrency)
+{
+    if (!paths || !results || count < 0)
+        return -1;
+    if (count == 0)
+        return 0;
+
+    std::atomic<int> okCount{0};
+
+    auto probeOne = [&](AudioPluginFormatManager& fm, int i)
+    {
+        MH_ProbeResult& r = results[i];
+        std::memset(&r, 0, sizeof(r));
+        if (probeWithFm(fm, paths[i], &r.desc, r.error, sizeof(r.error)))
+        {
+            // probeWithFm leaves desc.path empty (mh_probe callers know
+            // the path they passed); batch results travel further, so
+            // fill it in like the directory scanners do.
+            std::snprintf(r.desc.path, sizeof(r.desc.path), "%s", paths[i]);
+            r.ok = 1;
+            okCount.fetch_add(1);
+        }
+    };
+
+    if (concurrency > 64) concurrency = 64;
+    if (concurrency > count) concurrency = count;
+    if (concurrency <= 1)
+    {
+        // Serial path still amortizes one format manager over the list.
+        AudioPluginFormatManager fm;
+        initFormatManager(fm);
+        for (int i = 0; i < count; ++i)
+            probeOne(fm, i);
+        return okCount.load();
+    }
+
+    // Same worker pattern as mh_session_scan_directory_mt: indices come
+    // from a shared counter so one slow bundle does not serialize the
+    // rest, and each worker owns its format manager. Every worker
+    // writes disjoint entries of results[], so no locking is needed.
+    std::atomic<int> nextIndex{0};
+    auto worker = [&]()
+    {
+        AudioPluginFormatManager fm;
+        initFormatManager(fm);
+        for (;;)
+        {
+            const int i = nextIndex.fetch_add(1);
+            if (i >= count)
+                return;
+            probeOne(fm, i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve((size_t) concurrency);
+    for (int t = 0; t < concurrency; ++t)
+        threads.emplace_back([&worker]
+        {
+            mh_thread_policy_apply(MH_THREAD_ROLE_LOADER);
+            worker();
+        });
+    for (auto& th : threads)
+        th.join();
+
+    return okCount.load();
+}
+
 extern "C" int mh_param_to_text(MH_Plugin* p, int index, float value, char* buf, size_t buf_size)
 {
     if (!p || !p->inst || !buf || buf_size == 0) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         auto& params = p->inst->getParameters();
@@ -1182,10 +3118,39 @@ extern "C" int mh_param_to_text(MH_Plugin* p, int index, float value, char* buf,
     });
 }
 
-extern "C" int mh_param_from_text(MH_Plugin* p, int index, const char* text, float* out_value)
+extern "C" int mh_params_to_text_bulk(MH_Plugin* p, const int* indices,
+                                      const float* values, int count,
+                                      char* out, size_t stride)
 {
-    if (!p || !p->inst || !text || !out_value) return 0;
-    return runOnMsg([&]() -> int
+    if (!p || !p->inst || !indices || !values || !out || count < 0 || stride == 0)
+        return 0;
+    return runOnMsgFor(p, [&]() -> int
+    {
+        // One message-thread hop and one lock for the whole batch --
+        // refreshing a large parameter panel one mh_param_to_text call
+        // at a time pays both costs per parameter.
+        std::lock_guard<std::mutex> lock(p->stateMutex);
+        auto& params = p->inst->getParameters();
+        for (int i = 0; i < count; ++i)
+        {
+            char* buf = out + (size_t) i * stride;
+            buf[0] = '\0';
+            const int index = indices[i];
+            if (index < 0 || index >= params.size()) continue;
+
+            auto* param = params.getUnchecked(index);
+            const float value = jlimit(0.0f, 1.0f, values[i]);
+            String text = param->getText(value, static_cast<int>(stride) - 1);
+            std::snprintf(buf, stride, "%s", text.toRawUTF8());
+        }
+        return 1;
+    });
+}
+
+extern "C" int mh_param_from_text(MH_Plugin* p, int index, const char* text, float* out_value)
+{
+    if (!p || !p->inst || !text || !out_value) return 0;
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         auto& params = p->inst->getParameters();
@@ -1202,7 +3167,7 @@ extern "C" int mh_param_from_text(MH_Plugin* p, int index, const char* text, flo
 extern "C" int mh_get_num_programs(MH_Plugin* p)
 {
     if (!p || !p->inst) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         return p->inst->getNumPrograms();
@@ -1212,7 +3177,7 @@ extern "C" int mh_get_num_programs(MH_Plugin* p)
 extern "C" int mh_get_program_name(MH_Plugin* p, int index, char* buf, size_t buf_size)
 {
     if (!p || !p->inst || !buf || buf_size == 0) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         int numPrograms = p->inst->getNumPrograms();
@@ -1227,7 +3192,7 @@ extern "C" int mh_get_program_name(MH_Plugin* p, int index, char* buf, size_t bu
 extern "C" int mh_get_program(MH_Plugin* p)
 {
     if (!p || !p->inst) return -1;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         return p->inst->getCurrentProgram();
@@ -1237,7 +3202,7 @@ extern "C" int mh_get_program(MH_Plugin* p)
 extern "C" int mh_set_program(MH_Plugin* p, int index)
 {
     if (!p || !p->inst) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         int numPrograms = p->inst->getNumPrograms();
@@ -1248,6 +3213,74 @@ extern "C" int mh_set_program(MH_Plugin* p, int index)
     });
 }
 
+extern "C" int mh_prefetch_programs(MH_Plugin* p)
+{
+    if (!p || !p->inst) return 0;
+    return runOnMsgFor(p, [&]() -> int
+    {
+        std::lock_guard<std::mutex> lock(p->stateMutex);
+        const int numPrograms = p->inst->getNumPrograms();
+        if (numPrograms <= 0) return 0;
+
+        const int original = p->inst->getCurrentProgram();
+
+        // Walk every program once through the ordinary (slow) switch
+        // path and capture its state blob. Afterwards a switch is a
+        // cached-blob restore instead of a re-deserialization.
+        p->programCache.assign((size_t) numPrograms, MemoryBlock());
+        for (int i = 0; i < numPrograms; ++i)
+        {
+            p->inst->setCurrentProgram(i);
+            p->inst->getCurrentProgramStateInformation(
+                p->programCache[(size_t) i]);
+        }
+
+        // Restore the originally selected program (fast, from the
+        // blob we just captured).
+        if (original >= 0 && original < numPrograms)
+        {
+            p->inst->setCurrentProgram(original);
+            const MemoryBlock& mb = p->programCache[(size_t) original];
+            if (mb.getSize() > 0)
+                p->inst->setCurrentProgramStateInformation(
+                    mb.getData(), (int) mb.getSize());
+        }
+        return numPrograms;
+    });
+}
+
+extern "C" int mh_set_program_fast(MH_Plugin* p, int index)
+{
+    if (!p || !p->inst) return 0;
+    return runOnMsgFor(p, [&]() -> int
+    {
+        std::lock_guard<std::mutex> lock(p->stateMutex);
+        if (index < 0 || index >= (int) p->programCache.size()) return 0;
+
+        const MemoryBlock& mb = p->programCache[(size_t) index];
+        if (mb.getSize() == 0) return 0;
+
+        // Restore straight from the cached blob -- the program-change
+        // machinery (and its per-switch re-deserialization) is skipped
+        // entirely. The blob carries the sound; plugins that encode
+        // the program number in their program state will also update
+        // their selector, others may keep reporting the old index via
+        // mh_get_program (documented in the header).
+        p->inst->setCurrentProgramStateInformation(
+            mb.getData(), (int) mb.getSize());
+        return 1;
+    });
+}
+
+extern "C" int mh_clear_program_cache(MH_Plugin* p)
+{
+    if (!p) return 0;
+    std::lock_guard<std::mutex> lock(p->stateMutex);
+    p->programCache.clear();
+    p->programCache.shrink_to_fit();
+    return 1;
+}
+
 extern "C" int mh_get_num_buses(MH_Plugin* p, int is_input)
 {
     if (!p || !p->inst) return 0;
@@ -1343,6 +3376,16 @@ static MH_Plugin* finishPluginFromDesc(AudioPluginFormatManager& fm,
 
     p->inst = std::move(inst);
     p->inst->addListener(&p->listener);
+
+    // Capture static parameter metadata while already on the message
+    // thread; parameter queries then serve from the cache.
+    rebuildParamInfoCache(p.get());
+
+    // Idempotent by name, so repeated opens just re-fetch the handle.
+    g_plugin_blocks_metric.store(
+        mh_metric_register("plugin.blocks_processed", MH_METRIC_COUNTER),
+        std::memory_order_relaxed);
+
     return p.release();
 }
 
@@ -1389,17 +3432,27 @@ static MH_Plugin* createPluginFromDescXml_impl(AudioPluginFormatManager& fm,
                                 sidechain_in_ch, err_buf, err_buf_size);
 }
 
-// Plugin-construction core. Takes an already-initialized format manager
+// Plugin construction. Takes an already-initialized format manager
 // (caller's responsibility) so a session can pass its shared manager.
-static MH_Plugin* createPluginWithFm_impl(AudioPluginFormatManager& fm,
-                                      const char* plugin_path,
-                                      double sample_rate,
-                                      int max_block_size,
-                                      int main_in_ch,
-                                      int main_out_ch,
-                                      int sidechain_in_ch,
-                                      char* err_buf,
-                                      size_t err_buf_size)
+//
+// Split across threads: module discovery (findFirstTypeForFile -- the
+// dlopen, binary read, and factory scan, which dominate a cold load) is
+// not thread-affine and runs right here on the caller, exactly as
+// probeWithFm already does from arbitrary threads. Only the genuinely
+// JUCE-affine part -- instance construction and prepareToPlay in
+// finishPluginFromDesc -- marshals to the plugin thread. Concurrent
+// callers (e.g. a project opening all its plugins at once) therefore
+// overlap the expensive disk/relink work instead of serializing the
+// whole load behind one thread.
+static MH_Plugin* createPluginWithFm(AudioPluginFormatManager& fm,
+                                     const char* plugin_path,
+                                     double sample_rate,
+                                     int max_block_size,
+                                     int main_in_ch,
+                                     int main_out_ch,
+                                     int sidechain_in_ch,
+                                     char* err_buf,
+                                     size_t err_buf_size)
 {
     if (plugin_path == nullptr || plugin_path[0] == '\0')
     {
@@ -1407,61 +3460,48 @@ static MH_Plugin* createPluginWithFm_impl(AudioPluginFormatManager& fm,
         return nullptr;
     }
 
-    std::unique_ptr<MH_Plugin> p(new MH_Plugin());
-    p->sampleRate = sample_rate;
-    p->maxBlockSize = max_block_size;
-    p->path = plugin_path;
-
     File f(String::fromUTF8(plugin_path));
     if (! f.exists())
     {
+        // Fails fast, inline, without ever creating the JUCE
+        // MessageManager. This keeps a process that never successfully
+        // loads a plugin -- e.g. CI, or an app probing a bad path --
+        // from leaving a thread + MessageManager alive that deadlocks
+        // process exit on Linux.
         setErr(err_buf, err_buf_size, "Plugin file does not exist: " + f.getFullPathName());
         return nullptr;
     }
 
+    std::unique_ptr<MH_Plugin> p(new MH_Plugin());
+    p->sampleRate = sample_rate;
+    p->maxBlockSize = max_block_size;
+    p->path = plugin_path;
+
     PluginDescription desc;
     String err;
-    if (! findFirstTypeForFile(fm, f, desc, err))
+    if (! findFirstTypeForFileCached(fm, f, desc, err))
     {
         setErr(err_buf, err_buf_size, err);
         return nullptr;
     }
 
-    return finishPluginFromDesc(fm, desc, std::move(p), sample_rate,
-                                max_block_size, main_in_ch, main_out_ch,
-                                sidechain_in_ch, err_buf, err_buf_size);
-}
+    // Lazily bring up the plugin thread on the first real load. The
+    // MessageManager must exist even in multi-pump mode -- JUCE's
+    // bookkeeping needs one per process -- so this always runs first.
+    MinihostMessageThread::instance().init();
 
-// Thread-marshaling wrapper: run construction on the JUCE plugin thread when
-// enabled, else inline on the caller's thread (default when disabled).
-static MH_Plugin* createPluginWithFm(AudioPluginFormatManager& fm,
-                                     const char* plugin_path,
-                                     double sample_rate,
-                                     int max_block_size,
-                                     int main_in_ch,
-                                     int main_out_ch,
-                                     int sidechain_in_ch,
-                                     char* err_buf,
-                                     size_t err_buf_size)
-{
-    // Lazily bring up the plugin thread on the first *real* load, but only if
-    // the plugin actually exists. This keeps a process that never
-    // successfully loads a plugin -- e.g. CI, or an app probing a bad path --
-    // from ever creating the JUCE MessageManager (which otherwise leaves a
-    // thread + MessageManager alive that deadlocks process exit on Linux).
-    // A nonexistent path then fails fast, inline, exactly as before.
-    const bool pluginExists =
-        plugin_path && plugin_path[0] != '\0'
-        && juce::File(juce::String::fromUTF8(plugin_path)).exists();
-    if (pluginExists)
-        MinihostMessageThread::instance().init();
+    // Pin the plugin to a worker pump when multi-pump mode is active
+    // (-1 otherwise): construction then runs on the pinned thread, and
+    // every later thread-affine call follows it there via runOnMsgFor.
+    p->pump = MinihostWorkerPumps::instance().assign();
+    MH_Plugin* const raw = p.get();
 
     MH_Plugin* result = nullptr;
-    MinihostMessageThread::instance().run([&]()
+    runOnMsgFor(raw, [&]()
     {
-        result = createPluginWithFm_impl(fm, plugin_path, sample_rate,
-                                         max_block_size, main_in_ch, main_out_ch,
-                                         sidechain_in_ch, err_buf, err_buf_size);
+        result = finishPluginFromDesc(fm, desc, std::move(p), sample_rate,
+                                      max_block_size, main_in_ch, main_out_ch,
+                                      sidechain_in_ch, err_buf, err_buf_size);
     });
     return result;
 }
@@ -1500,14 +3540,25 @@ static MH_Plugin* createPluginFromDescWithFm(AudioPluginFormatManager& fm,
 {
     MinihostMessageThread::instance().init();
 
+    // Same pump pinning as the path-based wrapper: pick the pump first,
+    // construct on it, then record the pin on the finished instance
+    // (the MH_Plugin only exists inside the impl call).
+    const int pump = MinihostWorkerPumps::instance().assign();
+
     MH_Plugin* result = nullptr;
-    MinihostMessageThread::instance().run([&]()
+    const std::function<void()> build = [&]()
     {
         result = createPluginFromDescXml_impl(fm, pd_xml, sample_rate,
                                               max_block_size, main_in_ch,
                                               main_out_ch, sidechain_in_ch,
                                               err_buf, err_buf_size);
-    });
+    };
+    if (pump >= 0)
+        MinihostWorkerPumps::instance().run(pump, build);
+    else
+        MinihostMessageThread::instance().run(build);
+    if (result != nullptr)
+        result->pump = pump;
     return result;
 }
 
@@ -1528,15 +3579,27 @@ extern "C" MH_Plugin* mh_open_desc(const char* pd_xml,
                                       err_buf, err_buf_size);
 }
 
-extern "C" int mh_process_sidechain(MH_Plugin* p,
-                                    const float* const* main_in,
-                                    float* const* main_out,
-                                    const float* const* sidechain_in,
-                                    int nframes)
+// Shared body of mh_process_sidechain / mh_process_sidechain_midi.
+static int processSidechainImpl(MH_Plugin* p,
+                                const float* const* main_in,
+                                float* const* main_out,
+                                const float* const* sidechain_in,
+                                int nframes,
+                                const MH_MidiEvent* midi_events,
+                                int num_midi_events)
 {
     if (!p || !p->inst) return 0;
     if (nframes < 0 || nframes > p->maxBlockSize) return 0;
 
+    // Pick up a staged standby swap at the block boundary.
+    adoptStandby(p);
+
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(
+        p->denormalControl.load(std::memory_order_relaxed) != 0);
+
+    advanceSmoothers(p, nframes);
+
     // Use the pre-allocated combined processBuf (sized in mh_open_ex to
     // max(inCh + sidechainCh, outCh)) to avoid per-call heap allocation.
     auto& buffer = p->processBuf;
@@ -1572,8 +3635,19 @@ extern "C" int mh_process_sidechain(MH_Plugin* p,
     for (int ch = totalInCh; ch < totalCh; ++ch)
         buffer.clear(ch, 0, nframes);
 
-    // Clear MIDI buffer
+    // Build the MIDI input buffer (empty for the no-MIDI entry point).
     p->midi.clear();
+    if (midi_events && num_midi_events > 0)
+    {
+        for (int i = 0; i < num_midi_events; ++i)
+        {
+            const auto& ev = midi_events[i];
+            int samplePos = jlimit(0, nframes > 0 ? nframes - 1 : 0,
+                                   ev.sample_offset);
+            p->midi.addEvent(MidiMessage(ev.status, ev.data1, ev.data2),
+                             samplePos);
+        }
+    }
 
     // Process
     p->inst->processBlock(buffer, p->midi);
@@ -1585,6 +3659,110 @@ extern "C" int mh_process_sidechain(MH_Plugin* p,
             std::memcpy(main_out[ch], buffer.getReadPointer(ch), sizeof(float) * nframes);
     }
 
+    if (denormalScope.hit())
+        p->denormalHits.fetch_add(1, std::memory_order_relaxed);
+
+    return 1;
+}
+
+extern "C" int mh_process_sidechain(MH_Plugin* p,
+                                    const float* const* main_in,
+                                    float* const* main_out,
+                                    const float* const* sidechain_in,
+                                    int nframes)
+{
+    return processSidechainImpl(p, main_in, main_out, sidechain_in,
+                                nframes, nullptr, 0);
+}
+
+extern "C" int mh_process_sidechain_midi(MH_Plugin* p,
+                                         const float* const* main_in,
+                                         float* const* main_out,
+                                         const float* const* sidechain_in,
+                                         int nframes,
+                                         const MH_MidiEvent* midi_events,
+                                         int num_midi_events)
+{
+    return processSidechainImpl(p, main_in, main_out, sidechain_in,
+                                nframes, midi_events, num_midi_events);
+}
+
+extern "C" int mh_process_multibus(MH_Plugin* p,
+                                   const float* const* inputs,
+                                   float* const* const* bus_outputs,
+                                   int num_buses,
+                                   int nframes,
+                                   const MH_MidiEvent* midi_events,
+                                   int num_midi_events)
+{
+    if (!p || !p->inst) return 0;
+    if (nframes < 0 || nframes > p->maxBlockSize) return 0;
+    if (num_buses < 0 || !bus_outputs) return 0;
+
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(
+        p->denormalControl.load(std::memory_order_relaxed) != 0);
+
+    advanceSmoothers(p, nframes);
+
+    auto& buffer = p->processBuf;
+    const int totalCh = buffer.getNumChannels();
+    const size_t bytes = sizeof(float) * (size_t) nframes;
+    buffer.setSize(totalCh, nframes, false, false, true);
+
+    // Main inputs into the first channels, silence everywhere else
+    // (sidechain slots, the output bus channels).
+    if (inputs)
+    {
+        for (int ch = 0; ch < p->inCh; ++ch)
+            buffer.copyFrom(ch, 0, inputs[ch], nframes);
+    }
+    else
+    {
+        for (int ch = 0; ch < p->inCh; ++ch)
+            buffer.clear(ch, 0, nframes);
+    }
+    for (int ch = p->inCh; ch < totalCh; ++ch)
+        buffer.clear(ch, 0, nframes);
+
+    p->midi.clear();
+    if (midi_events && num_midi_events > 0)
+    {
+        for (int i = 0; i < num_midi_events; ++i)
+        {
+            const auto& ev = midi_events[i];
+            int samplePos = jlimit(0, nframes > 0 ? nframes - 1 : 0,
+                                   ev.sample_offset);
+            p->midi.addEvent(MidiMessage(ev.status, ev.data1, ev.data2),
+                             samplePos);
+        }
+    }
+
+    p->inst->processBlock(buffer, p->midi);
+
+    // Fan the combined buffer out per bus. Output bus b's channels sit
+    // at the running absolute output-channel offset (disabled buses
+    // contribute 0 channels, so the walk skips them naturally).
+    const int busCount = p->inst->getBusCount(false);
+    int offset = 0;
+    for (int b = 0; b < busCount; ++b)
+    {
+        const int busCh = p->inst->getChannelCountOfBus(false, b);
+        if (b < num_buses && bus_outputs[b] != nullptr)
+        {
+            for (int ch = 0; ch < busCh && offset + ch < totalCh; ++ch)
+            {
+                if (bus_outputs[b][ch])
+                    std::memcpy(bus_outputs[b][ch],
+                                buffer.getReadPointer(offset + ch), bytes);
+            }
+        }
+        offset += busCh;
+    }
+
+    if (denormalScope.hit())
+        p->denormalHits.fetch_add(1, std::memory_order_relaxed);
+
     return 1;
 }
 
@@ -1601,6 +3779,19 @@ extern "C" int mh_check_buses_layout(MH_Plugin* p,
     if (!p || !p->inst) return 0;
     std::lock_guard<std::mutex> lock(p->stateMutex);
 
+    // The answer is a pure function of (plugin, version, layout), so
+    // serve repeats from the negotiated-layout cache instead of
+    // round-tripping the plugin again.
+    const std::string key = layoutCacheKey(p->inst->getPluginDescription(),
+                                           input_channels, num_input_buses,
+                                           output_channels, num_output_buses);
+    {
+        std::lock_guard<std::mutex> clock(layoutCacheMutex);
+        auto it = layoutCache.find(key);
+        if (it != layoutCache.end())
+            return it->second;
+    }
+
     AudioProcessor::BusesLayout layout;
 
     for (int i = 0; i < num_input_buses; ++i)
@@ -1615,7 +3806,12 @@ extern "C" int mh_check_buses_layout(MH_Plugin* p,
         layout.outputBuses.add(AudioChannelSet::canonicalChannelSet(ch));
     }
 
-    return p->inst->checkBusesLayoutSupported(layout) ? 1 : 0;
+    const int supported = p->inst->checkBusesLayoutSupported(layout) ? 1 : 0;
+    {
+        std::lock_guard<std::mutex> clock(layoutCacheMutex);
+        layoutCache.emplace(key, supported);
+    }
+    return supported;
 }
 
 extern "C" int mh_set_change_callback(MH_Plugin* p, MH_ChangeCallback cb, void* user_data)
@@ -1634,6 +3830,60 @@ extern "C" int mh_set_param_value_callback(MH_Plugin* p, MH_ParamValueCallback c
     return 1;
 }
 
+extern "C" int mh_set_param_value_coalescing(MH_Plugin* p, int interval_ms)
+{
+    if (!p || !p->inst || interval_ms < 0) return 0;
+    MH_Listener& l = p->listener;
+
+    // Any change of mode starts by stopping the current flush thread so
+    // the slot arrays are never resized or freed under it. Pending
+    // changes are still delivered -- last-writer-wins, same as a normal
+    // flush tick.
+    l.stopCoalesceThread();
+    l.flushCoalesced();
+
+    if (interval_ms == 0)
+        return 1;   // back to immediate per-change delivery
+
+    // Size the dirty set to the current parameter count. Parameters the
+    // plugin adds later (MH_CHANGE_PARAM_INFO) deliver immediately until
+    // coalescing is re-enabled.
+    int count = 0;
+    {
+        std::lock_guard<std::mutex> lock(p->stateMutex);
+        count = p->inst->getParameters().size();
+    }
+    if (count <= 0)
+        return 1;   // nothing to coalesce; immediate path is a no-op too
+
+    l.coalesceValues.reset(new std::atomic<float>[(size_t) count]);
+    l.coalesceDirty.reset(new std::atomic<unsigned>[(size_t) count]);
+    for (int i = 0; i < count; ++i)
+    {
+        l.coalesceValues[(size_t) i].store(0.0f, std::memory_order_relaxed);
+        l.coalesceDirty[(size_t) i].store(0, std::memory_order_relaxed);
+    }
+    l.coalesceCount = count;
+    l.coalesceAnyDirty.store(0, std::memory_order_relaxed);
+
+    // Plain std::thread, not a juce::Timer: the embedded message thread
+    // runs a task queue, not a JUCE dispatch loop, so timers never fire
+    // there.
+    l.coalesceRunning.store(true);
+    l.coalesceIntervalMs.store(interval_ms, std::memory_order_release);
+    l.coalesceThread = std::thread([&l]()
+    {
+        mh_thread_policy_apply(MH_THREAD_ROLE_CONTROL);
+        while (l.coalesceRunning.load(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(
+                l.coalesceIntervalMs.load(std::memory_order_relaxed)));
+            l.flushCoalesced();
+        }
+    });
+    return 1;
+}
+
 extern "C" int mh_set_param_gesture_callback(MH_Plugin* p, MH_ParamGestureCallback cb, void* user_data)
 {
     if (!p) return 0;
@@ -1642,6 +3892,65 @@ extern "C" int mh_set_param_gesture_callback(MH_Plugin* p, MH_ParamGestureCallba
     return 1;
 }
 
+extern "C" int mh_param_record_start(MH_Plugin* p, int capacity)
+{
+    if (!p) return 0;
+    if (p->recordArmed.load(std::memory_order_acquire) != 0)
+        return 0;   // already armed; stop first
+    if (capacity <= 0)
+        capacity = 4096;
+
+    // Power-of-two capacity for the cell mask, capped well below
+    // anything a live session could fill between fetches.
+    int cap = 1;
+    while (cap < capacity && cap < (1 << 22))
+        cap <<= 1;
+
+    try
+    {
+        p->recorder.reset(new ParamRecorder(cap));
+    }
+    catch (...)
+    {
+        return 0;
+    }
+    p->recordArmed.store(1, std::memory_order_release);
+    return 1;
+}
+
+extern "C" int mh_param_record_stop(MH_Plugin* p)
+{
+    if (!p) return 0;
+    // The queue is kept so records captured before the stop remain
+    // fetchable; the next start replaces it.
+    p->recordArmed.store(0, std::memory_order_release);
+    return 1;
+}
+
+extern "C" int mh_param_record_armed(MH_Plugin* p)
+{
+    return p ? p->recordArmed.load(std::memory_order_acquire) : 0;
+}
+
+extern "C" int mh_param_record_fetch(MH_Plugin* p, MH_ParamRecord* out,
+                                     int max_records)
+{
+    if (!p || !out || max_records <= 0) return 0;
+    ParamRecorder* const r = p->recorder.get();
+    if (r == nullptr) return 0;
+
+    int n = 0;
+    while (n < max_records && r->pop(out[n]))
+        ++n;
+    return n;
+}
+
+extern "C" long long mh_param_record_dropped(MH_Plugin* p)
+{
+    if (!p || !p->recorder) return 0;
+    return p->recorder->dropped.load(std::memory_order_relaxed);
+}
+
 extern "C" int mh_begin_param_gesture(MH_Plugin* p, int index)
 {
     if (!p || !p->inst) return 0;
@@ -1665,7 +3974,7 @@ extern "C" int mh_end_param_gesture(MH_Plugin* p, int index)
 extern "C" int mh_get_program_state_size(MH_Plugin* p)
 {
     if (!p || !p->inst) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         MemoryBlock mb;
@@ -1677,7 +3986,7 @@ extern "C" int mh_get_program_state_size(MH_Plugin* p)
 extern "C" int mh_get_program_state(MH_Plugin* p, void* buffer, int buffer_size)
 {
     if (!p || !p->inst || !buffer || buffer_size <= 0) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         MemoryBlock mb;
@@ -1694,7 +4003,7 @@ extern "C" int mh_get_program_state(MH_Plugin* p, void* buffer, int buffer_size)
 extern "C" int mh_set_program_state(MH_Plugin* p, const void* data, int data_size)
 {
     if (!p || !p->inst || !data || data_size <= 0) return 0;
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
         std::lock_guard<std::mutex> lock(p->stateMutex);
         p->inst->setCurrentProgramStateInformation(data, data_size);
@@ -1710,7 +4019,7 @@ extern "C" int mh_set_sample_rate(MH_Plugin* p, double new_sample_rate)
     // negative/zero/NaN must fail fast.
     if (!(new_sample_rate > 0.0)) return 0;
 
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
     std::lock_guard<std::mutex> lock(p->stateMutex);
 
@@ -1774,6 +4083,12 @@ extern "C" double mh_get_sample_rate(MH_Plugin* p)
     return p->sampleRate;
 }
 
+extern "C" int mh_get_max_block_size(MH_Plugin* p)
+{
+    if (!p) return 0;
+    return p->maxBlockSize;
+}
+
 extern "C" int mh_scan_directory(const char* directory_path,
                                  MH_ScanCallback callback,
                                  void* user_data)
@@ -1843,7 +4158,7 @@ extern "C" int mh_set_processing_precision(MH_Plugin* p, int precision)
     if (!p || !p->inst) return 0;
     if (precision != MH_PRECISION_SINGLE && precision != MH_PRECISION_DOUBLE) return 0;
 
-    return runOnMsg([&]() -> int
+    return runOnMsgFor(p, [&]() -> int
     {
     // Double precision requires plugin support
     if (precision == MH_PRECISION_DOUBLE && !p->inst->supportsDoublePrecisionProcessing())
@@ -1915,84 +4230,107 @@ extern "C" int mh_process_double(MH_Plugin* p,
                                  int nframes)
 {
     if (!p || !p->inst) return 0;
-    if (nframes < 0 || nframes > p->maxBlockSize) return 0;
+    if (nframes < 0) return 0;
+
+    // Pick up a staged standby swap at the block boundary.
+    adoptStandby(p);
+
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(
+        p->denormalControl.load(std::memory_order_relaxed) != 0);
+
+    advanceSmoothers(p, nframes);
 
     // Both branches use persistent buffers (sized once in mh_open_ex) to
     // avoid heap allocation on the audio thread. setSize with
     // avoidReallocating=true updates the reported sample count without
-    // reallocating because nframes <= maxBlockSize is already validated.
-    if (p->inst->supportsDoublePrecisionProcessing())
+    // reallocating because the chunk never exceeds maxBlockSize. As in
+    // mh_process_midi_io, blocks within the prepared maximum run the loop
+    // once; larger blocks are sub-blocked transparently.
+    for (int done = 0; done < nframes || (nframes == 0 && done == 0);)
     {
-        auto& buf = p->processBufD;
-        const int totalCh = buf.getNumChannels();
-        const size_t bytes = sizeof(double) * (size_t)nframes;
-        buf.setSize(totalCh, nframes, false, false, true);
+        const int chunk = std::min(nframes - done, p->maxBlockSize);
 
-        if (inputs)
-        {
-            for (int ch = 0; ch < p->inCh; ++ch)
-                std::memcpy(buf.getWritePointer(ch), inputs[ch], bytes);
-        }
-        else
+        if (p->inst->supportsDoublePrecisionProcessing())
         {
-            for (int ch = 0; ch < p->inCh; ++ch)
-                std::memset(buf.getWritePointer(ch), 0, bytes);
-        }
-        for (int ch = p->inCh; ch < totalCh; ++ch)
-            std::memset(buf.getWritePointer(ch), 0, bytes);
+            auto& buf = p->processBufD;
+            const int totalCh = buf.getNumChannels();
+            const size_t bytes = sizeof(double) * (size_t)chunk;
+            buf.setSize(totalCh, chunk, false, false, true);
 
-        p->midi.clear();
-        p->inst->processBlock(buf, p->midi);
+            if (inputs)
+            {
+                for (int ch = 0; ch < p->inCh; ++ch)
+                    std::memcpy(buf.getWritePointer(ch), inputs[ch] + done, bytes);
+            }
+            else
+            {
+                for (int ch = 0; ch < p->inCh; ++ch)
+                    std::memset(buf.getWritePointer(ch), 0, bytes);
+            }
+            for (int ch = p->inCh; ch < totalCh; ++ch)
+                std::memset(buf.getWritePointer(ch), 0, bytes);
 
-        if (outputs)
-        {
-            for (int ch = 0; ch < p->outCh; ++ch)
-                std::memcpy(outputs[ch], buf.getReadPointer(ch), bytes);
-        }
-    }
-    else
-    {
-        // Plugin only supports float; convert double <-> float through the
-        // existing float processBuf.
-        auto& buf = p->processBuf;
-        const int totalCh = buf.getNumChannels();
-        buf.setSize(totalCh, nframes, false, false, true);
+            p->midi.clear();
+            p->inst->processBlock(buf, p->midi);
 
-        if (inputs)
-        {
-            for (int ch = 0; ch < p->inCh; ++ch)
+            if (outputs)
             {
-                auto* dest = buf.getWritePointer(ch);
-                const double* src = inputs[ch];
-                for (int i = 0; i < nframes; ++i)
-                    dest[i] = static_cast<float>(src[i]);
+                for (int ch = 0; ch < p->outCh; ++ch)
+                    std::memcpy(outputs[ch] + done, buf.getReadPointer(ch), bytes);
             }
         }
         else
         {
-            for (int ch = 0; ch < p->inCh; ++ch)
+            // Plugin only supports float; convert double <-> float through the
+            // existing float processBuf.
+            auto& buf = p->processBuf;
+            const int totalCh = buf.getNumChannels();
+            buf.setSize(totalCh, chunk, false, false, true);
+
+            if (inputs)
+            {
+                for (int ch = 0; ch < p->inCh; ++ch)
+                {
+                    auto* dest = buf.getWritePointer(ch);
+                    const double* src = inputs[ch] + done;
+                    for (int i = 0; i < chunk; ++i)
+                        dest[i] = static_cast<float>(src[i]);
+                }
+            }
+            else
+            {
+                for (int ch = 0; ch < p->inCh; ++ch)
+                    std::memset(buf.getWritePointer(ch), 0,
+                                sizeof(float) * (size_t)chunk);
+            }
+            for (int ch = p->inCh; ch < totalCh; ++ch)
                 std::memset(buf.getWritePointer(ch), 0,
-                            sizeof(float) * (size_t)nframes);
-        }
-        for (int ch = p->inCh; ch < totalCh; ++ch)
-            std::memset(buf.getWritePointer(ch), 0,
-                        sizeof(float) * (size_t)nframes);
+                            sizeof(float) * (size_t)chunk);
 
-        p->midi.clear();
-        p->inst->processBlock(buf, p->midi);
+            p->midi.clear();
+            p->inst->processBlock(buf, p->midi);
 
-        if (outputs)
-        {
-            for (int ch = 0; ch < p->outCh; ++ch)
+            if (outputs)
             {
-                const auto* src = buf.getReadPointer(ch);
-                double* dest = outputs[ch];
-                for (int i = 0; i < nframes; ++i)
-                    dest[i] = static_cast<double>(src[i]);
+                for (int ch = 0; ch < p->outCh; ++ch)
+                {
+                    const auto* src = buf.getReadPointer(ch);
+                    double* dest = outputs[ch] + done;
+                    for (int i = 0; i < chunk; ++i)
+                        dest[i] = static_cast<double>(src[i]);
+                }
             }
         }
+
+        done += chunk;
+        if (nframes == 0)
+            break;
     }
 
+    if (denormalScope.hit())
+        p->denormalHits.fetch_add(1, std::memory_order_relaxed);
+
     return 1;
 }
 
@@ -2012,6 +4350,7 @@ extern "C" int mh_open_async(const char* plugin_path,
 
     // Launch loading thread (detached - it manages its own lifetime)
     std::thread loadThread([=]() {
+        mh_thread_policy_apply(MH_THREAD_ROLE_LOADER);
         char errBuf[1024] = {0};
         MH_Plugin* plugin = mh_open(path.c_str(), sample_rate, max_block_size,
                                      requested_in_ch, requested_out_ch,
@@ -2031,6 +4370,184 @@ extern "C" int mh_open_async(const char* plugin_path,
     return 1;
 }
 
+// ---------------------------------------------------------------------------
+// Managed async load pool.
+//
+// mh_open_async spawns one detached thread per call; a 40-plugin project
+// opened that way creates 40 threads that mostly contend with each other.
+// The pool keeps a fixed set of workers, each with its own private format
+// manager (the scan_directory_mt pattern) so discovery -- the dlopen,
+// binary read and factory scan that dominate a cold load -- runs fully in
+// parallel with no shared lock. Only the thread-affine construction step
+// marshals to the plugin thread, which drains all pending constructions
+// per wakeup.
+// ---------------------------------------------------------------------------
+struct MH_LoadPool
+{
+    struct Job
+    {
+        long long ticket = 0;
+        std::string path;
+        double sampleRate = 0.0;
+        int maxBlockSize = 0;
+        int inCh = 0;
+        int outCh = 0;
+        MH_LoadCallback callback = nullptr;
+        void* userData = nullptr;
+    };
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Job> queue;
+    int inFlight = 0;
+    bool running = true;
+    long long nextTicket = 1;
+    std::vector<std::thread> workers;
+};
+
+static void loadPoolWorker(MH_LoadPool* pool)
+{
+    mh_thread_policy_apply(MH_THREAD_ROLE_LOADER);
+    // Private format manager per worker: format registration happens once
+    // per worker lifetime, and concurrent discovery never serializes on a
+    // shared manager.
+    AudioPluginFormatManager fm;
+    initFormatManager(fm);
+
+    for (;;)
+    {
+        MH_LoadPool::Job job;
+        {
+            std::unique_lock<std::mutex> lk(pool->mtx);
+            pool->cv.wait(lk, [pool] {
+                return ! pool->queue.empty() || ! pool->running;
+            });
+            if (pool->queue.empty())
+                break;   // shutdown with nothing pending
+            job = std::move(pool->queue.front());
+            pool->queue.pop_front();
+            ++pool->inFlight;
+        }
+
+        char errBuf[1024] = {0};
+        MH_Plugin* plugin = createPluginWithFm(fm, job.path.c_str(),
+                                               job.sampleRate,
+                                               job.maxBlockSize,
+                                               job.inCh, job.outCh,
+                                               /*sidechain_in_ch=*/0,
+                                               errBuf, sizeof(errBuf));
+        job.callback(plugin, plugin ? nullptr : errBuf, job.userData);
+
+        {
+            std::lock_guard<std::mutex> lk(pool->mtx);
+            --pool->inFlight;
+        }
+    }
+}
+
+extern "C" MH_LoadPool* mh_load_pool_create(int num_workers,
+                                            char* err_buf,
+                                            size_t err_buf_size)
+{
+    num_workers = jlimit(1, 64, num_workers);
+
+    std::unique_ptr<MH_LoadPool> pool(new MH_LoadPool());
+    try
+    {
+        pool->workers.reserve((size_t) num_workers);
+        for (int i = 0; i < num_workers; ++i)
+            pool->workers.emplace_back(loadPoolWorker, pool.get());
+    }
+    catch (const std::exception& e)
+    {
+        {
+            std::lock_guard<std::mutex> lk(pool->mtx);
+            pool->running = false;
+        }
+        pool->cv.notify_all();
+        for (auto& w : pool->workers)
+            if (w.joinable()) w.join();
+        setErr(err_buf, err_buf_size,
+               String("failed to start load pool workers: ") + e.what());
+        return nullptr;
+    }
+    return pool.release();
+}
+
+extern "C" long long mh_load_pool_open(MH_LoadPool* pool,
+                                       const char* plugin_path,
+                                       double sample_rate,
+                                       int max_block_size,
+                                       int requested_in_ch,
+                                       int requested_out_ch,
+                                       MH_LoadCallback callback,
+                                       void* user_data)
+{
+    if (!pool || !plugin_path || plugin_path[0] == '\0' || !callback)
+        return 0;
+
+    MH_LoadPool::Job job;
+    job.path = plugin_path;
+    job.sampleRate = sample_rate;
+    job.maxBlockSize = max_block_size;
+    job.inCh = requested_in_ch;
+    job.outCh = requested_out_ch;
+    job.callback = callback;
+    job.userData = user_data;
+
+    long long ticket = 0;
+    {
+        std::lock_guard<std::mutex> lk(pool->mtx);
+        if (! pool->running)
+            return 0;
+        ticket = pool->nextTicket++;
+        job.ticket = ticket;
+        pool->queue.push_back(std::move(job));
+    }
+    pool->cv.notify_one();
+    return ticket;
+}
+
+extern "C" int mh_load_pool_cancel(MH_LoadPool* pool, long long ticket)
+{
+    if (!pool || ticket <= 0)
+        return 0;
+
+    std::lock_guard<std::mutex> lk(pool->mtx);
+    for (auto it = pool->queue.begin(); it != pool->queue.end(); ++it)
+    {
+        if (it->ticket == ticket)
+        {
+            pool->queue.erase(it);
+            return 1;
+        }
+    }
+    return 0;   // already started, already finished, or never issued
+}
+
+extern "C" int mh_load_pool_pending(MH_LoadPool* pool)
+{
+    if (!pool)
+        return -1;
+    std::lock_guard<std::mutex> lk(pool->mtx);
+    return (int) pool->queue.size() + pool->inFlight;
+}
+
+extern "C" void mh_load_pool_close(MH_LoadPool* pool)
+{
+    if (!pool)
+        return;
+    {
+        std::lock_guard<std::mutex> lk(pool->mtx);
+        pool->running = false;
+        pool->queue.clear();   // queued-but-unstarted jobs are dropped
+    }
+    pool->cv.notify_all();
+    for (auto& w : pool->workers)
+        if (w.joinable()) w.join();
+    delete pool;
+}
+
 // ---------------------------------------------------------------------------
 // Session entry points
 // ---------------------------------------------------------------------------
@@ -2078,12 +4595,95 @@ static int scanDirectoryWithFm(AudioPluginFormatManager& fm,
     return count;
 }
 
+// Acquire a shard for one session operation. A try-lock pass over all
+// shards lets concurrent callers fan out without blocking; only when
+// every shard is busy does the caller block, on a rotating victim so
+// waiters spread out too. The shard's format manager is initialized on
+// first acquisition (under its own mutex). Returns the shard with `lk`
+// holding its lock for the operation's duration.
+static MH_Session::Shard* lockSessionShard(MH_Session* session,
+                                           std::unique_lock<std::mutex>& lk)
+{
+    for (int i = 0; i < MH_Session::kNumShards; ++i)
+    {
+        auto& sh = session->shards[i];
+        std::unique_lock<std::mutex> l(sh.mtx, std::try_to_lock);
+        if (l.owns_lock())
+        {
+            if (! sh.initialized)
+            {
+                initFormatManager(sh.fm);
+                sh.initialized = true;
+            }
+            lk = std::move(l);
+            return &sh;
+        }
+    }
+
+    auto& sh = session->shards[session->rr.fetch_add(1)
+                               % MH_Session::kNumShards];
+    std::unique_lock<std::mutex> l(sh.mtx);
+    if (! sh.initialized)
+    {
+        initFormatManager(sh.fm);
+        sh.initialized = true;
+    }
+    lk = std::move(l);
+    return &sh;
+}
+
+#if JUCE_PLUGINHOST_LV2
+// LV2 bundles are directories named *.lv2 -- the extension is the
+// format's identity on disk, so it doubles as the routing key.
+static bool isLv2Bundle(const char* path)
+{
+    return path != nullptr && path[0] != '\0'
+        && File(String::fromUTF8(path)).getFileName()
+               .endsWithIgnoreCase(".lv2");
+}
+
+// Acquire the session's shared LV2 context, creating it on first use.
+// Returns a manager holding a single LV2Format with `lk` holding its
+// lock for the operation's duration (the manager is not internally
+// thread-safe, same as the shards).
+static AudioPluginFormatManager* lockSessionLv2(MH_Session* session,
+                                                std::unique_lock<std::mutex>& lk)
+{
+    std::unique_lock<std::mutex> l(session->lv2Mtx);
+    if (! session->lv2Fm)
+    {
+        session->lv2Fm.reset(new AudioPluginFormatManager());
+        session->lv2Fm->addFormat(std::make_unique<LV2Format>());
+    }
+    lk = std::move(l);
+    return session->lv2Fm.get();
+}
+#endif
+
+// Acquire the right format manager for a path-targeted session
+// operation: .lv2 bundles go through the shared LV2 context so the
+// world parse is paid once per session, everything else fans out
+// across the shards as before.
+static AudioPluginFormatManager* lockSessionFmFor(MH_Session* session,
+                                                  const char* path,
+                                                  std::unique_lock<std::mutex>& lk)
+{
+   #if JUCE_PLUGINHOST_LV2
+    if (isLv2Bundle(path))
+        return lockSessionLv2(session, lk);
+   #else
+    (void) path;
+   #endif
+    return &lockSessionShard(session, lk)->fm;
+}
+
 extern "C" MH_Session* mh_session_create(char* err_buf, size_t err_buf_size)
 {
     try
     {
         std::unique_ptr<MH_Session> s(new MH_Session());
-        initFormatManager(s->fm);
+        initFormatManager(s->shards[0].fm);
+        s->shards[0].initialized = true;
         return s.release();
     }
     catch (const std::exception& e)
@@ -2100,7 +4700,19 @@ extern "C" void mh_session_close(MH_Session* session)
     // the format manager (the AudioPluginInstance is self-contained
     // post-creation), so closing the session is safe even while
     // plugins remain in use.
-    if (session) delete session;
+    if (!session) return;
+
+    // Instances still parked in the pool are ours to close; acquired
+    // plugins remain the caller's.
+    std::vector<MH_Plugin*> parked;
+    {
+        std::lock_guard<std::mutex> lock(session->poolMtx);
+        for (auto& pi : session->pool) parked.push_back(pi.plugin);
+        session->pool.clear();
+    }
+    for (auto* p : parked) mh_close(p);
+
+    delete session;
 }
 
 extern "C" MH_Plugin* mh_session_open(MH_Session* session,
@@ -2118,8 +4730,9 @@ extern "C" MH_Plugin* mh_session_open(MH_Session* session,
         setErr(err_buf, err_buf_size, "session is null");
         return nullptr;
     }
-    std::lock_guard<std::mutex> lock(session->mtx);
-    return createPluginWithFm(session->fm, plugin_path,
+    std::unique_lock<std::mutex> lock;
+    auto* fm = lockSessionFmFor(session, plugin_path, lock);
+    return createPluginWithFm(*fm, plugin_path,
                                sample_rate, max_block_size,
                                main_in_ch, main_out_ch, sidechain_in_ch,
                                err_buf, err_buf_size);
@@ -2139,14 +4752,510 @@ extern "C" MH_Plugin* mh_session_open_desc(MH_Session* session,
         setErr(err_buf, err_buf_size, "session is null");
         return nullptr;
     }
-    std::lock_guard<std::mutex> lock(session->mtx);
-    return createPluginFromDescWithFm(session->fm, pd_xml,
+    std::unique_lock<std::mutex> lock;
+    auto* shard = lockSessionShard(session, lock);
+    return createPluginFromDescWithFm(shard->fm, pd_xml,
                                       sample_rate, max_block_size,
                                       requested_in_ch, requested_out_ch,
                                       /*sidechain_in_ch=*/0,
                                       err_buf, err_buf_size);
 }
 
+extern "C" void mh_open_options_init(MH_OpenOptions* opts)
+{
+    if (opts == nullptr) return;
+    std::memset(opts, 0, sizeof(MH_OpenOptions));
+    opts->sample_rate     = 48000.0;
+    opts->max_block_size  = 512;
+    opts->main_in_ch      = 2;
+    opts->main_out_ch     = 2;
+    opts->sidechain_in_ch = 0;
+    opts->format          = MH_FORMAT_ANY;
+}
+
+extern "C" MH_Plugin* mh_session_open_opts(MH_Session* session,
+                                            const char* plugin_path,
+                                            const MH_OpenOptions* opts,
+                                            char* err_buf,
+                                            size_t err_buf_size)
+{
+    if (!session)
+    {
+        setErr(err_buf, err_buf_size, "session is null");
+        return nullptr;
+    }
+    if (!opts)
+    {
+        setErr(err_buf, err_buf_size,
+               "opts is null (initialize with mh_open_options_init)");
+        return nullptr;
+    }
+    if (opts->format < MH_FORMAT_ANY || opts->format > MH_FORMAT_LV2)
+    {
+        setErr(err_buf, err_buf_size,
+               "unknown format " + String(opts->format)
+               + " (expected one of the MH_FORMAT_* constants)");
+        return nullptr;
+    }
+
+    if (opts->format == MH_FORMAT_ANY)
+    {
+        std::unique_lock<std::mutex> lock;
+        auto* fm = lockSessionFmFor(session, plugin_path, lock);
+        return createPluginWithFm(*fm, plugin_path,
+                                   opts->sample_rate, opts->max_block_size,
+                                   opts->main_in_ch, opts->main_out_ch,
+                                   opts->sidechain_in_ch,
+                                   err_buf, err_buf_size);
+    }
+
+    if (opts->format == MH_FORMAT_LV2)
+    {
+       #if JUCE_PLUGINHOST_LV2
+        // Discovery runs against the LV2-only shared context, so a
+        // non-LV2 file fails with "no compatible plugin types" instead
+        // of opening through another format.
+        std::unique_lock<std::mutex> lock;
+        auto* fm = lockSessionLv2(session, lock);
+        return createPluginWithFm(*fm, plugin_path,
+                                   opts->sample_rate, opts->max_block_size,
+                                   opts->main_in_ch, opts->main_out_ch,
+                                   opts->sidechain_in_ch,
+                                   err_buf, err_buf_size);
+       #else
+        setErr(err_buf, err_buf_size,
+               "LV2 support is not compiled into this build");
+        return nullptr;
+       #endif
+    }
+
+   #if ! JUCE_MAC
+    if (opts->format == MH_FORMAT_AU)
+    {
+        setErr(err_buf, err_buf_size,
+               "AudioUnit hosting is only available on macOS");
+        return nullptr;
+    }
+   #endif
+
+    // Typed VST3/AU open: discover first (served from the module cache
+    // on repeat paths), verify the file actually resolved as the
+    // requested format, then construct from the resolved description.
+    if (plugin_path == nullptr || plugin_path[0] == '\0')
+    {
+        setErr(err_buf, err_buf_size, "plugin_path is empty");
+        return nullptr;
+    }
+    File f(String::fromUTF8(plugin_path));
+    if (! f.exists())
+    {
+        setErr(err_buf, err_buf_size,
+               "Plugin file does not exist: " + f.getFullPathName());
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock;
+    auto* shard = lockSessionShard(session, lock);
+
+    PluginDescription desc;
+    String derr;
+    if (! findFirstTypeForFileCached(shard->fm, f, desc, derr))
+    {
+        setErr(err_buf, err_buf_size, derr);
+        return nullptr;
+    }
+
+    const char* want = opts->format == MH_FORMAT_VST3 ? "VST3" : "AudioUnit";
+    if (! desc.pluginFormatName.equalsIgnoreCase(want))
+    {
+        setErr(err_buf, err_buf_size,
+               "file resolved as " + desc.pluginFormatName
+               + ", not the requested " + want + ": " + f.getFullPathName());
+        return nullptr;
+    }
+
+    std::unique_ptr<XmlElement> xml(desc.createXml());
+    if (xml == nullptr)
+    {
+        setErr(err_buf, err_buf_size, "descriptor serialization failed");
+        return nullptr;
+    }
+    return createPluginFromDescWithFm(shard->fm,
+                                      xml->toString().toRawUTF8(),
+                                      opts->sample_rate, opts->max_block_size,
+                                      opts->main_in_ch, opts->main_out_ch,
+                                      opts->sidechain_in_ch,
+                                      err_buf, err_buf_size);
+}
+
+extern "C" int mh_session_refresh_formats(MH_Session* session)
+{
+    if (!session) return 0;
+   #if JUCE_PLUGINHOST_LV2
+    // Dropping the context is enough: the next LV2-targeted call
+    // rebuilds it, parsing the world fresh. Nothing equivalent for the
+    // shards -- their discovery results come from the module cache,
+    // which invalidates on file size/mtime change.
+    std::lock_guard<std::mutex> lock(session->lv2Mtx);
+    session->lv2Fm.reset();
+   #endif
+    return 1;
+}
+
+// Pool key: bundle path plus everything a revived instance cannot
+// change after construction. An exact match is required -- reviving an
+// instance prepared at a different rate or block size would need a
+// re-prepare, which is most of the cost pooling exists to avoid.
+static std::string sessionPoolKey(const char* path,
+                                  double sample_rate,
+                                  int max_block_size,
+                                  int main_in_ch,
+                                  int main_out_ch,
+                                  int sidechain_in_ch)
+{
+    return (String(path != nullptr ? path : "")
+            + "|" + String(sample_rate)
+            + "|" + String(max_block_size)
+            + "|" + String(main_in_ch) + "x" + String(main_out_ch)
+            + "+" + String(sidechain_in_ch)).toStdString();
+}
+
+// Apply the pool policy. Caller holds poolMtx; victims are handed back
+// for closing outside the lock.
+static void poolEvictLocked(MH_Session* session,
+                            std::vector<MH_Plugin*>& victims)
+{
+    const int64 now = Time::currentTimeMillis();
+
+    if (session->poolTtlMs > 0)
+    {
+        for (auto it = session->pool.begin(); it != session->pool.end();)
+        {
+            if (now - it->parkedAtMs >= session->poolTtlMs)
+            {
+                victims.push_back(it->plugin);
+                it = session->pool.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    while ((int) session->pool.size() > session->poolMaxIdle)
+    {
+        victims.push_back(session->pool.front().plugin);
+        session->pool.erase(session->pool.begin());
+    }
+}
+
+extern "C" int mh_session_set_pool(MH_Session* session,
+                                   int max_idle,
+                                   int idle_ttl_ms)
+{
+    if (!session || max_idle < 0 || idle_ttl_ms < 0) return 0;
+
+    std::vector<MH_Plugin*> victims;
+    {
+        std::lock_guard<std::mutex> lock(session->poolMtx);
+        session->poolMaxIdle = max_idle;
+        session->poolTtlMs   = idle_ttl_ms;
+        poolEvictLocked(session, victims);
+    }
+    for (auto* v : victims) mh_close(v);
+    return 1;
+}
+
+extern "C" MH_Plugin* mh_session_acquire(MH_Session* session,
+                                          const char* plugin_path,
+                                          double sample_rate,
+                                          int max_block_size,
+                                          int main_in_ch,
+                                          int main_out_ch,
+                                          int sidechain_in_ch,
+                                          char* err_buf,
+                                          size_t err_buf_size)
+{
+    if (!session)
+    {
+        setErr(err_buf, err_buf_size, "session is null");
+        return nullptr;
+    }
+    if (!plugin_path || plugin_path[0] == '\0')
+    {
+        setErr(err_buf, err_buf_size, "plugin_path is empty");
+        return nullptr;
+    }
+
+    const std::string key = sessionPoolKey(plugin_path, sample_rate,
+                                           max_block_size, main_in_ch,
+                                           main_out_ch, sidechain_in_ch);
+
+    MH_Plugin* revived = nullptr;
+    MemoryBlock birth;
+    std::vector<MH_Plugin*> victims;
+    {
+        std::lock_guard<std::mutex> lock(session->poolMtx);
+        poolEvictLocked(session, victims);
+
+        // Most-recently parked match first: its working set is the
+        // most likely to still be resident.
+        for (auto it = session->pool.rbegin(); it != session->pool.rend(); ++it)
+        {
+            if (it->plugin->poolKey == key)
+            {
+                revived = it->plugin;
+                session->pool.erase(std::next(it).base());
+                break;
+            }
+        }
+        if (revived)
+        {
+            auto bit = session->poolBirthStates.find(key);
+            if (bit != session->poolBirthStates.end())
+                birth = bit->second;   // copy; applied outside the lock
+        }
+    }
+    for (auto* v : victims) mh_close(v);
+
+    if (revived)
+    {
+        // Revive: clear transient DSP state (delay lines, tails), then
+        // restore the state the key's first instance was born with so
+        // the job starts from factory defaults.
+        mh_reset(revived);
+        if (birth.getSize() > 0)
+            mh_set_state(revived, birth.getData(), (int) birth.getSize());
+        return revived;
+    }
+
+    MH_Plugin* p = mh_session_open(session, plugin_path, sample_rate,
+                                   max_block_size, main_in_ch, main_out_ch,
+                                   sidechain_in_ch, err_buf, err_buf_size);
+    if (!p)
+        return nullptr;
+    p->poolKey = key;
+
+    // Capture the birth state once per key. Plugins that report no
+    // state leave no entry; revival is then reset-only.
+    bool haveBirth;
+    {
+        std::lock_guard<std::mutex> lock(session->poolMtx);
+        haveBirth = session->poolBirthStates.find(key)
+                        != session->poolBirthStates.end();
+    }
+    if (! haveBirth)
+    {
+        void* data = nullptr;
+        int size = 0;
+        if (mh_get_state_alloc(p, &data, &size) && data != nullptr && size > 0)
+        {
+            std::lock_guard<std::mutex> lock(session->poolMtx);
+            if (session->poolBirthStates.find(key)
+                    == session->poolBirthStates.end())
+                session->poolBirthStates.emplace(key,
+                                                 MemoryBlock(data, (size_t) size));
+        }
+        mh_state_free(data);
+    }
+    return p;
+}
+
+extern "C" int mh_session_release(MH_Session* session, MH_Plugin* plugin)
+{
+    if (!session || !plugin) return 0;
+
+    // Handles that can't be safely revived later -- not acquired
+    // through this pool, or with a standby swap still staged -- are
+    // closed instead of parked.
+    if (plugin->poolKey.empty()
+        || plugin->pendingSwap.load(std::memory_order_acquire) != nullptr)
+    {
+        mh_close(plugin);
+        return 1;
+    }
+
+    // Strip caller-registered callbacks so the next acquirer never
+    // inherits them, and stop the coalescing flush thread (a parked
+    // instance must not keep a thread spinning).
+    plugin->listener.changeCb.store(nullptr, std::memory_order_relaxed);
+    plugin->listener.changeUserData.store(nullptr, std::memory_order_relaxed);
+    plugin->listener.paramValueCb.store(nullptr, std::memory_order_relaxed);
+    plugin->listener.paramValueUserData.store(nullptr, std::memory_order_relaxed);
+    plugin->listener.paramGestureCb.store(nullptr, std::memory_order_relaxed);
+    plugin->listener.paramGestureUserData.store(nullptr, std::memory_order_relaxed);
+    mh_set_param_value_coalescing(plugin, 0);
+
+    bool parked = false;
+    std::vector<MH_Plugin*> victims;
+    {
+        std::lock_guard<std::mutex> lock(session->poolMtx);
+        if (session->poolMaxIdle > 0)
+        {
+            session->pool.push_back({ plugin, Time::currentTimeMillis() });
+            parked = true;
+            poolEvictLocked(session, victims);
+        }
+    }
+    if (! parked)
+        mh_close(plugin);
+    for (auto* v : victims) mh_close(v);
+    return 1;
+}
+
+extern "C" int mh_session_pool_size(MH_Session* session)
+{
+    if (!session) return 0;
+    std::lock_guard<std::mutex> lock(session->poolMtx);
+    return (int) session->pool.size();
+}
+
+extern "C" MH_Plugin* mh_session_standby(MH_Session* session,
+                                          MH_Plugin* plugin,
+                                          char* err_buf,
+                                          size_t err_buf_size)
+{
+    if (!session)
+    {
+        setErr(err_buf, err_buf_size, "session is null");
+        return nullptr;
+    }
+    if (!plugin || !plugin->inst)
+    {
+        setErr(err_buf, err_buf_size, "plugin is null");
+        return nullptr;
+    }
+    if (plugin->path.empty())
+    {
+        setErr(err_buf, err_buf_size, "plugin has no bundle path to reopen");
+        return nullptr;
+    }
+
+    // Capture the active state first so the clone comes up already
+    // holding it -- the caller's mh_set_state with the alternate state
+    // is then the only heavyweight restore left, and it runs off the
+    // audio path.
+    MemoryBlock state;
+    runOnMsgFor(plugin, [&]()
+    {
+        std::lock_guard<std::mutex> lock(plugin->stateMutex);
+        plugin->inst->getStateInformation(state);
+    });
+
+    MH_Plugin* standby = nullptr;
+    {
+        std::unique_lock<std::mutex> lock;
+        auto* fm = lockSessionFmFor(session, plugin->path.c_str(), lock);
+        standby = createPluginWithFm(*fm, plugin->path.c_str(),
+                                     plugin->sampleRate, plugin->maxBlockSize,
+                                     plugin->inCh, plugin->outCh,
+                                     plugin->sidechainCh,
+                                     err_buf, err_buf_size);
+    }
+    if (!standby)
+        return nullptr;
+
+    // Same bundle, same requested layout -- but bus negotiation is the
+    // plugin's call, so verify the clone actually resolved identically
+    // before handing it out as swappable.
+    if (standby->inCh != plugin->inCh
+        || standby->outCh != plugin->outCh
+        || standby->sidechainCh != plugin->sidechainCh)
+    {
+        setErr(err_buf, err_buf_size,
+               "standby resolved a different channel layout than the "
+               "active instance");
+        mh_close(standby);
+        return nullptr;
+    }
+
+    if (state.getSize() > 0)
+    {
+        runOnMsgFor(standby, [&]()
+        {
+            std::lock_guard<std::mutex> lock(standby->stateMutex);
+            standby->inst->setStateInformation(state.getData(),
+                                               (int) state.getSize());
+        });
+    }
+    return standby;
+}
+
+extern "C" int mh_standby_swap(MH_Plugin* active,
+                               MH_Plugin* standby,
+                               char* err_buf,
+                               size_t err_buf_size)
+{
+    if (!active || !active->inst)
+    {
+        setErr(err_buf, err_buf_size, "active plugin is null");
+        return 0;
+    }
+    if (!standby || !standby->inst)
+    {
+        setErr(err_buf, err_buf_size, "standby plugin is null");
+        return 0;
+    }
+    if (active == standby)
+    {
+        setErr(err_buf, err_buf_size, "active and standby are the same handle");
+        return 0;
+    }
+    if (active->pendingSwap.load(std::memory_order_acquire) != nullptr)
+    {
+        setErr(err_buf, err_buf_size,
+               "a previous swap is still in flight; "
+               "wait for mh_standby_swap_pending to clear");
+        return 0;
+    }
+    if (standby->pendingSwap.load(std::memory_order_acquire) != nullptr)
+    {
+        setErr(err_buf, err_buf_size,
+               "standby has its own swap in flight");
+        return 0;
+    }
+    if (active->path != standby->path)
+    {
+        setErr(err_buf, err_buf_size,
+               "bundle mismatch: active is " + String(active->path.c_str())
+               + ", standby is " + String(standby->path.c_str()));
+        return 0;
+    }
+    if (active->sampleRate != standby->sampleRate
+        || active->maxBlockSize != standby->maxBlockSize)
+    {
+        setErr(err_buf, err_buf_size,
+               "sample rate / block size mismatch between active and standby");
+        return 0;
+    }
+    if (active->inCh != standby->inCh
+        || active->outCh != standby->outCh
+        || active->sidechainCh != standby->sidechainCh)
+    {
+        setErr(err_buf, err_buf_size,
+               "channel layout mismatch between active and standby");
+        return 0;
+    }
+    if (active->listener.coalesceIntervalMs.load(std::memory_order_acquire) > 0
+        || standby->listener.coalesceIntervalMs.load(std::memory_order_acquire) > 0)
+    {
+        setErr(err_buf, err_buf_size,
+               "disable parameter-value coalescing "
+               "(mh_set_param_value_coalescing) on both handles before "
+               "staging a swap");
+        return 0;
+    }
+
+    active->pendingSwap.store(standby, std::memory_order_release);
+    return 1;
+}
+
+extern "C" int mh_standby_swap_pending(MH_Plugin* active)
+{
+    if (!active) return 0;
+    return active->pendingSwap.load(std::memory_order_acquire) != nullptr
+               ? 1 : 0;
+}
+
 extern "C" int mh_session_probe(MH_Session* session,
                                  const char* plugin_path,
                                  MH_PluginDesc* out_desc,
@@ -2158,8 +5267,9 @@ extern "C" int mh_session_probe(MH_Session* session,
         setErr(err_buf, err_buf_size, "session is null");
         return 0;
     }
-    std::lock_guard<std::mutex> lock(session->mtx);
-    return probeWithFm(session->fm, plugin_path, out_desc,
+    std::unique_lock<std::mutex> lock;
+    auto* fm = lockSessionFmFor(session, plugin_path, lock);
+    return probeWithFm(*fm, plugin_path, out_desc,
                         err_buf, err_buf_size);
 }
 
@@ -2169,7 +5279,94 @@ extern "C" int mh_session_scan_directory(MH_Session* session,
                                           void* user_data)
 {
     if (!session) return -1;
-    std::lock_guard<std::mutex> lock(session->mtx);
-    return scanDirectoryWithFm(session->fm, directory_path, callback, user_data);
+    std::unique_lock<std::mutex> lock;
+    auto* shard = lockSessionShard(session, lock);
+    return scanDirectoryWithFm(shard->fm, directory_path, callback, user_data);
+}
+
+extern "C" int mh_session_scan_directory_mt(MH_Session* session,
+                                             const char* directory_path,
+                                             int num_threads,
+                                             MH_ScanCallback callback,
+                                             void* user_data)
+{
+    if (!session) return -1;
+    if (!directory_path || directory_path[0] == '\0' || !callback)
+        return -1;
+
+    File dir(String::fromUTF8(directory_path));
+    if (!dir.exists() || !dir.isDirectory())
+        return -1;
+
+    Array<File> pluginFiles;
+    dir.findChildFiles(pluginFiles, File::findDirectories, true, "*.vst3");
+   #if JUCE_MAC
+    dir.findChildFiles(pluginFiles, File::findDirectories, true, "*.component");
+   #endif
+   #if JUCE_PLUGINHOST_LV2
+    dir.findChildFiles(pluginFiles, File::findDirectories, true, "*.lv2");
+   #endif
+
+    if (num_threads > 64) num_threads = 64;
+    if (num_threads > pluginFiles.size()) num_threads = pluginFiles.size();
+    if (num_threads <= 1)
+    {
+        // Serial path: identical behaviour (and sorted callback order)
+        // to mh_session_scan_directory.
+        std::unique_lock<std::mutex> lock;
+        auto* shard = lockSessionShard(session, lock);
+        return scanDirectoryWithFm(shard->fm, directory_path, callback, user_data);
+    }
+
+    // Workers pull file indices from a shared counter so a directory of
+    // one slow plugin and many fast ones still balances. Each worker
+    // probes through its own format manager: format managers are cheap
+    // to build next to a dlopen-per-probe, and this keeps the session's
+    // shards free for concurrent mh_session_* calls.
+    std::atomic<int> nextIndex{0};
+    std::atomic<int> count{0};
+    std::mutex callbackMutex;
+
+    auto worker = [&]()
+    {
+        AudioPluginFormatManager fm;
+        initFormatManager(fm);
+
+        for (;;)
+        {
+            const int i = nextIndex.fetch_add(1);
+            if (i >= pluginFiles.size())
+                return;
+
+            const auto& pluginFile = pluginFiles.getReference(i);
+            MH_PluginDesc desc;
+            char errBuf[256];
+
+            if (probeWithFm(fm, pluginFile.getFullPathName().toRawUTF8(),
+                             &desc, errBuf, sizeof(errBuf)))
+            {
+                std::snprintf(desc.path, sizeof(desc.path), "%s",
+                              pluginFile.getFullPathName().toRawUTF8());
+                {
+                    std::lock_guard<std::mutex> lock(callbackMutex);
+                    callback(&desc, user_data);
+                }
+                count.fetch_add(1);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve((size_t) num_threads);
+    for (int t = 0; t < num_threads; ++t)
+        threads.emplace_back([&worker]
+        {
+            mh_thread_policy_apply(MH_THREAD_ROLE_LOADER);
+            worker();
+        });
+    for (auto& th : threads)
+        th.join();
+
+    return count.load();
 }
 
@@ -5,19 +5,24 @@
 //   Functions fall into three thread-safety classes:
 //
 //   1. AUDIO-THREAD ONLY (no locks, no allocations after warmup):
-//        mh_process, mh_process_midi, mh_process_midi_io,
-//        mh_process_auto, mh_process_sidechain, mh_process_double
+//        mh_process, mh_process_interleaved, mh_process_midi,
+//        mh_process_midi_io, mh_process_auto, mh_process_sidechain,
+//        mh_process_sidechain_midi, mh_process_double
 //      Call from exactly one thread (the audio callback). Concurrent calls
 //      from multiple threads on the same MH_Plugin are undefined.
 //
 //   2. CONCURRENT WITH AUDIO (atomic / brief lock; safe to overlap mh_process):
 //        mh_set_param, mh_get_param, mh_get_param_info,
 //        mh_morph_capture, mh_morph_apply, mh_morph_lerp,
-//        mh_morph_lerp_per_param, mh_morph,
+//        mh_morph_lerp_per_param, mh_morph, mh_params_diff,
 //        mh_get_num_params, mh_get_info, mh_get_path,
 //        mh_get_latency_samples, mh_get_tail_seconds,
 //        mh_get_bypass, mh_set_bypass,
-//        mh_set_transport, mh_param_to_text, mh_param_from_text,
+//        mh_set_automation_granularity, mh_get_automation_granularity
+//        (take effect on the next mh_process_auto call),
+//        mh_set_param_smoothing, mh_get_param_smoothing,
+//        mh_set_transport, mh_param_to_text, mh_params_to_text_bulk,
+//        mh_param_from_text,
 //        mh_get_num_buses, mh_get_bus_info, mh_get_sidechain_channels,
 //        mh_check_buses_layout, mh_set_track_properties,
 //        mh_supports_double, mh_get_processing_precision,
@@ -31,7 +36,9 @@
 //
 //   3. NOT SAFE TO OVERLAP mh_process (calls releaseResources/prepareToPlay
 //      or otherwise reconfigures the plugin's audio pipeline):
-//        mh_set_state, mh_set_program_state, mh_get_state, mh_get_state_size,
+//        mh_set_state, mh_set_states, mh_restore_state,
+//        mh_set_program_state, mh_prefetch_programs, mh_set_program_fast,
+//        mh_get_state, mh_get_state_size, mh_get_states_alloc,
 //        mh_get_program_state, mh_get_program_state_size,
 //        mh_set_sample_rate, mh_set_processing_precision,
 //        mh_set_non_realtime, mh_reset
@@ -126,6 +133,30 @@ void mh_message_thread_init(void);
 // teardown deadlocks process exit on Linux.
 void mh_message_thread_shutdown(void);
 
+// EXPERIMENTAL: configure `count` additional marshalling threads ("worker
+// pumps", 0 disables, clamped to 64) next to the message thread. JUCE
+// allows exactly one MessageManager per process, so by default every
+// thread-affine plugin operation serializes through the single plugin
+// thread above -- two heavyweight setStateInformation calls can never
+// overlap regardless of core count. With pumps enabled, each plugin is
+// pinned round-robin to one pump at open and ALL of its thread-affine
+// work (construction, destruction, state, programs, parameter info) runs
+// on that pump for its whole lifetime, so operations on plugins pinned to
+// different pumps proceed concurrently; the bulk helpers
+// (mh_get_states_alloc / mh_set_states) fan out per pump automatically.
+// Per-plugin thread identity is fully preserved -- what a pinned plugin
+// gives up is running on THE JUCE message thread, so plugins that drive
+// juce::Timer or AsyncUpdater against the real message loop must keep the
+// default. Intended for headless Linux batch hosts; strictly opt-in.
+// Must be called before the first plugin load: returns 1 on success, 0
+// once the pumps have started (pins cannot be rehashed). The environment
+// variable MINIHOST_MESSAGE_PUMPS provides the same setting when this is
+// never called. mh_message_thread_shutdown also stops the pumps.
+int mh_message_thread_set_pumps(int count);
+
+// Returns the configured worker pump count (0 = single-thread default).
+int mh_message_thread_get_pumps(void);
+
 // Returns the implementation's API version as a "MAJOR.MINOR.PATCH" string.
 // Storage is owned by the library; do not free.
 const char* mh_api_version_string(void);
@@ -257,11 +288,35 @@ int mh_get_info(MH_Plugin* p, MH_Info* out_info);
 
 // Non-interleaved buffers: inputs[ch][nframes], outputs[ch][nframes]
 // If in/out pointers are NULL, the host will supply silence / discard output.
+//
+// Variable block sizes: any nframes <= max_block_size (the size passed to
+// mh_open) is the fast path -- the prepared buffers are sized once at max,
+// so switching between small live blocks and large offline blocks needs no
+// re-prepare and no reallocation. nframes > max_block_size is sub-blocked
+// transparently into max_block_size chunks (MIDI offsets are rebased per
+// chunk), so a plugin prepared with a smaller maximum than its host still
+// works -- at the cost of one processBlock call per chunk. This applies to
+// mh_process, mh_process_midi, mh_process_midi_io, mh_process_auto and
+// mh_process_double; mh_process_sidechain, mh_process_sidechain_midi and
+// mh_process_interleaved stay bounded by max_block_size.
 int mh_process(MH_Plugin* p,
                const float* const* inputs,
                float* const* outputs,
                int nframes);
 
+// Interleaved buffers: in/out are [frame0_ch0, frame0_ch1, ...] with
+// `channels` samples per frame. The conversion happens once, directly
+// into (and out of) the plugin's prepared process buffer, so callers
+// holding interleaved data -- device callbacks, file codecs -- skip the
+// planar staging copy they would otherwise need before mh_process.
+// Channels beyond the plugin's bus widths are zero-filled on output and
+// ignored on input; NULL in supplies silence, NULL out discards output.
+int mh_process_interleaved(MH_Plugin* p,
+                           const float* in,
+                           float* out,
+                           int nframes,
+                           int channels);
+
 // Process with MIDI input
 // midi_events: array of MIDI events to send to the plugin (can be NULL if num_midi_events is 0)
 // num_midi_events: number of events in the array
@@ -293,9 +348,37 @@ int   mh_get_num_params(MH_Plugin* p);
 float mh_get_param(MH_Plugin* p, int index);
 int   mh_set_param(MH_Plugin* p, int index, float normalized_0_1);
 
-// Get parameter metadata (returns 1 on success, 0 on failure)
+// Batched parameter write: set count parameters (indices[i] <- values[i],
+// values clamped to [0, 1]) under a single state-lock acquisition. Unlike
+// per-call mh_set_param, batch writes do not fire per-parameter host
+// listener notifications (mh_set_param_value_callback stays quiet) -- the
+// intended use is restoring large snapshots, where 2000 listener
+// round-trips are pure overhead. Indices are validated before anything is
+// written, so failure (0) means no parameter changed. Returns 1 on success.
+int   mh_set_params(MH_Plugin* p, const int* indices, const float* values,
+                    int count);
+
+// Get parameter metadata (returns 1 on success, 0 on failure).
+// Static fields (name/id/label/range/flags) are served from a table
+// captured at open time and rebuilt when the plugin reports
+// MH_CHANGE_PARAM_INFO; only current_value_str is queried live.
 int   mh_get_param_info(MH_Plugin* p, int index, MH_ParamInfo* out_info);
 
+// Bulk parameter metadata: fill out_infos with every parameter's info in
+// one call (one message-thread hop for the whole table, instead of one
+// per parameter -- the difference between milliseconds and hundreds of
+// milliseconds when listing a 3000-parameter instrument). capacity must
+// be >= mh_get_num_params(p). Returns the number of entries written, or
+// -1 on failure (including insufficient capacity, in which case nothing
+// is written).
+int   mh_get_all_param_info(MH_Plugin* p, MH_ParamInfo* out_infos,
+                            int capacity);
+
+// Find a parameter index by its stable ID string (MH_ParamInfo.id).
+// Hash lookup against the cached table; O(1) rather than a scan.
+// Returns the index, or -1 if not found.
+int   mh_find_param_by_id(MH_Plugin* p, const char* id);
+
 // Parameter morphing (A/B interpolation over normalized parameter values)
 //
 // A "snapshot" is an array of normalized parameter values (each in [0, 1]),
@@ -338,6 +421,57 @@ int mh_morph_lerp_per_param(const float* a, const float* b, float* out,
 // 0 on failure.
 int mh_morph(MH_Plugin* p, const float* a, const float* b, int count, float t);
 
+// Diff the plugin's current parameters against a baseline snapshot (from
+// mh_morph_capture), reporting only the parameters that changed. count must
+// equal mh_get_num_params(p). Up to capacity (index, value) pairs are written
+// to changed_indices / new_values; pass capacity = count to never truncate, or
+// capacity = 0 with NULL arrays to just count the changes. Returns the TOTAL
+// number of changed parameters (which may exceed capacity -- compare to detect
+// truncation), or -1 on error (NULL plugin/baseline, count mismatch, or
+// capacity > 0 with NULL output arrays).
+//
+// Comparison is exact: untouched parameters read back bit-identical to the
+// captured value (both round-trip the plugin's own quantization), so no
+// epsilon is needed and a genuine edit is never masked. The pairs feed
+// directly into mh_set_params for minimal-delta preset application.
+int mh_params_diff(MH_Plugin* p, const float* baseline, int count,
+                   int* changed_indices, float* new_values, int capacity);
+
+// Differential morphing (mh_morph_pair_*). mh_morph writes every
+// parameter each step even when the snapshots differ in a handful. A
+// morph pair precomputes the ACTIVE SET -- the indices where a and b
+// actually differ -- once at creation, so each apply interpolates and
+// writes only those parameters; a 60 Hz sweep over a big patch stops
+// saturating the parameter path. epsilon widens the "unchanged" band:
+// 0 keeps the exact comparison mh_params_diff uses (snapshot values
+// round-trip the plugin's quantization, so equality is bit-exact),
+// while a positive value also drops parameters whose endpoints differ
+// by no more than it.
+//
+// The pair copies the active entries of both snapshots, so the
+// caller's arrays may be freed after create. Apply writes through the
+// batched mh_set_params (one state-mutex hop). A pair holds per-apply
+// scratch: drive one pair from one thread at a time.
+typedef struct MH_MorphPair MH_MorphPair;
+
+// Build a pair from two snapshots of `count` values each (in
+// mh_morph_capture order). Returns NULL on error (NULL arrays,
+// negative count or epsilon, allocation failure).
+MH_MorphPair* mh_morph_pair_create(const float* a, const float* b,
+                                   int count, float epsilon);
+
+// Free a pair. NULL is a no-op.
+void mh_morph_pair_free(MH_MorphPair* pair);
+
+// Number of parameters in the pair's active set, or -1 on NULL.
+int mh_morph_pair_active_count(const MH_MorphPair* pair);
+
+// Interpolate the active set at t and apply it to the plugin: for each
+// active index i, clamp01(a[i] + (b[i] - a[i]) * t). The count the
+// pair was built with must equal mh_get_num_params(p). Returns 1 on
+// success (including an empty active set), 0 on failure.
+int mh_morph_pair_apply(MH_Plugin* p, MH_MorphPair* pair, float t);
+
 // State save/load (for presets and session recall)
 // Returns size in bytes needed to store state, or 0 on error
 int mh_get_state_size(MH_Plugin* p);
@@ -346,13 +480,100 @@ int mh_get_state_size(MH_Plugin* p);
 // buffer must be at least mh_get_state_size() bytes
 int mh_get_state(MH_Plugin* p, void* buffer, int buffer_size);
 
+// Single-call state capture: serializes once and hands back an
+// allocated copy. The mh_get_state_size + mh_get_state pattern asks
+// the plugin to serialize twice, which is a real cost for instruments
+// with very large states (samplers). On success *out_data holds
+// *out_size bytes; release with mh_state_free. Returns 1 on success,
+// 0 on failure (*out_data NULL, *out_size 0).
+int mh_get_state_alloc(MH_Plugin* p, void** out_data, int* out_size);
+
+// Free a buffer returned by mh_get_state_alloc. NULL is a no-op.
+void mh_state_free(void* data);
+
 // Restore state from buffer. Returns 1 on success, 0 on failure.
 int mh_set_state(MH_Plugin* p, const void* data, int data_size);
 
+// Batched restore: apply a state blob, a program change, and a set of
+// normalized parameter writes in ONE hop to the plugin thread.
+// Restoring a session via separate mh_set_state / mh_set_program calls
+// pays a cross-thread round trip per call; this pays one regardless of
+// how much is applied. Steps run in order (state, then program, then
+// params). Each piece is optional: pass state=NULL to skip the blob,
+// program=-1 to skip the program change, param_count=0 to skip the
+// writes. Parameter values are clamped to [0, 1].
+//
+// Same thread-safety class as mh_set_state: NOT safe to overlap
+// mh_process.
+//
+// Returns 1 on success, 0 on failure (bad arguments, program or a
+// parameter index out of range -- in-range steps still apply).
+int mh_restore_state(MH_Plugin* p,
+                     const void* state, int state_size,
+                     int program,
+                     const int* param_indices,
+                     const float* param_values,
+                     int param_count);
+
+// Batch state capture: serialize `count` plugins in ONE submission to
+// the plugin thread. Saving a project by calling mh_get_state_alloc in
+// a loop pays a cross-thread round trip -- and, for a live session, an
+// audio pause -- per plugin; this pays one for the whole batch. Note
+// that plugin state calls are thread-affine, so the serializations
+// themselves still run sequentially on the plugin thread; the batch
+// removes the per-plugin hops, it does not parallelize the work.
+//
+// out_datas / out_sizes must each hold `count` entries. Entry i is
+// filled as by mh_get_state_alloc (release each with mh_state_free);
+// plugins that fail or report no state leave NULL / 0 in their slot.
+// Returns the number of states captured (0 on bad arguments).
+//
+// Same thread-safety class as mh_get_state: pause audio once around
+// the whole call, not per plugin.
+int mh_get_states_alloc(MH_Plugin* const* plugins, int count,
+                        void** out_datas, int* out_sizes);
+
+// Batch state restore: the mh_set_state counterpart of
+// mh_get_states_alloc. Entry i with a NULL data pointer or size <= 0
+// is skipped. Returns the number of states applied (0 on bad
+// arguments).
+//
+// Same thread-safety class as mh_set_state: NOT safe to overlap
+// mh_process on any plugin in the batch -- stop audio once around the
+// whole call.
+int mh_set_states(MH_Plugin* const* plugins, int count,
+                  const void* const* datas, const int* sizes);
+
 // Set transport info (call before mh_process to update tempo/position for plugins)
 // Pass NULL to clear transport info (plugins will see "no transport")
 int mh_set_transport(MH_Plugin* p, const MH_TransportInfo* transport);
 
+// Shared transport cell: one seqlock-published snapshot that any number
+// of plugins' playheads read. Driving N plugins from a common timeline
+// then costs one mh_shared_transport_write per block instead of N
+// mh_set_transport calls. Writes follow the same single-writer seqlock
+// discipline as mh_set_transport (one writing thread at a time); reads
+// are lock-free from any thread including audio threads.
+typedef struct MH_SharedTransport MH_SharedTransport;
+
+// Create / destroy a shared transport cell. The cell must outlive every
+// playhead attached to it -- detach (mh_set_transport_shared with NULL)
+// before freeing. Starts as "no transport".
+MH_SharedTransport* mh_shared_transport_create(void);
+void mh_shared_transport_free(MH_SharedTransport* st);
+
+// Publish a snapshot to the cell (one seqlock write). Pass NULL to
+// publish "no transport", like mh_set_transport. Returns 1 on success,
+// 0 on a NULL cell.
+int mh_shared_transport_write(MH_SharedTransport* st,
+                              const MH_TransportInfo* transport);
+
+// Point a plugin's playhead at a shared cell (NULL detaches and returns
+// to the plugin's own mh_set_transport state). While attached, the
+// plugin ignores mh_set_transport and reads the cell on every
+// getPosition query. Returns 1 on success, 0 on a NULL plugin.
+int mh_set_transport_shared(MH_Plugin* p, MH_SharedTransport* st);
+
 // Get plugin tail length in seconds (for reverbs, delays - time needed after input stops)
 // Returns 0.0 if plugin has no tail or on error
 double mh_get_tail_seconds(MH_Plugin* p);
@@ -384,6 +605,62 @@ int mh_process_auto(MH_Plugin* p,
                     const MH_ParamChange* param_changes,
                     int num_param_changes);
 
+// Automation granularity modes for mh_process_auto
+#define MH_AUTOMATION_SAMPLE_ACCURATE 0
+#define MH_AUTOMATION_BLOCK_RATE 1
+
+// Configure how mh_process_auto splits a block around parameter changes.
+//
+/// min_subblock_frames (>= 1): change offsets are coalesced to the nearest
+// multiple of this many frames, so a block is never split into
+// processBlock calls shorter than min_subblock_frames. Dense keyframe
+// automation otherwise splits a 512-frame block into dozens of tiny
+// calls, and many plugins have high fixed per-call overhead. 1 (the
+// default) keeps exact sample-accurate splitting.
+//
+// mode: MH_AUTOMATION_SAMPLE_ACCURATE (default) splits as above;
+// MH_AUTOMATION_BLOCK_RATE applies every change at block start and
+// processes the block in one call -- the fastest option when sample
+// accuracy is not required (e.g. automated offline renders).
+//
+// Returns 1 on success, 0 on invalid arguments.
+int mh_set_automation_granularity(MH_Plugin* p, int min_subblock_frames, int mode);
+
+// Read back the current automation granularity. Either out pointer may
+// be NULL. Returns 1 on success, 0 on failure.
+int mh_get_automation_granularity(MH_Plugin* p, int* min_subblock_frames, int* mode);
+
+// Host-side parameter smoothing modes
+#define MH_SMOOTH_LINEAR      0
+#define MH_SMOOTH_EXPONENTIAL 1
+
+// Declare a smoothing ramp for one parameter. With ramp_ms > 0, any
+// automation change addressed at the parameter (mh_process_auto, in
+// either granularity mode) becomes a ramp TARGET instead of an
+// immediate set: each process call advances the ramp one block step and
+// issues the plugin a single setValue -- the block is never split on
+// the smoothed parameter's account. A gain ride that used to cost 8
+// sub-block processBlock calls per block costs zero extra calls.
+//
+// MH_SMOOTH_LINEAR slews at a constant rate sized so a full-range
+// (0 -> 1) move takes ramp_ms; MH_SMOOTH_EXPONENTIAL is a one-pole lag
+// that settles within ~1% of the target in ramp_ms. Ramp resolution is
+// one value per processed block, so audible smoothness also depends on
+// the plugin's own parameter interpolation (most gain/filter params
+// interpolate internally; that is what makes block-rate ramps click-free).
+//
+// ramp_ms <= 0 turns smoothing off for the parameter (an in-flight ramp
+// completes by jumping to its target on the next block). mh_set_param
+// on a smoothed parameter stays immediate and resets the ramp state to
+// the new value. Returns 1 on success, 0 on failure (bad index / mode).
+int mh_set_param_smoothing(MH_Plugin* p, int param_index, float ramp_ms, int mode);
+
+// Read back one parameter's smoothing config. Either out pointer may be
+// NULL. Returns 1 on success, 0 if the parameter has never been within
+// a smoothing configuration (index out of range or smoothing never set
+// up on this plugin).
+int mh_get_param_smoothing(MH_Plugin* p, int param_index, float* ramp_ms, int* mode);
+
 // Reset plugin internal state (clears delay lines, reverb tails, filter states)
 // Call between unrelated audio segments to avoid artifacts
 // Returns 1 on success, 0 on failure
@@ -394,6 +671,56 @@ int mh_reset(MH_Plugin* p);
 // Returns 1 on success, 0 on failure
 int mh_set_non_realtime(MH_Plugin* p, int non_realtime);
 
+// Warm up a freshly opened plugin by processing `blocks` silence blocks
+// (max_block_size frames each, no MIDI) in non-realtime mode, then
+// resetting state. The first process call after open is routinely
+// 10-50x slower than steady state -- lazy allocations, internal table
+// builds, page faults on plugin data -- which is an audible glitch when
+// the first call happens inside a device callback. The silence passes
+// take those one-time costs (and pre-fault the lazily-allocated pages
+// they touch) on the calling thread instead; mh_reset afterwards clears
+// any tail the warm blocks left, and the plugin's prior non-realtime
+// setting is restored. Call after mh_open / state load and before
+// mh_audio_start. Returns 1 on success, 0 on NULL plugin, blocks < 1,
+// or a failed process call.
+int mh_warmup(MH_Plugin* p, int blocks);
+
+// Pin the host-side process buffers (float and double staging, every
+// channel up to max_block_size frames) with mlock so the OS cannot
+// evict them between callbacks. Plugin-internal state cannot be
+// enumerated from outside, so it is not covered here -- mh_warmup
+// pre-faults those pages, and together the two remove the cold-page
+// long-tail spikes live systems see after memory pressure. All-or-
+// nothing: if any mlock is refused (typically RLIMIT_MEMLOCK) the
+// partial locks are rolled back and 0 is returned, which is the
+// graceful-fallback path, not an error to abort on. Passing enabled=0
+// unpins. No-op returning 0 on Windows. Returns 1 when the requested
+// state is in effect, 0 otherwise (NULL plugin, lock refused).
+int mh_set_lock_memory(MH_Plugin* p, int enabled);
+
+// Bytes currently pinned by mh_set_lock_memory (0 when unpinned or
+// the lock was refused). Returns -1 on a NULL plugin.
+long long mh_get_locked_bytes(MH_Plugin* p);
+
+// Denormal control. By default every mh_process* call runs with
+// flush-to-zero + denormals-are-zero enabled (saved and restored around
+// the call, so the caller's FP environment is untouched) -- standard
+// DAW behavior that prevents the microcode stalls decaying feedback
+// (reverb/delay tails) otherwise triggers. Pass enabled=0 to opt a
+// plugin out, e.g. one whose DSP depends on gradual underflow.
+// Takes effect on the next process call; safe from any thread.
+// Returns 1 on success, 0 on a NULL plugin.
+int mh_set_denormal_control(MH_Plugin* p, int enabled);
+int mh_get_denormal_control(MH_Plugin* p);
+
+// Number of process calls on this plugin that observed a denormal
+// operand or flushed an underflow while denormal control was active --
+// the blocks that would have stalled without FTZ/DAZ. Monotonic since
+// open; diff two reads to attribute a block-time spike. 0 when denormal
+// control is disabled or the platform has no FTZ support (non-SSE x86,
+// non-AArch64 ARM).
+unsigned long long mh_get_denormal_hits(MH_Plugin* p);
+
 // Get plugin metadata without full instantiation
 // Useful for validation, inventory, state file compatibility checks
 // Returns 1 on success, 0 on failure (with error message in err_buf)
@@ -402,11 +729,47 @@ int mh_probe(const char* plugin_path,
              char* err_buf,
              size_t err_buf_size);
 
+// One entry of an mh_probe_batch result array.
+typedef struct MH_ProbeResult {
+    int ok;                     // 1 = desc is valid, 0 = probe failed (see error)
+    MH_PluginDesc desc;         // metadata on success; path is always populated
+    char error[256];            // failure reason when ok == 0
+} MH_ProbeResult;
+
+// Probe an explicit list of plugin paths in parallel. mh_probe builds
+// and tears down a format manager per call; here each worker builds one
+// and amortizes it over its share of the list, and workers pull indices
+// from a shared counter so one slow bundle does not serialize the rest
+// (the same pattern as mh_session_scan_directory_mt). results[] must
+// hold `count` entries and is written in place, one entry per path in
+// order, each carrying either the metadata or a per-entry error string
+// -- a failed path never aborts the batch. `concurrency` is the worker
+// count, clamped to [1, min(count, 64)]; <= 1 probes serially through a
+// single shared manager. No session is required: probing only needs a
+// format manager, never the session's plugin registry.
+// Returns the number of successful probes, or -1 on invalid arguments.
+int mh_probe_batch(const char* const* paths,
+                   int count,
+                   MH_ProbeResult* results,
+                   int concurrency);
+
 // Parameter value text conversion
 // Convert normalized value (0-1) to display string (e.g., "2500 Hz", "-6.0 dB")
 // Returns 1 on success, 0 on failure
 int mh_param_to_text(MH_Plugin* p, int index, float value, char* buf, size_t buf_size);
 
+// Batched variant of mh_param_to_text: converts count (index, value)
+// pairs with one message-thread hop and one lock instead of one per
+// call. `out` is count rows of `stride` bytes each; row i receives the
+// display string for (indices[i], values[i]). The same index may
+// appear more than once (e.g. min/default/max of one parameter).
+// Out-of-range indices leave their row as an empty string rather than
+// failing the batch.
+// Returns 1 on success, 0 on invalid arguments.
+int mh_params_to_text_bulk(MH_Plugin* p, const int* indices,
+                           const float* values, int count,
+                           char* out, size_t stride);
+
 // Convert display string to normalized value (0-1)
 // Returns 1 on success, 0 on failure (e.g., invalid text format)
 // Note: Not all plugins implement text-to-value conversion
@@ -428,6 +791,30 @@ int mh_get_program(MH_Plugin* p);
 // Returns 1 on success, 0 on failure
 int mh_set_program(MH_Plugin* p, int index);
 
+// Preset bank cache. mh_prefetch_programs walks every factory program
+// once through the ordinary switch path and captures its program-state
+// blob in memory; mh_set_program_fast then restores a program straight
+// from the cached blob, skipping the plugin's program-change machinery
+// (and its per-switch re-deserialization on heavyweight synths) --
+// auditioning a 100-program bank pays the slow path once at prefetch
+// instead of per switch.
+//
+// Caveat: the blob restore is the authoritative state. Plugins that do
+// not encode the program number in their program state may keep
+// reporting the previous index via mh_get_program after a fast switch.
+// mh_prefetch_programs audibly cycles through every program; both it
+// and mh_set_program_fast are thread-safety class 3 (the restore goes
+// through the same machinery as mh_set_program_state), so stop the
+// audio thread first. mh_clear_program_cache is class 2.
+//
+// mh_prefetch_programs returns the number of programs cached, 0 on
+// failure or when the plugin has none. mh_set_program_fast returns 1
+// on success, 0 when the index is out of range or not prefetched (fall
+// back to mh_set_program). mh_clear_program_cache frees the cache.
+int mh_prefetch_programs(MH_Plugin* p);
+int mh_set_program_fast(MH_Plugin* p, int index);
+int mh_clear_program_cache(MH_Plugin* p);
+
 // Bus layout query
 // Get number of input or output buses
 // is_input: 1 for input buses, 0 for output buses
@@ -477,6 +864,42 @@ int mh_process_sidechain(MH_Plugin* p,
 // Returns 0 if no sidechain or plugin opened with mh_open() instead of mh_open_ex()
 int mh_get_sidechain_channels(MH_Plugin* p);
 
+// Process with sidechain input and MIDI input in one call. Same buffer
+// layout as mh_process_sidechain; midi_events follow the
+// mh_process_midi contract (chronological, sample_offset block-relative,
+// can be NULL if num_midi_events is 0). Bounded by max_block_size like
+// mh_process_sidechain (no sub-blocking). This is what lets a graph or
+// chain drive a sidechain-keyed plugin that also takes MIDI without
+// dropping either stream.
+// Returns 1 on success, 0 on failure
+int mh_process_sidechain_midi(MH_Plugin* p,
+                              const float* const* main_in,
+                              float* const* main_out,
+                              const float* const* sidechain_in,
+                              int nframes,
+                              const MH_MidiEvent* midi_events,
+                              int num_midi_events);
+
+// Process one block and capture every enabled output bus in a single
+// processBlock call, instead of soloing buses across repeated renders.
+// bus_outputs: one planar pointer array per output bus, indexed by bus
+//   (mh_get_num_buses order): bus_outputs[b][ch][nframes]. Entries past
+//   num_buses, NULL entries, and disabled buses (0 channels) are
+//   skipped; each written bus receives exactly its
+//   MH_BusInfo.num_channels channels.
+// inputs: main input channels [in_ch][nframes]; NULL feeds silence
+//   (the usual case for multi-out instruments).
+// midi_events: MIDI for the block (can be NULL if num_midi_events is 0).
+// Bounded by max_block_size like mh_process_sidechain (no sub-blocking).
+// Returns 1 on success, 0 on failure.
+int mh_process_multibus(MH_Plugin* p,
+                        const float* const* inputs,
+                        float* const* const* bus_outputs,
+                        int num_buses,
+                        int nframes,
+                        const MH_MidiEvent* midi_events,
+                        int num_midi_events);
+
 // Check if a bus layout is supported before attempting to apply it
 // input_channels/output_channels: array of channel counts, one per bus
 // Returns 1 if supported, 0 if not supported or on error
@@ -507,6 +930,73 @@ int mh_set_change_callback(MH_Plugin* p, MH_ChangeCallback cb, void* user_data);
 int mh_set_param_value_callback(MH_Plugin* p, MH_ParamValueCallback cb, void* user_data);
 int mh_set_param_gesture_callback(MH_Plugin* p, MH_ParamGestureCallback cb, void* user_data);
 
+// Coalesced parameter value notifications. With interval_ms > 0,
+// plugin-initiated changes stop invoking the value callback one by one:
+// each change is a couple of atomic stores into a per-parameter
+// last-writer-wins slot, and a background flush forwards the surviving
+// value of every changed parameter once per interval. A GUI spraying
+// thousands of changes a second (preset morph, macro sweep) then costs
+// the consumer at most num_params callbacks per flush instead of one per
+// change. Per parameter the delivered value is always the most recent;
+// ordering ACROSS parameters within a flush is by index, not by arrival.
+// The callback fires on a dedicated flush thread (same contract as the
+// immediate path: callbacks may already arrive on arbitrary threads).
+//
+// interval_ms = 0 restores immediate per-change delivery (the default)
+// after forwarding anything still pending. The dirty set is sized to the
+// parameter count at the time of the call; parameters added later
+// (MH_CHANGE_PARAM_INFO) deliver immediately until coalescing is
+// re-enabled. Do not call concurrently with itself or mh_close on the
+// same plugin. Returns 1 on success, 0 on failure.
+int mh_set_param_value_coalescing(MH_Plugin* p, int interval_ms);
+
+// ---------------------------------------------------------------------------
+// Native parameter-change recording (mh_param_record_*)
+// ---------------------------------------------------------------------------
+//
+// Recording live knob movements by polling mh_get_param for every
+// parameter costs O(params x poll rate) and still misses fast gestures
+// between polls. Arming a plugin makes the listener trampoline append
+// one record per actual change into a bounded lock-free queue --
+// capture is exact and costs only the changes that happen. Records are
+// appended before coalescing, so an armed recorder sees every change
+// even when mh_set_param_value_coalescing thins the callback stream.
+//
+// Timestamps are steady-clock seconds since arming; multiply by the
+// sample rate for the sample offsets the automation timeline calls
+// (mh_graph_set_node_timeline, MH_ParamChange) consume.
+
+typedef struct MH_ParamRecord {
+    double time_sec;      // seconds since mh_param_record_start
+    int param_index;      // parameter index
+    float value;          // normalized value (0.0 to 1.0)
+} MH_ParamRecord;
+
+// Arm recording with room for `capacity` records (rounded up to a
+// power of two; <= 0 selects 4096). Fails if already armed -- stop
+// first. Same thread-safety class as mh_set_param_value_coalescing:
+// not safe concurrently with processing or parameter writes on this
+// plugin. Returns 1 on success, 0 on failure.
+int mh_param_record_start(MH_Plugin* p, int capacity);
+
+// Disarm. The queue is retained, so records captured before the stop
+// remain fetchable. Returns 1 on success, 0 on a null plugin.
+int mh_param_record_stop(MH_Plugin* p);
+
+// 1 while armed.
+int mh_param_record_armed(MH_Plugin* p);
+
+// Drain up to max_records captured records, oldest first, into `out`.
+// Returns the number copied. Safe to call while armed (one consumer at
+// a time); a live session typically fetches periodically from its
+// control thread.
+int mh_param_record_fetch(MH_Plugin* p, MH_ParamRecord* out, int max_records);
+
+// Records rejected because the queue was full since the last
+// mh_param_record_start. A non-zero value means fetch more often or
+// arm with a larger capacity.
+long long mh_param_record_dropped(MH_Plugin* p);
+
 // Signal start of a parameter change gesture (call before a sequence of mh_set_param calls)
 int mh_begin_param_gesture(MH_Plugin* p, int index);
 
@@ -531,6 +1021,11 @@ int mh_set_sample_rate(MH_Plugin* p, double new_sample_rate);
 // Get current sample rate
 double mh_get_sample_rate(MH_Plugin* p);
 
+// Get the max_block_size the plugin was prepared with (mh_open /
+// mh_open_ex). Blocks up to this size take the single-processBlock fast
+// path; larger blocks are sub-blocked (see mh_process).
+int mh_get_max_block_size(MH_Plugin* p);
+
 // Plugin directory scanning callback
 // Called for each valid plugin found in the directory
 // desc: plugin metadata (includes path field with full path to plugin)
@@ -598,6 +1093,53 @@ int mh_open_async(const char* plugin_path,
                   MH_LoadCallback callback,
                   void* user_data);
 
+// ---------------------------------------------------------------------------
+// Managed async load pool
+// ---------------------------------------------------------------------------
+//
+// mh_open_async spawns one background thread per call; opening a large
+// project that way creates as many threads as plugins. A load pool runs
+// submitted opens on a fixed set of worker threads instead, each worker
+// with its own pre-initialized format manager, so module discovery for
+// concurrent loads proceeds in parallel while thread counts stay bounded.
+// Callbacks fire from worker threads, one per submitted open, in
+// completion order (not submission order).
+typedef struct MH_LoadPool MH_LoadPool;
+
+// Create a pool with num_workers worker threads (clamped to [1, 64]).
+// Returns NULL on failure.
+MH_LoadPool* mh_load_pool_create(int num_workers,
+                                 char* err_buf, size_t err_buf_size);
+
+// Submit an open. Same semantics as mh_open; the callback receives the
+// plugin (or NULL + error) from a worker thread. Returns a ticket > 0
+// usable with mh_load_pool_cancel, or 0 on failure (NULL pool/path/
+// callback, or pool closing).
+long long mh_load_pool_open(MH_LoadPool* pool,
+                            const char* plugin_path,
+                            double sample_rate,
+                            int max_block_size,
+                            int requested_in_ch,
+                            int requested_out_ch,
+                            MH_LoadCallback callback,
+                            void* user_data);
+
+// Cancel a submitted open that has not started yet. Returns 1 if the job
+// was removed from the queue -- its callback will NOT be invoked, so the
+// caller keeps ownership of user_data -- or 0 if the job already started
+// (its callback will still fire), already finished, or is unknown.
+int mh_load_pool_cancel(MH_LoadPool* pool, long long ticket);
+
+// Number of submitted opens not yet completed (queued + in flight).
+// Returns -1 for a NULL pool.
+int mh_load_pool_pending(MH_LoadPool* pool);
+
+// Close the pool: queued-but-unstarted jobs are dropped without their
+// callbacks firing, in-flight jobs run to completion (callbacks fire),
+// then the workers are joined and the pool freed. Plugins delivered via
+// callbacks are unaffected and remain the caller's to close.
+void mh_load_pool_close(MH_LoadPool* pool);
+
 // ---------------------------------------------------------------------------
 // Session: shared plugin-format-manager state across loads/probes/scans
 // ---------------------------------------------------------------------------
@@ -612,7 +1154,14 @@ int mh_open_async(const char* plugin_path,
 //
 // Sessions are thread-safe for concurrent use of mh_session_open /
 // mh_session_probe / mh_session_scan_directory from multiple threads
-// against the same session (internal lock).
+// against the same session, and genuinely concurrent: the session
+// holds several internally-locked format-manager shards and each call
+// acquires one for its duration, so parallel probes/opens fan out
+// instead of serializing behind a single lock (shards beyond the
+// first are initialized lazily, only when contention reaches them).
+// LV2-targeted calls are the exception: they all share one
+// session-wide LV2 context (see mh_session_open_opts below) and
+// serialize behind it -- one lilv world, one lock.
 typedef struct MH_Session MH_Session;
 
 // Create a session. Returns NULL on failure.
@@ -646,6 +1195,121 @@ MH_Plugin* mh_session_open_desc(MH_Session* session,
                                 char* err_buf,
                                 size_t err_buf_size);
 
+// ---------------------------------------------------------------------------
+// Typed per-format open options
+// ---------------------------------------------------------------------------
+//
+// mh_session_open discovers across every registered format; the typed
+// variant below pins the open to one format up front. That matters
+// most for LV2: resolving an LV2 bundle (re)parses the lilv world --
+// every installed .ttl file -- once per format-manager instance, so
+// opens fanning out across the session's shards pay that parse once
+// per shard they touch. The session therefore keeps one shared LV2
+// context, created on the first LV2-targeted open/probe and reused for
+// the session's lifetime: opening 10 LV2 plugins through one session
+// costs one world parse. LV2 calls serialize behind the shared
+// context's lock, which is still far cheaper than re-parsing. VST3
+// needs no session context -- moduleinfo parsing is served from the
+// per-process module cache, invalidated on file size/mtime change.
+
+#define MH_FORMAT_ANY  0   // discover across all formats (mh_session_open behavior)
+#define MH_FORMAT_VST3 1
+#define MH_FORMAT_AU   2   // macOS only
+#define MH_FORMAT_LV2  3   // requires an LV2-enabled build
+
+typedef struct MH_OpenOptions
+{
+    double sample_rate;
+    int max_block_size;
+    int main_in_ch;
+    int main_out_ch;
+    int sidechain_in_ch;
+    int format;            // one of the MH_FORMAT_* constants
+} MH_OpenOptions;
+
+// Fill `opts` with defaults: 48000 Hz, 512-frame blocks, stereo in and
+// out, no sidechain, MH_FORMAT_ANY. Always initialize through this
+// before setting fields, so options added later keep old callers
+// well-defined.
+void mh_open_options_init(MH_OpenOptions* opts);
+
+// Load a plugin through the session with typed options. With
+// MH_FORMAT_ANY this behaves like mh_session_open (LV2 bundles route
+// to the shared LV2 context either way, keyed on the .lv2 extension).
+// A typed format restricts the open to that format: the file must
+// resolve as that format or the open fails -- a path never silently
+// opens through different machinery than the caller coded against.
+// Returns NULL on failure.
+MH_Plugin* mh_session_open_opts(MH_Session* session,
+                                 const char* plugin_path,
+                                 const MH_OpenOptions* opts,
+                                 char* err_buf,
+                                 size_t err_buf_size);
+
+// Drop the session's shared LV2 context so the next LV2-targeted call
+// rebuilds it. The lilv world is a snapshot of the installed bundles
+// taken when the context came up; bundles installed since are
+// invisible to the session until a refresh. VST3 needs no refresh (the
+// module cache invalidates on file change), and
+// mh_session_scan_directory_mt always probes through fresh private
+// managers. Cheap when nothing is cached. Returns 1, or 0 on a null
+// session.
+int mh_session_refresh_formats(MH_Session* session);
+
+// ---------------------------------------------------------------------------
+// Instance pooling (mh_session_acquire / mh_session_release)
+// ---------------------------------------------------------------------------
+//
+// Batch jobs that open and close the same effect thousands of times
+// pay instance construction + prepareToPlay per job, even with the
+// module cache keeping the binary mapped. The session can pool
+// instances instead: mh_session_release parks the plugin rather than
+// closing it, and a later mh_session_acquire for the same bundle,
+// rate, block size and layout revives the parked instance with
+// mh_reset plus the state it was born with. Per-job plugin cost drops
+// from a full construction to the cost of a reset.
+
+// Configure the pool. At most `max_idle` instances are parked across
+// the whole session (0, the default, disables pooling -- release then
+// closes, so release is always safe to call), and parked instances
+// idle longer than `idle_ttl_ms` are closed on the next
+// acquire/release (0 = no age limit). Shrinking the limits evicts
+// immediately, oldest first. Returns 1, or 0 on a null session or
+// negative arguments.
+int mh_session_set_pool(MH_Session* session, int max_idle, int idle_ttl_ms);
+
+// Acquire an instance of `plugin_path`. Served from the pool when a
+// parked instance matches the requested rate/block/layout exactly:
+// the instance is revived with mh_reset and the state captured when
+// its key was first opened, so each job starts from factory defaults.
+// Opened fresh through the session otherwise (same path as
+// mh_session_open). The returned handle is an ordinary plugin; close
+// it with mh_close if it should not return to the pool. Returns NULL
+// on failure.
+MH_Plugin* mh_session_acquire(MH_Session* session,
+                              const char* plugin_path,
+                              double sample_rate,
+                              int max_block_size,
+                              int main_in_ch,
+                              int main_out_ch,
+                              int sidechain_in_ch,
+                              char* err_buf,
+                              size_t err_buf_size);
+
+// Return `plugin` to the session's pool, or close it when pooling is
+// disabled, the pool is full (after evicting the oldest entries), the
+// handle was not acquired through this pool, or a standby swap is
+// pending on it. Registered change/parameter callbacks are cleared
+// and coalescing is stopped so a later acquirer never inherits them;
+// other per-handle policy (BPM, smoothing config, denormal control)
+// follows the instance. Same lifecycle rule as mh_close: no other
+// thread may be using the plugin. Returns 1 when the plugin was
+// parked or closed, 0 on null arguments.
+int mh_session_release(MH_Session* session, MH_Plugin* plugin);
+
+// Number of instances currently parked in the session's pool.
+int mh_session_pool_size(MH_Session* session);
+
 // Probe a plugin file using the session's format manager.
 int mh_session_probe(MH_Session* session,
                       const char* plugin_path,
@@ -659,6 +1323,131 @@ int mh_session_scan_directory(MH_Session* session,
                                MH_ScanCallback callback,
                                void* user_data);
 
+// Parallel variant of mh_session_scan_directory: candidate plugins are
+// probed by up to num_threads workers concurrently. Probing is
+// I/O-plus-dlopen-bound and independent per file, so a cold scan of a
+// large plugin tree drops to roughly the time of its slowest shard.
+// Each worker probes through its own private format manager (the
+// session's manager is never touched, so other mh_session_* calls stay
+// usable during the scan). Callback invocations are serialized -- the
+// callback never runs reentrantly -- but arrive in no particular
+// order, unlike the serial scan's sorted order. num_threads is clamped
+// to [1, 64] and to the number of candidates; 1 behaves exactly like
+// mh_session_scan_directory. Returns number of plugins found, or -1 on
+// error.
+int mh_session_scan_directory_mt(MH_Session* session,
+                                  const char* directory_path,
+                                  int num_threads,
+                                  MH_ScanCallback callback,
+                                  void* user_data);
+
+// Open a warm standby instance of `plugin` for instant A/B state flips.
+// A second instance of the same bundle is loaded through the session
+// (the module cache keeps the binary mapped, so the on-disk discovery
+// pass is skipped), configured with the active instance's sample rate,
+// block size and channel layout, and the active instance's current
+// state pre-applied. The expensive half of a state switch --
+// setStateInformation on a big sampler can take seconds -- is thereby
+// paid here, on the control thread, instead of at switch time. The
+// returned handle is an ordinary plugin: load the alternate state into
+// it with mh_set_state, flip with mh_standby_swap, and close it with
+// mh_close when done. Memory cost is a full second instance, which is
+// the explicit, opt-in price of the instant flip. Returns NULL on
+// failure (including when the clone's bus negotiation resolves to a
+// different layout than the active instance's).
+MH_Plugin* mh_session_standby(MH_Session* session,
+                               MH_Plugin* plugin,
+                               char* err_buf,
+                               size_t err_buf_size);
+
+// Stage `standby` to take over `active`'s role without stopping the
+// stream. The next process call on `active` (any mh_process* entry
+// point) adopts it at its block boundary: the two handles exchange
+// engine instances, so the state switch observed through `active` is a
+// few pointer swaps rather than a setStateInformation round trip. The
+// displaced engine lands in `standby` -- still warm, still holding its
+// state -- ready to be staged back for the return flip. Per-handle
+// policy (registered callbacks, smoothing config, BPM, denormal
+// control) stays with each handle; in-flight smoothing ramps are
+// cancelled on both sides.
+//
+// Both handles must come from the same bundle and share sample rate,
+// block size and channel layout (mh_session_standby guarantees this).
+// The flip is a hard cut at the block boundary; for a crossfaded flip
+// run the plugin in a chain and use mh_chain_replace_plugin instead.
+// Do not call control/state functions on either handle, and do not
+// close either handle, while a swap is pending -- poll
+// mh_standby_swap_pending for 0 first. Parameter-value coalescing
+// (mh_set_param_value_coalescing) must be disabled on both handles.
+// Only one swap per active handle may be in flight at a time.
+//
+// Returns 1 when staged, 0 on failure (null or identical handles,
+// bundle/rate/layout mismatch, coalescing enabled, previous swap still
+// pending).
+int mh_standby_swap(MH_Plugin* active,
+                    MH_Plugin* standby,
+                    char* err_buf,
+                    size_t err_buf_size);
+
+// 1 while a swap staged on `active` has not yet been adopted by a
+// process call; 0 once both handles are safe to touch again.
+int mh_standby_swap_pending(MH_Plugin* active);
+
+// ---------------------------------------------------------------------------
+// Per-process module cache
+// ---------------------------------------------------------------------------
+//
+// The open paths (mh_open, mh_open_ex, mh_session_open) remember the
+// resolved plugin description per bundle path, so the
+// second-through-Nth open of the same bundle in one process skips the
+// on-disk discovery pass (binary read, moduleinfo parse, factory
+// scan). On Linux the bundle's shared object is additionally kept
+// mapped between instances, so closing the last instance and
+// reopening does not dlopen from scratch. Entries are invalidated
+// automatically when the bundle's size or mtime changes on disk.
+//
+// The cache is always on; these calls exist for inspection and for
+// forcing a cold open (e.g. after replacing a bundle without its
+// mtime changing).
+
+// Number of bundles currently cached.
+int mh_module_cache_size(void);
+
+// Drop all cached descriptions and release the module residency pins.
+// Plugins already open are unaffected. Do not call concurrently with
+// open/probe calls.
+void mh_module_cache_clear(void);
+
+// ---------------------------------------------------------------------------
+// Negotiated-layout cache
+// ---------------------------------------------------------------------------
+//
+// mh_check_buses_layout round-trips the plugin, and enumerating a
+// plugin with many bus configurations can take seconds. Answers are
+// memoized process-wide per (plugin identifier, version, requested
+// per-bus channel counts) -- the version in the key means a plugin
+// update re-probes rather than trusting the old binary's answers.
+// The cache is always on; export/import exist so a host can persist
+// it between runs (the Python plugincache store does) and a daily
+// project reload skips the probing entirely.
+
+// Number of memoized layout answers.
+int mh_layout_cache_size(void);
+
+// Drop every memoized answer (e.g. to force a cold re-probe).
+void mh_layout_cache_clear(void);
+
+// Serialize the cache into a NUL-terminated text blob, one answer per
+// line. Returns the byte count required (including the NUL); the blob
+// is written only when buf is non-NULL and buf_size is at least that
+// large, so call once with NULL to size, then again with a buffer.
+int mh_layout_cache_export(char* buf, int buf_size);
+
+// Merge a previously exported blob into the cache. Malformed lines
+// are skipped (the cache is an optimization, never a correctness
+// input). Returns the number of answers imported.
+int mh_layout_cache_import(const char* data);
+
 #ifdef __cplusplus
 }
 #endif
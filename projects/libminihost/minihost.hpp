@@ -0,0 +1,307 @@
+// minihost.hpp
+//
+// Header-only C++17 wrapper over the core C API in `minihost.h`. RAII,
+// method syntax, exceptions on open failure. No new functionality --
+// pure sugar, same policy as `minihost_graph_v2.hpp`.
+//
+// Three pieces:
+//
+//   * `minihost::Plugin` -- unique-ownership handle over MH_Plugin.
+//     Every method inlines straight to its C call; the hot process
+//     entry points are noexcept and return bool, matching the C 1/0
+//     convention instead of throwing on the audio thread.
+//
+//   * `minihost::Span<T>` -- minimal pointer+length view (C++17
+//     predates std::span) so process calls and event lists can take
+//     vectors, arrays and C buffers through one signature.
+//
+//   * `minihost::Chain<Stages...>` -- compile-time chain composition.
+//     The stage list is a template parameter pack, so the hop loop
+//     monomorphizes: no per-hop dispatch, no argument re-marshalling,
+//     and the whole pipeline is visible to the inliner. Plugins load
+//     at run time, so the pack holds stage *types* rather than plugin
+//     identities -- `Chain<Plugin, Plugin, Plugin>` for a loaded
+//     synth/reverb/limiter stack, or any mix of `Plugin` and user DSP
+//     functors exposing the same `process` shape, which is where
+//     static composition actually pays (a custom gain stage inlines
+//     to a multiply; a chain of function pointers cannot).
+//
+// `Chain` is deliberately lean next to MH_PluginChain: no per-stage
+// mix/bypass, hot-swap crossfades, silence skip or pipelining. Those
+// live behind `minihost_chain.h`; this template is for fixed pipelines
+// where the per-call overhead of the dynamic chain is the point.
+//
+// The C ABI stays the source of truth and the surface the Python
+// wheel binds against.
+
+#pragma once
+
+#include "minihost.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace minihost {
+
+// Minimal span: pointer + length, no ownership. Implicit from any
+// contiguous container with data()/size() (std::vector, std::array)
+// and from C arrays, so call sites stay clean without committing the
+// public surface to a particular container.
+template <typename T>
+class Span {
+public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept
+        : data_(data), size_(size) {}
+    template <std::size_t N>
+    constexpr Span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+    template <typename C,
+              typename = decltype(std::declval<C&>().data()
+                                  + std::declval<C&>().size())>
+    constexpr Span(C& c) noexcept : data_(c.data()), size_(c.size()) {}
+
+    constexpr T*          data()  const noexcept { return data_; }
+    constexpr std::size_t size()  const noexcept { return size_; }
+    constexpr bool        empty() const noexcept { return size_ == 0; }
+    constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end()   const noexcept { return data_ + size_; }
+
+private:
+    T*          data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+class Plugin {
+public:
+    // requested_in_ch / requested_out_ch of 0 accept the plugin's
+    // default bus layout (the common case across the repo's hosts).
+    Plugin(const char* path, double sample_rate, int max_block_size,
+           int requested_in_ch = 0, int requested_out_ch = 0)
+    {
+        char err[kErrLen] = {0};
+        p_ = mh_open(path, sample_rate, max_block_size,
+                     requested_in_ch, requested_out_ch,
+                     err, sizeof(err));
+        if (p_ == nullptr) throwErr("mh_open", err);
+    }
+
+    ~Plugin() { if (p_) mh_close(p_); }
+
+    Plugin(const Plugin&) = delete;
+    Plugin& operator=(const Plugin&) = delete;
+
+    Plugin(Plugin&& other) noexcept : p_(other.p_) { other.p_ = nullptr; }
+    Plugin& operator=(Plugin&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (p_) mh_close(p_);
+            p_ = other.p_;
+            other.p_ = nullptr;
+        }
+        return *this;
+    }
+
+    // Direct access for the (large) parts of minihost.h not wrapped
+    // here -- state, programs, buses, callbacks. Use sparingly.
+    MH_Plugin* handle() const noexcept { return p_; }
+
+    MH_Info info() const noexcept
+    {
+        MH_Info i{};
+        mh_get_info(p_, &i);
+        return i;
+    }
+    int numInputChannels()  const noexcept { return info().num_input_ch; }
+    int numOutputChannels() const noexcept { return info().num_output_ch; }
+    int latencySamples()    const noexcept { return mh_get_latency_samples(p_); }
+    double tailSeconds()    const noexcept { return mh_get_tail_seconds(p_); }
+    const char* path()      const noexcept { return mh_get_path(p_); }
+
+    int   numParams()              const noexcept { return mh_get_num_params(p_); }
+    float getParam(int index)      const noexcept { return mh_get_param(p_, index); }
+    bool  setParam(int index, float normalized) noexcept
+    { return mh_set_param(p_, index, normalized) != 0; }
+
+    bool reset() noexcept { return mh_reset(p_) != 0; }
+    bool setBypass(bool bypassed) noexcept
+    { return mh_set_bypass(p_, bypassed ? 1 : 0) != 0; }
+    bool bypassed() const noexcept { return mh_get_bypass(p_) != 0; }
+
+    // ---- Process entry points ----
+    //
+    // noexcept, bool return: these sit on the audio thread, where the
+    // wrapper must not add failure modes the C API does not have.
+    // Buffer semantics (NULL tables, variable nframes, sub-blocking)
+    // are exactly those documented on mh_process in minihost.h.
+    bool process(const float* const* inputs, float* const* outputs,
+                 int nframes) noexcept
+    { return mh_process(p_, inputs, outputs, nframes) != 0; }
+
+    bool process(Span<const float* const> inputs,
+                 Span<float* const> outputs, int nframes) noexcept
+    { return mh_process(p_, inputs.data(), outputs.data(), nframes) != 0; }
+
+    bool processMidi(const float* const* inputs, float* const* outputs,
+                     int nframes, Span<const MH_MidiEvent> midi) noexcept
+    {
+        return mh_process_midi(p_, inputs, outputs, nframes,
+                               midi.data(), (int) midi.size()) != 0;
+    }
+
+    // Returns the number of MIDI events written to midi_out, or -1 on
+    // process failure.
+    int processMidiIo(const float* const* inputs, float* const* outputs,
+                      int nframes, Span<const MH_MidiEvent> midi_in,
+                      Span<MH_MidiEvent> midi_out) noexcept
+    {
+        int n = 0;
+        if (!mh_process_midi_io(p_, inputs, outputs, nframes,
+                                midi_in.data(), (int) midi_in.size(),
+                                midi_out.data(), (int) midi_out.size(),
+                                &n))
+            return -1;
+        return n;
+    }
+
+    bool processInterleaved(Span<const float> in, Span<float> out,
+                            int nframes, int channels) noexcept
+    {
+        return mh_process_interleaved(p_, in.data(), out.data(),
+                                      nframes, channels) != 0;
+    }
+
+    bool processDouble(const double* const* inputs,
+                       double* const* outputs, int nframes) noexcept
+    { return mh_process_double(p_, inputs, outputs, nframes) != 0; }
+
+private:
+    static constexpr std::size_t kErrLen = 256;
+
+    [[noreturn]] static void throwErr(const char* op, const char* err)
+    {
+        std::string msg = "minihost::Plugin::";
+        msg += op;
+        if (err && *err) { msg += ": "; msg += err; }
+        throw std::runtime_error(std::move(msg));
+    }
+
+    MH_Plugin* p_ = nullptr;
+};
+
+// Compile-time chain composition. Stages run in pack order; each must
+// expose `bool process(const float* const*, float* const*, int)`
+// (Plugin does, and so can any user functor). Inter-stage buffers are
+// two ping-pong scratch banks sized once at construction -- process()
+// never allocates -- and since the stage index is a template
+// parameter, the hop recursion below flattens into straight-line code
+// with every process call resolved statically.
+//
+// Width handling is the caller's contract, as with the raw C calls:
+// scratch carries max_channels pointers, and each stage reads the
+// widths it was opened with. For width-adapting or dynamically edited
+// pipelines use MH_PluginChain / MH_PluginGraph instead.
+template <typename... Stages>
+class Chain {
+    static_assert(sizeof...(Stages) >= 1,
+                  "Chain needs at least one stage");
+
+public:
+    Chain(int max_channels, int max_block_size, Stages... stages)
+        : stages_(std::move(stages)...)
+    {
+        if (max_channels < 1 || max_block_size < 1)
+            throw std::invalid_argument(
+                "minihost::Chain: max_channels and max_block_size "
+                "must be >= 1");
+        // A single-stage chain needs no scratch; two banks otherwise
+        // (stage i reads bank (i-1)&1 and writes bank i&1, so producer
+        // and consumer never share a buffer).
+        if (sizeof...(Stages) > 1)
+        {
+            scratch_storage_.assign(
+                2 * (std::size_t) max_channels * (std::size_t) max_block_size,
+                0.0f);
+            for (int b = 0; b < 2; ++b)
+            {
+                bank_[b].resize((std::size_t) max_channels);
+                for (int c = 0; c < max_channels; ++c)
+                    bank_[b][(std::size_t) c]
+                        = scratch_storage_.data()
+                          + ((std::size_t) b * max_channels + c)
+                                * max_block_size;
+            }
+        }
+    }
+
+    Chain(const Chain&) = delete;
+    Chain& operator=(const Chain&) = delete;
+    Chain(Chain&&) = default;
+    Chain& operator=(Chain&&) = default;
+
+    static constexpr std::size_t size() noexcept
+    { return sizeof...(Stages); }
+
+    // The I-th stage, for parameter access mid-stream:
+    //     chain.stage<1>().setParam(0, 0.4f);
+    template <std::size_t I>       auto& stage()       noexcept
+    { return std::get<I>(stages_); }
+    template <std::size_t I> const auto& stage() const noexcept
+    { return std::get<I>(stages_); }
+
+    // Run the whole pipeline for one block. Returns false as soon as
+    // any stage fails, leaving later stages untouched.
+    bool process(const float* const* inputs, float* const* outputs,
+                 int nframes) noexcept
+    { return hop<0>(inputs, outputs, nframes); }
+
+    bool process(Span<const float* const> inputs,
+                 Span<float* const> outputs, int nframes) noexcept
+    { return hop<0>(inputs.data(), outputs.data(), nframes); }
+
+private:
+    template <std::size_t I>
+    bool hop(const float* const* in, float* const* out, int nframes) noexcept
+    {
+        if constexpr (I + 1 == sizeof...(Stages))
+        {
+            return std::get<I>(stages_).process(in, out, nframes);
+        }
+        else
+        {
+            float* const* mid = bank_[I & 1].data();
+            if (!std::get<I>(stages_).process(in, mid, nframes))
+                return false;
+            return hop<I + 1>(mid, out, nframes);
+        }
+    }
+
+    std::tuple<Stages...> stages_;
+    std::vector<float>    scratch_storage_;
+    std::vector<float*>   bank_[2];
+};
+
+// Deduce the pack from the trailing stage arguments:
+//     auto c = minihost::Chain(2, 512, std::move(synth),
+//                              std::move(reverb), std::move(limiter));
+template <typename... Stages>
+Chain(int, int, Stages...) -> Chain<Stages...>;
+
+// Forwarding factory for call sites that prefer a named function (or
+// predate class template argument deduction in the local style).
+template <typename... Stages>
+Chain<std::decay_t<Stages>...> makeChain(int max_channels,
+                                         int max_block_size,
+                                         Stages&&... stages)
+{
+    return Chain<std::decay_t<Stages>...>(
+        max_channels, max_block_size,
+        std::forward<Stages>(stages)...);
+}
+
+} // namespace minihost
@@ -3,12 +3,38 @@
 
 #include "minihost_chain.h"
 #include "minihost.h"
+#include "minihost_rt_audit.h"
+#include "minihost_denormal.h"
+#include "minihost_eventlog.h"
+#include "minihost_metrics.h"
+#include "minihost_threads.h"
+#include "minihost_trace.h"
 
 #include <vector>
+#include <climits>
 #include <cstring>
 #include <cstdio>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Vector ISA for the dry/wet blend kernel. Compile-time dispatch, same
+// policy as the graph's mix kernels: SSE2 is baseline on x86_64 and
+// NEON on aarch64, so no runtime CPU detection.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define MH_CHAIN_MIX_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define MH_CHAIN_MIX_NEON 1
+#endif
+
+struct MH_ChainScratchArena;
 
 struct MH_PluginChain
 {
@@ -35,23 +61,406 @@ struct MH_PluginChain
     std::vector<MH_MidiEvent> autoChunkMidiIn;
     std::vector<MH_MidiEvent> autoChunkMidiOut;
 
-    // Per-plugin dry/wet mix. Defaults to 1.0 (full wet).
+    // Per-plugin packed control word, written by control threads
+    // (mh_chain_set_bypass / mh_chain_set_mix) and read wait-free --
+    // relaxed loads, no mutex -- by every audio path, so the "audio
+    // thread takes no locks" contract covers bypass and the dry/wet
+    // mix. Layout:
+    //   bit  0     : bypass (stage passes its input through unchanged)
+    //   bits 1..7  : reserved
+    //   bits 8..31 : wet mix, Q0.24 (0 = full dry, 0xFFFFFF = full wet)
+    // Both controls require in_ch == out_ch (identity passthrough and
+    // the dry snapshot are only well-defined then); the setters reject
+    // other stages. Sized once at create, like the smoother array on
+    // the plugin side.
+    std::unique_ptr<std::atomic<unsigned>[]> stage_control;
+
     // dry_storage[i] is non-empty only for plugins where in_ch == out_ch;
-    // for others, set_mix is rejected and mixes[i] stays at 1.0.
-    std::vector<float> mixes;
+    // for others, set_mix is rejected and the mix stays at full wet.
     std::vector<int> plugin_in_ch;
     std::vector<int> plugin_out_ch;
     std::vector<std::vector<float>> dry_storage;
     std::vector<std::vector<float*>> dry_ptrs;
+
+    // Audio-thread only: did snapshotDry copy this block? Full-wet
+    // stages skip the snapshot, and applyMix must agree with that
+    // decision even if a control thread moved the mix mid-block -- the
+    // flag makes the pair atomic without widening the control word.
+    std::vector<char> dry_valid;
+
+    // Per-stage sidechain source (mh_chain_set_sidechain_input): a
+    // borrowed planar pointer table, or null when the stage runs
+    // without a key signal. Staged from the thread driving the serial
+    // process calls (or while the chain is idle) and consumed by every
+    // subsequent block until cleared; the pointers and the audio
+    // behind them are caller-owned and must outlive the staging.
+    // plugin_sidechain_ch caches mh_get_sidechain_channels per stage
+    // so staging can be validated without touching the plugin.
+    std::vector<const float* const*> sidechain_srcs;
+    std::vector<int> plugin_sidechain_ch;
+
+    // Trace-span ring (mh_chain_set_tracing). Sized by the enabling
+    // call; the audio thread only writes into pre-existing slots.
+    // trace_block numbers each mh_chain_process_midi_io call (auto
+    // chunks count individually) so spans group per block in the
+    // exported timeline.
+    mh_trace::Ring trace_ring;
+    std::atomic<long long> trace_block{0};
+
+    // Silence-aware skip (mh_chain_set_silence_skip). tail_remaining[i]
+    // is the plugin's ring-out budget in samples once its input goes
+    // silent; -1 means "input was live last block" and the budget is
+    // re-queried from mh_get_tail_seconds on the next silent block (the
+    // query takes the plugin's state mutex, so it only happens on the
+    // live->silent transition, not per block).
+    int silence_skip = 0;
+    std::vector<long long> tail_remaining;
+
+    // Plugin hot-swap (mh_chain_replace_plugin). The control thread
+    // stages the incoming plugin here after allocating the fade
+    // scratch; the next serial process call adopts it at the block
+    // boundary and equal-power crossfades the outgoing instance's
+    // output against the newcomer's. Only the two staging fields and
+    // xfade_remaining cross threads; the rest is audio-thread only.
+    std::atomic<MH_Plugin*> pending_replacement{nullptr};
+    int pending_replacement_index = -1;   // written before the release store
+    MH_Plugin* outgoing = nullptr;        // old instance, rendered during the fade
+    int xfade_index = -1;
+    int xfade_total = 0;
+    std::atomic<int> xfade_remaining{0};
+    std::vector<float> xfade_storage;     // out_ch * max_block_size
+    std::vector<float*> xfade_ptrs;
+
+    // Double-precision path (mh_chain_process_double): one shared
+    // 64-bit scratch allocation carved into two ping-pong inter-stage
+    // buffers plus a dry-snapshot region for the dry/wet blend. Each
+    // region is max_stage_channels * max_block_size doubles, sized at
+    // chain creation so the process call never allocates.
+    std::vector<double> dbl_storage;
+    std::vector<double*> dbl_scratch_ptrs[2];
+    std::vector<double*> dbl_dry_ptrs;
+
+    // Precompiled automation timeline (mh_chain_set_automation_timeline).
+    // The flat MH_ChainParamChange list is split into one sorted lane
+    // per plugin at set time; each process block stages only the
+    // [timeline_frame, timeline_frame + nframes) slice of each lane,
+    // rebased to block-local offsets, into block_scratch. A forward
+    // cursor per lane makes the per-block cost O(changes this block)
+    // with no sorting or filtering on the audio thread.
+    struct TimelineLane
+    {
+        std::vector<MH_ParamChange> changes;        // sorted by absolute offset
+        size_t cursor = 0;
+        std::vector<MH_ParamChange> block_scratch;  // this block's rebased slice
+    };
+    std::vector<TimelineLane> timeline_lanes;       // one per plugin slot
+    long long timeline_frame = 0;
+
+    // Shared inter-stage scratch (mh_chain_set_scratch_arena). When
+    // attached, intermediate_ptrs point into the arena's region and
+    // intermediate_storage is released; null means private scratch.
+    // Written by the attach/detach calls only, never by the audio paths.
+    MH_ChainScratchArena* scratch_arena = nullptr;
+};
+
+// Shared inter-stage scratch region (mh_chain_arena_create). One
+// allocation sized for the hungriest attached chain; every attached
+// chain carves its stage layout from offset 0, which is sound only
+// because chains on one audio thread never process concurrently (the
+// single-audio-thread model documented in minihost_chain.h). The
+// registry exists so a growth re-points every attached chain; the
+// mutex guards attach/detach/free against each other, not against the
+// audio thread -- those calls are control-thread-while-idle by
+// contract.
+struct MH_ChainScratchArena
+{
+    std::mutex mtx;
+    std::vector<float> storage;
+    std::vector<MH_PluginChain*> chains;
 };
 
+// Process-wide block counter (mh_metrics). Registered on first chain
+// create; -1 (ignored by mh_metric_add) until then.
+static std::atomic<int> g_chain_blocks_metric{-1};
+
+// Control-word layout for MH_PluginChain::stage_control. The mix gets
+// 24 bits so quantization stays below float round-off for the values
+// control code actually sets (error <= 6e-8).
+static constexpr unsigned kStageBypassBit = 1u;
+static constexpr unsigned kStageMixShift  = 8;
+static constexpr unsigned kStageMixOne    = 0xFFFFFFu;
+
+static float stageMix(unsigned word)
+{
+    return (float) (word >> kStageMixShift) * (1.0f / (float) kStageMixOne);
+}
+
+// wet = mix * wet + (1 - mix) * dry. Callers elide the full-wet case
+// (no snapshot was taken), so no degenerate-gain shortcut here.
+static void blendWetDry(float* wet, const float* dry, float mix, int n)
+{
+    const float dry_gain = 1.0f - mix;
+    int i = 0;
+#if defined(MH_CHAIN_MIX_SSE2)
+    const __m128 vw = _mm_set1_ps(mix);
+    const __m128 vd = _mm_set1_ps(dry_gain);
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128 w = _mm_mul_ps(_mm_loadu_ps(wet + i), vw);
+        const __m128 d = _mm_mul_ps(_mm_loadu_ps(dry + i), vd);
+        _mm_storeu_ps(wet + i, _mm_add_ps(w, d));
+    }
+#elif defined(MH_CHAIN_MIX_NEON)
+    const float32x4_t vw = vdupq_n_f32(mix);
+    const float32x4_t vd = vdupq_n_f32(dry_gain);
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(wet + i,
+                  vmlaq_f32(vmulq_f32(vld1q_f32(wet + i), vw),
+                            vld1q_f32(dry + i), vd));
+#endif
+    for (; i < n; ++i) wet[i] = mix * wet[i] + dry_gain * dry[i];
+}
+
+// Crossfade length for mh_chain_replace_plugin: ~21 ms at 48 kHz,
+// long enough to mask the state discontinuity, short enough that A/B
+// flips still feel instant.
+static const int kReplaceFadeSamples = 1024;
+
+// Peak threshold below which a block counts as silent: -160 dBFS, low
+// enough to catch exact zeros and denormal dust without gating quiet
+// program material.
+static const float kSilenceThreshold = 1.0e-8f;
+
+static bool blockIsSilent(const float* const* bufs, int channels, int nframes)
+{
+    if (bufs == nullptr) return true;
+    for (int c = 0; c < channels; ++c)
+    {
+        const float* buf = bufs[c];
+        if (buf == nullptr) continue;
+        for (int n = 0; n < nframes; ++n)
+            if (std::fabs(buf[n]) > kSilenceThreshold) return false;
+    }
+    return true;
+}
+
+static void zeroBlock(float* const* bufs, int channels, int nframes)
+{
+    if (bufs == nullptr) return;
+    for (int c = 0; c < channels; ++c)
+        if (bufs[c] != nullptr)
+            std::memset(bufs[c], 0, sizeof(float) * (size_t) nframes);
+}
+
+// Ring-out budget in samples for a plugin's reported tail. JUCE's VST3
+// wrapper reports kInfiniteTail as +inf -- a value real reverbs and
+// delays use -- and casting a non-finite (or overflowing) product to
+// long long is undefined; in practice it came out LLONG_MIN, reading
+// as "already elapsed" and truncating exactly the ring-outs this
+// feature exists to preserve. Clamp those to a budget that never
+// elapses: the plugin simply is never skipped.
+static long long tailBudgetSamples(double tail_seconds, double sample_rate)
+{
+    const double samples = tail_seconds * sample_rate;
+    if (!std::isfinite(samples) || samples >= (double) LLONG_MAX)
+        return LLONG_MAX;
+    return (long long) samples;
+}
+
+// Decide whether plugin i can be skipped this block. Returns 1 when it
+// was skipped (output zero-filled), 0 when it must be processed; updates
+// the plugin's ring-out budget either way. Only called with skip enabled.
+static int maybeSkipSilent(MH_PluginChain* chain, int i, bool input_silent,
+                           float* const* out_ptrs, int nframes)
+{
+    // Never skip the slot that is mid-crossfade: the outgoing instance
+    // must keep rendering until the fade lands or it ends on a click.
+    if (i == chain->xfade_index
+        && chain->xfade_remaining.load(std::memory_order_relaxed) > 0)
+    {
+        chain->tail_remaining[i] = -1;
+        return 0;
+    }
+    if (!input_silent)
+    {
+        chain->tail_remaining[i] = -1;  // live; re-query tail on next silence
+        return 0;
+    }
+    if (chain->tail_remaining[i] < 0)
+        chain->tail_remaining[i] = tailBudgetSamples(
+            mh_get_tail_seconds(chain->plugins[i]), chain->sample_rate);
+    if (chain->tail_remaining[i] > 0)
+    {
+        chain->tail_remaining[i] -= nframes;  // still ringing out
+        return 0;
+    }
+    zeroBlock(out_ptrs, chain->plugin_out_ch[i], nframes);
+    return 1;
+}
+
+// First lane entry at or after `frame`.
+static size_t laneCursorFor(const std::vector<MH_ParamChange>& changes,
+                            long long frame)
+{
+    return (size_t) (std::lower_bound(
+                         changes.begin(), changes.end(), frame,
+                         [](const MH_ParamChange& c, long long f)
+                         { return (long long) c.sample_offset < f; })
+                     - changes.begin());
+}
+
+// Stage the [timeline_frame, timeline_frame + nframes) slice of every
+// timeline lane into block_scratch, rebased to block-local offsets, and
+// advance the position. Forward cursor walk -- a block pays only for
+// the changes it covers, never for the whole list. A change landing
+// behind the block start (possible only after a seek into the middle of
+// a gap) clamps to offset 0.
+static void stageTimelineLanes(MH_PluginChain* chain, int nframes)
+{
+    const long long start = chain->timeline_frame;
+    const long long end   = start + (long long) nframes;
+    for (auto& lane : chain->timeline_lanes)
+    {
+        if (lane.changes.empty())
+            continue;
+        // clear() preserves capacity, so after the first block that
+        // covers changes the push_backs below stay allocation-free.
+        lane.block_scratch.clear();
+        while (lane.cursor < lane.changes.size()
+               && (long long) lane.changes[lane.cursor].sample_offset < end)
+        {
+            MH_ParamChange c = lane.changes[lane.cursor];
+            const long long off = (long long) c.sample_offset - start;
+            c.sample_offset = off < 0 ? 0 : (int) off;
+            lane.block_scratch.push_back(c);
+            ++lane.cursor;
+        }
+    }
+    chain->timeline_frame = end;
+}
+
+// This block's staged slice for plugin i, or false if it has none.
+static bool laneHasChanges(MH_PluginChain* chain, int i)
+{
+    return (size_t) i < chain->timeline_lanes.size()
+        && !chain->timeline_lanes[(size_t) i].changes.empty()
+        && !chain->timeline_lanes[(size_t) i].block_scratch.empty();
+}
+
+// Identity copy for a bypassed stage (the setter guarantees
+// in_ch == out_ch). Null input channels read as silence; an aliased
+// in-place channel is left untouched.
+static void bypassPassthrough(MH_PluginChain* chain, int i,
+                              const float* const* in_ptrs,
+                              float* const* out_ptrs, int nframes)
+{
+    const int ch = chain->plugin_out_ch[i];
+    for (int c = 0; c < ch; ++c)
+    {
+        if (out_ptrs[c] == nullptr) continue;
+        const float* src = in_ptrs != nullptr ? in_ptrs[c] : nullptr;
+        if (src == nullptr)
+            std::memset(out_ptrs[c], 0, sizeof(float) * (size_t) nframes);
+        else if (src != out_ptrs[c])
+            std::memcpy(out_ptrs[c], src, sizeof(float) * (size_t) nframes);
+    }
+}
+
+// Process one chain stage, routing through mh_process_auto when the
+// plugin's timeline lane staged changes for this block. MIDI arguments
+// are non-null only for the first plugin (the chain's MIDI entry).
+// Reads the stage's control word first: a bypassed stage is an
+// identity copy and the plugin is not called at all -- the MIDI entry
+// stage then neither consumes nor emits events.
+static int stageProcess(MH_PluginChain* chain, int i,
+                        const float* const* in_ptrs,
+                        float* const* out_ptrs, int nframes,
+                        const MH_MidiEvent* midi_in, int num_midi_in,
+                        MH_MidiEvent* midi_out, int midi_out_capacity,
+                        int* num_midi_out)
+{
+    if (chain->stage_control[i].load(std::memory_order_relaxed)
+        & kStageBypassBit)
+    {
+        bypassPassthrough(chain, i, in_ptrs, out_ptrs, nframes);
+        return 1;
+    }
+    const float* const* sc = chain->sidechain_srcs[i];
+    if (sc != nullptr)
+    {
+        // Staged sidechain (mh_chain_set_sidechain_input): route
+        // through the sidechain entry points, the only ones that
+        // deliver the key signal. Timeline automation degrades to
+        // block-rate here (applied up front via mh_set_param; sample
+        // offsets are ignored) and MIDI output is not captured --
+        // both documented on the staging call.
+        if (laneHasChanges(chain, i))
+        {
+            const auto& scratch
+                = chain->timeline_lanes[(size_t) i].block_scratch;
+            for (const auto& chg : scratch)
+                mh_set_param(chain->plugins[i], chg.param_index, chg.value);
+        }
+        if (midi_in != nullptr)
+            return mh_process_sidechain_midi(chain->plugins[i], in_ptrs,
+                                             out_ptrs, sc, nframes,
+                                             midi_in, num_midi_in);
+        return mh_process_sidechain(chain->plugins[i], in_ptrs, out_ptrs,
+                                    sc, nframes);
+    }
+    if (laneHasChanges(chain, i))
+    {
+        auto& scratch = chain->timeline_lanes[(size_t) i].block_scratch;
+        return mh_process_auto(chain->plugins[i], in_ptrs, out_ptrs, nframes,
+                               midi_in, num_midi_in,
+                               midi_out, midi_out_capacity, num_midi_out,
+                               scratch.data(), (int) scratch.size());
+    }
+    if (midi_in != nullptr || midi_out != nullptr || num_midi_out != nullptr)
+        return mh_process_midi_io(chain->plugins[i], in_ptrs, out_ptrs, nframes,
+                                  midi_in, num_midi_in,
+                                  midi_out, midi_out_capacity, num_midi_out);
+    return mh_process(chain->plugins[i], in_ptrs, out_ptrs, nframes);
+}
+
+// Time one per-plugin call and push a span into the trace ring.
+// A plain passthrough (one branch) when tracing is off.
+template <typename Fn>
+static int tracedPluginCall(MH_PluginChain* chain, int plugin_index, Fn&& fn)
+{
+    if (!chain->trace_ring.enabled()) return fn();
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const int r = fn();
+    const auto t1 = std::chrono::steady_clock::now();
+
+    mh_trace::Event e;
+    e.begin_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        t0.time_since_epoch()).count();
+    e.dur_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        t1 - t0).count();
+    e.block = chain->trace_block.load(std::memory_order_relaxed);
+    e.track = plugin_index;
+    e.tid = mh_trace::currentThreadTrack();
+    chain->trace_ring.record(e);
+    return r;
+}
+
 // Snapshot the per-plugin input into dry_storage[i] so the post-process
 // dry-mix blend has the original signal. No-op for plugins without
-// allocated snapshot storage (in_ch != out_ch).
+// allocated snapshot storage (in_ch != out_ch) -- and, the dominant
+// case, for stages sitting at the full-wet default, whose blend would
+// be a no-op anyway: skipping the copy there means an untouched mix
+// costs nothing per block. dry_valid records the decision so applyMix
+// agrees with it even if the mix moves mid-block.
 static void snapshotDry(MH_PluginChain* chain, int i,
                          const float* const* inputs, int nframes)
 {
+    chain->dry_valid[i] = 0;
     if (chain->dry_storage[i].empty()) return;
+    const unsigned word
+        = chain->stage_control[i].load(std::memory_order_relaxed);
+    if ((word >> kStageMixShift) == kStageMixOne) return;
     int ch = chain->plugin_in_ch[i];
     for (int c = 0; c < ch; ++c)
     {
@@ -60,30 +469,113 @@ static void snapshotDry(MH_PluginChain* chain, int i,
         else
             std::memset(chain->dry_ptrs[i][c], 0, sizeof(float) * nframes);
     }
+    chain->dry_valid[i] = 1;
 }
 
 // Blend the plugin's wet output with its dry snapshot:
 //   out[c][n] = mix * out[c][n] + (1 - mix) * dry[c][n]
-// Skipped when mix is at its full-wet default or the plugin is
-// ineligible (no snapshot storage).
+// Skipped when snapshotDry took no snapshot this block (ineligible
+// plugin, or the mix was at full wet when the block started -- a mix
+// dropped below 1.0 mid-block takes effect on the next one).
 static void applyMix(MH_PluginChain* chain, int i,
                       float* const* outputs, int nframes)
 {
-    float mix = chain->mixes[i];
+    if (!chain->dry_valid[i]) return;
+    const unsigned word
+        = chain->stage_control[i].load(std::memory_order_relaxed);
+    const float mix = stageMix(word);
     if (mix >= 1.0f) return;
-    if (chain->dry_storage[i].empty()) return;
     int ch = chain->plugin_out_ch[i];
-    float dry_gain = 1.0f - mix;
     for (int c = 0; c < ch; ++c)
     {
         if (!outputs[c]) continue;
-        const float* dry = chain->dry_ptrs[i][c];
-        float* wet = outputs[c];
-        for (int n = 0; n < nframes; ++n)
-            wet[n] = mix * wet[n] + dry_gain * dry[n];
+        blendWetDry(outputs[c], chain->dry_ptrs[i][c], mix, nframes);
+    }
+}
+
+// Crossfade support for mh_chain_replace_plugin, split in two so the
+// outgoing instance reads its input before the newcomer can overwrite
+// it (a single-plugin chain may alias the caller's input and output
+// arrays). renderOutgoing runs before the slot's process call and
+// captures the old instance's output into the fade scratch; blend
+// runs after applyMix and equal-power mixes the two, advancing the
+// fade phase across blocks until the outgoing pointer is dropped.
+static void replaceFadeRenderOutgoing(MH_PluginChain* chain, int i,
+                                      const float* const* in_ptrs,
+                                      int nframes)
+{
+    if (i != chain->xfade_index || chain->outgoing == nullptr) return;
+    if (!mh_process(chain->outgoing, in_ptrs,
+                    chain->xfade_ptrs.data(), nframes))
+    {
+        // A failing outgoing plugin just ends the fade early; the
+        // newcomer's output stands alone from here on.
+        chain->outgoing = nullptr;
+        chain->xfade_index = -1;
+        chain->xfade_remaining.store(0, std::memory_order_relaxed);
+    }
+}
+
+static void replaceFadeBlend(MH_PluginChain* chain, int i,
+                             float* const* out_ptrs, int nframes)
+{
+    if (i != chain->xfade_index || chain->outgoing == nullptr) return;
+    const int remaining =
+        chain->xfade_remaining.load(std::memory_order_relaxed);
+    const int total = chain->xfade_total;
+    const int done  = total - remaining;
+    const int n     = std::min(nframes, remaining);
+    const int ch    = chain->plugin_out_ch[i];
+    const float kHalfPi = 1.5707963267948966f;
+    const float inv = 1.0f / (float) total;
+    for (int c = 0; c < ch; ++c)
+    {
+        float* wet = out_ptrs ? out_ptrs[c] : nullptr;
+        const float* old_out = chain->xfade_ptrs[c];
+        if (wet == nullptr || old_out == nullptr) continue;
+        for (int s = 0; s < n; ++s)
+        {
+            const float t = (float) (done + s) * inv;  // 0 -> 1
+            wet[s] = std::sin(t * kHalfPi) * wet[s]
+                   + std::cos(t * kHalfPi) * old_out[s];
+        }
+    }
+    const int left = remaining - n;
+    chain->xfade_remaining.store(left, std::memory_order_relaxed);
+    if (left <= 0)
+    {
+        chain->outgoing = nullptr;
+        chain->xfade_index = -1;
     }
 }
 
+// Adopt a staged replacement at a block boundary. The serial process
+// paths call this once per block; the pipelined path does not (see
+// the header note on mh_chain_replace_plugin).
+static void adoptPendingReplacement(MH_PluginChain* chain)
+{
+    MH_Plugin* incoming =
+        chain->pending_replacement.load(std::memory_order_acquire);
+    if (incoming == nullptr) return;
+    if (chain->outgoing != nullptr) return;  // earlier fade still landing
+    const int idx = chain->pending_replacement_index;
+    chain->outgoing = chain->plugins[idx];
+    chain->plugins[idx] = incoming;
+    chain->xfade_index = idx;
+    chain->xfade_total = kReplaceFadeSamples;
+    chain->xfade_remaining.store(kReplaceFadeSamples,
+                                 std::memory_order_relaxed);
+    chain->tail_remaining[idx] = -1;
+    // The incoming plugin may have a different (or no) sidechain bus;
+    // drop the staged source rather than feed it a mismatched table.
+    if (chain->plugin_sidechain_ch[idx]
+        != mh_get_sidechain_channels(incoming))
+        chain->sidechain_srcs[idx] = nullptr;
+    chain->plugin_sidechain_ch[idx] = mh_get_sidechain_channels(incoming);
+    chain->pending_replacement.store(nullptr, std::memory_order_release);
+    mh_eventlog_record(MH_LOG_SWAP, (unsigned) idx, 0);
+}
+
 static void setErr(char* buf, size_t n, const char* msg)
 {
     if (buf == nullptr || n == 0) return;
@@ -177,14 +669,24 @@ MH_PluginChain* mh_chain_create(MH_Plugin** plugins, int num_plugins,
     chain->autoChunkMidiIn.reserve(256);
     chain->autoChunkMidiOut.resize(256);
 
-    // Per-plugin dry/wet mix state. Snapshot storage is only allocated
-    // for plugins where in_ch == out_ch (the eligibility rule for mix);
-    // all others stay at full-wet mix=1.0 forever.
-    chain->mixes.assign(num_plugins, 1.0f);
+    // Per-plugin control words (full wet, not bypassed) and dry/wet
+    // state. Snapshot storage is only allocated for plugins where
+    // in_ch == out_ch (the eligibility rule for mix and bypass); all
+    // others stay at full-wet mix=1.0 forever.
+    chain->stage_control.reset(new std::atomic<unsigned>[(size_t) num_plugins]);
+    for (int i = 0; i < num_plugins; ++i)
+        chain->stage_control[i].store(kStageMixOne << kStageMixShift,
+                                      std::memory_order_relaxed);
+    chain->tail_remaining.assign(num_plugins, -1);
     chain->plugin_in_ch.resize(num_plugins);
     chain->plugin_out_ch.resize(num_plugins);
     chain->dry_storage.resize(num_plugins);
     chain->dry_ptrs.resize(num_plugins);
+    chain->dry_valid.assign(num_plugins, 0);
+    chain->sidechain_srcs.assign(num_plugins, nullptr);
+    chain->plugin_sidechain_ch.resize(num_plugins);
+    for (int i = 0; i < num_plugins; ++i)
+        chain->plugin_sidechain_ch[i] = mh_get_sidechain_channels(plugins[i]);
     for (int i = 0; i < num_plugins; ++i)
     {
         int in_c = infos[i].num_input_ch;
@@ -221,12 +723,48 @@ MH_PluginChain* mh_chain_create(MH_Plugin** plugins, int num_plugins,
         }
     }
 
+    // Shared double scratch for mh_chain_process_double: two ping-pong
+    // inter-stage regions and one dry-snapshot region in a single
+    // allocation, each wide enough for the widest stage in the chain.
+    {
+        int max_ch = std::max(chain->num_input_channels,
+                              chain->num_output_channels);
+        for (int i = 0; i < num_plugins; ++i)
+            max_ch = std::max(max_ch, std::max(infos[i].num_input_ch,
+                                               infos[i].num_output_ch));
+        const size_t region =
+            (size_t) max_ch * (size_t) chain->max_block_size;
+        chain->dbl_storage.assign(3 * region, 0.0);
+        for (int b = 0; b < 2; ++b)
+        {
+            chain->dbl_scratch_ptrs[b].resize(max_ch);
+            for (int c = 0; c < max_ch; ++c)
+                chain->dbl_scratch_ptrs[b][c] = chain->dbl_storage.data()
+                    + (size_t) b * region + (size_t) c * chain->max_block_size;
+        }
+        chain->dbl_dry_ptrs.resize(max_ch);
+        for (int c = 0; c < max_ch; ++c)
+            chain->dbl_dry_ptrs[c] = chain->dbl_storage.data()
+                + 2 * region + (size_t) c * chain->max_block_size;
+    }
+
+    // Idempotent by name, so repeated creates just re-fetch the handle.
+    g_chain_blocks_metric.store(
+        mh_metric_register("chain.blocks_processed", MH_METRIC_COUNTER),
+        std::memory_order_relaxed);
+
     return chain;
 }
 
 void mh_chain_close(MH_PluginChain* chain)
 {
     if (chain == nullptr) return;
+    if (chain->scratch_arena != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(chain->scratch_arena->mtx);
+        auto& reg = chain->scratch_arena->chains;
+        reg.erase(std::remove(reg.begin(), reg.end(), chain), reg.end());
+    }
     // Note: We do NOT close the individual plugins - caller owns them
     delete chain;
 }
@@ -256,34 +794,92 @@ int mh_chain_process_midi_io(MH_PluginChain* chain,
     int num_plugins = static_cast<int>(chain->plugins.size());
     if (num_plugins == 0) return 0;
 
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(true);
+
+    if (chain->trace_ring.enabled())
+        chain->trace_block.fetch_add(1, std::memory_order_relaxed);
+
+    mh_metric_add(g_chain_blocks_metric.load(std::memory_order_relaxed), 1);
+    MhEventLogBlockScope logBlockScope(1, (unsigned) nframes);
+    if (num_midi_in > 0)
+        mh_eventlog_record(MH_LOG_MIDI_IN, 0, (unsigned) num_midi_in);
+
+    // Pick up a staged plugin replacement at the block boundary.
+    adoptPendingReplacement(chain);
+
+    // Stage this block's slice of the precompiled automation timeline
+    // (no-op walk when no timeline is set; the frame position always
+    // advances so a later set picks up from "now").
+    stageTimelineLanes(chain, nframes);
+
     // Initialize midi output count
     if (num_midi_out)
         *num_midi_out = 0;
 
+    // Silence skip applies to the first plugin only when no MIDI is in
+    // flight: incoming events can wake an instrument from silence, and a
+    // skipped plugin produces no MIDI output. Staged automation likewise
+    // blocks the skip -- the changes must land even on a silent block.
+    const bool first_may_skip = chain->silence_skip
+        && num_midi_in == 0 && midi_out == nullptr
+        && !laneHasChanges(chain, 0);
+
     // Special case: single plugin
     if (num_plugins == 1)
     {
+        if (first_may_skip
+            && maybeSkipSilent(chain, 0,
+                   blockIsSilent(inputs, chain->num_input_channels, nframes),
+                   outputs, nframes))
+            return 1;
+        replaceFadeRenderOutgoing(chain, 0, inputs, nframes);
         snapshotDry(chain, 0, inputs, nframes);
-        int r = mh_process_midi_io(chain->plugins[0],
-                                    inputs, outputs, nframes,
-                                    midi_in, num_midi_in,
-                                    midi_out, midi_out_capacity, num_midi_out);
+        int r = tracedPluginCall(chain, 0, [&] {
+            return stageProcess(chain, 0, inputs, outputs, nframes,
+                                midi_in, num_midi_in,
+                                midi_out, midi_out_capacity, num_midi_out);
+        });
         if (!r) return 0;
         applyMix(chain, 0, outputs, nframes);
+        replaceFadeBlend(chain, 0, outputs, nframes);
         return 1;
     }
 
     // Multi-plugin chain processing
 
+    // Silence propagates stage to stage: a skipped plugin's output is
+    // known-zero without a rescan, a processed one is scanned (early
+    // exit on the first audible sample, so loud blocks cost almost
+    // nothing).
+    bool stage_silent = false;
+
     // Process first plugin with MIDI -> intermediate[0]
     float* const* first_output = chain->intermediate_ptrs[0].data();
-    snapshotDry(chain, 0, inputs, nframes);
-    int result = mh_process_midi_io(chain->plugins[0],
-                                    inputs, first_output, nframes,
-                                    midi_in, num_midi_in,
-                                    midi_out, midi_out_capacity, num_midi_out);
-    if (!result) return 0;
-    applyMix(chain, 0, first_output, nframes);
+    int result;
+    if (first_may_skip
+        && maybeSkipSilent(chain, 0,
+               blockIsSilent(inputs, chain->num_input_channels, nframes),
+               first_output, nframes))
+    {
+        stage_silent = true;
+    }
+    else
+    {
+        replaceFadeRenderOutgoing(chain, 0, inputs, nframes);
+        snapshotDry(chain, 0, inputs, nframes);
+        result = tracedPluginCall(chain, 0, [&] {
+            return stageProcess(chain, 0, inputs, first_output, nframes,
+                                midi_in, num_midi_in,
+                                midi_out, midi_out_capacity, num_midi_out);
+        });
+        if (!result) return 0;
+        applyMix(chain, 0, first_output, nframes);
+        replaceFadeBlend(chain, 0, first_output, nframes);
+        stage_silent = chain->silence_skip
+            && blockIsSilent(const_cast<const float* const*>(first_output),
+                             chain->plugin_out_ch[0], nframes);
+    }
 
     // Process middle plugins (no MIDI): intermediate[i-1] -> intermediate[i]
     for (int i = 1; i < num_plugins - 1; ++i)
@@ -292,6 +888,11 @@ int mh_chain_process_midi_io(MH_PluginChain* chain,
             const_cast<const float* const*>(chain->intermediate_ptrs[i - 1].data());
         float* const* out_ptrs = chain->intermediate_ptrs[i].data();
 
+        if (chain->silence_skip
+            && !laneHasChanges(chain, i)
+            && maybeSkipSilent(chain, i, stage_silent, out_ptrs, nframes))
+            continue;  // output zero-filled; stage_silent stays true
+
         // Get channel info for this stage
         MH_Info prev_info, curr_info;
         mh_get_info(chain->plugins[i - 1], &prev_info);
@@ -311,16 +912,30 @@ int mh_chain_process_midi_io(MH_PluginChain* chain,
             }
         }
 
+        replaceFadeRenderOutgoing(chain, i, in_ptrs, nframes);
         snapshotDry(chain, i, in_ptrs, nframes);
-        result = mh_process(chain->plugins[i], in_ptrs, out_ptrs, nframes);
+        result = tracedPluginCall(chain, i, [&] {
+            return stageProcess(chain, i, in_ptrs, out_ptrs, nframes,
+                                nullptr, 0, nullptr, 0, nullptr);
+        });
         if (!result) return 0;
         applyMix(chain, i, out_ptrs, nframes);
+        replaceFadeBlend(chain, i, out_ptrs, nframes);
+        stage_silent = chain->silence_skip
+            && blockIsSilent(const_cast<const float* const*>(out_ptrs),
+                             chain->plugin_out_ch[i], nframes);
     }
 
     // Process last plugin: intermediate[n-2] -> outputs
     const float* const* last_input =
         const_cast<const float* const*>(chain->intermediate_ptrs[num_plugins - 2].data());
 
+    if (chain->silence_skip
+        && !laneHasChanges(chain, num_plugins - 1)
+        && maybeSkipSilent(chain, num_plugins - 1, stage_silent,
+                           outputs, nframes))
+        return 1;
+
     // Handle channel mismatch for last plugin
     MH_Info prev_info, last_info;
     mh_get_info(chain->plugins[num_plugins - 2], &prev_info);
@@ -339,13 +954,343 @@ int mh_chain_process_midi_io(MH_PluginChain* chain,
         }
     }
 
+    replaceFadeRenderOutgoing(chain, num_plugins - 1, last_input, nframes);
     snapshotDry(chain, num_plugins - 1, last_input, nframes);
-    result = mh_process(chain->plugins[num_plugins - 1], last_input, outputs, nframes);
+    result = tracedPluginCall(chain, num_plugins - 1, [&] {
+        return stageProcess(chain, num_plugins - 1,
+                            last_input, outputs, nframes,
+                            nullptr, 0, nullptr, 0, nullptr);
+    });
     if (!result) return 0;
     applyMix(chain, num_plugins - 1, outputs, nframes);
+    replaceFadeBlend(chain, num_plugins - 1, outputs, nframes);
+    return 1;
+}
+
+int mh_chain_process_double(MH_PluginChain* chain,
+                            const double* const* inputs,
+                            double* const* outputs,
+                            int nframes)
+{
+    if (chain == nullptr) return 0;
+    if (nframes <= 0 || nframes > chain->max_block_size) return 0;
+
+    int num_plugins = static_cast<int>(chain->plugins.size());
+    if (num_plugins == 0) return 0;
+
+    MhRtAuditScope rtAuditScope;
+    MhDenormalScope denormalScope(true);
+
+    if (chain->trace_ring.enabled())
+        chain->trace_block.fetch_add(1, std::memory_order_relaxed);
+
+    // Stage input for plugin 0: the caller's buffers, or the pong
+    // scratch zero-filled for silence (stage 0 writes ping, so the
+    // zeros survive its process call).
+    const double* const* cur_in = inputs;
+    if (cur_in == nullptr)
+    {
+        for (int c = 0; c < chain->num_input_channels; ++c)
+            std::memset(chain->dbl_scratch_ptrs[1][c], 0,
+                        sizeof(double) * (size_t) nframes);
+        cur_in = const_cast<const double* const*>(
+            chain->dbl_scratch_ptrs[1].data());
+    }
+
+    // Every hop stays 64-bit: the conversion for a float-only plugin
+    // happens inside its own mh_process_double call (which converts
+    // internally when the plugin lacks double support), so capability
+    // boundaries are the only places audio leaves double.
+    for (int i = 0; i < num_plugins; ++i)
+    {
+        const bool last = (i == num_plugins - 1);
+        double* const* out_ptrs = (last && outputs != nullptr)
+            ? outputs
+            : chain->dbl_scratch_ptrs[i & 1].data();
+
+        // One control-word read per stage, shared by the bypass check
+        // and the dry/wet blend.
+        const unsigned word
+            = chain->stage_control[i].load(std::memory_order_relaxed);
+
+        if (word & kStageBypassBit)
+        {
+            // Identity copy, 64-bit flavour of bypassPassthrough.
+            for (int c = 0; c < chain->plugin_out_ch[i]; ++c)
+            {
+                if (out_ptrs[c] == nullptr) continue;
+                if (cur_in[c] == nullptr)
+                    std::memset(out_ptrs[c], 0,
+                                sizeof(double) * (size_t) nframes);
+                else if (cur_in[c] != out_ptrs[c])
+                    std::memcpy(out_ptrs[c], cur_in[c],
+                                sizeof(double) * (size_t) nframes);
+            }
+        }
+        else
+        {
+            // Dry snapshot for the dry/wet blend; same eligibility rule
+            // as the float path (snapshot storage exists only when the
+            // plugin's in/out channel counts match).
+            const float mix = stageMix(word);
+            const bool want_mix
+                = mix < 1.0f && !chain->dry_storage[i].empty();
+            if (want_mix)
+            {
+                for (int c = 0; c < chain->plugin_in_ch[i]; ++c)
+                {
+                    if (cur_in[c])
+                        std::memcpy(chain->dbl_dry_ptrs[c], cur_in[c],
+                                    sizeof(double) * (size_t) nframes);
+                    else
+                        std::memset(chain->dbl_dry_ptrs[c], 0,
+                                    sizeof(double) * (size_t) nframes);
+                }
+            }
+
+            int r = tracedPluginCall(chain, i, [&] {
+                return mh_process_double(chain->plugins[i],
+                                         cur_in, out_ptrs, nframes);
+            });
+            if (!r) return 0;
+
+            if (want_mix)
+            {
+                const double wet_gain = mix;
+                const double dry_gain = 1.0 - wet_gain;
+                for (int c = 0; c < chain->plugin_out_ch[i]; ++c)
+                {
+                    if (!out_ptrs[c]) continue;
+                    const double* dry = chain->dbl_dry_ptrs[c];
+                    double* wet = out_ptrs[c];
+                    for (int n = 0; n < nframes; ++n)
+                        wet[n] = wet_gain * wet[n] + dry_gain * dry[n];
+                }
+            }
+        }
+
+        if (!last)
+        {
+            // Zero-pad input channels the next stage has beyond this
+            // stage's output count (scratch is sized for the widest
+            // stage, so the channels exist).
+            for (int c = chain->plugin_out_ch[i];
+                 c < chain->plugin_in_ch[i + 1]; ++c)
+                std::memset(out_ptrs[c], 0,
+                            sizeof(double) * (size_t) nframes);
+            cur_in = const_cast<const double* const*>(out_ptrs);
+        }
+    }
     return 1;
 }
 
+namespace {
+
+// SPSC queue of audio-block slots between two pipeline stages. The
+// producer fills slots[head % depth] and publishes by bumping head;
+// the consumer reads slots[tail % depth] and releases by bumping
+// tail. One producer, one consumer, so acquire/release on the two
+// counters is all the synchronization needed (same discipline as the
+// ring buffers in libminihost_audio).
+struct StageQueue
+{
+    static constexpr int kDepth = 4;
+
+    int channels = 0;
+    int block    = 0;
+    std::vector<std::vector<float>>  slots;      // kDepth x channels*block
+    std::vector<std::vector<float*>> slot_ptrs;  // kDepth x channels
+
+    std::atomic<long long> head{0};
+    std::atomic<long long> tail{0};
+
+    void init(int ch, int block_size)
+    {
+        channels = ch;
+        block    = block_size;
+        slots.assign(kDepth, std::vector<float>(
+            (size_t) ch * (size_t) block_size, 0.0f));
+        slot_ptrs.assign(kDepth, {});
+        for (int s = 0; s < kDepth; ++s)
+        {
+            slot_ptrs[s].resize((size_t) ch);
+            for (int c = 0; c < ch; ++c)
+                slot_ptrs[s][(size_t) c]
+                    = slots[s].data() + (size_t) c * block_size;
+        }
+    }
+
+    // Block (spinning with yield) until a slot is free to write.
+    // Returns nullptr if the pipeline aborted.
+    float* const* acquireWrite(const std::atomic<int>& ok)
+    {
+        while (head.load(std::memory_order_relaxed)
+                   - tail.load(std::memory_order_acquire) >= kDepth)
+        {
+            if (!ok.load(std::memory_order_relaxed)) return nullptr;
+            std::this_thread::yield();
+        }
+        return slot_ptrs[(size_t)(head.load(std::memory_order_relaxed)
+                                  % kDepth)].data();
+    }
+    void publish() { head.fetch_add(1, std::memory_order_release); }
+
+    // Block until a filled slot is readable. Returns nullptr on abort.
+    float* const* acquireRead(const std::atomic<int>& ok)
+    {
+        while (head.load(std::memory_order_acquire)
+                   == tail.load(std::memory_order_relaxed))
+        {
+            if (!ok.load(std::memory_order_relaxed)) return nullptr;
+            std::this_thread::yield();
+        }
+        return slot_ptrs[(size_t)(tail.load(std::memory_order_relaxed)
+                                  % kDepth)].data();
+    }
+    void release() { tail.fetch_add(1, std::memory_order_release); }
+};
+
+} // namespace
+
+int mh_chain_process_pipelined(MH_PluginChain* chain,
+                               const float* const* inputs,
+                               float* const* outputs,
+                               long long total_frames,
+                               int block_size)
+{
+    if (chain == nullptr) return 0;
+    if (total_frames < 0) return 0;
+    if (total_frames == 0) return 1;
+    if (block_size <= 0 || block_size > chain->max_block_size) return 0;
+
+    const int num_plugins = static_cast<int>(chain->plugins.size());
+    const long long nblocks = (total_frames + block_size - 1) / block_size;
+
+    // Single plugin: nothing to pipeline, just walk the blocks.
+    if (num_plugins == 1)
+    {
+        std::vector<const float*> in_ptrs(chain->num_input_channels);
+        std::vector<float*> out_ptrs(chain->num_output_channels);
+        for (long long b = 0; b < nblocks; ++b)
+        {
+            const long long off = b * block_size;
+            const int n = static_cast<int>(
+                std::min<long long>(block_size, total_frames - off));
+            for (int c = 0; c < chain->num_input_channels; ++c)
+                in_ptrs[c] = inputs ? inputs[c] + off : nullptr;
+            for (int c = 0; c < chain->num_output_channels; ++c)
+                out_ptrs[c] = outputs ? outputs[c] + off : nullptr;
+            if (!mh_chain_process(chain,
+                                  inputs ? in_ptrs.data() : nullptr,
+                                  outputs ? out_ptrs.data() : nullptr, n))
+                return 0;
+        }
+        return 1;
+    }
+
+    // One queue between each pair of adjacent stages, sized like the
+    // serial path's intermediate buffers (max of producer-out and
+    // consumer-in channels, so zero-padding has room).
+    std::vector<StageQueue> queues(num_plugins - 1);
+    for (int s = 0; s < num_plugins - 1; ++s)
+        queues[s].init(std::max(chain->plugin_out_ch[s],
+                                chain->plugin_in_ch[s + 1]), block_size);
+
+    std::atomic<int> ok{1};
+
+    // Stage body: plugin s consumes from queues[s-1] (or the caller's
+    // input for s == 0) and produces into queues[s] (or the caller's
+    // output for the last stage). Dry/wet snapshot scratch is per
+    // plugin index, so each stage thread touches only its own.
+    auto stage = [&](int s) {
+        std::vector<const float*> in_ptrs(
+            (size_t) std::max(chain->plugin_in_ch[s], 1));
+        std::vector<float*> out_ptrs(
+            (size_t) std::max(chain->plugin_out_ch[s], 1));
+        for (long long b = 0; b < nblocks; ++b)
+        {
+            if (!ok.load(std::memory_order_relaxed)) return;
+            const long long off = b * block_size;
+            const int n = static_cast<int>(
+                std::min<long long>(block_size, total_frames - off));
+
+            const float* const* in = nullptr;
+            if (s == 0)
+            {
+                if (inputs)
+                {
+                    for (int c = 0; c < chain->plugin_in_ch[0]; ++c)
+                        in_ptrs[(size_t) c] = inputs[c] + off;
+                    in = in_ptrs.data();
+                }
+            }
+            else
+            {
+                float* const* slot = queues[s - 1].acquireRead(ok);
+                if (slot == nullptr) return;
+                // Zero-pad input channels beyond the producer's count.
+                for (int c = chain->plugin_out_ch[s - 1];
+                     c < chain->plugin_in_ch[s]; ++c)
+                    std::memset(slot[c], 0, sizeof(float) * (size_t) n);
+                in = slot;
+            }
+
+            float* const* out = nullptr;
+            if (s == num_plugins - 1)
+            {
+                if (outputs)
+                {
+                    for (int c = 0; c < chain->plugin_out_ch[s]; ++c)
+                        out_ptrs[(size_t) c] = outputs[c] + off;
+                    out = out_ptrs.data();
+                }
+            }
+            else
+            {
+                out = queues[s].acquireWrite(ok);
+                if (out == nullptr) return;
+            }
+
+            if (chain->stage_control[s].load(std::memory_order_relaxed)
+                & kStageBypassBit)
+            {
+                if (out != nullptr)
+                    bypassPassthrough(chain, s, in, out, n);
+            }
+            else
+            {
+                snapshotDry(chain, s, in, n);
+                if (!mh_process(chain->plugins[s], in, out, n))
+                {
+                    ok.store(0, std::memory_order_relaxed);
+                    return;
+                }
+                if (out != nullptr)
+                    applyMix(chain, s, out, n);
+            }
+
+            if (s > 0) queues[s - 1].release();
+            if (s < num_plugins - 1) queues[s].publish();
+        }
+    };
+
+    // One thread per downstream stage; the caller runs stage 0. Stage
+    // threads do audio-rate work, so they pick up the audio-worker
+    // scheduling policy at spawn.
+    std::vector<std::thread> threads;
+    threads.reserve((size_t) num_plugins - 1);
+    for (int s = 1; s < num_plugins; ++s)
+        threads.emplace_back([&stage, s]
+        {
+            mh_thread_policy_apply(MH_THREAD_ROLE_AUDIO_WORKER);
+            stage(s);
+        });
+    stage(0);
+    for (auto& t : threads) t.join();
+
+    return ok.load(std::memory_order_relaxed) != 0;
+}
+
 int mh_chain_get_latency_samples(MH_PluginChain* chain)
 {
     if (chain == nullptr) return 0;
@@ -419,6 +1364,100 @@ int mh_chain_set_non_realtime(MH_PluginChain* chain, int non_realtime)
     return 1;
 }
 
+int mh_chain_set_silence_skip(MH_PluginChain* chain, int enabled)
+{
+    if (chain == nullptr) return 0;
+    chain->silence_skip = enabled ? 1 : 0;
+    // Treat every plugin's input as live so nothing already ringing out
+    // is cut off by an immediately-silent block after enabling.
+    std::fill(chain->tail_remaining.begin(), chain->tail_remaining.end(),
+              (long long) -1);
+    return 1;
+}
+
+int mh_chain_replace_plugin(MH_PluginChain* chain, int index,
+                            MH_Plugin* new_plugin,
+                            char* err_buf, size_t err_buf_size)
+{
+    if (chain == nullptr || new_plugin == nullptr)
+    {
+        setErr(err_buf, err_buf_size, "null chain or plugin");
+        return 0;
+    }
+    if (index < 0 || index >= (int) chain->plugins.size())
+    {
+        char msg[256];
+        std::snprintf(msg, sizeof(msg),
+                      "plugin index %d out of range [0, %d)",
+                      index, (int) chain->plugins.size());
+        setErr(err_buf, err_buf_size, msg);
+        return 0;
+    }
+    if (mh_chain_replace_pending(chain))
+    {
+        setErr(err_buf, err_buf_size,
+               "a previous replacement is still in flight; "
+               "wait for mh_chain_replace_pending to clear");
+        return 0;
+    }
+
+    MH_Info info{};
+    if (!mh_get_info(new_plugin, &info))
+    {
+        setErr(err_buf, err_buf_size, "mh_get_info failed on new plugin");
+        return 0;
+    }
+    if (info.num_input_ch != chain->plugin_in_ch[(size_t) index]
+        || info.num_output_ch != chain->plugin_out_ch[(size_t) index])
+    {
+        char msg[256];
+        std::snprintf(msg, sizeof(msg),
+                      "channel mismatch: slot %d is %d in / %d out, "
+                      "replacement is %d in / %d out",
+                      index,
+                      chain->plugin_in_ch[(size_t) index],
+                      chain->plugin_out_ch[(size_t) index],
+                      info.num_input_ch, info.num_output_ch);
+        setErr(err_buf, err_buf_size, msg);
+        return 0;
+    }
+    const double rate = mh_get_sample_rate(new_plugin);
+    if (std::fabs(rate - chain->sample_rate) > 0.1)
+    {
+        char msg[256];
+        std::snprintf(msg, sizeof(msg),
+                      "sample rate mismatch: chain is %.0f Hz, "
+                      "replacement is %.0f Hz",
+                      chain->sample_rate, rate);
+        setErr(err_buf, err_buf_size, msg);
+        return 0;
+    }
+
+    // Everything the fade needs is allocated here, off the audio
+    // thread, before the release store publishes the newcomer.
+    const int out_ch = chain->plugin_out_ch[(size_t) index];
+    chain->xfade_storage.assign(
+        (size_t) out_ch * (size_t) chain->max_block_size, 0.0f);
+    chain->xfade_ptrs.resize((size_t) out_ch);
+    for (int c = 0; c < out_ch; ++c)
+        chain->xfade_ptrs[(size_t) c] =
+            chain->xfade_storage.data() + (size_t) c * chain->max_block_size;
+
+    chain->pending_replacement_index = index;
+    chain->pending_replacement.store(new_plugin, std::memory_order_release);
+    return 1;
+}
+
+int mh_chain_replace_pending(MH_PluginChain* chain)
+{
+    if (chain == nullptr) return 0;
+    if (chain->pending_replacement.load(std::memory_order_acquire)
+        != nullptr)
+        return 1;
+    return chain->xfade_remaining.load(std::memory_order_relaxed) > 0
+        ? 1 : 0;
+}
+
 int mh_chain_process_auto(MH_PluginChain* chain,
                            const float* const* inputs,
                            float* const* outputs,
@@ -554,6 +1593,71 @@ int mh_chain_process_auto(MH_PluginChain* chain,
     return 1;
 }
 
+int mh_chain_set_automation_timeline(MH_PluginChain* chain,
+                                     const MH_ChainParamChange* changes,
+                                     int num_changes)
+{
+    if (chain == nullptr) return 0;
+
+    const int num_plugins = static_cast<int>(chain->plugins.size());
+
+    // Validate before touching any state so a bad entry leaves the
+    // previous timeline intact.
+    if (changes != nullptr)
+    {
+        for (int i = 0; i < num_changes; ++i)
+        {
+            if (changes[i].plugin_index < 0
+                || changes[i].plugin_index >= num_plugins)
+                return 0;
+        }
+    }
+
+    chain->timeline_lanes.assign((size_t) num_plugins,
+                                 MH_PluginChain::TimelineLane{});
+    if (changes == nullptr || num_changes <= 0)
+        return 1;  // cleared
+
+    // Split the flat list into per-plugin lanes (a stable partition, so
+    // caller order survives within each lane), then sort each lane once
+    // here so the audio-thread path is a pure forward walk.
+    for (int i = 0; i < num_changes; ++i)
+    {
+        const MH_ChainParamChange& cc = changes[i];
+        MH_ParamChange pc;
+        pc.sample_offset = cc.sample_offset;
+        pc.param_index = cc.param_index;
+        pc.value = cc.value;
+        chain->timeline_lanes[(size_t) cc.plugin_index]
+            .changes.push_back(pc);
+    }
+    for (auto& lane : chain->timeline_lanes)
+    {
+        if (lane.changes.empty())
+            continue;
+        // stable_sort keeps same-offset changes in caller order (last
+        // writer wins inside mh_process_auto).
+        std::stable_sort(lane.changes.begin(), lane.changes.end(),
+                         [](const MH_ParamChange& a, const MH_ParamChange& b)
+                         { return a.sample_offset < b.sample_offset; });
+        // Skip past changes behind the current position; otherwise they
+        // would all fire (clamped) on the next block.
+        lane.cursor = laneCursorFor(lane.changes, chain->timeline_frame);
+    }
+    return 1;
+}
+
+int mh_chain_seek_automation(MH_PluginChain* chain, long long frame)
+{
+    if (chain == nullptr) return 0;
+    if (frame < 0) return 0;
+    chain->timeline_frame = frame;
+    for (auto& lane : chain->timeline_lanes)
+        lane.cursor = lane.changes.empty()
+            ? 0 : laneCursorFor(lane.changes, frame);
+    return 1;
+}
+
 double mh_chain_get_tail_seconds(MH_PluginChain* chain)
 {
     if (chain == nullptr) return 0.0;
@@ -568,6 +1672,21 @@ double mh_chain_get_tail_seconds(MH_PluginChain* chain)
     return max_tail;
 }
 
+int mh_chain_set_sidechain_input(MH_PluginChain* chain, int plugin_index,
+                                 const float* const* sidechain)
+{
+    if (chain == nullptr) return 0;
+    if (plugin_index < 0 ||
+        plugin_index >= static_cast<int>(chain->plugins.size()))
+        return 0;
+    // Eligibility: the stage's plugin must have been opened with a
+    // sidechain bus (mh_open_ex). Clearing is always allowed.
+    if (sidechain != nullptr && chain->plugin_sidechain_ch[plugin_index] <= 0)
+        return 0;
+    chain->sidechain_srcs[plugin_index] = sidechain;
+    return 1;
+}
+
 int mh_chain_set_mix(MH_PluginChain* chain, int plugin_index, float mix)
 {
     if (chain == nullptr) return 0;
@@ -580,7 +1699,17 @@ int mh_chain_set_mix(MH_PluginChain* chain, int plugin_index, float mix)
         return 0;
     if (mix < 0.0f) mix = 0.0f;
     if (mix > 1.0f) mix = 1.0f;
-    chain->mixes[plugin_index] = mix;
+    const unsigned q = (unsigned) std::lround((double) mix * kStageMixOne);
+    // CAS loop so a concurrent bypass flip on the same word is never
+    // lost; only the mix bits are replaced.
+    auto& word = chain->stage_control[plugin_index];
+    unsigned cur = word.load(std::memory_order_relaxed);
+    while (!word.compare_exchange_weak(
+        cur,
+        (cur & ~(kStageMixOne << kStageMixShift)) | (q << kStageMixShift),
+        std::memory_order_relaxed))
+    {
+    }
     return 1;
 }
 
@@ -590,5 +1719,194 @@ float mh_chain_get_mix(MH_PluginChain* chain, int plugin_index)
     if (plugin_index < 0 ||
         plugin_index >= static_cast<int>(chain->plugins.size()))
         return -1.0f;
-    return chain->mixes[plugin_index];
+    return stageMix(chain->stage_control[plugin_index].load(
+        std::memory_order_relaxed));
+}
+
+int mh_chain_set_bypass(MH_PluginChain* chain, int plugin_index,
+                        int bypassed)
+{
+    if (chain == nullptr) return 0;
+    if (plugin_index < 0 ||
+        plugin_index >= static_cast<int>(chain->plugins.size()))
+        return 0;
+    // Eligibility: identity passthrough needs matching channel counts.
+    if (chain->plugin_in_ch[plugin_index]
+        != chain->plugin_out_ch[plugin_index])
+        return 0;
+    auto& word = chain->stage_control[plugin_index];
+    if (bypassed)
+        word.fetch_or(kStageBypassBit, std::memory_order_relaxed);
+    else
+        word.fetch_and(~kStageBypassBit, std::memory_order_relaxed);
+    return 1;
+}
+
+int mh_chain_get_bypass(MH_PluginChain* chain, int plugin_index)
+{
+    if (chain == nullptr) return 0;
+    if (plugin_index < 0 ||
+        plugin_index >= static_cast<int>(chain->plugins.size()))
+        return 0;
+    return (chain->stage_control[plugin_index].load(
+                std::memory_order_relaxed)
+            & kStageBypassBit) ? 1 : 0;
+}
+
+int mh_chain_set_tracing(MH_PluginChain* chain, int capacity_events)
+{
+    if (chain == nullptr || capacity_events < 0) return 0;
+    chain->trace_ring.resize(capacity_events);
+    chain->trace_block.store(0, std::memory_order_relaxed);
+    return 1;
+}
+
+int mh_chain_trace_dump(MH_PluginChain* chain, const char* path,
+                        char* err_buf, size_t err_buf_size)
+{
+    if (chain == nullptr)
+    {
+        setErr(err_buf, err_buf_size, "null chain");
+        return 0;
+    }
+    if (!chain->trace_ring.enabled())
+    {
+        setErr(err_buf, err_buf_size, "tracing not enabled");
+        return 0;
+    }
+
+    // Label each track with the plugin's file basename so the trace
+    // viewer shows "reverb.vst3" rather than a bare index.
+    std::vector<std::string> names;
+    names.reserve(chain->plugins.size());
+    for (size_t i = 0; i < chain->plugins.size(); ++i)
+    {
+        std::string path_str = mh_get_path(chain->plugins[i]);
+        size_t slash = path_str.find_last_of("/\\");
+        std::string base = slash == std::string::npos
+            ? path_str : path_str.substr(slash + 1);
+        if (base.empty()) base = "plugin";
+        names.push_back(std::to_string(i) + ":" + base);
+    }
+
+    std::string error;
+    if (!mh_trace::dumpJson(chain->trace_ring, names, path, error))
+    {
+        setErr(err_buf, err_buf_size, error.c_str());
+        return 0;
+    }
+    return 1;
+}
+
+// Total floats of inter-stage scratch this chain's stage layout needs
+// (sum over the n-1 intermediate buffers of channels * max_block_size).
+static size_t chainScratchFloats(const MH_PluginChain* chain)
+{
+    size_t total = 0;
+    for (const auto& ptrs : chain->intermediate_ptrs)
+        total += ptrs.size() * (size_t) chain->max_block_size;
+    return total;
+}
+
+// Rebuild every intermediate channel pointer against `base`, packing
+// the stages back to back from offset 0 (the same layout the private
+// per-stage allocations use, just contiguous).
+static void pointIntermediateAt(MH_PluginChain* chain, float* base)
+{
+    size_t off = 0;
+    for (auto& ptrs : chain->intermediate_ptrs)
+        for (auto& p : ptrs)
+        {
+            p = base + off;
+            off += (size_t) chain->max_block_size;
+        }
+}
+
+// Reallocate private per-stage scratch and point the channel tables
+// back at it -- the inverse of attaching to an arena. The channel
+// counts survive in intermediate_ptrs, so no plugin queries needed.
+static void restorePrivateScratch(MH_PluginChain* chain)
+{
+    const size_t n = chain->intermediate_ptrs.size();
+    chain->intermediate_storage.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const size_t channels = chain->intermediate_ptrs[i].size();
+        chain->intermediate_storage[i].assign(
+            channels * (size_t) chain->max_block_size, 0.0f);
+        for (size_t c = 0; c < channels; ++c)
+            chain->intermediate_ptrs[i][c] =
+                chain->intermediate_storage[i].data()
+                + c * (size_t) chain->max_block_size;
+    }
+}
+
+MH_ChainScratchArena* mh_chain_arena_create(void)
+{
+    return new (std::nothrow) MH_ChainScratchArena();
+}
+
+void mh_chain_arena_free(MH_ChainScratchArena* arena)
+{
+    if (arena == nullptr) return;
+    {
+        std::lock_guard<std::mutex> lock(arena->mtx);
+        // Still-attached chains fall back to private scratch so they
+        // stay processable after the arena is gone.
+        for (MH_PluginChain* c : arena->chains)
+        {
+            c->scratch_arena = nullptr;
+            restorePrivateScratch(c);
+        }
+        arena->chains.clear();
+    }
+    delete arena;
+}
+
+size_t mh_chain_arena_bytes(MH_ChainScratchArena* arena)
+{
+    if (arena == nullptr) return 0;
+    std::lock_guard<std::mutex> lock(arena->mtx);
+    return arena->storage.size() * sizeof(float);
+}
+
+int mh_chain_set_scratch_arena(MH_PluginChain* chain,
+                               MH_ChainScratchArena* arena)
+{
+    if (chain == nullptr) return 0;
+    if (chain->scratch_arena == arena) return 1;
+
+    if (chain->scratch_arena != nullptr)
+    {
+        MH_ChainScratchArena* old = chain->scratch_arena;
+        std::lock_guard<std::mutex> lock(old->mtx);
+        old->chains.erase(
+            std::remove(old->chains.begin(), old->chains.end(), chain),
+            old->chains.end());
+        chain->scratch_arena = nullptr;
+    }
+
+    if (arena == nullptr)
+    {
+        restorePrivateScratch(chain);
+        return 1;
+    }
+
+    std::lock_guard<std::mutex> lock(arena->mtx);
+    const size_t needed = chainScratchFloats(chain);
+    if (needed > arena->storage.size())
+    {
+        // Growing moves the region: re-point every attached chain, not
+        // just the newcomer.
+        arena->storage.assign(needed, 0.0f);
+        for (MH_PluginChain* c : arena->chains)
+            pointIntermediateAt(c, arena->storage.data());
+    }
+    arena->chains.push_back(chain);
+    chain->scratch_arena = arena;
+    pointIntermediateAt(chain, arena->storage.data());
+    // Drop the private allocation -- the whole point of sharing.
+    chain->intermediate_storage.clear();
+    chain->intermediate_storage.shrink_to_fit();
+    return 1;
 }
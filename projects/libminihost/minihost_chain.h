@@ -52,12 +52,43 @@ void mh_chain_close(MH_PluginChain* chain);
 // outputs: output audio buffers [channel][nframes] (can be NULL to discard)
 // nframes: number of frames to process
 //
+// Variable block sizes: any nframes up to mh_chain_get_max_block_size()
+// works on the same prepared chain -- the inter-stage scratch is sized
+// once at max, so alternating 64-frame live blocks and 2048-frame
+// offline blocks needs no teardown or second chain instance. Plugins
+// that were opened with a smaller max_block_size than the block being
+// rendered are sub-blocked inside their own mh_process call (see
+// minihost.h), so mixed prepared sizes in one chain are fine.
+//
 // Returns 1 on success, 0 on failure
 int mh_chain_process(MH_PluginChain* chain,
                      const float* const* inputs,
                      float* const* outputs,
                      int nframes);
 
+// Process audio through the chain in double precision (no MIDI).
+// Inter-stage audio stays 64-bit end to end: every stage dispatches
+// through mh_process_double, so a double-capable plugin (put it in
+// MH_PRECISION_DOUBLE via mh_set_processing_precision for genuinely
+// native processing) never sees a float conversion between hops, and
+// a float-only plugin converts exactly once down and once up inside
+// its own call -- the capability boundary -- rather than at every
+// hop. Inter-stage buffers come from a single shared scratch
+// allocated at chain creation, so this call never allocates.
+//
+// Per-plugin dry/wet mix (mh_chain_set_mix) and tracing apply as in
+// mh_chain_process. Silence skip and staged plugin replacements
+// (mh_chain_replace_plugin) are serviced by the float paths only.
+//
+// inputs / outputs: planar 64-bit buffers, same layout as
+// mh_chain_process (NULL for silence in / discard out).
+//
+// Returns 1 on success, 0 on failure.
+int mh_chain_process_double(MH_PluginChain* chain,
+                            const double* const* inputs,
+                            double* const* outputs,
+                            int nframes);
+
 // Process audio through the chain with MIDI I/O.
 // MIDI is sent to the first plugin only (typical synth -> effects pattern).
 // Audio flows sequentially through all plugins.
@@ -82,6 +113,29 @@ int mh_chain_process_midi_io(MH_PluginChain* chain,
                              int midi_out_capacity,
                              int* num_midi_out);
 
+// Software-pipelined offline processing. Splits a long buffer into
+// block_size chunks and runs plugin k on block n while plugin k+1 is
+// still processing block n-1, one thread per chain stage with SPSC
+// slot queues in between -- an N-plugin mastering chain scales toward
+// N cores. Threads are spawned per call and joined before it returns,
+// so the chain holds no extra state afterwards.
+//
+// Intended for offline rendering (pair with mh_chain_set_non_realtime):
+// the pipeline adds queue latency in whole blocks, which is why this is
+// a separate entry point and not a mode on mh_chain_process. Audio
+// only -- MIDI and sample-accurate automation take the serial paths.
+//
+// inputs / outputs: planar buffers holding total_frames frames per
+// channel (NULL for silence in / discard out). block_size must be in
+// (0, mh_chain_get_max_block_size()].
+//
+// Returns 1 on success, 0 on failure.
+int mh_chain_process_pipelined(MH_PluginChain* chain,
+                               const float* const* inputs,
+                               float* const* outputs,
+                               long long total_frames,
+                               int block_size);
+
 // Get total latency of the chain in samples (sum of all plugin latencies).
 int mh_chain_get_latency_samples(MH_PluginChain* chain);
 
@@ -112,6 +166,43 @@ int mh_chain_reset(MH_PluginChain* chain);
 // Returns 1 on success, 0 on failure
 int mh_chain_set_non_realtime(MH_PluginChain* chain, int non_realtime);
 
+// Enable/disable silence-aware skipping (default: off). When enabled, a
+// plugin whose input block peaks below -160 dBFS and whose reported tail
+// (mh_get_tail_seconds, queried on the live->silent transition) has
+// elapsed is not processed; its output is zero-filled instead, and the
+// silence propagates so downstream plugins skip without rescanning.
+// Meant for offline stem renders with long silent stretches -- skipped
+// output is exact zeros rather than whatever near-silence the plugin
+// would have produced, so leave it off when bit-exactness against an
+// unskipped render matters. Never skips while MIDI is in flight or MIDI
+// output capture is requested. Returns 1 on success, 0 on null chain.
+int mh_chain_set_silence_skip(MH_PluginChain* chain, int enabled);
+
+// Stage new_plugin to take over chain slot `index` without stopping
+// the audio stream. Validation and the crossfade scratch allocation
+// happen here, on the calling (control) thread; the next serial
+// process call (mh_chain_process / _midi_io / _auto -- not the
+// pipelined path) adopts the newcomer at its block boundary and
+// renders a short equal-power crossfade (~21 ms at 48 kHz) between
+// the outgoing instance and the replacement, so A/B flips are
+// gapless and click-free.
+//
+// The replacement must match the slot's channel counts and the
+// chain's sample rate. The chain never owns plugins: the displaced
+// instance is simply no longer referenced once the fade completes --
+// poll mh_chain_replace_pending for 0 before closing it. Only one
+// replacement may be in flight at a time.
+//
+// Returns 1 when staged, 0 on failure (bad index, channel/rate
+// mismatch, previous replacement still in flight).
+int mh_chain_replace_plugin(MH_PluginChain* chain, int index,
+                            MH_Plugin* new_plugin,
+                            char* err_buf, size_t err_buf_size);
+
+// 1 while a staged replacement has not been adopted or its crossfade
+// is still rendering; 0 once the displaced plugin is out of use.
+int mh_chain_replace_pending(MH_PluginChain* chain);
+
 // Process audio through the chain with sample-accurate parameter automation.
 // param_changes: array of parameter changes sorted by sample_offset
 // num_param_changes: number of parameter changes
@@ -131,6 +222,36 @@ int mh_chain_process_auto(MH_PluginChain* chain,
                            const MH_ChainParamChange* param_changes,
                            int num_param_changes);
 
+// Set a whole-render automation timeline for the chain. Unlike
+// mh_chain_process_auto's per-call array the offsets are ABSOLUTE
+// sample positions on the render timeline (not block-local), and the
+// chain compiles its own copy once at set time: the flat list is split
+// into one sorted per-plugin lane each, and every serial process call
+// (mh_chain_process / _midi_io / _auto) consumes the slice it covers
+// via a forward cursor, dispatching plugins with changes through
+// mh_process_auto. Per-block cost is O(changes this block) with no
+// sorting or filtering on the audio thread, no matter how large the
+// timeline -- built for dense pre-generated automation over long
+// offline renders.
+//
+// The chain's timeline position starts at 0 and advances by nframes
+// per serial process call (the pipelined and double-precision paths do
+// not consume it); use mh_chain_seek_automation to rewind or jump.
+// Call from the control thread while processing is stopped. Pass
+// changes=NULL / num_changes=0 to clear.
+//
+// Returns 1 on success, 0 on failure (NULL chain, or a plugin_index
+// out of range -- in which case the previous timeline is untouched).
+int mh_chain_set_automation_timeline(MH_PluginChain* chain,
+                                     const MH_ChainParamChange* changes,
+                                     int num_changes);
+
+// Move the automation timeline position to `frame` (absolute samples).
+// Repositions every lane's cursor by binary search. Changes strictly
+// before `frame` will not replay. Returns 1 on success, 0 on failure
+// (NULL chain, negative frame).
+int mh_chain_seek_automation(MH_PluginChain* chain, long long frame);
+
 // Get total tail length of the chain in seconds (maximum of all plugin tails).
 // Note: This is the max, not sum, since tails overlap temporally.
 double mh_chain_get_tail_seconds(MH_PluginChain* chain);
@@ -148,7 +269,10 @@ double mh_chain_get_tail_seconds(MH_PluginChain* chain);
 // permanently locked at mix=1.0; set_mix returns 0 in that case.
 //
 // Applied to all chain process variants (mh_chain_process,
-// mh_chain_process_midi_io, mh_chain_process_auto).
+// mh_chain_process_midi_io, mh_chain_process_auto). The blend itself
+// is vectorized, and a stage sitting at the full-wet default takes
+// neither the dry snapshot nor the blend pass -- an untouched mix
+// costs nothing per block.
 //
 // Returns 1 on success, 0 on failure (NULL chain, index out of range,
 // non-matching channel counts).
@@ -159,6 +283,131 @@ int mh_chain_set_mix(MH_PluginChain* chain, int plugin_index, float mix);
 // (NULL chain or index out of range).
 float mh_chain_get_mix(MH_PluginChain* chain, int plugin_index);
 
+// Per-plugin bypass. A bypassed stage passes its input through
+// unchanged and its plugin is not called at all (unlike mix=0.0,
+// which still runs the plugin and discards the wet signal) -- flip it
+// from a GUI or control thread at any time: the flag lives in a
+// packed per-plugin atomic word together with the mix, read once per
+// stage per block by the audio paths, so neither setter nor reader
+// ever takes a lock. A bypassed first plugin neither consumes nor
+// emits MIDI.
+//
+// Same eligibility rule as mix: the plugin's input and output channel
+// counts must match (identity passthrough is only well-defined then);
+// set_bypass returns 0 otherwise.
+//
+// Returns 1 on success, 0 on failure (NULL chain, index out of range,
+// non-matching channel counts).
+int mh_chain_set_bypass(MH_PluginChain* chain, int plugin_index,
+                        int bypassed);
+
+// 1 if the plugin at plugin_index is currently bypassed, 0 otherwise
+// (or on NULL chain / bad index).
+int mh_chain_get_bypass(MH_PluginChain* chain, int plugin_index);
+
+// Per-plugin sidechain source. Stages a planar pointer table
+// (mh_get_sidechain_channels(plugin) channels, each covering at least
+// the nframes of the following process calls) as the key signal for
+// one stage; every subsequent serial process call (mh_chain_process,
+// mh_chain_process_midi_io) then routes that
+// stage through mh_process_sidechain instead of the plain entry
+// points, so ducking one chain under an external signal no longer
+// needs a hand-rolled per-block loop around the chain. NULL clears.
+//
+// The table and the audio behind it stay caller-owned and borrowed:
+// stage them from the thread driving the process calls (or while the
+// chain is idle) and keep them valid until cleared -- typically a
+// scratch buffer staged once and refilled per block. On a stage with
+// a staged sidechain, timeline automation is applied at block rate
+// via mh_set_param (sample offsets are ignored) and the stage's MIDI
+// output is not captured; incoming MIDI (first plugin) still works.
+// mh_chain_process_double and mh_chain_process_pipelined ignore
+// staged sidechains, and mh_chain_process_auto with an explicit
+// change list chunk-splits the block without rebasing the staged
+// table -- drive automation through the timeline API
+// (mh_chain_set_automation_timeline) on sidechained chains instead.
+// A plugin replacement (mh_chain_replace_plugin)
+// whose sidechain bus width differs drops the staged source.
+//
+// Returns 1 on success, 0 on failure (NULL chain, index out of range,
+// or a non-NULL table for a stage whose plugin has no sidechain bus).
+int mh_chain_set_sidechain_input(MH_PluginChain* chain, int plugin_index,
+                                 const float* const* sidechain);
+
+// Trace export: when enabled, the serial process variants
+// (mh_chain_process, mh_chain_process_midi_io, mh_chain_process_auto)
+// record one begin/duration span per plugin call into a preallocated
+// ring, and mh_chain_trace_dump writes the captured spans as Chrome
+// trace-event JSON (loadable in chrome://tracing or Perfetto). Lets
+// you see which plugin spiked on which block across a long offline
+// render. mh_chain_process_pipelined is not traced.
+//
+// mh_chain_set_tracing: capacity_events sizes the ring (oldest spans
+// overwritten once it wraps; size it as num_plugins * blocks to keep).
+// 0 disables and frees. Allocates in this call -- never on the audio
+// path -- so do NOT call concurrently with the process functions.
+// Returns 1 on success, 0 for NULL chain or negative capacity.
+int mh_chain_set_tracing(MH_PluginChain* chain, int capacity_events);
+
+// mh_chain_trace_dump: must not run concurrently with the process
+// functions (dump between blocks or after the render). On failure
+// returns 0 and fills err_buf.
+int mh_chain_trace_dump(MH_PluginChain* chain, const char* path,
+                        char* err_buf, size_t err_buf_size);
+
+// Shared inter-stage scratch arena (opt-in). Every chain privately
+// allocates n-1 inter-stage buffers sized at max block, so a session
+// holding dozens of chains pays that footprint dozens of times over --
+// yet chains driven from one audio thread never process concurrently
+// (the threading model at the top of this header), so at most one
+// chain's scratch is live at any instant. An arena is a single region
+// sized for the hungriest attached chain; attached chains borrow it
+// for the duration of each process call, cutting inter-stage scratch
+// memory from the sum of all chains to the max of any one.
+//
+// Scope: the float inter-stage buffers used by the serial process
+// paths (mh_chain_process / _midi_io / _auto and the timeline). The
+// double-precision scratch, dry/wet snapshots, and crossfade buffers
+// stay per-chain, and mh_chain_process_pipelined allocates its own
+// slot queues per call as before.
+//
+// The single-audio-thread assumption is load-bearing: two chains
+// attached to the same arena must never process at the same time
+// (including one running mh_chain_process_pipelined while another
+// processes). Chains that do run concurrently belong in different
+// arenas -- typically one arena per audio thread.
+typedef struct MH_ChainScratchArena MH_ChainScratchArena;
+
+// Create an empty arena. It grows as chains attach and never shrinks.
+// Returns NULL on allocation failure.
+MH_ChainScratchArena* mh_chain_arena_create(void);
+
+// Free the arena. Any still-attached chains are reverted to private
+// scratch first (allocating), so they remain processable; prefer
+// detaching them yourself (mh_chain_set_scratch_arena(chain, NULL))
+// before freeing. NULL is a no-op. Must not run concurrently with the
+// process functions of attached chains.
+void mh_chain_arena_free(MH_ChainScratchArena* arena);
+
+// Current size of the arena's shared region in bytes -- the footprint
+// replacing the attached chains' private inter-stage scratch. 0 for a
+// NULL or empty arena.
+size_t mh_chain_arena_bytes(MH_ChainScratchArena* arena);
+
+// Attach `chain` to `arena` (or detach with arena=NULL, reallocating
+// private scratch). Attaching releases the chain's private inter-stage
+// buffers and points its stage tables into the arena, growing the
+// region if this chain needs more than any previous attachee; the
+// grow happens here, on the calling thread, never on the audio path.
+// Call from the control thread while the chain (and every chain
+// already attached to the arena) is not processing. The arena must
+// outlive the attachment -- close the chain or detach before freeing
+// the arena. Re-attaching to the current arena is a no-op.
+//
+// Returns 1 on success, 0 on NULL chain.
+int mh_chain_set_scratch_arena(MH_PluginChain* chain,
+                               MH_ChainScratchArena* arena);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,98 @@
+// minihost_denormal.h
+//
+// Internal (C++-only) scoped FTZ/DAZ control shared by the plugin,
+// chain and graph process paths. Not part of the public C ABI -- the
+// public surface is mh_set_denormal_control / mh_get_denormal_hits in
+// minihost.h.
+//
+// Denormal (subnormal) float operands drop many CPUs into microcoded
+// assist paths one to two orders of magnitude slower than the normal
+// pipeline; decaying feedback (reverb/delay tails) produces them in
+// bulk, which shows up as block-time spikes. MhDenormalScope sets
+// flush-to-zero + denormals-are-zero for its lifetime and restores the
+// caller's FP environment on exit, so the plugin's and the host's own
+// FP settings never leak across a process call. hit() reports whether
+// the scope observed a denormal operand or flushed an underflow (read
+// it before the scope ends; the sticky flags are cleared on entry and
+// the caller's restored on exit).
+//
+// x86 uses the SSE MXCSR register (FTZ bit 15, DAZ bit 6; DE/UE sticky
+// flags bits 1 and 4). AArch64 uses FPCR.FZ (bit 24) with FPSR.IDC/UFC
+// (bits 7 and 3) as the sticky flags. Elsewhere the scope is a no-op
+// that never reports a hit.
+
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MH_DENORMAL_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define MH_DENORMAL_AARCH64 1
+#endif
+
+class MhDenormalScope
+{
+public:
+    explicit MhDenormalScope(bool enable) : active_(enable)
+    {
+#if defined(MH_DENORMAL_X86)
+        if (!active_) return;
+        savedCsr_ = _mm_getcsr();
+        // Set FTZ | DAZ, clear the DE/UE sticky flags so hit() observes
+        // only this scope.
+        _mm_setcsr((savedCsr_ | 0x8040u) & ~0x12u);
+#elif defined(MH_DENORMAL_AARCH64)
+        if (!active_) return;
+        savedFpcr_ = getFpcr();
+        savedFpsr_ = getFpsr();
+        setFpcr(savedFpcr_ | (1ull << 24));           // FZ
+        setFpsr(savedFpsr_ & ~((1ull << 7) | (1ull << 3)));  // IDC | UFC
+#endif
+    }
+
+    MhDenormalScope(const MhDenormalScope&) = delete;
+    MhDenormalScope& operator=(const MhDenormalScope&) = delete;
+
+    // True when a denormal operand was seen or an underflow was flushed
+    // since the scope began. Call before the scope ends.
+    bool hit() const
+    {
+#if defined(MH_DENORMAL_X86)
+        return active_ && (_mm_getcsr() & 0x12u) != 0;
+#elif defined(MH_DENORMAL_AARCH64)
+        return active_ && (getFpsr() & ((1ull << 7) | (1ull << 3))) != 0;
+#else
+        return false;
+#endif
+    }
+
+    ~MhDenormalScope()
+    {
+#if defined(MH_DENORMAL_X86)
+        if (active_) _mm_setcsr(savedCsr_);
+#elif defined(MH_DENORMAL_AARCH64)
+        if (active_) { setFpcr(savedFpcr_); setFpsr(savedFpsr_); }
+#endif
+    }
+
+private:
+#if defined(MH_DENORMAL_AARCH64)
+    static unsigned long long getFpcr()
+    { unsigned long long v; __asm__ __volatile__("mrs %0, fpcr" : "=r"(v)); return v; }
+    static void setFpcr(unsigned long long v)
+    { __asm__ __volatile__("msr fpcr, %0" : : "r"(v)); }
+    static unsigned long long getFpsr()
+    { unsigned long long v; __asm__ __volatile__("mrs %0, fpsr" : "=r"(v)); return v; }
+    static void setFpsr(unsigned long long v)
+    { __asm__ __volatile__("msr fpsr, %0" : : "r"(v)); }
+#endif
+
+    bool active_;
+#if defined(MH_DENORMAL_X86)
+    unsigned int savedCsr_ = 0;
+#elif defined(MH_DENORMAL_AARCH64)
+    unsigned long long savedFpcr_ = 0;
+    unsigned long long savedFpsr_ = 0;
+#endif
+};
@@ -0,0 +1,152 @@
+// minihost_eventlog.cpp
+// Flight-recorder event ring. See minihost_eventlog.h for the contract.
+
+#include "minihost_eventlog.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+constexpr long long kDefaultBytes = 4ll * 1024 * 1024;
+
+// The ring. Publication order matters only at enable/disable time
+// (control thread, by contract not concurrent with recorders): the
+// hot path does one relaxed pointer load and bails on null, so a
+// disabled log is a single predicted branch.
+std::atomic<MH_LogEvent*>  g_ring{nullptr};
+size_t                     g_mask = 0;   // record count - 1 (pow2)
+std::atomic<long long>     g_cursor{0};
+
+inline unsigned long long logTimestamp()
+{
+#if defined(__x86_64__) || defined(__i386__) \
+    || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+    return __rdtsc();
+#elif defined(__aarch64__)
+    unsigned long long v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (unsigned long long)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Enable at load when MINIHOST_EVENTLOG is set -- the production mode:
+// the ring exists before any audio thread does, so there is no
+// enable/record race to reason about. "1" selects the default size,
+// any other number is a byte count.
+struct EventLogInit {
+    EventLogInit()
+    {
+        const char* v = std::getenv("MINIHOST_EVENTLOG");
+        if (v == nullptr || v[0] == '\0') return;
+        long long bytes = std::strtoll(v, nullptr, 10);
+        if (bytes == 1) bytes = kDefaultBytes;
+        if (bytes > 0) (void) mh_eventlog_enable(bytes);
+    }
+};
+EventLogInit g_eventlog_init;
+
+} // namespace
+
+extern "C" int mh_eventlog_enable(long long capacity_bytes)
+{
+    if (capacity_bytes <= 0) capacity_bytes = kDefaultBytes;
+    // Round the record count down to a power of two so the hot path
+    // masks instead of dividing; keep at least a small ring.
+    long long records = capacity_bytes / (long long) sizeof(MH_LogEvent);
+    size_t count = 256;
+    while ((long long) (count << 1) <= records && (count << 1) != 0)
+        count <<= 1;
+
+    auto* ring = static_cast<MH_LogEvent*>(
+        std::calloc(count, sizeof(MH_LogEvent)));
+    if (ring == nullptr) return 0;
+
+    MH_LogEvent* old = g_ring.exchange(nullptr, std::memory_order_relaxed);
+    std::free(old);
+    g_mask = count - 1;
+    g_cursor.store(0, std::memory_order_relaxed);
+    g_ring.store(ring, std::memory_order_release);
+    return 1;
+}
+
+extern "C" void mh_eventlog_disable(void)
+{
+    MH_LogEvent* old = g_ring.exchange(nullptr, std::memory_order_relaxed);
+    std::free(old);
+    g_mask = 0;
+    g_cursor.store(0, std::memory_order_relaxed);
+}
+
+extern "C" int mh_eventlog_enabled(void)
+{
+    return g_ring.load(std::memory_order_relaxed) != nullptr ? 1 : 0;
+}
+
+extern "C" int mh_eventlog_capacity(void)
+{
+    return g_ring.load(std::memory_order_relaxed) != nullptr
+               ? (int) (g_mask + 1) : 0;
+}
+
+extern "C" void mh_eventlog_record(int kind,
+                                   unsigned int arg16,
+                                   unsigned int arg32)
+{
+    MH_LogEvent* ring = g_ring.load(std::memory_order_relaxed);
+    if (ring == nullptr) return;
+    const long long i = g_cursor.fetch_add(1, std::memory_order_relaxed);
+    MH_LogEvent& e = ring[(size_t) i & g_mask];
+    e.timestamp = logTimestamp();
+    e.kind      = (unsigned short) kind;
+    e.arg16     = (unsigned short) arg16;
+    e.arg32     = arg32;
+}
+
+extern "C" long long mh_eventlog_count(void)
+{
+    return g_cursor.load(std::memory_order_relaxed);
+}
+
+extern "C" int mh_eventlog_dump(MH_LogEvent* out, int capacity)
+{
+    const MH_LogEvent* ring = g_ring.load(std::memory_order_acquire);
+    if (ring == nullptr) return 0;
+    const long long total = g_cursor.load(std::memory_order_relaxed);
+    const long long cap   = (long long) (g_mask + 1);
+    const long long count = total < cap ? total : cap;
+    if (out != nullptr && capacity > 0)
+    {
+        const long long start = total < cap ? 0 : total;  // oldest slot
+        const long long n = count < capacity ? count : capacity;
+        for (long long k = 0; k < n; ++k)
+            out[k] = ring[(size_t) (start + k) & g_mask];
+    }
+    return (int) count;
+}
+
+extern "C" void mh_eventlog_reset(void)
+{
+    g_cursor.store(0, std::memory_order_relaxed);
+}
+
+extern "C" int mh_eventlog_timestamp_is_raw(void)
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) \
+    || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+    return 1;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,128 @@
+// minihost_eventlog.h
+// Always-on flight recorder: a wait-free binary event ring.
+//
+// When a live session glitches, logs written after the fact are too
+// late and printf in the audio path changes the timing enough to hide
+// the bug. This module keeps a preallocated ring of fixed-size records
+// that hot paths append to for a few nanoseconds each -- one relaxed
+// atomic increment, one timestamp read, one 16-byte store -- so it can
+// stay enabled in production and be dumped after the incident.
+//
+// libminihost records block start/end (chain and graph render paths),
+// xrun-budget overruns, parameter writes, incoming MIDI batches, and
+// live plugin swaps. Applications may append their own markers with
+// mh_eventlog_record (kinds >= MH_LOG_USER).
+//
+// Enabling:
+//   - MINIHOST_EVENTLOG=1 in the environment enables a 4 MB ring at
+//     load (the production mode -- no enable/record race possible).
+//     Any other numeric value is a ring size in bytes.
+//   - mh_eventlog_enable / mh_eventlog_disable switch it
+//     programmatically; like trace-ring resize, they must not run
+//     concurrently with recording threads (enable before starting the
+//     engine, disable after stopping it).
+//
+// Timestamps are raw cycle counters where available (rdtsc on x86,
+// cntvct_el0 on AArch64 -- mh_eventlog_timestamp_is_raw reports
+// which), otherwise steady-clock nanoseconds. Raw counters are
+// monotonic per core and cheap; convert to wall time offline using two
+// dump points if needed.
+//
+// Thread Safety:
+//   - mh_eventlog_record: any thread, wait-free, allocation-free.
+//     A disabled log costs one predicted branch.
+//   - mh_eventlog_dump / _count: any thread. A dump concurrent with
+//     recording is safe (records are fixed-size, the ring is never
+//     freed while enabled) but records at the write frontier may be
+//     torn or overwritten mid-copy; post-incident dumps of a quiesced
+//     engine are exact.
+//   - mh_eventlog_enable / _disable / _reset: control thread only,
+//     not concurrent with recording.
+//
+#pragma once
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Record kinds written by libminihost. arg16/arg32 meaning per kind:
+//   BLOCK_BEGIN  arg16 = source (1 chain, 3 graph), arg32 = nframes
+//   BLOCK_END    arg16 = source (1 chain, 3 graph), arg32 = nframes
+//   XRUN         arg16 = source,       arg32 = nframes of the block
+//   PARAM_WRITE  arg16 = param index,  arg32 = float bits of the value
+//   MIDI_IN      arg16 = 0,            arg32 = number of events staged
+//   SWAP         arg16 = slot index,   arg32 = 0
+#define MH_LOG_BLOCK_BEGIN 1
+#define MH_LOG_BLOCK_END   2
+#define MH_LOG_XRUN        3
+#define MH_LOG_PARAM_WRITE 4
+#define MH_LOG_MIDI_IN     5
+#define MH_LOG_SWAP        6
+// First kind free for application markers.
+#define MH_LOG_USER        64
+
+// One ring record: 16 bytes, fixed layout, safe to write to disk raw.
+typedef struct MH_LogEvent {
+    unsigned long long timestamp;  // cycle counter or steady-clock ns
+    unsigned short     kind;       // MH_LOG_* or application kind
+    unsigned short     arg16;      // small payload (see kind table)
+    unsigned int       arg32;      // payload (see kind table)
+} MH_LogEvent;
+
+// Allocate (or reallocate) the ring. capacity_bytes <= 0 selects the
+// 4 MB default; the record count is rounded down to a power of two.
+// Resets the cursor. Must not race recording threads. Returns 1 on
+// success, 0 on allocation failure.
+int mh_eventlog_enable(long long capacity_bytes);
+
+// Free the ring; subsequent records are dropped at the cost of one
+// branch. Must not race recording threads.
+void mh_eventlog_disable(void);
+
+// 1 when a ring is allocated (via env var or mh_eventlog_enable).
+int mh_eventlog_enabled(void);
+
+// Ring capacity in records (0 when disabled).
+int mh_eventlog_capacity(void);
+
+// Append one record. Wait-free; drops silently when disabled. kind
+// should be an MH_LOG_* value or an application kind >= MH_LOG_USER.
+void mh_eventlog_record(int kind, unsigned int arg16, unsigned int arg32);
+
+// Total records appended since enable / last reset (may exceed the
+// capacity -- the ring keeps the newest).
+long long mh_eventlog_count(void);
+
+// Copy the retained records oldest-first into out (at most capacity
+// entries) and return the number retained, which may exceed capacity;
+// call with NULL/0 to query the size first. See the header comment
+// for the concurrent-dump caveat.
+int mh_eventlog_dump(MH_LogEvent* out, int capacity);
+
+// Drop all retained records (the ring stays allocated).
+void mh_eventlog_reset(void);
+
+// 1 when timestamps are raw cycle counts, 0 when steady-clock ns.
+int mh_eventlog_timestamp_is_raw(void);
+
+#ifdef __cplusplus
+}
+
+// RAII block marker for the C++ render paths: records BLOCK_BEGIN on
+// entry and BLOCK_END on every exit (including error returns, which
+// are exactly the blocks worth seeing in a post-incident dump).
+class MhEventLogBlockScope {
+public:
+    MhEventLogBlockScope(unsigned int source, unsigned int nframes)
+        : source_(source), nframes_(nframes)
+    { mh_eventlog_record(MH_LOG_BLOCK_BEGIN, source_, nframes_); }
+    ~MhEventLogBlockScope()
+    { mh_eventlog_record(MH_LOG_BLOCK_END, source_, nframes_); }
+    MhEventLogBlockScope(const MhEventLogBlockScope&) = delete;
+    MhEventLogBlockScope& operator=(const MhEventLogBlockScope&) = delete;
+private:
+    unsigned int source_;
+    unsigned int nframes_;
+};
+#endif
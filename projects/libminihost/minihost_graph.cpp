@@ -3,11 +3,17 @@
 
 #include "minihost_graph.h"
 #include "minihost_chain.h"
+#include "minihost_threads.h"
 
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
 struct MH_PluginBus
@@ -25,6 +31,51 @@ struct MH_PluginBus
     // time so process is allocation-free.
     std::vector<std::vector<float>> branch_storage;
     std::vector<std::vector<float*>> branch_ptrs;
+
+    // MIDI-merge scratch for mh_bus_process_midi_io. Each branch
+    // appends a contiguous, already time-sorted run into the caller's
+    // midi_out; the spans below record where each run landed so the
+    // k-way merge can read them back. Span/cursor/tree vectors are
+    // sized in mh_bus_add_branch; the staging buffer grows to the
+    // largest merged event count seen (one allocation per high-water
+    // mark, allocation-free at steady state).
+    std::vector<int>                 midi_span_begin;
+    std::vector<int>                 midi_span_count;
+    std::vector<const MH_MidiEvent*> midi_merge_head;
+    std::vector<const MH_MidiEvent*> midi_merge_end;
+    std::vector<int>                 midi_merge_tree;
+    std::vector<MH_MidiEvent>        midi_merge_scratch;
+
+    // ----- worker pool (mh_bus_set_num_threads) -----
+    //
+    // Branches are claimed through one atomic cursor; each worker (and
+    // the calling thread) renders claimed branches into their scratch
+    // buffers, then the calling thread does the gain-sum reduction.
+    // pool_active filters stale wakeups; pool_busy lets process wait
+    // until no worker is still inside drainBranches before returning.
+    std::vector<std::thread> workers;
+    std::mutex               pool_mutex;
+    std::condition_variable  pool_cv;
+    std::condition_variable  pool_done_cv;
+    bool                     pool_shutdown   = false;
+    bool                     pool_active     = false;
+    int                      pool_busy       = 0;
+    unsigned                 pool_generation = 0;
+    std::atomic<int>         pool_next{0};
+    std::atomic<int>         pool_remaining{0};
+    std::atomic<int>         pool_ok{1};
+
+    // Per-call arguments shared with the workers; only valid while a
+    // process call is on the stack.
+    const float* const* pb_inputs   = nullptr;
+    const MH_MidiEvent* pb_midi_in  = nullptr;
+    int                 pb_num_midi = 0;
+    int                 pb_nframes  = 0;
+
+    void stopWorkers();
+    void workerMain();
+    void drainBranches();
+    bool runBranchesParallel();
 };
 
 static void setErr(char* buf, size_t n, const char* msg)
@@ -68,10 +119,116 @@ MH_PluginBus* mh_bus_create(int num_in_channels,
 void mh_bus_close(MH_PluginBus* graph)
 {
     if (graph == nullptr) return;
+    graph->stopWorkers();
     // Branches are owned by the caller -- do not close them.
     delete graph;
 }
 
+void MH_PluginBus::stopWorkers()
+{
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        pool_shutdown = true;
+    }
+    pool_cv.notify_all();
+    for (auto& t : workers) t.join();
+    workers.clear();
+    pool_shutdown = false;
+}
+
+void MH_PluginBus::workerMain()
+{
+    unsigned seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            pool_cv.wait(lock, [&] {
+                return pool_shutdown
+                    || (pool_active && pool_generation != seen);
+            });
+            if (pool_shutdown) return;
+            seen = pool_generation;
+            ++pool_busy;
+        }
+        drainBranches();
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            --pool_busy;
+        }
+        pool_done_cv.notify_all();
+    }
+}
+
+void MH_PluginBus::drainBranches()
+{
+    const int count = static_cast<int>(branches.size());
+    for (;;)
+    {
+        const int b = pool_next.fetch_add(1, std::memory_order_relaxed);
+        if (b >= count) break;
+        if (gains[b] != 0.0f)  // muted branches are skipped, as in serial
+        {
+            int r;
+            if (pb_midi_in != nullptr && pb_num_midi > 0)
+                r = mh_chain_process_midi_io(branches[b], pb_inputs,
+                                             branch_ptrs[b].data(),
+                                             pb_nframes,
+                                             pb_midi_in, pb_num_midi,
+                                             nullptr, 0, nullptr);
+            else
+                r = mh_chain_process(branches[b], pb_inputs,
+                                     branch_ptrs[b].data(), pb_nframes);
+            if (!r)
+                pool_ok.store(0, std::memory_order_relaxed);
+        }
+        if (pool_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            pool_done_cv.notify_all();
+    }
+}
+
+bool MH_PluginBus::runBranchesParallel()
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        pool_next.store(0, std::memory_order_relaxed);
+        pool_remaining.store(static_cast<int>(branches.size()),
+                             std::memory_order_relaxed);
+        pool_ok.store(1, std::memory_order_relaxed);
+        pool_active = true;
+        ++pool_generation;
+    }
+    pool_cv.notify_all();
+    drainBranches();  // the calling thread helps
+    {
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        pool_done_cv.wait(lock, [&] {
+            return pool_remaining.load(std::memory_order_acquire) == 0
+                && pool_busy == 0;
+        });
+        pool_active = false;
+    }
+    return pool_ok.load(std::memory_order_relaxed) != 0;
+}
+
+int mh_bus_set_num_threads(MH_PluginBus* graph, int num_threads)
+{
+    if (graph == nullptr) return 0;
+    if (num_threads < 1)  num_threads = 1;
+    if (num_threads > 64) num_threads = 64;
+    graph->stopWorkers();
+    if (num_threads == 1) return 1;
+    graph->workers.reserve(static_cast<size_t>(num_threads - 1));
+    for (int i = 0; i < num_threads - 1; ++i)
+        graph->workers.emplace_back([graph]
+        {
+            mh_thread_policy_apply(MH_THREAD_ROLE_AUDIO_WORKER);
+            graph->workerMain();
+        });
+    return 1;
+}
+
 int mh_bus_add_branch(MH_PluginBus* graph,
                          MH_PluginChain* chain,
                          float gain,
@@ -133,6 +290,14 @@ int mh_bus_add_branch(MH_PluginBus* graph,
     for (int c = 0; c < graph->out_channels; ++c)
         ptrs[c] = storage.data() + c * graph->max_block_size;
 
+    // Size the MIDI-merge scratch so process stays allocation-free.
+    const size_t nb = graph->branches.size();
+    graph->midi_span_begin.resize(nb, 0);
+    graph->midi_span_count.resize(nb, 0);
+    graph->midi_merge_head.resize(nb, nullptr);
+    graph->midi_merge_end.resize(nb, nullptr);
+    graph->midi_merge_tree.resize(nb, -1);
+
     return static_cast<int>(graph->branches.size()) - 1;
 }
 
@@ -161,6 +326,56 @@ int mh_bus_get_num_branches(MH_PluginBus* graph)
     return static_cast<int>(graph->branches.size());
 }
 
+// Merge k time-sorted MIDI runs with a tournament ("loser") tree:
+// tree[1..k-1] hold match losers, tree[0] the current winner, so each
+// emitted event costs O(log k) comparisons. Ties on sample_offset go
+// to the lower source index and each run is read in order, which is
+// exactly the stability contract mh_bus_process_midi_io documents
+// (same-offset events keep branch order). head[] cursors advance in
+// place; out must have room for the full merged count.
+static void merge_sorted_midi(const MH_MidiEvent** head,
+                              const MH_MidiEvent* const* end,
+                              int k, int* tree, MH_MidiEvent* out)
+{
+    auto beats = [&](int a, int b) -> bool
+    {
+        if (head[a] == end[a]) return false;   // exhausted runs lose
+        if (head[b] == end[b]) return true;
+        if (head[a]->sample_offset != head[b]->sample_offset)
+            return head[a]->sample_offset < head[b]->sample_offset;
+        return a < b;
+    };
+
+    // Build bottom-up: the first source reaching an empty internal
+    // node parks there; later ones play the match, leave the loser,
+    // and push the winner up.
+    for (int i = 0; i < k; ++i) tree[i] = -1;
+    for (int s = k - 1; s >= 0; --s)
+    {
+        int w = s;
+        int t = (s + k) / 2;
+        while (t > 0 && tree[t] != -1)
+        {
+            if (beats(tree[t], w)) std::swap(w, tree[t]);
+            t /= 2;
+        }
+        tree[t > 0 ? t : 0] = w;
+    }
+
+    int w = 0;
+    for (;;)
+    {
+        const int s = tree[0];
+        if (head[s] == end[s]) break;   // all runs drained
+        out[w++] = *head[s];
+        ++head[s];
+        int cur = s;   // replay only s's leaf-to-root path
+        for (int t = (s + k) / 2; t > 0; t /= 2)
+            if (beats(tree[t], cur)) std::swap(cur, tree[t]);
+        tree[0] = cur;
+    }
+}
+
 // Shared fan-out-and-sum core for the audio-only and MIDI variants.
 // When midi_in is non-NULL (and num_midi_in > 0) each branch is driven
 // via mh_chain_process_midi_io so the same MIDI reaches every branch.
@@ -202,12 +417,50 @@ static int graph_process_impl(MH_PluginBus* graph,
     const bool have_midi = (midi_in != nullptr && num_midi_in > 0);
     const bool collect_midi = (midi_out != nullptr && midi_out_capacity > 0);
 
+    // Parallel path: render branches concurrently on the pool, then do
+    // the gain-sum reduction here. MIDI collection stays on the serial
+    // path below -- the merged stream must preserve branch order.
+    if (!graph->workers.empty() && n_branches > 1 && !collect_midi)
+    {
+        graph->pb_inputs   = inputs;
+        graph->pb_midi_in  = have_midi ? midi_in : nullptr;
+        graph->pb_num_midi = have_midi ? num_midi_in : 0;
+        graph->pb_nframes  = nframes;
+        const bool ok = graph->runBranchesParallel();
+        graph->pb_inputs  = nullptr;
+        graph->pb_midi_in = nullptr;
+        if (!ok) return 0;
+
+        for (int b = 0; b < n_branches; ++b)
+        {
+            const float gain = graph->gains[b];
+            if (gain == 0.0f) continue;
+            float* const* branch_out = graph->branch_ptrs[b].data();
+            for (int c = 0; c < out_ch; ++c)
+            {
+                if (!outputs[c]) continue;
+                const float* src = branch_out[c];
+                float* dst = outputs[c];
+                for (int n = 0; n < nframes; ++n)
+                    dst[n] += gain * src[n];
+            }
+        }
+        return 1;
+    }
+
     // Branch MIDI is appended directly into the caller's midi_out buffer
     // (no internal allocation), then stably sorted once at the end.
     int total_midi_out = 0;
 
     for (int b = 0; b < n_branches; ++b)
     {
+        if (collect_midi)
+        {
+            // Record where this branch's run will land (count filled
+            // in below; stays 0 for muted branches).
+            graph->midi_span_begin[b] = total_midi_out;
+            graph->midi_span_count[b] = 0;
+        }
         float gain = graph->gains[b];
         if (gain == 0.0f)
             continue;  // muted branch -- skip processing entirely
@@ -232,6 +485,7 @@ static int graph_process_impl(MH_PluginBus* graph,
                                          collect_midi ? &branch_count : nullptr);
             if (collect_midi)
             {
+                graph->midi_span_count[b] = branch_count;
                 total_midi_out += branch_count;
                 // The chain filled all the room we gave it: this branch (or
                 // a later one) may have produced more than fit.
@@ -263,21 +517,52 @@ static int graph_process_impl(MH_PluginBus* graph,
 
     if (collect_midi && total_midi_out > 1)
     {
-        // Stable insertion sort by sample_offset. Allocation-free and
-        // stable (uses '>' so equal-offset events keep branch order),
-        // which matters for note-off/note-on pairs at the same frame.
-        // Event counts per block are small, so O(n^2) is acceptable on
-        // the audio thread.
-        for (int i = 1; i < total_midi_out; ++i)
+        // Each branch's run is contiguous in midi_out and (normally)
+        // already time-sorted, so a k-way tournament merge replaces
+        // the per-block sort: O(n log k) and one comparison path per
+        // event. Verify sortedness while setting up the cursors; a
+        // branch that emitted out of order (nothing downstream of a
+        // plugin promises it never will) drops us to the old stable
+        // insertion sort, which imposes order regardless of input.
+        // Either way, equal-offset events keep branch order (branch 0
+        // first), so same-frame note-off/note-on pairs come out in the
+        // same order every render.
+        bool runs_sorted = true;
+        for (int b = 0; b < n_branches; ++b)
         {
-            MH_MidiEvent key = midi_out[i];
-            int j = i - 1;
-            while (j >= 0 && midi_out[j].sample_offset > key.sample_offset)
+            const MH_MidiEvent* run = midi_out + graph->midi_span_begin[b];
+            const int cnt = graph->midi_span_count[b];
+            graph->midi_merge_head[b] = run;
+            graph->midi_merge_end[b]  = run + cnt;
+            for (int i = 1; i < cnt && runs_sorted; ++i)
+                if (run[i].sample_offset < run[i - 1].sample_offset)
+                    runs_sorted = false;
+        }
+        if (runs_sorted)
+        {
+            if ((int) graph->midi_merge_scratch.size() < total_midi_out)
+                graph->midi_merge_scratch.resize((size_t) total_midi_out);
+            merge_sorted_midi(graph->midi_merge_head.data(),
+                              graph->midi_merge_end.data(),
+                              n_branches,
+                              graph->midi_merge_tree.data(),
+                              graph->midi_merge_scratch.data());
+            std::memcpy(midi_out, graph->midi_merge_scratch.data(),
+                        sizeof(MH_MidiEvent) * (size_t) total_midi_out);
+        }
+        else
+        {
+            for (int i = 1; i < total_midi_out; ++i)
             {
-                midi_out[j + 1] = midi_out[j];
-                --j;
+                MH_MidiEvent key = midi_out[i];
+                int j = i - 1;
+                while (j >= 0 && midi_out[j].sample_offset > key.sample_offset)
+                {
+                    midi_out[j + 1] = midi_out[j];
+                    --j;
+                }
+                midi_out[j + 1] = key;
             }
-            midi_out[j + 1] = key;
         }
     }
 
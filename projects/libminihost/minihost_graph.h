@@ -69,6 +69,21 @@ int mh_bus_add_branch(MH_PluginBus* graph,
                          char* err_buf,
                          size_t err_buf_size);
 
+// Opt-in parallel branch execution. Branches are data-independent by
+// construction (same input, summed outputs), so with num_threads > 1
+// mh_bus_process and mh_bus_process_midi render branches concurrently
+// on a worker pool (spawned here, caller's thread participates) and
+// do the gain-sum reduction afterwards. num_threads is clamped to
+// [1, 64]; 1 tears the pool down and restores the serial path.
+//
+// mh_bus_process_midi_io with MIDI collection stays serial: the merged
+// MIDI stream is defined to preserve branch order, which the pool
+// cannot guarantee cheaply.
+//
+// Must not be called while a process call is in flight.
+// Returns 1 on success, 0 on failure.
+int mh_bus_set_num_threads(MH_PluginBus* graph, int num_threads);
+
 // Get / set a branch's summing gain. Returns 1 on success, 0 on
 // failure (NULL graph, index out of range).
 int mh_bus_set_branch_gain(MH_PluginBus* graph, int branch_index, float gain);
@@ -123,9 +138,13 @@ int mh_bus_process_midi(MH_PluginBus* graph,
 // midi_in / num_midi_in: input MIDI fanned to every branch (NULL/0 ok).
 //
 // midi_out: caller-owned buffer receiving the merged branch MIDI,
-//   stably sorted by sample_offset (events at the same offset keep
-//   branch order: branch 0 before branch 1, etc.). May be NULL only if
-//   midi_out_capacity is 0.
+//   stably ordered by sample_offset. The stability guarantee: events
+//   at the same offset keep branch order (branch 0 before branch 1,
+//   etc.) and events from one branch keep their relative order, so
+//   same-frame interleavings are identical on every render. Branch
+//   runs are already time-sorted, so the merge is a k-way tournament
+//   merge over preallocated scratch rather than a per-block sort.
+//   May be NULL only if midi_out_capacity is 0.
 // midi_out_capacity: capacity of midi_out in events.
 // num_midi_out: receives the number of merged events written (may be
 //   NULL). Always <= midi_out_capacity.
@@ -2,14 +2,51 @@
 // General-DAG graph executor. See minihost_graph_v2.h for design.
 
 #include "minihost_graph_v2.h"
+#include "minihost_rt_audit.h"
+#include "minihost_denormal.h"
+#include "minihost_eventlog.h"
+#include "minihost_metrics.h"
+#include "minihost_threads.h"
+#include "minihost_trace.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
 #include <cmath>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#if defined(__linux__)
+  #include <sys/mman.h>   // madvise(MADV_HUGEPAGE), mlock for the pool arena
+  #include <pthread.h>    // pthread_setaffinity_np for worker pinning
+  #include <sched.h>      // cpu_set_t
+#elif !defined(_WIN32)
+  #include <sys/mman.h>   // mlock/munlock (mh_graph_set_lock_memory)
+#endif
+
+// Vector ISA for the mix kernels below. Dispatch is compile-time: SSE2
+// is baseline on x86_64 and NEON on aarch64, so every target we build
+// for resolves to a vector path without runtime CPU detection.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define MH_GRAPH_MIX_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define MH_GRAPH_MIX_NEON 1
+#endif
+
 namespace {
 
 struct Edge {
@@ -29,6 +66,13 @@ struct MidiEdge {
 // Per-plugin midi-out capture buffer (events).
 constexpr int kMidiBufCapacity = 1024;
 
+// Monomorphized MIDI processor handlers (see applyMidiOp below). They
+// take the node so they can read its precomputed tables alongside the
+// params. Return false to drop the event.
+struct Node;
+typedef bool (*MidiOpFn)(MH_MidiEvent&, const Node&);
+typedef bool (*MidiPairFn)(MH_MidiEvent&, const Node&, const Node&);
+
 struct Node {
     MH_NodeKind kind;
 
@@ -42,25 +86,35 @@ struct Node {
     int         num_input_ports = 0;
     int         output_channels = 0;
 
+    // Plugin-only sidechain bus (mh_open_ex with sidechain_in_ch > 0):
+    // exposed as one extra audio input port -- always the
+    // highest-numbered one -- with its own channel count.
+    // sidechain_port == -1 when the plugin has no sidechain bus.
+    int         sidechain_channels = 0;
+    int         sidechain_port     = -1;
+
     // Mix-only: per-input gains. size == num_input_ports.
     std::vector<float> mix_gains;
 
     // Resolved at compile: for each input port, the buffer source.
-    // For plugin/output: input_sources.size() == 1.
-    // For mix:           input_sources.size() == num_input_ports.
+    // For output:  input_sources.size() == 1.
+    // For plugin:  main port plus an optional trailing sidechain port.
+    // For mix:     input_sources.size() == num_input_ports.
     // Each entry references either the caller's input buffer (for an
     // upstream input node, which has no pool buffer) or a pool entry.
     struct InputRef {
         bool        from_caller;   // true => upstream is an input node
         bool        is_silent;     // true => unwired plugin port; feed silence
         int         caller_index;  // index into input_buffers[]
-        int         pool_index;    // index into pool_storage_, when !from_caller
+        int         pool_index;    // pool-entry node id, when !from_caller
+        int         delay_index = -1;  // compensation delay line, or -1
+        int         feedback_index = -1;  // fb_ptrs entry (previous block)
     };
     std::vector<InputRef> input_sources;
 
     // Resolved at compile: the buffer this node writes to.
     //  - input  : not used at render time (we read straight from caller)
-    //  - plugin/mix : index into pool_storage_
+    //  - plugin/mix : its own pool-arena entry (pool_offsets)
     //  - output : caller's output buffer index (caller_index)
     bool out_to_caller   = false;
     int  out_caller_index = 0;
@@ -74,6 +128,30 @@ struct Node {
     // forward to the (single) output channel.
     int pick_channel_index = 0;
 
+    // For MH_NODE_REMAP only: output channel i carries input channel
+    // remap_map[i]; -1 means silence.
+    std::vector<int> remap_map;
+
+    // Copy elision, resolved at compile:
+    //  - output_elided (OUTPUT only): the upstream plugin renders
+    //    directly into the caller's buffer; this node is a no-op.
+    //  - pick_aliased (PICK_CHANNEL only): pool_ptrs[id][0] points
+    //    into the upstream pool buffer; no memcpy at render time.
+    //  - remap_aliased (REMAP only): every mapped output channel's
+    //    pool_ptrs entry points into the upstream pool buffer; render
+    //    only zero-fills the silence channels.
+    bool output_elided = false;
+    bool pick_aliased  = false;
+    bool remap_aliased = false;
+
+    // Analysis tap (mh_graph_set_node_tap): the node's pool entry must
+    // stay written and stride-uniform so mh_graph_borrow_node_audio can
+    // hand out a zero-copy view after each render_block. Compile
+    // therefore excludes tapped nodes from output elision and from
+    // bypass aliasing (both would leave the pool entry stale or
+    // repointed at foreign storage).
+    bool tapped = false;
+
     // MIDI capabilities (cached from MH_Info for plugins).
     bool accepts_midi  = false;
     bool produces_midi = false;
@@ -91,6 +169,33 @@ struct Node {
     // For MH_NODE_MIDI_PROCESSOR only.
     MH_MidiProcessorParams midi_processor_params{};
 
+    // Precomputed from the params (rebuildMidiProcessorTables, run at
+    // add and set_midi_processor_params): the velocity curve as a
+    // 128-entry output LUT and the FILTER note-range test as a
+    // 128-bit pass mask. Every op is then a table read at render time
+    // -- no powf, no libm, in the audio path.
+    unsigned char      midi_velocity_lut[128]   = {};
+    unsigned long long midi_note_pass_mask[2]   = {};
+
+    // MIDI processor specialization (compile; refreshed by
+    // mh_graph_set_midi_processor_params). midi_op_fn is the
+    // monomorphized handler for this node's op. Chains of processors
+    // whose intermediate stream has no other consumer are fused at
+    // compile: the downstream end renders the whole chain in one pass
+    // over the events read from midi_fused_src, applying
+    // midi_fused_stages (upstream-first, self last) per event --
+    // midi_pair_fn short-circuits the common two-stage case -- and
+    // every upstream stage is marked midi_fused_away and renders as a
+    // no-op. midi_fused_consumer points from a folded stage to the
+    // node that absorbed it so a post-compile op change can re-select
+    // the consumer's pair handler.
+    MidiOpFn               midi_op_fn          = nullptr;
+    MidiPairFn             midi_pair_fn        = nullptr;
+    std::vector<MH_NodeId> midi_fused_stages;
+    MH_NodeId              midi_fused_src      = -1;
+    MH_NodeId              midi_fused_consumer = -1;
+    bool                   midi_fused_away     = false;
+
     // MIDI buffers:
     //  - midi_out_buf: events produced by this node this block
     //    (MIDI_INPUT: written by set_midi_input_events; plugin: filled
@@ -102,10 +207,167 @@ struct Node {
     int                       midi_out_count = 0;
     int                       midi_out_truncated_count = 0;
 
+    // Watchdog scratch (mh_graph_set_watchdog): the captured-count
+    // slot handed to a supervised process call. Node-owned rather than
+    // a render-stack int because a call that trips the deadline can
+    // complete long after the render frame is gone, and its late write
+    // must land in memory that still exists.
+    int wd_midi_out_n = 0;
+
+    // MIDI_MERGE scratch, sized to num_midi_input_ports at compile:
+    // per-source read cursors plus the tournament-tree array for the
+    // k-way merge in renderNode. Render-thread-only.
+    std::vector<const MH_MidiEvent*> merge_head;
+    std::vector<const MH_MidiEvent*> merge_end;
+    std::vector<int>                 merge_tree;
+
     // For MIDI_INPUT only: borrowed pointer / count staged by caller
     // before render_block; cleared after each render_block.
     const MH_MidiEvent* staged_midi_events = nullptr;
     int                 staged_midi_count  = 0;
+
+    // For MIDI_OUTPUT only: the drain view for this block. Aliases
+    // the upstream producer's buffer when that buffer is graph-owned
+    // (zero-copy); midi_out_buf is only written when the source is a
+    // MIDI_INPUT, whose caller-staged pointer dies when render_block
+    // returns.
+    const MH_MidiEvent* midi_view_evts = nullptr;
+    int                 midi_view_n    = 0;
+
+    // Plugin-only modulation targets, cached at compile: indices into
+    // the graph's mod_edges that land on this node, plus the scratch
+    // the render path merges synthesized points and staged automation
+    // into (reserved at compile for the synthesized part; grows
+    // amortized when staged automation joins the merge).
+    std::vector<int>            mod_indices;
+    std::vector<MH_ParamChange> mod_auto_scratch;
+
+    // For MH_NODE_RESAMPLE only: caller-fed source-rate FIFO (see
+    // mh_graph_add_resample). Planar ring of resample_capacity frames
+    // per channel; absolute frame counters avoid wrap bookkeeping --
+    // source frame f for channel c lives at [c * capacity + f % capacity].
+    // read_pos is fractional (linear interpolation) and only ever
+    // advances.
+    double             resample_source_rate = 0.0;
+    double             resample_step        = 0.0;  // source frames per output frame
+    int                resample_capacity    = 0;
+    std::vector<float> resample_fifo;               // channels * capacity
+    long long          resample_write_pos   = 0;    // next source frame to write
+    double             resample_read_pos    = 0.0;
+
+    // For MH_NODE_CONVOLVE only: uniformly partitioned FFT
+    // convolution (see mh_graph_add_convolve). The IR spectra are
+    // baked at add time; everything else is render state, touched
+    // only by the thread rendering the node. Input is staged into
+    // conv_in_buf in hops of conv_part frames; each full hop runs one
+    // forward FFT per channel into the frequency-domain delay line
+    // (conv_fdl_*, a ring of conv_parts spectra), multiply-accumulates
+    // against the IR partition spectra, inverse-transforms, and
+    // overlap-adds into the output ring. All buffers are sized at add
+    // time -- the render path never allocates.
+    int conv_part        = 0;   // partition hop (pow2 >= max_block_size)
+    int conv_fft         = 0;   // FFT size, 2 * conv_part
+    int conv_parts       = 0;   // partition count
+    int conv_ir_channels = 0;   // 1 (shared) or output_channels
+    std::vector<float> conv_ir_re,  conv_ir_im;   // ir_ch * parts * fft
+    std::vector<float> conv_fdl_re, conv_fdl_im;  // channels * parts * fft
+    int                conv_fdl_head = 0;          // ring slot of newest hop
+    std::vector<float> conv_overlap;               // channels * part OLA tail
+    std::vector<float> conv_in_buf;                // channels * part staging
+    int                conv_in_fill  = 0;
+    std::vector<float> conv_out_ring;              // channels * 2*part
+    int                conv_out_rd    = 0;
+    int                conv_out_avail = 0;         // primed with conv_part zeros
+    std::vector<float> conv_work_re, conv_work_im; // fft FFT scratch
+    std::vector<float> conv_acc_re,  conv_acc_im;  // fft spectrum accumulator
+
+    // For MH_NODE_PLUGIN added via mh_graph_add_plugin_oversampled
+    // with factor > 1: polyphase windowed-sinc up/downsampling wrapped
+    // around just this plugin's process call. The kernel is designed
+    // at add time; histories and scratch are sized at add time too, so
+    // the render path never allocates (except the MIDI / automation
+    // offset-scaling scratch, which grows amortized with event count).
+    // Touched only by the thread rendering the node.
+    int                oversample_factor = 1;
+    int                os_taps           = 0;  // kernel length, (taps-1) % factor == 0
+    std::vector<float> os_kernel;
+    int                os_up_hist_len = 0;     // ceil(taps/factor) - 1
+    std::vector<float> os_up_hist;             // in_ch * os_up_hist_len
+    std::vector<float> os_up_work;             // os_up_hist_len + max_block
+    std::vector<float> os_down_hist;           // out_ch * (taps - 1)
+    std::vector<float> os_down_work;           // (taps-1) + factor*max_block
+    std::vector<float> os_in_buf;              // in_ch  * factor*max_block
+    std::vector<float> os_out_buf;             // out_ch * factor*max_block
+    std::vector<const float*>   os_in_ptrs;
+    std::vector<float*>         os_out_ptrs;
+    std::vector<MH_MidiEvent>   os_midi_scratch;
+    std::vector<MH_ParamChange> os_auto_scratch;
+
+    // Double-precision rendering (mh_graph_set_double_precision).
+    // double_native is a compile product: plugin node, no oversampling
+    // wrap, mh_supports_double. pool_double_valid tags the node's
+    // shadow-pool entry as holding this block's 64-bit output; it is
+    // only meaningful inside one mh_graph_render_block_double call.
+    // dbl_in_scratch widens float-only inputs (delay lines, silence,
+    // non-native upstreams) ahead of mh_process_double. Touched only
+    // by the thread rendering the node (the level barrier orders
+    // cross-thread reads by downstream consumers).
+    bool                double_native     = false;
+    bool                pool_double_valid = false;
+    std::vector<double> dbl_in_scratch;           // in_ch * max_block
+
+    // Per-node bypass (mh_graph_set_node_bypass), plugin nodes only.
+    // bypass_alias_ok and bypass_delay are compile products: whether a
+    // bypassed block may pass through by aliasing this node's pool
+    // pointers at the upstream buffer (zero-copy), and the node's own
+    // compiled latency, which the dry path reproduces through
+    // bypass_ring so toggling stays phase-aligned. bypass_aliased
+    // marks pool_ptrs as currently aliased; the rendering thread
+    // repoints them at the node's own storage before anything else
+    // writes through them. All of it render-thread-only state -- the
+    // flag itself lives in MH_PluginGraph::bypass_flags.
+    bool               bypass_alias_ok = false;
+    bool               bypass_aliased  = false;
+    int                bypass_delay    = 0;
+    std::vector<float> bypass_ring;          // out_ch * bypass_delay
+    int                bypass_ring_pos = 0;
+
+    // Plugin-only, silence-skip state (mh_graph_set_silence_skip): the
+    // ring-out budget in samples once the node's input goes silent; -1
+    // means "input was live last block" and the budget is re-queried
+    // from mh_get_tail_seconds on the next silent block. Touched only
+    // by whichever thread renders the node, so no atomics needed (the
+    // level barrier orders accesses across blocks).
+    long long tail_remaining = -1;
+
+    // Freeze cache (mh_graph_freeze_node). Recording appends each
+    // rendered block (planar, channels * nframes floats) to the cache;
+    // Replaying copies cache blocks back out in sequence instead of
+    // rendering. freeze_elided marks upstream nodes whose every
+    // consumer is a replaying or elided node, so render skips them
+    // outright. All state is touched only by the thread rendering the
+    // node (level barrier orders across blocks) or by the freeze API
+    // calls, which must not overlap render_block.
+    enum class FreezeMode { Idle, Recording, Replaying };
+    FreezeMode freeze_mode   = FreezeMode::Idle;
+    bool       freeze_elided = false;
+    std::vector<std::vector<float>> freeze_cache;
+    std::vector<int>                freeze_cache_nframes;
+    size_t                          freeze_cursor = 0;
+    unsigned long long              freeze_state_hash = 0;
+};
+
+// Latency-compensation delay line inserted by compile on an input
+// port whose path carries less plugin latency than its siblings into
+// the same fan-in point. All storage is sized at compile; render only
+// rotates the ring, so the audio path stays allocation-free.
+struct DelayLine {
+    int delay    = 0;   // in samples, > 0
+    int channels = 0;
+    int pos      = 0;   // ring cursor, shared across channels
+    std::vector<float>  ring;         // channels * delay, zero-initialized
+    std::vector<float>  out_storage;  // channels * max_block_size
+    std::vector<float*> out_ptrs;     // [channel] -> out_storage frames
 };
 
 struct EdgeKey {
@@ -115,6 +377,78 @@ struct EdgeKey {
     { return dst_node == o.dst_node && dst_port == o.dst_port; }
 };
 
+// Per-node profiling accumulators (mh_graph_set_profiling). Written by
+// whichever pool thread renders the node, read by a polling GUI/control
+// thread; everything is a relaxed atomic, so neither side blocks and no
+// allocation happens on the audio path. The histogram buckets block
+// times into power-of-two nanosecond ranges (bin b = times in
+// [2^b, 2^(b+1)) ns), which is coarse but enough to rank nodes and read
+// off an approximate p99.
+constexpr int kProfileHistBins = 32;
+
+struct NodeProfile {
+    std::atomic<long long> blocks;
+    std::atomic<long long> total_ns;
+    std::atomic<long long> last_ns;
+    std::atomic<long long> max_ns;
+    std::atomic<long long> xruns;
+    std::atomic<long long> ewma_ns;  // 1/8-gain EWMA of block time; feeds
+                                     // mh_graph_refresh_priorities
+    std::atomic<long long> hist[kProfileHistBins];
+
+    void reset()
+    {
+        blocks.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        last_ns.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+        xruns.store(0, std::memory_order_relaxed);
+        ewma_ns.store(0, std::memory_order_relaxed);
+        for (int b = 0; b < kProfileHistBins; ++b)
+            hist[b].store(0, std::memory_order_relaxed);
+    }
+};
+
+inline int profileBin(long long ns)
+{
+    int bin = 0;
+    while (ns > 1 && bin < kProfileHistBins - 1) { ns >>= 1; ++bin; }
+    return bin;
+}
+
+// Per-node meter tap (mh_graph_set_node_meter). One slot per node,
+// written by whichever thread renders the node (the level barrier keeps
+// it single-writer) and read by a polling GUI thread. Published through
+// a seqlock -- the same snapshot pattern MH_PlayHead uses for transport
+// state -- so the writer never blocks and a reader that catches a write
+// in flight just re-copies.
+constexpr int kMeterMaxChannels = 32;
+
+struct NodeMeter {
+    std::atomic<unsigned> seq{0};   // odd = write in progress
+    float peak[kMeterMaxChannels];
+    float rms [kMeterMaxChannels];
+};
+
+// Watchdog sentry (mh_graph_set_watchdog): one worker thread that runs
+// supervised plugin process calls so the render thread can wait them
+// out with a deadline. Started lazily on the first supervised call.
+// When a call trips the deadline the worker is stuck inside the
+// plugin, so the whole sentry is abandoned -- detached and
+// intentionally leaked, because the zombie thread still references it
+// -- and a fresh one starts on the next supervised call.
+struct WatchdogSentry {
+    std::mutex              mtx;
+    std::condition_variable cv;
+    std::function<int()>    job;
+    bool                    has_job = false;
+    bool                    done    = false;
+    bool                    quit    = false;
+    int                     result  = 0;
+    std::thread             worker;
+    bool                    running = false;
+};
+
 } // namespace
 
 struct MH_PluginGraph {
@@ -124,6 +458,35 @@ struct MH_PluginGraph {
     std::vector<Node>      nodes;
     std::vector<Edge>      edges;
     std::vector<MidiEdge>  midi_edges;
+
+    // Feedback edges (mh_graph_connect_feedback): excluded from the
+    // topological sort, so they may legally close a cycle. Each one
+    // carries a single-block delay: a per-edge holding buffer
+    // (fb_storage, allocated and zeroed at compile) receives the
+    // source node's pool output after every render walk, and the
+    // destination port reads that copy -- i.e. the previous block --
+    // on the next one.
+    std::vector<Edge>                feedback_edges;
+    std::vector<std::vector<float>>  fb_storage;  // [edge] ch * max_block
+    std::vector<std::vector<float*>> fb_ptrs;
+
+    // Modulation edges (mh_graph_connect_modulation): one source
+    // channel driving one (plugin, parameter) target. Sampled at
+    // render time -- once per block, or every mod_interval frames --
+    // into synthesized MH_ParamChange entries that ride the normal
+    // mh_process_auto dispatch. Forward edges for scheduling: they
+    // join the topological sort so the source renders first.
+    struct ModEdge {
+        MH_NodeId src_node;
+        int       src_channel;
+        MH_NodeId dst_node;
+        int       param_index;
+        float     base;
+        float     depth;
+        int       curve;       // MH_ModCurve
+    };
+    std::vector<ModEdge> mod_edges;
+    int                  mod_interval = 0;  // frames; 0 = once per block
     std::vector<MH_NodeId> input_nodes_;   // node ids in add order
     std::vector<MH_NodeId> output_nodes_;
 
@@ -131,17 +494,81 @@ struct MH_PluginGraph {
     bool                    compiled = false;
     std::vector<MH_NodeId>  schedule;
 
+    // Frame count of the most recent successful render_block: the
+    // valid length of every pool buffer, served to analysis taps by
+    // mh_graph_borrow_node_audio. Reset at compile. Written only by
+    // the rendering thread; read between blocks (same contract as the
+    // MIDI borrow).
+    int                     last_nframes = 0;
+
+    // True between mh_graph_begin_edit and the next successful
+    // mh_graph_compile. While set, compile runs its incremental path:
+    // pool slots whose size is unchanged are zeroed instead of
+    // reallocated and the worker pool stays alive.
+    bool editing = false;
+
+    // Staged compiled-schedule snapshot (mh_graph_set_plan). Verified
+    // against the graph's shape hash at compile; on a match compile
+    // adopts the stored topological order instead of re-validating
+    // connectivity and re-running the sort. A mismatch is ignored.
+    std::vector<unsigned char> plan_blob;
+
     // Single zero-filled buffer sized max_block_size, used to feed
     // silence into plugin nodes whose audio input port is unwired
     // (instruments / synths typically don't need a wired input but
     // their JUCE descriptor still reports one).
     std::vector<float>                silence_buf;
 
-    // Per-pool-entry: channels * max_block_size floats (contiguous).
-    // Pointer table for handing planar views to mh_process.
-    std::vector<std::vector<float>>   pool_storage;
+    // Buffer-pool arena (compile step 3): every node's pool buffer is
+    // carved from one 64-byte-aligned allocation, laid out in schedule
+    // order so adjacent nodes in the render walk touch adjacent cache
+    // lines. pool_offsets[i] is node i's first float in the arena
+    // (SIZE_MAX for nodes without a pool entry); channels are padded
+    // to pool_chan_stride floats so every channel pointer stays
+    // 64-byte aligned. pool_huge_pages asks for transparent-huge-page
+    // backing on Linux (mh_graph_set_pool_huge_pages).
+    struct PoolArenaFree { void operator()(float* p) const { std::free(p); } };
+    std::unique_ptr<float[], PoolArenaFree> pool_arena;
+    size_t                            pool_arena_floats = 0;
+    std::vector<size_t>               pool_offsets;
+    size_t                            pool_chan_stride  = 0;
+    int                               pool_huge_pages   = 0;
     std::vector<std::vector<float*>>  pool_ptrs;        // [pool][channel] -> frame_ptr
 
+    // Opt-in arena residency (mh_graph_set_lock_memory): compile
+    // mlocks the pool arenas so the OS cannot evict them between
+    // callbacks. Best-effort -- an RLIMIT_MEMLOCK refusal leaves the
+    // arena unlocked (locked bytes stay 0) and compile proceeds. The
+    // tracked lengths let the exact ranges be munlocked before the
+    // allocator recycles the pages.
+    int    pool_lock_memory  = 0;
+    size_t pool_locked_bytes = 0;   // float arena
+    size_t dbl_locked_bytes  = 0;   // double shadow arena
+
+    // Double-precision shadow pool (mh_graph_set_double_precision,
+    // compile step 3.5): same stride and schedule-order layout as the
+    // float arena but with entries only for double-native plugin
+    // nodes, so consecutive double-capable hops hand 64-bit audio off
+    // directly. The float pool stays authoritative for every other
+    // consumer -- a double node narrows into it eagerly right after
+    // processing, which also keeps mix/pick/freeze/bypass oblivious
+    // to the precision of their upstreams.
+    struct DblArenaFree { void operator()(double* p) const { std::free(p); } };
+    int    double_mode = 0;
+    std::unique_ptr<double[], DblArenaFree> dbl_arena;
+    size_t                            dbl_arena_doubles = 0;
+    std::vector<size_t>               dbl_offsets;
+    std::vector<std::vector<double*>> dbl_ptrs;
+
+    // Float staging for render_block_double: the caller's double
+    // inputs are narrowed here once per block and handed to the render
+    // walk as its float input_buffers table, so float consumers see a
+    // normal float render. Double-native plugins wired straight to an
+    // input node bypass the staging via rbd_inputs below.
+    std::vector<std::vector<float>>        dbl_in_stage;
+    std::vector<std::vector<const float*>> dbl_in_stage_ptrs;
+    std::vector<const float* const*>       dbl_stage_table;
+
     // Pending MIDI for the next render_block call, indexed by node id.
     // Caller-owned pointers; cleared after each render_block.
     struct PendingMidi { const MH_MidiEvent* events; int count; };
@@ -151,6 +578,248 @@ struct MH_PluginGraph {
     // node id. Same lifetime contract as pending_midi.
     struct PendingAuto { const MH_ParamChange* changes; int count; };
     std::vector<PendingAuto> pending_auto;
+
+    // Timeline automation (mh_graph_set_node_automation_timeline):
+    // owned, sorted copies of whole-render change lists with absolute
+    // sample offsets, consumed slice by slice as render_block advances
+    // timeline_frame. cursor walks forward so each block pays only for
+    // the changes it covers; block_scratch holds the rebased slice that
+    // gets staged into pending_auto for the block.
+    // Curve automation (mh_graph_set_node_automation_curves) rides the
+    // same playhead: keyframes stay in native sparse form, grouped per
+    // parameter, and each block evaluates every curve once at the block
+    // start -- nothing is ever expanded to a dense change list.
+    struct TimelineAuto {
+        std::vector<MH_ParamChange> changes;       // sorted by sample_offset
+        size_t                      cursor = 0;
+        std::vector<MH_ParamChange> block_scratch; // block-local rebased slice
+        std::vector<MH_ParamChange> keyframes;     // sorted (param, offset)
+        struct Curve {
+            int    param  = 0;      // parameter index
+            size_t begin  = 0;      // keyframe group [begin, end)
+            size_t end    = 0;
+            size_t cursor = 0;      // first keyframe past the playhead
+            float  last   = 0.0f;   // last staged value (if has_last)
+            bool   has_last = false;
+        };
+        std::vector<Curve> curves;
+        // Scrubbing index (mh_graph_seek_automation_state): a
+        // (param, offset)-sorted copy of `changes` with per-parameter
+        // group ranges, so the latest value before an arbitrary frame
+        // is one binary search per parameter instead of a replay.
+        // Built lazily on the first state seek -- plain offline
+        // renders never pay for it.
+        struct ParamSpan { int param = 0; size_t begin = 0; size_t end = 0; };
+        std::vector<MH_ParamChange> state_index;
+        std::vector<ParamSpan>      state_groups;
+        bool                        state_index_built = false;
+    };
+    std::vector<TimelineAuto> timeline_auto;  // sized at compile, one per node
+    long long                 timeline_frame = 0;
+
+    // Graph transport (mh_graph_set_transport): one shared seqlock cell
+    // that every plugin node's playhead reads, so a timeline update is
+    // a single mh_shared_transport_write instead of a per-plugin
+    // mh_set_transport fan-out. transport_info is the render thread's
+    // authoritative copy, advanced after each block while playing;
+    // transport_active distinguishes "never set" from an explicit
+    // NULL (no-transport) publish. Plugin nodes are detached at close.
+    MH_SharedTransport* shared_transport = nullptr;
+    MH_TransportInfo    transport_info{};
+    bool                transport_active = false;
+
+    // Latency compensation (filled at compile).
+    std::vector<DelayLine> delay_lines;
+    int graph_latency_samples = 0;
+
+    // Per-node profiling (mh_graph_set_profiling). `profiles` is sized
+    // nodes.size() at compile; the enable flag can be flipped from any
+    // thread and is read once per node render.
+    std::atomic<int> profiling_enabled{0};
+    std::unique_ptr<NodeProfile[]> profiles;
+
+    // Trace-span ring (mh_graph_set_tracing). Sized by the enabling
+    // call; render threads only write into pre-existing slots.
+    // trace_block numbers every render_block call so spans can be
+    // correlated with a specific block in the exported timeline.
+    mh_trace::Ring         trace_ring;
+    std::atomic<long long> trace_block{0};
+
+    // Silence-aware plugin-node skip (mh_graph_set_silence_skip). Read
+    // once per plugin node render; flippable from any thread.
+    std::atomic<int> silence_skip{0};
+
+    // Watchdog supervision (mh_graph_set_watchdog). timeout 0 = off;
+    // read once per plugin process call. watchdog_mtx serializes
+    // supervised calls from parallel render workers behind the single
+    // sentry. failed_flags is sized at compile and carries over
+    // recompiles like bypass_flags; a set flag is sticky -- the hung
+    // call may still be executing on an abandoned thread, so the
+    // node's plugin is never touched again (mh_graph_clear_node_failed
+    // is the explicit override).
+    std::atomic<long long> watchdog_timeout_ns{0};
+    std::atomic<long long> watchdog_trips{0};
+    std::mutex             watchdog_mtx;
+    WatchdogSentry*        sentry = nullptr;  // lazy; leaked on abandon
+    std::unique_ptr<std::atomic<int>[]> failed_flags;
+    int                                 failed_count = 0;
+
+    // Per-node bypass flags (mh_graph_set_node_bypass). Sized
+    // nodes.size() at compile -- existing values survive a begin_edit
+    // recompile since node ids are append-only. Each flag is read once
+    // per plugin-node render and flippable from any thread.
+    std::unique_ptr<std::atomic<int>[]> bypass_flags;
+    int                                 bypass_count = 0;
+
+    // Per-node wet/dry mix (mh_graph_set_node_mix), float bits in an
+    // atomic word. Sized and carried over recompiles like bypass_flags;
+    // read once per plugin-node render and retunable from any thread.
+    std::unique_ptr<std::atomic<unsigned>[]> node_mix;
+    int                                      node_mix_count = 0;
+
+    // ---- Adaptive overload governor (mh_graph_set_governor) ----
+    //
+    // shed_order ranks sacrificial nodes (-1 = never shed); sized like
+    // bypass_flags at compile and surviving recompiles the same way.
+    // The over/under counters and the shed stack belong to the render
+    // thread; cfg/cb/user are published before enabled can read 1 and
+    // are only replaced while no render is in flight. governor_stack is
+    // reserved at compile so shedding never allocates on the render
+    // path. shed_count mirrors the stack size for any-thread polling.
+    std::unique_ptr<std::atomic<int>[]> shed_order;
+    int                                 shed_order_count = 0;
+    std::atomic<int>         governor_enabled{0};
+    MH_GovernorConfig        governor_cfg{};
+    MH_GraphGovernorCallback governor_cb   = nullptr;
+    void*                    governor_user = nullptr;
+    int                      governor_over  = 0;
+    int                      governor_under = 0;
+    std::vector<MH_NodeId>   governor_stack;
+    std::atomic<int>         governor_shed_count{0};
+
+    // Per-node meter taps (mh_graph_set_node_meter). Flags and slots
+    // are sized nodes.size() at compile -- flag values survive a
+    // begin_edit recompile like bypass flags do -- so toggling a tap
+    // mid-session allocates nothing. Each flag is read once per node
+    // render and flippable from any thread.
+    std::unique_ptr<std::atomic<int>[]> meter_flags;
+    std::unique_ptr<NodeMeter[]>        meters;
+    int                                 meter_count = 0;
+
+    // Verification hashing (mh_graph_set_hashing). Mode 0 = off, 1 =
+    // fold each block's caller-visible output into render_digest, 2 =
+    // additionally fold every node's output into its own slot so a
+    // divergence between two runs localizes to the first node whose
+    // digests differ. Slots are sized nodes.size() at compile; mode
+    // and digests are atomic so a control thread can poll mid-render,
+    // though digests only compare meaningfully between completed runs
+    // rendered with identical block sequences.
+    std::atomic<int> hash_mode{0};
+    std::atomic<unsigned long long> render_digest{0};
+    std::unique_ptr<std::atomic<unsigned long long>[]> node_digests;
+    int hash_count = 0;
+
+    // ----- worker pool (mh_graph_set_num_threads) -----
+    //
+    // Requested thread count; 1 = serial render on the caller's
+    // thread (no pool). Compile groups the schedule into topological
+    // levels and spawns num_threads - 1 workers; nodes within a level
+    // are claimed via per-level atomic cursors so a block allocates
+    // nothing and threads that finish early steal remaining nodes.
+    int num_threads = 1;
+
+    // Worker CPU pinning (mh_graph_set_worker_affinity): worker i is
+    // pinned to worker_cpus[i % size] at spawn. Empty = no pinning.
+    // Applied on Linux only (pthread_setaffinity_np); stored but inert
+    // elsewhere.
+    std::vector<int> worker_cpus;
+
+    // levels[k] = nodes whose longest path from any root is k. Every
+    // edge crosses strictly upward in level, so nodes sharing a level
+    // are mutually independent. Within a level, nodes are ordered by
+    // descending critical-path cost (longest remaining chain first) so
+    // the pool's claim cursor hands out stragglers before the cheap
+    // leaves -- an expensive node claimed last would idle every other
+    // core at the level barrier. Compile ranks with unit costs;
+    // mh_graph_refresh_priorities re-ranks with measured times.
+    std::vector<std::vector<MH_NodeId>> levels;
+
+    // Successor lists captured at compile for the critical-path
+    // re-rank (audio + MIDI edges, same lists the level builder used).
+    std::vector<std::vector<MH_NodeId>> cp_succ;
+
+    // Deadline accounting (mh_graph_render_block_deadline). The
+    // caller's per-block budget replaces the derived nframes/rate one
+    // for the governor and xrun attribution; misses are polled from
+    // any thread.
+    std::atomic<long long> deadline_misses{0};
+
+    std::vector<std::thread> workers;
+    std::mutex               pool_mutex;
+    std::condition_variable  pool_cv;       // main -> workers: level ready
+    std::condition_variable  pool_done_cv;  // workers -> main: progress
+    bool                     pool_shutdown   = false;
+    bool                     pool_active     = false;  // a level is in flight
+    int                      pool_busy       = 0;      // workers inside drainLevel
+    unsigned                 pool_generation = 0;
+    int                      pool_level_index = 0;
+    std::atomic<int>         pool_ok{1};
+
+    // Per-level cursors, sized levels.size() at compile and reset at
+    // the top of every multi-threaded render_block.
+    std::unique_ptr<std::atomic<int>[]> pool_level_next;
+    std::unique_ptr<std::atomic<int>[]> pool_level_remaining;
+
+    // Shared executor (mh_graph_set_executor). When attached, levels
+    // are published to the process-wide pool instead of the private
+    // one: the render thread still helps drain, shared workers join
+    // according to priority and the per-graph cap. exec_busy counts
+    // shared workers currently inside this graph's drainLevel; the
+    // render thread waits it down to zero before leaving a level so a
+    // worker never touches the graph after render_block returns.
+    MH_GraphExecutor* executor         = nullptr;
+    int               exec_priority    = 0;
+    int               exec_max_workers = 0;   // 0 = executor size
+    std::atomic<int>  exec_busy{0};
+
+    // Per-block render arguments shared with the workers. Only valid
+    // while render_block is on the stack.
+    const float* const* const* rb_inputs  = nullptr;
+    float* const* const*       rb_outputs = nullptr;
+    int                        rb_nframes = 0;
+
+    // Double-render arguments (mh_graph_render_block_double), same
+    // lifetime as the rb_* trio. rbd_active routes plugin and output
+    // nodes onto the double path for the duration of the call.
+    bool                        rbd_active  = false;
+    const double* const* const* rbd_inputs  = nullptr;
+    double* const* const*       rbd_outputs = nullptr;
+
+    void spawnWorkers();
+    void stopWorkers();
+    void workerMain();
+    void drainLevel(int level_index);
+    bool runLevel(int level_index);
+};
+
+// Shared executor (mh_graph_executor_create): one process-wide pool
+// that several graphs publish their in-flight level to. Same
+// claim-a-node-from-an-atomic-cursor scheme as the private pool --
+// workers just pick WHICH graph's cursor to drain first, preferring
+// the highest exec_priority among the runnable ones.
+struct MH_GraphExecutor {
+    std::mutex               mutex;
+    std::condition_variable  cv;       // graphs -> workers: level published
+    std::vector<std::thread> workers;
+    bool                     shutdown = false;
+
+    // Graphs with a level in flight. Publish / retract bracket each
+    // multi-node level inside runLevel, so entries are always valid to
+    // dereference while they are on the list.
+    std::vector<MH_PluginGraph*> active;
+
+    MH_PluginGraph* pick();   // call with mutex held
+    void workerMain();
 };
 
 namespace {
@@ -172,6 +841,23 @@ void setErrf(char* buf, size_t n, const char* fmt, ...)
 
 bool inRange(MH_NodeId id, int sz) { return id >= 0 && id < sz; }
 
+// Float <-> bits for the per-node wet/dry mix: the value lives in an
+// atomic word so any thread can retune it while a render is in flight
+// (same shape as the metrics gauges).
+inline unsigned floatBits(float v)
+{
+    unsigned bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    return bits;
+}
+
+inline float bitsToFloat(unsigned bits)
+{
+    float v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
 // Find the edge whose (dst_node, dst_port) matches key. Returns -1
 // if none. Linear scan; v1 graphs are small.
 int findEdge(const std::vector<Edge>& edges, MH_NodeId dst, int port)
@@ -182,6 +868,288 @@ int findEdge(const std::vector<Edge>& edges, MH_NodeId dst, int port)
     return -1;
 }
 
+// Smallest power of two >= v (v >= 1).
+int nextPow2(int v)
+{
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// In-place iterative radix-2 complex FFT (n a power of two). Twiddles
+// come from a double-precision recurrence per stage, so the cost is
+// one cos/sin pair per stage rather than per butterfly, and the error
+// stays at float level for the sizes the convolve node uses. The
+// inverse applies its own 1/n scale. Self-contained on purpose:
+// libminihost links no DSP library, and the convolve node only needs
+// this one transform.
+void fftInPlace(float* re, float* im, int n, bool inverse)
+{
+    for (int i = 1, j = 0; i < n; ++i)
+    {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+    const double kPi = 3.14159265358979323846;
+    for (int len = 2; len <= n; len <<= 1)
+    {
+        const double ang = (inverse ? 2.0 : -2.0) * kPi / (double) len;
+        const double wr0 = std::cos(ang);
+        const double wi0 = std::sin(ang);
+        for (int i = 0; i < n; i += len)
+        {
+            double wr = 1.0, wi = 0.0;
+            for (int k = 0; k < len / 2; ++k)
+            {
+                const int   a  = i + k;
+                const int   b  = a + len / 2;
+                const float tr = (float)(re[b] * wr - im[b] * wi);
+                const float ti = (float)(re[b] * wi + im[b] * wr);
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+                const double nwr = wr * wr0 - wi * wi0;
+                wi = wr * wi0 + wi * wr0;
+                wr = nwr;
+            }
+        }
+    }
+    if (inverse)
+    {
+        const float s = 1.0f / (float) n;
+        for (int i = 0; i < n; ++i)
+        {
+            re[i] *= s;
+            im[i] *= s;
+        }
+    }
+}
+
+// Anti-imaging / anti-aliasing kernel for the oversampling wrapper:
+// Blackman-windowed sinc lowpass at the oversampled rate, cutoff just
+// inside the base band (~74 dB stopband). Tap counts keep the
+// combined up+down group delay, (taps - 1) high-rate samples, an
+// integer number of base-rate samples. Unity DC gain; the up stage
+// multiplies by the factor to undo zero-stuffing loss.
+std::vector<float> designOversampleKernel(int factor)
+{
+    const int taps = (factor == 2) ? 121 : 241;   // (taps - 1) % factor == 0
+    std::vector<float> h((size_t) taps);
+    const double kPi = 3.14159265358979323846;
+    const double fc  = 0.45 / (double) factor;
+    const int    c   = (taps - 1) / 2;
+    double sum = 0.0;
+    for (int t = 0; t < taps; ++t)
+    {
+        const double x = (double)(t - c);
+        const double s = (x == 0.0)
+            ? 2.0 * fc
+            : std::sin(2.0 * kPi * fc * x) / (kPi * x);
+        const double w = 0.42
+            - 0.5  * std::cos(2.0 * kPi * t / (taps - 1))
+            + 0.08 * std::cos(4.0 * kPi * t / (taps - 1));
+        h[(size_t) t] = (float)(s * w);
+        sum += s * w;
+    }
+    for (auto& v : h) v = (float)((double) v / sum);
+    return h;
+}
+
+// Defined with the freeze helpers further down; compile needs it when
+// recompiling a graph that still holds replaying nodes.
+static void recomputeFreezeElision(MH_PluginGraph* g);
+
+// Process-wide block counter (mh_metrics). Registered on first graph
+// create; -1 (ignored by mh_metric_add) until then.
+std::atomic<int> g_graph_blocks_metric{-1};
+
+// mlock/munlock one arena range (mh_graph_set_lock_memory). Locking
+// is best-effort: a refusal (typically RLIMIT_MEMLOCK) leaves
+// *locked_bytes at 0 and the caller proceeds with pageable memory.
+// Unlocking must happen before the arena is freed -- the allocator
+// recycles the pages, and a still-locked range would keep counting
+// against the process's memlock budget.
+void lockArena(void* p, size_t bytes, size_t* locked_bytes)
+{
+    *locked_bytes = 0;
+#if !defined(_WIN32)
+    if (p != nullptr && bytes > 0 && mlock(p, bytes) == 0)
+        *locked_bytes = bytes;
+#else
+    (void) p; (void) bytes;
+#endif
+}
+
+void unlockArena(void* p, size_t* locked_bytes)
+{
+#if !defined(_WIN32)
+    if (p != nullptr && *locked_bytes > 0)
+        munlock(p, *locked_bytes);
+#else
+    (void) p;
+#endif
+    *locked_bytes = 0;
+}
+
+// ---- MIDI processor specialization ---------------------------------
+//
+// The render-time MH_MidiOp switch is hoisted out of the per-event
+// loop: one template instantiation per op (if constexpr folds the
+// dead branches away), selected into Node::midi_op_fn at compile and
+// whenever set_midi_processor_params changes the op. Stacked
+// processors additionally fuse (compileGraph step 6b) so a 5-deep
+// stack is one pass over the event array instead of five buffered
+// hops.
+
+template <int Op>
+bool applyMidiOp(MH_MidiEvent& e, const Node& node)
+{
+    const unsigned char status_hi = (unsigned char)(e.status & 0xF0);
+    const bool is_note_on  = (status_hi == 0x90);
+    const bool is_note_off = (status_hi == 0x80);
+
+    if constexpr (Op == MH_MIDI_OP_FILTER)
+    {
+        if ((unsigned char) e.status >= 0xF0) return true;  // system msgs
+        // Channel filter applies to all channel-voice messages.
+        if (((node.midi_processor_params.channel_mask
+                  >> (e.status & 0x0F)) & 1) == 0) return false;
+        // Note range filter only applies to note on/off; the
+        // [min_note, max_note] test is a precomputed pass-mask bit.
+        if (is_note_on || is_note_off)
+        {
+            const int note = e.data1 & 0x7F;
+            if (((node.midi_note_pass_mask[note >> 6]
+                      >> (note & 63)) & 1ull) == 0) return false;
+        }
+        return true;
+    }
+    else if constexpr (Op == MH_MIDI_OP_TRANSPOSE)
+    {
+        if (is_note_on || is_note_off)
+        {
+            const int new_note = (e.data1 & 0x7F)
+                + node.midi_processor_params.transpose_semitones;
+            if (new_note < 0 || new_note > 127) return false;
+            e.data1 = (unsigned char) new_note;
+        }
+        return true;
+    }
+    else  // MH_MIDI_OP_VELOCITY_CURVE
+    {
+        // The curve was baked into a LUT when the params were set;
+        // velocity-0 note-ons (note-offs in disguise) pass untouched.
+        if (is_note_on && e.data2 > 0)
+            e.data2 = node.midi_velocity_lut[e.data2 & 0x7F];
+        return true;
+    }
+}
+
+// Fused two-stage handler: both ops inlined into one call, the common
+// shape for stacked processors (filter+transpose, transpose+curve...).
+template <int Op1, int Op2>
+bool applyMidiOpPair(MH_MidiEvent& e, const Node& a, const Node& b)
+{
+    return applyMidiOp<Op1>(e, a) && applyMidiOp<Op2>(e, b);
+}
+
+// Bake the param-derived tables: the velocity curve's 128 outputs
+// (identical rounding/clamping to the formula documented on
+// MH_MidiProcessorParams) and the FILTER note-range pass mask. Called
+// from add_midi_processor and set_midi_processor_params -- the only
+// places params change -- so render never touches powf.
+void rebuildMidiProcessorTables(Node& n)
+{
+    const MH_MidiProcessorParams& p = n.midi_processor_params;
+    const float gamma = p.velocity_gamma > 0.0f ? p.velocity_gamma : 1.0f;
+    n.midi_velocity_lut[0] = 0;   // unreachable: velocity 0 passes through
+    for (int vel = 1; vel < 128; ++vel)
+    {
+        const float curved
+            = std::pow((float) vel / 127.0f, gamma);
+        int v = (int) std::lround(curved * 127.0f);
+        if (v < 1)   v = 1;
+        if (v > 127) v = 127;
+        n.midi_velocity_lut[vel] = (unsigned char) v;
+    }
+    n.midi_note_pass_mask[0] = 0;
+    n.midi_note_pass_mask[1] = 0;
+    for (int note = 0; note < 128; ++note)
+        if (note >= p.min_note && note <= p.max_note)
+            n.midi_note_pass_mask[note >> 6] |= 1ull << (note & 63);
+}
+
+MidiOpFn selectMidiOpFn(MH_MidiOp op)
+{
+    switch (op)
+    {
+    case MH_MIDI_OP_FILTER:         return &applyMidiOp<MH_MIDI_OP_FILTER>;
+    case MH_MIDI_OP_TRANSPOSE:      return &applyMidiOp<MH_MIDI_OP_TRANSPOSE>;
+    case MH_MIDI_OP_VELOCITY_CURVE: break;
+    }
+    return &applyMidiOp<MH_MIDI_OP_VELOCITY_CURVE>;
+}
+
+MidiPairFn selectMidiPairFn(MH_MidiOp op1, MH_MidiOp op2)
+{
+    switch (op1)
+    {
+    case MH_MIDI_OP_FILTER:
+        switch (op2)
+        {
+        case MH_MIDI_OP_FILTER:
+            return &applyMidiOpPair<MH_MIDI_OP_FILTER, MH_MIDI_OP_FILTER>;
+        case MH_MIDI_OP_TRANSPOSE:
+            return &applyMidiOpPair<MH_MIDI_OP_FILTER, MH_MIDI_OP_TRANSPOSE>;
+        case MH_MIDI_OP_VELOCITY_CURVE: break;
+        }
+        return &applyMidiOpPair<MH_MIDI_OP_FILTER, MH_MIDI_OP_VELOCITY_CURVE>;
+    case MH_MIDI_OP_TRANSPOSE:
+        switch (op2)
+        {
+        case MH_MIDI_OP_FILTER:
+            return &applyMidiOpPair<MH_MIDI_OP_TRANSPOSE, MH_MIDI_OP_FILTER>;
+        case MH_MIDI_OP_TRANSPOSE:
+            return &applyMidiOpPair<MH_MIDI_OP_TRANSPOSE, MH_MIDI_OP_TRANSPOSE>;
+        case MH_MIDI_OP_VELOCITY_CURVE: break;
+        }
+        return &applyMidiOpPair<MH_MIDI_OP_TRANSPOSE,
+                                MH_MIDI_OP_VELOCITY_CURVE>;
+    case MH_MIDI_OP_VELOCITY_CURVE: break;
+    }
+    switch (op2)
+    {
+    case MH_MIDI_OP_FILTER:
+        return &applyMidiOpPair<MH_MIDI_OP_VELOCITY_CURVE, MH_MIDI_OP_FILTER>;
+    case MH_MIDI_OP_TRANSPOSE:
+        return &applyMidiOpPair<MH_MIDI_OP_VELOCITY_CURVE,
+                                MH_MIDI_OP_TRANSPOSE>;
+    case MH_MIDI_OP_VELOCITY_CURVE: break;
+    }
+    return &applyMidiOpPair<MH_MIDI_OP_VELOCITY_CURVE,
+                            MH_MIDI_OP_VELOCITY_CURVE>;
+}
+
+// (Re)select a node's fused two-stage handler from its stage list.
+// Cleared for chains of any other length -- those take the generic
+// per-stage loop in renderNodeImpl.
+void refreshMidiPairFn(MH_PluginGraph* g, MH_NodeId id)
+{
+    Node& n = g->nodes[(size_t) id];
+    n.midi_pair_fn = nullptr;
+    if (n.midi_fused_stages.size() != 2) return;
+    const Node& a = g->nodes[(size_t) n.midi_fused_stages[0]];
+    n.midi_pair_fn = selectMidiPairFn(a.midi_processor_params.op,
+                                      n.midi_processor_params.op);
+}
+
 } // namespace
 
 extern "C" MH_PluginGraph* mh_graph_create(int max_block_size,
@@ -201,13 +1169,46 @@ extern "C" MH_PluginGraph* mh_graph_create(int max_block_size,
     auto* g = new MH_PluginGraph();
     g->max_block_size = max_block_size;
     g->sample_rate    = sample_rate;
+
+    // Idempotent by name, so repeated creates just re-fetch the handle.
+    g_graph_blocks_metric.store(
+        mh_metric_register("graph.blocks_rendered", MH_METRIC_COUNTER),
+        std::memory_order_relaxed);
+
     return g;
 }
 
 extern "C" void mh_graph_close(MH_PluginGraph* g)
 {
     if (g == nullptr) return;
-    // Plugin nodes are caller-owned.
+    g->stopWorkers();
+    // Stop a live watchdog sentry (an abandoned one was detached at
+    // trip time and stays leaked on purpose).
+    if (g->sentry != nullptr)
+    {
+        {
+            std::lock_guard<std::mutex> lk(g->sentry->mtx);
+            g->sentry->quit = true;
+        }
+        g->sentry->cv.notify_all();
+        if (g->sentry->worker.joinable())
+            g->sentry->worker.join();
+        delete g->sentry;
+        g->sentry = nullptr;
+    }
+    // Plugin nodes are caller-owned and outlive the graph; detach their
+    // playheads before the shared transport cell goes away.
+    if (g->shared_transport != nullptr)
+    {
+        for (auto& n : g->nodes)
+            if (n.plugin != nullptr)
+                mh_set_transport_shared(n.plugin, nullptr);
+        mh_shared_transport_free(g->shared_transport);
+    }
+    // Unpin before the arenas are freed: free() does not munlock, and
+    // leaked locks keep counting against RLIMIT_MEMLOCK.
+    unlockArena(g->pool_arena.get(), &g->pool_locked_bytes);
+    unlockArena(g->dbl_arena.get(), &g->dbl_locked_bytes);
     delete g;
 }
 
@@ -243,6 +1244,17 @@ extern "C" MH_NodeId mh_graph_add_plugin(MH_PluginGraph* g, MH_Plugin* p,
     n.output_channels = info.num_output_ch;
     n.accepts_midi    = info.accepts_midi != 0;
     n.produces_midi   = info.produces_midi != 0;
+    // Plugins opened with a sidechain bus (mh_open_ex) get one extra
+    // input port after the main one, so mh_graph_connect can wire a
+    // key signal straight from the pool. Unwired it feeds silence,
+    // like the main plugin port.
+    const int sc_ch = mh_get_sidechain_channels(p);
+    if (sc_ch > 0)
+    {
+        n.sidechain_channels = sc_ch;
+        n.sidechain_port     = n.num_input_ports;
+        n.num_input_ports += 1;
+    }
     n.input_sources.resize((size_t) n.num_input_ports);
     if (n.accepts_midi)
     {
@@ -253,6 +1265,57 @@ extern "C" MH_NodeId mh_graph_add_plugin(MH_PluginGraph* g, MH_Plugin* p,
     return (MH_NodeId)(g->nodes.size() - 1);
 }
 
+extern "C" MH_NodeId mh_graph_add_plugin_oversampled(MH_PluginGraph* g,
+                                                        MH_Plugin* p,
+                                                        int factor,
+                                                        char* err_buf,
+                                                        size_t err_buf_size)
+{
+    if (factor != 1 && factor != 2 && factor != 4)
+    {
+        setErrf(err_buf, err_buf_size,
+                "oversample factor must be 1, 2 or 4, got %d", factor);
+        return -1;
+    }
+    const MH_NodeId id = mh_graph_add_plugin(g, p, err_buf, err_buf_size);
+    if (id < 0 || factor == 1) return id;
+
+    Node& n = g->nodes[(size_t) id];
+    // The oversampling wrap has no sidechain path (up/downsampling a
+    // key signal would smear the detector timing it exists to carry),
+    // so an oversampled node does not expose the sidechain port.
+    if (n.sidechain_port >= 0)
+    {
+        n.num_input_ports -= 1;
+        n.sidechain_port      = -1;
+        n.sidechain_channels  = 0;
+        n.input_sources.resize((size_t) n.num_input_ports);
+    }
+    n.oversample_factor = factor;
+    n.os_kernel         = designOversampleKernel(factor);
+    n.os_taps           = (int) n.os_kernel.size();
+    n.os_up_hist_len    = (n.os_taps + factor - 1) / factor - 1;
+
+    const int in_ch  = n.input_channels;
+    const int out_ch = n.output_channels;
+    const int F      = g->max_block_size;
+    n.os_up_hist.assign((size_t) in_ch * n.os_up_hist_len, 0.0f);
+    n.os_up_work.assign((size_t) n.os_up_hist_len + F, 0.0f);
+    n.os_down_hist.assign((size_t) out_ch * (n.os_taps - 1), 0.0f);
+    n.os_down_work.assign((size_t)(n.os_taps - 1) + (size_t) factor * F, 0.0f);
+    n.os_in_buf.assign((size_t) in_ch * factor * F, 0.0f);
+    n.os_out_buf.assign((size_t) out_ch * factor * F, 0.0f);
+    n.os_in_ptrs.resize((size_t) in_ch);
+    for (int c = 0; c < in_ch; ++c)
+        n.os_in_ptrs[(size_t) c]
+            = n.os_in_buf.data() + (size_t) c * factor * F;
+    n.os_out_ptrs.resize((size_t) out_ch);
+    for (int c = 0; c < out_ch; ++c)
+        n.os_out_ptrs[(size_t) c]
+            = n.os_out_buf.data() + (size_t) c * factor * F;
+    return id;
+}
+
 extern "C" MH_NodeId mh_graph_add_pick_channel(MH_PluginGraph* g,
                                                   int in_channels,
                                                   int channel_index,
@@ -310,80 +1373,285 @@ extern "C" MH_NodeId mh_graph_add_merge_channels(MH_PluginGraph* g,
     return (MH_NodeId)(g->nodes.size() - 1);
 }
 
-extern "C" MH_NodeId mh_graph_add_midi_input(MH_PluginGraph* g,
-                                                char* err_buf, size_t err_buf_size)
+extern "C" MH_NodeId mh_graph_add_remap(MH_PluginGraph* g,
+                                           int in_channels,
+                                           const int* channel_map,
+                                           int out_channels,
+                                           char* err_buf, size_t err_buf_size)
 {
     if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
     if (g->compiled)  { setErr(err_buf, err_buf_size,
                                "graph already compiled"); return -1; }
+    if (in_channels <= 0)
+    {
+        setErr(err_buf, err_buf_size, "remap in_channels must be positive");
+        return -1;
+    }
+    if (out_channels <= 0)
+    {
+        setErr(err_buf, err_buf_size, "remap out_channels must be positive");
+        return -1;
+    }
+    if (channel_map == nullptr)
+    {
+        setErr(err_buf, err_buf_size, "remap channel_map is null");
+        return -1;
+    }
+    for (int i = 0; i < out_channels; ++i)
+    {
+        if (channel_map[i] < -1 || channel_map[i] >= in_channels)
+        {
+            setErrf(err_buf, err_buf_size,
+                    "remap channel_map[%d] = %d out of range [-1, %d)",
+                    i, channel_map[i], in_channels);
+            return -1;
+        }
+    }
     Node n;
-    n.kind            = MH_NODE_MIDI_INPUT;
-    n.input_channels  = 0;
-    n.num_input_ports = 0;
-    n.output_channels = 0;
-    n.produces_midi   = true;
+    n.kind            = MH_NODE_REMAP;
+    n.input_channels  = in_channels;
+    n.num_input_ports = 1;
+    n.output_channels = out_channels;
+    n.remap_map.assign(channel_map, channel_map + out_channels);
+    n.input_sources.resize(1);
     g->nodes.push_back(std::move(n));
     return (MH_NodeId)(g->nodes.size() - 1);
 }
 
-extern "C" MH_NodeId mh_graph_add_midi_output(MH_PluginGraph* g,
-                                                 char* err_buf, size_t err_buf_size)
+extern "C" MH_NodeId mh_graph_add_resample(MH_PluginGraph* g,
+                                              int channels,
+                                              double source_rate,
+                                              char* err_buf, size_t err_buf_size)
 {
     if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
     if (g->compiled)  { setErr(err_buf, err_buf_size,
                                "graph already compiled"); return -1; }
+    if (channels <= 0)
+    {
+        setErr(err_buf, err_buf_size, "resample channels must be positive");
+        return -1;
+    }
+    if (!(source_rate > 0.0))
+    {
+        setErr(err_buf, err_buf_size, "resample source_rate must be positive");
+        return -1;
+    }
     Node n;
-    n.kind                = MH_NODE_MIDI_OUTPUT;
-    n.input_channels      = 0;
-    n.num_input_ports     = 0;
-    n.output_channels     = 0;
-    n.accepts_midi        = true;
-    n.num_midi_input_ports = 1;
-    n.midi_srcs.assign(1, -1);
+    n.kind                 = MH_NODE_RESAMPLE;
+    n.input_channels       = 0;
+    n.num_input_ports      = 0;
+    n.output_channels      = channels;
+    n.resample_source_rate = source_rate;
+    n.resample_step        = source_rate / g->sample_rate;
+    // FIFO sized at add (max_block_size is fixed at graph create):
+    // four graph blocks of source audio plus interpolation slack,
+    // enough headroom that a caller topping it up once per block
+    // never underruns. Survives recompile, so primed audio isn't
+    // dropped by an edit cycle.
+    n.resample_capacity = (int) std::ceil(
+        4.0 * (double) g->max_block_size * std::max(1.0, n.resample_step)) + 8;
+    n.resample_fifo.assign(
+        (size_t) channels * (size_t) n.resample_capacity, 0.0f);
     g->nodes.push_back(std::move(n));
     return (MH_NodeId)(g->nodes.size() - 1);
 }
 
-extern "C" MH_NodeId mh_graph_add_input(MH_PluginGraph* g, int channels,
-                                           char* err_buf, size_t err_buf_size)
+extern "C" int mh_graph_resample_write(MH_PluginGraph* g, MH_NodeId node,
+                                          const float* const* frames,
+                                          int num_channels, int num_frames)
 {
-    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
-    if (g->compiled)  { setErr(err_buf, err_buf_size,
-                               "graph already compiled"); return -1; }
-    if (channels <= 0)
+    if (g == nullptr || frames == nullptr) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    auto& n = g->nodes[(size_t) node];
+    if (n.kind != MH_NODE_RESAMPLE) return 0;
+    if (num_channels != n.output_channels) return 0;
+    if (num_frames < 0) return 0;
+    const long long used = n.resample_write_pos
+                           - (long long) n.resample_read_pos;
+    if (used + num_frames > n.resample_capacity) return 0;  // would clobber unread audio
+    const int cap = n.resample_capacity;
+    for (int c = 0; c < n.output_channels; ++c)
     {
-        setErr(err_buf, err_buf_size, "input channels must be positive");
-        return -1;
+        const float* src  = frames[c];
+        float*       ring = n.resample_fifo.data() + (size_t) c * (size_t) cap;
+        for (int f = 0; f < num_frames; ++f)
+            ring[(size_t)((n.resample_write_pos + f) % cap)]
+                = src ? src[f] : 0.0f;
     }
-    Node n;
-    n.kind            = MH_NODE_INPUT;
-    n.input_channels  = 0;
-    n.num_input_ports = 0;
-    n.output_channels = channels;
-    n.io_index        = (int) g->input_nodes_.size();
-    g->nodes.push_back(std::move(n));
-    MH_NodeId id = (MH_NodeId)(g->nodes.size() - 1);
-    g->input_nodes_.push_back(id);
-    return id;
+    n.resample_write_pos += num_frames;
+    return 1;
 }
 
-extern "C" MH_NodeId mh_graph_add_output(MH_PluginGraph* g, int channels,
-                                            char* err_buf, size_t err_buf_size)
+extern "C" long long mh_graph_resample_frames_needed(MH_PluginGraph* g,
+                                                        MH_NodeId node,
+                                                        int nframes)
+{
+    if (g == nullptr) return -1;
+    if (!inRange(node, (int) g->nodes.size())) return -1;
+    const auto& n = g->nodes[(size_t) node];
+    if (n.kind != MH_NODE_RESAMPLE) return -1;
+    if (nframes <= 0) return 0;
+    // The last output sample of the block interpolates between source
+    // frames floor(pos) and floor(pos) + 1.
+    const long long last = (long long)(
+        n.resample_read_pos + (double)(nframes - 1) * n.resample_step) + 1;
+    const long long needed = last + 1 - n.resample_write_pos;
+    return needed > 0 ? needed : 0;
+}
+
+extern "C" MH_NodeId mh_graph_add_convolve(MH_PluginGraph* g, int channels,
+                                              const float* const* ir,
+                                              int ir_channels, int ir_frames,
+                                              char* err_buf, size_t err_buf_size)
 {
     if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
     if (g->compiled)  { setErr(err_buf, err_buf_size,
                                "graph already compiled"); return -1; }
     if (channels <= 0)
     {
-        setErr(err_buf, err_buf_size, "output channels must be positive");
+        setErr(err_buf, err_buf_size, "convolve channels must be positive");
+        return -1;
+    }
+    if (ir == nullptr || ir_frames <= 0)
+    {
+        setErr(err_buf, err_buf_size, "convolve needs a non-empty IR");
+        return -1;
+    }
+    if (ir_channels != 1 && ir_channels != channels)
+    {
+        setErrf(err_buf, err_buf_size,
+                "IR must have 1 channel or match the node (%d), got %d",
+                channels, ir_channels);
         return -1;
     }
     Node n;
-    n.kind            = MH_NODE_OUTPUT;
+    n.kind            = MH_NODE_CONVOLVE;
     n.input_channels  = channels;
     n.num_input_ports = 1;
-    n.output_channels = 0;
-    n.io_index        = (int) g->output_nodes_.size();
+    n.output_channels = channels;
+    n.input_sources.resize(1);
+    n.conv_part        = nextPow2(g->max_block_size);
+    n.conv_fft         = 2 * n.conv_part;
+    n.conv_parts       = (ir_frames + n.conv_part - 1) / n.conv_part;
+    n.conv_ir_channels = ir_channels;
+
+    // Bake the IR partition spectra: each partition is conv_part
+    // samples zero-padded to conv_fft and transformed once, here.
+    const size_t spec = (size_t) n.conv_fft;
+    n.conv_ir_re.assign((size_t) ir_channels * n.conv_parts * spec, 0.0f);
+    n.conv_ir_im.assign((size_t) ir_channels * n.conv_parts * spec, 0.0f);
+    for (int c = 0; c < ir_channels; ++c)
+    {
+        if (ir[c] == nullptr)
+        {
+            setErrf(err_buf, err_buf_size, "IR channel %d is null", c);
+            return -1;
+        }
+        for (int p = 0; p < n.conv_parts; ++p)
+        {
+            float* pre = n.conv_ir_re.data()
+                         + ((size_t) c * n.conv_parts + p) * spec;
+            float* pim = n.conv_ir_im.data()
+                         + ((size_t) c * n.conv_parts + p) * spec;
+            const int base = p * n.conv_part;
+            const int take = std::min(n.conv_part, ir_frames - base);
+            for (int i = 0; i < take; ++i)
+                pre[i] = ir[c][base + i];
+            fftInPlace(pre, pim, n.conv_fft, false);
+        }
+    }
+
+    n.conv_fdl_re.assign((size_t) channels * n.conv_parts * spec, 0.0f);
+    n.conv_fdl_im.assign((size_t) channels * n.conv_parts * spec, 0.0f);
+    n.conv_overlap.assign((size_t) channels * n.conv_part, 0.0f);
+    n.conv_in_buf.assign((size_t) channels * n.conv_part, 0.0f);
+    n.conv_out_ring.assign((size_t) channels * 2 * n.conv_part, 0.0f);
+    // Prime the output ring with one partition of zeros: that is the
+    // node's buffering latency (reported via the compile latency pass)
+    // and guarantees a pop never outruns the hop cadence.
+    n.conv_out_avail = n.conv_part;
+    n.conv_work_re.assign(spec, 0.0f);
+    n.conv_work_im.assign(spec, 0.0f);
+    n.conv_acc_re.assign(spec, 0.0f);
+    n.conv_acc_im.assign(spec, 0.0f);
+    g->nodes.push_back(std::move(n));
+    return (MH_NodeId)(g->nodes.size() - 1);
+}
+
+extern "C" MH_NodeId mh_graph_add_midi_input(MH_PluginGraph* g,
+                                                char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
+    if (g->compiled)  { setErr(err_buf, err_buf_size,
+                               "graph already compiled"); return -1; }
+    Node n;
+    n.kind            = MH_NODE_MIDI_INPUT;
+    n.input_channels  = 0;
+    n.num_input_ports = 0;
+    n.output_channels = 0;
+    n.produces_midi   = true;
+    g->nodes.push_back(std::move(n));
+    return (MH_NodeId)(g->nodes.size() - 1);
+}
+
+extern "C" MH_NodeId mh_graph_add_midi_output(MH_PluginGraph* g,
+                                                 char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
+    if (g->compiled)  { setErr(err_buf, err_buf_size,
+                               "graph already compiled"); return -1; }
+    Node n;
+    n.kind                = MH_NODE_MIDI_OUTPUT;
+    n.input_channels      = 0;
+    n.num_input_ports     = 0;
+    n.output_channels     = 0;
+    n.accepts_midi        = true;
+    n.num_midi_input_ports = 1;
+    n.midi_srcs.assign(1, -1);
+    g->nodes.push_back(std::move(n));
+    return (MH_NodeId)(g->nodes.size() - 1);
+}
+
+extern "C" MH_NodeId mh_graph_add_input(MH_PluginGraph* g, int channels,
+                                           char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
+    if (g->compiled)  { setErr(err_buf, err_buf_size,
+                               "graph already compiled"); return -1; }
+    if (channels <= 0)
+    {
+        setErr(err_buf, err_buf_size, "input channels must be positive");
+        return -1;
+    }
+    Node n;
+    n.kind            = MH_NODE_INPUT;
+    n.input_channels  = 0;
+    n.num_input_ports = 0;
+    n.output_channels = channels;
+    n.io_index        = (int) g->input_nodes_.size();
+    g->nodes.push_back(std::move(n));
+    MH_NodeId id = (MH_NodeId)(g->nodes.size() - 1);
+    g->input_nodes_.push_back(id);
+    return id;
+}
+
+extern "C" MH_NodeId mh_graph_add_output(MH_PluginGraph* g, int channels,
+                                            char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return -1; }
+    if (g->compiled)  { setErr(err_buf, err_buf_size,
+                               "graph already compiled"); return -1; }
+    if (channels <= 0)
+    {
+        setErr(err_buf, err_buf_size, "output channels must be positive");
+        return -1;
+    }
+    Node n;
+    n.kind            = MH_NODE_OUTPUT;
+    n.input_channels  = channels;
+    n.num_input_ports = 1;
+    n.output_channels = 0;
+    n.io_index        = (int) g->output_nodes_.size();
     n.input_sources.resize(1);
     g->nodes.push_back(std::move(n));
     MH_NodeId id = (MH_NodeId)(g->nodes.size() - 1);
@@ -436,6 +1704,7 @@ extern "C" MH_NodeId mh_graph_add_midi_processor(
     n.num_midi_input_ports  = 1;
     n.midi_srcs.assign(1, -1);
     n.midi_processor_params = params;
+    rebuildMidiProcessorTables(n);
     g->nodes.push_back(std::move(n));
     return (MH_NodeId)(g->nodes.size() - 1);
 }
@@ -448,6 +1717,18 @@ extern "C" int mh_graph_set_midi_processor_params(
     auto& n = g->nodes[(size_t) node];
     if (n.kind != MH_NODE_MIDI_PROCESSOR) return 0;
     n.midi_processor_params = params;
+    rebuildMidiProcessorTables(n);
+    // Keep the compile-time specialization coherent with the new op:
+    // re-select this node's monomorphized handler, and the fused
+    // two-stage handler of whichever node applies this stage inline
+    // (this node itself, or the consumer that absorbed it).
+    if (g->compiled)
+    {
+        n.midi_op_fn = selectMidiOpFn(params.op);
+        refreshMidiPairFn(g, node);
+        if (n.midi_fused_consumer >= 0)
+            refreshMidiPairFn(g, n.midi_fused_consumer);
+    }
     return 1;
 }
 
@@ -527,11 +1808,22 @@ extern "C" int mh_graph_connect(MH_PluginGraph* g,
                 dn.num_input_ports);
         return 0;
     }
-    if (dn.input_channels != sn.output_channels)
+    // Per-port width: a plugin's sidechain port carries the sidechain
+    // bus channel count, which need not match the main input.
+    const int want_ch = (dst_port == dn.sidechain_port)
+        ? dn.sidechain_channels : dn.input_channels;
+    if (want_ch != sn.output_channels)
     {
         setErrf(err_buf, err_buf_size,
                 "channel mismatch on edge: src %d ch, dst %d ch",
-                sn.output_channels, dn.input_channels);
+                sn.output_channels, want_ch);
+        return 0;
+    }
+
+    if (findEdge(g->feedback_edges, dst, dst_port) >= 0)
+    {
+        setErr(err_buf, err_buf_size,
+               "port already driven by a feedback edge");
         return 0;
     }
 
@@ -543,6 +1835,174 @@ extern "C" int mh_graph_connect(MH_PluginGraph* g,
     return 1;
 }
 
+extern "C" int mh_graph_connect_feedback(MH_PluginGraph* g,
+                                            MH_NodeId src, int src_port,
+                                            MH_NodeId dst, int dst_port,
+                                            char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return 0; }
+    if (g->compiled)  { setErr(err_buf, err_buf_size,
+                               "graph already compiled"); return 0; }
+    const int N = (int) g->nodes.size();
+    if (!inRange(src, N) || !inRange(dst, N))
+    {
+        setErr(err_buf, err_buf_size, "node id out of range");
+        return 0;
+    }
+    if (src_port != 0)
+    {
+        setErr(err_buf, err_buf_size,
+               "src_port must be 0 (only one output port in v1)");
+        return 0;
+    }
+    // No self-edge ban: a node feeding its own input through the
+    // one-block delay is the canonical echo patch.
+    auto& dn = g->nodes[(size_t) dst];
+    auto& sn = g->nodes[(size_t) src];
+    if (sn.kind == MH_NODE_INPUT || sn.kind == MH_NODE_OUTPUT)
+    {
+        // Inputs carry caller data (no delay to close) and outputs
+        // render into the caller's buffers, not the pool the holding
+        // buffer is captured from.
+        setErr(err_buf, err_buf_size,
+               "feedback source must be a processing node "
+               "(not an input or output node)");
+        return 0;
+    }
+    if (dn.kind == MH_NODE_INPUT)
+    {
+        setErr(err_buf, err_buf_size,
+               "cannot connect into an input node");
+        return 0;
+    }
+    auto is_midi_kind = [](MH_NodeKind k) {
+        return k == MH_NODE_MIDI_INPUT
+            || k == MH_NODE_MIDI_OUTPUT
+            || k == MH_NODE_MIDI_PROCESSOR
+            || k == MH_NODE_MIDI_MERGE;
+    };
+    if (is_midi_kind(sn.kind) || is_midi_kind(dn.kind))
+    {
+        setErr(err_buf, err_buf_size,
+               "MIDI nodes cannot participate in audio edges; "
+               "use mh_graph_connect_midi");
+        return 0;
+    }
+    if (dst_port < 0 || dst_port >= dn.num_input_ports)
+    {
+        setErrf(err_buf, err_buf_size,
+                "dst_port %d out of range [0, %d)", dst_port,
+                dn.num_input_ports);
+        return 0;
+    }
+    const int want_ch = (dst_port == dn.sidechain_port)
+        ? dn.sidechain_channels : dn.input_channels;
+    if (want_ch != sn.output_channels)
+    {
+        setErrf(err_buf, err_buf_size,
+                "channel mismatch on edge: src %d ch, dst %d ch",
+                sn.output_channels, want_ch);
+        return 0;
+    }
+    if (findEdge(g->edges, dst, dst_port) >= 0)
+    {
+        setErr(err_buf, err_buf_size,
+               "port already driven by a forward edge");
+        return 0;
+    }
+
+    // Overwrite any existing feedback edge to (dst, dst_port).
+    int existing = findEdge(g->feedback_edges, dst, dst_port);
+    Edge e{ src, src_port, dst, dst_port, sn.output_channels };
+    if (existing >= 0) g->feedback_edges[(size_t) existing] = e;
+    else               g->feedback_edges.push_back(e);
+    return 1;
+}
+
+extern "C" int mh_graph_connect_modulation(MH_PluginGraph* g,
+                                              MH_NodeId src, int src_channel,
+                                              MH_NodeId dst, int param_index,
+                                              float base, float depth,
+                                              int curve,
+                                              char* err_buf,
+                                              size_t err_buf_size)
+{
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return 0; }
+    if (g->compiled)  { setErr(err_buf, err_buf_size,
+                               "graph already compiled"); return 0; }
+    const int N = (int) g->nodes.size();
+    if (!inRange(src, N) || !inRange(dst, N))
+    {
+        setErr(err_buf, err_buf_size, "node id out of range");
+        return 0;
+    }
+    auto& dn = g->nodes[(size_t) dst];
+    auto& sn = g->nodes[(size_t) src];
+    if (sn.kind == MH_NODE_OUTPUT || sn.output_channels <= 0)
+    {
+        setErr(err_buf, err_buf_size,
+               "modulation source must produce audio (an input node "
+               "or a processing node)");
+        return 0;
+    }
+    if (dn.kind != MH_NODE_PLUGIN)
+    {
+        setErr(err_buf, err_buf_size,
+               "modulation target must be a plugin node");
+        return 0;
+    }
+    if (src == dst)
+    {
+        // Same-block self-modulation would need the node's output
+        // before the node runs; route through a feedback edge into a
+        // mix tap instead.
+        setErr(err_buf, err_buf_size, "self-edges not allowed");
+        return 0;
+    }
+    if (src_channel < 0 || src_channel >= sn.output_channels)
+    {
+        setErrf(err_buf, err_buf_size,
+                "src_channel %d out of range [0, %d)", src_channel,
+                sn.output_channels);
+        return 0;
+    }
+    const int num_params = mh_get_num_params(dn.plugin);
+    if (param_index < 0 || param_index >= num_params)
+    {
+        setErrf(err_buf, err_buf_size,
+                "param_index %d out of range [0, %d)", param_index,
+                num_params);
+        return 0;
+    }
+    if (curve < MH_MOD_CURVE_LINEAR || curve > MH_MOD_CURVE_SMOOTHSTEP)
+    {
+        setErr(err_buf, err_buf_size, "unknown modulation curve");
+        return 0;
+    }
+
+    // One edge per (dst, param): overwrite.
+    MH_PluginGraph::ModEdge e{ src, src_channel, dst, param_index,
+                               base, depth, curve };
+    for (auto& m : g->mod_edges)
+        if (m.dst_node == dst && m.param_index == param_index)
+        {
+            m = e;
+            return 1;
+        }
+    g->mod_edges.push_back(e);
+    return 1;
+}
+
+extern "C" int mh_graph_set_modulation_interval(MH_PluginGraph* g,
+                                                   int frames)
+{
+    if (g == nullptr) return 0;
+    if (g->compiled) return 0;
+    if (frames < 0) return 0;
+    g->mod_interval = frames;
+    return 1;
+}
+
 extern "C" int mh_graph_set_mix_gain(MH_PluginGraph* g, MH_NodeId mix_node,
                                         int input_index, float gain)
 {
@@ -634,129 +2094,489 @@ extern "C" int mh_graph_connect_midi(MH_PluginGraph* g,
     return mh_graph_connect_midi_port(g, src, dst, 0, err_buf, err_buf_size);
 }
 
-extern "C" int mh_graph_compile(MH_PluginGraph* g,
-                                   char* err_buf, size_t err_buf_size)
+// Shared by mh_graph_compile for both the first compile and the
+// incremental recompile after mh_graph_begin_edit. With reuse set,
+// pool slots whose byte size is unchanged are zeroed in place, the
+// per-node derived routing state left over from the previous compile
+// is reset before being rebuilt, and the worker threads are kept
+// parked instead of being joined and respawned. Validation (steps 1-2)
+// runs before any mutation, so a failed recompile leaves the previous
+// pool and workers intact and the graph simply uncompiled.
+// FNV-1a over the graph's shape: node kinds, port and channel counts,
+// and both edge lists. Equal hashes mean (for schedule purposes) the
+// same topology, so a schedule exported from one graph is a valid
+// schedule for the other.
+static uint64_t graphShapeHash(const MH_PluginGraph* g)
 {
-    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return 0; }
-    if (g->compiled)  { setErr(err_buf, err_buf_size,
-                               "already compiled"); return 0; }
-    if (g->output_nodes_.empty())
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](uint64_t v)
     {
-        setErr(err_buf, err_buf_size, "graph has no output nodes");
-        return 0;
-    }
-
-    const int N = (int) g->nodes.size();
-
-    // 1. Validate every required input port is connected.
-    //    Mix / output: every port required.
-    //    Plugin: input ports tolerate being unwired and are fed
-    //    silence at render time. Instruments often expose a stereo
-    //    audio input bus (JUCE convention) even though they're
-    //    MIDI-driven; requiring users to wire silence in by hand
-    //    is hostile UX.
-    for (int i = 0; i < N; ++i)
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+    mix((uint64_t) g->nodes.size());
+    for (const auto& n : g->nodes)
     {
-        const auto& n = g->nodes[(size_t) i];
-        if (n.kind == MH_NODE_PLUGIN) continue;
-        for (int port = 0; port < n.num_input_ports; ++port)
-        {
-            if (findEdge(g->edges, i, port) < 0)
-            {
-                setErrf(err_buf, err_buf_size,
-                        "node %d input port %d is unconnected",
-                        i, port);
-                return 0;
-            }
-        }
-        // MIDI sinks must have their required input ports connected.
-        // MIDI_OUTPUT and MIDI_PROCESSOR: port 0 required.
-        // MIDI_MERGE: every port 0..num_midi_input_ports-1 required.
-        // Plugins with accepts_midi: optional (legacy
-        // set_node_midi staging covers them when unconnected).
-        if (n.kind == MH_NODE_MIDI_OUTPUT
-            || n.kind == MH_NODE_MIDI_PROCESSOR
-            || n.kind == MH_NODE_MIDI_MERGE)
-        {
-            for (int p = 0; p < n.num_midi_input_ports; ++p)
-            {
-                bool found = false;
-                for (const auto& me : g->midi_edges)
-                    if (me.dst_node == i && me.dst_port == p)
-                    { found = true; break; }
-                if (!found)
-                {
-                    setErrf(err_buf, err_buf_size,
-                            "node %d MIDI input port %d has no incoming MIDI edge",
-                            i, p);
-                    return 0;
-                }
-            }
-        }
+        mix((uint64_t) n.kind);
+        mix((uint64_t) n.num_input_ports);
+        mix((uint64_t) n.num_midi_input_ports);
+        mix((uint64_t) n.input_channels);
+        mix((uint64_t) n.sidechain_channels);
+        mix((uint64_t) n.output_channels);
     }
-
-    // 2. Kahn topological sort. Indegree counts both audio and MIDI
-    //    incoming edges so MIDI dependencies are respected.
-    std::vector<int> indegree((size_t) N, 0);
-    std::vector<std::vector<MH_NodeId>> succ((size_t) N);
+    mix((uint64_t) g->edges.size());
     for (const auto& e : g->edges)
     {
-        indegree[(size_t) e.dst_node]++;
-        succ[(size_t) e.src_node].push_back(e.dst_node);
+        mix((uint64_t) e.src_node);
+        mix((uint64_t) e.src_port);
+        mix((uint64_t) e.dst_node);
+        mix((uint64_t) e.dst_port);
     }
+    mix((uint64_t) g->midi_edges.size());
     for (const auto& me : g->midi_edges)
     {
-        indegree[(size_t) me.dst_node]++;
-        succ[(size_t) me.src_node].push_back(me.dst_node);
+        mix((uint64_t) me.src_node);
+        mix((uint64_t) me.dst_node);
+        mix((uint64_t) me.dst_port);
     }
-    std::vector<MH_NodeId> order;
-    order.reserve((size_t) N);
-    std::vector<MH_NodeId> ready;
-    for (int i = 0; i < N; ++i)
-        if (indegree[(size_t) i] == 0) ready.push_back(i);
-    while (!ready.empty())
+    mix((uint64_t) g->feedback_edges.size());
+    for (const auto& e : g->feedback_edges)
     {
-        MH_NodeId u = ready.back();
-        ready.pop_back();
-        order.push_back(u);
-        for (auto v : succ[(size_t) u])
-            if (--indegree[(size_t) v] == 0) ready.push_back(v);
+        mix((uint64_t) e.src_node);
+        mix((uint64_t) e.dst_node);
+        mix((uint64_t) e.dst_port);
     }
-    if ((int) order.size() != N)
+    mix((uint64_t) g->mod_edges.size());
+    for (const auto& me : g->mod_edges)
     {
-        setErr(err_buf, err_buf_size, "graph contains a cycle");
-        return 0;
+        mix((uint64_t) me.src_node);
+        mix((uint64_t) me.dst_node);
+        mix((uint64_t) me.param_index);
     }
+    return h;
+}
 
-    // 3. Allocate pool buffers for every non-input, non-output node.
-    //    Input nodes alias caller buffers; output nodes write into
-    //    caller buffers. We index pool entries on the node id directly
-    //    for simplicity (some entries unused -- not a hot path).
-    g->silence_buf.assign((size_t) g->max_block_size, 0.0f);
-    g->pool_storage.assign((size_t) N, {});
-    g->pool_ptrs.assign((size_t) N, {});
-    for (int i = 0; i < N; ++i)
+// Plan blob layout (little-endian, host byte order -- plans are a
+// same-machine artifact): u32 magic, u32 version, u32 node count,
+// u64 shape hash, then node_count i32 schedule entries.
+constexpr uint32_t kPlanMagic   = 0x4D484750u;  // "MHGP"
+constexpr uint32_t kPlanVersion = 1u;
+constexpr size_t   kPlanHeader  = 4 + 4 + 4 + 8;
+
+// Try to adopt a schedule from a blob staged by mh_graph_set_plan.
+// Fills `order` and returns true only when the plan matches the
+// current shape and holds a complete node permutation; any mismatch
+// leaves `order` empty and the caller derives the schedule in full.
+static bool adoptPlan(const MH_PluginGraph* g, std::vector<MH_NodeId>& order)
+{
+    const auto& blob = g->plan_blob;
+    const size_t N = g->nodes.size();
+    if (blob.size() != kPlanHeader + N * 4)
+        return false;
+
+    uint32_t magic, version, count;
+    uint64_t hash;
+    std::memcpy(&magic,   blob.data() + 0,  4);
+    std::memcpy(&version, blob.data() + 4,  4);
+    std::memcpy(&count,   blob.data() + 8,  4);
+    std::memcpy(&hash,    blob.data() + 12, 8);
+    if (magic != kPlanMagic || version != kPlanVersion)
+        return false;
+    if ((size_t) count != N || hash != graphShapeHash(g))
+        return false;
+
+    std::vector<MH_NodeId> o((size_t) N);
+    std::vector<char> seen((size_t) N, 0);
+    for (size_t i = 0; i < N; ++i)
     {
-        const auto& n = g->nodes[(size_t) i];
-        if (n.kind == MH_NODE_PLUGIN
-            || n.kind == MH_NODE_MIX
-            || n.kind == MH_NODE_PICK_CHANNEL
-            || n.kind == MH_NODE_MERGE_CHANNELS)
-        {
-            const int ch = n.output_channels;
-            const int F  = g->max_block_size;
-            g->pool_storage[(size_t) i].assign(
-                (size_t) ch * (size_t) F, 0.0f);
-            g->pool_ptrs[(size_t) i].resize((size_t) ch);
-            for (int c = 0; c < ch; ++c)
-                g->pool_ptrs[(size_t) i][(size_t) c]
-                    = g->pool_storage[(size_t) i].data() + (size_t) c * F;
-        }
+        int32_t id;
+        std::memcpy(&id, blob.data() + kPlanHeader + i * 4, 4);
+        if (id < 0 || (size_t) id >= N || seen[(size_t) id])
+            return false;
+        seen[(size_t) id] = 1;
+        o[i] = (MH_NodeId) id;
     }
+    order = std::move(o);
+    return true;
+}
 
-    // 4. Resolve every node's input_sources + output target.
-    for (int i = 0; i < N; ++i)
-    {
+// Attach every plugin node's playhead to the graph's shared transport
+// cell. Idempotent; runs from mh_graph_set_transport and from compile,
+// so plugin nodes added during an edit cycle join the broadcast.
+static void attachGraphTransport(MH_PluginGraph* g)
+{
+    if (g->shared_transport == nullptr) return;
+    for (auto& n : g->nodes)
+        if (n.plugin != nullptr)
+            mh_set_transport_shared(n.plugin, g->shared_transport);
+}
+
+// Advance the graph transport by one rendered block: bump the sample
+// position (wrapping inside the loop range), re-derive the beat
+// position from bpm and the graph sample rate, and publish with a
+// single seqlock write. Runs on the render thread, which is the only
+// transport writer once rendering starts.
+static void advanceGraphTransport(MH_PluginGraph* g, int nframes)
+{
+    if (!g->transport_active || g->shared_transport == nullptr) return;
+    MH_TransportInfo& t = g->transport_info;
+    if (!t.is_playing) return;
+    t.position_samples += (long long) nframes;
+    if (t.is_looping && t.loop_end_samples > t.loop_start_samples
+        && t.position_samples >= t.loop_end_samples)
+    {
+        const long long span = t.loop_end_samples - t.loop_start_samples;
+        t.position_samples = t.loop_start_samples
+            + (t.position_samples - t.loop_start_samples) % span;
+    }
+    if (g->sample_rate > 0.0)
+        t.position_beats = (double) t.position_samples / g->sample_rate
+                           * (t.bpm / 60.0);
+    mh_shared_transport_write(g->shared_transport, &t);
+}
+
+// Re-order every level by descending remaining critical-path cost:
+// remaining(u) = cost(u) + max over successors of remaining(v), swept
+// over the schedule in reverse topological order. A level's claim
+// cursor then hands out the longest remaining chain first, so the
+// straggler starts while the other workers chew through the cheap
+// leaves instead of after them. Not render-safe: callers run it at
+// compile or between blocks.
+static void sortLevelsByRemainingCost(MH_PluginGraph* g,
+                                      const long long* node_cost)
+{
+    std::vector<long long> remaining(g->cp_succ.size(), 0);
+    for (auto it = g->schedule.rbegin(); it != g->schedule.rend(); ++it)
+    {
+        const MH_NodeId u = *it;
+        long long down = 0;
+        for (MH_NodeId v : g->cp_succ[(size_t) u])
+            if (remaining[(size_t) v] > down) down = remaining[(size_t) v];
+        remaining[(size_t) u] = node_cost[(size_t) u] + down;
+    }
+    for (auto& level : g->levels)
+        std::stable_sort(level.begin(), level.end(),
+                         [&](MH_NodeId a, MH_NodeId b) {
+                             return remaining[(size_t) a]
+                                  > remaining[(size_t) b];
+                         });
+}
+
+static int compileGraph(MH_PluginGraph* g, bool reuse,
+                        char* err_buf, size_t err_buf_size)
+{
+    if (g->output_nodes_.empty())
+    {
+        setErr(err_buf, err_buf_size, "graph has no output nodes");
+        return 0;
+    }
+
+    const int N = (int) g->nodes.size();
+
+    // Successor lists, used by the topological sort (step 2) and the
+    // level grouping (step 7).
+    std::vector<std::vector<MH_NodeId>> succ((size_t) N);
+    for (const auto& e : g->edges)
+        succ[(size_t) e.src_node].push_back(e.dst_node);
+    for (const auto& me : g->midi_edges)
+        succ[(size_t) me.src_node].push_back(me.dst_node);
+    // Modulation edges are ordering edges too: the target samples the
+    // source's current-block output, so the source must render first.
+    for (const auto& me : g->mod_edges)
+        succ[(size_t) me.src_node].push_back(me.dst_node);
+
+    // Plan fast path: a schedule snapshot staged via mh_graph_set_plan
+    // whose shape hash matches this graph replaces steps 1-2 outright
+    // (the exporting graph already passed both; an equal shape passes
+    // them too). A stale or foreign plan falls through to the full
+    // derivation below.
+    std::vector<MH_NodeId> order;
+    if (! adoptPlan(g, order))
+    {
+        // 1. Validate every required input port is connected.
+        //    Mix / output: every port required.
+        //    Plugin: input ports tolerate being unwired and are fed
+        //    silence at render time. Instruments often expose a stereo
+        //    audio input bus (JUCE convention) even though they're
+        //    MIDI-driven; requiring users to wire silence in by hand
+        //    is hostile UX.
+        for (int i = 0; i < N; ++i)
+        {
+            const auto& n = g->nodes[(size_t) i];
+            if (n.kind == MH_NODE_PLUGIN) continue;
+            for (int port = 0; port < n.num_input_ports; ++port)
+            {
+                // A feedback edge satisfies the port like a forward
+                // one -- it just reads the previous block.
+                if (findEdge(g->edges, i, port) < 0
+                    && findEdge(g->feedback_edges, i, port) < 0)
+                {
+                    setErrf(err_buf, err_buf_size,
+                            "node %d input port %d is unconnected",
+                            i, port);
+                    return 0;
+                }
+            }
+            // MIDI sinks must have their required input ports connected.
+            // MIDI_OUTPUT and MIDI_PROCESSOR: port 0 required.
+            // MIDI_MERGE: every port 0..num_midi_input_ports-1 required.
+            // Plugins with accepts_midi: optional (legacy
+            // set_node_midi staging covers them when unconnected).
+            if (n.kind == MH_NODE_MIDI_OUTPUT
+                || n.kind == MH_NODE_MIDI_PROCESSOR
+                || n.kind == MH_NODE_MIDI_MERGE)
+            {
+                for (int p = 0; p < n.num_midi_input_ports; ++p)
+                {
+                    bool found = false;
+                    for (const auto& me : g->midi_edges)
+                        if (me.dst_node == i && me.dst_port == p)
+                        { found = true; break; }
+                    if (!found)
+                    {
+                        setErrf(err_buf, err_buf_size,
+                                "node %d MIDI input port %d has no incoming MIDI edge",
+                                i, p);
+                        return 0;
+                    }
+                }
+            }
+        }
+
+        // 2. Kahn topological sort. Indegree counts both audio and MIDI
+        //    incoming edges so MIDI dependencies are respected.
+        std::vector<int> indegree((size_t) N, 0);
+        for (const auto& e : g->edges)
+            indegree[(size_t) e.dst_node]++;
+        for (const auto& me : g->midi_edges)
+            indegree[(size_t) me.dst_node]++;
+        for (const auto& me : g->mod_edges)
+            indegree[(size_t) me.dst_node]++;
+        order.reserve((size_t) N);
+        std::vector<MH_NodeId> ready;
+        for (int i = 0; i < N; ++i)
+            if (indegree[(size_t) i] == 0) ready.push_back(i);
+        while (!ready.empty())
+        {
+            MH_NodeId u = ready.back();
+            ready.pop_back();
+            order.push_back(u);
+            for (auto v : succ[(size_t) u])
+                if (--indegree[(size_t) v] == 0) ready.push_back(v);
+        }
+        if ((int) order.size() != N)
+        {
+            setErr(err_buf, err_buf_size, "graph contains a cycle");
+            return 0;
+        }
+    }
+
+    // Recompile: throw away derived routing state from the previous
+    // compile before the steps below rebuild it. input_sources and the
+    // out_* fields are fully reassigned in step 4, but the elision
+    // flags, cached MIDI routing and latency delay lines would
+    // otherwise leak stale entries.
+    if (reuse)
+    {
+        g->delay_lines.clear();
+        for (auto& n : g->nodes)
+        {
+            n.output_elided          = false;
+            n.pick_aliased           = false;
+            n.remap_aliased          = false;
+            n.bypass_aliased         = false;  // pool_ptrs rebuilt below
+            n.has_outgoing_midi_edge = false;
+            n.tail_remaining         = -1;
+            std::fill(n.midi_srcs.begin(), n.midi_srcs.end(), -1);
+        }
+    }
+
+    // 3. Plan the buffer-pool arena: one 64-byte-aligned allocation
+    //    holding every non-input, non-output node's pool buffer,
+    //    carved in schedule order so adjacent nodes in the render walk
+    //    touch adjacent cache lines (scattered per-node vectors
+    //    thrashed L2 on big graphs). Channels are padded to a 64-byte
+    //    stride, so every channel pointer is SIMD-alignable. Pool
+    //    entries stay indexed by node id via pool_offsets. On
+    //    recompile the allocation is kept when the total size is
+    //    unchanged; either way the arena is zero-filled.
+    g->silence_buf.assign((size_t) g->max_block_size, 0.0f);
+    {
+        const size_t stride
+            = ((size_t) g->max_block_size + 15) & ~(size_t) 15;  // floats
+        std::vector<size_t> offsets((size_t) N, SIZE_MAX);
+        size_t total = 0;
+        for (MH_NodeId id : order)
+        {
+            const auto& n = g->nodes[(size_t) id];
+            if (n.kind == MH_NODE_PLUGIN
+                || n.kind == MH_NODE_MIX
+                || n.kind == MH_NODE_PICK_CHANNEL
+                || n.kind == MH_NODE_MERGE_CHANNELS
+                || n.kind == MH_NODE_RESAMPLE
+                || n.kind == MH_NODE_CONVOLVE
+                || n.kind == MH_NODE_REMAP)
+            {
+                offsets[(size_t) id] = total;
+                total += (size_t) n.output_channels * stride;
+            }
+        }
+        if (g->pool_arena == nullptr || g->pool_arena_floats != total)
+        {
+            unlockArena(g->pool_arena.get(), &g->pool_locked_bytes);
+            // std::aligned_alloc wants the size in whole alignment
+            // units. With huge pages requested, over-align to 2 MiB so
+            // the madvise below covers the exact allocation.
+            size_t align = 64;
+#if defined(__linux__)
+            const size_t kHugePage = 2u * 1024u * 1024u;
+            if (g->pool_huge_pages && total * sizeof(float) >= kHugePage)
+                align = kHugePage;
+#endif
+            size_t bytes = total * sizeof(float);
+            bytes = (bytes + align - 1) / align * align;
+            float* p = (bytes > 0)
+                ? (float*) std::aligned_alloc(align, bytes)
+                : nullptr;
+            if (bytes > 0 && p == nullptr)
+            {
+                setErr(err_buf, err_buf_size,
+                       "buffer-pool arena allocation failed");
+                return 0;
+            }
+#if defined(__linux__)
+            if (p != nullptr && align == kHugePage)
+                madvise(p, bytes, MADV_HUGEPAGE);  // best-effort hint
+#endif
+            g->pool_arena.reset(p);
+            g->pool_arena_floats = total;
+        }
+        // Pin (or unpin) the arena per mh_graph_set_lock_memory; the
+        // realloc branch above already released any stale lock, so a
+        // kept arena with a live lock is left alone.
+        if (g->pool_lock_memory && g->pool_locked_bytes == 0)
+            lockArena(g->pool_arena.get(), total * sizeof(float),
+                      &g->pool_locked_bytes);
+        else if (!g->pool_lock_memory)
+            unlockArena(g->pool_arena.get(), &g->pool_locked_bytes);
+        if (total > 0)
+            std::memset(g->pool_arena.get(), 0, total * sizeof(float));
+        g->pool_offsets     = std::move(offsets);
+        g->pool_chan_stride = stride;
+        g->pool_ptrs.assign((size_t) N, {});
+        for (int i = 0; i < N; ++i)
+        {
+            if (g->pool_offsets[(size_t) i] == SIZE_MAX) continue;
+            const int ch = g->nodes[(size_t) i].output_channels;
+            g->pool_ptrs[(size_t) i].resize((size_t) ch);
+            for (int c = 0; c < ch; ++c)
+                g->pool_ptrs[(size_t) i][(size_t) c]
+                    = g->pool_arena.get() + g->pool_offsets[(size_t) i]
+                      + (size_t) c * stride;
+        }
+    }
+
+    // 3.5 Double-precision shadow pool (mh_graph_set_double_precision):
+    //     mirror the arena above at the same channel stride, but carve
+    //     entries only for double-native plugin nodes -- a plugin that
+    //     reports mh_supports_double and is not inside the (float32)
+    //     oversampling wrapper. Everything else renders float and
+    //     never touches this arena. Also sized here: the per-node
+    //     input-widening scratch and the float staging render_block_double
+    //     narrows the caller's inputs into.
+    if (g->double_mode)
+    {
+        const size_t stride = g->pool_chan_stride;
+        std::vector<size_t> offsets((size_t) N, SIZE_MAX);
+        size_t total = 0;
+        for (MH_NodeId id : order)
+        {
+            auto& n = g->nodes[(size_t) id];
+            n.double_native = n.kind == MH_NODE_PLUGIN
+                && n.plugin != nullptr
+                && n.oversample_factor == 1
+                && mh_supports_double(n.plugin);
+            if (!n.double_native) continue;
+            offsets[(size_t) id] = total;
+            total += (size_t) n.output_channels * stride;
+            n.dbl_in_scratch.assign(
+                (size_t) n.input_channels * (size_t) g->max_block_size, 0.0);
+        }
+        if (g->dbl_arena == nullptr || g->dbl_arena_doubles != total)
+        {
+            unlockArena(g->dbl_arena.get(), &g->dbl_locked_bytes);
+            size_t bytes = total * sizeof(double);
+            bytes = (bytes + 63) / 64 * 64;
+            double* p = (bytes > 0)
+                ? (double*) std::aligned_alloc(64, bytes)
+                : nullptr;
+            if (bytes > 0 && p == nullptr)
+            {
+                setErr(err_buf, err_buf_size,
+                       "double-pool arena allocation failed");
+                return 0;
+            }
+            g->dbl_arena.reset(p);
+            g->dbl_arena_doubles = total;
+        }
+        if (g->pool_lock_memory && g->dbl_locked_bytes == 0)
+            lockArena(g->dbl_arena.get(), total * sizeof(double),
+                      &g->dbl_locked_bytes);
+        else if (!g->pool_lock_memory)
+            unlockArena(g->dbl_arena.get(), &g->dbl_locked_bytes);
+        if (total > 0)
+            std::memset(g->dbl_arena.get(), 0, total * sizeof(double));
+        g->dbl_offsets = std::move(offsets);
+        g->dbl_ptrs.assign((size_t) N, {});
+        for (int i = 0; i < N; ++i)
+        {
+            if (g->dbl_offsets[(size_t) i] == SIZE_MAX) continue;
+            const int ch = g->nodes[(size_t) i].output_channels;
+            g->dbl_ptrs[(size_t) i].resize((size_t) ch);
+            for (int c = 0; c < ch; ++c)
+                g->dbl_ptrs[(size_t) i][(size_t) c]
+                    = g->dbl_arena.get() + g->dbl_offsets[(size_t) i]
+                      + (size_t) c * stride;
+        }
+        g->dbl_in_stage.assign(g->input_nodes_.size(), {});
+        g->dbl_in_stage_ptrs.assign(g->input_nodes_.size(), {});
+        g->dbl_stage_table.assign(g->input_nodes_.size(), nullptr);
+        for (size_t i = 0; i < g->input_nodes_.size(); ++i)
+        {
+            const int ch
+                = g->nodes[(size_t) g->input_nodes_[i]].output_channels;
+            g->dbl_in_stage[i].assign(
+                (size_t) ch * (size_t) g->max_block_size, 0.0f);
+            g->dbl_in_stage_ptrs[i].resize((size_t) ch);
+            for (int c = 0; c < ch; ++c)
+                g->dbl_in_stage_ptrs[i][(size_t) c]
+                    = g->dbl_in_stage[i].data()
+                      + (size_t) c * (size_t) g->max_block_size;
+            g->dbl_stage_table[i] = g->dbl_in_stage_ptrs[i].data();
+        }
+    }
+    else
+    {
+        // Double precision switched off during an edit cycle: drop the
+        // shadow pool and the per-node flags from the prior compile.
+        unlockArena(g->dbl_arena.get(), &g->dbl_locked_bytes);
+        g->dbl_arena.reset();
+        g->dbl_arena_doubles = 0;
+        g->dbl_offsets.clear();
+        g->dbl_ptrs.clear();
+        g->dbl_in_stage.clear();
+        g->dbl_in_stage_ptrs.clear();
+        g->dbl_stage_table.clear();
+        for (auto& n : g->nodes)
+        {
+            n.double_native = false;
+            n.dbl_in_scratch.clear();
+        }
+    }
+
+    // 4. Resolve every node's input_sources + output target.
+    for (int i = 0; i < N; ++i)
+    {
         auto& n = g->nodes[(size_t) i];
         for (int port = 0; port < n.num_input_ports; ++port)
         {
@@ -799,7 +2619,10 @@ extern "C" int mh_graph_compile(MH_PluginGraph* g,
         else if (n.kind == MH_NODE_PLUGIN
                  || n.kind == MH_NODE_MIX
                  || n.kind == MH_NODE_PICK_CHANNEL
-                 || n.kind == MH_NODE_MERGE_CHANNELS)
+                 || n.kind == MH_NODE_MERGE_CHANNELS
+                 || n.kind == MH_NODE_RESAMPLE
+                 || n.kind == MH_NODE_CONVOLVE
+                 || n.kind == MH_NODE_REMAP)
         {
             n.out_to_caller    = false;
             n.out_caller_index = -1;
@@ -807,6 +2630,249 @@ extern "C" int mh_graph_compile(MH_PluginGraph* g,
         }
     }
 
+    // 4.1 Feedback edges (mh_graph_connect_feedback): point each
+    //     destination port at the edge's holding buffer and size the
+    //     buffers. Zeroed here, so the loop starts from one block of
+    //     silence after every compile.
+    g->fb_storage.assign(g->feedback_edges.size(), {});
+    g->fb_ptrs.assign(g->feedback_edges.size(), {});
+    for (size_t f = 0; f < g->feedback_edges.size(); ++f)
+    {
+        const auto& e = g->feedback_edges[f];
+        Node::InputRef ref{};
+        ref.from_caller    = false;
+        ref.is_silent      = false;
+        ref.caller_index   = -1;
+        ref.pool_index     = -1;
+        ref.feedback_index = (int) f;
+        g->nodes[(size_t) e.dst_node]
+            .input_sources[(size_t) e.dst_port] = ref;
+        g->fb_storage[f].assign(
+            (size_t) e.channels * (size_t) g->max_block_size, 0.0f);
+        g->fb_ptrs[f].resize((size_t) e.channels);
+        for (int c = 0; c < e.channels; ++c)
+            g->fb_ptrs[f][(size_t) c]
+                = g->fb_storage[f].data()
+                  + (size_t) c * (size_t) g->max_block_size;
+    }
+
+    // 4.2 Latency compensation. Walk the schedule in topological
+    //     order computing each node's cumulative output latency
+    //     (max over inputs, plus the node's own plugin latency) and
+    //     insert a ring-buffer delay line on every input port whose
+    //     path arrives early relative to its siblings. A second pass
+    //     delay-aligns all output nodes to the graph-wide maximum so
+    //     multi-output renders stay coherent.
+    {
+        auto ref_latency = [&](const Node::InputRef& ref,
+                               const std::vector<int>& lat) -> int {
+            if (ref.from_caller || ref.is_silent) return 0;
+            if (ref.feedback_index >= 0) return 0;  // deliberate delay
+            return lat[(size_t) ref.pool_index];
+        };
+        auto add_delay = [&](Node& n, int port, int delay) {
+            DelayLine dl;
+            dl.delay    = delay;
+            dl.channels = (port == n.sidechain_port)
+                ? n.sidechain_channels : n.input_channels;
+            dl.ring.assign((size_t) dl.channels * (size_t) delay, 0.0f);
+            dl.out_storage.assign(
+                (size_t) dl.channels * (size_t) g->max_block_size, 0.0f);
+            dl.out_ptrs.resize((size_t) dl.channels);
+            for (int c = 0; c < dl.channels; ++c)
+                dl.out_ptrs[(size_t) c]
+                    = dl.out_storage.data() + (size_t) c * g->max_block_size;
+            g->delay_lines.push_back(std::move(dl));
+            n.input_sources[(size_t) port].delay_index
+                = (int) g->delay_lines.size() - 1;
+        };
+
+        std::vector<int> out_latency((size_t) N, 0);
+        for (MH_NodeId id : order)
+        {
+            auto& n = g->nodes[(size_t) id];
+            int max_in = 0;
+            for (int port = 0; port < n.num_input_ports; ++port)
+            {
+                const int lat = ref_latency(n.input_sources[(size_t) port],
+                                            out_latency);
+                if (lat > max_in) max_in = lat;
+            }
+            for (int port = 0; port < n.num_input_ports; ++port)
+            {
+                const auto& ref = n.input_sources[(size_t) port];
+                if (ref.is_silent) continue;  // silence delays to silence
+                if (ref.feedback_index >= 0) continue;  // never compensated
+                const int lat = ref_latency(ref, out_latency);
+                if (lat < max_in) add_delay(n, port, max_in - lat);
+            }
+            int own = 0;
+            if (n.kind == MH_NODE_PLUGIN && n.plugin != nullptr)
+            {
+                own = mh_get_latency_samples(n.plugin);
+                if (n.oversample_factor > 1)
+                {
+                    // The plugin reports latency at the oversampled
+                    // rate; fold it back to graph-rate samples and add
+                    // the wrapper's own FIR group delay (an integer by
+                    // kernel construction).
+                    const int F = n.oversample_factor;
+                    own = (own + F / 2) / F + (n.os_taps - 1) / F;
+                }
+                // Dry-path delay for latency-matched bypass
+                // (mh_graph_set_node_bypass): sized here because the
+                // node's own latency is only known now.
+                n.bypass_delay = own;
+                const size_t need = (size_t) n.output_channels * own;
+                if (n.bypass_ring.size() != need)
+                    n.bypass_ring.assign(need, 0.0f);
+                else
+                    std::fill(n.bypass_ring.begin(), n.bypass_ring.end(),
+                              0.0f);
+                n.bypass_ring_pos = 0;
+            }
+            else if (n.kind == MH_NODE_CONVOLVE)
+                own = n.conv_part;  // partition buffering delay
+            out_latency[(size_t) id] = max_in + own;
+        }
+
+        int graph_max = 0;
+        for (MH_NodeId oid : g->output_nodes_)
+        {
+            const auto& on = g->nodes[(size_t) oid];
+            const int lat = ref_latency(on.input_sources[0], out_latency);
+            if (lat > graph_max) graph_max = lat;
+        }
+        for (MH_NodeId oid : g->output_nodes_)
+        {
+            auto& on = g->nodes[(size_t) oid];
+            const int lat = ref_latency(on.input_sources[0], out_latency);
+            if (lat < graph_max && !on.input_sources[0].is_silent)
+                add_delay(on, 0, graph_max - lat);
+        }
+        g->graph_latency_samples = graph_max;
+    }
+
+    // 4.5 Copy elision. Two patterns the pool copies for no reason:
+    //
+    //     a) plugin --(single fanout)--> output: the plugin can render
+    //        directly into the caller's output buffer, making the
+    //        output node a no-op. Restricted to plugin sources -- a
+    //        plugin's process call never reads its output buffer as
+    //        input, so aliasing the caller's buffer is safe even when
+    //        the caller overlaps its input and output arrays. Mix /
+    //        merge nodes read inputs while writing outputs and are
+    //        deliberately left copying.
+    //
+    //     b) pick_channel from a pool source: the single output
+    //        channel can alias the source's channel pointer outright
+    //        (pool buffers are written once per block, before any
+    //        consumer runs). Walked in topological order so chained
+    //        picks alias through.
+    //
+    //     c) remap from a pool source: same argument as (b), applied
+    //        per output channel. Every mapped channel aliases its
+    //        source channel; silence channels keep their own pool
+    //        storage and render only zero-fills those.
+    {
+        std::vector<int> audio_fanout((size_t) N, 0);
+        for (const auto& e : g->edges)
+            audio_fanout[(size_t) e.src_node]++;
+        // A feedback or modulation source must keep writing its pool
+        // entry -- the end-of-block capture and the per-block
+        // parameter sampling read it -- so it cannot render straight
+        // into the caller's buffer. (Input-node modulation sources
+        // read the caller's buffers; no pool entry to pin.)
+        std::vector<char> fb_src((size_t) N, 0);
+        for (const auto& e : g->feedback_edges)
+            fb_src[(size_t) e.src_node] = 1;
+        for (const auto& me : g->mod_edges)
+            if (g->nodes[(size_t) me.src_node].kind != MH_NODE_INPUT)
+                fb_src[(size_t) me.src_node] = 1;
+        // (a) is off in double mode: render_block_double passes no
+        //     caller float buffers for a plugin to render into, and
+        //     the output node performs the final copy (or narrow)
+        //     itself.
+        if (!g->double_mode)
+        for (MH_NodeId oid : g->output_nodes_)
+        {
+            auto& on  = g->nodes[(size_t) oid];
+            auto& ref = on.input_sources[0];
+            if (ref.from_caller || ref.is_silent) continue;
+            if (ref.feedback_index >= 0) continue;  // reads the holding buffer
+            if (ref.delay_index >= 0) continue;  // port runs a delay line
+            auto& src = g->nodes[(size_t) ref.pool_index];
+            if (src.kind == MH_NODE_PLUGIN
+                && audio_fanout[(size_t) ref.pool_index] == 1
+                && !fb_src[(size_t) ref.pool_index]
+                && !src.tapped   // tap reads the pool entry post-render
+                && !src.out_to_caller)
+            {
+                src.out_to_caller    = true;
+                src.out_caller_index = on.io_index;
+                on.output_elided     = true;
+            }
+        }
+        for (MH_NodeId id : order)
+        {
+            auto& n = g->nodes[(size_t) id];
+            if (n.kind != MH_NODE_PICK_CHANNEL) continue;
+            const auto& ref = n.input_sources[0];
+            if (ref.from_caller) continue;  // caller pointers vary per call
+            if (ref.feedback_index >= 0) continue;  // holding buffer, not pool
+            if (ref.delay_index >= 0) continue;  // port runs a delay line
+            const auto& src = g->nodes[(size_t) ref.pool_index];
+            if (src.out_to_caller) continue;  // source pool never written
+            g->pool_ptrs[(size_t) id][0]
+                = g->pool_ptrs[(size_t) ref.pool_index]
+                             [(size_t) n.pick_channel_index];
+            n.pick_aliased = true;
+        }
+        for (MH_NodeId id : order)
+        {
+            auto& n = g->nodes[(size_t) id];
+            if (n.kind != MH_NODE_REMAP) continue;
+            const auto& ref = n.input_sources[0];
+            if (ref.from_caller) continue;  // caller pointers vary per call
+            if (ref.feedback_index >= 0) continue;  // holding buffer, not pool
+            if (ref.delay_index >= 0) continue;  // port runs a delay line
+            const auto& src = g->nodes[(size_t) ref.pool_index];
+            if (src.out_to_caller) continue;  // source pool never written
+            for (int c = 0; c < n.output_channels; ++c)
+            {
+                const int s = n.remap_map[(size_t) c];
+                if (s >= 0)
+                    g->pool_ptrs[(size_t) id][(size_t) c]
+                        = g->pool_ptrs[(size_t) ref.pool_index][(size_t) s];
+            }
+            n.remap_aliased = true;
+        }
+
+        // 4.6 Bypass alias eligibility (mh_graph_set_node_bypass): a
+        //     bypassed plugin may pass through by repointing its pool
+        //     pointers at the upstream buffer only when it has an
+        //     input port of matching width, writes to its own pool
+        //     entry, and no pick-channel or remap consumer captured a
+        //     pointer into that entry above (the alias would leave it
+        //     stale).
+        {
+            std::vector<char> pick_target((size_t) N, 0);
+            for (const auto& pn : g->nodes)
+                if (pn.pick_aliased || pn.remap_aliased)
+                    pick_target[(size_t) pn.input_sources[0].pool_index] = 1;
+            for (int i = 0; i < N; ++i)
+            {
+                auto& n = g->nodes[(size_t) i];
+                n.bypass_alias_ok = n.kind == MH_NODE_PLUGIN
+                    && !n.out_to_caller
+                    && !n.tapped   // tap needs stride-uniform own storage
+                    && n.num_input_ports > 0
+                    && n.input_channels == n.output_channels
+                    && !pick_target[(size_t) i];
+            }
+        }
+    }
+
     // 5. Resolve MIDI routing: per dst node, cache the upstream src.
     //    Mark sources that have any outgoing MIDI edge so we know
     //    whether to allocate a midi_out capture buffer for them.
@@ -817,6 +2883,25 @@ extern "C" int mh_graph_compile(MH_PluginGraph* g,
         g->nodes[(size_t) me.src_node].has_outgoing_midi_edge = true;
     }
 
+    // 5.1 Resolve modulation routing: per target plugin, cache the
+    //     incoming edge indices and reserve the merge scratch for the
+    //     synthesized points (one per edge per sampling interval) so
+    //     the render path only grows it when staged automation joins
+    //     the merge.
+    for (auto& n : g->nodes) n.mod_indices.clear();
+    for (size_t m = 0; m < g->mod_edges.size(); ++m)
+        g->nodes[(size_t) g->mod_edges[m].dst_node]
+            .mod_indices.push_back((int) m);
+    {
+        const int step = g->mod_interval > 0 ? g->mod_interval
+                                             : g->max_block_size;
+        const size_t points
+            = (size_t) ((g->max_block_size + step - 1) / step);
+        for (auto& n : g->nodes)
+            if (!n.mod_indices.empty())
+                n.mod_auto_scratch.reserve(n.mod_indices.size() * points);
+    }
+
     // 6. Allocate per-node MIDI output buffers:
     //    - MIDI_INPUT  : always (caller stages into staged_midi_events;
     //                    midi_out_buf unused, but allocated for safety)
@@ -836,493 +2921,3610 @@ extern "C" int mh_graph_compile(MH_PluginGraph* g,
                   || n.kind == MH_NODE_MIDI_MERGE)
                  && n.has_outgoing_midi_edge) needs_buf = true;
         if (needs_buf)
+        {
             n.midi_out_buf.assign((size_t) kMidiBufCapacity, MH_MidiEvent{});
+            if (n.kind == MH_NODE_MIDI_MERGE)
+            {
+                // k-way merge scratch: one cursor pair per input port
+                // plus the tournament tree (see mergeSortedMidi).
+                const size_t k = (size_t) n.num_midi_input_ports;
+                n.merge_head.assign(k, nullptr);
+                n.merge_end.assign(k, nullptr);
+                n.merge_tree.assign(k, -1);
+            }
+        }
+        else if (reuse)
+            n.midi_out_buf.clear();  // edge overwritten away during the edit
+    }
+
+    // 6b. Specialize and fuse MIDI processors. Every processor gets
+    //     its monomorphized per-op handler, then chains are folded:
+    //     when a processor's source is another processor whose MIDI
+    //     output has no other consumer, the downstream node absorbs
+    //     the upstream stage and applies it inline during its own
+    //     pass, and the upstream node renders as a no-op. The schedule
+    //     is topological over MIDI edges, so a stage's own fusion
+    //     state is final before its consumer looks at it -- whole
+    //     stacks collapse onto their last node transitively.
+    {
+        std::vector<int> midi_outdeg(g->nodes.size(), 0);
+        for (const auto& n : g->nodes)
+            for (MH_NodeId src : n.midi_srcs)
+                if (src >= 0) ++midi_outdeg[(size_t) src];
+        for (auto& n : g->nodes)
+        {
+            n.midi_fused_stages.clear();
+            n.midi_fused_src      = -1;
+            n.midi_fused_consumer = -1;
+            n.midi_fused_away     = false;
+            n.midi_pair_fn        = nullptr;
+            // Drop drain views left over from a previous compile: they
+            // may alias buffers that step 6 just reallocated.
+            n.midi_view_evts      = nullptr;
+            n.midi_view_n         = 0;
+            n.midi_op_fn = n.kind == MH_NODE_MIDI_PROCESSOR
+                ? selectMidiOpFn(n.midi_processor_params.op) : nullptr;
+        }
+        for (MH_NodeId id : g->schedule)
+        {
+            auto& n = g->nodes[(size_t) id];
+            if (n.kind != MH_NODE_MIDI_PROCESSOR) continue;
+            const MH_NodeId src
+                = (!n.midi_srcs.empty()) ? n.midi_srcs[0] : -1;
+            if (src >= 0
+                && g->nodes[(size_t) src].kind == MH_NODE_MIDI_PROCESSOR
+                && midi_outdeg[(size_t) src] == 1)
+            {
+                auto& s = g->nodes[(size_t) src];
+                n.midi_fused_stages   = s.midi_fused_stages;
+                n.midi_fused_src      = s.midi_fused_src;
+                s.midi_fused_away     = true;
+                s.midi_fused_consumer = id;
+            }
+            else
+                n.midi_fused_src = src;
+            n.midi_fused_stages.push_back(id);
+            refreshMidiPairFn(g, id);
+        }
+    }
+
+    // 7. Group the schedule into topological levels for the worker
+    //    pool: level(v) = 1 + max(level(u)) over incoming edges. Built
+    //    unconditionally (it is cheap and makes the graph shape
+    //    introspectable); the pool itself is only spawned when the
+    //    caller asked for more than one thread.
+    {
+        std::vector<int> level((size_t) N, 0);
+        int max_level = 0;
+        for (MH_NodeId u : order)
+            for (MH_NodeId v : succ[(size_t) u])
+            {
+                if (level[(size_t) v] < level[(size_t) u] + 1)
+                    level[(size_t) v] = level[(size_t) u] + 1;
+                if (level[(size_t) v] > max_level)
+                    max_level = level[(size_t) v];
+            }
+        g->levels.assign((size_t) max_level + 1, {});
+        for (int i = 0; i < N; ++i)
+            g->levels[(size_t) level[(size_t) i]].push_back(i);
+        g->cp_succ = succ;  // kept for re-ranking with measured times
     }
 
     g->schedule = std::move(order);
+
+    // Critical-path-first order within each level, unit costs for now
+    // (longest chain in hops). mh_graph_refresh_priorities re-ranks
+    // with the profiling EWMA once real timings exist.
+    {
+        std::vector<long long> unit((size_t) N, 1);
+        sortLevelsByRemainingCost(g, unit.data());
+    }
     g->pending_midi.assign((size_t) N, MH_PluginGraph::PendingMidi{nullptr, 0});
     g->pending_auto.assign((size_t) N, MH_PluginGraph::PendingAuto{nullptr, 0});
+    g->timeline_auto.assign((size_t) N, MH_PluginGraph::TimelineAuto{});
+    g->timeline_frame = 0;
+    g->profiles.reset(new NodeProfile[(size_t) N]);
+    for (int i = 0; i < N; ++i) g->profiles[(size_t) i].reset();
+    {
+        // Bypass flags: values carry over a recompile (node ids are
+        // append-only); nodes added during the edit start live.
+        std::unique_ptr<std::atomic<int>[]> flags(new std::atomic<int>[(size_t) N]);
+        for (int i = 0; i < N; ++i)
+            flags[(size_t) i].store(
+                (reuse && i < g->bypass_count)
+                    ? g->bypass_flags[(size_t) i].load(std::memory_order_relaxed)
+                    : 0,
+                std::memory_order_relaxed);
+        g->bypass_flags = std::move(flags);
+        g->bypass_count = N;
+    }
+    {
+        // Watchdog failure flags carry over a recompile the same way
+        // bypass flags do: a plugin that hung once is still hung, and
+        // its abandoned call may still be running.
+        std::unique_ptr<std::atomic<int>[]> flags(new std::atomic<int>[(size_t) N]);
+        for (int i = 0; i < N; ++i)
+            flags[(size_t) i].store(
+                (reuse && i < g->failed_count)
+                    ? g->failed_flags[(size_t) i].load(std::memory_order_relaxed)
+                    : 0,
+                std::memory_order_relaxed);
+        g->failed_flags = std::move(flags);
+        g->failed_count = N;
+    }
+    {
+        // Wet/dry mixes carry over a recompile the same way; nodes
+        // added during the edit start full wet.
+        std::unique_ptr<std::atomic<unsigned>[]> mixes(
+            new std::atomic<unsigned>[(size_t) N]);
+        for (int i = 0; i < N; ++i)
+            mixes[(size_t) i].store(
+                (reuse && i < g->node_mix_count)
+                    ? g->node_mix[(size_t) i].load(std::memory_order_relaxed)
+                    : floatBits(1.0f),
+                std::memory_order_relaxed);
+        g->node_mix = std::move(mixes);
+        g->node_mix_count = N;
+    }
+    {
+        // Governor shed ranks carry over a recompile the same way
+        // bypass flags do; nodes added during the edit are never shed.
+        std::unique_ptr<std::atomic<int>[]> order(new std::atomic<int>[(size_t) N]);
+        for (int i = 0; i < N; ++i)
+            order[(size_t) i].store(
+                (reuse && i < g->shed_order_count)
+                    ? g->shed_order[(size_t) i].load(std::memory_order_relaxed)
+                    : -1,
+                std::memory_order_relaxed);
+        g->shed_order = std::move(order);
+        g->shed_order_count = N;
+        g->governor_stack.reserve((size_t) N);
+    }
+    {
+        // Meter taps: enable flags carry over a recompile the same way
+        // bypass flags do; published levels restart at silence.
+        std::unique_ptr<std::atomic<int>[]> flags(new std::atomic<int>[(size_t) N]);
+        for (int i = 0; i < N; ++i)
+            flags[(size_t) i].store(
+                (reuse && i < g->meter_count)
+                    ? g->meter_flags[(size_t) i].load(std::memory_order_relaxed)
+                    : 0,
+                std::memory_order_relaxed);
+        g->meter_flags = std::move(flags);
+        g->meters.reset(new NodeMeter[(size_t) N]);
+        for (int i = 0; i < N; ++i)
+            for (int c = 0; c < kMeterMaxChannels; ++c)
+            {
+                g->meters[(size_t) i].peak[c] = 0.0f;
+                g->meters[(size_t) i].rms[c]  = 0.0f;
+            }
+        g->meter_count = N;
+    }
+    {
+        // Verification digests restart on a recompile: an edited graph
+        // is a different render, so comparing digests across the edit
+        // would be meaningless anyway. The hashing mode itself persists.
+        std::unique_ptr<std::atomic<unsigned long long>[]> digests(
+            new std::atomic<unsigned long long>[(size_t) N]);
+        for (int i = 0; i < N; ++i)
+            digests[(size_t) i].store(0, std::memory_order_relaxed);
+        g->node_digests = std::move(digests);
+        g->hash_count = N;
+        g->render_digest.store(0, std::memory_order_relaxed);
+    }
+    if (g->workers.empty() && g->executor == nullptr)
+    {
+        g->spawnWorkers();
+    }
+    else
+    {
+        // Recompile with the pool already running (or a shared
+        // executor attached, which spawns nothing here): the levels
+        // may have changed shape, so the per-level cursors are
+        // refreshed. Safe because the workers only touch them inside
+        // render_block, which must not overlap an edit cycle.
+        g->pool_level_next.reset(new std::atomic<int>[g->levels.size()]);
+        g->pool_level_remaining.reset(new std::atomic<int>[g->levels.size()]);
+        for (size_t k = 0; k < g->levels.size(); ++k)
+        {
+            g->pool_level_next[k].store(0, std::memory_order_relaxed);
+            g->pool_level_remaining[k].store(0, std::memory_order_relaxed);
+        }
+    }
+    if (reuse)
+        recomputeFreezeElision(g);  // edges may have changed under a freeze
+    attachGraphTransport(g);        // nodes added during an edit cycle
+    g->last_nframes = 0;            // no rendered audio in the pool yet
     g->compiled = true;
     return 1;
 }
 
-extern "C" int mh_graph_set_node_midi(MH_PluginGraph* g, MH_NodeId node,
-                                         const MH_MidiEvent* events,
-                                         int num_events)
+extern "C" int mh_graph_compile(MH_PluginGraph* g,
+                                   char* err_buf, size_t err_buf_size)
 {
-    if (g == nullptr) return 0;
-    if (!g->compiled) return 0;
-    if (!inRange(node, (int) g->nodes.size())) return 0;
-    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
-    g->pending_midi[(size_t) node].events = events;
-    g->pending_midi[(size_t) node].count  = events ? num_events : 0;
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return 0; }
+    if (g->compiled)  { setErr(err_buf, err_buf_size,
+                               "already compiled"); return 0; }
+    if (!compileGraph(g, /*reuse=*/g->editing, err_buf, err_buf_size))
+        return 0;
+    g->editing = false;
     return 1;
 }
 
-extern "C" int mh_graph_set_midi_input_events(MH_PluginGraph* g, MH_NodeId node,
-                                                 const MH_MidiEvent* events,
-                                                 int num_events)
+extern "C" int mh_graph_begin_edit(MH_PluginGraph* g,
+                                      char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr) { setErr(err_buf, err_buf_size, "null graph"); return 0; }
+    if (!g->compiled)
+    {
+        setErr(err_buf, err_buf_size,
+               "graph is not compiled; nothing to reopen for editing");
+        return 0;
+    }
+    g->compiled = false;
+    g->editing  = true;
+    return 1;
+}
+
+extern "C" int mh_graph_set_num_threads(MH_PluginGraph* g, int num_threads)
 {
     if (g == nullptr) return 0;
-    if (!g->compiled) return 0;
-    if (!inRange(node, (int) g->nodes.size())) return 0;
-    auto& n = g->nodes[(size_t) node];
-    if (n.kind != MH_NODE_MIDI_INPUT) return 0;
-    n.staged_midi_events = events;
-    n.staged_midi_count  = events ? num_events : 0;
+    if (g->compiled) return 0;
+    if (num_threads < 1)  num_threads = 1;
+    if (num_threads > 64) num_threads = 64;
+    g->num_threads = num_threads;
     return 1;
 }
 
-extern "C" int mh_graph_get_midi_output_events(MH_PluginGraph* g, MH_NodeId node,
-                                                  MH_MidiEvent* out_buf,
-                                                  int capacity,
-                                                  int* num_events_out)
+extern "C" int mh_graph_set_worker_affinity(MH_PluginGraph* g,
+                                               const int* cpu_ids, int count)
 {
     if (g == nullptr) return 0;
-    if (!g->compiled) return 0;
-    if (!inRange(node, (int) g->nodes.size())) return 0;
-    auto& n = g->nodes[(size_t) node];
-    if (n.kind != MH_NODE_MIDI_OUTPUT) return 0;
-    const int total = n.midi_out_truncated_count;
-    if (num_events_out) *num_events_out = total;
-    if (out_buf != nullptr && capacity > 0)
+    if (g->compiled) return 0;
+    if (count < 0) return 0;
+    if (count == 0)
     {
-        const int to_copy = total < capacity ? total : capacity;
-        for (int i = 0; i < to_copy; ++i)
-            out_buf[i] = n.midi_out_buf[(size_t) i];
+        g->worker_cpus.clear();
+        return 1;
     }
+    if (cpu_ids == nullptr) return 0;
+    for (int i = 0; i < count; ++i)
+        if (cpu_ids[i] < 0) return 0;
+    g->worker_cpus.assign(cpu_ids, cpu_ids + count);
     return 1;
 }
 
-extern "C" int mh_graph_set_node_automation(MH_PluginGraph* g, MH_NodeId node,
-                                               const MH_ParamChange* changes,
-                                               int num_changes)
+extern "C" MH_GraphExecutor* mh_graph_executor_create(int num_threads)
+{
+    if (num_threads < 1)  num_threads = 1;
+    if (num_threads > 64) num_threads = 64;
+    auto* e = new (std::nothrow) MH_GraphExecutor();
+    if (e == nullptr) return nullptr;
+    e->workers.reserve((size_t) num_threads);
+    for (int i = 0; i < num_threads; ++i)
+        e->workers.emplace_back([e]
+        {
+            mh_thread_policy_apply(MH_THREAD_ROLE_AUDIO_WORKER);
+            e->workerMain();
+        });
+    return e;
+}
+
+extern "C" void mh_graph_executor_close(MH_GraphExecutor* e)
+{
+    if (e == nullptr) return;
+    {
+        std::lock_guard<std::mutex> lock(e->mutex);
+        e->shutdown = true;
+    }
+    e->cv.notify_all();
+    for (auto& t : e->workers) t.join();
+    delete e;
+}
+
+extern "C" int mh_graph_set_executor(MH_PluginGraph* g, MH_GraphExecutor* e,
+                                     int priority, int max_workers)
 {
     if (g == nullptr) return 0;
-    if (!g->compiled) return 0;
-    if (!inRange(node, (int) g->nodes.size())) return 0;
-    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
-    g->pending_auto[(size_t) node].changes = changes;
-    g->pending_auto[(size_t) node].count
-        = changes ? num_changes : 0;
+    if (g->compiled) return 0;
+    if (max_workers < 0) return 0;
+    // The shared pool replaces any private one; detaching (e == NULL)
+    // lets the next compile spawn a private pool again.
+    g->stopWorkers();
+    g->executor         = e;
+    g->exec_priority    = priority;
+    g->exec_max_workers = max_workers;
     return 1;
 }
 
-extern "C" int mh_graph_render_block(MH_PluginGraph* g,
-                                        const float* const* const* input_buffers,
-                                        int num_input_nodes,
+extern "C" int mh_graph_set_pool_huge_pages(MH_PluginGraph* g, int enabled)
+{
+    if (g == nullptr) return 0;
+    if (g->compiled) return 0;
+    g->pool_huge_pages = enabled ? 1 : 0;
+    return 1;
+}
+
+extern "C" int mh_graph_set_lock_memory(MH_PluginGraph* g, int enabled)
+{
+    if (g == nullptr) return 0;
+    if (g->compiled) return 0;
+    g->pool_lock_memory = enabled ? 1 : 0;
+    return 1;
+}
+
+extern "C" long long mh_graph_get_locked_bytes(MH_PluginGraph* g)
+{
+    if (g == nullptr) return -1;
+    return (long long) (g->pool_locked_bytes + g->dbl_locked_bytes);
+}
+
+extern "C" int mh_graph_set_double_precision(MH_PluginGraph* g, int enabled)
+{
+    if (g == nullptr) return 0;
+    if (g->compiled) return 0;
+    g->double_mode = enabled ? 1 : 0;
+    return 1;
+}
+
+extern "C" int mh_graph_set_plan(MH_PluginGraph* g, const void* data, int size)
+{
+    if (g == nullptr || data == nullptr) return 0;
+    if ((size_t) size < kPlanHeader) return 0;
+    if (g->compiled) return 0;
+    const auto* p = (const unsigned char*) data;
+    g->plan_blob.assign(p, p + size);
+    return 1;
+}
+
+extern "C" int mh_graph_export_plan(MH_PluginGraph* g,
+                                    void** out_data, int* out_size)
+{
+    if (g == nullptr || out_data == nullptr || out_size == nullptr) return 0;
+    *out_data = nullptr;
+    *out_size = 0;
+    if (! g->compiled) return 0;
+
+    const uint32_t count = (uint32_t) g->schedule.size();
+    const uint64_t hash  = graphShapeHash(g);
+    const size_t   bytes = kPlanHeader + (size_t) count * 4;
+
+    auto* blob = (unsigned char*) std::malloc(bytes);
+    if (blob == nullptr) return 0;
+    std::memcpy(blob + 0,  &kPlanMagic,   4);
+    std::memcpy(blob + 4,  &kPlanVersion, 4);
+    std::memcpy(blob + 8,  &count,        4);
+    std::memcpy(blob + 12, &hash,         8);
+    for (size_t i = 0; i < (size_t) count; ++i)
+    {
+        const int32_t id = (int32_t) g->schedule[i];
+        std::memcpy(blob + kPlanHeader + i * 4, &id, 4);
+    }
+    *out_data = blob;
+    *out_size = (int) bytes;
+    return 1;
+}
+
+extern "C" void mh_graph_plan_free(void* data)
+{
+    std::free(data);
+}
+
+extern "C" int mh_graph_set_node_midi(MH_PluginGraph* g, MH_NodeId node,
+                                         const MH_MidiEvent* events,
+                                         int num_events)
+{
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
+    g->pending_midi[(size_t) node].events = events;
+    g->pending_midi[(size_t) node].count  = events ? num_events : 0;
+    return 1;
+}
+
+extern "C" int mh_graph_set_midi_input_events(MH_PluginGraph* g, MH_NodeId node,
+                                                 const MH_MidiEvent* events,
+                                                 int num_events)
+{
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    auto& n = g->nodes[(size_t) node];
+    if (n.kind != MH_NODE_MIDI_INPUT) return 0;
+    n.staged_midi_events = events;
+    n.staged_midi_count  = events ? num_events : 0;
+    if (n.staged_midi_count > 0)
+        mh_eventlog_record(MH_LOG_MIDI_IN, 0, (unsigned) n.staged_midi_count);
+    return 1;
+}
+
+extern "C" int mh_graph_get_midi_output_events(MH_PluginGraph* g, MH_NodeId node,
+                                                  MH_MidiEvent* out_buf,
+                                                  int capacity,
+                                                  int* num_events_out)
+{
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    auto& n = g->nodes[(size_t) node];
+    if (n.kind != MH_NODE_MIDI_OUTPUT) return 0;
+    const int total = n.midi_out_truncated_count;
+    if (num_events_out) *num_events_out = total;
+    if (out_buf != nullptr && capacity > 0 && n.midi_view_evts != nullptr)
+    {
+        const int avail   = n.midi_view_n;
+        const int to_copy = avail < capacity ? avail : capacity;
+        for (int i = 0; i < to_copy; ++i)
+            out_buf[i] = n.midi_view_evts[i];
+    }
+    return 1;
+}
+
+extern "C" int mh_graph_borrow_midi_output_events(MH_PluginGraph* g,
+                                                     MH_NodeId node,
+                                                     const MH_MidiEvent** events_out,
+                                                     int* num_events_out)
+{
+    if (events_out) *events_out = nullptr;
+    if (num_events_out) *num_events_out = 0;
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    if (events_out == nullptr || num_events_out == nullptr) return 0;
+    auto& n = g->nodes[(size_t) node];
+    if (n.kind != MH_NODE_MIDI_OUTPUT) return 0;
+    *events_out     = n.midi_view_evts;
+    *num_events_out = n.midi_view_n;
+    return 1;
+}
+
+extern "C" int mh_graph_set_node_automation(MH_PluginGraph* g, MH_NodeId node,
+                                               const MH_ParamChange* changes,
+                                               int num_changes)
+{
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
+    g->pending_auto[(size_t) node].changes = changes;
+    g->pending_auto[(size_t) node].count
+        = changes ? num_changes : 0;
+    return 1;
+}
+
+namespace {
+
+// First timeline entry at or after `frame`.
+size_t timelineCursorFor(const std::vector<MH_ParamChange>& changes,
+                         long long frame)
+{
+    return (size_t) (std::lower_bound(
+                         changes.begin(), changes.end(), frame,
+                         [](const MH_ParamChange& c, long long f)
+                         { return (long long) c.sample_offset < f; })
+                     - changes.begin());
+}
+
+// First keyframe in [begin, end) strictly after `frame` -- the curve
+// cursor. `frame` then sits in the segment [cursor-1, cursor).
+size_t curveCursorFor(const std::vector<MH_ParamChange>& kfs,
+                      size_t begin, size_t end, long long frame)
+{
+    return (size_t) (std::upper_bound(
+                         kfs.begin() + (ptrdiff_t) begin,
+                         kfs.begin() + (ptrdiff_t) end, frame,
+                         [](long long f, const MH_ParamChange& c)
+                         { return f < (long long) c.sample_offset; })
+                     - kfs.begin());
+}
+
+} // namespace
+
+extern "C" int mh_graph_set_node_automation_timeline(MH_PluginGraph* g,
+                                                        MH_NodeId node,
+                                                        const MH_ParamChange* changes,
+                                                        int num_changes)
+{
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
+
+    auto& ta = g->timeline_auto[(size_t) node];
+    ta.changes.clear();
+    ta.cursor = 0;
+    ta.state_index.clear();
+    ta.state_groups.clear();
+    ta.state_index_built = false;
+    if (changes != nullptr && num_changes > 0)
+    {
+        ta.changes.assign(changes, changes + num_changes);
+        // Sorted once here so the render path is a forward walk.
+        // stable_sort keeps same-offset changes in caller order (last
+        // writer wins inside mh_process_auto).
+        std::stable_sort(ta.changes.begin(), ta.changes.end(),
+                         [](const MH_ParamChange& a, const MH_ParamChange& b)
+                         { return a.sample_offset < b.sample_offset; });
+        // Skip past changes behind the current position; otherwise they
+        // would all fire (clamped) on the next block.
+        ta.cursor = timelineCursorFor(ta.changes, g->timeline_frame);
+    }
+    return 1;
+}
+
+extern "C" int mh_graph_set_node_automation_curves(MH_PluginGraph* g,
+                                                      MH_NodeId node,
+                                                      const MH_ParamChange* keyframes,
+                                                      int num_keyframes)
+{
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
+
+    auto& ta = g->timeline_auto[(size_t) node];
+    ta.keyframes.clear();
+    ta.curves.clear();
+    if (keyframes == nullptr || num_keyframes <= 0) return 1;
+
+    ta.keyframes.assign(keyframes, keyframes + num_keyframes);
+    // Group per parameter, time-sorted inside each group, so the render
+    // path is a forward cursor walk per curve. stable_sort keeps
+    // same-offset keyframes in caller order.
+    std::stable_sort(ta.keyframes.begin(), ta.keyframes.end(),
+                     [](const MH_ParamChange& a, const MH_ParamChange& b)
+                     {
+                         if (a.param_index != b.param_index)
+                             return a.param_index < b.param_index;
+                         return a.sample_offset < b.sample_offset;
+                     });
+    size_t begin = 0;
+    for (size_t i = 1; i <= ta.keyframes.size(); ++i)
+    {
+        if (i < ta.keyframes.size()
+            && ta.keyframes[i].param_index
+                   == ta.keyframes[begin].param_index)
+            continue;
+        MH_PluginGraph::TimelineAuto::Curve c;
+        c.param  = ta.keyframes[begin].param_index;
+        c.begin  = begin;
+        c.end    = i;
+        c.cursor = curveCursorFor(ta.keyframes, begin, i, g->timeline_frame);
+        ta.curves.push_back(c);
+        begin = i;
+    }
+    return 1;
+}
+
+extern "C" int mh_graph_seek_automation(MH_PluginGraph* g, long long frame)
+{
+    if (g == nullptr) return 0;
+    if (!g->compiled) return 0;
+    if (frame < 0) return 0;
+    g->timeline_frame = frame;
+    for (auto& ta : g->timeline_auto)
+    {
+        ta.cursor = ta.changes.empty()
+            ? 0 : timelineCursorFor(ta.changes, frame);
+        for (auto& cv : ta.curves)
+        {
+            cv.cursor = curveCursorFor(ta.keyframes, cv.begin, cv.end, frame);
+            // Re-establish the value on the first block after a jump.
+            cv.has_last = false;
+        }
+    }
+    return 1;
+}
+
+namespace {
+
+// Build a node timeline's scrubbing index: a (param, offset)-sorted
+// copy of the change list plus per-parameter group ranges. stable_sort
+// keeps same-(param, offset) changes in caller order, so the last
+// entry of a group slice is the last writer -- the value a replay
+// would have left behind.
+void buildTimelineStateIndex(MH_PluginGraph::TimelineAuto& ta)
+{
+    ta.state_index = ta.changes;
+    std::stable_sort(ta.state_index.begin(), ta.state_index.end(),
+                     [](const MH_ParamChange& a, const MH_ParamChange& b)
+                     {
+                         if (a.param_index != b.param_index)
+                             return a.param_index < b.param_index;
+                         return a.sample_offset < b.sample_offset;
+                     });
+    ta.state_groups.clear();
+    size_t begin = 0;
+    for (size_t i = 1; i <= ta.state_index.size(); ++i)
+    {
+        if (i < ta.state_index.size()
+            && ta.state_index[i].param_index
+                   == ta.state_index[begin].param_index)
+            continue;
+        MH_PluginGraph::TimelineAuto::ParamSpan s;
+        s.param = ta.state_index[begin].param_index;
+        s.begin = begin;
+        s.end   = i;
+        ta.state_groups.push_back(s);
+        begin = i;
+    }
+    ta.state_index_built = true;
+}
+
+// Clamped-linear curve value at `frame`. cv.cursor must already be the
+// curve cursor for `frame` (first keyframe strictly after it) -- the
+// same evaluation the block-start staging performs.
+float curveValueAt(const std::vector<MH_ParamChange>& kfs,
+                   const MH_PluginGraph::TimelineAuto::Curve& cv,
+                   long long frame)
+{
+    if (cv.cursor == cv.begin) return kfs[cv.begin].value;
+    if (cv.cursor == cv.end)   return kfs[cv.end - 1].value;
+    const MH_ParamChange& k0 = kfs[cv.cursor - 1];
+    const MH_ParamChange& k1 = kfs[cv.cursor];
+    const double t = (double) (frame - (long long) k0.sample_offset)
+                     / (double) ((long long) k1.sample_offset
+                                 - (long long) k0.sample_offset);
+    return (float) (k0.value + t * (k1.value - k0.value));
+}
+
+} // namespace
+
+extern "C" int mh_graph_seek_automation_state(MH_PluginGraph* g,
+                                                 long long frame)
+{
+    if (!mh_graph_seek_automation(g, frame)) return 0;
+    for (size_t id = 0; id < g->timeline_auto.size(); ++id)
+    {
+        auto& ta = g->timeline_auto[id];
+        if (ta.changes.empty() && ta.curves.empty())
+            continue;
+        MH_Plugin* plugin = g->nodes[id].plugin;
+        if (plugin == nullptr)
+            continue;
+        // Timeline first, curves second: after a seek the curves
+        // restage their value on the first rendered block anyway
+        // (has_last was cleared by the seek above), so a parameter
+        // carrying both ends up at the curve's value either way --
+        // applying in that order makes the reconstructed state match
+        // the rendered one immediately.
+        if (!ta.changes.empty())
+        {
+            if (!ta.state_index_built)
+                buildTimelineStateIndex(ta);
+            for (const auto& sp : ta.state_groups)
+            {
+                const auto first = ta.state_index.begin()
+                                   + (ptrdiff_t) sp.begin;
+                const auto last  = ta.state_index.begin()
+                                   + (ptrdiff_t) sp.end;
+                // Latest change strictly before `frame`; a change at
+                // exactly `frame` is left to the first rendered block,
+                // where it overrides -- exactly as in a replay.
+                const auto it = std::lower_bound(
+                    first, last, frame,
+                    [](const MH_ParamChange& c, long long f)
+                    { return (long long) c.sample_offset < f; });
+                if (it != first)
+                    mh_set_param(plugin, sp.param, (it - 1)->value);
+            }
+        }
+        for (const auto& cv : ta.curves)
+            mh_set_param(plugin, cv.param,
+                         curveValueAt(ta.keyframes, cv, frame));
+    }
+    return 1;
+}
+
+extern "C" int mh_graph_set_transport(MH_PluginGraph* g,
+                                         const MH_TransportInfo* transport)
+{
+    if (g == nullptr) return 0;
+    if (g->shared_transport == nullptr)
+    {
+        g->shared_transport = mh_shared_transport_create();
+        if (g->shared_transport == nullptr) return 0;
+    }
+    attachGraphTransport(g);
+    if (transport == nullptr)
+    {
+        g->transport_active = false;
+        return mh_shared_transport_write(g->shared_transport, nullptr);
+    }
+    g->transport_info   = *transport;
+    g->transport_active = true;
+    return mh_shared_transport_write(g->shared_transport, &g->transport_info);
+}
+
+namespace {
+
+// Map one bipolar modulation sample to a shaped unipolar position
+// (mh_graph_connect_modulation). Only a handful of points are shaped
+// per block -- one per edge per sampling interval -- so this stays
+// scalar; the SIMD mix kernels below earn their keep on whole
+// buffers, not on block-rate taps.
+inline float shapeModValue(int curve, float s)
+{
+    float u = 0.5f * s + 0.5f;  // [-1, 1] -> [0, 1]
+    if (u < 0.0f) u = 0.0f; else if (u > 1.0f) u = 1.0f;
+    switch (curve)
+    {
+        case MH_MOD_CURVE_SQUARED:    return u * u;
+        case MH_MOD_CURVE_SMOOTHSTEP: return u * u * (3.0f - 2.0f * u);
+        default:                      return u;
+    }
+}
+
+// Resolve the planar source pointers for one (non-silent) input port,
+// running the port's compensation delay line first when compile
+// inserted one. The returned table has at least the port's channel
+// count entries and stays valid for the rest of the block.
+const float* const* resolveInputPort(MH_PluginGraph* g,
+                                     const Node::InputRef& ref,
+                                     const float* const* const* input_buffers,
+                                     int nframes)
+{
+    const float* const* src;
+    if (ref.feedback_index >= 0)
+        src = g->fb_ptrs[(size_t) ref.feedback_index].data();
+    else if (ref.from_caller)
+        src = input_buffers[(size_t) ref.caller_index];
+    else
+        src = g->pool_ptrs[(size_t) ref.pool_index].data();
+    if (ref.delay_index < 0) return src;
+
+    auto& dl = g->delay_lines[(size_t) ref.delay_index];
+    const int D = dl.delay;
+    int end_pos = dl.pos;
+    for (int c = 0; c < dl.channels; ++c)
+    {
+        float*       ring = dl.ring.data() + (size_t) c * (size_t) D;
+        float*       out  = dl.out_ptrs[(size_t) c];
+        const float* in   = src[c];
+        int pos = dl.pos;
+        for (int i = 0; i < nframes; ++i)
+        {
+            out[i]    = ring[pos];
+            ring[pos] = in[i];
+            if (++pos == D) pos = 0;
+        }
+        end_pos = pos;
+    }
+    dl.pos = end_pos;
+    return dl.out_ptrs.data();
+}
+
+// Render one node. Shared by the serial path and the worker-pool path
+// of mh_graph_render_block. Returns 1 on success, 0 on failure.
+// ---- Mix kernels ----
+//
+// dst = src * gain. gain == 1 degenerates to memcpy (the dominant case
+// for mix nodes used purely as summing junctions).
+inline void copyScaled(float* dst, const float* src, float gain, int n)
+{
+    if (gain == 1.0f)
+    {
+        std::memcpy(dst, src, (size_t) n * sizeof(float));
+        return;
+    }
+    int i = 0;
+#if defined(MH_GRAPH_MIX_SSE2)
+    const __m128 vg = _mm_set1_ps(gain);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), vg));
+#elif defined(MH_GRAPH_MIX_NEON)
+    const float32x4_t vg = vdupq_n_f32(gain);
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), vg));
+#endif
+    for (; i < n; ++i) dst[i] = src[i] * gain;
+}
+
+// dst += src * gain.
+inline void addScaled(float* dst, const float* src, float gain, int n)
+{
+    int i = 0;
+#if defined(MH_GRAPH_MIX_SSE2)
+    const __m128 vg = _mm_set1_ps(gain);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 d = _mm_loadu_ps(dst + i);
+        d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(src + i), vg));
+        _mm_storeu_ps(dst + i, d);
+    }
+#elif defined(MH_GRAPH_MIX_NEON)
+    const float32x4_t vg = vdupq_n_f32(gain);
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i,
+                  vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), vg));
+#endif
+    for (; i < n; ++i) dst[i] += src[i] * gain;
+}
+
+// wet = mix * wet + (1 - mix) * dry (mh_graph_set_node_mix). Callers
+// elide the full-wet case, so no degenerate-gain shortcut here.
+inline void blendWetDry(float* wet, const float* dry, float mix, int n)
+{
+    const float dry_gain = 1.0f - mix;
+    int i = 0;
+#if defined(MH_GRAPH_MIX_SSE2)
+    const __m128 vw = _mm_set1_ps(mix);
+    const __m128 vd = _mm_set1_ps(dry_gain);
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128 w = _mm_mul_ps(_mm_loadu_ps(wet + i), vw);
+        const __m128 d = _mm_mul_ps(_mm_loadu_ps(dry + i), vd);
+        _mm_storeu_ps(wet + i, _mm_add_ps(w, d));
+    }
+#elif defined(MH_GRAPH_MIX_NEON)
+    const float32x4_t vw = vdupq_n_f32(mix);
+    const float32x4_t vd = vdupq_n_f32(dry_gain);
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(wet + i,
+                  vmlaq_f32(vmulq_f32(vld1q_f32(wet + i), vw),
+                            vld1q_f32(dry + i), vd));
+#endif
+    for (; i < n; ++i) wet[i] = mix * wet[i] + dry_gain * dry[i];
+}
+
+// Convert a plugin's reported tail into a ring-out budget in samples.
+// An infinite tail (JUCE's VST3 wrapper maps kInfiniteTail to +inf)
+// would make the multiply-and-cast undefined -- and land on LLONG_MIN
+// in practice, i.e. "elapsed before the first silent block" -- so
+// non-finite or overflowing values clamp to a budget that never runs
+// out and the node is never skipped.
+inline long long tailBudgetSamples(double tail_seconds, double sample_rate)
+{
+    const double samples = tail_seconds * sample_rate;
+    if (!std::isfinite(samples) || samples >= (double) LLONG_MAX)
+        return LLONG_MAX;
+    return (long long) samples;
+}
+
+// Silence test for the silence-skip path: peak scan with early exit on
+// the first lane above the -160 dBFS threshold (catches exact zeros and
+// denormal dust without gating quiet program material), so audible
+// blocks cost only a few samples.
+inline bool blockIsSilent(const float* const* bufs, int channels, int nframes)
+{
+    const float thresh = 1.0e-8f;
+    for (int c = 0; c < channels; ++c)
+    {
+        const float* buf = bufs[c];
+        int i = 0;
+#if defined(MH_GRAPH_MIX_SSE2)
+        const __m128 vt   = _mm_set1_ps(thresh);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        for (; i + 4 <= nframes; i += 4)
+        {
+            const __m128 v = _mm_andnot_ps(sign, _mm_loadu_ps(buf + i));
+            if (_mm_movemask_ps(_mm_cmpgt_ps(v, vt)) != 0) return false;
+        }
+#elif defined(MH_GRAPH_MIX_NEON)
+        const float32x4_t vt = vdupq_n_f32(thresh);
+        for (; i + 4 <= nframes; i += 4)
+        {
+            const uint32x4_t m
+                = vcgtq_f32(vabsq_f32(vld1q_f32(buf + i)), vt);
+            const uint32x2_t m2 = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+            if ((vget_lane_u32(m2, 0) | vget_lane_u32(m2, 1)) != 0)
+                return false;
+        }
+#endif
+        for (; i < nframes; ++i)
+            if (std::fabs(buf[i]) > thresh) return false;
+    }
+    return true;
+}
+
+// One partitioned-convolution hop: transforms the conv_part frames
+// staged in conv_in_buf, pushes the spectrum into the frequency-domain
+// delay line, multiply-accumulates every IR partition against its
+// aligned past-input spectrum, inverse-transforms, overlap-adds, and
+// appends conv_part output frames to the output ring. No allocations;
+// touched only by the thread rendering the node.
+inline void convolveHop(Node& n)
+{
+    const int B  = n.conv_part;
+    const int F  = n.conv_fft;
+    const int P  = n.conv_parts;
+    const int ch = n.output_channels;
+    n.conv_fdl_head = (n.conv_fdl_head + P - 1) % P;  // newest slot
+    for (int c = 0; c < ch; ++c)
+    {
+        // Forward FFT of this hop, zero-padded to F, stored into the
+        // delay-line slot for this channel.
+        float* sr = n.conv_fdl_re.data()
+                    + ((size_t) c * P + n.conv_fdl_head) * F;
+        float* si = n.conv_fdl_im.data()
+                    + ((size_t) c * P + n.conv_fdl_head) * F;
+        const float* staged = n.conv_in_buf.data() + (size_t) c * B;
+        std::memcpy(sr, staged, (size_t) B * sizeof(float));
+        std::memset(sr + B, 0, (size_t) B * sizeof(float));
+        std::memset(si, 0, (size_t) F * sizeof(float));
+        fftInPlace(sr, si, F, false);
+
+        // Spectrum MAC: IR partition p pairs with the input spectrum
+        // from p hops ago. Flat per-bin loops so the compiler can
+        // vectorize the complex multiply.
+        float* ar = n.conv_acc_re.data();
+        float* ai = n.conv_acc_im.data();
+        std::memset(ar, 0, (size_t) F * sizeof(float));
+        std::memset(ai, 0, (size_t) F * sizeof(float));
+        const int irc = (n.conv_ir_channels == 1) ? 0 : c;
+        for (int p = 0; p < P; ++p)
+        {
+            const float* xr = n.conv_fdl_re.data()
+                + ((size_t) c * P + (n.conv_fdl_head + p) % P) * F;
+            const float* xi = n.conv_fdl_im.data()
+                + ((size_t) c * P + (n.conv_fdl_head + p) % P) * F;
+            const float* hr = n.conv_ir_re.data() + ((size_t) irc * P + p) * F;
+            const float* hi = n.conv_ir_im.data() + ((size_t) irc * P + p) * F;
+            for (int i = 0; i < F; ++i)
+            {
+                ar[i] += xr[i] * hr[i] - xi[i] * hi[i];
+                ai[i] += xr[i] * hi[i] + xi[i] * hr[i];
+            }
+        }
+        fftInPlace(ar, ai, F, true);
+
+        // Overlap-add: first half plus the previous hop's tail goes
+        // out; second half becomes the new tail.
+        float* tail = n.conv_overlap.data() + (size_t) c * B;
+        float* ring = n.conv_out_ring.data() + (size_t) c * 2 * B;
+        int w = (n.conv_out_rd + n.conv_out_avail) % (2 * B);
+        for (int i = 0; i < B; ++i)
+        {
+            ring[w] = ar[i] + tail[i];
+            w = (w + 1) % (2 * B);
+            tail[i] = ar[B + i];
+        }
+    }
+    n.conv_out_avail += B;
+}
+
+// One channel of the oversampling up stage: polyphase windowed-sinc
+// interpolation by n.oversample_factor. hist holds the last
+// os_up_hist_len base-rate input samples; the work buffer gives the
+// FIR a contiguous [history | block] view so the inner loop needs no
+// wrap tests. Gain of `factor` undoes the zero-stuffing loss.
+inline void oversampleUp(Node& n, float* hist, const float* src,
+                         int nframes, float* dst)
+{
+    const int F = n.oversample_factor;
+    const int T = n.os_taps;
+    const int H = n.os_up_hist_len;
+    float* w = n.os_up_work.data();
+    std::memcpy(w, hist, (size_t) H * sizeof(float));
+    std::memcpy(w + H, src, (size_t) nframes * sizeof(float));
+    const float* h = n.os_kernel.data();
+    const float  gain = (float) F;
+    for (int i = 0; i < nframes; ++i)
+    {
+        for (int p = 0; p < F; ++p)
+        {
+            float acc = 0.0f;
+            for (int t = p, k = 0; t < T; t += F, ++k)
+                acc += h[t] * w[H + i - k];
+            dst[F * i + p] = acc * gain;
+        }
+    }
+    std::memcpy(hist, w + nframes, (size_t) H * sizeof(float));
+}
+
+// One channel of the down stage: lowpass at the oversampled rate,
+// then keep every factor-th sample. hist holds the last (taps - 1)
+// oversampled samples of the plugin's output.
+inline void oversampleDown(Node& n, float* hist, const float* src,
+                           int os_frames, float* dst)
+{
+    const int F = n.oversample_factor;
+    const int T = n.os_taps;
+    const int H = T - 1;
+    float* w = n.os_down_work.data();
+    std::memcpy(w, hist, (size_t) H * sizeof(float));
+    std::memcpy(w + H, src, (size_t) os_frames * sizeof(float));
+    const float* h = n.os_kernel.data();
+    const int out_n = os_frames / F;
+    for (int i = 0; i < out_n; ++i)
+    {
+        float acc = 0.0f;
+        const float* x = w + H + F * i;
+        for (int t = 0; t < T; ++t)
+            acc += h[t] * x[-t];
+        dst[i] = acc;
+    }
+    std::memcpy(hist, w + os_frames, (size_t) H * sizeof(float));
+}
+
+// ---- Freeze cache (mh_graph_freeze_node) ----
+
+// The buffers a freezable node renders into: the caller's output
+// buffer when the plugin->output copy was elided (compile step 4.5),
+// the node's pool entry otherwise. Mix nodes always use the pool.
+inline float* const* frozenNodeBuffers(MH_PluginGraph* g, const Node& n,
+                                       MH_NodeId id,
+                                       float* const* const* output_buffers)
+{
+    return (n.kind == MH_NODE_PLUGIN && n.out_to_caller)
+        ? output_buffers[(size_t) n.out_caller_index]
+        : g->pool_ptrs[(size_t) id].data();
+}
+
+// Append the just-rendered block to the node's cache. Allocates, so a
+// recording pass is not RT-safe -- freeze is an offline-render feature.
+inline void recordFrozenBlock(MH_PluginGraph* g, Node& n, MH_NodeId id,
+                              float* const* const* output_buffers,
+                              int nframes)
+{
+    const float* const* src = frozenNodeBuffers(g, n, id, output_buffers);
+    const int ch = n.output_channels;
+    std::vector<float> block((size_t) ch * (size_t) nframes);
+    for (int c = 0; c < ch; ++c)
+        std::memcpy(block.data() + (size_t) c * nframes, src[c],
+                    (size_t) nframes * sizeof(float));
+    n.freeze_cache.push_back(std::move(block));
+    n.freeze_cache_nframes.push_back(nframes);
+}
+
+// Copy the next cached block back out. Fails (0) when the render pass
+// asks for more blocks than were recorded or splits blocks differently
+// from the recording pass -- the cache is a positional replay, not a
+// random-access store.
+inline int replayFrozenBlock(MH_PluginGraph* g, Node& n, MH_NodeId id,
+                             float* const* const* output_buffers,
+                             int nframes)
+{
+    if (n.freeze_cursor >= n.freeze_cache.size()) return 0;
+    if (n.freeze_cache_nframes[n.freeze_cursor] != nframes) return 0;
+    float* const* dst = frozenNodeBuffers(g, n, id, output_buffers);
+    const std::vector<float>& block = n.freeze_cache[n.freeze_cursor];
+    const int ch = n.output_channels;
+    for (int c = 0; c < ch; ++c)
+        std::memcpy(dst[c], block.data() + (size_t) c * nframes,
+                    (size_t) nframes * sizeof(float));
+    ++n.freeze_cursor;
+    return 1;
+}
+
+// Recompute which nodes the freeze set absorbs: a node is elided when
+// it has at least one consumer and every consumer (audio or MIDI) is a
+// replaying node or itself elided -- nothing live reads its output.
+// Walking the schedule back to front settles consumers before their
+// producers. Input/output/MIDI-I/O nodes stay live (they do no or
+// caller-visible work).
+static void recomputeFreezeElision(MH_PluginGraph* g)
+{
+    for (auto& n : g->nodes) n.freeze_elided = false;
+
+    bool any_replaying = false;
+    for (const auto& n : g->nodes)
+        if (n.freeze_mode == Node::FreezeMode::Replaying) any_replaying = true;
+    if (!any_replaying) return;
+
+    for (auto it = g->schedule.rbegin(); it != g->schedule.rend(); ++it)
+    {
+        const MH_NodeId id = *it;
+        Node& n = g->nodes[(size_t) id];
+        if (n.freeze_mode == Node::FreezeMode::Replaying) continue;
+        if (n.kind == MH_NODE_INPUT || n.kind == MH_NODE_OUTPUT
+            || n.kind == MH_NODE_MIDI_INPUT || n.kind == MH_NODE_MIDI_OUTPUT)
+            continue;
+
+        bool has_consumer = false;
+        bool all_absorbed = true;
+        auto consume = [&](MH_NodeId dst) {
+            has_consumer = true;
+            const Node& d = g->nodes[(size_t) dst];
+            if (d.freeze_mode != Node::FreezeMode::Replaying
+                && !d.freeze_elided)
+                all_absorbed = false;
+        };
+        for (const Edge& e : g->edges)
+            if (e.src_node == id) consume(e.dst_node);
+        for (const MidiEdge& e : g->midi_edges)
+            if (e.src_node == id) consume(e.dst_node);
+
+        if (has_consumer && all_absorbed) n.freeze_elided = true;
+    }
+}
+
+// FNV-1a over the state blobs of every plugin that can reach `node`
+// (including `node` itself). Parameter tweaks and preset loads land in
+// plugin state, so a changed hash means the cached render is stale.
+static unsigned long long upstreamStateHash(MH_PluginGraph* g, MH_NodeId node)
+{
+    // Reverse reachability over audio + MIDI edges.
+    std::vector<char> reach(g->nodes.size(), 0);
+    std::vector<MH_NodeId> stack{node};
+    reach[(size_t) node] = 1;
+    while (!stack.empty())
+    {
+        const MH_NodeId v = stack.back();
+        stack.pop_back();
+        auto visit = [&](MH_NodeId src) {
+            if (!reach[(size_t) src])
+            {
+                reach[(size_t) src] = 1;
+                stack.push_back(src);
+            }
+        };
+        for (const Edge& e : g->edges)
+            if (e.dst_node == v) visit(e.src_node);
+        for (const MidiEdge& e : g->midi_edges)
+            if (e.dst_node == v) visit(e.src_node);
+    }
+
+    unsigned long long h = 1469598103934665603ull;  // FNV offset basis
+    auto mix = [&](const char* data, size_t len) {
+        for (size_t i = 0; i < len; ++i)
+        {
+            h ^= (unsigned char) data[i];
+            h *= 1099511628211ull;  // FNV prime
+        }
+    };
+    std::vector<char> state;
+    for (size_t i = 0; i < g->nodes.size(); ++i)
+    {
+        const Node& n = g->nodes[i];
+        if (!reach[i] || n.kind != MH_NODE_PLUGIN || n.plugin == nullptr)
+            continue;
+        const int size = mh_get_state_size(n.plugin);
+        if (size <= 0) continue;
+        state.resize((size_t) size);
+        if (!mh_get_state(n.plugin, state.data(), size)) continue;
+        mix(state.data(), (size_t) size);
+    }
+    return h;
+}
+
+// k-way merge of time-sorted MIDI runs through a tournament (loser)
+// tree: tree[1..k-1] hold the losers of internal matches, tree[0] the
+// current overall winner, so each emitted event costs O(log k)
+// comparisons instead of the O(k) of a linear head scan. The merge is
+// stable: ties on sample_offset go to the lower source index, and each
+// source is consumed in order, so same-offset events come out in
+// deterministic port order every block. head[] is advanced in place
+// (scratch cursors); out receives at most cap events while *out_total
+// counts everything so callers can report truncation.
+static void mergeSortedMidi(const MH_MidiEvent** head,
+                            const MH_MidiEvent* const* end,
+                            int k, int* tree,
+                            MH_MidiEvent* out, int cap,
+                            int* out_kept, int* out_total)
+{
+    // "a beats b": source a's next event must be emitted before source
+    // b's. Exhausted sources lose to everyone, so the tree drains
+    // without special-casing.
+    auto beats = [&](int a, int b) -> bool
+    {
+        if (head[a] == end[a]) return false;
+        if (head[b] == end[b]) return true;
+        if (head[a]->sample_offset != head[b]->sample_offset)
+            return head[a]->sample_offset < head[b]->sample_offset;
+        return a < b;
+    };
+
+    // Build: insert each source bottom-up. The first arrival at an
+    // empty internal node parks there; later arrivals play the match,
+    // leave the loser behind, and carry the winner upward.
+    for (int i = 0; i < k; ++i) tree[i] = -1;
+    for (int s = k - 1; s >= 0; --s)
+    {
+        int w = s;
+        int t = (s + k) / 2;
+        while (t > 0 && tree[t] != -1)
+        {
+            if (beats(tree[t], w)) std::swap(w, tree[t]);
+            t /= 2;
+        }
+        tree[t > 0 ? t : 0] = w;
+    }
+
+    int w = 0;
+    for (;;)
+    {
+        const int s = tree[0];
+        if (head[s] == end[s]) break;   // winner exhausted => all drained
+        if (w < cap) out[w] = *head[s];
+        ++w;
+        ++head[s];
+        // Replay only s's leaf-to-root path against the stored losers.
+        int cur = s;
+        for (int t = (s + k) / 2; t > 0; t /= 2)
+            if (beats(tree[t], cur)) std::swap(cur, tree[t]);
+        tree[0] = cur;
+    }
+    *out_kept  = (w < cap) ? w : cap;
+    *out_total = w;
+}
+
+// Resolve the per-block event view of a MIDI source: one immutable
+// buffer per producer per block, shared by every fan-out destination
+// as pointer + count -- consumers never copy it. MIDI_INPUT exposes
+// the caller-staged array directly; everything else exposes the
+// midi_out_buf it filled earlier in the schedule. Producers that
+// modify the stream (processors, merges) are the copy boundary: they
+// wrote their own buffer, untouched streams are never duplicated.
+static void midiSourceView(const MH_PluginGraph* g, MH_NodeId src_id,
+                           const MH_MidiEvent** evts, int* count)
+{
+    *evts  = nullptr;
+    *count = 0;
+    if (src_id < 0) return;
+    const Node& s = g->nodes[(size_t) src_id];
+    if (s.kind == MH_NODE_MIDI_INPUT)
+    {
+        *evts  = s.staged_midi_events;
+        *count = s.staged_midi_count;
+    }
+    else
+    {
+        *evts  = s.midi_out_buf.empty() ? nullptr : s.midi_out_buf.data();
+        *count = s.midi_out_count;
+    }
+}
+
+// Run one plugin process dispatch under watchdog supervision
+// (mh_graph_set_watchdog): hand the call to the sentry thread and wait
+// it out with the configured deadline. Returns the call's own result
+// (1/0), or -1 on a trip -- at which point the node has been marked
+// failed, the trip counter bumped, and the sentry abandoned (the
+// worker is stuck inside the plugin; the struct leaks on purpose so
+// the zombie thread's writes stay in valid memory). watchdog_mtx
+// serializes parallel render workers behind the single sentry; the
+// std::function allocation is fine here because supervision is an
+// offline-only mode.
+int superviseNodeCall(MH_PluginGraph* g, MH_NodeId id,
+                      std::function<int()> fn, long long timeout_ns)
+{
+    std::lock_guard<std::mutex> serial(g->watchdog_mtx);
+    if (g->sentry == nullptr)
+        g->sentry = new WatchdogSentry;
+    WatchdogSentry* s = g->sentry;
+    if (!s->running)
+    {
+        s->worker = std::thread([s]
+        {
+            std::unique_lock<std::mutex> lk(s->mtx);
+            for (;;)
+            {
+                s->cv.wait(lk, [s] { return s->has_job || s->quit; });
+                if (s->quit) return;
+                std::function<int()> job = std::move(s->job);
+                s->has_job = false;
+                lk.unlock();
+                const int r = job();
+                lk.lock();
+                s->result = r;
+                s->done   = true;
+                s->cv.notify_all();
+            }
+        });
+        s->running = true;
+    }
+    std::unique_lock<std::mutex> lk(s->mtx);
+    s->job     = std::move(fn);
+    s->has_job = true;
+    s->done    = false;
+    s->cv.notify_all();
+    if (!s->cv.wait_for(lk, std::chrono::nanoseconds(timeout_ns),
+                        [s] { return s->done; }))
+    {
+        lk.unlock();
+        s->worker.detach();
+        g->sentry = nullptr;
+        g->failed_flags[(size_t) id].store(1, std::memory_order_relaxed);
+        g->watchdog_trips.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+    return s->result;
+}
+
+int renderNodeImpl(MH_PluginGraph* g, MH_NodeId id,
+                   const float* const* const* input_buffers,
+                   float* const* const* output_buffers,
+                   int nframes)
+{
+    Node& n = g->nodes[(size_t) id];
+
+    // A block rendered with zero-copy bypass left this node's pool
+    // pointers aliased at the upstream buffer; repoint them at the
+    // node's own storage before anything writes through them.
+    if (n.bypass_aliased)
+    {
+        auto& pp = g->pool_ptrs[(size_t) id];
+        for (int c = 0; c < n.output_channels; ++c)
+            pp[(size_t) c] = g->pool_arena.get()
+                             + g->pool_offsets[(size_t) id]
+                             + (size_t) c * g->pool_chan_stride;
+        n.bypass_aliased = false;
+    }
+
+    // Frozen subtree: an elided node's output feeds only replaying
+    // nodes, so it renders nothing; a replaying node plays its cache
+    // back instead of processing.
+    if (n.freeze_elided) return 1;
+    if (n.freeze_mode == Node::FreezeMode::Replaying)
+        return replayFrozenBlock(g, n, id, output_buffers, nframes);
+
+    switch (n.kind)
+    {
+    case MH_NODE_INPUT:
+        // No work: the buffer lives in the caller; downstream
+        // nodes read straight from input_buffers[io_index].
+        break;
+
+    case MH_NODE_OUTPUT:
+    {
+        // Elided: the upstream plugin already rendered into the
+        // caller's buffer (compile step 4.5).
+        if (n.output_elided) break;
+
+        // Double render: deliver 64-bit straight from the upstream
+        // shadow-pool entry (or a caller input) when one is live;
+        // otherwise widen the resolved float path. This is the last
+        // conversion boundary before the caller's buffers.
+        if (g->rbd_active)
+        {
+            const auto& ref = n.input_sources[0];
+            double* const* dst = g->rbd_outputs[(size_t) n.io_index];
+            const int ch = n.input_channels;
+            if (!ref.from_caller && !ref.is_silent && ref.delay_index < 0
+                && ref.feedback_index < 0
+                && g->nodes[(size_t) ref.pool_index].pool_double_valid)
+            {
+                const auto& src = g->dbl_ptrs[(size_t) ref.pool_index];
+                for (int c = 0; c < ch; ++c)
+                    std::memcpy(dst[c], src[(size_t) c],
+                                (size_t) nframes * sizeof(double));
+            }
+            else if (ref.from_caller && ref.delay_index < 0)
+            {
+                const double* const* src
+                    = g->rbd_inputs[(size_t) ref.caller_index];
+                for (int c = 0; c < ch; ++c)
+                    std::memcpy(dst[c], src[c],
+                                (size_t) nframes * sizeof(double));
+            }
+            else
+            {
+                const float* const* src = resolveInputPort(
+                    g, ref, input_buffers, nframes);
+                for (int c = 0; c < ch; ++c)
+                    for (int i = 0; i < nframes; ++i)
+                        dst[c][i] = src[c][i];
+            }
+            break;
+        }
+
+        // Copy from upstream into caller's output buffer.
+        const float* const* src
+            = resolveInputPort(g, n.input_sources[0], input_buffers, nframes);
+        float* const* dst = output_buffers[(size_t) n.io_index];
+        const int ch = n.input_channels;
+        for (int c = 0; c < ch; ++c)
+            std::memcpy(dst[c], src[c],
+                        (size_t) nframes * sizeof(float));
+        break;
+    }
+
+    case MH_NODE_PLUGIN:
+    {
+        const int in_ch  = n.input_channels;
+        const int out_ch = n.output_channels;
+
+        // Build planar pointer arrays for mh_process. Instruments
+        // (in_ch == 0) have no main audio input and skip the
+        // input-resolution step entirely; mh_process accepts a null
+        // inputs pointer table in that case. The main port, when
+        // present, is always port 0; a sidechain port is always the
+        // last one (and may be port 0 on a sidechain-only node).
+        const float* in_ptrs[64];
+        const int kMaxCh = 64;
+        if (in_ch > kMaxCh) return 0;
+        const bool has_main = in_ch > 0;
+        if (has_main)
+        {
+            const auto& ref = n.input_sources[0];
+            if (ref.is_silent)
+            {
+                // Unwired: every channel reads from the shared
+                // zero-filled silence buffer.
+                for (int c = 0; c < in_ch; ++c)
+                    in_ptrs[c] = g->silence_buf.data();
+            }
+            else
+            {
+                const float* const* src
+                    = resolveInputPort(g, ref, input_buffers, nframes);
+                for (int c = 0; c < in_ch; ++c) in_ptrs[c] = src[c];
+            }
+        }
+
+        // Resolve the sidechain port (mh_graph_connect to
+        // mh_graph_get_node_sidechain_port). Resolved here -- before
+        // the bypass check, like the main port -- so any compensation
+        // delay on the edge keeps advancing every block. The pool (or
+        // caller) pointers feed mh_process_sidechain directly; nothing
+        // is copied on the way in. Unwired stays null: the plugin
+        // already zeroes its sidechain slots in that case.
+        const float* const* sc_in = nullptr;
+        if (n.sidechain_port >= 0)
+        {
+            const auto& ref = n.input_sources[(size_t) n.sidechain_port];
+            if (!ref.is_silent)
+                sc_in = resolveInputPort(g, ref, input_buffers, nframes);
+        }
+
+        // Single-fanout edge into an output node: render straight
+        // into the caller's buffer (compile step 4.5).
+        float* const* out_ptrs_raw = n.out_to_caller
+            ? output_buffers[(size_t) n.out_caller_index]
+            : g->pool_ptrs[(size_t) id].data();
+
+        // Per-node bypass (mh_graph_set_node_bypass): pass the dry
+        // input through without calling the plugin. Zero-copy when
+        // compile cleared it (downstream consumers read the upstream
+        // buffer through this node's aliased pool pointers); a node
+        // with compiled latency instead runs the dry signal through a
+        // matching delay so toggling stays phase-aligned. MIDI and
+        // automation staged for this block are dropped, and the node
+        // emits no MIDI.
+        if (g->bypass_flags[(size_t) id].load(std::memory_order_relaxed))
+        {
+            n.midi_out_count           = 0;
+            n.midi_out_truncated_count = 0;
+            const float* const* dry = has_main ? in_ptrs : nullptr;
+            if (n.bypass_delay == 0 && n.bypass_alias_ok && dry != nullptr)
+            {
+                auto& pp = g->pool_ptrs[(size_t) id];
+                for (int c = 0; c < out_ch; ++c)
+                    pp[(size_t) c] = const_cast<float*>(dry[c]);
+                n.bypass_aliased = true;
+                break;
+            }
+            for (int c = 0; c < out_ch; ++c)
+            {
+                const float* src = (dry != nullptr && c < in_ch)
+                    ? dry[c] : g->silence_buf.data();
+                float* dst = out_ptrs_raw[c];
+                if (n.bypass_delay == 0)
+                {
+                    std::memcpy(dst, src,
+                                (size_t) nframes * sizeof(float));
+                    continue;
+                }
+                float* ring = n.bypass_ring.data()
+                              + (size_t) c * n.bypass_delay;
+                int pos = n.bypass_ring_pos;
+                for (int i = 0; i < nframes; ++i)
+                {
+                    const float d = ring[pos];
+                    ring[pos] = src[i];
+                    dst[i]    = d;
+                    if (++pos == n.bypass_delay) pos = 0;
+                }
+            }
+            if (n.bypass_delay > 0)
+                n.bypass_ring_pos
+                    = (n.bypass_ring_pos + nframes) % n.bypass_delay;
+            break;
+        }
+
+        // Watchdog failure (mh_graph_set_watchdog): a node whose
+        // plugin tripped the deadline stays failed -- the abandoned
+        // call may still be executing inside the plugin, so it is
+        // never touched again. Emit silence, drop MIDI.
+        if (g->failed_flags[(size_t) id].load(std::memory_order_relaxed))
+        {
+            n.midi_out_count           = 0;
+            n.midi_out_truncated_count = 0;
+            for (int c = 0; c < out_ch; ++c)
+                std::memset(out_ptrs_raw[c], 0,
+                            (size_t) nframes * sizeof(float));
+            break;
+        }
+
+        // Resolve MIDI input: incoming MIDI edge (port 0) wins;
+        // otherwise fall back to events staged via set_node_midi
+        // (legacy).
+        const MH_MidiEvent* midi_in_evts = nullptr;
+        int                 midi_in_n    = 0;
+        const MH_NodeId midi_src0
+            = (!n.midi_srcs.empty()) ? n.midi_srcs[0] : -1;
+        if (midi_src0 >= 0)
+        {
+            midiSourceView(g, midi_src0, &midi_in_evts, &midi_in_n);
+        }
+        else
+        {
+            const auto& pm = g->pending_midi[(size_t) id];
+            midi_in_evts = pm.events;
+            midi_in_n    = pm.count;
+        }
+
+        // Determine if we need to capture this plugin's MIDI
+        // output (downstream consumer wired up).
+        const bool capture_midi_out
+            = n.produces_midi && n.has_outgoing_midi_edge;
+        const long long wd_ns
+            = g->watchdog_timeout_ns.load(std::memory_order_relaxed);
+        MH_MidiEvent* midi_out_ptr = nullptr;
+        int           midi_out_cap = 0;
+        // Under watchdog supervision the captured count lands in
+        // node-owned scratch instead of this stack frame (see
+        // wd_midi_out_n on Node).
+        n.wd_midi_out_n         = 0;
+        int  midi_out_n_local   = 0;
+        int& midi_out_n = wd_ns > 0 ? n.wd_midi_out_n : midi_out_n_local;
+        if (capture_midi_out)
+        {
+            midi_out_ptr = n.midi_out_buf.data();
+            midi_out_cap = (int) n.midi_out_buf.size();
+        }
+
+        const auto& autm = g->pending_auto[(size_t) id];
+
+        // Modulation edges (mh_graph_connect_modulation): sample each
+        // source buffer at the configured interval (default once per
+        // block), shape and scale into normalized values, and merge
+        // the synthesized points with any staged automation. The
+        // merged list rides the existing mh_process_auto dispatch, so
+        // sub-block points get the same block splitting automation
+        // already does. Staged automation is appended after the
+        // synthesized points, so it wins offset ties (last writer
+        // wins inside mh_process_auto).
+        const MH_ParamChange* eff_chgs = autm.changes;
+        int                   eff_n    = autm.count;
+        if (!n.mod_indices.empty())
+        {
+            n.mod_auto_scratch.clear();
+            int step = g->mod_interval > 0 ? g->mod_interval : nframes;
+            if (step > nframes) step = nframes;
+            if (step < 1) step = 1;
+            for (int mi : n.mod_indices)
+            {
+                const auto& me = g->mod_edges[(size_t) mi];
+                const Node& s  = g->nodes[(size_t) me.src_node];
+                const float* sig = (s.kind == MH_NODE_INPUT)
+                    ? input_buffers[(size_t) s.io_index]
+                                   [(size_t) me.src_channel]
+                    : g->pool_ptrs[(size_t) me.src_node]
+                                  [(size_t) me.src_channel];
+                for (int off = 0; off < nframes; off += step)
+                {
+                    float v = me.base
+                        + me.depth * shapeModValue(me.curve, sig[off]);
+                    if (v < 0.0f) v = 0.0f;
+                    else if (v > 1.0f) v = 1.0f;
+                    MH_ParamChange c;
+                    c.sample_offset = off;
+                    c.param_index   = me.param_index;
+                    c.value         = v;
+                    n.mod_auto_scratch.push_back(c);
+                }
+            }
+            if (eff_n > 0)
+                n.mod_auto_scratch.insert(n.mod_auto_scratch.end(),
+                                          eff_chgs, eff_chgs + eff_n);
+            std::stable_sort(
+                n.mod_auto_scratch.begin(), n.mod_auto_scratch.end(),
+                [](const MH_ParamChange& a, const MH_ParamChange& b)
+                { return a.sample_offset < b.sample_offset; });
+            eff_chgs = n.mod_auto_scratch.data();
+            eff_n    = (int) n.mod_auto_scratch.size();
+        }
+
+        // Silence-aware skip (mh_graph_set_silence_skip): a plugin fed
+        // silence whose reported tail has rung out writes exact zeros
+        // without a process call. MIDI or automation in flight -- or a
+        // wired MIDI output -- always processes, since events can wake
+        // a plugin from silent audio input. A wired sidechain also
+        // disqualifies: the key signal can be audible in the output
+        // (sidechain-listen modes), so silent main input proves
+        // nothing.
+        if (g->silence_skip.load(std::memory_order_relaxed)
+            && has_main && sc_in == nullptr && eff_n == 0
+            && midi_in_n == 0 && !capture_midi_out)
+        {
+            const bool in_silent = n.input_sources[0].is_silent
+                || blockIsSilent(in_ptrs, in_ch, nframes);
+            if (!in_silent)
+            {
+                n.tail_remaining = -1;  // live; re-query tail on next silence
+            }
+            else
+            {
+                if (n.tail_remaining < 0)
+                    n.tail_remaining = tailBudgetSamples(
+                        mh_get_tail_seconds(n.plugin), g->sample_rate);
+                if (n.tail_remaining > 0)
+                {
+                    n.tail_remaining -= nframes;  // still ringing out
+                }
+                else
+                {
+                    for (int c = 0; c < out_ch; ++c)
+                        std::memset(out_ptrs_raw[c], 0,
+                                    (size_t) nframes * sizeof(float));
+                    break;
+                }
+            }
+        }
+
+        // Double-precision hop (mh_graph_render_block_double): a
+        // double-native plugin processes 64-bit into its shadow-pool
+        // entry, reading upstream doubles directly when the producer
+        // left a tagged entry (or straight from the caller's input
+        // buffers), and widening the already-resolved float pointers
+        // otherwise -- delay lines, silence and float-only upstreams
+        // convert exactly once here. The result is narrowed eagerly
+        // into the float pool so float consumers (mix, pick, freeze,
+        // non-native plugins) stay correct; double consumers keep
+        // reading the tagged shadow entry. MIDI / automation blocks --
+        // and wired sidechains, which only the float dispatch can
+        // route -- fall through to the float dispatch.
+        if (g->rbd_active && n.double_native && sc_in == nullptr
+            && midi_in_n == 0 && eff_n == 0 && !capture_midi_out)
+        {
+            const double* dbl_in[64];
+            const double* const* din = nullptr;
+            if (has_main)
+            {
+                const auto& ref = n.input_sources[0];
+                if (!ref.is_silent && !ref.from_caller
+                    && ref.delay_index < 0 && ref.feedback_index < 0
+                    && g->nodes[(size_t) ref.pool_index].pool_double_valid)
+                {
+                    din = g->dbl_ptrs[(size_t) ref.pool_index].data();
+                }
+                else if (!ref.is_silent && ref.from_caller
+                         && ref.delay_index < 0)
+                {
+                    din = g->rbd_inputs[(size_t) ref.caller_index];
+                }
+                else
+                {
+                    for (int c = 0; c < in_ch; ++c)
+                    {
+                        double* d = n.dbl_in_scratch.data()
+                                    + (size_t) c * g->max_block_size;
+                        const float* s = in_ptrs[c];
+                        for (int i = 0; i < nframes; ++i) d[i] = s[i];
+                        dbl_in[c] = d;
+                    }
+                    din = dbl_in;
+                }
+            }
+            double* const* dout = g->dbl_ptrs[(size_t) id].data();
+            int dr;
+            if (wd_ns > 0)
+                dr = superviseNodeCall(
+                    g, id,
+                    [&]() -> int
+                    { return mh_process_double(n.plugin, din, dout,
+                                               nframes); },
+                    wd_ns);
+            else
+                dr = mh_process_double(n.plugin, din, dout, nframes);
+            if (dr < 0)
+            {
+                // Watchdog trip: structured failure -- silence out and
+                // the render carries on (the failed-node check above
+                // keeps the plugin untouched from here on).
+                for (int c = 0; c < out_ch; ++c)
+                    std::memset(out_ptrs_raw[c], 0,
+                                (size_t) nframes * sizeof(float));
+                break;
+            }
+            if (!dr)
+                return 0;
+            {
+                // Per-node wet/dry (mh_graph_set_node_mix): blend in
+                // 64-bit before narrowing so float and double consumers
+                // see the same signal. Set-time eligibility guarantees
+                // in_ch == out_ch and a live input, so din is valid.
+                const float mix = bitsToFloat(
+                    g->node_mix[(size_t) id].load(std::memory_order_relaxed));
+                if (mix < 1.0f)
+                {
+                    const double wg = mix, dg = 1.0 - (double) mix;
+                    for (int c = 0; c < out_ch; ++c)
+                    {
+                        double*       w = dout[c];
+                        const double* d = din[c];
+                        for (int i = 0; i < nframes; ++i)
+                            w[i] = wg * w[i] + dg * d[i];
+                    }
+                }
+            }
+            for (int c = 0; c < out_ch; ++c)
+            {
+                const double* s = dout[c];
+                float*       d = out_ptrs_raw[c];
+                for (int i = 0; i < nframes; ++i) d[i] = (float) s[i];
+            }
+            n.pool_double_valid = true;
+            break;
+        }
+
+        // Oversampling wrap (mh_graph_add_plugin_oversampled): the
+        // plugin sees factor * nframes frames at factor * the graph
+        // rate. Inputs are polyphase-upsampled into the node's
+        // preallocated scratch, the process dispatch below runs
+        // unchanged on the redirected pointers, and the output is
+        // filtered back down afterwards. MIDI and automation offsets
+        // scale up on the way in (and back down on the way out).
+        const float* const*   proc_in   = in_ptrs;
+        float* const*         proc_out  = out_ptrs_raw;
+        int                   proc_n    = nframes;
+        const MH_ParamChange* auto_chgs = eff_chgs;
+        int                   auto_n    = eff_n;
+        if (n.oversample_factor > 1)
+        {
+            const int F = n.oversample_factor;
+            for (int c = 0; c < in_ch; ++c)
+                oversampleUp(n,
+                             n.os_up_hist.data()
+                                 + (size_t) c * n.os_up_hist_len,
+                             in_ptrs[c], nframes,
+                             n.os_in_buf.data()
+                                 + (size_t) c * F * g->max_block_size);
+            proc_in  = n.os_in_ptrs.data();
+            proc_out = n.os_out_ptrs.data();
+            proc_n   = F * nframes;
+            if (midi_in_n > 0)
+            {
+                n.os_midi_scratch.assign(midi_in_evts,
+                                         midi_in_evts + midi_in_n);
+                for (auto& e : n.os_midi_scratch) e.sample_offset *= F;
+                midi_in_evts = n.os_midi_scratch.data();
+            }
+            if (auto_n > 0)
+            {
+                n.os_auto_scratch.assign(auto_chgs, auto_chgs + auto_n);
+                for (auto& a : n.os_auto_scratch) a.sample_offset *= F;
+                auto_chgs = n.os_auto_scratch.data();
+            }
+        }
+
+        auto dispatch = [&]() -> int
+        {
+            if (sc_in != nullptr)
+            {
+                // Wired sidechain: route through the sidechain entry
+                // points, which are the only ones that deliver the key
+                // signal. Staged automation degrades to block-rate here
+                // (applied up front via mh_set_param; sample offsets are
+                // ignored), and MIDI output cannot be captured -- both
+                // documented on the sidechain section of the header.
+                for (int a = 0; a < auto_n; ++a)
+                    mh_set_param(n.plugin, auto_chgs[a].param_index,
+                                 auto_chgs[a].value);
+                if (midi_in_n > 0)
+                    return mh_process_sidechain_midi(n.plugin, proc_in,
+                                                     proc_out, sc_in, proc_n,
+                                                     midi_in_evts, midi_in_n);
+                return mh_process_sidechain(n.plugin, proc_in, proc_out,
+                                            sc_in, proc_n);
+            }
+            if (auto_n > 0)
+                return mh_process_auto(
+                    n.plugin, proc_in, proc_out, proc_n,
+                    midi_in_evts, midi_in_n,
+                    midi_out_ptr, midi_out_cap,
+                    capture_midi_out ? &midi_out_n : nullptr,
+                    auto_chgs, auto_n);
+            if (capture_midi_out)
+                return mh_process_midi_io(n.plugin, proc_in, proc_out,
+                                          proc_n,
+                                          midi_in_evts, midi_in_n,
+                                          midi_out_ptr, midi_out_cap,
+                                          &midi_out_n);
+            if (midi_in_n > 0)
+                return mh_process_midi(n.plugin, proc_in, proc_out,
+                                       proc_n, midi_in_evts, midi_in_n);
+            return mh_process(n.plugin, proc_in, proc_out, proc_n);
+        };
+        int r;
+        if (wd_ns > 0)
+            r = superviseNodeCall(g, id, dispatch, wd_ns);
+        else
+            r = dispatch();
+        if (r < 0)
+        {
+            // Watchdog trip: structured failure instead of a hung
+            // render -- silence out, no MIDI, and the failed-node
+            // check above keeps the plugin untouched from here on.
+            n.midi_out_count           = 0;
+            n.midi_out_truncated_count = 0;
+            for (int c = 0; c < out_ch; ++c)
+                std::memset(out_ptrs_raw[c], 0,
+                            (size_t) nframes * sizeof(float));
+            break;
+        }
+        if (!r) return 0;
+        if (n.oversample_factor > 1)
+        {
+            const int F = n.oversample_factor;
+            for (int c = 0; c < out_ch; ++c)
+                oversampleDown(n,
+                               n.os_down_hist.data()
+                                   + (size_t) c * (n.os_taps - 1),
+                               n.os_out_buf.data()
+                                   + (size_t) c * F * g->max_block_size,
+                               F * nframes, out_ptrs_raw[c]);
+            if (capture_midi_out)
+                for (int i = 0; i < midi_out_n; ++i)
+                    midi_out_ptr[i].sample_offset /= F;
+        }
+        if (capture_midi_out)
+        {
+            // mh_process_midi_io / mh_process_auto write up to
+            // capacity; we store the (possibly truncated) count
+            // and treat n.midi_out_buf[0..count) as live events.
+            n.midi_out_count           = midi_out_n;
+            n.midi_out_truncated_count = midi_out_n;
+        }
+        {
+            // Per-node wet/dry (mh_graph_set_node_mix): blend the wet
+            // output against the resolved input pointers. No dry copy
+            // is needed -- the plugin rendered into a separate buffer,
+            // so the upstream block is still intact -- and the full-wet
+            // default skips the pass entirely. Set-time eligibility
+            // guarantees in_ch == out_ch on any node with mix < 1.
+            const float mix = bitsToFloat(
+                g->node_mix[(size_t) id].load(std::memory_order_relaxed));
+            if (mix < 1.0f)
+                for (int c = 0; c < out_ch; ++c)
+                    blendWetDry(out_ptrs_raw[c], in_ptrs[c], mix, nframes);
+        }
+        break;
+    }
+
+    case MH_NODE_MIDI_INPUT:
+        // No work at render time. Events live in
+        // n.staged_midi_events for downstream consumers.
+        break;
+
+    case MH_NODE_MIDI_OUTPUT:
+    {
+        // Publish the upstream stream for the drain calls. Graph-owned
+        // sources are aliased, not copied: their buffers stay intact
+        // until the next render_block, which is exactly the window the
+        // get/borrow contract promises.
+        n.midi_out_count           = 0;
+        n.midi_out_truncated_count = 0;
+        n.midi_view_evts           = nullptr;
+        n.midi_view_n              = 0;
+        const MH_NodeId src_id
+            = (!n.midi_srcs.empty()) ? n.midi_srcs[0] : -1;
+        if (src_id < 0) break;
+        const MH_MidiEvent* src_evts = nullptr;
+        int                 src_n    = 0;
+        midiSourceView(g, src_id, &src_evts, &src_n);
+        n.midi_out_truncated_count = src_n;
+        if (g->nodes[(size_t) src_id].kind == MH_NODE_MIDI_INPUT)
+        {
+            // Caller-staged events die when render_block returns, so
+            // they are the one source we still materialize.
+            const int cap = (int) n.midi_out_buf.size();
+            const int to_copy = src_n < cap ? src_n : cap;
+            for (int i = 0; i < to_copy; ++i)
+                n.midi_out_buf[(size_t) i] = src_evts[i];
+            n.midi_out_count = to_copy;
+            n.midi_view_evts = n.midi_out_buf.empty()
+                                   ? nullptr : n.midi_out_buf.data();
+            n.midi_view_n    = to_copy;
+        }
+        else
+        {
+            n.midi_out_count = src_n;
+            n.midi_view_evts = src_evts;
+            n.midi_view_n    = src_n;
+        }
+        break;
+    }
+
+    case MH_NODE_MIDI_PROCESSOR:
+    {
+        n.midi_out_count           = 0;
+        n.midi_out_truncated_count = 0;
+        // Folded into a downstream processor at compile: that node
+        // applies our op inline, nothing to materialize here.
+        if (n.midi_fused_away) break;
+        // Resolve upstream events: the head of the fused chain when
+        // one was built at compile, otherwise port 0 directly.
+        const MH_NodeId src_id = !n.midi_fused_stages.empty()
+            ? n.midi_fused_src
+            : ((!n.midi_srcs.empty()) ? n.midi_srcs[0] : -1);
+        if (src_id < 0 || !n.has_outgoing_midi_edge) break;
+        const MH_MidiEvent* src_evts = nullptr;
+        int src_n = 0;
+        midiSourceView(g, src_id, &src_evts, &src_n);
+
+        // One pass over the events through the monomorphized handlers
+        // (compile step 6b): the two-stage fast path calls one fused
+        // instantiation, longer chains walk their stage list. A stage
+        // returning false drops the event.
+        const int cap = (int) n.midi_out_buf.size();
+        int       w   = 0;
+        const size_t nstages = n.midi_fused_stages.size();
+        const Node* pair_a = nstages == 2
+            ? &g->nodes[(size_t) n.midi_fused_stages[0]]
+            : nullptr;
+        for (int i = 0; i < src_n; ++i)
+        {
+            MH_MidiEvent e = src_evts[i];
+            bool keep;
+            if (n.midi_pair_fn != nullptr && pair_a != nullptr)
+                keep = n.midi_pair_fn(e, *pair_a, n);
+            else if (nstages <= 1)
+                keep = n.midi_op_fn(e, n);
+            else
+            {
+                keep = true;
+                for (MH_NodeId sid : n.midi_fused_stages)
+                {
+                    const Node& st = g->nodes[(size_t) sid];
+                    if (!st.midi_op_fn(e, st))
+                    {
+                        keep = false;
+                        break;
+                    }
+                }
+            }
+            if (keep)
+            {
+                if (w < cap) n.midi_out_buf[(size_t) w] = e;
+                ++w;
+            }
+        }
+        n.midi_out_count           = (w < cap) ? w : cap;
+        n.midi_out_truncated_count = w;
+        break;
+    }
+
+    case MH_NODE_MIDI_MERGE:
+    {
+        n.midi_out_count           = 0;
+        n.midi_out_truncated_count = 0;
+        if (!n.has_outgoing_midi_edge) break;
+        const int cap = (int) n.midi_out_buf.size();
+        // Point the per-port cursors at each source's event run and
+        // verify (cheaply, while walking anyway) that every run is
+        // already time-sorted -- plugins and staged input are, which
+        // lets the k-way merge below replace the per-block sort.
+        const int k = n.num_midi_input_ports;
+        bool runs_sorted = true;
+        for (int port = 0; port < k; ++port)
+        {
+            const MH_MidiEvent* src_evts = nullptr;
+            int src_n = 0;
+            midiSourceView(g, n.midi_srcs[(size_t) port],
+                           &src_evts, &src_n);
+            n.merge_head[(size_t) port] = src_evts;
+            n.merge_end[(size_t) port]  = src_evts + src_n;
+            for (int i = 1; i < src_n; ++i)
+                if (src_evts[i].sample_offset
+                        < src_evts[i - 1].sample_offset)
+                {
+                    runs_sorted = false;
+                    break;
+                }
+        }
+        if (runs_sorted)
+        {
+            // O(total * log k) stable merge, allocation-free (scratch
+            // was sized at compile). Ties on sample_offset keep port
+            // order -- same observable order as the old concatenate-
+            // then-stable-sort, guaranteed bit-reproducible per block.
+            int kept = 0, total = 0;
+            mergeSortedMidi(n.merge_head.data(), n.merge_end.data(), k,
+                            n.merge_tree.data(), n.midi_out_buf.data(),
+                            cap, &kept, &total);
+            n.midi_out_count           = kept;
+            n.midi_out_truncated_count = total;
+            break;
+        }
+        // A source emitted out of order (nothing upstream promises it
+        // never will): fall back to concatenate + stable insertion
+        // sort, which imposes order regardless of input.
+        int w = 0;
+        for (int port = 0; port < k; ++port)
+            for (const MH_MidiEvent* e = n.merge_head[(size_t) port];
+                 e != n.merge_end[(size_t) port]; ++e)
+            {
+                if (w < cap) n.midi_out_buf[(size_t) w] = *e;
+                ++w;
+            }
+        const int kept = (w < cap) ? w : cap;
+        for (int i = 1; i < kept; ++i)
+        {
+            MH_MidiEvent x = n.midi_out_buf[(size_t) i];
+            int j = i - 1;
+            while (j >= 0
+                   && n.midi_out_buf[(size_t) j].sample_offset > x.sample_offset)
+            {
+                n.midi_out_buf[(size_t) (j + 1)] = n.midi_out_buf[(size_t) j];
+                --j;
+            }
+            n.midi_out_buf[(size_t) (j + 1)] = x;
+        }
+        n.midi_out_count           = kept;
+        n.midi_out_truncated_count = w;
+        break;
+    }
+
+    case MH_NODE_MIX:
+    {
+        const int ch = n.output_channels;
+        auto& outvec = g->pool_ptrs[(size_t) id];
+        // The first live input initializes the output (copyScaled; a
+        // single unity-gain source is then one memcpy per channel)
+        // instead of memset-then-accumulate; later inputs FMA on top.
+        bool first = true;
+        for (int port = 0; port < n.num_input_ports; ++port)
+        {
+            const float gain = n.mix_gains[(size_t) port];
+            if (gain == 0.0f) continue;   // muted input contributes nothing
+            const auto& ref = n.input_sources[(size_t) port];
+            const float* const* src
+                = resolveInputPort(g, ref, input_buffers, nframes);
+            for (int c = 0; c < ch; ++c)
+            {
+                if (first)
+                    copyScaled(outvec[(size_t) c], src[c], gain, nframes);
+                else
+                    addScaled(outvec[(size_t) c], src[c], gain, nframes);
+            }
+            first = false;
+        }
+        if (first)   // no live inputs: silence
+            for (int c = 0; c < ch; ++c)
+                std::memset(outvec[(size_t) c], 0,
+                            (size_t) nframes * sizeof(float));
+        break;
+    }
+
+    case MH_NODE_PICK_CHANNEL:
+    {
+        // Aliased: pool_ptrs[id][0] already points at the upstream
+        // channel (compile step 4.5); nothing to copy.
+        if (n.pick_aliased) break;
+
+        const float* const* srcs
+            = resolveInputPort(g, n.input_sources[0], input_buffers, nframes);
+        const float* src = srcs[n.pick_channel_index];
+        float* dst = g->pool_ptrs[(size_t) id][0];
+        std::memcpy(dst, src, (size_t) nframes * sizeof(float));
+        break;
+    }
+
+    case MH_NODE_MERGE_CHANNELS:
+    {
+        auto& outvec = g->pool_ptrs[(size_t) id];
+        for (int port = 0; port < n.num_input_ports; ++port)
+        {
+            const float* const* srcs
+                = resolveInputPort(g, n.input_sources[(size_t) port],
+                                   input_buffers, nframes);
+            std::memcpy(outvec[(size_t) port], srcs[0],
+                        (size_t) nframes * sizeof(float));
+        }
+        break;
+    }
+
+    case MH_NODE_REMAP:
+    {
+        auto& outvec = g->pool_ptrs[(size_t) id];
+        if (n.remap_aliased)
+        {
+            // Mapped channels already point into the upstream pool
+            // entry (compile step 4.5c); only silence channels need
+            // writing, and a pure permutation has none.
+            for (int c = 0; c < n.output_channels; ++c)
+                if (n.remap_map[(size_t) c] < 0)
+                    std::memset(outvec[(size_t) c], 0,
+                                (size_t) nframes * sizeof(float));
+            break;
+        }
+        const float* const* srcs
+            = resolveInputPort(g, n.input_sources[0], input_buffers, nframes);
+        for (int c = 0; c < n.output_channels; ++c)
+        {
+            const int s = n.remap_map[(size_t) c];
+            if (s < 0)
+                std::memset(outvec[(size_t) c], 0,
+                            (size_t) nframes * sizeof(float));
+            else
+                std::memcpy(outvec[(size_t) c], srcs[(size_t) s],
+                            (size_t) nframes * sizeof(float));
+        }
+        break;
+    }
+
+    case MH_NODE_RESAMPLE:
+    {
+        auto& outvec = g->pool_ptrs[(size_t) id];
+        const int    ch   = n.output_channels;
+        const int    cap  = n.resample_capacity;
+        const double step = n.resample_step;
+        for (int s = 0; s < nframes; ++s)
+        {
+            const double    pos = n.resample_read_pos + (double) s * step;
+            const long long i0  = (long long) pos;  // read_pos is never negative
+            if (i0 + 1 >= n.resample_write_pos)
+            {
+                // FIFO underrun: emit silence but keep the timeline
+                // advancing so a late write doesn't time-shift the
+                // source audio.
+                for (int c = 0; c < ch; ++c)
+                    outvec[(size_t) c][s] = 0.0f;
+                continue;
+            }
+            const float t = (float)(pos - (double) i0);
+            for (int c = 0; c < ch; ++c)
+            {
+                const float* ring
+                    = n.resample_fifo.data() + (size_t) c * (size_t) cap;
+                const float a = ring[(size_t)(i0 % cap)];
+                const float b = ring[(size_t)((i0 + 1) % cap)];
+                outvec[(size_t) c][s] = a + t * (b - a);
+            }
+        }
+        n.resample_read_pos += (double) nframes * step;
+        break;
+    }
+
+    case MH_NODE_CONVOLVE:
+    {
+        auto& outvec = g->pool_ptrs[(size_t) id];
+        const float* const* src
+            = resolveInputPort(g, n.input_sources[0], input_buffers, nframes);
+        const int ch = n.output_channels;
+        const int B  = n.conv_part;
+        // nframes may be smaller than the partition hop (and never
+        // larger: B >= max_block_size); stage input until a hop fills,
+        // run it, and pop from the output ring. The ring's one-
+        // partition zero priming keeps pops ahead of the hop cadence
+        // at every split.
+        int done = 0;
+        while (done < nframes)
+        {
+            const int m = std::min(nframes - done, B - n.conv_in_fill);
+            for (int c = 0; c < ch; ++c)
+                std::memcpy(n.conv_in_buf.data() + (size_t) c * B
+                                + n.conv_in_fill,
+                            src[c] + done, (size_t) m * sizeof(float));
+            n.conv_in_fill += m;
+            if (n.conv_in_fill == B)
+            {
+                convolveHop(n);
+                n.conv_in_fill = 0;
+            }
+            for (int c = 0; c < ch; ++c)
+            {
+                const float* ring
+                    = n.conv_out_ring.data() + (size_t) c * 2 * B;
+                float* dst = outvec[(size_t) c] + done;
+                int r = n.conv_out_rd;
+                for (int i = 0; i < m; ++i)
+                {
+                    dst[i] = ring[r];
+                    r = (r + 1) % (2 * B);
+                }
+            }
+            n.conv_out_rd     = (n.conv_out_rd + m) % (2 * B);
+            n.conv_out_avail -= m;
+            done += m;
+        }
+        break;
+    }
+    }
+
+    if (n.freeze_mode == Node::FreezeMode::Recording)
+        recordFrozenBlock(g, n, id, output_buffers, nframes);
+
+    return 1;
+}
+
+// Meter tap (mh_graph_set_node_meter): after a node renders, scan its
+// output for per-channel peak and RMS and publish both through the
+// node's seqlock slot. The scan is one straight-line pass over the
+// block -- a shape the compiler's auto-vectorizer handles -- with no
+// branches on data, no locks and no allocation.
+// 64-bit multiply-xor mix (splitmix64 finalizer). Fast, dependency-free
+// and good enough for render verification -- two genuinely different
+// renders collide with probability ~2^-64 per comparison. Not
+// cryptographic.
+inline unsigned long long mixHash64(unsigned long long h)
+{
+    h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27; h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+// Fold n floats into `seed`, eight raw bytes per mix step plus a
+// four-byte tail. Hashing the bit patterns (not the values) means
+// -0.0 vs +0.0 and differing NaN payloads count as divergence --
+// exactly what a determinism check wants.
+inline unsigned long long hashSamples(const float* s, int n,
+                                      unsigned long long seed)
+{
+    unsigned long long h
+        = seed ^ (0x9e3779b97f4a7c15ull * (unsigned long long)(unsigned) n);
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        unsigned long long w;
+        std::memcpy(&w, s + i, sizeof(w));
+        h = mixHash64(h ^ w);
+    }
+    if (i < n)
+    {
+        unsigned w;
+        std::memcpy(&w, s + i, sizeof(w));
+        h = mixHash64(h ^ (unsigned long long) w);
+    }
+    return h;
+}
+
+// Fold one node's rendered output into its verification digest slot
+// (hash mode 2). Source selection mirrors meterTap: output nodes hash
+// what they delivered to the caller, pool-backed nodes hash their pool
+// entry, and the double render path (no float output table) skips
+// nodes whose audio lives in the caller's buffers.
+inline void hashTap(MH_PluginGraph* g, MH_NodeId id,
+                    const float* const* const* input_buffers,
+                    float* const* const* output_buffers,
+                    int nframes)
+{
+    const Node& n = g->nodes[(size_t) id];
+    if (n.freeze_elided) return;    // rendered nothing this block
+
+    const float* const* src = nullptr;
+    int channels = 0;
+    switch (n.kind)
+    {
+    case MH_NODE_MIDI_INPUT:
+    case MH_NODE_MIDI_OUTPUT:
+    case MH_NODE_MIDI_PROCESSOR:
+    case MH_NODE_MIDI_MERGE:
+        return;                     // no audio to hash
+    case MH_NODE_INPUT:
+        src      = input_buffers[(size_t) n.io_index];
+        channels = n.output_channels;
+        break;
+    case MH_NODE_OUTPUT:
+        if (output_buffers == nullptr) return;
+        src      = output_buffers[(size_t) n.io_index];
+        channels = n.input_channels;
+        break;
+    default:
+        if (n.out_to_caller)
+        {
+            if (output_buffers == nullptr) return;
+            src = output_buffers[(size_t) n.out_caller_index];
+        }
+        else
+        {
+            src = g->pool_ptrs[(size_t) id].data();
+        }
+        channels = n.output_channels;
+        break;
+    }
+    if (channels <= 0 || nframes <= 0) return;
+
+    auto& slot = g->node_digests[(size_t) id];
+    unsigned long long h = slot.load(std::memory_order_relaxed);
+    for (int c = 0; c < channels; ++c)
+        h = hashSamples(src[c], nframes, h);
+    slot.store(h, std::memory_order_relaxed);
+}
+
+inline void meterTap(MH_PluginGraph* g, MH_NodeId id,
+                     const float* const* const* input_buffers,
+                     float* const* const* output_buffers,
+                     int nframes)
+{
+    const Node& n = g->nodes[(size_t) id];
+    if (n.freeze_elided) return;    // rendered nothing this block
+
+    // Where did this node's audio land? Output nodes meter what they
+    // delivered to the caller (valid whether or not the copy was
+    // elided); pool-backed nodes meter their pool entry -- aliased
+    // pick / bypass pointers still reference the right samples. The
+    // double render path passes no float output table, so nodes whose
+    // audio lives in the caller's buffers are skipped there.
+    const float* const* src = nullptr;
+    int channels = 0;
+    switch (n.kind)
+    {
+    case MH_NODE_MIDI_INPUT:
+    case MH_NODE_MIDI_OUTPUT:
+    case MH_NODE_MIDI_PROCESSOR:
+    case MH_NODE_MIDI_MERGE:
+        return;                     // no audio to meter
+    case MH_NODE_INPUT:
+        src      = input_buffers[(size_t) n.io_index];
+        channels = n.output_channels;
+        break;
+    case MH_NODE_OUTPUT:
+        if (output_buffers == nullptr) return;
+        src      = output_buffers[(size_t) n.io_index];
+        channels = n.input_channels;
+        break;
+    default:
+        if (n.out_to_caller)
+        {
+            if (output_buffers == nullptr) return;
+            src = output_buffers[(size_t) n.out_caller_index];
+        }
+        else
+        {
+            src = g->pool_ptrs[(size_t) id].data();
+        }
+        channels = n.output_channels;
+        break;
+    }
+    if (channels > kMeterMaxChannels) channels = kMeterMaxChannels;
+    if (channels <= 0 || nframes <= 0) return;
+
+    float peak[kMeterMaxChannels];
+    float rms [kMeterMaxChannels];
+    for (int c = 0; c < channels; ++c)
+    {
+        const float* s  = src[c];
+        float        pk = 0.0f;
+        float        sum = 0.0f;
+        for (int i = 0; i < nframes; ++i)
+        {
+            const float v = s[i];
+            const float a = v < 0.0f ? -v : v;
+            if (a > pk) pk = a;
+            sum += v * v;
+        }
+        peak[c] = pk;
+        rms[c]  = std::sqrt(sum / (float) nframes);
+    }
+
+    NodeMeter& m = g->meters[(size_t) id];
+    m.seq.fetch_add(1, std::memory_order_release);   // odd  = write in progress
+    for (int c = 0; c < channels; ++c)
+    {
+        m.peak[c] = peak[c];
+        m.rms[c]  = rms[c];
+    }
+    m.seq.fetch_add(1, std::memory_order_release);   // even = write complete
+}
+
+// Timing wrapper around renderNodeImpl: when profiling is on, record
+// this node's render time into its lock-free accumulators; when
+// tracing is on, additionally push one span into the trace ring; when
+// the node's meter tap is on, publish the block's peak / RMS. Runs
+// on whichever thread (caller or pool worker) claimed the node.
+inline int renderNode(MH_PluginGraph* g, MH_NodeId id,
+                      const float* const* const* input_buffers,
+                      float* const* const* output_buffers,
+                      int nframes)
+{
+    const bool profiling = g->profiles != nullptr
+        && g->profiling_enabled.load(std::memory_order_relaxed) != 0;
+    const bool tracing  = g->trace_ring.enabled();
+    const bool metering = g->meters != nullptr
+        && g->meter_flags[(size_t) id].load(std::memory_order_relaxed) != 0;
+    const bool hashing  = g->node_digests != nullptr
+        && g->hash_mode.load(std::memory_order_relaxed) >= 2;
+    if (!profiling && !tracing)
+    {
+        const int ok = renderNodeImpl(g, id, input_buffers, output_buffers,
+                                      nframes);
+        if (ok && metering)
+            meterTap(g, id, input_buffers, output_buffers, nframes);
+        if (ok && hashing)
+            hashTap(g, id, input_buffers, output_buffers, nframes);
+        return ok;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const int ok = renderNodeImpl(g, id, input_buffers, output_buffers, nframes);
+    const auto t1 = std::chrono::steady_clock::now();
+    const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        t1 - t0).count();
+
+    if (profiling)
+    {
+        NodeProfile& np = g->profiles[(size_t) id];
+        np.last_ns.store(ns, std::memory_order_relaxed);
+        np.total_ns.fetch_add(ns, std::memory_order_relaxed);
+        np.blocks.fetch_add(1, std::memory_order_relaxed);
+        np.hist[profileBin(ns)].fetch_add(1, std::memory_order_relaxed);
+        // 1/8-gain EWMA: smooth enough to ignore one spiky block, fast
+        // enough to track a preset change within a few dozen blocks.
+        const long long e = np.ewma_ns.load(std::memory_order_relaxed);
+        np.ewma_ns.store(e == 0 ? ns : e + (ns - e) / 8,
+                         std::memory_order_relaxed);
+        long long prev = np.max_ns.load(std::memory_order_relaxed);
+        while (ns > prev
+               && !np.max_ns.compare_exchange_weak(prev, ns,
+                                                   std::memory_order_relaxed)) {}
+    }
+    if (tracing)
+    {
+        mh_trace::Event e;
+        e.begin_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            t0.time_since_epoch()).count();
+        e.dur_us   = ns / 1000;
+        e.block    = g->trace_block.load(std::memory_order_relaxed);
+        e.track    = (int) id;
+        e.tid      = mh_trace::currentThreadTrack();
+        g->trace_ring.record(e);
+    }
+    if (ok && metering)
+        meterTap(g, id, input_buffers, output_buffers, nframes);
+    if (ok && hashing)
+        hashTap(g, id, input_buffers, output_buffers, nframes);
+    return ok;
+}
+
+} // namespace
+
+void MH_PluginGraph::spawnWorkers()
+{
+    if (num_threads <= 1) return;
+    pool_level_next.reset(new std::atomic<int>[levels.size()]);
+    pool_level_remaining.reset(new std::atomic<int>[levels.size()]);
+    for (size_t k = 0; k < levels.size(); ++k)
+    {
+        pool_level_next[k].store(0, std::memory_order_relaxed);
+        pool_level_remaining[k].store(0, std::memory_order_relaxed);
+    }
+    workers.reserve((size_t)(num_threads - 1));
+    for (int i = 0; i < num_threads - 1; ++i)
+    {
+        workers.emplace_back([this, i]
+        {
+            // Role policy first (priority + any role-wide cpu list),
+            // then the per-graph pin, so mh_graph_set_worker_affinity
+            // overrides the role list when both are configured. Pinning
+            // before any real work keeps first-touch NUMA placement on
+            // the worker's own socket (faulted pages follow the
+            // faulting CPU).
+            mh_thread_policy_apply(MH_THREAD_ROLE_AUDIO_WORKER);
+           #if defined(__linux__)
+            if (!worker_cpus.empty())
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET((unsigned)
+                            worker_cpus[(size_t) i % worker_cpus.size()],
+                        &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            }
+           #else
+            (void) i;
+           #endif
+            workerMain();
+        });
+    }
+}
+
+void MH_PluginGraph::stopWorkers()
+{
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        pool_shutdown = true;
+    }
+    pool_cv.notify_all();
+    for (auto& t : workers) t.join();
+    workers.clear();
+}
+
+void MH_PluginGraph::workerMain()
+{
+    unsigned seen = 0;
+    for (;;)
+    {
+        int level_index;
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            // pool_active filters stale wakeups: a worker that slept
+            // through a whole level must not start draining it after
+            // the render thread has already moved on.
+            pool_cv.wait(lock, [&] {
+                return pool_shutdown
+                    || (pool_active && pool_generation != seen);
+            });
+            if (pool_shutdown) return;
+            seen        = pool_generation;
+            level_index = pool_level_index;
+            ++pool_busy;
+        }
+        drainLevel(level_index);
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            --pool_busy;
+        }
+        pool_done_cv.notify_all();
+    }
+}
+
+void MH_PluginGraph::drainLevel(int level_index)
+{
+    const auto& level = levels[(size_t) level_index];
+    const int   count = (int) level.size();
+    auto& next      = pool_level_next[(size_t) level_index];
+    auto& remaining = pool_level_remaining[(size_t) level_index];
+    for (;;)
+    {
+        const int i = next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= count) break;
+        if (!renderNode(this, level[(size_t) i],
+                        rb_inputs, rb_outputs, rb_nframes))
+            pool_ok.store(0, std::memory_order_relaxed);
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            pool_done_cv.notify_all();
+    }
+}
+
+MH_PluginGraph* MH_GraphExecutor::pick()
+{
+    MH_PluginGraph* best = nullptr;
+    for (MH_PluginGraph* g : active)
+    {
+        const int cap = g->exec_max_workers > 0 ? g->exec_max_workers
+                                                : (int) workers.size();
+        if (g->exec_busy.load(std::memory_order_relaxed) >= cap) continue;
+        const int idx = g->pool_level_index;
+        if (g->pool_level_next[(size_t) idx].load(std::memory_order_relaxed)
+                >= (int) g->levels[(size_t) idx].size())
+            continue;  // level fully claimed; the claimants will finish it
+        if (best == nullptr || g->exec_priority > best->exec_priority)
+            best = g;
+    }
+    return best;
+}
+
+void MH_GraphExecutor::workerMain()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        if (shutdown) return;
+        MH_PluginGraph* g = pick();
+        if (g == nullptr)
+        {
+            cv.wait(lock);
+            continue;
+        }
+        // Read the level index under the executor mutex: the graph
+        // published it before pushing itself onto `active`, and cannot
+        // advance it while exec_busy is nonzero.
+        const int level_index = g->pool_level_index;
+        g->exec_busy.fetch_add(1, std::memory_order_relaxed);
+        lock.unlock();
+        g->drainLevel(level_index);
+        {
+            // Decrement and notify under the graph's pool mutex: the
+            // render thread's wait cannot both observe exec_busy == 0
+            // and destroy the graph before this worker is done
+            // touching it.
+            std::lock_guard<std::mutex> glock(g->pool_mutex);
+            g->exec_busy.fetch_sub(1, std::memory_order_acq_rel);
+            g->pool_done_cv.notify_all();
+        }
+        lock.lock();
+    }
+}
+
+bool MH_PluginGraph::runLevel(int level_index)
+{
+    const auto& level = levels[(size_t) level_index];
+    if (level.empty()) return true;
+    if ((int) level.size() == 1)
+    {
+        // A one-node level gains nothing from a wakeup; render inline.
+        if (!renderNode(this, level[0], rb_inputs, rb_outputs, rb_nframes))
+            pool_ok.store(0, std::memory_order_relaxed);
+    }
+    else if (executor != nullptr)
+    {
+        // Shared-executor path: publish the level, help drain it, then
+        // retract and wait out any shared worker still inside it.
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            pool_level_index = level_index;
+        }
+        {
+            std::lock_guard<std::mutex> elock(executor->mutex);
+            executor->active.push_back(this);
+        }
+        executor->cv.notify_all();
+        drainLevel(level_index);  // the render thread helps
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            auto& remaining = pool_level_remaining[(size_t) level_index];
+            pool_done_cv.wait(lock, [&] {
+                return remaining.load(std::memory_order_acquire) == 0;
+            });
+        }
+        {
+            // Retract before the final busy-wait: once off the active
+            // list no new worker can claim the graph, so exec_busy only
+            // falls from here.
+            std::lock_guard<std::mutex> elock(executor->mutex);
+            auto& a = executor->active;
+            a.erase(std::find(a.begin(), a.end(), this));
+        }
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            pool_done_cv.wait(lock, [&] {
+                return exec_busy.load(std::memory_order_acquire) == 0;
+            });
+        }
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            pool_level_index = level_index;
+            pool_active      = true;
+            ++pool_generation;
+        }
+        pool_cv.notify_all();
+        drainLevel(level_index);  // the render thread helps
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            auto& remaining = pool_level_remaining[(size_t) level_index];
+            // Both conditions matter: remaining == 0 says every node
+            // rendered; pool_busy == 0 says no worker is still inside
+            // drainLevel touching this level's cursor.
+            pool_done_cv.wait(lock, [&] {
+                return remaining.load(std::memory_order_acquire) == 0
+                    && pool_busy == 0;
+            });
+            pool_active = false;
+        }
+    }
+    return pool_ok.load(std::memory_order_relaxed) != 0;
+}
+
+namespace {
+
+// Shared body of mh_graph_render_block / mh_graph_render_block_double.
+// Arguments are pre-validated; for the double entry point,
+// input_buffers is the graph's float staging and output_buffers is
+// null (output nodes write through rbd_outputs instead).
+// Stage the [timeline_frame, timeline_frame + nframes) slice of every
+// node timeline into pending_auto, rebased to block-local offsets,
+// along with one block-rate change per keyframe curve whose value
+// moved this block.
+// Cursor-based forward walk, so a block pays only for the changes it
+// covers -- never for the whole list. A change landing behind the block
+// start (possible only after a seek into the middle of a gap) clamps to
+// offset 0.
+void stageTimelineAutomation(MH_PluginGraph* g, int nframes)
+{
+    const long long start = g->timeline_frame;
+    const long long end   = start + (long long) nframes;
+    for (size_t id = 0; id < g->timeline_auto.size(); ++id)
+    {
+        auto& ta = g->timeline_auto[id];
+        if (ta.changes.empty() && ta.curves.empty())
+            continue;
+        ta.block_scratch.clear();
+        // Curves first: each one is evaluated at the block start
+        // (linear between keyframes, clamped outside the span) and
+        // staged at offset 0 only when its value moved -- a plateau
+        // costs nothing. Staged before the timeline slice so an
+        // explicit timeline event at the same offset wins (last
+        // writer wins inside mh_process_auto).
+        for (auto& cv : ta.curves)
+        {
+            while (cv.cursor < cv.end
+                   && (long long) ta.keyframes[cv.cursor].sample_offset
+                          <= start)
+                ++cv.cursor;
+            float v;
+            if (cv.cursor == cv.begin)
+                v = ta.keyframes[cv.begin].value;      // before first kf
+            else if (cv.cursor == cv.end)
+                v = ta.keyframes[cv.end - 1].value;    // after last kf
+            else
+            {
+                const MH_ParamChange& k0 = ta.keyframes[cv.cursor - 1];
+                const MH_ParamChange& k1 = ta.keyframes[cv.cursor];
+                const double t
+                    = (double) (start - (long long) k0.sample_offset)
+                      / (double) ((long long) k1.sample_offset
+                                  - (long long) k0.sample_offset);
+                v = (float) (k0.value + t * (k1.value - k0.value));
+            }
+            if (!cv.has_last || v != cv.last)
+            {
+                MH_ParamChange c{};
+                c.sample_offset = 0;
+                c.param_index   = cv.param;
+                c.value         = v;
+                ta.block_scratch.push_back(c);
+                cv.last     = v;
+                cv.has_last = true;
+            }
+        }
+        while (ta.cursor < ta.changes.size()
+               && (long long) ta.changes[ta.cursor].sample_offset < end)
+        {
+            MH_ParamChange c = ta.changes[ta.cursor];
+            const long long off = (long long) c.sample_offset - start;
+            c.sample_offset = off < 0 ? 0 : (int) off;
+            ta.block_scratch.push_back(c);
+            ++ta.cursor;
+        }
+        // A node with a timeline owns its automation: stage even an
+        // empty slice so stale per-block staging cannot leak in.
+        g->pending_auto[id].changes
+            = ta.block_scratch.empty() ? nullptr : ta.block_scratch.data();
+        g->pending_auto[id].count = (int) ta.block_scratch.size();
+    }
+    g->timeline_frame = end;
+}
+
+// One governor step, run by the render thread after each block. Engage
+// and release both require their thresholds to hold for a configured
+// number of consecutive blocks (hysteresis: loads inside the band reset
+// both counters), so one spiky block neither sheds a node nor yo-yos a
+// shed node back in. Shedding flips the node's ordinary bypass flag, so
+// everything documented for mh_graph_set_node_bypass (latency-aligned
+// dry path, hard splice at the block edge) applies to governor action
+// too. The callback runs on the render thread and must not block.
+void governBlock(MH_PluginGraph* g,
+                 std::chrono::steady_clock::time_point block_t0,
+                 int nframes, long long deadline_ns)
+{
+    // A caller-supplied deadline is the real budget -- the callback may
+    // have burned part of the period before the graph was reached.
+    const double budget_s = deadline_ns > 0
+        ? (double) deadline_ns / 1e9
+        : (double) nframes / g->sample_rate;
+    const double elapsed_s
+        = std::chrono::duration_cast<std::chrono::duration<double>>(
+              std::chrono::steady_clock::now() - block_t0).count();
+    const double load = elapsed_s / budget_s;
+    const auto&  cfg  = g->governor_cfg;
+
+    if (load >= cfg.engage_load)
+    {
+        g->governor_under = 0;
+        if (++g->governor_over < cfg.engage_blocks)
+            return;
+        g->governor_over = 0;
+
+        // Shed the lowest-ranked sacrificial node still live. Nodes the
+        // user already bypassed are skipped -- they cost nothing.
+        MH_NodeId pick = -1;
+        int       best = INT_MAX;
+        for (int i = 0; i < g->shed_order_count; ++i)
+        {
+            const int rank = g->shed_order[(size_t) i]
+                                 .load(std::memory_order_relaxed);
+            if (rank < 0 || rank >= best)
+                continue;
+            if (g->bypass_flags[(size_t) i].load(std::memory_order_relaxed))
+                continue;
+            best = rank;
+            pick = (MH_NodeId) i;
+        }
+        if (pick < 0)
+            return;  // nothing left to shed
+        g->bypass_flags[(size_t) pick].store(1, std::memory_order_relaxed);
+        g->governor_stack.push_back(pick);
+        g->governor_shed_count.store((int) g->governor_stack.size(),
+                                     std::memory_order_relaxed);
+        if (g->governor_cb)
+            g->governor_cb(pick, MH_GOVERNOR_SHED, load, g->governor_user);
+    }
+    else if (load <= cfg.release_load)
+    {
+        g->governor_over = 0;
+        if (g->governor_stack.empty())
+        {
+            g->governor_under = 0;
+            return;
+        }
+        if (++g->governor_under < cfg.release_blocks)
+            return;
+        g->governor_under = 0;
+
+        // Restore the most recently shed node first.
+        const MH_NodeId node = g->governor_stack.back();
+        g->governor_stack.pop_back();
+        g->bypass_flags[(size_t) node].store(0, std::memory_order_relaxed);
+        g->governor_shed_count.store((int) g->governor_stack.size(),
+                                     std::memory_order_relaxed);
+        if (g->governor_cb)
+            g->governor_cb(node, MH_GOVERNOR_RESTORE, load, g->governor_user);
+    }
+    else
+    {
+        // Inside the hysteresis band: hold current state.
+        g->governor_over  = 0;
+        g->governor_under = 0;
+    }
+}
+
+int renderBlockImpl(MH_PluginGraph* g,
+                    const float* const* const* input_buffers,
+                    float* const* const* output_buffers,
+                    int nframes, long long deadline_ns)
+{
+    // Audits the calling thread only; pool workers render inside the
+    // audited mh_process calls of their plugin nodes, which have their
+    // own scope markers.
+    MhRtAuditScope rtAuditScope;
+
+    // FTZ/DAZ for the built-in nodes rendered on this thread; plugin
+    // nodes scope (and count) their own inside mh_process.
+    MhDenormalScope denormalScope(true);
+
+    mh_metric_add(g_graph_blocks_metric.load(std::memory_order_relaxed), 1);
+    MhEventLogBlockScope logBlockScope(3, (unsigned) nframes);
+
+    const bool profiling = g->profiles != nullptr
+        && g->profiling_enabled.load(std::memory_order_relaxed) != 0;
+    const bool governing = g->shed_order != nullptr
+        && g->governor_enabled.load(std::memory_order_relaxed) != 0
+        && g->sample_rate > 0.0;
+    std::chrono::steady_clock::time_point block_t0;
+    if (profiling || governing || deadline_ns > 0)
+        block_t0 = std::chrono::steady_clock::now();
+    if (g->trace_ring.enabled())
+        g->trace_block.fetch_add(1, std::memory_order_relaxed);
+
+    stageTimelineAutomation(g, nframes);
+
+    bool ok = true;
+    if (g->workers.empty() && g->executor == nullptr)
+    {
+        // Serial path: walk the flat topological schedule.
+        for (MH_NodeId id : g->schedule)
+            if (!renderNode(g, id, input_buffers, output_buffers, nframes))
+            { ok = false; break; }
+    }
+    else
+    {
+        // Level-parallel path. Each level is drained by the pool with
+        // the calling thread participating, then acts as a barrier
+        // before the next level starts.
+        g->rb_inputs  = input_buffers;
+        g->rb_outputs = output_buffers;
+        g->rb_nframes = nframes;
+        for (size_t k = 0; k < g->levels.size(); ++k)
+        {
+            g->pool_level_next[k].store(0, std::memory_order_relaxed);
+            g->pool_level_remaining[k].store((int) g->levels[k].size(),
+                                             std::memory_order_relaxed);
+        }
+        g->pool_ok.store(1, std::memory_order_relaxed);
+        for (size_t k = 0; k < g->levels.size(); ++k)
+            if (!g->runLevel((int) k)) { ok = false; break; }
+        g->rb_inputs  = nullptr;
+        g->rb_outputs = nullptr;
+        g->rb_nframes = 0;
+    }
+    if (!ok) return 0;
+
+    // Feedback edges: capture each source node's pool output into the
+    // edge's holding buffer now that the whole walk is done, so every
+    // consumer this block read the previous one. When blocks vary in
+    // length only the first min(previous, current) frames of the loop
+    // signal are fresh; drive at a fixed block size for time-exact
+    // loops.
+    for (size_t f = 0; f < g->feedback_edges.size(); ++f)
+    {
+        const auto& e  = g->feedback_edges[f];
+        const auto& sp = g->pool_ptrs[(size_t) e.src_node];
+        for (int c = 0; c < e.channels; ++c)
+            std::memcpy(g->fb_ptrs[f][(size_t) c], sp[(size_t) c],
+                        (size_t) nframes * sizeof(float));
+    }
+
+    // Verification hashing: fold this block's caller-visible output
+    // into the running render digest. Channel-major in output-node
+    // order, so two runs that delivered identical samples in identical
+    // block sequences end with identical digests. The double path
+    // passes no float output table and is not hashed.
+    if (g->hash_mode.load(std::memory_order_relaxed) > 0
+        && output_buffers != nullptr)
+    {
+        unsigned long long h
+            = g->render_digest.load(std::memory_order_relaxed);
+        for (MH_NodeId oid : g->output_nodes_)
+        {
+            const Node& on = g->nodes[(size_t) oid];
+            const float* const* dst = output_buffers[(size_t) on.io_index];
+            for (int c = 0; c < on.input_channels; ++c)
+                h = hashSamples(dst[c], nframes, h);
+        }
+        g->render_digest.store(h, std::memory_order_relaxed);
+    }
+
+    long long elapsed_ns = -1;
+    if ((profiling && g->sample_rate > 0.0) || deadline_ns > 0)
+        elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - block_t0).count();
+    if (deadline_ns > 0 && elapsed_ns > deadline_ns)
+        g->deadline_misses.fetch_add(1, std::memory_order_relaxed);
+    if (profiling && g->sample_rate > 0.0)
+    {
+        // Xrun attribution: when the whole block overran its real-time
+        // budget, charge it to the slowest node this block. One counter
+        // per node lets a GUI rank offenders directly instead of
+        // guessing from means. A caller-supplied deadline replaces the
+        // derived budget.
+        const long long budget_ns = deadline_ns > 0
+            ? deadline_ns
+            : (long long)(1e9 * (double) nframes / g->sample_rate);
+        if (elapsed_ns > budget_ns)
+        {
+            mh_eventlog_record(MH_LOG_XRUN, 3, (unsigned) nframes);
+            MH_NodeId worst    = -1;
+            long long worst_ns = -1;
+            for (size_t i = 0; i < g->nodes.size(); ++i)
+            {
+                const long long ns
+                    = g->profiles[i].last_ns.load(std::memory_order_relaxed);
+                if (ns > worst_ns) { worst_ns = ns; worst = (MH_NodeId) i; }
+            }
+            if (worst >= 0)
+                g->profiles[(size_t) worst].xruns
+                    .fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (governing)
+        governBlock(g, block_t0, nframes, deadline_ns);
+    advanceGraphTransport(g, nframes);
+    // Clear pending MIDI / automation -- callers must re-stage
+    // every block. MIDI_INPUT staging is also borrowed-pointer state
+    // and must be re-staged each block. Note: MIDI_OUTPUT counts are
+    // intentionally preserved until the caller drains them.
+    for (auto& pm : g->pending_midi) { pm.events = nullptr; pm.count = 0; }
+    for (auto& pa : g->pending_auto) { pa.changes = nullptr; pa.count = 0; }
+    for (auto& node : g->nodes)
+    {
+        if (node.kind == MH_NODE_MIDI_INPUT)
+        {
+            node.staged_midi_events = nullptr;
+            node.staged_midi_count  = 0;
+        }
+    }
+    g->last_nframes = nframes;   // pool buffers now hold this many frames
+    return 1;
+}
+
+} // namespace
+
+extern "C" int mh_graph_render_block(MH_PluginGraph* g,
+                                        const float* const* const* input_buffers,
+                                        int num_input_nodes,
                                         float* const* const* output_buffers,
                                         int num_output_nodes,
                                         int nframes)
 {
     if (g == nullptr || !g->compiled) return 0;
-    if (nframes <= 0 || nframes > g->max_block_size) return 0;
-    if (num_input_nodes  != (int) g->input_nodes_.size())  return 0;
-    if (num_output_nodes != (int) g->output_nodes_.size()) return 0;
-    if (num_input_nodes  > 0 && input_buffers  == nullptr) return 0;
-    if (num_output_nodes > 0 && output_buffers == nullptr) return 0;
+    if (nframes <= 0 || nframes > g->max_block_size) return 0;
+    if (num_input_nodes  != (int) g->input_nodes_.size())  return 0;
+    if (num_output_nodes != (int) g->output_nodes_.size()) return 0;
+    if (num_input_nodes  > 0 && input_buffers  == nullptr) return 0;
+    if (num_output_nodes > 0 && output_buffers == nullptr) return 0;
+    return renderBlockImpl(g, input_buffers, output_buffers, nframes, 0);
+}
+
+extern "C" int mh_graph_render_block_deadline(MH_PluginGraph* g,
+                                              const float* const* const* input_buffers,
+                                              int num_input_nodes,
+                                              float* const* const* output_buffers,
+                                              int num_output_nodes,
+                                              int nframes,
+                                              long long deadline_ns)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (nframes <= 0 || nframes > g->max_block_size) return 0;
+    if (deadline_ns < 0) return 0;
+    if (num_input_nodes  != (int) g->input_nodes_.size())  return 0;
+    if (num_output_nodes != (int) g->output_nodes_.size()) return 0;
+    if (num_input_nodes  > 0 && input_buffers  == nullptr) return 0;
+    if (num_output_nodes > 0 && output_buffers == nullptr) return 0;
+    return renderBlockImpl(g, input_buffers, output_buffers, nframes,
+                           deadline_ns);
+}
+
+extern "C" long long mh_graph_get_deadline_misses(MH_PluginGraph* g)
+{
+    if (g == nullptr) return -1;
+    return g->deadline_misses.load(std::memory_order_relaxed);
+}
+
+extern "C" int mh_graph_set_watchdog(MH_PluginGraph* g, int timeout_ms)
+{
+    if (g == nullptr || timeout_ms < 0) return 0;
+    g->watchdog_timeout_ns.store((long long) timeout_ms * 1000000LL,
+                                 std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" long long mh_graph_get_watchdog_trips(MH_PluginGraph* g)
+{
+    if (g == nullptr) return -1;
+    return g->watchdog_trips.load(std::memory_order_relaxed);
+}
+
+extern "C" int mh_graph_get_node_failed(MH_PluginGraph* g, MH_NodeId node)
+{
+    if (g == nullptr || !g->compiled) return -1;
+    if (!inRange(node, (int) g->nodes.size())) return -1;
+    return g->failed_flags[(size_t) node].load(std::memory_order_relaxed)
+        ? 1 : 0;
+}
+
+extern "C" int mh_graph_clear_node_failed(MH_PluginGraph* g, MH_NodeId node)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    g->failed_flags[(size_t) node].store(0, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_set_hashing(MH_PluginGraph* g, int mode)
+{
+    if (g == nullptr) return 0;
+    if (mode < 0 || mode > 2) return 0;
+    // A mode change starts a fresh verification run: zero every digest
+    // so two runs under the same mode compare from the same seed.
+    g->render_digest.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < g->hash_count; ++i)
+        g->node_digests[(size_t) i].store(0, std::memory_order_relaxed);
+    g->hash_mode.store(mode, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_get_hashing(MH_PluginGraph* g)
+{ return g ? g->hash_mode.load(std::memory_order_relaxed) : 0; }
+
+extern "C" unsigned long long mh_graph_get_render_digest(MH_PluginGraph* g)
+{
+    if (g == nullptr) return 0;
+    return g->render_digest.load(std::memory_order_relaxed);
+}
+
+extern "C" int mh_graph_get_node_digest(MH_PluginGraph* g, MH_NodeId node,
+                                        unsigned long long* digest)
+{
+    if (g == nullptr || !g->compiled || digest == nullptr) return 0;
+    if (!inRange(node, g->hash_count)) return 0;
+    *digest = g->node_digests[(size_t) node].load(std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_refresh_priorities(MH_PluginGraph* g)
+{
+    if (g == nullptr || !g->compiled || g->profiles == nullptr) return 0;
+    const size_t N = g->cp_succ.size();
+    std::vector<long long> cost(N, 1);
+    for (size_t i = 0; i < N; ++i)
+    {
+        const long long e
+            = g->profiles[i].ewma_ns.load(std::memory_order_relaxed);
+        if (e > 0) cost[i] = e;
+    }
+    sortLevelsByRemainingCost(g, cost.data());
+    return 1;
+}
+
+extern "C" int mh_graph_render_block_double(MH_PluginGraph* g,
+                                               const double* const* const* input_buffers,
+                                               int num_input_nodes,
+                                               double* const* const* output_buffers,
+                                               int num_output_nodes,
+                                               int nframes)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (!g->double_mode) return 0;
+    if (nframes <= 0 || nframes > g->max_block_size) return 0;
+    if (num_input_nodes  != (int) g->input_nodes_.size())  return 0;
+    if (num_output_nodes != (int) g->output_nodes_.size()) return 0;
+    if (num_input_nodes  > 0 && input_buffers  == nullptr) return 0;
+    if (num_output_nodes > 0 && output_buffers == nullptr) return 0;
+
+    // Narrow the caller's doubles into the float staging once -- the
+    // single graph-input conversion float consumers observe. Nodes on
+    // the double path read the caller's buffers via rbd_inputs and
+    // never see this copy.
+    for (size_t i = 0; i < g->input_nodes_.size(); ++i)
+    {
+        const int ch
+            = g->nodes[(size_t) g->input_nodes_[i]].output_channels;
+        for (int c = 0; c < ch; ++c)
+        {
+            const double* s = input_buffers[i][c];
+            float* d = g->dbl_in_stage[i].data()
+                       + (size_t) c * (size_t) g->max_block_size;
+            for (int k = 0; k < nframes; ++k) d[k] = (float) s[k];
+        }
+    }
+    for (auto& n : g->nodes) n.pool_double_valid = false;
+
+    g->rbd_active  = true;
+    g->rbd_inputs  = input_buffers;
+    g->rbd_outputs = output_buffers;
+    const int ok = renderBlockImpl(
+        g,
+        g->dbl_stage_table.empty() ? nullptr : g->dbl_stage_table.data(),
+        nullptr, nframes, 0);
+    g->rbd_active  = false;
+    g->rbd_inputs  = nullptr;
+    g->rbd_outputs = nullptr;
+    return ok;
+}
+
+extern "C" int mh_graph_get_latency_samples(MH_PluginGraph* g)
+{ return (g && g->compiled) ? g->graph_latency_samples : 0; }
+
+extern "C" int mh_graph_set_profiling(MH_PluginGraph* g, int enabled)
+{
+    if (g == nullptr) return 0;
+    g->profiling_enabled.store(enabled ? 1 : 0, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_get_profiling(MH_PluginGraph* g)
+{ return g ? g->profiling_enabled.load(std::memory_order_relaxed) : 0; }
+
+extern "C" int mh_graph_get_node_stats(MH_PluginGraph* g, MH_NodeId node,
+                                          MH_NodeStats* out_stats)
+{
+    if (g == nullptr || out_stats == nullptr || g->profiles == nullptr)
+        return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+
+    const NodeProfile& np = g->profiles[(size_t) node];
+    const long long blocks = np.blocks.load(std::memory_order_relaxed);
+    out_stats->blocks  = blocks;
+    out_stats->xruns   = np.xruns.load(std::memory_order_relaxed);
+    out_stats->last_us = (double) np.last_ns.load(std::memory_order_relaxed) / 1000.0;
+    out_stats->max_us  = (double) np.max_ns.load(std::memory_order_relaxed) / 1000.0;
+    out_stats->mean_us = blocks > 0
+        ? ((double) np.total_ns.load(std::memory_order_relaxed) / 1000.0)
+              / (double) blocks
+        : 0.0;
+
+    // p99: walk the histogram until 99% of blocks are covered and
+    // report that bin's upper bound (bin b spans [2^b, 2^(b+1)) ns).
+    double p99_us = 0.0;
+    if (blocks > 0)
+    {
+        const long long threshold = blocks - blocks / 100;
+        long long cum = 0;
+        for (int b = 0; b < kProfileHistBins; ++b)
+        {
+            cum += np.hist[b].load(std::memory_order_relaxed);
+            if (cum >= threshold)
+            {
+                p99_us = (double)(1ll << (b + 1)) / 1000.0;
+                break;
+            }
+        }
+    }
+    out_stats->p99_us = p99_us;
+
+    MH_Plugin* plugin = g->nodes[(size_t) node].plugin;
+    out_stats->denormal_hits =
+        plugin != nullptr ? (long long) mh_get_denormal_hits(plugin) : 0;
+    return 1;
+}
+
+extern "C" int mh_graph_reset_node_stats(MH_PluginGraph* g)
+{
+    if (g == nullptr || g->profiles == nullptr) return 0;
+    for (size_t i = 0; i < g->nodes.size(); ++i)
+        g->profiles[i].reset();
+    return 1;
+}
+
+extern "C" int mh_graph_set_tracing(MH_PluginGraph* g, int capacity_events)
+{
+    if (g == nullptr || !g->compiled || capacity_events < 0) return 0;
+    g->trace_ring.resize(capacity_events);
+    g->trace_block.store(0, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_set_silence_skip(MH_PluginGraph* g, int enabled)
+{
+    if (g == nullptr) return 0;
+    // Treat every plugin node's input as live so nothing already ringing
+    // out is cut off by an immediately-silent block after enabling.
+    for (auto& n : g->nodes)
+        n.tail_remaining = -1;
+    g->silence_skip.store(enabled ? 1 : 0, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_set_node_bypass(MH_PluginGraph* g, MH_NodeId node,
+                                           int bypassed)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (!inRange(node, g->bypass_count)) return 0;
+    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
+    g->bypass_flags[(size_t) node].store(bypassed ? 1 : 0,
+                                         std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_get_node_bypass(MH_PluginGraph* g, MH_NodeId node)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (!inRange(node, g->bypass_count)) return 0;
+    return g->bypass_flags[(size_t) node].load(std::memory_order_relaxed)
+           != 0;
+}
+
+extern "C" int mh_graph_set_node_mix(MH_PluginGraph* g, MH_NodeId node,
+                                        float mix)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (!inRange(node, g->node_mix_count)) return 0;
+    const Node& n = g->nodes[(size_t) node];
+    if (n.kind != MH_NODE_PLUGIN) return 0;
+    // The blend reads dry straight from the node's input buffers, so
+    // it needs a live input with matching channel counts: instruments
+    // and width-changing plugins have no dry signal to blend against.
+    if (n.num_input_ports == 0
+        || n.input_channels != n.output_channels) return 0;
+    if (!(mix >= 0.0f && mix <= 1.0f)) return 0;  // rejects NaN too
+    g->node_mix[(size_t) node].store(floatBits(mix),
+                                     std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" float mh_graph_get_node_mix(MH_PluginGraph* g, MH_NodeId node)
+{
+    if (g == nullptr || !g->compiled) return -1.0f;
+    if (!inRange(node, g->node_mix_count)) return -1.0f;
+    return bitsToFloat(
+        g->node_mix[(size_t) node].load(std::memory_order_relaxed));
+}
+
+extern "C" int mh_graph_get_node_sidechain_port(MH_PluginGraph* g,
+                                                   MH_NodeId node)
+{
+    if (g == nullptr) return -1;
+    if (!inRange(node, (int) g->nodes.size())) return -1;
+    return g->nodes[(size_t) node].sidechain_port;
+}
+
+extern "C" int mh_graph_set_node_sacrificial(MH_PluginGraph* g, MH_NodeId node,
+                                                int shed_order)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (!inRange(node, g->shed_order_count)) return 0;
+    if (g->nodes[(size_t) node].kind != MH_NODE_PLUGIN) return 0;
+    if (shed_order < -1) return 0;
+    g->shed_order[(size_t) node].store(shed_order, std::memory_order_relaxed);
+    return 1;
+}
+
+extern "C" int mh_graph_get_node_sacrificial(MH_PluginGraph* g, MH_NodeId node)
+{
+    if (g == nullptr || !g->compiled) return -1;
+    if (!inRange(node, g->shed_order_count)) return -1;
+    return g->shed_order[(size_t) node].load(std::memory_order_relaxed);
+}
+
+extern "C" int mh_graph_set_governor(MH_PluginGraph* g,
+                                        const MH_GovernorConfig* config,
+                                        MH_GraphGovernorCallback callback,
+                                        void* user_data)
+{
+    if (g == nullptr || !g->compiled) return 0;
+
+    MH_GovernorConfig cfg;
+    if (config != nullptr)
+    {
+        cfg = *config;
+        if (!(cfg.engage_load > 0.0) || !(cfg.release_load >= 0.0)) return 0;
+        if (cfg.release_load >= cfg.engage_load) return 0;
+        if (cfg.engage_blocks < 1 || cfg.release_blocks < 1) return 0;
+    }
+    else
+    {
+        cfg.engage_load    = 0.9;
+        cfg.release_load   = 0.6;
+        cfg.engage_blocks  = 8;
+        cfg.release_blocks = 1024;
+    }
+
+    g->governor_cfg   = cfg;
+    g->governor_cb    = callback;
+    g->governor_user  = user_data;
+    g->governor_over  = 0;
+    g->governor_under = 0;
+    g->governor_enabled.store(1, std::memory_order_release);
+    return 1;
+}
+
+extern "C" int mh_graph_clear_governor(MH_PluginGraph* g)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    g->governor_enabled.store(0, std::memory_order_relaxed);
+    // Bring every governor-shed node back; user-set bypass is untouched
+    // (the governor never sheds an already-bypassed node).
+    while (!g->governor_stack.empty())
+    {
+        const MH_NodeId node = g->governor_stack.back();
+        g->governor_stack.pop_back();
+        if (inRange(node, g->bypass_count))
+            g->bypass_flags[(size_t) node].store(0, std::memory_order_relaxed);
+    }
+    g->governor_shed_count.store(0, std::memory_order_relaxed);
+    g->governor_over  = 0;
+    g->governor_under = 0;
+    g->governor_cb    = nullptr;
+    g->governor_user  = nullptr;
+    return 1;
+}
+
+extern "C" int mh_graph_governor_shed_count(MH_PluginGraph* g)
+{
+    if (g == nullptr) return 0;
+    return g->governor_shed_count.load(std::memory_order_relaxed);
+}
+
+extern "C" int mh_graph_set_node_meter(MH_PluginGraph* g, MH_NodeId node,
+                                          int enabled)
+{
+    if (g == nullptr || !g->compiled) return 0;
+    if (!inRange(node, g->meter_count)) return 0;
+    g->meter_flags[(size_t) node].store(enabled ? 1 : 0,
+                                        std::memory_order_relaxed);
+    return 1;
+}
 
-    for (MH_NodeId id : g->schedule)
-    {
-        Node& n = g->nodes[(size_t) id];
+extern "C" int mh_graph_get_node_meter(MH_PluginGraph* g, MH_NodeId node,
+                                          float* peaks, float* rms,
+                                          int max_channels)
+{
+    if (g == nullptr || g->meters == nullptr) return 0;
+    if (!inRange(node, g->meter_count)) return 0;
+    if (g->meter_flags[(size_t) node].load(std::memory_order_relaxed) == 0)
+        return 0;
 
-        switch (n.kind)
-        {
-        case MH_NODE_INPUT:
-            // No work: the buffer lives in the caller; downstream
-            // nodes read straight from input_buffers[io_index].
-            break;
+    const Node& n = g->nodes[(size_t) node];
+    int channels = (n.kind == MH_NODE_OUTPUT) ? n.input_channels
+                                              : n.output_channels;
+    if (channels > kMeterMaxChannels) channels = kMeterMaxChannels;
+    if (channels > max_channels)      channels = max_channels;
+    if (channels <= 0) return 0;
 
-        case MH_NODE_OUTPUT:
+    // Seqlock read, same retry pattern as MH_PlayHead: re-copy if the
+    // rendering thread published mid-read.
+    NodeMeter& m = g->meters[(size_t) node];
+    unsigned seq0, seq1;
+    do {
+        seq0 = m.seq.load(std::memory_order_acquire);
+        for (int c = 0; c < channels; ++c)
         {
-            // Copy from upstream into caller's output buffer.
-            const auto& ref = n.input_sources[0];
-            float* const* dst = output_buffers[(size_t) n.io_index];
-            const int ch = n.input_channels;
-            if (ref.from_caller)
-            {
-                const float* const* src
-                    = input_buffers[(size_t) ref.caller_index];
-                for (int c = 0; c < ch; ++c)
-                    std::memcpy(dst[c], src[c],
-                                (size_t) nframes * sizeof(float));
-            }
-            else
-            {
-                const auto& src = g->pool_ptrs[(size_t) ref.pool_index];
-                for (int c = 0; c < ch; ++c)
-                    std::memcpy(dst[c], src[(size_t) c],
-                                (size_t) nframes * sizeof(float));
-            }
-            break;
+            if (peaks != nullptr) peaks[c] = m.peak[c];
+            if (rms   != nullptr) rms[c]   = m.rms[c];
         }
+        seq1 = m.seq.load(std::memory_order_acquire);
+    } while (seq0 != seq1 || (seq0 & 1));            // retry if torn or mid-write
+    return channels;
+}
 
-        case MH_NODE_PLUGIN:
-        {
-            const int in_ch  = n.input_channels;
-            const int out_ch = n.output_channels;
-
-            // Build planar pointer arrays for mh_process. Instruments
-            // (in_ch == 0, num_input_ports == 0) have no audio input
-            // and skip the input-resolution step entirely; mh_process
-            // accepts a null inputs pointer table in that case.
-            const float* in_ptrs[64];
-            const int kMaxCh = 64;
-            if (in_ch > kMaxCh) return 0;
-            if (n.num_input_ports > 0)
-            {
-                const auto& ref = n.input_sources[0];
-                if (ref.is_silent)
-                {
-                    // Unwired: every channel reads from the shared
-                    // zero-filled silence buffer.
-                    for (int c = 0; c < in_ch; ++c)
-                        in_ptrs[c] = g->silence_buf.data();
-                }
-                else if (ref.from_caller)
-                {
-                    const float* const* src
-                        = input_buffers[(size_t) ref.caller_index];
-                    for (int c = 0; c < in_ch; ++c) in_ptrs[c] = src[c];
-                }
-                else
-                {
-                    const auto& src = g->pool_ptrs[(size_t) ref.pool_index];
-                    for (int c = 0; c < in_ch; ++c)
-                        in_ptrs[c] = src[(size_t) c];
-                }
-            }
+extern "C" int mh_graph_set_node_tap(MH_PluginGraph* g, MH_NodeId node,
+                                        int enabled)
+{
+    if (g == nullptr) return 0;
+    if (g->compiled) return 0;   // elision/alias decisions bake at compile
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    auto& n = g->nodes[(size_t) node];
+    if (n.kind == MH_NODE_INPUT || n.kind == MH_NODE_OUTPUT) return 0;
+    if (n.output_channels <= 0) return 0;   // MIDI-only: no audio to tap
+    n.tapped = enabled != 0;
+    return 1;
+}
 
-            float** out_ptrs_raw = g->pool_ptrs[(size_t) id].data();
-            (void) out_ch;
+extern "C" int mh_graph_borrow_node_audio(MH_PluginGraph* g, MH_NodeId node,
+                                             const float* const** channels_out,
+                                             int* num_channels_out,
+                                             int* num_frames_out)
+{
+    if (channels_out)     *channels_out     = nullptr;
+    if (num_channels_out) *num_channels_out = 0;
+    if (num_frames_out)   *num_frames_out   = 0;
+    if (g == nullptr || !g->compiled) return 0;
+    if (!inRange(node, (int) g->nodes.size())) return 0;
+    if (channels_out == nullptr || num_channels_out == nullptr
+        || num_frames_out == nullptr)
+        return 0;
+    const auto& n = g->nodes[(size_t) node];
+    if (!n.tapped) return 0;
+    const auto& ptrs = g->pool_ptrs[(size_t) node];
+    if (ptrs.empty()) return 0;
+    *channels_out     = (const float* const*) ptrs.data();
+    *num_channels_out = n.output_channels;
+    *num_frames_out   = g->last_nframes;
+    return 1;
+}
 
-            // Resolve MIDI input: incoming MIDI edge (port 0) wins;
-            // otherwise fall back to events staged via set_node_midi
-            // (legacy).
-            const MH_MidiEvent* midi_in_evts = nullptr;
-            int                 midi_in_n    = 0;
-            const MH_NodeId midi_src0
-                = (!n.midi_srcs.empty()) ? n.midi_srcs[0] : -1;
-            if (midi_src0 >= 0)
-            {
-                const Node& s = g->nodes[(size_t) midi_src0];
-                if (s.kind == MH_NODE_MIDI_INPUT)
-                {
-                    midi_in_evts = s.staged_midi_events;
-                    midi_in_n    = s.staged_midi_count;
-                }
-                else
-                {
-                    // Plugin / processor / merge source: events live in
-                    // s.midi_out_buf, populated earlier in topo.
-                    midi_in_evts = s.midi_out_buf.empty()
-                                       ? nullptr : s.midi_out_buf.data();
-                    midi_in_n    = s.midi_out_count;
-                }
-            }
-            else
-            {
-                const auto& pm = g->pending_midi[(size_t) id];
-                midi_in_evts = pm.events;
-                midi_in_n    = pm.count;
-            }
+// ---- Freeze (mh_graph_freeze_node and friends) ----
 
-            // Determine if we need to capture this plugin's MIDI
-            // output (downstream consumer wired up).
-            const bool capture_midi_out
-                = n.produces_midi && n.has_outgoing_midi_edge;
-            MH_MidiEvent* midi_out_ptr = nullptr;
-            int           midi_out_cap = 0;
-            int           midi_out_n   = 0;
-            if (capture_midi_out)
-            {
-                midi_out_ptr = n.midi_out_buf.data();
-                midi_out_cap = (int) n.midi_out_buf.size();
-            }
+namespace {
 
-            const auto& autm = g->pending_auto[(size_t) id];
-            int r;
-            if (autm.count > 0)
-                r = mh_process_auto(
-                        n.plugin, in_ptrs, out_ptrs_raw, nframes,
-                        midi_in_evts, midi_in_n,
-                        midi_out_ptr, midi_out_cap,
-                        capture_midi_out ? &midi_out_n : nullptr,
-                        autm.changes, autm.count);
-            else if (capture_midi_out)
-                r = mh_process_midi_io(n.plugin, in_ptrs, out_ptrs_raw,
-                                       nframes,
-                                       midi_in_evts, midi_in_n,
-                                       midi_out_ptr, midi_out_cap,
-                                       &midi_out_n);
-            else if (midi_in_n > 0)
-                r = mh_process_midi(n.plugin, in_ptrs, out_ptrs_raw,
-                                    nframes, midi_in_evts, midi_in_n);
-            else
-                r = mh_process(n.plugin, in_ptrs, out_ptrs_raw, nframes);
-            if (!r) return 0;
-            if (capture_midi_out)
-            {
-                // mh_process_midi_io / mh_process_auto write up to
-                // capacity; we store the (possibly truncated) count
-                // and treat n.midi_out_buf[0..count) as live events.
-                n.midi_out_count           = midi_out_n;
-                n.midi_out_truncated_count = midi_out_n;
-            }
-            break;
-        }
+// Shared validation for the freeze entry points.
+Node* freezeNodeChecked(MH_PluginGraph* g, MH_NodeId node,
+                        char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr)
+    {
+        setErr(err_buf, err_buf_size, "null graph");
+        return nullptr;
+    }
+    if (!g->compiled)
+    {
+        setErr(err_buf, err_buf_size, "graph not compiled");
+        return nullptr;
+    }
+    if (node < 0 || node >= (MH_NodeId) g->nodes.size())
+    {
+        setErrf(err_buf, err_buf_size, "node id %d out of range", node);
+        return nullptr;
+    }
+    Node& n = g->nodes[(size_t) node];
+    if (n.kind != MH_NODE_PLUGIN && n.kind != MH_NODE_MIX)
+    {
+        setErr(err_buf, err_buf_size,
+               "only plugin and mix nodes can be frozen");
+        return nullptr;
+    }
+    if (n.has_outgoing_midi_edge)
+    {
+        setErr(err_buf, err_buf_size,
+               "cannot freeze a node with a wired MIDI output "
+               "(replay carries audio only)");
+        return nullptr;
+    }
+    return &n;
+}
 
-        case MH_NODE_MIDI_INPUT:
-            // No work at render time. Events live in
-            // n.staged_midi_events for downstream consumers.
-            break;
+} // namespace
 
-        case MH_NODE_MIDI_OUTPUT:
-        {
-            // Copy from upstream MIDI source into our buffer for
-            // caller retrieval via get_midi_output_events.
-            n.midi_out_count           = 0;
-            n.midi_out_truncated_count = 0;
-            const MH_NodeId src_id
-                = (!n.midi_srcs.empty()) ? n.midi_srcs[0] : -1;
-            if (src_id < 0) break;
-            const Node& s = g->nodes[(size_t) src_id];
-            const MH_MidiEvent* src_evts = nullptr;
-            int                 src_n    = 0;
-            if (s.kind == MH_NODE_MIDI_INPUT)
-            {
-                src_evts = s.staged_midi_events;
-                src_n    = s.staged_midi_count;
-            }
-            else
-            {
-                src_evts = s.midi_out_buf.empty()
-                               ? nullptr : s.midi_out_buf.data();
-                src_n    = s.midi_out_count;
-            }
-            n.midi_out_truncated_count = src_n;
-            const int cap = (int) n.midi_out_buf.size();
-            const int to_copy = src_n < cap ? src_n : cap;
-            for (int i = 0; i < to_copy; ++i)
-                n.midi_out_buf[(size_t) i] = src_evts[i];
-            n.midi_out_count = to_copy;
-            break;
-        }
+extern "C" int mh_graph_freeze_node(MH_PluginGraph* g, MH_NodeId node,
+                                    char* err_buf, size_t err_buf_size)
+{
+    Node* n = freezeNodeChecked(g, node, err_buf, err_buf_size);
+    if (n == nullptr) return 0;
+    if (n->freeze_mode != Node::FreezeMode::Idle)
+    {
+        setErr(err_buf, err_buf_size, "node is already frozen");
+        return 0;
+    }
+    n->freeze_cache.clear();
+    n->freeze_cache_nframes.clear();
+    n->freeze_cursor = 0;
+    n->freeze_mode   = Node::FreezeMode::Recording;
+    return 1;
+}
 
-        case MH_NODE_MIDI_PROCESSOR:
-        {
-            n.midi_out_count           = 0;
-            n.midi_out_truncated_count = 0;
-            // Resolve upstream events (port 0).
-            const MH_NodeId src_id
-                = (!n.midi_srcs.empty()) ? n.midi_srcs[0] : -1;
-            if (src_id < 0 || !n.has_outgoing_midi_edge) break;
-            const Node& s = g->nodes[(size_t) src_id];
-            const MH_MidiEvent* src_evts = nullptr;
-            int src_n = 0;
-            if (s.kind == MH_NODE_MIDI_INPUT)
-            {
-                src_evts = s.staged_midi_events;
-                src_n    = s.staged_midi_count;
-            }
-            else
-            {
-                src_evts = s.midi_out_buf.empty()
-                               ? nullptr : s.midi_out_buf.data();
-                src_n    = s.midi_out_count;
-            }
+extern "C" int mh_graph_freeze_finish(MH_PluginGraph* g, MH_NodeId node,
+                                      char* err_buf, size_t err_buf_size)
+{
+    Node* n = freezeNodeChecked(g, node, err_buf, err_buf_size);
+    if (n == nullptr) return 0;
+    if (n->freeze_mode != Node::FreezeMode::Recording)
+    {
+        setErr(err_buf, err_buf_size, "node is not recording a freeze pass");
+        return 0;
+    }
+    if (n->freeze_cache.empty())
+    {
+        setErr(err_buf, err_buf_size,
+               "no blocks recorded (render at least one block between "
+               "freeze_node and freeze_finish)");
+        return 0;
+    }
+    n->freeze_mode       = Node::FreezeMode::Replaying;
+    n->freeze_cursor     = 0;
+    n->freeze_state_hash = upstreamStateHash(g, node);
+    recomputeFreezeElision(g);
+    return 1;
+}
 
-            const auto& p   = n.midi_processor_params;
-            const int   cap = (int) n.midi_out_buf.size();
-            int         w   = 0;
-            auto push = [&](const MH_MidiEvent& e) {
-                if (w < cap) n.midi_out_buf[(size_t) w] = e;
-                ++w;
-            };
-            for (int i = 0; i < src_n; ++i)
-            {
-                MH_MidiEvent e = src_evts[i];
-                const unsigned char status_hi = (unsigned char)(e.status & 0xF0);
-                const int channel             = e.status & 0x0F;
-                const bool is_note_on  = (status_hi == 0x90);
-                const bool is_note_off = (status_hi == 0x80);
-                const bool is_sys      = ((unsigned char) e.status >= 0xF0);
-
-                switch (p.op)
-                {
-                case MH_MIDI_OP_FILTER:
-                {
-                    if (is_sys) { push(e); break; }
-                    // Channel filter applies to all channel-voice messages.
-                    if (((p.channel_mask >> channel) & 1) == 0) break;
-                    // Note range filter only applies to note on/off.
-                    if (is_note_on || is_note_off)
-                    {
-                        const int note = e.data1 & 0x7F;
-                        if (note < p.min_note || note > p.max_note) break;
-                    }
-                    push(e);
-                    break;
-                }
-                case MH_MIDI_OP_TRANSPOSE:
-                {
-                    if (is_note_on || is_note_off)
-                    {
-                        const int new_note
-                            = (e.data1 & 0x7F) + p.transpose_semitones;
-                        if (new_note < 0 || new_note > 127) break;
-                        e.data1 = (unsigned char) new_note;
-                    }
-                    push(e);
-                    break;
-                }
-                case MH_MIDI_OP_VELOCITY_CURVE:
-                {
-                    if (is_note_on && e.data2 > 0)
-                    {
-                        const float norm = (float) (e.data2 & 0x7F) / 127.0f;
-                        const float curved = std::pow(norm,
-                            p.velocity_gamma > 0.0f ? p.velocity_gamma : 1.0f);
-                        int v = (int) std::lround(curved * 127.0f);
-                        if (v < 1)   v = 1;
-                        if (v > 127) v = 127;
-                        e.data2 = (unsigned char) v;
-                    }
-                    push(e);
-                    break;
-                }
-                }
-            }
-            n.midi_out_count           = (w < cap) ? w : cap;
-            n.midi_out_truncated_count = w;
-            break;
-        }
+extern "C" int mh_graph_unfreeze_node(MH_PluginGraph* g, MH_NodeId node,
+                                      char* err_buf, size_t err_buf_size)
+{
+    Node* n = freezeNodeChecked(g, node, err_buf, err_buf_size);
+    if (n == nullptr) return 0;
+    if (n->freeze_mode == Node::FreezeMode::Idle)
+    {
+        setErr(err_buf, err_buf_size, "node is not frozen");
+        return 0;
+    }
+    n->freeze_mode = Node::FreezeMode::Idle;
+    // Swap-to-empty actually releases the cache storage.
+    std::vector<std::vector<float>>().swap(n->freeze_cache);
+    std::vector<int>().swap(n->freeze_cache_nframes);
+    n->freeze_cursor = 0;
+    recomputeFreezeElision(g);
+    return 1;
+}
 
-        case MH_NODE_MIDI_MERGE:
-        {
-            n.midi_out_count           = 0;
-            n.midi_out_truncated_count = 0;
-            if (!n.has_outgoing_midi_edge) break;
-            const int cap = (int) n.midi_out_buf.size();
-            int w = 0;
-            // Concatenate events from each input port, then stable
-            // sort by sample_offset so downstream consumers see a
-            // single ordered stream.
-            for (int port = 0; port < n.num_midi_input_ports; ++port)
-            {
-                const MH_NodeId src_id = n.midi_srcs[(size_t) port];
-                if (src_id < 0) continue;
-                const Node& s = g->nodes[(size_t) src_id];
-                const MH_MidiEvent* src_evts = nullptr;
-                int src_n = 0;
-                if (s.kind == MH_NODE_MIDI_INPUT)
-                {
-                    src_evts = s.staged_midi_events;
-                    src_n    = s.staged_midi_count;
-                }
-                else
-                {
-                    src_evts = s.midi_out_buf.empty()
-                                   ? nullptr : s.midi_out_buf.data();
-                    src_n    = s.midi_out_count;
-                }
-                for (int i = 0; i < src_n; ++i)
-                {
-                    if (w < cap) n.midi_out_buf[(size_t) w] = src_evts[i];
-                    ++w;
-                }
-            }
-            const int kept = (w < cap) ? w : cap;
-            // Stable sort by sample_offset (insertion sort -- typical
-            // event counts per block are small and we want stability).
-            for (int i = 1; i < kept; ++i)
-            {
-                MH_MidiEvent x = n.midi_out_buf[(size_t) i];
-                int j = i - 1;
-                while (j >= 0
-                       && n.midi_out_buf[(size_t) j].sample_offset > x.sample_offset)
-                {
-                    n.midi_out_buf[(size_t) (j + 1)] = n.midi_out_buf[(size_t) j];
-                    --j;
-                }
-                n.midi_out_buf[(size_t) (j + 1)] = x;
-            }
-            n.midi_out_count           = kept;
-            n.midi_out_truncated_count = w;
-            break;
-        }
+extern "C" int mh_graph_freeze_rewind(MH_PluginGraph* g)
+{
+    if (g == nullptr) return 0;
+    for (auto& n : g->nodes)
+        n.freeze_cursor = 0;
+    return 1;
+}
 
-        case MH_NODE_MIX:
-        {
-            const int ch = n.output_channels;
-            auto& outvec = g->pool_ptrs[(size_t) id];
-            for (int c = 0; c < ch; ++c)
-                std::memset(outvec[(size_t) c], 0,
-                            (size_t) nframes * sizeof(float));
-            for (int port = 0; port < n.num_input_ports; ++port)
-            {
-                const auto& ref  = n.input_sources[(size_t) port];
-                const float gain = n.mix_gains[(size_t) port];
-                for (int c = 0; c < ch; ++c)
-                {
-                    const float* s;
-                    if (ref.from_caller)
-                        s = input_buffers[(size_t) ref.caller_index][c];
-                    else
-                        s = g->pool_ptrs[(size_t) ref.pool_index][(size_t) c];
-                    float* dst = outvec[(size_t) c];
-                    for (int i = 0; i < nframes; ++i) dst[i] += s[i] * gain;
-                }
-            }
-            break;
-        }
+extern "C" int mh_graph_freeze_is_stale(MH_PluginGraph* g, MH_NodeId node)
+{
+    if (g == nullptr || !g->compiled) return -1;
+    if (node < 0 || node >= (MH_NodeId) g->nodes.size()) return -1;
+    Node& n = g->nodes[(size_t) node];
+    if (n.freeze_mode != Node::FreezeMode::Replaying) return -1;
+    return upstreamStateHash(g, node) != n.freeze_state_hash ? 1 : 0;
+}
 
-        case MH_NODE_PICK_CHANNEL:
-        {
-            const auto& ref = n.input_sources[0];
-            const float* src;
-            if (ref.from_caller)
-                src = input_buffers[(size_t) ref.caller_index]
-                                   [n.pick_channel_index];
-            else
-                src = g->pool_ptrs[(size_t) ref.pool_index]
-                                  [(size_t) n.pick_channel_index];
-            float* dst = g->pool_ptrs[(size_t) id][0];
-            std::memcpy(dst, src, (size_t) nframes * sizeof(float));
-            break;
-        }
+namespace {
 
-        case MH_NODE_MERGE_CHANNELS:
-        {
-            auto& outvec = g->pool_ptrs[(size_t) id];
-            for (int port = 0; port < n.num_input_ports; ++port)
-            {
-                const auto& ref = n.input_sources[(size_t) port];
-                const float* src;
-                if (ref.from_caller)
-                    src = input_buffers[(size_t) ref.caller_index][0];
-                else
-                    src = g->pool_ptrs[(size_t) ref.pool_index][0];
-                std::memcpy(outvec[(size_t) port], src,
-                            (size_t) nframes * sizeof(float));
-            }
-            break;
-        }
-        }
+const char* nodeKindName(MH_NodeKind kind)
+{
+    switch (kind)
+    {
+        case MH_NODE_PLUGIN:         return "plugin";
+        case MH_NODE_INPUT:          return "input";
+        case MH_NODE_OUTPUT:         return "output";
+        case MH_NODE_MIX:            return "mix";
+        case MH_NODE_PICK_CHANNEL:   return "pick_channel";
+        case MH_NODE_MERGE_CHANNELS: return "merge_channels";
+        case MH_NODE_MIDI_INPUT:     return "midi_input";
+        case MH_NODE_MIDI_OUTPUT:    return "midi_output";
+        case MH_NODE_MIDI_PROCESSOR: return "midi_processor";
+        case MH_NODE_MIDI_MERGE:     return "midi_merge";
+        case MH_NODE_RESAMPLE:       return "resample";
+        case MH_NODE_CONVOLVE:       return "convolve";
+        case MH_NODE_REMAP:          return "remap";
     }
-    // Clear pending MIDI / automation -- callers must re-stage
-    // every block. MIDI_INPUT staging is also borrowed-pointer state
-    // and must be re-staged each block. Note: MIDI_OUTPUT counts are
-    // intentionally preserved until the caller drains them.
-    for (auto& pm : g->pending_midi) { pm.events = nullptr; pm.count = 0; }
-    for (auto& pa : g->pending_auto) { pa.changes = nullptr; pa.count = 0; }
-    for (auto& node : g->nodes)
+    return "node";
+}
+
+} // namespace
+
+extern "C" int mh_graph_trace_dump(MH_PluginGraph* g, const char* path,
+                                      char* err_buf, size_t err_buf_size)
+{
+    if (g == nullptr)
+    { setErr(err_buf, err_buf_size, "null graph"); return 0; }
+    if (!g->trace_ring.enabled())
+    { setErr(err_buf, err_buf_size, "tracing not enabled"); return 0; }
+
+    std::vector<std::string> names;
+    names.reserve(g->nodes.size());
+    for (size_t i = 0; i < g->nodes.size(); ++i)
+        names.push_back("node" + std::to_string(i) + ":"
+                        + nodeKindName(g->nodes[i].kind));
+
+    std::string error;
+    if (!mh_trace::dumpJson(g->trace_ring, names, path, error))
     {
-        if (node.kind == MH_NODE_MIDI_INPUT)
-        {
-            node.staged_midi_events = nullptr;
-            node.staged_midi_count  = 0;
-        }
+        setErr(err_buf, err_buf_size, error.c_str());
+        return 0;
     }
     return 1;
 }
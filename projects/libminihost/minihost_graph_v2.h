@@ -14,18 +14,36 @@
 //     allowed. Fan-in requires an explicit mix node.
 //   - Channel-count validation at connect / compile time.
 //   - Per-node output buffer pool, allocation-free after compile.
+//     Compile elides copies where it can prove them redundant: a
+//     single-fanout plugin edge into an output node renders straight
+//     into the caller's buffer, and pick-channel nodes alias their
+//     upstream pool channel instead of copying it.
 //   - Per-node parameter automation (MH_ParamChange lists) via
-//     mh_graph_set_node_automation.
+//     mh_graph_set_node_automation, and audio-rate modulation edges
+//     onto parameters (mh_graph_connect_modulation).
 //   - MIDI routing: dedicated MIDI_INPUT / MIDI_OUTPUT node kinds and
 //     a separate MIDI edge list (mh_graph_connect_midi). One MIDI
 //     edge per dst node; fan-out allowed. Plugin nodes accept MIDI on
 //     an implicit MIDI input port (when accepts_midi=1) and produce
 //     MIDI on an implicit MIDI output port (when produces_midi=1).
-//   - No latency compensation across fan-in paths.
-//   - No feedback loops.
+//   - Automatic latency compensation: compile queries
+//     mh_get_latency_samples on every plugin node and inserts
+//     ring-buffer delay lines on the shorter paths into each fan-in
+//     point (and across output nodes), so parallel branches stay
+//     sample-aligned. Total graph latency is reported by
+//     mh_graph_get_latency_samples. Latency is sampled once at
+//     compile; plugins whose latency changes afterwards are not
+//     re-compensated.
+//   - No delay-free feedback loops. Loops are expressed with
+//     explicit single-block-delay edges (mh_graph_connect_feedback).
 //
 // Threading:
 //   - mh_graph_render_block: audio-thread-only, no internal lock.
+//     With mh_graph_set_num_threads(n > 1), render_block dispatches
+//     independent nodes of the same topological level onto a worker
+//     pool spawned at compile time (allocation-free per block). The
+//     caller's thread participates in the work, so n == 1 and the
+//     unset default are exactly the old serial path.
 //   - All other functions: thread-safe (do not call concurrently
 //     with render_block on the same graph).
 //
@@ -54,6 +72,9 @@ typedef enum MH_NodeKind {
     MH_NODE_MERGE_CHANNELS  = 7,
     MH_NODE_MIDI_PROCESSOR  = 8,
     MH_NODE_MIDI_MERGE      = 9,
+    MH_NODE_RESAMPLE        = 10,
+    MH_NODE_CONVOLVE        = 11,
+    MH_NODE_REMAP           = 12,
 } MH_NodeKind;
 
 typedef enum MH_MidiOp {
@@ -77,6 +98,10 @@ typedef enum MH_MidiOp {
 //   data2 := round(pow(data2/127, velocity_gamma) * 127), clamped
 //   to [1, 127]. Note On with velocity=0 (a Note Off in disguise)
 //   passes through unchanged.
+//
+// The curve and the note-range test are precomputed into per-node
+// tables when the params are set, so rendering a processor is table
+// reads only -- no transcendental math in the audio path.
 typedef struct MH_MidiProcessorParams {
     MH_MidiOp op;
     // FILTER:
@@ -113,6 +138,21 @@ void mh_graph_close(MH_PluginGraph* g);
 MH_NodeId mh_graph_add_plugin(MH_PluginGraph* g, MH_Plugin* p,
                                  char* err_buf, size_t err_buf_size);
 
+// Like mh_graph_add_plugin, but wraps just this node in polyphase
+// 2x/4x oversampling: inputs are upsampled, the plugin processes
+// factor * nframes frames per block, and the output is filtered back
+// down. Lets an aliasing-prone saturator run at 96k/192k without
+// oversampling the whole project. factor must be 1 (plain add), 2 or
+// 4, and the caller must have prepared the plugin at factor * the
+// graph's sample rate and factor * max_block_size -- the graph cannot
+// verify either. All filter state is preallocated at add time. The
+// wrapper's FIR group delay plus the plugin's own (oversampled-rate)
+// latency feed the compile-time compensation pass. MIDI and
+// automation sample offsets are scaled both ways.
+MH_NodeId mh_graph_add_plugin_oversampled(MH_PluginGraph* g, MH_Plugin* p,
+                                             int factor,
+                                             char* err_buf, size_t err_buf_size);
+
 // Add an input node: produces `channels` channels from a caller-
 // supplied buffer at render time.
 MH_NodeId mh_graph_add_input(MH_PluginGraph* g, int channels,
@@ -155,6 +195,88 @@ MH_NodeId mh_graph_add_pick_channel(MH_PluginGraph* g,
 MH_NodeId mh_graph_add_merge_channels(MH_PluginGraph* g, int out_channels,
                                          char* err_buf, size_t err_buf_size);
 
+// Add a channel-remap node: output channel i carries input channel
+// channel_map[i], or silence when channel_map[i] is -1. Source
+// channels may repeat (duplication) and need not all be used, so one
+// node covers reordering, duplication, and width changes that would
+// otherwise take a ladder of pick_channel + merge_channels hops --
+// each hop a full buffer copy through the pool. Wide stem layouts
+// are the motivating case: a 32-channel reorder is one node.
+//
+// Compile lowers the node to the minimal work: when the input comes
+// from a pool source (not a caller buffer, feedback edge, or delay
+// line), every mapped output channel aliases the upstream channel
+// pointer outright and the render step only zero-fills the silence
+// channels -- a pure permutation costs nothing per block.
+//
+// `channel_map` points at `out_channels` ints; the array is copied.
+//
+// Topology:
+//   - One input port (port 0): in_channels channels.
+//   - One output port (port 0): out_channels channels.
+MH_NodeId mh_graph_add_remap(MH_PluginGraph* g, int in_channels,
+                                const int* channel_map, int out_channels,
+                                char* err_buf, size_t err_buf_size);
+
+// Add a sample-rate-converter source node. The node has no input
+// ports: the caller streams source-rate frames into its FIFO with
+// mh_graph_resample_write, and every render_block the node emits
+// exactly nframes graph-rate frames drawn from the FIFO by linear
+// interpolation (the same algorithm class the offline
+// mh_audio_resample path uses). This lets a 44.1k file feed a 48k
+// graph in one pass -- no offline resample round-trip -- with all
+// storage preallocated here (four graph blocks of source audio), so
+// the render path never allocates.
+//
+// Top the FIFO up once per block: mh_graph_resample_frames_needed
+// says how many source frames the next render needs; an underrun
+// emits silence for the missing samples but keeps the source
+// timeline advancing, so late writes don't time-shift the audio.
+// Write from the rendering thread between blocks (same contract as
+// the MIDI / automation staging calls).
+MH_NodeId mh_graph_add_resample(MH_PluginGraph* g, int channels,
+                                   double source_rate,
+                                   char* err_buf, size_t err_buf_size);
+
+// Append num_frames source-rate frames (planar, frames[c][i],
+// num_channels pointers) to a resample node's FIFO. Returns 1 on
+// success, 0 on failure (bad node, channel-count mismatch, or the
+// write would overrun unread audio -- the FIFO holds four graph
+// blocks' worth of source frames).
+int mh_graph_resample_write(MH_PluginGraph* g, MH_NodeId node,
+                               const float* const* frames,
+                               int num_channels, int num_frames);
+
+// Source frames mh_graph_resample_write must supply before the next
+// render of `nframes` output frames reads past the FIFO's write
+// position. 0 when already primed; -1 on a bad node.
+long long mh_graph_resample_frames_needed(MH_PluginGraph* g, MH_NodeId node,
+                                             int nframes);
+
+// Add a convolution node: convolves its single input (port 0, which
+// must be wired) with a static impulse response. Replaces a
+// convolution-plugin instance per reverb send with a built-in node --
+// no plugin instantiation, and memory bounded by the IR itself.
+//
+// ir is planar (ir[c][i]); ir_channels must be 1 (the same IR applied
+// to every channel) or equal to channels. The IR is copied -- and
+// transformed -- at add time, so the caller's buffers need not
+// outlive the call. Load IRs with whatever decoder the caller links
+// (mh_audio_read at the CLI/desktop layer); libminihost itself stays
+// decoder-free.
+//
+// Rendering is uniformly partitioned FFT convolution: the IR is split
+// into partitions of one power-of-two block (>= max_block_size), each
+// pre-transformed at add time; per block the node does one forward
+// FFT, a complex multiply-accumulate across the partitions, and one
+// inverse FFT per channel, with zero allocations. The partition
+// buffering adds one partition of latency, reported through the
+// compile-time compensation pass (mh_graph_get_latency_samples).
+MH_NodeId mh_graph_add_convolve(MH_PluginGraph* g, int channels,
+                                   const float* const* ir, int ir_channels,
+                                   int ir_frames,
+                                   char* err_buf, size_t err_buf_size);
+
 // Add a MIDI processor node: applies params.op (filter / transpose /
 // velocity_curve) to events flowing from its single MIDI input port
 // (port 0) to its single MIDI output port. Defaults for unused
@@ -168,14 +290,21 @@ MH_NodeId mh_graph_add_midi_processor(MH_PluginGraph* g,
 // thread reads params each block; updating from another thread
 // while render_block is in flight is undefined (callers should
 // serialize, e.g. via LiveEngine's start/stop or message-thread
-// cadence).
+// cadence). Compile specializes each processor (and fuses stacks of
+// them -- see compileGraph) on its op; this call re-selects the
+// affected handlers, so an op change needs no recompile.
 int mh_graph_set_midi_processor_params(MH_PluginGraph* g, MH_NodeId node,
                                           MH_MidiProcessorParams params);
 
-// Add a MIDI merge node: concatenates events from `num_inputs`
-// separate MIDI input ports (0..num_inputs-1) into one output
-// stream, sorted by sample_offset (stable across ports). The
-// canonical fan-in primitive for MIDI; pair with
+// Add a MIDI merge node: merges events from `num_inputs` separate
+// MIDI input ports (0..num_inputs-1) into one time-ordered output
+// stream. Because each source is already time-sorted, the node runs a
+// k-way tournament merge over preallocated per-node scratch (no
+// per-block sort, no allocation). Ordering is guaranteed stable:
+// events at the same sample_offset come out in port order (port 0
+// first), and events from one port keep their relative order -- so
+// same-offset note-off/note-on interleavings are bit-reproducible
+// across renders. The canonical fan-in primitive for MIDI; pair with
 // mh_graph_connect_midi_port to wire each source.
 MH_NodeId mh_graph_add_midi_merge(MH_PluginGraph* g, int num_inputs,
                                      char* err_buf, size_t err_buf_size);
@@ -210,6 +339,87 @@ int mh_graph_connect(MH_PluginGraph* g,
                         MH_NodeId dst, int dst_port,
                         char* err_buf, size_t err_buf_size);
 
+// Connect src.out -> dst.in[dst_port] through a single-block delay.
+//
+// Ordinary edges must form a DAG -- compile rejects cycles because a
+// delay-free loop has no well-defined render order. A feedback edge
+// is the sanctioned way to close a loop: it is excluded from the
+// topological sort, and the destination port reads the source node's
+// PREVIOUS block (a per-edge holding buffer, preallocated and zeroed
+// at compile, captured after each render walk). Echo and feedback
+// patches therefore run entirely inside mh_graph_render_block instead
+// of an external block-by-block loop copying output back to input.
+//
+// Same validation as mh_graph_connect (ports, channel widths, one
+// edge per (dst_node, dst_port) across both edge kinds), with three
+// differences: self-edges are allowed (a node feeding its own input
+// is the canonical echo patch), the source must be a processing node
+// (not an input or output node), and the edge never receives latency
+// compensation -- the one-block delay is the point. The loop signal's
+// delay equals the previous call's nframes, so drive the graph at a
+// fixed block size for time-exact loops; every compile resets the
+// loop to one block of silence.
+//
+// Returns 1 on success, 0 on failure (err_buf describes the error).
+int mh_graph_connect_feedback(MH_PluginGraph* g,
+                                 MH_NodeId src, int src_port,
+                                 MH_NodeId dst, int dst_port,
+                                 char* err_buf, size_t err_buf_size);
+
+// Shaping curve for a modulation edge (mh_graph_connect_modulation).
+// Applied to the unipolar position u = clamp(0.5 * sample + 0.5, 0, 1)
+// derived from the (nominally bipolar [-1, 1]) source sample.
+typedef enum MH_ModCurve {
+    MH_MOD_CURVE_LINEAR     = 0,  // u
+    MH_MOD_CURVE_SQUARED    = 1,  // u^2 (gentler near the floor)
+    MH_MOD_CURVE_SMOOTHSTEP = 2,  // u^2 * (3 - 2u) (eased endpoints)
+} MH_ModCurve;
+
+// Route an audio signal onto a plugin parameter: src.out[src_channel]
+// modulates dst's parameter param_index. The replacement for feeding
+// LFO-shaped parameter wiggles through mh_graph_set_node_automation as
+// thousands of hand-generated MH_ParamChange entries per second --
+// modulation is a buffer read inside mh_graph_render_block instead of
+// an automation-event flood.
+//
+// Each block the source buffer is sampled every
+// mh_graph_set_modulation_interval frames (default: once per block at
+// offset 0); each sample becomes a normalized parameter value
+//
+//     clamp(base + depth * curve(clamp(0.5 * sample + 0.5, 0, 1)), 0, 1)
+//
+// and the synthesized points are merged with any staged automation and
+// delivered through the normal sample-accurate dispatch, so sub-block
+// points get the same block splitting automation already does. Staged
+// automation wins offset ties. depth may be negative to invert.
+//
+// The source may be an input node (caller-provided LFO buffers are the
+// cheap way to get a modulator) or any audio-producing processing
+// node; the edge participates in topological ordering, so it cannot
+// close a cycle -- route through mh_graph_connect_feedback for
+// feedback-driven modulation. The target must be a plugin node. One
+// edge per (dst, param): reconnecting overwrites.
+//
+// Caveats: a bypassed target drops modulation for the block along with
+// staged MIDI and automation; on a target with a wired sidechain the
+// points degrade to block-rate application (same as staged
+// automation); a modulated node always processes, so the silence skip
+// and the double-precision fast path step aside for it.
+//
+// Returns 1 on success, 0 on failure (err_buf describes the error).
+int mh_graph_connect_modulation(MH_PluginGraph* g,
+                                   MH_NodeId src, int src_channel,
+                                   MH_NodeId dst, int param_index,
+                                   float base, float depth, int curve,
+                                   char* err_buf, size_t err_buf_size);
+
+// Set the modulation sampling interval in frames. 0 (the default)
+// samples once per block; otherwise every `frames` frames starting
+// at offset 0, clamped to the block length at render time. Applies
+// graph-wide. Pre-compile configuration: rejected (returns 0) on a
+// compiled graph -- reopen with mh_graph_begin_edit to change it.
+int mh_graph_set_modulation_interval(MH_PluginGraph* g, int frames);
+
 // Set the per-input gain on a mix node (default 1.0). Linear gain.
 // Returns 1 on success, 0 on failure.
 int mh_graph_set_mix_gain(MH_PluginGraph* g, MH_NodeId mix_node,
@@ -245,16 +455,182 @@ int mh_graph_connect_midi_port(MH_PluginGraph* g,
                                   int dst_port,
                                   char* err_buf, size_t err_buf_size);
 
+// Configure the number of threads mh_graph_render_block uses (default
+// 1 = fully serial on the caller's thread). Must be called before
+// mh_graph_compile; compile spawns num_threads - 1 workers which live
+// until mh_graph_close. The schedule is grouped into topological
+// levels and nodes within a level are claimed atomically by whichever
+// thread is free (the calling thread works too), so wide graphs --
+// mastering buses with many independent branches -- scale across
+// cores while deep serial chains degrade gracefully to the serial
+// path.
+//
+// num_threads is clamped to [1, 64]. Returns 1 on success, 0 on
+// failure (null graph, already compiled).
+int mh_graph_set_num_threads(MH_PluginGraph* g, int num_threads);
+
+// Pin the worker pool to specific CPUs: worker i is bound to
+// cpu_ids[i % count] when it is spawned at compile time. On dual-socket
+// machines pinning all of one graph's workers (and the caller's render
+// thread, which the caller pins itself) to a single socket keeps the
+// buffer-pool arena local: pages are placed by first touch, so a worker
+// that faults them in from a pinned CPU gets node-local memory for
+// every block after.
+//
+// Linux only (pthread_setaffinity_np); the list is stored but inert on
+// other platforms. Must be called before mh_graph_compile; workers are
+// reused across begin_edit/compile cycles so the pinning persists.
+// Passing count == 0 clears the list (no pinning). Returns 1 on
+// success, 0 on failure (null graph, already compiled, null list with
+// count > 0, or a negative cpu id).
+int mh_graph_set_worker_affinity(MH_PluginGraph* g, const int* cpu_ids,
+                                 int count);
+
+// Shared executor: one process-wide worker pool that several graphs
+// submit node work to, instead of each graph spawning its own. A batch
+// service rendering 8 projects concurrently with per-graph pools
+// oversubscribes the machine 8x; with a shared executor the same
+// renders divide the cores between them.
+//
+// Workers claim nodes from whichever attached graph has a level in
+// flight, preferring the graph with the highest priority; each render
+// thread still participates in its own graph's levels, so a graph is
+// never starved outright -- priority and the per-graph cap only govern
+// how the shared workers distribute themselves.
+typedef struct MH_GraphExecutor MH_GraphExecutor;
+
+// Create an executor with num_threads workers (clamped to [1, 64]).
+// The executor must outlive every graph attached to it: close the
+// graphs (or detach them) first, then the executor. Returns NULL on
+// allocation failure.
+MH_GraphExecutor* mh_graph_executor_create(int num_threads);
+
+// Join the workers and free the executor. No graph may be attached or
+// mid-render. NULL is a no-op.
+void mh_graph_executor_close(MH_GraphExecutor* e);
+
+// Attach the graph to a shared executor instead of a private pool.
+// Must be called before mh_graph_compile; tears down any private pool
+// already spawned, and mh_graph_set_num_threads is ignored while
+// attached. priority orders graphs competing for workers (higher
+// first; ties share). max_workers caps how many shared workers drain
+// this graph at once, 0 = no cap beyond the executor's size -- cap a
+// background bounce low so it cannot crowd out a priority render.
+// Pass e == NULL to detach (the next compile spawns a private pool
+// again per mh_graph_set_num_threads).
+//
+// Returns 1 on success, 0 on failure (null graph, already compiled,
+// negative max_workers).
+int mh_graph_set_executor(MH_PluginGraph* g, MH_GraphExecutor* e,
+                          int priority, int max_workers);
+
+// Ask for the buffer-pool arena to be backed by huge pages. The pool
+// is carved from one 64-byte-aligned arena laid out in schedule order;
+// with this enabled the arena is instead aligned to 2 MiB and (on
+// Linux) hinted with madvise(MADV_HUGEPAGE), cutting TLB pressure on
+// large sessions. Best effort: the hint is silently ignored on other
+// platforms or when the arena is smaller than one huge page.
+//
+// Must be called before mh_graph_compile; takes effect at the next
+// compile. Returns 1 on success, 0 on failure (null graph, already
+// compiled).
+int mh_graph_set_pool_huge_pages(MH_PluginGraph* g, int enabled);
+
+// Ask for the buffer-pool arenas (float, and the double shadow pool
+// when double precision is on) to be mlocked at compile so the OS
+// cannot evict them between callbacks -- cold-page faults mid-render
+// are a classic long-tail spike on live systems. Best effort: if
+// mlock is refused (typically RLIMIT_MEMLOCK) the arena stays
+// unlocked and compile proceeds; check mh_graph_get_locked_bytes to
+// see what was actually pinned. Unavailable on Windows (no-op lock).
+// Plugin-internal state is not covered -- pair with mh_warmup /
+// mh_set_lock_memory on the plugin handles for full residency.
+//
+// Must be called before mh_graph_compile; takes effect at the next
+// compile and the lock is released when the arena is reallocated or
+// the graph is closed. Returns 1 on success, 0 on failure (null
+// graph, already compiled).
+int mh_graph_set_lock_memory(MH_PluginGraph* g, int enabled);
+
+// Bytes of arena memory currently pinned by mh_graph_set_lock_memory
+// (0 when the option is off or the lock was refused). Returns -1 on a
+// null graph.
+long long mh_graph_get_locked_bytes(MH_PluginGraph* g);
+
+// Request a double-precision render path. Compile then allocates a
+// 64-bit shadow pool alongside the float pool, with entries for every
+// plugin node that reports mh_supports_double (and is not wrapped by
+// mh_graph_add_plugin_oversampled -- the polyphase wrapper is
+// float32). mh_graph_render_block_double becomes available after the
+// next compile; the float mh_graph_render_block keeps working
+// unchanged.
+//
+// For genuinely native 64-bit processing also put the supporting
+// plugins in double precision (mh_set_processing_precision with
+// MH_PRECISION_DOUBLE) before compiling -- the graph dispatches
+// through mh_process_double either way, but that call converts
+// internally when the plugin was prepared for float.
+//
+// Must be called before mh_graph_compile; takes effect at the next
+// compile. Returns 1 on success, 0 on failure (null graph, already
+// compiled).
+int mh_graph_set_double_precision(MH_PluginGraph* g, int enabled);
+
+// Compiled-schedule snapshot. After a successful compile,
+// mh_graph_export_plan serializes the validated topological schedule
+// into a caller-owned blob (release with mh_graph_plan_free). A later
+// process that rebuilds the same graph shape can hand the blob to
+// mh_graph_set_plan before compiling: compile then verifies the plan
+// against the graph (a shape hash over node kinds, port counts and
+// both edge lists), and on a match skips the connectivity validation
+// and topological sort and adopts the stored schedule directly. The
+// buffer-pool layout, routing and latency plans are still derived at
+// compile (they bind to the live plugin instances and are cheap next
+// to validation + sorting on large graphs).
+//
+// A plan that does not match the current shape (the project was
+// edited) is ignored and compile runs in full -- the plan is an
+// optimization hint, never a correctness input.
+//
+// mh_graph_set_plan must be called before mh_graph_compile; returns 1
+// on success, 0 on failure (null graph/blob, bad size, already
+// compiled). mh_graph_export_plan returns 1 on success, 0 on failure
+// (null arguments, graph not compiled).
+int mh_graph_set_plan(MH_PluginGraph* g, const void* data, int size);
+int mh_graph_export_plan(MH_PluginGraph* g, void** out_data, int* out_size);
+void mh_graph_plan_free(void* data);
+
 // Compile: validate topology (acyclic, all required inputs connected,
 // channel counts match across edges), produce a topological schedule,
 // and allocate the per-node output buffer pool.
 //
 // After compile succeeds, no further add_* / connect calls are
-// permitted (they return 0). Re-compile is not supported in v1.
+// permitted (they return 0) until the graph is reopened with
+// mh_graph_begin_edit.
 //
 // Returns 1 on success, 0 on failure.
 int mh_graph_compile(MH_PluginGraph* g, char* err_buf, size_t err_buf_size);
 
+// Reopen a compiled graph for editing. Between begin_edit and the
+// next successful mh_graph_compile the add_* / connect calls work
+// again and render_block is refused; that compile then runs
+// incrementally: buffer-pool slots whose size is unchanged are zeroed
+// in place rather than reallocated (node kinds and channel counts are
+// fixed at add time, so only nodes added during the edit allocate)
+// and the worker threads stay parked instead of being joined and
+// respawned. This keeps edit-to-audition latency low for interactive
+// editors that rewire one edge at a time.
+//
+// Mix gains (mh_graph_set_mix_gain) and staged automation apply to a
+// compiled graph directly and never need an edit cycle.
+//
+// A failed recompile leaves the graph uncompiled with the edit still
+// open; fix the topology and compile again. Must not overlap a
+// render_block call on another thread.
+//
+// Returns 1 on success, 0 on failure (null graph, not compiled).
+int mh_graph_begin_edit(MH_PluginGraph* g, char* err_buf, size_t err_buf_size);
+
 // Render one block.
 //
 //   input_buffers[i][c] = pointer to the c-th channel of the i-th
@@ -265,7 +641,14 @@ int mh_graph_compile(MH_PluginGraph* g, char* err_buf, size_t err_buf_size);
 //   output node. Each pointer must address writeable storage for at
 //   least nframes frames.
 //
-// nframes must satisfy 0 < nframes <= max_block_size.
+// nframes must satisfy 0 < nframes <= max_block_size. Any size in
+// that range is the fast path on the same compiled graph: the buffer
+// pool and every node's scratch are sized once at max_block_size, so
+// one graph can serve 64-frame live callbacks and 2048-frame offline
+// renders back to back with no recompile, no reallocation and no
+// second instance. Plugin nodes opened with a smaller max_block_size
+// than this graph's are sub-blocked inside their own mh_process call
+// (see minihost.h).
 //
 // Returns 1 on success, 0 on failure (e.g. graph not compiled,
 // nframes out of range, plugin process failure).
@@ -276,6 +659,134 @@ int mh_graph_render_block(MH_PluginGraph* g,
                              int num_output_nodes,
                              int nframes);
 
+// Render one block in double precision. Same buffer layout and
+// nframes contract as mh_graph_render_block, with 64-bit samples.
+//
+// Requires mh_graph_set_double_precision(g, 1) before the compile.
+// Audio stays double across consecutive double-capable plugin hops
+// (and from a graph input or to a graph output wired straight to such
+// a plugin); everywhere else it converts at the node boundary, since
+// the built-in nodes (mix, pick/merge, resample, convolve), the
+// latency-compensation delay lines and plugins without double support
+// process in float32. Each conversion happens at most once per hop --
+// there are no per-node round-trips beyond those boundaries.
+//
+// Returns 1 on success, 0 on failure (graph not compiled, double
+// precision not requested, nframes out of range, plugin process
+// failure).
+int mh_graph_render_block_double(MH_PluginGraph* g,
+                                    const double* const* const* input_buffers,
+                                    int num_input_nodes,
+                                    double* const* const* output_buffers,
+                                    int num_output_nodes,
+                                    int nframes);
+
+// mh_graph_render_block with the audio callback's deadline attached:
+// deadline_ns is the budget remaining for this block, in nanoseconds,
+// measured from the moment of the call (the callback knows how much of
+// its period it already spent before reaching the graph; the derived
+// nframes / sample_rate figure does not). The deadline feeds the
+// overload governor (replacing the derived budget) and the xrun
+// attribution in the profiling counters, and a block that finishes
+// past it increments the miss counter below. deadline_ns == 0 renders
+// exactly like mh_graph_render_block.
+//
+// Same buffer layout, nframes contract and return value as
+// mh_graph_render_block; additionally fails on a negative deadline.
+int mh_graph_render_block_deadline(MH_PluginGraph* g,
+                                   const float* const* const* input_buffers,
+                                   int num_input_nodes,
+                                   float* const* const* output_buffers,
+                                   int num_output_nodes,
+                                   int nframes,
+                                   long long deadline_ns);
+
+// Blocks that finished past the deadline handed to
+// mh_graph_render_block_deadline, cumulative since create. Safe from
+// any thread. Returns -1 on a null graph.
+long long mh_graph_get_deadline_misses(MH_PluginGraph* g);
+
+// Watchdog-supervised plugin processing, for NON-REALTIME rendering
+// only. With a non-zero timeout every plugin process call runs on a
+// supervision thread while the render thread waits it out with the
+// per-call deadline. A call that misses the deadline trips the
+// watchdog: the node is marked failed (sticky), its output is silence
+// from that block on, the trip counter below increments, and
+// render_block returns normally instead of hanging the process -- a
+// plugin stuck on a license server or a deadlocked worker costs one
+// timeout, not the whole job.
+//
+// The tripped call is abandoned on its thread (intentionally leaked:
+// it may still be executing inside the plugin), so a failed node's
+// plugin must not be processed, closed, or otherwise touched until
+// the process exits -- the graph itself honors this via the sticky
+// flag, and mh_graph_clear_node_failed is the explicit override. The
+// abandoned call can also still write into the buffers it was handed:
+// graph-owned pool memory, and, for a node compiled to render straight
+// into a caller buffer, the output array passed to the render_block
+// call that timed out.
+//
+// Supervised calls serialize behind one sentry thread, so
+// multi-worker rendering loses node parallelism while enabled, and
+// every call pays a thread handoff -- this is an isolation mode for
+// render farms, not a realtime feature. timeout_ms = 0 disables (the
+// default). Returns 1 on success, 0 on null graph / negative timeout.
+int mh_graph_set_watchdog(MH_PluginGraph* g, int timeout_ms);
+
+// Watchdog trips since create, cumulative. Safe from any thread.
+// Returns -1 on a null graph.
+long long mh_graph_get_watchdog_trips(MH_PluginGraph* g);
+
+// 1 if the node was failed by a watchdog trip, 0 if live, -1 on bad
+// args (null graph, not compiled, node out of range). Failed flags
+// carry over recompiles the same way bypass flags do.
+int mh_graph_get_node_failed(MH_PluginGraph* g, MH_NodeId node);
+
+// Re-arm a failed node so the next render processes its plugin again.
+// Only safe when the trip was a false positive (a slow-but-finite
+// block): if the abandoned call is genuinely hung, the plugin is still
+// executing it. Returns 1 on success, 0 on bad args.
+int mh_graph_clear_node_failed(MH_PluginGraph* g, MH_NodeId node);
+
+// Render verification hashing. A determinism check normally means
+// rendering twice and diffing full output files; with hashing enabled
+// each render folds its output into a 64-bit running digest instead,
+// so the comparison is two integers and the second run stores nothing.
+//
+//   mode 0  off (the default; hashing costs one pass over the audio)
+//   mode 1  fold each block's caller-visible output (every output
+//           node, channel-major) into the render digest
+//   mode 2  additionally fold every audio node's block output into a
+//           per-node digest, so when two runs diverge the first node
+//           whose digests differ localizes the nondeterministic
+//           plugin in one run instead of a render bisection
+//
+// Digests hash raw sample bits (so -0.0 vs +0.0 and NaN payload
+// differences count as divergence) and depend on the block sequence:
+// compare runs rendered with identical block sizes in identical
+// order. Setting a mode zeroes all digests to start a fresh run;
+// compiling does too (an edited graph is a different render). The
+// float render paths are hashed; mh_graph_render_block_double is not.
+//
+// Returns 1 on success, 0 on null graph or mode outside [0, 2].
+int mh_graph_set_hashing(MH_PluginGraph* g, int mode);
+
+// Current hashing mode, 0 when off or the graph is null.
+int mh_graph_get_hashing(MH_PluginGraph* g);
+
+// Running whole-render digest (modes 1 and 2). 0 on a null graph --
+// and also the value of a fresh run, so compare digests between runs
+// rather than testing against zero. Safe from any thread; only stable
+// between render_block calls.
+unsigned long long mh_graph_get_render_digest(MH_PluginGraph* g);
+
+// Per-node digest (mode 2). Writes the node's running digest into
+// *digest; MIDI-only nodes stay at 0 (they render no audio). Returns
+// 1 on success, 0 on bad args (null graph / digest, not compiled,
+// node out of range).
+int mh_graph_get_node_digest(MH_PluginGraph* g, MH_NodeId node,
+                             unsigned long long* digest);
+
 // Stage sample-accurate parameter automation for a plugin node. The
 // graph borrows the changes pointer until the next render_block call;
 // the caller keeps it alive that long. Cleared after each
@@ -290,6 +801,98 @@ int mh_graph_set_node_automation(MH_PluginGraph* g, MH_NodeId node,
                                     const MH_ParamChange* changes,
                                     int num_changes);
 
+// Stage a whole-render automation timeline for a plugin node. Unlike
+// mh_graph_set_node_automation the offsets are ABSOLUTE sample
+// positions on the render timeline (not block-local), the graph takes
+// its own sorted copy (no borrowed-pointer lifetime to manage), and the
+// timeline persists across render_block calls: each block consumes the
+// slice it covers via a forward cursor, so per-block cost is
+// O(changes this block) no matter how many changes the timeline holds.
+// Built for long offline renders with very large pre-generated change
+// lists -- set once, then just call render_block.
+//
+// The graph's timeline position starts at 0 after compile and advances
+// by nframes per render_block; use mh_graph_seek_automation to rewind
+// or jump. A node with a timeline set owns its automation: per-block
+// mh_graph_set_node_automation staging is ignored for that node.
+// Recompiling clears all timelines (same as other staged state).
+// Pass changes=NULL / num_changes=0 to clear one node's timeline.
+//
+// Returns 1 on success, 0 if node is not a plugin / out of range /
+// graph not compiled.
+int mh_graph_set_node_automation_timeline(MH_PluginGraph* g, MH_NodeId node,
+                                             const MH_ParamChange* changes,
+                                             int num_changes);
+
+// Stage native keyframe automation curves for a plugin node. Like the
+// timeline, keyframes carry ABSOLUTE (sample_offset, param_index,
+// value) positions and the graph takes its own copy -- but storage
+// stays at the keyframes themselves: each parameter's curve is
+// evaluated once per render_block at the block start, linear between
+// keyframes and clamped to the first/last keyframe outside the span
+// (the same semantics as plugin-level keyframe automation). Nothing is
+// ever expanded to a dense change list, so hour-long curves cost a few
+// KB and O(curves) per block. A plateau value is staged once, not
+// every block.
+//
+// Curves ride the same playhead as the timeline (advance per
+// render_block, reposition via mh_graph_seek_automation) and combine
+// with it: an explicit timeline event overrides a curve's value at the
+// same block offset. Pass keyframes=NULL / num_keyframes=0 to clear
+// one node's curves. Recompiling clears all curves.
+//
+// Returns 1 on success, 0 if node is not a plugin / out of range /
+// graph not compiled.
+int mh_graph_set_node_automation_curves(MH_PluginGraph* g, MH_NodeId node,
+                                           const MH_ParamChange* keyframes,
+                                           int num_keyframes);
+
+// Move the automation timeline position to `frame` (absolute samples).
+// Repositions every node timeline's and curve's cursor by binary
+// search. Timeline changes strictly before `frame` will not replay;
+// curves re-establish their value on the first block after the jump.
+// Returns 1 on success, 0 on failure (null graph, not compiled,
+// negative frame).
+int mh_graph_seek_automation(MH_PluginGraph* g, long long frame);
+
+// Like mh_graph_seek_automation, but also reconstruct parameter state
+// at `frame` instead of leaving it wherever the last rendered block
+// put it: every timeline parameter gets its latest value from strictly
+// before `frame`, every curve is evaluated at `frame` (clamped
+// linear), and the results are applied as one batched mh_set_param
+// pass per node -- the state a replay from zero would have left
+// behind, without the replay. Timeline lookups go through a lazily
+// built per-parameter index (the first state seek after a timeline is
+// set pays one O(n log n) sort; every seek after that is a binary
+// search per parameter), so scrubbing an hour-long project costs
+// microseconds per jump. A timeline change exactly at `frame` is not
+// applied here; it fires in the first rendered block, overriding the
+// reconstruction -- exactly as in a replay. Call while no render_block
+// is in flight. Returns 1 on success, 0 on failure (same conditions
+// as mh_graph_seek_automation).
+int mh_graph_seek_automation_state(MH_PluginGraph* g, long long frame);
+
+// Graph-level transport. Publishes ONE shared snapshot (a seqlock
+// cell, see mh_shared_transport_* in minihost.h) that every plugin
+// node's playhead reads, replacing a per-plugin mh_set_transport
+// fan-out from the caller. All current plugin nodes attach on the
+// first call; nodes added during an edit cycle attach at the next
+// compile. Pass NULL to publish "no transport" (nodes stay attached).
+//
+// While transport->is_playing, render_block advances position_samples
+// by its frame count after each block (wrapping inside the loop range
+// when is_looping) and re-derives position_beats from bpm and the
+// graph sample rate -- one seqlock write per block on the render
+// thread, no caller involvement. A later mh_graph_set_transport call
+// overrides the advanced position (e.g. for a seek).
+//
+// Call from the render thread or while no render_block is in flight.
+// mh_graph_close detaches every plugin node it attached.
+//
+// Returns 1 on success, 0 on failure (null graph, allocation).
+int mh_graph_set_transport(MH_PluginGraph* g,
+                              const MH_TransportInfo* transport);
+
 // Stage MIDI events to deliver to a plugin node on the next
 // mh_graph_render_block call. The graph borrows the events
 // pointer until render_block returns; the caller must keep it alive
@@ -335,6 +938,399 @@ int mh_graph_get_midi_output_events(MH_PluginGraph* g, MH_NodeId node,
                                        int capacity,
                                        int* num_events_out);
 
+// Zero-copy variant of mh_graph_get_midi_output_events: points
+// *events_out at the graph's internal event storage for a MIDI_OUTPUT
+// node instead of copying. *num_events_out is the buffered count (the
+// same events a full-capacity get_midi_output_events call would copy;
+// use that function's num_events_out to detect truncation). When the
+// output is fed by a graph-owned producer (plugin, processor, merge)
+// this is a view straight into that producer's per-block buffer -- the
+// stream is never duplicated on its way out of the graph.
+//
+// The pointer stays valid until the next mh_graph_render_block,
+// mh_graph_begin_edit, mh_graph_compile or mh_graph_close, and must be
+// read on the same thread(s) that observe render_block completion --
+// the next render overwrites the storage in place.
+//
+// Returns 1 on success, 0 on failure (null argument, graph not
+// compiled, or node is not a MIDI_OUTPUT).
+int mh_graph_borrow_midi_output_events(MH_PluginGraph* g, MH_NodeId node,
+                                          const MH_MidiEvent** events_out,
+                                          int* num_events_out);
+
+// Total graph latency in samples after compensation: the longest
+// plugin-latency path from any input to any output. All output nodes
+// are delay-aligned to this value by compile. Returns 0 before
+// compile (or for NULL).
+int mh_graph_get_latency_samples(MH_PluginGraph* g);
+
+// ---- Per-node profiling ----
+//
+// When enabled, mh_graph_render_block records each node's render time
+// into lock-free accumulators (fixed-size power-of-two histograms,
+// relaxed atomics, no allocations on the audio path), so a GUI or
+// control thread can poll which node eats the block budget while the
+// graph renders live.
+typedef struct MH_NodeStats {
+    long long blocks;    // blocks rendered since enable / reset
+    long long xruns;     // blocks where the graph as a whole overran
+                         // its real-time budget (nframes / sample_rate)
+                         // and this node was the slowest that block
+    double    last_us;   // most recent block render time, microseconds
+    double    mean_us;   // mean block render time
+    double    p99_us;    // approximate 99th percentile: the upper bound
+                         // of the covering histogram bin (bins are
+                         // power-of-two spaced, so within 2x)
+    double    max_us;    // worst block
+    long long denormal_hits; // for plugin nodes, the plugin's cumulative
+                             // mh_get_denormal_hits count (process calls
+                             // that observed a denormal or flushed an
+                             // underflow); 0 for built-in nodes
+} MH_NodeStats;
+
+// Enable/disable per-node timing. Safe to call from any thread at any
+// time, including while render_block runs; timing takes effect on the
+// next block. Accumulator storage is allocated at compile, so toggling
+// mid-session allocates nothing. Returns 1 on success, 0 for NULL.
+int mh_graph_set_profiling(MH_PluginGraph* g, int enabled);
+int mh_graph_get_profiling(MH_PluginGraph* g);
+
+// Read one node's accumulated stats. Unlike most mh_graph_* functions
+// this IS safe to call concurrently with render_block: every counter
+// is a relaxed atomic, so a reader may catch a block half-recorded --
+// fine for monitoring displays. Returns 1 on success, 0 on bad node
+// id or before compile.
+int mh_graph_get_node_stats(MH_PluginGraph* g, MH_NodeId node,
+                               MH_NodeStats* out_stats);
+
+// Zero every node's accumulators. Same concurrency contract as
+// mh_graph_get_node_stats. Returns 1 on success, 0 before compile.
+int mh_graph_reset_node_stats(MH_PluginGraph* g);
+
+// Re-rank the parallel schedule from measured timings. Compile orders
+// the nodes inside each topological level critical-path-first using
+// unit costs (longest remaining chain in hops), so the pool starts
+// stragglers before cheap leaves instead of idling cores at the level
+// barrier. This call redoes that ranking with each node's timing EWMA
+// from the profiling counters -- run with profiling enabled for a few
+// hundred blocks, then refresh, and the order reflects what the nodes
+// actually cost. Nodes never profiled keep a nominal unit cost.
+//
+// NOT safe concurrently with render_block (it reorders the level
+// lists the claim cursors walk); call it between blocks from the
+// render thread, or stop the render. Cheap enough to repeat whenever
+// the session changes shape. Returns 1 on success, 0 before compile.
+int mh_graph_refresh_priorities(MH_PluginGraph* g);
+
+// ---- Trace export ----
+//
+// Beyond the profiling counters above, the graph can record a full
+// timeline: one begin/duration span per node render, stored in a
+// preallocated ring and written out as Chrome trace-event JSON that
+// loads in chrome://tracing or Perfetto. This answers "which node
+// spiked on which block" across long offline renders, which counters
+// alone cannot.
+
+// Enable tracing with a ring of `capacity_events` spans (oldest spans
+// are overwritten once the ring wraps; size it as nodes * blocks you
+// want to keep). 0 disables and frees the ring. Allocation happens in
+// this call, never on the render path -- but for that reason it must
+// NOT be called concurrently with mh_graph_render_block. Requires
+// compile. Returns 1 on success, 0 for NULL / bad capacity / not
+// compiled.
+int mh_graph_set_tracing(MH_PluginGraph* g, int capacity_events);
+
+// Write the captured spans to `path` as Chrome trace-event JSON. Must
+// not run concurrently with mh_graph_render_block (stop the render or
+// call between blocks). On failure returns 0 and fills err_buf.
+int mh_graph_trace_dump(MH_PluginGraph* g, const char* path,
+                           char* err_buf, size_t err_buf_size);
+
+// ---- Silence-aware skip ----
+
+// Enable/disable silence-aware skipping of plugin nodes (default: off).
+// When enabled, a plugin node whose input block peaks below -160 dBFS
+// and whose reported tail (mh_get_tail_seconds, queried on the
+// live->silent transition) has elapsed is not processed; its pool buffer
+// is zero-filled instead, so downstream nodes see exact silence. Nodes
+// with MIDI or automation staged for the block, or a wired MIDI output,
+// always process. Meant for offline stem renders with long silent
+// stretches; skipped output is exact zeros rather than whatever
+// near-silence the plugin would have produced, so leave it off when
+// bit-exactness against an unskipped render matters. Returns 1 on
+// success, 0 for NULL graph.
+int mh_graph_set_silence_skip(MH_PluginGraph* g, int enabled);
+
+// ---- Per-node bypass ----
+
+// Bypass / un-bypass a plugin node (default: live). RT-safe to flip
+// from any thread; the flag is read once per node render. A bypassed
+// node passes its dry input through without calling the plugin --
+// zero-copy (the node's pool pointers alias the upstream buffer)
+// whenever the node's input and output widths match and no compile-
+// time pointer into its pool entry exists, a copy otherwise. A node
+// whose compiled latency is non-zero instead delays the dry signal by
+// that amount, so A/B toggling stays phase-aligned with the rest of
+// the graph. MIDI and automation staged for a bypassed block are
+// dropped. Requires a compiled graph and a plugin node; returns 1 on
+// success. The toggle itself is not click-free -- the dry/wet signals
+// splice hard at the block boundary.
+int mh_graph_set_node_bypass(MH_PluginGraph* g, MH_NodeId node,
+                                int bypassed);
+
+// 1 if the node is currently bypassed, 0 otherwise (or on a bad
+// node / uncompiled graph).
+int mh_graph_get_node_bypass(MH_PluginGraph* g, MH_NodeId node);
+
+// ---- Per-node wet/dry mix ----
+
+// Set a plugin node's wet/dry mix in [0.0, 1.0] (default: 1.0, full
+// wet). After the node processes, its output is blended in place as
+// out = mix * wet + (1 - mix) * dry, replacing the two-branch
+// mix-node idiom for the common "30% reverb" case without the extra
+// buffer traffic. The dry signal is read straight from the node's
+// already-resolved input buffers -- the plugin renders into a separate
+// buffer, so no dry copy is ever taken, and the full-wet default skips
+// the blend pass entirely. RT-safe to retune from any thread; the
+// value is read once per node render, and a mid-render change lands on
+// the next block. The dry path is not delay-compensated against the
+// plugin's latency (unlike bypass); for latency-heavy plugins build an
+// explicit delay branch instead. Requires a compiled graph and a
+// plugin node whose input and output widths match (instruments have no
+// dry signal); returns 1 on success, 0 otherwise. Values survive a
+// begin_edit/compile cycle the same way bypass flags do.
+int mh_graph_set_node_mix(MH_PluginGraph* g, MH_NodeId node, float mix);
+
+// The node's current mix, or -1.0 on a bad node / uncompiled graph.
+float mh_graph_get_node_mix(MH_PluginGraph* g, MH_NodeId node);
+
+// ---- Sidechain ports ----
+//
+// A plugin opened with a sidechain bus (mh_open_ex with
+// sidechain_in_ch > 0) exposes one extra audio input port on its graph
+// node -- always the highest-numbered one -- carrying the sidechain
+// bus width (mh_get_sidechain_channels). Wire a key signal into it
+// with mh_graph_connect like any other edge: channel counts are
+// validated per port, the edge participates in latency compensation,
+// and at render time the upstream pool (or caller input) buffers feed
+// mh_process_sidechain directly, with no intermediate copy. Left
+// unwired, the port feeds silence, matching the plugin's own
+// unwired-sidechain behavior. This replaces the per-block
+// mh_process_sidechain driving loop for ducking/keying topologies.
+//
+// Caveats on a node whose sidechain port is wired: staged automation
+// (mh_graph_set_node_automation) is applied at block rate via
+// mh_set_param -- sample offsets are ignored -- and the node's MIDI
+// output cannot be captured (incoming MIDI still works, through
+// mh_process_sidechain_midi). Oversampled nodes
+// (mh_graph_add_plugin_oversampled, factor > 1) do not expose the
+// port: resampling the key signal would smear the detector timing it
+// exists to carry.
+
+// The node's sidechain input port index, or -1 when the node has no
+// sidechain port (not a plugin node, no sidechain bus, or
+// oversampled). Valid before compile; use it as dst_port in
+// mh_graph_connect.
+int mh_graph_get_node_sidechain_port(MH_PluginGraph* g, MH_NodeId node);
+
+// ---- Adaptive overload governor ----
+//
+// Graceful degradation for unattended live graphs: instead of
+// glitching through a sustained overload (thermal throttling, a
+// background task stealing cores), the graph sheds pre-designated
+// work and rides it out. Plugin nodes are marked "sacrificial" with a
+// shed order; the render thread measures every block against its
+// real-time budget (nframes / sample_rate), and when the load stays
+// at or above engage_load for engage_blocks consecutive blocks it
+// bypasses the lowest-ranked sacrificial node still live -- then
+// re-arms, so a deep overload sheds further nodes. When the load
+// stays at or below release_load for release_blocks consecutive
+// blocks, the most recently shed node is restored, one per interval.
+// Loads inside the (release_load, engage_load) band reset both
+// counters, so the two thresholds form a hysteresis gap and a shed
+// node cannot yo-yo.
+//
+// Shedding flips the same per-node flag as mh_graph_set_node_bypass
+// (latency-aligned dry pass-through, hard splice at the block edge),
+// and skips nodes the user already bypassed. The measured load of the
+// render call itself is the input -- when the graph is driven from an
+// audio device callback this tracks the device's own load figure for
+// the processing share the graph is responsible for.
+typedef struct MH_GovernorConfig {
+    double engage_load;     // shed when load >= this (fraction of budget)
+    double release_load;    // restore when load <= this; must be < engage_load
+    int    engage_blocks;   // consecutive blocks over before a shed
+    int    release_blocks;  // consecutive blocks under before a restore
+} MH_GovernorConfig;
+
+// `action` values passed to the governor event callback.
+#define MH_GOVERNOR_SHED    0   // node was bypassed to shed load
+#define MH_GOVERNOR_RESTORE 1   // node was un-bypassed after recovery
+
+// Fired from the render thread when the governor sheds or restores a
+// node. Same contract as the audio-thread callbacks elsewhere: must
+// not block, allocate, or take locks -- flip an atomic and poll.
+typedef void (*MH_GraphGovernorCallback)(MH_NodeId node, int action,
+                                         double load, void* user_data);
+
+// Rank a plugin node for shedding: 0 is sacrificed first, higher
+// ranks later; -1 (the default) marks the node never-shed. RT-safe to
+// change at any time; ranks survive a begin_edit recompile the same
+// way bypass flags do. Requires a compiled graph and a plugin node;
+// returns 1 on success.
+int mh_graph_set_node_sacrificial(MH_PluginGraph* g, MH_NodeId node,
+                                     int shed_order);
+
+// The node's current shed rank, or -1 (never-shed / bad node).
+int mh_graph_get_node_sacrificial(MH_PluginGraph* g, MH_NodeId node);
+
+// Enable the governor. config == NULL uses the defaults (engage at
+// 0.9 for 8 blocks, release at 0.6 for 1024 blocks); callback may be
+// NULL to govern silently (poll mh_graph_governor_shed_count).
+// Requires a compiled graph; storage is sized at compile so enabling
+// allocates nothing. Must not be called concurrently with
+// mh_graph_render_block (the callback pointer swaps unguarded) --
+// same restriction as mh_graph_set_tracing. Returns 1 on success, 0
+// on NULL graph, uncompiled graph, or a config with
+// release_load >= engage_load or non-positive block counts.
+int mh_graph_set_governor(MH_PluginGraph* g,
+                             const MH_GovernorConfig* config,
+                             MH_GraphGovernorCallback callback,
+                             void* user_data);
+
+// Disable the governor and restore every node it shed (user-set
+// bypass is untouched). Same concurrency restriction as
+// mh_graph_set_governor. Returns 1 on success, 0 for NULL /
+// uncompiled graph.
+int mh_graph_clear_governor(MH_PluginGraph* g);
+
+// Number of nodes currently shed by the governor. Safe to poll from
+// any thread.
+int mh_graph_governor_shed_count(MH_PluginGraph* g);
+
+// ---- Per-node meter taps ----
+//
+// Optional signal metering on any node, for live views that want to
+// see where audio flows instead of debugging routing by ear. With a
+// node's tap enabled, every render_block scans that node's output for
+// per-channel peak and RMS and publishes the pair through a seqlock'd
+// slot (the same snapshot pattern the transport playhead uses), so a
+// GUI polls levels without ever blocking the audio thread. Audio-path
+// cost is one linear pass over the tapped node's block and zero
+// allocations; untapped nodes pay one flag load. Slot storage is
+// allocated at compile, so toggling taps mid-session allocates
+// nothing. A tap meters the node's output -- for an output node, the
+// audio it delivered to the caller's buffer. MIDI-only nodes carry no
+// audio and always read as 0 channels; channels beyond 32 are not
+// metered.
+
+// Enable/disable the tap on a node. RT-safe to flip from any thread;
+// the flag is read once per node render and survives a begin_edit
+// recompile. Requires a compiled graph. Returns 1 on success, 0 on a
+// bad node id / uncompiled graph.
+int mh_graph_set_node_meter(MH_PluginGraph* g, MH_NodeId node, int enabled);
+
+// Read a node's most recently published levels: writes up to
+// max_channels per-channel linear peak (max |sample|) and RMS values
+// from the last rendered block into peaks[] / rms[] (either may be
+// NULL to skip it). Unlike most mh_graph_* functions this IS safe to
+// call concurrently with render_block -- the seqlock retries when the
+// rendering thread publishes mid-read. Returns the number of channels
+// written, or 0 on a bad node id, a tap that is not enabled, or an
+// uncompiled graph.
+int mh_graph_get_node_meter(MH_PluginGraph* g, MH_NodeId node,
+                               float* peaks, float* rms, int max_channels);
+
+// ---- Per-node analysis taps ----
+//
+// Where a meter tap publishes two numbers per channel, an analysis tap
+// exposes the audio itself: mark a node tapped before compile, and
+// after each render_block borrow a pointer view of its pool buffer --
+// the block the node just produced -- without adding an extra output
+// node or copying a sample. Built for in-loop analysis sidecars
+// (loudness, spectra) that want to feed each block to numpy/torch at
+// negligible render cost.
+//
+// A tapped node is excluded from the compile-time copy elisions that
+// would otherwise leave its pool entry unwritten (rendering straight
+// into the caller's output buffer) or repointed at foreign storage
+// (bypass aliasing), so its buffer is always valid after render_block
+// and its channels always sit at a uniform stride in the pool arena --
+// which is what lets the Python binding hand the block to numpy as one
+// strided zero-copy array. The cost of tapping an otherwise-elidable
+// node is the one copy the elision would have saved.
+
+// Mark/unmark a node tapped. Pre-compile configuration (rejected on a
+// compiled graph -- reopen with mh_graph_begin_edit): the elision
+// decisions above bake at compile. Any audio-producing processing node
+// can be tapped; input and output nodes cannot (their audio lives in
+// the caller's own buffers -- tap the node feeding an output instead),
+// nor can MIDI-only nodes. Returns 1 on success, 0 on failure.
+int mh_graph_set_node_tap(MH_PluginGraph* g, MH_NodeId node, int enabled);
+
+// After render_block, borrow a tapped node's output: *channels_out
+// points at the node's per-channel pool pointers, *num_channels_out is
+// the channel count and *num_frames_out the frame count of the most
+// recent render_block (0 before the first one). No copy is made. The
+// pointers stay valid until the next mh_graph_render_block,
+// mh_graph_begin_edit, mh_graph_compile or mh_graph_close, and must be
+// read on the same thread(s) that observe render_block completion --
+// the next render overwrites the storage in place (same contract as
+// mh_graph_borrow_midi_output_events). Returns 1 on success, 0 on
+// failure (null argument, graph not compiled, bad node id, or a node
+// that is not tapped).
+int mh_graph_borrow_node_audio(MH_PluginGraph* g, MH_NodeId node,
+                                  const float* const** channels_out,
+                                  int* num_channels_out,
+                                  int* num_frames_out);
+
+// ---- Frozen-subtree render cache ----
+//
+// Freeze caches one node's rendered output so iterative re-renders of
+// the same material skip its whole upstream subtree. Workflow:
+//
+//   1. mh_graph_freeze_node(g, node)    -- start recording
+//   2. render the material once         -- each block is cached
+//   3. mh_graph_freeze_finish(g, node)  -- switch to replay
+//   4. re-render after tweaks elsewhere -- the node replays its cache
+//      and every upstream node feeding only frozen nodes is skipped,
+//      so only the dirty path to the output is processed
+//
+// The cache is a positional replay: a replay pass must ask for the
+// same sequence of block sizes as the recording pass (render_block
+// fails otherwise), and mh_graph_freeze_rewind resets all replay
+// cursors before each pass. Recording allocates per block, so freeze
+// is an offline-render feature, not for the live audio path.
+//
+// Only plugin and mix nodes can be frozen, and not ones with a wired
+// MIDI output (replay carries audio only). Staleness is tracked by
+// hashing the state of every upstream plugin at freeze_finish; it is
+// the caller's job to check mh_graph_freeze_is_stale after touching
+// upstream plugins and re-record when it reports stale.
+
+// Start recording `node`'s output. Returns 1 on success, 0 with
+// err_buf filled on bad node / already frozen.
+int mh_graph_freeze_node(MH_PluginGraph* g, MH_NodeId node,
+                            char* err_buf, size_t err_buf_size);
+
+// Stop recording and switch to replay. Requires at least one recorded
+// block. Returns 1 on success, 0 with err_buf filled.
+int mh_graph_freeze_finish(MH_PluginGraph* g, MH_NodeId node,
+                              char* err_buf, size_t err_buf_size);
+
+// Drop the cache and return the node (and its upstream subtree) to
+// normal rendering. Returns 1 on success, 0 with err_buf filled.
+int mh_graph_unfreeze_node(MH_PluginGraph* g, MH_NodeId node,
+                              char* err_buf, size_t err_buf_size);
+
+// Reset every frozen node's replay cursor to the first cached block.
+// Call before each replay pass. Returns 1 on success, 0 for NULL graph.
+int mh_graph_freeze_rewind(MH_PluginGraph* g);
+
+// 1 if any upstream plugin's state changed since freeze_finish, 0 if
+// the cache is still fresh, -1 for a node that is not replaying.
+int mh_graph_freeze_is_stale(MH_PluginGraph* g, MH_NodeId node);
+
 // Introspection.
 int mh_graph_num_nodes(MH_PluginGraph* g);
 int mh_graph_num_input_nodes(MH_PluginGraph* g);
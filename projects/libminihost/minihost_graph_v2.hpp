@@ -226,6 +226,18 @@ public:
             throw std::runtime_error("render_block failed");
     }
 
+    // Per-node profiling (see mh_graph_set_profiling /
+    // mh_graph_get_node_stats). nodeStats is safe to call from a GUI
+    // thread while renderBlock runs on the audio thread.
+    void setProfiling(bool enabled) noexcept
+    { mh_graph_set_profiling(g_, enabled ? 1 : 0); }
+    bool profilingEnabled() const noexcept
+    { return mh_graph_get_profiling(g_) != 0; }
+    bool nodeStats(NodeId node, MH_NodeStats& out) const noexcept
+    { return mh_graph_get_node_stats(g_, node, &out) != 0; }
+    void resetNodeStats() noexcept
+    { mh_graph_reset_node_stats(g_); }
+
     int numNodes()        const noexcept
     { return mh_graph_num_nodes(g_); }
     int numInputNodes()   const noexcept
@@ -0,0 +1,211 @@
+// minihost_metrics.cpp
+// Wait-free process-global metrics registry. See minihost_metrics.h
+// for the contract.
+
+#include "minihost_metrics.h"
+#include "minihost_rt_audit.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+constexpr int kMaxMetrics = 256;
+
+// Static storage so the hot-path update functions never allocate and
+// never take the registry lock: a handle indexes straight into this
+// table, and the atomics inside a slot are the only state they touch.
+// Slot lifecycle (free -> live -> free) is serialized by g_lock; the
+// hot path only checks `live` with a relaxed load, so an update racing
+// an unregister may land in a dying slot -- harmless, the slot's
+// values are cleared on reuse.
+struct Slot {
+    char name[64];
+    int  kind;
+    MH_MetricReadFn read_fn;
+    void* user_data;
+    std::atomic<long long>          count{0};       // MH_METRIC_COUNTER
+    std::atomic<unsigned long long> gauge_bits{0};  // MH_METRIC_GAUGE (double bits)
+    std::atomic<int> live{0};
+};
+
+Slot       g_slots[kMaxMetrics];
+std::mutex g_lock;  // registration / unregistration / snapshot iteration order
+
+unsigned long long doubleBits(double v)
+{
+    unsigned long long bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    return bits;
+}
+
+double bitsDouble(unsigned long long bits)
+{
+    double v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+// Register under g_lock (caller holds it). Returns the existing slot
+// for `name` or claims a free one; -1 when the registry is full.
+int registerLocked(const char* name, int kind,
+                   MH_MetricReadFn read_fn, void* user_data)
+{
+    int free_slot = -1;
+    for (int i = 0; i < kMaxMetrics; ++i)
+    {
+        if (g_slots[i].live.load(std::memory_order_relaxed))
+        {
+            if (std::strcmp(g_slots[i].name, name) == 0)
+            {
+                // Idempotent by name; a pull registration may replace
+                // the callback (e.g. re-attach after a device restart).
+                g_slots[i].read_fn   = read_fn;
+                g_slots[i].user_data = user_data;
+                return i;
+            }
+        }
+        else if (free_slot < 0)
+        {
+            free_slot = i;
+        }
+    }
+    if (free_slot < 0) return -1;
+
+    Slot& s = g_slots[free_slot];
+    std::strncpy(s.name, name, sizeof s.name - 1);
+    s.name[sizeof s.name - 1] = '\0';
+    s.kind      = kind;
+    s.read_fn   = read_fn;
+    s.user_data = user_data;
+    s.count.store(0, std::memory_order_relaxed);
+    s.gauge_bits.store(doubleBits(0.0), std::memory_order_relaxed);
+    s.live.store(1, std::memory_order_release);
+    return free_slot;
+}
+
+bool validName(const char* name)
+{
+    return name != nullptr && name[0] != '\0'
+        && std::strlen(name) < sizeof g_slots[0].name;
+}
+
+double readRtAuditHits(void*)
+{
+    return (double) mh_rt_audit_hit_count();
+}
+
+// Built-ins that pull from counters other modules already maintain.
+// Registered on first registry use so a bare snapshot is populated;
+// the push built-ins (plugin/chain/graph block counters) register
+// themselves from their own translation units at create/open time.
+void ensureBuiltins()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        std::lock_guard<std::mutex> guard(g_lock);
+        registerLocked("rt_audit.hits", MH_METRIC_COUNTER,
+                       readRtAuditHits, nullptr);
+    });
+}
+
+} // namespace
+
+extern "C" int mh_metric_register(const char* name, int kind)
+{
+    if (!validName(name)) return -1;
+    if (kind != MH_METRIC_COUNTER && kind != MH_METRIC_GAUGE) return -1;
+    ensureBuiltins();
+    std::lock_guard<std::mutex> guard(g_lock);
+    return registerLocked(name, kind, nullptr, nullptr);
+}
+
+extern "C" int mh_metric_register_read(const char* name, int kind,
+                                       MH_MetricReadFn read_fn,
+                                       void* user_data)
+{
+    if (!validName(name)) return -1;
+    if (kind != MH_METRIC_COUNTER && kind != MH_METRIC_GAUGE) return -1;
+    if (read_fn == nullptr) return -1;
+    ensureBuiltins();
+    std::lock_guard<std::mutex> guard(g_lock);
+    return registerLocked(name, kind, read_fn, user_data);
+}
+
+extern "C" int mh_metric_unregister(int handle)
+{
+    if (handle < 0 || handle >= kMaxMetrics) return 0;
+    std::lock_guard<std::mutex> guard(g_lock);
+    if (!g_slots[handle].live.load(std::memory_order_relaxed)) return 0;
+    g_slots[handle].live.store(0, std::memory_order_release);
+    return 1;
+}
+
+extern "C" void mh_metric_add(int handle, long long delta)
+{
+    if (handle < 0 || handle >= kMaxMetrics) return;
+    Slot& s = g_slots[handle];
+    if (!s.live.load(std::memory_order_relaxed)) return;
+    if (s.kind != MH_METRIC_COUNTER || s.read_fn != nullptr) return;
+    s.count.fetch_add(delta, std::memory_order_relaxed);
+}
+
+extern "C" void mh_metric_set(int handle, double value)
+{
+    if (handle < 0 || handle >= kMaxMetrics) return;
+    Slot& s = g_slots[handle];
+    if (!s.live.load(std::memory_order_relaxed)) return;
+    if (s.kind != MH_METRIC_GAUGE || s.read_fn != nullptr) return;
+    s.gauge_bits.store(doubleBits(value), std::memory_order_relaxed);
+}
+
+extern "C" int mh_metrics_count(void)
+{
+    ensureBuiltins();
+    std::lock_guard<std::mutex> guard(g_lock);
+    int n = 0;
+    for (int i = 0; i < kMaxMetrics; ++i)
+        if (g_slots[i].live.load(std::memory_order_relaxed)) ++n;
+    return n;
+}
+
+extern "C" int mh_metrics_snapshot(MH_MetricValue* out, int capacity)
+{
+    ensureBuiltins();
+    std::lock_guard<std::mutex> guard(g_lock);
+    int n = 0;
+    for (int i = 0; i < kMaxMetrics; ++i)
+    {
+        Slot& s = g_slots[i];
+        if (!s.live.load(std::memory_order_relaxed)) continue;
+        if (out != nullptr && n < capacity)
+        {
+            MH_MetricValue& v = out[n];
+            std::strncpy(v.name, s.name, sizeof v.name - 1);
+            v.name[sizeof v.name - 1] = '\0';
+            v.kind = s.kind;
+            if (s.read_fn != nullptr)
+                v.value = s.read_fn(s.user_data);
+            else if (s.kind == MH_METRIC_COUNTER)
+                v.value = (double) s.count.load(std::memory_order_relaxed);
+            else
+                v.value = bitsDouble(
+                    s.gauge_bits.load(std::memory_order_relaxed));
+        }
+        ++n;
+    }
+    return n;
+}
+
+extern "C" void mh_metrics_reset(void)
+{
+    std::lock_guard<std::mutex> guard(g_lock);
+    for (int i = 0; i < kMaxMetrics; ++i)
+    {
+        Slot& s = g_slots[i];
+        if (!s.live.load(std::memory_order_relaxed)) continue;
+        if (s.kind == MH_METRIC_COUNTER && s.read_fn == nullptr)
+            s.count.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,94 @@
+// minihost_metrics.h
+// Wait-free process-global metrics registry.
+//
+// One surface for the perf figures that otherwise leak out through
+// logs and bespoke getters: hot paths bump counters / store gauges
+// with single relaxed atomic operations, and a control thread reads
+// the whole registry in one call (mh_metrics_snapshot) for export to
+// whatever scrapes it (Prometheus, a status page, a test harness).
+//
+// Two metric flavours:
+//   - push: mh_metric_register gives a handle; hot paths call
+//     mh_metric_add (counters) or mh_metric_set (gauges). Both are
+//     wait-free -- one relaxed atomic RMW / store, no locks, no
+//     allocation -- so they are safe on the audio thread.
+//   - pull: mh_metric_register_read attaches a read callback instead;
+//     the value is fetched at snapshot time. Zero hot-path cost, used
+//     for figures an existing counter already tracks (e.g. the
+//     RT-allocation-audit hit count).
+//
+// libminihost registers its own built-ins on first use -- per-process
+// block counters for the plugin / chain / graph render paths and the
+// rt-audit hit count -- so a bare mh_metrics_snapshot is already
+// useful. Registration is idempotent by name: registering an existing
+// name returns the existing handle (with the original kind).
+//
+// Thread Safety:
+//   - mh_metric_add / mh_metric_set: any thread, wait-free; invalid
+//     handles are ignored.
+//   - mh_metric_register / _register_read / _unregister: any thread,
+//     takes a brief registry lock -- control threads only, not the
+//     audio callback.
+//   - mh_metrics_snapshot / _count / _reset: any thread; a snapshot
+//     concurrent with hot-path writers may be one update behind,
+//     which is fine for scraping.
+//
+#pragma once
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Metric kinds. Counters are monotonically increasing (reset aside);
+// gauges hold the last written value.
+#define MH_METRIC_COUNTER 0
+#define MH_METRIC_GAUGE   1
+
+// One registry entry as read by mh_metrics_snapshot.
+typedef struct MH_MetricValue {
+    char name[64];   // dotted lowercase path, e.g. "chain.blocks_processed"
+    int kind;        // MH_METRIC_COUNTER or MH_METRIC_GAUGE
+    double value;    // counter count or gauge value at snapshot time
+} MH_MetricValue;
+
+// Read callback for pull metrics: returns the current value. Must be
+// callable from any thread for as long as the metric stays registered.
+typedef double (*MH_MetricReadFn)(void* user_data);
+
+// Register a push metric (or look up an existing one by name).
+// Returns a handle >= 0, or -1 on failure (NULL/empty/oversized name,
+// bad kind, registry full).
+int mh_metric_register(const char* name, int kind);
+
+// Register a pull metric whose value is read_fn(user_data) at snapshot
+// time. Same name/handle semantics as mh_metric_register; re-registering
+// an existing name replaces its callback.
+int mh_metric_register_read(const char* name, int kind,
+                            MH_MetricReadFn read_fn, void* user_data);
+
+// Remove a metric. The handle becomes invalid (later updates through
+// it are ignored) and the slot may be recycled by a future
+// registration. Returns 1 on success, 0 on a bad handle.
+int mh_metric_unregister(int handle);
+
+// Hot-path updates. Wait-free; no-ops on invalid handles or on a
+// kind mismatch (add is counters-only, set is gauges-only).
+void mh_metric_add(int handle, long long delta);
+void mh_metric_set(int handle, double value);
+
+// Number of live metrics (including built-ins).
+int mh_metrics_count(void);
+
+// Copy every live metric into out (up to capacity entries; out may be
+// NULL when capacity is 0). Returns the number of live metrics, which
+// may exceed capacity -- call mh_metrics_count first or retry with a
+// bigger buffer.
+int mh_metrics_snapshot(MH_MetricValue* out, int capacity);
+
+// Zero all push counters. Gauges and pull metrics are untouched.
+void mh_metrics_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,197 @@
+// minihost_rt_audit.cpp
+// Runtime RT-safety audit. See minihost_rt_audit.h for the contract.
+
+#include "minihost_rt_audit.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if !defined(_WIN32)
+#include <execinfo.h>
+#endif
+
+namespace {
+
+constexpr int kMaxFrames = 16;
+constexpr int kMaxHits   = 64;
+
+// Static storage so recording never allocates. Slots are claimed with
+// an atomic cursor; concurrent audio threads write distinct slots.
+struct Hit {
+    void*  frames[kMaxFrames];
+    int    num_frames;
+    size_t bytes;
+};
+
+Hit                    g_hits[kMaxHits];
+std::atomic<long long> g_hit_count{0};  // total; may exceed kMaxHits
+
+// Set once at load from MINIHOST_RT_AUDIT. Zero-initialized, so
+// allocations during earlier static initialization are never trapped.
+bool g_enabled = false;
+
+// Per-thread state: audited-scope nesting depth, and a re-entrancy
+// guard so allocations made by backtrace() itself are not re-trapped.
+thread_local int  tl_scope_depth = 0;
+thread_local bool tl_in_hook     = false;
+
+struct AuditInit {
+    AuditInit()
+    {
+        const char* v = std::getenv("MINIHOST_RT_AUDIT");
+        g_enabled = v != nullptr && v[0] == '1';
+#if !defined(_WIN32)
+        if (g_enabled)
+        {
+            // Warm up the unwinder: glibc's first backtrace() call may
+            // allocate while loading libgcc, which must not happen
+            // inside the allocation hook on the audio thread.
+            void* scratch[2];
+            (void) backtrace(scratch, 2);
+        }
+#endif
+    }
+};
+AuditInit g_audit_init;
+
+void recordHit(size_t bytes)
+{
+    tl_in_hook = true;
+    const long long n = g_hit_count.fetch_add(1, std::memory_order_relaxed);
+    if (n < kMaxHits)
+    {
+        Hit& h = g_hits[n];
+        h.bytes = bytes;
+#if !defined(_WIN32)
+        h.num_frames = backtrace(h.frames, kMaxFrames);
+#else
+        h.num_frames = 0;
+#endif
+    }
+    tl_in_hook = false;
+}
+
+// Bounded printf-append for the report writer.
+void appendf(char* buf, size_t buf_size, size_t* off, const char* fmt, ...)
+{
+    if (*off >= buf_size) return;
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(buf + *off, buf_size - *off, fmt, args);
+    va_end(args);
+    if (n > 0) *off += (size_t) n;
+}
+
+} // namespace
+
+// ---- interposed allocator ----
+//
+// Defining the global allocation functions here makes every operator
+// new in the linked image route through the audit check: one branch on
+// a bool when audit mode is off. Deallocation is not audited (freeing
+// on the audio path is also a violation, but trapping it doubles the
+// noise for the less common bug).
+
+void* operator new(std::size_t size)
+{
+    if (g_enabled && tl_scope_depth > 0 && !tl_in_hook)
+        recordHit(size);
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    if (g_enabled && tl_scope_depth > 0 && !tl_in_hook)
+        recordHit(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+// ---- C API ----
+
+extern "C" int mh_rt_audit_enabled(void)
+{
+    return g_enabled ? 1 : 0;
+}
+
+extern "C" long long mh_rt_audit_hit_count(void)
+{
+    return g_hit_count.load(std::memory_order_relaxed);
+}
+
+extern "C" long long mh_rt_audit_report(char* buf, size_t buf_size)
+{
+    const long long total = g_hit_count.load(std::memory_order_relaxed);
+    if (buf == nullptr || buf_size == 0) return total;
+
+    const int recorded = total < kMaxHits ? (int) total : kMaxHits;
+    size_t off = 0;
+    appendf(buf, buf_size, &off,
+            "rt-audit: %lld allocation(s) trapped in audited audio paths"
+            " (%d with backtrace)\n",
+            total, recorded);
+
+    for (int i = 0; i < recorded; ++i)
+    {
+        const Hit& h = g_hits[i];
+        appendf(buf, buf_size, &off, "hit %d: %zu bytes\n", i, h.bytes);
+#if !defined(_WIN32)
+        // Symbolization allocates, but report runs off the audio path.
+        char** symbols = backtrace_symbols(h.frames, h.num_frames);
+        if (symbols != nullptr)
+        {
+            for (int f = 0; f < h.num_frames; ++f)
+                appendf(buf, buf_size, &off, "  %s\n", symbols[f]);
+            std::free(symbols);
+        }
+#endif
+    }
+    return total;
+}
+
+extern "C" long long mh_rt_audit_hit_bytes(int index)
+{
+    const long long total = g_hit_count.load(std::memory_order_relaxed);
+    const int recorded = total < kMaxHits ? (int) total : kMaxHits;
+    if (index < 0 || index >= recorded) return -1;
+    return (long long) g_hits[index].bytes;
+}
+
+extern "C" void mh_rt_audit_reset(void)
+{
+    g_hit_count.store(0, std::memory_order_relaxed);
+}
+
+extern "C" void mh_rt_audit_scope_begin(void)
+{
+    if (!g_enabled) return;
+    ++tl_scope_depth;
+}
+
+extern "C" void mh_rt_audit_scope_end(void)
+{
+    if (!g_enabled) return;
+    --tl_scope_depth;
+}
@@ -0,0 +1,78 @@
+// minihost_rt_audit.h
+// Runtime RT-safety audit: trap allocations in the audio path.
+//
+// When the process starts with MINIHOST_RT_AUDIT=1, libminihost's
+// global operator new is interposed: any C++ heap allocation made
+// while a thread is inside an audited audio entry point (mh_process*
+// variants, mh_chain_process*, mh_graph_render_block) is counted and
+// its backtrace captured into a fixed-size table. Query the result
+// with mh_rt_audit_report() to turn "it glitched live once" into a
+// one-run diagnosis of exactly which code path allocated.
+//
+// Scope and limits:
+//   - Catches operator new / new[] (the allocator used by libminihost,
+//     JUCE, and most plugin code). Raw malloc calls are not interposed
+//     -- that would require platform linker tricks out of scope here.
+//   - The recording path is itself allocation-free (static hit table,
+//     atomic cursor); only the first kMaxHits distinct hits keep a
+//     backtrace, but the total count keeps climbing.
+//   - Backtraces are captured on POSIX (execinfo); on Windows hits are
+//     counted without frames.
+//   - When MINIHOST_RT_AUDIT is unset the interposed allocator is a
+//     single predicted branch over plain malloc -- negligible.
+//
+// Thread Safety:
+//   - mh_rt_audit_scope_begin/end: called on the audio thread by the
+//     audited entry points; scopes nest (depth-counted per thread).
+//   - All other functions: any thread. Calling report concurrently
+//     with a recording thread may miss the newest hit; fine for
+//     diagnostics.
+//
+#pragma once
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns 1 if audit mode is active (MINIHOST_RT_AUDIT=1 in the
+// environment when the library was loaded), 0 otherwise.
+int mh_rt_audit_enabled(void);
+
+// Total allocations trapped in audited scopes since load / last reset.
+long long mh_rt_audit_hit_count(void);
+
+// Write a human-readable report into buf (truncated if needed): one
+// stanza per recorded hit with its symbolized backtrace. buf may be
+// NULL to query the count only. Returns the total hit count.
+long long mh_rt_audit_report(char* buf, size_t buf_size);
+
+// Size in bytes of recorded hit `index`, or -1 when index is out of
+// range (index must be below both the hit count and the fixed table
+// capacity). Lets harnesses size-bucket trapped allocations without
+// parsing the text report; the allocation-profile baseline emitter in
+// minihost_bench is the intended consumer.
+long long mh_rt_audit_hit_bytes(int index);
+
+// Clear the hit table and counter.
+void mh_rt_audit_reset(void);
+
+// Scope markers bracketing an audited audio entry point. Called by
+// libminihost internally; also usable by applications to audit their
+// own audio callbacks. No-ops when audit mode is off.
+void mh_rt_audit_scope_begin(void);
+void mh_rt_audit_scope_end(void);
+
+#ifdef __cplusplus
+}
+
+// RAII scope marker for the C++ translation units (exception- and
+// early-return-safe, unlike paired begin/end calls).
+class MhRtAuditScope {
+public:
+    MhRtAuditScope() { mh_rt_audit_scope_begin(); }
+    ~MhRtAuditScope() { mh_rt_audit_scope_end(); }
+    MhRtAuditScope(const MhRtAuditScope&) = delete;
+    MhRtAuditScope& operator=(const MhRtAuditScope&) = delete;
+};
+#endif
@@ -0,0 +1,159 @@
+// minihost_threads.cpp
+// Per-role thread scheduling policy. See minihost_threads.h for the
+// contract.
+
+#include "minihost_threads.h"
+#include "minihost_metrics.h"
+
+#include <mutex>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int kMaxCpus = 64;
+
+// Policies are tiny and read once per thread spawn, so fixed storage
+// behind a plain mutex beats anything clever. The cpu list is inline
+// (no vector) so a copy under the lock never allocates.
+struct RolePolicy {
+    int priority = MH_THREAD_PRIORITY_DEFAULT;
+    int cpus[kMaxCpus] = {};
+    int num_cpus = 0;
+};
+
+RolePolicy g_policies[MH_THREAD_NUM_ROLES];
+std::mutex g_lock;
+
+// Applications and denials are counted in the metrics registry so a
+// misconfigured box (missing rtprio privilege, bad cpu list) shows up
+// in the same snapshot as every other perf figure.
+std::once_flag g_metrics_once;
+int g_applied_metric = -1;
+int g_denied_metric  = -1;
+
+void ensureMetrics()
+{
+    std::call_once(g_metrics_once, []()
+    {
+        g_applied_metric
+            = mh_metric_register("threads.policy_applied", MH_METRIC_COUNTER);
+        g_denied_metric
+            = mh_metric_register("threads.policy_denied", MH_METRIC_COUNTER);
+    });
+}
+
+bool validRole(int role)
+{
+    return role >= 0 && role < MH_THREAD_NUM_ROLES;
+}
+
+} // namespace
+
+extern "C" int mh_thread_policy_set(int role, int priority,
+                                    const int* cpu_ids, int count)
+{
+    if (!validRole(role)) return 0;
+    if (priority < MH_THREAD_PRIORITY_DEFAULT
+        || priority > MH_THREAD_PRIORITY_REALTIME)
+        return 0;
+    if (count < 0 || count > kMaxCpus) return 0;
+    if (count > 0 && cpu_ids == nullptr) return 0;
+    for (int i = 0; i < count; ++i)
+        if (cpu_ids[i] < 0) return 0;
+
+    std::lock_guard<std::mutex> lock(g_lock);
+    RolePolicy& p = g_policies[role];
+    p.priority = priority;
+    p.num_cpus = count;
+    for (int i = 0; i < count; ++i)
+        p.cpus[i] = cpu_ids[i];
+    return 1;
+}
+
+extern "C" int mh_thread_policy_get(int role, int* priority,
+                                    int* cpu_ids, int capacity)
+{
+    if (!validRole(role)) return -1;
+
+    std::lock_guard<std::mutex> lock(g_lock);
+    const RolePolicy& p = g_policies[role];
+    if (priority != nullptr) *priority = p.priority;
+    const int n = capacity < p.num_cpus ? capacity : p.num_cpus;
+    for (int i = 0; i < n && cpu_ids != nullptr; ++i)
+        cpu_ids[i] = p.cpus[i];
+    return p.num_cpus;
+}
+
+extern "C" void mh_thread_policy_apply(int role)
+{
+    if (!validRole(role)) return;
+
+    RolePolicy p;
+    {
+        std::lock_guard<std::mutex> lock(g_lock);
+        p = g_policies[role];
+    }
+    if (p.priority == MH_THREAD_PRIORITY_DEFAULT && p.num_cpus == 0)
+        return;   // nothing configured; skip the metrics registration too
+
+    ensureMetrics();
+
+#if !defined(_WIN32)
+    bool applied = false;
+    bool denied  = false;
+
+    if (p.priority == MH_THREAD_PRIORITY_REALTIME)
+    {
+        // Mid-range SCHED_FIFO: above every SCHED_OTHER thread but
+        // below the kernel's own realtime housekeeping, matching where
+        // miniaudio places the device callback.
+        struct sched_param sp = {};
+        const int lo = sched_get_priority_min(SCHED_FIFO);
+        const int hi = sched_get_priority_max(SCHED_FIFO);
+        sp.sched_priority = lo + (hi - lo) / 2;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) == 0)
+            applied = true;
+        else
+            denied = true;   // typically RLIMIT_RTPRIO / missing CAP_SYS_NICE
+    }
+#if defined(__linux__)
+    else if (p.priority != MH_THREAD_PRIORITY_DEFAULT)
+    {
+        // Per-thread nice: on Linux setpriority with a tid adjusts only
+        // the calling thread. Raising priority (negative nice) may need
+        // RLIMIT_NICE; lowering always succeeds.
+        const int nice_val
+            = p.priority == MH_THREAD_PRIORITY_HIGH ? -10 : 10;
+        if (setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid),
+                        nice_val) == 0)
+            applied = true;
+        else
+            denied = true;
+    }
+
+    if (p.num_cpus > 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int i = 0; i < p.num_cpus; ++i)
+            CPU_SET((unsigned) p.cpus[i], &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0)
+            applied = true;
+        else
+            denied = true;
+    }
+#endif
+
+    if (applied) mh_metric_add(g_applied_metric, 1);
+    if (denied)  mh_metric_add(g_denied_metric, 1);
+#endif
+}
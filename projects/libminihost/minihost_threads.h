@@ -0,0 +1,82 @@
+// minihost_threads.h
+// Per-role scheduling policy for library-spawned threads.
+//
+// libminihost spawns threads of very different characters: the
+// embedded JUCE message thread (every thread-affine plugin operation
+// funnels through it), graph render workers and chain pipeline stages
+// (audio-rate work off the device callback), async open / scan pool
+// workers (batch discovery), and the parameter-coalescing flush
+// thread. They all start at default priority, so on a loaded render
+// box the message thread gets starved behind the render workers and
+// control operations stall for seconds -- while the miniaudio device
+// callback itself already runs realtime. This module lets the
+// application assign each role a scheduling class (and optionally a
+// CPU list) that every thread of that role applies to itself at
+// spawn.
+//
+// Semantics:
+//   - Policy is read when a thread starts; already-running threads
+//     keep their class. The message thread is created lazily at the
+//     first plugin load, so set policies at startup, before mh_open.
+//   - Best-effort: MH_THREAD_PRIORITY_REALTIME needs rtprio privilege
+//     (RLIMIT_RTPRIO / CAP_SYS_NICE) and a refusal leaves the thread
+//     at its previous class. Applications and denials are counted in
+//     the metrics registry ("threads.policy_applied" /
+//     "threads.policy_denied") so a misconfigured box shows up in the
+//     same snapshot as everything else.
+//   - Priorities map to SCHED_FIFO (realtime) and per-thread nice
+//     (high/low, Linux). Affinity is Linux-only, matching
+//     mh_graph_set_worker_affinity -- which, when set on a graph,
+//     overrides the role CPU list for that graph's workers.
+//   - POSIX only; policies are stored but inert on Windows.
+//
+// Thread Safety:
+//   - mh_thread_policy_set / _get: any thread, takes a brief lock --
+//     control threads only, not the audio callback.
+//   - mh_thread_policy_apply: called by library threads at spawn;
+//     also usable by applications on their own threads.
+//
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Thread roles.
+#define MH_THREAD_ROLE_MESSAGE      0  // embedded JUCE message thread
+#define MH_THREAD_ROLE_AUDIO_WORKER 1  // graph workers, chain pipeline stages
+#define MH_THREAD_ROLE_LOADER       2  // mh_open_async pool, parallel scan
+#define MH_THREAD_ROLE_CONTROL      3  // parameter-coalescing flush thread
+#define MH_THREAD_NUM_ROLES         4
+
+// Scheduling classes.
+#define MH_THREAD_PRIORITY_DEFAULT  0  // inherit; apply changes nothing
+#define MH_THREAD_PRIORITY_LOW      1  // nice +10 (Linux)
+#define MH_THREAD_PRIORITY_HIGH     2  // nice -10 (Linux; may need privilege)
+#define MH_THREAD_PRIORITY_REALTIME 3  // SCHED_FIFO, mid-range priority
+
+// Set the policy for a role: scheduling class plus an optional CPU
+// list the role's threads are confined to (cpu_ids may be NULL when
+// count is 0; count == 0 clears any list). Takes effect for threads
+// spawned after the call. Returns 1 on success, 0 on failure (bad
+// role or priority, NULL list with count > 0, a negative cpu id, or
+// count > 64).
+int mh_thread_policy_set(int role, int priority,
+                         const int* cpu_ids, int count);
+
+// Read back a role's policy: *priority receives the scheduling class
+// (may be NULL), and up to capacity cpu ids are copied into cpu_ids.
+// Returns the CPU-list length (which may exceed capacity), or -1 on a
+// bad role.
+int mh_thread_policy_get(int role, int* priority,
+                         int* cpu_ids, int capacity);
+
+// Apply the role's current policy to the calling thread. Called by
+// libminihost's own threads as their first act; applications may call
+// it from threads they want scheduled alongside a library role.
+// Best-effort -- denials are counted, not reported.
+void mh_thread_policy_apply(int role);
+
+#ifdef __cplusplus
+}
+#endif
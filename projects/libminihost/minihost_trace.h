@@ -0,0 +1,141 @@
+// minihost_trace.h
+//
+// Internal (C++-only) trace ring shared by the graph and chain
+// executors. Not part of the public C ABI -- the public surface is the
+// per-module pairs mh_graph_set_tracing / mh_graph_trace_dump and
+// mh_chain_set_tracing / mh_chain_trace_dump.
+//
+// The ring is preallocated by the enabling call (control thread); the
+// audio path records one fixed-size event per plugin/node call with a
+// relaxed fetch_add cursor -- wait-free, no allocations, oldest events
+// overwritten when the ring wraps. Size the ring for the capture you
+// want: nodes_per_block * blocks_to_keep events.
+//
+// dumpJson writes Chrome trace-event JSON ("X" complete events),
+// loadable in chrome://tracing and Perfetto. Dump and resize must not
+// run concurrently with recording; recording concurrently with a dump
+// can tear individual events, which the callers forbid by contract
+// (dump between blocks / after the render).
+
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mh_trace {
+
+struct Event {
+    long long begin_us = 0;   // steady_clock timestamp, microseconds
+    long long dur_us   = 0;
+    long long block    = 0;   // block sequence number
+    int       track    = 0;   // node id / plugin index (names at dump)
+    unsigned  tid      = 0;   // render-thread lane (currentThreadTrack)
+};
+
+// Stable small id for the calling thread so parallel node renders land
+// on separate rows in the trace viewer.
+inline unsigned currentThreadTrack()
+{
+    return (unsigned)(std::hash<std::thread::id>{}(
+                          std::this_thread::get_id()) & 0xffffu);
+}
+
+class Ring {
+public:
+    // capacity <= 0 disables and frees. Control-thread only.
+    void resize(int capacity)
+    {
+        events_.assign(capacity > 0 ? (size_t) capacity : 0, Event{});
+        cursor_.store(0, std::memory_order_relaxed);
+    }
+
+    bool enabled() const { return !events_.empty(); }
+    int  capacity() const { return (int) events_.size(); }
+
+    void record(const Event& e)
+    {
+        if (events_.empty()) return;
+        const long long i = cursor_.fetch_add(1, std::memory_order_relaxed);
+        events_[(size_t)(i % (long long) events_.size())] = e;
+    }
+
+    // Oldest-first copy of the captured events (at most capacity).
+    std::vector<Event> snapshot() const
+    {
+        std::vector<Event> out;
+        const long long total = cursor_.load(std::memory_order_relaxed);
+        const long long cap   = (long long) events_.size();
+        if (total <= 0 || cap == 0) return out;
+        const long long count = total < cap ? total : cap;
+        const long long start = total < cap ? 0 : total % cap;
+        out.reserve((size_t) count);
+        for (long long k = 0; k < count; ++k)
+            out.push_back(events_[(size_t)((start + k) % cap)]);
+        return out;
+    }
+
+private:
+    std::vector<Event>     events_;
+    std::atomic<long long> cursor_{0};
+};
+
+inline std::string escapeJson(const std::string& s)
+{
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        if ((unsigned char) c >= 0x20) out.push_back(c);
+    }
+    return out;
+}
+
+// Write the ring as Chrome trace-event JSON. track_names[track] labels
+// each event (falls back to "track<N>" when out of range). On failure
+// fills `error` and returns false.
+inline bool dumpJson(const Ring& ring,
+                     const std::vector<std::string>& track_names,
+                     const char* path,
+                     std::string& error)
+{
+    if (path == nullptr || *path == '\0')
+    {
+        error = "trace dump path is empty";
+        return false;
+    }
+    std::FILE* f = std::fopen(path, "w");
+    if (f == nullptr)
+    {
+        error = std::string("cannot open trace file: ") + path;
+        return false;
+    }
+
+    const std::vector<Event> events = ring.snapshot();
+    std::fputs("{\"traceEvents\":[", f);
+    bool first = true;
+    for (const Event& e : events)
+    {
+        std::string name = (e.track >= 0
+                            && (size_t) e.track < track_names.size())
+            ? escapeJson(track_names[(size_t) e.track])
+            : "track" + std::to_string(e.track);
+        std::fprintf(f,
+            "%s\n{\"name\":\"%s\",\"cat\":\"render\",\"ph\":\"X\","
+            "\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"block\":%lld}}",
+            first ? "" : ",",
+            name.c_str(), e.begin_us, e.dur_us, e.tid, e.block);
+        first = false;
+    }
+    std::fputs("\n]}\n", f);
+    const bool ok = std::fclose(f) == 0;
+    if (!ok) error = std::string("write failed: ") + path;
+    return ok;
+}
+
+} // namespace mh_trace
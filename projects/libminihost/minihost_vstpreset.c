@@ -3,12 +3,24 @@
 //
 // Binary layout and chunk IDs are documented in minihost_vstpreset.h.
 
+// For pread, posix_fadvise, posix_madvise and dirent on POSIX systems.
+// Must precede the first system header; harmless elsewhere.
+#define _POSIX_C_SOURCE 200809L
+
 #include "minihost_vstpreset.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define HEADER_SIZE 48
 #define ENTRY_SIZE 20  // 4-byte id + int64 offset + int64 size
 static const char MAGIC[4] = { 'V', 'S', 'T', '3' };
@@ -60,6 +72,19 @@ static void set_errf(char* err_buf, size_t err_buf_size, const char* fmt,
     }
 }
 
+// Copy the 32-byte class ID field from a header into a NUL-terminated
+// buffer of MH_VSTPRESET_CLASS_ID_LEN + 1 bytes, stripping trailing NULs
+// so substring searches work.
+static void copy_class_id(char* dst, const unsigned char* src) {
+    memcpy(dst, src, MH_VSTPRESET_CLASS_ID_LEN);
+    dst[MH_VSTPRESET_CLASS_ID_LEN] = '\0';
+    for (int i = MH_VSTPRESET_CLASS_ID_LEN - 1; i >= 0; i--) {
+        if (dst[i] == '\0') continue;
+        dst[i + 1] = '\0';
+        break;
+    }
+}
+
 // ---- API ----------------------------------------------------------------
 
 void mh_vstpreset_free(MH_VstPreset* preset) {
@@ -130,15 +155,7 @@ int mh_vstpreset_read(const char* path, MH_VstPreset* out,
         return 0;
     }
 
-    // Copy class_id: 32 bytes, strip trailing NULs
-    memcpy(out->class_id, data + 8, MH_VSTPRESET_CLASS_ID_LEN);
-    out->class_id[MH_VSTPRESET_CLASS_ID_LEN] = '\0';
-    // Strip trailing NULs so substring searches work
-    for (int i = MH_VSTPRESET_CLASS_ID_LEN - 1; i >= 0; i--) {
-        if (out->class_id[i] == '\0') continue;
-        out->class_id[i + 1] = '\0';
-        break;
-    }
+    copy_class_id(out->class_id, data + 8);
 
     long long list_offset = read_le_i64(data + 40);
     if (list_offset < HEADER_SIZE || list_offset >= flen) {
@@ -217,6 +234,493 @@ int mh_vstpreset_read(const char* path, MH_VstPreset* out,
     return 1;
 }
 
+// ---- Lazy preset handle --------------------------------------------------
+//
+// mh_vstpreset_open() maps the file read-only (POSIX mmap; buffered stdio
+// elsewhere or when mmap fails) and parses only the header and the chunk
+// list. State chunk bytes are untouched until a state accessor is called,
+// so metadata queries over a large preset library stay cheap.
+
+struct MH_VstPresetFile {
+    char class_id[MH_VSTPRESET_CLASS_ID_LEN + 1];
+    long long file_size;
+    long long comp_offset, comp_size;  // 'Comp' chunk location (-1 = absent)
+    long long cont_offset, cont_size;  // 'Cont' chunk location (-1 = absent)
+    unsigned char* map;                // mmap'd file, NULL on stdio fallback
+    size_t map_len;
+    FILE* f;                           // stdio fallback stream, NULL when mapped
+    unsigned char* comp_buf;           // lazily read chunk copies (fallback only)
+    unsigned char* cont_buf;
+};
+
+// Read n bytes at absolute offset off. Bounds-checks against the file size
+// and works for both the mapped and the stdio paths.
+static int vp_read_at(MH_VstPresetFile* p, long long off, void* dst, size_t n) {
+    if (off < 0 || off + (long long)n > p->file_size) return 0;
+    if (p->map) {
+        memcpy(dst, p->map + off, n);
+        return 1;
+    }
+    if (fseek(p->f, (long)off, SEEK_SET) != 0) return 0;
+    return fread(dst, 1, n, p->f) == n;
+}
+
+// Parse the header and chunk list of an opened handle. Touches at most the
+// header page and the chunk-list pages.
+static int vp_parse(MH_VstPresetFile* p, char* err_buf, size_t err_buf_size) {
+    unsigned char header[HEADER_SIZE];
+    if (p->file_size < HEADER_SIZE) {
+        set_err(err_buf, err_buf_size, "File too small to be a .vstpreset");
+        return 0;
+    }
+    if (!vp_read_at(p, 0, header, HEADER_SIZE)) {
+        set_err(err_buf, err_buf_size, "Failed to read preset file");
+        return 0;
+    }
+    if (memcmp(header, MAGIC, 4) != 0) {
+        set_err(err_buf, err_buf_size, "Invalid .vstpreset magic");
+        return 0;
+    }
+    if (read_le_i32(header + 4) != 1) {
+        set_err(err_buf, err_buf_size, "Unsupported .vstpreset version");
+        return 0;
+    }
+    copy_class_id(p->class_id, header + 8);
+
+    long long list_offset = read_le_i64(header + 40);
+    if (list_offset < HEADER_SIZE || list_offset >= p->file_size) {
+        set_errf(err_buf, err_buf_size,
+                 "Invalid chunk list offset: %lld (file size: %lld)",
+                 list_offset, p->file_size);
+        return 0;
+    }
+
+    unsigned char list_header[8];
+    if (!vp_read_at(p, list_offset, list_header, 8)) {
+        set_err(err_buf, err_buf_size, "Chunk list header truncated");
+        return 0;
+    }
+    if (memcmp(list_header, CHUNK_LIST, 4) != 0) {
+        set_err(err_buf, err_buf_size, "Invalid chunk list magic");
+        return 0;
+    }
+    int entry_count = read_le_i32(list_header + 4);
+    if (entry_count < 0 || entry_count > 128) {
+        set_err(err_buf, err_buf_size, "Invalid chunk entry count");
+        return 0;
+    }
+
+    unsigned char entries[128 * ENTRY_SIZE];
+    size_t entries_bytes = (size_t)entry_count * ENTRY_SIZE;
+    if (entry_count > 0 &&
+        !vp_read_at(p, list_offset + 8, entries, entries_bytes)) {
+        set_err(err_buf, err_buf_size, "Chunk list entries truncated");
+        return 0;
+    }
+
+    for (int i = 0; i < entry_count; i++) {
+        const unsigned char* entry = entries + (size_t)i * ENTRY_SIZE;
+        long long chunk_offset = read_le_i64(entry + 4);
+        long long chunk_size = read_le_i64(entry + 12);
+
+        if (chunk_offset < 0 || chunk_size < 0) continue;
+        if (chunk_offset + chunk_size > p->file_size) {
+            set_err(err_buf, err_buf_size, "Chunk extends beyond file");
+            return 0;
+        }
+
+        if (memcmp(entry, CHUNK_COMP, 4) == 0) {
+            p->comp_offset = chunk_offset;
+            p->comp_size = chunk_size;
+        } else if (memcmp(entry, CHUNK_CONT, 4) == 0) {
+            p->cont_offset = chunk_offset;
+            p->cont_size = chunk_size;
+        }
+        // Unknown chunks are silently ignored (matches mh_vstpreset_read).
+    }
+    return 1;
+}
+
+MH_VstPresetFile* mh_vstpreset_open(const char* path,
+                                    char* err_buf, size_t err_buf_size) {
+    if (!path) {
+        set_err(err_buf, err_buf_size, "Invalid arguments");
+        return NULL;
+    }
+    MH_VstPresetFile* p = (MH_VstPresetFile*)calloc(1, sizeof(*p));
+    if (!p) {
+        set_err(err_buf, err_buf_size, "Out of memory");
+        return NULL;
+    }
+    p->comp_offset = p->comp_size = -1;
+    p->cont_offset = p->cont_size = -1;
+
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)
+            && st.st_size >= HEADER_SIZE) {
+            void* map = mmap(NULL, (size_t)st.st_size, PROT_READ,
+                             MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                p->map = (unsigned char*)map;
+                p->map_len = (size_t)st.st_size;
+                p->file_size = (long long)st.st_size;
+                // A metadata query touches only the header and the chunk
+                // list; suppress kernel readahead of the state area between
+                // them.
+                posix_madvise(map, p->map_len, POSIX_MADV_RANDOM);
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    if (!p->map) {
+        p->f = fopen(path, "rb");
+        if (!p->f) {
+            free(p);
+            set_err(err_buf, err_buf_size, "Cannot open preset file");
+            return NULL;
+        }
+        if (fseek(p->f, 0, SEEK_END) != 0) {
+            fclose(p->f);
+            free(p);
+            set_err(err_buf, err_buf_size, "Failed to seek in preset file");
+            return NULL;
+        }
+        long flen = ftell(p->f);
+        if (flen < 0) {
+            fclose(p->f);
+            free(p);
+            set_err(err_buf, err_buf_size,
+                    "Failed to determine preset file size");
+            return NULL;
+        }
+        p->file_size = flen;
+    }
+
+    if (!vp_parse(p, err_buf, err_buf_size)) {
+        mh_vstpreset_close(p);
+        return NULL;
+    }
+    return p;
+}
+
+const char* mh_vstpreset_file_class_id(const MH_VstPresetFile* file) {
+    return file ? file->class_id : NULL;
+}
+
+long long mh_vstpreset_file_size(const MH_VstPresetFile* file) {
+    return file ? file->file_size : 0;
+}
+
+long long mh_vstpreset_file_component_size(const MH_VstPresetFile* file) {
+    return file ? file->comp_size : -1;
+}
+
+long long mh_vstpreset_file_controller_size(const MH_VstPresetFile* file) {
+    return file ? file->cont_size : -1;
+}
+
+// Shared body of the two state accessors. Mapped handles return a pointer
+// straight into the mapping (the lazy load is the page fault); the stdio
+// fallback reads the chunk into a cached heap buffer on first access.
+static const void* vp_chunk_state(MH_VstPresetFile* p,
+                                  long long offset, long long size,
+                                  unsigned char** cache,
+                                  const char* missing_msg,
+                                  char* err_buf, size_t err_buf_size) {
+    if (!p) {
+        set_err(err_buf, err_buf_size, "Invalid arguments");
+        return NULL;
+    }
+    if (offset < 0) {
+        set_err(err_buf, err_buf_size, missing_msg);
+        return NULL;
+    }
+    if (p->map) return p->map + offset;
+    if (!*cache) {
+        unsigned char* buf = (unsigned char*)malloc(size > 0 ? (size_t)size : 1);
+        if (!buf) {
+            set_err(err_buf, err_buf_size, "Out of memory");
+            return NULL;
+        }
+        if (size > 0 && !vp_read_at(p, offset, buf, (size_t)size)) {
+            free(buf);
+            set_err(err_buf, err_buf_size, "Failed to read state chunk");
+            return NULL;
+        }
+        *cache = buf;
+    }
+    return *cache;
+}
+
+const void* mh_vstpreset_file_component_state(MH_VstPresetFile* file,
+                                              char* err_buf, size_t err_buf_size) {
+    if (!file) {
+        set_err(err_buf, err_buf_size, "Invalid arguments");
+        return NULL;
+    }
+    return vp_chunk_state(file, file->comp_offset, file->comp_size,
+                          &file->comp_buf,
+                          "Preset has no component state ('Comp' chunk)",
+                          err_buf, err_buf_size);
+}
+
+const void* mh_vstpreset_file_controller_state(MH_VstPresetFile* file,
+                                               char* err_buf, size_t err_buf_size) {
+    if (!file) {
+        set_err(err_buf, err_buf_size, "Invalid arguments");
+        return NULL;
+    }
+    return vp_chunk_state(file, file->cont_offset, file->cont_size,
+                          &file->cont_buf,
+                          "Preset has no controller state ('Cont' chunk)",
+                          err_buf, err_buf_size);
+}
+
+void mh_vstpreset_close(MH_VstPresetFile* file) {
+    if (!file) return;
+#ifndef _WIN32
+    if (file->map) munmap(file->map, file->map_len);
+#endif
+    if (file->f) fclose(file->f);
+    free(file->comp_buf);
+    free(file->cont_buf);
+    free(file);
+}
+
+// ---- Bulk directory index ------------------------------------------------
+
+void mh_vstpreset_index_free(MH_VstPresetIndexEntry* entries, int count) {
+    if (!entries) return;
+    for (int i = 0; i < count; i++) free(entries[i].path);
+    free(entries);
+}
+
+#ifndef _WIN32
+
+// Files opened and readahead-hinted ahead of the one being parsed.
+#define INDEX_BATCH 64
+
+// Case-insensitive ".vstpreset" suffix match (ASCII only).
+static int has_vstpreset_suffix(const char* name) {
+    static const char suffix[] = ".vstpreset";
+    size_t nlen = strlen(name);
+    size_t slen = sizeof(suffix) - 1;
+    if (nlen < slen) return 0;
+    const char* tail = name + (nlen - slen);
+    for (size_t i = 0; i < slen; i++) {
+        char c = tail[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if (c != suffix[i]) return 0;
+    }
+    return 1;
+}
+
+// "<dir>/<name>", inserting the separator only when needed.
+static char* join_path(const char* dir, size_t dir_len, const char* name) {
+    size_t name_len = strlen(name);
+    int need_sep = (dir_len > 0 && dir[dir_len - 1] != '/');
+    char* out = (char*)malloc(dir_len + (need_sep ? 1 : 0) + name_len + 1);
+    if (!out) return NULL;
+    memcpy(out, dir, dir_len);
+    size_t k = dir_len;
+    if (need_sep) out[k++] = '/';
+    memcpy(out + k, name, name_len + 1);
+    return out;
+}
+
+static void free_path_list(char** paths, int count) {
+    for (int i = 0; i < count; i++) free(paths[i]);
+    free(paths);
+}
+
+static int cmp_path(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// Parse header + chunk list metadata from an open fd using pread. Returns 1
+// and fills *e (except e->path) on success; 0 for anything unparseable.
+static int read_meta_fd(int fd, long long fsize, MH_VstPresetIndexEntry* e) {
+    unsigned char header[HEADER_SIZE];
+    if (fsize < HEADER_SIZE) return 0;
+    if (pread(fd, header, HEADER_SIZE, 0) != HEADER_SIZE) return 0;
+    if (memcmp(header, MAGIC, 4) != 0) return 0;
+    if (read_le_i32(header + 4) != 1) return 0;
+
+    long long list_offset = read_le_i64(header + 40);
+    if (list_offset < HEADER_SIZE || list_offset + 8 > fsize) return 0;
+
+    unsigned char list_header[8];
+    if (pread(fd, list_header, 8, (off_t)list_offset) != 8) return 0;
+    if (memcmp(list_header, CHUNK_LIST, 4) != 0) return 0;
+    int entry_count = read_le_i32(list_header + 4);
+    if (entry_count < 0 || entry_count > 128) return 0;
+
+    unsigned char entries[128 * ENTRY_SIZE];
+    size_t entries_bytes = (size_t)entry_count * ENTRY_SIZE;
+    if (list_offset + 8 + (long long)entries_bytes > fsize) return 0;
+    if (entry_count > 0 &&
+        pread(fd, entries, entries_bytes, (off_t)(list_offset + 8))
+            != (ssize_t)entries_bytes) {
+        return 0;
+    }
+
+    copy_class_id(e->class_id, header + 8);
+    e->file_size = fsize;
+    e->component_size = -1;
+    e->controller_size = -1;
+    for (int i = 0; i < entry_count; i++) {
+        const unsigned char* entry = entries + (size_t)i * ENTRY_SIZE;
+        long long chunk_offset = read_le_i64(entry + 4);
+        long long chunk_size = read_le_i64(entry + 12);
+        if (chunk_offset < 0 || chunk_size < 0) continue;
+        if (chunk_offset + chunk_size > fsize) return 0;
+        if (memcmp(entry, CHUNK_COMP, 4) == 0) {
+            e->component_size = chunk_size;
+        } else if (memcmp(entry, CHUNK_CONT, 4) == 0) {
+            e->controller_size = chunk_size;
+        }
+    }
+    return 1;
+}
+
+int mh_vstpreset_index_dir(const char* dir_path,
+                           MH_VstPresetIndexEntry** entries_out, int* count_out,
+                           char* err_buf, size_t err_buf_size) {
+    if (!dir_path || !entries_out || !count_out) {
+        set_err(err_buf, err_buf_size, "Invalid arguments");
+        return 0;
+    }
+    *entries_out = NULL;
+    *count_out = 0;
+
+    DIR* dir = opendir(dir_path);
+    if (!dir) {
+        set_err(err_buf, err_buf_size, "Cannot open preset directory");
+        return 0;
+    }
+
+    // Collect full paths first so we can sort them (stable output order)
+    // and feed the readahead pipeline in batches.
+    size_t dir_len = strlen(dir_path);
+    char** paths = NULL;
+    int num_paths = 0, cap_paths = 0;
+    struct dirent* de;
+    while ((de = readdir(dir)) != NULL) {
+        if (!has_vstpreset_suffix(de->d_name)) continue;
+        if (num_paths == cap_paths) {
+            int new_cap = cap_paths ? cap_paths * 2 : 64;
+            char** grown = (char**)realloc(paths, (size_t)new_cap * sizeof(char*));
+            if (!grown) {
+                closedir(dir);
+                free_path_list(paths, num_paths);
+                set_err(err_buf, err_buf_size, "Out of memory");
+                return 0;
+            }
+            paths = grown;
+            cap_paths = new_cap;
+        }
+        paths[num_paths] = join_path(dir_path, dir_len, de->d_name);
+        if (!paths[num_paths]) {
+            closedir(dir);
+            free_path_list(paths, num_paths);
+            set_err(err_buf, err_buf_size, "Out of memory");
+            return 0;
+        }
+        num_paths++;
+    }
+    closedir(dir);
+
+    if (num_paths == 0) return 1;
+
+    qsort(paths, (size_t)num_paths, sizeof(char*), cmp_path);
+
+    MH_VstPresetIndexEntry* entries =
+        (MH_VstPresetIndexEntry*)calloc((size_t)num_paths, sizeof(*entries));
+    if (!entries) {
+        free_path_list(paths, num_paths);
+        set_err(err_buf, err_buf_size, "Out of memory");
+        return 0;
+    }
+    int num_entries = 0;
+
+    int batch_fds[INDEX_BATCH];
+    long long batch_sizes[INDEX_BATCH];
+
+    for (int start = 0; start < num_paths; start += INDEX_BATCH) {
+        int batch = num_paths - start;
+        if (batch > INDEX_BATCH) batch = INDEX_BATCH;
+
+        // Phase 1: open the whole batch and hint the pages we are about to
+        // read — the header at the front and the chunk list at the tail
+        // (where mh_vstpreset_write and the VST3 SDK both place it) — so
+        // the kernel overlaps the I/O with our parsing.
+        for (int i = 0; i < batch; i++) {
+            batch_fds[i] = -1;
+            batch_sizes[i] = 0;
+            int fd = open(paths[start + i], O_RDONLY);
+            if (fd < 0) continue;
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+                close(fd);
+                continue;
+            }
+            batch_fds[i] = fd;
+            batch_sizes[i] = (long long)st.st_size;
+#ifdef POSIX_FADV_WILLNEED
+            posix_fadvise(fd, 0, 4096, POSIX_FADV_WILLNEED);
+            if (st.st_size > 4096) {
+                posix_fadvise(fd, st.st_size - 4096, 4096,
+                              POSIX_FADV_WILLNEED);
+            }
+#endif
+        }
+
+        // Phase 2: parse metadata from the (now warm) pages. Unparseable
+        // files are skipped rather than failing the whole index.
+        for (int i = 0; i < batch; i++) {
+            int fd = batch_fds[i];
+            if (fd < 0) continue;
+            MH_VstPresetIndexEntry* e = &entries[num_entries];
+            if (read_meta_fd(fd, batch_sizes[i], e)) {
+                e->path = paths[start + i];
+                paths[start + i] = NULL;  // ownership moved to the entry
+                num_entries++;
+            }
+            close(fd);
+        }
+    }
+
+    free_path_list(paths, num_paths);
+
+    if (num_entries == 0) {
+        free(entries);
+        return 1;
+    }
+    *entries_out = entries;
+    *count_out = num_entries;
+    return 1;
+}
+
+#else  // _WIN32
+
+int mh_vstpreset_index_dir(const char* dir_path,
+                           MH_VstPresetIndexEntry** entries_out, int* count_out,
+                           char* err_buf, size_t err_buf_size) {
+    (void)dir_path;
+    if (entries_out) *entries_out = NULL;
+    if (count_out) *count_out = 0;
+    set_err(err_buf, err_buf_size,
+            "Preset directory indexing is not implemented on Windows");
+    return 0;
+}
+
+#endif  // _WIN32
+
 // ---- moduleinfo.json scanner --------------------------------------------
 //
 // VST3 SDK 3.7.5+ plugins ship a `Contents/Resources/moduleinfo.json` file
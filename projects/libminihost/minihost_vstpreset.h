@@ -58,6 +58,91 @@ int mh_vstpreset_read(const char* path, MH_VstPreset* out,
 // Safe to call on a zero-initialised struct.
 void mh_vstpreset_free(MH_VstPreset* preset);
 
+// ---- Lazy preset handle --------------------------------------------------
+//
+// mh_vstpreset_read() loads the whole file and copies every chunk up front,
+// which is the right call when the preset is about to be applied. Preset
+// browsers, however, index tens of thousands of files and only need the
+// class ID and chunk sizes. MH_VstPresetFile maps the file (mmap on POSIX,
+// buffered stdio elsewhere) and parses only the 48-byte header and the chunk
+// list; the state chunks are not touched until a state accessor is called,
+// so a metadata-only query faults in at most two pages per file.
+//
+// Pointers returned by the state accessors point into the mapping (or into
+// an internal buffer on the stdio fallback) and remain valid until
+// mh_vstpreset_close(). They are read-only; copy the bytes if they must
+// outlive the handle.
+
+typedef struct MH_VstPresetFile MH_VstPresetFile;
+
+// Open a .vstpreset file and parse its header and chunk list.
+// Returns a handle on success, or NULL on failure (writes error to err_buf).
+// The handle must be released with mh_vstpreset_close().
+MH_VstPresetFile* mh_vstpreset_open(const char* path,
+                                    char* err_buf, size_t err_buf_size);
+
+// The processor class ID from the header (NUL-terminated, trailing NULs
+// stripped, same as MH_VstPreset.class_id). Valid until close.
+const char* mh_vstpreset_file_class_id(const MH_VstPresetFile* file);
+
+// Total file size in bytes.
+long long mh_vstpreset_file_size(const MH_VstPresetFile* file);
+
+// Size of the 'Comp' / 'Cont' chunk in bytes, or -1 if the chunk is not
+// present in the file. These are metadata queries: they never read the
+// chunk contents.
+long long mh_vstpreset_file_component_size(const MH_VstPresetFile* file);
+long long mh_vstpreset_file_controller_size(const MH_VstPresetFile* file);
+
+// Borrow the 'Comp' / 'Cont' chunk contents. This is the lazy load: the
+// chunk bytes are faulted in (or read from disk on the stdio fallback) on
+// the first call. Returns NULL if the chunk is absent or an I/O error
+// occurs (writes error to err_buf). A present but empty chunk returns a
+// non-NULL pointer; use the size accessors to get the byte count.
+const void* mh_vstpreset_file_component_state(MH_VstPresetFile* file,
+                                              char* err_buf, size_t err_buf_size);
+const void* mh_vstpreset_file_controller_state(MH_VstPresetFile* file,
+                                               char* err_buf, size_t err_buf_size);
+
+// Release the handle. Safe to call with NULL.
+void mh_vstpreset_close(MH_VstPresetFile* file);
+
+// ---- Bulk directory index ------------------------------------------------
+
+// One indexed preset. `path` is a heap-allocated full path owned by the
+// entry array; sizes follow the handle conventions above (-1 = chunk
+// absent).
+typedef struct MH_VstPresetIndexEntry {
+    char* path;
+    char class_id[MH_VSTPRESET_CLASS_ID_LEN + 1];
+    long long file_size;
+    long long component_size;
+    long long controller_size;
+} MH_VstPresetIndexEntry;
+
+// Index every *.vstpreset file (case-insensitive suffix match) directly in
+// dir_path — the scan is not recursive. Entries are sorted by file name so
+// the result is stable across runs. Files that fail to parse are skipped;
+// an unreadable directory is an error.
+//
+// On POSIX the scanner issues readahead hints (posix_fadvise WILLNEED on
+// the header page and the tail page, where the chunk list lives) for a
+// batch of files ahead of the one being parsed, so the kernel overlaps I/O
+// with parsing. Only metadata is read — state chunks are never touched.
+//
+// On success, stores a malloc'd array in *entries_out (NULL if the
+// directory holds no presets), the entry count in *count_out, and returns 1.
+// The caller must release the array with mh_vstpreset_index_free().
+// On failure, writes an error to err_buf and returns 0.
+// Not implemented on Windows (returns 0).
+int mh_vstpreset_index_dir(const char* dir_path,
+                           MH_VstPresetIndexEntry** entries_out, int* count_out,
+                           char* err_buf, size_t err_buf_size);
+
+// Free an entry array returned by mh_vstpreset_index_dir().
+// Safe to call with NULL.
+void mh_vstpreset_index_free(MH_VstPresetIndexEntry* entries, int count);
+
 // Write a .vstpreset file.
 // class_id is truncated to 32 bytes or NUL-padded as needed.
 // controller_state may be NULL (in which case only the 'Comp' chunk is written).
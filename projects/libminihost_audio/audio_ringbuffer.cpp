@@ -32,6 +32,72 @@ static int next_power_of_2(int n) {
     return n;
 }
 
+// Interleave one contiguous run of planar source frames (each channel
+// read from src[c] + src_offset) into interleaved dst. Same kernel
+// shape as mh_audio_interleave in minihost_audiofile.c: mono is a
+// straight memcpy, stereo is a single pass the compiler turns into
+// vector shuffles, other channel counts are per-channel strided loops.
+// copy_ch may be less than dst_ch; the extra destination channels are
+// zeroed.
+static void interleave_run(const float* const* src, int src_offset, float* dst,
+                           int frames, int copy_ch, int dst_ch) {
+    if (copy_ch == 1 && dst_ch == 1) {
+        std::memcpy(dst, src[0] + src_offset,
+                    static_cast<size_t>(frames) * sizeof(float));
+        return;
+    }
+    if (copy_ch == 2 && dst_ch == 2) {
+        const float* l = src[0] + src_offset;
+        const float* r = src[1] + src_offset;
+        for (int i = 0; i < frames; i++) {
+            dst[i * 2] = l[i];
+            dst[i * 2 + 1] = r[i];
+        }
+        return;
+    }
+    for (int c = 0; c < copy_ch; c++) {
+        const float* in = src[c] + src_offset;
+        float* out = dst + c;
+        for (int i = 0; i < frames; i++) {
+            out[i * dst_ch] = in[i];
+        }
+    }
+    for (int c = copy_ch; c < dst_ch; c++) {
+        float* out = dst + c;
+        for (int i = 0; i < frames; i++) {
+            out[i * dst_ch] = 0.0f;
+        }
+    }
+}
+
+// De-interleave one contiguous run of interleaved src into planar
+// destination buffers (each channel written at dst[c] + dst_offset).
+// Mirror of interleave_run, same fast paths.
+static void deinterleave_run(const float* src, float* const* dst, int dst_offset,
+                             int frames, int copy_ch, int src_ch) {
+    if (copy_ch == 1 && src_ch == 1) {
+        std::memcpy(dst[0] + dst_offset, src,
+                    static_cast<size_t>(frames) * sizeof(float));
+        return;
+    }
+    if (copy_ch == 2 && src_ch == 2) {
+        float* l = dst[0] + dst_offset;
+        float* r = dst[1] + dst_offset;
+        for (int i = 0; i < frames; i++) {
+            l[i] = src[i * 2];
+            r[i] = src[i * 2 + 1];
+        }
+        return;
+    }
+    for (int c = 0; c < copy_ch; c++) {
+        const float* in = src + c;
+        float* out = dst[c] + dst_offset;
+        for (int i = 0; i < frames; i++) {
+            out[i] = in[i * src_ch];
+        }
+    }
+}
+
 extern "C" {
 
 MH_AudioRingBuffer* mh_audio_ringbuffer_create(int channels, int capacity_frames) {
@@ -78,9 +144,43 @@ int mh_audio_ringbuffer_push(MH_AudioRingBuffer* rb, const float* data, int nfra
     int to_write = nframes < available ? nframes : available;
     int ch = rb->channels;
 
-    for (int f = 0; f < to_write; f++) {
-        int idx = ((write + f) & rb->mask) * ch;
-        std::memcpy(&rb->buffer[idx], &data[f * ch], ch * sizeof(float));
+    // Source and storage are both interleaved, so this is two contiguous
+    // memcpy runs (wraparound) -- no per-frame loop.
+    int first = rb->capacity - write;
+    if (first > to_write) first = to_write;
+    std::memcpy(&rb->buffer[write * ch], data,
+                static_cast<size_t>(first) * ch * sizeof(float));
+    if (to_write > first) {
+        std::memcpy(&rb->buffer[0], data + static_cast<size_t>(first) * ch,
+                    static_cast<size_t>(to_write - first) * ch * sizeof(float));
+    }
+
+    rb->write_pos.store((write + to_write) & rb->mask, std::memory_order_release);
+    return to_write;
+}
+
+int mh_audio_ringbuffer_push_planar(MH_AudioRingBuffer* rb, const float* const* data,
+                                    int channels, int nframes) {
+    if (!rb || !data || channels <= 0 || nframes <= 0) return 0;
+
+    int write = rb->write_pos.load(std::memory_order_relaxed);
+    int read = rb->read_pos.load(std::memory_order_acquire);
+
+    int used = (write - read) & rb->mask;
+    int available = rb->capacity - 1 - used;
+    if (available <= 0) return 0;
+
+    int to_write = nframes < available ? nframes : available;
+    int ch = rb->channels;
+    int copy_ch = channels < ch ? channels : ch;
+
+    // Interleave straight into ring storage in at most two contiguous
+    // runs -- the producer needs no staging copy of its own.
+    int first = rb->capacity - write;
+    if (first > to_write) first = to_write;
+    interleave_run(data, 0, &rb->buffer[write * ch], first, copy_ch, ch);
+    if (to_write > first) {
+        interleave_run(data, first, &rb->buffer[0], to_write - first, copy_ch, ch);
     }
 
     rb->write_pos.store((write + to_write) & rb->mask, std::memory_order_release);
@@ -107,22 +207,26 @@ int mh_audio_ringbuffer_read_into(MH_AudioRingBuffer* rb, float* const* buffers,
     int rb_ch = rb->channels;
     int copy_ch = channels < rb_ch ? channels : rb_ch;
 
-    // De-interleave from ring buffer into per-channel output buffers
-    for (int f = 0; f < to_read; f++) {
-        int idx = ((read + f) & rb->mask) * rb_ch;
-        for (int c = 0; c < copy_ch; c++) {
-            buffers[c][f] = rb->buffer[idx + c];
-        }
-        // Zero extra output channels not in ring buffer
-        for (int c = copy_ch; c < channels; c++) {
-            buffers[c][f] = 0.0f;
-        }
+    // De-interleave from ring storage in at most two contiguous runs
+    // (wraparound) through the vectorized kernels.
+    int first = rb->capacity - read;
+    if (first > to_read) first = to_read;
+    deinterleave_run(&rb->buffer[read * rb_ch], buffers, 0, first, copy_ch, rb_ch);
+    if (to_read > first) {
+        deinterleave_run(&rb->buffer[0], buffers, first, to_read - first,
+                         copy_ch, rb_ch);
+    }
+
+    // Zero extra output channels not in the ring buffer
+    for (int c = copy_ch; c < channels; c++) {
+        std::memset(buffers[c], 0, to_read * sizeof(float));
     }
 
     // Zero remaining frames (underrun silence)
-    for (int f = to_read; f < nframes; f++) {
+    if (to_read < nframes) {
         for (int c = 0; c < channels; c++) {
-            buffers[c][f] = 0.0f;
+            std::memset(buffers[c] + to_read, 0,
+                        (nframes - to_read) * sizeof(float));
         }
     }
 
@@ -133,6 +237,32 @@ int mh_audio_ringbuffer_read_into(MH_AudioRingBuffer* rb, float* const* buffers,
     return to_read;
 }
 
+int mh_audio_ringbuffer_read_interleaved(MH_AudioRingBuffer* rb, float* dst, int nframes) {
+    if (!rb || !dst || nframes <= 0) return 0;
+
+    int read = rb->read_pos.load(std::memory_order_relaxed);
+    int write = rb->write_pos.load(std::memory_order_acquire);
+
+    int avail = (write - read) & rb->mask;
+    int to_read = nframes < avail ? nframes : avail;
+    if (to_read == 0) return 0;
+
+    // Storage is already interleaved, so copy in at most two contiguous
+    // runs (wraparound) -- no per-frame loop.
+    int ch = rb->channels;
+    int first = rb->capacity - read;
+    if (first > to_read) first = to_read;
+    std::memcpy(dst, &rb->buffer[read * ch],
+                static_cast<size_t>(first) * ch * sizeof(float));
+    if (to_read > first) {
+        std::memcpy(dst + static_cast<size_t>(first) * ch, &rb->buffer[0],
+                    static_cast<size_t>(to_read - first) * ch * sizeof(float));
+    }
+
+    rb->read_pos.store((read + to_read) & rb->mask, std::memory_order_release);
+    return to_read;
+}
+
 void mh_audio_ringbuffer_clear(MH_AudioRingBuffer* rb) {
     if (!rb) return;
     rb->write_pos.store(0, std::memory_order_relaxed);
@@ -146,6 +276,11 @@ int mh_audio_ringbuffer_available(MH_AudioRingBuffer* rb) {
     return (write - read) & rb->mask;
 }
 
+int mh_audio_ringbuffer_capacity(MH_AudioRingBuffer* rb) {
+    if (!rb) return 0;
+    return rb->capacity;
+}
+
 int mh_audio_ringbuffer_channels(MH_AudioRingBuffer* rb) {
     if (!rb) return 0;
     return rb->channels;
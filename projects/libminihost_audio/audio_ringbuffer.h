@@ -32,6 +32,18 @@ void mh_audio_ringbuffer_free(MH_AudioRingBuffer* rb);
 // Returns number of frames actually written (may be less if buffer is full).
 int mh_audio_ringbuffer_push(MH_AudioRingBuffer* rb, const float* data, int nframes);
 
+// Push planar frames into the ring buffer (producer thread).
+// data: array of per-channel float pointers [channel][frame]
+// channels: number of source channels; extra ring-buffer channels (if
+// the buffer has more) are zero-filled, extra source channels dropped.
+// Interleaving happens once, straight into the ring storage through
+// the same split-out stereo / strided-loop kernels as
+// mh_audio_interleave, so planar producers (AudioBuffer, numpy
+// (channels, frames) arrays) skip their own staging copy.
+// Returns number of frames actually written (may be less if buffer is full).
+int mh_audio_ringbuffer_push_planar(MH_AudioRingBuffer* rb, const float* const* data,
+                                    int channels, int nframes);
+
 // Read frames from the ring buffer into non-interleaved channel buffers (consumer/audio thread).
 // buffers: array of per-channel float pointers [channel][frame]
 // nframes: number of frames to read
@@ -41,12 +53,24 @@ int mh_audio_ringbuffer_push(MH_AudioRingBuffer* rb, const float* data, int nfra
 int mh_audio_ringbuffer_read_into(MH_AudioRingBuffer* rb, float* const* buffers,
                                    int nframes, int channels);
 
+// Read up to nframes interleaved frames into dst (consumer thread).
+// Unlike read_into, the data stays interleaved (two contiguous memcpy
+// runs at most) and nothing is silence-filled -- short reads just
+// return fewer frames. For consumers that want raw frames, e.g. a
+// disk-writer thread draining the recording tap.
+// Returns the number of frames actually read (0 if empty).
+int mh_audio_ringbuffer_read_interleaved(MH_AudioRingBuffer* rb, float* dst, int nframes);
+
 // Clear the ring buffer (not thread-safe, call when not playing).
 void mh_audio_ringbuffer_clear(MH_AudioRingBuffer* rb);
 
 // Get number of frames available for reading (approximate, for diagnostics).
 int mh_audio_ringbuffer_available(MH_AudioRingBuffer* rb);
 
+// Get the capacity in frames (after the power-of-2 round-up; one frame
+// of it is always unusable to distinguish full from empty).
+int mh_audio_ringbuffer_capacity(MH_AudioRingBuffer* rb);
+
 // Get the channel count.
 int mh_audio_ringbuffer_channels(MH_AudioRingBuffer* rb);
 
@@ -7,8 +7,10 @@
 #include <cstring>
 #include <new>
 
+// Slots store the timed form; the plain push/pop API wraps it with
+// time_sec = -1 ("unknown") so both views share one buffer.
 struct MH_MidiRingBuffer {
-    MH_MidiEvent* buffer;
+    MH_MidiTimedEvent* buffer;
     int capacity;
     int mask;  // capacity - 1, for fast modulo with power of 2
     std::atomic<int> write_pos;
@@ -40,7 +42,7 @@ MH_MidiRingBuffer* mh_midi_ringbuffer_create(int capacity) {
     MH_MidiRingBuffer* rb = new (std::nothrow) MH_MidiRingBuffer();
     if (!rb) return nullptr;
 
-    rb->buffer = static_cast<MH_MidiEvent*>(std::calloc(capacity, sizeof(MH_MidiEvent)));
+    rb->buffer = static_cast<MH_MidiTimedEvent*>(std::calloc(capacity, sizeof(MH_MidiTimedEvent)));
     if (!rb->buffer) {
         delete rb;
         return nullptr;
@@ -60,7 +62,8 @@ void mh_midi_ringbuffer_free(MH_MidiRingBuffer* rb) {
     delete rb;
 }
 
-int mh_midi_ringbuffer_push(MH_MidiRingBuffer* rb, const MH_MidiEvent* event) {
+int mh_midi_ringbuffer_push_timed(MH_MidiRingBuffer* rb, const MH_MidiEvent* event,
+                                  double time_sec) {
     if (!rb || !event) return 0;
 
     int write = rb->write_pos.load(std::memory_order_relaxed);
@@ -73,7 +76,8 @@ int mh_midi_ringbuffer_push(MH_MidiRingBuffer* rb, const MH_MidiEvent* event) {
     }
 
     // Write the event
-    rb->buffer[write] = *event;
+    rb->buffer[write].event = *event;
+    rb->buffer[write].time_sec = time_sec;
 
     // Publish the write
     rb->write_pos.store(next_write, std::memory_order_release);
@@ -81,6 +85,95 @@ int mh_midi_ringbuffer_push(MH_MidiRingBuffer* rb, const MH_MidiEvent* event) {
     return 1;
 }
 
+int mh_midi_ringbuffer_push(MH_MidiRingBuffer* rb, const MH_MidiEvent* event) {
+    return mh_midi_ringbuffer_push_timed(rb, event, -1.0);
+}
+
+int mh_midi_ringbuffer_push_n_timed(MH_MidiRingBuffer* rb, const MH_MidiTimedEvent* events,
+                                    int n) {
+    if (!rb || !events || n <= 0) return 0;
+
+    int write = rb->write_pos.load(std::memory_order_relaxed);
+    int read = rb->read_pos.load(std::memory_order_acquire);
+
+    // One slot stays unused so full != empty.
+    int free_slots = (read - write - 1) & rb->mask;
+    int count = (n < free_slots) ? n : free_slots;
+    if (count == 0) return 0;
+
+    // Copy in at most two contiguous runs (wraparound).
+    int first = rb->capacity - write;
+    if (first > count) first = count;
+    std::memcpy(&rb->buffer[write], events, first * sizeof(*events));
+    if (count > first) {
+        std::memcpy(&rb->buffer[0], events + first, (count - first) * sizeof(*events));
+    }
+
+    // Publish all writes at once
+    rb->write_pos.store((write + count) & rb->mask, std::memory_order_release);
+
+    return count;
+}
+
+int mh_midi_ringbuffer_push_n(MH_MidiRingBuffer* rb, const MH_MidiEvent* events, int n) {
+    if (!rb || !events || n <= 0) return 0;
+
+    int write = rb->write_pos.load(std::memory_order_relaxed);
+    int read = rb->read_pos.load(std::memory_order_acquire);
+
+    int free_slots = (read - write - 1) & rb->mask;
+    int count = (n < free_slots) ? n : free_slots;
+
+    // No memcpy here: the slot type is timed, so each event is wrapped
+    // with the "unknown" stamp as it lands.
+    for (int i = 0; i < count; i++) {
+        int idx = (write + i) & rb->mask;
+        rb->buffer[idx].event = events[i];
+        rb->buffer[idx].time_sec = -1.0;
+    }
+
+    // Publish all writes at once
+    if (count > 0) {
+        rb->write_pos.store((write + count) & rb->mask, std::memory_order_release);
+    }
+
+    return count;
+}
+
+int mh_midi_ringbuffer_reserve(MH_MidiRingBuffer* rb, int n,
+                               MH_MidiTimedEvent** seg1, int* n1,
+                               MH_MidiTimedEvent** seg2, int* n2) {
+    if (seg1) *seg1 = nullptr;
+    if (seg2) *seg2 = nullptr;
+    if (n1) *n1 = 0;
+    if (n2) *n2 = 0;
+    if (!rb || n <= 0 || !seg1 || !n1 || !seg2 || !n2) return 0;
+
+    int write = rb->write_pos.load(std::memory_order_relaxed);
+    int read = rb->read_pos.load(std::memory_order_acquire);
+
+    int free_slots = (read - write - 1) & rb->mask;
+    int count = (n < free_slots) ? n : free_slots;
+    if (count == 0) return 0;
+
+    int first = rb->capacity - write;
+    if (first > count) first = count;
+    *seg1 = &rb->buffer[write];
+    *n1 = first;
+    if (count > first) {
+        *seg2 = &rb->buffer[0];
+        *n2 = count - first;
+    }
+    return count;
+}
+
+void mh_midi_ringbuffer_commit(MH_MidiRingBuffer* rb, int n) {
+    if (!rb || n <= 0) return;
+
+    int write = rb->write_pos.load(std::memory_order_relaxed);
+    rb->write_pos.store((write + n) & rb->mask, std::memory_order_release);
+}
+
 int mh_midi_ringbuffer_pop(MH_MidiRingBuffer* rb, MH_MidiEvent* event) {
     if (!rb || !event) return 0;
 
@@ -92,7 +185,7 @@ int mh_midi_ringbuffer_pop(MH_MidiRingBuffer* rb, MH_MidiEvent* event) {
     }
 
     // Read the event
-    *event = rb->buffer[read];
+    *event = rb->buffer[read].event;
 
     // Publish the read
     rb->read_pos.store((read + 1) & rb->mask, std::memory_order_release);
@@ -107,6 +200,28 @@ int mh_midi_ringbuffer_pop_all(MH_MidiRingBuffer* rb, MH_MidiEvent* events, int
     int read = rb->read_pos.load(std::memory_order_relaxed);
     int write = rb->write_pos.load(std::memory_order_acquire);
 
+    while (read != write && count < max_events) {
+        events[count] = rb->buffer[read].event;
+        read = (read + 1) & rb->mask;
+        count++;
+    }
+
+    // Publish all reads at once
+    if (count > 0) {
+        rb->read_pos.store(read, std::memory_order_release);
+    }
+
+    return count;
+}
+
+int mh_midi_ringbuffer_pop_all_timed(MH_MidiRingBuffer* rb, MH_MidiTimedEvent* events,
+                                     int max_events) {
+    if (!rb || !events || max_events <= 0) return 0;
+
+    int count = 0;
+    int read = rb->read_pos.load(std::memory_order_relaxed);
+    int write = rb->write_pos.load(std::memory_order_acquire);
+
     while (read != write && count < max_events) {
         events[count] = rb->buffer[read];
         read = (read + 1) & rb->mask;
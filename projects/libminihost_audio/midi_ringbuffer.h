@@ -23,10 +23,55 @@ MH_MidiRingBuffer* mh_midi_ringbuffer_create(int capacity);
 // Free a ring buffer
 void mh_midi_ringbuffer_free(MH_MidiRingBuffer* rb);
 
+// A MIDI event paired with its receipt time (seconds on the caller's
+// monotonic clock). time_sec < 0 means "unknown" -- events pushed via
+// the plain mh_midi_ringbuffer_push carry -1.
+typedef struct MH_MidiTimedEvent {
+    MH_MidiEvent event;
+    double time_sec;
+} MH_MidiTimedEvent;
+
 // Push an event to the ring buffer (producer/MIDI thread)
 // Returns 1 on success, 0 if buffer is full
 int mh_midi_ringbuffer_push(MH_MidiRingBuffer* rb, const MH_MidiEvent* event);
 
+// Push an event stamped with its receipt time (producer/MIDI thread).
+// The consumer converts the timestamp into a per-event sample offset
+// against the audio clock (see mh_midi_ringbuffer_pop_all_timed).
+// Returns 1 on success, 0 if buffer is full
+int mh_midi_ringbuffer_push_timed(MH_MidiRingBuffer* rb, const MH_MidiEvent* event,
+                                  double time_sec);
+
+// Bulk push: copy up to n events in one synchronization round-trip
+// (one acquire of the read position, one release of the write
+// position -- instead of an atomic pair per event). Events are
+// stamped with time_sec = -1 ("unknown"). Returns the number of
+// events actually pushed (may be < n if the buffer fills).
+int mh_midi_ringbuffer_push_n(MH_MidiRingBuffer* rb, const MH_MidiEvent* events, int n);
+
+// Bulk push of timestamped events; same synchronization cost as
+// mh_midi_ringbuffer_push_n. Returns the number pushed.
+int mh_midi_ringbuffer_push_n_timed(MH_MidiRingBuffer* rb, const MH_MidiTimedEvent* events,
+                                    int n);
+
+// Zero-copy producer API: reserve up to n slots for in-place writes
+// (producer/MIDI thread). On return, *seg1/*n1 and *seg2/*n2 describe
+// at most two contiguous slot runs (the second is non-empty only when
+// the reservation wraps the end of the buffer). Fill the slots, then
+// publish with mh_midi_ringbuffer_commit. Returns the total number of
+// slots reserved, i.e. *n1 + *n2 (0 if the buffer is full).
+//
+// A reservation is only a window onto unpublished slots -- nothing is
+// held, so reserving again before committing simply returns the same
+// window. Commit fewer slots than reserved to drop the tail.
+int mh_midi_ringbuffer_reserve(MH_MidiRingBuffer* rb, int n,
+                               MH_MidiTimedEvent** seg1, int* n1,
+                               MH_MidiTimedEvent** seg2, int* n2);
+
+// Publish the first n reserved slots (producer/MIDI thread). n must
+// not exceed the count returned by the matching reserve.
+void mh_midi_ringbuffer_commit(MH_MidiRingBuffer* rb, int n);
+
 // Pop a single event from the ring buffer (consumer/audio thread)
 // Returns 1 on success, 0 if buffer is empty
 int mh_midi_ringbuffer_pop(MH_MidiRingBuffer* rb, MH_MidiEvent* event);
@@ -35,6 +80,12 @@ int mh_midi_ringbuffer_pop(MH_MidiRingBuffer* rb, MH_MidiEvent* event);
 // Returns number of events popped
 int mh_midi_ringbuffer_pop_all(MH_MidiRingBuffer* rb, MH_MidiEvent* events, int max_events);
 
+// Pop all available events with their receipt timestamps
+// (consumer/audio thread). Events pushed without a timestamp come out
+// with time_sec = -1. Returns number of events popped
+int mh_midi_ringbuffer_pop_all_timed(MH_MidiRingBuffer* rb, MH_MidiTimedEvent* events,
+                                     int max_events);
+
 // Check if buffer is empty (approximate, for debugging)
 int mh_midi_ringbuffer_is_empty(MH_MidiRingBuffer* rb);
 
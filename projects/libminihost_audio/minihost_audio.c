@@ -6,6 +6,7 @@
 #include "miniaudio.h"
 
 #include "minihost_audio.h"
+#include "minihost_audiofile.h"
 #include "minihost_midi.h"
 #include "midi_ringbuffer.h"
 #include "audio_ringbuffer.h"
@@ -40,6 +41,37 @@ static inline void mh_atomic_store_release_ptr(void* volatile* slot, void* value
 }
 #endif
 
+// Same idea for 64-bit counters (callback load and xrun count). The audio
+// thread is the only writer, so relaxed ordering suffices; the MSVC
+// interlocked fallbacks are full barriers, which is merely stronger.
+#if defined(_MSC_VER)
+static inline long long mh_atomic_load_relaxed_i64(volatile long long* slot) {
+    return _InterlockedCompareExchange64(slot, 0, 0);
+}
+static inline void mh_atomic_store_relaxed_i64(volatile long long* slot, long long value) {
+    (void)_InterlockedExchange64(slot, value);
+}
+#else
+static inline long long mh_atomic_load_relaxed_i64(volatile long long* slot) {
+    return __atomic_load_n(slot, __ATOMIC_RELAXED);
+}
+static inline void mh_atomic_store_relaxed_i64(volatile long long* slot, long long value) {
+    __atomic_store_n(slot, value, __ATOMIC_RELAXED);
+}
+#endif
+
+// Doubles travel through the 64-bit atomic slots as raw bit patterns.
+static inline long long mh_double_to_bits(double d) {
+    long long bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+static inline double mh_bits_to_double(long long bits) {
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
 struct MH_AudioDevice {
     ma_device device;
     ma_context context;
@@ -81,10 +113,104 @@ struct MH_AudioDevice {
     // Audio input ring buffer (for write_input / effect processing)
     MH_AudioRingBuffer* audio_in_buffer;
 
+    // Drift-compensated input consumption (mh_audio_set_input_drift_comp).
+    // Configured while the device is stopped, like enable_input; the
+    // resampler, scratch buffers and controller state are then owned by
+    // the audio thread. ratio/fill stats cross back to app threads
+    // through the relaxed 64-bit atomics as double bits, like load_bits.
+    int input_drift_enabled;
+    ma_resampler input_resampler;
+    int input_resampler_ready;
+    float* drift_in_scratch;     // interleaved frames read from the ring
+    float* drift_out_scratch;    // interleaved resampler output
+    int drift_scratch_frames;
+    double drift_fill_avg;       // audio-thread owned
+    int drift_fill_target;
+    volatile long long drift_ratio_bits;
+    volatile long long drift_fill_avg_bits;
+    volatile long long drift_underruns;
+
+    // MIDI timing. midi_clock is a device-wide monotonic clock started
+    // at open; the MIDI thread stamps each incoming event with it and
+    // the audio thread converts the stamps into per-event sample
+    // offsets within the block (see audio_callback). Reading the timer
+    // from two threads is safe: ma_timer_get_time_in_seconds only
+    // reads the start counter set at init. prev_block_time is owned by
+    // the audio thread.
+    ma_timer midi_clock;
+    double prev_block_time;
+
+    // Preloaded loop-audio source (mh_audio_set_loop_source). Same
+    // publish/retire discipline as cc_map below; the play position
+    // lives inside the source and is owned by the audio thread once
+    // the source is published.
+    void* loop_source;          // holds an MH_LoopSource*
+    void* loop_source_retired;
+
+    // Gapless playlist (mh_audio_playlist_*). The head pointer is
+    // published like loop_source; appends publish the previous tail's
+    // next pointer with a release store, so the audio thread can walk
+    // onto items queued while it plays without a device restart. The
+    // play cursor (playlist_seen / playlist_cur / playlist_pos) is
+    // audio-thread-owned; playlist_tail / playlist_count are app-side
+    // bookkeeping; playlist_index and playlist_crossfade cross threads
+    // via the relaxed 64-bit atomics like record_dropped.
+    void* playlist;             // holds the head MH_PlaylistItem*
+    void* playlist_retired;     // displaced chain, freed on next clear/close
+    void* playlist_tail;        // app-thread append point
+    int   playlist_count;       // app-thread item count
+    void* playlist_seen;        // audio thread: head it last adopted
+    void* playlist_cur;         // audio thread: item being played
+    int   playlist_pos;         // audio thread: frame position in cur
+    long long playlist_gen_seen;            // audio thread: gen it adopted
+    volatile long long playlist_gen;        // bumped per head (re)publish --
+                                            // malloc can hand a cleared
+                                            // head's address back to a
+                                            // later one, so pointer
+                                            // equality alone cannot detect
+                                            // a fresh install
+    volatile long long playlist_index;      // current item index, -1 idle
+    volatile long long playlist_crossfade;  // splice crossfade in frames
+
+    // Compiled CC-to-parameter map (mh_audio_set_cc_map). Published
+    // through the acquire/release pointer atomics like input_callback;
+    // the audio thread reads it once per block. cc_map_retired holds
+    // the previously-installed table until the next set call (or close)
+    // so an in-flight callback never reads freed memory.
+    void* cc_map;          // holds an MH_CCMapTable*
+    void* cc_map_retired;
+
+    // Async output recorder (mh_audio_record_start). Published through
+    // the pointer atomics like cc_map; the audio thread pushes each
+    // processed block into the recorder's FIFO and the writer thread
+    // encodes it to disk. record_dropped counts frames lost to a full
+    // FIFO (disk stall); it survives record_stop so it can be read
+    // after the take.
+    void* recorder;          // holds an MH_Recorder*
+    void* recorder_retired;
+    volatile long long record_dropped;
+
+    // Callback health instrumentation. Written only by the audio thread,
+    // polled from app threads via the relaxed 64-bit atomics above.
+    // load_bits holds the smoothed duration/period ratio as double bits.
+    volatile long long load_bits;
+    volatile long long xrun_count;
+    void* overload_callback;  // holds an MH_AudioOverloadCallback; same
+    void* overload_callback_user_data;  // publication contract as input_callback
+
     // State
     int is_playing;
 };
 
+// Exponential smoothing factor for the rolling load: each callback
+// contributes ~9% of the new value, so the reading settles over roughly
+// 25 callbacks (~0.3 s at 512 frames / 48 kHz) -- responsive enough for
+// a dashboard without jittering on every block.
+#define MH_LOAD_SMOOTHING 0.91
+
+// Defined with the input-ring helpers below; needed by close/disable.
+static void free_input_drift_comp(MH_AudioDevice* dev);
+
 // Resolve playback/capture device IDs from MH_AudioConfig indices via an already-initialized context.
 // On success, stores pointers to the resolved ma_device_id into *out_playback_id / *out_capture_id
 // (which may be NULL if no selection was made). The pointed-to ma_device_info arrays remain valid
@@ -174,24 +300,248 @@ static void free_channel_buffers(float** buffers, int channels) {
     free(buffers);
 }
 
+// Heap layout for an installed loop source: header plus the planar
+// samples (channel-major, frames contiguous per channel) in one block.
+// pos is the next frame the audio callback will read; it lives here so
+// replacing the source also restarts playback.
+typedef struct MH_LoopSource {
+    int channels;
+    int frames;
+    int pos;        // audio-thread-owned after publication
+    float samples[];  // channels * frames
+} MH_LoopSource;
+
+// One queued playlist entry (mh_audio_playlist_add_audio/_add_midi).
+// Audio items carry preloaded planar samples in the flexible tail like
+// MH_LoopSource; MIDI items carry a separately-allocated sorted event
+// array (offsets are frames from the item's start) plus a duration.
+// next is append-published by the app thread with a release store and
+// walked by the audio thread with acquire loads; next_event is the
+// audio thread's event cursor once the item is reachable.
+typedef struct MH_PlaylistItem {
+    void* next;        // MH_PlaylistItem*; NULL until a later append
+    int is_midi;
+    int channels;      // audio items
+    int frames;        // item length in device frames (both kinds)
+    MH_MidiEvent* events;  // MIDI items; owned, freed with the item
+    int num_events;
+    int next_event;    // audio-thread cursor
+    float samples[];   // audio items: channels * frames, channel-major
+} MH_PlaylistItem;
+
+// Free a retired playlist chain (device stopped, or the chain has
+// survived a full install interval -- same reasoning as cc_map_retired).
+static void free_playlist_chain(MH_PlaylistItem* item) {
+    while (item) {
+        MH_PlaylistItem* next = (MH_PlaylistItem*)item->next;
+        free(item->events);
+        free(item);
+        item = next;
+    }
+}
+
+// Fill this block's plugin input from the playlist. Returns 1 when the
+// playlist produced the block (audio copied / silence under a MIDI
+// item, remainder zero-padded if the queue ran dry mid-block), 0 when
+// there is nothing to play -- the caller then falls through to the
+// next input source in precedence. Sequenced MIDI landing in this
+// block is written to pl_events with block-local offsets (sorted).
+//
+// Splices happen in place: when an item ends mid-block the next one
+// continues at the very next frame, and with a crossfade configured
+// two adjacent audio items overlap by up to that many frames (linear
+// ramps; the crossfade clamps to both item lengths, and splices
+// involving a MIDI item are hard cuts). An exhausted playlist stays
+// poised: appending another item resumes playback at the next block.
+static int playlist_fill_block(MH_AudioDevice* dev, int frames,
+                               MH_MidiEvent* pl_events, int pl_cap,
+                               int* pl_count) {
+    *pl_count = 0;
+    MH_PlaylistItem* head =
+        (MH_PlaylistItem*)mh_atomic_load_acquire_ptr(&dev->playlist);
+    if (!head) {
+        if (dev->playlist_seen) {
+            dev->playlist_seen = NULL;
+            dev->playlist_cur = NULL;
+            mh_atomic_store_relaxed_i64(&dev->playlist_index, -1);
+        }
+        return 0;
+    }
+    long long gen = mh_atomic_load_relaxed_i64(&dev->playlist_gen);
+    if (head != dev->playlist_seen || gen != dev->playlist_gen_seen) {
+        // A new list was installed (first add after open or clear):
+        // adopt it from the top.
+        dev->playlist_seen = head;
+        dev->playlist_gen_seen = gen;
+        dev->playlist_cur = head;
+        dev->playlist_pos = 0;
+        mh_atomic_store_relaxed_i64(&dev->playlist_index, 0);
+    }
+
+    MH_PlaylistItem* cur = (MH_PlaylistItem*)dev->playlist_cur;
+    int channels = dev->channels;
+    int cf = (int)mh_atomic_load_relaxed_i64(&dev->playlist_crossfade);
+    int filled = 0;
+    while (filled < frames) {
+        int rem = cur->frames - dev->playlist_pos;
+        if (rem <= 0) {
+            MH_PlaylistItem* nxt =
+                (MH_PlaylistItem*)mh_atomic_load_acquire_ptr(&cur->next);
+            if (!nxt) break;  // poised for a later append
+            // A crossfaded splice already consumed the start of the
+            // next item while blending below; skip past it.
+            int consumed = 0;
+            if (cf > 0 && !cur->is_midi && !nxt->is_midi) {
+                consumed = cf;
+                if (consumed > cur->frames) consumed = cur->frames;
+                if (consumed > nxt->frames) consumed = nxt->frames;
+            }
+            cur = nxt;
+            dev->playlist_cur = cur;
+            dev->playlist_pos = consumed;
+            mh_atomic_store_relaxed_i64(&dev->playlist_index,
+                mh_atomic_load_relaxed_i64(&dev->playlist_index) + 1);
+            continue;
+        }
+        int n = rem < frames - filled ? rem : frames - filled;
+        if (cur->is_midi) {
+            // Sequenced item: silence into the plugin, events out.
+            for (int ch = 0; ch < channels; ch++) {
+                memset(dev->input_buffers[ch] + filled, 0,
+                       (size_t)n * sizeof(float));
+            }
+            while (cur->next_event < cur->num_events) {
+                const MH_MidiEvent* ev = &cur->events[cur->next_event];
+                if (ev->sample_offset >= dev->playlist_pos + n) break;
+                if (*pl_count < pl_cap) {
+                    pl_events[*pl_count] = *ev;
+                    pl_events[*pl_count].sample_offset =
+                        filled + (ev->sample_offset - dev->playlist_pos);
+                    (*pl_count)++;
+                }
+                cur->next_event++;
+            }
+        } else {
+            for (int ch = 0; ch < channels; ch++) {
+                const float* src = cur->samples
+                    + (size_t)(ch % cur->channels) * cur->frames
+                    + dev->playlist_pos;
+                memcpy(dev->input_buffers[ch] + filled, src,
+                       (size_t)n * sizeof(float));
+            }
+            // Crossfade tail: blend the next item's opening frames
+            // over this item's final ones. Only audio-to-audio splices
+            // fade; the ramp is linear and touches just the overlap.
+            MH_PlaylistItem* nxt =
+                (MH_PlaylistItem*)mh_atomic_load_acquire_ptr(&cur->next);
+            if (cf > 0 && nxt && !nxt->is_midi) {
+                int xf = cf;
+                if (xf > cur->frames) xf = cur->frames;
+                if (xf > nxt->frames) xf = nxt->frames;
+                int fade_start = cur->frames - xf;
+                int p0 = dev->playlist_pos > fade_start
+                             ? dev->playlist_pos : fade_start;
+                for (int p = p0; p < dev->playlist_pos + n; p++) {
+                    float t = (float)(p - fade_start + 1) / (float)(xf + 1);
+                    int f = filled + (p - dev->playlist_pos);
+                    int b = p - fade_start;  // position in next item
+                    for (int ch = 0; ch < channels; ch++) {
+                        float a = dev->input_buffers[ch][f];
+                        float bs = nxt->samples
+                            [(size_t)(ch % nxt->channels) * nxt->frames + b];
+                        dev->input_buffers[ch][f] = a * (1.0f - t) + bs * t;
+                    }
+                }
+            }
+        }
+        dev->playlist_pos += n;
+        filled += n;
+    }
+    if (filled == 0) return 0;
+    if (filled < frames) {
+        // Queue ran dry mid-block: pad to the block edge so the
+        // splice point for a later append stays block-aligned.
+        for (int ch = 0; ch < channels; ch++) {
+            memset(dev->input_buffers[ch] + filled, 0,
+                   (size_t)(frames - filled) * sizeof(float));
+        }
+    }
+    return 1;
+}
+
+// Heap layout for an installed CC map: the count plus a tail array of
+// entries, allocated in one block so publication is a single pointer store.
+typedef struct MH_CCMapTable {
+    int count;
+    MH_CCMapping entries[];
+} MH_CCMapTable;
+
+// Async output recorder state (mh_audio_record_start). The audio thread
+// is the FIFO producer; the writer thread drains it into the streaming
+// encoder (MH_AudioWriter). Threading goes through miniaudio's
+// primitives, which this translation unit compiles anyway.
+typedef struct MH_Recorder {
+    MH_AudioWriter* writer;      // owned; writer thread only after start
+    MH_AudioRingBuffer* fifo;    // audio thread -> writer thread
+    float* chunk;                // writer-side staging [chunk_frames * channels]
+    int chunk_frames;
+    ma_thread thread;
+    volatile long long stop;     // app thread -> writer thread: drain and exit
+    char err[256];               // first write error (sticky; read after join)
+    int failed;                  // writer thread only until join, then app thread
+} MH_Recorder;
+
+static void free_retired_recorder(MH_Recorder* rec);
+
+// Writer thread: drain the FIFO into the encoder in large chunks. After
+// a write error it keeps draining (so the audio thread's pushes still
+// land somewhere) but stops encoding; the error surfaces at record_stop.
+// The stop flag is honored only once the FIFO is empty, so everything
+// pushed before stop was requested reaches the disk.
+static ma_thread_result MA_THREADCALL recorder_thread(void* user_data) {
+    MH_Recorder* rec = (MH_Recorder*)user_data;
+    for (;;) {
+        int n = mh_audio_ringbuffer_read_interleaved(rec->fifo, rec->chunk,
+                                                     rec->chunk_frames);
+        if (n > 0) {
+            if (!rec->failed &&
+                !mh_audio_writer_write(rec->writer, rec->chunk, (unsigned int)n,
+                                       rec->err, sizeof(rec->err))) {
+                rec->failed = 1;
+            }
+            continue;  // keep draining while data is flowing
+        }
+        if (mh_atomic_load_relaxed_i64(&rec->stop)) break;
+        ma_sleep(2);
+    }
+    return (ma_thread_result)0;
+}
+
 // MIDI input callback - called from MIDI thread when messages arrive
 static void midi_input_callback(const unsigned char* data, size_t len, void* user_data) {
     MH_AudioDevice* dev = (MH_AudioDevice*)user_data;
     if (!dev || !dev->midi_in_buffer || len < 1) return;
 
     MH_MidiEvent event;
-    event.sample_offset = 0;  // Will be processed at start of next audio buffer
+    event.sample_offset = 0;  // Rewritten from the receipt timestamp at drain time
     event.status = data[0];
     event.data1 = (len >= 2) ? data[1] : 0;
     event.data2 = (len >= 3) ? data[2] : 0;
 
-    mh_midi_ringbuffer_push(dev->midi_in_buffer, &event);
+    mh_midi_ringbuffer_push_timed(dev->midi_in_buffer, &event,
+                                  ma_timer_get_time_in_seconds(&dev->midi_clock));
 }
 
 // Audio callback - called from miniaudio's audio thread
 static void audio_callback(ma_device* device, void* output, const void* input, ma_uint32 frame_count) {
     MH_AudioDevice* dev = (MH_AudioDevice*)device->pUserData;
 
+    // Time the whole callback for load / xrun accounting. ma_timer is
+    // miniaudio's internal monotonic clock; it is visible here because
+    // this file compiles the miniaudio implementation.
+    ma_timer timer;
+    ma_timer_init(&timer);
+
     float* interleaved_output = (float*)output;
     int channels = dev->channels;
     int frames = (int)frame_count;
@@ -201,84 +551,274 @@ static void audio_callback(ma_device* device, void* output, const void* input, m
         frames = dev->buffer_capacity;
     }
 
-    // Get input audio: capture (duplex) > input callback > silence
+    // Planar views of the block for the process call. At one channel,
+    // interleaved and planar layouts coincide, so the plugin reads the
+    // device's capture buffer and writes its output buffer directly --
+    // no staging copies and no extra buffer of latency for a mono rig.
+    // Multi-channel keeps the preallocated de/interleave buffers.
+    const float* in_alias[1];
+    float* out_alias[1];
+    const float* const* proc_inputs = (const float* const*)dev->input_buffers;
+    float* const* proc_outputs = dev->output_buffers;
+    int direct_out = 0;
+    if (channels == 1) {
+        out_alias[0] = interleaved_output;
+        proc_outputs = out_alias;
+        direct_out = 1;
+    }
+
+    // Sequenced MIDI produced by a playlist MIDI item this block;
+    // merged with the live MIDI drained below.
+    MH_MidiEvent pl_events[128];
+    int num_pl_events = 0;
+
+    // Get input audio:
+    // capture (duplex) > playlist > loop source > input callback > silence
+    // Multi-channel capture and silence defer their planar conversion:
+    // if the block ends up carrying no MIDI and no parameter changes, the
+    // interleaved fast path below hands the device buffers straight to
+    // mh_process_interleaved and the conversion here never happens.
+    const float* deferred_interleaved_in = NULL;
+    int input_is_silence = 0;
     void* cbp;
+    void* lsp;
     if (dev->capture && input) {
-        // De-interleave capture input into per-channel buffers
-        const float* interleaved_input = (const float*)input;
-        for (int f = 0; f < frames; f++) {
+        if (channels == 1) {
+            // Zero-copy: alias the capture buffer as the plugin input.
+            in_alias[0] = (const float*)input;
+            proc_inputs = in_alias;
+        } else {
+            deferred_interleaved_in = (const float*)input;
+        }
+    } else if (playlist_fill_block(dev, frames, pl_events, 128,
+                                   &num_pl_events)) {
+        // Playlist filled the planar input buffers (and possibly
+        // staged sequenced MIDI); nothing more to do here.
+    } else if ((lsp = mh_atomic_load_acquire_ptr(&dev->loop_source)) != NULL) {
+        // Copy from the preloaded loop source with wraparound: per
+        // channel, at most two contiguous memcpy runs per block.
+        MH_LoopSource* ls = (MH_LoopSource*)lsp;
+        int copied = 0;
+        int pos = ls->pos;
+        while (copied < frames) {
+            int run = ls->frames - pos;
+            if (run > frames - copied) run = frames - copied;
             for (int ch = 0; ch < channels; ch++) {
-                dev->input_buffers[ch][f] = interleaved_input[f * channels + ch];
+                const float* src = ls->samples
+                    + (size_t)(ch % ls->channels) * ls->frames + pos;
+                memcpy(dev->input_buffers[ch] + copied, src,
+                       run * sizeof(float));
             }
+            copied += run;
+            pos += run;
+            if (pos >= ls->frames) pos = 0;
         }
+        ls->pos = pos;
     } else if ((cbp = mh_atomic_load_acquire_ptr(&dev->input_callback)) != NULL) {
         ((MH_AudioInputCallback)cbp)(dev->input_buffers, frames,
                                      dev->input_callback_user_data);
     } else {
-        // Zero input buffers for synth plugins
-        for (int ch = 0; ch < channels; ch++) {
-            memset(dev->input_buffers[ch], 0, frames * sizeof(float));
-        }
+        // Silence for synth plugins; buffers are zeroed lazily only if the
+        // planar path is taken (mh_process_interleaved takes NULL input).
+        input_is_silence = 1;
     }
 
-    // Drain MIDI input buffer
+    // Drain MIDI input, converting each event's receipt timestamp into
+    // a sample offset within this block. Events received during the
+    // previous buffer period land at (receipt - previous block start)
+    // scaled by the sample rate, so live playing keeps its micro-timing
+    // instead of being quantized to the buffer size. Stamps outside the
+    // block (clock jitter, events arriving mid-callback) clamp to the
+    // block edges, and offsets are kept non-decreasing so the events
+    // stay sorted as mh_process_midi expects.
     MH_MidiEvent midi_events[256];
     int num_midi_events = 0;
+    double block_time = ma_timer_get_time_in_seconds(&dev->midi_clock);
     if (dev->midi_in_buffer) {
-        num_midi_events = mh_midi_ringbuffer_pop_all(dev->midi_in_buffer, midi_events, 256);
+        MH_MidiTimedEvent timed[256];
+        int num_timed = mh_midi_ringbuffer_pop_all_timed(dev->midi_in_buffer, timed, 256);
+        int last_offset = 0;
+        for (int i = 0; i < num_timed; i++) {
+            int offset = 0;
+            if (timed[i].time_sec >= 0.0 && dev->sample_rate > 0 && frames > 0) {
+                double dt = timed[i].time_sec - dev->prev_block_time;
+                if (dt > 0.0) {
+                    offset = (int)(dt * dev->sample_rate);
+                }
+                if (offset > frames - 1) {
+                    offset = frames - 1;
+                }
+            }
+            if (offset < last_offset) {
+                offset = last_offset;
+            }
+            last_offset = offset;
+            midi_events[num_midi_events] = timed[i].event;
+            midi_events[num_midi_events].sample_offset = offset;
+            num_midi_events++;
+        }
+    }
+    dev->prev_block_time = block_time;
+
+    // Merge sequenced playlist MIDI with the live events drained above.
+    // Both runs are sorted by offset, so a single two-pointer merge
+    // keeps the combined list sorted as mh_process_midi expects; the
+    // merged events take the same path as live input from here on
+    // (including CC-map translation below).
+    if (num_pl_events > 0) {
+        MH_MidiEvent merged[256];
+        int a = 0, b = 0, m = 0;
+        while (m < 256 && (a < num_midi_events || b < num_pl_events)) {
+            if (b >= num_pl_events ||
+                (a < num_midi_events &&
+                 midi_events[a].sample_offset <= pl_events[b].sample_offset)) {
+                merged[m++] = midi_events[a++];
+            } else {
+                merged[m++] = pl_events[b++];
+            }
+        }
+        memcpy(midi_events, merged, (size_t)m * sizeof(MH_MidiEvent));
+        num_midi_events = m;
+    }
+
+    // Translate mapped CC events into parameter writes applied at block
+    // start. Mapped events are consumed (compacted out of midi_events);
+    // everything else passes through to the plugin as MIDI. The lookup
+    // is a linear scan over the table -- CC rates and table sizes are
+    // both tiny relative to a buffer period.
+    MH_ParamChange param_changes[256];
+    MH_ChainParamChange chain_param_changes[256];
+    int num_param_changes = 0;
+    MH_CCMapTable* cc_table = (MH_CCMapTable*)mh_atomic_load_acquire_ptr(&dev->cc_map);
+    if (cc_table && num_midi_events > 0) {
+        int kept = 0;
+        for (int i = 0; i < num_midi_events; i++) {
+            const MH_MidiEvent* ev = &midi_events[i];
+            int mapped = 0;
+            if ((ev->status & 0xF0) == 0xB0) {
+                int ev_channel = ev->status & 0x0F;
+                for (int m = 0; m < cc_table->count; m++) {
+                    const MH_CCMapping* map = &cc_table->entries[m];
+                    if (map->cc != (int)ev->data1) continue;
+                    if (map->channel >= 0 && map->channel != ev_channel) continue;
+                    if (num_param_changes < 256) {
+                        float value = map->lut[ev->data2 & 0x7F];
+                        if (dev->chain) {
+                            chain_param_changes[num_param_changes].sample_offset = 0;
+                            chain_param_changes[num_param_changes].plugin_index = map->plugin_index;
+                            chain_param_changes[num_param_changes].param_index = map->param_index;
+                            chain_param_changes[num_param_changes].value = value;
+                        } else {
+                            param_changes[num_param_changes].sample_offset = 0;
+                            param_changes[num_param_changes].param_index = map->param_index;
+                            param_changes[num_param_changes].value = value;
+                        }
+                        num_param_changes++;
+                    }
+                    mapped = 1;
+                    break;
+                }
+            }
+            if (!mapped) {
+                midi_events[kept++] = *ev;
+            }
+        }
+        num_midi_events = kept;
     }
 
     // Process through the plugin or chain with MIDI
     MH_MidiEvent midi_out[256];
     int num_midi_out = 0;
 
+    // Interleaved fast path: single plugin, multi-channel, no MIDI and no
+    // mapped parameter changes this block, input straight from the capture
+    // buffer (or silence). The library converts once, directly into the
+    // plugin's process buffer -- both planar staging copies are skipped.
+    if (!dev->chain && channels > 1 &&
+        num_midi_events == 0 && num_param_changes == 0 &&
+        (deferred_interleaved_in || input_is_silence)) {
+        mh_process_interleaved(dev->plugin, deferred_interleaved_in,
+                               interleaved_output, frames, channels);
+        direct_out = 1;  // output already interleaved in place
+        goto after_process;
+    }
+
+    // General path: materialize the deferred planar input first.
+    if (deferred_interleaved_in) {
+        for (int f = 0; f < frames; f++) {
+            for (int ch = 0; ch < channels; ch++) {
+                dev->input_buffers[ch][f] = deferred_interleaved_in[f * channels + ch];
+            }
+        }
+    } else if (input_is_silence) {
+        for (int ch = 0; ch < channels; ch++) {
+            memset(dev->input_buffers[ch], 0, frames * sizeof(float));
+        }
+    }
+
     if (dev->chain) {
         // Process through plugin chain
-        if (num_midi_events > 0) {
+        if (num_param_changes > 0) {
+            mh_chain_process_auto(dev->chain,
+                              proc_inputs,
+                              proc_outputs,
+                              frames,
+                              midi_events, num_midi_events,
+                              midi_out, 256, &num_midi_out,
+                              chain_param_changes, num_param_changes);
+        } else if (num_midi_events > 0) {
             mh_chain_process_midi_io(dev->chain,
-                              (const float* const*)dev->input_buffers,
-                              dev->output_buffers,
+                              proc_inputs,
+                              proc_outputs,
                               frames,
                               midi_events, num_midi_events,
                               midi_out, 256, &num_midi_out);
         } else {
             mh_chain_process(dev->chain,
-                       (const float* const*)dev->input_buffers,
-                       dev->output_buffers,
+                       proc_inputs,
+                       proc_outputs,
                        frames);
         }
     } else {
         // Process through single plugin
-        if (num_midi_events > 0) {
+        if (num_param_changes > 0) {
+            mh_process_auto(dev->plugin,
+                              proc_inputs,
+                              proc_outputs,
+                              frames,
+                              midi_events, num_midi_events,
+                              midi_out, 256, &num_midi_out,
+                              param_changes, num_param_changes);
+        } else if (num_midi_events > 0) {
             mh_process_midi_io(dev->plugin,
-                              (const float* const*)dev->input_buffers,
-                              dev->output_buffers,
+                              proc_inputs,
+                              proc_outputs,
                               frames,
                               midi_events, num_midi_events,
                               midi_out, 256, &num_midi_out);
         } else {
             mh_process(dev->plugin,
-                       (const float* const*)dev->input_buffers,
-                       dev->output_buffers,
+                       proc_inputs,
+                       proc_outputs,
                        frames);
         }
     }
 
-    // Send MIDI output
+after_process:
+    // Send MIDI output as one batch: allocation-free steady state, and
+    // each message goes out at its status byte's real wire length
+    // (program change is 2 bytes, not a padded 3).
     if (num_midi_out > 0 && dev->midi_out) {
-        for (int i = 0; i < num_midi_out; i++) {
-            unsigned char msg[3];
-            msg[0] = midi_out[i].status;
-            msg[1] = midi_out[i].data1;
-            msg[2] = midi_out[i].data2;
-            mh_midi_out_send(dev->midi_out, msg, 3);
-        }
+        mh_midi_out_send_events(dev->midi_out, midi_out, num_midi_out);
     }
 
     // Interleave output: non-interleaved [[L0,L1,...], [R0,R1,...]] -> interleaved [L0,R0,L1,R1,...]
-    for (int f = 0; f < frames; f++) {
-        for (int ch = 0; ch < channels; ch++) {
-            interleaved_output[f * channels + ch] = dev->output_buffers[ch][f];
+    // (skipped on the mono fast path -- the plugin already wrote the device buffer)
+    if (!direct_out) {
+        for (int f = 0; f < frames; f++) {
+            for (int ch = 0; ch < channels; ch++) {
+                interleaved_output[f * channels + ch] = dev->output_buffers[ch][f];
+            }
         }
     }
 
@@ -287,6 +827,45 @@ static void audio_callback(ma_device* device, void* output, const void* input, m
         memset(interleaved_output + frames * channels, 0,
                ((int)frame_count - frames) * channels * sizeof(float));
     }
+
+    // Recording tap: hand the processed block to the writer thread
+    // through the FIFO. The push is wait-free; if the disk has stalled
+    // long enough to fill the FIFO, the overflow is dropped and counted
+    // rather than blocking the callback.
+    void* recp = mh_atomic_load_acquire_ptr(&dev->recorder);
+    if (recp) {
+        MH_Recorder* rec = (MH_Recorder*)recp;
+        int pushed = mh_audio_ringbuffer_push(rec->fifo, interleaved_output, frames);
+        if (pushed < frames) {
+            mh_atomic_store_relaxed_i64(&dev->record_dropped,
+                mh_atomic_load_relaxed_i64(&dev->record_dropped) + (frames - pushed));
+        }
+    }
+
+    // Load / xrun accounting: ratio of this callback's duration to the
+    // buffer period it had to fill. A ratio above 1.0 means the device
+    // could not have been fed in time -- count it as an xrun and fire
+    // the overload callback (if installed). All updates are lock-free
+    // relaxed atomics; app threads poll via mh_audio_get_load() and
+    // mh_audio_get_xrun_count().
+    if (dev->sample_rate > 0 && frame_count > 0) {
+        double elapsed = ma_timer_get_time_in_seconds(&timer);
+        double period = (double)frame_count / dev->sample_rate;
+        double instant = elapsed / period;
+
+        double smoothed = mh_bits_to_double(mh_atomic_load_relaxed_i64(&dev->load_bits));
+        smoothed = MH_LOAD_SMOOTHING * smoothed + (1.0 - MH_LOAD_SMOOTHING) * instant;
+        mh_atomic_store_relaxed_i64(&dev->load_bits, mh_double_to_bits(smoothed));
+
+        if (instant > 1.0) {
+            mh_atomic_store_relaxed_i64(&dev->xrun_count,
+                mh_atomic_load_relaxed_i64(&dev->xrun_count) + 1);
+            void* ocb = mh_atomic_load_acquire_ptr(&dev->overload_callback);
+            if (ocb) {
+                ((MH_AudioOverloadCallback)ocb)(instant, dev->overload_callback_user_data);
+            }
+        }
+    }
 }
 
 MH_AudioDevice* mh_audio_open(MH_Plugin* plugin, const MH_AudioConfig* config,
@@ -430,6 +1009,12 @@ MH_AudioDevice* mh_audio_open(MH_Plugin* plugin, const MH_AudioConfig* config,
     // Initialize MIDI
     dev->midi_in_port = -1;
     dev->midi_out_port = -1;
+    dev->playlist_index = -1;
+
+    // Start the MIDI timestamp clock (shared by the MIDI thread and
+    // the audio thread; see the struct comment).
+    ma_timer_init(&dev->midi_clock);
+    dev->prev_block_time = 0.0;
 
     // Create MIDI ring buffers
     dev->midi_in_buffer = mh_midi_ringbuffer_create(256);
@@ -604,6 +1189,12 @@ MH_AudioDevice* mh_audio_open_chain(MH_PluginChain* chain, const MH_AudioConfig*
     // Initialize MIDI
     dev->midi_in_port = -1;
     dev->midi_out_port = -1;
+    dev->playlist_index = -1;
+
+    // Start the MIDI timestamp clock (shared by the MIDI thread and
+    // the audio thread; see the struct comment).
+    ma_timer_init(&dev->midi_clock);
+    dev->prev_block_time = 0.0;
 
     // Create MIDI ring buffers
     dev->midi_in_buffer = mh_midi_ringbuffer_create(256);
@@ -641,6 +1232,12 @@ void mh_audio_close(MH_AudioDevice* dev) {
         ma_device_stop(&dev->device);
     }
 
+    // Finalize any in-progress recording (drains and joins the writer)
+    if (mh_atomic_load_acquire_ptr(&dev->recorder)) {
+        mh_audio_record_stop(dev, NULL, 0);
+    }
+    free_retired_recorder((MH_Recorder*)dev->recorder_retired);
+
     // Cleanup MIDI
     if (dev->midi_in) {
         mh_midi_in_close(dev->midi_in);
@@ -655,11 +1252,21 @@ void mh_audio_close(MH_AudioDevice* dev) {
         mh_midi_ringbuffer_free(dev->midi_out_buffer);
     }
 
-    // Cleanup audio input ring buffer
+    // Cleanup audio input ring buffer and drift compensation
+    free_input_drift_comp(dev);
     if (dev->audio_in_buffer) {
         mh_audio_ringbuffer_free(dev->audio_in_buffer);
     }
 
+    // Cleanup loop source, playlist, and CC map (device is stopped, so
+    // no callback can be reading)
+    free(dev->loop_source);
+    free(dev->loop_source_retired);
+    free_playlist_chain((MH_PlaylistItem*)dev->playlist);
+    free_playlist_chain((MH_PlaylistItem*)dev->playlist_retired);
+    free(dev->cc_map);
+    free(dev->cc_map_retired);
+
     // Cleanup audio
     ma_device_uninit(&dev->device);
     ma_context_uninit(&dev->context);
@@ -723,6 +1330,24 @@ int mh_audio_get_channels(MH_AudioDevice* dev) {
     return dev->channels;
 }
 
+double mh_audio_get_load(MH_AudioDevice* dev) {
+    if (!dev) return 0.0;
+    return mh_bits_to_double(mh_atomic_load_relaxed_i64(&dev->load_bits));
+}
+
+long long mh_audio_get_xrun_count(MH_AudioDevice* dev) {
+    if (!dev) return 0;
+    return mh_atomic_load_relaxed_i64(&dev->xrun_count);
+}
+
+void mh_audio_set_overload_callback(MH_AudioDevice* dev, MH_AudioOverloadCallback cb, void* user_data) {
+    if (!dev) return;
+    // Same publication order as mh_audio_set_input_callback: user_data
+    // first, then the release store of the callback pointer.
+    dev->overload_callback_user_data = user_data;
+    mh_atomic_store_release_ptr(&dev->overload_callback, (void*)cb);
+}
+
 int mh_audio_connect_midi_input(MH_AudioDevice* dev, int port_index) {
     if (!dev) return 0;
 
@@ -851,14 +1476,291 @@ int mh_audio_send_midi(MH_AudioDevice* dev, unsigned char status, unsigned char
     if (!dev || !dev->midi_in_buffer) return 0;
 
     MH_MidiEvent event;
-    event.sample_offset = 0;  // Will be processed at start of next audio buffer
+    event.sample_offset = 0;  // Rewritten from the receipt timestamp at drain time
     event.status = status;
     event.data1 = data1;
     event.data2 = data2;
 
-    return mh_midi_ringbuffer_push(dev->midi_in_buffer, &event);
+    return mh_midi_ringbuffer_push_timed(dev->midi_in_buffer, &event,
+                                         ma_timer_get_time_in_seconds(&dev->midi_clock));
+}
+
+int mh_audio_set_loop_source(MH_AudioDevice* dev, const float* const* data,
+                             int channels, int num_frames) {
+    if (!dev) return 0;
+    if (num_frames < 0 || channels < 0) return 0;
+    if (num_frames > 0 && (!data || channels < 1)) return 0;
+
+    MH_LoopSource* src = NULL;
+    if (num_frames > 0) {
+        src = (MH_LoopSource*)malloc(sizeof(MH_LoopSource)
+                                     + (size_t)channels * num_frames * sizeof(float));
+        if (!src) return 0;
+        src->channels = channels;
+        src->frames = num_frames;
+        src->pos = 0;
+        for (int ch = 0; ch < channels; ch++) {
+            memcpy(src->samples + (size_t)ch * num_frames, data[ch],
+                   (size_t)num_frames * sizeof(float));
+        }
+    }
+
+    // Same swap-then-retire discipline as mh_audio_set_cc_map.
+    void* old = mh_atomic_load_acquire_ptr(&dev->loop_source);
+    mh_atomic_store_release_ptr(&dev->loop_source, src);
+    free(dev->loop_source_retired);
+    dev->loop_source_retired = old;
+    return 1;
+}
+
+// Append an item to the playlist. With an existing tail the append is
+// one release store of the tail's next pointer, so the audio thread
+// can walk onto it mid-playback; publishing a fresh head also bumps
+// the generation counter so the audio thread adopts the new list even
+// if malloc handed back a cleared head's address.
+static int playlist_append(MH_AudioDevice* dev, MH_PlaylistItem* item) {
+    item->next = NULL;
+    if (dev->playlist_tail) {
+        MH_PlaylistItem* tail = (MH_PlaylistItem*)dev->playlist_tail;
+        mh_atomic_store_release_ptr(&tail->next, item);
+    } else {
+        mh_atomic_store_release_ptr(&dev->playlist, item);
+        mh_atomic_store_relaxed_i64(&dev->playlist_gen,
+            mh_atomic_load_relaxed_i64(&dev->playlist_gen) + 1);
+    }
+    dev->playlist_tail = item;
+    dev->playlist_count++;
+    return 1;
+}
+
+int mh_audio_playlist_add_audio(MH_AudioDevice* dev, const float* const* data,
+                                int channels, int num_frames) {
+    if (!dev || !data || channels < 1 || num_frames < 1) return 0;
+
+    MH_PlaylistItem* item = (MH_PlaylistItem*)malloc(sizeof(MH_PlaylistItem)
+        + (size_t)channels * num_frames * sizeof(float));
+    if (!item) return 0;
+    memset(item, 0, sizeof(MH_PlaylistItem));
+    item->channels = channels;
+    item->frames = num_frames;
+    for (int ch = 0; ch < channels; ch++) {
+        memcpy(item->samples + (size_t)ch * num_frames, data[ch],
+               (size_t)num_frames * sizeof(float));
+    }
+    return playlist_append(dev, item);
+}
+
+int mh_audio_playlist_add_midi(MH_AudioDevice* dev, const MH_MidiEvent* events,
+                               int num_events, int duration_frames) {
+    if (!dev || duration_frames < 1) return 0;
+    if (num_events < 0 || (num_events > 0 && !events)) return 0;
+
+    MH_PlaylistItem* item = (MH_PlaylistItem*)malloc(sizeof(MH_PlaylistItem));
+    if (!item) return 0;
+    memset(item, 0, sizeof(MH_PlaylistItem));
+    item->is_midi = 1;
+    item->frames = duration_frames;
+    if (num_events > 0) {
+        item->events = (MH_MidiEvent*)malloc((size_t)num_events
+                                             * sizeof(MH_MidiEvent));
+        if (!item->events) {
+            free(item);
+            return 0;
+        }
+        memcpy(item->events, events,
+               (size_t)num_events * sizeof(MH_MidiEvent));
+        item->num_events = num_events;
+    }
+    return playlist_append(dev, item);
+}
+
+int mh_audio_playlist_set_crossfade(MH_AudioDevice* dev, int frames) {
+    if (!dev || frames < 0) return 0;
+    mh_atomic_store_relaxed_i64(&dev->playlist_crossfade, frames);
+    return 1;
+}
+
+int mh_audio_playlist_clear(MH_AudioDevice* dev) {
+    if (!dev) return 0;
+    // Swap out the head, then retire the whole chain. The previously
+    // retired chain has survived at least one full install interval,
+    // so no callback can still hold it -- free it now (same discipline
+    // as mh_audio_set_cc_map).
+    void* old = mh_atomic_load_acquire_ptr(&dev->playlist);
+    mh_atomic_store_release_ptr(&dev->playlist, NULL);
+    free_playlist_chain((MH_PlaylistItem*)dev->playlist_retired);
+    dev->playlist_retired = old;
+    dev->playlist_tail = NULL;
+    dev->playlist_count = 0;
+    return 1;
+}
+
+int mh_audio_playlist_get_index(MH_AudioDevice* dev) {
+    if (!dev) return -1;
+    return (int)mh_atomic_load_relaxed_i64(&dev->playlist_index);
+}
+
+int mh_audio_playlist_get_count(MH_AudioDevice* dev) {
+    if (!dev) return 0;
+    return dev->playlist_count;
+}
+
+int mh_audio_set_cc_map(MH_AudioDevice* dev, const MH_CCMapping* mappings, int count) {
+    if (!dev) return 0;
+    if (count < 0 || (count > 0 && !mappings)) return 0;
+
+    MH_CCMapTable* table = NULL;
+    if (count > 0) {
+        table = (MH_CCMapTable*)malloc(sizeof(MH_CCMapTable) + count * sizeof(MH_CCMapping));
+        if (!table) return 0;
+        table->count = count;
+        memcpy(table->entries, mappings, count * sizeof(MH_CCMapping));
+    }
+
+    // Swap in the new table, then retire the displaced one. The
+    // previously-retired table has survived at least one full install
+    // interval, so no callback can still hold it -- free it now.
+    void* old = mh_atomic_load_acquire_ptr(&dev->cc_map);
+    mh_atomic_store_release_ptr(&dev->cc_map, table);
+    free(dev->cc_map_retired);
+    dev->cc_map_retired = old;
+    return 1;
+}
+
+// Free a retired recorder's memory. The writer thread has already been
+// joined and the writer closed by record_stop; only the allocations
+// that an in-flight audio callback might have touched survive to here.
+static void free_retired_recorder(MH_Recorder* rec) {
+    if (!rec) return;
+    mh_audio_ringbuffer_free(rec->fifo);
+    free(rec->chunk);
+    free(rec);
+}
+
+int mh_audio_record_start(MH_AudioDevice* dev, const char* path, int bit_depth,
+                          char* err_buf, size_t err_buf_size) {
+    if (!dev || !path) {
+        if (err_buf && err_buf_size > 0) {
+            snprintf(err_buf, err_buf_size, "Device or path is NULL");
+        }
+        return 0;
+    }
+    if (mh_atomic_load_acquire_ptr(&dev->recorder)) {
+        if (err_buf && err_buf_size > 0) {
+            snprintf(err_buf, err_buf_size, "Already recording");
+        }
+        return 0;
+    }
+
+    MH_Recorder* rec = (MH_Recorder*)calloc(1, sizeof(MH_Recorder));
+    if (!rec) {
+        if (err_buf && err_buf_size > 0) {
+            snprintf(err_buf, err_buf_size, "Failed to allocate recorder");
+        }
+        return 0;
+    }
+
+    rec->writer = mh_audio_writer_open(path, (unsigned int)dev->channels,
+                                       (unsigned int)dev->sample_rate, bit_depth,
+                                       err_buf, err_buf_size);
+    if (!rec->writer) {
+        free(rec);
+        return 0;  // err_buf already filled by the writer
+    }
+
+    // ~4 seconds of FIFO headroom before a disk stall starts dropping,
+    // and 8192-frame chunks so the encoder sees large writes.
+    int fifo_frames = (int)(dev->sample_rate > 0 ? dev->sample_rate * 4.0 : 192000);
+    rec->fifo = mh_audio_ringbuffer_create(dev->channels, fifo_frames);
+    rec->chunk_frames = 8192;
+    rec->chunk = (float*)malloc((size_t)rec->chunk_frames * dev->channels * sizeof(float));
+    if (!rec->fifo || !rec->chunk) {
+        char close_err[256];
+        mh_audio_writer_close(rec->writer, close_err, sizeof(close_err));
+        free_retired_recorder(rec);
+        if (err_buf && err_buf_size > 0) {
+            snprintf(err_buf, err_buf_size, "Failed to allocate recording FIFO");
+        }
+        return 0;
+    }
+
+    if (ma_thread_create(&rec->thread, ma_thread_priority_normal, 0,
+                         recorder_thread, rec, NULL) != MA_SUCCESS) {
+        char close_err[256];
+        mh_audio_writer_close(rec->writer, close_err, sizeof(close_err));
+        free_retired_recorder(rec);
+        if (err_buf && err_buf_size > 0) {
+            snprintf(err_buf, err_buf_size, "Failed to start recorder thread");
+        }
+        return 0;
+    }
+
+    // The previously-retired recorder has survived a full record
+    // interval -- safe to free now (same discipline as cc_map).
+    free_retired_recorder((MH_Recorder*)dev->recorder_retired);
+    dev->recorder_retired = NULL;
+    mh_atomic_store_relaxed_i64(&dev->record_dropped, 0);
+    mh_atomic_store_release_ptr(&dev->recorder, rec);
+    return 1;
+}
+
+int mh_audio_record_stop(MH_AudioDevice* dev, char* err_buf, size_t err_buf_size) {
+    if (!dev) return 0;
+
+    MH_Recorder* rec = (MH_Recorder*)mh_atomic_load_acquire_ptr(&dev->recorder);
+    if (!rec) {
+        if (err_buf && err_buf_size > 0) {
+            snprintf(err_buf, err_buf_size, "Not recording");
+        }
+        return 0;
+    }
+
+    // Unpublish first so no new blocks enter the FIFO, then let the
+    // writer drain what is already there and join it. An audio callback
+    // already in flight may push one last block into the (still live)
+    // FIFO; at worst that block misses the take.
+    mh_atomic_store_release_ptr(&dev->recorder, NULL);
+    mh_atomic_store_relaxed_i64(&rec->stop, 1);
+    ma_thread_wait(&rec->thread);
+
+    int ok = mh_audio_writer_close(rec->writer, err_buf, err_buf_size);
+    if (rec->failed) {
+        ok = 0;
+        if (err_buf && err_buf_size > 0) {
+            snprintf(err_buf, err_buf_size, "%s", rec->err);
+        }
+    }
+    rec->writer = NULL;
+
+    // Retire the memory the audio thread might still be touching; it is
+    // freed on the next record_start or at close.
+    free_retired_recorder((MH_Recorder*)dev->recorder_retired);
+    dev->recorder_retired = rec;
+    return ok;
 }
 
+int mh_audio_is_recording(MH_AudioDevice* dev) {
+    if (!dev) return 0;
+    return mh_atomic_load_acquire_ptr(&dev->recorder) != NULL;
+}
+
+long long mh_audio_record_dropped_frames(MH_AudioDevice* dev) {
+    if (!dev) return 0;
+    return mh_atomic_load_relaxed_i64(&dev->record_dropped);
+}
+
+// Drift controller tuning. The correction needed to null a real crystal
+// mismatch is tens of ppm; +/-2000 ppm of authority is plenty of
+// headroom while staying far below audibility (a fifth of a cent).
+// The proportional gain recovers a half-target fill error within a few
+// thousand blocks (~30 s at 512/48k) -- slow enough that the ratio
+// never pumps on normal fill jitter, fast enough to beat the ~20 min
+// walk to an underrun. Fill smoothing matches the load meter's idea of
+// "settles over tens of blocks".
+#define MH_DRIFT_MAX_DEV        0.002
+#define MH_DRIFT_GAIN           0.004
+#define MH_DRIFT_FILL_SMOOTHING 0.97
+
 // Internal callback that reads from the audio ring buffer
 static void audio_ringbuffer_input_callback(float* const* buffer, int nframes, void* user_data) {
     MH_AudioDevice* dev = (MH_AudioDevice*)user_data;
@@ -870,13 +1772,88 @@ static void audio_ringbuffer_input_callback(float* const* buffer, int nframes, v
         }
         return;
     }
-    mh_audio_ringbuffer_read_into(dev->audio_in_buffer, buffer, nframes, dev->channels);
+
+    if (!dev->input_drift_enabled || !dev->input_resampler_ready
+        || nframes > dev->drift_scratch_frames) {
+        mh_audio_ringbuffer_read_into(dev->audio_in_buffer, buffer, nframes, dev->channels);
+        return;
+    }
+
+    // Drift-compensated path: hold the smoothed fill level at the
+    // setpoint by trimming the consumption ratio a few hundred ppm at
+    // most. Fill above target means the producer runs fast -> consume
+    // more than one input frame per output frame (ratio > 1).
+    int avail = mh_audio_ringbuffer_available(dev->audio_in_buffer);
+    dev->drift_fill_avg = MH_DRIFT_FILL_SMOOTHING * dev->drift_fill_avg
+                        + (1.0 - MH_DRIFT_FILL_SMOOTHING) * (double)avail;
+
+    double err = (dev->drift_fill_avg - (double)dev->drift_fill_target)
+               / (double)dev->drift_fill_target;
+    double deviation = MH_DRIFT_GAIN * err;
+    if (deviation > MH_DRIFT_MAX_DEV) deviation = MH_DRIFT_MAX_DEV;
+    if (deviation < -MH_DRIFT_MAX_DEV) deviation = -MH_DRIFT_MAX_DEV;
+    double ratio = 1.0 + deviation;
+
+    ma_resampler_set_rate_ratio(&dev->input_resampler, (float)ratio);
+
+    ma_uint64 in_needed = 0;
+    ma_resampler_get_required_input_frame_count(&dev->input_resampler,
+                                                (ma_uint64)nframes, &in_needed);
+    if (in_needed > (ma_uint64)dev->drift_scratch_frames) {
+        in_needed = (ma_uint64)dev->drift_scratch_frames;
+    }
+
+    int got = mh_audio_ringbuffer_read_interleaved(dev->audio_in_buffer,
+                                                   dev->drift_in_scratch,
+                                                   (int)in_needed);
+    if (got < (int)in_needed) {
+        // Genuine underrun: feed silence for the missing tail so the
+        // resampler still produces a full block.
+        memset(dev->drift_in_scratch + (size_t)got * dev->channels, 0,
+               ((size_t)in_needed - (size_t)got) * dev->channels * sizeof(float));
+        mh_atomic_store_relaxed_i64(&dev->drift_underruns,
+            mh_atomic_load_relaxed_i64(&dev->drift_underruns) + 1);
+    }
+
+    ma_uint64 in_count = in_needed;
+    ma_uint64 out_count = (ma_uint64)nframes;
+    ma_resampler_process_pcm_frames(&dev->input_resampler,
+                                    dev->drift_in_scratch, &in_count,
+                                    dev->drift_out_scratch, &out_count);
+    if (out_count < (ma_uint64)nframes) {
+        memset(dev->drift_out_scratch + (size_t)out_count * dev->channels, 0,
+               ((size_t)nframes - (size_t)out_count) * dev->channels * sizeof(float));
+    }
+
+    mh_audio_deinterleave(dev->drift_out_scratch, buffer,
+                          (unsigned int)dev->channels, (unsigned int)nframes);
+
+    mh_atomic_store_relaxed_i64(&dev->drift_ratio_bits, mh_double_to_bits(ratio));
+    mh_atomic_store_relaxed_i64(&dev->drift_fill_avg_bits,
+                                mh_double_to_bits(dev->drift_fill_avg));
+}
+
+// Free the drift-compensation resources (resampler + scratch). Called
+// with the device stopped or the input callback already cleared.
+static void free_input_drift_comp(MH_AudioDevice* dev) {
+    dev->input_drift_enabled = 0;
+    if (dev->input_resampler_ready) {
+        ma_resampler_uninit(&dev->input_resampler, NULL);
+        dev->input_resampler_ready = 0;
+    }
+    free(dev->drift_in_scratch);
+    free(dev->drift_out_scratch);
+    dev->drift_in_scratch = NULL;
+    dev->drift_out_scratch = NULL;
+    dev->drift_scratch_frames = 0;
 }
 
 int mh_audio_enable_input(MH_AudioDevice* dev, int capacity_frames) {
     if (!dev) return 0;
 
-    // Free existing buffer if any
+    // Free existing buffer if any (drift compensation is sized to the
+    // old capacity, so it goes with it; re-enable after this call)
+    free_input_drift_comp(dev);
     if (dev->audio_in_buffer) {
         mh_audio_ringbuffer_free(dev->audio_in_buffer);
         dev->audio_in_buffer = NULL;
@@ -896,7 +1873,8 @@ void mh_audio_disable_input(MH_AudioDevice* dev) {
     // Clear the input callback first (audio thread will see NULL and zero buffers)
     mh_audio_set_input_callback(dev, NULL, NULL);
 
-    // Then free the ring buffer
+    // Then free the ring buffer and any drift compensation riding on it
+    free_input_drift_comp(dev);
     if (dev->audio_in_buffer) {
         mh_audio_ringbuffer_free(dev->audio_in_buffer);
         dev->audio_in_buffer = NULL;
@@ -908,18 +1886,164 @@ int mh_audio_write_input(MH_AudioDevice* dev, const float* data, int nframes) {
     return mh_audio_ringbuffer_push(dev->audio_in_buffer, data, nframes);
 }
 
+int mh_audio_write_input_planar(MH_AudioDevice* dev, const float* const* data,
+                                int channels, int nframes) {
+    if (!dev || !dev->audio_in_buffer || !data || channels <= 0 || nframes <= 0) return 0;
+    return mh_audio_ringbuffer_push_planar(dev->audio_in_buffer, data, channels, nframes);
+}
+
 int mh_audio_input_available(MH_AudioDevice* dev) {
     if (!dev || !dev->audio_in_buffer) return 0;
     return mh_audio_ringbuffer_available(dev->audio_in_buffer);
 }
 
-// Shared enumeration helper. Set is_capture=0 for playback devices, 1 for capture.
-static int enumerate_devices_impl(int is_capture,
-                                  MH_AudioDeviceInfo* out_devices,
-                                  int max_devices) {
-    ma_context ctx;
-    if (ma_context_init(NULL, 0, NULL, &ctx) != MA_SUCCESS) {
-        return -1;
+int mh_audio_set_input_drift_comp(MH_AudioDevice* dev, int enabled) {
+    if (!dev) return 0;
+
+    if (!enabled) {
+        free_input_drift_comp(dev);
+        return 1;
+    }
+
+    if (!dev->audio_in_buffer) return 0;
+    if (dev->input_drift_enabled) return 1;
+
+    // Nominal 1:1 rates; the callback steers the ratio around 1.0.
+    // Linear algorithm: dynamic ratio changes are cheap, and at a few
+    // hundred ppm of deviation the interpolation error is negligible.
+    ma_resampler_config config = ma_resampler_config_init(
+        ma_format_f32, (ma_uint32)dev->channels,
+        (ma_uint32)dev->sample_rate, (ma_uint32)dev->sample_rate,
+        ma_resample_algorithm_linear);
+    if (ma_resampler_init(&config, NULL, &dev->input_resampler) != MA_SUCCESS) {
+        return 0;
+    }
+
+    // Scratch sized to the largest callback block (buffer_capacity is
+    // already 2x the period) plus ratio/latency headroom; a block that
+    // somehow exceeds it falls back to the uncompensated read.
+    dev->drift_scratch_frames = dev->buffer_capacity + 64;
+    dev->drift_in_scratch = (float*)malloc(
+        (size_t)dev->drift_scratch_frames * dev->channels * sizeof(float));
+    dev->drift_out_scratch = (float*)malloc(
+        (size_t)dev->drift_scratch_frames * dev->channels * sizeof(float));
+    if (!dev->drift_in_scratch || !dev->drift_out_scratch) {
+        ma_resampler_uninit(&dev->input_resampler, NULL);
+        free(dev->drift_in_scratch);
+        free(dev->drift_out_scratch);
+        dev->drift_in_scratch = NULL;
+        dev->drift_out_scratch = NULL;
+        dev->drift_scratch_frames = 0;
+        return 0;
+    }
+
+    // Setpoint: half the ring. Maximum headroom against both underrun
+    // and overflow, which is the whole point of the controller.
+    dev->drift_fill_target = mh_audio_ringbuffer_capacity(dev->audio_in_buffer) / 2;
+    dev->drift_fill_avg = (double)dev->drift_fill_target;
+    mh_atomic_store_relaxed_i64(&dev->drift_ratio_bits, mh_double_to_bits(1.0));
+    mh_atomic_store_relaxed_i64(&dev->drift_fill_avg_bits,
+                                mh_double_to_bits(dev->drift_fill_avg));
+    mh_atomic_store_relaxed_i64(&dev->drift_underruns, 0);
+
+    dev->input_resampler_ready = 1;
+    dev->input_drift_enabled = 1;
+    return 1;
+}
+
+int mh_audio_input_drift_stats(MH_AudioDevice* dev, MH_InputDriftStats* out_stats) {
+    if (!dev || !out_stats || !dev->input_drift_enabled) return 0;
+    out_stats->ratio = mh_bits_to_double(
+        mh_atomic_load_relaxed_i64(&dev->drift_ratio_bits));
+    out_stats->fill_avg = mh_bits_to_double(
+        mh_atomic_load_relaxed_i64(&dev->drift_fill_avg_bits));
+    out_stats->fill_target = dev->drift_fill_target;
+    out_stats->underruns = mh_atomic_load_relaxed_i64(&dev->drift_underruns);
+    return 1;
+}
+
+// ---- Cached device enumeration ----
+//
+// ma_context_init can take 100-400 ms on some ALSA setups, and the old
+// per-call context meant every `devices` listing and every poll paid
+// it. The context below is created on the first enumeration and kept
+// alive, together with a snapshot of both device lists, so repeated
+// enumeration is a memcpy from the snapshot. mh_audio_refresh_devices
+// re-queries the backend explicitly (miniaudio has no backend-level
+// hot-plug notification, so refresh is the poll point) and fires the
+// registered change callback when the list actually differed.
+//
+// All state is guarded by g_enum_lock; the mutex itself is created
+// lazily under a spinlock since plain C has no static initializer for
+// ma_mutex. Control-path only -- nothing here touches the audio thread.
+
+static ma_spinlock g_enum_init_lock = 0;
+static ma_mutex    g_enum_lock;
+static int         g_enum_lock_ready = 0;
+
+static ma_context  g_enum_ctx;
+static int         g_enum_ctx_valid = 0;
+
+// Heap-allocated snapshot arrays, replaced wholesale on refresh; -1
+// count means no snapshot has been taken yet.
+static MH_AudioDeviceInfo* g_enum_playback = NULL;
+static MH_AudioDeviceInfo* g_enum_capture = NULL;
+static int g_enum_playback_count = -1;
+static int g_enum_capture_count = -1;
+
+static MH_AudioDeviceChangeCallback g_enum_change_cb = NULL;
+static void* g_enum_change_user = NULL;
+
+static void enum_lock(void) {
+    ma_spinlock_lock(&g_enum_init_lock);
+    if (!g_enum_lock_ready) {
+        ma_mutex_init(&g_enum_lock);
+        g_enum_lock_ready = 1;
+    }
+    ma_spinlock_unlock(&g_enum_init_lock);
+    ma_mutex_lock(&g_enum_lock);
+}
+
+static void enum_unlock(void) {
+    ma_mutex_unlock(&g_enum_lock);
+}
+
+// Allocate-and-copy one fresh list into MH_AudioDeviceInfo form. A
+// zero-device list yields a NULL array with count 0, which is fine.
+static MH_AudioDeviceInfo* enum_copy_infos(const ma_device_info* src, int count) {
+    if (count <= 0) return NULL;
+    MH_AudioDeviceInfo* dst =
+        (MH_AudioDeviceInfo*)malloc((size_t)count * sizeof(*dst));
+    if (!dst) return NULL;
+    for (int i = 0; i < count; i++) {
+        strncpy(dst[i].name, src[i].name, sizeof(dst[i].name) - 1);
+        dst[i].name[sizeof(dst[i].name) - 1] = '\0';
+        dst[i].is_default = src[i].isDefault ? 1 : 0;
+    }
+    return dst;
+}
+
+static int enum_infos_differ(const MH_AudioDeviceInfo* cached, int cached_count,
+                             const MH_AudioDeviceInfo* fresh, int fresh_count) {
+    if (cached_count != fresh_count) return 1;
+    for (int i = 0; i < fresh_count; i++) {
+        if (strcmp(cached[i].name, fresh[i].name) != 0) return 1;
+        if (cached[i].is_default != fresh[i].is_default) return 1;
+    }
+    return 0;
+}
+
+// Re-query the backend into the snapshot. Caller holds g_enum_lock.
+// Returns 1 on success (setting *out_changed), 0 on failure (the
+// previous snapshot, if any, is left in place).
+static int enum_refresh_locked(int* out_changed) {
+    *out_changed = 0;
+
+    if (!g_enum_ctx_valid) {
+        if (ma_context_init(NULL, 0, NULL, &g_enum_ctx) != MA_SUCCESS) {
+            return 0;
+        }
+        g_enum_ctx_valid = 1;
     }
 
     ma_device_info* playback_infos = NULL;
@@ -927,25 +2051,62 @@ static int enumerate_devices_impl(int is_capture,
     ma_device_info* capture_infos = NULL;
     ma_uint32 capture_count = 0;
 
-    if (ma_context_get_devices(&ctx, &playback_infos, &playback_count,
-                                &capture_infos, &capture_count) != MA_SUCCESS) {
-        ma_context_uninit(&ctx);
-        return -1;
+    if (ma_context_get_devices(&g_enum_ctx, &playback_infos, &playback_count,
+                               &capture_infos, &capture_count) != MA_SUCCESS) {
+        return 0;
+    }
+
+    MH_AudioDeviceInfo* playback =
+        enum_copy_infos(playback_infos, (int)playback_count);
+    MH_AudioDeviceInfo* capture =
+        enum_copy_infos(capture_infos, (int)capture_count);
+    if ((playback_count > 0 && !playback) || (capture_count > 0 && !capture)) {
+        free(playback);
+        free(capture);
+        return 0;
     }
 
-    ma_device_info* infos = is_capture ? capture_infos : playback_infos;
-    int total = is_capture ? (int)capture_count : (int)playback_count;
+    *out_changed =
+        enum_infos_differ(g_enum_playback, g_enum_playback_count,
+                          playback, (int)playback_count)
+        || enum_infos_differ(g_enum_capture, g_enum_capture_count,
+                             capture, (int)capture_count);
+
+    free(g_enum_playback);
+    free(g_enum_capture);
+    g_enum_playback = playback;
+    g_enum_capture = capture;
+    g_enum_playback_count = (int)playback_count;
+    g_enum_capture_count = (int)capture_count;
+    return 1;
+}
 
-    if (out_devices && max_devices > 0) {
-        int to_copy = total < max_devices ? total : max_devices;
-        for (int i = 0; i < to_copy; i++) {
-            strncpy(out_devices[i].name, infos[i].name, sizeof(out_devices[i].name) - 1);
-            out_devices[i].name[sizeof(out_devices[i].name) - 1] = '\0';
-            out_devices[i].is_default = infos[i].isDefault ? 1 : 0;
+// Shared enumeration helper. Set is_capture=0 for playback devices, 1
+// for capture. Serves from the snapshot; the first call (or the first
+// after a shutdown) populates it.
+static int enumerate_devices_impl(int is_capture,
+                                  MH_AudioDeviceInfo* out_devices,
+                                  int max_devices) {
+    enum_lock();
+
+    if (g_enum_playback_count < 0) {
+        int changed;
+        if (!enum_refresh_locked(&changed)) {
+            enum_unlock();
+            return -1;
         }
     }
 
-    ma_context_uninit(&ctx);
+    const MH_AudioDeviceInfo* infos = is_capture ? g_enum_capture
+                                                 : g_enum_playback;
+    int total = is_capture ? g_enum_capture_count : g_enum_playback_count;
+
+    if (out_devices && max_devices > 0 && infos) {
+        int to_copy = total < max_devices ? total : max_devices;
+        memcpy(out_devices, infos, (size_t)to_copy * sizeof(*out_devices));
+    }
+
+    enum_unlock();
     return total;
 }
 
@@ -956,3 +2117,43 @@ int mh_audio_enumerate_playback_devices(MH_AudioDeviceInfo* out_devices, int max
 int mh_audio_enumerate_capture_devices(MH_AudioDeviceInfo* out_devices, int max_devices) {
     return enumerate_devices_impl(1, out_devices, max_devices);
 }
+
+int mh_audio_refresh_devices(void) {
+    enum_lock();
+    int changed = 0;
+    int ok = enum_refresh_locked(&changed);
+    MH_AudioDeviceChangeCallback cb = g_enum_change_cb;
+    void* user = g_enum_change_user;
+    enum_unlock();
+
+    // Fired outside the lock so the callback can enumerate without
+    // deadlocking.
+    if (ok && changed && cb) {
+        cb(user);
+    }
+    return ok;
+}
+
+int mh_audio_set_device_change_callback(MH_AudioDeviceChangeCallback callback,
+                                        void* user_data) {
+    enum_lock();
+    g_enum_change_cb = callback;
+    g_enum_change_user = user_data;
+    enum_unlock();
+    return 1;
+}
+
+void mh_audio_enumeration_shutdown(void) {
+    enum_lock();
+    if (g_enum_ctx_valid) {
+        ma_context_uninit(&g_enum_ctx);
+        g_enum_ctx_valid = 0;
+    }
+    free(g_enum_playback);
+    free(g_enum_capture);
+    g_enum_playback = NULL;
+    g_enum_capture = NULL;
+    g_enum_playback_count = -1;
+    g_enum_capture_count = -1;
+    enum_unlock();
+}
@@ -18,6 +18,7 @@ extern "C" {
 // Forward declarations - require minihost.h/minihost_chain.h for actual use
 typedef struct MH_Plugin MH_Plugin;
 typedef struct MH_PluginChain MH_PluginChain;
+typedef struct MH_MidiEvent MH_MidiEvent;
 
 typedef struct MH_AudioDevice MH_AudioDevice;
 
@@ -42,12 +43,45 @@ typedef struct MH_AudioDeviceInfo {
 // out_devices: optional buffer to receive device info (may be NULL to count only)
 // max_devices: capacity of out_devices buffer (0 to count only)
 // Returns total number of devices available (may exceed max_devices), or -1 on error.
+//
+// Served from a cached snapshot: the first call creates one shared
+// backend context (ma_context_init runs 100-400 ms on some ALSA
+// setups) and keeps it alive, so every later call is a memory read.
+// The snapshot only moves when mh_audio_refresh_devices is called --
+// devices plugged or unplugged since then are not reflected until a
+// refresh. Thread-safe.
 int mh_audio_enumerate_playback_devices(MH_AudioDeviceInfo* out_devices, int max_devices);
 
 // Enumerate available audio capture (input) devices.
 // See mh_audio_enumerate_playback_devices for semantics.
 int mh_audio_enumerate_capture_devices(MH_AudioDeviceInfo* out_devices, int max_devices);
 
+// Called after mh_audio_refresh_devices found the device list changed.
+// Runs on the thread that called refresh; enumeration from inside the
+// callback is allowed.
+typedef void (*MH_AudioDeviceChangeCallback)(void* user_data);
+
+// Re-query the backend for both device lists, updating the cached
+// snapshot. Fires the registered change callback when the refreshed
+// list differs from the previous snapshot. The backend offers no
+// hot-plug notification, so this is the poll point: a watcher calling
+// refresh at, say, 1 Hz costs one backend query per second while every
+// enumeration in between stays a memory read. Returns 1 on success,
+// 0 on backend failure (the previous snapshot stays intact).
+int mh_audio_refresh_devices(void);
+
+// Register (or clear, with NULL) the device-change callback fired by
+// mh_audio_refresh_devices. One callback process-wide; a second call
+// replaces the first. Returns 1.
+int mh_audio_set_device_change_callback(MH_AudioDeviceChangeCallback callback,
+                                        void* user_data);
+
+// Tear down the shared enumeration context and drop the snapshot (the
+// next enumeration re-creates both). Optional -- the context is
+// process-lived otherwise. Do not call concurrently with enumeration
+// from a change callback.
+void mh_audio_enumeration_shutdown(void);
+
 // Input callback for effects (called from audio thread)
 // Provides input audio to be processed by the plugin
 // buffer: non-interleaved audio buffers [channel][frame]
@@ -55,6 +89,14 @@ int mh_audio_enumerate_capture_devices(MH_AudioDeviceInfo* out_devices, int max_
 // user_data: user-provided context pointer
 typedef void (*MH_AudioInputCallback)(float* const* buffer, int nframes, void* user_data);
 
+// Overload callback (called from the audio thread when one callback's
+// processing time exceeded its buffer period, i.e. an underrun was
+// unavoidable). load is the ratio of callback duration to buffer
+// period for the offending block (> 1.0). The callback runs on the
+// audio thread: it must not block, allocate, or take locks -- typical
+// use is flipping an atomic flag that a monitoring thread polls.
+typedef void (*MH_AudioOverloadCallback)(double load, void* user_data);
+
 // Open an audio device for real-time playback through a plugin
 // plugin: the plugin to process audio (must remain valid while device is open)
 // config: optional configuration (NULL for defaults)
@@ -103,6 +145,25 @@ int mh_audio_get_buffer_frames(MH_AudioDevice* dev);
 // Get the number of output channels
 int mh_audio_get_channels(MH_AudioDevice* dev);
 
+// Get the rolling audio callback load: the exponentially smoothed
+// ratio of callback processing time to buffer period (0.0 = idle,
+// 1.0 = the callback consumes its entire real-time budget). Updated
+// by the audio thread with lock-free atomics; safe to poll from any
+// thread. Returns 0.0 before the first callback (or for NULL).
+double mh_audio_get_load(MH_AudioDevice* dev);
+
+// Get the number of callbacks whose processing time exceeded the
+// buffer period since the device was opened (each one is an audible
+// underrun). Monotonic; safe to poll from any thread.
+long long mh_audio_get_xrun_count(MH_AudioDevice* dev);
+
+// Install an overload callback fired from the audio thread whenever a
+// callback overruns its buffer period (the same condition counted by
+// mh_audio_get_xrun_count). Pass NULL to clear. Same publication
+// contract as mh_audio_set_input_callback: clear before installing a
+// different non-NULL callback.
+void mh_audio_set_overload_callback(MH_AudioDevice* dev, MH_AudioOverloadCallback cb, void* user_data);
+
 // Connect MIDI input port (can be called while running)
 // port_index: MIDI input port index (use mh_midi_enumerate_inputs to list)
 // Returns 1 on success, 0 on failure
@@ -148,13 +209,143 @@ int mh_audio_is_midi_input_virtual(MH_AudioDevice* dev);
 int mh_audio_is_midi_output_virtual(MH_AudioDevice* dev);
 
 // Send MIDI event to the plugin (thread-safe, can be called while playing)
-// Events are queued and processed at the start of the next audio buffer
+// Events are queued, timestamped at receipt, and delivered within the next
+// audio buffer at a sample offset derived from the timestamp (the same
+// sample-accurate path as hardware MIDI input)
 // status: MIDI status byte (e.g., 0x90 for note on, 0x80 for note off)
 // data1: first data byte (e.g., note number)
 // data2: second data byte (e.g., velocity)
 // Returns 1 on success, 0 on failure (e.g., queue full)
 int mh_audio_send_midi(MH_AudioDevice* dev, unsigned char status, unsigned char data1, unsigned char data2);
 
+// One compiled CC-to-parameter mapping for the native MIDI path.
+// The 128-entry lookup table is precomputed by the caller from the
+// mapping's value range and response curve, so the audio thread does a
+// single indexed load per CC event -- no curve math, no allocation.
+typedef struct MH_CCMapping {
+    int channel;        // MIDI channel 0-15, or -1 = any channel
+    int cc;             // CC number 0-127
+    int plugin_index;   // chain devices: index of the target plugin; 0 for single-plugin devices
+    int param_index;    // parameter index on the target plugin
+    float lut[128];     // CC value (0-127) -> normalized parameter value (0.0 to 1.0)
+} MH_CCMapping;
+
+// Install a compiled CC-to-parameter map on the device (thread-safe,
+// can be called while playing). The table is copied; the caller's array
+// need not outlive the call. Pass NULL/0 to clear.
+//
+// While a map is installed, the audio thread translates matching CC
+// events from the device's MIDI input into parameter writes applied at
+// the start of the block (via the sample-accurate automation path, so
+// no mutex is taken beyond the process call the audio thread already
+// makes). Mapped CC events are consumed -- they do not also reach the
+// plugin as MIDI. Unmatched events pass through unchanged.
+//
+// The displaced table is retired and freed on the next call (or at
+// close), giving any in-flight audio callback time to finish with it --
+// same publication contract as mh_audio_set_input_callback.
+// Returns 1 on success, 0 on failure (NULL device or allocation).
+int mh_audio_set_cc_map(MH_AudioDevice* dev, const MH_CCMapping* mappings, int count);
+
+// Install a preloaded loop-audio source (thread-safe, can be called
+// while playing). The planar audio (data[channel][frame], already at
+// the device sample rate) is copied into an internally-owned buffer;
+// the audio callback then reads it directly with wraparound as the
+// plugin input -- no feeding thread, no ring buffer, nothing outside
+// the callback in the loop. If channels is fewer than the device's
+// channel count, source channels repeat (mono duplicates to all).
+//
+// Precedence in the callback is capture > playlist > loop source >
+// input callback > silence. Pass NULL/0 to clear (playback restarts
+// from the top if a source is installed again). The displaced source
+// is retired and freed on the next call (or at close), same
+// publication contract as mh_audio_set_cc_map.
+// Returns 1 on success, 0 on failure (NULL device, bad args, or allocation).
+int mh_audio_set_loop_source(MH_AudioDevice* dev, const float* const* data,
+                             int channels, int num_frames);
+
+// ---- Gapless playlist ----
+//
+// A queue of preloaded items played back to back through the plugin
+// with no device restart and no re-prepare: when one item ends, the
+// next continues at the very next frame (optionally crossfaded), so a
+// sequencer chaining songs never hears the hundreds of milliseconds of
+// stop/re-warmup a close/reopen cycle costs. Items follow the
+// loop-source convention -- the caller pre-decodes (mh_audio_read_planar
+// for audio files, the MidiFile machinery for MIDI files) and hands the
+// device flat data, which it copies; queueing the next item from a
+// background thread while the current one plays is exactly the
+// intended use, since an append publishes one pointer and never
+// disturbs the audio thread.
+//
+// Items are played in append order. Audio items feed the plugin like a
+// (non-looping) loop source; channels repeat if fewer than the
+// device's. MIDI items feed silence plus their events -- offsets are
+// frames from the item's start, the list must be sorted, and the item
+// ends after duration_frames regardless of the last event (schedule
+// your note-offs inside the duration). An exhausted playlist yields to
+// the lower-precedence input sources and stays poised: appending
+// another item resumes playback on the next block.
+//
+// Append calls are thread-safe against the audio thread but must be
+// serialized among app threads (same contract as the other setters).
+// Returns 1 on success, 0 on failure (NULL device, bad args, or
+// allocation).
+int mh_audio_playlist_add_audio(MH_AudioDevice* dev, const float* const* data,
+                                int channels, int num_frames);
+int mh_audio_playlist_add_midi(MH_AudioDevice* dev, const MH_MidiEvent* events,
+                               int num_events, int duration_frames);
+
+// Set the crossfade length applied at audio-to-audio splices (linear
+// ramps, clamped to both item lengths; splices involving a MIDI item
+// are hard cuts). 0 (the default) splices without fading. Takes
+// effect from the next splice; thread-safe. Returns 1 on success.
+int mh_audio_playlist_set_crossfade(MH_AudioDevice* dev, int frames);
+
+// Drop all queued items (thread-safe, can be called while playing;
+// playback stops at the next block). The displaced items are retired
+// and freed on the next clear (or at close), same publication contract
+// as mh_audio_set_cc_map. Returns 1 on success.
+int mh_audio_playlist_clear(MH_AudioDevice* dev);
+
+// Index of the item currently playing (0-based, in append order since
+// the last clear), or -1 when the playlist is empty / cleared. An
+// exhausted playlist keeps reporting its last item. Safe to poll from
+// any thread.
+int mh_audio_playlist_get_index(MH_AudioDevice* dev);
+
+// Number of items appended since the last clear (played ones included).
+int mh_audio_playlist_get_count(MH_AudioDevice* dev);
+
+// Start recording the device's processed output to disk (thread-safe,
+// can be called while playing). Format is chosen by extension like
+// mh_audio_write (.wav: bit_depth 16/24/32, .flac: 16/24). The audio
+// callback hands each processed block to a lock-free FIFO; a writer
+// thread drains it into the streaming encoder with large buffered
+// writes, so encoding and disk latency never touch the callback. If
+// the disk stalls long enough to fill the FIFO (~4 s), the overflow is
+// dropped and counted (mh_audio_record_dropped_frames) rather than
+// blocking the audio thread.
+// Only one recording at a time; stop with mh_audio_record_stop().
+// Returns 1 on success, 0 on failure (writes message to err_buf).
+int mh_audio_record_start(MH_AudioDevice* dev, const char* path, int bit_depth,
+                          char* err_buf, size_t err_buf_size);
+
+// Stop recording: drain the FIFO, finalize the container, and release
+// the writer thread. Blocks until the remaining buffered audio is on
+// disk. Returns 1 on success, 0 on failure (not recording, or an
+// encode/write error occurred -- message in err_buf; a write error
+// during recording is sticky and surfaces here).
+int mh_audio_record_stop(MH_AudioDevice* dev, char* err_buf, size_t err_buf_size);
+
+// Check if a recording is in progress. Returns 1 if recording, 0 if not.
+int mh_audio_is_recording(MH_AudioDevice* dev);
+
+// Get the number of frames dropped because the recording FIFO was full
+// (disk stall). Reset by mh_audio_record_start; safe to poll from any
+// thread.
+long long mh_audio_record_dropped_frames(MH_AudioDevice* dev);
+
 // Enable ring-buffer-based audio input for effect processing.
 // Creates an internal ring buffer and installs an input callback that reads from it.
 // Call mh_audio_write_input() from any thread to push audio data.
@@ -171,10 +362,53 @@ void mh_audio_disable_input(MH_AudioDevice* dev);
 // Returns number of frames actually written (may be less if buffer is full).
 int mh_audio_write_input(MH_AudioDevice* dev, const float* data, int nframes);
 
+// As mh_audio_write_input but planar: one pointer per channel, nframes
+// floats each. The ring buffer interleaves directly into its own
+// storage, so planar producers skip the interleaved staging copy.
+// Extra device channels are zero-filled, extra source channels dropped.
+// Returns number of frames actually written (may be less if buffer is full).
+int mh_audio_write_input_planar(MH_AudioDevice* dev, const float* const* data,
+                                int channels, int nframes);
+
 // Get number of frames available in the input ring buffer for reading.
 // Returns 0 if input ring buffer is not enabled.
 int mh_audio_input_available(MH_AudioDevice* dev);
 
+// Drift-compensation statistics (mh_audio_input_drift_stats).
+typedef struct MH_InputDriftStats {
+    double ratio;            // current consumption ratio (1.0 = nominal;
+                             // > 1 drains the ring faster than realtime)
+    double fill_avg;         // smoothed ring fill level, frames
+    int fill_target;         // setpoint the controller holds, frames
+    long long underruns;     // blocks short on data despite compensation
+} MH_InputDriftStats;
+
+// Enable/disable drift-compensated consumption of the input ring buffer.
+// A producer clocked against a different crystal than the output device
+// (network audio, a second soundcard) walks the ring fill level a few
+// ppm per block until it underruns or overflows, no matter how big the
+// buffer is. When enabled, the input callback tracks the smoothed fill
+// level and trims its consumption rate through a fractional resampler
+// (miniaudio's linear resampler with a dynamic in/out ratio) so the
+// level holds at half the ring capacity. The correction authority is
+// capped at +/-2000 ppm -- orders of magnitude above any real crystal
+// mismatch, far below audibility.
+//
+// Call after mh_audio_enable_input and, like it, not while the device
+// is running. Enabling allocates the resampler and two interleaved
+// scratch buffers; disabling frees them. mh_audio_disable_input tears
+// the compensation down with the ring buffer.
+// Returns 1 on success, 0 on failure (no device, input not enabled,
+// or allocation failure).
+int mh_audio_set_input_drift_comp(MH_AudioDevice* dev, int enabled);
+
+// Read the drift-compensation stats (safe from any thread). ratio and
+// fill_avg come from the audio thread via relaxed atomics, so a
+// dashboard can watch the controller settle: a steady ratio offset IS
+// the measured clock drift between producer and output device.
+// Returns 1 on success, 0 if drift compensation is not enabled.
+int mh_audio_input_drift_stats(MH_AudioDevice* dev, MH_InputDriftStats* out_stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,242 @@
+// minihost_audiocache.c
+// Decoded-audio cache: (path, mtime, size)-keyed planar float32 blocks
+// with an LRU-evicted memory budget. See minihost_audiocache.h.
+
+#include "minihost_audiocache.h"
+#include "minihost_audiofile.h"
+#include "miniaudio.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+// One cached stem. Entries live on a singly linked list -- sessions
+// hold dozens of stems, not thousands, so a scan beats the bookkeeping
+// of a hash table here. `refs` counts live views; an entry detached
+// from the list (evicted/invalidated while viewed) is freed by the
+// last release instead.
+typedef struct CacheEntry {
+    struct CacheEntry* next;
+    char* path;
+    unsigned long long mtime;
+    unsigned long long fsize;
+    MH_AudioDataPlanar* audio;
+    unsigned long long bytes;
+    int refs;
+    int in_cache;
+    unsigned long long last_use;   // LRU tick
+} CacheEntry;
+
+// ma_spinlock needs no init call, so the cache works from the first
+// acquire without an init/once dance. The lock only covers list and
+// counter updates; decodes run outside it.
+static ma_spinlock g_cache_lock = 0;
+static CacheEntry* g_cache_head = NULL;
+static unsigned long long g_cache_budget = 0;
+static unsigned long long g_cache_bytes = 0;
+static unsigned int g_cache_entries = 0;
+static unsigned long long g_cache_hits = 0;
+static unsigned long long g_cache_misses = 0;
+static unsigned long long g_cache_evictions = 0;
+static unsigned long long g_cache_tick = 0;
+
+static void cache_entry_free(CacheEntry* e) {
+    mh_audio_data_planar_free(e->audio);
+    free(e->path);
+    free(e);
+}
+
+// Detach an entry from the list and the footprint counters. Frees it
+// immediately unless views are still out.
+static void cache_detach_locked(CacheEntry* e, CacheEntry* prev) {
+    if (prev) prev->next = e->next;
+    else g_cache_head = e->next;
+    e->next = NULL;
+    e->in_cache = 0;
+    g_cache_bytes -= e->bytes;
+    g_cache_entries--;
+    g_cache_evictions++;
+    if (e->refs == 0) cache_entry_free(e);
+}
+
+// Evict unreferenced entries, LRU first, until the footprint plus
+// `incoming` fits the budget. Entries with live views are skipped.
+static void cache_evict_to_fit_locked(unsigned long long incoming) {
+    while (g_cache_bytes + incoming > g_cache_budget) {
+        CacheEntry* lru = NULL;
+        CacheEntry* lru_prev = NULL;
+        CacheEntry* prev = NULL;
+        for (CacheEntry* e = g_cache_head; e; prev = e, e = e->next) {
+            if (e->refs == 0 && (!lru || e->last_use < lru->last_use)) {
+                lru = e;
+                lru_prev = prev;
+            }
+        }
+        if (!lru) break;  // everything left is in use
+        cache_detach_locked(lru, lru_prev);
+    }
+}
+
+// stat the file for the cache key. Seconds-resolution mtime plus size
+// is the same freshness test make uses; a re-exported stem changes both
+// in practice.
+static int cache_stat(const char* path, unsigned long long* mtime,
+                      unsigned long long* fsize) {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(path, &st) != 0) return 0;
+#else
+    struct stat st;
+    if (stat(path, &st) != 0) return 0;
+#endif
+    *mtime = (unsigned long long)st.st_mtime;
+    *fsize = (unsigned long long)st.st_size;
+    return 1;
+}
+
+int mh_audio_cache_set_budget(unsigned long long max_bytes) {
+    ma_spinlock_lock(&g_cache_lock);
+    g_cache_budget = max_bytes;
+    if (max_bytes == 0) {
+        while (g_cache_head) cache_detach_locked(g_cache_head, NULL);
+    } else {
+        cache_evict_to_fit_locked(0);
+    }
+    ma_spinlock_unlock(&g_cache_lock);
+    return 1;
+}
+
+unsigned long long mh_audio_cache_get_budget(void) {
+    ma_spinlock_lock(&g_cache_lock);
+    unsigned long long b = g_cache_budget;
+    ma_spinlock_unlock(&g_cache_lock);
+    return b;
+}
+
+void mh_audio_cache_clear(void) {
+    ma_spinlock_lock(&g_cache_lock);
+    while (g_cache_head) cache_detach_locked(g_cache_head, NULL);
+    ma_spinlock_unlock(&g_cache_lock);
+}
+
+int mh_audio_cache_stats(MH_AudioCacheStats* stats) {
+    if (!stats) return 0;
+    ma_spinlock_lock(&g_cache_lock);
+    stats->bytes = g_cache_bytes;
+    stats->entries = g_cache_entries;
+    stats->hits = g_cache_hits;
+    stats->misses = g_cache_misses;
+    stats->evictions = g_cache_evictions;
+    ma_spinlock_unlock(&g_cache_lock);
+    return 1;
+}
+
+static void cache_fill_view(CacheEntry* e, MH_AudioCacheView* view) {
+    view->data = e->audio->data;
+    view->channels = e->audio->channels;
+    view->frames = e->audio->frames;
+    view->sample_rate = e->audio->sample_rate;
+    view->entry = e;
+}
+
+int mh_audio_cache_acquire(const char* path, MH_AudioCacheView* view,
+                           char* err, size_t err_size) {
+    if (!path || !view) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return 0;
+    }
+    memset(view, 0, sizeof(*view));
+
+    unsigned long long mtime = 0, fsize = 0;
+    if (!cache_stat(path, &mtime, &fsize)) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Failed to stat file: %s", path);
+        return 0;
+    }
+
+    ma_spinlock_lock(&g_cache_lock);
+    CacheEntry* prev = NULL;
+    for (CacheEntry* e = g_cache_head; e; prev = e, e = e->next) {
+        if (strcmp(e->path, path) != 0) continue;
+        if (e->mtime == mtime && e->fsize == fsize) {
+            e->refs++;
+            e->last_use = ++g_cache_tick;
+            g_cache_hits++;
+            cache_fill_view(e, view);
+            ma_spinlock_unlock(&g_cache_lock);
+            return 1;
+        }
+        // Stale: the file changed under the cached copy.
+        cache_detach_locked(e, prev);
+        break;
+    }
+    g_cache_misses++;
+    ma_spinlock_unlock(&g_cache_lock);
+
+    // Decode outside the lock; concurrent misses on the same path each
+    // decode, and the insert below resolves the duplicate.
+    MH_AudioDataPlanar* audio = mh_audio_read_planar(path, err, err_size);
+    if (!audio) return 0;
+
+    CacheEntry* e = (CacheEntry*)calloc(1, sizeof(CacheEntry));
+    if (!e) {
+        mh_audio_data_planar_free(audio);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return 0;
+    }
+    size_t path_len = strlen(path) + 1;
+    e->path = (char*)malloc(path_len);
+    if (!e->path) {
+        free(e);
+        mh_audio_data_planar_free(audio);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return 0;
+    }
+    memcpy(e->path, path, path_len);
+    e->mtime = mtime;
+    e->fsize = fsize;
+    e->audio = audio;
+    e->bytes = (unsigned long long)audio->channels * audio->frames *
+               sizeof(float);
+    e->refs = 1;
+
+    ma_spinlock_lock(&g_cache_lock);
+    // Another thread may have inserted this stem while we decoded; use
+    // its copy and drop ours so concurrent readers converge on one.
+    for (CacheEntry* other = g_cache_head; other; other = other->next) {
+        if (strcmp(other->path, path) == 0 && other->mtime == mtime &&
+            other->fsize == fsize) {
+            other->refs++;
+            other->last_use = ++g_cache_tick;
+            cache_fill_view(other, view);
+            ma_spinlock_unlock(&g_cache_lock);
+            cache_entry_free(e);
+            return 1;
+        }
+    }
+    if (g_cache_budget > 0 && e->bytes <= g_cache_budget) {
+        cache_evict_to_fit_locked(e->bytes);
+        e->in_cache = 1;
+        e->last_use = ++g_cache_tick;
+        e->next = g_cache_head;
+        g_cache_head = e;
+        g_cache_bytes += e->bytes;
+        g_cache_entries++;
+    }
+    // else: disabled or over-budget -- serve privately, freed on release.
+    cache_fill_view(e, view);
+    ma_spinlock_unlock(&g_cache_lock);
+    return 1;
+}
+
+void mh_audio_cache_release(MH_AudioCacheView* view) {
+    if (!view || !view->entry) return;
+    CacheEntry* e = (CacheEntry*)view->entry;
+    memset(view, 0, sizeof(*view));
+    ma_spinlock_lock(&g_cache_lock);
+    e->refs--;
+    int dead = (e->refs == 0 && !e->in_cache);
+    ma_spinlock_unlock(&g_cache_lock);
+    if (dead) cache_entry_free(e);
+}
@@ -0,0 +1,75 @@
+// minihost_audiocache.h
+// Opt-in process-wide cache of decoded audio files.
+//
+// A/B and batch workflows read the same input stems dozens of times per
+// session; each read_audio pays the full decode again. The cache keeps
+// decoded planar float32 blocks keyed by (path, mtime, size), bounded
+// by a caller-set memory budget with LRU eviction, so the
+// second-through-Nth read of an unchanged stem is a refcounted pointer
+// handoff instead of a decode. Disabled until a budget is set; all
+// entry points are thread-safe.
+
+#ifndef MINIHOST_AUDIOCACHE_H
+#define MINIHOST_AUDIOCACHE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Set the cache memory budget in bytes. 0 (the initial state) disables
+// the cache and drops every unreferenced entry; shrinking below the
+// current footprint evicts LRU-first. Returns 1.
+int mh_audio_cache_set_budget(unsigned long long max_bytes);
+
+// Current budget in bytes (0 = disabled).
+unsigned long long mh_audio_cache_get_budget(void);
+
+// View into a cache entry. `data` is the same contiguous planar layout
+// as MH_AudioDataPlanar (channel c starts at data + c * frames) and is
+// immutable and valid until mh_audio_cache_release. Do not free it.
+typedef struct {
+    const float* data;
+    unsigned int channels;
+    unsigned int frames;
+    unsigned int sample_rate;
+    // internal (do not touch)
+    void* entry;
+} MH_AudioCacheView;
+
+// Acquire a decoded view of an audio file. A valid cached entry (same
+// path, mtime, and size) is handed out directly; otherwise the file is
+// decoded (mh_audio_read_planar), inserted when it fits the budget,
+// and handed out. With the cache disabled -- or for files larger than
+// the whole budget -- the decode is served privately and freed on
+// release, so callers use one code path either way. Returns 1 on
+// success, 0 on error (writes message to err).
+int mh_audio_cache_acquire(const char* path, MH_AudioCacheView* view,
+                           char* err, size_t err_size);
+
+// Release a view. Safe on a zeroed or already-released struct.
+void mh_audio_cache_release(MH_AudioCacheView* view);
+
+// Drop every unreferenced entry (entries with live views are dropped
+// when their last view is released). The budget is unchanged.
+void mh_audio_cache_clear(void);
+
+// Cache counters since process start (or the numbers' last natural
+// reset -- they are never zeroed by clear/set_budget).
+typedef struct {
+    unsigned long long bytes;      // decoded bytes currently resident
+    unsigned int entries;          // entries currently resident
+    unsigned long long hits;       // acquires served from the cache
+    unsigned long long misses;     // acquires that had to decode
+    unsigned long long evictions;  // entries evicted or invalidated
+} MH_AudioCacheStats;
+
+// Snapshot the counters. Returns 1 (0 only for a NULL stats pointer).
+int mh_audio_cache_stats(MH_AudioCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MINIHOST_AUDIOCACHE_H
@@ -1,12 +1,17 @@
 // minihost_audiofile.c
 // Audio file read/write using miniaudio decoder/encoder + tflac for FLAC output
 
+#ifdef __linux__
+#define _GNU_SOURCE  // O_DIRECT
+#endif
+
 #include "minihost_audiofile.h"
 #include "miniaudio.h"
 #include "tflac.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 MH_AudioData* mh_audio_read(const char* path, char* err, size_t err_size) {
     if (!path) {
@@ -55,378 +60,1801 @@ void mh_audio_data_free(MH_AudioData* data) {
     free(data);
 }
 
-static int write_wav(const char* path, const float* data,
-                     unsigned int channels, unsigned int frames,
-                     unsigned int sample_rate, int bit_depth,
-                     char* err, size_t err_size) {
-    ma_format format;
-    switch (bit_depth) {
-        case 16: format = ma_format_s16; break;
-        case 24: format = ma_format_s24; break;
-        case 32: format = ma_format_f32; break;
-        default:
-            if (err && err_size > 0)
-                snprintf(err, err_size, "Unsupported bit depth: %d (use 16, 24, or 32)", bit_depth);
-            return 0;
+MH_AudioDataPlanar* mh_audio_read_planar(const char* path, char* err, size_t err_size) {
+    MH_AudioData* interleaved = mh_audio_read(path, err, err_size);
+    if (!interleaved) return NULL;
+
+    unsigned int channels = interleaved->channels;
+    unsigned int frames = interleaved->frames;
+
+    MH_AudioDataPlanar* data = (MH_AudioDataPlanar*)malloc(sizeof(MH_AudioDataPlanar));
+    float* planar = (float*)malloc((size_t)channels * frames * sizeof(float));
+    float** ptrs = (float**)malloc(channels * sizeof(float*));
+    if (!data || !planar || !ptrs) {
+        free(ptrs);
+        free(planar);
+        free(data);
+        mh_audio_data_free(interleaved);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+
+    for (unsigned int c = 0; c < channels; c++) {
+        ptrs[c] = planar + (size_t)c * frames;
     }
+    mh_audio_deinterleave(interleaved->data, ptrs, channels, frames);
+    free(ptrs);
+
+    data->data = planar;
+    data->channels = channels;
+    data->frames = frames;
+    data->sample_rate = interleaved->sample_rate;
+    mh_audio_data_free(interleaved);
+    return data;
+}
+
+void mh_audio_data_planar_free(MH_AudioDataPlanar* data) {
+    if (!data) return;
+    free(data->data);
+    free(data);
+}
+
+// ---- Streaming writer ----
+//
+// All file writing goes through MH_AudioWriter; mh_audio_write is a
+// one-shot open/write/close over it.
 
-    ma_encoder_config config = ma_encoder_config_init(
-        ma_encoding_format_wav, format, channels, sample_rate);
+#define FLAC_BLOCKSIZE 4096
 
+static const char* get_extension(const char* path);
+static int strcasecmp_ext(const char* a, const char* b);
+static void put_u16_le(unsigned char* p, unsigned int v);
+static void put_u32_le(unsigned char* p, unsigned long v);
+
+// Per-stream dither state: a TPDF noise generator plus per-channel
+// second-order error-feedback history for MH_DITHER_SHAPED. Owned by
+// whatever drives a conversion run (the streaming writer, or one per
+// worker on the frame-parallel FLAC path -- error feedback then resets
+// at run boundaries, which is inaudible at -90 dB).
+typedef struct {
+    int mode;              // MH_DitherMode
+    unsigned int rng;      // xorshift32 state, never zero
+    float* e1;             // per-channel previous quantization error
+    float* e2;             // per-channel error before that
+} dither_state;
+
+struct MH_AudioWriter {
+    unsigned int channels;
+    unsigned int sample_rate;
+    int bit_depth;
+    int is_flac;
+    int failed;                   // sticky: set on first encode/write error
+    unsigned long long frames_written;
+    char* path;                   // owned copy, for removing failed FLAC output
+
+    // WAV (miniaudio encoder)
+    ma_format format;
     ma_encoder encoder;
-    ma_result result = ma_encoder_init_file(path, &config, &encoder);
-    if (result != MA_SUCCESS) {
-        if (err && err_size > 0) {
-            snprintf(err, err_size, "Failed to open file for writing: %s (error %d)", path, result);
-        }
-        return 0;
-    }
+    void* wav_conv;               // s16/s24 conversion scratch
+    size_t wav_conv_cap;          // capacity in samples
 
-    ma_uint64 total_samples = (ma_uint64)frames * channels;
+    // Float->int dither (mh_audio_writer_set_dither)
+    dither_state dither;
 
-    if (format == ma_format_f32) {
-        ma_uint64 written = 0;
-        result = ma_encoder_write_pcm_frames(&encoder, data, frames, &written);
-    } else {
-        size_t bytes_per_sample = ma_get_bytes_per_sample(format);
-        size_t buffer_size = total_samples * bytes_per_sample;
+    // FLAC (tflac)
+    tflac t;
+    void* mem;
+    void* frame_buf;
+    tflac_u32 frame_buf_size;
+    void* flac_conv;              // one block of s16/s32
+    float* carry;                 // partial block [FLAC_BLOCKSIZE * channels]
+    unsigned int carry_frames;
+    FILE* fp;                     // also the append stream in capture mode
+
+    // WAV capture mode (own RF64-ready container; no ma_encoder)
+    int capture_mode;
+    int is_rf64;                  // one-way upgrade past 4 GB
+    int capture_padded;           // trailing pad byte written at close
+    unsigned long long data_bytes;
+    unsigned long long flush_interval_frames;
+    unsigned long long next_flush_frames;
+#ifdef _WIN32
+    FILE* patch_fp;               // no pwrite on Windows; patch via a
+                                  // dedicated stream instead
+#endif
+
+    // Unbuffered (direct I/O) mode; shares the capture-mode container
+    int unbuffered;
+    int direct_fd;
+    int direct_active;            // O_DIRECT actually engaged (needs the
+                                  // aligned tail handling at close)
+    unsigned char* stage;         // aligned staging buffer
+    size_t stage_used;
+};
+
+// ---- Dither ----
+
+static void dither_state_init(dither_state* ds) {
+    ds->mode = MH_DITHER_TPDF;
+    ds->rng = 0x9E3779B9u;
+    ds->e1 = NULL;
+    ds->e2 = NULL;
+}
 
-        void* converted = malloc(buffer_size);
-        if (!converted) {
-            ma_encoder_uninit(&encoder);
-            if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
-            return 0;
-        }
+// Two uniform variates summed give a triangular pdf spanning (-1, 1)
+// LSB -- the classic TPDF dither amplitude.
+static float dither_tpdf(unsigned int* rng) {
+    unsigned int x = *rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    float a = (float)(x & 0xFFFFFFu) * (1.0f / 16777216.0f);
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    float b = (float)(x & 0xFFFFFFu) * (1.0f / 16777216.0f);
+    *rng = x;
+    return a - b;
+}
+
+// Quantize one sample at `scale` with TPDF dither and (1 - z^-1)^2
+// error-feedback noise shaping. The feedback makes the loop serial per
+// channel, so shaped conversion is a plain scalar loop; the flat TPDF
+// and none modes keep miniaudio's vectorizable converters.
+static long dither_shaped_quantize(dither_state* ds, unsigned int ch,
+                                   float sample, double scale,
+                                   long lo, long hi) {
+    double in = (double)sample * scale;
+    double shaped = in + 2.0 * (double)ds->e1[ch] - (double)ds->e2[ch];
+    long q = lrint(shaped + (double)dither_tpdf(&ds->rng));
+    ds->e2[ch] = ds->e1[ch];
+    ds->e1[ch] = (float)(shaped - (double)q);
+    if (q > hi) q = hi;
+    if (q < lo) q = lo;
+    return q;
+}
+
+static void dither_shaped_f32_to_s16(dither_state* ds, ma_int16* dst,
+                                     const float* src, unsigned int frames,
+                                     unsigned int channels) {
+    for (unsigned int f = 0; f < frames; f++)
+        for (unsigned int c = 0; c < channels; c++, src++, dst++)
+            *dst = (ma_int16)dither_shaped_quantize(ds, c, *src, 32768.0,
+                                                    -32768, 32767);
+}
 
-        if (format == ma_format_s16) {
-            ma_pcm_f32_to_s16(converted, data, total_samples, ma_dither_mode_triangle);
-        } else if (format == ma_format_s24) {
-            ma_pcm_f32_to_s24(converted, data, total_samples, ma_dither_mode_triangle);
+// Packed 3-byte little-endian samples, matching ma_pcm_f32_to_s24.
+static void dither_shaped_f32_to_s24(dither_state* ds, unsigned char* dst,
+                                     const float* src, unsigned int frames,
+                                     unsigned int channels) {
+    for (unsigned int f = 0; f < frames; f++)
+        for (unsigned int c = 0; c < channels; c++, src++, dst += 3) {
+            long q = dither_shaped_quantize(ds, c, *src, 8388608.0,
+                                            -8388608, 8388607);
+            dst[0] = (unsigned char)(q & 0xFF);
+            dst[1] = (unsigned char)((q >> 8) & 0xFF);
+            dst[2] = (unsigned char)((q >> 16) & 0xFF);
         }
+}
 
-        ma_uint64 written = 0;
-        result = ma_encoder_write_pcm_frames(&encoder, converted, frames, &written);
-        free(converted);
-    }
+// tflac's 24-in-32 layout for the FLAC path.
+static void dither_shaped_f32_to_s32_24(dither_state* ds, tflac_s32* dst,
+                                        const float* src, unsigned int frames,
+                                        unsigned int channels) {
+    for (unsigned int f = 0; f < frames; f++)
+        for (unsigned int c = 0; c < channels; c++, src++, dst++)
+            *dst = (tflac_s32)dither_shaped_quantize(ds, c, *src, 8388607.0,
+                                                     -8388607, 8388607);
+}
 
-    ma_encoder_uninit(&encoder);
+static ma_dither_mode dither_to_ma(int mode) {
+    return mode == MH_DITHER_NONE ? ma_dither_mode_none
+                                  : ma_dither_mode_triangle;
+}
 
-    if (result != MA_SUCCESS) {
-        if (err && err_size > 0) {
-            snprintf(err, err_size, "Failed to write audio data (error %d)", result);
+// Convert one frame's worth of interleaved float samples and encode it with
+// the given tflac instance into frame_buf. Returns tflac's result code
+// (0 = success); *used receives the encoded byte count.
+static int flac_convert_and_encode(tflac* t, const float* block_data,
+                                   unsigned int block_frames, unsigned int channels,
+                                   int bit_depth, void* conv, dither_state* ds,
+                                   void* frame_buf, tflac_u32 frame_buf_size,
+                                   tflac_u32* used) {
+    ma_uint64 block_total = (ma_uint64)block_frames * channels;
+
+    if (bit_depth == 16) {
+        tflac_s16* s16_buf = (tflac_s16*)conv;
+        if (ds->mode == MH_DITHER_SHAPED)
+            dither_shaped_f32_to_s16(ds, (ma_int16*)s16_buf, block_data,
+                                     block_frames, channels);
+        else
+            ma_pcm_f32_to_s16(s16_buf, block_data, block_total,
+                              dither_to_ma(ds->mode));
+        return tflac_encode_s16i(t, block_frames, s16_buf, frame_buf, frame_buf_size, used);
+    }
+
+    // 24-bit: scale f32 to s32 range for 24-bit (shift into upper bits)
+    tflac_s32* s32_buf = (tflac_s32*)conv;
+    if (ds->mode == MH_DITHER_SHAPED) {
+        dither_shaped_f32_to_s32_24(ds, s32_buf, block_data,
+                                    block_frames, channels);
+    } else {
+        for (ma_uint64 i = 0; i < block_total; i++) {
+            float s = block_data[i];
+            // Clamp to [-1, 1)
+            if (s > 1.0f) s = 1.0f;
+            if (s < -1.0f) s = -1.0f;
+            // Scale to 24-bit range, with flat TPDF noise unless the
+            // caller asked for plain rounding.
+            double scaled = (double)s * 8388607.0;
+            if (ds->mode == MH_DITHER_TPDF)
+                scaled += (double)dither_tpdf(&ds->rng);
+            tflac_s32 v = (tflac_s32)scaled;
+            if (v > 8388607) v = 8388607;
+            if (v < -8388607) v = -8388607;
+            s32_buf[i] = v;
         }
-        return 0;
     }
+    return tflac_encode_s32i(t, block_frames, s32_buf, frame_buf, frame_buf_size, used);
+}
 
+// Convert and encode exactly one FLAC frame of block_frames (<= FLAC_BLOCKSIZE)
+// interleaved float samples, and write it out.
+static int writer_flac_encode_block(MH_AudioWriter* w, const float* block_data,
+                                    unsigned int block_frames,
+                                    char* err, size_t err_size) {
+    tflac_u32 used = 0;
+    int r = flac_convert_and_encode(&w->t, block_data, block_frames, w->channels,
+                                    w->bit_depth, w->flac_conv, &w->dither,
+                                    w->frame_buf, w->frame_buf_size, &used);
+    if (r != 0) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "FLAC encode error %d at frame %llu",
+                     r, w->frames_written);
+        return 0;
+    }
+    if (fwrite(w->frame_buf, 1, used, w->fp) != used) {
+        if (err && err_size > 0) snprintf(err, err_size, "Write error");
+        return 0;
+    }
     return 1;
 }
 
-#define FLAC_BLOCKSIZE 4096
+MH_AudioWriter* mh_audio_writer_open(const char* path,
+                                     unsigned int channels,
+                                     unsigned int sample_rate,
+                                     int bit_depth,
+                                     char* err, size_t err_size) {
+    if (!path || channels == 0 || sample_rate == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return NULL;
+    }
 
-static int write_flac(const char* path, const float* data,
-                      unsigned int channels, unsigned int frames,
-                      unsigned int sample_rate, int bit_depth,
-                      char* err, size_t err_size) {
+    const char* ext = get_extension(path);
+    int is_wav = (strcasecmp_ext(ext, ".wav") == 0);
+    int is_flac = (strcasecmp_ext(ext, ".flac") == 0);
+    if (!is_wav && !is_flac) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Unsupported format '%s' (use .wav or .flac)", ext);
+        return NULL;
+    }
+
+    MH_AudioWriter* w = (MH_AudioWriter*)calloc(1, sizeof(MH_AudioWriter));
+    if (!w) {
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+    w->channels = channels;
+    w->sample_rate = sample_rate;
+    w->bit_depth = bit_depth;
+    dither_state_init(&w->dither);
+    w->is_flac = is_flac;
+
+    size_t path_len = strlen(path) + 1;
+    w->path = (char*)malloc(path_len);
+    if (!w->path) {
+        free(w);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+    memcpy(w->path, path, path_len);
+
+    if (is_wav) {
+        switch (bit_depth) {
+            case 16: w->format = ma_format_s16; break;
+            case 24: w->format = ma_format_s24; break;
+            case 32: w->format = ma_format_f32; break;
+            default:
+                if (err && err_size > 0)
+                    snprintf(err, err_size, "Unsupported bit depth: %d (use 16, 24, or 32)", bit_depth);
+                free(w->path);
+                free(w);
+                return NULL;
+        }
+
+        ma_encoder_config config = ma_encoder_config_init(
+            ma_encoding_format_wav, w->format, channels, sample_rate);
+        ma_result result = ma_encoder_init_file(path, &config, &w->encoder);
+        if (result != MA_SUCCESS) {
+            if (err && err_size > 0) {
+                snprintf(err, err_size, "Failed to open file for writing: %s (error %d)", path, result);
+            }
+            free(w->path);
+            free(w);
+            return NULL;
+        }
+        return w;
+    }
+
+    // FLAC
     if (bit_depth != 16 && bit_depth != 24) {
         if (err && err_size > 0)
             snprintf(err, err_size,
                      "FLAC does not support %d-bit; use 16 or 24", bit_depth);
-        return 0;
+        free(w->path);
+        free(w);
+        return NULL;
     }
 
-    tflac t;
-    tflac_init(&t);
-    t.blocksize = FLAC_BLOCKSIZE;
-    t.samplerate = sample_rate;
-    t.channels = channels;
-    t.bitdepth = (tflac_u32)bit_depth;
+    tflac_init(&w->t);
+    w->t.blocksize = FLAC_BLOCKSIZE;
+    w->t.samplerate = sample_rate;
+    w->t.channels = channels;
+    w->t.bitdepth = (tflac_u32)bit_depth;
 
     tflac_u32 mem_size = tflac_size_memory(FLAC_BLOCKSIZE);
-    void* mem = malloc(mem_size);
-    if (!mem) {
+    size_t block_samples = (size_t)FLAC_BLOCKSIZE * channels;
+
+    w->mem = malloc(mem_size);
+    w->frame_buf_size = tflac_size_frame(FLAC_BLOCKSIZE, channels, (tflac_u32)bit_depth);
+    w->frame_buf = malloc(w->frame_buf_size);
+    w->flac_conv = malloc(block_samples *
+                          (bit_depth == 16 ? sizeof(tflac_s16) : sizeof(tflac_s32)));
+    w->carry = (float*)malloc(block_samples * sizeof(float));
+    if (!w->mem || !w->frame_buf || !w->flac_conv || !w->carry) {
         if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
-        return 0;
+        goto fail;
     }
 
-    if (tflac_validate(&t, mem, mem_size) != 0) {
-        free(mem);
+    if (tflac_validate(&w->t, w->mem, mem_size) != 0) {
         if (err && err_size > 0) snprintf(err, err_size, "tflac_validate failed");
+        goto fail;
+    }
+
+    w->fp = fopen(path, "wb");
+    if (!w->fp) {
+        if (err && err_size > 0) snprintf(err, err_size, "Failed to open file: %s", path);
+        goto fail;
+    }
+
+    {
+        // Write fLaC marker, then reserve space for the STREAMINFO metadata
+        // block (4-byte header + 34-byte body = 38 bytes); it is rewritten
+        // with real totals on close.
+        const unsigned char flac_marker[4] = {'f', 'L', 'a', 'C'};
+        unsigned char streaminfo_placeholder[38];
+        memset(streaminfo_placeholder, 0, sizeof(streaminfo_placeholder));
+        if (fwrite(flac_marker, 1, 4, w->fp) != 4 ||
+            fwrite(streaminfo_placeholder, 1, 38, w->fp) != 38) {
+            if (err && err_size > 0) snprintf(err, err_size, "Write error");
+            fclose(w->fp);
+            remove(path);
+            w->fp = NULL;
+            goto fail;
+        }
+    }
+
+    return w;
+
+fail:
+    free(w->carry);
+    free(w->flac_conv);
+    free(w->frame_buf);
+    free(w->mem);
+    free(w->path);
+    free(w);
+    return NULL;
+}
+
+// ---- Crash-safe WAV capture mode ----
+//
+// Capture mode writes its own RF64-ready container instead of going
+// through ma_encoder (which only fixes the chunk sizes at uninit): a
+// ds64-sized JUNK chunk sits between the RIFF header and fmt, so the
+// file can be upgraded to RF64/BW64 in place when the data chunk
+// outgrows 32-bit sizes. The whole header region is a fixed 80 bytes,
+// rebuilt in memory and patched with one positioned write -- the
+// append position of the sample stream is never seeked, and the sizes
+// on disk never claim more data than has been flushed.
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#define CAPTURE_HEADER_SIZE 80
+#define CAPTURE_DATA_SIZE_MAX 0xFFFFFFF0ull  // stay clear of the u32 limit
+#define CAPTURE_DEFAULT_FLUSH_SECONDS 4.0
+
+static void put_u64_le(unsigned char* p, unsigned long long v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (unsigned char)((v >> (8 * i)) & 0xFF);
+    }
+}
+
+// Build the current 80-byte header image. Layout:
+//    0  "RIFF"/"RF64"  u32 riff size (0xFFFFFFFF once RF64)  "WAVE"
+//   12  "JUNK"/"ds64"  u32 28  body: u64 riff, u64 data, u64 frames, u32 0
+//   48  "fmt "         u32 16  body: tag, channels, rate, byte rate,
+//                              block align, bits
+//   72  "data"         u32 data size (0xFFFFFFFF once RF64)
+static void capture_build_header(const MH_AudioWriter* w, unsigned char* hdr) {
+    unsigned int block_align = w->channels * (unsigned int)(w->bit_depth / 8);
+    unsigned long long riff_size = (CAPTURE_HEADER_SIZE - 8) + w->data_bytes +
+                                   (w->capture_padded ? 1 : 0);
+
+    memcpy(hdr + 0, w->is_rf64 ? "RF64" : "RIFF", 4);
+    put_u32_le(hdr + 4, w->is_rf64 ? 0xFFFFFFFFul : (unsigned long)riff_size);
+    memcpy(hdr + 8, "WAVE", 4);
+    memcpy(hdr + 12, w->is_rf64 ? "ds64" : "JUNK", 4);
+    put_u32_le(hdr + 16, 28);
+    memset(hdr + 20, 0, 28);
+    if (w->is_rf64) {
+        put_u64_le(hdr + 20, riff_size);
+        put_u64_le(hdr + 28, w->data_bytes);
+        put_u64_le(hdr + 36, w->frames_written);
+    }
+    memcpy(hdr + 48, "fmt ", 4);
+    put_u32_le(hdr + 52, 16);
+    put_u16_le(hdr + 56, w->bit_depth == 32 ? 3 : 1);  // IEEE float / PCM
+    put_u16_le(hdr + 58, w->channels);
+    put_u32_le(hdr + 60, w->sample_rate);
+    put_u32_le(hdr + 64, (unsigned long)w->sample_rate * block_align);
+    put_u16_le(hdr + 68, block_align);
+    put_u16_le(hdr + 70, (unsigned int)w->bit_depth);
+    memcpy(hdr + 72, "data", 4);
+    put_u32_le(hdr + 76,
+               w->is_rf64 ? 0xFFFFFFFFul : (unsigned long)w->data_bytes);
+}
+
+// Flush buffered samples, then rewrite the header region in place with
+// a positioned write that leaves the append stream untouched.
+static int capture_patch_header(MH_AudioWriter* w, char* err, size_t err_size) {
+    if (fflush(w->fp) != 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Write error");
+        return 0;
+    }
+    if (!w->is_rf64 && w->data_bytes > CAPTURE_DATA_SIZE_MAX) {
+        w->is_rf64 = 1;
+    }
+    unsigned char hdr[CAPTURE_HEADER_SIZE];
+    capture_build_header(w, hdr);
+#ifdef _WIN32
+    if (fseek(w->patch_fp, 0, SEEK_SET) != 0 ||
+        fwrite(hdr, 1, sizeof(hdr), w->patch_fp) != sizeof(hdr) ||
+        fflush(w->patch_fp) != 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Header patch failed");
         return 0;
     }
+#else
+    if (pwrite(fileno(w->fp), hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr)) {
+        if (err && err_size > 0) snprintf(err, err_size, "Header patch failed");
+        return 0;
+    }
+#endif
+    return 1;
+}
 
-    tflac_u32 frame_buf_size = tflac_size_frame(FLAC_BLOCKSIZE, channels, (tflac_u32)bit_depth);
-    void* frame_buf = malloc(frame_buf_size);
-    if (!frame_buf) {
-        free(mem);
+MH_AudioWriter* mh_audio_writer_open_capture(const char* path,
+                                             unsigned int channels,
+                                             unsigned int sample_rate,
+                                             int bit_depth,
+                                             double flush_interval_seconds,
+                                             char* err, size_t err_size) {
+    if (!path || channels == 0 || channels > 0xFFFF || sample_rate == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return NULL;
+    }
+    if (strcasecmp_ext(get_extension(path), ".wav") != 0) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Capture mode writes WAV only (got '%s')",
+                     get_extension(path));
+        return NULL;
+    }
+    if (bit_depth != 16 && bit_depth != 24 && bit_depth != 32) {
+        if (err && err_size > 0)
+            snprintf(err, err_size,
+                     "Unsupported bit depth: %d (use 16, 24, or 32)", bit_depth);
+        return NULL;
+    }
+
+    MH_AudioWriter* w = (MH_AudioWriter*)calloc(1, sizeof(MH_AudioWriter));
+    if (!w) {
         if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
-        return 0;
+        return NULL;
+    }
+    w->channels = channels;
+    w->sample_rate = sample_rate;
+    w->bit_depth = bit_depth;
+    dither_state_init(&w->dither);
+    w->capture_mode = 1;
+    switch (bit_depth) {
+        case 16: w->format = ma_format_s16; break;
+        case 24: w->format = ma_format_s24; break;
+        default: w->format = ma_format_f32; break;
     }
 
-    FILE* fp = fopen(path, "wb");
-    if (!fp) {
-        free(frame_buf);
-        free(mem);
-        if (err && err_size > 0) snprintf(err, err_size, "Failed to open file: %s", path);
-        return 0;
+    size_t path_len = strlen(path) + 1;
+    w->path = (char*)malloc(path_len);
+    if (!w->path) {
+        free(w);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
     }
+    memcpy(w->path, path, path_len);
 
-    // Write fLaC marker
-    const unsigned char flac_marker[4] = {'f', 'L', 'a', 'C'};
-    fwrite(flac_marker, 1, 4, fp);
+    if (flush_interval_seconds <= 0.0) {
+        flush_interval_seconds = CAPTURE_DEFAULT_FLUSH_SECONDS;
+    }
+    w->flush_interval_frames =
+        (unsigned long long)(flush_interval_seconds * sample_rate + 0.5);
+    if (w->flush_interval_frames == 0) w->flush_interval_frames = 1;
+    w->next_flush_frames = w->flush_interval_frames;
 
-    // Reserve space for STREAMINFO metadata block (4-byte header + 34-byte body = 38 bytes)
-    unsigned char streaminfo_placeholder[38];
-    memset(streaminfo_placeholder, 0, sizeof(streaminfo_placeholder));
-    fwrite(streaminfo_placeholder, 1, 38, fp);
+    w->fp = fopen(path, "wb");
+    if (!w->fp) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Failed to open file: %s", path);
+        free(w->path);
+        free(w);
+        return NULL;
+    }
 
-    // Allocate conversion buffer for one block of interleaved samples
-    size_t block_samples = (size_t)FLAC_BLOCKSIZE * channels;
-    void* conv_buf = NULL;
-    if (bit_depth == 16) {
-        conv_buf = malloc(block_samples * sizeof(tflac_s16));
-    } else {
-        conv_buf = malloc(block_samples * sizeof(tflac_s32));
+    // The initial header already describes a valid, empty WAV file.
+    unsigned char hdr[CAPTURE_HEADER_SIZE];
+    capture_build_header(w, hdr);
+    if (fwrite(hdr, 1, sizeof(hdr), w->fp) != sizeof(hdr) ||
+        fflush(w->fp) != 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Write error");
+        fclose(w->fp);
+        remove(path);
+        free(w->path);
+        free(w);
+        return NULL;
     }
-    if (!conv_buf) {
-        fclose(fp);
-        free(frame_buf);
-        free(mem);
-        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+
+#ifdef _WIN32
+    w->patch_fp = fopen(path, "r+b");
+    if (!w->patch_fp) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Failed to reopen file for header patching");
+        fclose(w->fp);
+        remove(path);
+        free(w->path);
+        free(w);
+        return NULL;
+    }
+#endif
+
+    return w;
+}
+
+int mh_audio_writer_flush(MH_AudioWriter* writer, char* err, size_t err_size) {
+    if (!writer || !writer->capture_mode) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Flush requires a capture-mode writer");
         return 0;
     }
+    if (writer->failed) {
+        if (err && err_size > 0) snprintf(err, err_size, "Writer is in error state");
+        return 0;
+    }
+    return capture_patch_header(writer, err, err_size);
+}
 
-    int ok = 1;
-    unsigned int pos = 0;
-    while (pos < frames) {
-        unsigned int block_frames = frames - pos;
-        if (block_frames > FLAC_BLOCKSIZE) block_frames = FLAC_BLOCKSIZE;
+// ---- Unbuffered (direct I/O) writer ----
+//
+// Same RF64-ready container as capture mode, but the sample stream
+// bypasses the page cache: everything (header included) flows through
+// an aligned staging buffer flushed in full 1 MiB O_DIRECT writes, so
+// a multi-gigabyte bounce cannot evict warm plugin binaries and sample
+// libraries from the node. The unaligned tail and the final header
+// patch happen at close, after O_DIRECT is dropped from the
+// descriptor (direct I/O accepts neither). POSIX only; macOS has no
+// O_DIRECT and uses F_NOCACHE, which needs no alignment.
+
+#ifndef _WIN32
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#define DIRECT_ALIGN 4096
+#define DIRECT_STAGE_SIZE (1024 * 1024)
+
+// write() until n bytes are down or an error stops us.
+static int direct_write_all(int fd, const unsigned char* p, size_t n,
+                            char* err, size_t err_size) {
+    while (n > 0) {
+        ssize_t got = write(fd, p, n);
+        if (got <= 0) {
+            if (err && err_size > 0) snprintf(err, err_size, "Write error");
+            return 0;
+        }
+        p += got;
+        n -= (size_t)got;
+    }
+    return 1;
+}
 
-        tflac_u32 used = 0;
-        int r;
-        ma_uint64 block_total = (ma_uint64)block_frames * channels;
-        const float* block_data = data + (size_t)pos * channels;
-
-        if (bit_depth == 16) {
-            tflac_s16* s16_buf = (tflac_s16*)conv_buf;
-            ma_pcm_f32_to_s16(s16_buf, block_data, block_total, ma_dither_mode_triangle);
-            r = tflac_encode_s16i(&t, block_frames, s16_buf, frame_buf, frame_buf_size, &used);
-        } else {
-            // 24-bit: scale f32 to s32 range for 24-bit (shift into upper bits)
-            tflac_s32* s32_buf = (tflac_s32*)conv_buf;
-            for (ma_uint64 i = 0; i < block_total; i++) {
-                float s = block_data[i];
-                // Clamp to [-1, 1)
-                if (s > 1.0f) s = 1.0f;
-                if (s < -1.0f) s = -1.0f;
-                // Scale to 24-bit range
-                double scaled = (double)s * 8388607.0;
-                tflac_s32 v = (tflac_s32)scaled;
-                if (v > 8388607) v = 8388607;
-                if (v < -8388607) v = -8388607;
-                s32_buf[i] = v;
+// Copy bytes into the staging buffer, flushing each full (and
+// therefore aligned) buffer straight to the descriptor.
+static int direct_stage_append(MH_AudioWriter* w, const void* data,
+                               size_t bytes, char* err, size_t err_size) {
+    const unsigned char* p = (const unsigned char*)data;
+    while (bytes > 0) {
+        size_t room = DIRECT_STAGE_SIZE - w->stage_used;
+        size_t take = bytes < room ? bytes : room;
+        memcpy(w->stage + w->stage_used, p, take);
+        w->stage_used += take;
+        p += take;
+        bytes -= take;
+        if (w->stage_used == DIRECT_STAGE_SIZE) {
+            if (!direct_write_all(w->direct_fd, w->stage, DIRECT_STAGE_SIZE,
+                                  err, err_size)) {
+                return 0;
             }
-            r = tflac_encode_s32i(&t, block_frames, s32_buf, frame_buf, frame_buf_size, &used);
+            w->stage_used = 0;
         }
+    }
+    return 1;
+}
 
-        if (r != 0) {
+#endif  // !_WIN32
+
+MH_AudioWriter* mh_audio_writer_open_unbuffered(const char* path,
+                                                unsigned int channels,
+                                                unsigned int sample_rate,
+                                                int bit_depth,
+                                                char* err, size_t err_size) {
+#ifdef _WIN32
+    // No direct-I/O support here; fall back to the standard writer.
+    return mh_audio_writer_open(path, channels, sample_rate, bit_depth,
+                                err, err_size);
+#else
+    if (!path || channels == 0 || channels > 0xFFFF || sample_rate == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return NULL;
+    }
+    if (strcasecmp_ext(get_extension(path), ".wav") != 0) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Unbuffered mode writes WAV only (got '%s')",
+                     get_extension(path));
+        return NULL;
+    }
+    if (bit_depth != 16 && bit_depth != 24 && bit_depth != 32) {
+        if (err && err_size > 0)
+            snprintf(err, err_size,
+                     "Unsupported bit depth: %d (use 16, 24, or 32)", bit_depth);
+        return NULL;
+    }
+
+    MH_AudioWriter* w = (MH_AudioWriter*)calloc(1, sizeof(MH_AudioWriter));
+    if (!w) {
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+    w->channels = channels;
+    w->sample_rate = sample_rate;
+    w->bit_depth = bit_depth;
+    dither_state_init(&w->dither);
+    w->unbuffered = 1;
+    w->direct_fd = -1;
+    switch (bit_depth) {
+        case 16: w->format = ma_format_s16; break;
+        case 24: w->format = ma_format_s24; break;
+        default: w->format = ma_format_f32; break;
+    }
+
+    size_t path_len = strlen(path) + 1;
+    w->path = (char*)malloc(path_len);
+    if (!w->path) {
+        free(w);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+    memcpy(w->path, path, path_len);
+
+    void* stage = NULL;
+    if (posix_memalign(&stage, DIRECT_ALIGN, DIRECT_STAGE_SIZE) != 0) {
+        free(w->path);
+        free(w);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+    w->stage = (unsigned char*)stage;
+
+#ifdef O_DIRECT
+    w->direct_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0666);
+    if (w->direct_fd >= 0) w->direct_active = 1;
+#endif
+    if (w->direct_fd < 0) {
+        // Filesystem without O_DIRECT (or macOS): plain descriptor,
+        // best-effort cache bypass via F_NOCACHE where it exists.
+        w->direct_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (w->direct_fd < 0) {
             if (err && err_size > 0)
-                snprintf(err, err_size, "FLAC encode error %d at frame %u", r, pos);
-            ok = 0;
-            break;
+                snprintf(err, err_size, "Failed to open file: %s", path);
+            free(w->stage);
+            free(w->path);
+            free(w);
+            return NULL;
         }
+#ifdef F_NOCACHE
+        fcntl(w->direct_fd, F_NOCACHE, 1);
+#endif
+    }
 
-        if (fwrite(frame_buf, 1, used, fp) != used) {
-            if (err && err_size > 0) snprintf(err, err_size, "Write error");
-            ok = 0;
-            break;
+    // The header travels through the staging buffer like everything
+    // else, keeping every direct write buffer- and offset-aligned. It
+    // is patched with real sizes once at close.
+    unsigned char hdr[CAPTURE_HEADER_SIZE];
+    capture_build_header(w, hdr);
+    if (!direct_stage_append(w, hdr, sizeof(hdr), err, err_size)) {
+        close(w->direct_fd);
+        remove(path);
+        free(w->stage);
+        free(w->path);
+        free(w);
+        return NULL;
+    }
+    return w;
+#endif  // _WIN32
+}
+
+int mh_audio_writer_set_dither(MH_AudioWriter* writer, int mode) {
+    if (!writer) return 0;
+    if (mode != MH_DITHER_TPDF && mode != MH_DITHER_NONE &&
+        mode != MH_DITHER_SHAPED) {
+        return 0;
+    }
+    if (mode == MH_DITHER_SHAPED && !writer->dither.e1) {
+        float* e1 = (float*)calloc(writer->channels, sizeof(float));
+        float* e2 = (float*)calloc(writer->channels, sizeof(float));
+        if (!e1 || !e2) {
+            free(e1);
+            free(e2);
+            return 0;
         }
+        writer->dither.e1 = e1;
+        writer->dither.e2 = e2;
+    }
+    writer->dither.mode = mode;
+    return 1;
+}
 
-        pos += block_frames;
+int mh_audio_writer_write(MH_AudioWriter* writer, const float* interleaved,
+                          unsigned int frames, char* err, size_t err_size) {
+    if (!writer || (!interleaved && frames > 0)) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return 0;
+    }
+    if (writer->failed) {
+        if (err && err_size > 0) snprintf(err, err_size, "Writer is in error state");
+        return 0;
     }
+    if (frames == 0) return 1;
+
+    unsigned int channels = writer->channels;
+
+    if (!writer->is_flac) {
+        ma_uint64 total_samples = (ma_uint64)frames * channels;
+        const void* src = interleaved;
+
+        if (writer->format != ma_format_f32) {
+            size_t bytes_per_sample = ma_get_bytes_per_sample(writer->format);
+            if (writer->wav_conv_cap < total_samples) {
+                void* grown = realloc(writer->wav_conv, total_samples * bytes_per_sample);
+                if (!grown) {
+                    if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+                    writer->failed = 1;
+                    return 0;
+                }
+                writer->wav_conv = grown;
+                writer->wav_conv_cap = total_samples;
+            }
+            if (writer->format == ma_format_s16) {
+                if (writer->dither.mode == MH_DITHER_SHAPED)
+                    dither_shaped_f32_to_s16(&writer->dither,
+                                             (ma_int16*)writer->wav_conv,
+                                             interleaved, frames, channels);
+                else
+                    ma_pcm_f32_to_s16(writer->wav_conv, interleaved, total_samples,
+                                      dither_to_ma(writer->dither.mode));
+            } else {
+                if (writer->dither.mode == MH_DITHER_SHAPED)
+                    dither_shaped_f32_to_s24(&writer->dither,
+                                             (unsigned char*)writer->wav_conv,
+                                             interleaved, frames, channels);
+                else
+                    ma_pcm_f32_to_s24(writer->wav_conv, interleaved, total_samples,
+                                      dither_to_ma(writer->dither.mode));
+            }
+            src = writer->wav_conv;
+        }
 
-    if (ok) {
-        tflac_finalize(&t);
+#ifndef _WIN32
+        if (writer->unbuffered) {
+            size_t bytes = (size_t)total_samples *
+                           ma_get_bytes_per_sample(writer->format);
+            if (!direct_stage_append(writer, src, bytes, err, err_size)) {
+                writer->failed = 1;
+                return 0;
+            }
+            writer->data_bytes += bytes;
+            writer->frames_written += frames;
+            return 1;
+        }
+#endif
+
+        if (writer->capture_mode) {
+            size_t bytes = (size_t)total_samples *
+                           ma_get_bytes_per_sample(writer->format);
+            if (fwrite(src, 1, bytes, writer->fp) != bytes) {
+                if (err && err_size > 0) snprintf(err, err_size, "Write error");
+                writer->failed = 1;
+                return 0;
+            }
+            writer->data_bytes += bytes;
+            writer->frames_written += frames;
+            if (writer->frames_written >= writer->next_flush_frames) {
+                if (!capture_patch_header(writer, err, err_size)) {
+                    writer->failed = 1;
+                    return 0;
+                }
+                while (writer->next_flush_frames <= writer->frames_written) {
+                    writer->next_flush_frames += writer->flush_interval_frames;
+                }
+            }
+            return 1;
+        }
 
-        // Encode final STREAMINFO
-        // tflac's bitwriter always writes a full tflac_uint (8 bytes on
-        // 64-bit) at the current position, even when only a few logical
-        // bytes remain.  Add 8 bytes of padding so the final flush does
-        // not overwrite past the buffer (detected by MSVC /GS on Windows).
-        unsigned char si_buf[38 + 8];
-        tflac_u32 si_used = 0;
-        // lastflag=1 means this is the last metadata block
-        if (tflac_encode_streaminfo(&t, 1, si_buf, sizeof(si_buf), &si_used) != 0) {
-            if (err && err_size > 0) snprintf(err, err_size, "Failed to encode STREAMINFO");
-            ok = 0;
-        } else {
-            // Seek back and overwrite STREAMINFO
-            fseek(fp, 4, SEEK_SET);
-            fwrite(si_buf, 1, si_used, fp);
+        ma_uint64 written = 0;
+        ma_result result = ma_encoder_write_pcm_frames(&writer->encoder, src, frames, &written);
+        if (result != MA_SUCCESS) {
+            if (err && err_size > 0) {
+                snprintf(err, err_size, "Failed to write audio data (error %d)", result);
+            }
+            writer->failed = 1;
+            return 0;
         }
+        writer->frames_written += frames;
+        return 1;
     }
 
-    fclose(fp);
-    free(conv_buf);
-    free(frame_buf);
-    free(mem);
-
-    if (!ok) {
-        remove(path);
+    // FLAC: accumulate into fixed FLAC_BLOCKSIZE frames; full blocks that
+    // arrive aligned are encoded straight from the caller's buffer.
+    while (frames > 0) {
+        if (writer->carry_frames == 0 && frames >= FLAC_BLOCKSIZE) {
+            if (!writer_flac_encode_block(writer, interleaved, FLAC_BLOCKSIZE, err, err_size)) {
+                writer->failed = 1;
+                return 0;
+            }
+            interleaved += (size_t)FLAC_BLOCKSIZE * channels;
+            frames -= FLAC_BLOCKSIZE;
+            writer->frames_written += FLAC_BLOCKSIZE;
+        } else {
+            unsigned int take = FLAC_BLOCKSIZE - writer->carry_frames;
+            if (take > frames) take = frames;
+            memcpy(writer->carry + (size_t)writer->carry_frames * channels,
+                   interleaved, (size_t)take * channels * sizeof(float));
+            writer->carry_frames += take;
+            interleaved += (size_t)take * channels;
+            frames -= take;
+            writer->frames_written += take;
+            if (writer->carry_frames == FLAC_BLOCKSIZE) {
+                if (!writer_flac_encode_block(writer, writer->carry, FLAC_BLOCKSIZE, err, err_size)) {
+                    writer->failed = 1;
+                    return 0;
+                }
+                writer->carry_frames = 0;
+            }
+        }
     }
-
-    return ok;
+    return 1;
 }
 
-static const char* get_extension(const char* path) {
-    const char* dot = strrchr(path, '.');
-    return dot ? dot : "";
+unsigned long long mh_audio_writer_frames_written(const MH_AudioWriter* writer) {
+    return writer ? writer->frames_written : 0;
 }
 
-static int strcasecmp_ext(const char* a, const char* b) {
-    while (*a && *b) {
-        char ca = *a >= 'A' && *a <= 'Z' ? *a + 32 : *a;
-        char cb = *b >= 'A' && *b <= 'Z' ? *b + 32 : *b;
+int mh_audio_writer_close(MH_AudioWriter* writer, char* err, size_t err_size) {
+    if (!writer) return 0;
+
+    int ok = !writer->failed;
+
+#ifndef _WIN32
+    if (writer->unbuffered) {
+        if (ok && (writer->data_bytes & 1)) {
+            // Pad the data chunk to an even byte count (RIFF requires it).
+            unsigned char pad = 0;
+            if (direct_stage_append(writer, &pad, 1, err, err_size)) {
+                writer->capture_padded = 1;
+            } else {
+                ok = 0;
+            }
+        }
+
+        // Flush what is still aligned with direct I/O, then drop
+        // O_DIRECT from the descriptor for the unaligned tail and the
+        // header patch (neither satisfies its constraints).
+        size_t aligned = writer->stage_used & ~((size_t)DIRECT_ALIGN - 1);
+        if (ok && aligned > 0 &&
+            !direct_write_all(writer->direct_fd, writer->stage, aligned,
+                              err, err_size)) {
+            ok = 0;
+        }
+#ifdef O_DIRECT
+        if (writer->direct_active) {
+            int fl = fcntl(writer->direct_fd, F_GETFL);
+            if (fl >= 0) fcntl(writer->direct_fd, F_SETFL, fl & ~O_DIRECT);
+        }
+#endif
+        if (ok && aligned < writer->stage_used &&
+            !direct_write_all(writer->direct_fd, writer->stage + aligned,
+                              writer->stage_used - aligned, err, err_size)) {
+            ok = 0;
+        }
+        if (ok) {
+            if (!writer->is_rf64 && writer->data_bytes > CAPTURE_DATA_SIZE_MAX) {
+                writer->is_rf64 = 1;
+            }
+            unsigned char hdr[CAPTURE_HEADER_SIZE];
+            capture_build_header(writer, hdr);
+            if (pwrite(writer->direct_fd, hdr, sizeof(hdr), 0) !=
+                (ssize_t)sizeof(hdr)) {
+                if (err && err_size > 0)
+                    snprintf(err, err_size, "Header patch failed");
+                ok = 0;
+            }
+        }
+        close(writer->direct_fd);
+        free(writer->stage);
+        free(writer->wav_conv);
+        free(writer->dither.e1);
+        free(writer->dither.e2);
+        free(writer->path);
+        free(writer);
+        return ok;
+    }
+#endif
+
+    if (writer->capture_mode) {
+        // Pad the data chunk to an even byte count (RIFF requires it),
+        // then patch the header one last time -- even after a write
+        // error, so whatever reached disk stays readable. Capture files
+        // are never removed.
+        if (ok && (writer->data_bytes & 1)) {
+            if (fputc(0, writer->fp) == EOF) ok = 0;
+            else writer->capture_padded = 1;
+        }
+        if (!capture_patch_header(writer, ok ? err : NULL, ok ? err_size : 0)) {
+            ok = 0;
+        }
+        fclose(writer->fp);
+#ifdef _WIN32
+        fclose(writer->patch_fp);
+#endif
+        free(writer->wav_conv);
+    } else if (!writer->is_flac) {
+        ma_encoder_uninit(&writer->encoder);
+        free(writer->wav_conv);
+    } else {
+        // Flush the trailing partial block (FLAC allows a short last frame).
+        if (ok && writer->carry_frames > 0) {
+            if (!writer_flac_encode_block(writer, writer->carry, writer->carry_frames, err, err_size)) {
+                ok = 0;
+            }
+            writer->carry_frames = 0;
+        }
+
+        if (ok) {
+            tflac_finalize(&writer->t);
+
+            // Encode final STREAMINFO
+            // tflac's bitwriter always writes a full tflac_uint (8 bytes on
+            // 64-bit) at the current position, even when only a few logical
+            // bytes remain.  Add 8 bytes of padding so the final flush does
+            // not overwrite past the buffer (detected by MSVC /GS on Windows).
+            unsigned char si_buf[38 + 8];
+            tflac_u32 si_used = 0;
+            // lastflag=1 means this is the last metadata block
+            if (tflac_encode_streaminfo(&writer->t, 1, si_buf, sizeof(si_buf), &si_used) != 0) {
+                if (err && err_size > 0) snprintf(err, err_size, "Failed to encode STREAMINFO");
+                ok = 0;
+            } else {
+                // Seek back and overwrite STREAMINFO
+                fseek(writer->fp, 4, SEEK_SET);
+                fwrite(si_buf, 1, si_used, writer->fp);
+            }
+        }
+
+        fclose(writer->fp);
+        if (!ok) {
+            remove(writer->path);
+        }
+        free(writer->carry);
+        free(writer->flac_conv);
+        free(writer->frame_buf);
+        free(writer->mem);
+    }
+
+    free(writer->dither.e1);
+    free(writer->dither.e2);
+    free(writer->path);
+    free(writer);
+    return ok;
+}
+
+// One-shot write over the streaming writer.
+static int write_via_writer(const char* path, const float* data,
+                            unsigned int channels, unsigned int frames,
+                            unsigned int sample_rate, int bit_depth,
+                            char* err, size_t err_size) {
+    MH_AudioWriter* w = mh_audio_writer_open(path, channels, sample_rate,
+                                             bit_depth, err, err_size);
+    if (!w) return 0;
+    int ok = mh_audio_writer_write(w, data, frames, err, err_size);
+    // On write failure keep the first error message; close still finalizes
+    // or removes the file as appropriate.
+    if (!mh_audio_writer_close(w, ok ? err : NULL, ok ? err_size : 0)) ok = 0;
+    return ok;
+}
+
+// ---- Frame-parallel FLAC encode ----
+//
+// FLAC frames are self-contained (fixed blocksize, per-frame CRCs, frame
+// number in the header), so disjoint runs of blocks can be encoded by
+// independent tflac instances and the resulting byte runs concatenated in
+// order. Each worker starts its instance's frameno at its run's first
+// block index; min/max frame sizes are merged across workers for the
+// STREAMINFO. The one casualty is the STREAMINFO MD5, which is defined
+// over the whole decoded stream in order -- parallel output leaves it
+// zeroed, which the spec defines as "unset".
+
+#ifndef _WIN32
+#include <pthread.h>
+
+typedef struct {
+    const float* data;          // full interleaved input
+    unsigned int channels;
+    unsigned int sample_rate;
+    int bit_depth;
+    unsigned int frames_total;
+    unsigned int start_block;   // [start_block, end_block) of FLAC_BLOCKSIZE runs
+    unsigned int end_block;
+    unsigned char* out;         // encoded bytes for this run (grown as needed)
+    size_t out_len;
+    size_t out_cap;
+    tflac t;
+    int ok;
+    char errmsg[128];
+} flac_mt_job;
+
+static int flac_mt_append(flac_mt_job* job, const void* bytes, size_t n) {
+    if (job->out_len + n > job->out_cap) {
+        size_t grown = job->out_cap ? job->out_cap * 2 : 65536;
+        while (grown < job->out_len + n) grown *= 2;
+        unsigned char* p = (unsigned char*)realloc(job->out, grown);
+        if (!p) return 0;
+        job->out = p;
+        job->out_cap = grown;
+    }
+    memcpy(job->out + job->out_len, bytes, n);
+    job->out_len += n;
+    return 1;
+}
+
+static void* flac_mt_worker(void* arg) {
+    flac_mt_job* job = (flac_mt_job*)arg;
+    unsigned int channels = job->channels;
+
+    tflac_init(&job->t);
+    job->t.blocksize = FLAC_BLOCKSIZE;
+    job->t.samplerate = job->sample_rate;
+    job->t.channels = channels;
+    job->t.bitdepth = (tflac_u32)job->bit_depth;
+    job->t.enable_md5 = 0;       // MD5 is inherently serial; see note above
+    job->t.frameno = job->start_block;
+
+    tflac_u32 mem_size = tflac_size_memory(FLAC_BLOCKSIZE);
+    tflac_u32 frame_buf_size = tflac_size_frame(FLAC_BLOCKSIZE, channels, (tflac_u32)job->bit_depth);
+    size_t block_samples = (size_t)FLAC_BLOCKSIZE * channels;
+
+    void* mem = malloc(mem_size);
+    void* frame_buf = malloc(frame_buf_size);
+    void* conv = malloc(block_samples *
+                        (job->bit_depth == 16 ? sizeof(tflac_s16) : sizeof(tflac_s32)));
+    if (!mem || !frame_buf || !conv) {
+        snprintf(job->errmsg, sizeof(job->errmsg), "Out of memory");
+        goto done;
+    }
+
+    if (tflac_validate(&job->t, mem, mem_size) != 0) {
+        snprintf(job->errmsg, sizeof(job->errmsg), "tflac_validate failed");
+        goto done;
+    }
+
+    // Per-worker TPDF state, seeded by the run so output is stable for
+    // a given thread split.
+    dither_state ds;
+    dither_state_init(&ds);
+    ds.rng ^= job->start_block + 1;
+
+    for (unsigned int b = job->start_block; b < job->end_block; b++) {
+        unsigned int pos = b * FLAC_BLOCKSIZE;
+        unsigned int block_frames = job->frames_total - pos;
+        if (block_frames > FLAC_BLOCKSIZE) block_frames = FLAC_BLOCKSIZE;
+
+        tflac_u32 used = 0;
+        int r = flac_convert_and_encode(&job->t, job->data + (size_t)pos * channels,
+                                        block_frames, channels, job->bit_depth,
+                                        conv, &ds, frame_buf, frame_buf_size, &used);
+        if (r != 0) {
+            snprintf(job->errmsg, sizeof(job->errmsg),
+                     "FLAC encode error %d at frame %u", r, pos);
+            goto done;
+        }
+        if (!flac_mt_append(job, frame_buf, used)) {
+            snprintf(job->errmsg, sizeof(job->errmsg), "Out of memory");
+            goto done;
+        }
+    }
+    job->ok = 1;
+
+done:
+    free(conv);
+    free(frame_buf);
+    free(mem);
+    return NULL;
+}
+#endif  // !_WIN32
+
+int mh_audio_write_flac_mt(const char* path, const float* data,
+                           unsigned int channels, unsigned int frames,
+                           unsigned int sample_rate, int bit_depth,
+                           int num_threads,
+                           char* err, size_t err_size) {
+    if (!path || !data || channels == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return 0;
+    }
+    if (bit_depth != 16 && bit_depth != 24) {
+        if (err && err_size > 0)
+            snprintf(err, err_size,
+                     "FLAC does not support %d-bit; use 16 or 24", bit_depth);
+        return 0;
+    }
+
+    unsigned int nblocks = (frames + FLAC_BLOCKSIZE - 1) / FLAC_BLOCKSIZE;
+    if (num_threads > 64) num_threads = 64;
+    if ((unsigned int)num_threads > nblocks) num_threads = (int)nblocks;
+
+#ifdef _WIN32
+    num_threads = 1;
+#endif
+
+    // Serial fallback also keeps the MD5 populated.
+    if (num_threads <= 1) {
+        return write_via_writer(path, data, channels, frames, sample_rate,
+                                bit_depth, err, err_size);
+    }
+
+#ifndef _WIN32
+    flac_mt_job* jobs = (flac_mt_job*)calloc((size_t)num_threads, sizeof(flac_mt_job));
+    pthread_t* threads = (pthread_t*)calloc((size_t)num_threads, sizeof(pthread_t));
+    if (!jobs || !threads) {
+        free(jobs);
+        free(threads);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return 0;
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        jobs[i].data = data;
+        jobs[i].channels = channels;
+        jobs[i].sample_rate = sample_rate;
+        jobs[i].bit_depth = bit_depth;
+        jobs[i].frames_total = frames;
+        jobs[i].start_block = (unsigned int)((unsigned long long)nblocks * i / num_threads);
+        jobs[i].end_block = (unsigned int)((unsigned long long)nblocks * (i + 1) / num_threads);
+    }
+
+    int spawned = 0;
+    int ok = 1;
+    for (; spawned < num_threads; spawned++) {
+        if (pthread_create(&threads[spawned], NULL, flac_mt_worker, &jobs[spawned]) != 0) {
+            ok = 0;
+            if (err && err_size > 0) snprintf(err, err_size, "Failed to spawn encoder thread");
+            break;
+        }
+    }
+    for (int i = 0; i < spawned; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (ok) {
+        for (int i = 0; i < num_threads; i++) {
+            if (!jobs[i].ok) {
+                if (err && err_size > 0) snprintf(err, err_size, "%s", jobs[i].errmsg);
+                ok = 0;
+                break;
+            }
+        }
+    }
+
+    FILE* fp = NULL;
+    if (ok) {
+        fp = fopen(path, "wb");
+        if (!fp) {
+            if (err && err_size > 0) snprintf(err, err_size, "Failed to open file: %s", path);
+            ok = 0;
+        }
+    }
+
+    if (ok) {
+        // Merge per-run stats into job 0's instance for the STREAMINFO.
+        tflac* si = &jobs[0].t;
+        si->samplecount = frames;
+        for (int i = 1; i < num_threads; i++) {
+            tflac* t = &jobs[i].t;
+            if (t->min_frame_size &&
+                (si->min_frame_size == 0 || t->min_frame_size < si->min_frame_size))
+                si->min_frame_size = t->min_frame_size;
+            if (t->max_frame_size > si->max_frame_size)
+                si->max_frame_size = t->max_frame_size;
+        }
+
+        // Same bitwriter padding note as the streaming writer's close.
+        unsigned char si_buf[38 + 8];
+        tflac_u32 si_used = 0;
+        const unsigned char flac_marker[4] = {'f', 'L', 'a', 'C'};
+        if (tflac_encode_streaminfo(si, 1, si_buf, sizeof(si_buf), &si_used) != 0) {
+            if (err && err_size > 0) snprintf(err, err_size, "Failed to encode STREAMINFO");
+            ok = 0;
+        } else if (fwrite(flac_marker, 1, 4, fp) != 4 ||
+                   fwrite(si_buf, 1, si_used, fp) != si_used) {
+            if (err && err_size > 0) snprintf(err, err_size, "Write error");
+            ok = 0;
+        } else {
+            for (int i = 0; i < num_threads; i++) {
+                if (fwrite(jobs[i].out, 1, jobs[i].out_len, fp) != jobs[i].out_len) {
+                    if (err && err_size > 0) snprintf(err, err_size, "Write error");
+                    ok = 0;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (fp) {
+        fclose(fp);
+        if (!ok) remove(path);
+    }
+    for (int i = 0; i < num_threads; i++) {
+        free(jobs[i].out);
+    }
+    free(jobs);
+    free(threads);
+    return ok;
+#else
+    return 0;  // unreachable: num_threads forced to 1 above
+#endif
+}
+
+static const char* get_extension(const char* path) {
+    const char* dot = strrchr(path, '.');
+    return dot ? dot : "";
+}
+
+static int strcasecmp_ext(const char* a, const char* b) {
+    while (*a && *b) {
+        char ca = *a >= 'A' && *a <= 'Z' ? *a + 32 : *a;
+        char cb = *b >= 'A' && *b <= 'Z' ? *b + 32 : *b;
         if (ca != cb) return ca - cb;
         a++; b++;
     }
     return (unsigned char)*a - (unsigned char)*b;
 }
 
-// ---- BWF (Broadcast Wave Format) bext chunk ----
+// ---- BWF (Broadcast Wave Format) bext chunk ----
+
+// Copy a source string into a fixed-size, null-padded destination field,
+// truncating if longer (BWF fields are fixed width). NULL source => all zeros.
+static void bwf_copy_field(unsigned char* dst, size_t field_size, const char* src) {
+    memset(dst, 0, field_size);
+    if (!src) return;
+    size_t n = strlen(src);
+    if (n > field_size) n = field_size;
+    memcpy(dst, src, n);
+}
+
+static void put_u16_le(unsigned char* p, unsigned int v) {
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)((v >> 8) & 0xFF);
+}
+
+static void put_u32_le(unsigned char* p, unsigned long v) {
+    p[0] = (unsigned char)(v & 0xFFUL);
+    p[1] = (unsigned char)((v >> 8) & 0xFFUL);
+    p[2] = (unsigned char)((v >> 16) & 0xFFUL);
+    p[3] = (unsigned char)((v >> 24) & 0xFFUL);
+}
+
+static unsigned long get_u32_le(const unsigned char* p) {
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) |
+           ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+// EBU Tech 3285 fixed-size portion of the bext chunk (no coding history).
+#define BWF_BEXT_FIXED_SIZE 602
+
+// Append a BWF `bext` chunk to an existing, finalized WAV file and fix up the
+// RIFF chunk size. The chunk is written after the data chunk; compliant WAV
+// readers (including miniaudio) locate chunks by scanning, so ordering does
+// not matter. Returns 1 on success, 0 on error.
+static int append_bext_chunk(const char* path, const MH_BwfMetadata* bwf,
+                             char* err, size_t err_size) {
+    unsigned char bext[BWF_BEXT_FIXED_SIZE];
+    memset(bext, 0, sizeof(bext));
+    // Field offsets per EBU Tech 3285.
+    bwf_copy_field(bext + 0,   256, bwf->description);
+    bwf_copy_field(bext + 256, 32,  bwf->originator);
+    bwf_copy_field(bext + 288, 32,  bwf->originator_reference);
+    bwf_copy_field(bext + 320, 10,  bwf->origination_date);
+    bwf_copy_field(bext + 330, 8,   bwf->origination_time);
+    put_u32_le(bext + 338, (unsigned long)(bwf->time_reference & 0xFFFFFFFFULL));
+    put_u32_le(bext + 342, (unsigned long)((bwf->time_reference >> 32) & 0xFFFFFFFFULL));
+    put_u16_le(bext + 346, 1);  // Version = 1
+    // UMID (348..411), loudness values (412..421) and Reserved (422..601)
+    // remain zero-filled.
+
+    FILE* f = fopen(path, "r+b");
+    if (!f) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Failed to reopen WAV for BWF metadata: %s", path);
+        return 0;
+    }
+
+    unsigned char sizebuf[4];
+    if (fseek(f, 4, SEEK_SET) != 0 || fread(sizebuf, 1, 4, f) != 4) {
+        fclose(f);
+        if (err && err_size > 0) snprintf(err, err_size, "Failed to read RIFF header");
+        return 0;
+    }
+    unsigned long riff_size = get_u32_le(sizebuf);
+
+    unsigned char hdr[8];
+    memcpy(hdr, "bext", 4);
+    put_u32_le(hdr + 4, (unsigned long)BWF_BEXT_FIXED_SIZE);
+
+    if (fseek(f, 0, SEEK_END) != 0 ||
+        fwrite(hdr, 1, 8, f) != 8 ||
+        fwrite(bext, 1, BWF_BEXT_FIXED_SIZE, f) != BWF_BEXT_FIXED_SIZE) {
+        fclose(f);
+        if (err && err_size > 0) snprintf(err, err_size, "Failed to append bext chunk");
+        return 0;
+    }
+
+    // The chunk added 8 (header) + 602 (payload) bytes; 602 is even so no pad
+    // byte is required. Grow the RIFF size by the same amount.
+    unsigned long new_size = riff_size + 8 + BWF_BEXT_FIXED_SIZE;
+    put_u32_le(sizebuf, new_size);
+    if (fseek(f, 4, SEEK_SET) != 0 || fwrite(sizebuf, 1, 4, f) != 4) {
+        fclose(f);
+        if (err && err_size > 0) snprintf(err, err_size, "Failed to update RIFF size");
+        return 0;
+    }
+
+    fclose(f);
+    return 1;
+}
+
+int mh_audio_write_bwf(const char* path, const float* data,
+                       unsigned int channels, unsigned int frames,
+                       unsigned int sample_rate, int bit_depth,
+                       const MH_BwfMetadata* bwf,
+                       char* err, size_t err_size) {
+    if (!path || !data) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return 0;
+    }
+
+    const char* ext = get_extension(path);
+    int is_wav = (strcasecmp_ext(ext, ".wav") == 0);
+
+    if (bwf && !is_wav) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "BWF metadata is only supported for WAV output");
+        return 0;
+    }
+
+    if (!write_via_writer(path, data, channels, frames, sample_rate, bit_depth, err, err_size))
+        return 0;
+    if (is_wav && bwf && !append_bext_chunk(path, bwf, err, err_size)) {
+        remove(path);
+        return 0;
+    }
+    return 1;
+}
+
+int mh_audio_write(const char* path, const float* data,
+                   unsigned int channels, unsigned int frames,
+                   unsigned int sample_rate, int bit_depth,
+                   char* err, size_t err_size) {
+    return mh_audio_write_bwf(path, data, channels, frames, sample_rate,
+                              bit_depth, NULL, err, err_size);
+}
+
+// Frames interleaved per chunk on the planar write path. Bounds the
+// staging buffer (32 KiB for stereo) independent of file length.
+#define WRITE_PLANAR_CHUNK_FRAMES 4096
+
+int mh_audio_write_planar_opts(const char* path, const float* const* channel_data,
+                               unsigned int channels, unsigned int frames,
+                               unsigned int sample_rate, int bit_depth,
+                               int dither_mode, const MH_BwfMetadata* bwf,
+                               char* err, size_t err_size) {
+    if (!path || !channel_data || channels == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return 0;
+    }
+
+    const char* ext = get_extension(path);
+    int is_wav = (strcasecmp_ext(ext, ".wav") == 0);
+
+    if (bwf && !is_wav) {
+        if (err && err_size > 0)
+            snprintf(err, err_size, "BWF metadata is only supported for WAV output");
+        return 0;
+    }
+
+    MH_AudioWriter* w = mh_audio_writer_open(path, channels, sample_rate,
+                                             bit_depth, err, err_size);
+    if (!w) return 0;
+    if (!mh_audio_writer_set_dither(w, dither_mode)) {
+        mh_audio_writer_close(w, NULL, 0);
+        remove(path);
+        if (err && err_size > 0)
+            snprintf(err, err_size, "Invalid dither mode: %d", dither_mode);
+        return 0;
+    }
+
+    float* scratch = (float*)malloc((size_t)WRITE_PLANAR_CHUNK_FRAMES * channels * sizeof(float));
+    const float** chans = (const float**)malloc(channels * sizeof(const float*));
+    if (!scratch || !chans) {
+        free(chans);
+        free(scratch);
+        mh_audio_writer_close(w, NULL, 0);
+        remove(path);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return 0;
+    }
+
+    int ok = 1;
+    unsigned int done = 0;
+    while (done < frames) {
+        unsigned int n = frames - done;
+        if (n > WRITE_PLANAR_CHUNK_FRAMES) n = WRITE_PLANAR_CHUNK_FRAMES;
+        for (unsigned int c = 0; c < channels; c++) {
+            chans[c] = channel_data[c] + done;
+        }
+        mh_audio_interleave(chans, scratch, channels, n);
+        if (!mh_audio_writer_write(w, scratch, n, err, err_size)) {
+            ok = 0;
+            break;
+        }
+        done += n;
+    }
+    free(chans);
+    free(scratch);
+
+    // On write failure keep the first error message; close still finalizes
+    // or removes the file as appropriate.
+    if (!mh_audio_writer_close(w, ok ? err : NULL, ok ? err_size : 0)) ok = 0;
+    if (!ok) return 0;
+
+    if (is_wav && bwf && !append_bext_chunk(path, bwf, err, err_size)) {
+        remove(path);
+        return 0;
+    }
+    return 1;
+}
+
+int mh_audio_write_planar_bwf(const char* path, const float* const* channel_data,
+                              unsigned int channels, unsigned int frames,
+                              unsigned int sample_rate, int bit_depth,
+                              const MH_BwfMetadata* bwf,
+                              char* err, size_t err_size) {
+    return mh_audio_write_planar_opts(path, channel_data, channels, frames,
+                                      sample_rate, bit_depth, MH_DITHER_TPDF,
+                                      bwf, err, err_size);
+}
+
+int mh_audio_write_planar(const char* path, const float* const* channel_data,
+                          unsigned int channels, unsigned int frames,
+                          unsigned int sample_rate, int bit_depth,
+                          char* err, size_t err_size) {
+    return mh_audio_write_planar_bwf(path, channel_data, channels, frames,
+                                     sample_rate, bit_depth, NULL, err, err_size);
+}
+
+// ---- Streaming reader ----
+
+// Frames decoded per internal pull. Keeps the scratch buffer small
+// (16 KiB for stereo) while amortizing per-call decoder overhead.
+#define READER_CHUNK_FRAMES 2048
+
+struct MH_AudioReader {
+    ma_decoder decoder;
+    unsigned int channels;
+    unsigned int sample_rate;
+    unsigned long long frames;  // 0 if the format can't report a length
+    float* scratch;             // interleaved [READER_CHUNK_FRAMES * channels]
+};
+
+MH_AudioReader* mh_audio_reader_open(const char* path, char* err, size_t err_size) {
+    if (!path) {
+        if (err && err_size > 0) snprintf(err, err_size, "Path is NULL");
+        return NULL;
+    }
+
+    MH_AudioReader* reader = (MH_AudioReader*)calloc(1, sizeof(MH_AudioReader));
+    if (!reader) {
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+
+    ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
+    ma_result result = ma_decoder_init_file(path, &config, &reader->decoder);
+    if (result != MA_SUCCESS) {
+        if (err && err_size > 0) {
+            snprintf(err, err_size, "Failed to open audio file: %s (error %d)", path, result);
+        }
+        free(reader);
+        return NULL;
+    }
+
+    reader->channels = reader->decoder.outputChannels;
+    reader->sample_rate = reader->decoder.outputSampleRate;
+
+    ma_uint64 length = 0;
+    if (ma_decoder_get_length_in_pcm_frames(&reader->decoder, &length) == MA_SUCCESS) {
+        reader->frames = (unsigned long long)length;
+    }
+
+    reader->scratch = (float*)malloc(sizeof(float) * READER_CHUNK_FRAMES * reader->channels);
+    if (!reader->scratch) {
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        ma_decoder_uninit(&reader->decoder);
+        free(reader);
+        return NULL;
+    }
+
+    return reader;
+}
+
+void mh_audio_reader_close(MH_AudioReader* reader) {
+    if (!reader) return;
+    ma_decoder_uninit(&reader->decoder);
+    free(reader->scratch);
+    free(reader);
+}
 
-// Copy a source string into a fixed-size, null-padded destination field,
-// truncating if longer (BWF fields are fixed width). NULL source => all zeros.
-static void bwf_copy_field(unsigned char* dst, size_t field_size, const char* src) {
-    memset(dst, 0, field_size);
-    if (!src) return;
-    size_t n = strlen(src);
-    if (n > field_size) n = field_size;
-    memcpy(dst, src, n);
+unsigned int mh_audio_reader_channels(const MH_AudioReader* reader) {
+    return reader ? reader->channels : 0;
 }
 
-static void put_u16_le(unsigned char* p, unsigned int v) {
-    p[0] = (unsigned char)(v & 0xFF);
-    p[1] = (unsigned char)((v >> 8) & 0xFF);
+unsigned int mh_audio_reader_sample_rate(const MH_AudioReader* reader) {
+    return reader ? reader->sample_rate : 0;
 }
 
-static void put_u32_le(unsigned char* p, unsigned long v) {
-    p[0] = (unsigned char)(v & 0xFFUL);
-    p[1] = (unsigned char)((v >> 8) & 0xFFUL);
-    p[2] = (unsigned char)((v >> 16) & 0xFFUL);
-    p[3] = (unsigned char)((v >> 24) & 0xFFUL);
+unsigned long long mh_audio_reader_frames(const MH_AudioReader* reader) {
+    return reader ? reader->frames : 0;
 }
 
-static unsigned long get_u32_le(const unsigned char* p) {
-    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) |
-           ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+long long mh_audio_reader_read(MH_AudioReader* reader,
+                               float* const* dst, unsigned int nframes) {
+    if (!reader || !dst) return -1;
+
+    unsigned int ch = reader->channels;
+    unsigned long long total = 0;
+
+    while (total < nframes) {
+        unsigned long long want = nframes - total;
+        if (want > READER_CHUNK_FRAMES) want = READER_CHUNK_FRAMES;
+
+        ma_uint64 got = 0;
+        ma_result result = ma_decoder_read_pcm_frames(&reader->decoder,
+                                                      reader->scratch, want, &got);
+        if (got > 0) {
+            // Deinterleave the decoded chunk into the planar destination.
+            for (unsigned int c = 0; c < ch; c++) {
+                const float* src = reader->scratch + c;
+                float* out = dst[c] + total;
+                for (ma_uint64 i = 0; i < got; i++) {
+                    out[i] = src[i * ch];
+                }
+            }
+            total += got;
+        }
+        if (result == MA_AT_END || got < want) break;
+        if (result != MA_SUCCESS) return -1;
+    }
+
+    return (long long)total;
 }
 
-// EBU Tech 3285 fixed-size portion of the bext chunk (no coding history).
-#define BWF_BEXT_FIXED_SIZE 602
+long long mh_audio_reader_read_interleaved(MH_AudioReader* reader,
+                                           float* dst, unsigned int nframes) {
+    if (!reader || !dst) return -1;
 
-// Append a BWF `bext` chunk to an existing, finalized WAV file and fix up the
-// RIFF chunk size. The chunk is written after the data chunk; compliant WAV
-// readers (including miniaudio) locate chunks by scanning, so ordering does
-// not matter. Returns 1 on success, 0 on error.
-static int append_bext_chunk(const char* path, const MH_BwfMetadata* bwf,
-                             char* err, size_t err_size) {
-    unsigned char bext[BWF_BEXT_FIXED_SIZE];
-    memset(bext, 0, sizeof(bext));
-    // Field offsets per EBU Tech 3285.
-    bwf_copy_field(bext + 0,   256, bwf->description);
-    bwf_copy_field(bext + 256, 32,  bwf->originator);
-    bwf_copy_field(bext + 288, 32,  bwf->originator_reference);
-    bwf_copy_field(bext + 320, 10,  bwf->origination_date);
-    bwf_copy_field(bext + 330, 8,   bwf->origination_time);
-    put_u32_le(bext + 338, (unsigned long)(bwf->time_reference & 0xFFFFFFFFULL));
-    put_u32_le(bext + 342, (unsigned long)((bwf->time_reference >> 32) & 0xFFFFFFFFULL));
-    put_u16_le(bext + 346, 1);  // Version = 1
-    // UMID (348..411), loudness values (412..421) and Reserved (422..601)
-    // remain zero-filled.
+    ma_uint64 got = 0;
+    ma_result result = ma_decoder_read_pcm_frames(&reader->decoder, dst, nframes, &got);
+    if (result != MA_SUCCESS && result != MA_AT_END) return -1;
+    return (long long)got;
+}
 
-    FILE* f = fopen(path, "r+b");
-    if (!f) {
-        if (err && err_size > 0)
-            snprintf(err, err_size, "Failed to reopen WAV for BWF metadata: %s", path);
+int mh_audio_reader_seek(MH_AudioReader* reader, unsigned long long frame) {
+    if (!reader) return 0;
+    return ma_decoder_seek_to_pcm_frame(&reader->decoder, (ma_uint64)frame) == MA_SUCCESS;
+}
+
+// ---- Memory-mapped reader (float32 WAV only) ----
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+int mh_audio_map_open(const char* path, MH_AudioMap* map,
+                      char* err, size_t err_size) {
+    if (!path || !map) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
         return 0;
     }
-
-    unsigned char sizebuf[4];
-    if (fseek(f, 4, SEEK_SET) != 0 || fread(sizebuf, 1, 4, f) != 4) {
-        fclose(f);
-        if (err && err_size > 0) snprintf(err, err_size, "Failed to read RIFF header");
+    memset(map, 0, sizeof(MH_AudioMap));
+
+#ifdef _WIN32
+    if (err && err_size > 0) snprintf(err, err_size, "mh_audio_map_open is not supported on this platform");
+    return 0;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Failed to open file: %s", path);
         return 0;
     }
-    unsigned long riff_size = get_u32_le(sizebuf);
 
-    unsigned char hdr[8];
-    memcpy(hdr, "bext", 4);
-    put_u32_le(hdr + 4, (unsigned long)BWF_BEXT_FIXED_SIZE);
-
-    if (fseek(f, 0, SEEK_END) != 0 ||
-        fwrite(hdr, 1, 8, f) != 8 ||
-        fwrite(bext, 1, BWF_BEXT_FIXED_SIZE, f) != BWF_BEXT_FIXED_SIZE) {
-        fclose(f);
-        if (err && err_size > 0) snprintf(err, err_size, "Failed to append bext chunk");
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 12) {
+        if (err && err_size > 0) snprintf(err, err_size, "Failed to stat file: %s", path);
+        close(fd);
         return 0;
     }
+    size_t file_size = (size_t)st.st_size;
 
-    // The chunk added 8 (header) + 602 (payload) bytes; 602 is even so no pad
-    // byte is required. Grow the RIFF size by the same amount.
-    unsigned long new_size = riff_size + 8 + BWF_BEXT_FIXED_SIZE;
-    put_u32_le(sizebuf, new_size);
-    if (fseek(f, 4, SEEK_SET) != 0 || fwrite(sizebuf, 1, 4, f) != 4) {
-        fclose(f);
-        if (err && err_size > 0) snprintf(err, err_size, "Failed to update RIFF size");
+    void* base = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps its own reference
+    if (base == MAP_FAILED) {
+        if (err && err_size > 0) snprintf(err, err_size, "mmap failed: %s", path);
         return 0;
     }
 
-    fclose(f);
-    return 1;
-}
-
-int mh_audio_write_bwf(const char* path, const float* data,
-                       unsigned int channels, unsigned int frames,
-                       unsigned int sample_rate, int bit_depth,
-                       const MH_BwfMetadata* bwf,
-                       char* err, size_t err_size) {
-    if (!path || !data) {
-        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+    const unsigned char* p = (const unsigned char*)base;
+    if (memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Not a WAV file: %s", path);
+        munmap(base, file_size);
         return 0;
     }
 
-    const char* ext = get_extension(path);
-    int is_wav = (strcasecmp_ext(ext, ".wav") == 0);
+    // Walk the chunk list for fmt and data. Chunks are word-aligned.
+    unsigned int format_tag = 0, channels = 0, sample_rate = 0, bits = 0;
+    size_t data_offset = 0;
+    unsigned long data_size = 0;
+    size_t pos = 12;
+    while (pos + 8 <= file_size) {
+        unsigned long chunk_size = get_u32_le(p + pos + 4);
+        size_t body = pos + 8;
+        if (memcmp(p + pos, "fmt ", 4) == 0 && chunk_size >= 16 && body + 16 <= file_size) {
+            format_tag = (unsigned int)(p[body] | (p[body + 1] << 8));
+            channels = (unsigned int)(p[body + 2] | (p[body + 3] << 8));
+            sample_rate = (unsigned int)get_u32_le(p + body + 4);
+            bits = (unsigned int)(p[body + 14] | (p[body + 15] << 8));
+        } else if (memcmp(p + pos, "data", 4) == 0) {
+            data_offset = body;
+            data_size = chunk_size;
+        }
+        pos = body + chunk_size + (chunk_size & 1);
+    }
 
-    if (bwf && !is_wav) {
-        if (err && err_size > 0)
-            snprintf(err, err_size, "BWF metadata is only supported for WAV output");
+    // 3 = WAVE_FORMAT_IEEE_FLOAT -- the only layout we can alias as float*.
+    if (format_tag != 3 || bits != 32 || channels == 0 || sample_rate == 0) {
+        if (err && err_size > 0) {
+            snprintf(err, err_size, "Not a float32 WAV (format %u, %u-bit): %s",
+                     format_tag, bits, path);
+        }
+        munmap(base, file_size);
+        return 0;
+    }
+    if (data_offset == 0 || data_offset + data_size > file_size) {
+        if (err && err_size > 0) snprintf(err, err_size, "Missing or truncated data chunk: %s", path);
+        munmap(base, file_size);
+        return 0;
+    }
+    if ((data_offset & 3) != 0) {
+        // Legal WAV, but we can't hand out a misaligned float*.
+        if (err && err_size > 0) snprintf(err, err_size, "data chunk is not 4-byte aligned: %s", path);
+        munmap(base, file_size);
         return 0;
     }
 
-    if (is_wav) {
-        if (!write_wav(path, data, channels, frames, sample_rate, bit_depth, err, err_size))
-            return 0;
-        if (bwf && !append_bext_chunk(path, bwf, err, err_size)) {
-            remove(path);
-            return 0;
+    map->data = (const float*)(p + data_offset);
+    map->channels = channels;
+    map->sample_rate = sample_rate;
+    map->frames = (unsigned int)(data_size / (sizeof(float) * channels));
+    map->map_base = base;
+    map->map_size = file_size;
+    return 1;
+#endif
+}
+
+void mh_audio_map_close(MH_AudioMap* map) {
+    if (!map) return;
+#ifndef _WIN32
+    if (map->map_base) munmap(map->map_base, map->map_size);
+#endif
+    memset(map, 0, sizeof(MH_AudioMap));
+}
+
+void mh_audio_deinterleave(const float* src, float* const* dst,
+                           unsigned int channels, unsigned int frames) {
+    if (!src || !dst || channels == 0) return;
+    if (channels == 2) {
+        // Stereo fast path: a single pass the compiler turns into
+        // vector shuffles.
+        float* restrict l = dst[0];
+        float* restrict r = dst[1];
+        for (unsigned int i = 0; i < frames; i++) {
+            l[i] = src[i * 2];
+            r[i] = src[i * 2 + 1];
+        }
+        return;
+    }
+    for (unsigned int c = 0; c < channels; c++) {
+        const float* in = src + c;
+        float* restrict out = dst[c];
+        for (unsigned int i = 0; i < frames; i++) {
+            out[i] = in[i * channels];
         }
-        return 1;
-    } else if (strcasecmp_ext(ext, ".flac") == 0) {
-        return write_flac(path, data, channels, frames, sample_rate, bit_depth, err, err_size);
-    } else {
-        if (err && err_size > 0)
-            snprintf(err, err_size, "Unsupported format '%s' (use .wav or .flac)", ext);
-        return 0;
     }
 }
 
-int mh_audio_write(const char* path, const float* data,
-                   unsigned int channels, unsigned int frames,
-                   unsigned int sample_rate, int bit_depth,
-                   char* err, size_t err_size) {
-    return mh_audio_write_bwf(path, data, channels, frames, sample_rate,
-                              bit_depth, NULL, err, err_size);
+void mh_audio_interleave(const float* const* src, float* dst,
+                         unsigned int channels, unsigned int frames) {
+    if (!src || !dst || channels == 0) return;
+    if (channels == 2) {
+        // Stereo fast path, mirror of the deinterleave one.
+        const float* restrict l = src[0];
+        const float* restrict r = src[1];
+        for (unsigned int i = 0; i < frames; i++) {
+            dst[i * 2] = l[i];
+            dst[i * 2 + 1] = r[i];
+        }
+        return;
+    }
+    for (unsigned int c = 0; c < channels; c++) {
+        const float* restrict in = src[c];
+        float* out = dst + c;
+        for (unsigned int i = 0; i < frames; i++) {
+            out[i * channels] = in[i];
+        }
+    }
 }
 
 int mh_audio_get_file_info(const char* path, MH_AudioFileInfo* info,
@@ -548,3 +1976,321 @@ MH_AudioData* mh_audio_resample(const float* data_in,
     out->sample_rate = sample_rate_out;
     return out;
 }
+
+// ---- Multi-threaded planar resample ----
+//
+// Each channel is a self-contained mono conversion over contiguous
+// memory, so channels parallelize with no shared state beyond the
+// output block. Output channel planes are laid out at the expected
+// capacity stride during conversion and compacted to the actual frame
+// count afterwards (the converters are deterministic, so per-channel
+// counts agree; the minimum is used defensively).
+
+static ma_uint32 resample_quality_lpf_order(int quality) {
+    switch (quality) {
+        case MH_RESAMPLE_QUALITY_FAST: return 1;
+        case MH_RESAMPLE_QUALITY_HIGH: return 8;
+        default:                       return 4;  // MH_RESAMPLE_QUALITY_DEFAULT
+    }
+}
+
+typedef struct {
+    const float* const* channel_data;   // planar input, one pointer per channel
+    float* out;                         // planar output block
+    unsigned long long out_stride;      // capacity frames per output plane
+    unsigned int frames_in;
+    unsigned int sample_rate_in;
+    unsigned int sample_rate_out;
+    ma_uint32 lpf_order;
+    unsigned int start_channel;         // [start_channel, end_channel)
+    unsigned int end_channel;
+    unsigned long long* out_counts;     // per-channel produced frames (shared, disjoint writes)
+    int ok;
+    char errmsg[128];
+} resample_mt_job;
+
+static void* resample_mt_worker(void* arg) {
+    resample_mt_job* job = (resample_mt_job*)arg;
+
+    for (unsigned int c = job->start_channel; c < job->end_channel; c++) {
+        ma_resampler_config config = ma_resampler_config_init(
+            ma_format_f32, 1, job->sample_rate_in, job->sample_rate_out,
+            ma_resample_algorithm_linear);
+        config.linear.lpfOrder = job->lpf_order;
+
+        ma_resampler resampler;
+        if (ma_resampler_init(&config, NULL, &resampler) != MA_SUCCESS) {
+            snprintf(job->errmsg, sizeof(job->errmsg), "Failed to init resampler");
+            return NULL;
+        }
+
+        ma_uint64 in_count = job->frames_in;
+        ma_uint64 out_count = job->out_stride;
+        ma_result result = ma_resampler_process_pcm_frames(
+            &resampler, job->channel_data[c], &in_count,
+            job->out + (size_t)c * job->out_stride, &out_count);
+        ma_resampler_uninit(&resampler, NULL);
+
+        if (result != MA_SUCCESS) {
+            snprintf(job->errmsg, sizeof(job->errmsg),
+                     "Resampler failed on channel %u: %d", c, result);
+            return NULL;
+        }
+        job->out_counts[c] = out_count;
+    }
+    job->ok = 1;
+    return NULL;
+}
+
+MH_AudioDataPlanar* mh_audio_resample_planar_mt(
+    const float* const* channel_data,
+    unsigned int channels, unsigned int frames_in,
+    unsigned int sample_rate_in, unsigned int sample_rate_out,
+    int quality, int num_threads,
+    char* err, size_t err_size) {
+    if (!channel_data || channels == 0 || frames_in == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid input parameters");
+        return NULL;
+    }
+    if (sample_rate_in == 0 || sample_rate_out == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Sample rates must be > 0");
+        return NULL;
+    }
+
+    MH_AudioDataPlanar* out = (MH_AudioDataPlanar*)malloc(sizeof(MH_AudioDataPlanar));
+    if (!out) {
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+
+    if (sample_rate_in == sample_rate_out) {
+        // No conversion needed -- copy input
+        out->data = (float*)malloc((size_t)frames_in * channels * sizeof(float));
+        if (!out->data) {
+            free(out);
+            if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+            return NULL;
+        }
+        for (unsigned int c = 0; c < channels; c++) {
+            memcpy(out->data + (size_t)c * frames_in, channel_data[c],
+                   (size_t)frames_in * sizeof(float));
+        }
+        out->channels = channels;
+        out->frames = frames_in;
+        out->sample_rate = sample_rate_out;
+        return out;
+    }
+
+    // Estimate output frame count (capacity stride during conversion)
+    unsigned long long out_stride =
+        (unsigned long long)((double)frames_in * sample_rate_out / sample_rate_in) + 16;
+
+    float* block = (float*)malloc((size_t)out_stride * channels * sizeof(float));
+    unsigned long long* out_counts =
+        (unsigned long long*)calloc(channels, sizeof(unsigned long long));
+    if (!block || !out_counts) {
+        free(out_counts);
+        free(block);
+        free(out);
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+
+    if (num_threads > 64) num_threads = 64;
+    if ((unsigned int)num_threads > channels) num_threads = (int)channels;
+#ifdef _WIN32
+    num_threads = 1;
+#endif
+    if (num_threads < 1) num_threads = 1;
+
+    int ok = 1;
+
+    if (num_threads == 1) {
+        resample_mt_job job;
+        memset(&job, 0, sizeof(job));
+        job.channel_data = channel_data;
+        job.out = block;
+        job.out_stride = out_stride;
+        job.frames_in = frames_in;
+        job.sample_rate_in = sample_rate_in;
+        job.sample_rate_out = sample_rate_out;
+        job.lpf_order = resample_quality_lpf_order(quality);
+        job.start_channel = 0;
+        job.end_channel = channels;
+        job.out_counts = out_counts;
+        resample_mt_worker(&job);
+        if (!job.ok) {
+            if (err && err_size > 0) snprintf(err, err_size, "%s", job.errmsg);
+            ok = 0;
+        }
+    } else {
+#ifndef _WIN32
+        resample_mt_job* jobs =
+            (resample_mt_job*)calloc((size_t)num_threads, sizeof(resample_mt_job));
+        pthread_t* threads = (pthread_t*)calloc((size_t)num_threads, sizeof(pthread_t));
+        if (!jobs || !threads) {
+            free(jobs);
+            free(threads);
+            free(out_counts);
+            free(block);
+            free(out);
+            if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+            return NULL;
+        }
+
+        for (int i = 0; i < num_threads; i++) {
+            jobs[i].channel_data = channel_data;
+            jobs[i].out = block;
+            jobs[i].out_stride = out_stride;
+            jobs[i].frames_in = frames_in;
+            jobs[i].sample_rate_in = sample_rate_in;
+            jobs[i].sample_rate_out = sample_rate_out;
+            jobs[i].lpf_order = resample_quality_lpf_order(quality);
+            jobs[i].start_channel = (unsigned int)((unsigned long long)channels * i / num_threads);
+            jobs[i].end_channel = (unsigned int)((unsigned long long)channels * (i + 1) / num_threads);
+            jobs[i].out_counts = out_counts;
+        }
+
+        int spawned = 0;
+        for (; spawned < num_threads; spawned++) {
+            if (pthread_create(&threads[spawned], NULL, resample_mt_worker, &jobs[spawned]) != 0) {
+                ok = 0;
+                if (err && err_size > 0) snprintf(err, err_size, "Failed to spawn resampler thread");
+                break;
+            }
+        }
+        for (int i = 0; i < spawned; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        if (ok) {
+            for (int i = 0; i < num_threads; i++) {
+                if (!jobs[i].ok) {
+                    if (err && err_size > 0) snprintf(err, err_size, "%s", jobs[i].errmsg);
+                    ok = 0;
+                    break;
+                }
+            }
+        }
+        free(threads);
+        free(jobs);
+#endif
+    }
+
+    if (!ok) {
+        free(out_counts);
+        free(block);
+        free(out);
+        return NULL;
+    }
+
+    unsigned long long frames_out = out_counts[0];
+    for (unsigned int c = 1; c < channels; c++) {
+        if (out_counts[c] < frames_out) frames_out = out_counts[c];
+    }
+    free(out_counts);
+
+    // Compact the capacity-stride planes to a tight [channels * frames_out]
+    // block (channel 0 is already in place).
+    for (unsigned int c = 1; c < channels; c++) {
+        memmove(block + (size_t)c * frames_out, block + (size_t)c * out_stride,
+                (size_t)frames_out * sizeof(float));
+    }
+
+    out->data = block;
+    out->channels = channels;
+    out->frames = (unsigned int)frames_out;
+    out->sample_rate = sample_rate_out;
+    return out;
+}
+
+// ---- Streaming resampler ----
+
+struct MH_Resampler {
+    ma_resampler resampler;
+    unsigned int channels;
+    unsigned int sample_rate_in;
+    unsigned int sample_rate_out;
+};
+
+MH_Resampler* mh_resampler_open(unsigned int channels,
+                                unsigned int sample_rate_in,
+                                unsigned int sample_rate_out,
+                                char* err, size_t err_size) {
+    if (channels == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Channels must be > 0");
+        return NULL;
+    }
+    if (sample_rate_in == 0 || sample_rate_out == 0) {
+        if (err && err_size > 0) snprintf(err, err_size, "Sample rates must be > 0");
+        return NULL;
+    }
+
+    MH_Resampler* r = (MH_Resampler*)malloc(sizeof(MH_Resampler));
+    if (!r) {
+        if (err && err_size > 0) snprintf(err, err_size, "Out of memory");
+        return NULL;
+    }
+
+    // Same converter settings as mh_audio_resample.
+    ma_resampler_config config = ma_resampler_config_init(
+        ma_format_f32, channels, sample_rate_in, sample_rate_out,
+        ma_resample_algorithm_linear);
+    config.linear.lpfOrder = 4;  // Low-pass filter for anti-aliasing
+
+    ma_result result = ma_resampler_init(&config, NULL, &r->resampler);
+    if (result != MA_SUCCESS) {
+        free(r);
+        if (err && err_size > 0) snprintf(err, err_size, "Failed to init resampler: %d", result);
+        return NULL;
+    }
+
+    r->channels = channels;
+    r->sample_rate_in = sample_rate_in;
+    r->sample_rate_out = sample_rate_out;
+    return r;
+}
+
+void mh_resampler_close(MH_Resampler* resampler) {
+    if (!resampler) return;
+    ma_resampler_uninit(&resampler->resampler, NULL);
+    free(resampler);
+}
+
+int mh_resampler_process(MH_Resampler* resampler,
+                         const float* input, unsigned long long* in_frames,
+                         float* output, unsigned long long* out_frames,
+                         char* err, size_t err_size) {
+    if (!resampler || !in_frames || !output || !out_frames) {
+        if (err && err_size > 0) snprintf(err, err_size, "Invalid arguments");
+        return 0;
+    }
+
+    ma_uint64 in_count = *in_frames;
+    ma_uint64 out_count = *out_frames;
+    ma_result result = ma_resampler_process_pcm_frames(
+        &resampler->resampler, input, &in_count, output, &out_count);
+    if (result != MA_SUCCESS) {
+        if (err && err_size > 0) snprintf(err, err_size, "Resampler failed: %d", result);
+        return 0;
+    }
+
+    *in_frames = in_count;
+    *out_frames = out_count;
+    return 1;
+}
+
+unsigned long long mh_resampler_latency(const MH_Resampler* resampler) {
+    if (!resampler) return 0;
+    return ma_resampler_get_output_latency((ma_resampler*)&resampler->resampler);
+}
+
+unsigned long long mh_resampler_expected_output(const MH_Resampler* resampler,
+                                                unsigned long long input_frames) {
+    if (!resampler) return 0;
+    ma_uint64 out = 0;
+    if (ma_resampler_get_expected_output_frame_count(
+            (ma_resampler*)&resampler->resampler, input_frames, &out) != MA_SUCCESS) {
+        return 0;
+    }
+    return out;
+}
@@ -27,6 +27,30 @@ MH_AudioData* mh_audio_read(const char* path, char* err, size_t err_size);
 // Free decoded audio data.
 void mh_audio_data_free(MH_AudioData* data);
 
+// Decoded audio data (planar float32): one contiguous block of
+// channels * frames floats laid out channel-major (ch0 frames, ch1
+// frames, ...). Channel c starts at data + c * frames.
+typedef struct {
+    float* data;              // contiguous planar block [channels * frames]
+    unsigned int channels;
+    unsigned int frames;
+    unsigned int sample_rate;
+} MH_AudioDataPlanar;
+
+// As mh_audio_read, but deinterleaved once in C (mh_audio_deinterleave)
+// into the planar layout mh_process and AudioBuffer consume, so callers
+// that work planar skip their own deinterleave copy. The block is
+// contiguous, making it directly adoptable as a (channels, frames)
+// buffer. For block-at-a-time planar decode without materializing the
+// file, use mh_audio_reader_read, which is already planar.
+// Returns NULL on error (writes message to err buffer).
+// Caller must free with mh_audio_data_planar_free().
+MH_AudioDataPlanar* mh_audio_read_planar(const char* path,
+                                         char* err, size_t err_size);
+
+// Free planar decoded audio data.
+void mh_audio_data_planar_free(MH_AudioDataPlanar* data);
+
 // Write interleaved float32 data to an audio file (WAV or FLAC).
 // bit_depth: 16, 24, or 32 (32 = IEEE float).
 // Returns 1 on success, 0 on error.
@@ -61,6 +85,229 @@ int mh_audio_write_bwf(const char* path, const float* data,
                        const MH_BwfMetadata* bwf,
                        char* err, size_t err_size);
 
+// Write planar float32 data (one pointer per channel, frames floats
+// each) to an audio file. Same format/bit_depth contract as
+// mh_audio_write, but the data is interleaved chunk by chunk into a
+// small fixed scratch buffer on the way to the streaming writer, so
+// peak staging memory is bounded by one chunk instead of a second
+// whole-file interleaved copy.
+int mh_audio_write_planar(const char* path, const float* const* channel_data,
+                          unsigned int channels, unsigned int frames,
+                          unsigned int sample_rate, int bit_depth,
+                          char* err, size_t err_size);
+
+// As mh_audio_write_planar with an optional BWF `bext` chunk; same
+// contract as mh_audio_write_bwf.
+int mh_audio_write_planar_bwf(const char* path, const float* const* channel_data,
+                              unsigned int channels, unsigned int frames,
+                              unsigned int sample_rate, int bit_depth,
+                              const MH_BwfMetadata* bwf,
+                              char* err, size_t err_size);
+
+// As mh_audio_write_planar_bwf with an explicit dither mode
+// (MH_DitherMode, declared with the streaming writer below) applied
+// during the float->int conversion. `bwf` may be NULL.
+int mh_audio_write_planar_opts(const char* path, const float* const* channel_data,
+                               unsigned int channels, unsigned int frames,
+                               unsigned int sample_rate, int bit_depth,
+                               int dither_mode, const MH_BwfMetadata* bwf,
+                               char* err, size_t err_size);
+
+// ---- Streaming reader ----
+//
+// Pull-based decoder handle for block-at-a-time reading. Unlike
+// mh_audio_read, which materializes the whole file in one interleaved
+// allocation, an MH_AudioReader decodes on demand with a fixed-size
+// internal scratch buffer, so multi-GB stems can be streamed straight
+// into mh_process without ever being resident. Same format support as
+// mh_audio_read (WAV, FLAC, MP3, Vorbis). Not thread-safe; use one
+// reader per thread.
+typedef struct MH_AudioReader MH_AudioReader;
+
+// Open a file for streaming decode. Returns NULL on error (writes
+// message to err). Close with mh_audio_reader_close().
+MH_AudioReader* mh_audio_reader_open(const char* path,
+                                     char* err, size_t err_size);
+
+void mh_audio_reader_close(MH_AudioReader* reader);
+
+// Stream properties (valid after open).
+unsigned int mh_audio_reader_channels(const MH_AudioReader* reader);
+unsigned int mh_audio_reader_sample_rate(const MH_AudioReader* reader);
+// Total frame count, or 0 when the backing format cannot report a
+// length without a full scan.
+unsigned long long mh_audio_reader_frames(const MH_AudioReader* reader);
+
+// Decode up to nframes into planar dst[channel][nframes] (one pointer
+// per channel, each with room for nframes floats). Returns the number
+// of frames produced -- less than nframes only at end of stream, 0 at
+// EOF -- or -1 on decode error.
+long long mh_audio_reader_read(MH_AudioReader* reader,
+                               float* const* dst, unsigned int nframes);
+
+// As mh_audio_reader_read but into an interleaved buffer
+// [nframes * channels] (no deinterleave pass).
+long long mh_audio_reader_read_interleaved(MH_AudioReader* reader,
+                                           float* dst, unsigned int nframes);
+
+// Seek to an absolute frame position. Returns 1 on success, 0 on
+// failure (error or unseekable stream).
+int mh_audio_reader_seek(MH_AudioReader* reader, unsigned long long frame);
+
+// Multi-threaded FLAC write. Same contract as mh_audio_write for a
+// .flac path (bit_depth 16/24), but the interleaved buffer is split
+// into runs of whole FLAC frames encoded concurrently by num_threads
+// workers and stitched in order -- FLAC frames are self-contained, so
+// the output is a valid stream. num_threads is clamped to [1, 64] and
+// to the number of frames; 1 (and Windows, which has no worker
+// support here) falls back to the serial encoder.
+//
+// Trade-off: the parallel path leaves the STREAMINFO MD5 unset (all
+// zeros, which the FLAC spec allows) since the whole-stream digest is
+// inherently serial. Use the serial path when the MD5 matters.
+// Returns 1 on success, 0 on error.
+int mh_audio_write_flac_mt(const char* path, const float* data,
+                           unsigned int channels, unsigned int frames,
+                           unsigned int sample_rate, int bit_depth,
+                           int num_threads,
+                           char* err, size_t err_size);
+
+// ---- Streaming writer ----
+//
+// Incremental counterpart to mh_audio_write: open once, append
+// interleaved float32 frames block by block, close to finalize. WAV is
+// encoded through miniaudio's encoder; FLAC through tflac with the
+// STREAMINFO header patched on close. Lets a render loop hand blocks
+// to an encoder as they are produced instead of buffering the whole
+// take. Not thread-safe; one writer per thread.
+typedef struct MH_AudioWriter MH_AudioWriter;
+
+// Open a writer. Format is chosen by extension like mh_audio_write
+// (.wav: bit_depth 16/24/32, .flac: 16/24). Returns NULL on error.
+MH_AudioWriter* mh_audio_writer_open(const char* path,
+                                     unsigned int channels,
+                                     unsigned int sample_rate,
+                                     int bit_depth,
+                                     char* err, size_t err_size);
+
+// Open a WAV writer in crash-safe capture mode (.wav only, bit_depth
+// 16/24/32). Unlike mh_audio_writer_open, which leaves the container
+// sizes to be finalized on close, capture mode patches the RIFF and
+// data chunk sizes in place every flush_interval_seconds of audio
+// (<= 0 selects the 4 s default) -- the patch is a single positioned
+// write of the header region, so the append stream is never seeked and
+// a crash mid-capture loses at most one interval, not the whole take.
+// The header is laid out RF64-ready (a ds64-sized JUNK chunk precedes
+// fmt); when the file grows past 4 GB it is upgraded to RF64/BW64 in
+// place and capture continues uninterrupted. Capture files are never
+// removed on error: whatever reached disk stays readable.
+// Returns NULL on error.
+MH_AudioWriter* mh_audio_writer_open_capture(const char* path,
+                                             unsigned int channels,
+                                             unsigned int sample_rate,
+                                             int bit_depth,
+                                             double flush_interval_seconds,
+                                             char* err, size_t err_size);
+
+// Open a WAV writer in unbuffered (direct I/O) mode (.wav only,
+// bit_depth 16/24/32). Sample data is staged in an aligned 1 MiB
+// buffer and written with O_DIRECT (F_NOCACHE on macOS), bypassing the
+// page cache entirely -- a multi-gigabyte bounce then cannot evict the
+// plugin binaries and sample libraries other jobs on the node have
+// warm. Uses the same RF64-ready container as capture mode, so >4 GB
+// output upgrades to RF64/BW64 automatically; the header is finalized
+// once at close (direct I/O cannot patch it periodically -- the two
+// modes are mutually exclusive). Falls back to ordinary buffered
+// writes when the filesystem rejects O_DIRECT, and on Windows, which
+// has no direct-I/O support here. Returns NULL on error.
+MH_AudioWriter* mh_audio_writer_open_unbuffered(const char* path,
+                                                unsigned int channels,
+                                                unsigned int sample_rate,
+                                                int bit_depth,
+                                                char* err, size_t err_size);
+
+// Dither applied during the float->int conversion 16/24-bit writes
+// already perform (32-bit float output has no quantization step and
+// ignores the setting). MH_DITHER_TPDF is flat triangular dither --
+// what 16/24-bit WAV and 16-bit FLAC writes have always applied.
+// MH_DITHER_SHAPED adds second-order error-feedback noise shaping on
+// top of the TPDF noise, pushing the quantization floor toward high
+// frequencies where it is least audible -- the mastering-deliverable
+// option that previously required a separate dither pass over the
+// file. MH_DITHER_NONE rounds without noise (deterministic output;
+// useful for bit-exact comparisons).
+typedef enum MH_DitherMode {
+    MH_DITHER_TPDF   = 0,
+    MH_DITHER_NONE   = 1,
+    MH_DITHER_SHAPED = 2,
+} MH_DitherMode;
+
+// Select the dither mode for subsequent writes. Call between open and
+// the first write; the conversion happens inside the write path, so
+// no extra pass over the sample data is made. Returns 1 on success,
+// 0 on a bad mode or writer.
+int mh_audio_writer_set_dither(MH_AudioWriter* writer, int mode);
+
+// Append interleaved float32 frames [frames * channels].
+// Returns 1 on success, 0 on error (the writer stays open; close it).
+int mh_audio_writer_write(MH_AudioWriter* writer, const float* interleaved,
+                          unsigned int frames, char* err, size_t err_size);
+
+// Force a header patch now (capture-mode writers only): flushes
+// buffered sample data and rewrites the container sizes to cover
+// everything written so far. Called automatically on the flush
+// interval; call it directly around known-risky moments (e.g. before
+// unmounting media). Returns 1 on success, 0 on error or for a
+// non-capture writer.
+int mh_audio_writer_flush(MH_AudioWriter* writer, char* err, size_t err_size);
+
+// Total frames accepted so far.
+unsigned long long mh_audio_writer_frames_written(const MH_AudioWriter* writer);
+
+// Flush, finalize the container, and free the writer (always freed,
+// even on failure). A failed FLAC finalize removes the partial file,
+// matching mh_audio_write. Returns 1 on success, 0 on error.
+int mh_audio_writer_close(MH_AudioWriter* writer, char* err, size_t err_size);
+
+// ---- Memory-mapped reader (float32 WAV only) ----
+//
+// Zero-copy fast path for the exact format mh_audio_write produces with
+// bit_depth 32: a WAV file whose data chunk is interleaved IEEE float32.
+// The data chunk is mapped read-only and exposed in place -- no decode,
+// no copy, and pages are shared with the OS cache, so re-reading
+// intermediates costs neither CPU nor double-resident memory. Any other
+// container or sample format fails; fall back to mh_audio_read /
+// mh_audio_reader_open for those.
+typedef struct {
+    const float* data;        // interleaved float32, points into the mapping
+    unsigned int channels;
+    unsigned int frames;
+    unsigned int sample_rate;
+    // internal (do not touch)
+    void* map_base;
+    size_t map_size;
+} MH_AudioMap;
+
+// Map a float32 WAV file. Returns 1 on success (map->data valid until
+// mh_audio_map_close), 0 on error -- including "not a float32 WAV",
+// so callers can probe and fall back. Not available on Windows.
+int mh_audio_map_open(const char* path, MH_AudioMap* map,
+                      char* err, size_t err_size);
+
+// Unmap. Safe on a zeroed or already-closed struct.
+void mh_audio_map_close(MH_AudioMap* map);
+
+// Deinterleave [frames * channels] float32 into planar dst[channel].
+// Plain per-channel strided loops; with channels known small the
+// compiler vectorizes these, and the common stereo case is split out.
+void mh_audio_deinterleave(const float* src, float* const* dst,
+                           unsigned int channels, unsigned int frames);
+
+// Interleave planar src[channel] into [frames * channels] float32.
+// Inverse of mh_audio_deinterleave, same vectorization story.
+void mh_audio_interleave(const float* const* src, float* dst,
+                         unsigned int channels, unsigned int frames);
+
 // Audio file metadata (without full decode)
 typedef struct {
     unsigned int channels;
@@ -85,6 +332,75 @@ MH_AudioData* mh_audio_resample(const float* data_in,
                                 unsigned int sample_rate_out,
                                 char* err, size_t err_size);
 
+// Quality/speed preset for mh_audio_resample_planar_mt: selects the
+// converter's anti-aliasing filter order.
+typedef enum {
+    MH_RESAMPLE_QUALITY_FAST = 0,     // order 1: cheapest, most aliasing
+    MH_RESAMPLE_QUALITY_DEFAULT = 1,  // order 4: mh_audio_resample's setting
+    MH_RESAMPLE_QUALITY_HIGH = 2      // order 8: steepest filter, slowest
+} MH_ResampleQuality;
+
+// Multi-threaded planar resample. Channels are independent mono
+// conversions, so they are dispatched across num_threads workers
+// (clamped to [1, 64] and to the channel count); each worker runs its
+// channels through a mono converter over contiguous memory, where the
+// inner loops vectorize, instead of the serial interleaved pass
+// mh_audio_resample does. 16-32 channel stem conversions scale close
+// to linearly with cores.
+//
+// quality is an MH_ResampleQuality. num_threads 1 (and Windows, which
+// has no worker support here) runs the same per-channel path serially.
+// Returns planar output at sample_rate_out, or NULL on error. Caller
+// must free with mh_audio_data_planar_free().
+MH_AudioDataPlanar* mh_audio_resample_planar_mt(
+    const float* const* channel_data,
+    unsigned int channels, unsigned int frames_in,
+    unsigned int sample_rate_in, unsigned int sample_rate_out,
+    int quality, int num_threads,
+    char* err, size_t err_size);
+
+// ---- Streaming resampler ----
+//
+// Incremental counterpart to mh_audio_resample: open once, push
+// interleaved float32 blocks through mh_resampler_process, close when
+// done. All filter state is preallocated at open, so a file of any
+// length converts with peak memory bounded by the caller's block size
+// -- pair with MH_AudioReader / MH_AudioWriter for file-to-file
+// conversion of multi-hour stems. Same converter and anti-aliasing
+// settings as mh_audio_resample. Not thread-safe; one resampler per
+// thread.
+typedef struct MH_Resampler MH_Resampler;
+
+// Open a resampler. Rates must be > 0 and may be equal (the converter
+// then passes frames through). Returns NULL on error.
+MH_Resampler* mh_resampler_open(unsigned int channels,
+                                unsigned int sample_rate_in,
+                                unsigned int sample_rate_out,
+                                char* err, size_t err_size);
+
+void mh_resampler_close(MH_Resampler* resampler);
+
+// Convert one block. On entry *in_frames is the number of interleaved
+// input frames available at `input` and *out_frames the capacity of
+// `output`; on return they hold the frames actually consumed and
+// produced (either may be short -- loop until the input is drained).
+// Pass input = NULL to flush: the converter then reads silence, which
+// pushes out the frames still buffered in its filter history.
+// Returns 1 on success, 0 on error.
+int mh_resampler_process(MH_Resampler* resampler,
+                         const float* input, unsigned long long* in_frames,
+                         float* output, unsigned long long* out_frames,
+                         char* err, size_t err_size);
+
+// Frames of output still latent in the filter history -- the amount a
+// final NULL-input flush should request. 0 for a closed/NULL handle.
+unsigned long long mh_resampler_latency(const MH_Resampler* resampler);
+
+// Output frames a push of input_frames would yield given the current
+// internal state. Useful for sizing the caller's output block.
+unsigned long long mh_resampler_expected_output(const MH_Resampler* resampler,
+                                                unsigned long long input_frames);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,92 @@
+// minihost_measure.h
+// Vectorizable audio measurement kernels: per-channel peak/RMS scans and
+// a streaming EBU R128 / ITU-R BS.1770 loudness meter.
+//
+// The scans are plain contiguous loops the compiler auto-vectorizes
+// (same story as mh_audio_deinterleave); the loudness meter keeps all
+// filter and gating state internal so arbitrarily long material is
+// measured block by block -- feed it render output, decoded file
+// blocks, or a PluginGraph analysis tap, and query at any point.
+// Replaces whole-file numpy passes whose loudness measurement could
+// outlast the render that produced the audio.
+
+#ifndef MINIHOST_MEASURE_H
+#define MINIHOST_MEASURE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Scan planar float32 audio (one pointer per channel, frames samples
+// each) for per-channel linear peak (max |sample|) and RMS. Either
+// output array may be NULL to skip it; both are sized `channels`.
+// One pass per channel over contiguous memory. Returns 1 on success,
+// 0 on bad arguments.
+int mh_measure_peak_rms(const float* const* channel_data,
+                        unsigned int channels, unsigned int frames,
+                        float* peaks, float* rms);
+
+// ---- Streaming loudness meter (EBU R128 / ITU-R BS.1770-4) ----
+//
+// Open once per program, push planar blocks with mh_loudness_process,
+// read integrated / short-term loudness whenever needed (queries do
+// not disturb the measurement state). Internals: the BS.1770
+// K-weighting pre-filter (high shelf + high pass, coefficients derived
+// for the meter's sample rate) runs per channel; energy is accumulated
+// in 100 ms hops, combined into 400 ms gating blocks with 75% overlap
+// for the integrated measure (-70 LUFS absolute gate, then a relative
+// gate 10 LU below the absolute-gated mean), and into a 3 s sliding
+// window for short-term. Channel weighting follows the BS.1770 5.0
+// layout: channels 4 and 5 (the surrounds) weigh 1.41, all others 1.0
+// -- mono and stereo material is unaffected.
+//
+// Block processing does not allocate except for the integrated
+// measure's gating-block list, which grows amortized (about 10 doubles
+// per second of audio). Not thread-safe; one meter per stream.
+typedef struct MH_LoudnessMeter MH_LoudnessMeter;
+
+// Create a meter. channels must be >= 1, sample_rate >= 8000 (the
+// K-weighting prefilter is not meaningful below that). Returns NULL on
+// error (writes message to err). Close with mh_loudness_close().
+MH_LoudnessMeter* mh_loudness_open(unsigned int channels,
+                                   unsigned int sample_rate,
+                                   char* err, size_t err_size);
+
+void mh_loudness_close(MH_LoudnessMeter* m);
+
+// Feed one planar block (one pointer per channel, frames samples
+// each). Blocks may be any size; hop and window boundaries are
+// tracked internally. Also tracks the running per-channel sample peak
+// of the unweighted input. Returns 1 on success, 0 on bad arguments.
+int mh_loudness_process(MH_LoudnessMeter* m,
+                        const float* const* channel_data,
+                        unsigned int frames);
+
+// Gated integrated loudness in LUFS over everything processed since
+// open/reset. -HUGE_VAL until at least one 400 ms gating block has
+// completed and passed the absolute gate.
+double mh_loudness_integrated(const MH_LoudnessMeter* m);
+
+// Short-term loudness in LUFS: the ungated energy of the most recent
+// 3 seconds (or of what has been processed so far, when less).
+// -HUGE_VAL until the first 100 ms hop completes.
+double mh_loudness_shortterm(const MH_LoudnessMeter* m);
+
+// Running linear sample peak (max |sample|) of `channel` since
+// open/reset, measured on the raw input before K-weighting. Returns
+// 0.0 for an out-of-range channel or NULL meter.
+double mh_loudness_sample_peak(const MH_LoudnessMeter* m,
+                               unsigned int channel);
+
+// Drop all measurement state (filters, windows, gating blocks, peaks)
+// without reallocating; the meter is ready for a new stream. Returns
+// 1 on success, 0 for NULL.
+int mh_loudness_reset(MH_LoudnessMeter* m);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MINIHOST_MEASURE_H
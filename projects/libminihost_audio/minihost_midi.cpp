@@ -32,8 +32,40 @@ struct MH_MidiIn {
 // MIDI output wrapper
 struct MH_MidiOut {
     std::unique_ptr<libremidi::midi_out> midi_out;
+
+    // Preallocated encoding buffer for mh_midi_out_send_events: the
+    // whole burst is encoded here before anything is handed to the
+    // backend, so the send path does not allocate. Reserved at open
+    // for a typical burst; a larger burst grows it once (and never on
+    // the bursts that follow).
+    std::vector<unsigned char> encode_buf;
 };
 
+// Bytes reserved in encode_buf at open: room for a 341-event burst of
+// 3-byte channel messages, comfortably past a dense generative chord.
+static constexpr size_t kEncodeBufReserve = 1024;
+
+// Encoded length of the MIDI message starting with `status`: channel
+// voice messages are 2-3 bytes, system common 1-3. Returns 0 for
+// anything MH_MidiEvent cannot carry (data bytes, sysex).
+static size_t midi_message_length(unsigned char status) {
+    if (status < 0x80) return 0;
+    switch (status & 0xF0) {
+        case 0xC0:  // program change
+        case 0xD0:  // channel pressure
+            return 2;
+        case 0xF0:
+            switch (status) {
+                case 0xF1: case 0xF3: return 2;  // MTC quarter, song select
+                case 0xF2: return 3;             // song position
+                case 0xF0: case 0xF7: return 0;  // sysex: needs a byte stream
+                default: return 1;               // tune request, real-time
+            }
+        default:
+            return 3;
+    }
+}
+
 extern "C" {
 
 int mh_midi_enumerate_inputs(MH_MidiPortCallback callback, void* user_data) {
@@ -264,6 +296,7 @@ MH_MidiOut* mh_midi_out_open(int port_index, char* err_buf, size_t err_buf_size)
 
         auto* midi_out = new MH_MidiOut();
         midi_out->midi_out = std::make_unique<libremidi::midi_out>();
+        midi_out->encode_buf.reserve(kEncodeBufReserve);
 
         auto err = midi_out->midi_out->open_port(ports[port_index]);
         if (err != stdx::error{}) {
@@ -299,6 +332,7 @@ MH_MidiOut* mh_midi_out_open_virtual(const char* port_name, char* err_buf, size_
     try {
         auto* midi_out = new MH_MidiOut();
         midi_out->midi_out = std::make_unique<libremidi::midi_out>();
+        midi_out->encode_buf.reserve(kEncodeBufReserve);
 
         auto err = midi_out->midi_out->open_virtual_port(port_name);
         if (err != stdx::error{}) {
@@ -343,4 +377,40 @@ int mh_midi_out_send(MH_MidiOut* midi_out, const unsigned char* data, size_t len
     }
 }
 
+int mh_midi_out_send_events(MH_MidiOut* midi_out,
+                            const MH_MidiEvent* events, int num_events) {
+    if (!midi_out || !midi_out->midi_out || num_events < 0) return -1;
+    if (num_events > 0 && !events) return -1;
+    if (num_events == 0) return 0;
+
+    try {
+        // Encode the whole burst into the preallocated buffer first,
+        // then hand the backend one message per encoded slice. The
+        // reserve only reallocates when a burst exceeds every earlier
+        // one; steady-state bursts are allocation-free.
+        auto& buf = midi_out->encode_buf;
+        const size_t needed = static_cast<size_t>(num_events) * 3;
+        if (buf.capacity() < needed) buf.reserve(needed);
+        buf.clear();
+
+        int sent = 0;
+        for (int i = 0; i < num_events; i++) {
+            const size_t len = midi_message_length(events[i].status);
+            if (len == 0) continue;  // not expressible in MH_MidiEvent
+
+            const size_t at = buf.size();
+            buf.push_back(events[i].status);
+            if (len >= 2) buf.push_back(events[i].data1);
+            if (len >= 3) buf.push_back(events[i].data2);
+
+            auto err = midi_out->midi_out->send_message(buf.data() + at, len);
+            if (err != stdx::error{}) return sent;
+            sent++;
+        }
+        return sent;
+    } catch (...) {
+        return -1;
+    }
+}
+
 }  // extern "C"
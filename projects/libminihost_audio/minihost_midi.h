@@ -9,6 +9,8 @@
 
 #include <stddef.h>
 
+#include "minihost.h"  // For MH_MidiEvent
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -86,6 +88,25 @@ void mh_midi_out_close(MH_MidiOut* midi_out);
 // Returns 1 on success, 0 on failure
 int mh_midi_out_send(MH_MidiOut* midi_out, const unsigned char* data, size_t len);
 
+// Batch send: encode and send num_events events in one call. Each
+// event's wire length (1-3 bytes) is derived from its status byte;
+// events MH_MidiEvent cannot carry (sysex, stray data bytes) are
+// skipped. The whole burst is encoded into a buffer preallocated at
+// open before anything reaches the backend, so steady-state bursts
+// are allocation-free -- one mh_midi_out_send per event paid an
+// API/exception boundary each, which is what smeared dense chords.
+//
+// Events are sent in array order; keep bursts chronological (the same
+// contract as mh_process_midi). sample_offset is not used for
+// scheduling: the backends expose no timestamped send, so the burst
+// goes out immediately and back-to-back.
+//
+// Returns the number of events handed to the backend (skipped events
+// are not counted; an early backend failure stops the burst), or -1
+// on invalid arguments.
+int mh_midi_out_send_events(MH_MidiOut* midi_out,
+                            const MH_MidiEvent* events, int num_events);
+
 #ifdef __cplusplus
 }
 #endif
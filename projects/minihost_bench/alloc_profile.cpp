@@ -0,0 +1,330 @@
+// alloc_profile.cpp
+// Allocation-profile regression harness for the audited audio paths.
+//
+// Runs every AUDIO-THREAD ONLY entry point from minihost.h's
+// thread-safety taxonomy (mh_process* variants, the chain process
+// variants, mh_graph_render_block) under the MINIHOST_RT_AUDIT
+// allocator interposer, size-buckets any trapped allocation, and
+// emits one JSON entry per path for CI to diff against a checked-in
+// baseline. When any audited path allocates, the symbolized
+// backtraces go to stderr and the exit status is non-zero -- a new
+// malloc in mh_process_midi_io fails the run loudly with the
+// offending call path instead of slipping past a single-path test.
+//
+// Usage:
+//   MINIHOST_RT_AUDIT=1 [MINIHOST_BENCH_PLUGIN=/path/to.vst3] \
+//       ./minihost_alloc_profile > alloc_profile.json
+//
+// Without MINIHOST_BENCH_PLUGIN only the plugin-free paths (graph
+// built-ins) are exercised; skipped paths still appear in the JSON
+// with "skipped": true so the baseline shape stays stable.
+
+#include "minihost.h"
+#include "minihost_chain.h"
+#include "minihost_graph_v2.h"
+#include "minihost_rt_audit.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace {
+
+constexpr double kSampleRate   = 48000.0;
+constexpr int    kMaxBlockSize = 1024;
+constexpr int    kBlock        = 512;
+constexpr int    kWarmupCalls  = 8;   // first calls may allocate lazily
+constexpr int    kMeasureCalls = 64;
+
+// Planar scratch with a pointer table (same helper shape as
+// benchmarks.cpp; duplicated rather than shared so each tool stays a
+// single self-contained translation unit).
+struct PlanarBuf {
+    std::vector<float>  storage;
+    std::vector<float*> ptrs;
+
+    PlanarBuf(int channels, int frames)
+        : storage((size_t) channels * (size_t) frames, 0.0f),
+          ptrs((size_t) channels)
+    {
+        for (int c = 0; c < channels; ++c)
+            ptrs[(size_t) c] = storage.data() + (size_t) c * frames;
+    }
+
+    float* const* out() { return ptrs.data(); }
+    const float* const* in() const
+    { return const_cast<const float* const*>(ptrs.data()); }
+};
+
+struct PlanarBufD {
+    std::vector<double>  storage;
+    std::vector<double*> ptrs;
+
+    PlanarBufD(int channels, int frames)
+        : storage((size_t) channels * (size_t) frames, 0.0),
+          ptrs((size_t) channels)
+    {
+        for (int c = 0; c < channels; ++c)
+            ptrs[(size_t) c] = storage.data() + (size_t) c * frames;
+    }
+
+    double* const* out() { return ptrs.data(); }
+    const double* const* in() const
+    { return const_cast<const double* const*>(ptrs.data()); }
+};
+
+bool g_first_entry = true;
+
+void emitSkipped(const char* name)
+{
+    std::printf("%s  {\"entry_point\": \"%s\", \"skipped\": true}",
+                g_first_entry ? "" : ",\n", name);
+    g_first_entry = false;
+}
+
+// Warm up, reset the audit counter, run the measured calls, and emit
+// one JSON entry with the hit count and size buckets. Returns true
+// when the path stayed allocation-free.
+bool profilePath(const char* name, const std::function<void()>& body)
+{
+    for (int i = 0; i < kWarmupCalls; ++i) body();
+    mh_rt_audit_reset();
+    for (int i = 0; i < kMeasureCalls; ++i) body();
+
+    const long long hits = mh_rt_audit_hit_count();
+    long long le64 = 0, le256 = 0, le1k = 0, le4k = 0, gt4k = 0;
+    for (int i = 0;; ++i)
+    {
+        const long long bytes = mh_rt_audit_hit_bytes(i);
+        if (bytes < 0) break;
+        if      (bytes <= 64)   ++le64;
+        else if (bytes <= 256)  ++le256;
+        else if (bytes <= 1024) ++le1k;
+        else if (bytes <= 4096) ++le4k;
+        else                    ++gt4k;
+    }
+
+    std::printf("%s  {\"entry_point\": \"%s\", \"calls\": %d, "
+                "\"allocations\": %lld, \"buckets\": "
+                "{\"le64\": %lld, \"le256\": %lld, \"le1k\": %lld, "
+                "\"le4k\": %lld, \"gt4k\": %lld}}",
+                g_first_entry ? "" : ",\n", name, kMeasureCalls, hits,
+                le64, le256, le1k, le4k, gt4k);
+    g_first_entry = false;
+
+    if (hits > 0)
+    {
+        std::vector<char> report(65536);
+        mh_rt_audit_report(report.data(), report.size());
+        std::fprintf(stderr, "\n== %s allocated ==\n%s",
+                     name, report.data());
+    }
+    return hits == 0;
+}
+
+// Plugin-free coverage: mh_graph_render_block over built-in nodes
+// (input -> convolve -> mix -> output touches the buffer pool, the
+// FFT path, and the mix kernel).
+bool profileGraphPaths()
+{
+    char err[256] = {0};
+    MH_PluginGraph* g = mh_graph_create(kMaxBlockSize, kSampleRate,
+                                        err, sizeof(err));
+    if (g == nullptr)
+    {
+        std::fprintf(stderr, "graph create failed: %s\n", err);
+        emitSkipped("mh_graph_render_block");
+        return false;
+    }
+
+    std::vector<float> ir((size_t) kBlock, 0.0f);
+    ir[0] = 1.0f;
+    const float* ir_ptr = ir.data();
+
+    MH_NodeId in   = mh_graph_add_input(g, 2, err, sizeof(err));
+    MH_NodeId conv = mh_graph_add_convolve(g, 2, &ir_ptr, 1,
+                                           (int) ir.size(), err, sizeof(err));
+    MH_NodeId mix  = mh_graph_add_mix(g, 1, 2, err, sizeof(err));
+    MH_NodeId out  = mh_graph_add_output(g, 2, err, sizeof(err));
+    bool ok = in >= 0 && conv >= 0 && mix >= 0 && out >= 0
+        && mh_graph_connect(g, in, 0, conv, 0, err, sizeof(err))
+        && mh_graph_connect(g, conv, 0, mix, 0, err, sizeof(err))
+        && mh_graph_connect(g, mix, 0, out, 0, err, sizeof(err))
+        && mh_graph_compile(g, err, sizeof(err));
+    if (!ok)
+    {
+        std::fprintf(stderr, "graph build failed: %s\n", err);
+        mh_graph_close(g);
+        emitSkipped("mh_graph_render_block");
+        return false;
+    }
+
+    PlanarBuf in_buf(2, kBlock);
+    PlanarBuf out_buf(2, kBlock);
+    const float* const* in_top[1]  = { in_buf.in() };
+    float* const*       out_top[1] = { out_buf.out() };
+
+    bool clean = profilePath("mh_graph_render_block", [&] {
+        mh_graph_render_block(g, in_top, 1, out_top, 1, kBlock);
+    });
+    mh_graph_close(g);
+    return clean;
+}
+
+// Plugin-dependent coverage of every mh_process* variant plus the
+// chain process variants (two instances so the inter-stage path runs).
+bool profilePluginPaths(const char* path)
+{
+    static const char* const kPluginPaths[] = {
+        "mh_process", "mh_process_interleaved", "mh_process_midi",
+        "mh_process_midi_io", "mh_process_auto", "mh_process_sidechain",
+        "mh_process_double", "mh_chain_process",
+        "mh_chain_process_midi_io", "mh_chain_process_auto",
+    };
+
+    if (path == nullptr)
+    {
+        for (const char* name : kPluginPaths) emitSkipped(name);
+        return true;
+    }
+
+    char err[256] = {0};
+    MH_Plugin* p = mh_open(path, kSampleRate, kMaxBlockSize, 0, 0,
+                           err, sizeof(err));
+    MH_Plugin* p2 = mh_open(path, kSampleRate, kMaxBlockSize, 0, 0,
+                            err, sizeof(err));
+    if (p == nullptr || p2 == nullptr)
+    {
+        std::fprintf(stderr, "plugin open failed: %s\n", err);
+        if (p != nullptr) mh_close(p);
+        for (const char* name : kPluginPaths) emitSkipped(name);
+        return false;
+    }
+
+    MH_Info info;
+    mh_get_info(p, &info);
+    const int in_ch  = info.num_input_ch  > 0 ? info.num_input_ch  : 1;
+    const int out_ch = info.num_output_ch > 0 ? info.num_output_ch : 1;
+    PlanarBuf  in_buf(in_ch, kBlock);
+    PlanarBuf  out_buf(out_ch, kBlock);
+    PlanarBufD in_d(in_ch, kBlock);
+    PlanarBufD out_d(out_ch, kBlock);
+    const int inter_ch = in_ch > out_ch ? in_ch : out_ch;
+    std::vector<float> inter_in((size_t) inter_ch * kBlock, 0.0f);
+    std::vector<float> inter_out((size_t) inter_ch * kBlock, 0.0f);
+
+    MH_MidiEvent midi[2] = {};
+    midi[0].sample_offset = 0;   midi[0].status = 0x90;
+    midi[0].data1 = 60;          midi[0].data2 = 100;
+    midi[1].sample_offset = 128; midi[1].status = 0x80;
+    midi[1].data1 = 60;          midi[1].data2 = 0;
+    MH_MidiEvent midi_out_buf[64];
+    int num_midi_out = 0;
+
+    MH_ParamChange changes[2] = {};
+    changes[0].sample_offset = 0;   changes[0].param_index = 0;
+    changes[0].value = 0.25f;
+    changes[1].sample_offset = 256; changes[1].param_index = 0;
+    changes[1].value = 0.75f;
+    const int num_changes = mh_get_num_params(p) > 0 ? 2 : 0;
+
+    bool clean = true;
+    clean &= profilePath("mh_process", [&] {
+        mh_process(p, in_buf.in(), out_buf.out(), kBlock);
+    });
+    clean &= profilePath("mh_process_interleaved", [&] {
+        mh_process_interleaved(p, inter_in.data(), inter_out.data(),
+                               kBlock, inter_ch);
+    });
+    clean &= profilePath("mh_process_midi", [&] {
+        mh_process_midi(p, in_buf.in(), out_buf.out(), kBlock, midi, 2);
+    });
+    clean &= profilePath("mh_process_midi_io", [&] {
+        mh_process_midi_io(p, in_buf.in(), out_buf.out(), kBlock,
+                           midi, 2, midi_out_buf, 64, &num_midi_out);
+    });
+    clean &= profilePath("mh_process_auto", [&] {
+        mh_process_auto(p, in_buf.in(), out_buf.out(), kBlock,
+                        midi, 2, midi_out_buf, 64, &num_midi_out,
+                        changes, num_changes);
+    });
+    if (mh_get_sidechain_channels(p) > 0)
+    {
+        PlanarBuf sc(mh_get_sidechain_channels(p), kBlock);
+        clean &= profilePath("mh_process_sidechain", [&] {
+            mh_process_sidechain(p, in_buf.in(), out_buf.out(),
+                                 sc.in(), kBlock);
+        });
+    }
+    else
+    {
+        emitSkipped("mh_process_sidechain");
+    }
+    clean &= profilePath("mh_process_double", [&] {
+        mh_process_double(p, in_d.in(), out_d.out(), kBlock);
+    });
+
+    MH_Plugin* plugins[2] = { p, p2 };
+    MH_PluginChain* chain = mh_chain_create(plugins, 2, err, sizeof(err));
+    if (chain != nullptr)
+    {
+        const int cin  = mh_chain_get_num_input_channels(chain);
+        const int cout = mh_chain_get_num_output_channels(chain);
+        PlanarBuf chain_in(cin > 0 ? cin : 1, kBlock);
+        PlanarBuf chain_out(cout > 0 ? cout : 1, kBlock);
+        MH_ChainParamChange cchanges[2] = {};
+        cchanges[0].sample_offset = 0;   cchanges[0].value = 0.25f;
+        cchanges[1].sample_offset = 256; cchanges[1].plugin_index = 1;
+        cchanges[1].value = 0.75f;
+
+        clean &= profilePath("mh_chain_process", [&] {
+            mh_chain_process(chain, chain_in.in(), chain_out.out(), kBlock);
+        });
+        clean &= profilePath("mh_chain_process_midi_io", [&] {
+            mh_chain_process_midi_io(chain, chain_in.in(), chain_out.out(),
+                                     kBlock, midi, 2,
+                                     midi_out_buf, 64, &num_midi_out);
+        });
+        clean &= profilePath("mh_chain_process_auto", [&] {
+            mh_chain_process_auto(chain, chain_in.in(), chain_out.out(),
+                                  kBlock, midi, 2,
+                                  midi_out_buf, 64, &num_midi_out,
+                                  cchanges, num_changes);
+        });
+        mh_chain_close(chain);
+    }
+    else
+    {
+        std::fprintf(stderr, "chain create failed: %s\n", err);
+        emitSkipped("mh_chain_process");
+        emitSkipped("mh_chain_process_midi_io");
+        emitSkipped("mh_chain_process_auto");
+        clean = false;
+    }
+
+    mh_close(p);
+    mh_close(p2);
+    return clean;
+}
+
+} // namespace
+
+int main()
+{
+    if (!mh_rt_audit_enabled())
+    {
+        std::fprintf(stderr,
+                     "alloc_profile: MINIHOST_RT_AUDIT=1 must be set in the "
+                     "environment before the process starts (the allocator "
+                     "interposer is latched at library load).\n");
+        return 2;
+    }
+
+    std::printf("[\n");
+    bool clean = profileGraphPaths();
+    clean &= profilePluginPaths(std::getenv("MINIHOST_BENCH_PLUGIN"));
+    std::printf("\n]\n");
+    return clean ? 0 : 1;
+}
@@ -0,0 +1,616 @@
+// benchmarks.cpp
+// Google Benchmark microbenchmarks for the minihost hot paths. Every
+// perf-sensitive change should come with a before/after run of this
+// suite instead of a hand-rolled timer.
+//
+// Audio-processing benchmarks report two custom counters:
+//   blocks_per_sec  -- process calls per wall-clock second
+//   x_realtime      -- how many times faster than realtime the path
+//                      runs (rendered seconds per wall-clock second)
+//
+// Plugin-dependent benchmarks (mh_process, mh_chain_process) need a
+// real plugin: set MINIHOST_BENCH_PLUGIN to a plugin path, otherwise
+// they skip. Everything else is synthetic and always runs.
+//
+// Usage:
+//   cmake -B build -DMINIHOST_BUILD_BENCH=ON
+//   cmake --build build --target minihost_bench
+//   MINIHOST_BENCH_PLUGIN=/path/to/plugin.vst3 \
+//       ./build/projects/minihost_bench/minihost_bench
+//
+// Pass --benchmark_filter=Graph (etc.) to run a subset, and
+// --benchmark_format=json for machine-readable before/after diffs.
+
+#include <benchmark/benchmark.h>
+
+#include "minihost.h"
+#include "minihost_chain.h"
+#include "minihost_graph_v2.h"
+#include "audio_ringbuffer.h"
+#include "minihost_audiofile.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double kSampleRate   = 48000.0;
+constexpr int    kMaxBlockSize = 2048;
+
+// Attach the standard audio counters after a processing loop.
+void setAudioCounters(benchmark::State& state, int nframes)
+{
+    state.counters["blocks_per_sec"] = benchmark::Counter(
+        (double) state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["x_realtime"] = benchmark::Counter(
+        (double) state.iterations() * (double) nframes / kSampleRate,
+        benchmark::Counter::kIsRate);
+}
+
+const char* benchPluginPath()
+{
+    return std::getenv("MINIHOST_BENCH_PLUGIN");
+}
+
+// Planar scratch buffers with a pointer table, the shape every
+// process entry point consumes.
+struct PlanarBuf {
+    std::vector<float>  storage;
+    std::vector<float*> ptrs;
+
+    PlanarBuf(int channels, int frames)
+        : storage((size_t) channels * (size_t) frames, 0.0f),
+          ptrs((size_t) channels)
+    {
+        for (int c = 0; c < channels; ++c)
+            ptrs[(size_t) c] = storage.data() + (size_t) c * frames;
+    }
+
+    float* const* out() { return ptrs.data(); }
+    const float* const* in() const
+    { return const_cast<const float* const*>(ptrs.data()); }
+};
+
+// ---------------------------------------------------------------- //
+// mh_process dispatch overhead (plugin required)                    //
+// ---------------------------------------------------------------- //
+
+void BM_ProcessDispatch(benchmark::State& state)
+{
+    const char* path = benchPluginPath();
+    if (path == nullptr)
+    {
+        state.SkipWithError("MINIHOST_BENCH_PLUGIN not set");
+        return;
+    }
+
+    char err[256];
+    MH_Plugin* p = mh_open(path, kSampleRate, kMaxBlockSize, 0, 0,
+                           err, sizeof(err));
+    if (p == nullptr)
+    {
+        state.SkipWithError(err);
+        return;
+    }
+
+    MH_Info info;
+    mh_get_info(p, &info);
+    const int nframes = (int) state.range(0);
+    PlanarBuf in(info.num_input_ch > 0 ? info.num_input_ch : 1, nframes);
+    PlanarBuf out(info.num_output_ch > 0 ? info.num_output_ch : 1, nframes);
+
+    for (auto _ : state)
+        mh_process(p, in.in(), out.out(), nframes);
+
+    setAudioCounters(state, nframes);
+    mh_close(p);
+}
+BENCHMARK(BM_ProcessDispatch)->Arg(64)->Arg(128)->Arg(256)->Arg(512)->Arg(1024);
+
+// ---------------------------------------------------------------- //
+// mh_chain_process (plugin required; chain of N instances)          //
+// ---------------------------------------------------------------- //
+
+void BM_ChainProcess(benchmark::State& state)
+{
+    const char* path = benchPluginPath();
+    if (path == nullptr)
+    {
+        state.SkipWithError("MINIHOST_BENCH_PLUGIN not set");
+        return;
+    }
+
+    const int num_plugins = (int) state.range(0);
+    const int nframes     = 512;
+
+    char err[256];
+    std::vector<MH_Plugin*> plugins;
+    for (int i = 0; i < num_plugins; ++i)
+    {
+        MH_Plugin* p = mh_open(path, kSampleRate, kMaxBlockSize, 0, 0,
+                               err, sizeof(err));
+        if (p == nullptr)
+        {
+            for (MH_Plugin* q : plugins) mh_close(q);
+            state.SkipWithError(err);
+            return;
+        }
+        plugins.push_back(p);
+    }
+
+    MH_PluginChain* chain = mh_chain_create(plugins.data(), num_plugins,
+                                            err, sizeof(err));
+    if (chain == nullptr)
+    {
+        for (MH_Plugin* q : plugins) mh_close(q);
+        state.SkipWithError(err);
+        return;
+    }
+
+    PlanarBuf in(mh_chain_get_num_input_channels(chain) > 0
+                     ? mh_chain_get_num_input_channels(chain) : 1, nframes);
+    PlanarBuf out(mh_chain_get_num_output_channels(chain) > 0
+                      ? mh_chain_get_num_output_channels(chain) : 1, nframes);
+
+    for (auto _ : state)
+        mh_chain_process(chain, in.in(), out.out(), nframes);
+
+    setAudioCounters(state, nframes);
+    mh_chain_close(chain);
+    for (MH_Plugin* q : plugins) mh_close(q);
+}
+BENCHMARK(BM_ChainProcess)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+// ---------------------------------------------------------------- //
+// mh_graph_render_block on synthetic topologies (no plugin)         //
+// ---------------------------------------------------------------- //
+
+// N parallel input branches mixed into one output: measures the
+// scheduler, buffer pool, and mix kernel without plugin cost.
+void BM_GraphFanInMix(benchmark::State& state)
+{
+    const int branches = (int) state.range(0);
+    const int nframes  = 512;
+    const int channels = 2;
+
+    char err[256];
+    MH_PluginGraph* g = mh_graph_create(kMaxBlockSize, kSampleRate,
+                                        err, sizeof(err));
+    if (g == nullptr) { state.SkipWithError(err); return; }
+
+    std::vector<MH_NodeId> inputs;
+    for (int i = 0; i < branches; ++i)
+        inputs.push_back(mh_graph_add_input(g, channels, err, sizeof(err)));
+    MH_NodeId mix = mh_graph_add_mix(g, branches, channels, err, sizeof(err));
+    MH_NodeId out = mh_graph_add_output(g, channels, err, sizeof(err));
+    for (int i = 0; i < branches; ++i)
+        mh_graph_connect(g, inputs[(size_t) i], 0, mix, i, err, sizeof(err));
+    mh_graph_connect(g, mix, 0, out, 0, err, sizeof(err));
+    if (!mh_graph_compile(g, err, sizeof(err)))
+    {
+        mh_graph_close(g);
+        state.SkipWithError(err);
+        return;
+    }
+
+    std::vector<PlanarBuf> in_bufs;
+    in_bufs.reserve((size_t) branches);
+    std::vector<const float* const*> in_tops;
+    for (int i = 0; i < branches; ++i)
+    {
+        in_bufs.emplace_back(channels, nframes);
+        in_tops.push_back(in_bufs.back().in());
+    }
+    PlanarBuf out_buf(channels, nframes);
+    float* const* out_top[1] = { out_buf.out() };
+
+    for (auto _ : state)
+        mh_graph_render_block(g, in_tops.data(), branches,
+                              out_top, 1, nframes);
+
+    setAudioCounters(state, nframes);
+    mh_graph_close(g);
+}
+BENCHMARK(BM_GraphFanInMix)->Arg(2)->Arg(8)->Arg(32);
+
+// ---------------------------------------------------------------- //
+// Synthetic topology generator (no plugin)                          //
+// ---------------------------------------------------------------- //
+//
+// Parameterized graph families for scheduler-scaling regression runs:
+// wide fan-out, deep chains, diamond fan-out/fan-in, and seeded random
+// DAGs. The "busy" node standing in for a plugin is a convolve node
+// whose impulse response is sized in partitions: per block it costs
+// one forward FFT plus `cost_parts` complex multiply-accumulates per
+// channel -- real, deterministic DSP work with an allocation-free
+// render path, so the scaling curves do not depend on a wall-clock
+// busy-wait or on machine-specific timer resolution.
+
+constexpr int kSynthBlock    = 512;  // graph max block == render block
+constexpr int kSynthChannels = 2;
+constexpr int kSynthCost     = 4;    // busy-node weight in IR partitions
+
+// Deterministic 32-bit LCG (numerical recipes constants) so random
+// DAG shapes and IR contents reproduce across runs and machines.
+struct BenchRng {
+    unsigned state;
+    explicit BenchRng(unsigned seed) : state(seed != 0 ? seed : 1u) {}
+    unsigned next() { state = state * 1664525u + 1013904223u; return state; }
+    int below(int n) { return (int)(next() % (unsigned) n); }
+};
+
+// One busy node: a convolve whose IR spans cost_parts partitions of
+// the graph block size. A dense low-level noise tail keeps every
+// partition spectrum non-trivial (an all-zero tail would still be
+// multiplied, but this guards against future sparsity optimizations
+// quietly hollowing out the benchmark).
+MH_NodeId addBusyNode(MH_PluginGraph* g, int cost_parts, BenchRng& rng,
+                      char* err, size_t err_size)
+{
+    std::vector<float> ir((size_t) cost_parts * (size_t) kSynthBlock);
+    ir[0] = 1.0f;
+    for (size_t i = 1; i < ir.size(); ++i)
+        ir[i] = (float)((int)((rng.next() >> 16) & 0xffu) - 128)
+              / (1024.0f * (float) cost_parts * 128.0f);
+    const float* ir_ptr = ir.data();
+    return mh_graph_add_convolve(g, kSynthChannels, &ir_ptr, 1,
+                                 (int) ir.size(), err, err_size);
+}
+
+// width parallel busy branches between one input and a mix: the widest
+// schedulable level, where worker scaling should be near-linear until
+// the mix barrier dominates.
+MH_PluginGraph* makeFanout(int width, int cost_parts, int threads,
+                           char* err, size_t err_size)
+{
+    MH_PluginGraph* g = mh_graph_create(kSynthBlock, kSampleRate,
+                                        err, err_size);
+    if (g == nullptr) return nullptr;
+    mh_graph_set_num_threads(g, threads);
+
+    BenchRng rng(0xb00f5u);
+    MH_NodeId in  = mh_graph_add_input(g, kSynthChannels, err, err_size);
+    MH_NodeId mix = mh_graph_add_mix(g, width, kSynthChannels, err, err_size);
+    MH_NodeId out = mh_graph_add_output(g, kSynthChannels, err, err_size);
+    bool ok = in >= 0 && mix >= 0 && out >= 0;
+    for (int i = 0; ok && i < width; ++i)
+    {
+        MH_NodeId busy = addBusyNode(g, cost_parts, rng, err, err_size);
+        ok = busy >= 0
+            && mh_graph_connect(g, in, 0, busy, 0, err, err_size)
+            && mh_graph_connect(g, busy, 0, mix, i, err, err_size);
+    }
+    if (!ok
+        || !mh_graph_connect(g, mix, 0, out, 0, err, err_size)
+        || !mh_graph_compile(g, err, err_size))
+    {
+        mh_graph_close(g);
+        return nullptr;
+    }
+    return g;
+}
+
+// depth busy nodes in series: zero exploitable parallelism, so this is
+// the worst case for any scheduling overhead the executor adds per
+// level. Rendered serially regardless of the thread count.
+MH_PluginGraph* makeDeepChain(int depth, int cost_parts, int threads,
+                              char* err, size_t err_size)
+{
+    MH_PluginGraph* g = mh_graph_create(kSynthBlock, kSampleRate,
+                                        err, err_size);
+    if (g == nullptr) return nullptr;
+    mh_graph_set_num_threads(g, threads);
+
+    BenchRng rng(0xdeec0u);
+    MH_NodeId in  = mh_graph_add_input(g, kSynthChannels, err, err_size);
+    MH_NodeId out = mh_graph_add_output(g, kSynthChannels, err, err_size);
+    bool ok = in >= 0 && out >= 0;
+    MH_NodeId prev = in;
+    for (int i = 0; ok && i < depth; ++i)
+    {
+        MH_NodeId busy = addBusyNode(g, cost_parts, rng, err, err_size);
+        ok = busy >= 0
+            && mh_graph_connect(g, prev, 0, busy, 0, err, err_size);
+        prev = busy;
+    }
+    if (!ok
+        || !mh_graph_connect(g, prev, 0, out, 0, err, err_size)
+        || !mh_graph_compile(g, err, err_size))
+    {
+        mh_graph_close(g);
+        return nullptr;
+    }
+    return g;
+}
+
+// Diamond: one busy head fans out to width busy branches which fan
+// back into a mix and one busy tail. Exercises the serial -> parallel
+// -> serial level transitions, where barrier cost shows up.
+MH_PluginGraph* makeDiamond(int width, int cost_parts, int threads,
+                            char* err, size_t err_size)
+{
+    MH_PluginGraph* g = mh_graph_create(kSynthBlock, kSampleRate,
+                                        err, err_size);
+    if (g == nullptr) return nullptr;
+    mh_graph_set_num_threads(g, threads);
+
+    BenchRng rng(0xd1a0du);
+    MH_NodeId in   = mh_graph_add_input(g, kSynthChannels, err, err_size);
+    MH_NodeId head = addBusyNode(g, cost_parts, rng, err, err_size);
+    MH_NodeId mix  = mh_graph_add_mix(g, width, kSynthChannels, err, err_size);
+    MH_NodeId tail = addBusyNode(g, cost_parts, rng, err, err_size);
+    MH_NodeId out  = mh_graph_add_output(g, kSynthChannels, err, err_size);
+    bool ok = in >= 0 && head >= 0 && mix >= 0 && tail >= 0 && out >= 0
+        && mh_graph_connect(g, in, 0, head, 0, err, err_size);
+    for (int i = 0; ok && i < width; ++i)
+    {
+        MH_NodeId busy = addBusyNode(g, cost_parts, rng, err, err_size);
+        ok = busy >= 0
+            && mh_graph_connect(g, head, 0, busy, 0, err, err_size)
+            && mh_graph_connect(g, busy, 0, mix, i, err, err_size);
+    }
+    if (!ok
+        || !mh_graph_connect(g, mix, 0, tail, 0, err, err_size)
+        || !mh_graph_connect(g, tail, 0, out, 0, err, err_size)
+        || !mh_graph_compile(g, err, err_size))
+    {
+        mh_graph_close(g);
+        return nullptr;
+    }
+    return g;
+}
+
+// Seeded random DAG: num_nodes busy nodes in addition order, each
+// drawing its source uniformly from the input node and all earlier
+// busy nodes -- later draws deepen some branches while leaving others
+// wide, giving irregular level widths. Unconsumed nodes are mixed
+// into the output so nothing is dead-code-eliminated by the compile.
+MH_PluginGraph* makeRandomDag(int num_nodes, int cost_parts, int threads,
+                              unsigned seed, char* err, size_t err_size)
+{
+    MH_PluginGraph* g = mh_graph_create(kSynthBlock, kSampleRate,
+                                        err, err_size);
+    if (g == nullptr) return nullptr;
+    mh_graph_set_num_threads(g, threads);
+
+    BenchRng rng(seed);
+    MH_NodeId in = mh_graph_add_input(g, kSynthChannels, err, err_size);
+    bool ok = in >= 0;
+
+    std::vector<MH_NodeId> ids;
+    std::vector<char> consumed;
+    ids.push_back(in);
+    consumed.push_back(0);
+    for (int i = 0; ok && i < num_nodes; ++i)
+    {
+        MH_NodeId busy = addBusyNode(g, cost_parts, rng, err, err_size);
+        const int src = rng.below((int) ids.size());
+        ok = busy >= 0
+            && mh_graph_connect(g, ids[(size_t) src], 0, busy, 0,
+                                err, err_size);
+        consumed[(size_t) src] = 1;
+        ids.push_back(busy);
+        consumed.push_back(0);
+    }
+
+    std::vector<MH_NodeId> sinks;
+    for (size_t i = 1; i < ids.size(); ++i)  // input alone is never a sink
+        if (!consumed[i])
+            sinks.push_back(ids[i]);
+
+    MH_NodeId mix = ok ? mh_graph_add_mix(g, (int) sinks.size(),
+                                          kSynthChannels, err, err_size)
+                       : -1;
+    MH_NodeId out = ok ? mh_graph_add_output(g, kSynthChannels,
+                                             err, err_size)
+                       : -1;
+    ok = ok && mix >= 0 && out >= 0;
+    for (size_t i = 0; ok && i < sinks.size(); ++i)
+        ok = mh_graph_connect(g, sinks[i], 0, mix, (int) i,
+                              err, err_size) != 0;
+    if (!ok
+        || !mh_graph_connect(g, mix, 0, out, 0, err, err_size)
+        || !mh_graph_compile(g, err, err_size))
+    {
+        mh_graph_close(g);
+        return nullptr;
+    }
+    return g;
+}
+
+// Shared render loop over a compiled single-input/single-output graph.
+void runSynthGraph(benchmark::State& state, MH_PluginGraph* g)
+{
+    if (g == nullptr) return;  // caller already set the skip error
+    PlanarBuf in_buf(kSynthChannels, kSynthBlock);
+    PlanarBuf out_buf(kSynthChannels, kSynthBlock);
+    const float* const* in_top[1]  = { in_buf.in() };
+    float* const*       out_top[1] = { out_buf.out() };
+
+    for (auto _ : state)
+        mh_graph_render_block(g, in_top, 1, out_top, 1, kSynthBlock);
+
+    setAudioCounters(state, kSynthBlock);
+    mh_graph_close(g);
+}
+
+void BM_GraphSynthFanout(benchmark::State& state)
+{
+    char err[256] = {0};
+    MH_PluginGraph* g = makeFanout((int) state.range(0), kSynthCost,
+                                   (int) state.range(1), err, sizeof(err));
+    if (g == nullptr) { state.SkipWithError(err); return; }
+    runSynthGraph(state, g);
+}
+BENCHMARK(BM_GraphSynthFanout)->ArgsProduct({{4, 16, 64}, {1, 2, 4}});
+
+void BM_GraphSynthDeepChain(benchmark::State& state)
+{
+    char err[256] = {0};
+    MH_PluginGraph* g = makeDeepChain((int) state.range(0), kSynthCost,
+                                      (int) state.range(1), err, sizeof(err));
+    if (g == nullptr) { state.SkipWithError(err); return; }
+    runSynthGraph(state, g);
+}
+BENCHMARK(BM_GraphSynthDeepChain)->ArgsProduct({{4, 16, 64}, {1, 4}});
+
+void BM_GraphSynthDiamond(benchmark::State& state)
+{
+    char err[256] = {0};
+    MH_PluginGraph* g = makeDiamond((int) state.range(0), kSynthCost,
+                                    (int) state.range(1), err, sizeof(err));
+    if (g == nullptr) { state.SkipWithError(err); return; }
+    runSynthGraph(state, g);
+}
+BENCHMARK(BM_GraphSynthDiamond)->ArgsProduct({{2, 8, 32}, {1, 4}});
+
+void BM_GraphSynthRandomDag(benchmark::State& state)
+{
+    char err[256] = {0};
+    MH_PluginGraph* g = makeRandomDag((int) state.range(0), kSynthCost,
+                                      (int) state.range(1), 0x5eedu,
+                                      err, sizeof(err));
+    if (g == nullptr) { state.SkipWithError(err); return; }
+    runSynthGraph(state, g);
+}
+BENCHMARK(BM_GraphSynthRandomDag)->ArgsProduct({{8, 32, 128}, {1, 4}});
+
+// ---------------------------------------------------------------- //
+// mh_audio_ringbuffer push / read_into                              //
+// ---------------------------------------------------------------- //
+
+void BM_RingBufferPushRead(benchmark::State& state)
+{
+    const int channels = 2;
+    const int nframes  = (int) state.range(0);
+
+    MH_AudioRingBuffer* rb = mh_audio_ringbuffer_create(channels,
+                                                        nframes * 8);
+    if (rb == nullptr) { state.SkipWithError("ringbuffer create failed"); return; }
+
+    std::vector<float> interleaved((size_t)(channels * nframes), 0.25f);
+    PlanarBuf planar(channels, nframes);
+
+    for (auto _ : state)
+    {
+        mh_audio_ringbuffer_push(rb, interleaved.data(), nframes);
+        mh_audio_ringbuffer_read_into(rb, planar.out(), nframes, channels);
+    }
+
+    setAudioCounters(state, nframes);
+    mh_audio_ringbuffer_free(rb);
+}
+BENCHMARK(BM_RingBufferPushRead)->Arg(128)->Arg(512)->Arg(2048);
+
+// ---------------------------------------------------------------- //
+// mh_morph_lerp                                                     //
+// ---------------------------------------------------------------- //
+
+void BM_MorphLerp(benchmark::State& state)
+{
+    const int count = (int) state.range(0);
+    std::vector<float> a((size_t) count, 0.2f);
+    std::vector<float> b((size_t) count, 0.8f);
+    std::vector<float> out((size_t) count, 0.0f);
+
+    for (auto _ : state)
+    {
+        mh_morph_lerp(a.data(), b.data(), out.data(), count, 0.37f);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.counters["params_per_sec"] = benchmark::Counter(
+        (double) state.iterations() * (double) count,
+        benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MorphLerp)->Arg(8)->Arg(64)->Arg(512)->Arg(4096);
+
+// ---------------------------------------------------------------- //
+// Audiofile encode / decode                                         //
+// ---------------------------------------------------------------- //
+
+std::string benchTempFile(const char* ext)
+{
+    const char* dir = std::getenv("TMPDIR");
+    if (dir == nullptr || *dir == '\0') dir = "/tmp";
+    return std::string(dir) + "/minihost_bench_audiofile." + ext;
+}
+
+// One second of stereo test signal, interleaved.
+std::vector<float> benchTestSignal()
+{
+    std::vector<float> data((size_t)(2 * kSampleRate));
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = 0.5f * (float)((i * 2654435761u & 0xffffu) / 65535.0 - 0.5);
+    return data;
+}
+
+void BM_AudioFileEncode(benchmark::State& state, const char* ext,
+                        int bit_depth)
+{
+    const std::vector<float> data = benchTestSignal();
+    const unsigned int frames = (unsigned int)(data.size() / 2);
+    const std::string path = benchTempFile(ext);
+    char err[256];
+
+    for (auto _ : state)
+    {
+        if (!mh_audio_write(path.c_str(), data.data(), 2, frames,
+                            (unsigned int) kSampleRate, bit_depth,
+                            err, sizeof(err)))
+        {
+            state.SkipWithError(err);
+            break;
+        }
+    }
+
+    // Rendered seconds encoded per wall-clock second.
+    state.counters["x_realtime"] = benchmark::Counter(
+        (double) state.iterations() * frames / kSampleRate,
+        benchmark::Counter::kIsRate);
+    std::remove(path.c_str());
+}
+BENCHMARK_CAPTURE(BM_AudioFileEncode, wav16, "wav", 16);
+BENCHMARK_CAPTURE(BM_AudioFileEncode, wav32f, "wav", 32);
+BENCHMARK_CAPTURE(BM_AudioFileEncode, flac16, "flac", 16);
+
+void BM_AudioFileDecode(benchmark::State& state, const char* ext,
+                        int bit_depth)
+{
+    const std::vector<float> data = benchTestSignal();
+    const unsigned int frames = (unsigned int)(data.size() / 2);
+    const std::string path = benchTempFile(ext);
+    char err[256];
+    if (!mh_audio_write(path.c_str(), data.data(), 2, frames,
+                        (unsigned int) kSampleRate, bit_depth,
+                        err, sizeof(err)))
+    {
+        state.SkipWithError(err);
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        MH_AudioData* decoded = mh_audio_read(path.c_str(), err, sizeof(err));
+        if (decoded == nullptr)
+        {
+            state.SkipWithError(err);
+            break;
+        }
+        benchmark::DoNotOptimize(decoded->data);
+        mh_audio_data_free(decoded);
+    }
+
+    state.counters["x_realtime"] = benchmark::Counter(
+        (double) state.iterations() * frames / kSampleRate,
+        benchmark::Counter::kIsRate);
+    std::remove(path.c_str());
+}
+BENCHMARK_CAPTURE(BM_AudioFileDecode, wav16, "wav", 16);
+BENCHMARK_CAPTURE(BM_AudioFileDecode, wav32f, "wav", 32);
+BENCHMARK_CAPTURE(BM_AudioFileDecode, flac16, "flac", 16);
+
+} // namespace
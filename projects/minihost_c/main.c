@@ -552,17 +552,45 @@ static int cmd_params(const char* plugin_path, double sample_rate, int block_siz
         printf("\n]\n");
     } else if (verbose) {
         printf("Parameters (%d):\n", num_params);
+
+        /* Min / max / default display strings for the whole table in
+         * one bulk call: per-call mh_param_to_text costs a
+         * message-thread hop plus a lock each, which stutters on
+         * large parameter sets. */
+        enum { TEXT_STRIDE = 128 };
+        int* text_indices = NULL;
+        float* text_values = NULL;
+        char* texts = NULL;
+        if (num_params > 0) {
+            text_indices = (int*)malloc((size_t)num_params * 3 * sizeof(int));
+            text_values = (float*)malloc((size_t)num_params * 3 * sizeof(float));
+            texts = (char*)calloc((size_t)num_params * 3, TEXT_STRIDE);
+        }
+
+        if (text_indices && text_values && texts) {
+            for (int i = 0; i < num_params; i++) {
+                MH_ParamInfo info;
+                float def = 0.0f;
+                if (mh_get_param_info(p, i, &info)) def = info.default_value;
+                text_indices[i * 3 + 0] = i;
+                text_indices[i * 3 + 1] = i;
+                text_indices[i * 3 + 2] = i;
+                text_values[i * 3 + 0] = 0.0f;
+                text_values[i * 3 + 1] = 1.0f;
+                text_values[i * 3 + 2] = def;
+            }
+            mh_params_to_text_bulk(p, text_indices, text_values,
+                                   num_params * 3, texts, TEXT_STRIDE);
+        }
+
         for (int i = 0; i < num_params; i++) {
             MH_ParamInfo info;
             if (mh_get_param_info(p, i, &info)) {
                 float value = mh_get_param(p, i);
 
-                char min_text[128] = {0};
-                char max_text[128] = {0};
-                char default_text[128] = {0};
-                mh_param_to_text(p, i, 0.0f, min_text, sizeof(min_text));
-                mh_param_to_text(p, i, 1.0f, max_text, sizeof(max_text));
-                mh_param_to_text(p, i, info.default_value, default_text, sizeof(default_text));
+                const char* min_text = texts ? texts + (i * 3 + 0) * TEXT_STRIDE : "";
+                const char* max_text = texts ? texts + (i * 3 + 1) * TEXT_STRIDE : "";
+                const char* default_text = texts ? texts + (i * 3 + 2) * TEXT_STRIDE : "";
 
                 printf("  [%3d] %s\n", i, info.name);
                 printf("         Value:   %.4f", value);
@@ -587,6 +615,10 @@ static int cmd_params(const char* plugin_path, double sample_rate, int block_siz
                 }
             }
         }
+
+        free(text_indices);
+        free(text_values);
+        free(texts);
     } else {
         printf("Parameters (%d):\n", num_params);
         for (int i = 0; i < num_params; i++) {
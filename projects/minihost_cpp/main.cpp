@@ -3,6 +3,7 @@
 
 #include "minihost.h"
 #include "minihost_audio.h"
+#include "minihost_chain.h"
 #include "minihost_audiofile.h"
 #include "minihost_midi.h"
 #include "minihost_vstpreset.h"
@@ -11,19 +12,37 @@
 #include "include/CLI11.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 volatile sig_atomic_t g_running = 1;
 
 void sigint_handler(int) { g_running = 0; }
@@ -109,15 +128,15 @@ static bool parse_param_spec(MH_Plugin* p, const std::string& spec,
         return out_index >= 0 && out_index < mh_get_num_params(p);
     }
 
-    // Try as parameter name (case-insensitive substring match)
+    // Try as parameter name (exact match against the bulk table)
     int num_params = mh_get_num_params(p);
-    for (int i = 0; i < num_params; i++) {
-        MH_ParamInfo info;
-        if (mh_get_param_info(p, i, &info)) {
-            if (name_part == info.name) {
-                out_index = i;
-                return true;
-            }
+    std::vector<MH_ParamInfo> infos((size_t)num_params);
+    int fetched = num_params > 0
+        ? mh_get_all_param_info(p, infos.data(), num_params) : 0;
+    for (int i = 0; i < fetched; i++) {
+        if (name_part == infos[(size_t)i].name) {
+            out_index = i;
+            return true;
         }
     }
 
@@ -230,15 +249,26 @@ static bool load_midi_file(const std::string& path, double sample_rate,
 // Command: probe
 // ============================================================================
 
-int cmd_probe(const std::string& plugin_path, bool json_output) {
+int cmd_probe(const std::string& plugin_path, bool json_output,
+              bool binary_output = false) {
     MH_PluginDesc desc;
     char err[1024] = {0};
 
     if (!mh_probe(plugin_path.c_str(), &desc, err, sizeof(err))) {
-        print_error(err);
+        if (!binary_output) print_error(err);
         return 1;
     }
 
+    // Binary mode: write the raw MH_PluginDesc to stdout. Used as the
+    // worker end of `scan --isolated`, which probes each candidate in a
+    // subprocess and reads the record back over a pipe.
+    if (binary_output) {
+        std::snprintf(desc.path, sizeof(desc.path), "%s", plugin_path.c_str());
+        if (std::fwrite(&desc, sizeof(desc), 1, stdout) != 1) return 1;
+        std::fflush(stdout);
+        return 0;
+    }
+
     if (json_output) {
         std::printf("{\n");
         std::printf("  \"name\": \"%s\",\n", desc.name);
@@ -316,6 +346,182 @@ int cmd_scan(const std::string& directory, bool json_output) {
     return 0;
 }
 
+// ============================================================================
+// Command: scan --isolated
+// ============================================================================
+//
+// Crash-isolated parallel scan: one bad plugin can abort the probing
+// process outright (a crash inside its dlopen/factory code), which is why
+// the in-process scan has to be treated as fragile. Here each candidate is
+// probed by a short-lived `minihost probe --binary` subprocess and the
+// MH_PluginDesc record is read back over a pipe; a crashing or failing
+// worker just loses that one candidate. Isolation is also what makes
+// probing in parallel safe, so up to `jobs` workers run concurrently.
+// Not available on Windows (falls back to the in-process serial scan).
+
+// Set from argv[0] so workers re-exec this same binary.
+static const char* g_self_exe = "minihost";
+
+// Collect plugin bundle/file candidates the way mh_scan_directory does:
+// *.vst3 everywhere, *.component on macOS, *.lv2 when LV2 is enabled.
+// A matching entry is a leaf -- never descended into.
+static std::vector<std::string> find_plugin_candidates(const std::string& directory) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> out;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(
+        directory, fs::directory_options::skip_permission_denied, ec);
+    fs::recursive_directory_iterator end;
+    for (; !ec && it != end; it.increment(ec)) {
+        std::string ext = it->path().extension().string();
+        for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        bool match = ext == ".vst3";
+#ifdef __APPLE__
+        match = match || ext == ".component";
+#endif
+        match = match || ext == ".lv2";
+        if (match) {
+            out.push_back(it->path().string());
+            std::error_code dir_ec;
+            if (it->is_directory(dir_ec))
+                it.disable_recursion_pending();  // bundle is a leaf
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+#ifndef _WIN32
+
+struct ProbeWorker {
+    pid_t pid;
+    int fd;            // read end of the worker's stdout pipe
+};
+
+// Spawn `minihost probe --binary <path>` with stdout piped back to us.
+// Returns false if the process could not be started.
+static bool spawn_probe_worker(const std::string& path, ProbeWorker& out) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        // Child: stdout -> pipe, stderr -> /dev/null (a crashing plugin
+        // may spew; the scan output must stay clean).
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDERR_FILENO);
+            close(devnull);
+        }
+        execlp(g_self_exe, g_self_exe, "probe", "--binary", path.c_str(),
+               (char*) nullptr);
+        _exit(127);
+    }
+    close(fds[1]);
+    out.pid = pid;
+    out.fd = fds[0];
+    return true;
+}
+
+// Read the worker's record after it exited. The record (~1.5 KB) is far
+// below the pipe buffer, so the child never blocks on write and the full
+// payload is drainable post-exit. Returns true iff a whole, valid record
+// arrived and the worker exited cleanly.
+static bool read_probe_record(const ProbeWorker& w, int status, MH_PluginDesc& desc) {
+    size_t got = 0;
+    char* dst = reinterpret_cast<char*>(&desc);
+    for (;;) {
+        ssize_t n = read(w.fd, dst + got, sizeof(desc) - got);
+        if (n <= 0) break;
+        got += (size_t) n;
+        if (got == sizeof(desc)) break;
+    }
+    close(w.fd);
+    return got == sizeof(desc) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int cmd_scan_isolated(const std::string& directory, int jobs, bool json_output) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::is_directory(directory, ec)) {
+        print_error("Failed to scan directory");
+        return 1;
+    }
+
+    std::vector<std::string> paths = find_plugin_candidates(directory);
+
+    if (jobs < 1) jobs = 1;
+    if (jobs > 64) jobs = 64;
+    if (jobs > (int) paths.size()) jobs = (int) paths.size();
+
+    ScanContext ctx{json_output, 0, true};
+    if (json_output) std::printf("[\n");
+
+    std::vector<std::pair<ProbeWorker, bool>> workers;  // worker, slot-live
+    size_t next = 0;
+    int active = 0;
+    int failed = 0;
+
+    while (next < paths.size() || active > 0) {
+        while (active < jobs && next < paths.size()) {
+            ProbeWorker w;
+            if (spawn_probe_worker(paths[next], w)) {
+                workers.emplace_back(w, true);
+                ++active;
+            } else {
+                ++failed;
+            }
+            ++next;
+        }
+        if (active == 0) break;
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) break;
+        for (auto& [w, live] : workers) {
+            if (!live || w.pid != pid) continue;
+            MH_PluginDesc desc;
+            if (read_probe_record(w, status, desc))
+                scan_callback(&desc, &ctx);
+            else
+                ++failed;  // probe error or crash -- candidate skipped
+            live = false;
+            --active;
+            break;
+        }
+    }
+
+    if (json_output) {
+        if (ctx.count > 0) std::printf("\n");
+        std::printf("]\n");
+    } else {
+        std::printf("\nFound %d plugin(s)\n", ctx.count);
+        if (failed > 0)
+            std::printf("(%d candidate(s) failed to probe or crashed)\n", failed);
+    }
+    return 0;
+}
+
+#else  // _WIN32
+
+int cmd_scan_isolated(const std::string& directory, int jobs, bool json_output) {
+    (void) jobs;
+    std::fprintf(stderr,
+                 "warning: --isolated is not supported on Windows; "
+                 "scanning in-process\n");
+    return cmd_scan(directory, json_output);
+}
+
+#endif
+
 // ============================================================================
 // Command: info
 // ============================================================================
@@ -446,71 +652,88 @@ int cmd_params(const std::string& plugin_path,
 
     int num_params = mh_get_num_params(p);
 
+    // One bulk call for the whole table (per-index mh_get_param_info
+    // costs a message-thread hop each).
+    std::vector<MH_ParamInfo> infos((size_t)num_params);
+    int fetched = num_params > 0
+        ? mh_get_all_param_info(p, infos.data(), num_params) : 0;
+
     if (json_output) {
         std::printf("[\n");
-        for (int i = 0; i < num_params; i++) {
-            MH_ParamInfo info;
-            if (mh_get_param_info(p, i, &info)) {
-                float value = mh_get_param(p, i);
-                if (i > 0) std::printf(",\n");
-                std::printf("  {\n");
-                std::printf("    \"index\": %d,\n", i);
-                std::printf("    \"name\": \"%s\",\n", info.name);
-                std::printf("    \"label\": \"%s\",\n", info.label);
-                std::printf("    \"value\": %.6f,\n", value);
-                std::printf("    \"value_str\": \"%s\",\n", info.current_value_str);
-                std::printf("    \"default\": %.6f,\n", info.default_value);
-                std::printf("    \"automatable\": %s,\n", info.is_automatable ? "true" : "false");
-                std::printf("    \"boolean\": %s,\n", info.is_boolean ? "true" : "false");
-                std::printf("    \"steps\": %d\n", info.num_steps);
-                std::printf("  }");
-            }
+        for (int i = 0; i < fetched; i++) {
+            const MH_ParamInfo& info = infos[(size_t)i];
+            float value = mh_get_param(p, i);
+            if (i > 0) std::printf(",\n");
+            std::printf("  {\n");
+            std::printf("    \"index\": %d,\n", i);
+            std::printf("    \"name\": \"%s\",\n", info.name);
+            std::printf("    \"label\": \"%s\",\n", info.label);
+            std::printf("    \"value\": %.6f,\n", value);
+            std::printf("    \"value_str\": \"%s\",\n", info.current_value_str);
+            std::printf("    \"default\": %.6f,\n", info.default_value);
+            std::printf("    \"automatable\": %s,\n", info.is_automatable ? "true" : "false");
+            std::printf("    \"boolean\": %s,\n", info.is_boolean ? "true" : "false");
+            std::printf("    \"steps\": %d\n", info.num_steps);
+            std::printf("  }");
         }
         std::printf("\n]\n");
     } else if (verbose) {
         std::printf("Parameters (%d):\n", num_params);
-        for (int i = 0; i < num_params; i++) {
-            MH_ParamInfo info;
-            if (mh_get_param_info(p, i, &info)) {
-                float value = mh_get_param(p, i);
 
-                char min_text[128] = {0};
-                char max_text[128] = {0};
-                char default_text[128] = {0};
-                mh_param_to_text(p, i, 0.0f, min_text, sizeof(min_text));
-                mh_param_to_text(p, i, 1.0f, max_text, sizeof(max_text));
-                mh_param_to_text(p, i, info.default_value, default_text, sizeof(default_text));
-
-                std::printf("  [%3d] %s\n", i, info.name);
-                std::printf("         Value:   %.4f", value);
-                if (info.label[0] != '\0') std::printf(" %s", info.label);
-                std::printf(" (%s)\n", info.current_value_str);
-                std::printf("         Range:   %s .. %s\n", min_text, max_text);
-                std::printf("         Default: %.4f (%s)\n", info.default_value, default_text);
-
-                // Flags
-                std::string flags;
-                if (info.is_automatable) {
-                    if (!flags.empty()) flags += ", ";
-                    flags += "automatable";
-                }
-                if (info.num_steps > 0) {
-                    if (!flags.empty()) flags += ", ";
-                    flags += "discrete, " + std::to_string(info.num_steps) + " steps";
-                }
-                if (!flags.empty()) {
-                    std::printf("         Flags:   %s\n", flags.c_str());
-                }
+        // Min / max / default display strings for the whole table in
+        // one bulk call (per-call mh_param_to_text costs a
+        // message-thread hop plus a lock each).
+        constexpr size_t kTextStride = 128;
+        std::vector<int> text_indices((size_t)fetched * 3);
+        std::vector<float> text_values((size_t)fetched * 3);
+        std::vector<char> texts((size_t)fetched * 3 * kTextStride, '\0');
+        for (int i = 0; i < fetched; i++) {
+            text_indices[(size_t)i * 3 + 0] = i;
+            text_indices[(size_t)i * 3 + 1] = i;
+            text_indices[(size_t)i * 3 + 2] = i;
+            text_values[(size_t)i * 3 + 0] = 0.0f;
+            text_values[(size_t)i * 3 + 1] = 1.0f;
+            text_values[(size_t)i * 3 + 2] = infos[(size_t)i].default_value;
+        }
+        if (fetched > 0) {
+            mh_params_to_text_bulk(p, text_indices.data(), text_values.data(),
+                                   fetched * 3, texts.data(), kTextStride);
+        }
+
+        for (int i = 0; i < fetched; i++) {
+            const MH_ParamInfo& info = infos[(size_t)i];
+            float value = mh_get_param(p, i);
+
+            const char* min_text = texts.data() + ((size_t)i * 3 + 0) * kTextStride;
+            const char* max_text = texts.data() + ((size_t)i * 3 + 1) * kTextStride;
+            const char* default_text = texts.data() + ((size_t)i * 3 + 2) * kTextStride;
+
+            std::printf("  [%3d] %s\n", i, info.name);
+            std::printf("         Value:   %.4f", value);
+            if (info.label[0] != '\0') std::printf(" %s", info.label);
+            std::printf(" (%s)\n", info.current_value_str);
+            std::printf("         Range:   %s .. %s\n", min_text, max_text);
+            std::printf("         Default: %.4f (%s)\n", info.default_value, default_text);
+
+            // Flags
+            std::string flags;
+            if (info.is_automatable) {
+                if (!flags.empty()) flags += ", ";
+                flags += "automatable";
+            }
+            if (info.num_steps > 0) {
+                if (!flags.empty()) flags += ", ";
+                flags += "discrete, " + std::to_string(info.num_steps) + " steps";
+            }
+            if (!flags.empty()) {
+                std::printf("         Flags:   %s\n", flags.c_str());
             }
         }
     } else {
         std::printf("Parameters (%d):\n", num_params);
-        for (int i = 0; i < num_params; i++) {
-            MH_ParamInfo info;
-            if (mh_get_param_info(p, i, &info)) {
-                float value = mh_get_param(p, i);
-                print_param_info(i, info, value);
-            }
+        for (int i = 0; i < fetched; i++) {
+            float value = mh_get_param(p, i);
+            print_param_info(i, infos[(size_t)i], value);
         }
     }
 
@@ -766,7 +989,8 @@ int cmd_presets(const std::string& plugin_path,
                 int program_index,
                 const std::string& state_file_input,
                 const std::string& load_vstpreset_file,
-                bool overwrite) {
+                bool overwrite,
+                double audition_seconds) {
     char err[1024] = {0};
 
     MH_Plugin* p = mh_open(plugin_path.c_str(), sample_rate, block_size, 2, 2, err, sizeof(err));
@@ -889,6 +1113,74 @@ int cmd_presets(const std::string& plugin_path,
         return 0;
     }
 
+    // Audition mode: prefetch the whole bank once (the slow per-switch
+    // path runs here, up front), then step through every program with
+    // mh_set_program_fast while playing a test note. The device is
+    // paused around each switch -- program-state restore is not safe to
+    // overlap the audio callback (thread-safety class 3).
+    if (audition_seconds > 0.0) {
+        int num_programs = mh_get_num_programs(p);
+        if (num_programs == 0) {
+            std::fprintf(stderr, "Error: plugin has no factory presets\n");
+            mh_close(p);
+            return 1;
+        }
+
+        std::fprintf(stderr, "Prefetching %d program states...\n", num_programs);
+        if (mh_prefetch_programs(p) <= 0) {
+            std::fprintf(stderr, "Error: Failed to prefetch program states\n");
+            mh_close(p);
+            return 1;
+        }
+
+        MH_AudioConfig config = {};
+        config.sample_rate = sample_rate;
+        config.buffer_frames = block_size;
+        config.midi_input_port = -1;
+        config.midi_output_port = -1;
+        config.playback_device_index = -1;
+        config.capture_device_index = -1;
+
+        MH_AudioDevice* dev = mh_audio_open(p, &config, err, sizeof(err));
+        if (!dev) {
+            print_error(err);
+            mh_close(p);
+            return 1;
+        }
+
+        g_running = 1;
+        std::signal(SIGINT, sigint_handler);
+        std::fprintf(stderr, "Auditioning %d presets (%.1fs each, Ctrl+C to stop):\n",
+                     num_programs, audition_seconds);
+
+        const auto hold = std::chrono::duration<double>(audition_seconds);
+        for (int i = 0; i < num_programs && g_running; i++) {
+            if (!mh_set_program_fast(p, i)) {
+                std::fprintf(stderr, "  [%3d] (switch failed, skipped)\n", i);
+                continue;
+            }
+            char name[256] = {0};
+            mh_get_program_name(p, i, name, sizeof(name));
+            std::printf("  [%3d] %s\n", i, name);
+            std::fflush(stdout);
+
+            if (!mh_audio_start(dev)) {
+                print_error("Failed to start audio");
+                break;
+            }
+            mh_audio_send_midi(dev, 0x90, 60, 100);  // middle C
+            std::this_thread::sleep_for(hold);
+            mh_audio_send_midi(dev, 0x80, 60, 0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(150));
+            mh_audio_stop(dev);
+        }
+
+        mh_audio_close(dev);
+        mh_clear_program_cache(p);
+        mh_close(p);
+        return 0;
+    }
+
     // Listing mode
     int num_programs = mh_get_num_programs(p);
     int current = mh_get_program(p);
@@ -1166,6 +1458,80 @@ int cmd_morph(const std::string& plugin_path, double sample_rate, int block_size
 // Command: process
 // ============================================================================
 
+// Shared setup for the process paths: load a state file, select a factory
+// preset, apply --param overrides (also recorded as first-block automation
+// changes), and set non-realtime mode and transport. Prints its own errors;
+// returns false on a fatal one (the caller closes the plugin).
+static bool configure_process_plugin(MH_Plugin* p,
+                                     const std::string& state_file,
+                                     int preset_index,
+                                     const std::vector<std::string>& param_specs,
+                                     bool non_realtime,
+                                     double bpm,
+                                     std::vector<MH_ParamChange>& param_changes) {
+    // --- Load state ---
+    if (!state_file.empty()) {
+        std::ifstream ifs(state_file, std::ios::binary);
+        if (ifs) {
+            std::vector<char> data((std::istreambuf_iterator<char>(ifs)),
+                                    std::istreambuf_iterator<char>());
+            if (mh_set_state(p, data.data(), static_cast<int>(data.size()))) {
+                std::fprintf(stderr, "Loaded state from %s\n", state_file.c_str());
+            } else {
+                std::fprintf(stderr, "Warning: Failed to load state from %s\n", state_file.c_str());
+            }
+        }
+    }
+
+    // --- Load preset ---
+    if (preset_index >= 0) {
+        int num_programs = mh_get_num_programs(p);
+        if (preset_index >= num_programs) {
+            std::fprintf(stderr, "Error: Preset index %d out of range (0-%d)\n",
+                         preset_index, num_programs - 1);
+            return false;
+        }
+        mh_set_program(p, preset_index);
+        char name[256] = {0};
+        mh_get_program_name(p, preset_index, name, sizeof(name));
+        std::fprintf(stderr, "Loaded preset [%d]: %s\n", preset_index, name);
+    }
+
+    // --- Apply static parameter overrides ---
+    for (const auto& spec : param_specs) {
+        int idx;
+        float val;
+        if (!parse_param_spec(p, spec, idx, val)) {
+            std::fprintf(stderr, "Error: Invalid parameter spec '%s'\n", spec.c_str());
+            return false;
+        }
+        // Apply as initial value and record for automation
+        mh_set_param(p, idx, val);
+        MH_ParamChange change;
+        change.sample_offset = 0;
+        change.param_index = idx;
+        change.value = val;
+        param_changes.push_back(change);
+    }
+
+    // --- Non-realtime mode ---
+    if (non_realtime) {
+        mh_set_non_realtime(p, 1);
+    }
+
+    // --- Transport ---
+    if (bpm > 0) {
+        MH_TransportInfo transport = {};
+        transport.bpm = bpm;
+        transport.time_sig_numerator = 4;
+        transport.time_sig_denominator = 4;
+        transport.is_playing = 1;
+        mh_set_transport(p, &transport);
+    }
+
+    return true;
+}
+
 int cmd_process(const std::string& plugin_path,
                 const std::string& input_file,
                 const std::string& output_file,
@@ -1249,67 +1615,12 @@ int cmd_process(const std::string& plugin_path,
         return 1;
     }
 
-    // --- Load state ---
-    if (!state_file.empty()) {
-        std::ifstream ifs(state_file, std::ios::binary);
-        if (ifs) {
-            std::vector<char> data((std::istreambuf_iterator<char>(ifs)),
-                                    std::istreambuf_iterator<char>());
-            if (mh_set_state(p, data.data(), static_cast<int>(data.size()))) {
-                std::fprintf(stderr, "Loaded state from %s\n", state_file.c_str());
-            } else {
-                std::fprintf(stderr, "Warning: Failed to load state from %s\n", state_file.c_str());
-            }
-        }
-    }
-
-    // --- Load preset ---
-    if (preset_index >= 0) {
-        int num_programs = mh_get_num_programs(p);
-        if (preset_index >= num_programs) {
-            std::fprintf(stderr, "Error: Preset index %d out of range (0-%d)\n",
-                         preset_index, num_programs - 1);
-            mh_close(p);
-            return 1;
-        }
-        mh_set_program(p, preset_index);
-        char name[256] = {0};
-        mh_get_program_name(p, preset_index, name, sizeof(name));
-        std::fprintf(stderr, "Loaded preset [%d]: %s\n", preset_index, name);
-    }
-
-    // --- Apply static parameter overrides ---
+    // --- Configure (state, preset, params, non-realtime, transport) ---
     std::vector<MH_ParamChange> param_changes;
-    for (const auto& spec : param_specs) {
-        int idx;
-        float val;
-        if (!parse_param_spec(p, spec, idx, val)) {
-            std::fprintf(stderr, "Error: Invalid parameter spec '%s'\n", spec.c_str());
-            mh_close(p);
-            return 1;
-        }
-        // Apply as initial value and record for automation
-        mh_set_param(p, idx, val);
-        MH_ParamChange change;
-        change.sample_offset = 0;
-        change.param_index = idx;
-        change.value = val;
-        param_changes.push_back(change);
-    }
-
-    // --- Non-realtime mode ---
-    if (non_realtime) {
-        mh_set_non_realtime(p, 1);
-    }
-
-    // --- Transport ---
-    if (bpm > 0) {
-        MH_TransportInfo transport = {};
-        transport.bpm = bpm;
-        transport.time_sig_numerator = 4;
-        transport.time_sig_denominator = 4;
-        transport.is_playing = 1;
-        mh_set_transport(p, &transport);
+    if (!configure_process_plugin(p, state_file, preset_index, param_specs,
+                                  non_realtime, bpm, param_changes)) {
+        mh_close(p);
+        return 1;
     }
 
     // --- Get plugin info ---
@@ -1514,32 +1825,1409 @@ int cmd_process(const std::string& plugin_path,
 }
 
 // ============================================================================
-// Helper: print MIDI message
+// Command: process --stream
 // ============================================================================
 
-static void print_midi_msg(const unsigned char* data, size_t len) {
-    static const char* note_names[] = {
-        "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
-    };
+// One hop of the streaming pipeline: decoded (planar) or processed
+// (interleaved) audio handed between two threads.
+struct StreamBlock {
+    std::vector<float> samples;
+    int frames = 0;
+};
 
-    if (len == 0) return;
+// Bounded handoff queue between pipeline stages. Capacity 2 is classic
+// double buffering: the producer fills block n+1 while the consumer holds
+// block n, which overlaps the stages without letting a fast producer run
+// ahead and grow memory.
+class StreamQueue {
+public:
+    explicit StreamQueue(size_t capacity) : capacity_(capacity) {}
+
+    // Blocks while full. Returns false if the pipeline was aborted.
+    bool push(StreamBlock&& block) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_cv_.wait(lock, [&] { return queue_.size() < capacity_ || aborted_; });
+        if (aborted_) return false;
+        queue_.push_back(std::move(block));
+        data_cv_.notify_one();
+        return true;
+    }
 
-    unsigned char status = data[0];
-    unsigned char type = status & 0xF0;
-    unsigned char ch = (status & 0x0F) + 1;
+    // Blocks while empty. Returns false at end of stream (producer called
+    // finish() and the queue drained) or if the pipeline was aborted.
+    bool pop(StreamBlock& block) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        data_cv_.wait(lock, [&] { return !queue_.empty() || done_ || aborted_; });
+        if (aborted_ || queue_.empty()) return false;
+        block = std::move(queue_.front());
+        queue_.pop_front();
+        space_cv_.notify_one();
+        return true;
+    }
 
-    switch (type) {
-    case 0x90:
-        if (len >= 3 && data[2] > 0) {
-            int note = data[1];
-            int oct = (note / 12) - 1;
-            std::printf("NoteOn   ch=%2d  %s%d (%3d)  vel=%3d\n",
-                        ch, note_names[note % 12], oct, note, data[2]);
-        } else if (len >= 3) {
-            int note = data[1];
-            int oct = (note / 12) - 1;
-            std::printf("NoteOff  ch=%2d  %s%d (%3d)\n",
-                        ch, note_names[note % 12], oct, note);
+    void finish() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        data_cv_.notify_all();
+    }
+
+    void abort() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        aborted_ = true;
+        data_cv_.notify_all();
+        space_cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable data_cv_;
+    std::condition_variable space_cv_;
+    std::deque<StreamBlock> queue_;
+    size_t capacity_;
+    bool done_ = false;
+    bool aborted_ = false;
+};
+
+#ifndef _WIN32
+// Readahead hints for the streamed input. The decoder owns its own file
+// handle, but POSIX_FADV_WILLNEED populates the shared page cache, so hints
+// issued on this side fd benefit the decoder's reads: the kernel fetches the
+// next window while the plugin chews on the current block. Compressed
+// formats do not map frames to bytes linearly; the proportional estimate
+// below is close enough for a readahead hint.
+struct StreamReadahead {
+    static constexpr long long kWindow = 8ll * 1024 * 1024;
+
+    int fd = -1;
+    long long file_bytes = 0;
+    unsigned long long total_frames = 0;
+    long long hinted_to = 0;
+
+    void open_and_prime(const char* path, unsigned long long frames) {
+        fd = open(path, O_RDONLY);
+        if (fd < 0) return;
+        total_frames = frames;
+        file_bytes = static_cast<long long>(lseek(fd, 0, SEEK_END));
+        if (file_bytes < 0) file_bytes = 0;
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        advance(0);
+    }
+
+    // Keep roughly kWindow bytes of readahead beyond the estimated byte
+    // position of frames_done.
+    void advance(unsigned long long frames_done) {
+        if (fd < 0 || file_bytes <= 0) return;
+        long long est = total_frames > 0
+            ? static_cast<long long>(
+                  static_cast<double>(file_bytes) * static_cast<double>(frames_done) /
+                  static_cast<double>(total_frames))
+            : 0;
+        (void)est;
+#ifdef POSIX_FADV_WILLNEED
+        while (hinted_to < file_bytes && est + kWindow > hinted_to) {
+            long long len = std::min(kWindow, file_bytes - hinted_to);
+            posix_fadvise(fd, hinted_to, len, POSIX_FADV_WILLNEED);
+            hinted_to += len;
+        }
+#endif
+    }
+
+    ~StreamReadahead() {
+        if (fd >= 0) close(fd);
+    }
+};
+#endif
+
+// Fully streamed process path: a decode thread feeds planar blocks through
+// a bounded queue, this thread runs the plugin, and an encode thread writes
+// the output incrementally. Memory stays constant for any file length and
+// wall clock approaches max(decode, process, encode) instead of their sum.
+int cmd_process_stream(const std::string& plugin_path,
+                       const std::string& input_file,
+                       const std::string& output_file,
+                       const std::string& midi_file,
+                       int block_size,
+                       const std::string& state_file,
+                       int preset_index,
+                       const std::vector<std::string>& param_specs,
+                       bool non_realtime,
+                       double bpm,
+                       int bit_depth,
+                       double tail_seconds) {
+    char err[1024] = {0};
+
+    // --- Open the streaming decoder ---
+    MH_AudioReader* reader = mh_audio_reader_open(input_file.c_str(), err, sizeof(err));
+    if (!reader) {
+        print_error(err);
+        return 1;
+    }
+    int in_ch = static_cast<int>(mh_audio_reader_channels(reader));
+    double sample_rate = static_cast<double>(mh_audio_reader_sample_rate(reader));
+    unsigned long long input_frames = mh_audio_reader_frames(reader);  // 0 = unknown
+
+    // --- Load MIDI (events are known up front; only the audio streams) ---
+    std::vector<SampleMidiEvent> midi_events;
+    int midi_total_samples = 0;
+    bool has_midi_input = !midi_file.empty();
+    if (has_midi_input) {
+        if (!load_midi_file(midi_file, sample_rate, midi_events, midi_total_samples)) {
+            mh_audio_reader_close(reader);
+            return 1;
+        }
+    }
+
+    // --- Open plugin ---
+    MH_Plugin* p = mh_open(plugin_path.c_str(), sample_rate, block_size,
+                           in_ch, 2, err, sizeof(err));
+    if (!p) {
+        print_error(err);
+        mh_audio_reader_close(reader);
+        return 1;
+    }
+
+    // --- Configure (state, preset, params, non-realtime, transport) ---
+    std::vector<MH_ParamChange> param_changes;
+    if (!configure_process_plugin(p, state_file, preset_index, param_specs,
+                                  non_realtime, bpm, param_changes)) {
+        mh_close(p);
+        mh_audio_reader_close(reader);
+        return 1;
+    }
+
+    // --- Get plugin info ---
+    MH_Info pinfo;
+    mh_get_info(p, &pinfo);
+    int out_ch = pinfo.num_output_ch > 0 ? pinfo.num_output_ch : 2;
+    int latency = mh_get_latency_samples(p);
+
+    // --- Open the streaming encoder ---
+    if (bit_depth <= 0) bit_depth = 24;
+    MH_AudioWriter* writer = mh_audio_writer_open(output_file.c_str(),
+                                                  static_cast<unsigned>(out_ch),
+                                                  static_cast<unsigned>(sample_rate),
+                                                  bit_depth, err, sizeof(err));
+    if (!writer) {
+        print_error(err);
+        mh_close(p);
+        mh_audio_reader_close(reader);
+        return 1;
+    }
+
+    // --- Print summary ---
+    std::fprintf(stderr, "Plugin: %s\n", plugin_path.c_str());
+    std::fprintf(stderr, "  Sample rate: %.0f Hz\n", sample_rate);
+    std::fprintf(stderr, "  Block size:  %d\n", block_size);
+    std::fprintf(stderr, "  Latency:     %d samples\n", latency);
+    if (input_frames > 0) {
+        std::fprintf(stderr, "  Input:       %d ch, %llu samples (streamed)\n",
+                     in_ch, input_frames);
+    } else {
+        std::fprintf(stderr, "  Input:       %d ch, unknown length (streamed)\n", in_ch);
+    }
+    if (has_midi_input) {
+        std::fprintf(stderr, "  MIDI events: %zu\n", midi_events.size());
+    }
+    if (!param_changes.empty()) {
+        std::fprintf(stderr, "  Params:      %zu override(s)\n", param_changes.size());
+    }
+    std::fprintf(stderr, "  Output:      %d ch -> %s\n", out_ch, output_file.c_str());
+
+    // --- Pipeline state ---
+    StreamQueue decoded(2);
+    StreamQueue processed(2);
+    std::atomic<bool> failed{false};
+    std::mutex fail_mutex;
+    std::string fail_msg;
+    auto fail = [&](const std::string& msg) {
+        {
+            std::lock_guard<std::mutex> lock(fail_mutex);
+            if (fail_msg.empty()) fail_msg = msg;
+        }
+        failed.store(true);
+        decoded.abort();
+        processed.abort();
+    };
+
+    // --- Decode thread: reader -> decoded ---
+    // Blocks are planar with channel stride block_size (the last audio block
+    // and trailing silence may carry fewer frames than the stride). After the
+    // decoder hits end of stream, silence is appended until the stream covers
+    // the MIDI tail (if any) plus the plugin latency, mirroring the padding
+    // the buffered path applies.
+    std::thread decode_thread([&] {
+        StreamBlock block;
+        std::vector<float*> ch_ptrs(in_ch);
+        unsigned long long pushed = 0;
+        unsigned long long target = 0;  // set once the decoder reports EOF
+        bool eof = false;
+#ifndef _WIN32
+        StreamReadahead readahead;
+        readahead.open_and_prime(input_file.c_str(), input_frames);
+#endif
+        while (!failed.load()) {
+            if (eof) {
+                if (pushed >= target) break;
+                int want = static_cast<int>(std::min<unsigned long long>(
+                    static_cast<unsigned long long>(block_size), target - pushed));
+                block.samples.assign(static_cast<size_t>(in_ch) * block_size, 0.0f);
+                block.frames = want;
+                if (!decoded.push(std::move(block))) break;
+                pushed += static_cast<unsigned long long>(want);
+                continue;
+            }
+            block.samples.assign(static_cast<size_t>(in_ch) * block_size, 0.0f);
+            for (int c = 0; c < in_ch; c++) {
+                ch_ptrs[c] = block.samples.data() + static_cast<size_t>(c) * block_size;
+            }
+            long long got = mh_audio_reader_read(reader, ch_ptrs.data(),
+                                                 static_cast<unsigned>(block_size));
+            if (got < 0) {
+                fail("Decode error in " + input_file);
+                break;
+            }
+            if (got < block_size) {
+                eof = true;
+                unsigned long long end = pushed + static_cast<unsigned long long>(got);
+                if (has_midi_input) {
+                    unsigned long long midi_end =
+                        static_cast<unsigned long long>(midi_total_samples) +
+                        static_cast<unsigned long long>(tail_seconds * sample_rate);
+                    if (midi_end > end) end = midi_end;
+                }
+                target = end + static_cast<unsigned long long>(latency);
+            }
+            if (got == 0) continue;  // EOF on a block boundary: fall into padding
+            block.frames = static_cast<int>(got);
+            if (!decoded.push(std::move(block))) break;
+            pushed += static_cast<unsigned long long>(got);
+#ifndef _WIN32
+            readahead.advance(pushed);
+#endif
+        }
+        decoded.finish();
+    });
+
+    // --- Encode thread: processed -> writer ---
+    std::thread encode_thread([&] {
+        char werr[1024] = {0};
+        StreamBlock block;
+        while (processed.pop(block)) {
+            if (block.frames <= 0) continue;
+            if (!mh_audio_writer_write(writer, block.samples.data(),
+                                       static_cast<unsigned>(block.frames),
+                                       werr, sizeof(werr))) {
+                fail(werr);
+                break;
+            }
+        }
+    });
+
+    // --- Process stage (this thread): decoded -> plugin -> processed ---
+    std::vector<const float*> in_ptrs(in_ch);
+    std::vector<float*> out_ptrs(out_ch);
+    std::vector<float> out_planar(static_cast<size_t>(out_ch) * block_size);
+    std::vector<const float*> trimmed_ptrs(out_ch);
+    size_t midi_idx = 0;
+    bool has_param_automation = !param_changes.empty();
+    unsigned long long pos = 0;  // stream position in frames
+    StreamBlock in_block;
+    while (decoded.pop(in_block)) {
+        int bsize = in_block.frames;
+        size_t in_stride = in_block.samples.size() / static_cast<size_t>(in_ch);
+        for (int c = 0; c < in_ch; c++) {
+            in_ptrs[c] = in_block.samples.data() + static_cast<size_t>(c) * in_stride;
+        }
+        for (int c = 0; c < out_ch; c++) {
+            out_ptrs[c] = out_planar.data() + static_cast<size_t>(c) * block_size;
+        }
+
+        // Collect MIDI events for this block
+        unsigned long long end = pos + static_cast<unsigned long long>(bsize);
+        std::vector<MH_MidiEvent> block_midi;
+        while (midi_idx < midi_events.size()) {
+            const auto& ev = midi_events[midi_idx];
+            if (static_cast<unsigned long long>(ev.sample_pos) >= end) break;
+            MH_MidiEvent mev;
+            int offset = static_cast<int>(
+                static_cast<unsigned long long>(ev.sample_pos) - pos);
+            mev.sample_offset = std::max(0, std::min(offset, bsize - 1));
+            mev.status = ev.status;
+            mev.data1 = ev.data1;
+            mev.data2 = ev.data2;
+            block_midi.push_back(mev);
+            midi_idx++;
+        }
+
+        if (has_param_automation || !block_midi.empty()) {
+            mh_process_auto(p,
+                            in_ptrs.data(), out_ptrs.data(), bsize,
+                            block_midi.empty() ? nullptr : block_midi.data(),
+                            static_cast<int>(block_midi.size()),
+                            nullptr, 0, nullptr,
+                            // Only send param changes in first block
+                            (pos == 0 && has_param_automation) ? param_changes.data() : nullptr,
+                            (pos == 0 && has_param_automation) ? static_cast<int>(param_changes.size()) : 0);
+        } else {
+            mh_process(p, in_ptrs.data(), out_ptrs.data(), bsize);
+        }
+
+        // Latency compensation: drop the first `latency` output frames. The
+        // decode stage appended the same number of silence frames at the end,
+        // so the written length matches the buffered path.
+        int skip = 0;
+        if (pos < static_cast<unsigned long long>(latency)) {
+            skip = static_cast<int>(std::min<unsigned long long>(
+                static_cast<unsigned long long>(latency) - pos,
+                static_cast<unsigned long long>(bsize)));
+        }
+        pos = end;
+        int write_frames = bsize - skip;
+        if (write_frames <= 0) continue;
+
+        StreamBlock out_block;
+        out_block.frames = write_frames;
+        out_block.samples.resize(static_cast<size_t>(out_ch) * write_frames);
+        for (int c = 0; c < out_ch; c++) {
+            trimmed_ptrs[c] = out_ptrs[c] + skip;
+        }
+        mh_audio_interleave(trimmed_ptrs.data(), out_block.samples.data(),
+                            static_cast<unsigned>(out_ch),
+                            static_cast<unsigned>(write_frames));
+        if (!processed.push(std::move(out_block))) break;
+    }
+    processed.finish();
+
+    decode_thread.join();
+    encode_thread.join();
+
+    // --- Finalize ---
+    unsigned long long written = mh_audio_writer_frames_written(writer);
+    char werr[1024] = {0};
+    int close_ok = mh_audio_writer_close(writer, werr, sizeof(werr));
+    mh_audio_reader_close(reader);
+    mh_close(p);
+
+    if (failed.load()) {
+        print_error(fail_msg.c_str());
+        return 1;
+    }
+    if (!close_ok) {
+        print_error(werr);
+        return 1;
+    }
+
+    double duration = static_cast<double>(written) / sample_rate;
+    std::fprintf(stderr, "Wrote %llu samples (%.2fs) to %s\n",
+                 written, duration, output_file.c_str());
+    return 0;
+}
+
+// ============================================================================
+// Command: process --batch
+// ============================================================================
+//
+// Amortized multi-file processing. Nightly jobs that shell out once per
+// file pay JUCE init plus plugin instantiation -- often seconds -- for
+// every invocation. Batch mode configures the plugin once (state file,
+// preset, --param overrides), captures the result with
+// mh_get_state_alloc, and clones it into one plugin instance per worker
+// with mh_set_state. Instances are opened serially on the main thread
+// (plugin instantiation is not reliably thread-safe); workers only call
+// mh_process on the instance they own, which is safe to run
+// concurrently. Batch mode covers the plain audio-in/audio-out path:
+// MIDI, sidechain and double precision stay single-file.
+
+// Expand a batch input spec: literal paths pass through, entries with
+// wildcard characters are expanded with glob(3) so file lists can be
+// given without relying on the shell (useful from scripts and cron).
+// Windows has no glob(3); patterns are treated as literal paths there.
+static void expand_batch_inputs(const std::vector<std::string>& specs,
+                                std::vector<std::string>& files) {
+    for (const auto& spec : specs) {
+#ifndef _WIN32
+        if (spec.find_first_of("*?[") != std::string::npos) {
+            glob_t g;
+            if (glob(spec.c_str(), 0, nullptr, &g) == 0) {
+                for (size_t i = 0; i < g.gl_pathc; i++)
+                    files.push_back(g.gl_pathv[i]);
+            } else {
+                std::fprintf(stderr, "Warning: Pattern matched no files: %s\n",
+                             spec.c_str());
+            }
+            globfree(&g);
+            continue;
+        }
+#endif
+        files.push_back(spec);
+    }
+}
+
+// Resolve one output path from the -o template: "{}" is replaced by the
+// input file's stem; a template naming an existing directory gets
+// "<stem>.wav" appended. Anything else is taken literally (only valid
+// for a single-file batch).
+static std::string batch_output_path(const std::string& output_template,
+                                     const std::string& input_file) {
+    namespace fs = std::filesystem;
+    std::string stem = fs::path(input_file).stem().string();
+    auto pos = output_template.find("{}");
+    if (pos != std::string::npos) {
+        std::string out = output_template;
+        out.replace(pos, 2, stem);
+        return out;
+    }
+    std::error_code ec;
+    if (fs::is_directory(output_template, ec))
+        return (fs::path(output_template) / (stem + ".wav")).string();
+    return output_template;
+}
+
+// Run pre-read audio through a plugin instance and write the result:
+// deinterleave with latency padding, reset, block loop, latency trim,
+// write. The instance must have been opened for the data's channel
+// count and sample rate. Shared by the process --batch workers and
+// the daemon's PROCESS requests. Returns true on success; on failure
+// err_out carries the reason.
+static bool render_loaded_audio(MH_Plugin* p, const MH_AudioData* data,
+                                const std::string& output_file,
+                                int block_size, int bit_depth,
+                                std::string& err_out) {
+    char err[1024] = {0};
+    int batch_ch = (int) data->channels;
+
+    int frames = (int) data->frames;
+    int latency = mh_get_latency_samples(p);
+    int output_total = frames + latency;
+
+    MH_Info pinfo;
+    mh_get_info(p, &pinfo);
+    int out_ch = pinfo.num_output_ch > 0 ? pinfo.num_output_ch : 2;
+
+    // Deinterleave and pad by latency so the full input is flushed out.
+    std::vector<std::vector<float>> in_channels(batch_ch);
+    for (int c = 0; c < batch_ch; c++) {
+        in_channels[c].assign(output_total, 0.0f);
+        for (int f = 0; f < frames; f++)
+            in_channels[c][f] = data->data[(size_t) f * batch_ch + c];
+    }
+
+    std::vector<std::vector<float>> out_channels(out_ch);
+    for (auto& ch : out_channels)
+        ch.assign(output_total, 0.0f);
+
+    // Clear delay lines and tails left over from the previous file.
+    mh_reset(p);
+
+    std::vector<const float*> in_ptrs(batch_ch);
+    std::vector<float*> out_ptrs(out_ch);
+    for (int start = 0; start < output_total; start += block_size) {
+        int bsize = std::min(block_size, output_total - start);
+        for (int c = 0; c < batch_ch; c++)
+            in_ptrs[c] = in_channels[c].data() + start;
+        for (int c = 0; c < out_ch; c++)
+            out_ptrs[c] = out_channels[c].data() + start;
+        if (!mh_process(p, in_ptrs.data(), out_ptrs.data(), bsize)) {
+            err_out = "Process failed";
+            return false;
+        }
+    }
+
+    // Latency compensation: trim leading latency samples.
+    int write_frames = frames;
+    std::vector<float> out_interleaved((size_t) out_ch * write_frames);
+    for (int f = 0; f < write_frames; f++)
+        for (int c = 0; c < out_ch; c++)
+            out_interleaved[(size_t) f * out_ch + c] = out_channels[c][latency + f];
+
+    if (!mh_audio_write(output_file.c_str(), out_interleaved.data(),
+                        (unsigned) out_ch, (unsigned) write_frames,
+                        data->sample_rate, bit_depth,
+                        err, sizeof(err))) {
+        err_out = err;
+        return false;
+    }
+    return true;
+}
+
+// Process one file on a worker's plugin instance. The instance was
+// opened for the batch channel count and sample rate, so mismatched
+// files are skipped rather than silently processed at the wrong rate.
+// Returns true on success; on failure err_out carries the reason.
+static bool process_batch_file(MH_Plugin* p,
+                               const std::string& input_file,
+                               const std::string& output_file,
+                               int batch_ch, int batch_rate,
+                               int block_size, int bit_depth,
+                               std::string& err_out) {
+    char err[1024] = {0};
+    MH_AudioData* data = mh_audio_read(input_file.c_str(), err, sizeof(err));
+    if (!data) {
+        err_out = err;
+        return false;
+    }
+    if ((int) data->channels != batch_ch || (int) data->sample_rate != batch_rate) {
+        char msg[256];
+        std::snprintf(msg, sizeof(msg),
+                      "%u ch @ %u Hz does not match batch format (%d ch @ %d Hz)",
+                      data->channels, data->sample_rate, batch_ch, batch_rate);
+        err_out = msg;
+        mh_audio_data_free(data);
+        return false;
+    }
+    bool ok = render_loaded_audio(p, data, output_file,
+                                  block_size, bit_depth, err_out);
+    mh_audio_data_free(data);
+    return ok;
+}
+
+int cmd_process_batch(const std::string& plugin_path,
+                      const std::vector<std::string>& input_specs,
+                      const std::string& output_template,
+                      double sample_rate,
+                      int block_size,
+                      const std::string& state_file,
+                      int preset_index,
+                      const std::vector<std::string>& param_specs,
+                      bool non_realtime,
+                      double bpm,
+                      int bit_depth,
+                      int jobs) {
+    char err[1024] = {0};
+
+    std::vector<std::string> files;
+    expand_batch_inputs(input_specs, files);
+    if (files.empty()) {
+        print_error("Batch mode: no input files");
+        return 1;
+    }
+    if (files.size() > 1 && output_template.find("{}") == std::string::npos) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(output_template, ec)) {
+            print_error("Batch mode with multiple inputs needs -o to be a "
+                        "template containing {} or an existing directory");
+            return 1;
+        }
+    }
+
+    // The batch format comes from the first input file; every worker
+    // instance is opened for it, so mismatched files are skipped.
+    AudioBuffer first;
+    if (!read_audio_file(files[0], first)) return 1;
+    int batch_ch = first.channels;
+    int batch_rate = first.sample_rate;
+    sample_rate = batch_rate;
+    first.interleaved.clear();
+
+    // --- Configure the master instance once ---
+    MH_Plugin* master = mh_open(plugin_path.c_str(), sample_rate, block_size,
+                                batch_ch, 2, err, sizeof(err));
+    if (!master) {
+        print_error(err);
+        return 1;
+    }
+
+    if (!state_file.empty()) {
+        std::ifstream ifs(state_file, std::ios::binary);
+        if (ifs) {
+            std::vector<char> data((std::istreambuf_iterator<char>(ifs)),
+                                    std::istreambuf_iterator<char>());
+            if (mh_set_state(master, data.data(), static_cast<int>(data.size()))) {
+                std::fprintf(stderr, "Loaded state from %s\n", state_file.c_str());
+            } else {
+                std::fprintf(stderr, "Warning: Failed to load state from %s\n",
+                             state_file.c_str());
+            }
+        }
+    }
+
+    if (preset_index >= 0) {
+        int num_programs = mh_get_num_programs(master);
+        if (preset_index >= num_programs) {
+            std::fprintf(stderr, "Error: Preset index %d out of range (0-%d)\n",
+                         preset_index, num_programs - 1);
+            mh_close(master);
+            return 1;
+        }
+        mh_set_program(master, preset_index);
+    }
+
+    for (const auto& spec : param_specs) {
+        int idx;
+        float val;
+        if (!parse_param_spec(master, spec, idx, val)) {
+            std::fprintf(stderr, "Error: Invalid parameter spec '%s'\n", spec.c_str());
+            mh_close(master);
+            return 1;
+        }
+        mh_set_param(master, idx, val);
+    }
+
+    // --- Clone the configured state into one instance per worker ---
+    void* blob = nullptr;
+    int blob_size = 0;
+    if (!mh_get_state_alloc(master, &blob, &blob_size)) {
+        // A plugin with no serializable state still batches fine: the
+        // clones get the same preset/param setup applied directly.
+        blob = nullptr;
+    }
+
+    if (jobs < 1) jobs = 1;
+    if (jobs > 64) jobs = 64;
+    if (jobs > (int) files.size()) jobs = (int) files.size();
+
+    MH_TransportInfo transport = {};
+    if (bpm > 0) {
+        transport.bpm = bpm;
+        transport.time_sig_numerator = 4;
+        transport.time_sig_denominator = 4;
+        transport.is_playing = 1;
+    }
+
+    auto configure_instance = [&](MH_Plugin* p) {
+        if (blob) mh_set_state(p, blob, blob_size);
+        if (non_realtime) mh_set_non_realtime(p, 1);
+        if (bpm > 0) mh_set_transport(p, &transport);
+    };
+    configure_instance(master);
+
+    std::vector<MH_Plugin*> instances;
+    instances.push_back(master);
+    for (int i = 1; i < jobs; i++) {
+        MH_Plugin* p = mh_open(plugin_path.c_str(), sample_rate, block_size,
+                               batch_ch, 2, err, sizeof(err));
+        if (!p) {
+            std::fprintf(stderr, "Warning: Worker %d failed to open plugin; "
+                         "continuing with %d worker(s)\n", i, i);
+            break;
+        }
+        if (!blob) {
+            // No state blob to clone: replay the preset/param setup.
+            if (preset_index >= 0) mh_set_program(p, preset_index);
+            for (const auto& spec : param_specs) {
+                int idx;
+                float val;
+                if (parse_param_spec(p, spec, idx, val)) mh_set_param(p, idx, val);
+            }
+        }
+        configure_instance(p);
+        instances.push_back(p);
+    }
+    mh_state_free(blob);
+    jobs = (int) instances.size();
+
+    std::fprintf(stderr, "Plugin: %s\n", plugin_path.c_str());
+    std::fprintf(stderr, "  Sample rate: %d Hz\n", batch_rate);
+    std::fprintf(stderr, "  Block size:  %d\n", block_size);
+    std::fprintf(stderr, "  Batch:       %zu file(s), %d ch, %d worker(s)\n",
+                 files.size(), batch_ch, jobs);
+
+    if (bit_depth <= 0) bit_depth = 24;
+
+    // --- Worker pool: pull file indices from a shared counter ---
+    std::atomic<size_t> next{0};
+    std::atomic<int> failed{0};
+    std::mutex log_mutex;
+
+    auto worker = [&](MH_Plugin* p) {
+        for (;;) {
+            size_t i = next.fetch_add(1);
+            if (i >= files.size()) break;
+            std::string out_path = batch_output_path(output_template, files[i]);
+            std::string file_err;
+            bool ok = process_batch_file(p, files[i], out_path,
+                                         batch_ch, batch_rate,
+                                         block_size, bit_depth, file_err);
+            std::lock_guard<std::mutex> lock(log_mutex);
+            if (ok) {
+                std::fprintf(stderr, "  %s -> %s\n", files[i].c_str(),
+                             out_path.c_str());
+            } else {
+                std::fprintf(stderr, "  %s: Error: %s\n", files[i].c_str(),
+                             file_err.c_str());
+                failed.fetch_add(1);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < jobs; i++)
+        threads.emplace_back(worker, instances[(size_t) i]);
+    worker(instances[0]);
+    for (auto& t : threads) t.join();
+
+    for (MH_Plugin* p : instances) mh_close(p);
+
+    int nfailed = failed.load();
+    std::fprintf(stderr, "Processed %zu file(s), %d failed\n",
+                 files.size() - nfailed, nfailed);
+    return nfailed > 0 ? 1 : 0;
+}
+
+// ============================================================================
+// Command: daemon
+// ============================================================================
+//
+// Long-lived warm-plugin service. mh_open pays dlopen + module init +
+// prepareToPlay on every CLI invocation -- seconds for large samplers --
+// so CLI-driven workflows that shell out per render spend most of their
+// wall time on cold starts. The daemon keeps configured instances
+// resident in an LRU cache keyed by (path, sample rate, channels),
+// shares one MH_Session across loads, and serves render requests over a
+// Unix stream socket. Requests are served one at a time on the accept
+// thread: plugin processing is single-threaded per instance anyway, and
+// serializing keeps the cache lock-free. Not available on Windows.
+//
+// Protocol: one tab-separated request line per message, one "OK ..." or
+// "ERR <reason>" response line back (STATUS responds with "OK <n>"
+// followed by n detail lines). Fields are tab-separated so paths with
+// spaces need no quoting.
+//
+//   PROCESS <plugin> <input> <output> [key=value ...]
+//       File-to-file render through a warm instance matching the input
+//       file's format. Keys: state=<file>, preset=<index>,
+//       param=<name-or-index>=<value> (repeatable), bits=<16|24|32>.
+//   RENDER <plugin> <shm> <channels> <frames> <rate> [key=value ...]
+//       Process interleaved float32 audio in place inside the POSIX
+//       shared-memory object <shm> (created and sized by the client:
+//       channels * frames floats) -- no audio crosses the socket. The
+//       plugin's output channel count must equal <channels>. Keys as
+//       for PROCESS except bits.
+//   STATUS
+//       List resident instances with seconds since last use.
+//   EVICT [<plugin>]
+//       Drop resident instances for <plugin>, or all of them.
+//   SHUTDOWN
+//       Stop the daemon.
+
+#ifndef _WIN32
+
+struct WarmPlugin {
+    MH_Plugin* p;
+    std::string path;
+    int sample_rate;
+    int channels;
+    std::chrono::steady_clock::time_point last_used;
+};
+
+// Per-request configuration parsed from trailing key=value fields.
+struct DaemonRenderOpts {
+    std::string state_file;
+    int preset = -1;
+    std::vector<std::string> params;
+    int bits = 24;
+};
+
+static bool parse_daemon_opts(const std::vector<std::string>& fields,
+                              size_t start, DaemonRenderOpts& opts,
+                              std::string& err_out) {
+    for (size_t i = start; i < fields.size(); i++) {
+        const std::string& f = fields[i];
+        auto eq = f.find('=');
+        std::string key = eq == std::string::npos ? f : f.substr(0, eq);
+        std::string val = eq == std::string::npos ? "" : f.substr(eq + 1);
+        if (key == "state") {
+            opts.state_file = val;
+        } else if (key == "preset") {
+            opts.preset = std::atoi(val.c_str());
+        } else if (key == "param") {
+            opts.params.push_back(val);
+        } else if (key == "bits") {
+            opts.bits = std::atoi(val.c_str());
+        } else {
+            err_out = "unknown option '" + key + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Apply per-request state/preset/param setup to a warm instance.
+// Applied on every request that carries options -- the instance is
+// shared across requests, so the previous caller's state would
+// otherwise leak into this render.
+static bool daemon_configure(MH_Plugin* p, const DaemonRenderOpts& opts,
+                             std::string& err_out) {
+    if (!opts.state_file.empty()) {
+        std::ifstream ifs(opts.state_file, std::ios::binary);
+        if (!ifs) {
+            err_out = "cannot read state file " + opts.state_file;
+            return false;
+        }
+        std::vector<char> data((std::istreambuf_iterator<char>(ifs)),
+                                std::istreambuf_iterator<char>());
+        if (!mh_set_state(p, data.data(), static_cast<int>(data.size()))) {
+            err_out = "failed to load state from " + opts.state_file;
+            return false;
+        }
+    }
+    if (opts.preset >= 0) {
+        if (opts.preset >= mh_get_num_programs(p)) {
+            err_out = "preset index out of range";
+            return false;
+        }
+        mh_set_program(p, opts.preset);
+    }
+    for (const auto& spec : opts.params) {
+        int idx;
+        float val;
+        if (!parse_param_spec(p, spec, idx, val)) {
+            err_out = "invalid parameter spec '" + spec + "'";
+            return false;
+        }
+        mh_set_param(p, idx, val);
+    }
+    return true;
+}
+
+// Find or load the instance for (path, rate, channels). Loads go
+// through the shared session (format registration amortized across the
+// daemon's lifetime); the least-recently-used instance is evicted when
+// the cache is full. Linear scan -- the cache is small by design.
+static MH_Plugin* daemon_acquire(std::vector<WarmPlugin>& cache,
+                                 MH_Session* session,
+                                 const std::string& plugin_path,
+                                 int rate, int channels,
+                                 int block_size, int max_resident,
+                                 std::string& err_out) {
+    for (auto& w : cache) {
+        if (w.path == plugin_path && w.sample_rate == rate
+            && w.channels == channels) {
+            w.last_used = std::chrono::steady_clock::now();
+            return w.p;
+        }
+    }
+
+    while ((int) cache.size() >= max_resident && !cache.empty()) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < cache.size(); i++)
+            if (cache[i].last_used < cache[oldest].last_used) oldest = i;
+        std::fprintf(stderr, "daemon: evicting %s (%d Hz, %d ch)\n",
+                     cache[oldest].path.c_str(), cache[oldest].sample_rate,
+                     cache[oldest].channels);
+        mh_close(cache[oldest].p);
+        cache.erase(cache.begin() + (long) oldest);
+    }
+
+    char err[1024] = {0};
+    auto t0 = std::chrono::steady_clock::now();
+    MH_Plugin* p = mh_session_open(session, plugin_path.c_str(),
+                                   (double) rate, block_size,
+                                   channels, channels, 0,
+                                   err, sizeof(err));
+    if (!p) {
+        err_out = err;
+        return nullptr;
+    }
+    mh_set_non_realtime(p, 1);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+    std::fprintf(stderr, "daemon: loaded %s (%d Hz, %d ch) in %lld ms\n",
+                 plugin_path.c_str(), rate, channels, (long long) ms);
+
+    WarmPlugin w;
+    w.p = p;
+    w.path = plugin_path;
+    w.sample_rate = rate;
+    w.channels = channels;
+    w.last_used = std::chrono::steady_clock::now();
+    cache.push_back(w);
+    return p;
+}
+
+// PROCESS <plugin> <input> <output> [opts] -> one response line.
+static std::string daemon_handle_process(std::vector<WarmPlugin>& cache,
+                                         MH_Session* session,
+                                         const std::vector<std::string>& fields,
+                                         int block_size, int max_resident) {
+    if (fields.size() < 4) return "ERR PROCESS needs <plugin> <input> <output>";
+    DaemonRenderOpts opts;
+    std::string err;
+    if (!parse_daemon_opts(fields, 4, opts, err)) return "ERR " + err;
+
+    char read_err[1024] = {0};
+    MH_AudioData* data = mh_audio_read(fields[2].c_str(),
+                                       read_err, sizeof(read_err));
+    if (!data) return std::string("ERR ") + read_err;
+
+    MH_Plugin* p = daemon_acquire(cache, session, fields[1],
+                                  (int) data->sample_rate,
+                                  (int) data->channels,
+                                  block_size, max_resident, err);
+    if (!p) {
+        mh_audio_data_free(data);
+        return "ERR " + err;
+    }
+    if (!daemon_configure(p, opts, err)) {
+        mh_audio_data_free(data);
+        return "ERR " + err;
+    }
+
+    unsigned frames = data->frames;
+    bool ok = render_loaded_audio(p, data, fields[3],
+                                  block_size, opts.bits, err);
+    mh_audio_data_free(data);
+    if (!ok) return "ERR " + err;
+
+    char reply[1200];
+    std::snprintf(reply, sizeof(reply), "OK %s %u frames",
+                  fields[3].c_str(), frames);
+    return reply;
+}
+
+// RENDER <plugin> <shm> <channels> <frames> <rate> [opts] -> one line.
+// The shared-memory object holds the interleaved float32 input on
+// entry and the (latency-trimmed) output on return.
+static std::string daemon_handle_render(std::vector<WarmPlugin>& cache,
+                                        MH_Session* session,
+                                        const std::vector<std::string>& fields,
+                                        int block_size, int max_resident) {
+    if (fields.size() < 6)
+        return "ERR RENDER needs <plugin> <shm> <channels> <frames> <rate>";
+    int channels = std::atoi(fields[3].c_str());
+    long long frames = std::atoll(fields[4].c_str());
+    int rate = std::atoi(fields[5].c_str());
+    if (channels <= 0 || frames <= 0 || rate <= 0)
+        return "ERR bad channels/frames/rate";
+
+    DaemonRenderOpts opts;
+    std::string err;
+    if (!parse_daemon_opts(fields, 6, opts, err)) return "ERR " + err;
+
+    MH_Plugin* p = daemon_acquire(cache, session, fields[1], rate, channels,
+                                  block_size, max_resident, err);
+    if (!p) return "ERR " + err;
+
+    MH_Info pinfo;
+    mh_get_info(p, &pinfo);
+    if (pinfo.num_output_ch != channels) {
+        char msg[256];
+        std::snprintf(msg, sizeof(msg),
+                      "ERR plugin has %d output channel(s), shm buffer has %d",
+                      pinfo.num_output_ch, channels);
+        return msg;
+    }
+    if (!daemon_configure(p, opts, err)) return "ERR " + err;
+
+    const size_t nbytes = (size_t) channels * (size_t) frames * sizeof(float);
+    int shm_fd = shm_open(fields[2].c_str(), O_RDWR, 0);
+    if (shm_fd < 0) return "ERR cannot open shm object " + fields[2];
+    float* audio = (float*) mmap(nullptr, nbytes, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+    if (audio == MAP_FAILED) return "ERR cannot map shm object " + fields[2];
+
+    // Same shape as the file path: deinterleave with latency padding,
+    // reset, block loop, trim, re-interleave back into the mapping.
+    int latency = mh_get_latency_samples(p);
+    long long total = frames + latency;
+    std::vector<std::vector<float>> in_ch((size_t) channels);
+    std::vector<std::vector<float>> out_ch((size_t) channels);
+    for (int c = 0; c < channels; c++) {
+        in_ch[c].assign((size_t) total, 0.0f);
+        out_ch[c].assign((size_t) total, 0.0f);
+        for (long long f = 0; f < frames; f++)
+            in_ch[c][(size_t) f] = audio[(size_t) f * channels + c];
+    }
+    mh_reset(p);
+
+    std::vector<const float*> in_ptrs((size_t) channels);
+    std::vector<float*> out_ptrs((size_t) channels);
+    bool ok = true;
+    for (long long start = 0; start < total; start += block_size) {
+        int bsize = (int) std::min<long long>(block_size, total - start);
+        for (int c = 0; c < channels; c++) {
+            in_ptrs[c] = in_ch[c].data() + start;
+            out_ptrs[c] = out_ch[c].data() + start;
+        }
+        if (!mh_process(p, in_ptrs.data(), out_ptrs.data(), bsize)) {
+            ok = false;
+            break;
+        }
+    }
+    if (ok)
+        for (long long f = 0; f < frames; f++)
+            for (int c = 0; c < channels; c++)
+                audio[(size_t) f * channels + c]
+                    = out_ch[c][(size_t)(latency + f)];
+    munmap(audio, nbytes);
+    if (!ok) return "ERR process failed";
+
+    char reply[256];
+    std::snprintf(reply, sizeof(reply), "OK %lld frames", frames);
+    return reply;
+}
+
+static std::string daemon_handle_status(const std::vector<WarmPlugin>& cache) {
+    auto now = std::chrono::steady_clock::now();
+    char line[1200];
+    std::snprintf(line, sizeof(line), "OK %zu", cache.size());
+    std::string reply = line;
+    for (const auto& w : cache) {
+        auto idle = std::chrono::duration_cast<std::chrono::seconds>(
+            now - w.last_used).count();
+        std::snprintf(line, sizeof(line), "\n%s\t%d\t%d\t%llds",
+                      w.path.c_str(), w.sample_rate, w.channels,
+                      (long long) idle);
+        reply += line;
+    }
+    return reply;
+}
+
+static std::string daemon_handle_evict(std::vector<WarmPlugin>& cache,
+                                       const std::vector<std::string>& fields) {
+    size_t before = cache.size();
+    for (size_t i = cache.size(); i-- > 0;) {
+        if (fields.size() > 1 && cache[i].path != fields[1]) continue;
+        mh_close(cache[i].p);
+        cache.erase(cache.begin() + (long) i);
+    }
+    char reply[64];
+    std::snprintf(reply, sizeof(reply), "OK evicted %zu", before - cache.size());
+    return reply;
+}
+
+int cmd_daemon(const std::string& socket_path, int max_resident,
+               int block_size) {
+    char err[1024] = {0};
+    if (max_resident < 1) max_resident = 1;
+
+    MH_Session* session = mh_session_create(err, sizeof(err));
+    if (!session) {
+        print_error(err);
+        return 1;
+    }
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        print_error("Socket path too long");
+        mh_session_close(session);
+        return 1;
+    }
+    std::strncpy(addr.sun_path, socket_path.c_str(),
+                 sizeof(addr.sun_path) - 1);
+
+    unlink(socket_path.c_str());  // stale socket from a previous run
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0
+        || bind(listen_fd, (sockaddr*) &addr, sizeof(addr)) != 0
+        || listen(listen_fd, 4) != 0) {
+        print_error("Failed to bind daemon socket");
+        if (listen_fd >= 0) close(listen_fd);
+        mh_session_close(session);
+        return 1;
+    }
+
+    std::fprintf(stderr, "minihost daemon listening on %s "
+                 "(block %d, max %d resident)\n",
+                 socket_path.c_str(), block_size, max_resident);
+
+    g_running = 1;
+    std::signal(SIGINT, sigint_handler);
+
+    std::vector<WarmPlugin> cache;
+    bool shutdown = false;
+
+    while (g_running && !shutdown) {
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;  // SIGINT: loop re-checks g_running
+            break;
+        }
+        FILE* conn = fdopen(fd, "r+");
+        if (conn == nullptr) {
+            close(fd);
+            continue;
+        }
+        char* line = nullptr;
+        size_t line_cap = 0;
+        ssize_t len;
+        while ((len = getline(&line, &line_cap, conn)) > 0) {
+            while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+                line[--len] = '\0';
+            std::vector<std::string> fields;
+            for (char* tok = line; tok != nullptr;) {
+                char* tab = std::strchr(tok, '\t');
+                if (tab) *tab = '\0';
+                fields.emplace_back(tok);
+                tok = tab ? tab + 1 : nullptr;
+            }
+            std::string reply;
+            if (fields.empty() || fields[0].empty()) {
+                reply = "ERR empty request";
+            } else if (fields[0] == "PROCESS") {
+                reply = daemon_handle_process(cache, session, fields,
+                                              block_size, max_resident);
+            } else if (fields[0] == "RENDER") {
+                reply = daemon_handle_render(cache, session, fields,
+                                             block_size, max_resident);
+            } else if (fields[0] == "STATUS") {
+                reply = daemon_handle_status(cache);
+            } else if (fields[0] == "EVICT") {
+                reply = daemon_handle_evict(cache, fields);
+            } else if (fields[0] == "SHUTDOWN") {
+                reply = "OK bye";
+                shutdown = true;
+            } else {
+                reply = "ERR unknown request '" + fields[0] + "'";
+            }
+            std::fputs(reply.c_str(), conn);
+            std::fputc('\n', conn);
+            std::fflush(conn);
+            if (shutdown) break;
+        }
+        free(line);
+        fclose(conn);
+    }
+
+    for (auto& w : cache) mh_close(w.p);
+    close(listen_fd);
+    unlink(socket_path.c_str());
+    mh_session_close(session);
+    std::fprintf(stderr, "minihost daemon stopped\n");
+    return 0;
+}
+
+#else  // _WIN32
+
+int cmd_daemon(const std::string& socket_path, int max_resident,
+               int block_size) {
+    (void) socket_path;
+    (void) max_resident;
+    (void) block_size;
+    print_error("daemon mode is not supported on Windows");
+    return 1;
+}
+
+#endif
+
+// ============================================================================
+// Command: bench
+// ============================================================================
+//
+// Offline throughput measurement for plugin evaluation: feed synthetic
+// noise for N seconds of audio at each block size in a 32..4096 sweep
+// and report realtime factor, per-block p50/p99 latency, and denormal
+// output samples. More than one plugin path builds an mh_chain and
+// benches the whole chain.
+
+// Per-block-size measurement results.
+struct BenchResult {
+    int nframes;
+    int blocks;
+    double realtime_factor;
+    double p50_us;
+    double p99_us;
+    long long denormal_samples;
+};
+
+// Deterministic low-amplitude noise: real signal levels without a seed
+// dependency between runs, and loud enough that well-behaved plugins
+// never see an all-zero input (which would hide decay-tail denormals).
+static void fill_bench_noise(std::vector<std::vector<float>>& channels, int nframes) {
+    unsigned int rng = 0x2545f491u;
+    for (auto& ch : channels) {
+        for (int f = 0; f < nframes; f++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            ch[(size_t)f] = ((float)(rng & 0xffffffu) / (float)0xffffffu - 0.5f) * 0.25f;
+        }
+    }
+}
+
+static long long count_denormal_samples(const std::vector<std::vector<float>>& channels,
+                                        int nframes) {
+    long long n = 0;
+    for (const auto& ch : channels) {
+        for (int f = 0; f < nframes; f++) {
+            if (std::fpclassify(ch[(size_t)f]) == FP_SUBNORMAL) n++;
+        }
+    }
+    return n;
+}
+
+int cmd_bench(const std::vector<std::string>& plugin_paths,
+              double sample_rate,
+              double seconds,
+              bool json_output) {
+    char err[1024] = {0};
+    constexpr int kMaxBench = 4096;
+    constexpr int kWarmupBlocks = 16;
+
+    // Open at the largest block size in the sweep so every size fits.
+    std::vector<MH_Plugin*> plugins;
+    for (const auto& path : plugin_paths) {
+        MH_Plugin* p = mh_open(path.c_str(), sample_rate, kMaxBench, 2, 2,
+                               err, sizeof(err));
+        if (!p) {
+            print_error(err);
+            for (MH_Plugin* q : plugins) mh_close(q);
+            return 1;
+        }
+        plugins.push_back(p);
+    }
+
+    MH_PluginChain* chain = nullptr;
+    int in_ch, out_ch;
+    if (plugins.size() > 1) {
+        chain = mh_chain_create(plugins.data(), (int)plugins.size(),
+                                err, sizeof(err));
+        if (!chain) {
+            print_error(err);
+            for (MH_Plugin* q : plugins) mh_close(q);
+            return 1;
+        }
+        in_ch = mh_chain_get_num_input_channels(chain);
+        out_ch = mh_chain_get_num_output_channels(chain);
+    } else {
+        MH_Info info;
+        mh_get_info(plugins[0], &info);
+        in_ch = info.num_input_ch;
+        out_ch = info.num_output_ch;
+    }
+    if (in_ch < 1) in_ch = 1;
+    if (out_ch < 1) out_ch = 1;
+
+    // Offline render: tell the plugin(s) it need not meet deadlines, same
+    // as `process --non-realtime`.
+    for (MH_Plugin* q : plugins) mh_set_non_realtime(q, 1);
+
+    std::vector<BenchResult> results;
+
+    for (int nframes = 32; nframes <= kMaxBench; nframes *= 2) {
+        std::vector<std::vector<float>> in_data((size_t)in_ch,
+                                                std::vector<float>((size_t)nframes));
+        std::vector<std::vector<float>> out_data((size_t)out_ch,
+                                                 std::vector<float>((size_t)nframes));
+        fill_bench_noise(in_data, nframes);
+
+        std::vector<const float*> in_ptrs;
+        std::vector<float*> out_ptrs;
+        for (auto& ch : in_data) in_ptrs.push_back(ch.data());
+        for (auto& ch : out_data) out_ptrs.push_back(ch.data());
+
+        const int blocks = std::max(1, (int)(seconds * sample_rate / nframes));
+        std::vector<double> block_us((size_t)blocks);
+        long long denormals = 0;
+
+        auto process_one = [&]() {
+            return chain
+                ? mh_chain_process(chain, in_ptrs.data(), out_ptrs.data(), nframes)
+                : mh_process(plugins[0], in_ptrs.data(), out_ptrs.data(), nframes);
+        };
+
+        // Warm-up outside the timed region: first calls hit lazy plugin
+        // allocations and cold code paths.
+        for (int i = 0; i < kWarmupBlocks; i++) process_one();
+
+        bool ok = true;
+        for (int i = 0; i < blocks; i++) {
+            auto t0 = std::chrono::steady_clock::now();
+            int ret = process_one();
+            auto t1 = std::chrono::steady_clock::now();
+            if (!ret) {
+                ok = false;
+                break;
+            }
+            block_us[(size_t)i] =
+                std::chrono::duration<double, std::micro>(t1 - t0).count();
+            // Counted outside the timed region.
+            denormals += count_denormal_samples(out_data, nframes);
+        }
+        if (!ok) {
+            print_error("process call failed during bench");
+            if (chain) mh_chain_close(chain);
+            for (MH_Plugin* q : plugins) mh_close(q);
+            return 1;
+        }
+
+        double total_us = 0.0;
+        for (double us : block_us) total_us += us;
+
+        std::vector<double> sorted = block_us;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&](double pct) {
+            size_t idx = (size_t)(pct * (double)(sorted.size() - 1));
+            return sorted[idx];
+        };
+
+        BenchResult r;
+        r.nframes = nframes;
+        r.blocks = blocks;
+        r.realtime_factor =
+            ((double)blocks * nframes / sample_rate) / (total_us * 1e-6);
+        r.p50_us = percentile(0.50);
+        r.p99_us = percentile(0.99);
+        r.denormal_samples = denormals;
+        results.push_back(r);
+    }
+
+    if (json_output) {
+        std::printf("{\n  \"sample_rate\": %.0f,\n  \"seconds\": %.2f,\n",
+                    sample_rate, seconds);
+        std::printf("  \"plugins\": [");
+        for (size_t i = 0; i < plugin_paths.size(); i++) {
+            std::printf("%s\"%s\"", i == 0 ? "" : ", ", plugin_paths[i].c_str());
+        }
+        std::printf("],\n  \"sweep\": [\n");
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            std::printf("    {\"block_size\": %d, \"blocks\": %d, "
+                        "\"realtime_factor\": %.2f, \"p50_us\": %.1f, "
+                        "\"p99_us\": %.1f, \"denormal_samples\": %lld}%s\n",
+                        r.nframes, r.blocks, r.realtime_factor,
+                        r.p50_us, r.p99_us, r.denormal_samples,
+                        (i + 1 < results.size()) ? "," : "");
+        }
+        std::printf("  ]\n}\n");
+    } else {
+        std::printf("Bench: %.1fs of audio per block size at %.0f Hz, %d ch -> %d ch\n\n",
+                    seconds, sample_rate, in_ch, out_ch);
+        std::printf("%7s %8s %10s %10s %10s %10s\n",
+                    "block", "blocks", "rt-factor", "p50 (us)", "p99 (us)", "denormals");
+        for (const BenchResult& r : results) {
+            std::printf("%7d %8d %9.1fx %10.1f %10.1f %10lld\n",
+                        r.nframes, r.blocks, r.realtime_factor,
+                        r.p50_us, r.p99_us, r.denormal_samples);
+        }
+    }
+
+    if (chain) mh_chain_close(chain);
+    for (MH_Plugin* q : plugins) mh_close(q);
+    return 0;
+}
+
+// ============================================================================
+// Helper: print MIDI message
+// ============================================================================
+
+static void print_midi_msg(const unsigned char* data, size_t len) {
+    static const char* note_names[] = {
+        "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+    };
+
+    if (len == 0) return;
+
+    unsigned char status = data[0];
+    unsigned char type = status & 0xF0;
+    unsigned char ch = (status & 0x0F) + 1;
+
+    switch (type) {
+    case 0x90:
+        if (len >= 3 && data[2] > 0) {
+            int note = data[1];
+            int oct = (note / 12) - 1;
+            std::printf("NoteOn   ch=%2d  %s%d (%3d)  vel=%3d\n",
+                        ch, note_names[note % 12], oct, note, data[2]);
+        } else if (len >= 3) {
+            int note = data[1];
+            int oct = (note / 12) - 1;
+            std::printf("NoteOff  ch=%2d  %s%d (%3d)\n",
+                        ch, note_names[note % 12], oct, note);
         }
         break;
     case 0x80:
@@ -1828,57 +3516,151 @@ int cmd_resample(const std::string& input_path, const std::string& output_path,
         }
     }
 
-    // Read input
+    // Stream reader -> resampler -> writer chunk by chunk, so a 3-hour
+    // stem converts with peak memory bounded by the chunk buffers below
+    // (a few MB) instead of three whole-file copies.
     char err[1024] = {0};
-    MH_AudioData* input = mh_audio_read(input_path.c_str(), err, sizeof(err));
-    if (!input) {
+    MH_AudioReader* reader = mh_audio_reader_open(input_path.c_str(), err, sizeof(err));
+    if (!reader) {
         print_error(err);
         return 1;
     }
+    unsigned int channels = mh_audio_reader_channels(reader);
+    unsigned int in_rate = mh_audio_reader_sample_rate(reader);
 
-    if (input->sample_rate == target_rate) {
+    bool converting = (in_rate != target_rate);
+    if (!converting) {
         std::fprintf(stderr, "Input already at %u Hz, writing without resampling\n", target_rate);
-        if (!mh_audio_write(output_path.c_str(), input->data,
-                            input->channels, input->frames,
-                            input->sample_rate, bit_depth, err, sizeof(err))) {
+    }
+
+    MH_Resampler* resampler = nullptr;
+    if (converting) {
+        resampler = mh_resampler_open(channels, in_rate, target_rate, err, sizeof(err));
+        if (!resampler) {
             print_error(err);
-            mh_audio_data_free(input);
+            mh_audio_reader_close(reader);
             return 1;
         }
-        std::printf("%s -> %s (%u Hz, %u ch, %u frames, %d-bit)\n",
-                    input_path.c_str(), output_path.c_str(),
-                    input->sample_rate, input->channels, input->frames, bit_depth);
-        mh_audio_data_free(input);
-        return 0;
     }
 
-    // Resample
-    MH_AudioData* resampled = mh_audio_resample(
-        input->data, input->channels, input->frames,
-        input->sample_rate, target_rate, err, sizeof(err));
-    if (!resampled) {
+    MH_AudioWriter* writer = mh_audio_writer_open(
+        output_path.c_str(), channels, converting ? target_rate : in_rate,
+        bit_depth, err, sizeof(err));
+    if (!writer) {
         print_error(err);
-        mh_audio_data_free(input);
+        mh_resampler_close(resampler);
+        mh_audio_reader_close(reader);
         return 1;
     }
 
-    // Write output
-    if (!mh_audio_write(output_path.c_str(), resampled->data,
-                        resampled->channels, resampled->frames,
-                        resampled->sample_rate, bit_depth, err, sizeof(err))) {
-        print_error(err);
-        mh_audio_data_free(resampled);
-        mh_audio_data_free(input);
-        return 1;
+    constexpr unsigned int kChunkFrames = 65536;
+    std::vector<float> in_buf((size_t)kChunkFrames * channels);
+    std::vector<float> out_buf;
+    if (converting) {
+        // Enough for one chunk's worth of output plus converter slack.
+        size_t out_cap = (size_t)((double)kChunkFrames * target_rate / in_rate) + 64;
+        out_buf.resize(out_cap * channels);
+    }
+
+    unsigned long long total_in = 0;
+    unsigned long long total_out = 0;
+    bool failed = false;
+
+    for (;;) {
+        long long got = mh_audio_reader_read_interleaved(reader, in_buf.data(), kChunkFrames);
+        if (got < 0) {
+            print_error("Decode error while reading input");
+            failed = true;
+            break;
+        }
+        if (got == 0) break;
+        total_in += (unsigned long long)got;
+
+        if (!converting) {
+            if (!mh_audio_writer_write(writer, in_buf.data(), (unsigned int)got,
+                                       err, sizeof(err))) {
+                print_error(err);
+                failed = true;
+                break;
+            }
+            total_out += (unsigned long long)got;
+            continue;
+        }
+
+        unsigned long long consumed_total = 0;
+        while (consumed_total < (unsigned long long)got && !failed) {
+            unsigned long long in_frames = (unsigned long long)got - consumed_total;
+            unsigned long long out_frames = out_buf.size() / channels;
+            if (!mh_resampler_process(resampler,
+                                      in_buf.data() + consumed_total * channels,
+                                      &in_frames, out_buf.data(), &out_frames,
+                                      err, sizeof(err))) {
+                print_error(err);
+                failed = true;
+                break;
+            }
+            if (out_frames > 0 &&
+                !mh_audio_writer_write(writer, out_buf.data(),
+                                       (unsigned int)out_frames, err, sizeof(err))) {
+                print_error(err);
+                failed = true;
+                break;
+            }
+            total_out += out_frames;
+            if (in_frames == 0 && out_frames == 0) break;  // no progress; done
+            consumed_total += in_frames;
+        }
+        if (failed) break;
+    }
+
+    // Flush the frames still latent in the converter's filter history.
+    if (!failed && converting) {
+        unsigned long long remaining = mh_resampler_latency(resampler);
+        while (remaining > 0) {
+            unsigned long long in_frames = 0;
+            unsigned long long out_frames = remaining;
+            if (out_frames > out_buf.size() / channels)
+                out_frames = out_buf.size() / channels;
+            if (!mh_resampler_process(resampler, nullptr, &in_frames,
+                                      out_buf.data(), &out_frames,
+                                      err, sizeof(err))) {
+                print_error(err);
+                failed = true;
+                break;
+            }
+            if (out_frames == 0) break;
+            if (!mh_audio_writer_write(writer, out_buf.data(),
+                                       (unsigned int)out_frames, err, sizeof(err))) {
+                print_error(err);
+                failed = true;
+                break;
+            }
+            total_out += out_frames;
+            remaining -= out_frames;
+        }
     }
 
-    std::printf("%s -> %s (%u Hz -> %u Hz, %u ch, %u -> %u frames, %d-bit)\n",
-                input_path.c_str(), output_path.c_str(),
-                input->sample_rate, resampled->sample_rate,
-                resampled->channels, input->frames, resampled->frames, bit_depth);
+    mh_resampler_close(resampler);
+    mh_audio_reader_close(reader);
+    if (!mh_audio_writer_close(writer, failed ? NULL : err,
+                               failed ? 0 : sizeof(err))) {
+        if (!failed) print_error(err);
+        failed = true;
+    }
+    if (failed) {
+        std::remove(output_path.c_str());
+        return 1;
+    }
 
-    mh_audio_data_free(resampled);
-    mh_audio_data_free(input);
+    if (converting) {
+        std::printf("%s -> %s (%u Hz -> %u Hz, %u ch, %llu -> %llu frames, %d-bit)\n",
+                    input_path.c_str(), output_path.c_str(),
+                    in_rate, target_rate, channels, total_in, total_out, bit_depth);
+    } else {
+        std::printf("%s -> %s (%u Hz, %u ch, %llu frames, %d-bit)\n",
+                    input_path.c_str(), output_path.c_str(),
+                    in_rate, channels, total_in, bit_depth);
+    }
     return 0;
 }
 
@@ -1899,6 +3681,9 @@ int main(int argc, char** argv) {
     mh_message_thread_init();
     std::atexit(mh_message_thread_shutdown);
 
+    if (argc > 0 && argv[0] && argv[0][0] != '\0')
+        g_self_exe = argv[0];
+
     CLI::App app{"minihost - Audio plugin hosting CLI"};
     app.require_subcommand(1);
 
@@ -1921,9 +3706,13 @@ int main(int argc, char** argv) {
     probe_cmd->add_option("plugin", probe_path, "Path to plugin (.vst3 or .component)")
         ->required();
     probe_cmd->add_flag("-j,--json", probe_json, "Output as JSON");
+    bool probe_binary = false;
+    probe_cmd->add_flag("--binary", probe_binary,
+                        "Write the raw MH_PluginDesc record to stdout "
+                        "(internal; worker mode for scan --isolated)");
 
     probe_cmd->callback([&]() {
-        std::exit(cmd_probe(probe_path, probe_json));
+        std::exit(cmd_probe(probe_path, probe_json, probe_binary));
     });
 
     // ========================================================================
@@ -1936,9 +3725,19 @@ int main(int argc, char** argv) {
     scan_cmd->add_option("directory", scan_dir, "Directory to scan")
         ->required();
     scan_cmd->add_flag("-j,--json", scan_json, "Output as JSON");
+    bool scan_isolated = false;
+    int scan_jobs = (int) std::thread::hardware_concurrency();
+    scan_cmd->add_flag("--isolated", scan_isolated,
+                       "Probe each plugin in a crash-isolated worker "
+                       "subprocess (a bad plugin skips only itself)");
+    scan_cmd->add_option("--jobs", scan_jobs,
+                         "Concurrent probe workers with --isolated "
+                         "(default: CPU count)");
 
     scan_cmd->callback([&]() {
-        std::exit(cmd_scan(scan_dir, scan_json));
+        std::exit(scan_isolated
+                      ? cmd_scan_isolated(scan_dir, scan_jobs, scan_json)
+                      : cmd_scan(scan_dir, scan_json));
     });
 
     // ========================================================================
@@ -2040,12 +3839,16 @@ int main(int argc, char** argv) {
                             "Load .vstpreset before saving (preserves class_id)");
     presets_cmd->add_flag("-y,--overwrite", presets_overwrite,
                           "Overwrite --save output if it exists");
+    double presets_audition = 0.0;
+    presets_cmd->add_option("--audition", presets_audition,
+                            "Play each preset for N seconds (prefetches the "
+                            "whole bank once, then switches from the cache)");
 
     presets_cmd->callback([&]() {
         std::exit(cmd_presets(presets_path, sample_rate, block_size,
                               presets_json, presets_save, presets_program,
                               presets_state, presets_load_vstpreset,
-                              presets_overwrite));
+                              presets_overwrite, presets_audition));
     });
 
     // ========================================================================
@@ -2148,8 +3951,58 @@ int main(int argc, char** argv) {
         ->check(CLI::IsMember({16, 24, 32}));
     process_cmd->add_option("-t,--tail", process_tail, "Tail length in seconds after MIDI ends (default: 2.0)")
         ->default_val(2.0);
+    bool process_stream = false;
+    process_cmd->add_flag("--stream", process_stream,
+                          "Stream decode -> process -> encode on a pipeline "
+                          "of threads (constant memory for any file length; "
+                          "requires -i and audio-file in/out)");
+    std::vector<std::string> process_batch;
+    int process_jobs = (int) std::thread::hardware_concurrency();
+    process_cmd->add_option("--batch", process_batch,
+                            "Batch mode: input audio files or glob patterns "
+                            "(repeatable); -o becomes a template where {} is "
+                            "the input file stem, or an output directory");
+    process_cmd->add_option("--jobs", process_jobs,
+                            "Concurrent batch workers with --batch "
+                            "(default: CPU count)");
 
     process_cmd->callback([&]() {
+        if (!process_batch.empty()) {
+            if (!process_input.empty() || !process_midi.empty() ||
+                !process_sidechain.empty() || process_double) {
+                print_error("--batch covers the audio-in/audio-out float path; "
+                            "-i, -m, --sidechain and -d are single-file only");
+                std::exit(1);
+            }
+            std::exit(cmd_process_batch(process_plugin, process_batch,
+                                        process_output,
+                                        sample_rate, block_size, process_state,
+                                        process_preset, process_params,
+                                        process_nrt, process_bpm,
+                                        process_bit_depth, process_jobs));
+        }
+        if (process_stream) {
+            if (process_input.empty()) {
+                print_error("--stream requires an audio input file (-i)");
+                std::exit(1);
+            }
+            if (!is_audio_file(process_input) || !is_audio_file(process_output)) {
+                print_error("--stream covers the audio-file in/out path; "
+                            "raw float32 files are single-file only");
+                std::exit(1);
+            }
+            if (!process_sidechain.empty() || process_double) {
+                print_error("--stream covers the main audio path; "
+                            "--sidechain and -d are buffered-mode only");
+                std::exit(1);
+            }
+            std::exit(cmd_process_stream(process_plugin, process_input,
+                                         process_output, process_midi,
+                                         block_size, process_state,
+                                         process_preset, process_params,
+                                         process_nrt, process_bpm,
+                                         process_bit_depth, process_tail));
+        }
         std::exit(cmd_process(process_plugin, process_input, process_output,
                               process_sidechain, process_midi,
                               sample_rate, block_size, process_state,
@@ -2158,6 +4011,27 @@ int main(int argc, char** argv) {
                               process_bit_depth, process_tail));
     });
 
+    // ========================================================================
+    // Subcommand: bench
+    // ========================================================================
+    auto* bench_cmd = app.add_subcommand(
+        "bench", "Measure offline plugin throughput over a block-size sweep");
+    std::vector<std::string> bench_plugins;
+    double bench_seconds = 10.0;
+    bool bench_json = false;
+
+    bench_cmd->add_option("plugin", bench_plugins,
+                          "Path to plugin (repeat to bench a chain)")
+        ->required();
+    bench_cmd->add_option("-t,--seconds", bench_seconds,
+                          "Seconds of audio to render per block size (default: 10)")
+        ->default_val(10.0);
+    bench_cmd->add_flag("-j,--json", bench_json, "Output as JSON");
+
+    bench_cmd->callback([&]() {
+        std::exit(cmd_bench(bench_plugins, sample_rate, bench_seconds, bench_json));
+    });
+
     // ========================================================================
     // Subcommand: morph
     // ========================================================================
@@ -2276,6 +4150,25 @@ int main(int argc, char** argv) {
                                resample_overwrite));
     });
 
+    // ========================================================================
+    // Subcommand: daemon
+    // ========================================================================
+    auto* daemon_cmd = app.add_subcommand(
+        "daemon", "Serve render requests from warm resident plugins");
+    std::string daemon_socket = "/tmp/minihost.sock";
+    int daemon_max_resident = 8;
+
+    daemon_cmd->add_option("-s,--socket", daemon_socket,
+                           "Unix socket path to listen on")
+        ->default_val("/tmp/minihost.sock");
+    daemon_cmd->add_option("--max-resident", daemon_max_resident,
+                           "Resident plugin instance limit (LRU eviction)")
+        ->default_val(8);
+
+    daemon_cmd->callback([&]() {
+        std::exit(cmd_daemon(daemon_socket, daemon_max_resident, block_size));
+    });
+
     // Parse and run
     CLI11_PARSE(app, argc, argv);
 
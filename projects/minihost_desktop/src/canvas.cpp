@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <unordered_set>
 
 namespace minihost_desktop {
@@ -25,6 +26,33 @@ CanvasComponent::CanvasComponent()
 {
     setOpaque(true);
     setWantsKeyboardFocus(true);
+
+#if MINIHOST_CANVAS_OPENGL
+    // Composite through the GPU: paint() still runs on the message
+    // thread, but rasterization moves to the GL thread, so big-display
+    // frames stop monopolizing message-thread time that parameter
+    // change notifications and other control work need. On-demand
+    // repainting only -- the dirty-rect invalidation drives what gets
+    // redrawn exactly as in the software path.
+    //
+    // MINIHOST_DESKTOP_NO_OPENGL=1 opts out at runtime for hosts whose
+    // GL stack is broken or absent (remote X, some CI images); the
+    // canvas then falls back to the software renderer transparently.
+    if (const char* no_gl = std::getenv("MINIHOST_DESKTOP_NO_OPENGL");
+        no_gl == nullptr || no_gl[0] == '\0' || no_gl[0] == '0')
+    {
+        gl_.setContinuousRepainting(false);
+        gl_.setComponentPaintingEnabled(true);
+        gl_.attachTo(*this);
+    }
+#endif
+}
+
+CanvasComponent::~CanvasComponent()
+{
+#if MINIHOST_CANVAS_OPENGL
+    gl_.detach();
+#endif
 }
 
 void CanvasComponent::setDocument(project::ProjectDocument* doc)
@@ -198,6 +226,12 @@ void CanvasComponent::edgeCubic(juce::Point<float> p0, juce::Point<float> p1,
 
 void CanvasComponent::paint(juce::Graphics& g)
 {
+    // Dirty-region rendering: the clip bounds describe the invalidated
+    // area (a node drag repaints one node plus its edges; the meter
+    // timer repaints meter rects), so anything outside it is skipped
+    // before any path or image work happens.
+    const auto clip = g.getClipBounds().toFloat();
+
     g.fillAll(juce::Colour(0xff1a1a1a));
 
     if (doc_ == nullptr)
@@ -219,6 +253,12 @@ void CanvasComponent::paint(juce::Graphics& g)
         const auto p1 = inputPortPos(dst, e.dst_port);
         juce::Point<float> c0, c1;
         edgeCubic(p0, p1, c0, c1);
+        // Control-point hull covers the curve; reject before building
+        // a Path.
+        const auto hull = juce::Rectangle<float>(p0, p1)
+                              .getUnion(juce::Rectangle<float>(c0, c1))
+                              .expanded(4.0f);
+        if (!clip.intersects(hull)) continue;
         juce::Path path;
         path.startNewSubPath(p0);
         path.cubicTo(c0, c1, p1);
@@ -256,19 +296,34 @@ void CanvasComponent::paint(juce::Graphics& g)
         g.fillPath(dashed);
     }
 
-    // Nodes.
-    g.setFont(juce::FontOptions(12.0f));
+    // Nodes. Each node's static rendering is cached in an image and
+    // blitted; the vector drawing only re-runs when the cache is stale
+    // (layout rebuild, selection change, display scale change).
+    const float scale = std::max(1.0f,
+        juce::Component::getApproximateScaleFactorForComponent(this));
     for (int i = 0; i < (int) nodes_.size(); ++i)
     {
-        const auto& n = nodes_[(size_t) i];
-        g.setColour(kindColour(n.kind));
-        g.fillRoundedRectangle(n.bounds, 6.0f);
-
-        g.setColour(i == selected_node_
-                    ? juce::Colours::yellow
-                    : juce::Colour(0xff707070));
-        g.drawRoundedRectangle(n.bounds, 6.0f,
-                               i == selected_node_ ? 2.0f : 1.0f);
+        auto& n = nodes_[(size_t) i];
+        const bool selected = (i == selected_node_);
+        const auto area = n.bounds.expanded(kPortRadius + 3.0f);
+        if (!clip.intersects(area)) continue;
+
+        if (n.cache.isNull()
+            || n.cache_selected != selected
+            || n.cache_scale != scale)
+        {
+            n.cache = juce::Image(juce::Image::ARGB,
+                std::max(1, (int) std::ceil(area.getWidth()  * scale)),
+                std::max(1, (int) std::ceil(area.getHeight() * scale)),
+                /*clearImage=*/true);
+            juce::Graphics ig(n.cache);
+            ig.addTransform(juce::AffineTransform::scale(scale)
+                .translated(-area.getX() * scale, -area.getY() * scale));
+            paintNodeBody(ig, n, selected);
+            n.cache_selected = selected;
+            n.cache_scale    = scale;
+        }
+        g.drawImage(n.cache, area);
 
         // Meter overlay: vertical per-channel level bars across the
         // bottom of the node. Always draws an empty frame so the
@@ -336,29 +391,94 @@ void CanvasComponent::paint(juce::Graphics& g)
             // Frame outline so the meter region reads as a box.
             g.setColour(juce::Colour(0xff404040));
             g.drawRect(box, 1.0f);
+
+            // Meter labels draw live so they stay above the bars
+            // (every other kind's label is baked into the cache).
+            g.setFont(juce::FontOptions(12.0f));
+            g.setColour(juce::Colours::white);
+            g.drawFittedText(n.label,
+                             n.bounds.toNearestInt().reduced(8),
+                             juce::Justification::centred, 3);
         }
+    }
+}
+
+void CanvasComponent::paintNodeBody(juce::Graphics& g, const NodeLayout& n,
+                                    bool selected) const
+{
+    g.setColour(kindColour(n.kind));
+    g.fillRoundedRectangle(n.bounds, 6.0f);
 
+    g.setColour(selected ? juce::Colours::yellow : juce::Colour(0xff707070));
+    g.drawRoundedRectangle(n.bounds, 6.0f, selected ? 2.0f : 1.0f);
+
+    if (n.kind != "meter")
+    {
+        g.setFont(juce::FontOptions(12.0f));
         g.setColour(juce::Colours::white);
         g.drawFittedText(n.label,
                          n.bounds.toNearestInt().reduced(8),
                          juce::Justification::centred, 3);
+    }
 
-        g.setColour(juce::Colour(0xffd0d0d0));
-        for (int port = 0; port < n.num_input_ports; ++port)
-        {
-            const auto p = inputPortPos(n, port);
-            g.fillEllipse(p.x - kPortRadius, p.y - kPortRadius,
-                          kPortRadius * 2, kPortRadius * 2);
-        }
-        if (n.num_output_ports > 0)
-        {
-            const auto p = outputPortPos(n);
-            g.fillEllipse(p.x - kPortRadius, p.y - kPortRadius,
-                          kPortRadius * 2, kPortRadius * 2);
-        }
+    g.setColour(juce::Colour(0xffd0d0d0));
+    for (int port = 0; port < n.num_input_ports; ++port)
+    {
+        const auto p = inputPortPos(n, port);
+        g.fillEllipse(p.x - kPortRadius, p.y - kPortRadius,
+                      kPortRadius * 2, kPortRadius * 2);
+    }
+    if (n.num_output_ports > 0)
+    {
+        const auto p = outputPortPos(n);
+        g.fillEllipse(p.x - kPortRadius, p.y - kPortRadius,
+                      kPortRadius * 2, kPortRadius * 2);
     }
 }
 
+juce::Rectangle<float> CanvasComponent::edgeBounds(const EdgeLayout& e) const
+{
+    const auto p0 = outputPortPos(nodes_[(size_t) e.src_node_index]);
+    const auto p1 = inputPortPos(nodes_[(size_t) e.dst_node_index],
+                                 e.dst_port);
+    juce::Point<float> c0, c1;
+    edgeCubic(p0, p1, c0, c1);
+    return juce::Rectangle<float>(p0, p1)
+        .getUnion(juce::Rectangle<float>(c0, c1))
+        .expanded(4.0f);
+}
+
+juce::Rectangle<int> CanvasComponent::nodeRepaintArea(int node_index) const
+{
+    auto area = nodes_[(size_t) node_index].bounds
+                    .expanded(kPortRadius + 3.0f);
+    for (const auto& e : edges_)
+        if (e.src_node_index == node_index || e.dst_node_index == node_index)
+            area = area.getUnion(edgeBounds(e));
+    return area.toNearestInt().expanded(2);
+}
+
+juce::Rectangle<float> CanvasComponent::connectDragBounds() const
+{
+    if (connect_from_node_ < 0) return {};
+    const auto p0 = outputPortPos(nodes_[(size_t) connect_from_node_]);
+    const auto p1 = connect_to_pos_;
+    juce::Point<float> c0, c1;
+    edgeCubic(p0, p1, c0, c1);
+    return juce::Rectangle<float>(p0, p1)
+        .getUnion(juce::Rectangle<float>(c0, c1))
+        .expanded(4.0f);
+}
+
+// Meter animation tick: an idle canvas with live meters invalidates a
+// few small rectangles, not the whole graph.
+void CanvasComponent::timerCallback()
+{
+    for (const auto& n : nodes_)
+        if (n.kind == "meter")
+            repaint(n.bounds.toNearestInt().expanded(2));
+}
+
 int CanvasComponent::hitTestNode(juce::Point<float> p) const
 {
     for (int i = (int) nodes_.size() - 1; i >= 0; --i)
@@ -534,16 +654,21 @@ void CanvasComponent::mouseDown(const juce::MouseEvent& e)
 
 void CanvasComponent::mouseDrag(const juce::MouseEvent& e)
 {
+    // Per-frame drags invalidate only the affected region (old position
+    // union new), so an 80-node graph repaints one node and its edges.
     if (drag_kind_ == DragKind::MovingNode && dragging_node_ >= 0)
     {
+        auto dirty = nodeRepaintArea(dragging_node_);
         auto& n = nodes_[(size_t) dragging_node_];
         n.bounds.setPosition(e.position - drag_offset_);
-        repaint();
+        repaint(dirty.getUnion(nodeRepaintArea(dragging_node_)));
     }
     else if (drag_kind_ == DragKind::ConnectingFromPort)
     {
+        const auto old_area = connectDragBounds();
         connect_to_pos_ = e.position;
-        repaint();
+        repaint(old_area.getUnion(connectDragBounds())
+                    .toNearestInt().expanded(2));
     }
 }
 
@@ -24,6 +24,18 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>  // juce::PluginDescription
 
+// GPU compositing (MINIHOST_DESKTOP_OPENGL in CMake). When enabled, an
+// OpenGLContext is attached to the canvas so component painting
+// rasterizes and composites on the GL thread instead of the software
+// renderer -- the paint() code and the dirty-rect invalidation are
+// unchanged, only the backend differs.
+#ifndef MINIHOST_CANVAS_OPENGL
+ #define MINIHOST_CANVAS_OPENGL 0
+#endif
+#if MINIHOST_CANVAS_OPENGL
+ #include <juce_opengl/juce_opengl.h>
+#endif
+
 #include <functional>
 #include <unordered_map>
 #include <vector>
@@ -35,6 +47,7 @@ class CanvasComponent : public juce::Component,
 {
 public:
     CanvasComponent();
+    ~CanvasComponent() override;
 
     // Callback fired when the user double-clicks a plugin node. The
     // argument is the index into doc->plugins (NOT the canvas's
@@ -63,8 +76,13 @@ public:
 
     // After the application updates a plugin's state_b64 (e.g. user
     // captured editor state), call this so the canvas refreshes its
-    // label cache. Pure repaint trigger; no layout recompute.
-    void notifyDocumentChanged() { repaint(); }
+    // label cache. Repaint trigger (drops the per-node render caches);
+    // no layout recompute.
+    void notifyDocumentChanged()
+    {
+        for (auto& n : nodes_) n.cache = juce::Image();
+        repaint();
+    }
 
     // Undo / redo of canvas edits (add / delete / connect / move /
     // properties). Snapshot-based: each edit records the pre-edit
@@ -119,6 +137,17 @@ private:
         juce::Rectangle<float> bounds;
         int                 num_input_ports  = 0;
         int                 num_output_ports = 0;  // 0 for output kind, 1 otherwise
+
+        // Cached rendering of the node body (fill, border, label,
+        // ports) so a dirty-rect repaint blits an image instead of
+        // re-running the vector drawing. Null until first painted;
+        // regenerated when the selection state or display scale the
+        // cache was rendered at no longer matches. Meter bars animate,
+        // so they draw live on top of the cache (and meter labels with
+        // them, to keep text above the bars).
+        juce::Image         cache;
+        bool                cache_selected = false;
+        float               cache_scale    = 0.0f;
     };
 
     // Per-edge visual data. doc_edge_index is the position of the
@@ -156,6 +185,22 @@ private:
     void edgeCubic(juce::Point<float> p0, juce::Point<float> p1,
                    juce::Point<float>& c0, juce::Point<float>& c1) const;
 
+    // Dirty-region helpers. edgeBounds is a conservative cover of an
+    // edge's curve (the bezier stays inside its control-point hull);
+    // nodeRepaintArea is the smallest screen region a change to one
+    // node must invalidate: its bounds plus ports, selection stroke,
+    // and every attached edge. connectDragBounds covers the in-progress
+    // rubber-band curve.
+    juce::Rectangle<float> edgeBounds(const EdgeLayout& e) const;
+    juce::Rectangle<int>   nodeRepaintArea(int node_index) const;
+    juce::Rectangle<float> connectDragBounds() const;
+
+    // The static part of a node's rendering (everything except meter
+    // bars and, for meter nodes, the label). Drawn into the per-node
+    // image cache; coordinates are canvas-space.
+    void paintNodeBody(juce::Graphics& g, const NodeLayout& n,
+                       bool selected) const;
+
     void showContextMenu(juce::Point<int> screen_pos);
     // File-chooser flows (registry can't express async UI cleanly):
     void addPluginNode();           // launches an async file chooser
@@ -185,13 +230,19 @@ private:
     // Also notifies the application that an edit is happening.
     void recordUndo();
 
+#if MINIHOST_CANVAS_OPENGL
+    // Attached in the constructor (unless opted out via the
+    // MINIHOST_DESKTOP_NO_OPENGL env var), detached in the destructor.
+    juce::OpenGLContext       gl_;
+#endif
+
     project::ProjectDocument* doc_ = nullptr;
     project::LoadedProject*   live_project_ = nullptr;
     UndoHistory               undo_history_;
     DocumentEditedCb          on_document_edited_;
 
-    // juce::Timer
-    void timerCallback() override { repaint(); }
+    // juce::Timer -- meter animation tick; invalidates meter rects only.
+    void timerCallback() override;
     OpenPluginEditorCb        on_open_plugin_editor_;
     AddPluginRequestedCb      on_add_plugin_requested_;
     std::vector<NodeLayout>   nodes_;
@@ -7,6 +7,64 @@
 
 namespace minihost_desktop {
 
+namespace {
+
+// Allocates the planar audio storage + pointer tables the audio
+// callback hands to mh_graph_render_block for one loaded project.
+// Input order is file inputs, then device_inputs, then metronomes;
+// output order is file sinks, then device_outputs, then meters --
+// both match the loader's add-order. Shared by start() and the
+// hot-swap path so the two can't drift.
+void buildBufferTables(const project::LoadedProject& proj,
+                       int block_size,
+                       std::vector<std::vector<float>>&        in_planar,
+                       std::vector<std::vector<const float*>>& in_ch_ptrs,
+                       std::vector<const float* const*>&       in_top_ptrs,
+                       std::vector<std::vector<float>>&        out_planar,
+                       std::vector<std::vector<float*>>&       out_ch_ptrs,
+                       std::vector<float* const*>&             out_top_ptrs)
+{
+    in_planar.clear();
+    in_ch_ptrs.clear();
+    in_top_ptrs.clear();
+    auto pushIn = [&](int channels) {
+        std::vector<float> buf((size_t) channels
+                               * (size_t) block_size, 0.0f);
+        std::vector<const float*> ptrs((size_t) channels);
+        for (int c = 0; c < channels; ++c)
+            ptrs[(size_t) c] = buf.data() + (size_t) c * block_size;
+        in_planar.push_back(std::move(buf));
+        in_ch_ptrs.push_back(std::move(ptrs));
+    };
+    for (const auto& in : proj.doc.inputs)        pushIn(in.channels);
+    for (const auto& di : proj.doc.device_inputs) pushIn(di.channels);
+    for (const auto& mn : proj.doc.metronomes)    pushIn(mn.channels);
+    in_top_ptrs.resize(in_ch_ptrs.size());
+    for (size_t i = 0; i < in_ch_ptrs.size(); ++i)
+        in_top_ptrs[i] = in_ch_ptrs[i].data();
+
+    out_planar.clear();
+    out_ch_ptrs.clear();
+    out_top_ptrs.clear();
+    auto pushOut = [&](int channels) {
+        std::vector<float> buf((size_t) channels
+                               * (size_t) block_size, 0.0f);
+        std::vector<float*> ptrs((size_t) channels);
+        for (int c = 0; c < channels; ++c)
+            ptrs[(size_t) c] = buf.data() + (size_t) c * block_size;
+        out_planar.push_back(std::move(buf));
+        out_ch_ptrs.push_back(std::move(ptrs));
+    };
+    for (const auto& on : proj.doc.outputs)        pushOut(on.channels);
+    for (const auto& dn : proj.doc.device_outputs) pushOut(dn.channels);
+    for (const auto& mn : proj.doc.meters)         pushOut(mn.channels);
+    out_top_ptrs.resize(out_ch_ptrs.size());
+    for (size_t i = 0; i < out_ch_ptrs.size(); ++i)
+        out_top_ptrs[i] = out_ch_ptrs[i].data();
+}
+
+} // namespace
+
 LiveEngine::LiveEngine() {}
 
 LiveEngine::~LiveEngine()
@@ -170,52 +228,15 @@ bool LiveEngine::start(const juce::File& project_file, juce::String& error)
     }
 
     // Pre-allocate input/output buffer storage + pointer tables.
-    // File-source inputs come first, then device_inputs -- matches the
-    // loader's add-order. Both are zero-filled here; per-block the
-    // audio callback overwrites device_input slots with the live
-    // device input channels, while file-source slots stay silent
-    // (their WAV data is only staged during file rendering).
-    in_planar_.clear();
-    in_ch_ptrs_.clear();
-    in_top_ptrs_.clear();
-    auto pushIn = [&](int channels) {
-        std::vector<float> buf((size_t) channels
-                               * (size_t) cb_block_size_, 0.0f);
-        std::vector<const float*> ptrs((size_t) channels);
-        for (int c = 0; c < channels; ++c)
-            ptrs[(size_t) c] = buf.data() + (size_t) c * cb_block_size_;
-        in_planar_.push_back(std::move(buf));
-        in_ch_ptrs_.push_back(std::move(ptrs));
-    };
-    for (const auto& in : compiled_->doc.inputs)        pushIn(in.channels);
-    for (const auto& di : compiled_->doc.device_inputs) pushIn(di.channels);
-    for (const auto& mn : compiled_->doc.metronomes)    pushIn(mn.channels);
-    in_top_ptrs_.resize(in_ch_ptrs_.size());
-    for (size_t i = 0; i < in_ch_ptrs_.size(); ++i)
-        in_top_ptrs_[i] = in_ch_ptrs_[i].data();
-
-    out_planar_.clear();
-    out_ch_ptrs_.clear();
-    out_top_ptrs_.clear();
-    // File-sink outputs come first, then device_outputs -- ordering
-    // matches the loader. LiveEngine writes file-sink buffers nowhere
-    // (file rendering is a separate path); they're allocated so the
-    // graph has somewhere to write each block.
-    auto pushOut = [&](int channels) {
-        std::vector<float> buf((size_t) channels
-                               * (size_t) cb_block_size_, 0.0f);
-        std::vector<float*> ptrs((size_t) channels);
-        for (int c = 0; c < channels; ++c)
-            ptrs[(size_t) c] = buf.data() + (size_t) c * cb_block_size_;
-        out_planar_.push_back(std::move(buf));
-        out_ch_ptrs_.push_back(std::move(ptrs));
-    };
-    for (const auto& on : compiled_->doc.outputs)        pushOut(on.channels);
-    for (const auto& dn : compiled_->doc.device_outputs) pushOut(dn.channels);
-    for (const auto& mn : compiled_->doc.meters)         pushOut(mn.channels);
-    out_top_ptrs_.resize(out_ch_ptrs_.size());
-    for (size_t i = 0; i < out_ch_ptrs_.size(); ++i)
-        out_top_ptrs_[i] = out_ch_ptrs_[i].data();
+    // All zero-filled here; per-block the audio callback overwrites
+    // device_input slots with the live device input channels, while
+    // file-source slots stay silent (their WAV data is only staged
+    // during file rendering). File-sink output buffers are written
+    // nowhere live; they're allocated so the graph has somewhere to
+    // write each block.
+    buildBufferTables(*compiled_, cb_block_size_,
+                      in_planar_, in_ch_ptrs_, in_top_ptrs_,
+                      out_planar_, out_ch_ptrs_, out_top_ptrs_);
 
     if (out_planar_.empty())
     {
@@ -258,11 +279,24 @@ bool LiveEngine::start(const juce::File& project_file, juce::String& error)
         }
     }
 
+    // Per-node profiling is always on live: the accumulators are
+    // relaxed atomics the audio thread updates wait-free, and the GUI
+    // can ask which node eats the budget the moment an overrun shows
+    // up rather than after a restart-with-profiling.
+    compiled_->graph->setProfiling(true);
+
     dm_.addAudioCallback(this);
     running_.store(true, std::memory_order_release);
     return true;
 }
 
+bool LiveEngine::nodeStats(int node, MH_NodeStats& out) const noexcept
+{
+    if (compiled_ == nullptr || compiled_->graph == nullptr)
+        return false;
+    return compiled_->graph->nodeStats(node, out);
+}
+
 void LiveEngine::detachCallback()
 {
     if (running_.load(std::memory_order_acquire))
@@ -275,12 +309,83 @@ void LiveEngine::detachCallback()
 void LiveEngine::stop()
 {
     detachCallback();
+    // Callback is detached; any rig still parked in the hot-swap
+    // slots is reclaimed here on the message thread.
+    if (SwapRig* p = pending_swap_.exchange(nullptr)) delete p;
+    reapRetiredSwap_();
+    swap_fade_in_next_ = false;
     transport_playing_.store(false);
     transport_pos_samples_ = 0;
     transport_pos_beats_   = 0.0;
     compiled_.reset();
 }
 
+void LiveEngine::reapRetiredSwap_()
+{
+    if (SwapRig* old = retired_swap_.exchange(nullptr,
+                                              std::memory_order_acq_rel))
+        delete old;
+}
+
+bool LiveEngine::applyProjectEdit(const juce::File& project_file,
+                                  juce::String& error)
+{
+    if (!running_.load(std::memory_order_acquire) || compiled_ == nullptr)
+    {
+        error = "live engine is not running; use start()";
+        return false;
+    }
+    reapRetiredSwap_();
+    if (pending_swap_.load(std::memory_order_acquire) != nullptr)
+    {
+        error = "a previous edit is still being applied; try again";
+        return false;
+    }
+
+    std::unique_ptr<project::LoadedProject> next;
+    try {
+        next = project::loadProject(project_file);
+    } catch (const std::exception& e) {
+        error = juce::String("loadProject failed: ") + e.what();
+        return false;
+    }
+
+    // The device keeps running across the swap, so anything that
+    // would need it reconfigured forces the stop/start path instead.
+    if (next->doc.sample_rate != compiled_->doc.sample_rate)
+    {
+        error = "sample rate changed; a full live restart is required";
+        return false;
+    }
+    int needed_in_ch = 0;
+    for (const auto& di : next->doc.device_inputs)
+        needed_in_ch = std::max(needed_in_ch, di.channels);
+    const auto setup = dm_.getAudioDeviceSetup();
+    if (needed_in_ch > setup.inputChannels.countNumberOfSetBits())
+    {
+        error = "project needs more device input channels; "
+                "a full live restart is required";
+        return false;
+    }
+
+    auto rig = std::make_unique<SwapRig>();
+    rig->block_size = next->doc.block_size;
+    buildBufferTables(*next, rig->block_size,
+                      rig->in_planar, rig->in_ch_ptrs, rig->in_top_ptrs,
+                      rig->out_planar, rig->out_ch_ptrs, rig->out_top_ptrs);
+    if (rig->out_planar.empty())
+    {
+        error = "project has no output nodes; nothing to play live";
+        return false;
+    }
+
+    // Same always-on profiling contract as start().
+    next->graph->setProfiling(true);
+    rig->project = std::move(next);
+    pending_swap_.store(rig.release(), std::memory_order_release);
+    return true;
+}
+
 void LiveEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
 {
     if (device != nullptr)
@@ -299,46 +404,118 @@ void LiveEngine::audioDeviceError(const juce::String& errorMessage)
     std::fprintf(stderr, "live audio error: %s\n", errorMessage.toRawUTF8());
 }
 
+bool LiveEngine::enqueueCommand(const RtCommand& cmd) noexcept
+{
+    return command_queue_.push(cmd);
+}
+
 bool LiveEngine::enqueueParamWrite(int plugin_node_index,
                                    int param_index, float value) noexcept
 {
-    ParamWriteCommand cmd{ plugin_node_index, param_index, value };
-    return param_queue_.push(cmd);
+    return command_queue_.push(
+        RtCommand::paramWrite(plugin_node_index, param_index, value));
+}
+
+bool LiveEngine::enqueueBypass(int plugin_node_index, bool bypassed) noexcept
+{
+    return command_queue_.push(
+        RtCommand::bypassToggle(plugin_node_index, bypassed));
+}
+
+bool LiveEngine::enqueueMixGain(int mix_node, int input_index,
+                                float gain) noexcept
+{
+    return command_queue_.push(
+        RtCommand::mixGain(mix_node, input_index, gain));
+}
+
+bool LiveEngine::enqueueTransport(bool playing, double bpm) noexcept
+{
+    return command_queue_.push(RtCommand::transportState(playing, bpm));
+}
+
+int LiveEngine::drainCommandsForTest()
+{
+    return drainCommands_(/*max=*/INT_MAX);
 }
 
-int LiveEngine::drainParamWritesForTest()
+// Resolve a plugin node index to its JUCE processor, or nullptr if the
+// index is stale / the plugin has no processor. Drain-time commands
+// referencing nodes removed by a project edit are silently dropped.
+static juce::AudioProcessor* resolveProcessor(
+    const project::LoadedProject* compiled, int plugin_node_index)
 {
-    return drainParamWrites_(/*max=*/INT_MAX);
+    if (plugin_node_index < 0
+        || plugin_node_index >= (int) compiled->plugins.size())
+        return nullptr;
+    MH_Plugin* p = compiled->plugins[(size_t) plugin_node_index];
+    if (p == nullptr) return nullptr;
+    return static_cast<juce::AudioProcessor*>(mh_get_juce_processor(p));
 }
 
-int LiveEngine::drainParamWrites_(int max)
+int LiveEngine::drainCommands_(int max)
 {
     if (compiled_ == nullptr) return 0;
     int applied = 0;
-    ParamWriteCommand cmd;
-    while (applied < max && param_queue_.pop(cmd))
+    RtCommand cmd;
+    while (applied < max && command_queue_.pop(cmd))
     {
-        if (cmd.plugin_node_index < 0
-            || cmd.plugin_node_index
-                 >= (int) compiled_->plugins.size())
-            continue;
-        MH_Plugin* p = compiled_->plugins[(size_t) cmd.plugin_node_index];
-        if (p == nullptr) continue;
-
-        auto* proc = static_cast<juce::AudioProcessor*>(
-            mh_get_juce_processor(p));
-        if (proc == nullptr) continue;
-
-        const auto& params = proc->getParameters();
-        if (cmd.param_index < 0 || cmd.param_index >= params.size())
-            continue;
-        auto* param = params[cmd.param_index];
-        if (param == nullptr) continue;
-        // setValue is RT-safe per JUCE's contract -- atomic store
-        // into the parameter's value cache. Does NOT acquire
-        // libminihost's mutex (which mh_set_param would).
-        param->setValue(juce::jlimit(0.0f, 1.0f, cmd.value));
-        ++applied;
+        switch (cmd.kind)
+        {
+        case RtCommand::Kind::ParamWrite:
+        {
+            auto* proc = resolveProcessor(compiled_.get(),
+                                           cmd.param.plugin_node_index);
+            if (proc == nullptr) continue;
+            const auto& params = proc->getParameters();
+            if (cmd.param.param_index < 0
+                || cmd.param.param_index >= params.size())
+                continue;
+            auto* param = params[cmd.param.param_index];
+            if (param == nullptr) continue;
+            // setValue is RT-safe per JUCE's contract -- atomic store
+            // into the parameter's value cache. Does NOT acquire
+            // libminihost's mutex (which mh_set_param would).
+            param->setValue(juce::jlimit(0.0f, 1.0f, cmd.param.value));
+            ++applied;
+            break;
+        }
+        case RtCommand::Kind::BypassToggle:
+        {
+            auto* proc = resolveProcessor(compiled_.get(),
+                                           cmd.bypass.plugin_node_index);
+            if (proc == nullptr) continue;
+            // Same RT-safe parameter path as ParamWrite. Plugins
+            // without a bypass parameter drop the command.
+            auto* bypass = proc->getBypassParameter();
+            if (bypass == nullptr) continue;
+            bypass->setValue(cmd.bypass.bypassed ? 1.0f : 0.0f);
+            ++applied;
+            break;
+        }
+        case RtCommand::Kind::MixGain:
+        {
+            // A plain store into the node's gain array -- no lock, no
+            // allocation. We're on the render thread between blocks,
+            // which satisfies the graph's threading contract.
+            if (compiled_->graph == nullptr) continue;
+            if (!mh_graph_set_mix_gain(compiled_->graph->handle(),
+                                       cmd.mix.mix_node,
+                                       cmd.mix.input_index,
+                                       cmd.mix.gain))
+                continue;
+            ++applied;
+            break;
+        }
+        case RtCommand::Kind::Transport:
+        {
+            transport_playing_.store(cmd.transport.playing != 0);
+            if (cmd.transport.bpm > 0.0)
+                transport_bpm_.store(cmd.transport.bpm);
+            ++applied;
+            break;
+        }
+        }
     }
     return applied;
 }
@@ -362,6 +539,21 @@ void LiveEngine::audioDeviceIOCallbackWithContext(
         return;
     }
 
+    // Hot-swap pickup (applyProjectEdit): at most one rig per
+    // callback. This callback still renders on the outgoing rig; the
+    // device output gets a linear fade-out across the buffer, the
+    // swap happens after the buffer is filled, and the next callback
+    // fades the incoming graph back in. One device buffer of fade
+    // each way (~1-20 ms) avoids clicks without paying to render
+    // both graphs. pending_swap_ is cleared only after the displaced
+    // rig is parked, so the GUI-side "edit in flight" gate stays
+    // closed for the whole window.
+    SwapRig* incoming = nullptr;
+    if (retired_swap_.load(std::memory_order_acquire) == nullptr)
+        incoming = pending_swap_.load(std::memory_order_acquire);
+    const bool fade_in = swap_fade_in_next_;
+    swap_fade_in_next_ = false;
+
     // Render in chunks of up to cb_block_size_. Device callback sizes
     // are usually small (64-1024) so a single chunk is the norm.
     int frames_left = numSamples;
@@ -414,10 +606,11 @@ void LiveEngine::audioDeviceIOCallbackWithContext(
             }
         }
 
-        // Drain any pending parameter writes from the GUI before
-        // rendering this block. RT-safe (lock-free queue + RT-safe
-        // setValue on each AudioProcessorParameter).
-        drainParamWrites_(/*max=*/64);
+        // Drain any pending commands (param writes, bypass, mix gain,
+        // transport) from the control threads before rendering this
+        // block. RT-safe: lock-free queue, and every command kind
+        // applies through an RT-safe path (see drainCommands_).
+        drainCommands_(/*max=*/64);
 
         // Drain MIDI events from the ring buffer. All events go to
         // every plugin node (v1 fan-out routing). Per-plugin
@@ -553,6 +746,13 @@ void LiveEngine::audioDeviceIOCallbackWithContext(
                     std::memset(outputChannelData[c] + offset, 0,
                                 (size_t) (numSamples - offset)
                                 * sizeof(float));
+            // A rig we were about to adopt goes to the retired slot
+            // unadopted (never freed here); stop() will reclaim it.
+            if (incoming != nullptr)
+            {
+                retired_swap_.store(incoming, std::memory_order_release);
+                pending_swap_.store(nullptr, std::memory_order_release);
+            }
             running_.store(false, std::memory_order_release);
             return;
         }
@@ -619,6 +819,43 @@ void LiveEngine::audioDeviceIOCallbackWithContext(
         frames_left -= n;
         offset      += n;
     }
+
+    // Swap-boundary gain ramp over the whole device buffer: down to
+    // zero when an edit lands this callback, up from zero on the
+    // first callback after it. Both at once (two edits in back-to-
+    // back callbacks) degenerates to one silent buffer, which is fine.
+    const float g0 = fade_in ? 0.0f : 1.0f;
+    const float g1 = (incoming != nullptr) ? 0.0f : 1.0f;
+    if (numSamples > 0 && (g0 != 1.0f || g1 != 1.0f))
+    {
+        for (int c = 0; c < numOutputChannels; ++c)
+        {
+            float* d = outputChannelData[c];
+            if (d == nullptr) continue;
+            for (int i = 0; i < numSamples; ++i)
+                d[i] *= g0 + (g1 - g0)
+                             * ((float) i / (float) numSamples);
+        }
+    }
+
+    if (incoming != nullptr)
+    {
+        // Adopt the new rig now that the old one has rendered its
+        // final (faded) buffer. Pure pointer swaps -- vector::swap
+        // and unique_ptr::swap allocate nothing -- then park the
+        // displaced rig for the message thread to delete.
+        compiled_.swap(incoming->project);
+        in_planar_.swap(incoming->in_planar);
+        in_ch_ptrs_.swap(incoming->in_ch_ptrs);
+        in_top_ptrs_.swap(incoming->in_top_ptrs);
+        out_planar_.swap(incoming->out_planar);
+        out_ch_ptrs_.swap(incoming->out_ch_ptrs);
+        out_top_ptrs_.swap(incoming->out_top_ptrs);
+        std::swap(cb_block_size_, incoming->block_size);
+        swap_fade_in_next_ = true;
+        retired_swap_.store(incoming, std::memory_order_release);
+        pending_swap_.store(nullptr, std::memory_order_release);
+    }
 }
 
 } // namespace minihost_desktop
@@ -50,13 +50,34 @@ public:
     void stop();
     bool isRunning() const noexcept { return running_.load(); }
 
+    // Hot-swap the running graph without stopping the audio device.
+    // Loads + compiles `project_file` on the message thread, then
+    // publishes it for the audio callback to adopt at its next block
+    // boundary: the callback renders one last buffer on the outgoing
+    // graph under a linear fade-out, swaps pointers (allocation-free),
+    // and fades the new graph in over the following buffer. The
+    // displaced project stays alive until the next applyProjectEdit /
+    // stop so GUI pointers from loadedProject() don't dangle.
+    //
+    // Refused (returns false with `error` set, engine keeps playing
+    // the old graph) when the engine is not running, a previous edit
+    // has not been picked up yet, or the edit needs the device
+    // reconfigured -- sample-rate change or more device input
+    // channels -- in which case callers should fall back to the full
+    // stop/start path. Message thread only.
+    bool applyProjectEdit(const juce::File& project_file,
+                          juce::String& error);
+
     juce::AudioDeviceManager& deviceManager() noexcept { return dm_; }
 
     // Currently-loaded live project, or nullptr if not running.
     // Valid only on the GUI thread; both start()/stop() and the
     // returned pointer's consumers live there, so no locking is
     // required as long as callers don't stash the pointer across
-    // event-loop iterations without re-checking.
+    // event-loop iterations without re-checking. After an
+    // applyProjectEdit the returned pointer changes once the audio
+    // thread picks the new project up (within one device callback),
+    // so re-fetch shortly after an edit.
     project::LoadedProject* loadedProject() noexcept
     { return compiled_.get(); }
 
@@ -66,12 +87,23 @@ public:
     void loadSettingsFromXml(const juce::String& xml);
     juce::String saveSettingsAsXml() const;
 
-    // Enqueue a parameter write for the audio thread to apply on the
-    // next callback block. Safe to call from the message thread.
-    // Returns false if the queue is full (drop-newest).
+    // Enqueue a command for the audio thread to apply on the next
+    // callback block. Safe to call from any control thread (GUI,
+    // control-surface listeners, automation playback) concurrently --
+    // the queue is MPSC. Returns false if the queue is full
+    // (drop-newest).
+    bool enqueueCommand(const RtCommand& cmd) noexcept;
+
+    // Convenience wrappers around enqueueCommand for the common kinds.
     bool enqueueParamWrite(int plugin_node_index,
                            int param_index,
                            float value) noexcept;
+    bool enqueueBypass(int plugin_node_index, bool bypassed) noexcept;
+    bool enqueueMixGain(int mix_node, int input_index, float gain) noexcept;
+    // Transport via the queue lands in order with surrounding param
+    // writes (e.g. automation playback arming values before a start);
+    // setTransportPlaying / setBpm below remain the direct path.
+    bool enqueueTransport(bool playing, double bpm) noexcept;
 
     // Transport. Default BPM is 120; default state is stopped.
     void setTransportPlaying(bool playing) noexcept
@@ -110,11 +142,20 @@ public:
     juce::String midiInputDevice() const noexcept
     { return midi_input_port_name_; }
 
+    // Per-node render profiling (mh_graph_get_node_stats). Enabled for
+    // the whole live run at start(). Safe to poll from the GUI thread
+    // while the audio callback renders -- the accumulators are
+    // lock-free -- so a stats overlay can show which node eats the
+    // block budget in real time. Returns false when not running or the
+    // node id is out of range.
+    bool nodeStats(int node, MH_NodeStats& out) const noexcept;
+
     // Test hook: drain pending commands synchronously, applying them
-    // to the live engine's plugins. The real audio callback drains
-    // before each render_block. Returns the number of commands
-    // applied. Not safe to call concurrently with the audio thread.
-    int drainParamWritesForTest();
+    // to the live engine's plugins / graph / transport. The real audio
+    // callback drains before each render_block. Returns the number of
+    // commands applied. Not safe to call concurrently with the audio
+    // thread.
+    int drainCommandsForTest();
 
     // juce::AudioIODeviceCallback
     void audioDeviceIOCallbackWithContext(
@@ -133,6 +174,43 @@ private:
     void detachCallback();
     void initialiseDeviceManagerOnce();
 
+    // ----- lock-free graph hot-swap (applyProjectEdit) ----- //
+    // A SwapRig bundles everything the audio thread must exchange to
+    // move onto a new compiled project: the project itself plus the
+    // pre-allocated planar buffers / pointer tables sized for its
+    // block size. Built and freed on the message thread only; the
+    // audio thread adopts one by swapping its contents member-for-
+    // member (vector swap = pointer swaps, allocation-free).
+    struct SwapRig {
+        std::unique_ptr<project::LoadedProject> project;
+        std::vector<std::vector<float>>         in_planar;
+        std::vector<std::vector<const float*>>  in_ch_ptrs;
+        std::vector<const float* const*>        in_top_ptrs;
+        std::vector<std::vector<float>>         out_planar;
+        std::vector<std::vector<float*>>        out_ch_ptrs;
+        std::vector<float* const*>              out_top_ptrs;
+        int                                     block_size = 0;
+    };
+
+    // Message thread -> audio thread: the next rig to adopt. The
+    // callback renders on the old rig under a fade-out, swaps at the
+    // end of the buffer, parks the displaced rig in retired_swap_ for
+    // the message thread to delete (the audio thread never frees
+    // memory), and only then clears pending_swap_ -- so a non-null
+    // pending slot always means "an edit is in flight" to the GUI.
+    std::atomic<SwapRig*> pending_swap_{ nullptr };
+    std::atomic<SwapRig*> retired_swap_{ nullptr };
+
+    // Audio-thread only: fade the first buffer after a swap back in
+    // so the incoming graph doesn't click.
+    bool swap_fade_in_next_ = false;
+
+    // Deletes the rig displaced by the last swap. Message thread
+    // only; called from applyProjectEdit and stop(). Deliberately
+    // deferred to those points so pointers handed out by
+    // loadedProject() before the swap stay valid until the next edit.
+    void reapRetiredSwap_();
+
     juce::AudioDeviceManager                       dm_;
     bool                                           dm_initialised_ = false;
 
@@ -164,10 +242,12 @@ private:
     std::atomic<long long>                         loop_end_{ 0 };
     std::atomic<bool>                              loop_enabled_{ false };
 
-    // SPSC queue for live parameter writes. Producer = GUI thread,
-    // consumer = audio callback (drainParamWrites_ at top of each
-    // block). 1024 commands is plenty for typical knob rates.
-    RtParamQueue<1024>                             param_queue_;
+    // MPSC queue for live commands (param writes, bypass toggles, mix
+    // gains, transport). Producers = any control threads (GUI, control
+    // surfaces, automation playback), consumer = audio callback
+    // (drainCommands_ at top of each block). 1024 commands is plenty
+    // for typical knob rates.
+    RtCommandQueue<1024>                           command_queue_;
 
     // ----- MIDI input ----- //
     // Receives from the libremidi MIDI thread (via mh_midi_in_open),
@@ -192,12 +272,14 @@ private:
     MH_MidiIn*                                     midi_in_ = nullptr;
     juce::String                                   midi_input_port_name_;
 
-    // Drains the queue and applies up to `max` commands to live
-    // plugin nodes. Called from the audio thread (and from
-    // drainParamWritesForTest for unit testing). Uses
-    // juce::AudioProcessorParameter::setValue which is RT-safe
-    // by JUCE contract -- does NOT take mh_set_param's mutex.
-    int drainParamWrites_(int max);
+    // Drains the queue and applies up to `max` commands. Called from
+    // the audio thread (and from drainCommandsForTest for unit
+    // testing). Param and bypass writes go through
+    // juce::AudioProcessorParameter::setValue (RT-safe by JUCE
+    // contract -- does NOT take mh_set_param's mutex), mix gains
+    // through mh_graph_set_mix_gain (a plain store), transport into
+    // the atomics above.
+    int drainCommands_(int max);
 };
 
 } // namespace minihost_desktop
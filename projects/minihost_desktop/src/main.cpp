@@ -45,6 +45,14 @@
 //       hermetic sidecar location. Exit 0 on success, 1 on any broken
 //       invariant. Driven by tests/test_desktop_autosave.py.
 //
+//   minihost_desktop --rescan-selftest=<scratch-dir>
+//       Headless self-test of the incremental library refresh
+//       (BackgroundPluginRescan::refreshPass): an up-to-date entry is
+//       kept without a probe, a vanished entry is dropped. Uses fake
+//       bundles in <scratch-dir>; no real plugins needed. Exit 0 on
+//       success, 1 on any broken invariant. Driven by
+//       tests/test_desktop_pluginscan.py.
+//
 //   minihost_desktop --scan-plugins[=<dir1;dir2>] [--scan-out=<file.xml>]
 //                     [--scan-format=<VST3|AudioUnit|LV2>] [--scan-oop]
 //       (--scan-oop routes each probe through a disposable child process for
@@ -1187,6 +1195,24 @@ public:
             return;
         }
 
+        // Headless incremental-rescan self-test: exercises the library
+        // refresh pass's stat-compare invariants with fake bundles -- no
+        // real plugins, no probing. Exit 0 on success, 1 on any broken
+        // invariant. Driven by tests/test_desktop_pluginscan.py.
+        if (args.containsOption("--rescan-selftest"))
+        {
+            const auto path = args.removeValueForOption("--rescan-selftest");
+            if (path.isEmpty())
+            {
+                std::fprintf(stderr, "--rescan-selftest requires a path\n");
+                setApplicationReturnValue(2);
+                quit();
+                return;
+            }
+            runRescanSelfTest(juce::File(path));
+            return;
+        }
+
         // Headless plugin scan: register the host formats, scan the given
         // (or default) directories in-process, and write the resulting
         // KnownPluginList to XML. Proves addDefaultFormatsToManager yields
@@ -1324,6 +1350,26 @@ public:
             loadKnownPlugins();
             owns_library_ = true;   // this process persists the library
 
+            // Incremental background rescan: verify the restored library
+            // against the filesystem off the message thread. Vanished
+            // plugins are dropped, changed bundles are re-probed (through
+            // the out-of-process child) and new ones beside known plugins
+            // are picked up; each result lands in known_plugins_ as it
+            // arrives, so menus populate progressively. An unchanged
+            // library costs one stat per bundle. A never-scanned library
+            // has nothing to verify -- scanning stays user-driven.
+            if (known_plugins_.getNumTypes() > 0)
+            {
+                plugin_rescan_ = std::make_unique<BackgroundPluginRescan>(
+                    known_plugins_, plugin_format_manager_,
+                    [this]() {
+                        juce::MessageManager::callAsync([this]() {
+                            if (owns_library_) saveKnownPlugins();
+                        });
+                    });
+                plugin_rescan_->startThread();
+            }
+
             // Autosave: the canvas marks the working document dirty on every
             // edit; a heartbeat timer snapshots it to a sidecar so a plugin
             // crash costs at most kAutosaveIntervalMs of unsaved editing. Only
@@ -1350,9 +1396,13 @@ public:
         // a headless mode sharing the settings dir never clears a *different*
         // (crashed) GUI session's sidecar.
         if (autosave_timer_) autosave_timer_->stopTimer();
+        if (autosave_writer_.joinable()) autosave_writer_.join();
         if (autosave_enabled_) clearAutosave();
 
         if (live_) saveSettingsToDisk();
+        // Stop the background rescan before persisting the library so the
+        // saved XML is not raced by an in-flight probe landing.
+        plugin_rescan_.reset();
         // Only the GUI app-shell loads and owns known_plugins_; persist it
         // only there. Headless modes (--scan-plugins writes its own local
         // list) and spawned scan-worker children have an empty member list
@@ -1463,36 +1513,58 @@ public:
     // Write the sidecar snapshot + its origin-path metadata. Atomic (the
     // project writer renames a .tmp into place). Throws ProjectError on I/O
     // failure. Factored out of performAutosave so the headless self-test can
-    // exercise the exact write path without a MainWindow.
+    // exercise the exact write path without a MainWindow. The state cache
+    // makes repeated writes incremental: plugin state sidecars whose blobs
+    // haven't changed since the previous autosave are left untouched.
     void writeAutosaveSnapshot(const project::ProjectDocument& doc,
                                const juce::File& orig_path)
     {
-        project::saveProjectFile(autosaveFile(), doc);
+        project::saveProjectFile(autosaveFile(), doc, &autosave_state_cache_);
         autosaveMetaFile().replaceWithText(orig_path.getFullPathName());
     }
 
     // Snapshot the working document iff it changed since the last write.
-    // Runs on the message thread from the heartbeat timer. Best-effort:
-    // on failure the dirty flag stays set so the next tick retries.
+    // Runs on the message thread from the heartbeat timer, but only the
+    // document COPY happens here (cheap: spec structs plus refcounted
+    // strings -- state blobs are shared, not duplicated). Serialization
+    // and sidecar compression run on a background thread so a blob-heavy
+    // session doesn't hitch the GUI every interval. Best-effort: on
+    // failure the dirty flag is re-raised so the next tick retries.
     void performAutosave()
     {
         if (!mainWindow_) return;
         auto* doc = mainWindow_->currentDocument();
         if (doc == nullptr) return;
         if (!doc_dirty_) return;
-        try {
-            writeAutosaveSnapshot(*doc, mainWindow_->currentProjectPath());
-            doc_dirty_ = false;
-        } catch (const std::exception& e) {
-            std::fprintf(stderr, "autosave failed: %s\n", e.what());
-        }
+        if (autosave_write_running_.load())
+            return;   // previous write still in flight; retry next tick
+        if (autosave_writer_.joinable())
+            autosave_writer_.join();   // reap the finished thread
+
+        doc_dirty_ = false;
+        autosave_write_running_ = true;
+        autosave_writer_ = std::thread(
+            [this, snapshot = *doc,
+             orig = mainWindow_->currentProjectPath()]() {
+                try {
+                    writeAutosaveSnapshot(snapshot, orig);
+                } catch (const std::exception& e) {
+                    std::fprintf(stderr, "autosave failed: %s\n", e.what());
+                    juce::MessageManager::callAsync(
+                        [this]() { doc_dirty_ = true; });
+                }
+                autosave_write_running_ = false;
+            });
     }
 
     // Remove the recovery sidecar (clean exit / explicit save / discard).
     void clearAutosave()
     {
+        if (autosave_writer_.joinable())
+            autosave_writer_.join();   // don't race an in-flight write
         autosaveFile().deleteFile();
         autosaveMetaFile().deleteFile();
+        autosave_state_cache_.last_written.clear();
         doc_dirty_ = false;
     }
 
@@ -1902,6 +1974,47 @@ private:
             if (hist.canRedo())
                 return fail("redo stack not cleared by new edit");
 
+            // State-blob edits are delta-encoded between adjacent
+            // history entries; undo/redo must still round-trip them
+            // byte-exactly across several steps, including a step that
+            // removes the plugin outright. The blob stays below the
+            // sidecar threshold so serialize() keeps it inline and the
+            // comparisons see the actual bytes.
+            {
+                project::PluginNodeSpec spec;
+                spec.id   = "undo-selftest-synth";
+                spec.path = juce::File("/nonexistent/Selftest.vst3");
+                juce::String big;
+                for (int i = 0; i < 200; ++i)
+                    big << "QUJDREVGR0hJSktM";   // valid base64, ~2.4 KB raw
+                spec.state_b64 = big;
+
+                hist.clear();
+                hist.snapshot(doc);
+                doc.plugins.push_back(spec);
+                const juce::String t0 = serialize(doc);
+
+                hist.snapshot(doc);
+                // A localized edit in the middle of the blob -- the
+                // delta-encoded entry should shrink to roughly this.
+                doc.plugins.back().state_b64 =
+                    big.replaceSection((int) big.length() / 2, 4, "ZZZZ");
+                const juce::String t1 = serialize(doc);
+
+                hist.snapshot(doc);
+                doc.plugins.pop_back();
+                const juce::String t2 = serialize(doc);
+
+                if (!hist.undo(doc))      return fail("state undo 1 failed");
+                if (serialize(doc) != t1) return fail("state undo 1 mismatch");
+                if (!hist.undo(doc))      return fail("state undo 2 failed");
+                if (serialize(doc) != t0) return fail("state undo 2 mismatch");
+                if (!hist.redo(doc))      return fail("state redo 1 failed");
+                if (serialize(doc) != t1) return fail("state redo 1 mismatch");
+                if (!hist.redo(doc))      return fail("state redo 2 failed");
+                if (serialize(doc) != t2) return fail("state redo 2 mismatch");
+            }
+
             std::fprintf(stderr, "undo-selftest OK\n");
             setApplicationReturnValue(0);
             quit();
@@ -1964,6 +2077,43 @@ private:
                 != orig_path.getFullPathName())
                 return fail("meta file did not record the origin path");
 
+            // Incremental rewrite: a state blob above the sidecar
+            // threshold is externalized on the first write; a second
+            // write with the blob unchanged must leave the sidecar file
+            // untouched (asserted by planting sentinel bytes), and a
+            // changed blob must rewrite it.
+            {
+                project::PluginNodeSpec spec;
+                spec.id   = "autosave-selftest-synth";
+                spec.path = juce::File("/nonexistent/Selftest.vst3");
+                juce::String big;
+                for (int i = 0; i < 600; ++i)
+                    big << "QUJDREVGR0hJSktM";   // ~7 KB raw, over threshold
+                spec.state_b64 = big;
+                doc.plugins.push_back(spec);
+
+                writeAutosaveSnapshot(doc, orig_path);
+                const auto sidecar = autosaveFile().getParentDirectory()
+                    .getChildFile("autosave.states")
+                    .getChildFile("autosave-selftest-synth.stz");
+                if (!sidecar.existsAsFile())
+                    return fail("large state was not externalized");
+
+                sidecar.replaceWithText("sentinel");
+                writeAutosaveSnapshot(doc, orig_path);
+                if (sidecar.loadFileAsString() != "sentinel")
+                    return fail("unchanged state sidecar was rewritten");
+
+                doc.plugins.back().state_b64 =
+                    big.replaceSection(0, 4, "ZZZZ");
+                writeAutosaveSnapshot(doc, orig_path);
+                if (sidecar.loadFileAsString() == "sentinel")
+                    return fail("changed state sidecar was not rewritten");
+
+                sidecar.deleteFile();
+                doc.plugins.pop_back();
+            }
+
             clearAutosave();
             if (autosaveFile().existsAsFile()
                 || autosaveMetaFile().existsAsFile())
@@ -1977,6 +2127,71 @@ private:
         }
     }
 
+    // Headless self-test for the incremental library refresh. Builds a
+    // KnownPluginList over fake bundles in `scratch_dir` and runs
+    // BackgroundPluginRescan::refreshPass synchronously, asserting the
+    // stat-compare contract:
+    //   1. an entry whose stored mod time matches the file is kept
+    //      WITHOUT probing (probing the fake would fail and discard it);
+    //   2. an entry whose file vanished is dropped;
+    //   3. the pass reports exactly the one change.
+    // Exit 0 on success, 1 on any broken invariant.
+    void runRescanSelfTest(juce::File scratch_dir)
+    {
+        auto fail = [this](const juce::String& m) {
+            std::fprintf(stderr, "rescan-selftest FAIL: %s\n", m.toRawUTF8());
+            setApplicationReturnValue(1);
+            quit();
+        };
+        scratch_dir.createDirectory();
+
+        juce::AudioPluginFormatManager formats;
+        juce::addDefaultFormatsToManager(formats);
+        juce::AudioPluginFormat* vst3 = nullptr;
+        for (auto* f : formats.getFormats())
+            if (f->getName() == "VST3")
+                vst3 = f;
+        if (vst3 == nullptr)
+            return fail("no VST3 format registered");
+
+        // A fake bundle whose stored mod time matches the file on disk.
+        const auto fresh = scratch_dir.getChildFile("fresh.vst3");
+        fresh.replaceWithText("not a real plugin");
+
+        juce::KnownPluginList known;
+        juce::PluginDescription d;
+        d.name             = "Fresh";
+        d.pluginFormatName = vst3->getName();
+        d.fileOrIdentifier = fresh.getFullPathName();
+        d.lastFileModTime  = fresh.getLastModificationTime();
+        d.uniqueId         = 1;
+        known.addType(d);
+
+        // And one whose file does not exist.
+        juce::PluginDescription gone = d;
+        gone.name             = "Gone";
+        gone.fileOrIdentifier =
+            scratch_dir.getChildFile("gone.vst3").getFullPathName();
+        gone.uniqueId         = 2;
+        known.addType(gone);
+
+        const int changes =
+            BackgroundPluginRescan::refreshPass(known, formats, nullptr);
+
+        if (changes != 1)
+            return fail("expected exactly 1 change, got "
+                        + juce::String(changes));
+        if (known.getNumTypes() != 1)
+            return fail("expected 1 surviving entry, got "
+                        + juce::String(known.getNumTypes()));
+        if (known.getTypes()[0].name != "Fresh")
+            return fail("up-to-date entry was not the survivor");
+
+        std::fprintf(stderr, "rescan-selftest OK\n");
+        setApplicationReturnValue(0);
+        quit();
+    }
+
     // Headless in-process scan. `paths_override` is a ';'-separated list of
     // directories (empty = each format's default locations). `out_override`
     // is the XML destination (empty = the real known_plugins.xml).
@@ -2251,27 +2466,22 @@ private:
         MH_Plugin* p = match->plugin();
         if (p == nullptr) return;
 
-        const int sz = mh_get_state_size(p);
-        if (sz <= 0)
-        {
-            juce::AlertWindow::showMessageBoxAsync(
-                juce::AlertWindow::WarningIcon,
-                "Capture failed",
-                "Plugin reported zero state size.");
-            return;
-        }
-        std::vector<unsigned char> buf((size_t) sz);
-        const int got = mh_get_state(p, buf.data(), sz);
-        if (got <= 0)
+        // Single-call capture: mh_get_state_size + mh_get_state would
+        // make the plugin serialize twice, a visible stall for big
+        // sampler states.
+        void* state = nullptr;
+        int sz = 0;
+        if (!mh_get_state_alloc(p, &state, &sz))
         {
             juce::AlertWindow::showMessageBoxAsync(
                 juce::AlertWindow::WarningIcon,
                 "Capture failed",
-                "mh_get_state returned 0.");
+                "Plugin reported no state.");
             return;
         }
         juce::MemoryOutputStream encoded;
-        juce::Base64::convertToBase64(encoded, buf.data(), (size_t) got);
+        juce::Base64::convertToBase64(encoded, state, (size_t) sz);
+        mh_state_free(state);
         doc->plugins[(size_t) plugin_index].state_b64
             = encoded.toString();
         // Capturing state mutates the document outside the canvas edit path
@@ -2282,7 +2492,7 @@ private:
             cv->notifyDocumentChanged();
         std::fprintf(stderr,
             "captured %d bytes of state for plugin '%s'\n",
-            got, node_id.toRawUTF8());
+            sz, node_id.toRawUTF8());
     }
 
     void openProjectInCanvas(juce::File project_file)
@@ -2355,9 +2565,30 @@ private:
             return;
         }
 
-        // Topology swap under mute: stop -> reload -> start.
         auto& engine = ensureLiveEngine();
         juce::String err;
+
+        // Already live: try a hot-swap first. The audio thread adopts
+        // the recompiled project at a block boundary under a short
+        // crossfade instead of the stop/start mute cycle. Falls back
+        // to the full restart below when the edit needs the device
+        // reconfigured (sample-rate change, more input channels).
+        if (engine.isRunning() && engine.applyProjectEdit(path, err))
+        {
+            // The swap lands on the next audio callback; re-point the
+            // canvas at the new project once it has certainly landed.
+            juce::Timer::callAfterDelay(100, [this] {
+                if (!mainWindow_ || !live_ || !live_->isRunning())
+                    return;
+                if (auto* c = mainWindow_->canvas())
+                    c->setLiveProject(live_->loadedProject());
+            });
+            std::fprintf(stderr, "live: project hot-swapped\n");
+            return;
+        }
+        err.clear();
+
+        // Topology swap under mute: stop -> reload -> start.
         if (!engine.start(path, err))
         {
             mainWindow_->setLiveRunning(false);
@@ -2509,6 +2740,11 @@ private:
     // top of initialise()); keeps the child's IPC connection alive.
     std::unique_ptr<PluginScannerSubprocess> scanner_subprocess_;
 
+    // Startup refresh of the restored library (GUI shell only); see the
+    // wiring in initialise(). Reset in shutdown() before the library is
+    // persisted.
+    std::unique_ptr<BackgroundPluginRescan> plugin_rescan_;
+
     // True only in the GUI app-shell, which loads/owns known_plugins_ and is
     // the only process that should persist it on shutdown.
     bool owns_library_ = false;
@@ -2522,6 +2758,16 @@ private:
     bool                         doc_dirty_        = false;
     bool                         autosave_enabled_ = false;
 
+    // Background autosave writer. performAutosave copies the document on
+    // the message thread and serializes on this thread; at most one write
+    // is in flight (a busy tick just retries at the next heartbeat). The
+    // sidecar cache makes successive writes incremental: only plugin
+    // state blobs that changed since the previous autosave are
+    // re-compressed and rewritten.
+    std::thread                  autosave_writer_;
+    std::atomic<bool>            autosave_write_running_{false};
+    project::StateSidecarCache   autosave_state_cache_;
+
     // Unsaved-changes tracking for the save-before-quit prompt. Distinct from
     // doc_dirty_ (which measures change since the last *autosave* and resets
     // every heartbeat): unsaved_changes_ measures change since the last
@@ -250,7 +250,6 @@ NodeKindEntry makePlugin()
 
     e.parse = [](const juce::var& n, const juce::String& id,
                  ProjectDocument& d, const juce::File& project_dir) {
-        (void) project_dir;
         project::PluginNodeSpec s;
         s.id   = id;
         s.descriptor = prop_string(n, "descriptor", {});
@@ -266,6 +265,16 @@ NodeKindEntry makePlugin()
             s.path = juce::File(require_string(n, "path"));
         }
         s.state_b64 = prop_string(n, "state_b64", {});
+        if (s.state_b64.isEmpty())
+        {
+            // Large states live in a compressed sidecar (state_file,
+            // relative to the project); inline state_b64 wins if both
+            // are somehow present.
+            const auto state_file = prop_string(n, "state_file", {});
+            if (state_file.isNotEmpty())
+                s.state_b64 = project::readStateSidecar(
+                    project_dir.getChildFile(state_file));
+        }
         const juce::Identifier kReceivesMidi("receives_midi");
         if (n.getDynamicObject()->hasProperty(kReceivesMidi))
         {
@@ -144,6 +144,105 @@ void ScannerCoordinator::handleConnectionLost()
     condvar_.notify_one();
 }
 
+// ------------------------------------------------------------------ //
+// Incremental background rescan                                      //
+// ------------------------------------------------------------------ //
+
+BackgroundPluginRescan::BackgroundPluginRescan (
+    juce::KnownPluginList& known,
+    juce::AudioPluginFormatManager& formats,
+    std::function<void()> on_finished)
+    : juce::Thread ("plugin rescan"),
+      known_ (known),
+      formats_ (formats),
+      on_finished_ (std::move (on_finished))
+{
+}
+
+BackgroundPluginRescan::~BackgroundPluginRescan()
+{
+    // Generous: a stale bundle mid-probe holds the pass for up to the
+    // scanner's own hang timeout before the exit flag is seen.
+    stopThread (60000);
+}
+
+void BackgroundPluginRescan::run()
+{
+    refreshPass (known_, formats_, this);
+    if (! threadShouldExit() && on_finished_ != nullptr)
+        on_finished_();
+}
+
+int BackgroundPluginRescan::refreshPass (juce::KnownPluginList& known,
+                                         juce::AudioPluginFormatManager& formats,
+                                         juce::Thread* thread)
+{
+    const auto aborted = [thread]
+    { return thread != nullptr && thread->threadShouldExit(); };
+
+    int changes = 0;
+
+    // 1. Drop entries whose file is gone. Only file-based identifiers
+    //    can be checked this way; AudioUnit identifiers are not paths
+    //    and are left alone.
+    for (const auto& type : known.getTypes())
+    {
+        if (aborted())
+            return changes;
+        if (! juce::File::isAbsolutePath (type.fileOrIdentifier))
+            continue;
+        if (! juce::File (type.fileOrIdentifier).exists())
+        {
+            known.removeType (type);
+            ++changes;
+        }
+    }
+
+    // 2. Re-walk the directories that hold known plugins, per format.
+    //    The directory listing is cheap; scanAndAddFile with
+    //    dontRescanIfAlreadyInList=true compares the bundle's mod time
+    //    against the stored description and only probes identifiers
+    //    that changed (or are new) -- so an unchanged library is one
+    //    stat per bundle, and a changed one pays only for its deltas.
+    //    Probes dispatch through the list's custom scanner, which in
+    //    the app is the out-of-process child.
+    for (auto* format : formats.getFormats())
+    {
+        if (aborted())
+            return changes;
+
+        juce::FileSearchPath roots;
+        for (const auto& type : known.getTypes())
+            if (type.pluginFormatName == format->getName()
+                && juce::File::isAbsolutePath (type.fileOrIdentifier))
+                roots.addIfNotAlreadyThere (
+                    juce::File (type.fileOrIdentifier).getParentDirectory());
+
+        if (roots.getNumPaths() == 0)
+            continue;
+
+        const auto identifiers = format->searchPathsForPlugins (
+            roots, /*recursive=*/false, /*allowAsync=*/true);
+
+        for (const auto& identifier : identifiers)
+        {
+            if (aborted())
+                return changes;
+
+            if (known.isListingUpToDate (identifier, *format))
+                continue;
+
+            juce::OwnedArray<juce::PluginDescription> found;
+            known.scanAndAddFile (identifier,
+                                  /*dontRescanIfAlreadyInList=*/true,
+                                  found, *format);
+            ++changes;
+        }
+    }
+
+    return changes;
+}
+
 // ------------------------------------------------------------------ //
 // CustomScanner hook                                                 //
 // ------------------------------------------------------------------ //
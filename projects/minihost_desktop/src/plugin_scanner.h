@@ -28,6 +28,7 @@
 #include <juce_events/juce_events.h>
 
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -94,6 +95,45 @@ private:
     bool got_result_      = false;
 };
 
+// Incremental background refresh of a previously-scanned library. The full
+// scan stays user-driven (Plugin Browser); this pass runs at launch on a
+// background thread to keep the restored list honest without blocking the
+// UI. Entries whose file vanished are dropped, bundles whose on-disk mod
+// time no longer matches the stored description are re-probed (through the
+// custom scanner the list is configured with, i.e. the disposable child
+// process), and new bundles that appeared beside known ones are picked up.
+// Everything else is a stat compare -- an unchanged library costs one stat
+// per bundle. Each probe result lands in the KnownPluginList as it arrives
+// (the list is internally locked and broadcasts changes asynchronously), so
+// menus and the browser populate progressively while the pass runs.
+class BackgroundPluginRescan final : public juce::Thread
+{
+public:
+    // `on_finished` fires on the background thread after a completed (not
+    // aborted) pass; marshal to the message thread before touching UI or
+    // persisting the list.
+    BackgroundPluginRescan (juce::KnownPluginList& known,
+                            juce::AudioPluginFormatManager& formats,
+                            std::function<void()> on_finished);
+    ~BackgroundPluginRescan() override;   // stops the thread
+
+    void run() override;
+
+    // One synchronous refresh pass over `known` (the core the thread
+    // runs; also the headless --rescan-selftest seam). Polls `thread`
+    // (may be null) so an exiting background thread abandons the pass
+    // promptly. Returns the number of list changes made: removals of
+    // vanished plugins plus re-probes of new or stale bundles.
+    static int refreshPass (juce::KnownPluginList& known,
+                            juce::AudioPluginFormatManager& formats,
+                            juce::Thread* thread);
+
+private:
+    juce::KnownPluginList&          known_;
+    juce::AudioPluginFormatManager& formats_;
+    std::function<void()>           on_finished_;
+};
+
 // The KnownPluginList hook. findPluginTypesFor dispatches one plugin to the
 // child and collects its descriptions. Returning false tells KnownPluginList
 // the plugin is unrecoverable, so it gets blacklisted and the scan continues.
@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -107,6 +109,92 @@ bool decodeBase64(const juce::String& b64, juce::MemoryBlock& out)
     return juce::Base64::convertFromBase64(stream, b64);
 }
 
+// Raw plugin states at or below this many bytes stay inline as
+// state_b64; larger ones are externalized to a compressed sidecar at
+// save time (same threshold as src/minihost/project.py).
+constexpr int kStateInlineMax = 4096;
+
+// Filesystem-safe sidecar file name for a plugin node id.
+juce::String stateSidecarName(const juce::String& id)
+{
+    juce::String safe;
+    for (int i = 0; i < id.length(); ++i)
+    {
+        const juce::juce_wchar c = id[i];
+        const bool ok = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z')
+                     || (c >= 'A' && c <= 'Z') || c == '-' || c == '_';
+        safe += ok ? juce::String::charToString(c) : juce::String("_");
+    }
+    return safe + ".stz";
+}
+
+// Rewrite serialized plugin nodes whose decoded state exceeds the
+// inline threshold: the raw state goes zlib-compressed into
+// "<project stem>.states/<id>.stz" and the node gets a `state_file`
+// reference instead of the base64 blob. Sidecars are written before
+// the JSON lands, so a crash mid-save never leaves a document pointing
+// at a missing state.
+void externalizePluginStates(juce::Array<juce::var>& nodes,
+                             const juce::File& project_path,
+                             StateSidecarCache* cache)
+{
+    const auto dir_name =
+        project_path.getFileNameWithoutExtension() + ".states";
+
+    for (auto& nv : nodes)
+    {
+        auto* obj = nv.getDynamicObject();
+        if (obj == nullptr) continue;
+        if (obj->getProperty("kind").toString() != "plugin") continue;
+        const auto b64 = obj->getProperty("state_b64").toString();
+        if (b64.isEmpty()) continue;
+
+        juce::MemoryBlock state;
+        if (!decodeBase64(b64, state)) continue;  // leave inline as-is
+        if ((int) state.getSize() <= kStateInlineMax) continue;
+
+        auto dir = project_path.getParentDirectory().getChildFile(dir_name);
+        const auto id = obj->getProperty("id").toString();
+        const auto fname = stateSidecarName(id);
+        auto sidecar = dir.getChildFile(fname);
+
+        // Incremental path: the blob hasn't changed since the last save
+        // through this cache and its sidecar is still on disk, so the
+        // compression and the write -- the expensive parts -- are
+        // skipped and the node just references the existing file.
+        if (cache != nullptr && sidecar.existsAsFile())
+        {
+            auto it = cache->last_written.find(id.toStdString());
+            if (it != cache->last_written.end() && it->second == b64)
+            {
+                obj->removeProperty("state_b64");
+                obj->setProperty("state_file", dir_name + "/" + fname);
+                continue;
+            }
+        }
+        dir.createDirectory();
+
+        juce::MemoryBlock compressed;
+        {
+            juce::MemoryOutputStream mos(compressed, false);
+            // Default window bits = zlib format, which the Python
+            // loader's zlib.decompress reads directly.
+            juce::GZIPCompressorOutputStream z(mos);
+            z.write(state.getData(), state.getSize());
+            z.flush();
+        }
+        if (!sidecar.replaceWithData(compressed.getData(),
+                                     compressed.getSize()))
+            throw ProjectError(("failed to write "
+                                + sidecar.getFullPathName()).toStdString());
+        if (cache != nullptr)
+            cache->last_written[id.toStdString()] = b64;
+
+        obj->removeProperty("state_b64");
+        obj->setProperty("state_file", dir_name + "/" + fname);
+    }
+}
+
 // De-interleave [frames*channels] into planar contiguous storage:
 // channel 0's `frames` samples first, then channel 1's, ...
 void deinterleave(const float* src, int channels, int frames,
@@ -428,7 +516,8 @@ ProjectDocument parseProjectFile(const juce::File& path)
     return out;
 }
 
-void saveProjectFile(const juce::File& path, const ProjectDocument& doc)
+void saveProjectFile(const juce::File& path, const ProjectDocument& doc,
+                     StateSidecarCache* sidecar_cache)
 {
     auto* root = new juce::DynamicObject();
     root->setProperty("minihost_project_version", kSchemaVersion);
@@ -447,6 +536,7 @@ void saveProjectFile(const juce::File& path, const ProjectDocument& doc)
         };
     for (const auto& entry : nodeRegistry())
         entry.serialize_all(doc, pushNode);
+    externalizePluginStates(nodes, path, sidecar_cache);
     root->setProperty("nodes", nodes);
 
     juce::Array<juce::var> edges;
@@ -499,6 +589,29 @@ void saveProjectFile(const juce::File& path, const ProjectDocument& doc)
     }
 }
 
+juce::String readStateSidecar(const juce::File& sidecar)
+{
+    if (!sidecar.existsAsFile())
+        throwErr("plugin state sidecar not found: "
+                 + sidecar.getFullPathName());
+    juce::FileInputStream in(sidecar);
+    if (!in.openedOk())
+        throwErr("failed to read " + sidecar.getFullPathName());
+
+    juce::GZIPDecompressorInputStream z(
+        &in, /*deleteSourceWhenDestroyed=*/false,
+        juce::GZIPDecompressorInputStream::zlibFormat);
+    juce::MemoryBlock state;
+    z.readIntoMemoryBlock(state);
+    if (state.getSize() == 0)
+        throwErr("corrupt plugin state sidecar: "
+                 + sidecar.getFullPathName());
+
+    juce::MemoryOutputStream b64;
+    juce::Base64::convertToBase64(b64, state.getData(), state.getSize());
+    return b64.toString();
+}
+
 std::unique_ptr<LoadedProject> loadProject(const juce::File& path)
 {
     auto loaded = std::make_unique<LoadedProject>();
@@ -581,41 +694,101 @@ std::unique_ptr<LoadedProject> loadProject(const juce::File& path)
     }
 
     // Open plugins. Prefer the descriptor (AudioUnits, which have no file
-    // path) via mh_open_desc; fall back to the path via mh_open.
-    for (auto& pl : doc.plugins)
+    // path) via mh_open_desc; fall back to the path via mh_open. Opens run
+    // concurrently: module discovery happens on each calling thread and
+    // only the JUCE-affine construction serializes on the plugin thread,
+    // so a project loads in roughly the time of its slowest plugin.
+    // Slots are pre-sized so node order is preserved; on failure the
+    // LoadedProject destructor closes whichever plugins did open (it
+    // null-checks each slot).
+    loaded->plugins.assign(doc.plugins.size(), nullptr);
     {
-        char err[512] = {0};
-        MH_Plugin* p = nullptr;
-        if (pl.descriptor.isNotEmpty())
+        std::mutex errMutex;
+        juce::String firstErr;
+        // Decoded state blobs, filled by the open workers and applied
+        // in one batch after they join.
+        std::vector<juce::MemoryBlock> states(doc.plugins.size());
+        auto openOne = [&](size_t idx)
+        {
+            const auto& pl = doc.plugins[idx];
+            auto fail = [&](const juce::String& msg)
+            {
+                std::lock_guard<std::mutex> lk(errMutex);
+                if (firstErr.isEmpty())
+                    firstErr = msg;
+            };
+            char err[512] = {0};
+            MH_Plugin* p = nullptr;
+            if (pl.descriptor.isNotEmpty())
+            {
+                juce::MemoryBlock db;
+                if (!decodeBase64(pl.descriptor, db))
+                    return fail("plugin " + pl.id + ": malformed descriptor");
+                const juce::String pd_xml = juce::String::fromUTF8(
+                    static_cast<const char*>(db.getData()), (int) db.getSize());
+                p = mh_open_desc(pd_xml.toRawUTF8(),
+                                 (double) doc.sample_rate, doc.block_size,
+                                 /*req_in=*/0, /*req_out=*/0, err, sizeof(err));
+            }
+            else
+            {
+                if (!pl.path.exists())
+                    return fail("plugin path not found: "
+                                + pl.path.getFullPathName());
+                p = mh_open(pl.path.getFullPathName().toRawUTF8(),
+                            (double) doc.sample_rate, doc.block_size,
+                            /*req_in=*/0, /*req_out=*/0, err, sizeof(err));
+            }
+            if (!p)
+                return fail("plugin " + pl.id + " failed to open: "
+                            + juce::String(static_cast<const char*>(err)));
+            loaded->plugins[idx] = p;
+
+            if (pl.state_b64.isNotEmpty())
+            {
+                if (!decodeBase64(pl.state_b64, states[idx]))
+                    return fail("plugin " + pl.id + ": malformed state_b64");
+            }
+        };
+
+        if (doc.plugins.size() > 1)
         {
-            juce::MemoryBlock db;
-            if (!decodeBase64(pl.descriptor, db))
-                throwErr("plugin " + pl.id + ": malformed descriptor");
-            const juce::String pd_xml = juce::String::fromUTF8(
-                static_cast<const char*>(db.getData()), (int) db.getSize());
-            p = mh_open_desc(pd_xml.toRawUTF8(),
-                             (double) doc.sample_rate, doc.block_size,
-                             /*req_in=*/0, /*req_out=*/0, err, sizeof(err));
+            std::vector<std::thread> workers;
+            workers.reserve(doc.plugins.size());
+            for (size_t i = 0; i < doc.plugins.size(); ++i)
+                workers.emplace_back(openOne, i);
+            for (auto& w : workers)
+                w.join();
         }
-        else
+        else if (doc.plugins.size() == 1)
         {
-            if (!pl.path.exists())
-                throwErr("plugin path not found: " + pl.path.getFullPathName());
-            p = mh_open(pl.path.getFullPathName().toRawUTF8(),
-                        (double) doc.sample_rate, doc.block_size,
-                        /*req_in=*/0, /*req_out=*/0, err, sizeof(err));
+            openOne(0);
         }
-        if (!p)
-            throwErr("plugin " + pl.id + " failed to open: "
-                     + juce::String(static_cast<const char*>(err)));
-        loaded->plugins.push_back(p);
-
-        if (pl.state_b64.isNotEmpty())
+        if (firstErr.isNotEmpty())
+            throwErr(firstErr);
+
+        // Restore every decoded state in ONE submission to the plugin
+        // thread. Calling mh_set_state inside each worker pays a
+        // cross-thread round trip per plugin; the state calls are
+        // thread-affine and serialize on the plugin thread either way,
+        // so batching removes the hops without changing the ordering.
+        if (!doc.plugins.empty())
         {
-            juce::MemoryBlock mb;
-            if (!decodeBase64(pl.state_b64, mb))
-                throwErr("plugin " + pl.id + ": malformed state_b64");
-            mh_set_state(p, mb.getData(), (int) mb.getSize());
+            std::vector<const void*> datas(doc.plugins.size(), nullptr);
+            std::vector<int> sizes(doc.plugins.size(), 0);
+            bool any = false;
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                if (states[i].getSize() == 0)
+                    continue;
+                datas[i] = states[i].getData();
+                sizes[i] = (int) states[i].getSize();
+                any = true;
+            }
+            if (any)
+                mh_set_states(loaded->plugins.data(),
+                              (int) loaded->plugins.size(),
+                              datas.data(), sizes.data());
         }
     }
 
@@ -312,10 +312,34 @@ struct ProjectDocument {
 
 ProjectDocument parseProjectFile(const juce::File& path);
 
+// Tracks, per plugin node id, the state_b64 most recently externalized
+// to a sidecar, so repeated saves of the same document to the same path
+// (autosave) skip re-compressing unchanged blobs -- the dominant cost
+// of serializing a sampler-heavy session. Owned by the caller; sidecar
+// paths derive from the destination, so use one cache per destination
+// and drop it when the destination changes.
+struct StateSidecarCache {
+    std::unordered_map<std::string, juce::String> last_written;
+};
+
 // Serialize a ProjectDocument back to disk. Writes to a `.tmp` file and
 // renames; the destination is only replaced once the write succeeds.
-// Throws ProjectError on I/O failure.
-void saveProjectFile(const juce::File& path, const ProjectDocument& doc);
+// Plugin states beyond a small threshold are written zlib-compressed to
+// "<project stem>.states/<id>.stz" sidecars and referenced from the JSON
+// via `state_file`, keeping the document itself small and fast to parse
+// (matching the Python loader's sidecar support). Throws ProjectError on
+// I/O failure.
+//
+// With a non-null `sidecar_cache`, a plugin whose state_b64 matches the
+// cached value for its id (and whose sidecar file still exists) keeps
+// its existing sidecar untouched instead of re-compressing it.
+void saveProjectFile(const juce::File& path, const ProjectDocument& doc,
+                     StateSidecarCache* sidecar_cache = nullptr);
+
+// Read a `state_file` sidecar (zlib-compressed raw plugin state) and
+// return it base64-encoded, ready for PluginNodeSpec::state_b64. Throws
+// ProjectError if the file is missing or corrupt.
+juce::String readStateSidecar(const juce::File& sidecar);
 
 // Owns the built graph, opened plugin instances, and loaded input
 // audio buffers. mh_close runs for every plugin in the destructor.
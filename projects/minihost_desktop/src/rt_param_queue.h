@@ -1,25 +1,35 @@
 // rt_param_queue.h
 //
-// Lock-free single-producer / single-consumer (SPSC) ring buffer for
-// parameter-write commands. The GUI / message thread is the producer;
-// the audio thread is the consumer.
+// Lock-free bounded multi-producer / single-consumer (MPSC) ring
+// buffer for real-time commands. Producers are any number of control
+// threads -- GUI, control surfaces, automation playback; the consumer
+// is the audio thread.
 //
-// Header-only. Fixed power-of-two capacity. Drop-newest-on-overflow:
-// a producer call that would wrap into the consumer's tail returns
-// false without enqueueing. Drain reads up to capacity items in FIFO
-// order.
+// Header-only. Fixed power-of-two capacity, allocation-free.
+// Drop-newest-on-overflow: a push against a full queue returns false
+// without enqueueing. Drain reads in FIFO order.
 //
 // Why we need this:
 //   `mh_set_param` takes libminihost's internal mutex, which a GUI
 //   thread may already hold (e.g. during topology edits). Calling
 //   it from the audio callback can therefore block. The queue lets
-//   the GUI hand commands off cheaply; the audio thread drains them
-//   at the top of each block and applies them via
-//   `juce::AudioProcessorParameter::setValue` (RT-safe by JUCE
-//   contract) on the underlying processor.
+//   control threads hand commands off cheaply; the audio thread
+//   drains them at the top of each block and applies them through
+//   RT-safe paths (juce::AudioProcessorParameter::setValue for
+//   parameter and bypass writes, mh_graph_set_mix_gain -- a plain
+//   store -- for mix gains, atomic stores for transport).
 //
 // The queue itself doesn't know about plugins; the consumer maps
-// `plugin_node_index` to a processor at drain time.
+// node indices to processors at drain time.
+//
+// Algorithm: Vyukov-style bounded queue restricted to one consumer.
+// Each cell carries a sequence counter; producers claim a cell by
+// CAS-advancing `head_` and publish the payload with a release store
+// of the cell's sequence, so the consumer never reads a cell whose
+// payload is still being written. A producer that loses the CAS race
+// backs off briefly (spin-relax, doubling each retry) before trying
+// again, which keeps two knob streams from cache-line ping-ponging
+// on `head_`. The single consumer owns `tail_` outright.
 
 #pragma once
 
@@ -27,42 +37,159 @@
 #include <array>
 #include <cstdint>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace minihost_desktop {
 
+// Kept for the ParamWrite payload (and source compatibility with the
+// original SPSC queue, which carried only this).
 struct ParamWriteCommand {
     int   plugin_node_index = -1;  // index into LoadedProject::plugins
     int   param_index       = -1;
     float value             = 0.0f;
 };
 
-// Capacity must be a power of two. 1024 commands ~= 16 kB; plenty for
-// typical knob-twiddling rates against any sensible block boundary.
+// Tagged command union. One queue now carries everything the audio
+// thread applies at block boundaries, so a surge of mixed commands
+// (automation playback firing param writes alongside a transport
+// start) is applied in the order it was produced.
+struct RtCommand {
+    enum class Kind : int { ParamWrite, BypassToggle, MixGain, Transport };
+
+    Kind kind = Kind::ParamWrite;
+    union {
+        ParamWriteCommand param;                    // ParamWrite
+        struct { int plugin_node_index;
+                 int bypassed; } bypass;            // BypassToggle (1 = bypassed)
+        struct { int mix_node;
+                 int input_index;
+                 float gain; } mix;                 // MixGain (linear)
+        struct { int playing;                       // Transport (1 = playing)
+                 double bpm; } transport;           // bpm <= 0 = leave unchanged
+    };
+
+    RtCommand() noexcept : param{} {}
+
+    static RtCommand paramWrite(int plugin_node_index,
+                                int param_index, float value) noexcept
+    {
+        RtCommand c;
+        c.kind = Kind::ParamWrite;
+        c.param = { plugin_node_index, param_index, value };
+        return c;
+    }
+
+    static RtCommand bypassToggle(int plugin_node_index, bool bypassed) noexcept
+    {
+        RtCommand c;
+        c.kind = Kind::BypassToggle;
+        c.bypass = { plugin_node_index, bypassed ? 1 : 0 };
+        return c;
+    }
+
+    static RtCommand mixGain(int mix_node, int input_index, float gain) noexcept
+    {
+        RtCommand c;
+        c.kind = Kind::MixGain;
+        c.mix = { mix_node, input_index, gain };
+        return c;
+    }
+
+    static RtCommand transportState(bool playing, double bpm) noexcept
+    {
+        RtCommand c;
+        c.kind = Kind::Transport;
+        c.transport = { playing ? 1 : 0, bpm };
+        return c;
+    }
+};
+
+namespace rtq_detail {
+
+// One CPU "relax" hint -- a pause/yield instruction, not an OS yield
+// (producers may be near-RT automation threads that must not block).
+inline void cpuRelax() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+} // namespace rtq_detail
+
+// Capacity must be a power of two. 1024 commands ~= 24 kB; plenty for
+// two control surfaces plus automation playback against any sensible
+// block boundary.
 template <std::size_t Capacity>
-class RtParamQueue
+class RtCommandQueue
 {
     static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
                   "Capacity must be a power of two");
 public:
-    // Producer (GUI/message thread). Returns false if full (overflow).
-    bool push(const ParamWriteCommand& cmd) noexcept
+    RtCommandQueue() noexcept
     {
-        const auto head = head_.load(std::memory_order_relaxed);
-        const auto next = (head + 1) & kMask;
-        if (next == tail_.load(std::memory_order_acquire))
-            return false;  // full: drop newest
-        buf_[head] = cmd;
-        head_.store(next, std::memory_order_release);
-        return true;
+        for (std::size_t i = 0; i < Capacity; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
     }
 
-    // Consumer (audio thread). Returns false if empty.
-    bool pop(ParamWriteCommand& out) noexcept
+    // Producer (any control thread). Returns false if full (overflow).
+    bool push(const RtCommand& cmd) noexcept
     {
-        const auto tail = tail_.load(std::memory_order_relaxed);
-        if (tail == head_.load(std::memory_order_acquire))
-            return false;
-        out = buf_[tail];
-        tail_.store((tail + 1) & kMask, std::memory_order_release);
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        unsigned backoff = 1;
+        for (;;)
+        {
+            Cell& cell = cells_[pos & kMask];
+            const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            const std::intptr_t dif
+                = (std::intptr_t) seq - (std::intptr_t) pos;
+            if (dif == 0)
+            {
+                // Cell is free at our position; try to claim it.
+                if (head_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed))
+                {
+                    cell.cmd = cmd;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // Lost the race to another producer: back off before
+                // re-contending (pos was reloaded by the failed CAS).
+                for (unsigned i = 0; i < backoff; ++i)
+                    rtq_detail::cpuRelax();
+                if (backoff < kMaxBackoff) backoff <<= 1;
+            }
+            else if (dif < 0)
+            {
+                return false;  // full: drop newest
+            }
+            else
+            {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer (audio thread only). Returns false if empty.
+    bool pop(RtCommand& out) noexcept
+    {
+        Cell& cell = cells_[tail_ & kMask];
+        const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+        if ((std::intptr_t) seq - (std::intptr_t) (tail_ + 1) < 0)
+            return false;  // producer hasn't published this cell yet
+        out = cell.cmd;
+        cell.seq.store(tail_ + Capacity, std::memory_order_release);
+        ++tail_;
         return true;
     }
 
@@ -71,17 +198,23 @@ public:
     std::size_t approxSize() const noexcept
     {
         const auto h = head_.load(std::memory_order_relaxed);
-        const auto t = tail_.load(std::memory_order_relaxed);
-        return (h - t) & kMask;
+        return (h - tail_) & kMask;
     }
 
     constexpr std::size_t capacity() const noexcept { return Capacity; }
 
 private:
     static constexpr std::size_t kMask = Capacity - 1;
-    alignas(64) std::atomic<std::size_t> head_{ 0 };
-    alignas(64) std::atomic<std::size_t> tail_{ 0 };
-    std::array<ParamWriteCommand, Capacity> buf_{};
+    static constexpr unsigned    kMaxBackoff = 64;
+
+    struct Cell {
+        std::atomic<std::size_t> seq{ 0 };
+        RtCommand                cmd;
+    };
+
+    alignas(64) std::atomic<std::size_t> head_{ 0 };  // producers (CAS)
+    alignas(64) std::size_t              tail_{ 0 };  // consumer-owned
+    std::array<Cell, Capacity>           cells_{};
 };
 
 } // namespace minihost_desktop
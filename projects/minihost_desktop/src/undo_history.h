@@ -1,6 +1,7 @@
 // undo_history.h
 //
-// Snapshot-based undo/redo for a ProjectDocument.
+// Snapshot-based undo/redo for a ProjectDocument, with delta-encoded
+// plugin state blobs.
 //
 // ProjectDocument is a plain aggregate of copyable specs (it round-trips
 // losslessly to JSON), so a whole-document snapshot is both correct and
@@ -9,6 +10,23 @@
 // path regardless of which of the ~19 node kinds or edge shapes changed, so
 // adding a new node kind needs no undo work.
 //
+// The one place a snapshot is NOT cheap is plugin state: state_b64 can be
+// hundreds of MB for sampler-heavy sessions. Two things keep undo memory
+// proportional to what actually changed rather than to depth x document
+// size:
+//
+//   1. juce::String is reference-counted, so copying a document shares
+//      every unchanged blob with the live document -- a snapshot copies
+//      spec structs, never state bytes, and never serializes anything
+//      (no JSON is produced until File > Save).
+//   2. When a blob DOES change between adjacent history entries, the
+//      older entry keeps only a delta against its successor (shared
+//      prefix length, shared suffix length, and the differing middle
+//      span). State edits are typically localized, so the middle is
+//      small. Only the top entry of each stack holds full blobs; deltas
+//      are reconstituted as entries return to the top, so undo() /
+//      redo() still restore byte-exact documents.
+//
 // Usage: call snapshot(doc) immediately BEFORE mutating the document. undo()
 // restores the previous state into the caller's document (saving the current
 // state for redo); redo() reverses it. Any fresh snapshot() clears the redo
@@ -21,6 +39,7 @@
 
 #include "project.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -29,14 +48,19 @@ namespace minihost_desktop {
 class UndoHistory {
 public:
     // Cap the depth so a long editing session can't grow without bound.
-    // Documents are small; 100 steps is generous.
+    // Entries cost roughly what their edit changed, so 100 steps stays
+    // modest even for blob-heavy sessions.
     explicit UndoHistory(std::size_t limit = 100) : limit_(limit) {}
 
     // Capture `current` as a restore point. Call BEFORE the mutation.
     // Clears the redo stack (a new edit invalidates any redo future).
     void snapshot(const project::ProjectDocument& current)
     {
-        undo_.push_back(current);
+        // The previous top now has a successor; shrink its changed
+        // blobs to deltas against it.
+        if (!undo_.empty())
+            deltaEncode(undo_.back(), current);
+        undo_.push_back(Entry{current, {}});
         if (undo_.size() > limit_)
             undo_.erase(undo_.begin());
         redo_.clear();
@@ -51,8 +75,14 @@ public:
     bool undo(project::ProjectDocument& current)
     {
         if (undo_.empty()) return false;
-        redo_.push_back(current);
-        current = std::move(undo_.back());
+        // The entry below the top references the top's blobs; make it
+        // whole before the top leaves the stack.
+        if (undo_.size() >= 2)
+            reconstitute(undo_[undo_.size() - 2], undo_.back().doc);
+        if (!redo_.empty())
+            deltaEncode(redo_.back(), current);
+        redo_.push_back(Entry{current, {}});
+        current = std::move(undo_.back().doc);
         undo_.pop_back();
         return true;
     }
@@ -62,8 +92,12 @@ public:
     bool redo(project::ProjectDocument& current)
     {
         if (redo_.empty()) return false;
-        undo_.push_back(current);
-        current = std::move(redo_.back());
+        if (redo_.size() >= 2)
+            reconstitute(redo_[redo_.size() - 2], redo_.back().doc);
+        if (!undo_.empty())
+            deltaEncode(undo_.back(), current);
+        undo_.push_back(Entry{current, {}});
+        current = std::move(redo_.back().doc);
         redo_.pop_back();
         return true;
     }
@@ -79,8 +113,99 @@ public:
     std::size_t redoDepth() const { return redo_.size(); }
 
 private:
-    std::vector<project::ProjectDocument> undo_;
-    std::vector<project::ProjectDocument> redo_;
+    // A changed state blob, stored against the entry ABOVE this one on
+    // the same stack (its successor in time). Encoded over the base64
+    // text: prefix/suffix bytes are taken from the successor's blob and
+    // `middle` replaces the differing span.
+    struct StateDelta {
+        juce::String id;          // plugin node id
+        int          prefix = 0;  // bytes shared with the successor blob's head
+        int          suffix = 0;  // bytes shared with its tail
+        juce::String middle;
+    };
+
+    struct Entry {
+        project::ProjectDocument doc;
+        // Non-empty only while this entry is below the top of its
+        // stack; the corresponding doc.plugins state_b64 are cleared.
+        std::vector<StateDelta>  deltas;
+    };
+
+    static const project::PluginNodeSpec* findPlugin(
+        const project::ProjectDocument& doc, const juce::String& id)
+    {
+        for (const auto& pl : doc.plugins)
+            if (pl.id == id) return &pl;
+        return nullptr;
+    }
+
+    static project::PluginNodeSpec* findPlugin(
+        project::ProjectDocument& doc, const juce::String& id)
+    {
+        for (auto& pl : doc.plugins)
+            if (pl.id == id) return &pl;
+        return nullptr;
+    }
+
+    // Shrink `older`'s changed state blobs to deltas against `newer`
+    // (the document that sits, or is about to sit, directly above it).
+    // Unchanged blobs already share storage via juce::String's refcount
+    // and are left alone; plugins absent from `newer` (removed by the
+    // edit) keep their full blob -- there is nothing to delta against.
+    static void deltaEncode(Entry& older, const project::ProjectDocument& newer)
+    {
+        for (auto& pl : older.doc.plugins)
+        {
+            if (pl.state_b64.isEmpty()) continue;
+            const auto* succ = findPlugin(newer, pl.id);
+            if (succ == nullptr || succ->state_b64.isEmpty()) continue;
+            if (pl.state_b64 == succ->state_b64) continue;
+
+            // Base64 text is ASCII, so raw UTF-8 bytes compare 1:1.
+            const char* a  = pl.state_b64.toRawUTF8();
+            const char* b  = succ->state_b64.toRawUTF8();
+            const int   an = (int) pl.state_b64.getNumBytesAsUTF8();
+            const int   bn = (int) succ->state_b64.getNumBytesAsUTF8();
+
+            const int maxShared = std::min(an, bn);
+            int prefix = 0;
+            while (prefix < maxShared && a[prefix] == b[prefix]) ++prefix;
+            int suffix = 0;
+            while (suffix < maxShared - prefix
+                   && a[an - 1 - suffix] == b[bn - 1 - suffix]) ++suffix;
+
+            StateDelta d;
+            d.id     = pl.id;
+            d.prefix = prefix;
+            d.suffix = suffix;
+            d.middle = juce::String::fromUTF8(a + prefix, an - prefix - suffix);
+            older.deltas.push_back(std::move(d));
+            pl.state_b64.clear();
+        }
+    }
+
+    // Rebuild `e`'s full state blobs from its deltas and the successor
+    // document they were encoded against. Inverse of deltaEncode;
+    // called as an entry becomes the top of its stack.
+    static void reconstitute(Entry& e, const project::ProjectDocument& successor)
+    {
+        for (const auto& d : e.deltas)
+        {
+            auto* pl = findPlugin(e.doc, d.id);
+            const auto* succ = findPlugin(successor, d.id);
+            if (pl == nullptr || succ == nullptr) continue;
+
+            const char* b  = succ->state_b64.toRawUTF8();
+            const int   bn = (int) succ->state_b64.getNumBytesAsUTF8();
+            pl->state_b64 = juce::String::fromUTF8(b, d.prefix)
+                          + d.middle
+                          + juce::String::fromUTF8(b + bn - d.suffix, d.suffix);
+        }
+        e.deltas.clear();
+    }
+
+    std::vector<Entry> undo_;
+    std::vector<Entry> redo_;
     std::size_t limit_;
 };
 
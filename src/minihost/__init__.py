@@ -25,55 +25,184 @@ Example usage:
     >>> # Save/restore state
     >>> state = plugin.get_state()
     >>> plugin.set_state(state)
+
+All exports are loaded lazily (PEP 562): ``import minihost`` itself is
+cheap, and the native ``_core`` extension is only loaded the first time a
+native name is touched. This keeps short CLI invocations and metadata-only
+operations (scan-cache queries, .vstpreset indexing via pure-Python
+callers) from paying the native-module import cost.
 """
 
-from minihost._core import (
-    AudioBuffer,
-    AudioBufferD,
-    Plugin,
-    PluginChain,
-    PluginBus,
-    PluginGraph,
-    Session,
-    AudioDevice,
-    MidiFile,
-    MidiIn,
-    probe,
-    scan_directory,
-    midi_get_input_ports,
-    midi_get_output_ports,
-    audio_get_playback_devices,
-    audio_get_capture_devices,
-    api_version,
-    api_version_string,
-    MH_API_VERSION_MAJOR,
-    MH_API_VERSION_MINOR,
-    MH_API_VERSION_PATCH,
-    MH_API_VERSION_NUMBER,
-    MH_API_VERSION_STRING,
-    MH_CHANGE_LATENCY,
-    MH_CHANGE_PARAM_INFO,
-    MH_CHANGE_PROGRAM,
-    MH_CHANGE_NON_PARAM_STATE,
-    MH_PRECISION_SINGLE,
-    MH_PRECISION_DOUBLE,
-    MIDI_OUT_CAPACITY,
-)
+import atexit as _atexit
+import importlib as _importlib
+import sys as _sys
 
-from minihost.render import (
-    render_midi,
-    render_midi_stream,
-    render_midi_to_file,
-    midi_file_to_events,
-    MidiRenderer,
-)
+# Names exported straight from the native _core extension. Touching any of
+# these loads the extension (and applies its one-time setup; see
+# _load_core below).
+_CORE_EXPORTS = frozenset({
+    "AudioBuffer",
+    "AudioBufferD",
+    "BufferOp",
+    "BufferPool",
+    "Plugin",
+    "PluginChain",
+    "ChainScratchArena",
+    "PluginBus",
+    "PluginGraph",
+    "Session",
+    "AudioDevice",
+    "AudioFileReader",
+    "AudioFileWriter",
+    "LoudnessMeter",
+    "MidiFile",
+    "MidiEventTimeline",
+    "MidiIn",
+    "MorphAutomation",
+    "MorphPair",
+    "KeyframeAutomation",
+    "probe",
+    "probe_batch",
+    "scan_directory",
+    "capture_states",
+    "restore_states",
+    "midi_get_input_ports",
+    "midi_get_output_ports",
+    "audio_get_playback_devices",
+    "audio_get_capture_devices",
+    "audio_refresh_devices",
+    "audio_cache_set_budget",
+    "audio_cache_stats",
+    "audio_cache_clear",
+    "layout_cache_size",
+    "layout_cache_clear",
+    "layout_cache_export",
+    "layout_cache_import",
+    "rt_audit_enabled",
+    "rt_audit_report",
+    "rt_audit_reset",
+    "eventlog_enable",
+    "eventlog_disable",
+    "eventlog_enabled",
+    "eventlog_dump",
+    "eventlog_reset",
+    "metrics_snapshot",
+    "metrics_reset",
+    "measure_peak_rms",
+    "set_thread_policy",
+    "set_message_pumps",
+    "get_message_pumps",
+    "api_version",
+    "api_version_string",
+    "MH_API_VERSION_MAJOR",
+    "MH_API_VERSION_MINOR",
+    "MH_API_VERSION_PATCH",
+    "MH_API_VERSION_NUMBER",
+    "MH_API_VERSION_STRING",
+    "MH_CHANGE_LATENCY",
+    "MH_CHANGE_PARAM_INFO",
+    "MH_CHANGE_PROGRAM",
+    "MH_CHANGE_NON_PARAM_STATE",
+    "MH_PRECISION_SINGLE",
+    "MH_PRECISION_DOUBLE",
+    "MH_AUTOMATION_SAMPLE_ACCURATE",
+    "MH_AUTOMATION_BLOCK_RATE",
+    "MH_SMOOTH_LINEAR",
+    "MH_SMOOTH_EXPONENTIAL",
+    "MIDI_OUT_CAPACITY",
+    "MIDI_EVENT_SIZE",
+})
 
-from minihost.audio_io import (
-    read_audio,
-    write_audio,
-    get_audio_info,
-    resample,
-)
+# Pure-Python exports: name -> (submodule, attribute). The submodule is
+# imported on first access; an attribute of None exposes the submodule
+# itself. Submodules that use _core import it themselves, so touching e.g.
+# render_midi still pulls the extension -- but only then.
+_LAZY_EXPORTS = {}
+for _mod, _names in {
+    "render": (
+        "render_midi",
+        "render_midi_parallel",
+        "render_midi_stream",
+        "render_midi_to_file",
+        "render_preview",
+        "midi_file_to_events",
+        "MidiRenderer",
+    ),
+    "audio_io": ("read_audio", "write_audio", "get_audio_info", "resample"),
+    "control": ("MidiMapper",),
+    "process": (
+        "BatchResult",
+        "PreparedRender",
+        "RenderCache",
+        "autotune_block_size",
+        "batch_process",
+        "process_audio",
+        "process_audio_multibus",
+        "process_audio_stream",
+        "process_audio_to_file",
+    ),
+    "chain": ("load_chain",),
+    "compose": (
+        "Compose",
+        "Gain",
+        "Normalize",
+        "Trim",
+        "Fade",
+        "Maybe",
+        "OneOf",
+        "SomeOf",
+        "RandomParam",
+        "AddGaussianNoise",
+    ),
+    "project": (
+        "LoadedProject",
+        "ProjectError",
+        "load_project",
+        "save_project",
+        "render_project",
+    ),
+    "project_binary": (
+        "is_binary_project",
+        "load_project_binary",
+        "read_topology",
+        "save_project_binary",
+    ),
+    "automation": (
+        "find_param_by_name",
+        "parse_param_arg",
+        "parse_automation_file",
+        "parse_automation_curves",
+    ),
+    "_async": (
+        "open_async",
+        "aopen",
+        "aprocess_audio",
+        "aprocess_audio_stream",
+    ),
+    "vstpreset": (
+        "VstPreset",
+        "VstPresetInfo",
+        "read_vstpreset",
+        "read_vstpreset_info",
+        "index_vstpreset_dir",
+        "load_vstpreset",
+        "write_vstpreset",
+        "save_vstpreset",
+    ),
+}.items():
+    for _name in _names:
+        _LAZY_EXPORTS[_name] = ("minihost." + _mod, _name)
+_LAZY_EXPORTS.update({
+    "plugincache": ("minihost.plugincache", None),
+    "scan_plugins": ("minihost.plugincache", "scan"),
+    "query_plugins": ("minihost.plugincache", "query"),
+    "morph": ("minihost.morph", None),
+    "capture_params": ("minihost.morph", "capture"),
+    "apply_params": ("minihost.morph", "apply"),
+    "lerp_params": ("minihost.morph", "lerp"),
+    "morph_params": ("minihost.morph", "morph"),
+})
+del _mod, _names, _name
 
 
 # Wrap as_ndarray() to convert nanobind's "ModuleNotFoundError: No module
@@ -97,94 +226,160 @@ def _make_as_ndarray_with_friendly_error(cls):
     cls.as_ndarray = as_ndarray  # type: ignore[method-assign]
 
 
-_make_as_ndarray_with_friendly_error(AudioBuffer)
-_make_as_ndarray_with_friendly_error(AudioBufferD)
+_core_module = None
 
 
-from minihost.control import MidiMapper
+def _load_core():
+    """Import the native extension, applying its one-time setup (the
+    friendly as_ndarray error wrapper) on first load."""
+    global _core_module
+    if _core_module is None:
+        # import_module rather than `from minihost import _core`: the latter
+        # consults this module's __getattr__ and would recurse back here.
+        _core = _importlib.import_module("minihost._core")
 
-from minihost.process import (
-    process_audio,
-    process_audio_stream,
-    process_audio_to_file,
-)
+        _make_as_ndarray_with_friendly_error(_core.AudioBuffer)
+        _make_as_ndarray_with_friendly_error(_core.AudioBufferD)
+        _core_module = _core
+    return _core_module
 
-from minihost.chain import load_chain
 
-from minihost.compose import (
-    Compose,
-    Gain,
-    Normalize,
-    Trim,
-    Fade,
-    Maybe,
-    OneOf,
-    SomeOf,
-    RandomParam,
-    AddGaussianNoise,
-)
+# Cleanly stop the native plugin thread at interpreter exit. Without this, a
+# JUCE MessageManager left alive on the background thread deadlocks process
+# exit on Linux. Registered unconditionally (it is cheap) because the
+# extension can be pulled in through any submodule, not just through this
+# module's lazy attributes; no-op if the extension was never imported or the
+# thread was never started.
+@_atexit.register
+def _shutdown_message_thread():
+    core = _sys.modules.get("minihost._core")
+    if core is not None:
+        core._message_thread_shutdown()
+
+
+def midi_event_dtype():
+    """Structured numpy dtype matching the native MH_MidiEvent record.
+
+    View the uint8 array returned by PluginGraph.borrow_midi_output_events
+    with this dtype to read events zero-copy::
+
+        raw = graph.borrow_midi_output_events(out_node)
+        events = raw.view(minihost.midi_event_dtype())
+        events["sample_offset"], events["status"], ...
 
-from minihost.project import (
-    LoadedProject,
-    ProjectError,
-    load_project,
-    save_project,
-    render_project,
-)
+    Fields are sample_offset (int32), status, data1, data2 (uint8);
+    itemsize is MIDI_EVENT_SIZE (includes the struct's tail padding).
+    Requires numpy; raises ImportError otherwise.
+    """
+    try:
+        import numpy
+    except ImportError as e:
+        raise ImportError(
+            "midi_event_dtype() requires numpy. Install minihost with the "
+            "numpy extra: 'pip install minihost[numpy]'."
+        ) from e
+    return numpy.dtype(
+        {
+            "names": ["sample_offset", "status", "data1", "data2"],
+            "formats": ["=i4", "u1", "u1", "u1"],
+            "offsets": [0, 4, 5, 6],
+            "itemsize": _load_core().MIDI_EVENT_SIZE,
+        }
+    )
 
-from minihost import plugincache
-from minihost.plugincache import scan as scan_plugins
-from minihost.plugincache import query as query_plugins
 
-from minihost.automation import (
-    find_param_by_name,
-    parse_param_arg,
-    parse_automation_file,
-)
+def __getattr__(name):
+    if name == "_core":
+        value = _load_core()
+    elif name in _CORE_EXPORTS:
+        value = getattr(_load_core(), name)
+    elif name in _LAZY_EXPORTS:
+        module_name, attr = _LAZY_EXPORTS[name]
+        module = _importlib.import_module(module_name)
+        if _core_module is None and "minihost._core" in _sys.modules:
+            _load_core()  # the submodule pulled _core in; apply its setup
+        value = module if attr is None else getattr(module, attr)
+    else:
+        raise AttributeError(f"module 'minihost' has no attribute {name!r}")
+    # Cache so subsequent lookups bypass __getattr__.
+    globals()[name] = value
+    return value
 
-from minihost import morph
-from minihost.morph import (
-    capture as capture_params,
-    apply as apply_params,
-    lerp as lerp_params,
-    morph as morph_params,
-)
 
-from minihost._async import open_async
+def __dir__():
+    return sorted(set(__all__) | set(globals()))
 
-from minihost.vstpreset import (
-    VstPreset,
-    read_vstpreset,
-    load_vstpreset,
-    write_vstpreset,
-    save_vstpreset,
-)
 
 __all__ = [
     # Core classes
     "AudioBuffer",
     "AudioBufferD",
+    "BufferOp",
+    "BufferPool",
     "Plugin",
     "PluginChain",
+    "ChainScratchArena",
     "PluginBus",
     "PluginGraph",
     "Session",
     "AudioDevice",
+    "AudioFileReader",
+    "AudioFileWriter",
+    "LoudnessMeter",
     "MidiFile",
+    "MidiEventTimeline",
     "MidiIn",
+    "MorphAutomation",
+    "MorphPair",
+    "KeyframeAutomation",
     # Plugin discovery
     "probe",
+    "probe_batch",
     "scan_directory",
+    # Batch state capture/restore (one plugin-thread hop per batch)
+    "capture_states",
+    "restore_states",
     # MIDI ports
     "midi_get_input_ports",
     "midi_get_output_ports",
     # Audio devices
     "audio_get_playback_devices",
     "audio_get_capture_devices",
+    "audio_refresh_devices",
+    # Decoded-audio cache
+    "audio_cache_set_budget",
+    "audio_cache_stats",
+    "audio_cache_clear",
+    # Negotiated-layout cache
+    "layout_cache_size",
+    "layout_cache_clear",
+    "layout_cache_export",
+    "layout_cache_import",
+    # RT-safety audit
+    "rt_audit_enabled",
+    "rt_audit_report",
+    "rt_audit_reset",
+    # Flight-recorder event log
+    "eventlog_enable",
+    "eventlog_disable",
+    "eventlog_enabled",
+    "eventlog_dump",
+    "eventlog_reset",
+    # Metrics registry
+    "metrics_snapshot",
+    "metrics_reset",
+    # Audio measurement
+    "measure_peak_rms",
+    # Thread scheduling policy
+    "set_thread_policy",
+    "set_message_pumps",
+    "get_message_pumps",
     # MIDI rendering
     "render_midi",
+    "render_midi_parallel",
     "render_midi_stream",
     "render_midi_to_file",
+    "render_preview",
     "midi_file_to_events",
     "MidiRenderer",
     # Audio I/O
@@ -193,9 +388,15 @@ __all__ = [
     "get_audio_info",
     "resample",
     # Audio processing
+    "autotune_block_size",
     "process_audio",
+    "process_audio_multibus",
     "process_audio_stream",
     "process_audio_to_file",
+    "batch_process",
+    "BatchResult",
+    "PreparedRender",
+    "RenderCache",
     # Declarative chains
     "load_chain",
     # Callable composition pipelines
@@ -215,18 +416,27 @@ __all__ = [
     "load_project",
     "save_project",
     "render_project",
+    # Binary project container (lazy state sections)
+    "is_binary_project",
+    "load_project_binary",
+    "read_topology",
+    "save_project_binary",
     # Persistent plugin-scan cache
     "plugincache",
     "scan_plugins",
     "query_plugins",
     # Control surface mapping
     "MidiMapper",
-    # Async loading
+    # Async loading and rendering
     "open_async",
+    "aopen",
+    "aprocess_audio",
+    "aprocess_audio_stream",
     # Automation
     "find_param_by_name",
     "parse_param_arg",
     "parse_automation_file",
+    "parse_automation_curves",
     # Preset morphing
     "morph",
     "capture_params",
@@ -235,7 +445,10 @@ __all__ = [
     "morph_params",
     # VST3 presets
     "VstPreset",
+    "VstPresetInfo",
     "read_vstpreset",
+    "read_vstpreset_info",
+    "index_vstpreset_dir",
     "load_vstpreset",
     "write_vstpreset",
     "save_vstpreset",
@@ -247,8 +460,15 @@ __all__ = [
     # Processing precision constants
     "MH_PRECISION_SINGLE",
     "MH_PRECISION_DOUBLE",
+    "MH_AUTOMATION_SAMPLE_ACCURATE",
+    "MH_AUTOMATION_BLOCK_RATE",
+    "MH_SMOOTH_LINEAR",
+    "MH_SMOOTH_EXPONENTIAL",
     # MIDI-output buffer default capacity
     "MIDI_OUT_CAPACITY",
+    # Native MH_MidiEvent record size / zero-copy view dtype
+    "MIDI_EVENT_SIZE",
+    "midi_event_dtype",
     # ABI versioning
     "api_version",
     "api_version_string",
@@ -259,12 +479,3 @@ __all__ = [
     "MH_API_VERSION_STRING",
 ]
 __version__ = "0.4.2"
-
-
-# Cleanly stop the native plugin thread at interpreter exit. Without this, a
-# JUCE MessageManager left alive on the background thread deadlocks process
-# exit on Linux. No-op if the thread was never started.
-import atexit as _atexit  # noqa: E402
-from minihost._core import _message_thread_shutdown as _message_thread_shutdown  # noqa: E402
-
-_atexit.register(_message_thread_shutdown)
@@ -1,4 +1,4 @@
-"""Async plugin loading for minihost.
+"""Async plugin loading and rendering for minihost.
 
 ``open_async`` loads a plugin on a background thread and returns a ``Future``
 that resolves to a ``Plugin``. This is safe because the native layer owns a
@@ -7,12 +7,43 @@ control operations are marshaled onto it regardless of which thread calls
 them, so the returned ``Plugin`` can be built on the loader thread and then
 used and closed from any other thread. (Set ``MINIHOST_MESSAGE_THREAD=0`` to
 disable that thread; async loading then reverts to being unsafe.)
+
+``aopen`` / ``aprocess_audio`` / ``aprocess_audio_stream`` are the asyncio
+counterparts: awaitables (and an async generator) that run the blocking work
+on a shared background thread pool so an event loop serving other traffic is
+never blocked for the duration of a load or a render. The native block loop
+releases the GIL while it runs, so renders on different pool workers execute
+genuinely in parallel.
 """
 
 from __future__ import annotations
 
+import asyncio
 import concurrent.futures
+import functools
+import os
 import threading
+from typing import TYPE_CHECKING, Any, AsyncIterator
+
+if TYPE_CHECKING:
+    from minihost._core import AudioBuffer, Plugin
+
+# Shared worker pool for every async entry point in this module. Lazily
+# created so merely importing minihost never spins up threads; sized to
+# the machine because renders release the GIL and scale across cores.
+_executor: concurrent.futures.ThreadPoolExecutor | None = None
+_executor_lock = threading.Lock()
+
+
+def _get_executor() -> concurrent.futures.ThreadPoolExecutor:
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            _executor = concurrent.futures.ThreadPoolExecutor(
+                max_workers=os.cpu_count() or 4,
+                thread_name_prefix="minihost-async",
+            )
+        return _executor
 
 
 def open_async(
@@ -39,6 +70,9 @@ def open_async(
         plugin.process(in_buf, out_buf)
         plugin.close()
 
+    Inside a running event loop, prefer :func:`aopen`, which awaits the same
+    load without tying up a loop worker.
+
     Args:
         path: Path to the plugin (.vst3, .component, .lv2).
         sample_rate: Sample rate in Hz.
@@ -50,24 +84,131 @@ def open_async(
     Returns:
         A Future whose ``.result()`` is the loaded ``Plugin``.
     """
-    from minihost._core import Plugin
-
-    future: concurrent.futures.Future = concurrent.futures.Future()
-
-    def _loader() -> None:
-        try:
-            future.set_result(
-                Plugin(
-                    path,
-                    sample_rate=sample_rate,
-                    max_block_size=max_block_size,
-                    in_channels=in_channels,
-                    out_channels=out_channels,
-                    sidechain_channels=sidechain_channels,
-                )
-            )
-        except Exception as exc:  # noqa: BLE001 - propagated via the Future
-            future.set_exception(exc)
 
-    threading.Thread(target=_loader, daemon=True).start()
-    return future
+    def _loader() -> "Plugin":
+        from minihost._core import Plugin
+
+        return Plugin(
+            path,
+            sample_rate=sample_rate,
+            max_block_size=max_block_size,
+            in_channels=in_channels,
+            out_channels=out_channels,
+            sidechain_channels=sidechain_channels,
+        )
+
+    return _get_executor().submit(_loader)
+
+
+async def aopen(
+    path: str,
+    sample_rate: float = 48000.0,
+    max_block_size: int = 512,
+    in_channels: int = 2,
+    out_channels: int = 2,
+    sidechain_channels: int = 0,
+) -> "Plugin":
+    """Awaitable plugin load: ``plugin = await minihost.aopen(path)``.
+
+    The asyncio counterpart of :func:`open_async` -- same arguments, same
+    background load on the shared pool, but returns an awaitable instead of a
+    ``concurrent.futures.Future``, so an event-loop worker stays free while a
+    heavy sampler constructs.
+    """
+    return await asyncio.wrap_future(
+        open_async(
+            path,
+            sample_rate=sample_rate,
+            max_block_size=max_block_size,
+            in_channels=in_channels,
+            out_channels=out_channels,
+            sidechain_channels=sidechain_channels,
+        )
+    )
+
+
+async def aprocess_audio(
+    plugin_or_chain: Any,
+    audio: Any | None = None,
+    *,
+    progress_callback: Any | None = None,
+    **kwargs: Any,
+) -> "AudioBuffer":
+    """Awaitable :func:`minihost.process_audio`.
+
+    Runs the whole render (native block loop, GIL released) on the shared
+    background pool and resolves to the finished :class:`AudioBuffer`, so an
+    event loop serving other traffic is never blocked for the duration of a
+    render. All :func:`process_audio` keyword arguments are accepted and
+    forwarded unchanged.
+
+    ``progress_callback`` is cooperative: it is marshaled onto the event loop
+    with ``call_soon_threadsafe`` and fired there once per block, so it may
+    safely touch loop-bound state (websockets, tasks, loop-local caches).
+    Note that supplying one keeps the render on the per-block Python loop
+    instead of the single-crossing native fast path -- the usual
+    :func:`process_audio` trade-off.
+
+    Example::
+
+        plugin = await minihost.aopen("reverb.vst3")
+        out = await minihost.aprocess_audio(plugin, audio, tail_seconds=3.0)
+    """
+    from minihost.process import process_audio
+
+    loop = asyncio.get_running_loop()
+    cb = None
+    if progress_callback is not None:
+
+        def cb(done: int, total: int) -> None:
+            loop.call_soon_threadsafe(progress_callback, done, total)
+
+    return await loop.run_in_executor(
+        _get_executor(),
+        functools.partial(
+            process_audio,
+            plugin_or_chain,
+            audio,
+            progress_callback=cb,
+            **kwargs,
+        ),
+    )
+
+
+async def aprocess_audio_stream(
+    plugin_or_chain: Any,
+    audio: Any | None = None,
+    **kwargs: Any,
+) -> "AsyncIterator[Any]":
+    """Async-generator :func:`minihost.process_audio_stream`.
+
+    Yields the same post-latency-compensation blocks as the sync generator,
+    but each block is rendered on the shared background pool and awaited, so
+    the event loop runs freely between blocks::
+
+        async for block in minihost.aprocess_audio_stream(
+                plugin, audio, block_size=4096):
+            await websocket.send(block.to_numpy().tobytes())
+
+    Blocks are pulled one at a time (natural backpressure: the next block is
+    not rendered until the consumer asks for it). All
+    :func:`process_audio_stream` keyword arguments are accepted and forwarded
+    unchanged.
+    """
+    from minihost.process import process_audio_stream
+
+    loop = asyncio.get_running_loop()
+    pool = _get_executor()
+    gen = process_audio_stream(plugin_or_chain, audio, **kwargs)
+    sentinel = object()
+    try:
+        while True:
+            block = await loop.run_in_executor(pool, next, gen, sentinel)
+            if block is sentinel:
+                return
+            yield block
+    finally:
+        # Close on a worker too: after a cancellation the generator may
+        # still be executing its last block there. shield lets the close
+        # run to completion even while the cancellation propagates.
+        await asyncio.shield(loop.run_in_executor(pool, gen.close))
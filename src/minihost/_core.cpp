@@ -1,8 +1,11 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
+#include <nanobind/stl/pair.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/ndarray.h>
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -10,6 +13,21 @@
 #include <cstring>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <juce_core/juce_core.h>
 #include <juce_audio_basics/juce_audio_basics.h>
@@ -18,8 +36,14 @@
 #include "minihost_chain.h"
 #include "minihost_graph.h"
 #include "minihost_graph_v2.h"
+#include "minihost_metrics.h"
+#include "minihost_threads.h"
+#include "minihost_rt_audit.h"
+#include "minihost_eventlog.h"
 #include "minihost_audio.h"
 #include "minihost_audiofile.h"
+#include "minihost_audiocache.h"
+#include "minihost_measure.h"
 #include "minihost_midi.h"
 #include "minihost_vstpreset.h"
 #include "MidiFile.h"
@@ -44,7 +68,8 @@ public:
     using Sample = T;
 
     MhAudioBufferT(int channels, int frames)
-        : buf_(juce::jmax(1, channels), juce::jmax(0, frames))
+        : buf_(juce::jmax(1, channels), juce::jmax(0, frames)),
+          row_stride_((size_t)juce::jmax(0, frames))
     {
         // juce::AudioBuffer leaves memory uninitialized; explicit clear so
         // freshly constructed buffers are deterministic (zero-filled).
@@ -52,34 +77,309 @@ public:
     }
 
     // Non-owning view constructor: alias an existing, externally-owned
-    // contiguous channel block (JUCE's setDataToReferTo neither copies nor
-    // frees the referenced data). Because the parent's channels are laid out
-    // planar and contiguous, a contiguous channel range is itself a valid
-    // contiguous planar block, so the c_contig invariant carries over. The
-    // caller MUST keep the backing memory alive for the view's lifetime
-    // (the Python binding does this via nanobind keep_alive).
+    // channel block (JUCE's setDataToReferTo neither copies nor frees the
+    // referenced data). `rowStride` is the element distance between
+    // consecutive channel rows in the backing allocation; it equals
+    // numFrames for whole-row views (channel_view of a contiguous parent)
+    // and exceeds it for frame-range views, which alias a strided window
+    // of each row. The caller MUST keep the backing memory alive for the
+    // view's lifetime (the Python binding does this via nanobind
+    // keep_alive).
     struct AliasTag {};
-    MhAudioBufferT(AliasTag, T* const* channelPtrs, int numChannels, int numFrames)
+    MhAudioBufferT(AliasTag, T* const* channelPtrs, int numChannels, int numFrames,
+                   size_t rowStride)
+        : row_stride_(rowStride)
     {
         buf_.setDataToReferTo(const_cast<T**>(channelPtrs), numChannels, numFrames);
     }
 
+    // Adopting constructor: wrap an externally-allocated contiguous planar
+    // block (channel c at contiguousPlanar + c * numFrames) zero-copy and
+    // take ownership of it -- freeOwner(owner) runs when the buffer is
+    // destroyed. Used by audio_read to hand mh_audio_read_planar's block
+    // straight to Python without a deinterleave copy. The block has the
+    // same layout the (channels, frames) constructor produces, so the
+    // c_contig invariant holds.
+    struct AdoptTag {};
+    MhAudioBufferT(AdoptTag, T* contiguousPlanar, int numChannels, int numFrames,
+                   void* owner, void (*freeOwner)(void*))
+        : row_stride_((size_t)juce::jmax(0, numFrames)), owner_(owner, freeOwner)
+    {
+        std::vector<T*> ptrs((size_t)juce::jmax(1, numChannels));
+        for (int c = 0; c < numChannels; ++c)
+            ptrs[(size_t)c] = contiguousPlanar + (size_t)c * (size_t)numFrames;
+        buf_.setDataToReferTo(ptrs.data(), numChannels, numFrames);
+    }
+
     int channels() const { return buf_.getNumChannels(); }
     int frames()   const { return buf_.getNumSamples(); }
     T*       data()       { return buf_.getWritePointer(0); }
     const T* data() const { return buf_.getReadPointer(0); }
 
+    // Element distance between consecutive channel rows starting at
+    // data(). Equals frames() for owning buffers and channel views;
+    // larger for frame views, whose rows are windows into a wider parent.
+    size_t row_stride() const { return row_stride_; }
+    bool contiguous() const { return row_stride_ == (size_t)frames(); }
+
     juce::AudioBuffer<T>&       juce()       { return buf_; }
     const juce::AudioBuffer<T>& juce() const { return buf_; }
 
 private:
     juce::AudioBuffer<T> buf_;
+    size_t row_stride_ = 0;
+    // Backing allocation for the AdoptTag constructor; null (and the
+    // no-op deleter never invoked) for the owning and AliasTag paths.
+    std::unique_ptr<void, void (*)(void*)> owner_{nullptr, [](void*) {}};
 };
 
 // Back-compat alias: existing float code paths refer to MhAudioBuffer.
 using MhAudioBuffer  = MhAudioBufferT<float>;
 using MhAudioBufferD = MhAudioBufferT<double>;
 
+#ifndef _WIN32
+// ---- Shared-memory backing (POSIX shm_open) ----
+//
+// AudioBuffer.create_shared / attach_shared place the planar sample block
+// in a named shared-memory segment so cooperating processes (a decoder, a
+// render worker, an encoder) can hand blocks off zero-copy -- each process
+// must host its own plugin instances (one MessageManager per process), but
+// the audio between them no longer needs to be pickled. The segment starts
+// with a small header recording the shape and sample width, padded to 64
+// bytes so the sample data keeps the alignment the (channels, frames)
+// constructor provides; AdoptTag then wraps the mapped block like any other
+// externally-owned planar allocation, so indexing, DLPack export, and
+// as_ndarray all work unchanged.
+namespace {
+
+struct MhShmHeader {
+    char magic[8];              // "MHSHMAB\0"
+    std::uint32_t version;      // 1
+    std::uint32_t sample_size;  // sizeof(T): 4 (float32) or 8 (float64)
+    std::int32_t channels;
+    std::int32_t frames;
+};
+
+constexpr size_t kShmDataOffset = 64;
+constexpr char kShmMagic[8] = {'M', 'H', 'S', 'H', 'M', 'A', 'B', '\0'};
+
+// POSIX wants portable shm names to begin with exactly one slash; accept
+// bare tokens and normalize.
+std::string shm_path(const std::string& token) {
+    if (token.empty())
+        throw std::invalid_argument("Shared-memory name must be non-empty");
+    if (token[0] == '/') return token;
+    return "/" + token;
+}
+
+struct MhShmMapping {
+    void* base;
+    size_t len;
+};
+
+void shm_mapping_free(void* owner) {
+    auto* mapping = static_cast<MhShmMapping*>(owner);
+    munmap(mapping->base, mapping->len);
+    delete mapping;
+}
+
+template <typename T>
+MhAudioBufferT<T>* shm_wrap(void* base, size_t len) {
+    auto* hdr = static_cast<MhShmHeader*>(base);
+    T* data = reinterpret_cast<T*>(static_cast<char*>(base) + kShmDataOffset);
+    auto* mapping = new MhShmMapping{base, len};
+    return new MhAudioBufferT<T>(typename MhAudioBufferT<T>::AdoptTag{},
+                                 data, hdr->channels, hdr->frames,
+                                 mapping, shm_mapping_free);
+}
+
+template <typename T>
+MhAudioBufferT<T>* shm_create(const std::string& token, int channels, int frames) {
+    if (channels < 1)
+        throw std::invalid_argument("channels must be >= 1");
+    if (frames < 0)
+        throw std::invalid_argument("frames must be >= 0");
+    std::string name = shm_path(token);
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throw std::runtime_error("shm_open('" + name + "') failed: " +
+                                 std::strerror(errno));
+    size_t len = kShmDataOffset +
+                 (size_t)channels * (size_t)frames * sizeof(T);
+    if (ftruncate(fd, (off_t)len) != 0) {
+        int e = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("ftruncate('" + name + "') failed: " +
+                                 std::strerror(e));
+    }
+    void* base = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        int e = errno;
+        shm_unlink(name.c_str());
+        throw std::runtime_error("mmap('" + name + "') failed: " +
+                                 std::strerror(e));
+    }
+    auto* hdr = static_cast<MhShmHeader*>(base);
+    std::memcpy(hdr->magic, kShmMagic, sizeof(kShmMagic));
+    hdr->version = 1;
+    hdr->sample_size = (std::uint32_t)sizeof(T);
+    hdr->channels = channels;
+    hdr->frames = frames;
+    // ftruncate zero-fills the segment, so the sample data starts cleared
+    // exactly like the (channels, frames) constructor.
+    return shm_wrap<T>(base, len);
+}
+
+template <typename T>
+MhAudioBufferT<T>* shm_attach(const std::string& token) {
+    std::string name = shm_path(token);
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        throw std::runtime_error("shm_open('" + name + "') failed: " +
+                                 std::strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int e = errno;
+        close(fd);
+        throw std::runtime_error("fstat('" + name + "') failed: " +
+                                 std::strerror(e));
+    }
+    size_t len = (size_t)st.st_size;
+    if (len < kShmDataOffset) {
+        close(fd);
+        throw std::runtime_error("'" + name +
+                                 "' is too small to be a shared audio buffer");
+    }
+    void* base = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        throw std::runtime_error("mmap('" + name + "') failed: " +
+                                 std::strerror(errno));
+    auto* hdr = static_cast<MhShmHeader*>(base);
+    const char* bad = nullptr;
+    if (std::memcmp(hdr->magic, kShmMagic, sizeof(kShmMagic)) != 0)
+        bad = "' was not created by create_shared";
+    else if (hdr->version != 1)
+        bad = "' has an unsupported shared-buffer version";
+    else if (hdr->sample_size != sizeof(T))
+        bad = sizeof(T) == 4
+            ? "' holds float64 samples; attach with AudioBufferD"
+            : "' holds float32 samples; attach with AudioBuffer";
+    else if (hdr->channels < 1 || hdr->frames < 0 ||
+             len < kShmDataOffset + (size_t)hdr->channels *
+                                    (size_t)hdr->frames * sizeof(T))
+        bad = "' has a header inconsistent with its size";
+    if (bad) {
+        munmap(base, len);
+        throw std::runtime_error("'" + name + bad);
+    }
+    return shm_wrap<T>(base, len);
+}
+
+}  // namespace
+#endif  // !_WIN32
+
+// Fade gain at normalized position `t` in [0, 1]. Linear is a straight
+// ramp; equal-power follows sin(t*pi/2), so the two legs of a crossfade
+// keep the summed power constant (gain_in^2 + gain_out^2 == 1) instead
+// of dipping -3 dB at the midpoint the way two linear legs do.
+static inline double fadeGainAt(double t, bool equal_power) {
+    return equal_power ? std::sin(t * 1.5707963267948966) : t;
+}
+
+// Parse the `shape` argument shared by the fade/crossfade buffer methods.
+static bool parseFadeShape(const std::string& shape) {
+    if (shape == "equal_power") return true;
+    if (shape == "linear") return false;
+    throw nb::value_error("shape must be 'linear' or 'equal_power'");
+}
+
+// One step of a fused DSP batch for AudioBuffer.apply(). Each kind mirrors
+// one of the standalone buffer methods (apply_gain, apply_gain_ramp,
+// magnitude/get_rms_level); the point of batching is memory traffic: a list
+// of BufferOps executes as a single traversal of the sample data instead of
+// one full pass per op, which on large buffers is the whole cost.
+// Constructed via the static factories bound below; plain kind-tagged
+// struct, same pattern as the graph's MH_NODE_* kinds.
+struct BufferOp {
+    enum Kind { Gain, GainRamp, FadeIn, FadeOut, Measure };
+    Kind kind = Gain;
+    double gain0 = 1.0;   // Gain: factor. GainRamp/fades: start gain.
+    double gain1 = 1.0;   // GainRamp/fades: end gain.
+    int start = 0;        // GainRamp: first affected frame.
+    int count = 0;        // GainRamp: ramp length; fades: fade length.
+    bool want_peak = false;  // Measure
+    bool want_rms = false;   // Measure
+};
+
+// Recycling pool of fixed-shape AudioBuffers for block loops. The pool
+// preallocates `capacity` buffers; acquire() hands one out (the Python
+// object keeps it alive) and release() returns it for reuse, so steady
+// state runs with zero JUCE allocations. The free list stores the
+// Python objects themselves -- the same AudioBuffer instances cycle
+// through the loop rather than being constructed per block.
+//
+// Exhausting the pool grows it by one per acquire (warm-up, not an
+// error). Recycled buffers keep their previous contents; clear or
+// overwrite after acquiring.
+class BufferPool {
+public:
+    BufferPool(int channels, int frames, int capacity)
+        : channels_(channels), frames_(frames)
+    {
+        if (channels < 1)
+            throw std::invalid_argument("channels must be >= 1");
+        if (frames < 0)
+            throw std::invalid_argument("frames must be >= 0");
+        if (capacity < 1)
+            throw std::invalid_argument("capacity must be >= 1");
+        free_.reserve((size_t)capacity);
+        for (int i = 0; i < capacity; ++i)
+            free_.push_back(make_buffer());
+        total_ = capacity;
+    }
+
+    nb::object acquire() {
+        if (free_.empty()) {
+            ++total_;
+            return make_buffer();
+        }
+        nb::object buf = std::move(free_.back());
+        free_.pop_back();
+        return buf;
+    }
+
+    void release(nb::object buf) {
+        auto& b = nb::cast<MhAudioBuffer&>(buf);  // TypeError if not one
+        if (b.channels() != channels_ || b.frames() != frames_)
+            throw nb::value_error(
+                "buffer shape does not match the pool's (channels, frames)");
+        for (const nb::object& held : free_) {
+            if (held.ptr() == buf.ptr())
+                throw nb::value_error("buffer was already released");
+        }
+        free_.push_back(std::move(buf));
+    }
+
+    int channels()  const { return channels_; }
+    int frames()    const { return frames_; }
+    int available() const { return (int)free_.size(); }
+    int total()     const { return total_; }
+
+private:
+    nb::object make_buffer() const {
+        return nb::cast(new MhAudioBuffer(channels_, frames_),
+                        nb::rv_policy::take_ownership);
+    }
+
+    int channels_;
+    int frames_;
+    int total_ = 0;
+    std::vector<nb::object> free_;
+};
+
 // Normalize a (possibly negative) index to [0, size). Throws on out-of-range.
 static int normalize_index(int idx, int size, const char* axis) {
     int result = idx;
@@ -179,23 +479,6 @@ static MH_MidiEvent parse_midi_event(nb::handle item) {
     return e;
 }
 
-// Convert planar float audio [ch0_s0,ch0_s1,...,ch1_s0,ch1_s1,...] to interleaved
-// [s0_ch0,s0_ch1,...,s1_ch0,s1_ch1,...].
-static void planar_to_interleaved(const float* planar, float* interleaved,
-                                  size_t channels, size_t frames) {
-    for (size_t f = 0; f < frames; f++)
-        for (size_t ch = 0; ch < channels; ch++)
-            interleaved[f * channels + ch] = planar[ch * frames + f];
-}
-
-// Convert interleaved float audio to planar layout.
-static void interleaved_to_planar(const float* interleaved, float* planar,
-                                  size_t channels, size_t frames) {
-    for (size_t ch = 0; ch < channels; ch++)
-        for (size_t f = 0; f < frames; f++)
-            planar[ch * frames + f] = interleaved[f * channels + ch];
-}
-
 // Validate audio buffer shape for a process call. Throws on mismatch.
 // User arrays must have >= the plugin's required channel count; extra
 // channels are harmless (the C layer only references the first N).
@@ -227,6 +510,156 @@ static void validate_process_shape(int in_channels, int out_channels,
     }
 }
 
+// Batch-render driver shared by Plugin.process_blocks and
+// PluginChain.process_blocks: slice one large (channels, frames) pair
+// into block_size sub-blocks and loop `process_fn` over them with the
+// GIL released for the whole batch. The GIL is re-acquired only to
+// invoke the optional progress callback every progress_interval
+// blocks, so light plugins stop being Python-dispatch-bound -- one
+// binding crossing per render instead of one per block.
+template <typename ProcessFn>
+static void process_blocks_impl(AudioArray& input, AudioArray& output,
+                                int block_size, nb::object progress,
+                                int progress_interval,
+                                int required_in, int required_out,
+                                int max_block_size,
+                                ProcessFn process_fn, const char* fail_msg) {
+    int in_channels = static_cast<int>(input.shape(0));
+    int out_channels = static_cast<int>(output.shape(0));
+    int in_frames = static_cast<int>(input.shape(1));
+    int out_frames = static_cast<int>(output.shape(1));
+
+    // Channel counts and block_size go through the usual checks; the
+    // buffers themselves may be any length, they just have to agree.
+    validate_process_shape(in_channels, out_channels, block_size, block_size,
+                           required_in, required_out, max_block_size);
+    if (in_frames != out_frames) {
+        throw std::runtime_error(
+            "Input and output frame counts must match (input=" +
+            std::to_string(in_frames) + ", output=" + std::to_string(out_frames) + ")");
+    }
+    if (progress_interval < 1) {
+        throw nb::value_error("progress_interval must be >= 1");
+    }
+
+    std::vector<const float*> in_ptrs(in_channels);
+    std::vector<float*> out_ptrs(out_channels);
+    const float* in_base = input.data();
+    float* out_base = output.data();
+
+    int total_blocks = (in_frames + block_size - 1) / block_size;
+    bool has_progress = !progress.is_none();
+
+    int start = 0;
+    int done_blocks = 0;
+    while (start < in_frames) {
+        // Without a callback the GIL is released once for the whole
+        // batch; with one, in progress_interval-block stretches.
+        int run_blocks = total_blocks - done_blocks;
+        if (has_progress && run_blocks > progress_interval) {
+            run_blocks = progress_interval;
+        }
+        int ok = 1;
+        {
+            nb::gil_scoped_release release;
+            for (int b = 0; b < run_blocks && ok; ++b) {
+                int n = in_frames - start;
+                if (n > block_size) n = block_size;
+                for (int ch = 0; ch < in_channels; ++ch) {
+                    in_ptrs[ch] = in_base + static_cast<size_t>(ch) * in_frames + start;
+                }
+                for (int ch = 0; ch < out_channels; ++ch) {
+                    out_ptrs[ch] = out_base + static_cast<size_t>(ch) * out_frames + start;
+                }
+                ok = process_fn(in_ptrs.data(), out_ptrs.data(), n);
+                start += n;
+                ++done_blocks;
+            }
+        }
+        if (!ok) {
+            throw std::runtime_error(fail_msg);
+        }
+        if (has_progress) {
+            progress(done_blocks, total_blocks);
+        }
+    }
+}
+
+// Tail-hunt driver shared by Plugin.detect_tail and
+// PluginChain.detect_tail: process silence blocks natively, scanning
+// the output peak per block (a plain fabs/max loop the compiler
+// vectorizes), until the level holds below the dBFS threshold for
+// hold_blocks consecutive blocks or max_frames is reached. The GIL is
+// released for the whole hunt, so tail trimming stops being bound by
+// per-block Python dispatch and magnitude() calls.
+template <typename ProcessFn>
+static long long detect_tail_impl(int block_size, double threshold_db,
+                                  int hold_blocks, long long max_frames,
+                                  int in_ch, int out_ch, int max_block_size,
+                                  ProcessFn process_fn, const char* fail_msg) {
+    if (block_size < 1 || block_size > max_block_size) {
+        throw std::runtime_error(
+            "block_size " + std::to_string(block_size) +
+            " out of range [1, " + std::to_string(max_block_size) + "]");
+    }
+    if (hold_blocks < 1) {
+        throw nb::value_error("hold_blocks must be >= 1");
+    }
+    if (max_frames < 1) {
+        throw nb::value_error("max_seconds must give at least one frame");
+    }
+    if (in_ch < 1) in_ch = 1;
+    if (out_ch < 1) out_ch = 1;
+
+    float threshold = static_cast<float>(std::pow(10.0, threshold_db / 20.0));
+
+    std::vector<float> in_data(static_cast<size_t>(in_ch) * block_size, 0.0f);
+    std::vector<float> out_data(static_cast<size_t>(out_ch) * block_size, 0.0f);
+    std::vector<const float*> in_ptrs(in_ch);
+    std::vector<float*> out_ptrs(out_ch);
+    for (int ch = 0; ch < in_ch; ++ch) {
+        in_ptrs[ch] = in_data.data() + static_cast<size_t>(ch) * block_size;
+    }
+    for (int ch = 0; ch < out_ch; ++ch) {
+        out_ptrs[ch] = out_data.data() + static_cast<size_t>(ch) * block_size;
+    }
+
+    long long rendered = 0;
+    long long tail_end = 0;  // end of the last block above threshold
+    int silent_run = 0;
+    int ok = 1;
+    {
+        nb::gil_scoped_release release;
+        while (rendered < max_frames && silent_run < hold_blocks) {
+            long long remaining = max_frames - rendered;
+            int n = remaining < block_size ? static_cast<int>(remaining) : block_size;
+            ok = process_fn(in_ptrs.data(), out_ptrs.data(), n);
+            if (!ok) break;
+
+            float peak = 0.0f;
+            for (int ch = 0; ch < out_ch; ++ch) {
+                const float* s = out_ptrs[ch];
+                for (int i = 0; i < n; ++i) {
+                    float a = std::fabs(s[i]);
+                    if (a > peak) peak = a;
+                }
+            }
+
+            rendered += n;
+            if (peak < threshold) {
+                ++silent_run;
+            } else {
+                silent_run = 0;
+                tail_end = rendered;
+            }
+        }
+    }
+    if (!ok) {
+        throw std::runtime_error(fail_msg);
+    }
+    return tail_end;
+}
+
 // Build a Python dict from MH_PluginDesc fields.
 static nb::dict plugin_desc_to_dict(const MH_PluginDesc& desc) {
     nb::dict d;
@@ -252,6 +685,310 @@ struct CallbackEvent {
     float float_val; // new_value (ParamValue only)
 };
 
+// Packed, time-sorted MIDI event timeline at a fixed sample rate. Built
+// once by MidiFile.sample_events() -- which converts ticks to sample
+// positions through the file's cached tempo map -- and consumed per block
+// by Plugin.process_midi_timeline / PluginChain.process_midi_timeline,
+// which binary-search the block's event range natively. That replaces the
+// per-block Python re-slicing of a list of event dicts, which on dense
+// arrangements cost more than the synth itself.
+class MidiEventTimeline {
+public:
+    explicit MidiEventTimeline(std::vector<MH_MidiEvent> events,
+                               double max_seconds)
+        : events_(std::move(events)), max_seconds_(max_seconds) {}
+
+    size_t size() const { return events_.size(); }
+
+    // Sample position of the last event (0 when empty).
+    int max_sample() const {
+        return events_.empty() ? 0 : events_.back().sample_offset;
+    }
+
+    // Time of the last event in seconds, before sample quantization
+    // (0.0 when empty).
+    double max_seconds() const { return max_seconds_; }
+
+    const std::vector<MH_MidiEvent>& events() const { return events_; }
+
+    // Build a per-block bucket index: bucket b holds the index of the
+    // first event at or after sample b * block_size. Built once per
+    // (timeline, block_size) by the renderer; every subsequent
+    // lower_bound at a block boundary is then one array fetch instead
+    // of a binary search over the whole timeline -- on a 100k-event
+    // arrangement rendered in 64-frame blocks that search runs once
+    // per block and dominates the lookup cost. Rebuilding with a new
+    // block_size replaces the index.
+    void build_block_index(int block_size) {
+        if (block_size < 1) {
+            throw std::invalid_argument("block_size must be >= 1");
+        }
+        bucket_start_.clear();
+        indexed_block_size_ = block_size;
+        if (events_.empty()) return;
+        const size_t nbuckets =
+            (size_t) events_.back().sample_offset / (size_t) block_size + 1;
+        bucket_start_.reserve(nbuckets);
+        size_t i = 0;
+        for (size_t b = 0; b < nbuckets; ++b) {
+            const long long start = (long long) b * block_size;
+            while (i < events_.size() && events_[i].sample_offset < start) ++i;
+            bucket_start_.push_back(i);
+        }
+    }
+
+    // Block size the bucket index was built for (0 = no index).
+    int indexed_block_size() const { return indexed_block_size_; }
+
+    // Index of the first event at or after `pos` (events are sorted).
+    // With a block index built, a pos inside the indexed range costs
+    // one bucket fetch plus a scan of that bucket's events (zero
+    // iterations when pos is a block boundary, the renderer's case).
+    size_t lower_bound(int pos) const {
+        if (indexed_block_size_ > 0 && pos >= 0) {
+            const size_t b = (size_t) pos / (size_t) indexed_block_size_;
+            if (b >= bucket_start_.size()) return events_.size();
+            size_t i = bucket_start_[b];
+            while (i < events_.size() && events_[i].sample_offset < pos) ++i;
+            return i;
+        }
+        auto it = std::lower_bound(
+            events_.begin(), events_.end(), pos,
+            [](const MH_MidiEvent& e, int p) { return e.sample_offset < p; });
+        return static_cast<size_t>(it - events_.begin());
+    }
+
+    // Events with absolute sample positions in [start, end), as
+    // (sample_offset, status, data1, data2) tuples.
+    nb::list slice(int start, int end) const {
+        nb::list result;
+        for (size_t i = lower_bound(start);
+             i < events_.size() && events_[i].sample_offset < end; ++i) {
+            const MH_MidiEvent& e = events_[i];
+            result.append(nb::make_tuple(e.sample_offset, e.status,
+                                         e.data1, e.data2));
+        }
+        return result;
+    }
+
+    // The whole timeline as a list of tuples (interop with callers that
+    // still want Python-side events, e.g. midi_file_to_events).
+    nb::list to_list() const {
+        nb::list result;
+        for (const MH_MidiEvent& e : events_) {
+            result.append(nb::make_tuple(e.sample_offset, e.status,
+                                         e.data1, e.data2));
+        }
+        return result;
+    }
+
+private:
+    std::vector<MH_MidiEvent> events_;  // sorted by sample_offset
+    double max_seconds_;
+    std::vector<size_t> bucket_start_;  // per-block index (see above)
+    int indexed_block_size_ = 0;        // 0 = no index built
+};
+
+
+// Native morph automation: snapshots A and B plus a piecewise-linear blend
+// curve over absolute sample positions. Built once on the Python side and
+// consumed per block by Plugin.apply_morph, which interpolates the whole
+// snapshot and writes it as one batched parameter update natively --
+// sweeping a 2000-parameter patch at block rate is otherwise a Python-side
+// loop over set_param calls.
+class MorphAutomation {
+public:
+    MorphAutomation(std::vector<float> a, std::vector<float> b,
+                    std::vector<std::pair<int, float>> curve)
+        : a_(std::move(a)), b_(std::move(b)), curve_(std::move(curve)) {
+        if (a_.size() != b_.size()) {
+            throw std::invalid_argument(
+                "snapshots differ in length (" + std::to_string(a_.size()) +
+                " vs " + std::to_string(b_.size()) + ")");
+        }
+        if (curve_.empty()) {
+            throw std::invalid_argument(
+                "curve needs at least one (sample, t) point");
+        }
+        std::stable_sort(curve_.begin(), curve_.end(),
+                         [](const std::pair<int, float>& x,
+                            const std::pair<int, float>& y) {
+                             return x.first < y.first;
+                         });
+    }
+
+    // Number of parameters per snapshot.
+    size_t size() const { return a_.size(); }
+
+    // Blend amount at an absolute sample position: linear between curve
+    // points, clamped to the first/last point outside the curve's span.
+    float t_at(int sample) const {
+        if (sample <= curve_.front().first) return curve_.front().second;
+        if (sample >= curve_.back().first) return curve_.back().second;
+        auto it = std::upper_bound(
+            curve_.begin(), curve_.end(), sample,
+            [](int s, const std::pair<int, float>& pt) { return s < pt.first; });
+        const auto& hi = *it;
+        const auto& lo = *(it - 1);
+        if (hi.first == lo.first) return hi.second;
+        double frac = static_cast<double>(sample - lo.first) /
+                      static_cast<double>(hi.first - lo.first);
+        return static_cast<float>(lo.second + (hi.second - lo.second) * frac);
+    }
+
+    const std::vector<float>& a() const { return a_; }
+    const std::vector<float>& b() const { return b_; }
+
+private:
+    std::vector<float> a_;
+    std::vector<float> b_;
+    std::vector<std::pair<int, float>> curve_;  // sorted by sample position
+};
+
+
+// Differential morph pair: the active set -- the indices where the two
+// snapshots actually differ, with an optional epsilon band -- is
+// computed once natively at construction, so each
+// Plugin.apply_morph_pair call interpolates and writes only the moving
+// parameters. A 60 Hz sweep over a 2000-parameter patch that differs
+// in 12 writes 12 values per step instead of 2000.
+class MorphPair {
+public:
+    MorphPair(const std::vector<float>& a, const std::vector<float>& b,
+              float epsilon) {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument(
+                "snapshots differ in length (" + std::to_string(a.size()) +
+                " vs " + std::to_string(b.size()) + ")");
+        }
+        if (epsilon < 0.0f) {
+            throw std::invalid_argument("epsilon must be >= 0");
+        }
+        // data() may be null for empty snapshots; the C API treats null
+        // arrays as an error, so hand it a dummy for the zero-length case.
+        const float dummy = 0.0f;
+        pair_ = mh_morph_pair_create(a.empty() ? &dummy : a.data(),
+                                     b.empty() ? &dummy : b.data(),
+                                     static_cast<int>(a.size()), epsilon);
+        if (pair_ == nullptr) {
+            throw std::runtime_error("Failed to create morph pair");
+        }
+    }
+    ~MorphPair() { mh_morph_pair_free(pair_); }
+    MorphPair(const MorphPair&) = delete;
+    MorphPair& operator=(const MorphPair&) = delete;
+
+    // Number of parameters whose endpoints differ.
+    int active_count() const { return mh_morph_pair_active_count(pair_); }
+
+    MH_MorphPair* handle() const { return pair_; }
+
+private:
+    MH_MorphPair* pair_ = nullptr;
+};
+
+
+// Native keyframe automation: per-parameter piecewise-linear curves over
+// absolute sample positions. Built once from sparse (sample, param_index,
+// value) keyframes and consumed per block by Plugin.apply_curves, which
+// evaluates every curve at the block's start sample and writes the
+// results as one batched parameter update. Replaces materializing the
+// dense per-block expansion up front (automation._interpolate_keyframes):
+// storage stays at the keyframes themselves and each block costs one
+// binary search + lerp per curve.
+class KeyframeAutomation {
+public:
+    explicit KeyframeAutomation(nb::list keyframes) {
+        std::unordered_map<int, std::vector<std::pair<int, float>>> grouped;
+        for (auto item : keyframes) {
+            auto t = nb::cast<nb::tuple>(item);
+            if (t.size() != 3) {
+                throw std::invalid_argument(
+                    "keyframe must be a 3-tuple (sample, param_index, value)");
+            }
+            const int sample = nb::cast<int>(t[0]);
+            const int param  = nb::cast<int>(t[1]);
+            const float val  = nb::cast<float>(t[2]);
+            if (param < 0) {
+                throw std::invalid_argument(
+                    "keyframe parameter index must be >= 0, got " +
+                    std::to_string(param));
+            }
+            grouped[param].emplace_back(sample, val);
+        }
+        if (grouped.empty()) {
+            throw std::invalid_argument(
+                "needs at least one (sample, param_index, value) keyframe");
+        }
+        curves_.reserve(grouped.size());
+        for (auto& [param, pts] : grouped) {
+            std::stable_sort(pts.begin(), pts.end(),
+                             [](const std::pair<int, float>& x,
+                                const std::pair<int, float>& y) {
+                                 return x.first < y.first;
+                             });
+            curves_.push_back(Curve{param, std::move(pts)});
+        }
+        std::sort(curves_.begin(), curves_.end(),
+                  [](const Curve& x, const Curve& y) {
+                      return x.param < y.param;
+                  });
+        indices_.reserve(curves_.size());
+        for (const auto& c : curves_) indices_.push_back(c.param);
+    }
+
+    // Number of automated parameters (one curve each).
+    size_t num_curves() const { return curves_.size(); }
+
+    // Automated parameter indices, ascending. Aligned with values_at's
+    // output.
+    const std::vector<int>& param_indices() const { return indices_; }
+
+    // Curve value for one parameter at an absolute sample position:
+    // linear between keyframes, clamped to the first/last keyframe
+    // outside the curve's span (same contract as MorphAutomation::t_at).
+    float value_at(int param_index, int sample) const {
+        for (const auto& c : curves_)
+            if (c.param == param_index)
+                return eval(c.points, sample);
+        throw std::invalid_argument(
+            "no curve for parameter " + std::to_string(param_index));
+    }
+
+    // Evaluate every curve at an absolute sample position into `out`,
+    // aligned with param_indices(). Resizes `out` only on first use.
+    void values_at(int sample, std::vector<float>& out) const {
+        out.resize(curves_.size());
+        for (size_t i = 0; i < curves_.size(); ++i)
+            out[i] = eval(curves_[i].points, sample);
+    }
+
+private:
+    struct Curve {
+        int param;
+        std::vector<std::pair<int, float>> points;  // sorted by sample
+    };
+
+    static float eval(const std::vector<std::pair<int, float>>& pts,
+                      int sample) {
+        if (sample <= pts.front().first) return pts.front().second;
+        if (sample >= pts.back().first) return pts.back().second;
+        auto it = std::upper_bound(
+            pts.begin(), pts.end(), sample,
+            [](int s, const std::pair<int, float>& pt) { return s < pt.first; });
+        const auto& hi = *it;
+        const auto& lo = *(it - 1);
+        if (hi.first == lo.first) return hi.second;
+        double frac = static_cast<double>(sample - lo.first) /
+                      static_cast<double>(hi.first - lo.first);
+        return static_cast<float>(lo.second + (hi.second - lo.second) * frac);
+    }
+
+    std::vector<Curve> curves_;  // sorted by parameter index
+    std::vector<int> indices_;
+};
+
+
 // Python wrapper class for MH_Plugin
 class Plugin {
 public:
@@ -284,15 +1021,21 @@ public:
     // by Session::open below.
     Plugin(MH_Session* session, const std::string& path,
            double sample_rate, int max_block_size,
-           int in_channels, int out_channels, int sidechain_channels)
+           int in_channels, int out_channels, int sidechain_channels,
+           int format = MH_FORMAT_ANY)
         : sample_rate_(sample_rate), max_block_size_(max_block_size)
     {
         char err[1024] = {0};
-        plugin_ = mh_session_open(session, path.c_str(),
-                                   sample_rate, max_block_size,
-                                   in_channels, out_channels,
-                                   sidechain_channels,
-                                   err, sizeof(err));
+        MH_OpenOptions opts;
+        mh_open_options_init(&opts);
+        opts.sample_rate     = sample_rate;
+        opts.max_block_size  = max_block_size;
+        opts.main_in_ch      = in_channels;
+        opts.main_out_ch     = out_channels;
+        opts.sidechain_in_ch = sidechain_channels;
+        opts.format          = format;
+        plugin_ = mh_session_open_opts(session, path.c_str(), &opts,
+                                        err, sizeof(err));
         if (!plugin_) {
             throw std::runtime_error(
                 std::string("Failed to open plugin via session: ") + err);
@@ -329,6 +1072,18 @@ public:
                           in_channels, out_channels);
     }
 
+    // Adopting constructor: wrap an MH_Plugin* created elsewhere
+    // (Session::standby). Takes ownership of the handle.
+    struct AdoptTag {};
+    Plugin(AdoptTag, MH_Plugin* raw)
+        : sample_rate_(mh_get_sample_rate(raw)),
+          max_block_size_(mh_get_max_block_size(raw))
+    {
+        plugin_ = raw;
+        cb_queue_.reserve(CB_QUEUE_CAPACITY);
+        dispatch_buffer_.reserve(CB_QUEUE_CAPACITY);
+    }
+
     ~Plugin() {
         close();
     }
@@ -441,6 +1196,10 @@ public:
         return mh_get_sample_rate(plugin_);
     }
 
+    int get_max_block_size() const {
+        return mh_get_max_block_size(plugin_);
+    }
+
     void set_sample_rate(double new_rate) {
         if (!mh_set_sample_rate(plugin_, new_rate)) {
             throw std::runtime_error("Failed to set sample rate");
@@ -482,6 +1241,28 @@ public:
         }
     }
 
+    void set_params(nb::handle params) {
+        std::vector<int> indices;
+        std::vector<float> values;
+        size_t n = nb::len(params);
+        indices.reserve(n);
+        values.reserve(n);
+        for (nb::handle item : params) {
+            nb::tuple t = nb::cast<nb::tuple>(item);
+            if (nb::len(t) != 2) {
+                throw std::runtime_error(
+                    "set_params expects (index, value) pairs");
+            }
+            indices.push_back(nb::cast<int>(t[0]));
+            values.push_back(nb::cast<float>(t[1]));
+        }
+        if (!mh_set_params(plugin_, indices.data(), values.data(),
+                           (int)indices.size())) {
+            throw std::runtime_error(
+                "Failed to set parameters (index out of range?)");
+        }
+    }
+
     nb::dict get_param_info(int index) const {
         MH_ParamInfo info;
         if (!mh_get_param_info(plugin_, index, &info)) {
@@ -503,6 +1284,36 @@ public:
         return d;
     }
 
+    // All parameter info in one call (single trip through the C layer
+    // instead of one per parameter).
+    nb::list get_all_param_info() const {
+        int n = mh_get_num_params(plugin_);
+        std::vector<MH_ParamInfo> infos(static_cast<size_t>(n > 0 ? n : 0));
+        int fetched = n > 0 ? mh_get_all_param_info(plugin_, infos.data(), n) : 0;
+        if (n > 0 && fetched < 0) {
+            throw std::runtime_error("Failed to get parameter info");
+        }
+
+        nb::list result;
+        for (int i = 0; i < fetched; ++i) {
+            const MH_ParamInfo& info = infos[static_cast<size_t>(i)];
+            nb::dict d;
+            d["name"] = std::string(info.name);
+            d["id"] = std::string(info.id);
+            d["label"] = std::string(info.label);
+            d["current_value_str"] = std::string(info.current_value_str);
+            d["min_value"] = info.min_value;
+            d["max_value"] = info.max_value;
+            d["default_value"] = info.default_value;
+            d["num_steps"] = info.num_steps;
+            d["is_automatable"] = info.is_automatable != 0;
+            d["is_boolean"] = info.is_boolean != 0;
+            d["category"] = info.category;
+            result.append(d);
+        }
+        return result;
+    }
+
     // Find parameter index by name (case-insensitive)
     int find_param(const std::string& name) const {
         int n = mh_get_num_params(plugin_);
@@ -510,18 +1321,24 @@ public:
         std::string name_lower = name;
         for (auto& c : name_lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
 
-        for (int i = 0; i < n; ++i) {
-            MH_ParamInfo info;
-            if (mh_get_param_info(plugin_, i, &info)) {
-                std::string pname(info.name);
-                for (auto& c : pname) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-                if (pname == name_lower)
-                    return i;
-            }
+        // Fetch the whole table in one call rather than one round trip
+        // per parameter.
+        std::vector<MH_ParamInfo> infos(static_cast<size_t>(n > 0 ? n : 0));
+        int fetched = n > 0 ? mh_get_all_param_info(plugin_, infos.data(), n) : 0;
+        for (int i = 0; i < fetched; ++i) {
+            std::string pname(infos[static_cast<size_t>(i)].name);
+            for (auto& c : pname) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            if (pname == name_lower)
+                return i;
         }
         throw std::runtime_error("Parameter not found: '" + name + "'");
     }
 
+    // Find parameter index by stable parameter ID (exact match).
+    int find_param_by_id(const std::string& param_id) const {
+        return mh_find_param_by_id(plugin_, param_id.c_str());
+    }
+
     // Get parameter value by name
     float get_param_by_name(const std::string& name) const {
         return mh_get_param(plugin_, find_param(name));
@@ -579,6 +1396,101 @@ public:
         return out;
     }
 
+    // Diff current parameters against a baseline snapshot (from
+    // morph_capture), returning only the (index, value) pairs that
+    // changed. Exact comparison -- both sides round-tripped the
+    // plugin's quantization, so untouched parameters compare equal.
+    std::vector<std::pair<int, float>> params_diff(
+            const std::vector<float>& baseline) const {
+        int n = mh_get_num_params(plugin_);
+        if (static_cast<int>(baseline.size()) != n) {
+            throw std::invalid_argument(
+                "baseline has " + std::to_string(baseline.size()) +
+                " values but plugin has " + std::to_string(n) + " parameters");
+        }
+        std::vector<std::pair<int, float>> out;
+        if (n == 0) {
+            return out;
+        }
+        std::vector<int> indices(static_cast<size_t>(n));
+        std::vector<float> values(static_cast<size_t>(n));
+        int changed = mh_params_diff(plugin_, baseline.data(), n,
+                                     indices.data(), values.data(), n);
+        if (changed < 0) {
+            throw std::runtime_error("Failed to diff parameters");
+        }
+        out.reserve(static_cast<size_t>(changed));
+        for (int i = 0; i < changed; ++i) {
+            out.emplace_back(indices[static_cast<size_t>(i)],
+                             values[static_cast<size_t>(i)]);
+        }
+        return out;
+    }
+
+    // Apply a MorphAutomation's blend at an absolute sample position:
+    // interpolate the whole snapshot natively and write it as one batched
+    // parameter update. The scratch vectors are members so a per-block
+    // call from a render loop does not allocate after the first block.
+    // Returns the blend amount that was applied.
+    float apply_morph(const MorphAutomation& automation, int sample) {
+        int n = mh_get_num_params(plugin_);
+        if (static_cast<int>(automation.size()) != n) {
+            throw std::invalid_argument(
+                "morph automation has " + std::to_string(automation.size()) +
+                " values per snapshot but plugin has " + std::to_string(n) +
+                " parameters");
+        }
+        float t = automation.t_at(sample);
+        if (n == 0) {
+            return t;
+        }
+        morph_values_.resize(static_cast<size_t>(n));
+        if (static_cast<int>(morph_indices_.size()) != n) {
+            morph_indices_.resize(static_cast<size_t>(n));
+            for (int i = 0; i < n; ++i) morph_indices_[static_cast<size_t>(i)] = i;
+        }
+        if (!mh_morph_lerp(automation.a().data(), automation.b().data(),
+                           morph_values_.data(), n, t) ||
+            !mh_set_params(plugin_, morph_indices_.data(),
+                           morph_values_.data(), n)) {
+            throw std::runtime_error("Failed to apply morph automation");
+        }
+        return t;
+    }
+
+    // Differential morph: interpolate only the pair's active set at t
+    // and write it as one batched update. Built for live sweeps where
+    // most of a big patch is identical between the snapshots.
+    void apply_morph_pair(const MorphPair& pair, float t) {
+        if (!mh_morph_pair_apply(plugin_, pair.handle(), t)) {
+            throw std::runtime_error(
+                "Failed to apply morph pair (was it built from snapshots "
+                "of this plugin's parameter count?)");
+        }
+    }
+
+    // Evaluate a KeyframeAutomation at an absolute sample position and
+    // write every curve's value as one batched parameter update. Scratch
+    // is a member so a per-block call does not allocate after the first
+    // block. Returns the number of parameters written.
+    int apply_curves(const KeyframeAutomation& automation, int sample) {
+        const auto& indices = automation.param_indices();
+        const int n = mh_get_num_params(plugin_);
+        // Curves are built without a plugin in hand, so range-check here.
+        if (!indices.empty() && indices.back() >= n) {
+            throw std::invalid_argument(
+                "curve parameter index " + std::to_string(indices.back()) +
+                " out of range (plugin has " + std::to_string(n) +
+                " parameters)");
+        }
+        automation.values_at(sample, curve_values_);
+        if (!mh_set_params(plugin_, indices.data(), curve_values_.data(),
+                           static_cast<int>(indices.size()))) {
+            throw std::runtime_error("Failed to apply keyframe automation");
+        }
+        return static_cast<int>(indices.size());
+    }
+
     // Parameter text conversion
     std::string param_to_text(int index, float value) const {
         char buf[256] = {0};
@@ -596,6 +1508,33 @@ public:
         return value;
     }
 
+    // Batched text conversion: one lock / message-thread hop for the
+    // whole list instead of one per param_to_text call.
+    std::vector<std::string> params_to_text(
+        std::vector<std::pair<int, float>> requests) const {
+        std::vector<int> indices;
+        std::vector<float> values;
+        indices.reserve(requests.size());
+        values.reserve(requests.size());
+        for (const auto& r : requests) {
+            indices.push_back(r.first);
+            values.push_back(r.second);
+        }
+        constexpr size_t kStride = 256;
+        std::vector<char> texts(requests.size() * kStride, '\0');
+        if (!requests.empty()
+            && !mh_params_to_text_bulk(plugin_, indices.data(), values.data(),
+                                       static_cast<int>(requests.size()),
+                                       texts.data(), kStride)) {
+            throw std::runtime_error("Failed to convert parameters to text");
+        }
+        std::vector<std::string> out;
+        out.reserve(requests.size());
+        for (size_t i = 0; i < requests.size(); ++i)
+            out.emplace_back(texts.data() + i * kStride);
+        return out;
+    }
+
     // Factory presets (programs)
     int num_programs() const {
         return mh_get_num_programs(plugin_);
@@ -619,19 +1558,44 @@ public:
         }
     }
 
-    // State management
-    nb::bytes get_state() const {
-        int size = mh_get_state_size(plugin_);
-        if (size <= 0) {
-            return nb::bytes(nullptr, 0);
+    // Preset bank cache (see mh_prefetch_programs in minihost.h).
+    int prefetch_programs() {
+        int n;
+        {
+            nb::gil_scoped_release release;
+            n = mh_prefetch_programs(plugin_);
+        }
+        if (n <= 0) {
+            throw std::runtime_error(
+                "Failed to prefetch programs (plugin may have none)");
         }
+        return n;
+    }
 
-        std::vector<char> buffer(size);
-        if (!mh_get_state(plugin_, buffer.data(), size)) {
-            throw std::runtime_error("Failed to get plugin state");
+    void set_program_fast(int index) {
+        if (!mh_set_program_fast(plugin_, index)) {
+            throw std::runtime_error(
+                "Fast program switch failed (index out of range or "
+                "not prefetched)");
         }
+    }
 
-        return nb::bytes(buffer.data(), size);
+    void clear_program_cache() {
+        mh_clear_program_cache(plugin_);
+    }
+
+    // State management
+    nb::bytes get_state() const {
+        // Single-call capture: the size + copy pattern would serialize
+        // the plugin state twice.
+        void* data = nullptr;
+        int size = 0;
+        if (!mh_get_state_alloc(plugin_, &data, &size)) {
+            return nb::bytes(nullptr, 0);
+        }
+        nb::bytes out(data, static_cast<size_t>(size));
+        mh_state_free(data);
+        return out;
     }
 
     void set_state(nb::bytes data) {
@@ -640,6 +1604,44 @@ public:
         }
     }
 
+    // Batched restore: state blob + program + parameter writes in one
+    // hop to the plugin thread, instead of a cross-thread round trip
+    // per call.
+    void restore(std::optional<nb::bytes> state, int program,
+                 const std::vector<std::pair<int, float>>& params) {
+        std::vector<int> indices;
+        std::vector<float> values;
+        indices.reserve(params.size());
+        values.reserve(params.size());
+        for (const auto& pv : params) {
+            indices.push_back(pv.first);
+            values.push_back(pv.second);
+        }
+        const void* blob = state ? state->c_str() : nullptr;
+        int blob_size = state ? static_cast<int>(state->size()) : 0;
+        if (!mh_restore_state(plugin_, blob, blob_size, program,
+                              indices.empty() ? nullptr : indices.data(),
+                              values.empty() ? nullptr : values.data(),
+                              static_cast<int>(indices.size()))) {
+            throw std::runtime_error("Failed to restore plugin state");
+        }
+    }
+
+    // Standby swap: stage `standby` to take over this plugin's role;
+    // the next process call adopts it at a block boundary (the two
+    // handles exchange engine instances). See mh_standby_swap for the
+    // contract.
+    void swap_standby(Plugin& standby) {
+        char err[1024] = {0};
+        if (!mh_standby_swap(plugin_, standby.plugin_, err, sizeof(err))) {
+            throw std::runtime_error(std::string("swap_standby failed: ") + err);
+        }
+    }
+
+    bool swap_pending() const {
+        return mh_standby_swap_pending(plugin_) != 0;
+    }
+
     // Bypass
     bool get_bypass() const {
         return mh_get_bypass(plugin_) != 0;
@@ -681,6 +1683,26 @@ public:
         }
     }
 
+    void warmup(int blocks) {
+        if (blocks < 1) {
+            throw std::invalid_argument("blocks must be >= 1");
+        }
+        if (!mh_warmup(plugin_, blocks)) {
+            throw std::runtime_error("Warmup failed");
+        }
+    }
+
+    // Buffer residency. A refused lock (RLIMIT_MEMLOCK) is the
+    // documented graceful-fallback path, so it returns False rather
+    // than raising.
+    bool set_lock_memory(bool enabled) {
+        return mh_set_lock_memory(plugin_, enabled ? 1 : 0) != 0;
+    }
+
+    long long get_locked_bytes() const {
+        return mh_get_locked_bytes(plugin_);
+    }
+
     // Non-realtime mode
     bool get_non_realtime() const {
         // Note: JUCE doesn't provide a getter, so we track it ourselves
@@ -694,6 +1716,21 @@ public:
         non_realtime_ = non_realtime;
     }
 
+    // Denormal (FTZ/DAZ) control
+    bool get_denormal_control() const {
+        return mh_get_denormal_control(plugin_) != 0;
+    }
+
+    void set_denormal_control(bool enabled) {
+        if (!mh_set_denormal_control(plugin_, enabled ? 1 : 0)) {
+            throw std::runtime_error("Failed to set denormal control");
+        }
+    }
+
+    unsigned long long get_denormal_hits() const {
+        return mh_get_denormal_hits(plugin_);
+    }
+
     // Process audio (simple version - no MIDI)
     void process(AudioArray input, AudioArray output) {
         int in_channels = static_cast<int>(input.shape(0));
@@ -722,16 +1759,106 @@ public:
         }
     }
 
-    // Process with MIDI
-    nb::list process_midi(AudioArray input, AudioArray output,
-                          nb::list midi_in, int midi_out_capacity)
-    {
-        check_midi_capacity(midi_out_capacity);
-        int in_channels = static_cast<int>(input.shape(0));
-        int out_channels = static_cast<int>(output.shape(0));
-        int in_frames = static_cast<int>(input.shape(1));
-        int out_frames = static_cast<int>(output.shape(1));
-
+    // Zero-allocation fast path for block loops. Both sides are
+    // AudioBuffers, so there is no DLPack export and no per-call pointer
+    // vector -- juce::AudioBuffer already holds the channel pointer
+    // arrays -- and the GIL is released while the plugin runs.
+    void process_into(const MhAudioBuffer& input, MhAudioBuffer& output) {
+        MH_Info info;
+        mh_get_info(plugin_, &info);
+        validate_process_shape(input.channels(), output.channels(),
+                               input.frames(), output.frames(),
+                               info.num_input_ch, info.num_output_ch,
+                               max_block_size_);
+
+        int ok;
+        {
+            nb::gil_scoped_release release;
+            ok = mh_process(plugin_,
+                            input.juce().getArrayOfReadPointers(),
+                            output.juce().getArrayOfWritePointers(),
+                            input.frames());
+        }
+        if (!ok) {
+            throw std::runtime_error("Process failed");
+        }
+    }
+
+    // Process interleaved audio: both arrays are [frames, channels] and
+    // C-contiguous, which is exactly the interleaved memory layout that
+    // device callbacks and audio files use. The library converts once,
+    // straight into (and out of) the plugin's process buffer -- no planar
+    // staging array on either side of the binding.
+    void process_interleaved(AudioArray input, AudioArray output) {
+        int frames = static_cast<int>(input.shape(0));
+        int channels = static_cast<int>(input.shape(1));
+        if (static_cast<int>(output.shape(0)) != frames ||
+            static_cast<int>(output.shape(1)) != channels) {
+            throw std::invalid_argument(
+                "input and output must have the same [frames, channels] shape");
+        }
+        if (channels < 1 || frames < 1) {
+            throw std::invalid_argument("need at least 1 frame and 1 channel");
+        }
+        if (frames > max_block_size_) {
+            throw std::invalid_argument(
+                "frames (" + std::to_string(frames) + ") exceeds max_block_size (" +
+                std::to_string(max_block_size_) + ")");
+        }
+
+        int ok;
+        {
+            nb::gil_scoped_release release;
+            ok = mh_process_interleaved(plugin_, input.data(), output.data(),
+                                        frames, channels);
+        }
+        if (!ok) {
+            throw std::runtime_error("Process failed");
+        }
+    }
+
+    // Native tail hunt (see detect_tail_impl). Mutates plugin state:
+    // the tail is actually rendered, so call reset() first to measure
+    // from a clean slate, or call it right after the content you want
+    // the tail of.
+    long long detect_tail(int block_size, double threshold_db, int hold_blocks,
+                          double max_seconds) {
+        MH_Info info;
+        mh_get_info(plugin_, &info);
+        long long max_frames = static_cast<long long>(max_seconds * sample_rate_);
+        return detect_tail_impl(block_size, threshold_db, hold_blocks, max_frames,
+                                info.num_input_ch, info.num_output_ch,
+                                max_block_size_,
+                                [this](const float** in, float** out, int n) {
+                                    return mh_process(plugin_, in, out, n);
+                                },
+                                "Process failed");
+    }
+
+    // Batch render: slice one large buffer into block_size sub-blocks
+    // and loop mh_process over them natively (see process_blocks_impl).
+    void process_blocks(AudioArray input, AudioArray output, int block_size,
+                        nb::object progress, int progress_interval) {
+        MH_Info info;
+        mh_get_info(plugin_, &info);
+        process_blocks_impl(input, output, block_size, progress, progress_interval,
+                            info.num_input_ch, info.num_output_ch, max_block_size_,
+                            [this](const float** in, float** out, int n) {
+                                return mh_process(plugin_, in, out, n);
+                            },
+                            "Process failed");
+    }
+
+    // Process with MIDI
+    nb::list process_midi(AudioArray input, AudioArray output,
+                          nb::list midi_in, int midi_out_capacity)
+    {
+        check_midi_capacity(midi_out_capacity);
+        int in_channels = static_cast<int>(input.shape(0));
+        int out_channels = static_cast<int>(output.shape(0));
+        int in_frames = static_cast<int>(input.shape(1));
+        int out_frames = static_cast<int>(output.shape(1));
+
         MH_Info info;
         mh_get_info(plugin_, &info);
         validate_process_shape(in_channels, out_channels, in_frames, out_frames,
@@ -777,6 +1904,81 @@ public:
         return result;
     }
 
+    // Process one block against a MidiEventTimeline: binary-search the
+    // events whose absolute sample positions fall in [start, start +
+    // frames) and feed them with block-relative offsets -- no Python-side
+    // event slicing per block.
+    nb::list process_midi_timeline(AudioArray input, AudioArray output,
+                                   const MidiEventTimeline& timeline,
+                                   int start, int midi_out_capacity)
+    {
+        check_midi_capacity(midi_out_capacity);
+        int in_channels = static_cast<int>(input.shape(0));
+        int out_channels = static_cast<int>(output.shape(0));
+        int in_frames = static_cast<int>(input.shape(1));
+        int out_frames = static_cast<int>(output.shape(1));
+
+        MH_Info info;
+        mh_get_info(plugin_, &info);
+        validate_process_shape(in_channels, out_channels, in_frames, out_frames,
+                               info.num_input_ch, info.num_output_ch, max_block_size_);
+
+        // Slice the block's events with block-relative offsets.
+        const auto& events = timeline.events();
+        std::vector<MH_MidiEvent> midi_events;
+        for (size_t i = timeline.lower_bound(start);
+             i < events.size() && events[i].sample_offset < start + in_frames;
+             ++i) {
+            MH_MidiEvent e = events[i];
+            e.sample_offset = juce::jlimit(0, in_frames - 1,
+                                           e.sample_offset - start);
+            midi_events.push_back(e);
+        }
+
+        // Set up channel pointers
+        std::vector<const float*> in_ptrs(in_channels);
+        std::vector<float*> out_ptrs(out_channels);
+
+        for (int ch = 0; ch < in_channels; ++ch) {
+            in_ptrs[ch] = input.data() + ch * in_frames;
+        }
+        for (int ch = 0; ch < out_channels; ++ch) {
+            out_ptrs[ch] = output.data() + ch * out_frames;
+        }
+
+        // Output MIDI buffer (capped at midi_out_capacity; excess dropped)
+        std::vector<MH_MidiEvent> midi_out(midi_out_capacity);
+        int num_midi_out = 0;
+
+        int ok;
+        {
+            // Released GIL: lets render threads driving separate Plugin
+            // instances (e.g. render_midi_parallel) overlap their
+            // process calls.
+            nb::gil_scoped_release release;
+            ok = mh_process_midi_io(plugin_, in_ptrs.data(), out_ptrs.data(),
+                                    in_frames, midi_events.data(),
+                                    static_cast<int>(midi_events.size()),
+                                    midi_out.data(), midi_out_capacity,
+                                    &num_midi_out);
+        }
+        if (!ok) {
+            throw std::runtime_error("Process failed");
+        }
+
+        // Convert MIDI output to Python list
+        nb::list result;
+        for (int i = 0; i < num_midi_out; ++i) {
+            result.append(nb::make_tuple(
+                midi_out[i].sample_offset,
+                midi_out[i].status,
+                midi_out[i].data1,
+                midi_out[i].data2
+            ));
+        }
+        return result;
+    }
+
     // Process with sample-accurate automation
     nb::list process_auto(AudioArray input, AudioArray output,
                           nb::list midi_in, nb::list param_changes,
@@ -914,6 +2116,126 @@ public:
         }
     }
 
+    // Capture every output bus in one processBlock call. `outputs` is a
+    // list with one entry per output bus (bus order): an array of shape
+    // (bus_channels, frames), or None to skip that bus.
+    void process_multibus(nb::list outputs, nb::object input,
+                          nb::object midi_in)
+    {
+        const int num_buses = static_cast<int>(nb::len(outputs));
+        const int plugin_buses = mh_get_num_buses(plugin_, 0);
+        if (num_buses < 1 || num_buses > plugin_buses) {
+            throw std::invalid_argument(
+                "outputs must have between 1 and " +
+                std::to_string(plugin_buses) +
+                " entries (one per output bus), got " +
+                std::to_string(num_buses));
+        }
+
+        // Resolve per-bus arrays, validating each against the bus layout.
+        std::vector<AudioArray> arrays(num_buses);
+        std::vector<bool> present(num_buses, false);
+        int nframes = -1;
+        for (int b = 0; b < num_buses; ++b) {
+            if (outputs[b].is_none()) {
+                continue;
+            }
+            arrays[b] = nb::cast<AudioArray>(outputs[b]);
+            present[b] = true;
+            MH_BusInfo bus_info;
+            if (!mh_get_bus_info(plugin_, 0, b, &bus_info)) {
+                throw std::runtime_error("Failed to query output bus " +
+                                         std::to_string(b));
+            }
+            int ch = static_cast<int>(arrays[b].shape(0));
+            int frames = static_cast<int>(arrays[b].shape(1));
+            if (ch != bus_info.num_channels) {
+                throw std::invalid_argument(
+                    "outputs[" + std::to_string(b) + "] has " +
+                    std::to_string(ch) + " channel(s) but bus '" +
+                    bus_info.name + "' has " +
+                    std::to_string(bus_info.num_channels));
+            }
+            if (nframes < 0) {
+                nframes = frames;
+            } else if (frames != nframes) {
+                throw std::invalid_argument(
+                    "all output buffers must have the same frame count");
+            }
+        }
+        if (nframes < 0) {
+            throw std::invalid_argument(
+                "outputs must contain at least one non-None buffer");
+        }
+        if (nframes > max_block_size_) {
+            throw std::invalid_argument(
+                "frames (" + std::to_string(nframes) +
+                ") exceeds max_block_size (" +
+                std::to_string(max_block_size_) + ")");
+        }
+
+        // Optional main input (silence when None, the usual case for
+        // multi-out instruments).
+        MH_Info info;
+        mh_get_info(plugin_, &info);
+        std::vector<const float*> in_ptrs;
+        AudioArray in_arr;
+        if (!input.is_none()) {
+            in_arr = nb::cast<AudioArray>(input);
+            int in_ch = static_cast<int>(in_arr.shape(0));
+            int in_frames = static_cast<int>(in_arr.shape(1));
+            if (in_ch < info.num_input_ch) {
+                throw std::invalid_argument(
+                    "input has " + std::to_string(in_ch) +
+                    " channel(s) but plugin requires at least " +
+                    std::to_string(info.num_input_ch));
+            }
+            if (in_frames != nframes) {
+                throw std::invalid_argument(
+                    "input frame count must match the output buffers");
+            }
+            in_ptrs.resize(in_ch);
+            for (int ch = 0; ch < in_ch; ++ch) {
+                in_ptrs[ch] = in_arr.data() + ch * nframes;
+            }
+        }
+
+        std::vector<MH_MidiEvent> midi_events;
+        if (!midi_in.is_none()) {
+            nb::list events = nb::cast<nb::list>(midi_in);
+            for (size_t i = 0; i < nb::len(events); ++i) {
+                midi_events.push_back(parse_midi_event(events[i]));
+            }
+        }
+
+        // Per-bus channel pointer tables.
+        std::vector<std::vector<float*>> bus_ptrs(num_buses);
+        std::vector<float* const*> bus_tables(num_buses, nullptr);
+        for (int b = 0; b < num_buses; ++b) {
+            if (!present[b]) {
+                continue;
+            }
+            int ch_count = static_cast<int>(arrays[b].shape(0));
+            bus_ptrs[b].resize(ch_count);
+            for (int ch = 0; ch < ch_count; ++ch) {
+                bus_ptrs[b][ch] = arrays[b].data() + ch * nframes;
+            }
+            bus_tables[b] = bus_ptrs[b].data();
+        }
+
+        int ok;
+        {
+            nb::gil_scoped_release release;
+            ok = mh_process_multibus(
+                plugin_, in_ptrs.empty() ? nullptr : in_ptrs.data(),
+                bus_tables.data(), num_buses, nframes, midi_events.data(),
+                static_cast<int>(midi_events.size()));
+        }
+        if (!ok) {
+            throw std::runtime_error("Multibus process failed");
+        }
+    }
+
     // Double precision support
     bool supports_double() const {
         return mh_supports_double(plugin_) != 0;
@@ -947,6 +2269,162 @@ public:
         }
     }
 
+    // Native offline block loop. Renders `out_frames` frames of output by
+    // iterating `block_size`-frame blocks entirely in C++ with the GIL
+    // released -- one Python -> C++ crossing per render instead of one per
+    // block, which is what dominated offline renders of light plugins at
+    // small block sizes. `input` may be None (synth-mode: silent input).
+    // `midi_in` / `param_changes` carry absolute sample positions, sorted;
+    // they are sliced per block with block-relative offsets here exactly
+    // like the Python loop did. `latency` frames are rendered past
+    // `out_frames` and the same number discarded from the head, so the
+    // returned buffer is time-aligned with the input. Plugin MIDI output is
+    // discarded (matching process_audio, which never surfaced it).
+    MhAudioBuffer* render_blocks(const MhAudioBuffer* input, int out_frames,
+                                 int block_size, int latency,
+                                 nb::list midi_in, nb::list param_changes)
+    {
+        if (block_size < 1) {
+            throw std::runtime_error("block_size must be >= 1");
+        }
+        if (block_size > max_block_size_) {
+            throw std::runtime_error(
+                "Block size " + std::to_string(block_size) +
+                " exceeds max block size " + std::to_string(max_block_size_));
+        }
+        if (latency < 0) latency = 0;
+
+        MH_Info info;
+        mh_get_info(plugin_, &info);
+        // A synth reports 0 input channels but the I/O buffers still need at
+        // least one channel; the plugin ignores the (silent) extra channel.
+        const int work_in = std::max(info.num_input_ch, 1);
+        const int out_ch = std::max(info.num_output_ch, 1);
+        if (input && input->channels() < info.num_input_ch) {
+            throw std::runtime_error(
+                "Input has " + std::to_string(input->channels()) +
+                " channel(s) but plugin requires at least " +
+                std::to_string(info.num_input_ch));
+        }
+
+        // Convert events under the GIL; the loop below runs without it.
+        std::vector<MH_MidiEvent> midi_events;
+        midi_events.reserve(nb::len(midi_in));
+        for (size_t i = 0; i < nb::len(midi_in); ++i) {
+            midi_events.push_back(parse_midi_event(midi_in[i]));
+        }
+        std::vector<MH_ParamChange> changes;
+        changes.reserve(nb::len(param_changes));
+        for (size_t i = 0; i < nb::len(param_changes); ++i) {
+            nb::tuple pc = nb::cast<nb::tuple>(param_changes[i]);
+            if (nb::len(pc) != 3) {
+                throw std::runtime_error(
+                    "param_changes must be (sample_offset, param_index, "
+                    "value) 3-tuples");
+            }
+            MH_ParamChange c;
+            c.sample_offset = nb::cast<int>(pc[0]);
+            c.param_index = nb::cast<int>(pc[1]);
+            c.value = nb::cast<float>(pc[2]);
+            changes.push_back(c);
+        }
+
+        auto* out = new MhAudioBuffer(out_ch, out_frames < 0 ? 0 : out_frames);
+        if (out_frames <= 0) {
+            return out;
+        }
+
+        bool ok = true;
+        {
+            nb::gil_scoped_release release;
+
+            juce::AudioBuffer<float> in_block(work_in, block_size);
+            juce::AudioBuffer<float> out_block(out_ch, block_size);
+            std::vector<const float*> in_ptrs(static_cast<size_t>(work_in));
+            std::vector<float*> out_ptrs(static_cast<size_t>(out_ch));
+            for (int ch = 0; ch < work_in; ++ch)
+                in_ptrs[static_cast<size_t>(ch)] = in_block.getReadPointer(ch);
+            for (int ch = 0; ch < out_ch; ++ch)
+                out_ptrs[static_cast<size_t>(ch)] = out_block.getWritePointer(ch);
+
+            // Discarded; sized like the default process_midi capacity so a
+            // chatty plugin doesn't make the C layer fail.
+            std::vector<MH_MidiEvent> midi_out(MIDI_OUT_CAPACITY);
+            int num_midi_out = 0;
+
+            const bool has_events = !midi_events.empty() || !changes.empty();
+            const int src_frames = input ? input->frames() : 0;
+            const int render_frames = out_frames + latency;
+            size_t midi_idx = 0;
+            size_t auto_idx = 0;
+            std::vector<MH_MidiEvent> block_midi;
+            std::vector<MH_ParamChange> block_auto;
+            int skip_remaining = latency;
+            int emitted = 0;
+
+            for (int start = 0; start < render_frames && ok; start += block_size) {
+                const int n = std::min(block_size, render_frames - start);
+
+                in_block.clear();
+                if (input && start < src_frames) {
+                    const int ncopy = std::min(n, src_frames - start);
+                    for (int ch = 0; ch < work_in; ++ch) {
+                        in_block.copyFrom(ch, 0, input->juce(), ch, start, ncopy);
+                    }
+                }
+
+                if (has_events) {
+                    block_midi.clear();
+                    while (midi_idx < midi_events.size()
+                           && midi_events[midi_idx].sample_offset < start + n) {
+                        MH_MidiEvent e = midi_events[midi_idx++];
+                        e.sample_offset = juce::jlimit(0, n - 1,
+                                                       e.sample_offset - start);
+                        block_midi.push_back(e);
+                    }
+                    block_auto.clear();
+                    while (auto_idx < changes.size()
+                           && changes[auto_idx].sample_offset < start + n) {
+                        MH_ParamChange c = changes[auto_idx++];
+                        c.sample_offset = juce::jlimit(0, n - 1,
+                                                       c.sample_offset - start);
+                        block_auto.push_back(c);
+                    }
+                    num_midi_out = 0;
+                    ok = mh_process_auto(plugin_, in_ptrs.data(), out_ptrs.data(), n,
+                                         block_midi.data(),
+                                         static_cast<int>(block_midi.size()),
+                                         midi_out.data(), MIDI_OUT_CAPACITY,
+                                         &num_midi_out,
+                                         block_auto.data(),
+                                         static_cast<int>(block_auto.size())) != 0;
+                } else {
+                    ok = mh_process(plugin_, in_ptrs.data(), out_ptrs.data(), n) != 0;
+                }
+                if (!ok) break;
+
+                if (skip_remaining >= n) {
+                    skip_remaining -= n;
+                    continue;
+                }
+                const int off = skip_remaining;
+                skip_remaining = 0;
+                const int emit = std::min(n - off, out_frames - emitted);
+                if (emit <= 0) break;
+                for (int ch = 0; ch < out_ch; ++ch) {
+                    out->juce().copyFrom(ch, emitted, out_block, ch, off, emit);
+                }
+                emitted += emit;
+                if (emitted >= out_frames) break;
+            }
+        }
+        if (!ok) {
+            delete out;
+            throw std::runtime_error("Process failed");
+        }
+        return out;
+    }
+
     // Processing precision
     int get_processing_precision() const {
         return mh_get_processing_precision(plugin_);
@@ -961,6 +2439,36 @@ public:
         }
     }
 
+    // Automation granularity (affects process_auto / render_blocks)
+    void set_automation_granularity(int min_subblock_frames, int mode) {
+        if (!mh_set_automation_granularity(plugin_, min_subblock_frames, mode)) {
+            throw std::runtime_error(
+                "Invalid automation granularity (need min_subblock_frames >= 1 and a MH_AUTOMATION_* mode)");
+        }
+    }
+
+    nb::tuple get_automation_granularity() const {
+        int min_subblock = 1;
+        int mode = 0;
+        mh_get_automation_granularity(plugin_, &min_subblock, &mode);
+        return nb::make_tuple(min_subblock, mode);
+    }
+
+    // Host-side parameter smoothing (ramps instead of block splitting)
+    void set_param_smoothing(int param_index, float ramp_ms, int mode) {
+        if (!mh_set_param_smoothing(plugin_, param_index, ramp_ms, mode)) {
+            throw std::runtime_error(
+                "Invalid parameter smoothing (bad param index or mode)");
+        }
+    }
+
+    nb::tuple get_param_smoothing(int param_index) const {
+        float ramp_ms = 0.0f;
+        int mode = 0;
+        mh_get_param_smoothing(plugin_, param_index, &ramp_ms, &mode);
+        return nb::make_tuple(ramp_ms, mode);
+    }
+
     // Track properties
     void set_track_properties(std::optional<std::string> name, std::optional<unsigned int> colour) {
         const char* name_ptr = name.has_value() ? name->c_str() : nullptr;
@@ -1034,6 +2542,57 @@ public:
         }
     }
 
+    void set_param_value_coalescing(int interval_ms) {
+        if (!mh_set_param_value_coalescing(plugin_, interval_ms))
+            throw std::runtime_error("Failed to set param value coalescing");
+    }
+
+    // Native parameter-change recording (mh_param_record_*).
+    void start_param_recording(int capacity) {
+        if (!mh_param_record_start(plugin_, capacity)) {
+            throw std::runtime_error(
+                "Failed to start parameter recording (already armed?)");
+        }
+    }
+
+    void stop_param_recording() {
+        if (!mh_param_record_stop(plugin_)) {
+            throw std::runtime_error("Failed to stop parameter recording");
+        }
+    }
+
+    bool param_recording_armed() const {
+        return mh_param_record_armed(plugin_) != 0;
+    }
+
+    // Drain captured records oldest-first as (time_sec, param_index,
+    // value) tuples -- the shape the automation timeline setters
+    // consume once time is scaled to samples.
+    nb::list fetch_param_records(int max_records) {
+        nb::list out;
+        MH_ParamRecord buf[256];
+        const int chunk = (int) (sizeof(buf) / sizeof(buf[0]));
+        int remaining = max_records;  // <= 0 drains everything
+        for (;;) {
+            int want = chunk;
+            if (max_records > 0 && remaining < want) want = remaining;
+            if (want <= 0) break;
+            const int got = mh_param_record_fetch(plugin_, buf, want);
+            for (int i = 0; i < got; i++) {
+                out.append(nb::make_tuple(buf[i].time_sec,
+                                          buf[i].param_index,
+                                          buf[i].value));
+            }
+            if (got < want) break;
+            remaining -= got;
+        }
+        return out;
+    }
+
+    long long param_records_dropped() const {
+        return mh_param_record_dropped(plugin_);
+    }
+
     void set_param_gesture_callback(nb::handle cb) {
         if (cb.is_none()) {
             param_gesture_callback_ = nb::object();
@@ -1097,6 +2656,11 @@ private:
     int max_block_size_;
     bool non_realtime_ = false;
 
+    // Scratch for apply_morph / apply_curves (avoids per-block allocation)
+    std::vector<float> morph_values_;
+    std::vector<int> morph_indices_;
+    std::vector<float> curve_values_;
+
     // Python callback holders (prevent GC)
     nb::object change_callback_;
     nb::object param_value_callback_;
@@ -1152,6 +2716,115 @@ private:
     friend class AudioDevice;
     friend class PluginChain;
     friend class PluginGraph;
+    friend class Session;
+    friend nb::list capture_states(nb::list plugins);
+    friend int restore_states(nb::list plugins, nb::list states);
+};
+
+
+// Batch state capture: serialize every plugin in one submission to the
+// plugin thread instead of a cross-thread round trip per get_state()
+// call. Returns one entry per plugin: bytes, or None for a plugin that
+// failed or reported no state.
+nb::list capture_states(nb::list plugins)
+{
+    std::vector<MH_Plugin*> raw_ptrs;
+    for (size_t i = 0; i < nb::len(plugins); ++i) {
+        Plugin& p = nb::cast<Plugin&>(plugins[i]);
+        if (!p.plugin_) {
+            throw std::runtime_error(
+                "Plugin at index " + std::to_string(i) +
+                " is invalid (null internal pointer -- was it moved from?)");
+        }
+        raw_ptrs.push_back(p.plugin_);
+    }
+
+    nb::list out;
+    const int count = static_cast<int>(raw_ptrs.size());
+    if (count == 0) return out;
+
+    std::vector<void*> datas(static_cast<size_t>(count), nullptr);
+    std::vector<int> sizes(static_cast<size_t>(count), 0);
+    mh_get_states_alloc(raw_ptrs.data(), count, datas.data(), sizes.data());
+    for (int i = 0; i < count; ++i) {
+        if (datas[(size_t) i]) {
+            out.append(nb::bytes(datas[(size_t) i],
+                                 static_cast<size_t>(sizes[(size_t) i])));
+            mh_state_free(datas[(size_t) i]);
+        } else {
+            out.append(nb::none());
+        }
+    }
+    return out;
+}
+
+// Batch state restore: the set_state counterpart of capture_states.
+// `states` must have one entry per plugin; None entries are skipped
+// (that plugin keeps its current state). Returns the number of states
+// applied.
+int restore_states(nb::list plugins, nb::list states)
+{
+    if (nb::len(plugins) != nb::len(states)) {
+        throw std::runtime_error(
+            "restore_states: plugins and states must have the same length");
+    }
+
+    std::vector<MH_Plugin*> raw_ptrs;
+    std::vector<const void*> datas;
+    std::vector<int> sizes;
+    for (size_t i = 0; i < nb::len(plugins); ++i) {
+        Plugin& p = nb::cast<Plugin&>(plugins[i]);
+        if (!p.plugin_) {
+            throw std::runtime_error(
+                "Plugin at index " + std::to_string(i) +
+                " is invalid (null internal pointer -- was it moved from?)");
+        }
+        raw_ptrs.push_back(p.plugin_);
+        if (states[i].is_none()) {
+            datas.push_back(nullptr);
+            sizes.push_back(0);
+        } else {
+            auto blob = nb::cast<nb::bytes>(states[i]);
+            datas.push_back(blob.c_str());
+            sizes.push_back(static_cast<int>(blob.size()));
+        }
+    }
+    if (raw_ptrs.empty()) return 0;
+
+    return mh_set_states(raw_ptrs.data(), static_cast<int>(raw_ptrs.size()),
+                         datas.data(), sizes.data());
+}
+
+
+// Shared inter-stage scratch region for chains driven from one audio
+// thread (wraps MH_ChainScratchArena). Chains attached via
+// PluginChain.set_scratch_arena borrow this region during each process
+// call instead of holding private scratch, so a session full of chains
+// pays the inter-stage footprint once instead of per chain. Safe only
+// because attached chains never process concurrently.
+class ChainScratchArena {
+public:
+    ChainScratchArena() : arena_(mh_chain_arena_create()) {
+        if (!arena_) {
+            throw std::runtime_error("Failed to create scratch arena");
+        }
+    }
+
+    ~ChainScratchArena() {
+        // Still-attached chains are reverted to private scratch by the
+        // C side, so destruction order vs. the chains doesn't matter.
+        if (arena_) mh_chain_arena_free(arena_);
+    }
+
+    ChainScratchArena(const ChainScratchArena&) = delete;
+    ChainScratchArena& operator=(const ChainScratchArena&) = delete;
+
+    size_t bytes() const { return mh_chain_arena_bytes(arena_); }
+
+    MH_ChainScratchArena* handle() const { return arena_; }
+
+private:
+    MH_ChainScratchArena* arena_ = nullptr;
 };
 
 
@@ -1259,6 +2932,37 @@ public:
         }
     }
 
+    // Silence-aware skip: silent-input plugins whose tail has elapsed
+    // zero-fill by flag instead of processing.
+    void set_silence_skip(bool enabled) {
+        if (!mh_chain_set_silence_skip(chain_, enabled ? 1 : 0)) {
+            throw std::runtime_error("Failed to set silence skip");
+        }
+    }
+
+    // Stage a gapless plugin replacement; the chain adopts it at the
+    // next process call's block boundary under a short crossfade.
+    void replace_plugin(int index, Plugin& p) {
+        if (!p.plugin_) {
+            throw std::runtime_error(
+                "Replacement plugin is invalid (null internal pointer "
+                "-- was it moved from?)");
+        }
+        char err[1024] = {0};
+        if (!mh_chain_replace_plugin(chain_, index, p.plugin_,
+                                     err, sizeof(err))) {
+            throw std::runtime_error(
+                std::string("replace_plugin failed: ") + err);
+        }
+        // Keep both instances referenced: the outgoing plugin renders
+        // until its crossfade completes.
+        plugin_refs_.push_back(&p);
+    }
+
+    bool replace_pending() const {
+        return mh_chain_replace_pending(chain_) != 0;
+    }
+
     // Get a plugin from the chain by index
     Plugin* get_plugin(int index) {
         if (index < 0 || index >= static_cast<int>(plugin_refs_.size())) {
@@ -1295,18 +2999,70 @@ public:
         return v;
     }
 
-    // Process audio (no MIDI)
-    void process(AudioArray input, AudioArray output) {
-        int in_channels = static_cast<int>(input.shape(0));
-        int out_channels = static_cast<int>(output.shape(0));
-        int in_frames = static_cast<int>(input.shape(1));
-        int out_frames = static_cast<int>(output.shape(1));
-
-        validate_process_shape(in_channels, out_channels, in_frames, out_frames,
-                               mh_chain_get_num_input_channels(chain_),
-                               mh_chain_get_num_output_channels(chain_),
-                               mh_chain_get_max_block_size(chain_));
-
+    // Per-plugin bypass (lock-free, same control word as the mix)
+    void set_bypass(int plugin_index, bool bypassed) {
+        if (plugin_index < 0 ||
+            plugin_index >= static_cast<int>(plugin_refs_.size())) {
+            throw std::runtime_error("Plugin index out of range");
+        }
+        if (!mh_chain_set_bypass(chain_, plugin_index, bypassed ? 1 : 0)) {
+            throw std::runtime_error(
+                "Plugin's input and output channel counts must match for "
+                "bypass to be enabled.");
+        }
+    }
+
+    bool get_bypass(int plugin_index) {
+        if (plugin_index < 0 ||
+            plugin_index >= static_cast<int>(plugin_refs_.size())) {
+            throw std::runtime_error("Plugin index out of range");
+        }
+        return mh_chain_get_bypass(chain_, plugin_index) != 0;
+    }
+
+    // Trace export: record one span per plugin call into a ring of
+    // `capacity_events` spans (0 disables) and dump as Chrome
+    // trace-event JSON. Enable/dump must not overlap processing.
+    void set_tracing(int capacity_events) {
+        if (!mh_chain_set_tracing(chain_, capacity_events)) {
+            throw std::runtime_error("set_tracing failed (bad capacity)");
+        }
+    }
+
+    void trace_dump(const std::string& path) {
+        char err[256] = {0};
+        if (!mh_chain_trace_dump(chain_, path.c_str(), err, sizeof(err))) {
+            throw std::runtime_error(std::string("trace_dump failed: ") + err);
+        }
+    }
+
+    // Borrow inter-stage scratch from a shared arena instead of the
+    // chain's private buffers. Attach while the chain (and every chain
+    // already on the arena) is idle.
+    void set_scratch_arena(ChainScratchArena& arena) {
+        if (!mh_chain_set_scratch_arena(chain_, arena.handle())) {
+            throw std::runtime_error("Failed to set scratch arena");
+        }
+    }
+
+    void clear_scratch_arena() {
+        if (!mh_chain_set_scratch_arena(chain_, nullptr)) {
+            throw std::runtime_error("Failed to clear scratch arena");
+        }
+    }
+
+    // Process audio (no MIDI)
+    void process(AudioArray input, AudioArray output) {
+        int in_channels = static_cast<int>(input.shape(0));
+        int out_channels = static_cast<int>(output.shape(0));
+        int in_frames = static_cast<int>(input.shape(1));
+        int out_frames = static_cast<int>(output.shape(1));
+
+        validate_process_shape(in_channels, out_channels, in_frames, out_frames,
+                               mh_chain_get_num_input_channels(chain_),
+                               mh_chain_get_num_output_channels(chain_),
+                               mh_chain_get_max_block_size(chain_));
+
         std::vector<const float*> in_ptrs(in_channels);
         std::vector<float*> out_ptrs(out_channels);
 
@@ -1322,6 +3078,55 @@ public:
         }
     }
 
+    // Zero-allocation fast path; see Plugin::process_into.
+    void process_into(const MhAudioBuffer& input, MhAudioBuffer& output) {
+        validate_process_shape(input.channels(), output.channels(),
+                               input.frames(), output.frames(),
+                               mh_chain_get_num_input_channels(chain_),
+                               mh_chain_get_num_output_channels(chain_),
+                               mh_chain_get_max_block_size(chain_));
+
+        int ok;
+        {
+            nb::gil_scoped_release release;
+            ok = mh_chain_process(chain_,
+                                  input.juce().getArrayOfReadPointers(),
+                                  output.juce().getArrayOfWritePointers(),
+                                  input.frames());
+        }
+        if (!ok) {
+            throw std::runtime_error("Chain process failed");
+        }
+    }
+
+    // Native tail hunt; see Plugin::detect_tail.
+    long long detect_tail(int block_size, double threshold_db, int hold_blocks,
+                          double max_seconds) {
+        long long max_frames =
+            static_cast<long long>(max_seconds * mh_chain_get_sample_rate(chain_));
+        return detect_tail_impl(block_size, threshold_db, hold_blocks, max_frames,
+                                mh_chain_get_num_input_channels(chain_),
+                                mh_chain_get_num_output_channels(chain_),
+                                mh_chain_get_max_block_size(chain_),
+                                [this](const float** in, float** out, int n) {
+                                    return mh_chain_process(chain_, in, out, n);
+                                },
+                                "Chain process failed");
+    }
+
+    // Batch render; see Plugin::process_blocks.
+    void process_blocks(AudioArray input, AudioArray output, int block_size,
+                        nb::object progress, int progress_interval) {
+        process_blocks_impl(input, output, block_size, progress, progress_interval,
+                            mh_chain_get_num_input_channels(chain_),
+                            mh_chain_get_num_output_channels(chain_),
+                            mh_chain_get_max_block_size(chain_),
+                            [this](const float** in, float** out, int n) {
+                                return mh_chain_process(chain_, in, out, n);
+                            },
+                            "Chain process failed");
+    }
+
     // Process with MIDI
     nb::list process_midi(AudioArray input, AudioArray output, nb::list midi_in,
                           int midi_out_capacity)
@@ -1376,6 +3181,73 @@ public:
         return result;
     }
 
+    // Timeline counterpart of process_midi (see Plugin::process_midi_timeline).
+    nb::list process_midi_timeline(AudioArray input, AudioArray output,
+                                   const MidiEventTimeline& timeline,
+                                   int start, int midi_out_capacity)
+    {
+        check_midi_capacity(midi_out_capacity);
+        int in_channels = static_cast<int>(input.shape(0));
+        int out_channels = static_cast<int>(output.shape(0));
+        int in_frames = static_cast<int>(input.shape(1));
+        int out_frames = static_cast<int>(output.shape(1));
+
+        validate_process_shape(in_channels, out_channels, in_frames, out_frames,
+                               mh_chain_get_num_input_channels(chain_),
+                               mh_chain_get_num_output_channels(chain_),
+                               mh_chain_get_max_block_size(chain_));
+
+        const auto& events = timeline.events();
+        std::vector<MH_MidiEvent> midi_events;
+        for (size_t i = timeline.lower_bound(start);
+             i < events.size() && events[i].sample_offset < start + in_frames;
+             ++i) {
+            MH_MidiEvent e = events[i];
+            e.sample_offset = juce::jlimit(0, in_frames - 1,
+                                           e.sample_offset - start);
+            midi_events.push_back(e);
+        }
+
+        std::vector<const float*> in_ptrs(in_channels);
+        std::vector<float*> out_ptrs(out_channels);
+
+        for (int ch = 0; ch < in_channels; ++ch) {
+            in_ptrs[ch] = input.data() + ch * in_frames;
+        }
+        for (int ch = 0; ch < out_channels; ++ch) {
+            out_ptrs[ch] = output.data() + ch * out_frames;
+        }
+
+        std::vector<MH_MidiEvent> midi_out(midi_out_capacity);
+        int num_midi_out = 0;
+
+        int ok;
+        {
+            // Released GIL, matching Plugin::process_midi_timeline.
+            nb::gil_scoped_release release;
+            ok = mh_chain_process_midi_io(chain_, in_ptrs.data(),
+                                          out_ptrs.data(), in_frames,
+                                          midi_events.data(),
+                                          static_cast<int>(midi_events.size()),
+                                          midi_out.data(), midi_out_capacity,
+                                          &num_midi_out);
+        }
+        if (!ok) {
+            throw std::runtime_error("Chain process failed");
+        }
+
+        nb::list result;
+        for (int i = 0; i < num_midi_out; ++i) {
+            result.append(nb::make_tuple(
+                midi_out[i].sample_offset,
+                midi_out[i].status,
+                midi_out[i].data1,
+                midi_out[i].data2
+            ));
+        }
+        return result;
+    }
+
     // Process with sample-accurate automation
     nb::list process_auto(AudioArray input, AudioArray output,
                           nb::list midi_in, nb::list param_changes,
@@ -1445,6 +3317,43 @@ public:
         return result;
     }
 
+    // Set a whole-render automation timeline for the chain. `changes`
+    // is a list of (sample_offset, plugin_index, param_index, value)
+    // tuples with ABSOLUTE sample offsets; the chain compiles sorted
+    // per-plugin lanes once and each process call consumes the slice
+    // it covers. An empty list clears the timeline.
+    void set_automation_timeline(nb::list changes) {
+        // The chain owns its copy, so a transient local is enough here.
+        std::vector<MH_ChainParamChange> buf;
+        buf.reserve(changes.size());
+        for (auto item : changes) {
+            auto t = nb::cast<nb::tuple>(item);
+            if (t.size() != 4)
+                throw std::runtime_error(
+                    "automation entry must be a 4-tuple "
+                    "(sample_offset, plugin_index, param_index, value)");
+            MH_ChainParamChange c{};
+            c.sample_offset = nb::cast<int>  (t[0]);
+            c.plugin_index  = nb::cast<int>  (t[1]);
+            c.param_index   = nb::cast<int>  (t[2]);
+            c.value         = nb::cast<float>(t[3]);
+            buf.push_back(c);
+        }
+        if (!mh_chain_set_automation_timeline(
+                chain_,
+                buf.empty() ? nullptr : buf.data(),
+                (int) buf.size()))
+            throw std::runtime_error(
+                "set_automation_timeline failed "
+                "(plugin_index out of range)");
+    }
+
+    void seek_automation(long long frame) {
+        if (!mh_chain_seek_automation(chain_, frame))
+            throw std::runtime_error(
+                "seek_automation failed (negative frame)");
+    }
+
 private:
     MH_PluginChain* chain_ = nullptr;
     std::vector<Plugin*> plugin_refs_;  // Keep references to prevent plugins from being GC'd
@@ -1668,6 +3577,17 @@ public:
         return id;
     }
 
+    int add_plugin_oversampled(Plugin& p, int factor) {
+        char err[256] = {0};
+        int id = mh_graph_add_plugin_oversampled(graph_, p.plugin_, factor,
+                                                    err, sizeof(err));
+        if (id < 0)
+            throw std::runtime_error(
+                std::string("add_plugin_oversampled failed: ") + err);
+        plugin_refs_.push_back(&p);
+        return id;
+    }
+
     int add_input(int channels) {
         char err[256] = {0};
         int id = mh_graph_add_input(graph_, channels,
@@ -1719,6 +3639,78 @@ public:
         return id;
     }
 
+    int add_remap(int in_channels, const std::vector<int>& channel_map) {
+        char err[256] = {0};
+        if (channel_map.empty())
+            throw std::runtime_error(
+                "add_remap failed: channel_map must not be empty");
+        int id = mh_graph_add_remap(graph_, in_channels,
+                                       channel_map.data(),
+                                       (int)channel_map.size(),
+                                       err, sizeof(err));
+        if (id < 0)
+            throw std::runtime_error(
+                std::string("add_remap failed: ") + err);
+        return id;
+    }
+
+    int add_resample(int channels, double source_rate) {
+        char err[256] = {0};
+        int id = mh_graph_add_resample(graph_, channels, source_rate,
+                                          err, sizeof(err));
+        if (id < 0)
+            throw std::runtime_error(
+                std::string("add_resample failed: ") + err);
+        return id;
+    }
+
+    // Streams source-rate frames into a resample node's FIFO. Takes
+    // a 2D float32 ndarray shaped (channels, nframes) at the node's
+    // source rate.
+    void resample_write(int node_id,
+                        nb::ndarray<const float, nb::shape<-1, -1>,
+                                    nb::c_contig, nb::device::cpu> frames) {
+        const int ch = static_cast<int>(frames.shape(0));
+        const int fr = static_cast<int>(frames.shape(1));
+        std::vector<const float*> ptrs((size_t) ch);
+        for (int c = 0; c < ch; ++c)
+            ptrs[(size_t) c] = frames.data() + (size_t) c * fr;
+        if (!mh_graph_resample_write(graph_, node_id, ptrs.data(), ch, fr))
+            throw std::runtime_error(
+                "resample_write failed (bad node id, wrong node kind, "
+                "channel-count mismatch, or FIFO full)");
+    }
+
+    // IR is a float32 (ir_channels, ir_frames) array; it is copied
+    // (and pre-transformed) inside the call, so the caller's array
+    // can be garbage-collected afterwards.
+    int add_convolve(int channels,
+                     nb::ndarray<const float, nb::shape<-1, -1>,
+                                 nb::c_contig, nb::device::cpu> ir) {
+        const int ir_ch = static_cast<int>(ir.shape(0));
+        const int ir_fr = static_cast<int>(ir.shape(1));
+        std::vector<const float*> ptrs((size_t) std::max(ir_ch, 1));
+        for (int c = 0; c < ir_ch; ++c)
+            ptrs[(size_t) c] = ir.data() + (size_t) c * ir_fr;
+        char err[256] = {0};
+        int id = mh_graph_add_convolve(graph_, channels, ptrs.data(),
+                                          ir_ch, ir_fr, err, sizeof(err));
+        if (id < 0)
+            throw std::runtime_error(
+                std::string("add_convolve failed: ") + err);
+        return id;
+    }
+
+    long long resample_frames_needed(int node_id, int nframes) {
+        long long n = mh_graph_resample_frames_needed(graph_, node_id,
+                                                         nframes);
+        if (n < 0)
+            throw std::runtime_error(
+                "resample_frames_needed failed (bad node id or wrong "
+                "node kind)");
+        return n;
+    }
+
     // Build params from a kwargs-style dict; missing fields use C
     // defaults so callers only set what they need for their op.
     static MH_MidiProcessorParams parse_processor_params(nb::dict p) {
@@ -1805,6 +3797,14 @@ public:
                 std::string("connect failed: ") + err);
     }
 
+    void connect_feedback(int src, int dst, int dst_port) {
+        char err[256] = {0};
+        if (!mh_graph_connect_feedback(graph_, src, 0, dst, dst_port,
+                                          err, sizeof(err)))
+            throw std::runtime_error(
+                std::string("connect_feedback failed: ") + err);
+    }
+
     void connect_midi(int src, int dst) {
         char err[256] = {0};
         if (!mh_graph_connect_midi(graph_, src, dst,
@@ -1813,6 +3813,25 @@ public:
                 std::string("connect_midi failed: ") + err);
     }
 
+    void connect_modulation(int src, int src_channel, int dst,
+                            int param_index, float base, float depth,
+                            int curve) {
+        char err[256] = {0};
+        if (!mh_graph_connect_modulation(graph_, src, src_channel,
+                                            dst, param_index, base,
+                                            depth, curve,
+                                            err, sizeof(err)))
+            throw std::runtime_error(
+                std::string("connect_modulation failed: ") + err);
+    }
+
+    void set_modulation_interval(int frames) {
+        if (!mh_graph_set_modulation_interval(graph_, frames))
+            throw std::runtime_error(
+                "set_modulation_interval failed (negative interval, "
+                "or graph already compiled)");
+    }
+
     void set_midi_input_events(int node_id, nb::list events) {
         auto& buf = midi_in_scratch_[node_id];
         buf.clear();
@@ -1848,6 +3867,20 @@ public:
         return out;
     }
 
+    // Zero-copy drain (mh_graph_borrow_midi_output_events): pointer +
+    // count into the graph's internal event storage. The binding wraps
+    // the result in an ndarray whose owner keeps this PluginGraph
+    // alive; validity (until the next render_block) is on the caller.
+    std::pair<const MH_MidiEvent*, int> borrow_midi_output_events(int node_id) {
+        const MH_MidiEvent* events = nullptr;
+        int count = 0;
+        if (!mh_graph_borrow_midi_output_events(graph_, node_id,
+                                                   &events, &count))
+            throw std::runtime_error(
+                "borrow_midi_output_events failed (bad node id or kind)");
+        return {events, count};
+    }
+
     void set_mix_gain(int mix_node, int input_index, float gain) {
         if (!mh_graph_set_mix_gain(graph_, mix_node, input_index, gain))
             throw std::runtime_error(
@@ -1861,6 +3894,13 @@ public:
                 std::string("compile failed: ") + err);
     }
 
+    void begin_edit() {
+        char err[256] = {0};
+        if (!mh_graph_begin_edit(graph_, err, sizeof(err)))
+            throw std::runtime_error(
+                std::string("begin_edit failed: ") + err);
+    }
+
     // Stage parameter automation for a plugin node. `changes` is a
     // list of (sample_offset, param_index, value) tuples; cleared
     // after the next render_block call.
@@ -1889,6 +3929,110 @@ public:
                 "set_node_automation failed (bad node id)");
     }
 
+    // Stage a whole-render automation timeline for a plugin node.
+    // `changes` is a list of (sample_offset, param_index, value)
+    // tuples with ABSOLUTE sample offsets; the graph copies and sorts
+    // them, and each render_block consumes its slice. An empty list
+    // clears the node's timeline.
+    void set_node_automation_timeline(int node_id, nb::list changes) {
+        // The graph owns its copy, so a transient local is enough here
+        // (unlike set_node_automation's borrowed-pointer scratch).
+        std::vector<MH_ParamChange> buf;
+        buf.reserve(changes.size());
+        for (auto item : changes) {
+            auto t = nb::cast<nb::tuple>(item);
+            if (t.size() != 3)
+                throw std::runtime_error(
+                    "automation entry must be a 3-tuple "
+                    "(sample_offset, param_index, value)");
+            MH_ParamChange c{};
+            c.sample_offset = nb::cast<int>  (t[0]);
+            c.param_index   = nb::cast<int>  (t[1]);
+            c.value         = nb::cast<float>(t[2]);
+            buf.push_back(c);
+        }
+        if (!mh_graph_set_node_automation_timeline(
+                graph_, node_id,
+                buf.empty() ? nullptr : buf.data(),
+                (int) buf.size()))
+            throw std::runtime_error(
+                "set_node_automation_timeline failed "
+                "(bad node id or graph not compiled)");
+    }
+
+    // Stage native keyframe automation curves for a plugin node.
+    // `keyframes` is a list of (sample_offset, param_index, value)
+    // tuples with ABSOLUTE offsets, in any order; the graph copies
+    // them and evaluates each parameter's curve once per block
+    // (linear between keyframes, clamped outside the span). An empty
+    // list clears the node's curves.
+    void set_node_automation_curves(int node_id, nb::list keyframes) {
+        std::vector<MH_ParamChange> buf;
+        buf.reserve(keyframes.size());
+        for (auto item : keyframes) {
+            auto t = nb::cast<nb::tuple>(item);
+            if (t.size() != 3)
+                throw std::runtime_error(
+                    "keyframe must be a 3-tuple "
+                    "(sample_offset, param_index, value)");
+            MH_ParamChange c{};
+            c.sample_offset = nb::cast<int>  (t[0]);
+            c.param_index   = nb::cast<int>  (t[1]);
+            c.value         = nb::cast<float>(t[2]);
+            buf.push_back(c);
+        }
+        if (!mh_graph_set_node_automation_curves(
+                graph_, node_id,
+                buf.empty() ? nullptr : buf.data(),
+                (int) buf.size()))
+            throw std::runtime_error(
+                "set_node_automation_curves failed "
+                "(bad node id or graph not compiled)");
+    }
+
+    void seek_automation(long long frame) {
+        if (!mh_graph_seek_automation(graph_, frame))
+            throw std::runtime_error(
+                "seek_automation failed "
+                "(negative frame or graph not compiled)");
+    }
+
+    void seek_automation_state(long long frame) {
+        if (!mh_graph_seek_automation_state(graph_, frame))
+            throw std::runtime_error(
+                "seek_automation_state failed "
+                "(negative frame or graph not compiled)");
+    }
+
+    // Graph-level transport: one seqlock write fans out to every plugin
+    // node's playhead, and render_block advances the position itself
+    // while playing -- no per-block fan-out from Python.
+    void set_transport(double bpm, int time_sig_num, int time_sig_denom,
+                       long long position_samples, double position_beats,
+                       bool is_playing, bool is_recording = false,
+                       bool is_looping = false,
+                       long long loop_start = 0, long long loop_end = 0)
+    {
+        MH_TransportInfo transport;
+        transport.bpm = bpm;
+        transport.time_sig_numerator = time_sig_num;
+        transport.time_sig_denominator = time_sig_denom;
+        transport.position_samples = position_samples;
+        transport.position_beats = position_beats;
+        transport.is_playing = is_playing ? 1 : 0;
+        transport.is_recording = is_recording ? 1 : 0;
+        transport.is_looping = is_looping ? 1 : 0;
+        transport.loop_start_samples = loop_start;
+        transport.loop_end_samples = loop_end;
+        if (!mh_graph_set_transport(graph_, &transport))
+            throw std::runtime_error("set_transport failed");
+    }
+
+    void clear_transport() {
+        if (!mh_graph_set_transport(graph_, nullptr))
+            throw std::runtime_error("clear_transport failed");
+    }
+
     // Takes a list of 2D float32 ndarrays (one per input node, one
     // per output node), shape (channels, nframes). All output arrays
     // and all input arrays must share the same nframes value, and
@@ -1945,18 +4089,370 @@ public:
             throw std::runtime_error("render_block failed");
     }
 
+    // Zero-allocation fast path for block loops; see Plugin::process_into.
+    // AudioBuffer nodes carry their own channel pointer arrays, so only
+    // the top-level tables are needed, and those live in member scratch
+    // vectors that allocate on the first call and are reused after
+    // (assign = amortized alloc). The GIL is released while rendering.
+    void render_block_into(nb::list inputs, nb::list outputs, int nframes) {
+        const int num_in  = mh_graph_num_input_nodes(graph_);
+        const int num_out = mh_graph_num_output_nodes(graph_);
+        if ((int) inputs.size() != num_in)
+            throw std::runtime_error(
+                "inputs list length does not match num_input_nodes");
+        if ((int) outputs.size() != num_out)
+            throw std::runtime_error(
+                "outputs list length does not match num_output_nodes");
+
+        in_top_scratch_.resize((size_t) num_in);
+        out_top_scratch_.resize((size_t) num_out);
+
+        for (int i = 0; i < num_in; ++i) {
+            auto& buf = nb::cast<MhAudioBuffer&>(inputs[i]);
+            if (buf.frames() < nframes)
+                throw std::runtime_error(
+                    "input buffer has fewer frames than nframes");
+            in_top_scratch_[(size_t) i] = buf.juce().getArrayOfReadPointers();
+        }
+        for (int i = 0; i < num_out; ++i) {
+            auto& buf = nb::cast<MhAudioBuffer&>(outputs[i]);
+            if (buf.frames() < nframes)
+                throw std::runtime_error(
+                    "output buffer has fewer frames than nframes");
+            out_top_scratch_[(size_t) i] = buf.juce().getArrayOfWritePointers();
+        }
+
+        int ok;
+        {
+            nb::gil_scoped_release release;
+            ok = mh_graph_render_block(graph_,
+                                       in_top_scratch_.data(),  num_in,
+                                       out_top_scratch_.data(), num_out,
+                                       nframes);
+        }
+        if (!ok)
+            throw std::runtime_error("render_block failed");
+    }
+
     int num_nodes()        const { return mh_graph_num_nodes(graph_); }
+    int latency_samples()  const { return mh_graph_get_latency_samples(graph_); }
     int num_input_nodes()  const { return mh_graph_num_input_nodes(graph_); }
     int num_output_nodes() const { return mh_graph_num_output_nodes(graph_); }
     bool is_compiled()     const { return mh_graph_is_compiled(graph_) != 0; }
 
-private:
-    MH_PluginGraph* graph_ = nullptr;
-    std::vector<Plugin*> plugin_refs_;
-    // Per-node automation scratch buffers that outlive Python call
-    // boundaries (the graph borrows pointers during render_block).
-    std::unordered_map<int, std::vector<MH_ParamChange>> autos_scratch_;
-    std::unordered_map<int, std::vector<MH_MidiEvent>>   midi_in_scratch_;
+    // Per-node render profiling (lock-free; safe to poll while another
+    // thread is inside render_block).
+    void set_profiling(bool enabled) {
+        mh_graph_set_profiling(graph_, enabled ? 1 : 0);
+    }
+
+    bool get_profiling() const {
+        return mh_graph_get_profiling(graph_) != 0;
+    }
+
+    nb::dict node_stats(int node_id) const {
+        MH_NodeStats s{};
+        if (!mh_graph_get_node_stats(graph_, node_id, &s))
+            throw std::runtime_error(
+                "node_stats failed (bad node id or graph not compiled)");
+        nb::dict d;
+        d["blocks"]  = s.blocks;
+        d["xruns"]   = s.xruns;
+        d["last_us"] = s.last_us;
+        d["mean_us"] = s.mean_us;
+        d["p99_us"]  = s.p99_us;
+        d["max_us"]  = s.max_us;
+        d["denormal_hits"] = s.denormal_hits;
+        return d;
+    }
+
+    void reset_node_stats() {
+        if (!mh_graph_reset_node_stats(graph_))
+            throw std::runtime_error(
+                "reset_node_stats failed (graph not compiled)");
+    }
+
+    // Trace export: record one span per node render into a ring of
+    // `capacity_events` spans (0 disables) and dump as Chrome
+    // trace-event JSON. Enable/dump must not overlap render_block.
+    void set_tracing(int capacity_events) {
+        if (!mh_graph_set_tracing(graph_, capacity_events))
+            throw std::runtime_error(
+                "set_tracing failed (graph not compiled or bad capacity)");
+    }
+
+    void trace_dump(const std::string& path) const {
+        char err[256] = {0};
+        if (!mh_graph_trace_dump(graph_, path.c_str(), err, sizeof(err)))
+            throw std::runtime_error(std::string("trace_dump failed: ") + err);
+    }
+
+    // Watchdog supervision: offline-only timeout isolation for hung
+    // plugins. A tripped node is failed sticky and renders silence.
+    void set_watchdog(int timeout_ms) {
+        if (!mh_graph_set_watchdog(graph_, timeout_ms))
+            throw std::runtime_error(
+                "set_watchdog failed (negative timeout)");
+    }
+
+    long long watchdog_trips() const {
+        return mh_graph_get_watchdog_trips(graph_);
+    }
+
+    bool node_failed(int node_id) const {
+        int r = mh_graph_get_node_failed(graph_, node_id);
+        if (r < 0)
+            throw std::runtime_error(
+                "node_failed failed (bad node id or graph not compiled)");
+        return r != 0;
+    }
+
+    void clear_node_failed(int node_id) {
+        if (!mh_graph_clear_node_failed(graph_, node_id))
+            throw std::runtime_error(
+                "clear_node_failed failed (bad node id or graph not "
+                "compiled)");
+    }
+
+    // Render verification hashing: fold rendered output into running
+    // 64-bit digests so a determinism check compares integers instead
+    // of diffing full output files.
+    void set_hashing(int mode) {
+        if (!mh_graph_set_hashing(graph_, mode))
+            throw std::runtime_error(
+                "set_hashing failed (mode must be 0, 1, or 2)");
+    }
+
+    int hashing() const {
+        return mh_graph_get_hashing(graph_);
+    }
+
+    unsigned long long render_digest() const {
+        return mh_graph_get_render_digest(graph_);
+    }
+
+    unsigned long long node_digest(int node_id) const {
+        unsigned long long d = 0;
+        if (!mh_graph_get_node_digest(graph_, node_id, &d))
+            throw std::runtime_error(
+                "node_digest failed (bad node id or graph not compiled)");
+        return d;
+    }
+
+    // Silence-aware skip: silent-input plugin nodes whose tail has
+    // elapsed zero-fill by flag instead of processing.
+    void set_silence_skip(bool enabled) {
+        if (!mh_graph_set_silence_skip(graph_, enabled ? 1 : 0))
+            throw std::runtime_error("Failed to set silence skip");
+    }
+
+    // Per-node bypass: pass the dry input through without calling the
+    // plugin, latency-matched to the node's compiled delay.
+    void set_node_bypass(int node_id, bool bypassed) {
+        if (!mh_graph_set_node_bypass(graph_, node_id, bypassed ? 1 : 0))
+            throw std::runtime_error(
+                "set_node_bypass failed (bad node id, not a plugin "
+                "node, or graph not compiled)");
+    }
+
+    bool get_node_bypass(int node_id) const {
+        return mh_graph_get_node_bypass(graph_, node_id) != 0;
+    }
+
+    // Per-node wet/dry mix: blend the node's output against its dry
+    // input after processing, replacing a two-branch bus for the
+    // common "30% reverb" case.
+    void set_node_mix(int node_id, float mix) {
+        if (mix < 0.0f || mix > 1.0f)
+            throw std::invalid_argument("mix must be in [0.0, 1.0]");
+        if (!mh_graph_set_node_mix(graph_, node_id, mix))
+            throw std::runtime_error(
+                "set_node_mix failed (bad node id, not a plugin node "
+                "with matching in/out channels, or graph not compiled)");
+    }
+
+    float get_node_mix(int node_id) const {
+        return mh_graph_get_node_mix(graph_, node_id);
+    }
+
+    int get_node_sidechain_port(int node_id) const {
+        return mh_graph_get_node_sidechain_port(graph_, node_id);
+    }
+
+    // Adaptive overload governor: sheds sacrificial nodes (via the
+    // ordinary bypass flags) under sustained overload and restores them
+    // on recovery. Exposed without the native event callback -- it fires
+    // on the render thread, where Python must never run; poll
+    // governor_shed_count (and get_node_bypass) instead.
+    void set_node_sacrificial(int node_id, int shed_order) {
+        if (!mh_graph_set_node_sacrificial(graph_, node_id, shed_order))
+            throw std::runtime_error(
+                "set_node_sacrificial failed (bad node id or shed order, "
+                "not a plugin node, or graph not compiled)");
+    }
+
+    int get_node_sacrificial(int node_id) const {
+        return mh_graph_get_node_sacrificial(graph_, node_id);
+    }
+
+    void set_governor(double engage_load, double release_load,
+                      int engage_blocks, int release_blocks) {
+        MH_GovernorConfig cfg;
+        cfg.engage_load    = engage_load;
+        cfg.release_load   = release_load;
+        cfg.engage_blocks  = engage_blocks;
+        cfg.release_blocks = release_blocks;
+        if (!mh_graph_set_governor(graph_, &cfg, nullptr, nullptr))
+            throw std::runtime_error(
+                "set_governor failed (graph not compiled, or "
+                "release_load >= engage_load / non-positive block counts)");
+    }
+
+    void clear_governor() {
+        if (!mh_graph_clear_governor(graph_))
+            throw std::runtime_error(
+                "clear_governor failed (graph not compiled)");
+    }
+
+    int governor_shed_count() const {
+        return mh_graph_governor_shed_count(graph_);
+    }
+
+    // Per-node meter taps: peak/RMS of the last rendered block,
+    // published through a seqlock so polling never blocks the render.
+    void set_node_meter(int node_id, bool enabled) {
+        if (!mh_graph_set_node_meter(graph_, node_id, enabled ? 1 : 0))
+            throw std::runtime_error(
+                "set_node_meter failed (bad node id or graph not compiled)");
+    }
+
+    nb::object node_meter(int node_id) const {
+        float peaks[32];
+        float rms[32];
+        const int n = mh_graph_get_node_meter(graph_, node_id,
+                                              peaks, rms, 32);
+        if (n <= 0)
+            throw std::runtime_error(
+                "node_meter failed (bad node id, meter not enabled, "
+                "or graph not compiled)");
+        nb::list peak_list, rms_list;
+        for (int c = 0; c < n; ++c) {
+            peak_list.append(peaks[c]);
+            rms_list.append(rms[c]);
+        }
+        return nb::make_tuple(peak_list, rms_list);
+    }
+
+    // Analysis taps: pre-compile marking plus a post-render zero-copy
+    // borrow of the node's pool buffer. The ndarray wrapping happens in
+    // the .def lambda (it needs the Python handle as the view's owner).
+    void set_node_tap(int node_id, bool enabled) {
+        if (!mh_graph_set_node_tap(graph_, node_id, enabled ? 1 : 0))
+            throw std::runtime_error(
+                "set_node_tap failed (bad node id, node carries no "
+                "audio, or graph already compiled)");
+    }
+
+    struct NodeAudioView {
+        const float* const* channels;
+        int num_channels;
+        int num_frames;
+    };
+
+    NodeAudioView borrow_node_audio(int node_id) {
+        NodeAudioView v{};
+        if (!mh_graph_borrow_node_audio(graph_, node_id, &v.channels,
+                                           &v.num_channels, &v.num_frames))
+            throw std::runtime_error(
+                "borrow_node_audio failed (bad node id, node not "
+                "tapped, or graph not compiled)");
+        return v;
+    }
+
+    // Huge-page backing for the buffer-pool arena (best-effort, Linux).
+    void set_pool_huge_pages(bool enabled) {
+        if (!mh_graph_set_pool_huge_pages(graph_, enabled ? 1 : 0))
+            throw std::runtime_error(
+                "set_pool_huge_pages failed (graph already compiled)");
+    }
+
+    // Arena residency (mlock at compile, best-effort).
+    void set_lock_memory(bool enabled) {
+        if (!mh_graph_set_lock_memory(graph_, enabled ? 1 : 0))
+            throw std::runtime_error(
+                "set_lock_memory failed (graph already compiled)");
+    }
+
+    long long get_locked_bytes() const {
+        return mh_graph_get_locked_bytes(graph_);
+    }
+
+    // Compiled-schedule snapshot (see mh_graph_export_plan /
+    // mh_graph_set_plan): export after compile, stage before a later
+    // compile of the same shape to skip validation + sorting.
+    nb::bytes export_plan() const {
+        void* data = nullptr;
+        int size = 0;
+        if (!mh_graph_export_plan(graph_, &data, &size)) {
+            throw std::runtime_error(
+                "export_plan failed (graph not compiled)");
+        }
+        nb::bytes out(data, static_cast<size_t>(size));
+        mh_graph_plan_free(data);
+        return out;
+    }
+
+    void set_plan(nb::bytes plan) {
+        if (!mh_graph_set_plan(graph_, plan.c_str(),
+                               static_cast<int>(plan.size()))) {
+            throw std::runtime_error(
+                "set_plan failed (graph already compiled or bad blob)");
+        }
+    }
+
+    // Frozen-subtree render cache: record a node's output once, then
+    // replay it so re-renders skip its upstream subtree.
+    void freeze_node(int node_id) {
+        char err[256] = {0};
+        if (!mh_graph_freeze_node(graph_, node_id, err, sizeof(err)))
+            throw std::runtime_error(std::string("freeze_node failed: ") + err);
+    }
+
+    void freeze_finish(int node_id) {
+        char err[256] = {0};
+        if (!mh_graph_freeze_finish(graph_, node_id, err, sizeof(err)))
+            throw std::runtime_error(std::string("freeze_finish failed: ") + err);
+    }
+
+    void unfreeze_node(int node_id) {
+        char err[256] = {0};
+        if (!mh_graph_unfreeze_node(graph_, node_id, err, sizeof(err)))
+            throw std::runtime_error(std::string("unfreeze_node failed: ") + err);
+    }
+
+    void freeze_rewind() {
+        if (!mh_graph_freeze_rewind(graph_))
+            throw std::runtime_error("freeze_rewind failed");
+    }
+
+    bool freeze_is_stale(int node_id) const {
+        int r = mh_graph_freeze_is_stale(graph_, node_id);
+        if (r < 0)
+            throw std::runtime_error(
+                "freeze_is_stale: node is not replaying a freeze cache");
+        return r != 0;
+    }
+
+private:
+    MH_PluginGraph* graph_ = nullptr;
+    std::vector<Plugin*> plugin_refs_;
+    // Per-node automation scratch buffers that outlive Python call
+    // boundaries (the graph borrows pointers during render_block).
+    std::unordered_map<int, std::vector<MH_ParamChange>> autos_scratch_;
+    std::unordered_map<int, std::vector<MH_MidiEvent>>   midi_in_scratch_;
+    // Top-level pointer tables for render_block_into (amortized alloc).
+    std::vector<const float* const*> in_top_scratch_;
+    std::vector<float* const*>       out_top_scratch_;
 };
 
 
@@ -1991,6 +4487,51 @@ public:
     Session& enter() { return *this; }
     void exit(nb::object, nb::object, nb::object) { close(); }
 
+    // Clone `plugin` into a warm standby instance (same bundle via the
+    // module cache, active state pre-applied). Member rather than a
+    // binding lambda so it can reach the raw MH_Plugin* handles.
+    Plugin* standby(Plugin& plugin) {
+        char err[1024] = {0};
+        MH_Plugin* raw = mh_session_standby(session_, plugin.plugin_,
+                                            err, sizeof(err));
+        if (!raw) {
+            throw std::runtime_error(
+                std::string("Session.standby failed: ") + err);
+        }
+        return new Plugin(Plugin::AdoptTag{}, raw);
+    }
+
+    // Pooled open: served from the session's instance pool when a
+    // parked instance matches the key, opened fresh otherwise. Member
+    // so it can adopt the raw handle (see standby above).
+    Plugin* acquire(const std::string& path, double sample_rate,
+                    int max_block_size, int in_channels, int out_channels,
+                    int sidechain_channels) {
+        char err[1024] = {0};
+        MH_Plugin* raw = mh_session_acquire(session_, path.c_str(),
+                                            sample_rate, max_block_size,
+                                            in_channels, out_channels,
+                                            sidechain_channels,
+                                            err, sizeof(err));
+        if (!raw) {
+            throw std::runtime_error(
+                std::string("Session.acquire failed: ") + err);
+        }
+        return new Plugin(Plugin::AdoptTag{}, raw);
+    }
+
+    // Park `plugin` back in the pool (or close it when pooling is
+    // disabled / full). The Python wrapper relinquishes the handle
+    // either way; using it afterwards raises like a closed plugin.
+    void release(Plugin& plugin) {
+        if (!plugin.plugin_) {
+            throw std::runtime_error(
+                "Session.release failed: plugin is already closed");
+        }
+        mh_session_release(session_, plugin.plugin_);
+        plugin.plugin_ = nullptr;
+    }
+
     MH_Session* raw() const { return session_; }
 
 private:
@@ -2082,7 +4623,21 @@ public:
         return *this;
     }
 
-    void start() {
+    void start(int warmup_blocks = 8) {
+        // Take the plugins' one-time first-process costs before the
+        // device starts pulling, so the first callback runs at
+        // steady-state speed instead of glitching.
+        if (warmup_blocks > 0) {
+            if (plugin_ref_) {
+                mh_warmup(plugin_ref_->plugin_, warmup_blocks);
+            } else if (chain_ref_) {
+                int n = mh_chain_get_num_plugins(chain_ref_->chain_);
+                for (int i = 0; i < n; ++i) {
+                    mh_warmup(mh_chain_get_plugin(chain_ref_->chain_, i),
+                              warmup_blocks);
+                }
+            }
+        }
         if (!mh_audio_start(device_)) {
             throw std::runtime_error("Failed to start audio");
         }
@@ -2110,6 +4665,39 @@ public:
         return mh_audio_get_channels(device_);
     }
 
+    // Callback health instrumentation (lock-free; safe to poll while
+    // the audio thread runs).
+    double get_load() const {
+        return mh_audio_get_load(device_);
+    }
+
+    long long get_xrun_count() const {
+        return mh_audio_get_xrun_count(device_);
+    }
+
+    // Async recording of the processed output to disk
+    void record_start(const char* path, int bit_depth) {
+        char err[256] = {0};
+        if (!mh_audio_record_start(device_, path, bit_depth, err, sizeof(err))) {
+            throw std::runtime_error(err);
+        }
+    }
+
+    void record_stop() {
+        char err[256] = {0};
+        if (!mh_audio_record_stop(device_, err, sizeof(err))) {
+            throw std::runtime_error(err);
+        }
+    }
+
+    bool is_recording() const {
+        return mh_audio_is_recording(device_) != 0;
+    }
+
+    long long record_dropped_frames() const {
+        return mh_audio_record_dropped_frames(device_);
+    }
+
     // MIDI connection
     void connect_midi_input(int port_index) {
         if (!mh_audio_connect_midi_input(device_, port_index)) {
@@ -2170,6 +4758,50 @@ public:
         }
     }
 
+    // Native CC-to-parameter map. Each mapping is a 5-tuple of
+    // (channel, cc, plugin_index, param_index, lut) where lut is a
+    // sequence of exactly 128 floats (the precomputed curve). The C
+    // layer copies the table, so the Python objects need not persist.
+    void set_cc_map(nb::list mappings) {
+        std::vector<MH_CCMapping> table;
+        table.reserve(nb::len(mappings));
+        for (size_t i = 0; i < nb::len(mappings); ++i) {
+            nb::tuple t = nb::cast<nb::tuple>(mappings[i]);
+            if (nb::len(t) != 5) {
+                throw std::runtime_error(
+                    "CC mapping must be a tuple of 5 elements: "
+                    "(channel, cc, plugin_index, param_index, lut)");
+            }
+            MH_CCMapping m;
+            m.channel = nb::cast<int>(t[0]);
+            m.cc = nb::cast<int>(t[1]);
+            m.plugin_index = nb::cast<int>(t[2]);
+            m.param_index = nb::cast<int>(t[3]);
+            auto lut = nb::cast<std::vector<float>>(t[4]);
+            if (lut.size() != 128) {
+                throw std::runtime_error(
+                    "CC mapping LUT must have exactly 128 entries, got " +
+                    std::to_string(lut.size()));
+            }
+            // MH_ParamChange values are normalized 0..1; clamp here so a
+            // value_range wider than the normalized range (e.g. (-1, 1))
+            // behaves the same as the Python set_param path.
+            for (int v = 0; v < 128; ++v) {
+                m.lut[v] = std::min(1.0f, std::max(0.0f, lut[v]));
+            }
+            table.push_back(m);
+        }
+        if (!mh_audio_set_cc_map(device_,
+                                 table.empty() ? nullptr : table.data(),
+                                 static_cast<int>(table.size()))) {
+            throw std::runtime_error("Failed to install CC map");
+        }
+    }
+
+    void clear_cc_map() {
+        mh_audio_set_cc_map(device_, nullptr, 0);
+    }
+
     // Audio input via lock-free ring buffer (no GIL on audio thread)
     void enable_input(int capacity_frames = 0) {
         if (capacity_frames <= 0) {
@@ -2189,25 +4821,111 @@ public:
     int write_input(AudioArray data) {
         int channels = static_cast<int>(data.shape(0));
         int frames = static_cast<int>(data.shape(1));
-        int dev_channels = mh_audio_get_channels(device_);
 
-        // Interleave: numpy is [channels, frames] row-major, ring buffer wants interleaved
-        std::vector<float> interleaved(frames * dev_channels, 0.0f);
+        // Planar push: numpy's [channels, frames] row-major layout is
+        // already one contiguous run per channel, and the ring buffer
+        // interleaves straight into its own storage -- no staging copy.
+        std::vector<const float*> ptrs(channels);
         const float* src = data.data();
-        int copy_ch = std::min(channels, dev_channels);
-        for (int f = 0; f < frames; f++) {
-            for (int c = 0; c < copy_ch; c++) {
-                interleaved[f * dev_channels + c] = src[c * frames + f];
-            }
+        for (int c = 0; c < channels; c++) {
+            ptrs[c] = src + static_cast<size_t>(c) * frames;
         }
-
-        return mh_audio_write_input(device_, interleaved.data(), frames);
+        return mh_audio_write_input_planar(device_, ptrs.data(), channels, frames);
     }
 
     int input_available() const {
         return mh_audio_input_available(device_);
     }
 
+    void set_input_drift_comp(bool enabled) {
+        if (!mh_audio_set_input_drift_comp(device_, enabled ? 1 : 0)) {
+            throw std::runtime_error(
+                "Failed to configure input drift compensation "
+                "(is the input ring buffer enabled?)");
+        }
+    }
+
+    nb::dict input_drift_stats() const {
+        MH_InputDriftStats stats;
+        if (!mh_audio_input_drift_stats(device_, &stats)) {
+            throw std::runtime_error("Input drift compensation is not enabled");
+        }
+        nb::dict d;
+        d["ratio"] = stats.ratio;
+        d["fill_avg"] = stats.fill_avg;
+        d["fill_target"] = stats.fill_target;
+        d["underruns"] = stats.underruns;
+        return d;
+    }
+
+    // Preloaded loop-audio source: the audio callback reads the copied
+    // buffer directly with wraparound, so looped playback needs no
+    // feeding thread (and no Python in the real-time path).
+    void set_loop_source(AudioArray data) {
+        int channels = static_cast<int>(data.shape(0));
+        int frames = static_cast<int>(data.shape(1));
+        if (channels < 1 || frames < 1) {
+            throw std::runtime_error("Loop source must have at least 1 channel and 1 frame");
+        }
+        std::vector<const float*> ptrs(channels);
+        for (int c = 0; c < channels; c++) {
+            ptrs[c] = data.data() + static_cast<size_t>(c) * frames;
+        }
+        if (!mh_audio_set_loop_source(device_, ptrs.data(), channels, frames)) {
+            throw std::runtime_error("Failed to install loop source");
+        }
+    }
+
+    void clear_loop_source() {
+        mh_audio_set_loop_source(device_, nullptr, 0, 0);
+    }
+
+    // Gapless playlist: preloaded items spliced back to back in the
+    // audio callback, so chaining songs never restarts the device.
+    void playlist_add_audio(AudioArray data) {
+        int channels = static_cast<int>(data.shape(0));
+        int frames = static_cast<int>(data.shape(1));
+        if (channels < 1 || frames < 1) {
+            throw std::runtime_error("Playlist item must have at least 1 channel and 1 frame");
+        }
+        std::vector<const float*> ptrs(channels);
+        for (int c = 0; c < channels; c++) {
+            ptrs[c] = data.data() + static_cast<size_t>(c) * frames;
+        }
+        if (!mh_audio_playlist_add_audio(device_, ptrs.data(), channels, frames)) {
+            throw std::runtime_error("Failed to append playlist item");
+        }
+    }
+
+    void playlist_add_midi(nb::list events, int duration_frames) {
+        std::vector<MH_MidiEvent> buf;
+        buf.reserve(nb::len(events));
+        for (auto item : events) buf.push_back(parse_midi_event(item));
+        if (!mh_audio_playlist_add_midi(device_,
+                                        buf.empty() ? nullptr : buf.data(),
+                                        (int) buf.size(), duration_frames)) {
+            throw std::runtime_error("Failed to append playlist item");
+        }
+    }
+
+    void playlist_set_crossfade(int frames) {
+        if (!mh_audio_playlist_set_crossfade(device_, frames)) {
+            throw std::runtime_error("Crossfade must be >= 0 frames");
+        }
+    }
+
+    void playlist_clear() {
+        mh_audio_playlist_clear(device_);
+    }
+
+    int playlist_index() const {
+        return mh_audio_playlist_get_index(device_);
+    }
+
+    int playlist_count() const {
+        return mh_audio_playlist_get_count(device_);
+    }
+
     // Context manager support
     AudioDevice& enter() {
         start();
@@ -2237,6 +4955,51 @@ nb::dict probe_plugin(const std::string& path) {
     return plugin_desc_to_dict(desc);
 }
 
+nb::list probe_batch_plugins(const std::vector<std::string>& paths, int concurrency) {
+    nb::list out;
+    if (paths.empty()) {
+        return out;
+    }
+
+    std::vector<const char*> ptrs;
+    ptrs.reserve(paths.size());
+    for (const auto& p : paths) {
+        ptrs.push_back(p.c_str());
+    }
+    std::vector<MH_ProbeResult> results(paths.size());
+
+    if (concurrency <= 0) {
+        concurrency = static_cast<int>(std::thread::hardware_concurrency());
+        if (concurrency <= 0) {
+            concurrency = 1;
+        }
+    }
+
+    int ok;
+    {
+        // Workers are plain C threads; release the GIL so a long vendor
+        // drop probes while Python keeps running.
+        nb::gil_scoped_release release;
+        ok = mh_probe_batch(ptrs.data(), static_cast<int>(ptrs.size()),
+                            results.data(), concurrency);
+    }
+    if (ok < 0) {
+        throw std::runtime_error("probe_batch failed: invalid arguments");
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].ok) {
+            out.append(plugin_desc_to_dict(results[i].desc));
+        } else {
+            nb::dict d;
+            d["path"] = paths[i];
+            d["error"] = std::string(results[i].error);
+            out.append(d);
+        }
+    }
+    return out;
+}
+
 // Callback context for scan_directory
 struct ScanContext {
     std::vector<nb::dict>* results;
@@ -2247,6 +5010,13 @@ static void scan_callback(const MH_PluginDesc* desc, void* user_data) {
     ctx->results->push_back(plugin_desc_to_dict(*desc));
 }
 
+// GIL-free collector for the parallel session scan: workers may invoke
+// the callback off the Python thread, so just copy the plain C struct
+// and convert to dicts afterwards under the GIL.
+static void scan_collect_callback(const MH_PluginDesc* desc, void* user_data) {
+    static_cast<std::vector<MH_PluginDesc>*>(user_data)->push_back(*desc);
+}
+
 // Module-level scan_directory function
 nb::list scan_directory(const std::string& directory_path) {
     std::vector<nb::dict> results;
@@ -2341,86 +5111,204 @@ class MidiFile {
 public:
     MidiFile() = default;
 
-    // Load from file
+    // Load from file (eager: every track is decoded up front)
     bool load(const std::string& path) {
+        drop_lazy_state();
         if (!file_.read(path)) {
             return false;
         }
         file_.doTimeAnalysis();
         file_.linkNotePairs();
+        tempo_dirty_ = true;
+        return true;
+    }
+
+    // Load lazily: read the raw bytes, parse only the MThd header and
+    // the MTrk chunk directory (4-byte tag + length per track), and
+    // decode a track's events on first get_events() access. For
+    // MIDI-heavy sessions that render two tracks out of sixty, open
+    // cost drops from decoding every event to one header scan.
+    // Whole-file operations (save, add_*, join/split, sample_events,
+    // ...) transparently promote to a full parse first, so lazy mode
+    // is an optimization, not a restricted mode.
+    //
+    // SMPTE-division files (rare) fall back to an eager load.
+    bool load_lazy(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        in.seekg(0, std::ios::end);
+        const std::streamoff size = in.tellg();
+        if (size < 14) return false;
+        in.seekg(0, std::ios::beg);
+        raw_.resize((size_t) size);
+        in.read(reinterpret_cast<char*>(raw_.data()), size);
+        if (!in) return false;
+
+        if (std::memcmp(raw_.data(), "MThd", 4) != 0) {
+            drop_lazy_state();
+            return false;
+        }
+        const uint32_t hlen = be32(4);
+        if (hlen < 6 || 8 + (size_t) hlen > raw_.size()) {
+            drop_lazy_state();
+            return false;
+        }
+        const int division = be16(12);
+        if (division & 0x8000) {
+            // SMPTE division: the tick scanner below assumes
+            // ticks-per-quarter timing. Decode eagerly instead.
+            drop_lazy_state();
+            return load(path);
+        }
+        lazy_tpq_ = division;
+
+        spans_.clear();
+        size_t pos = 8 + hlen;
+        while (pos + 8 <= raw_.size()) {
+            const uint32_t clen = be32(pos + 4);
+            if (pos + 8 + (size_t) clen > raw_.size()) break;
+            if (std::memcmp(raw_.data() + pos, "MTrk", 4) == 0)
+                spans_.push_back({pos + 8, (size_t) clen});
+            pos += 8 + (size_t) clen;  // alien chunks are skipped per spec
+        }
+        if (spans_.empty()) {
+            drop_lazy_state();
+            return false;
+        }
+        scans_.assign(spans_.size(), TrackScan{});
+        track_cache_.clear();
+        track_cache_.resize(spans_.size());
+        lazy_tempi_.clear();
+        lazy_ = true;
+        tempo_dirty_ = true;
         return true;
     }
 
     // Save to file
     bool save(const std::string& path) {
+        materialize_if_lazy();
         return file_.write(path);
     }
 
     // Get number of tracks
     int num_tracks() const {
-        return file_.getTrackCount();
+        return lazy_ ? (int) spans_.size() : file_.getTrackCount();
     }
 
     // Get ticks per quarter note
     int ticks_per_quarter() const {
-        return file_.getTicksPerQuarterNote();
+        return lazy_ ? lazy_tpq_ : file_.getTicksPerQuarterNote();
     }
 
     // Set ticks per quarter note
     void set_ticks_per_quarter(int tpq) {
+        materialize_if_lazy();
         file_.setTicksPerQuarterNote(tpq);
+        tempo_dirty_ = true;
     }
 
     // Get total duration in seconds
     double duration_seconds() {
+        if (lazy_) {
+            scan_all_tracks();
+            build_lazy_tempo_map();
+            int max_tick = 0;
+            for (const TrackScan& sc : scans_)
+                if (sc.end_tick > max_tick) max_tick = sc.end_tick;
+            return tick_to_seconds(max_tick, lazy_tpq_);
+        }
         file_.doTimeAnalysis();
         return file_.getFileDurationInSeconds();
     }
 
+    // Per-track stats without decoding event bodies. On a lazily
+    // loaded file this walks only the bytes needed to find event
+    // boundaries (delta VLQs, status bytes, meta/sysex lengths) --
+    // no event objects are built. Returns a dict with event_count,
+    // end_tick (absolute) and duration_seconds.
+    nb::dict track_stats(int track) {
+        if (track < 0 || track >= num_tracks())
+            throw std::out_of_range("track index out of range");
+        nb::dict d;
+        if (lazy_) {
+            // Duration needs the tempo map; tempo metas live in any
+            // track, so scan them all (still body-free and cached).
+            scan_all_tracks();
+            build_lazy_tempo_map();
+            const TrackScan& sc = scans_[(size_t) track];
+            d["event_count"] = sc.event_count;
+            d["end_tick"] = sc.end_tick;
+            d["duration_seconds"] = tick_to_seconds(sc.end_tick, lazy_tpq_);
+        } else {
+            file_.doTimeAnalysis();
+            const auto& track_events = file_[track];
+            const int n = track_events.getEventCount();
+            d["event_count"] = n;
+            d["end_tick"] = n > 0 ? track_events[n - 1].tick : 0;
+            d["duration_seconds"] =
+                n > 0 ? track_events[n - 1].seconds : 0.0;
+        }
+        return d;
+    }
+
     // Add a track
     int add_track() {
+        materialize_if_lazy();
         return file_.addTrack();
     }
 
     // Add a tempo event (BPM)
     void add_tempo(int track, int tick, double bpm) {
+        materialize_if_lazy();
         file_.addTempo(track, tick, bpm);
+        tempo_dirty_ = true;
     }
 
     // Add a note on event
     void add_note_on(int track, int tick, int channel, int pitch, int velocity) {
+        materialize_if_lazy();
         file_.addNoteOn(track, tick, channel, pitch, velocity);
     }
 
     // Add a note off event
     void add_note_off(int track, int tick, int channel, int pitch, int velocity = 0) {
+        materialize_if_lazy();
         file_.addNoteOff(track, tick, channel, pitch, velocity);
     }
 
     // Add a control change event
     void add_control_change(int track, int tick, int channel, int controller, int value) {
+        materialize_if_lazy();
         file_.addController(track, tick, channel, controller, value);
     }
 
     // Add a program change event
     void add_program_change(int track, int tick, int channel, int program) {
+        materialize_if_lazy();
         file_.addPatchChange(track, tick, channel, program);
     }
 
     // Add a pitch bend event
     void add_pitch_bend(int track, int tick, int channel, int value) {
+        materialize_if_lazy();
         file_.addPitchBend(track, tick, channel, value);
     }
 
-    // Get all events from a track as a list of dicts
-    nb::list get_events(int track) const {
-        nb::list events;
-
-        if (track < 0 || track >= file_.getTrackCount()) {
-            return events;
+    // Get all events from a track as a list of dicts. On a lazily
+    // loaded file only this track (plus track 0 for the tempo map) is
+    // decoded, and the decode is cached for repeat access.
+    nb::list get_events(int track) {
+        if (track < 0 || track >= num_tracks()) {
+            return nb::list();
         }
+        if (lazy_) return events_to_list(lazy_track(track));
+        return events_to_list(file_[track]);
+    }
 
-        const auto& track_events = file_[track];
+    // Event-list -> list-of-dicts conversion shared by the eager and
+    // lazy get_events paths.
+    static nb::list events_to_list(const smf::MidiEventList& track_events) {
+        nb::list events;
         for (int i = 0; i < track_events.getEventCount(); i++) {
             const auto& event = track_events[i];
 
@@ -2470,26 +5358,360 @@ public:
 
     // Convert to absolute ticks
     void make_absolute_ticks() {
+        materialize_if_lazy();
         file_.makeAbsoluteTicks();
+        tempo_dirty_ = true;
     }
 
     // Convert to delta ticks
     void make_delta_ticks() {
+        materialize_if_lazy();
         file_.makeDeltaTicks();
+        tempo_dirty_ = true;
     }
 
     // Join all tracks into track 0 (Type 0 format)
     void join_tracks() {
+        materialize_if_lazy();
         file_.joinTracks();
+        tempo_dirty_ = true;
     }
 
     // Split tracks (Type 1 format)
     void split_tracks() {
+        materialize_if_lazy();
         file_.splitTracks();
+        tempo_dirty_ = true;
+    }
+
+    // Flatten the file to a packed, time-sorted native event timeline at
+    // `sample_rate`. Tick -> seconds conversion goes through the cached
+    // tempo map (rebuilt only after a tempo-affecting mutation); meta
+    // events are dropped and only playable channel-voice messages are
+    // kept -- the same rules as render._collect_midi_events.
+    MidiEventTimeline* sample_events(double sample_rate) {
+        materialize_if_lazy();
+        rebuild_tempo_map_if_needed();
+        const int tpq = file_.getTicksPerQuarterNote();
+
+        struct RawEvent {
+            int tick;
+            unsigned char status, data1, data2;
+        };
+        std::vector<RawEvent> raw;
+        for (int track = 0; track < file_.getTrackCount(); ++track) {
+            const auto& track_events = file_[track];
+            for (int i = 0; i < track_events.getEventCount(); ++i) {
+                const auto& event = track_events[i];
+                RawEvent r;
+                r.tick = event.tick;
+                const int channel = event.isMeta() ? 0 : event.getChannel();
+                if (event.isNoteOn()) {
+                    r.status = static_cast<unsigned char>(0x90 | channel);
+                    r.data1 = static_cast<unsigned char>(event.getKeyNumber());
+                    r.data2 = static_cast<unsigned char>(event.getVelocity());
+                } else if (event.isNoteOff()) {
+                    r.status = static_cast<unsigned char>(0x80 | channel);
+                    r.data1 = static_cast<unsigned char>(event.getKeyNumber());
+                    r.data2 = static_cast<unsigned char>(event.getVelocity());
+                } else if (event.isController()) {
+                    r.status = static_cast<unsigned char>(0xB0 | channel);
+                    r.data1 = static_cast<unsigned char>(event.getP1());
+                    r.data2 = static_cast<unsigned char>(event.getP2());
+                } else if (event.isTimbre()) {
+                    r.status = static_cast<unsigned char>(0xC0 | channel);
+                    r.data1 = static_cast<unsigned char>(event.getP1());
+                    r.data2 = 0;
+                } else if (event.isPitchbend()) {
+                    r.status = static_cast<unsigned char>(0xE0 | channel);
+                    r.data1 = static_cast<unsigned char>(event.getP1());
+                    r.data2 = static_cast<unsigned char>(event.getP2());
+                } else {
+                    continue;
+                }
+                raw.push_back(r);
+            }
+        }
+        // Stable sort: same-tick events keep their track-major order,
+        // matching the Python collector.
+        std::stable_sort(raw.begin(), raw.end(),
+                         [](const RawEvent& a, const RawEvent& b) {
+                             return a.tick < b.tick;
+                         });
+
+        std::vector<MH_MidiEvent> events;
+        events.reserve(raw.size());
+        double max_seconds = 0.0;
+        for (const RawEvent& r : raw) {
+            const double seconds = tick_to_seconds(r.tick, tpq);
+            MH_MidiEvent e;
+            e.sample_offset = static_cast<int>(seconds * sample_rate);
+            e.status = r.status;
+            e.data1 = r.data1;
+            e.data2 = r.data2;
+            events.push_back(e);
+            if (seconds > max_seconds) max_seconds = seconds;
+        }
+        return new MidiEventTimeline(std::move(events), max_seconds);
     }
 
 private:
+    // One tempo segment: absolute time at `tick` plus the tempo in force
+    // from there until the next entry. Always anchored at tick 0.
+    struct TempoPoint {
+        int tick;
+        double seconds;         // absolute time at `tick`
+        double us_per_quarter;  // tempo in force from `tick` on
+    };
+
+    void rebuild_tempo_map_if_needed() {
+        if (!tempo_dirty_) return;
+        tempo_map_.clear();
+
+        for (int track = 0; track < file_.getTrackCount(); ++track) {
+            const auto& track_events = file_[track];
+            for (int i = 0; i < track_events.getEventCount(); ++i) {
+                const auto& event = track_events[i];
+                if (event.isTempo()) {
+                    tempo_map_.push_back(
+                        {event.tick, 0.0, 60000000.0 / event.getTempoBPM()});
+                }
+            }
+        }
+        finalize_tempo_map(file_.getTicksPerQuarterNote());
+        tempo_dirty_ = false;
+    }
+
+    // Sort, anchor at tick 0 (120 BPM default) and prefix absolute
+    // times so tick_to_seconds is a binary search plus one segment
+    // extrapolation. Shared by the eager rebuild and the lazy scan.
+    void finalize_tempo_map(int tpq) {
+        if (tempo_map_.empty()) {
+            tempo_map_.push_back({0, 0.0, 500000.0});  // 120 BPM default
+        }
+        std::stable_sort(tempo_map_.begin(), tempo_map_.end(),
+                         [](const TempoPoint& a, const TempoPoint& b) {
+                             return a.tick < b.tick;
+                         });
+        if (tempo_map_.front().tick != 0) {
+            tempo_map_.insert(tempo_map_.begin(), {0, 0.0, 500000.0});
+        }
+        for (size_t i = 1; i < tempo_map_.size(); ++i) {
+            const TempoPoint& prev = tempo_map_[i - 1];
+            const double delta_ticks = tempo_map_[i].tick - prev.tick;
+            tempo_map_[i].seconds =
+                prev.seconds + (delta_ticks / tpq) * (prev.us_per_quarter / 1000000.0);
+        }
+    }
+
+    // Requires a current tempo map (call rebuild_tempo_map_if_needed first).
+    double tick_to_seconds(int tick, int tpq) const {
+        // Last tempo point strictly before `tick` governs the remainder.
+        size_t lo = 0;
+        size_t hi = tempo_map_.size();
+        while (hi - lo > 1) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (tempo_map_[mid].tick < tick) lo = mid; else hi = mid;
+        }
+        const TempoPoint& p = tempo_map_[lo];
+        const double delta_ticks = tick - p.tick;
+        return p.seconds + (delta_ticks / tpq) * (p.us_per_quarter / 1000000.0);
+    }
+
+    // --- Lazy-load machinery (load_lazy) ------------------------------
+
+    // Byte range of one MTrk chunk body within raw_.
+    struct TrackSpan {
+        size_t offset;
+        size_t length;
+    };
+
+    // Result of the body-free boundary walk over one track.
+    struct TrackScan {
+        bool done = false;
+        int event_count = 0;
+        int end_tick = 0;
+    };
+
+    int be16(size_t o) const {
+        return ((int) raw_[o] << 8) | (int) raw_[o + 1];
+    }
+
+    uint32_t be32(size_t o) const {
+        return ((uint32_t) raw_[o] << 24) | ((uint32_t) raw_[o + 1] << 16)
+             | ((uint32_t) raw_[o + 2] << 8) | (uint32_t) raw_[o + 3];
+    }
+
+    // Variable-length quantity at p[pos]; false on truncation or a
+    // VLQ longer than the spec's 4-byte maximum.
+    static bool read_vlq(const unsigned char* p, size_t len, size_t& pos,
+                         int& value) {
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (pos >= len) return false;
+            const unsigned char b = p[pos++];
+            value = (value << 7) | (b & 0x7F);
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    // Walk one MTrk chunk counting events and accumulating ticks,
+    // reading only the bytes needed to find each event's boundary:
+    // delta-time VLQs, status bytes and meta/sysex lengths. Tempo
+    // metas (FF 51 03) are collected along the way -- their payload is
+    // part of the boundary walk anyway -- so duration queries need no
+    // event decode either. A malformed track ends the walk early with
+    // whatever was counted up to that point.
+    void scan_track_if_needed(int track) {
+        TrackScan& sc = scans_[(size_t) track];
+        if (sc.done) return;
+        const TrackSpan span = spans_[(size_t) track];
+        const unsigned char* p = raw_.data() + span.offset;
+        const size_t len = span.length;
+        size_t pos = 0;
+        int tick = 0;
+        unsigned char running = 0;
+        while (pos < len) {
+            int delta = 0;
+            if (!read_vlq(p, len, pos, delta)) break;
+            tick += delta;
+            if (pos >= len) break;
+            unsigned char status = p[pos];
+            if (status & 0x80) {
+                ++pos;
+            } else {
+                // Running status: p[pos] is already the first data
+                // byte, so don't advance past it.
+                status = running;
+                if (!(status & 0x80)) break;
+            }
+            if (status == 0xFF) {
+                running = 0;  // meta cancels running status
+                if (pos >= len) break;
+                const unsigned char type = p[pos++];
+                int mlen = 0;
+                if (!read_vlq(p, len, pos, mlen)) break;
+                if (type == 0x51 && mlen == 3 && pos + 3 <= len) {
+                    const double usq = (double) (((int) p[pos] << 16)
+                                                 | ((int) p[pos + 1] << 8)
+                                                 | (int) p[pos + 2]);
+                    lazy_tempi_.push_back({tick, 0.0, usq});
+                }
+                pos += (size_t) mlen;
+            } else if (status == 0xF0 || status == 0xF7) {
+                running = 0;  // sysex cancels running status
+                int slen = 0;
+                if (!read_vlq(p, len, pos, slen)) break;
+                pos += (size_t) slen;
+            } else {
+                running = status;
+                const int hi = status & 0xF0;
+                pos += (hi == 0xC0 || hi == 0xD0) ? 1 : 2;
+            }
+            if (pos > len) break;
+            ++sc.event_count;
+            sc.end_tick = tick;
+        }
+        sc.done = true;
+    }
+
+    void scan_all_tracks() {
+        for (int t = 0; t < (int) spans_.size(); ++t)
+            scan_track_if_needed(t);
+    }
+
+    // Requires scan_all_tracks() first (tempo metas can live in any
+    // track).
+    void build_lazy_tempo_map() {
+        tempo_map_ = lazy_tempi_;
+        finalize_tempo_map(lazy_tpq_);
+    }
+
+    // Mini-SMF for one track: MThd plus the raw MTrk bytes, prefixed
+    // with track 0 when decoding another track so that smf's time
+    // analysis sees the tempo map (the format-1 convention keeps
+    // tempo in track 0). Decoding goes through smf::MidiFile so the
+    // lazy path produces byte-identical events to the eager one.
+    const smf::MidiEventList& lazy_track(int track) {
+        auto& slot = track_cache_[(size_t) track];
+        if (!slot) {
+            const bool with_tempo = track != 0;
+            std::string bytes;
+            auto put16 = [&bytes](int v) {
+                bytes.push_back((char) ((v >> 8) & 0xFF));
+                bytes.push_back((char) (v & 0xFF));
+            };
+            auto put_chunk = [&](const TrackSpan& s) {
+                bytes.append("MTrk", 4);
+                const uint32_t L = (uint32_t) s.length;
+                bytes.push_back((char) ((L >> 24) & 0xFF));
+                bytes.push_back((char) ((L >> 16) & 0xFF));
+                bytes.push_back((char) ((L >> 8) & 0xFF));
+                bytes.push_back((char) (L & 0xFF));
+                bytes.append(reinterpret_cast<const char*>(raw_.data())
+                                 + s.offset,
+                             s.length);
+            };
+            bytes.append("MThd", 4);
+            bytes.append("\x00\x00\x00\x06", 4);
+            put16(1);  // format
+            put16(with_tempo ? 2 : 1);
+            put16(lazy_tpq_);
+            if (with_tempo) put_chunk(spans_[0]);
+            put_chunk(spans_[(size_t) track]);
+
+            auto mini = std::make_unique<smf::MidiFile>();
+            std::istringstream in(bytes, std::ios::binary);
+            if (!mini->read(in)) {
+                throw std::runtime_error(
+                    "MidiFile: failed to decode track "
+                    + std::to_string(track));
+            }
+            mini->doTimeAnalysis();
+            mini->linkNotePairs();
+            slot = std::move(mini);
+        }
+        return (*slot)[slot->getTrackCount() - 1];
+    }
+
+    // Promote a lazily opened file to a fully parsed smf::MidiFile.
+    // Mutating / whole-file operations land here; per-track reads stay
+    // lazy.
+    void materialize_if_lazy() {
+        if (!lazy_) return;
+        std::string bytes(reinterpret_cast<const char*>(raw_.data()),
+                          raw_.size());
+        std::istringstream in(bytes, std::ios::binary);
+        if (file_.read(in)) {
+            file_.doTimeAnalysis();
+            file_.linkNotePairs();
+        }
+        drop_lazy_state();
+        tempo_dirty_ = true;
+    }
+
+    void drop_lazy_state() {
+        lazy_ = false;
+        raw_.clear();
+        raw_.shrink_to_fit();
+        spans_.clear();
+        scans_.clear();
+        track_cache_.clear();
+        lazy_tempi_.clear();
+    }
+
     smf::MidiFile file_;
+    std::vector<TempoPoint> tempo_map_;
+    bool tempo_dirty_ = true;
+
+    std::vector<unsigned char> raw_;  // file bytes while lazy
+    bool lazy_ = false;
+    int lazy_tpq_ = 120;
+    std::vector<TrackSpan> spans_;
+    std::vector<TrackScan> scans_;
+    std::vector<TempoPoint> lazy_tempi_;  // tempo metas seen by scans
+    std::vector<std::unique_ptr<smf::MidiFile>> track_cache_;
 };
 
 
@@ -2521,63 +5743,422 @@ public:
             callback_ = std::move(other.callback_);
             other.handle_ = nullptr;
         }
-        return *this;
+        return *this;
+    }
+
+    static MidiIn open(int port_index, nb::callable callback) {
+        MidiIn m;
+        m.callback_ = std::move(callback);
+
+        char err[1024] = {0};
+        m.handle_ = mh_midi_in_open(port_index, &MidiIn::midi_callback, &m,
+                                     err, sizeof(err));
+        if (!m.handle_) {
+            throw std::runtime_error(std::string("Failed to open MIDI input: ") + err);
+        }
+        return m;
+    }
+
+    static MidiIn open_virtual(const std::string& name, nb::callable callback) {
+        MidiIn m;
+        m.callback_ = std::move(callback);
+
+        char err[1024] = {0};
+        m.handle_ = mh_midi_in_open_virtual(name.c_str(), &MidiIn::midi_callback, &m,
+                                             err, sizeof(err));
+        if (!m.handle_) {
+            throw std::runtime_error(std::string("Failed to open virtual MIDI input: ") + err);
+        }
+        return m;
+    }
+
+    void close() {
+        if (handle_) {
+            mh_midi_in_close(handle_);
+            handle_ = nullptr;
+        }
+    }
+
+    MidiIn& enter() {
+        return *this;
+    }
+
+    void exit(nb::object, nb::object, nb::object) {
+        close();
+    }
+
+private:
+    MH_MidiIn* handle_;
+    nb::callable callback_;
+
+    // NOTE: Called from the MIDI I/O thread. Acquires the GIL; callback must
+    // return quickly to avoid missed MIDI events.
+    static void midi_callback(const unsigned char* data, size_t len, void* user_data) {
+        nb::gil_scoped_acquire gil;
+        auto* self = static_cast<MidiIn*>(user_data);
+        if (self->callback_.is_valid() && !self->callback_.is_none()) {
+            self->callback_(nb::bytes(reinterpret_cast<const char*>(data), len));
+        }
+    }
+};
+
+
+// Map the Python-facing dither name onto MH_DitherMode for the write
+// paths. 32-bit float output ignores the setting (no quantization).
+static int parseDitherMode(const std::string& dither) {
+    if (dither == "tpdf") return MH_DITHER_TPDF;
+    if (dither == "none") return MH_DITHER_NONE;
+    if (dither == "shaped") return MH_DITHER_SHAPED;
+    throw std::runtime_error(
+        "dither must be 'tpdf', 'none', or 'shaped', got '" + dither + "'");
+}
+
+// Streaming audio file writer with a background encode thread.
+//
+// Wraps MH_AudioWriter: write() interleaves a finished block and hands
+// it to a bounded queue; a dedicated thread drains the queue into the
+// encoder. A render loop can therefore overlap processing block N with
+// encoding block N-1 -- the wall time for "render then encode" becomes
+// max(render, encode) instead of the sum, which matters most for FLAC
+// output. write() blocks (with the GIL released) when the queue is
+// full, so memory stays bounded at queue_blocks blocks. Encode errors
+// are deferred and re-raised from the next write() or close().
+class AudioFileWriter {
+public:
+    AudioFileWriter(const std::string& path, int channels, int sample_rate,
+                    int bit_depth, int queue_blocks, double flush_interval,
+                    bool unbuffered, const std::string& dither)
+        : channels_(channels) {
+        if (channels <= 0) {
+            throw std::runtime_error("channels must be >= 1");
+        }
+        if (unbuffered && flush_interval > 0.0) {
+            throw std::runtime_error(
+                "unbuffered and flush_interval are mutually exclusive "
+                "(direct I/O cannot patch the header mid-capture)");
+        }
+        max_queued_ = queue_blocks < 1 ? 1 : (size_t)queue_blocks;
+        const int dither_mode = parseDitherMode(dither);
+
+        char err[1024] = {0};
+        if (unbuffered) {
+            writer_ = mh_audio_writer_open_unbuffered(
+                path.c_str(), (unsigned int)channels,
+                (unsigned int)sample_rate, bit_depth, err, sizeof(err));
+        } else if (flush_interval > 0.0) {
+            writer_ = mh_audio_writer_open_capture(
+                path.c_str(), (unsigned int)channels,
+                (unsigned int)sample_rate, bit_depth, flush_interval,
+                err, sizeof(err));
+        } else {
+            writer_ = mh_audio_writer_open(path.c_str(), (unsigned int)channels,
+                                           (unsigned int)sample_rate, bit_depth,
+                                           err, sizeof(err));
+        }
+        if (!writer_) {
+            throw std::runtime_error(std::string(err));
+        }
+        if (!mh_audio_writer_set_dither(writer_, dither_mode)) {
+            mh_audio_writer_close(writer_, nullptr, 0);
+            writer_ = nullptr;
+            throw std::runtime_error("Failed to set dither mode");
+        }
+        encode_thread_ = std::thread(&AudioFileWriter::encodeLoop, this);
+    }
+
+    ~AudioFileWriter() { shutdown(nullptr, 0); }
+
+    AudioFileWriter(const AudioFileWriter&) = delete;
+    AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+
+    void write(nb::ndarray<const float, nb::shape<-1, -1>, nb::c_contig, nb::device::cpu> block) {
+        if (!writer_) {
+            throw std::runtime_error("Writer is closed");
+        }
+        if ((int)block.shape(0) < channels_) {
+            throw std::runtime_error(
+                "Block has " + std::to_string(block.shape(0)) +
+                " channel(s) but writer was opened with " +
+                std::to_string(channels_));
+        }
+        size_t frames = block.shape(1);
+        if (frames == 0) return;
+
+        // Interleave while the GIL is held (the source is a Python-owned
+        // buffer); only the wait for queue space releases it.
+        std::vector<float> interleaved((size_t)channels_ * frames);
+        const float* planar = block.data();
+        size_t src_frames = block.shape(1);
+        for (size_t f = 0; f < frames; f++) {
+            for (int ch = 0; ch < channels_; ch++) {
+                interleaved[f * channels_ + ch] = planar[(size_t)ch * src_frames + f];
+            }
+        }
+
+        nb::gil_scoped_release release;
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_cv_.wait(lock, [&] { return queue_.size() < max_queued_ || failed_; });
+        if (failed_) {
+            throw std::runtime_error(error_);
+        }
+        queue_.push_back(std::move(interleaved));
+        frames_accepted_ += frames;
+        data_cv_.notify_one();
+    }
+
+    unsigned long long frames_written() const { return frames_accepted_; }
+
+    // Drain the queue, finalize the file, and re-raise any deferred
+    // encode error. Idempotent.
+    void close() {
+        char err[1024] = {0};
+        int ok;
+        {
+            nb::gil_scoped_release release;
+            ok = shutdown(err, sizeof(err));
+        }
+        if (!ok) {
+            throw std::runtime_error(std::string(err));
+        }
+    }
+
+    AudioFileWriter& enter() { return *this; }
+    void exit(nb::object, nb::object, nb::object) { close(); }
+
+private:
+    // Join the encode thread and close the writer. Returns 1 on clean
+    // finalize, 0 on error (message in err). Never throws (also used
+    // from the destructor).
+    int shutdown(char* err, size_t err_size) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            closing_ = true;
+            data_cv_.notify_one();
+        }
+        if (encode_thread_.joinable()) {
+            encode_thread_.join();
+        }
+        int ok = 1;
+        if (writer_) {
+            ok = mh_audio_writer_close(writer_, err, err_size);
+            writer_ = nullptr;
+        }
+        if (failed_) {
+            if (err && err_size > 0) snprintf(err, err_size, "%s", error_.c_str());
+            failed_ = false;  // report a deferred error once
+            ok = 0;
+        }
+        return ok;
+    }
+
+    // Encode thread: drains queued blocks into the C writer. On error,
+    // records the message, drops the backlog, and wakes any blocked
+    // writer so it can re-raise.
+    void encodeLoop() {
+        for (;;) {
+            std::vector<float> block;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                data_cv_.wait(lock, [&] { return !queue_.empty() || closing_; });
+                if (queue_.empty()) return;  // closing and fully drained
+                block = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            space_cv_.notify_one();
+
+            char err[1024] = {0};
+            unsigned int frames = (unsigned int)(block.size() / channels_);
+            if (!mh_audio_writer_write(writer_, block.data(), frames, err, sizeof(err))) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                failed_ = true;
+                error_ = err;
+                queue_.clear();
+                space_cv_.notify_all();
+                return;
+            }
+        }
+    }
+
+    MH_AudioWriter* writer_ = nullptr;
+    int channels_;
+    size_t max_queued_;
+    std::atomic<unsigned long long> frames_accepted_{0};
+
+    std::thread encode_thread_;
+    std::mutex mutex_;
+    std::condition_variable data_cv_;   // encode thread waits for blocks
+    std::condition_variable space_cv_;  // write() waits for queue space
+    std::deque<std::vector<float>> queue_;
+    bool closing_ = false;
+    bool failed_ = false;
+    std::string error_;
+};
+
+
+// Streaming audio file reader (pull-based decoder).
+//
+// Wraps MH_AudioReader: read_into() decodes the next block straight into
+// a caller-provided AudioBuffer, so multi-GB files flow through a block
+// loop with one fixed-size buffer instead of ever being resident. Same
+// format support as read_audio (WAV, FLAC, MP3, Vorbis). The decode-side
+// counterpart to AudioFileWriter; decoding runs synchronously on the
+// calling thread with the GIL released.
+class AudioFileReader {
+public:
+    explicit AudioFileReader(const std::string& path) {
+        char err[1024] = {0};
+        reader_ = mh_audio_reader_open(path.c_str(), err, sizeof(err));
+        if (!reader_) {
+            throw std::runtime_error(std::string(err));
+        }
+    }
+
+    ~AudioFileReader() { closeInternal(); }
+
+    AudioFileReader(const AudioFileReader&) = delete;
+    AudioFileReader& operator=(const AudioFileReader&) = delete;
+
+    int channels() const {
+        requireOpen();
+        return (int)mh_audio_reader_channels(reader_);
+    }
+    int sample_rate() const {
+        requireOpen();
+        return (int)mh_audio_reader_sample_rate(reader_);
+    }
+    unsigned long long frames() const {
+        requireOpen();
+        return mh_audio_reader_frames(reader_);
+    }
+
+    // Decode up to buf.frames frames into buf (planar, zero extra
+    // copies). Returns the number of frames produced: the full request
+    // mid-stream, less near the end, 0 at EOF. Channels beyond the
+    // stream's are left untouched.
+    int read_into(MhAudioBuffer& buf) {
+        requireOpen();
+        if (buf.channels() < channels()) {
+            throw std::runtime_error(
+                "Buffer has " + std::to_string(buf.channels()) +
+                " channel(s) but the stream has " +
+                std::to_string(channels()));
+        }
+        long long got;
+        {
+            nb::gil_scoped_release release;
+            got = mh_audio_reader_read(reader_,
+                                       buf.juce().getArrayOfWritePointers(),
+                                       (unsigned int)buf.frames());
+        }
+        if (got < 0) {
+            throw std::runtime_error("Audio decode error");
+        }
+        return (int)got;
+    }
+
+    void seek(unsigned long long frame) {
+        requireOpen();
+        if (!mh_audio_reader_seek(reader_, frame)) {
+            throw std::runtime_error(
+                "Seek failed (decode error or unseekable stream)");
+        }
+    }
+
+    // Idempotent.
+    void close() { closeInternal(); }
+
+    AudioFileReader& enter() { return *this; }
+    void exit(nb::object, nb::object, nb::object) { close(); }
+
+private:
+    void requireOpen() const {
+        if (!reader_) {
+            throw std::runtime_error("Reader is closed");
+        }
+    }
+    void closeInternal() {
+        if (reader_) {
+            mh_audio_reader_close(reader_);
+            reader_ = nullptr;
+        }
     }
 
-    static MidiIn open(int port_index, nb::callable callback) {
-        MidiIn m;
-        m.callback_ = std::move(callback);
+    MH_AudioReader* reader_ = nullptr;
+};
 
-        char err[1024] = {0};
-        m.handle_ = mh_midi_in_open(port_index, &MidiIn::midi_callback, &m,
-                                     err, sizeof(err));
-        if (!m.handle_) {
-            throw std::runtime_error(std::string("Failed to open MIDI input: ") + err);
+
+// Streaming EBU R128 loudness meter (wraps MH_LoudnessMeter).
+//
+// process() takes any (channels, frames) float32 array whose innermost
+// dimension is contiguous -- which includes PluginGraph.node_audio tap
+// views and AudioBuffers via DLPack -- so per-block loudness tracking
+// inside a render loop costs no copy. Measurement runs with the GIL
+// released; queries are cheap and do not disturb the stream.
+class LoudnessMeter {
+public:
+    LoudnessMeter(int channels, int sample_rate) {
+        char err[256] = {0};
+        meter_ = mh_loudness_open((unsigned int)channels,
+                                  (unsigned int)sample_rate,
+                                  err, sizeof(err));
+        if (!meter_) {
+            throw std::runtime_error(std::string(err));
         }
-        return m;
+        channels_ = channels;
     }
 
-    static MidiIn open_virtual(const std::string& name, nb::callable callback) {
-        MidiIn m;
-        m.callback_ = std::move(callback);
+    ~LoudnessMeter() { mh_loudness_close(meter_); }
 
-        char err[1024] = {0};
-        m.handle_ = mh_midi_in_open_virtual(name.c_str(), &MidiIn::midi_callback, &m,
-                                             err, sizeof(err));
-        if (!m.handle_) {
-            throw std::runtime_error(std::string("Failed to open virtual MIDI input: ") + err);
+    LoudnessMeter(const LoudnessMeter&) = delete;
+    LoudnessMeter& operator=(const LoudnessMeter&) = delete;
+
+    void process(nb::ndarray<const float, nb::shape<-1, -1>,
+                             nb::device::cpu> block) {
+        if ((int)block.shape(0) != channels_) {
+            throw std::runtime_error(
+                "Block has " + std::to_string(block.shape(0)) +
+                " channel(s) but the meter was opened with " +
+                std::to_string(channels_));
+        }
+        const size_t frames = block.shape(1);
+        if (frames == 0) return;
+        if (block.stride(1) != 1) {
+            throw std::runtime_error(
+                "Block frames must be contiguous per channel "
+                "(stride 1 along the last axis)");
+        }
+        std::vector<const float*> ptrs((size_t)channels_);
+        for (int c = 0; c < channels_; c++) {
+            ptrs[(size_t)c] = block.data() + (int64_t)c * block.stride(0);
+        }
+        int ok;
+        {
+            nb::gil_scoped_release release;
+            ok = mh_loudness_process(meter_, ptrs.data(),
+                                     (unsigned int)frames);
+        }
+        if (!ok) {
+            throw std::runtime_error("loudness process failed");
         }
-        return m;
     }
 
-    void close() {
-        if (handle_) {
-            mh_midi_in_close(handle_);
-            handle_ = nullptr;
+    double integrated() const { return mh_loudness_integrated(meter_); }
+    double shortterm() const { return mh_loudness_shortterm(meter_); }
+
+    double sample_peak(int channel) const {
+        if (channel < 0 || channel >= channels_) {
+            throw std::runtime_error("channel out of range");
         }
+        return mh_loudness_sample_peak(meter_, (unsigned int)channel);
     }
 
-    MidiIn& enter() {
-        return *this;
-    }
+    void reset() { mh_loudness_reset(meter_); }
 
-    void exit(nb::object, nb::object, nb::object) {
-        close();
-    }
+    int channels() const { return channels_; }
 
 private:
-    MH_MidiIn* handle_;
-    nb::callable callback_;
-
-    // NOTE: Called from the MIDI I/O thread. Acquires the GIL; callback must
-    // return quickly to avoid missed MIDI events.
-    static void midi_callback(const unsigned char* data, size_t len, void* user_data) {
-        nb::gil_scoped_acquire gil;
-        auto* self = static_cast<MidiIn*>(user_data);
-        if (self->callback_.is_valid() && !self->callback_.is_none()) {
-            self->callback_(nb::bytes(reinterpret_cast<const char*>(data), len));
-        }
-    }
+    MH_LoudnessMeter* meter_ = nullptr;
+    int channels_ = 0;
 };
 
 
@@ -2608,6 +6189,31 @@ NB_MODULE(_core, m) {
     m.def("_message_thread_shutdown", &mh_message_thread_shutdown,
           "Stop the dedicated native plugin thread (registered with atexit).");
 
+    m.def("set_message_pumps",
+          [](int count) {
+              if (!mh_message_thread_set_pumps(count))
+                  throw std::runtime_error(
+                      "message pumps can only be configured before the "
+                      "first plugin load");
+          },
+          nb::arg("count"),
+          "EXPERIMENTAL: configure `count` extra marshalling threads "
+          "('worker pumps', 0 disables) next to the native plugin "
+          "thread. Each plugin opened afterwards is pinned to one pump "
+          "for life, so thread-affine work (loading, state save/restore, "
+          "programs) on plugins pinned to different pumps runs "
+          "concurrently instead of serializing through the single plugin "
+          "thread. Opt-in and headless-oriented: plugins that depend on "
+          "running on the real JUCE message thread (Timers, "
+          "AsyncUpdaters) must keep the default. Must be called before "
+          "the first plugin load (raises RuntimeError afterwards). The "
+          "MINIHOST_MESSAGE_PUMPS environment variable provides the same "
+          "setting.");
+
+    m.def("get_message_pumps", &mh_message_thread_get_pumps,
+          "Return the configured worker pump count (0 = single-thread "
+          "default).");
+
     // ABI version of the linked C library. Header constants
     // MH_API_VERSION_{MAJOR,MINOR,PATCH} are exposed so a wheel built against
     // one header version can detect a mismatch with a separately-installed
@@ -2628,10 +6234,37 @@ NB_MODULE(_core, m) {
           nb::arg("path"),
           "Get plugin metadata without full instantiation");
 
+    m.def("probe_batch", &probe_batch_plugins,
+          nb::arg("paths"), nb::arg("concurrency") = 0,
+          "Probe an explicit list of plugin paths in parallel. Returns a "
+          "list parallel to `paths`: a metadata dict (as from probe()) per "
+          "success, or a {'path', 'error'} dict per failure -- one bad "
+          "path never aborts the batch. `concurrency` is the worker "
+          "thread count (0 = CPU count; clamped to the list length; 1 "
+          "probes serially through one shared format manager, which is "
+          "still far cheaper than per-call probe()). The GIL is "
+          "released for the duration.");
+
     m.def("scan_directory", &scan_directory,
           nb::arg("directory_path"),
           "Scan a directory for plugins (VST3, AudioUnit). Returns list of plugin metadata dicts.");
 
+    m.def("capture_states", &capture_states,
+          nb::arg("plugins"),
+          "Capture the state of every plugin in one submission to the "
+          "plugin thread, instead of a cross-thread round trip per "
+          "get_state() call. Returns a list parallel to `plugins`: "
+          "bytes per plugin, or None where capture failed or the "
+          "plugin reported no state.");
+
+    m.def("restore_states", &restore_states,
+          nb::arg("plugins"), nb::arg("states"),
+          "Restore plugin states captured by capture_states() in one "
+          "submission to the plugin thread. `states` must be parallel "
+          "to `plugins`; None entries are skipped. Returns the number "
+          "of states applied. Not safe to overlap processing on any "
+          "plugin in the batch.");
+
     // Session: shared format-manager state across loads/probes/scans.
     nb::class_<Session>(m, "Session")
         .def(nb::init<>(),
@@ -2645,10 +6278,21 @@ NB_MODULE(_core, m) {
              [](Session& self, const std::string& path,
                 double sample_rate, int max_block_size,
                 int in_channels, int out_channels,
-                int sidechain_channels) {
+                int sidechain_channels, const std::string& format) {
+                 int fmt;
+                 if (format == "any")       fmt = MH_FORMAT_ANY;
+                 else if (format == "vst3") fmt = MH_FORMAT_VST3;
+                 else if (format == "au")   fmt = MH_FORMAT_AU;
+                 else if (format == "lv2")  fmt = MH_FORMAT_LV2;
+                 else {
+                     throw std::runtime_error(
+                         "Unknown format '" + format
+                         + "' (expected 'any', 'vst3', 'au' or 'lv2')");
+                 }
                  return new Plugin(self.raw(), path, sample_rate,
                                     max_block_size, in_channels,
-                                    out_channels, sidechain_channels);
+                                    out_channels, sidechain_channels,
+                                    fmt);
              },
              nb::arg("path"),
              nb::arg("sample_rate") = 48000.0,
@@ -2656,11 +6300,72 @@ NB_MODULE(_core, m) {
              nb::arg("in_channels") = 2,
              nb::arg("out_channels") = 2,
              nb::arg("sidechain_channels") = 0,
+             nb::arg("format") = "any",
              nb::rv_policy::take_ownership,
              "Load a plugin using the session's shared format manager. "
              "Returns a Plugin. The returned Plugin does not depend on "
              "the session post-construction; it is safe to close the "
-             "session while the Plugin remains in use.")
+             "session while the Plugin remains in use. `format` pins "
+             "the open to one plugin format ('vst3', 'au' or 'lv2'; "
+             "default 'any' discovers across all of them) -- the file "
+             "must resolve as that format or the open fails. LV2 opens "
+             "share one session-wide LV2 context, so N LV2 opens "
+             "through one session parse the lilv world once.")
+        .def("standby", &Session::standby,
+             nb::arg("plugin"),
+             nb::rv_policy::take_ownership,
+             "Open a warm standby clone of `plugin` for instant A/B "
+             "state flips: a second instance of the same bundle (the "
+             "module cache keeps the binary mapped), same rate, block "
+             "size and channel layout, with the active plugin's current "
+             "state pre-applied. Load the alternate state into it with "
+             "set_state, then flip with Plugin.swap_standby. The clone "
+             "is an ordinary Plugin; close it when done. Memory cost is "
+             "a full second instance.")
+        .def("set_pool",
+             [](Session& self, int max_idle, int idle_ttl_ms) {
+                 if (!mh_session_set_pool(self.raw(), max_idle,
+                                          idle_ttl_ms)) {
+                     throw std::runtime_error(
+                         "Session.set_pool failed (limits must be >= 0)");
+                 }
+             },
+             nb::arg("max_idle"), nb::arg("idle_ttl_ms") = 0,
+             "Configure the session's instance pool: at most max_idle "
+             "released plugins are parked for reuse (0, the default, "
+             "disables pooling -- release() then closes), and parked "
+             "instances idle longer than idle_ttl_ms milliseconds are "
+             "closed on the next acquire/release (0 = no age limit). "
+             "Shrinking the limits evicts immediately, oldest first.")
+        .def("acquire", &Session::acquire,
+             nb::arg("path"),
+             nb::arg("sample_rate") = 48000.0,
+             nb::arg("max_block_size") = 512,
+             nb::arg("in_channels") = 2,
+             nb::arg("out_channels") = 2,
+             nb::arg("sidechain_channels") = 0,
+             nb::rv_policy::take_ownership,
+             "Acquire a plugin instance, served from the session's pool "
+             "when a released instance matches the same path, rate, "
+             "block size and layout (revived with reset() plus the "
+             "state it was born with, so each job starts from factory "
+             "defaults), and opened fresh otherwise. Pair with "
+             "Session.release to keep the instance warm for the next "
+             "job; a batch that opens the same effect thousands of "
+             "times then pays construction once.")
+        .def("release", &Session::release,
+             nb::arg("plugin"),
+             "Return an acquired plugin to the session's pool, or close "
+             "it when pooling is disabled or the pool is full. "
+             "Registered callbacks are cleared so the next acquirer "
+             "never inherits them. The Plugin object is invalidated "
+             "either way -- do not use it after release.")
+        .def("pool_size",
+             [](Session& self) {
+                 return mh_session_pool_size(self.raw());
+             },
+             "Number of instances currently parked in the session's "
+             "instance pool.")
         .def("probe",
              [](Session& self, const std::string& path) {
                  MH_PluginDesc desc;
@@ -2676,24 +6381,45 @@ NB_MODULE(_core, m) {
              "Probe a plugin using the session's shared format manager. "
              "Returns the same dict shape as the module-level probe().")
         .def("scan_directory",
-             [](Session& self, const std::string& directory_path) {
-                 std::vector<nb::dict> results;
-                 ScanContext ctx{&results};
-                 int n = mh_session_scan_directory(
-                     self.raw(), directory_path.c_str(),
-                     scan_callback, &ctx);
+             [](Session& self, const std::string& directory_path,
+                int num_threads) {
+                 std::vector<MH_PluginDesc> descs;
+                 int n;
+                 {
+                     nb::gil_scoped_release release;
+                     n = num_threads > 1
+                         ? mh_session_scan_directory_mt(
+                               self.raw(), directory_path.c_str(),
+                               num_threads, scan_collect_callback, &descs)
+                         : mh_session_scan_directory(
+                               self.raw(), directory_path.c_str(),
+                               scan_collect_callback, &descs);
+                 }
                  if (n < 0) {
                      throw std::runtime_error(
                          "Session.scan_directory failed: " + directory_path);
                  }
                  nb::list out;
-                 for (const auto& d : results) out.append(d);
+                 for (const auto& d : descs) out.append(plugin_desc_to_dict(d));
                  return out;
              },
-             nb::arg("directory_path"),
+             nb::arg("directory_path"), nb::arg("num_threads") = 1,
              "Scan a directory for plugins using the session's shared "
              "format manager. Returns the same list-of-dicts shape as "
-             "the module-level scan_directory().")
+             "the module-level scan_directory(). num_threads > 1 probes "
+             "that many plugins concurrently (results then arrive in "
+             "arbitrary order); the GIL is released while scanning.")
+        .def("refresh_formats",
+             [](Session& self) {
+                 mh_session_refresh_formats(self.raw());
+             },
+             "Drop the session's shared LV2 context so the next "
+             "LV2-targeted open/probe rebuilds it. The LV2 world is a "
+             "snapshot of the installed bundles taken when the context "
+             "first came up; call this after installing or removing "
+             ".lv2 bundles. VST3 needs no refresh (moduleinfo results "
+             "are invalidated on file change automatically). Cheap "
+             "when nothing is cached.")
         .def("close", &Session::close,
              "Release the session's format manager. Idempotent. Plugins "
              "previously created via Session.open remain valid (the "
@@ -2716,7 +6442,157 @@ NB_MODULE(_core, m) {
     m.def("audio_get_capture_devices", &audio_get_capture_devices,
           "Get list of available audio capture (input) devices. "
           "Returns list of dicts with 'name', 'index', and 'is_default'.");
-
+    m.def("audio_refresh_devices",
+          []() {
+              int ok;
+              {
+                  nb::gil_scoped_release release;
+                  ok = mh_audio_refresh_devices();
+              }
+              if (!ok)
+                  throw std::runtime_error("audio device refresh failed");
+          },
+          "Re-query the audio backend for the current device lists. "
+          "Enumeration results are served from a cached snapshot (the "
+          "backend context can take hundreds of milliseconds to create "
+          "on some setups), so newly plugged or removed devices only "
+          "appear after a refresh. Releases the GIL while the backend "
+          "is queried.");
+
+    // RT-safety audit (MINIHOST_RT_AUDIT=1)
+    m.def("rt_audit_enabled",
+          []() { return mh_rt_audit_enabled() != 0; },
+          "True if RT-safety audit mode is active (MINIHOST_RT_AUDIT=1 "
+          "was set when the process started). In audit mode, heap "
+          "allocations made inside the audio processing paths are "
+          "trapped and backtraced.");
+    m.def("rt_audit_report",
+          []() {
+              std::vector<char> buf(65536);
+              long long total = mh_rt_audit_report(buf.data(), buf.size());
+              return nb::make_tuple(total, std::string(buf.data()));
+          },
+          "Return (hit_count, report_text): total allocations trapped "
+          "in audited audio paths and a human-readable report with "
+          "backtraces for the first hits recorded.");
+    m.def("rt_audit_reset", &mh_rt_audit_reset,
+          "Clear the RT-audit hit table and counter.");
+
+    // Flight-recorder event log (MINIHOST_EVENTLOG=1, mh_eventlog_*)
+    m.def("eventlog_enable",
+          [](long long capacity_bytes) {
+              if (!mh_eventlog_enable(capacity_bytes))
+                  throw std::runtime_error(
+                      "Failed to allocate the event-log ring");
+          },
+          nb::arg("capacity_bytes") = 0,
+          "Allocate the flight-recorder event ring (capacity_bytes <= 0 "
+          "selects the 4 MB default). Hot paths then append fixed-size "
+          "records -- block start/end, xruns, parameter writes, incoming "
+          "MIDI, live plugin swaps -- wait-free, a few nanoseconds each, "
+          "so the log can stay enabled in production. Call before "
+          "starting audio (or set MINIHOST_EVENTLOG=1 in the environment "
+          "to enable at process start); enabling while blocks are being "
+          "rendered is undefined.");
+    m.def("eventlog_disable", &mh_eventlog_disable,
+          "Free the event-log ring. Must not be called while audio is "
+          "being rendered.");
+    m.def("eventlog_enabled",
+          []() { return mh_eventlog_enabled() != 0; },
+          "True when the event-log ring is allocated (via "
+          "eventlog_enable() or MINIHOST_EVENTLOG).");
+    m.def("eventlog_dump",
+          []() {
+              int n = mh_eventlog_dump(nullptr, 0);
+              std::vector<MH_LogEvent> evts((size_t) (n > 0 ? n : 0));
+              int avail = n > 0 ? mh_eventlog_dump(evts.data(), n) : 0;
+              const int filled = avail < n ? avail : n;
+              nb::list out;
+              for (int i = 0; i < filled; ++i)
+                  out.append(nb::make_tuple(evts[(size_t) i].timestamp,
+                                            (int) evts[(size_t) i].kind,
+                                            (int) evts[(size_t) i].arg16,
+                                            evts[(size_t) i].arg32));
+              return out;
+          },
+          "Snapshot the retained event-log records, oldest first, as "
+          "(timestamp, kind, arg16, arg32) tuples. Timestamps are raw "
+          "cycle counts on x86/AArch64 and steady-clock nanoseconds "
+          "elsewhere. Safe to call while audio runs, but records at the "
+          "write frontier may be torn; dump after stopping the engine "
+          "for an exact capture.");
+    m.def("eventlog_reset", &mh_eventlog_reset,
+          "Drop all retained event-log records (the ring stays "
+          "allocated).");
+
+    // Process-global metrics registry (mh_metrics)
+    m.def("metrics_snapshot",
+          []() {
+              // Headroom over the pre-count in case a registration
+              // lands between the two calls.
+              int n = mh_metrics_count() + 16;
+              std::vector<MH_MetricValue> vals((size_t) n);
+              int live = mh_metrics_snapshot(vals.data(), n);
+              nb::list result;
+              int filled = live < n ? live : n;
+              for (int i = 0; i < filled; ++i)
+                  result.append(nb::make_tuple(
+                      std::string(vals[i].name),
+                      vals[i].kind == MH_METRIC_COUNTER ? "counter"
+                                                        : "gauge",
+                      vals[i].value));
+              return result;
+          },
+          "Snapshot the process-global metrics registry: a list of "
+          "(name, kind, value) tuples with kind 'counter' or 'gauge'. "
+          "Includes libminihost's built-ins (per-process block counters "
+          "for the plugin/chain/graph render paths, RT-audit hits) plus "
+          "anything registered through the C API. Wait-free on the "
+          "writer side, so scraping is safe while audio runs.");
+    m.def("metrics_reset", &mh_metrics_reset,
+          "Zero all counter metrics. Gauges and pull-style metrics "
+          "are untouched.");
+
+    // Per-role thread scheduling policy (mh_thread_policy_*)
+    m.def("set_thread_policy",
+          [](const std::string& role, const std::string& priority,
+             const std::vector<int>& cpus) {
+              int r = -1;
+              if (role == "message") r = MH_THREAD_ROLE_MESSAGE;
+              else if (role == "audio_worker") r = MH_THREAD_ROLE_AUDIO_WORKER;
+              else if (role == "loader") r = MH_THREAD_ROLE_LOADER;
+              else if (role == "control") r = MH_THREAD_ROLE_CONTROL;
+              else throw std::invalid_argument(
+                  "role must be 'message', 'audio_worker', 'loader', "
+                  "or 'control'");
+              int pr = -1;
+              if (priority == "default") pr = MH_THREAD_PRIORITY_DEFAULT;
+              else if (priority == "low") pr = MH_THREAD_PRIORITY_LOW;
+              else if (priority == "high") pr = MH_THREAD_PRIORITY_HIGH;
+              else if (priority == "realtime") pr = MH_THREAD_PRIORITY_REALTIME;
+              else throw std::invalid_argument(
+                  "priority must be 'default', 'low', 'high', or "
+                  "'realtime'");
+              if (!mh_thread_policy_set(r, pr,
+                                        cpus.empty() ? nullptr : cpus.data(),
+                                        (int) cpus.size())) {
+                  throw std::runtime_error(
+                      "set_thread_policy failed (bad cpu list)");
+              }
+          },
+          nb::arg("role"), nb::arg("priority"),
+          nb::arg("cpus") = std::vector<int>(),
+          "Set the scheduling policy for one of the library's thread "
+          "roles: 'message' (the embedded JUCE message thread), "
+          "'audio_worker' (graph render workers and chain pipeline "
+          "stages), 'loader' (async open / scan pool), or 'control' "
+          "(the parameter-coalescing flush thread). priority is "
+          "'default', 'low', 'high', or 'realtime' (SCHED_FIFO); cpus "
+          "optionally confines the role to a CPU list (Linux). Applied "
+          "when a thread of that role spawns -- set at startup, before "
+          "the first plugin load. Best-effort at apply time: denials "
+          "(e.g. missing rtprio privilege) show up in "
+          "metrics_snapshot() as threads.policy_denied.");
     // VST3 .vstpreset helpers
     m.def("vstpreset_read_class_id_from_bundle",
           [](const std::string& vst3_path) {
@@ -2760,6 +6636,62 @@ NB_MODULE(_core, m) {
           "(class_id, component_state, controller_state) where the latter two "
           "are bytes objects (or None if the chunk is absent).");
 
+    // Metadata-only preset query via the lazy mmap handle; the state chunks
+    // are never read.
+    m.def("vstpreset_read_info",
+          [](const std::string& path) {
+              char err[512] = {0};
+              MH_VstPresetFile* f =
+                  mh_vstpreset_open(path.c_str(), err, sizeof(err));
+              if (!f) {
+                  throw std::runtime_error(std::string("vstpreset_read_info: ") + err);
+              }
+              std::string class_id(mh_vstpreset_file_class_id(f));
+              long long file_size = mh_vstpreset_file_size(f);
+              long long comp_size = mh_vstpreset_file_component_size(f);
+              long long cont_size = mh_vstpreset_file_controller_size(f);
+              mh_vstpreset_close(f);
+              return nb::make_tuple(class_id, file_size, comp_size, cont_size);
+          },
+          nb::arg("path"),
+          "Read .vstpreset metadata without touching the state chunks. "
+          "Returns (class_id, file_size, component_size, controller_size); "
+          "chunk sizes are -1 when the chunk is absent from the file.");
+
+    // Bulk directory index for preset browsers.
+    m.def("vstpreset_index_dir",
+          [](const std::string& dir_path) {
+              char err[512] = {0};
+              MH_VstPresetIndexEntry* entries = nullptr;
+              int count = 0;
+              int ok;
+              {
+                  nb::gil_scoped_release release;
+                  ok = mh_vstpreset_index_dir(dir_path.c_str(), &entries,
+                                              &count, err, sizeof(err));
+              }
+              if (!ok) {
+                  throw std::runtime_error(std::string("vstpreset_index_dir: ") + err);
+              }
+              nb::list out;
+              for (int i = 0; i < count; i++) {
+                  const MH_VstPresetIndexEntry& e = entries[i];
+                  out.append(nb::make_tuple(std::string(e.path),
+                                            std::string(e.class_id),
+                                            e.file_size, e.component_size,
+                                            e.controller_size));
+              }
+              mh_vstpreset_index_free(entries, count);
+              return out;
+          },
+          nb::arg("dir_path"),
+          "Index every *.vstpreset file directly in a directory "
+          "(non-recursive, sorted by file name), reading only header and "
+          "chunk-list metadata with batched readahead. Returns a list of "
+          "(path, class_id, file_size, component_size, controller_size) "
+          "tuples; sizes are -1 when the chunk is absent. Unparseable files "
+          "are skipped.");
+
     // Write a .vstpreset via the C writer.
     m.def("vstpreset_write",
           [](const std::string& path, const std::string& class_id,
@@ -2795,6 +6727,14 @@ NB_MODULE(_core, m) {
     m.attr("MH_PRECISION_SINGLE") = MH_PRECISION_SINGLE;
     m.attr("MH_PRECISION_DOUBLE") = MH_PRECISION_DOUBLE;
 
+    // Automation granularity modes (Plugin.set_automation_granularity)
+    m.attr("MH_AUTOMATION_SAMPLE_ACCURATE") = MH_AUTOMATION_SAMPLE_ACCURATE;
+    m.attr("MH_AUTOMATION_BLOCK_RATE") = MH_AUTOMATION_BLOCK_RATE;
+
+    // Host-side parameter smoothing modes (Plugin.set_param_smoothing)
+    m.attr("MH_SMOOTH_LINEAR") = MH_SMOOTH_LINEAR;
+    m.attr("MH_SMOOTH_EXPONENTIAL") = MH_SMOOTH_EXPONENTIAL;
+
     // Default capacity of the MIDI-output buffer used by process_midi /
     // process_auto when the caller does not pass an explicit
     // midi_out_capacity. Events beyond the active capacity are dropped by
@@ -2803,6 +6743,13 @@ NB_MODULE(_core, m) {
     // midi_out_capacity argument for dense streams (e.g. MPE aftertouch).
     m.attr("MIDI_OUT_CAPACITY") = MIDI_OUT_CAPACITY;
 
+    // Byte size of one MH_MidiEvent record as laid out by the C ABI
+    // (int sample_offset + three unsigned char data bytes + padding).
+    // minihost.midi_event_dtype() uses this as the structured itemsize
+    // so PluginGraph.borrow_midi_output_events views stay in sync with
+    // the native struct.
+    m.attr("MIDI_EVENT_SIZE") = (int) sizeof(MH_MidiEvent);
+
     // ----------------------------------------------------------------------
     // AudioBuffer (wrapper around juce::AudioBuffer<float>)
     // ----------------------------------------------------------------------
@@ -2831,10 +6778,14 @@ NB_MODULE(_core, m) {
         const std::string class_doc =
             std::string("Planar ") + dtype_str +
             " audio buffer (stdlib-only; backed by juce::AudioBuffer).\n\n"
-            "Layout is (channels x frames) row-major. The buffer is always\n"
-            "contiguous in memory and exposes the DLPack buffer protocol, so it\n"
-            "can be passed directly to Plugin.process / PluginChain.process /\n"
-            "minihost.write_audio without an explicit conversion.\n\n"
+            "Layout is (channels x frames) row-major. Buffers you construct\n"
+            "are contiguous in memory and expose the DLPack buffer protocol,\n"
+            "so they can be passed directly to Plugin.process /\n"
+            "PluginChain.process / minihost.write_audio without an explicit\n"
+            "conversion. Views made with frame_view() are strided, not\n"
+            "contiguous; DLPack export carries the real strides, so\n"
+            "stride-aware consumers (numpy, process_into, ...) alias them,\n"
+            "while contiguous-only APIs (Plugin.process etc.) do not.\n\n"
             "2-axis indexing follows numpy conventions with deliberate limits:\n"
             "  buf[ch, fr]                -> float\n"
             "  buf[ch_slice, fr_slice]    -> same-dtype buffer (copy, not view)\n"
@@ -2878,7 +6829,7 @@ NB_MODULE(_core, m) {
                                               self.channels(), "channel");
                      int fr = normalize_index(nb::cast<int>(fr_key),
                                               self.frames(), "frame");
-                     return nb::cast(self.data()[(size_t)ch * self.frames() + fr]);
+                     return nb::cast(self.data()[(size_t)ch * self.row_stride() + fr]);
                  }
 
                  // Slice or scalar mixed -> new AudioBuffer (copy).
@@ -2893,7 +6844,7 @@ NB_MODULE(_core, m) {
                  auto* out = new MhAudioBuffer(ch_count, fr_count);
                  const T* src = self.data();
                  T* dst = out->data();
-                 const size_t src_stride = (size_t)self.frames();
+                 const size_t src_stride = self.row_stride();
                  const size_t dst_stride = (size_t)fr_count;
                  const size_t bytes = (size_t)fr_count * sizeof(T);
                  for (int i = 0; i < ch_count; ++i) {
@@ -2915,7 +6866,7 @@ NB_MODULE(_core, m) {
                                                               "frame");
 
                  T* dst = self.data();
-                 const size_t dst_stride = (size_t)self.frames();
+                 const size_t dst_stride = self.row_stride();
                  const size_t bytes = (size_t)fr_count * sizeof(T);
 
                  // Scalar broadcast.
@@ -2997,12 +6948,19 @@ NB_MODULE(_core, m) {
              [](const MhAudioBuffer& self) {
                  auto* out = new MhAudioBuffer(self.channels(),
                                                self.frames());
-                 std::memcpy(out->data(), self.data(),
-                             (size_t)self.channels() * self.frames()
-                                 * sizeof(T));
+                 // Per-row copy so strided frame views compact into a
+                 // contiguous buffer; for contiguous sources this is the
+                 // same bytes as one big memcpy.
+                 for (int c = 0; c < self.channels(); ++c) {
+                     std::memcpy(out->data() + (size_t)c * self.frames(),
+                                 self.data() + (size_t)c * self.row_stride(),
+                                 (size_t)self.frames() * sizeof(T));
+                 }
                  return nb::cast(out, nb::rv_policy::take_ownership);
              },
-             "Return a deep copy of this buffer.")
+             "Return a deep copy of this buffer. The copy is always "
+             "contiguous, so copying a frame_view yields a standalone "
+             "buffer that DLPack consumers accept.")
 
         // ---- Extended JUCE DSP ops ----
         // Each is a thin wrapper over juce::AudioBuffer<float>'s
@@ -3150,6 +7108,248 @@ NB_MODULE(_core, m) {
              "Reverse a single channel's sample order in place over "
              "[start, start+count). Defaults to the whole channel.")
 
+        // ---- Fades / crossfades ----
+        // Linear shapes delegate to JUCE's SIMD gain ramps; equal-power
+        // shapes precompute one gain table and apply it per channel, so
+        // the trig cost is paid once regardless of channel count.
+        .def("fade_in",
+             [](MhAudioBuffer& self, int count,
+                int start, const std::string& shape) {
+                 bool eq = parseFadeShape(shape);
+                 if (start < 0 || count < 0
+                     || start + count > self.frames()) {
+                     throw nb::value_error("fade_in range out of bounds");
+                 }
+                 if (count == 0) return;
+                 if (!eq) {
+                     self.juce().applyGainRamp(start, count, 0.0f, 1.0f);
+                     return;
+                 }
+                 std::vector<T> g((size_t)count);
+                 for (int i = 0; i < count; ++i)
+                     g[(size_t)i] = (T)fadeGainAt((double)i / count, true);
+                 for (int ch = 0; ch < self.channels(); ++ch) {
+                     T* d = self.juce().getWritePointer(ch) + start;
+                     for (int i = 0; i < count; ++i)
+                         d[i] *= g[(size_t)i];
+                 }
+             },
+             "count"_a, "start"_a = 0, "shape"_a = "linear",
+             "Fade in from silence across [start, start+count) samples on "
+             "all channels in place. `shape` is 'linear' (a straight gain "
+             "ramp, same as apply_gain_ramp(start, count, 0, 1)) or "
+             "'equal_power' (sine-shaped, the fade-in leg of an "
+             "equal-power crossfade).")
+        .def("fade_out",
+             [](MhAudioBuffer& self, int count,
+                std::optional<int> start_opt, const std::string& shape) {
+                 bool eq = parseFadeShape(shape);
+                 int start = start_opt.value_or(self.frames() - count);
+                 if (start < 0 || count < 0
+                     || start + count > self.frames()) {
+                     throw nb::value_error("fade_out range out of bounds");
+                 }
+                 if (count == 0) return;
+                 if (!eq) {
+                     self.juce().applyGainRamp(start, count, 1.0f, 0.0f);
+                     return;
+                 }
+                 std::vector<T> g((size_t)count);
+                 for (int i = 0; i < count; ++i)
+                     g[(size_t)i] =
+                         (T)fadeGainAt(1.0 - (double)i / count, true);
+                 for (int ch = 0; ch < self.channels(); ++ch) {
+                     T* d = self.juce().getWritePointer(ch) + start;
+                     for (int i = 0; i < count; ++i)
+                         d[i] *= g[(size_t)i];
+                 }
+             },
+             "count"_a, "start"_a = nb::none(), "shape"_a = "linear",
+             "Fade out to silence across [start, start+count) samples on "
+             "all channels in place. `start` defaults to frames - count "
+             "(the tail of the buffer). `shape` is 'linear' or "
+             "'equal_power' (the fade-out leg of an equal-power "
+             "crossfade).")
+        .def("crossfade_from",
+             [](MhAudioBuffer& self, const MhAudioBuffer& source,
+                std::optional<int> count_opt,
+                int start, int source_start, const std::string& shape) {
+                 bool eq = parseFadeShape(shape);
+                 if (source.channels() != self.channels()) {
+                     throw nb::value_error(
+                         ("source has " +
+                          std::to_string(source.channels()) +
+                          " channel(s), buffer has " +
+                          std::to_string(self.channels())).c_str());
+                 }
+                 if (start < 0 || start > self.frames()
+                     || source_start < 0
+                     || source_start > source.frames()) {
+                     throw nb::value_error("crossfade range out of bounds");
+                 }
+                 int count = count_opt.value_or(
+                     std::min(self.frames() - start,
+                              source.frames() - source_start));
+                 if (count < 0 || start + count > self.frames()
+                     || source_start + count > source.frames()) {
+                     throw nb::value_error("crossfade range out of bounds");
+                 }
+                 if (count == 0) return;
+                 if (!eq) {
+                     // Both legs are plain linear ramps, so the whole
+                     // crossfade is two SIMD passes.
+                     self.juce().applyGainRamp(start, count, 1.0f, 0.0f);
+                     for (int ch = 0; ch < self.channels(); ++ch) {
+                         const T* s = source.juce().getReadPointer(ch)
+                                      + source_start;
+                         self.juce().addFromWithRamp(ch, start, s, count,
+                                                     0.0f, 1.0f);
+                     }
+                     return;
+                 }
+                 std::vector<T> gin((size_t)count);
+                 std::vector<T> gout((size_t)count);
+                 for (int i = 0; i < count; ++i) {
+                     double t = (double)i / count;
+                     gin[(size_t)i] = (T)fadeGainAt(t, true);
+                     gout[(size_t)i] = (T)fadeGainAt(1.0 - t, true);
+                 }
+                 for (int ch = 0; ch < self.channels(); ++ch) {
+                     T* d = self.juce().getWritePointer(ch) + start;
+                     const T* s = source.juce().getReadPointer(ch)
+                                  + source_start;
+                     for (int i = 0; i < count; ++i)
+                         d[i] = d[i] * gout[(size_t)i]
+                                + s[i] * gin[(size_t)i];
+                 }
+             },
+             "source"_a, "count"_a = nb::none(), "start"_a = 0,
+             "source_start"_a = 0, "shape"_a = "equal_power",
+             "Crossfade from this buffer into `source` in place: over "
+             "[start, start+count) this buffer fades out while "
+             "source[source_start : source_start+count] fades in, and the "
+             "mix is written back into this buffer. `count` defaults to "
+             "the largest range both buffers cover. `shape` is "
+             "'equal_power' (default -- constant perceived level through "
+             "the transition) or 'linear'. Channel counts must match. "
+             "This is the same transition the chain hot-swap path renders "
+             "natively; use it to splice takes or patch edits without a "
+             "numpy round trip.")
+
+        // ---- Fused op batches ----
+        // Executes a list of BufferOps in a single traversal of the sample
+        // data. Ops apply per sample in list order, so a measure placed
+        // after a gain observes the scaled signal and one placed before it
+        // observes the raw signal. Fades resolve to gain ramps against this
+        // buffer's frame count up front, so the hot loop never branches on
+        // bounds.
+        .def("apply",
+             [](MhAudioBuffer& self, const std::vector<BufferOp>& ops)
+                 -> nb::object {
+                 const int frames = self.frames();
+                 struct Step {
+                     BufferOp::Kind kind;
+                     double g0, g1;
+                     int start, count;
+                 };
+                 std::vector<Step> steps;
+                 steps.reserve(ops.size());
+                 const BufferOp* measure = nullptr;
+                 for (const BufferOp& op : ops) {
+                     Step st{op.kind, op.gain0, op.gain1, op.start, op.count};
+                     switch (op.kind) {
+                     case BufferOp::Gain:
+                         break;
+                     case BufferOp::GainRamp:
+                         if (op.start < 0 || op.count < 0
+                             || op.start + op.count > frames) {
+                             throw nb::value_error(
+                                 "gain_ramp range out of bounds");
+                         }
+                         break;
+                     case BufferOp::FadeIn:
+                         if (op.count < 0 || op.count > frames) {
+                             throw nb::value_error(
+                                 "fade_in length out of bounds");
+                         }
+                         st.kind = BufferOp::GainRamp;
+                         st.start = 0;
+                         break;
+                     case BufferOp::FadeOut:
+                         if (op.count < 0 || op.count > frames) {
+                             throw nb::value_error(
+                                 "fade_out length out of bounds");
+                         }
+                         st.kind = BufferOp::GainRamp;
+                         st.start = frames - op.count;
+                         break;
+                     case BufferOp::Measure:
+                         if (measure != nullptr) {
+                             throw nb::value_error(
+                                 "at most one measure op per batch");
+                         }
+                         measure = &op;
+                         break;
+                     }
+                     steps.push_back(st);
+                 }
+
+                 double peak = 0.0, sumsq = 0.0;
+                 for (int ch = 0; ch < self.channels(); ++ch) {
+                     T* p = self.juce().getWritePointer(ch);
+                     for (int j = 0; j < frames; ++j) {
+                         double v = (double)p[j];
+                         for (const Step& st : steps) {
+                             switch (st.kind) {
+                             case BufferOp::Gain:
+                                 v *= st.g0;
+                                 break;
+                             case BufferOp::GainRamp:
+                                 // Samples outside the ramp window pass
+                                 // through, matching apply_gain_ramp.
+                                 if (j >= st.start
+                                     && j < st.start + st.count) {
+                                     v *= st.g0 + (st.g1 - st.g0)
+                                              * (double)(j - st.start)
+                                              / (double)st.count;
+                                 }
+                                 break;
+                             case BufferOp::Measure: {
+                                 const double a = v < 0.0 ? -v : v;
+                                 if (a > peak) peak = a;
+                                 sumsq += v * v;
+                                 break;
+                             }
+                             default:
+                                 break;  // fades were resolved above
+                             }
+                         }
+                         p[j] = (T)v;
+                     }
+                 }
+
+                 if (measure == nullptr) {
+                     return nb::none();
+                 }
+                 nb::dict result;
+                 if (measure->want_peak) {
+                     result["peak"] = peak;
+                 }
+                 if (measure->want_rms) {
+                     const size_t n = (size_t)self.channels() * frames;
+                     result["rms"] =
+                         n > 0 ? std::sqrt(sumsq / (double)n) : 0.0;
+                 }
+                 return std::move(result);
+             },
+             "ops"_a,
+             "Execute a batch of BufferOps as one fused traversal of the "
+             "sample data (one memory pass instead of one per op). Ops "
+             "apply per sample in list order; place a BufferOp.measure "
+             "after the processing ops to observe the processed signal. "
+             "Returns a dict of measurements ('peak' and/or 'rms') if the "
+             "batch contains a measure op, else None.")
+
         // ---- Zero-copy channel-range view ----
         .def("channel_view",
              [](nb::handle self_h, int start, int count) {
@@ -3167,7 +7367,7 @@ NB_MODULE(_core, m) {
                  }
                  auto* view = new MhAudioBuffer(
                      typename MhAudioBuffer::AliasTag{},
-                     ptrs.data(), count, self.frames());
+                     ptrs.data(), count, self.frames(), self.row_stride());
                  return nb::cast(view, nb::rv_policy::take_ownership);
              },
              "start"_a, "count"_a, nb::keep_alive<0, 1>(),
@@ -3175,9 +7375,44 @@ NB_MODULE(_core, m) {
              "channel range [start, start+count) of this buffer. Writes "
              "through the view are visible in the parent and vice versa. The "
              "parent is kept alive for the view's lifetime; do not resize the "
-             "parent while a view exists. Only channel ranges are supported "
-             "(channels are contiguous); frame slicing would require strided "
-             "views and is not offered.")
+             "parent while a view exists. For frame ranges see frame_view().")
+
+        // ---- Zero-copy frame-range view ----
+        // Unlike channel_view, the result is strided: its channel rows are
+        // parent-row-stride apart, not view-frames apart. DLPack export
+        // carries the real strides, so numpy and other stride-aware
+        // consumers alias it transparently; APIs that require contiguous
+        // input (Plugin.process and friends) never alias it -- use .copy()
+        // or the *_into variants there.
+        .def("frame_view",
+             [](nb::handle self_h, int start, int count) {
+                 auto& self = nb::cast<MhAudioBuffer&>(self_h);
+                 if (start < 0 || count < 1 ||
+                     start + count > self.frames()) {
+                     throw nb::value_error(
+                         "frame_view range out of bounds "
+                         "(need start >= 0, count >= 1, "
+                         "start + count <= frames)");
+                 }
+                 std::vector<T*> ptrs((size_t)self.channels());
+                 for (int c = 0; c < self.channels(); ++c) {
+                     ptrs[(size_t)c] = self.juce().getWritePointer(c) + start;
+                 }
+                 auto* view = new MhAudioBuffer(
+                     typename MhAudioBuffer::AliasTag{},
+                     ptrs.data(), self.channels(), count, self.row_stride());
+                 return nb::cast(view, nb::rv_policy::take_ownership);
+             },
+             "start"_a, "count"_a, nb::keep_alive<0, 1>(),
+             "Return a new AudioBuffer aliasing (zero-copy) the frame range "
+             "[start, start+count) of every channel of this buffer. Writes "
+             "through the view are visible in the parent and vice versa; the "
+             "parent is kept alive for the view's lifetime. The view is "
+             "strided (not contiguous): numpy and other stride-aware DLPack "
+             "consumers alias it zero-copy, but contiguous-only consumers "
+             "such as Plugin.process will not -- use .copy() for those, or "
+             "the process_into/render_block_into variants, which accept "
+             "strided buffers.")
 
         // ---- Buffer-protocol export (DLPack) ----
         // Allows Plugin.process(buf, out) etc. to consume AudioBuffer
@@ -3187,14 +7422,18 @@ NB_MODULE(_core, m) {
                  auto& self = nb::cast<MhAudioBuffer&>(self_h);
                  size_t shape[2] = { (size_t)self.channels(),
                                      (size_t)self.frames() };
-                 return nb::ndarray<T, nb::shape<-1, -1>, nb::c_contig,
+                 // Explicit strides: {frames, 1} for ordinary buffers (i.e.
+                 // contiguous), {parent_row_stride, 1} for frame views.
+                 int64_t strides[2] = { (int64_t)self.row_stride(), 1 };
+                 return nb::ndarray<T, nb::shape<-1, -1>,
                                     nb::device::cpu>(
-                     self.data(), 2, shape, self_h);
+                     self.data(), 2, shape, self_h, strides);
              },
              "stream"_a = nb::none(),
              "DLPack export. Consumers like nanobind's nb::ndarray and "
              "numpy.asarray call this to obtain a zero-copy view. AudioBufferD "
-             "exports float64, so it feeds Plugin.process_double directly.")
+             "exports float64, so it feeds Plugin.process_double directly. "
+             "Frame views export their real (non-contiguous) strides.")
         .def("__dlpack_device__",
              [](const MhAudioBuffer&) {
                  return nb::make_tuple(1, 0);  // (kDLCPU, device_id=0)
@@ -3213,9 +7452,9 @@ NB_MODULE(_core, m) {
                  auto& self = nb::cast<MhAudioBuffer&>(self_h);
                  size_t shape[2] = { (size_t)self.channels(),
                                      (size_t)self.frames() };
-                 return nb::ndarray<nb::numpy, T, nb::shape<-1, -1>,
-                                    nb::c_contig>(
-                     self.data(), 2, shape, self_h);
+                 int64_t strides[2] = { (int64_t)self.row_stride(), 1 };
+                 return nb::ndarray<nb::numpy, T, nb::shape<-1, -1>>(
+                     self.data(), 2, shape, self_h, strides);
              },
              "Return a numpy.ndarray view of this buffer (zero-copy). "
              "Requires numpy installed; raises ImportError otherwise.")
@@ -3228,9 +7467,9 @@ NB_MODULE(_core, m) {
                  auto& self = nb::cast<MhAudioBuffer&>(self_h);
                  size_t shape[2] = { (size_t)self.channels(),
                                      (size_t)self.frames() };
-                 return nb::ndarray<nb::numpy, T, nb::shape<-1, -1>,
-                                    nb::c_contig>(
-                     self.data(), 2, shape, self_h);
+                 int64_t strides[2] = { (int64_t)self.row_stride(), 1 };
+                 return nb::ndarray<nb::numpy, T, nb::shape<-1, -1>>(
+                     self.data(), 2, shape, self_h, strides);
              },
              "dtype"_a = nb::none(), "copy"_a = nb::none(),
              "numpy interop hook. Returns a numpy ndarray view (zero-copy). "
@@ -3247,12 +7486,161 @@ NB_MODULE(_core, m) {
                  return nb::cast(buf, nb::rv_policy::take_ownership);
              }, "array"_a,
              "Construct a new buffer by copying from a 2D c-contiguous array "
-             "of matching dtype (numpy ndarray, another buffer, etc.).");
+             "of matching dtype (numpy ndarray, another buffer, etc.).")
+
+        // ---- shared memory (POSIX; multiprocess pipelines) ----
+        .def_static("create_shared",
+             [](const std::string& name, int channels, int frames) -> nb::object {
+#ifndef _WIN32
+                 return nb::cast(shm_create<T>(name, channels, frames),
+                                 nb::rv_policy::take_ownership);
+#else
+                 (void)name; (void)channels; (void)frames;
+                 throw std::runtime_error(
+                     "Shared-memory buffers are not supported on Windows");
+#endif
+             }, "name"_a, "channels"_a, "frames"_a,
+             "Allocate a zero-initialized buffer whose sample block lives in "
+             "named POSIX shared memory (shm_open). Another process can map "
+             "the same block zero-copy with attach_shared(name), so a decoder "
+             "process, a render process, and an encoder process can hand off "
+             "audio without pickling. Layout, indexing, and DLPack export are "
+             "identical to an ordinary buffer. The name must be unused "
+             "(raises if it already exists) and persists until unlink_shared; "
+             "closing buffers only unmaps. No cross-process locking is "
+             "provided -- sequence writers and readers externally.")
+        .def_static("attach_shared",
+             [](const std::string& name) -> nb::object {
+#ifndef _WIN32
+                 return nb::cast(shm_attach<T>(name),
+                                 nb::rv_policy::take_ownership);
+#else
+                 (void)name;
+                 throw std::runtime_error(
+                     "Shared-memory buffers are not supported on Windows");
+#endif
+             }, "name"_a,
+             "Map an existing shared segment made by create_shared. The shape "
+             "is read from the segment header; the dtype must match this "
+             "class (attaching a float64 segment as AudioBuffer raises, and "
+             "vice versa). Writes are visible to every attached process.")
+        .def_static("unlink_shared",
+             [](const std::string& name) {
+#ifndef _WIN32
+                 std::string path = shm_path(name);
+                 if (shm_unlink(path.c_str()) != 0)
+                     throw std::runtime_error("shm_unlink('" + path +
+                                              "') failed: " +
+                                              std::strerror(errno));
+#else
+                 (void)name;
+                 throw std::runtime_error(
+                     "Shared-memory buffers are not supported on Windows");
+#endif
+             }, "name"_a,
+             "Remove a shared segment's name (shm_unlink). Call once, from "
+             "one process, when the pipeline is done; processes still "
+             "attached keep their mapping until their buffers are dropped.");
     };  // bind_audio_buffer
 
     bind_audio_buffer(float{},  "AudioBuffer",  "float32");
     bind_audio_buffer(double{}, "AudioBufferD", "float64");
 
+    nb::class_<BufferOp>(m, "BufferOp",
+        "One step of a fused DSP batch for AudioBuffer.apply().\n\n"
+        "Construct via the static factories (gain, gain_ramp, fade_in, "
+        "fade_out, measure); a list of BufferOps passed to apply() executes "
+        "as a single traversal of the buffer, so chaining gain + fade + "
+        "peak/RMS measurement costs one memory pass instead of three.")
+        .def_static("gain",
+             [](double g) {
+                 BufferOp op;
+                 op.kind = BufferOp::Gain;
+                 op.gain0 = g;
+                 return op;
+             }, "gain"_a,
+             "Multiply every sample by `gain`.")
+        .def_static("gain_ramp",
+             [](int start, int count, double gain_start, double gain_end) {
+                 if (count < 0) {
+                     throw nb::value_error("count must be >= 0");
+                 }
+                 BufferOp op;
+                 op.kind = BufferOp::GainRamp;
+                 op.start = start;
+                 op.count = count;
+                 op.gain0 = gain_start;
+                 op.gain1 = gain_end;
+                 return op;
+             }, "start"_a, "count"_a, "gain_start"_a, "gain_end"_a,
+             "Linear gain ramp across [start, start+count); samples outside "
+             "the range pass through (matches apply_gain_ramp).")
+        .def_static("fade_in",
+             [](int count) {
+                 if (count < 0) {
+                     throw nb::value_error("count must be >= 0");
+                 }
+                 BufferOp op;
+                 op.kind = BufferOp::FadeIn;
+                 op.count = count;
+                 op.gain0 = 0.0;
+                 op.gain1 = 1.0;
+                 return op;
+             }, "count"_a,
+             "Linear fade from 0 to 1 across the first `count` frames.")
+        .def_static("fade_out",
+             [](int count) {
+                 if (count < 0) {
+                     throw nb::value_error("count must be >= 0");
+                 }
+                 BufferOp op;
+                 op.kind = BufferOp::FadeOut;
+                 op.count = count;
+                 op.gain0 = 1.0;
+                 op.gain1 = 0.0;
+                 return op;
+             }, "count"_a,
+             "Linear fade from 1 to 0 across the last `count` frames.")
+        .def_static("measure",
+             [](bool peak, bool rms) {
+                 BufferOp op;
+                 op.kind = BufferOp::Measure;
+                 op.want_peak = peak;
+                 op.want_rms = rms;
+                 return op;
+             }, "peak"_a = true, "rms"_a = false,
+             "Record the peak absolute value and/or RMS of the signal as it "
+             "stands at this point in the op list (across all channels). "
+             "At most one measure per batch; results come back from apply() "
+             "as a dict.");
+
+    nb::class_<BufferPool>(m, "BufferPool",
+        "Recycling pool of fixed-shape AudioBuffers for block loops.\n\n"
+        "Preallocates `capacity` buffers of shape (channels, frames); "
+        "acquire() hands one out and release() returns it for reuse, so "
+        "a steady-state loop constructs no new buffers. Recycled buffers "
+        "keep their previous contents -- clear or overwrite after "
+        "acquiring. Exhausting the pool grows it by one per acquire.")
+        .def(nb::init<int, int, int>(),
+             nb::arg("channels"), nb::arg("frames"), nb::arg("capacity") = 8,
+             "Preallocate `capacity` AudioBuffers of shape (channels, frames).")
+        .def("acquire", &BufferPool::acquire,
+             "Take a buffer from the pool (allocating only if the pool is "
+             "exhausted). The buffer's contents are whatever the previous "
+             "user left in it.")
+        .def("release", &BufferPool::release, nb::arg("buf"),
+             "Return a buffer to the pool. The buffer must match the "
+             "pool's shape; releasing the same buffer twice raises.")
+        .def_prop_ro("channels", &BufferPool::channels,
+                     "Channel count of pooled buffers.")
+        .def_prop_ro("frames", &BufferPool::frames,
+                     "Frame count of pooled buffers.")
+        .def_prop_ro("available", &BufferPool::available,
+                     "Buffers currently in the pool (not handed out).")
+        .def_prop_ro("total", &BufferPool::total,
+                     "Buffers ever created by this pool (capacity plus "
+                     "any growth from exhausted acquires).");
+
     nb::class_<Plugin>(m, "Plugin",
         "A loaded audio plugin (VST3 or AudioUnit).\n\n"
         "Threading: construction, destruction, and thread-affine control "
@@ -3275,6 +7663,10 @@ NB_MODULE(_core, m) {
              nb::arg("in_channels") = 2,
              nb::arg("out_channels") = 2,
              nb::arg("sidechain_channels") = 0,
+             // Released GIL: module discovery runs on the calling
+             // thread, so Python threads opening several plugins
+             // overlap the expensive dlopen/scan work.
+             nb::call_guard<nb::gil_scoped_release>(),
              "Open an audio plugin (VST3 or AudioUnit). Use sidechain_channels > 0 for sidechain support.")
 
         .def_static("from_descriptor", &Plugin::from_descriptor,
@@ -3284,6 +7676,7 @@ NB_MODULE(_core, m) {
              nb::arg("in_channels") = 2,
              nb::arg("out_channels") = 2,
              nb::rv_policy::take_ownership,
+             nb::call_guard<nb::gil_scoped_release>(),
              "Open a plugin from a serialized juce::PluginDescription (its "
              "createXml() form). Required for AudioUnits, which have no file "
              "path. descriptor_xml is the UTF-8 XML string.")
@@ -3317,6 +7710,10 @@ NB_MODULE(_core, m) {
                      "Number of output buses")
         .def_prop_rw("sample_rate", &Plugin::get_sample_rate, &Plugin::set_sample_rate,
                      "Current sample rate (can be changed without reloading)")
+        .def_prop_ro("max_block_size",
+                     [](const Plugin& p) { return p.get_max_block_size(); },
+                     "The max_block_size the plugin was prepared with. Any "
+                     "block up to this size processes without reallocation.")
 
         // Bus layout
         .def("get_bus_info", &Plugin::get_bus_info,
@@ -3330,12 +7727,27 @@ NB_MODULE(_core, m) {
         .def("set_param", &Plugin::set_param,
              nb::arg("index"), nb::arg("value"),
              "Set parameter value (normalized 0-1)")
+        .def("set_params", &Plugin::set_params,
+             nb::arg("params"),
+             "Set a batch of parameters from (index, value) pairs under a "
+             "single state-lock acquisition. Values are clamped to [0, 1]. "
+             "Batch writes skip per-parameter value-callback notifications "
+             "(intended for restoring large snapshots). Indices are "
+             "validated before anything is written.")
         .def("get_param_info", &Plugin::get_param_info,
              nb::arg("index"),
              "Get parameter metadata as dict")
+        .def("get_all_param_info", &Plugin::get_all_param_info,
+             "Get metadata dicts for all parameters in a single call "
+             "(much faster than get_param_info in a loop on large "
+             "instruments)")
         .def("find_param", &Plugin::find_param,
              nb::arg("name"),
              "Find parameter index by name (case-insensitive). Raises RuntimeError if not found.")
+        .def("find_param_by_id", &Plugin::find_param_by_id,
+             nb::arg("param_id"),
+             "Find parameter index by stable parameter ID (exact match, "
+             "hash lookup). Returns -1 if not found.")
         .def("get_param_by_name", &Plugin::get_param_by_name,
              nb::arg("name"),
              "Get parameter value by name (case-insensitive)")
@@ -3357,6 +7769,36 @@ NB_MODULE(_core, m) {
              "Interpolate snapshots a and b at blend t (a + (b-a)*t, clamped "
              "to [0, 1]) and apply the result to the plugin. Returns the "
              "applied snapshot. Raises ValueError on length mismatch.")
+        .def("params_diff", &Plugin::params_diff,
+             nb::arg("baseline"),
+             "Diff current parameters against a baseline snapshot (from "
+             "morph_capture), returning a list of (index, value) pairs for "
+             "only the parameters that changed. Comparison is exact, so "
+             "untouched parameters never appear. Feed the pairs to "
+             "set_params for minimal-delta preset application. Raises "
+             "ValueError if len(baseline) != num_params.")
+        .def("apply_morph", &Plugin::apply_morph,
+             nb::arg("automation"), nb::arg("sample"),
+             "Apply a MorphAutomation's blend at an absolute sample "
+             "position: interpolate the whole snapshot natively and write "
+             "it as one batched parameter update. Returns the blend amount "
+             "applied. Raises ValueError if the automation's snapshot "
+             "length differs from the plugin's parameter count.")
+        .def("apply_morph_pair", &Plugin::apply_morph_pair,
+             nb::arg("pair"), nb::arg("t"),
+             "Interpolate a MorphPair's active set at blend amount t and "
+             "write it as one batched parameter update. Only parameters "
+             "whose endpoints differ are written, so a live sweep over a "
+             "big patch costs O(changed) per step instead of O(params). "
+             "The pair must have been built from snapshots of this "
+             "plugin's parameter count.")
+        .def("apply_curves", &Plugin::apply_curves,
+             nb::arg("automation"), nb::arg("sample"),
+             "Evaluate a KeyframeAutomation at an absolute sample position "
+             "and write every curve's value as one batched parameter "
+             "update. Call once per block from a render loop. Returns the "
+             "number of parameters written. Raises ValueError if a curve's "
+             "parameter index exceeds the plugin's parameter count.")
 
         .def("param_to_text", &Plugin::param_to_text,
              nb::arg("index"), nb::arg("value"),
@@ -3364,6 +7806,13 @@ NB_MODULE(_core, m) {
         .def("param_from_text", &Plugin::param_from_text,
              nb::arg("index"), nb::arg("text"),
              "Convert display string to normalized value (0-1)")
+        .def("params_to_text", &Plugin::params_to_text,
+             nb::arg("requests"),
+             "Batched param_to_text: requests is a list of (index, "
+             "value) pairs, converted with one lock instead of one "
+             "per call. Returns the display strings in request order; "
+             "out-of-range indices yield empty strings. The same "
+             "index may appear more than once (e.g. min/default/max).")
 
         // Factory presets (programs)
         .def_prop_ro("num_programs", &Plugin::num_programs,
@@ -3373,6 +7822,22 @@ NB_MODULE(_core, m) {
              "Get name of factory preset at index")
         .def_prop_rw("program", &Plugin::get_program, &Plugin::set_program,
                      "Current factory preset index")
+        .def("prefetch_programs", &Plugin::prefetch_programs,
+             "Capture every factory program's state blob into an "
+             "in-memory bank (pays the slow program-change path once, "
+             "audibly cycling through the bank; the GIL is released). "
+             "Returns the number of programs cached. Afterwards "
+             "set_program_fast restores from the cache.")
+        .def("set_program_fast", &Plugin::set_program_fast,
+             nb::arg("index"),
+             "Restore a program from the prefetched bank, skipping "
+             "the plugin's program-change machinery. Not safe while "
+             "audio is processing (same contract as set_program_state). "
+             "Note: plugins that don't encode the program number in "
+             "their program state may keep reporting the old index "
+             "via the program property.")
+        .def("clear_program_cache", &Plugin::clear_program_cache,
+             "Free the prefetched program bank.")
 
         // State
         .def("get_state", &Plugin::get_state,
@@ -3380,6 +7845,32 @@ NB_MODULE(_core, m) {
         .def("set_state", &Plugin::set_state,
              nb::arg("data"),
              "Restore plugin state from bytes")
+        .def("restore", &Plugin::restore,
+             nb::arg("state") = nb::none(),
+             nb::arg("program") = -1,
+             nb::arg("params") = std::vector<std::pair<int, float>>{},
+             "Batched restore: apply a state blob, a program change, and "
+             "a list of (param_index, normalized_value) writes in one hop "
+             "to the plugin thread. Each piece is optional (state=None, "
+             "program=-1, params=[] to skip). Restoring via separate "
+             "set_state / program / set_param calls pays a cross-thread "
+             "round trip per call; this pays one total.")
+        .def("swap_standby", &Plugin::swap_standby,
+             nb::arg("standby"),
+             "Stage `standby` (a warm clone from Session.standby, "
+             "typically holding an alternate state) to take over this "
+             "plugin's role. The next process call adopts it at a block "
+             "boundary: the two handles exchange engine instances, so "
+             "the state switch is a few pointer swaps instead of a "
+             "seconds-long set_state on a big sampler. The displaced "
+             "engine lands in `standby`, still warm, ready to be staged "
+             "back. Do not call control/state methods on either plugin, "
+             "or close either one, while swap_pending is True. Raises "
+             "RuntimeError on mismatched bundle, rate, block size or "
+             "channel layout.")
+        .def("swap_pending", &Plugin::swap_pending,
+             "True while a swap staged with swap_standby has not yet "
+             "been adopted by a process call.")
 
         // Bypass
         .def_prop_rw("bypass", &Plugin::get_bypass, &Plugin::set_bypass,
@@ -3389,10 +7880,41 @@ NB_MODULE(_core, m) {
         .def("reset", &Plugin::reset,
              "Reset internal state (clears delay lines, reverb tails, etc.)")
 
+        // Warm-up
+        .def("warmup", &Plugin::warmup,
+             nb::arg("blocks") = 8,
+             "Process `blocks` silence blocks in non-realtime mode, then reset. "
+             "Takes the plugin's one-time first-process costs (lazy allocations, "
+             "table builds, page faults) up front so the first real block -- "
+             "especially one inside a device callback -- runs at steady-state "
+             "speed. AudioDevice.start() does this automatically.")
+        .def("set_lock_memory", &Plugin::set_lock_memory,
+             nb::arg("enabled"),
+             "Pin (mlock) the host-side process buffers so the OS "
+             "cannot evict them between callbacks; pair with warmup() "
+             "to pre-fault plugin-internal pages. Returns True when "
+             "the requested state is in effect, False when the lock "
+             "was refused (typically RLIMIT_MEMLOCK) -- the graceful "
+             "fallback, not an error. All-or-nothing: a refusal rolls "
+             "back any partial pins.")
+        .def_prop_ro("locked_bytes", &Plugin::get_locked_bytes,
+                     "Bytes currently pinned by set_lock_memory (0 when "
+                     "unpinned or the lock was refused).")
+
         // Non-realtime mode
         .def_prop_rw("non_realtime", &Plugin::get_non_realtime, &Plugin::set_non_realtime,
                      "Non-realtime mode (enables higher-quality algorithms for offline processing)")
 
+        // Denormal control
+        .def_prop_rw("denormal_control", &Plugin::get_denormal_control,
+                     &Plugin::set_denormal_control,
+                     "Flush-to-zero/denormals-are-zero around process calls (default True). "
+                     "Disable only for plugins that depend on gradual underflow; the FP "
+                     "environment is saved and restored around every call either way.")
+        .def_prop_ro("denormal_hits", &Plugin::get_denormal_hits,
+                     "Number of process calls that observed a denormal operand or flushed "
+                     "an underflow. Monotonic; useful for attributing block-time spikes.")
+
         // Transport
         .def("set_transport", &Plugin::set_transport,
              nb::arg("bpm"),
@@ -3413,6 +7935,41 @@ NB_MODULE(_core, m) {
         .def("process", &Plugin::process,
              nb::arg("input"), nb::arg("output"),
              "Process audio (shape: [channels, frames])")
+        .def("process_into", &Plugin::process_into,
+             nb::arg("input"), nb::arg("output"),
+             "Process audio between two caller-owned AudioBuffers with "
+             "zero per-call allocation; the GIL is released while the "
+             "plugin runs. The fast path for tight block loops -- same "
+             "semantics as process() but AudioBuffer-only.")
+        .def("process_interleaved", &Plugin::process_interleaved,
+             nb::arg("input"), nb::arg("output"),
+             "Process interleaved audio (shape: [frames, channels], "
+             "C-contiguous -- the layout device callbacks and audio "
+             "files use). The de/interleave happens once inside the "
+             "library, straight into the plugin's process buffer; the "
+             "GIL is released while the plugin runs. Channels beyond "
+             "the plugin's bus widths are ignored on input and "
+             "zero-filled on output.")
+        .def("process_blocks", &Plugin::process_blocks,
+             nb::arg("input"), nb::arg("output"), nb::arg("block_size"),
+             nb::arg("progress") = nb::none(), nb::arg("progress_interval") = 64,
+             "Batch render: process one large [channels, frames] pair in "
+             "block_size sub-blocks with the GIL released for the whole "
+             "batch -- one binding crossing per render instead of one per "
+             "block. progress, if given, is called as progress(blocks_done, "
+             "total_blocks) every progress_interval blocks (with the GIL "
+             "re-acquired). No MIDI; use process_midi_timeline for that.")
+        .def("detect_tail", &Plugin::detect_tail,
+             nb::arg("block_size") = 512, nb::arg("threshold_db") = -80.0,
+             nb::arg("hold_blocks") = 4, nb::arg("max_seconds") = 30.0,
+             "Hunt the plugin's decay tail natively: process silence blocks "
+             "with the GIL released, scanning the output peak per block, "
+             "until the level holds below threshold_db for hold_blocks "
+             "consecutive blocks (or max_seconds elapse). Returns the tail "
+             "length in frames -- the end of the last block that exceeded "
+             "the threshold. Mutates plugin state (the tail is rendered); "
+             "call it right after the content you want the tail of, or "
+             "after reset() plus an impulse to measure a clean decay.")
         .def("process_midi", &Plugin::process_midi,
              nb::arg("input"), nb::arg("output"), nb::arg("midi_in"),
              nb::arg("midi_out_capacity") = MIDI_OUT_CAPACITY,
@@ -3420,6 +7977,15 @@ NB_MODULE(_core, m) {
              "Returns the list of output MIDI events. At most midi_out_capacity "
              "(default 256) events are returned; a returned count equal to "
              "midi_out_capacity means output may have been truncated -- raise it if so.")
+        .def("process_midi_timeline", &Plugin::process_midi_timeline,
+             nb::arg("input"), nb::arg("output"), nb::arg("timeline"),
+             nb::arg("start"),
+             nb::arg("midi_out_capacity") = MIDI_OUT_CAPACITY,
+             "Process one block against a MidiEventTimeline: events with "
+             "absolute sample positions in [start, start + frames) are "
+             "binary-searched and fed with block-relative offsets, with no "
+             "Python-side event slicing. Returns output MIDI events like "
+             "process_midi.")
         .def("process_auto", &Plugin::process_auto,
              nb::arg("input"), nb::arg("output"), nb::arg("midi_in"), nb::arg("param_changes"),
              nb::arg("midi_out_capacity") = MIDI_OUT_CAPACITY,
@@ -3428,6 +7994,17 @@ NB_MODULE(_core, m) {
         .def("process_sidechain", &Plugin::process_sidechain,
              nb::arg("main_in"), nb::arg("main_out"), nb::arg("sidechain_in"),
              "Process audio with sidechain input (all arrays shape: [channels, frames])")
+        .def("process_multibus", &Plugin::process_multibus,
+             nb::arg("outputs"), nb::arg("input") = nb::none(),
+             nb::arg("midi_in") = nb::none(),
+             "Process one block and capture every output bus at once. "
+             "outputs: one entry per output bus in bus order -- an array of "
+             "shape (bus_channels, frames) per get_bus_info, or None to skip "
+             "that bus. input: main input of shape (channels, frames), or "
+             "None for silence (the usual case for multi-out instruments). "
+             "midi_in: optional list of (sample_offset, status, data1, "
+             "data2). One processBlock fills all buses, replacing the "
+             "render-per-soloed-bus workaround for multitimbral plugins.")
 
         // Double precision processing
         .def_prop_ro("supports_double", &Plugin::supports_double,
@@ -3438,11 +8015,54 @@ NB_MODULE(_core, m) {
              "[channels, frames]. Accepts float64 numpy arrays or AudioBufferD "
              "(via DLPack) -- the latter needs no numpy.")
 
+        // Native offline render loop (the fast path behind
+        // minihost.process_audio).
+        .def("render_blocks", &Plugin::render_blocks,
+             nb::arg("input").none(), nb::arg("out_frames"),
+             nb::arg("block_size"), nb::arg("latency") = 0,
+             nb::arg("midi_in") = nb::list(), nb::arg("param_changes") = nb::list(),
+             "Render out_frames frames block-by-block in C++ with the GIL "
+             "released and return a new AudioBuffer. input: AudioBuffer or "
+             "None (synth mode; silent input, zero-padded past its end "
+             "either way). midi_in / param_changes: sorted event tuples "
+             "with absolute sample positions, sliced per block internally. "
+             "latency extra frames are rendered and dropped from the head "
+             "(latency compensation). Plugin MIDI output is discarded.")
+
         // Processing precision
         .def_prop_rw("processing_precision",
                      &Plugin::get_processing_precision, &Plugin::set_processing_precision,
                      "Processing precision (MH_PRECISION_SINGLE=0 or MH_PRECISION_DOUBLE=1)")
 
+        // Automation granularity
+        .def("set_automation_granularity", &Plugin::set_automation_granularity,
+             nb::arg("min_subblock_frames"),
+             nb::arg("mode") = MH_AUTOMATION_SAMPLE_ACCURATE,
+             "Configure how process_auto splits a block around parameter "
+             "changes. min_subblock_frames (>= 1) coalesces change offsets "
+             "to the nearest multiple, so dense automation never splits a "
+             "block into native calls shorter than that; 1 (default) keeps "
+             "exact sample-accurate splitting. mode MH_AUTOMATION_BLOCK_RATE "
+             "applies every change at block start and processes the block in "
+             "one call.")
+        .def("get_automation_granularity", &Plugin::get_automation_granularity,
+             "Return (min_subblock_frames, mode) as set by "
+             "set_automation_granularity.")
+        .def("set_param_smoothing", &Plugin::set_param_smoothing,
+             nb::arg("param_index"), nb::arg("ramp_ms"),
+             nb::arg("mode") = MH_SMOOTH_EXPONENTIAL,
+             "Declare a host-side smoothing ramp for one parameter. "
+             "Automation changes addressed at it become ramp targets: each "
+             "processed block issues a single interpolated set instead of "
+             "splitting the block at the change offsets. MH_SMOOTH_LINEAR "
+             "slews a full-range move in ramp_ms; MH_SMOOTH_EXPONENTIAL "
+             "(default) settles within ~1% in ramp_ms. ramp_ms <= 0 turns "
+             "smoothing off for the parameter.")
+        .def("get_param_smoothing", &Plugin::get_param_smoothing,
+             nb::arg("param_index"),
+             "Return (ramp_ms, mode) for one parameter; ramp_ms 0.0 means "
+             "unsmoothed.")
+
         // Track properties
         .def("set_track_properties", &Plugin::set_track_properties,
              nb::arg("name") = nb::none(),
@@ -3480,6 +8100,40 @@ NB_MODULE(_core, m) {
              "Register callback for plugin-initiated parameter changes. "
              "Callback receives (param_index: int, new_value: float). Pass None to clear. "
              "Events are queued and dispatched when poll_callbacks() is called.")
+        .def("set_param_value_coalescing", &Plugin::set_param_value_coalescing,
+             nb::arg("interval_ms"),
+             "Coalesce plugin-initiated parameter changes: with interval_ms > 0, "
+             "changes accumulate per-parameter (last writer wins) and the value "
+             "callback fires at most once per parameter per interval instead of "
+             "once per change. Cuts the event volume when a GUI sprays changes "
+             "(preset morph, macro sweep). 0 restores immediate delivery after "
+             "flushing anything pending. Events still arrive via poll_callbacks().")
+        .def("start_param_recording", &Plugin::start_param_recording,
+             nb::arg("capacity") = 0,
+             "Arm native parameter-change recording: every change the "
+             "plugin reports is appended as a (time_sec, param_index, "
+             "value) record into a lock-free buffer with room for "
+             "`capacity` records (0 selects 4096). Capture is exact -- "
+             "it costs only actual changes, unlike polling get_param at "
+             "a fixed rate -- and sees every change even with value "
+             "coalescing enabled. Fails if already armed.")
+        .def("stop_param_recording", &Plugin::stop_param_recording,
+             "Disarm parameter recording. Records captured before the "
+             "stop remain fetchable.")
+        .def("param_recording_armed", &Plugin::param_recording_armed,
+             "True while parameter recording is armed.")
+        .def("fetch_param_records", &Plugin::fetch_param_records,
+             nb::arg("max_records") = 0,
+             "Drain captured parameter changes oldest-first as a list "
+             "of (time_sec, param_index, value) tuples; time_sec is "
+             "seconds since arming (multiply by the sample rate for "
+             "the sample offsets the automation timeline setters "
+             "consume). max_records limits the drain (0 = everything). "
+             "Safe to call periodically while armed.")
+        .def("param_records_dropped", &Plugin::param_records_dropped,
+             "Records rejected because the buffer was full since the "
+             "last start_param_recording. Non-zero means fetch more "
+             "often or arm with a larger capacity.")
         .def("set_param_gesture_callback", &Plugin::set_param_gesture_callback,
              nb::arg("callback").none(),
              "Register callback for parameter gesture begin/end from plugin UI. "
@@ -3504,6 +8158,21 @@ NB_MODULE(_core, m) {
             self.close();
         });
 
+    // Shared inter-stage scratch for chains on one audio thread
+    nb::class_<ChainScratchArena>(m, "ChainScratchArena",
+        "Shared inter-stage scratch region for PluginChains driven "
+        "from one audio thread. Chains attached via "
+        "PluginChain.set_scratch_arena borrow this region during each "
+        "process call instead of holding private per-chain scratch, "
+        "cutting inter-stage memory from the sum over all chains to "
+        "the max of any one. Attached chains must never process "
+        "concurrently -- use one arena per audio thread.")
+        .def(nb::init<>())
+        .def_prop_ro("bytes", &ChainScratchArena::bytes,
+             "Current size of the shared region in bytes (the "
+             "footprint replacing the attached chains' private "
+             "inter-stage scratch).");
+
     // PluginChain class for chaining multiple plugins
     nb::class_<PluginChain>(m, "PluginChain")
         .def(nb::init<nb::list>(),
@@ -3549,6 +8218,53 @@ NB_MODULE(_core, m) {
              nb::arg("plugin_index"),
              "Get the current dry/wet mix for a plugin in the chain.")
 
+        // Per-plugin bypass
+        .def("set_bypass", &PluginChain::set_bypass,
+             nb::arg("plugin_index"), nb::arg("bypassed"),
+             "Bypass / un-bypass a plugin in the chain. A bypassed "
+             "stage passes its input through unchanged and the plugin "
+             "is not called at all (unlike mix=0.0, which still runs "
+             "it). Lock-free -- the flag shares a packed atomic control "
+             "word with the mix, read once per stage per block -- so "
+             "flipping it from a GUI thread never contends with the "
+             "audio thread. Raises if the plugin's input and output "
+             "channel counts differ.")
+        .def("get_bypass", &PluginChain::get_bypass,
+             nb::arg("plugin_index"),
+             "True if the plugin at plugin_index is currently bypassed.")
+
+        // Trace export
+        .def("set_tracing", &PluginChain::set_tracing,
+             nb::arg("capacity_events"),
+             "Enable trace capture with a ring of capacity_events "
+             "spans (one span per plugin call; oldest overwritten on "
+             "wrap). 0 disables. Size as num_plugins * blocks to "
+             "keep. Allocates now, never on the audio path; do not "
+             "call while processing runs.")
+        .def("trace_dump", &PluginChain::trace_dump,
+             nb::arg("path"),
+             "Write captured trace spans to `path` as Chrome "
+             "trace-event JSON, loadable in chrome://tracing or "
+             "Perfetto. Do not call while processing runs.")
+
+        // Shared scratch arena
+        .def("set_scratch_arena", &PluginChain::set_scratch_arena,
+             nb::arg("arena"),
+             // keep_alive<1, 2>: tie the arena's Python lifetime to the
+             // chain so the borrowed region can't be collected while
+             // the chain still points into it.
+             nb::keep_alive<1, 2>(),
+             "Borrow inter-stage scratch from `arena` instead of this "
+             "chain's private buffers, releasing the private "
+             "allocation. Chains on one arena must never process "
+             "concurrently (one arena per audio thread). Call while "
+             "the chain and every chain already attached are idle; the "
+             "arena grows here if this chain needs more than any "
+             "previous attachee, never on the audio path.")
+        .def("clear_scratch_arena", &PluginChain::clear_scratch_arena,
+             "Detach from the shared scratch arena, reallocating "
+             "private inter-stage buffers. Call while idle.")
+
         // Reset
         .def("reset", &PluginChain::reset,
              "Reset all plugins (clears delay lines, reverb tails, etc.)")
@@ -3558,20 +8274,82 @@ NB_MODULE(_core, m) {
              nb::arg("non_realtime"),
              "Set non-realtime mode for all plugins in the chain")
 
+        // Silence-aware skip
+        .def("set_silence_skip", &PluginChain::set_silence_skip,
+             nb::arg("enabled"),
+             "Enable silence-aware skipping (default: off): a plugin "
+             "whose input block is silent and whose reported tail has "
+             "elapsed is zero-filled by flag instead of processed. "
+             "Speeds up offline renders of mostly-silent stems; skipped "
+             "output is exact zeros, so leave off when bit-exactness "
+             "matters.")
+
+        // Gapless plugin replacement
+        .def("replace_plugin", &PluginChain::replace_plugin,
+             nb::arg("index"), nb::arg("plugin"),
+             "Stage a plugin to take over chain slot `index`; the next "
+             "process call adopts it at a block boundary under a short "
+             "equal-power crossfade. The replacement must match the "
+             "slot's channel counts and the chain's sample rate. Keep "
+             "the old plugin alive until replace_pending() is False.")
+        .def("replace_pending", &PluginChain::replace_pending,
+             "True while a staged replacement has not been adopted or "
+             "its crossfade is still rendering.")
+
         // Process
         .def("process", &PluginChain::process,
              nb::arg("input"), nb::arg("output"),
              "Process audio through the chain (shape: [channels, frames])")
+        .def("process_into", &PluginChain::process_into,
+             nb::arg("input"), nb::arg("output"),
+             "Process through the chain between two caller-owned "
+             "AudioBuffers with zero per-call allocation; the GIL is "
+             "released while the chain runs.")
+        .def("process_blocks", &PluginChain::process_blocks,
+             nb::arg("input"), nb::arg("output"), nb::arg("block_size"),
+             nb::arg("progress") = nb::none(), nb::arg("progress_interval") = 64,
+             "Batch render through the chain in block_size sub-blocks with "
+             "the GIL released for the whole batch (see "
+             "Plugin.process_blocks).")
+        .def("detect_tail", &PluginChain::detect_tail,
+             nb::arg("block_size") = 512, nb::arg("threshold_db") = -80.0,
+             nb::arg("hold_blocks") = 4, nb::arg("max_seconds") = 30.0,
+             "Hunt the chain's decay tail natively with the GIL released "
+             "(see Plugin.detect_tail). Returns the tail length in frames.")
         .def("process_midi", &PluginChain::process_midi,
              nb::arg("input"), nb::arg("output"), nb::arg("midi_in"),
              nb::arg("midi_out_capacity") = MIDI_OUT_CAPACITY,
              "Process audio with MIDI (to first plugin). midi_in: list of (sample_offset, status, data1, data2). "
              "Returns the list of output MIDI events (capped at midi_out_capacity, default 256).")
+        .def("process_midi_timeline", &PluginChain::process_midi_timeline,
+             nb::arg("input"), nb::arg("output"), nb::arg("timeline"),
+             nb::arg("start"),
+             nb::arg("midi_out_capacity") = MIDI_OUT_CAPACITY,
+             "Process one block against a MidiEventTimeline (see "
+             "Plugin.process_midi_timeline). MIDI goes to the first plugin.")
         .def("process_auto", &PluginChain::process_auto,
              nb::arg("input"), nb::arg("output"), nb::arg("midi_in"), nb::arg("param_changes"),
              nb::arg("midi_out_capacity") = MIDI_OUT_CAPACITY,
              "Process with sample-accurate automation. param_changes: list of (sample_offset, plugin_index, param_index, value). "
              "Returns the list of output MIDI events (capped at midi_out_capacity, default 256).")
+        .def("set_automation_timeline",
+             &PluginChain::set_automation_timeline,
+             nb::arg("changes"),
+             "Set a whole-render automation timeline: "
+             "(sample_offset, plugin_index, param_index, value) tuples "
+             "with ABSOLUTE sample offsets. The chain compiles one "
+             "sorted lane per plugin once, and every process call "
+             "consumes the slice it covers via a forward cursor -- "
+             "per-block cost is O(changes this block), so set it once "
+             "for an offline render instead of slicing per block in "
+             "Python. Persists across process calls; an empty list "
+             "clears.")
+        .def("seek_automation", &PluginChain::seek_automation,
+             nb::arg("frame"),
+             "Move the automation timeline position to an absolute "
+             "sample frame (it starts at 0 and advances by nframes per "
+             "process call). Changes before the new position will not "
+             "replay.")
 
         // Explicit close + context-manager support
         .def("close", &PluginChain::close,
@@ -3663,6 +8441,15 @@ NB_MODULE(_core, m) {
              "Add a plugin node. The graph keeps a reference to the "
              "Plugin so it cannot be garbage-collected while the graph "
              "is alive. Returns the new node id.")
+        .def("add_plugin_oversampled", &PluginGraph::add_plugin_oversampled,
+             nb::arg("plugin"), nb::arg("factor"),
+             "Add a plugin node wrapped in polyphase 2x/4x "
+             "oversampling: just this plugin processes at factor * "
+             "the graph rate (anti-aliasing for saturators without "
+             "oversampling the whole project). factor must be 1, 2 "
+             "or 4; open the plugin at factor * the graph's sample "
+             "rate and factor * max_block_size. The wrapper's filter "
+             "delay shows up in latency_samples. Returns node id.")
         .def("add_input", &PluginGraph::add_input,
              nb::arg("channels"),
              "Add an input node producing `channels` channels from a "
@@ -3686,6 +8473,45 @@ NB_MODULE(_core, m) {
              "Add a merge-channels node: takes out_channels separate "
              "1-channel inputs (one per port) and interleaves them "
              "into one out_channels output signal. Returns node id.")
+        .def("add_remap", &PluginGraph::add_remap,
+             nb::arg("in_channels"), nb::arg("channel_map"),
+             "Add a channel-remap node: takes an in_channels signal "
+             "and outputs len(channel_map) channels, where output "
+             "channel i carries input channel channel_map[i] (-1 = "
+             "silence). Source channels may repeat, so one node "
+             "covers reordering, duplication, and width changes that "
+             "would otherwise need a pick_channel + merge_channels "
+             "ladder. Compile aliases mapped channels into the "
+             "upstream buffer when it can, so a pure permutation "
+             "costs nothing per block. Returns node id.")
+        .def("add_resample", &PluginGraph::add_resample,
+             nb::arg("channels"), nb::arg("source_rate"),
+             "Add a resample source node: converts caller-supplied "
+             "source_rate audio to the graph rate (linear "
+             "interpolation). Has no input ports; feed it via "
+             "resample_write between render_block calls. Returns "
+             "node id.")
+        .def("resample_write", &PluginGraph::resample_write,
+             nb::arg("node_id"), nb::arg("frames"),
+             "Append source-rate frames to a resample node's FIFO. "
+             "frames is a float32 (channels, nframes) array at the "
+             "node's source rate. Raises if the write would overrun "
+             "unread audio (the FIFO holds four graph blocks' worth).")
+        .def("resample_frames_needed", &PluginGraph::resample_frames_needed,
+             nb::arg("node_id"), nb::arg("nframes"),
+             "Source frames resample_write must supply before a "
+             "render of nframes output frames reads past the FIFO's "
+             "write position. 0 when already primed; an underrun "
+             "emits silence but still advances the node's timeline.")
+        .def("add_convolve", &PluginGraph::add_convolve,
+             nb::arg("channels"), nb::arg("ir"),
+             "Add a convolution node: convolves its input with a "
+             "static impulse response (partitioned FFT, zero per-block "
+             "allocations). ir is a float32 (ir_channels, ir_frames) "
+             "array with ir_channels 1 (shared) or equal to channels; "
+             "it is copied at add time. Adds one partition "
+             "(next pow2 >= max_block_size) of latency, visible in "
+             "latency_samples. Returns node id.")
         .def("add_midi_processor", &PluginGraph::add_midi_processor,
              nb::arg("params"),
              "Add a MIDI processor node. params is a dict with key "
@@ -3718,8 +8544,48 @@ NB_MODULE(_core, m) {
              nb::arg("src"), nb::arg("dst"), nb::arg("dst_port") = 0,
              "Connect src.out -> dst.in[dst_port]. dst_port is 0 "
              "except for mix nodes, where it selects one of "
-             "num_inputs slots. Channel counts must match. Fan-out "
+             "num_inputs slots, and plugin nodes with a sidechain bus, "
+             "where get_node_sidechain_port names the key-signal port. "
+             "Channel counts must match per port. Fan-out "
              "from a source is allowed; fan-in requires a mix node.")
+        .def("connect_feedback", &PluginGraph::connect_feedback,
+             nb::arg("src"), nb::arg("dst"), nb::arg("dst_port") = 0,
+             "Connect src.out -> dst.in[dst_port] through a "
+             "single-block delay. Feedback edges may close a cycle "
+             "(including src == dst): the destination port reads the "
+             "source node's previous block from a holding buffer "
+             "preallocated at compile, so echo and feedback patches "
+             "render natively inside render_block instead of an "
+             "external per-block Python loop. The source must be a "
+             "processing node (not an input or output node); the edge "
+             "is never latency-compensated, and each compile resets "
+             "the loop to one block of silence. Delay-free loops "
+             "(ordinary connect edges forming a cycle) are still "
+             "rejected at compile.")
+        .def("connect_modulation", &PluginGraph::connect_modulation,
+             nb::arg("src"), nb::arg("src_channel"), nb::arg("dst"),
+             nb::arg("param_index"), nb::arg("base") = 0.0f,
+             nb::arg("depth") = 1.0f, nb::arg("curve") = 0,
+             "Route audio from src.out[src_channel] onto a parameter "
+             "of plugin node dst. Each block the source buffer is "
+             "sampled (once per block by default; every "
+             "set_modulation_interval frames otherwise) and each "
+             "sample becomes a normalized parameter value "
+             "clamp(base + depth * curve(clamp(0.5*s + 0.5, 0, 1)), "
+             "0, 1), merged with staged automation and applied "
+             "sample-accurately. curve: 0 = linear, 1 = squared, "
+             "2 = smoothstep. depth may be negative. The source may "
+             "be an input node (pass an LFO buffer as a graph input) "
+             "or a processing node; the edge orders the source before "
+             "the target, so it cannot close a cycle -- use "
+             "connect_feedback for feedback-driven modulation. One "
+             "edge per (dst, param): reconnecting overwrites.")
+        .def("set_modulation_interval",
+             &PluginGraph::set_modulation_interval,
+             nb::arg("frames"),
+             "Set the modulation sampling interval in frames "
+             "(graph-wide). 0 (the default) samples once per block. "
+             "Pre-compile configuration; raises on a compiled graph.")
         .def("set_mix_gain", &PluginGraph::set_mix_gain,
              nb::arg("mix_node"), nb::arg("input_index"), nb::arg("gain"),
              "Set the per-input gain (linear, default 1.0) on a mix "
@@ -3741,26 +8607,402 @@ NB_MODULE(_core, m) {
              "Drain MIDI events that flowed into a MIDI_OUTPUT node "
              "during the most recent render_block. Returns a list of "
              "(sample_offset, status, data1, data2) tuples.")
+        // Like as_ndarray, the bound Python object is passed as the
+        // owner of the returned view so the graph (and its event
+        // storage) outlives any array holding the borrow.
+        .def("borrow_midi_output_events",
+             [](nb::handle self_h, int node_id) {
+                 auto& self = nb::cast<PluginGraph&>(self_h);
+                 auto [events, count] = self.borrow_midi_output_events(node_id);
+                 static const unsigned char empty[1] = {0};
+                 const void* data = events != nullptr
+                     ? static_cast<const void*>(events)
+                     : static_cast<const void*>(empty);
+                 size_t shape[1]
+                     = { (size_t) count * sizeof(MH_MidiEvent) };
+                 return nb::ndarray<nb::numpy, const uint8_t,
+                                    nb::shape<-1>>(data, 1, shape, self_h);
+             },
+             nb::arg("node_id"),
+             "Zero-copy variant of get_midi_output_events: a read-only "
+             "uint8 array viewing the graph's internal event storage "
+             "for a MIDI_OUTPUT node. View it with "
+             "minihost.midi_event_dtype() for a record array with "
+             "sample_offset/status/data1/data2 fields. Valid only "
+             "until the next render_block / begin_edit / compile -- "
+             "the next render overwrites the storage in place; copy() "
+             "the array to keep events across blocks.")
         .def("compile", &PluginGraph::compile,
              "Validate topology, build the schedule, and allocate the "
              "per-node buffer pool. After compile, no further add_* / "
-             "connect calls are permitted.")
+             "connect calls are permitted until begin_edit reopens "
+             "the graph.")
+        .def("begin_edit", &PluginGraph::begin_edit,
+             "Reopen a compiled graph for editing. The next compile "
+             "is incremental: unchanged buffer-pool slots and the "
+             "worker threads are reused. Must not overlap "
+             "render_block.")
         .def("render_block", &PluginGraph::render_block,
              nb::arg("inputs"), nb::arg("outputs"), nb::arg("nframes"),
              "Render one block. inputs is a list of float32 arrays "
              "shape (channels, nframes), one per input node in the "
              "order add_input was called; outputs is the same for "
              "output nodes. nframes must be <= max_block_size.")
+        .def("render_block_into", &PluginGraph::render_block_into,
+             nb::arg("inputs"), nb::arg("outputs"), nb::arg("nframes"),
+             "As render_block but with AudioBuffers, zero per-call "
+             "allocation after the first call, and the GIL released "
+             "while rendering. The fast path for tight block loops.")
         .def("set_node_automation", &PluginGraph::set_node_automation,
              nb::arg("node_id"), nb::arg("changes"),
              "Stage sample-accurate parameter automation for a plugin "
              "node. `changes` is a list of "
              "(sample_offset, param_index, value) tuples. Cleared "
              "after the next render_block call.")
+        .def("set_node_automation_timeline",
+             &PluginGraph::set_node_automation_timeline,
+             nb::arg("node_id"), nb::arg("changes"),
+             "Stage a whole-render automation timeline for a plugin "
+             "node: (sample_offset, param_index, value) tuples with "
+             "ABSOLUTE sample offsets. The graph sorts its own copy and "
+             "each render_block consumes the slice it covers -- "
+             "per-block cost is O(changes this block), so set it once "
+             "for an offline render instead of slicing per block in "
+             "Python. Persists across render_block calls; an empty "
+             "list clears. Takes precedence over set_node_automation "
+             "for the node.")
+        .def("set_node_automation_curves",
+             &PluginGraph::set_node_automation_curves,
+             nb::arg("node_id"), nb::arg("keyframes"),
+             "Stage native keyframe automation curves for a plugin "
+             "node: (sample_offset, param_index, value) tuples with "
+             "ABSOLUTE sample offsets, in any order. Storage stays at "
+             "the keyframes -- each parameter's curve is evaluated "
+             "once per render_block at the block start (linear "
+             "between keyframes, clamped outside the span), so "
+             "hour-long curves cost a few KB instead of a dense "
+             "change list. Rides the same playhead as "
+             "set_node_automation_timeline (seek_automation "
+             "repositions both); an explicit timeline event wins over "
+             "a curve value at the same offset. An empty list clears "
+             "the node's curves.")
+        .def("seek_automation", &PluginGraph::seek_automation,
+             nb::arg("frame"),
+             "Move the automation timeline position to an absolute "
+             "sample frame (it starts at 0 after compile and advances "
+             "by nframes per render_block). Changes before the new "
+             "position will not replay.")
+        .def("seek_automation_state", &PluginGraph::seek_automation_state,
+             nb::arg("frame"),
+             "Seek like seek_automation, then reconstruct parameter "
+             "state at the new position: every timeline parameter "
+             "gets its latest value from before the frame and every "
+             "curve is evaluated at the frame, applied immediately -- "
+             "the state a replay from zero would have left behind, "
+             "without the replay. Built for timeline scrubbing and "
+             "mid-project render starts; lookups are binary searches "
+             "over a lazily built per-parameter index, so jumps cost "
+             "microseconds regardless of timeline length.")
+        .def("set_transport", &PluginGraph::set_transport,
+             nb::arg("bpm"),
+             nb::arg("time_sig_num") = 4,
+             nb::arg("time_sig_denom") = 4,
+             nb::arg("position_samples") = 0LL,
+             nb::arg("position_beats") = 0.0,
+             nb::arg("is_playing") = true,
+             nb::arg("is_recording") = false,
+             nb::arg("is_looping") = false,
+             nb::arg("loop_start") = 0LL,
+             nb::arg("loop_end") = 0LL,
+             "Set transport info for every plugin node at once. One "
+             "shared snapshot (a single seqlock write) replaces the "
+             "per-plugin set_transport fan-out, and while playing, "
+             "render_block advances the position by its own frame count "
+             "(wrapping inside the loop range when is_looping) -- call "
+             "this once at render start or to seek, not per block.")
+        .def("clear_transport", &PluginGraph::clear_transport,
+             "Publish 'no transport' to every plugin node (they stay "
+             "attached to the graph's shared snapshot).")
+        .def_prop_rw("profiling",
+                     &PluginGraph::get_profiling, &PluginGraph::set_profiling,
+                     "Per-node render profiling. When True, render_block "
+                     "records each node's block time into lock-free "
+                     "accumulators; read them with node_stats(). Toggling "
+                     "allocates nothing and is safe at any time.")
+        .def("node_stats", &PluginGraph::node_stats,
+             nb::arg("node_id"),
+             "Accumulated render stats for one node as a dict with keys "
+             "blocks, xruns, last_us, mean_us, p99_us, max_us, "
+             "denormal_hits. Safe to call from another thread while "
+             "render_block runs. xruns counts blocks where the whole "
+             "graph overran its real-time budget and this node was the "
+             "slowest. p99_us is histogram-approximate (within 2x). "
+             "denormal_hits is the plugin's cumulative denormal counter "
+             "(0 for built-in nodes).")
+        .def("reset_node_stats", &PluginGraph::reset_node_stats,
+             "Zero every node's profiling accumulators.")
+        .def("set_tracing", &PluginGraph::set_tracing,
+             nb::arg("capacity_events"),
+             "Enable trace capture with a ring of capacity_events "
+             "spans (one span per node render; oldest overwritten on "
+             "wrap). 0 disables. Size as num_nodes * blocks to keep. "
+             "Allocates now, never on the render path; do not call "
+             "while render_block runs. Requires compile().")
+        .def("trace_dump", &PluginGraph::trace_dump,
+             nb::arg("path"),
+             "Write captured trace spans to `path` as Chrome "
+             "trace-event JSON, loadable in chrome://tracing or "
+             "Perfetto. Do not call while render_block runs.")
+        .def("set_watchdog", &PluginGraph::set_watchdog,
+             nb::arg("timeout_ms"),
+             "Enable watchdog-supervised plugin processing (default: "
+             "off; 0 disables) for NON-REALTIME rendering: every "
+             "plugin process call runs on a supervision thread and is "
+             "waited out with the per-call deadline. A call that "
+             "misses it trips the watchdog -- the node is marked "
+             "failed (sticky, see node_failed / clear_node_failed), "
+             "renders silence from that block on, and render_block "
+             "returns normally instead of hanging the process. The "
+             "hung call is abandoned on a leaked thread, so a failed "
+             "node's plugin must not be processed or closed until the "
+             "process exits. Supervised calls serialize, so "
+             "multi-worker rendering loses node parallelism while "
+             "enabled.")
+        .def_prop_ro("watchdog_trips", &PluginGraph::watchdog_trips,
+             "Watchdog trips since the graph was created, cumulative. "
+             "Safe to poll from any thread.")
+        .def("node_failed", &PluginGraph::node_failed,
+             nb::arg("node_id"),
+             "True if the node was failed by a watchdog trip (it "
+             "renders silence and its plugin is never touched). Failed "
+             "flags survive recompiles like bypass flags.")
+        .def("clear_node_failed", &PluginGraph::clear_node_failed,
+             nb::arg("node_id"),
+             "Re-arm a failed node so the next render processes its "
+             "plugin again. Only safe when the trip was a false "
+             "positive (a slow-but-finite block); a genuinely hung "
+             "plugin is still executing the abandoned call.")
+        .def("set_hashing", &PluginGraph::set_hashing,
+             nb::arg("mode"),
+             "Enable render verification hashing (default 0 = off). "
+             "Mode 1 folds each block's caller-visible output into a "
+             "running 64-bit digest (render_digest), so a determinism "
+             "check compares two integers instead of diffing full "
+             "output files. Mode 2 additionally folds every audio "
+             "node's output into a per-node digest (node_digest) -- "
+             "when two runs diverge, the first differing node "
+             "localizes the nondeterministic plugin in one run. "
+             "Setting a mode (or compiling) zeroes all digests. "
+             "Digests hash raw sample bits and depend on the block "
+             "sequence: compare runs rendered with identical block "
+             "sizes in identical order. Double-precision renders are "
+             "not hashed.")
+        .def_prop_ro("hashing", &PluginGraph::hashing,
+             "Current verification hashing mode (0, 1, or 2).")
+        .def_prop_ro("render_digest", &PluginGraph::render_digest,
+             "Running whole-render digest (hashing modes 1 and 2). "
+             "Stable between render_block calls; 0 on a fresh run, so "
+             "compare digests between runs rather than against zero.")
+        .def("node_digest", &PluginGraph::node_digest,
+             nb::arg("node_id"),
+             "Per-node running digest (hashing mode 2). MIDI-only "
+             "nodes stay at 0 -- they render no audio.")
+        .def("set_silence_skip", &PluginGraph::set_silence_skip,
+             nb::arg("enabled"),
+             "Enable silence-aware skipping (default: off): a plugin "
+             "node whose input block is silent and whose reported tail "
+             "has elapsed is zero-filled by flag instead of processed. "
+             "Nodes with MIDI or automation staged always process. "
+             "Speeds up offline renders of mostly-silent stems; skipped "
+             "output is exact zeros, so leave off when bit-exactness "
+             "matters.")
+        .def("set_node_bypass", &PluginGraph::set_node_bypass,
+             nb::arg("node_id"), nb::arg("bypassed"),
+             "Bypass / un-bypass a plugin node. RT-safe to flip from "
+             "any thread; a bypassed node passes its dry input through "
+             "without calling the plugin (zero-copy where possible), "
+             "delayed by the node's compiled latency so toggling stays "
+             "phase-aligned. Requires a compiled graph.")
+        .def("get_node_bypass", &PluginGraph::get_node_bypass,
+             nb::arg("node_id"),
+             "True if the plugin node is currently bypassed.")
+        .def("set_node_mix", &PluginGraph::set_node_mix,
+             nb::arg("node_id"), nb::arg("mix"),
+             "Set a plugin node's wet/dry mix in [0.0, 1.0] (default "
+             "1.0, full wet): after the node processes, its output "
+             "becomes mix * wet + (1 - mix) * dry, with the dry signal "
+             "read straight from the node's input buffers -- no copy, "
+             "and full wet skips the blend entirely. RT-safe to retune "
+             "from any thread. The dry path is not delay-compensated "
+             "(unlike bypass). Requires a compiled graph and a plugin "
+             "node whose in/out channel counts match.")
+        .def("get_node_mix", &PluginGraph::get_node_mix,
+             nb::arg("node_id"),
+             "The node's current wet/dry mix, or -1.0 for a bad node "
+             "or uncompiled graph.")
+        .def("get_node_sidechain_port", &PluginGraph::get_node_sidechain_port,
+             nb::arg("node_id"),
+             "The node's sidechain input port index, or -1 when the "
+             "node has no sidechain port (not a plugin node, plugin "
+             "opened without a sidechain bus, or oversampled). A "
+             "plugin opened with sidechain_channels > 0 exposes its "
+             "sidechain bus as one extra audio input port -- always "
+             "the highest-numbered one; pass the index "
+             "as dst_port to connect() to wire a key signal into it, "
+             "and render_block routes it through the plugin's "
+             "sidechain entry point with no extra copies. Valid "
+             "before compile.")
+        .def("set_node_sacrificial", &PluginGraph::set_node_sacrificial,
+             nb::arg("node_id"), nb::arg("shed_order"),
+             "Rank a plugin node for the overload governor: 0 is shed "
+             "first, higher ranks later, -1 (default) means never shed. "
+             "RT-safe to change at any time; requires a compiled graph.")
+        .def("get_node_sacrificial", &PluginGraph::get_node_sacrificial,
+             nb::arg("node_id"),
+             "The node's shed rank, or -1 (never-shed / bad node).")
+        .def("set_governor", &PluginGraph::set_governor,
+             nb::arg("engage_load") = 0.9, nb::arg("release_load") = 0.6,
+             nb::arg("engage_blocks") = 8, nb::arg("release_blocks") = 1024,
+             "Enable the adaptive overload governor: when the measured "
+             "render load stays at or above engage_load for "
+             "engage_blocks consecutive blocks, the lowest-ranked "
+             "sacrificial node still live is bypassed; when load stays "
+             "at or below release_load for release_blocks blocks, the "
+             "most recently shed node is restored. The thresholds form "
+             "a hysteresis gap, so shed nodes cannot yo-yo. Do not call "
+             "while a render is in flight.")
+        .def("clear_governor", &PluginGraph::clear_governor,
+             "Disable the governor and restore every node it shed "
+             "(user-set bypass is untouched). Do not call while a "
+             "render is in flight.")
+        .def("governor_shed_count", &PluginGraph::governor_shed_count,
+             "Number of nodes currently shed by the governor. Safe to "
+             "poll from any thread.")
+        .def("set_node_meter", &PluginGraph::set_node_meter,
+             nb::arg("node_id"), nb::arg("enabled"),
+             "Enable/disable the meter tap on a node. While enabled, "
+             "every render scans the node's output for per-channel "
+             "peak and RMS (one linear pass, no allocations); read "
+             "them with node_meter(). RT-safe to flip from any thread; "
+             "requires a compiled graph.")
+        .def("node_meter", &PluginGraph::node_meter,
+             nb::arg("node_id"),
+             "The tapped node's levels from the most recently rendered "
+             "block, as a (peaks, rms) tuple of per-channel linear "
+             "values. Seqlock'd -- safe to poll while another thread "
+             "is inside render_block. Raises if the tap is not enabled "
+             "or the node id is bad.")
+        .def("set_node_tap", &PluginGraph::set_node_tap,
+             nb::arg("node_id"), nb::arg("enabled") = true,
+             "Mark a node as an analysis tap: after each render_block, "
+             "node_audio() returns a zero-copy view of the block it "
+             "produced. Pre-compile configuration (raises on a compiled "
+             "graph -- reopen with begin_edit): tapping opts the node "
+             "out of the compile-time copy elisions that would leave "
+             "its internal buffer unwritten. Any audio-producing "
+             "processing node can be tapped; for an output node, tap "
+             "the node feeding it instead.")
+        // Same owner pattern as borrow_midi_output_events: the bound
+        // Python object keeps the graph (and its pool arena) alive for
+        // as long as any view exists. The pool lays channels out at one
+        // uniform stride, so the whole block is a single strided array.
+        .def("node_audio",
+             [](nb::handle self_h, int node_id) {
+                 auto& self = nb::cast<PluginGraph&>(self_h);
+                 auto v = self.borrow_node_audio(node_id);
+                 static const float fallback[1] = {0.0f};
+                 const float* data = (v.num_channels > 0 && v.num_frames > 0)
+                     ? v.channels[0]
+                     : fallback;
+                 int64_t stride = v.num_frames;
+                 if (v.num_channels > 1 && v.num_frames > 0) {
+                     stride = (int64_t) (v.channels[1] - v.channels[0]);
+                     for (int c = 2; c < v.num_channels; ++c)
+                         if (v.channels[c] - v.channels[0]
+                             != (ptrdiff_t) c * stride)
+                             throw std::runtime_error(
+                                 "node_audio: channel buffers are not "
+                                 "uniformly strided");
+                 }
+                 size_t  shape[2]   = { (size_t) v.num_channels,
+                                        (size_t) v.num_frames };
+                 int64_t strides[2] = { stride, 1 };
+                 return nb::ndarray<nb::numpy, const float, nb::shape<-1, -1>>(
+                     data, 2, shape, self_h, strides);
+             },
+             nb::arg("node_id"),
+             "Zero-copy view of a tapped node's output from the most "
+             "recent render_block, as a read-only float32 array of "
+             "shape (channels, nframes) viewing the graph's internal "
+             "buffer (nframes is 0 before the first render). Feed it "
+             "straight to numpy/torch analysis -- no copy is made, so "
+             "per-block analysis stays affordable at high sample "
+             "rates. Valid only until the next render_block / "
+             "begin_edit / compile; copy() the array to keep audio "
+             "across blocks. Raises if the node is not tapped "
+             "(set_node_tap before compile).")
+        .def("set_pool_huge_pages", &PluginGraph::set_pool_huge_pages,
+             nb::arg("enabled"),
+             "Ask for the buffer-pool arena to be backed by huge pages "
+             "(2 MiB alignment plus an madvise hint on Linux), cutting "
+             "TLB pressure on large sessions. Best effort; call before "
+             "compile().")
+        .def("set_lock_memory", &PluginGraph::set_lock_memory,
+             nb::arg("enabled"),
+             "Ask for the buffer-pool arenas to be mlocked at compile "
+             "so the OS cannot evict them between callbacks. Best "
+             "effort: a refused lock (RLIMIT_MEMLOCK) leaves the arena "
+             "unlocked and compile proceeds -- check locked_bytes. "
+             "Call before compile(); raises if already compiled.")
+        .def_prop_ro("locked_bytes", &PluginGraph::get_locked_bytes,
+                     "Bytes of arena memory pinned by set_lock_memory "
+                     "(0 when the option is off or the lock was "
+                     "refused).")
+        .def("export_plan", &PluginGraph::export_plan,
+             "Serialize the compiled schedule (topological order plus a "
+             "shape hash) as bytes. Stage it on a later graph of the "
+             "same shape with set_plan() before compile() to skip "
+             "validation and the topological sort. Requires a compiled "
+             "graph.")
+        .def("set_plan", &PluginGraph::set_plan,
+             nb::arg("plan"),
+             "Stage a schedule snapshot from export_plan() before "
+             "compile(). A plan whose shape hash does not match the "
+             "graph is ignored and compile runs in full -- the plan is "
+             "an optimization hint, never a correctness input.")
+        .def("freeze_node", &PluginGraph::freeze_node,
+             nb::arg("node_id"),
+             "Start recording this node's rendered output into a freeze "
+             "cache. Render the material once, then call freeze_finish "
+             "to switch to replay. Plugin and mix nodes only; recording "
+             "allocates per block (offline feature).")
+        .def("freeze_finish", &PluginGraph::freeze_finish,
+             nb::arg("node_id"),
+             "Switch a recording node to replay: subsequent renders "
+             "copy cached blocks out instead of processing, and "
+             "upstream nodes feeding only frozen nodes are skipped. "
+             "Replay must use the same block-size sequence as the "
+             "recording pass; call freeze_rewind before each pass.")
+        .def("unfreeze_node", &PluginGraph::unfreeze_node,
+             nb::arg("node_id"),
+             "Drop the freeze cache and return the node and its "
+             "upstream subtree to normal rendering.")
+        .def("freeze_rewind", &PluginGraph::freeze_rewind,
+             "Reset every frozen node's replay cursor to the first "
+             "cached block. Call before each replay pass.")
+        .def("freeze_is_stale", &PluginGraph::freeze_is_stale,
+             nb::arg("node_id"),
+             "True if any upstream plugin's state changed since "
+             "freeze_finish (the cached render no longer matches). "
+             "Raises for a node that is not replaying.")
         .def_prop_ro("num_nodes",        &PluginGraph::num_nodes)
         .def_prop_ro("num_input_nodes",  &PluginGraph::num_input_nodes)
         .def_prop_ro("num_output_nodes", &PluginGraph::num_output_nodes)
         .def_prop_ro("is_compiled",      &PluginGraph::is_compiled)
+        .def_prop_ro("latency_samples",  &PluginGraph::latency_samples,
+                     "Graph-wide latency in samples (plugin latency "
+                     "plus built-in node buffering, after compile-time "
+                     "compensation). 0 before compile.")
         .def("close", &PluginGraph::close,
              "Release the graph's internal resources. Idempotent. "
              "Plugin nodes are not closed.")
@@ -3817,7 +9059,11 @@ NB_MODULE(_core, m) {
              "playback_device_index / capture_device_index: see single-plugin constructor.")
 
         .def("start", &AudioDevice::start,
-             "Start audio playback")
+             nb::arg("warmup_blocks") = 8,
+             "Start audio playback. First warms each plugin up with "
+             "`warmup_blocks` silence blocks (see Plugin.warmup) so the "
+             "first device callback runs at steady-state speed; pass "
+             "warmup_blocks=0 to skip.")
         .def("stop", &AudioDevice::stop,
              "Stop audio playback")
 
@@ -3829,6 +9075,34 @@ NB_MODULE(_core, m) {
                      "Actual buffer size in frames")
         .def_prop_ro("channels", &AudioDevice::get_channels,
                      "Number of output channels")
+        .def_prop_ro("load", &AudioDevice::get_load,
+                     "Rolling audio callback load: exponentially "
+                     "smoothed ratio of callback duration to buffer "
+                     "period (0.0 = idle, 1.0 = whole budget spent). "
+                     "Lock-free; safe to poll while playing.")
+        .def_prop_ro("xrun_count", &AudioDevice::get_xrun_count,
+                     "Number of callbacks that overran their buffer "
+                     "period (audible underruns) since the device was "
+                     "opened. Lock-free; safe to poll while playing.")
+
+        // Async disk recording of the processed output
+        .def("record_start", &AudioDevice::record_start,
+             nb::arg("path"), nb::arg("bit_depth") = 32,
+             "Start recording the device's processed output to path "
+             "(.wav: bit_depth 16/24/32, .flac: 16/24). The audio thread "
+             "hands blocks to a lock-free FIFO drained by a writer "
+             "thread, so recording never blocks the callback; if the "
+             "disk stalls, overflow is dropped and counted instead "
+             "(see record_dropped_frames).")
+        .def("record_stop", &AudioDevice::record_stop,
+             "Stop recording: drain the buffered audio, finalize the "
+             "file, and release the writer thread. Raises if a write "
+             "error occurred during the take.")
+        .def_prop_ro("is_recording", &AudioDevice::is_recording,
+                     "True while a recording is in progress")
+        .def_prop_ro("record_dropped_frames", &AudioDevice::record_dropped_frames,
+                     "Frames dropped because the recording FIFO was full "
+                     "(disk stall). Reset by record_start; lock-free.")
 
         // MIDI
         .def("connect_midi_input", &AudioDevice::connect_midi_input,
@@ -3863,6 +9137,63 @@ NB_MODULE(_core, m) {
              nb::arg("status"), nb::arg("data1"), nb::arg("data2"),
              "Send a MIDI event to the plugin (e.g., send_midi(0x90, 60, 100) for note on)")
 
+        // Native CC-to-parameter mapping
+        .def("set_cc_map", &AudioDevice::set_cc_map,
+             nb::arg("mappings"),
+             "Install a compiled CC-to-parameter map on the device's native MIDI path. "
+             "mappings: list of (channel, cc, plugin_index, param_index, lut) tuples where "
+             "lut is a sequence of 128 floats mapping CC value to normalized parameter value. "
+             "Matching CC events are translated to parameter writes at block boundaries on "
+             "the audio thread (no GIL) and are consumed before reaching the plugin as MIDI. "
+             "Replaces any previous map; an empty list clears it. Thread-safe, can be called "
+             "while playing. Normally driven by MidiMapper.attach_device() rather than directly.")
+        .def("clear_cc_map", &AudioDevice::clear_cc_map,
+             "Remove the native CC-to-parameter map (CC events reach the plugin as MIDI again)")
+
+        // Preloaded loop-audio source (audio callback reads it directly)
+        .def("set_loop_source", &AudioDevice::set_loop_source,
+             nb::arg("data"),
+             "Install a preloaded loop-audio source from a (channels, frames) float32 array "
+             "already at the device sample rate. The audio is copied; the audio callback then "
+             "reads it directly with wraparound as the plugin input -- no feeding thread, no "
+             "Python in the real-time path. Mono sources duplicate to all device channels. "
+             "Thread-safe, can be called while playing; replaces any previous source.")
+        .def("clear_loop_source", &AudioDevice::clear_loop_source,
+             "Remove the loop-audio source (input reverts to the callback chain / silence)")
+
+        // Gapless playlist (queued items spliced in the audio callback)
+        .def("playlist_add_audio", &AudioDevice::playlist_add_audio,
+             nb::arg("data"),
+             "Append a preloaded audio item to the gapless playlist from a "
+             "(channels, frames) float32 array already at the device sample "
+             "rate. Items play in append order with no device restart: when "
+             "one ends, the next continues at the very next frame "
+             "(crossfaded if playlist_set_crossfade is non-zero). The audio "
+             "is copied; appending from a background thread while the "
+             "current item plays is the intended use. Mono items duplicate "
+             "to all device channels.")
+        .def("playlist_add_midi", &AudioDevice::playlist_add_midi,
+             nb::arg("events"), nb::arg("duration_frames"),
+             "Append a sequenced MIDI item: a sorted list of (sample_offset, "
+             "status, data1, data2) tuples with offsets in frames from the "
+             "item's start, played into the plugin over silence for "
+             "duration_frames frames (schedule note-offs inside the "
+             "duration). Convert a MIDI file with midi_file_to_events and "
+             "scale seconds to frames at the device sample rate.")
+        .def("playlist_set_crossfade", &AudioDevice::playlist_set_crossfade,
+             nb::arg("frames"),
+             "Set the crossfade length in frames for audio-to-audio splices "
+             "(linear ramps, clamped to both item lengths; splices involving "
+             "a MIDI item are hard cuts). 0 disables fading. Thread-safe.")
+        .def("playlist_clear", &AudioDevice::playlist_clear,
+             "Drop all queued playlist items (playback stops at the next block)")
+        .def_prop_ro("playlist_index", &AudioDevice::playlist_index,
+             "Index of the playlist item currently playing (0-based since the "
+             "last clear), or -1 when the playlist is empty. An exhausted "
+             "playlist keeps reporting its last item.")
+        .def_prop_ro("playlist_count", &AudioDevice::playlist_count,
+             "Number of playlist items appended since the last clear")
+
         // Audio input for effect processing (lock-free ring buffer)
         .def("enable_input", &AudioDevice::enable_input,
              nb::arg("capacity_frames") = 0,
@@ -3878,6 +9209,23 @@ NB_MODULE(_core, m) {
              "Thread-safe, can be called while playing.")
         .def_prop_ro("input_available", &AudioDevice::input_available,
              "Number of audio frames available in the input ring buffer")
+        .def("set_input_drift_comp", &AudioDevice::set_input_drift_comp,
+             nb::arg("enabled"),
+             "Enable/disable drift-compensated consumption of the input "
+             "ring buffer. When the source feeding write_input() is "
+             "clocked against a different crystal than the output device "
+             "(network audio, a second soundcard), the fill level drifts "
+             "until it underruns or overflows; compensation holds it at "
+             "half capacity by trimming the consumption rate through a "
+             "fractional resampler (capped at +/-2000 ppm, inaudible). "
+             "Call after enable_input() and before start().")
+        .def("input_drift_stats", &AudioDevice::input_drift_stats,
+             "Drift-compensation stats as a dict: 'ratio' (current "
+             "consumption ratio; its steady offset from 1.0 is the "
+             "measured clock drift), 'fill_avg' (smoothed fill level, "
+             "frames), 'fill_target' (setpoint) and 'underruns' (blocks "
+             "short on data despite compensation). Safe to poll from any "
+             "thread. Raises if compensation is not enabled.")
 
         // Context manager support
         .def("__enter__", &AudioDevice::enter, nb::rv_policy::reference)
@@ -3901,6 +9249,101 @@ NB_MODULE(_core, m) {
         });
 
     // MidiFile class for MIDI file read/write
+    nb::class_<MidiEventTimeline>(m, "MidiEventTimeline",
+        "Packed, time-sorted MIDI event timeline at a fixed sample rate.\n\n"
+        "Built by MidiFile.sample_events(); consumed per block by "
+        "Plugin.process_midi_timeline / PluginChain.process_midi_timeline, "
+        "which binary-search the block's event range natively instead of "
+        "re-slicing a Python event list on every block.")
+        .def("__len__", &MidiEventTimeline::size)
+        .def_prop_ro("max_sample", &MidiEventTimeline::max_sample,
+                     "Sample position of the last event (0 when empty).")
+        .def_prop_ro("max_seconds", &MidiEventTimeline::max_seconds,
+                     "Time of the last event in seconds, before sample "
+                     "quantization (0.0 when empty).")
+        .def("build_block_index", &MidiEventTimeline::build_block_index,
+             nb::arg("block_size"),
+             "Build a per-block bucket index so every block-boundary "
+             "lookup is one array fetch instead of a binary search "
+             "over the whole timeline. Build once per (timeline, "
+             "block_size); rebuilding with a new block_size replaces "
+             "the index. MidiRenderer does this automatically.")
+        .def_prop_ro("indexed_block_size",
+                     &MidiEventTimeline::indexed_block_size,
+                     "Block size the bucket index was built for "
+                     "(0 = no index).")
+        .def("slice", &MidiEventTimeline::slice,
+             nb::arg("start"), nb::arg("end"),
+             "Events with absolute sample positions in [start, end) as "
+             "(sample_offset, status, data1, data2) tuples.")
+        .def("to_list", &MidiEventTimeline::to_list,
+             "The whole timeline as a list of (sample_offset, status, "
+             "data1, data2) tuples.");
+
+    nb::class_<MorphAutomation>(m, "MorphAutomation",
+        "Native morph automation: snapshots A and B plus a piecewise-linear "
+        "blend curve over absolute sample positions.\n\n"
+        "Build once with two snapshots (as from Plugin.morph_capture) and a "
+        "list of (sample, t) points, then call Plugin.apply_morph(automation, "
+        "sample) per block: the whole snapshot is interpolated natively and "
+        "written as one batched parameter update, so sweeping a large patch "
+        "at block rate does not loop over set_param in Python. Outside the "
+        "curve's span t clamps to the first/last point.")
+        .def(nb::init<std::vector<float>, std::vector<float>,
+                      std::vector<std::pair<int, float>>>(),
+             nb::arg("a"), nb::arg("b"), nb::arg("curve"),
+             "a / b: snapshots of normalized values, one per parameter "
+             "(equal length). curve: (sample, t) points; sorted internally.")
+        .def("__len__", &MorphAutomation::size)
+        .def("t_at", &MorphAutomation::t_at,
+             nb::arg("sample"),
+             "Blend amount at an absolute sample position (linear between "
+             "curve points, clamped outside the curve's span).");
+
+    nb::class_<MorphPair>(m, "MorphPair",
+        "Differential morph pair: two snapshots plus their precomputed "
+        "active set (the parameters whose endpoints actually differ).\n\n"
+        "Build once from two snapshots (as from Plugin.morph_capture), "
+        "then call Plugin.apply_morph_pair(pair, t) per step: only the "
+        "active set is interpolated and written, so a 60 Hz sweep over a "
+        "big patch that differs in a handful of parameters stops "
+        "saturating the parameter path. epsilon widens the 'unchanged' "
+        "band: 0 keeps the exact comparison params_diff uses; a positive "
+        "value also drops parameters whose endpoints differ by no more "
+        "than it.")
+        .def(nb::init<const std::vector<float>&, const std::vector<float>&,
+                      float>(),
+             nb::arg("a"), nb::arg("b"), nb::arg("epsilon") = 0.0f,
+             "a / b: snapshots of normalized values, one per parameter "
+             "(equal length). epsilon: minimum endpoint difference for a "
+             "parameter to join the active set (default 0 = exact).")
+        .def("__len__", &MorphPair::active_count)
+        .def_prop_ro("active_count", &MorphPair::active_count,
+             "Number of parameters whose endpoints differ.");
+
+    nb::class_<KeyframeAutomation>(m, "KeyframeAutomation",
+        "Native keyframe automation: per-parameter piecewise-linear curves "
+        "over absolute sample positions.\n\n"
+        "Build once from sparse (sample, param_index, value) keyframes, "
+        "then call Plugin.apply_curves(automation, sample) per block: every "
+        "curve is evaluated natively at that position and written as one "
+        "batched parameter update. Replaces expanding keyframes into a "
+        "dense per-block change list up front -- storage stays at the "
+        "keyframes, evaluation is lazy. Outside a curve's span the value "
+        "clamps to its first/last keyframe.")
+        .def(nb::init<nb::list>(),
+             nb::arg("keyframes"),
+             "keyframes: list of (sample, param_index, value) tuples; "
+             "grouped per parameter and sorted internally.")
+        .def("__len__", &KeyframeAutomation::num_curves)
+        .def("value_at", &KeyframeAutomation::value_at,
+             nb::arg("param_index"), nb::arg("sample"),
+             "Curve value for one parameter at an absolute sample position "
+             "(linear between keyframes, clamped outside the span). Raises "
+             "ValueError if the parameter has no curve.")
+        .def_prop_ro("param_indices", &KeyframeAutomation::param_indices,
+             "Automated parameter indices, ascending.");
+
     nb::class_<MidiFile>(m, "MidiFile")
         .def(nb::init<>(),
              "Create a new empty MIDI file")
@@ -3909,6 +9352,15 @@ NB_MODULE(_core, m) {
         .def("load", &MidiFile::load,
              nb::arg("path"),
              "Load a MIDI file. Returns True on success.")
+        .def("load_lazy", &MidiFile::load_lazy,
+             nb::arg("path"),
+             "Load a MIDI file lazily: only the header and per-track "
+             "chunk offsets are parsed up front; a track's events are "
+             "decoded (and cached) on first get_events() access. Use "
+             "track_stats() for event counts and durations without "
+             "decoding. Whole-file operations (save, add_*, "
+             "join_tracks, sample_events, ...) transparently fall back "
+             "to a full parse. Returns True on success.")
         .def("save", &MidiFile::save,
              nb::arg("path"),
              "Save to a MIDI file. Returns True on success.")
@@ -3948,7 +9400,15 @@ NB_MODULE(_core, m) {
         // Reading events
         .def("get_events", &MidiFile::get_events,
              nb::arg("track"),
-             "Get all events from a track as a list of dicts")
+             "Get all events from a track as a list of dicts. On a "
+             "lazily loaded file only this track is decoded (cached "
+             "for repeat access).")
+        .def("track_stats", &MidiFile::track_stats,
+             nb::arg("track"),
+             "Per-track stats as a dict with event_count, end_tick "
+             "and duration_seconds. On a lazily loaded file this "
+             "walks event boundaries only -- no event bodies are "
+             "decoded. Raises IndexError on a bad track index.")
 
         // Track format conversion
         .def("make_absolute_ticks", &MidiFile::make_absolute_ticks,
@@ -3958,25 +9418,74 @@ NB_MODULE(_core, m) {
         .def("join_tracks", &MidiFile::join_tracks,
              "Merge all tracks into track 0 (Type 0 format)")
         .def("split_tracks", &MidiFile::split_tracks,
-             "Split by channel into separate tracks (Type 1 format)");
+             "Split by channel into separate tracks (Type 1 format)")
+
+        // Native event timeline
+        .def("sample_events", &MidiFile::sample_events,
+             nb::arg("sample_rate"),
+             "Flatten the file to a MidiEventTimeline at sample_rate: "
+             "playable channel-voice events, time-sorted, with ticks "
+             "converted to sample positions through the file's cached "
+             "tempo map. Meta events are dropped.");
 
     // Audio file I/O functions
     m.def("audio_read", [](const std::string& path) {
         char err[1024] = {0};
-        MH_AudioData* data = mh_audio_read(path.c_str(), err, sizeof(err));
+
+        // Serve from the decoded-audio cache when one is configured.
+        // A hit copies out of the shared entry -- an AudioBuffer is
+        // mutable, so aliasing the cached block would let one consumer
+        // corrupt every other reader -- but skips the decode and
+        // deinterleave, which is where the time goes.
+        if (mh_audio_cache_get_budget() > 0) {
+            MH_AudioCacheView view;
+            float* copy = nullptr;
+            int ok;
+            {
+                nb::gil_scoped_release release;
+                ok = mh_audio_cache_acquire(path.c_str(), &view,
+                                            err, sizeof(err));
+                if (ok) {
+                    size_t n = (size_t)view.channels * view.frames;
+                    copy = (float*)malloc((n ? n : 1) * sizeof(float));
+                    if (copy) memcpy(copy, view.data, n * sizeof(float));
+                }
+            }
+            if (!ok) {
+                throw std::runtime_error(std::string(err));
+            }
+            if (!copy) {
+                mh_audio_cache_release(&view);
+                throw std::runtime_error("Out of memory");
+            }
+            unsigned int sample_rate = view.sample_rate;
+            auto* buf = new MhAudioBuffer(
+                MhAudioBuffer::AdoptTag{}, copy,
+                (int)view.channels, (int)view.frames,
+                copy, [](void* p) { free(p); });
+            mh_audio_cache_release(&view);
+            return nb::make_tuple(
+                nb::cast(buf, nb::rv_policy::take_ownership),
+                sample_rate);
+        }
+
+        MH_AudioDataPlanar* data =
+            mh_audio_read_planar(path.c_str(), err, sizeof(err));
         if (!data) {
             throw std::runtime_error(std::string(err));
         }
 
-        unsigned int channels = data->channels;
-        unsigned int frames = data->frames;
         unsigned int sample_rate = data->sample_rate;
 
-        // De-interleave directly into a fresh AudioBuffer. Avoids the
-        // numpy detour: this binding does not require numpy at all.
-        auto* buf = new MhAudioBuffer((int)channels, (int)frames);
-        interleaved_to_planar(data->data, buf->data(), channels, frames);
-        mh_audio_data_free(data);
+        // C decoded and deinterleaved into one contiguous planar block;
+        // adopt it as the AudioBuffer's storage (zero-copy, freed when
+        // the Python object dies). No numpy involved.
+        auto* buf = new MhAudioBuffer(
+            MhAudioBuffer::AdoptTag{}, data->data,
+            (int)data->channels, (int)data->frames,
+            data, [](void* p) {
+                mh_audio_data_planar_free(static_cast<MH_AudioDataPlanar*>(p));
+            });
 
         return nb::make_tuple(
             nb::cast(buf, nb::rv_policy::take_ownership),
@@ -3989,20 +9498,26 @@ NB_MODULE(_core, m) {
                             nb::ndarray<const float, nb::shape<-1, -1>, nb::c_contig, nb::device::cpu> data,
                             unsigned int sample_rate,
                             int bit_depth,
-                            nb::object bwf) {
+                            nb::object bwf,
+                            const std::string& dither) {
+        const int dither_mode = parseDitherMode(dither);
         size_t channels = data.shape(0);
         size_t frames = data.shape(1);
 
-        // Interleave planar numpy data for the C API
-        std::vector<float> interleaved(channels * frames);
-        planar_to_interleaved(data.data(), interleaved.data(), channels, frames);
+        // Hand the planar data to the C API directly; it interleaves
+        // chunk by chunk into the streaming writer, so no whole-file
+        // interleaved copy is staged here.
+        std::vector<const float*> chans(channels);
+        for (size_t c = 0; c < channels; ++c)
+            chans[c] = data.data() + c * frames;
 
         char err[1024] = {0};
         int ok;
         if (bwf.is_none()) {
-            ok = mh_audio_write(path.c_str(), interleaved.data(),
-                                (unsigned int)channels, (unsigned int)frames,
-                                sample_rate, bit_depth, err, sizeof(err));
+            ok = mh_audio_write_planar_opts(path.c_str(), chans.data(),
+                                            (unsigned int)channels, (unsigned int)frames,
+                                            sample_rate, bit_depth, dither_mode,
+                                            NULL, err, sizeof(err));
         } else {
             nb::dict d = nb::cast<nb::dict>(bwf);
             auto get_str = [&](const char* key) -> std::string {
@@ -4027,60 +9542,238 @@ NB_MODULE(_core, m) {
             meta.origination_date     = date.empty()    ? nullptr : date.c_str();
             meta.origination_time     = time.empty()    ? nullptr : time.c_str();
             meta.time_reference       = tref;
-            ok = mh_audio_write_bwf(path.c_str(), interleaved.data(),
-                                    (unsigned int)channels, (unsigned int)frames,
-                                    sample_rate, bit_depth, &meta,
-                                    err, sizeof(err));
+            ok = mh_audio_write_planar_opts(path.c_str(), chans.data(),
+                                            (unsigned int)channels, (unsigned int)frames,
+                                            sample_rate, bit_depth, dither_mode,
+                                            &meta, err, sizeof(err));
         }
         if (!ok) {
             throw std::runtime_error(std::string(err));
         }
     }, nb::arg("path"), nb::arg("data"), nb::arg("sample_rate"),
        nb::arg("bit_depth") = 24, nb::arg("bwf") = nb::none(),
+       nb::arg("dither") = "tpdf",
        "Write audio data to a WAV or FLAC file. Data shape: (channels, "
        "frames). Pass bwf=dict(...) to embed Broadcast Wave (bext) metadata "
        "(WAV only); recognized keys: description, originator, "
        "originator_reference, origination_date ('yyyy-mm-dd'), "
        "origination_time ('hh:mm:ss'), time_reference (int samples since "
-       "midnight).");
+       "midnight). dither selects the quantization noise for 16/24-bit "
+       "output: 'tpdf' (flat triangular, default), 'none' (plain "
+       "rounding), or 'shaped' (TPDF plus second-order noise shaping); "
+       "applied during the existing float->int conversion, so no extra "
+       "pass over the data.");
 
     m.def("audio_resample", [](
                 nb::ndarray<const float, nb::shape<-1, -1>, nb::c_contig, nb::device::cpu> data,
                 unsigned int sample_rate_in,
-                unsigned int sample_rate_out) {
+                unsigned int sample_rate_out,
+                int quality,
+                int num_threads) {
         size_t channels = data.shape(0);
         size_t frames_in = data.shape(1);
 
+        if (quality < MH_RESAMPLE_QUALITY_FAST ||
+            quality > MH_RESAMPLE_QUALITY_HIGH) {
+            throw std::invalid_argument("quality must be 0 (fast), 1 (default) "
+                                        "or 2 (high)");
+        }
+
         // Accept any 2D float32 c-contiguous buffer-protocol producer
-        // (numpy ndarray, AudioBuffer via DLPack, memoryview, ...).
-        // Interleave for the miniaudio resampler.
-        std::vector<float> interleaved(channels * frames_in);
-        planar_to_interleaved(data.data(), interleaved.data(), channels, frames_in);
+        // (numpy ndarray, AudioBuffer via DLPack, memoryview, ...). The
+        // planar C path converts each channel independently (parallel
+        // when num_threads > 1), no interleave staging.
+        std::vector<const float*> chans(channels);
+        for (size_t c = 0; c < channels; ++c)
+            chans[c] = data.data() + c * frames_in;
 
         char err[1024] = {0};
-        MH_AudioData* result = mh_audio_resample(
-            interleaved.data(),
-            static_cast<unsigned int>(channels),
-            static_cast<unsigned int>(frames_in),
-            sample_rate_in, sample_rate_out,
-            err, sizeof(err));
+        MH_AudioDataPlanar* result;
+        {
+            nb::gil_scoped_release release;
+            result = mh_audio_resample_planar_mt(
+                chans.data(),
+                static_cast<unsigned int>(channels),
+                static_cast<unsigned int>(frames_in),
+                sample_rate_in, sample_rate_out,
+                quality, num_threads,
+                err, sizeof(err));
+        }
         if (!result) {
             throw std::runtime_error(std::string(err));
         }
 
-        unsigned int out_ch = result->channels;
-        unsigned int out_frames = result->frames;
-
-        // De-interleave directly into a fresh AudioBuffer. No numpy required.
-        auto* buf = new MhAudioBuffer((int)out_ch, (int)out_frames);
-        interleaved_to_planar(result->data, buf->data(), out_ch, out_frames);
-        mh_audio_data_free(result);
+        // Adopt the planar block as the AudioBuffer's storage (zero-copy).
+        auto* buf = new MhAudioBuffer(
+            MhAudioBuffer::AdoptTag{}, result->data,
+            (int)result->channels, (int)result->frames,
+            result, [](void* p) {
+                mh_audio_data_planar_free(static_cast<MH_AudioDataPlanar*>(p));
+            });
 
         return nb::cast(buf, nb::rv_policy::take_ownership);
     }, nb::arg("data"), nb::arg("sample_rate_in"), nb::arg("sample_rate_out"),
+       nb::arg("quality") = (int)MH_RESAMPLE_QUALITY_DEFAULT,
+       nb::arg("num_threads") = 1,
        "Resample audio data. Input: any 2D float32 c-contiguous buffer-protocol "
        "producer (AudioBuffer / numpy ndarray / ...). Returns an AudioBuffer at "
-       "sample_rate_out.");
+       "sample_rate_out. quality selects the anti-aliasing filter order "
+       "(0 fast, 1 default, 2 high); num_threads > 1 converts channels in "
+       "parallel (the GIL is released while converting).");
+
+    nb::class_<AudioFileWriter>(m, "AudioFileWriter",
+        "Streaming audio file writer with a background encode thread.\n\n"
+        "Blocks passed to write() are queued and encoded while the caller "
+        "renders the next one, so offline renders finish in "
+        "max(render, encode) time instead of the sum. write() blocks when "
+        "queue_blocks blocks are already pending, keeping memory bounded. "
+        "Encode errors surface from the next write() or from close().\n\n"
+        "Passing flush_interval > 0 opens a crash-safe WAV capture: the "
+        "container sizes are patched in place every flush_interval "
+        "seconds of audio, so an interrupted multi-hour recording loses "
+        "at most one interval instead of the whole file, and captures "
+        "past 4 GB are upgraded to RF64/BW64 in place. WAV only.\n\n"
+        "Passing unbuffered=True writes WAV with direct I/O (O_DIRECT; "
+        "F_NOCACHE on macOS), bypassing the page cache so multi-gigabyte "
+        "bounces cannot evict warm plugin binaries and sample libraries "
+        "on shared render nodes. Mutually exclusive with flush_interval; "
+        "falls back to buffered writes where direct I/O is unavailable.")
+        .def(nb::init<const std::string&, int, int, int, int, double, bool,
+                      const std::string&>(),
+             nb::arg("path"), nb::arg("channels"), nb::arg("sample_rate"),
+             nb::arg("bit_depth") = 24, nb::arg("queue_blocks") = 8,
+             nb::arg("flush_interval") = 0.0, nb::arg("unbuffered") = false,
+             nb::arg("dither") = "tpdf",
+             "Open a .wav or .flac file for streaming writes (same formats "
+             "and bit depths as audio_write). flush_interval > 0 selects "
+             "crash-safe WAV capture mode; unbuffered=True selects "
+             "direct-I/O WAV writing. dither picks the noise applied "
+             "during 16/24-bit quantization: 'tpdf' (flat triangular, the "
+             "historical default), 'none' (plain rounding, deterministic "
+             "output), or 'shaped' (TPDF plus second-order noise shaping "
+             "for mastering deliverables).")
+        .def("write", &AudioFileWriter::write, nb::arg("block"),
+             "Queue a block for encoding. Shape (channels, frames); extra "
+             "channels beyond the writer's channel count are ignored.")
+        .def("close", &AudioFileWriter::close,
+             "Drain the queue, finalize the file, and raise any deferred "
+             "encode error. Idempotent.")
+        .def_prop_ro("frames_written", &AudioFileWriter::frames_written,
+             "Total frames accepted by write() so far.")
+        .def("__enter__", &AudioFileWriter::enter, nb::rv_policy::reference)
+        .def("__exit__", [](AudioFileWriter& self, const nb::args&) {
+            self.close();
+        });
+
+    nb::class_<AudioFileReader>(m, "AudioFileReader",
+        "Streaming audio file reader (pull-based decoder).\n\n"
+        "read_into() decodes the next block straight into a caller-provided "
+        "AudioBuffer, so multi-GB files flow through a block loop with one "
+        "fixed-size buffer instead of ever being resident. Same formats as "
+        "read_audio (WAV, FLAC, MP3, Vorbis). The decode-side counterpart "
+        "to AudioFileWriter.")
+        .def(nb::init<const std::string&>(), nb::arg("path"),
+             "Open a file for streaming decode.")
+        .def_prop_ro("channels", &AudioFileReader::channels,
+             "Channel count of the stream.")
+        .def_prop_ro("sample_rate", &AudioFileReader::sample_rate,
+             "Sample rate of the stream in Hz.")
+        .def_prop_ro("frames", &AudioFileReader::frames,
+             "Total frame count, or 0 when the backing format cannot "
+             "report a length without a full scan.")
+        .def("read_into", &AudioFileReader::read_into, nb::arg("buf"),
+             "Decode up to buf.frames frames into buf (planar, in place). "
+             "Returns the number of frames produced: the full request "
+             "mid-stream, less near the end of the file, 0 at EOF.")
+        .def("seek", &AudioFileReader::seek, nb::arg("frame"),
+             "Seek to an absolute frame position. Raises on decode error "
+             "or an unseekable stream.")
+        .def("close", &AudioFileReader::close,
+             "Close the reader. Idempotent.")
+        .def("__enter__", &AudioFileReader::enter, nb::rv_policy::reference)
+        .def("__exit__", [](AudioFileReader& self, const nb::args&) {
+            self.close();
+        });
+
+    nb::class_<LoudnessMeter>(m, "LoudnessMeter",
+        "Streaming EBU R128 / ITU-R BS.1770 loudness meter.\n\n"
+        "Feed planar float32 blocks with process() -- render output, "
+        "AudioFileReader blocks, or a PluginGraph.node_audio() tap view "
+        "all work without copies -- and read integrated() / shortterm() "
+        "loudness at any point. The K-weighting filters, 400 ms gating "
+        "blocks, and 3 s short-term window live in native state, so "
+        "album-length material is metered block by block in one pass "
+        "alongside the render instead of a numpy pass afterwards. "
+        "Not thread-safe; use one meter per stream.")
+        .def(nb::init<int, int>(), nb::arg("channels"),
+             nb::arg("sample_rate"),
+             "Create a meter for `channels` channels at `sample_rate` Hz "
+             "(>= 8000).")
+        .def("process", &LoudnessMeter::process, nb::arg("block"),
+             "Update the measurement with one planar (channels, frames) "
+             "float32 block. Any per-channel stride is accepted as long "
+             "as frames are contiguous, so graph tap views feed straight "
+             "in. Blocks may be any length; hop and window boundaries "
+             "are tracked internally. Releases the GIL while metering.")
+        .def("integrated", &LoudnessMeter::integrated,
+             "Gated integrated loudness in LUFS over everything "
+             "processed so far. -inf until 400 ms of audio has passed "
+             "the -70 LUFS absolute gate.")
+        .def("shortterm", &LoudnessMeter::shortterm,
+             "Ungated short-term loudness in LUFS over the most recent "
+             "3 seconds. -inf before the first 100 ms completes.")
+        .def("sample_peak", &LoudnessMeter::sample_peak,
+             nb::arg("channel"),
+             "Running linear sample peak of one channel since "
+             "creation/reset, measured on the raw input.")
+        .def("reset", &LoudnessMeter::reset,
+             "Drop all measurement state and start a new stream. Keeps "
+             "the channel count and sample rate.")
+        .def_prop_ro("channels", &LoudnessMeter::channels,
+             "Channel count the meter was opened with.");
+
+    m.def("measure_peak_rms",
+          [](nb::ndarray<const float, nb::shape<-1, -1>,
+                         nb::device::cpu> block) {
+        const int channels = (int)block.shape(0);
+        const size_t frames = block.shape(1);
+        if (frames > 0 && block.stride(1) != 1) {
+            throw std::runtime_error(
+                "Block frames must be contiguous per channel "
+                "(stride 1 along the last axis)");
+        }
+        std::vector<const float*> ptrs((size_t)channels);
+        for (int c = 0; c < channels; c++) {
+            ptrs[(size_t)c] = block.data() + (int64_t)c * block.stride(0);
+        }
+        std::vector<float> peaks((size_t)channels, 0.0f);
+        std::vector<float> rms((size_t)channels, 0.0f);
+        if (channels > 0 && frames > 0) {
+            int ok;
+            {
+                nb::gil_scoped_release release;
+                ok = mh_measure_peak_rms(ptrs.data(),
+                                         (unsigned int)channels,
+                                         (unsigned int)frames,
+                                         peaks.data(), rms.data());
+            }
+            if (!ok) {
+                throw std::runtime_error("peak/RMS measurement failed");
+            }
+        }
+        nb::list peaks_out;
+        nb::list rms_out;
+        for (int c = 0; c < channels; c++) {
+            peaks_out.append(peaks[(size_t)c]);
+            rms_out.append(rms[(size_t)c]);
+        }
+        return nb::make_tuple(peaks_out, rms_out);
+    }, nb::arg("block"),
+       "Scan a planar (channels, frames) float32 block for per-channel "
+       "linear peak and RMS in one native pass. Accepts AudioBuffers and "
+       "PluginGraph.node_audio() tap views via DLPack without copying. "
+       "Returns (peaks, rms) lists of length channels. Releases the GIL "
+       "while scanning.");
 
     m.def("audio_get_file_info", [](const std::string& path) {
         char err[1024] = {0};
@@ -4098,4 +9791,70 @@ NB_MODULE(_core, m) {
         return result;
     }, nb::arg("path"),
        "Get audio file metadata without decoding.");
+
+    m.def("audio_cache_set_budget", [](unsigned long long max_bytes) {
+        mh_audio_cache_set_budget(max_bytes);
+    }, nb::arg("max_bytes"),
+       "Set the decoded-audio cache budget in bytes. Once a budget is "
+       "set, read_audio serves repeated reads of an unchanged file "
+       "(same path, mtime, and size) from decoded planar float32 kept "
+       "in memory instead of decoding again -- A/B loops that re-read "
+       "the same stems dozens of times pay one decode per stem. LRU "
+       "entries are evicted to stay inside the budget. 0 (the default) "
+       "disables the cache and drops every entry.");
+
+    m.def("audio_cache_stats", []() {
+        MH_AudioCacheStats stats;
+        mh_audio_cache_stats(&stats);
+        nb::dict result;
+        result["bytes"] = stats.bytes;
+        result["entries"] = stats.entries;
+        result["hits"] = stats.hits;
+        result["misses"] = stats.misses;
+        result["evictions"] = stats.evictions;
+        return result;
+    }, "Decoded-audio cache counters: resident bytes and entries, plus "
+       "cumulative hits, misses, and evictions since process start.");
+
+    m.def("audio_cache_clear", []() {
+        mh_audio_cache_clear();
+    }, "Drop every cached decode. The budget is unchanged, so caching "
+       "resumes with the next read.");
+
+    // Negotiated-layout cache (mh_layout_cache_*): check_buses_layout
+    // answers memoized per (plugin identifier, version, layout), with
+    // export/import so minihost.plugincache can persist them between
+    // runs.
+    m.def("layout_cache_size", []() {
+        return mh_layout_cache_size();
+    }, "Number of memoized bus-layout answers (see "
+       "Plugin.check_buses_layout).");
+
+    m.def("layout_cache_clear", []() {
+        mh_layout_cache_clear();
+    }, "Drop every memoized bus-layout answer, forcing cold re-probes.");
+
+    m.def("layout_cache_export", []() {
+        // Size-then-fill, retried in case another thread grows the
+        // cache between the two calls.
+        int needed = mh_layout_cache_export(nullptr, 0);
+        std::string blob;
+        for (;;) {
+            blob.assign((size_t) needed, '\0');
+            int now = mh_layout_cache_export(&blob[0], needed);
+            if (now <= needed) {
+                blob.resize((size_t) now - 1);  // drop the NUL
+                break;
+            }
+            needed = now;
+        }
+        return blob;
+    }, "Serialize the bus-layout cache to a text blob (one answer per "
+       "line) for persistence; feed it back to layout_cache_import.");
+
+    m.def("layout_cache_import", [](const std::string& data) {
+        return mh_layout_cache_import(data.c_str());
+    }, nb::arg("data"),
+       "Merge a blob from layout_cache_export into the cache. Malformed "
+       "lines are skipped. Returns the number of answers imported.");
 }
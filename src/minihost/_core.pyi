@@ -1,6 +1,6 @@
 """Type stubs for minihost._core native extension module."""
 
-from typing import Any, Callable, ClassVar, Union, overload
+from typing import Any, Callable, ClassVar, Sequence, Union, overload
 
 import numpy as np
 from numpy.typing import NDArray
@@ -70,6 +70,9 @@ class AudioBuffer:
         self, start: int | None = None, count: int | None = None
     ) -> float: ...
     def copy(self) -> "AudioBuffer": ...
+    def apply(self, ops: list["BufferOp"]) -> dict[str, float] | None: ...
+    def channel_view(self, start: int, count: int) -> "AudioBuffer": ...
+    def frame_view(self, start: int, count: int) -> "AudioBuffer": ...
     def as_ndarray(self) -> NDArray[np.float32]: ...
     @classmethod
     def from_numpy(cls, array: Any) -> "AudioBuffer": ...
@@ -134,6 +137,9 @@ class AudioBufferD:
         self, start: int | None = None, count: int | None = None
     ) -> float: ...
     def copy(self) -> "AudioBufferD": ...
+    def apply(self, ops: list["BufferOp"]) -> dict[str, float] | None: ...
+    def channel_view(self, start: int, count: int) -> "AudioBufferD": ...
+    def frame_view(self, start: int, count: int) -> "AudioBufferD": ...
     def as_ndarray(self) -> NDArray[np.float64]: ...
     @classmethod
     def from_numpy(cls, array: Any) -> "AudioBufferD": ...
@@ -141,6 +147,37 @@ class AudioBufferD:
     def __dlpack__(self, stream: Any = None) -> Any: ...
     def __dlpack_device__(self) -> tuple[int, int]: ...
 
+class BufferOp:
+    """One step of a fused DSP batch for AudioBuffer.apply()."""
+
+    @staticmethod
+    def gain(gain: float) -> "BufferOp": ...
+    @staticmethod
+    def gain_ramp(
+        start: int, count: int, gain_start: float, gain_end: float
+    ) -> "BufferOp": ...
+    @staticmethod
+    def fade_in(count: int) -> "BufferOp": ...
+    @staticmethod
+    def fade_out(count: int) -> "BufferOp": ...
+    @staticmethod
+    def measure(peak: bool = True, rms: bool = False) -> "BufferOp": ...
+
+class BufferPool:
+    """Recycling pool of fixed-shape AudioBuffers for block loops."""
+
+    def __init__(self, channels: int, frames: int, capacity: int = 8) -> None: ...
+    def acquire(self) -> AudioBuffer: ...
+    def release(self, buf: AudioBuffer) -> None: ...
+    @property
+    def channels(self) -> int: ...
+    @property
+    def frames(self) -> int: ...
+    @property
+    def available(self) -> int: ...
+    @property
+    def total(self) -> int: ...
+
 class Plugin:
     """Audio plugin wrapper for VST3 and AudioUnit plugins."""
 
@@ -214,6 +251,10 @@ class Plugin:
     def processing_precision(self) -> int: ...
     @processing_precision.setter
     def processing_precision(self, value: int) -> None: ...
+    def set_automation_granularity(
+        self, min_subblock_frames: int, mode: int = 0
+    ) -> None: ...
+    def get_automation_granularity(self) -> tuple[int, int]: ...
     def get_bus_info(self, is_input: bool, bus_index: int) -> dict[str, Any]: ...
     def check_buses_layout(
         self, input_channels: list[int], output_channels: list[int]
@@ -235,10 +276,19 @@ class Plugin:
     ) -> None: ...
     def get_param(self, index: int) -> float: ...
     def set_param(self, index: int, value: float) -> None: ...
+    def set_params(self, params: Sequence[tuple[int, float]]) -> None:
+        """Set a batch of parameters under one state-lock acquisition.
+
+        Values are clamped to [0, 1]. Batch writes skip per-parameter
+        value-callback notifications (intended for restoring snapshots).
+        """
+        ...
     def find_param(self, name: str) -> int: ...
+    def find_param_by_id(self, param_id: str) -> int: ...
     def get_param_by_name(self, name: str) -> float: ...
     def set_param_by_name(self, name: str, value: float) -> None: ...
     def get_param_info(self, index: int) -> dict[str, Any]: ...
+    def get_all_param_info(self) -> list[dict[str, Any]]: ...
     def param_to_text(self, index: int, value: float) -> str: ...
     def param_from_text(self, index: int, text: str) -> float: ...
     def get_program_name(self, index: int) -> str: ...
@@ -264,12 +314,39 @@ class Plugin:
         input: AudioInput,
         output: AudioInput,
     ) -> None: ...
+    def process_into(
+        self,
+        input: "AudioBuffer",
+        output: "AudioBuffer",
+    ) -> None: ...
+    def process_blocks(
+        self,
+        input: AudioInput,
+        output: AudioInput,
+        block_size: int,
+        progress: Callable[[int, int], None] | None = None,
+        progress_interval: int = 64,
+    ) -> None: ...
+    def detect_tail(
+        self,
+        block_size: int = 512,
+        threshold_db: float = -80.0,
+        hold_blocks: int = 4,
+        max_seconds: float = 30.0,
+    ) -> int: ...
     def process_midi(
         self,
         input: AudioInput,
         output: AudioInput,
         midi_in: list[tuple[int, int, int, int]],
     ) -> list[tuple[int, int, int, int]]: ...
+    def process_midi_timeline(
+        self,
+        input: AudioInput,
+        output: AudioInput,
+        timeline: MidiEventTimeline,
+        start: int,
+    ) -> list[tuple[int, int, int, int]]: ...
     def process_auto(
         self,
         input: AudioInput,
@@ -288,6 +365,15 @@ class Plugin:
         input: NDArray[np.float64],
         output: NDArray[np.float64],
     ) -> None: ...
+    def render_blocks(
+        self,
+        input: AudioBuffer | None,
+        out_frames: int,
+        block_size: int,
+        latency: int = 0,
+        midi_in: list[tuple[int, int, int, int]] = ...,
+        param_changes: list[tuple[int, int, float]] = ...,
+    ) -> AudioBuffer: ...
     def morph_capture(self) -> list[float]:
         """Snapshot every parameter's current normalized value."""
         ...
@@ -297,6 +383,9 @@ class Plugin:
     def morph(self, a: list[float], b: list[float], t: float) -> list[float]:
         """Interpolate snapshots a and b at blend t, apply, and return it."""
         ...
+    def apply_morph(self, automation: "MorphAutomation", sample: int) -> float:
+        """Apply a MorphAutomation's blend at a sample position; returns t."""
+        ...
 
 class PluginChain:
     """Chain of audio plugins for sequential processing."""
@@ -317,19 +406,51 @@ class PluginChain:
     def get_plugin(self, index: int) -> Plugin: ...
     def set_mix(self, plugin_index: int, mix: float) -> None: ...
     def get_mix(self, plugin_index: int) -> float: ...
+    def set_tracing(self, capacity_events: int) -> None: ...
+    def trace_dump(self, path: str) -> None: ...
     def reset(self) -> None: ...
     def set_non_realtime(self, non_realtime: bool) -> None: ...
+    def set_silence_skip(self, enabled: bool) -> None: ...
+    def replace_plugin(self, index: int, plugin: Plugin) -> None: ...
+    def replace_pending(self) -> bool: ...
     def process(
         self,
         input: AudioInput,
         output: AudioInput,
     ) -> None: ...
+    def process_into(
+        self,
+        input: "AudioBuffer",
+        output: "AudioBuffer",
+    ) -> None: ...
+    def process_blocks(
+        self,
+        input: AudioInput,
+        output: AudioInput,
+        block_size: int,
+        progress: Callable[[int, int], None] | None = None,
+        progress_interval: int = 64,
+    ) -> None: ...
+    def detect_tail(
+        self,
+        block_size: int = 512,
+        threshold_db: float = -80.0,
+        hold_blocks: int = 4,
+        max_seconds: float = 30.0,
+    ) -> int: ...
     def process_midi(
         self,
         input: AudioInput,
         output: AudioInput,
         midi_in: list[tuple[int, int, int, int]],
     ) -> list[tuple[int, int, int, int]]: ...
+    def process_midi_timeline(
+        self,
+        input: AudioInput,
+        output: AudioInput,
+        timeline: MidiEventTimeline,
+        start: int,
+    ) -> list[tuple[int, int, int, int]]: ...
     def process_auto(
         self,
         input: AudioInput,
@@ -384,11 +505,16 @@ class PluginGraph:
 
     def __init__(self, max_block_size: int, sample_rate: float) -> None: ...
     def add_plugin(self, plugin: "Plugin") -> int: ...
+    def add_plugin_oversampled(self, plugin: "Plugin", factor: int) -> int: ...
     def add_input(self, channels: int) -> int: ...
     def add_output(self, channels: int) -> int: ...
     def add_mix(self, num_inputs: int, channels: int) -> int: ...
     def add_pick_channel(self, in_channels: int, channel_index: int) -> int: ...
     def add_merge_channels(self, out_channels: int) -> int: ...
+    def add_resample(self, channels: int, source_rate: float) -> int: ...
+    def resample_write(self, node_id: int, frames: NDArray[np.float32]) -> None: ...
+    def resample_frames_needed(self, node_id: int, nframes: int) -> int: ...
+    def add_convolve(self, channels: int, ir: NDArray[np.float32]) -> int: ...
     def add_midi_processor(self, params: dict[str, Any]) -> int: ...
     def set_midi_processor_params(
         self, node_id: int, params: dict[str, Any]
@@ -407,16 +533,40 @@ class PluginGraph:
         self, node_id: int
     ) -> list[tuple[int, int, int, int]]: ...
     def compile(self) -> None: ...
+    def begin_edit(self) -> None: ...
     def render_block(
         self,
         inputs: list[AudioInput],
         outputs: list[AudioInput],
         nframes: int,
     ) -> None: ...
+    def render_block_into(
+        self,
+        inputs: list["AudioBuffer"],
+        outputs: list["AudioBuffer"],
+        nframes: int,
+    ) -> None: ...
     def set_node_automation(
         self, node_id: int, changes: list[tuple[int, int, float]]
     ) -> None: ...
     @property
+    def profiling(self) -> bool: ...
+    @profiling.setter
+    def profiling(self, value: bool) -> None: ...
+    def node_stats(self, node_id: int) -> dict[str, Any]: ...
+    def reset_node_stats(self) -> None: ...
+    def set_tracing(self, capacity_events: int) -> None: ...
+    def trace_dump(self, path: str) -> None: ...
+    def set_silence_skip(self, enabled: bool) -> None: ...
+    def set_node_bypass(self, node_id: int, bypassed: bool) -> None: ...
+    def get_node_bypass(self, node_id: int) -> bool: ...
+    def set_pool_huge_pages(self, enabled: bool) -> None: ...
+    def freeze_node(self, node_id: int) -> None: ...
+    def freeze_finish(self, node_id: int) -> None: ...
+    def unfreeze_node(self, node_id: int) -> None: ...
+    def freeze_rewind(self) -> None: ...
+    def freeze_is_stale(self, node_id: int) -> bool: ...
+    @property
     def num_nodes(self) -> int: ...
     @property
     def num_input_nodes(self) -> int: ...
@@ -424,6 +574,8 @@ class PluginGraph:
     def num_output_nodes(self) -> int: ...
     @property
     def is_compiled(self) -> bool: ...
+    @property
+    def latency_samples(self) -> int: ...
     def close(self) -> None: ...
     def __enter__(self) -> "PluginGraph": ...
     def __exit__(self, *args: object) -> None: ...
@@ -442,7 +594,9 @@ class Session:
         sidechain_channels: int = 0,
     ) -> "Plugin": ...
     def probe(self, path: str) -> dict: ...
-    def scan_directory(self, directory_path: str) -> list[dict]: ...
+    def scan_directory(
+        self, directory_path: str, num_threads: int = 1
+    ) -> list[dict]: ...
     def close(self) -> None: ...
     def __enter__(self) -> "Session": ...
     def __exit__(self, *args: object) -> None: ...
@@ -471,6 +625,16 @@ class AudioDevice:
     @property
     def channels(self) -> int: ...
     @property
+    def load(self) -> float: ...
+    @property
+    def xrun_count(self) -> int: ...
+    def record_start(self, path: str, bit_depth: int = 32) -> None: ...
+    def record_stop(self) -> None: ...
+    @property
+    def is_recording(self) -> bool: ...
+    @property
+    def record_dropped_frames(self) -> int: ...
+    @property
     def midi_input_port(self) -> int: ...
     @property
     def midi_output_port(self) -> int: ...
@@ -487,6 +651,12 @@ class AudioDevice:
     def create_virtual_midi_input(self, port_name: str) -> None: ...
     def create_virtual_midi_output(self, port_name: str) -> None: ...
     def send_midi(self, status: int, data1: int, data2: int) -> None: ...
+    def set_cc_map(
+        self, mappings: list[tuple[int, int, int, int, Sequence[float]]]
+    ) -> None: ...
+    def clear_cc_map(self) -> None: ...
+    def set_loop_source(self, data: AudioInput) -> None: ...
+    def clear_loop_source(self) -> None: ...
     def enable_input(self, capacity_frames: int = 0) -> None: ...
     def disable_input(self) -> None: ...
     def write_input(self, data: AudioInput) -> int: ...
@@ -531,6 +701,30 @@ class MidiFile:
     def make_delta_ticks(self) -> None: ...
     def join_tracks(self) -> None: ...
     def split_tracks(self) -> None: ...
+    def sample_events(self, sample_rate: float) -> "MidiEventTimeline": ...
+
+class MidiEventTimeline:
+    """Packed, time-sorted MIDI event timeline at a fixed sample rate."""
+
+    def __len__(self) -> int: ...
+    @property
+    def max_sample(self) -> int: ...
+    @property
+    def max_seconds(self) -> float: ...
+    def slice(self, start: int, end: int) -> list[tuple[int, int, int, int]]: ...
+    def to_list(self) -> list[tuple[int, int, int, int]]: ...
+
+class MorphAutomation:
+    """Snapshots A/B plus a piecewise-linear blend curve over sample positions."""
+
+    def __init__(
+        self,
+        a: Sequence[float],
+        b: Sequence[float],
+        curve: Sequence[tuple[int, float]],
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def t_at(self, sample: int) -> float: ...
 
 class MidiIn:
     """Standalone MIDI input for monitoring MIDI messages."""
@@ -573,12 +767,27 @@ def audio_get_capture_devices() -> list[dict[str, Any]]:
     """
     ...
 
+def rt_audit_enabled() -> bool:
+    """True if RT-safety audit mode is active (MINIHOST_RT_AUDIT=1)."""
+    ...
+
+def rt_audit_report() -> tuple[int, str]:
+    """Return (hit_count, report_text) for allocations trapped in
+    audited audio paths."""
+    ...
+
+def rt_audit_reset() -> None:
+    """Clear the RT-audit hit table and counter."""
+    ...
+
 MH_CHANGE_LATENCY: int
 MH_CHANGE_PARAM_INFO: int
 MH_CHANGE_PROGRAM: int
 MH_CHANGE_NON_PARAM_STATE: int
 MH_PRECISION_SINGLE: int
 MH_PRECISION_DOUBLE: int
+MH_AUTOMATION_SAMPLE_ACCURATE: int
+MH_AUTOMATION_BLOCK_RATE: int
 
 # Default MIDI-output capacity for the process_* entry points.
 MIDI_OUT_CAPACITY: int
@@ -623,6 +832,8 @@ def audio_resample(
     data: AudioInput,
     sample_rate_in: int,
     sample_rate_out: int,
+    quality: int = 1,
+    num_threads: int = 1,
 ) -> "AudioBuffer":
     """Resample audio data. Returns AudioBuffer regardless of input type."""
     ...
@@ -631,6 +842,62 @@ def audio_get_file_info(path: str) -> dict[str, Any]:
     """Get audio file metadata without decoding."""
     ...
 
+class AudioFileWriter:
+    """Streaming audio file writer with a background encode thread.
+
+    Blocks passed to :meth:`write` are queued and encoded while the
+    caller renders the next one. ``write`` blocks once ``queue_blocks``
+    blocks are pending. Encode errors surface from the next ``write``
+    or from ``close``.
+    """
+
+    def __init__(
+        self,
+        path: str,
+        channels: int,
+        sample_rate: int,
+        bit_depth: int = 24,
+        queue_blocks: int = 8,
+    ) -> None: ...
+    def write(self, block: AudioInput) -> None:
+        """Queue a block (shape ``(channels, frames)``) for encoding."""
+        ...
+    def close(self) -> None:
+        """Drain the queue, finalize the file, and raise any deferred error."""
+        ...
+    @property
+    def frames_written(self) -> int:
+        """Total frames accepted by ``write`` so far."""
+        ...
+    def __enter__(self) -> "AudioFileWriter": ...
+    def __exit__(self, *args: Any) -> None: ...
+
+class AudioFileReader:
+    """Streaming audio file reader (pull-based decoder).
+
+    ``read_into`` decodes the next block straight into a caller-provided
+    :class:`AudioBuffer`, so long files flow through a block loop with
+    one fixed-size buffer instead of ever being resident.
+    """
+
+    def __init__(self, path: str) -> None: ...
+    @property
+    def channels(self) -> int: ...
+    @property
+    def sample_rate(self) -> int: ...
+    @property
+    def frames(self) -> int:
+        """Total frame count, or 0 when the format cannot report one."""
+        ...
+    def read_into(self, buf: AudioBuffer) -> int:
+        """Decode up to ``buf.frames`` frames into ``buf``; returns the
+        number of frames produced (0 at EOF)."""
+        ...
+    def seek(self, frame: int) -> None: ...
+    def close(self) -> None: ...
+    def __enter__(self) -> "AudioFileReader": ...
+    def __exit__(self, *args: Any) -> None: ...
+
 def vstpreset_read_class_id_from_bundle(vst3_path: str) -> str:
     """Read the processor class ID (32-char uppercase hex FUID) from a VST3 bundle."""
     ...
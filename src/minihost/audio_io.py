@@ -94,6 +94,7 @@ def write_audio(
     sample_rate: int,
     bit_depth: int = 24,
     bwf: dict | None = None,
+    dither: str = "tpdf",
 ) -> None:
     """Write audio data to an audio file (WAV or FLAC).
 
@@ -112,6 +113,13 @@ def write_audio(
             ``origination_time`` ('hh:mm:ss'), ``time_reference`` (int samples
             since midnight). Only valid for WAV; passing it with a FLAC path
             raises.
+        dither: Quantization noise for 16/24-bit output, applied during
+            the native float->int conversion (no extra pass over the
+            data). ``"tpdf"`` (flat triangular dither, the default),
+            ``"none"`` (plain rounding; deterministic output), or
+            ``"shaped"`` (TPDF plus second-order noise shaping --
+            the mastering-deliverable option that used to require a
+            separate dither pass). Ignored for 32-bit float output.
 
     Raises:
         ValueError: If bit_depth is invalid or extension is unsupported.
@@ -149,13 +157,15 @@ def write_audio(
         if write_data.ndim == 1:
             write_data = write_data.reshape(1, -1)
 
-    _write(str(path), write_data, int(sample_rate), bit_depth, bwf)
+    _write(str(path), write_data, int(sample_rate), bit_depth, bwf, dither)
 
 
 def resample(
     data: Any,
     sample_rate_in: int,
     sample_rate_out: int,
+    quality: int = 1,
+    num_threads: int = 1,
 ) -> Any:
     """Resample audio data to a different sample rate.
 
@@ -165,6 +175,10 @@ def resample(
             buffer.
         sample_rate_in: Source sample rate in Hz.
         sample_rate_out: Target sample rate in Hz.
+        quality: Anti-aliasing filter preset: 0 (fast), 1 (default),
+            or 2 (high).
+        num_threads: Channels are independent conversions; > 1 runs
+            them in parallel (useful for 16-32 channel stems).
 
     Returns:
         Resampled data of shape (channels, new_samples). The return type
@@ -176,7 +190,8 @@ def resample(
 
     if is_audiobuffer:
         # AudioBuffer goes straight through DLPack; no numpy needed.
-        out = _resample(data, int(sample_rate_in), int(sample_rate_out))
+        out = _resample(data, int(sample_rate_in), int(sample_rate_out),
+                        int(quality), int(num_threads))
         return out  # AudioBuffer
 
     # Non-AudioBuffer input: coerce via numpy (lazy import). The C
@@ -188,7 +203,8 @@ def resample(
     arr = np.ascontiguousarray(data, dtype=np.float32)
     if arr.ndim == 1:
         arr = arr.reshape(1, -1)
-    out = _resample(arr, int(sample_rate_in), int(sample_rate_out))  # AudioBuffer
+    out = _resample(arr, int(sample_rate_in), int(sample_rate_out),
+                    int(quality), int(num_threads))  # AudioBuffer
 
     if is_numpy:
         return out.as_ndarray()
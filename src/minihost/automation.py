@@ -22,7 +22,7 @@ from pathlib import Path
 from typing import TYPE_CHECKING
 
 if TYPE_CHECKING:
-    from minihost._core import Plugin
+    from minihost._core import KeyframeAutomation, Plugin
 
 
 def find_param_by_name(plugin: Plugin, name: str) -> int:
@@ -268,3 +268,93 @@ def parse_automation_file(
     # Sort by sample offset for process_auto()
     changes.sort(key=lambda x: x[0])
     return changes
+
+
+def parse_automation_curves(
+    path: str | Path,
+    plugin: Plugin,
+    sample_rate: int,
+    total_length_samples: int,
+) -> "KeyframeAutomation":
+    """Parse a JSON automation file into a native keyframe object.
+
+    The lazy counterpart to :func:`parse_automation_file`: instead of
+    expanding keyframes into a dense per-block change list up front
+    (``block_size`` granularity, millions of tuples for a long render),
+    the keyframes go into a :class:`minihost.KeyframeAutomation` as-is
+    and are interpolated natively per block at render time -- pass the
+    result as ``process_audio(..., curves=...)``. Static values become
+    single keyframes (held for the whole render by the curve's clamping).
+
+    Args:
+        path: Path to JSON automation file (same format as
+            :func:`parse_automation_file`).
+        plugin: Plugin instance for parameter name lookup and text
+            parsing.
+        sample_rate: Sample rate in Hz.
+        total_length_samples: Total length of the audio in samples.
+
+    Returns:
+        A :class:`minihost.KeyframeAutomation` holding one curve per
+        automated parameter.
+
+    Raises:
+        FileNotFoundError: If the file does not exist.
+        ValueError: If the JSON format is invalid or the file automates
+            no parameters.
+    """
+    from minihost._core import KeyframeAutomation
+
+    path = Path(path)
+    if not path.exists():
+        raise FileNotFoundError(f"Automation file not found: {path}")
+
+    with open(path) as f:
+        data = json.load(f)
+
+    if not isinstance(data, dict):
+        raise ValueError("Automation file must contain a JSON object at the top level.")
+
+    keyframes: list[tuple[int, int, float]] = []
+
+    for param_name, spec in data.items():
+        param_idx = find_param_by_name(plugin, param_name)
+
+        if isinstance(spec, (int, float)):
+            keyframes.append((0, param_idx, float(spec)))
+
+        elif isinstance(spec, str):
+            try:
+                value = plugin.param_from_text(param_idx, spec)
+            except (RuntimeError, ValueError) as e:
+                raise ValueError(
+                    f"Could not parse text value '{spec}' "
+                    f"for parameter '{param_name}': {e}"
+                ) from e
+            keyframes.append((0, param_idx, value))
+
+        elif isinstance(spec, dict):
+            for time_key, value in spec.items():
+                sample_offset = _parse_time_key(
+                    time_key, sample_rate, total_length_samples
+                )
+                if isinstance(value, str):
+                    try:
+                        value = plugin.param_from_text(param_idx, value)
+                    except (RuntimeError, ValueError) as e:
+                        raise ValueError(
+                            f"Could not parse text value '{value}' at time "
+                            f"'{time_key}' for parameter '{param_name}': {e}"
+                        ) from e
+                keyframes.append((sample_offset, param_idx, float(value)))
+
+        else:
+            raise ValueError(
+                f"Invalid automation spec for '{param_name}': "
+                f"expected number, string, or object, got {type(spec).__name__}"
+            )
+
+    if not keyframes:
+        raise ValueError(f"Automation file automates no parameters: {path}")
+
+    return KeyframeAutomation(keyframes)
@@ -25,6 +25,12 @@ import signal
 import sys
 import time
 
+# The minihost package loads its exports lazily (PEP 562): this import is a
+# few milliseconds and does NOT pull in the native _core extension. Each
+# subcommand pays for exactly the attributes it touches, so --help, shell
+# completion, and cache-only paths (e.g. `info --probe` on a cache hit)
+# never load the native module. Keep module scope free of minihost
+# attribute access to preserve that.
 import minihost
 
 
@@ -1026,37 +1032,28 @@ def _midi_loop_thread(audio, midi_file_path, sample_rate, stop_event):
             audio.send_midi(0xB0 | ch, _ALL_NOTES_OFF_CC, 0)
 
 
-def _audio_loop_thread(audio, audio_file_path, sample_rate, stop_event):
-    """Feed audio file data into the AudioDevice's input ring buffer at
-    real-time pace, looping from the start when the file ends.
-
-    Caller must have already enabled the input ring buffer
-    (``audio.enable_input()``). The file is auto-resampled to the device's
-    sample rate.
+def _load_loop_audio(audio, audio_file_path, sample_rate) -> bool:
+    """Decode an audio file and install it as the AudioDevice's native
+    loop source: the audio callback reads the preloaded buffer directly
+    with wraparound, so looping needs no feeding thread (and no Python
+    in the real-time path). The file is resampled up front to the
+    device's sample rate. Returns False on failure (error printed).
     """
     try:
         data, file_sr = minihost.read_audio(audio_file_path)
     except (FileNotFoundError, RuntimeError) as e:
         print(f"loop-audio: {e}", file=sys.stderr)
-        return
+        return False
 
     if int(file_sr) != int(sample_rate):
         data = minihost.resample(data, int(file_sr), int(sample_rate))
 
-    block_size = 1024
-    # Pace at slightly less than real time so the ring buffer stays fed
-    # without overflowing (mirrors the README example).
-    block_period = (block_size / sample_rate) * 0.9
-
-    while not stop_event.is_set():
-        for start in range(0, data.frames, block_size):
-            if stop_event.is_set():
-                return
-            end = min(start + block_size, data.frames)
-            chunk = data[:, start:end]
-            audio.write_input(chunk)
-            if stop_event.wait(block_period):
-                return
+    try:
+        audio.set_loop_source(data)
+    except RuntimeError as e:
+        print(f"loop-audio: {e}", file=sys.stderr)
+        return False
+    return True
 
 
 def cmd_play(args: argparse.Namespace) -> int:
@@ -1067,8 +1064,8 @@ def cmd_play(args: argparse.Namespace) -> int:
 
     if loop_audio_path and capture:
         print(
-            "Error: --loop-audio and --input both write to the input "
-            "ring buffer. Use one or the other.",
+            "Error: --loop-audio and --input both provide the plugin's "
+            "audio input. Use one or the other.",
             file=sys.stderr,
         )
         return 1
@@ -1272,24 +1269,36 @@ def cmd_play(args: argparse.Namespace) -> int:
     signal.signal(signal.SIGINT, on_signal)
     signal.signal(signal.SIGTERM, on_signal)
 
-    # If --loop-audio is set, prepare the input ring buffer before
-    # starting the audio device so the first block doesn't underrun.
+    # If --loop-audio is set, preload the file into the native loop
+    # source before starting the audio device so the first block plays
+    # audio (the callback reads the buffer directly -- no feeding thread).
     if loop_audio_path:
-        try:
-            audio.enable_input()
-        except RuntimeError as e:
-            print(f"Error enabling input ring buffer: {e}", file=sys.stderr)
+        if not _load_loop_audio(audio, loop_audio_path, audio.sample_rate):
             return 1
         print(f"  Loop audio: {loop_audio_path}")
     if loop_midi_path:
         print(f"  Loop MIDI:  {loop_midi_path}")
 
-    # Start audio
-    audio.start()
+    # Start recording the processed output before playback begins so the
+    # take captures the first block. Encoding happens on a writer thread
+    # inside the device; nothing is added to the Python side of the session.
+    record_path = getattr(args, "record", None)
+    if record_path:
+        try:
+            audio.record_start(record_path)
+        except RuntimeError as e:
+            print(f"Error starting recording: {e}", file=sys.stderr)
+            return 1
+        print(f"  Recording:  {record_path}")
+
+    # Start audio (warming the plugin up first so the opening buffers
+    # don't glitch on the plugin's one-time first-process costs)
+    audio.start(warmup_blocks=0 if getattr(args, "no_warmup", False) else 8)
     print("\nPlaying. Press Ctrl+C to stop.")
 
-    # Spawn loop-MIDI / loop-audio threads. They use a single stop_event
-    # so the main loop can break them out cleanly on Ctrl+C.
+    # Spawn the loop-MIDI thread. It uses a stop_event so the main loop
+    # can break it out cleanly on Ctrl+C. (Loop audio needs no thread:
+    # the preloaded source is read by the audio callback itself.)
     loop_stop = threading.Event()
     loop_threads: list[threading.Thread] = []
     if loop_midi_path:
@@ -1301,15 +1310,6 @@ def cmd_play(args: argparse.Namespace) -> int:
         )
         t.start()
         loop_threads.append(t)
-    if loop_audio_path:
-        t = threading.Thread(
-            target=_audio_loop_thread,
-            args=(audio, loop_audio_path, audio.sample_rate, loop_stop),
-            name="minihost-loop-audio",
-            daemon=True,
-        )
-        t.start()
-        loop_threads.append(t)
 
     no_midi_in = args.midi is None and not args.virtual_midi and not loop_midi_path
     no_midi_out = args.midi_out is None and not args.virtual_midi_out
@@ -1326,9 +1326,17 @@ def cmd_play(args: argparse.Namespace) -> int:
             hints.append("MIDI output (--midi-out N / --virtual-midi-out NAME)")
         print(f"(No {', '.join(hints)})")
 
+    stats_interval = getattr(args, "stats", None)
     try:
+        next_stats = time.monotonic() + (stats_interval or 0.0)
         while running:
             time.sleep(0.1)
+            if stats_interval and time.monotonic() >= next_stats:
+                print(
+                    f"load: {audio.load * 100.0:5.1f}%  "
+                    f"xruns: {audio.xrun_count}"
+                )
+                next_stats = time.monotonic() + stats_interval
     except KeyboardInterrupt:
         pass
 
@@ -1337,6 +1345,19 @@ def cmd_play(args: argparse.Namespace) -> int:
     loop_stop.set()
     for t in loop_threads:
         t.join(timeout=2.0)
+    if record_path and audio.is_recording:
+        try:
+            audio.record_stop()
+            dropped = audio.record_dropped_frames
+            if dropped:
+                print(
+                    f"Warning: recording dropped {dropped} frames "
+                    "(disk could not keep up)",
+                    file=sys.stderr,
+                )
+            print(f"Recorded to {record_path}")
+        except RuntimeError as e:
+            print(f"Error finalizing recording: {e}", file=sys.stderr)
     audio.stop()
     if midi_in_handle is not None:
         midi_in_handle.close()
@@ -1458,7 +1479,7 @@ def _process_single_file(
             input_path,
             output_path,
             tail_seconds=0.0,  # batch worker doesn't render tail
-            block_size=args.block_size,
+            block_size=("auto" if getattr(args, "block_size_auto", False) else args.block_size),
             bit_depth=bit_depth,
             resample_to_plugin_rate=allow_resample,
             duplicate_to_stereo=True,
@@ -1610,6 +1631,18 @@ def _cmd_process_batch(args, input_files):
     return 0
 
 
+def _parse_block_size(value):
+    """argparse type for --block-size: an integer or the literal 'auto'."""
+    if value.strip().lower() == "auto":
+        return "auto"
+    try:
+        return int(value)
+    except ValueError:
+        raise argparse.ArgumentTypeError(
+            f"expected an integer or 'auto', got {value!r}"
+        ) from None
+
+
 def _expand_globs(patterns):
     """Expand glob patterns in a list of file paths. Returns sorted unique paths."""
     import glob as globmod
@@ -1703,6 +1736,14 @@ def cmd_process(args: argparse.Namespace) -> int:
         )
         return 1
 
+    # --- Opt-in decoded-audio cache ---
+    # Pays off whenever one invocation reads a stem more than once
+    # (shared sidechains, repeated batch inputs); harmless otherwise.
+    if getattr(args, "audio_cache_mb", None):
+        import minihost
+
+        minihost.audio_cache_set_budget(args.audio_cache_mb * 1024 * 1024)
+
     # --- Detect batch mode ---
     has_globs = any(any(c in p for c in "*?[") for p in raw_inputs)
     batch_mode = (
@@ -1897,7 +1938,10 @@ def cmd_process(args: argparse.Namespace) -> int:
     latency = plugin.latency_samples
     print(f"Plugin: {chain_spec if using_chain else args.plugin}")
     print(f"  Sample rate: {sample_rate} Hz")
-    print(f"  Block size:  {args.block_size}")
+    block_desc = (
+        "auto" if getattr(args, "block_size_auto", False) else args.block_size
+    )
+    print(f"  Block size:  {block_desc}")
     print(f"  Latency:     {latency} samples")
     if has_audio_input:
         print(f"  Input:       {main_in_ch} ch, {total_samples_hint} samples")
@@ -1920,7 +1964,7 @@ def cmd_process(args: argparse.Namespace) -> int:
             input_path=input_files[0] if has_audio_input else None,
             output_path=args.output,
             tail_seconds=tail_seconds,
-            block_size=args.block_size,
+            block_size=("auto" if getattr(args, "block_size_auto", False) else args.block_size),
             bit_depth=bit_depth,
             resample_to_plugin_rate=not getattr(args, "no_resample", False),
             compensate_latency=True,
@@ -2061,9 +2105,10 @@ Examples:
     parser.add_argument(
         "-b",
         "--block-size",
-        type=int,
+        type=_parse_block_size,
         default=512,
-        help="Block size in samples (default: 512)",
+        help="Block size in samples, or 'auto' to probe the fastest "
+        "size for offline processing (default: 512)",
     )
 
     subparsers = parser.add_subparsers(dest="command", help="Commands")
@@ -2299,6 +2344,12 @@ Examples:
         metavar="NAME",
         help="Create virtual MIDI output with NAME",
     )
+    play_p.add_argument(
+        "--no-warmup",
+        action="store_true",
+        help="Skip the silence warm-up passes normally run before the device "
+        "starts (they absorb the plugin's slow first process call)",
+    )
     play_p.add_argument(
         "--playback-device",
         metavar="INDEX_OR_NAME",
@@ -2349,14 +2400,39 @@ Examples:
             "notes. Combinable with --midi (live + file MIDI are merged)."
         ),
     )
+    play_p.add_argument(
+        "--record",
+        type=str,
+        metavar="PATH",
+        help=(
+            "Record the processed output to an audio file (.wav or .flac) "
+            "while playing. Encoding runs on a background writer thread; "
+            "if the disk stalls, dropped frames are reported at exit."
+        ),
+    )
     play_p.add_argument(
         "--loop-audio",
         type=str,
         metavar="PATH",
         help=(
-            "Loop an audio file as the plugin's input. Auto-enables the "
-            "input ring buffer; the file is resampled to the device rate "
-            "if needed. For effect plugins. Mutually exclusive with --input."
+            "Loop an audio file as the plugin's input. The file is "
+            "preloaded (resampled to the device rate if needed) and read "
+            "directly by the audio callback. For effect plugins. "
+            "Mutually exclusive with --input."
+        ),
+    )
+    play_p.add_argument(
+        "--stats",
+        type=float,
+        nargs="?",
+        const=2.0,
+        default=None,
+        metavar="SECONDS",
+        help=(
+            "Periodically print audio callback load and xrun count "
+            "(default every 2 seconds). Load is the smoothed ratio of "
+            "callback duration to buffer period; xruns count callbacks "
+            "that overran their budget."
         ),
     )
     play_p.set_defaults(func=cmd_play)
@@ -2495,6 +2571,15 @@ Examples:
         "(0 dBFS = full scale; -1.0 = 1 dB headroom). With no "
         "argument, defaults to 0 dBFS.",
     )
+    process_p.add_argument(
+        "--audio-cache-mb",
+        type=int,
+        default=None,
+        metavar="MB",
+        help="Cache decoded input stems in memory up to MB megabytes, "
+        "so repeated reads of the same file (shared sidechains, "
+        "repeated batch inputs) decode once",
+    )
     process_p.set_defaults(func=cmd_process)
 
     # resample
@@ -2541,6 +2626,16 @@ Examples:
 
     args = parser.parse_args()
 
+    # 'auto' only means something to the offline process loop. Everywhere
+    # a plugin needs a concrete max_block_size at construction, use the
+    # largest autotune candidate so every probed size genuinely takes
+    # effect; cmd_process re-reads block_size_auto to enable the probe.
+    args.block_size_auto = args.block_size == "auto"
+    if args.block_size_auto:
+        from minihost.process import AUTOTUNE_BLOCK_SIZES
+
+        args.block_size = max(AUTOTUNE_BLOCK_SIZES)
+
     if not args.command:
         parser.print_help()
         return 1
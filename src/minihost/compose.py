@@ -41,6 +41,14 @@ Design notes
 * **Sample rate is validated, never silently resampled.** Native
   processors are constructed at a fixed rate; running a pipeline at a
   different rate raises rather than corrupt the signal.
+* **Adjacent pure stages fuse.** Runs of :class:`Gain` /
+  :class:`Normalize` / :class:`Trim` / :class:`Fade` in the top-level
+  transform order execute as a single native pass over the pipeline's
+  private working buffer (:class:`~minihost.BufferOp` batches, with
+  :class:`Trim` narrowing via a zero-copy frame view) instead of one
+  copying pass per stage. Plugin stages stream block-by-block through
+  :func:`minihost.process_audio` as before. Used standalone (outside a
+  Compose), the transforms keep their copying call semantics.
 * **Tails are handled once, at the pipeline boundary.** A numeric
   ``tail_seconds`` pads the input with that much silence up front so
   every element rings out into it; ``"auto"`` over-renders and trims
@@ -57,9 +65,17 @@ import random
 from pathlib import Path
 from typing import Any, Callable, Sequence, Union
 
-from minihost._core import AudioBuffer, Plugin, PluginBus, PluginChain
+from minihost._core import (
+    AudioBuffer,
+    AudioFileReader,
+    AudioFileWriter,
+    BufferOp,
+    Plugin,
+    PluginBus,
+    PluginChain,
+)
 from minihost.audio_io import read_audio, resample, write_audio
-from minihost.process import process_audio
+from minihost.process import _resolve_block_size, process_audio
 
 # Native processors that Compose runs via process_audio.
 _PROCESSORS = (Plugin, PluginChain, PluginBus)
@@ -325,8 +341,29 @@ class Compose:
             order = list(self.transforms)
             rng.shuffle(order)
 
-        for t in order:
-            work = _coerce(_apply(t, work, sr, rng, self.block_size))
+        # Runs of adjacent fusible pure transforms execute as one native
+        # pass over the working buffer (see _apply_fused); everything else
+        # goes through the one-transform-at-a-time path.
+        private = True  # work is pipeline-owned and safe to mutate in place
+        i = 0
+        while i < len(order):
+            t = order[i]
+            if isinstance(t, _FUSABLE):
+                j = i + 1
+                while j < len(order) and isinstance(order[j], _FUSABLE):
+                    j += 1
+                if not private:
+                    work = work.copy()
+                work = _apply_fused(order[i:j], work, sr)
+                private = True
+                i = j
+            else:
+                work = _coerce(_apply(t, work, sr, rng, self.block_size))
+                # Nested Composes and native processors return fresh
+                # buffers; a user callable or combinator may hand back
+                # anything, so its result is not assumed safe to mutate.
+                private = isinstance(t, (Compose,) + _PROCESSORS)
+                i += 1
 
         if do_trim:
             work = self._trim_tail(work, buf.frames)
@@ -395,10 +432,29 @@ class Compose:
 
         Returns:
             Number of frames written.
+
+        Notes:
+            When every stage can stream (native processors, :class:`Gain`,
+            :class:`Fade`; numeric ``tail_seconds``; input already at the
+            pipeline rate) the file is decoded, processed, and encoded
+            block-by-block with O(block) memory -- the full audio is never
+            resident. Pipelines with whole-signal stages
+            (:class:`Normalize`, ``tail_seconds="auto"``, ...) fall back
+            to the materializing path.
         """
         from minihost.process import _maybe_duplicate_to_match
 
         sr = self._resolve_sr(sample_rate)
+        streamed = self._to_file_streaming(
+            input_path,
+            output_path,
+            sr,
+            bit_depth=bit_depth,
+            duplicate_to_stereo=duplicate_to_stereo,
+        )
+        if streamed is not None:
+            return streamed
+
         audio, in_sr = read_audio(input_path)
         if in_sr != sr:
             if not resample_to_pipeline_rate:
@@ -422,6 +478,121 @@ class Compose:
         write_audio(output_path, out, int(sr), bit_depth=bit_depth)
         return out.frames
 
+    def _to_file_streaming(
+        self,
+        input_path: str | Path,
+        output_path: str | Path,
+        sr: float,
+        *,
+        bit_depth: int,
+        duplicate_to_stereo: bool,
+    ) -> int | None:
+        """Block-streamed file-to-file execution with O(block) memory.
+
+        Decodes the source with :class:`AudioFileReader`, runs every
+        stage block-wise (see the ``*Stream`` adapters), and hands each
+        finished block to :class:`AudioFileWriter`, whose background
+        thread encodes block N-1 while block N processes. Returns the
+        number of frames written, or None when the pipeline cannot
+        stream -- the caller then falls back to the materializing path
+        (which also owns raising for invalid configurations, so this
+        method only ever declines silently).
+        """
+        if self._closed:
+            return None  # fallback raises the canonical error
+        try:
+            pad_frames, do_trim = self._tail_frames(sr)
+        except ValueError:
+            return None
+        if do_trim:
+            return None  # "auto" trimming needs the whole output
+        for t in self.transforms:
+            if not isinstance(t, _PROCESSORS + (Gain, Fade)):
+                return None
+
+        self._check_rates(sr)
+
+        order = self.transforms
+        if self.shuffle:
+            order = list(self.transforms)
+            self._rng.shuffle(order)
+
+        with AudioFileReader(str(input_path)) as reader:
+            # Needs the input already at the pipeline rate (no streaming
+            # resampler here) and a known length (fade-out placement and
+            # output trimming are laid out against it).
+            if reader.sample_rate != int(sr) or reader.frames == 0:
+                return None
+
+            in_ch = reader.channels
+            entry_required = next(
+                (
+                    int(p.num_input_channels)
+                    for p in order
+                    if isinstance(p, _PROCESSORS)
+                ),
+                None,
+            )
+            dup_to = 0
+            entry_ch = in_ch
+            if entry_required is not None and in_ch < entry_required:
+                if not duplicate_to_stereo:
+                    return None  # fallback raises the channel mismatch
+                dup_to = entry_required
+                entry_ch = entry_required
+
+            # Build the stage chain, checking the channel chain up front.
+            total_frames = int(reader.frames) + pad_frames
+            stages: list[Any] = []
+            total_latency = 0
+            cur = entry_ch
+            for t in order:
+                if isinstance(t, _PROCESSORS):
+                    if int(t.num_input_channels) == 0:
+                        return None  # synth stages need the padded-input path
+                    if cur != int(t.num_input_channels):
+                        return None
+                    stage = _ProcStream(t)
+                    total_latency += stage.latency
+                    cur = stage.out_ch
+                    stages.append(stage)
+                elif isinstance(t, Gain):
+                    stages.append(_GainStream(t))
+                else:
+                    stages.append(_FadeStream(t, sr, total_frames))
+
+            block = _resolve_block_size(self.block_size)
+            in_buf = AudioBuffer(entry_ch, block)
+            feed_total = total_frames + total_latency
+            pos = 0
+            emitted = 0
+            with AudioFileWriter(
+                str(output_path), cur, int(sr), bit_depth=bit_depth
+            ) as writer:
+                while pos < feed_total and emitted < total_frames:
+                    n = min(block, feed_total - pos)
+                    buf = in_buf if n == block else AudioBuffer(entry_ch, n)
+                    buf.clear()
+                    reader.read_into(buf)  # 0 frames past EOF: stays silent
+                    if dup_to:
+                        last = buf[in_ch - 1 : in_ch, :]
+                        for ch in range(in_ch, dup_to):
+                            buf[ch : ch + 1, :] = last
+                    out: AudioBuffer | None = buf
+                    for stage in stages:
+                        out = stage.feed(out)
+                        if out is None or out.frames == 0:
+                            out = None
+                            break
+                    pos += n
+                    if out is None:
+                        continue
+                    if emitted + out.frames > total_frames:
+                        out = out[:, : total_frames - emitted]
+                    writer.write(out)
+                    emitted += out.frames
+            return emitted
+
     # -- lifetime ------------------------------------------------------
 
     def close(self) -> None:
@@ -527,21 +698,185 @@ class Fade:
         self.fade_out = float(fade_out)
 
     def __call__(self, audio: AudioBuffer, sample_rate: float) -> AudioBuffer:
-        np = _np()
-        data = audio.as_ndarray().copy()
-        n = data.shape[1]
+        n = audio.frames
         fi = min(int(self.fade_in * sample_rate), n)
         fo = min(int(self.fade_out * sample_rate), n)
+        out = audio.copy()
+        # Native in-place ramps -- no numpy round trip, which matters on
+        # album-length masters.
         if fi > 0:
-            data[:, :fi] *= np.linspace(0.0, 1.0, fi, dtype=np.float32)
+            out.fade_in(fi)
         if fo > 0:
-            data[:, n - fo :] *= np.linspace(1.0, 0.0, fo, dtype=np.float32)
-        return AudioBuffer.from_numpy(data)
+            out.fade_out(fo)
+        return out
 
     def __repr__(self) -> str:
         return f"Fade(fade_in={self.fade_in}, fade_out={self.fade_out})"
 
 
+# Pure transforms Compose fuses into single native passes when adjacent.
+_FUSABLE = (Gain, Normalize, Trim, Fade)
+
+
+def _apply_fused(
+    group: Sequence[Transform],
+    work: AudioBuffer,
+    sr: float,
+) -> AudioBuffer:
+    """Run a group of adjacent fusible transforms in place over ``work``.
+
+    ``work`` must be a pipeline-private buffer. Gains and fades accumulate
+    into one :class:`BufferOp` batch executed as a single native traversal;
+    :class:`Normalize` flushes the pending batch with a fused peak
+    measurement, then folds its correction gain into the next batch;
+    :class:`Trim` narrows via a zero-copy frame view. The result is
+    compacted to a contiguous copy only when a Trim produced a strided
+    view (downstream consumers require contiguous buffers).
+    """
+    ops: list[BufferOp] = []
+    is_view = False
+    for t in group:
+        if isinstance(t, Trim):
+            if ops:
+                work.apply(ops)
+                ops = []
+            n = work.frames
+            s = max(0, min(int(round(t.start * sr)), n))
+            if t.duration is None:
+                e = n
+            else:
+                e = max(s, min(s + int(round(t.duration * sr)), n))
+            if s == 0 and e == n:
+                pass
+            elif e > s:
+                work = work.frame_view(s, e - s)
+                is_view = True
+            else:  # empty window
+                work = work[:, s:e]
+                is_view = False
+        elif isinstance(t, Gain):
+            ops.append(BufferOp.gain(10.0 ** (t.db / 20.0)))
+        elif isinstance(t, Fade):
+            n = work.frames
+            fi = min(int(t.fade_in * sr), n)
+            fo = min(int(t.fade_out * sr), n)
+            # Native ramps step by j/count and never land on the end gain;
+            # stretch the end gain so the fused fades hit Fade's inclusive
+            # np.linspace endpoints exactly (first sample 0, last sample 1
+            # for a fade-in, and the mirror image for a fade-out).
+            if fi > 0:
+                g1 = fi / (fi - 1.0) if fi > 1 else 1.0
+                ops.append(BufferOp.gain_ramp(0, fi, 0.0, g1))
+            if fo > 0:
+                g1 = 1.0 - fo / (fo - 1.0) if fo > 1 else 0.0
+                ops.append(BufferOp.gain_ramp(n - fo, fo, 1.0, g1))
+        else:  # Normalize
+            measured = work.apply(ops + [BufferOp.measure(peak=True)])
+            ops = []
+            peak = measured["peak"]
+            if peak > 0.0:
+                ops.append(BufferOp.gain(10.0 ** (t.peak_dbfs / 20.0) / peak))
+    if ops:
+        work.apply(ops)
+    return work.copy() if is_view else work
+
+
+# =====================================================================
+# Streaming to_file execution (block-wise stage adapters)
+# =====================================================================
+#
+# Each adapter turns one pipeline stage into a block transformer for
+# Compose._to_file_streaming: feed(buf) consumes one block and returns
+# the stage's output block (None while a latency-compensating stage is
+# still swallowing its skip region). Stages may mutate ``buf`` in place;
+# the driver owns every block it feeds.
+
+
+class _GainStream:
+    """Per-block gain stage."""
+
+    def __init__(self, t: Gain) -> None:
+        self._ops = [BufferOp.gain(10.0 ** (t.db / 20.0))]
+
+    def feed(self, buf: AudioBuffer) -> AudioBuffer:
+        buf.apply(self._ops)
+        return buf
+
+
+class _FadeStream:
+    """Per-block fade stage.
+
+    The fade windows are laid out against ``total_frames`` (the final
+    output length, known up front from the source file); each block gets
+    the slice of the fade ramp covering its position, with ramp end
+    gains extrapolated so the per-block native ramps land exactly on
+    Fade's inclusive np.linspace endpoints.
+    """
+
+    def __init__(self, t: Fade, sr: float, total_frames: int) -> None:
+        self._fi = min(int(t.fade_in * sr), total_frames)
+        self._fo = min(int(t.fade_out * sr), total_frames)
+        self._total = total_frames
+        self._pos = 0
+
+    def feed(self, buf: AudioBuffer) -> AudioBuffer:
+        n = buf.frames
+        p = self._pos
+        self._pos += n
+        ops: list[BufferOp] = []
+        fi, fo, total = self._fi, self._fo, self._total
+        if fi > 0 and p < fi:
+            count = min(n, fi - p)
+            if fi > 1:
+                denom = fi - 1.0
+                g0 = p / denom
+                ops.append(BufferOp.gain_ramp(0, count, g0, g0 + count / denom))
+            else:
+                ops.append(BufferOp.gain_ramp(0, count, 0.0, 0.0))
+        if fo > 0:
+            lo = max(p, total - fo)
+            hi = min(p + n, total)
+            if hi > lo:
+                count = hi - lo
+                if fo > 1:
+                    denom = fo - 1.0
+                    g0 = 1.0 - (lo - (total - fo)) / denom
+                    ops.append(
+                        BufferOp.gain_ramp(lo - p, count, g0, g0 - count / denom)
+                    )
+                else:
+                    ops.append(BufferOp.gain_ramp(lo - p, count, 1.0, 1.0))
+        if ops:
+            buf.apply(ops)
+        return buf
+
+
+class _ProcStream:
+    """Block-streamed native processor stage with latency compensation.
+
+    Drops the first ``latency_samples`` frames of output (the driver
+    feeds matching extra input at the end), mirroring what
+    process_audio's compensate_latency does for the whole-buffer path.
+    """
+
+    def __init__(self, proc: Any) -> None:
+        self.proc = proc
+        self.out_ch = int(proc.num_output_channels)
+        self.latency = max(0, int(proc.latency_samples))
+        self._skip = self.latency
+
+    def feed(self, buf: AudioBuffer) -> AudioBuffer | None:
+        out = AudioBuffer(self.out_ch, buf.frames)
+        self.proc.process(buf, out)
+        if self._skip:
+            if self._skip >= out.frames:
+                self._skip -= out.frames
+                return None
+            out = out[:, self._skip :]
+            self._skip = 0
+        return out
+
+
 # =====================================================================
 # Phase 3 -- stochastic combinators
 # =====================================================================
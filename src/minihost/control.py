@@ -28,6 +28,23 @@ from minihost._core import Plugin
 _VALID_CURVES = ("linear", "exp", "log")
 
 
+def _compile_lut(value_range: tuple[float, float], curve: str) -> list[float]:
+    """Precompute the 128-entry CC-value -> parameter-value table for one
+    mapping (the native audio path indexes this instead of evaluating the
+    curve per event). Matches :meth:`_CCMapping.normalize` exactly."""
+    lo, hi = value_range
+    lut = []
+    for v in range(128):
+        n = v / 127.0
+        if curve == "exp":
+            n = n * n
+        elif curve == "log":
+            inv = 1.0 - n
+            n = 1.0 - inv * inv
+        lut.append(lo + n * (hi - lo))
+    return lut
+
+
 class _CCMapping:
     __slots__ = ("param_name", "param_idx", "value_range", "curve")
 
@@ -75,6 +92,13 @@ class MidiMapper:
     a single internal lock guards all mapping state. The lock hold is
     a few hash-table ops -- negligible relative to MIDI inter-event time.
 
+    For the lowest knob-to-sound latency, :meth:`attach_device` pushes
+    the CC table into an :class:`AudioDevice`'s native MIDI path so the
+    audio thread applies parameter writes directly at block boundaries,
+    skipping Python (and the GIL) entirely. The Python dispatch path
+    below remains useful for :class:`MidiIn` ports, note mappings, and
+    the ``on_unmapped`` fallback.
+
     Example:
         >>> plugin = minihost.Plugin("/path/to/synth.vst3", sample_rate=48000)
         >>> mapper = minihost.MidiMapper(plugin)
@@ -113,6 +137,10 @@ class MidiMapper:
         self._note: dict[tuple[int, int], _NoteMapping] = {}
         self._on_unmapped = on_unmapped
         self._lock = threading.RLock()
+        # Native mode (attach_device): the AudioDevice consuming the
+        # compiled CC table, or None when dispatching from Python only.
+        self._native_device = None
+        self._native_plugin_index = 0
 
     # ---- mapping configuration ----
 
@@ -162,6 +190,7 @@ class MidiMapper:
                 value_range=value_range,
                 curve=curve,
             )
+            self._push_native_locked()
 
     def map_note(
         self,
@@ -196,7 +225,8 @@ class MidiMapper:
     def unmap_cc(self, channel: int, cc: int) -> None:
         """Remove a CC mapping. No-op if not currently mapped."""
         with self._lock:
-            self._cc.pop((channel, cc), None)
+            if self._cc.pop((channel, cc), None) is not None:
+                self._push_native_locked()
 
     def unmap_note(self, channel: int, note: int) -> None:
         """Remove a note mapping. No-op if not currently mapped."""
@@ -208,6 +238,7 @@ class MidiMapper:
         with self._lock:
             self._cc.clear()
             self._note.clear()
+            self._push_native_locked()
 
     def set_on_unmapped(self, callback: Optional[Callable[[bytes], None]]) -> None:
         """Replace the unmapped-event fallback callback.
@@ -220,6 +251,60 @@ class MidiMapper:
         """
         self._on_unmapped = callback
 
+    # ---- native mode ----
+
+    def attach_device(self, device, plugin_index: int = 0) -> None:
+        """Compile the CC table into ``device``'s native MIDI path.
+
+        While attached, CC events arriving at the device's own MIDI
+        input (``AudioDevice.connect_midi_input`` or a virtual port)
+        are translated to parameter writes on the audio thread at block
+        boundaries -- no GIL, no Python dispatch, and each mapping's
+        curve is evaluated through a precomputed 128-entry lookup
+        table. Mapped CCs are consumed before reaching the plugin as
+        MIDI; note mappings and ``on_unmapped`` are unaffected (they
+        only apply to the Python :meth:`__call__` path).
+
+        The native table tracks subsequent ``map_cc`` / ``unmap_cc`` /
+        ``clear`` calls automatically. Values outside the normalized
+        0..1 range are clamped, matching :meth:`Plugin.set_param`.
+
+        Args:
+            device: The :class:`AudioDevice` hosting the plugin (or
+                chain) whose MIDI input should consume the table.
+            plugin_index: For chain devices, the index of the target
+                plugin within the chain. Ignored (use 0) for
+                single-plugin devices.
+        """
+        with self._lock:
+            self._native_device = device
+            self._native_plugin_index = plugin_index
+            self._push_native_locked()
+
+    def detach_device(self) -> None:
+        """Remove the native CC table from the attached device.
+
+        CC events reach the plugin as ordinary MIDI again. No-op if
+        not attached.
+        """
+        with self._lock:
+            device = self._native_device
+            self._native_device = None
+            if device is not None:
+                device.clear_cc_map()
+
+    def _push_native_locked(self) -> None:
+        """Recompile and install the CC table on the attached device.
+        Caller must hold ``self._lock``. No-op when not attached."""
+        if self._native_device is None:
+            return
+        mappings = [
+            (channel, cc, self._native_plugin_index, m.param_idx,
+             _compile_lut(m.value_range, m.curve))
+            for (channel, cc), m in self._cc.items()
+        ]
+        self._native_device.set_cc_map(mappings)
+
     # ---- introspection ----
 
     @property
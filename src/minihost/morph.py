@@ -16,6 +16,12 @@ the host plugin quantizes them, so the audible result may jump rather than
 glide. Pass ``indices`` to :func:`lerp` (via ``t`` as a per-parameter
 sequence) or simply exclude such parameters from the snapshots you morph if
 that matters for your use.
+
+For sweeping a morph *during a render*, prefer
+:class:`minihost.MorphAutomation` with ``process_audio(..., morph=...)``:
+the per-block interpolation and parameter writes then run natively, which
+matters for large patches (thousands of parameters). This module stays
+pure-Python for one-shot blends and mock-plugin tests.
 """
 
 from __future__ import annotations
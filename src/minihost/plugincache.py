@@ -1,7 +1,7 @@
 """Persistent plugin-scan cache.
 
 Probing an audio plugin is slow: the OS plugin host loads each one to read
-its metadata. This module keeps a JSON index of probe results keyed by
+its metadata. This module keeps a binary index of probe results keyed by
 plugin path, with a filesystem fingerprint (mtime + size) so stale entries
 are re-probed automatically. A repeat scan of an unchanged directory
 returns instantly and never touches the plugins.
@@ -12,10 +12,18 @@ validation status (``ok`` / ``error``). A plugin that fails to probe is
 remembered as an error so it is not re-probed on every scan. Parameter
 lists require a full plugin load and are deliberately not cached.
 
+Storage is a single append-friendly binary file: a short header followed
+by length-prefixed records of ``(path, mtime_ns, size, json payload)``.
+Updates append a superseding record rather than rewriting the file, point
+lookups walk the fixed-size record headers (seeking over payloads) and
+decode only the record they need, and freshness checks stat plugin files
+concurrently -- so cache overhead stays flat as the index grows into the
+thousands of plugins. ``prune()`` compacts superseded records away.
+
 Cache location (override with ``MINIHOST_CACHE_DIR``):
-  - macOS:   ~/Library/Caches/minihost/plugins.json
-  - Windows: %LOCALAPPDATA%/minihost/Cache/plugins.json
-  - other:   $XDG_CACHE_HOME/minihost/plugins.json (or ~/.cache/...)
+  - macOS:   ~/Library/Caches/minihost/plugins.bin
+  - Windows: %LOCALAPPDATA%/minihost/Cache/plugins.bin
+  - other:   $XDG_CACHE_HOME/minihost/plugins.bin (or ~/.cache/...)
 
 Plugin discovery is by known extension (.vst3, .component, .lv2, ...), so a
 cached scan finds the same file/bundle plugins as the uncached
@@ -27,13 +35,15 @@ from __future__ import annotations
 
 import json
 import os
+import struct
 import sys
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
-from typing import Any, Callable
+from typing import Callable, NamedTuple
 
 import minihost
 
-SCHEMA_VERSION = 1
+SCHEMA_VERSION = 2
 
 # Path suffixes that denote a plugin bundle or binary. Discovery treats any
 # matching entry as a leaf (it is not descended into).
@@ -57,8 +67,8 @@ def _default_cache_dir() -> Path:
 
 
 def cache_file() -> Path:
-    """Absolute path to the JSON cache file (honors MINIHOST_CACHE_DIR)."""
-    return _default_cache_dir() / "plugins.json"
+    """Absolute path to the binary cache file (honors MINIHOST_CACHE_DIR)."""
+    return _default_cache_dir() / "plugins.bin"
 
 
 # -- probe + fingerprint (indirected for testing) --------------------- #
@@ -69,43 +79,210 @@ def _probe(path: str) -> dict:
     return minihost.probe(path)
 
 
-def _fingerprint(path: str) -> dict:
-    """Cheap freshness key for a plugin path. Uses the path's own stat
-    (mtime + size); for bundles this is the bundle directory's metadata,
+def _fingerprint(path: str) -> tuple[int, int]:
+    """Cheap freshness key for a plugin path: (mtime_ns, size) from the
+    path's own stat. For bundles this is the bundle directory's metadata,
     which changes when the plugin is (re)installed. Cheap by design -- it
     must never approach the cost of a probe."""
     st = os.stat(path)
-    return {"mtime_ns": st.st_mtime_ns, "size": st.st_size}
-
+    return (st.st_mtime_ns, st.st_size)
 
-# -- raw cache I/O ---------------------------------------------------- #
 
+# Fingerprint stored for a plugin that could not be statted at probe time:
+# never matches a real stat, so the entry is always considered stale.
+_NO_FP = (-1, -1)
 
-def _empty() -> dict:
-    return {"schema": SCHEMA_VERSION, "entries": {}}
 
+def _fingerprint_many(paths: list[str]) -> dict[str, tuple[int, int] | None]:
+    """Stat many paths concurrently (os.stat releases the GIL, and on a
+    cold filesystem cache each stat is an independent I/O). Returns
+    path -> fingerprint, with None for paths that cannot be statted."""
 
-def _load_raw() -> dict:
+    def one(path: str) -> tuple[int, int] | None:
+        try:
+            return _fingerprint(path)
+        except OSError:
+            return None
+
+    if len(paths) <= 4:
+        return {p: one(p) for p in paths}
+    with ThreadPoolExecutor(max_workers=min(32, len(paths))) as pool:
+        return dict(zip(paths, pool.map(one, paths)))
+
+
+# -- binary store ------------------------------------------------------ #
+#
+# Layout: header, then records back to back. A record is
+#   <I key_len> <q mtime_ns> <q size> <I payload_len>
+#   key bytes (utf-8 plugin path)
+#   payload bytes (JSON entry: {"status", "desc", "error"?})
+# Records for the same key supersede earlier ones (last wins), which is
+# what makes writes pure appends. A truncated tail (e.g. a crash mid
+# append) is detected and cut off on the next write; a corrupt header
+# degrades to an empty cache.
+
+_MAGIC = b"MHPC"
+_FILE_HDR = struct.Struct("<4sI")
+_REC_HDR = struct.Struct("<IqqI")
+
+# A path may not plausibly exceed this; anything larger means a corrupt
+# record header and stops the walk.
+_MAX_KEY_LEN = 16384
+
+
+class _Rec(NamedTuple):
+    payload_off: int
+    payload_len: int
+    mtime_ns: int
+    size: int
+
+
+# One in-memory index per process, invalidated whenever the backing file
+# changes (keyed by its own mtime + size).
+_index_cache: tuple[tuple, dict[str, _Rec], int] | None = None
+
+
+def _invalidate_index() -> None:
+    global _index_cache
+    _index_cache = None
+
+
+def _walk_records(f, file_size: int):
+    """Yield (path, _Rec) for each well-formed record, then return the
+    offset just past the last good record via StopIteration.value."""
+    end = _FILE_HDR.size
+    f.seek(end)
+    while True:
+        hdr = f.read(_REC_HDR.size)
+        if len(hdr) < _REC_HDR.size:
+            return end
+        key_len, mtime_ns, size, payload_len = _REC_HDR.unpack(hdr)
+        if key_len == 0 or key_len > _MAX_KEY_LEN:
+            return end
+        key = f.read(key_len)
+        if len(key) < key_len:
+            return end
+        payload_off = f.tell()
+        if payload_off + payload_len > file_size:
+            return end
+        try:
+            path = key.decode("utf-8")
+        except UnicodeDecodeError:
+            return end
+        yield path, _Rec(payload_off, payload_len, mtime_ns, size)
+        end = payload_off + payload_len
+        f.seek(end)
+
+
+def _load_index() -> tuple[dict[str, _Rec], int]:
+    """Build (or reuse) the path -> record index by walking record headers
+    only -- payloads are skipped, not parsed. Returns (index, valid_size)
+    where valid_size is 0 for a missing/unreadable/foreign file (meaning
+    the next write must start the file over)."""
+    global _index_cache
     f = cache_file()
-    if not f.exists():
-        return _empty()
     try:
-        doc = json.loads(f.read_text())
-    except (json.JSONDecodeError, OSError):
-        return _empty()
-    if not isinstance(doc, dict) or doc.get("schema") != SCHEMA_VERSION:
-        return _empty()
-    if not isinstance(doc.get("entries"), dict):
-        doc["entries"] = {}
-    return doc
+        st = os.stat(f)
+    except OSError:
+        _index_cache = None
+        return {}, 0
+    key = (str(f), st.st_mtime_ns, st.st_size)
+    if _index_cache is not None and _index_cache[0] == key:
+        return _index_cache[1], _index_cache[2]
+
+    index: dict[str, _Rec] = {}
+    valid_size = 0
+    try:
+        with open(f, "rb") as fh:
+            hdr = fh.read(_FILE_HDR.size)
+            if len(hdr) == _FILE_HDR.size:
+                magic, version = _FILE_HDR.unpack(hdr)
+                if magic == _MAGIC and version == SCHEMA_VERSION:
+                    walker = _walk_records(fh, st.st_size)
+                    while True:
+                        try:
+                            path, rec = next(walker)
+                        except StopIteration as stop:
+                            valid_size = stop.value
+                            break
+                        index[path] = rec  # last record for a path wins
+    except OSError:
+        return {}, 0
+
+    _index_cache = (key, index, valid_size)
+    return index, valid_size
+
+
+def _read_payload(fh, rec: _Rec) -> dict:
+    fh.seek(rec.payload_off)
+    return json.loads(fh.read(rec.payload_len))
+
+
+def _read_entry(rec: _Rec) -> dict | None:
+    """Point lookup: decode a single record's payload."""
+    try:
+        with open(cache_file(), "rb") as fh:
+            return _read_payload(fh, rec)
+    except (OSError, json.JSONDecodeError, UnicodeDecodeError):
+        return None
+
+
+def _pack_record(path: str, fp: tuple[int, int], entry: dict) -> bytes:
+    key = path.encode("utf-8")
+    payload = json.dumps(entry, separators=(",", ":")).encode("utf-8")
+    return _REC_HDR.pack(len(key), fp[0], fp[1], len(payload)) + key + payload
 
 
-def _save_raw(doc: dict) -> None:
+def _append_records(records: list[tuple[str, tuple[int, int], dict]]) -> None:
+    """Append superseding records, truncating any malformed tail first.
+    Starts the file over (header + records) if it is missing or corrupt."""
+    f = cache_file()
+    f.parent.mkdir(parents=True, exist_ok=True)
+    _, valid_size = _load_index()
+    blob = b"".join(_pack_record(path, fp, entry) for path, fp, entry in records)
+    if valid_size == 0:
+        tmp = f.with_suffix(f.suffix + ".tmp")
+        with open(tmp, "wb") as fh:
+            fh.write(_FILE_HDR.pack(_MAGIC, SCHEMA_VERSION))
+            fh.write(blob)
+        tmp.replace(f)
+    else:
+        with open(f, "r+b") as fh:
+            fh.truncate(valid_size)
+            fh.seek(valid_size)
+            fh.write(blob)
+    _invalidate_index()
+
+
+def _rewrite(items: list[tuple[str, tuple[int, int], dict]]) -> None:
+    """Compact: write a fresh file holding exactly `items` (atomically)."""
     f = cache_file()
     f.parent.mkdir(parents=True, exist_ok=True)
     tmp = f.with_suffix(f.suffix + ".tmp")
-    tmp.write_text(json.dumps(doc, indent=2) + "\n")
+    with open(tmp, "wb") as fh:
+        fh.write(_FILE_HDR.pack(_MAGIC, SCHEMA_VERSION))
+        for path, fp, entry in items:
+            fh.write(_pack_record(path, fp, entry))
     tmp.replace(f)
+    _invalidate_index()
+
+
+def _load_all() -> list[tuple[str, tuple[int, int], dict]]:
+    """Decode every live entry (for whole-index operations: query, stats,
+    prune). Point lookups and scans never need this."""
+    index, _ = _load_index()
+    out: list[tuple[str, tuple[int, int], dict]] = []
+    try:
+        with open(cache_file(), "rb") as fh:
+            for path, rec in sorted(index.items(), key=lambda kv: kv[1].payload_off):
+                try:
+                    entry = _read_payload(fh, rec)
+                except (json.JSONDecodeError, UnicodeDecodeError):
+                    continue
+                out.append((path, (rec.mtime_ns, rec.size), entry))
+    except OSError:
+        return []
+    return out
 
 
 # -- discovery -------------------------------------------------------- #
@@ -141,27 +318,15 @@ def _discover_plugins(directory: str) -> list[str]:
 # -- entry helpers ---------------------------------------------------- #
 
 
-def _entry_fresh(entry: dict, path: str) -> bool:
-    try:
-        return entry.get("fp") == _fingerprint(path)
-    except OSError:
-        return False
-
-
 def _probe_to_entry(path: str) -> dict:
-    try:
-        fp: Any = _fingerprint(path)
-    except OSError:
-        fp = None
     try:
         desc = _probe(path)
-        return {"status": "ok", "desc": desc, "fp": fp}
+        return {"status": "ok", "desc": desc}
     except Exception as e:  # probe raises RuntimeError on failure
         return {
             "status": "error",
             "error": str(e),
             "desc": {"path": path},
-            "fp": fp,
         }
 
 
@@ -178,53 +343,80 @@ def scan(
     """Scan `directory` for plugins, using and updating the cache.
 
     Only new or changed plugins (by fingerprint) are probed; everything
-    else is served from cache. Returns the list of probe-metadata dicts for
-    successfully-probed plugins (plus error stubs if `include_errors`).
-    `refresh=True` re-probes every discovered plugin. `on_progress(done,
-    total, path)` is called per plugin if provided.
+    else is served from cache. Freshness stats run concurrently, and
+    probe results are appended to the store rather than rewriting it.
+    Returns the list of probe-metadata dicts for successfully-probed
+    plugins (plus error stubs if `include_errors`). `refresh=True`
+    re-probes every discovered plugin. `on_progress(done, total, path)`
+    is called per plugin if provided.
     """
-    doc = _load_raw()
-    entries = doc["entries"]
+    index, _ = _load_index()
     paths = _discover_plugins(str(directory))
+    fps = _fingerprint_many(paths)
     results: list[dict] = []
-    changed = False
-
-    for i, path in enumerate(paths):
-        entry = entries.get(path)
-        if refresh or entry is None or not _entry_fresh(entry, path):
-            entry = _probe_to_entry(path)
-            entries[path] = entry
-            changed = True
-        if on_progress is not None:
-            on_progress(i + 1, len(paths), path)
-        if entry["status"] == "ok":
-            results.append(entry["desc"])
-        elif include_errors:
-            results.append(
-                {
-                    "path": path,
-                    "status": "error",
-                    "error": entry.get("error"),
-                }
-            )
-
-    if changed:
-        _save_raw(doc)
+    new_records: list[tuple[str, tuple[int, int], dict]] = []
+
+    cache_fh = None
+    try:
+        for i, path in enumerate(paths):
+            rec = index.get(path)
+            fp = fps.get(path)
+            entry = None
+            if not refresh and rec is not None and fp == (rec.mtime_ns, rec.size):
+                if cache_fh is None:
+                    try:
+                        cache_fh = open(cache_file(), "rb")
+                    except OSError:
+                        cache_fh = None
+                if cache_fh is not None:
+                    try:
+                        entry = _read_payload(cache_fh, rec)
+                    except (json.JSONDecodeError, UnicodeDecodeError):
+                        entry = None
+            if entry is None:
+                entry = _probe_to_entry(path)
+                new_records.append((path, fp if fp is not None else _NO_FP, entry))
+            if on_progress is not None:
+                on_progress(i + 1, len(paths), path)
+            if entry["status"] == "ok":
+                results.append(entry["desc"])
+            elif include_errors:
+                results.append(
+                    {
+                        "path": path,
+                        "status": "error",
+                        "error": entry.get("error"),
+                    }
+                )
+    finally:
+        if cache_fh is not None:
+            cache_fh.close()
+
+    if new_records:
+        _append_records(new_records)
     return results
 
 
 def info(path: str | Path, *, refresh: bool = False) -> dict:
     """Return cached probe metadata for one plugin, probing (and caching)
-    on a cache miss or stale fingerprint. Raises RuntimeError if the plugin
-    cannot be probed (the failure is also cached)."""
+    on a cache miss or stale fingerprint. A hit is a point lookup: only
+    this plugin's record is decoded, never the whole store. Raises
+    RuntimeError if the plugin cannot be probed (the failure is also
+    cached)."""
     abspath = os.path.abspath(str(path))
-    doc = _load_raw()
-    entries = doc["entries"]
-    entry = entries.get(abspath)
-    if refresh or entry is None or not _entry_fresh(entry, abspath):
+    index, _ = _load_index()
+    rec = index.get(abspath)
+    try:
+        fp: tuple[int, int] | None = _fingerprint(abspath)
+    except OSError:
+        fp = None
+
+    entry = None
+    if not refresh and rec is not None and fp == (rec.mtime_ns, rec.size):
+        entry = _read_entry(rec)
+    if entry is None:
         entry = _probe_to_entry(abspath)
-        entries[abspath] = entry
-        _save_raw(doc)
+        _append_records([(abspath, fp if fp is not None else _NO_FP, entry)])
     if entry["status"] != "ok":
         raise RuntimeError(entry.get("error", "probe failed"))
     return entry["desc"]
@@ -245,7 +437,7 @@ def query(
     Returns matching probe-metadata dicts sorted by name then path. Only
     successfully-probed (status ok) plugins are considered."""
     out: list[dict] = []
-    for entry in _load_raw()["entries"].values():
+    for _path, _fp, entry in _load_all():
         if entry.get("status") != "ok":
             continue
         d = entry.get("desc", {})
@@ -277,7 +469,7 @@ def query(
 def all_entries(*, include_errors: bool = True) -> list[dict]:
     """Return every cached entry as ``{path, status, desc, error?}``."""
     out = []
-    for path, entry in _load_raw()["entries"].items():
+    for path, _fp, entry in _load_all():
         if not include_errors and entry.get("status") != "ok":
             continue
         out.append(
@@ -293,16 +485,15 @@ def all_entries(*, include_errors: bool = True) -> list[dict]:
 
 
 def prune() -> int:
-    """Drop cache entries whose plugin path no longer exists on disk.
-    Returns the number removed."""
-    doc = _load_raw()
-    entries = doc["entries"]
-    gone = [p for p in entries if not os.path.exists(p)]
-    for p in gone:
-        del entries[p]
-    if gone:
-        _save_raw(doc)
-    return len(gone)
+    """Drop cache entries whose plugin path no longer exists on disk and
+    compact superseded records away. Returns the number removed."""
+    items = _load_all()
+    paths = [path for path, _fp, _entry in items]
+    exists = _fingerprint_many(paths)
+    kept = [item for item in items if exists.get(item[0]) is not None]
+    if items:
+        _rewrite(kept)  # also compacts superseded records
+    return len(items) - len(kept)
 
 
 def clear() -> None:
@@ -312,13 +503,14 @@ def clear() -> None:
         f.unlink()
     except FileNotFoundError:
         pass
+    _invalidate_index()
 
 
 def stats() -> dict:
     """Summary counts plus the resolved cache-file path."""
-    entries = _load_raw()["entries"]
-    ok = sum(1 for e in entries.values() if e.get("status") == "ok")
-    err = sum(1 for e in entries.values() if e.get("status") == "error")
+    entries = [entry for _path, _fp, entry in _load_all()]
+    ok = sum(1 for e in entries if e.get("status") == "ok")
+    err = sum(1 for e in entries if e.get("status") == "error")
     return {
         "path": str(cache_file()),
         "exists": cache_file().exists(),
@@ -326,3 +518,105 @@ def stats() -> dict:
         "ok": ok,
         "error": err,
     }
+
+
+# -- auto-tuned block size -------------------------------------------- #
+#
+# process.autotune_block_size probes candidate offline block sizes and
+# records the winner here, piggybacking on the plugin's cache entry so
+# the usual fingerprint rules apply: a changed plugin binary drops the
+# recorded size along with the stale probe metadata.
+
+
+def tuned_block_size(path: str | Path) -> int | None:
+    """Return the auto-tuned offline block size recorded for a plugin,
+    or None when there is no current entry or no recorded size. A stale
+    fingerprint (plugin binary changed) reads as None."""
+    abspath = os.path.abspath(str(path))
+    index, _ = _load_index()
+    rec = index.get(abspath)
+    if rec is None:
+        return None
+    try:
+        fp: tuple[int, int] | None = _fingerprint(abspath)
+    except OSError:
+        return None
+    if fp != (rec.mtime_ns, rec.size):
+        return None
+    entry = _read_entry(rec)
+    if not entry:
+        return None
+    bs = entry.get("tuned_block_size")
+    return bs if isinstance(bs, int) and bs > 0 else None
+
+
+def set_tuned_block_size(path: str | Path, block_size: int) -> None:
+    """Record the auto-tuned offline block size for a plugin (probing
+    and creating the cache entry first if there is none). Later
+    ``block_size="auto"`` renders reuse it instead of re-probing."""
+    block_size = int(block_size)
+    if block_size <= 0:
+        raise ValueError("block_size must be positive")
+    abspath = os.path.abspath(str(path))
+    index, _ = _load_index()
+    rec = index.get(abspath)
+    try:
+        fp: tuple[int, int] | None = _fingerprint(abspath)
+    except OSError:
+        fp = None
+    entry = None
+    if rec is not None and fp == (rec.mtime_ns, rec.size):
+        entry = _read_entry(rec)
+    if entry is None:
+        entry = _probe_to_entry(abspath)
+    entry = dict(entry)
+    entry["tuned_block_size"] = block_size
+    _append_records([(abspath, fp if fp is not None else _NO_FP, entry)])
+
+
+# -- negotiated-layout cache persistence ------------------------------ #
+#
+# Plugin.check_buses_layout answers are memoized natively per (plugin
+# identifier, version, requested layout); these helpers round-trip that
+# in-process map through a sidecar file next to plugins.bin so a fresh
+# process skips layout probing for every combination a previous run
+# already negotiated. The blob is the native export format: one
+# "<0|1> <key>" line per answer, merged (not replaced) on load.
+
+
+def layout_cache_file() -> Path:
+    """Absolute path to the layout-cache sidecar (honors MINIHOST_CACHE_DIR)."""
+    return _default_cache_dir() / "layouts.txt"
+
+
+def save_layout_cache() -> int:
+    """Write the in-process layout answers to disk, merged with any
+    answers already saved by other processes. Returns the number of
+    answers in the saved file."""
+    blob = minihost.layout_cache_export()
+    f = layout_cache_file()
+    lines: dict[str, str] = {}
+    try:
+        for line in f.read_text(encoding="utf-8").splitlines():
+            if len(line) >= 3 and line[0] in "01" and line[1] == " ":
+                lines[line[2:]] = line
+    except FileNotFoundError:
+        pass
+    for line in blob.splitlines():
+        if len(line) >= 3 and line[0] in "01" and line[1] == " ":
+            lines[line[2:]] = line  # this process's answer wins
+    f.parent.mkdir(parents=True, exist_ok=True)
+    tmp = f.with_suffix(".txt.tmp")
+    tmp.write_text("\n".join(lines.values()) + "\n" if lines else "", encoding="utf-8")
+    os.replace(tmp, f)
+    return len(lines)
+
+
+def load_layout_cache() -> int:
+    """Merge previously saved layout answers into the in-process cache.
+    Returns the number imported (0 when no file exists yet)."""
+    try:
+        blob = layout_cache_file().read_text(encoding="utf-8")
+    except FileNotFoundError:
+        return 0
+    return minihost.layout_cache_import(blob)
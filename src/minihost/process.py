@@ -26,11 +26,27 @@ when the caller passes a numpy array).
 
 from __future__ import annotations
 
+import hashlib
+import os
+import queue
+import shutil
+import threading
 from dataclasses import dataclass
 from pathlib import Path
 from typing import TYPE_CHECKING, Any, Callable, Iterator, Sequence, Union, cast
 
-from minihost._core import AudioBuffer, MidiFile, Plugin, PluginChain
+from minihost._core import (
+    AudioBuffer,
+    AudioFileWriter,
+    KeyframeAutomation,
+    MidiFile,
+    MorphAutomation,
+    Plugin,
+    PluginChain,
+    capture_states,
+    probe,
+    restore_states,
+)
 from minihost.audio_io import read_audio, resample, write_audio
 
 if TYPE_CHECKING:
@@ -67,6 +83,94 @@ def _resolve_block_size(block_size: int | None) -> int:
     return 512
 
 
+# -- block-size auto-tune --------------------------------------------- #
+
+# Candidate sizes probed by ``block_size="auto"``. Offline throughput
+# varies up to ~3x across this range depending on the plugin, so a
+# short probe beats any fixed default.
+AUTOTUNE_BLOCK_SIZES = (256, 512, 1024, 2048, 4096)
+_AUTOTUNE_PROBE_SECONDS = 1.0
+
+
+def autotune_block_size(
+    plugin_or_chain: "PluginOrChain",
+    audio: Any | None = None,
+    *,
+    candidates: Sequence[int] = AUTOTUNE_BLOCK_SIZES,
+    probe_seconds: float = _AUTOTUNE_PROBE_SECONDS,
+    use_cache: bool = True,
+) -> int:
+    """Pick the fastest offline block size by timing a short probe
+    render at each candidate size.
+
+    Each candidate processes the first ``probe_seconds`` of ``audio``
+    (silence when rendering synth-style) and the size with the best
+    frames-per-second wins; the plugin is reset between candidates and
+    after the probe so no probe state leaks into the real render. For a
+    :class:`Plugin` opened from a file path the winner is recorded in
+    the plugin cache, so later ``"auto"`` runs skip the probe entirely
+    (the record is dropped when the plugin binary changes).
+    ``process_audio(..., block_size="auto")`` calls this internally.
+
+    Candidates above the plugin's construction ``max_block_size`` are
+    safe to probe: processing sub-blocks internally, so both the
+    measurement and a render at that size simply saturate at the
+    plugin's own maximum.
+    """
+    import time
+
+    path = getattr(plugin_or_chain, "path", None)
+    if use_cache and isinstance(plugin_or_chain, Plugin) and path:
+        from minihost import plugincache
+
+        cached = plugincache.tuned_block_size(path)
+        if cached is not None:
+            return cached
+
+    if not candidates:
+        raise ValueError("autotune_block_size needs at least one candidate")
+
+    in_ch = max(plugin_or_chain.num_input_channels, 1)
+    out_ch = max(plugin_or_chain.num_output_channels, 1)
+    sample_rate = float(plugin_or_chain.sample_rate)
+    probe_frames = max(int(probe_seconds * sample_rate), max(candidates))
+    probe = AudioBuffer(in_ch, probe_frames)
+    if audio is not None:
+        src = _to_audiobuffer(audio, 0)
+        ncopy = min(probe_frames, src.frames)
+        nch = min(in_ch, src.channels)
+        if ncopy > 0:
+            probe[:nch, :ncopy] = src[:nch, :ncopy]
+
+    best_block = int(candidates[0])
+    best_score = None
+    for cand in candidates:
+        cand = int(cand)
+        frames_done = (probe_frames // cand) * cand
+        if frames_done <= 0:
+            continue
+        plugin_or_chain.reset()
+        in_block = AudioBuffer(in_ch, cand)
+        out_block = AudioBuffer(out_ch, cand)
+        t0 = time.perf_counter()
+        for start in range(0, frames_done, cand):
+            in_block[:, :] = probe[:, start : start + cand]
+            plugin_or_chain.process(in_block, out_block)
+        # Seconds per frame, so candidates that cover slightly
+        # different probe lengths still compare fairly.
+        score = (time.perf_counter() - t0) / frames_done
+        if best_score is None or score < best_score:
+            best_score = score
+            best_block = cand
+    plugin_or_chain.reset()
+
+    if use_cache and isinstance(plugin_or_chain, Plugin) and path:
+        from minihost import plugincache
+
+        plugincache.set_tuned_block_size(path, best_block)
+    return best_block
+
+
 def _to_audiobuffer(audio: Any, in_ch_required: int) -> AudioBuffer:
     """Coerce an input to an AudioBuffer (one copy if not already one)."""
     if isinstance(audio, AudioBuffer):
@@ -197,6 +301,8 @@ class _RenderContext:
     out_frames: int
     render_frames: int
     latency: int
+    morph: MorphAutomation | None
+    curves: KeyframeAutomation | None
 
 
 def _prepare_render(
@@ -204,12 +310,14 @@ def _prepare_render(
     audio: Any | None,
     *,
     tail_seconds: float,
-    block_size: int | None,
+    block_size: int | str | None,
     compensate_latency: bool,
     midi: MidiInput | None,
     sidechain: Any | None,
     param_changes: Sequence | None,
     bpm: float | None,
+    morph: MorphAutomation | None = None,
+    curves: KeyframeAutomation | None = None,
 ) -> _RenderContext:
     """Validate inputs, resolve sources, compute geometry, set transport.
 
@@ -217,7 +325,15 @@ def _prepare_render(
     the per-block process loop. Side effect: sets the plugin's
     transport when ``bpm`` is given.
     """
-    block = _resolve_block_size(block_size)
+    if isinstance(block_size, str):
+        if block_size != "auto":
+            raise ValueError(
+                f"block_size must be an int, None, or 'auto', "
+                f"got {block_size!r}"
+            )
+        block = autotune_block_size(plugin_or_chain, audio)
+    else:
+        block = _resolve_block_size(block_size)
     sample_rate = float(plugin_or_chain.sample_rate)
     in_ch_required = plugin_or_chain.num_input_channels
     out_ch = plugin_or_chain.num_output_channels
@@ -233,6 +349,16 @@ def _prepare_render(
             "bpm transport is only supported for Plugin, not PluginChain "
             "(set transport on individual plugins instead)."
         )
+    if morph is not None and is_chain:
+        raise ValueError(
+            "morph automation is only supported for Plugin, not PluginChain "
+            "(snapshots are per-plugin parameter sets)."
+        )
+    if curves is not None and is_chain:
+        raise ValueError(
+            "keyframe-curve automation is only supported for Plugin, not "
+            "PluginChain (curves address per-plugin parameter indices)."
+        )
 
     midi_events: list = []
     midi_max_sample = 0
@@ -285,6 +411,8 @@ def _prepare_render(
         out_frames=out_frames,
         render_frames=render_frames,
         latency=latency,
+        morph=morph,
+        curves=curves,
     )
 
 
@@ -332,6 +460,8 @@ def _iter_blocks(
     out_frames = ctx.out_frames
     render_frames = ctx.render_frames
     plugin_or_chain = ctx.plugin_or_chain
+    morph = ctx.morph
+    curves = ctx.curves
 
     in_block = AudioBuffer(work_in, block)
     out_block = AudioBuffer(out_ch, block)
@@ -380,6 +510,16 @@ def _iter_blocks(
             else:
                 psc = None
 
+        if morph is not None:
+            # One native call: interpolate the whole A/B snapshot at this
+            # block's start and write it as a batched parameter update.
+            cast(Plugin, plugin_or_chain).apply_morph(morph, start)
+
+        if curves is not None:
+            # One native call: evaluate every keyframe curve at this
+            # block's start and write the results as a batched update.
+            cast(Plugin, plugin_or_chain).apply_curves(curves, start)
+
         if has_sidechain:
             for ev in block_auto:
                 if len(ev) == 3:
@@ -429,11 +569,77 @@ def _iter_blocks(
         progress_callback(out_frames, out_frames)
 
 
+# Queue sentinel marking normal end-of-stream in _iter_blocks_prefetched.
+_PREFETCH_DONE = object()
+
+
+def _iter_blocks_prefetched(
+    ctx: _RenderContext,
+    prefetch: int,
+    progress_callback: ProgressCallback | None = None,
+) -> Iterator[AudioBuffer]:
+    """Run :func:`_iter_blocks` on a worker thread, yielding from a
+    bounded queue of at most ``prefetch`` pre-rendered blocks.
+
+    The worker owns the plugin for the duration of the stream -- all
+    ``process()`` calls happen on its thread (the native call releases
+    the GIL, so rendering genuinely overlaps with a consumer doing I/O
+    or analysis). The consumer side only ever touches yielded blocks,
+    which are independent copies (``_iter_blocks``'s ``copy=True``
+    default), so no buffer is shared across the thread boundary.
+
+    ``progress_callback`` fires on the worker thread, after each
+    *rendered* block -- which with prefetch runs ahead of consumption.
+
+    Exceptions raised inside the render loop are re-raised in the
+    consumer. Abandoning the generator (``close()`` / GC / ``break``)
+    stops the worker at the next block boundary.
+    """
+    blocks: queue.Queue[Any] = queue.Queue(maxsize=prefetch)
+    stop = threading.Event()
+
+    def _worker() -> None:
+        try:
+            for block in _iter_blocks(ctx, progress_callback=progress_callback):
+                if stop.is_set():
+                    return
+                blocks.put(block)
+                if stop.is_set():
+                    return
+            blocks.put(_PREFETCH_DONE)
+        except BaseException as exc:  # re-raised on the consumer side
+            blocks.put(exc)
+
+    worker = threading.Thread(
+        target=_worker, name="minihost-prefetch", daemon=True
+    )
+    worker.start()
+    try:
+        while True:
+            item = blocks.get()
+            if item is _PREFETCH_DONE:
+                break
+            if isinstance(item, BaseException):
+                raise item
+            yield item
+    finally:
+        # Unblock a worker stuck on a full queue, then wait for it to
+        # finish so the plugin is idle again when the caller gets
+        # control back (closing a plugin mid-render is not safe).
+        stop.set()
+        while worker.is_alive():
+            try:
+                blocks.get_nowait()
+            except queue.Empty:
+                pass
+            worker.join(timeout=0.05)
+
+
 def process_audio(
     plugin_or_chain: "PluginOrChain",
     audio: Any | None = None,
     tail_seconds: float = 0.0,
-    block_size: int | None = None,
+    block_size: int | str | None = None,
     compensate_latency: bool = True,
     normalize: float | None = None,
     progress_callback: ProgressCallback | None = None,
@@ -443,6 +649,8 @@ def process_audio(
     param_changes: Sequence[ParamChangePlugin | ParamChangeChain] | None = None,
     bpm: float | None = None,
     in_place: bool = False,
+    morph: MorphAutomation | None = None,
+    curves: KeyframeAutomation | None = None,
 ) -> AudioBuffer:
     """Process audio through a plugin or chain.
 
@@ -458,6 +666,10 @@ def process_audio(
         tail_seconds: Extra silent input rendered after the source so
             reverb / delay tails are captured.
         block_size: Audio block size used for the internal process loop.
+            Pass ``"auto"`` to probe a few candidate sizes on the
+            first second of material and use the fastest (see
+            :func:`autotune_block_size`; the winner is cached per
+            plugin, so later auto runs skip the probe).
         compensate_latency: When True (default), render
             ``plugin.latency_samples`` extra frames at the end and discard
             the matching number of frames from the start.
@@ -478,6 +690,17 @@ def process_audio(
             :class:`PluginChain` use ``(sample, plugin_idx, param_idx,
             value)``. Routed through ``process_auto``.
         bpm: Set transport tempo (Plugin only) once before rendering.
+        morph: Optional :class:`minihost.MorphAutomation` (Plugin only).
+            Applied once per block at the block's start sample: the whole
+            A/B snapshot is interpolated natively and written as one
+            batched parameter update -- block-rate morph sweeps without a
+            Python-side loop over ``set_param``.
+        curves: Optional :class:`minihost.KeyframeAutomation` (Plugin
+            only). Evaluated once per block at the block's start sample:
+            every curve is interpolated natively and written as one
+            batched parameter update -- block-rate keyframe automation
+            without materializing a dense ``param_changes`` list up
+            front.
         in_place: When True, write output into the input buffer instead
             of allocating a new one. Saves one buffer's worth of memory
             for the common stereo-in / stereo-out case. **Mutates the
@@ -511,8 +734,37 @@ def process_audio(
         sidechain=sidechain,
         param_changes=param_changes,
         bpm=bpm,
+        morph=morph,
+        curves=curves,
     )
 
+    # Fast path: single Plugin, no sidechain, no in-place aliasing, no
+    # per-block progress reporting -- hand the whole render to the native
+    # block loop (one Python -> C++ crossing instead of one per block, GIL
+    # released throughout). Sidechain renders need per-block set_param +
+    # process_sidechain calls, morph and curves render a per-block
+    # apply_morph / apply_curves call, and in_place writes into the
+    # caller's buffer, so those keep the Python loop.
+    if (
+        isinstance(plugin_or_chain, Plugin)
+        and not in_place
+        and not ctx.has_sidechain
+        and ctx.morph is None
+        and ctx.curves is None
+        and progress_callback is None
+    ):
+        output = plugin_or_chain.render_blocks(
+            ctx.src,
+            ctx.out_frames,
+            ctx.block,
+            latency=ctx.latency,
+            midi_in=ctx.midi_events,
+            param_changes=ctx.auto_list,
+        )
+        if normalize is not None:
+            _normalize_peak(output, float(normalize))
+        return output
+
     if in_place:
         if not isinstance(audio, AudioBuffer):
             raise TypeError(
@@ -552,7 +804,7 @@ def process_audio_stream(
     plugin_or_chain: "PluginOrChain",
     audio: Any | None = None,
     tail_seconds: float = 0.0,
-    block_size: int | None = None,
+    block_size: int | str | None = None,
     compensate_latency: bool = True,
     progress_callback: ProgressCallback | None = None,
     *,
@@ -561,6 +813,7 @@ def process_audio_stream(
     param_changes: Sequence[ParamChangePlugin | ParamChangeChain] | None = None,
     bpm: float | None = None,
     as_: type | None = None,
+    prefetch: int = 0,
 ) -> "Iterator[AudioBuffer | np.ndarray]":
     """Stream blocks of processed audio.
 
@@ -578,6 +831,15 @@ def process_audio_stream(
             each yielded block (and once more after the final block).
         as_: Container type for each yielded block. ``AudioBuffer``
             (default) or ``numpy.ndarray``.
+        prefetch: Number of blocks to render ahead of the consumer.
+            ``0`` (default) renders synchronously: each block is
+            produced when the consumer asks for it. ``N > 0`` moves
+            rendering to a worker thread feeding a bounded queue of up
+            to ``N`` pre-rendered blocks, so a consumer that stalls
+            (network writes, analysis) overlaps with rendering instead
+            of serializing with it -- the native ``process()`` call
+            releases the GIL, so the two sides genuinely run
+            concurrently.
 
     Yields:
         Audio blocks of shape ``(channels, n)`` where ``n <=
@@ -589,6 +851,14 @@ def process_audio_stream(
         normalization requires the full output's peak, which a
         streaming consumer doesn't have. Normalize offline if needed.
 
+        With ``prefetch > 0`` the worker thread owns the plugin until
+        the stream ends or the generator is closed -- don't touch the
+        plugin (parameters, ``close()``) from other threads while
+        iterating. ``progress_callback`` then fires on the worker
+        thread and tracks *rendered* frames, which run ahead of what
+        the consumer has seen. Abandoning the generator early stops
+        the worker at the next block boundary.
+
     Example:
         >>> import minihost
         >>> plugin = minihost.Plugin("reverb.vst3", sample_rate=48000)
@@ -600,6 +870,9 @@ def process_audio_stream(
     """
     from minihost.render import _coerce_block
 
+    if prefetch < 0:
+        raise ValueError(f"prefetch must be >= 0, got {prefetch}")
+
     ctx = _prepare_render(
         plugin_or_chain,
         audio,
@@ -612,10 +885,805 @@ def process_audio_stream(
         bpm=bpm,
     )
 
-    for block in _iter_blocks(ctx, progress_callback=progress_callback):
+    if prefetch > 0:
+        it = _iter_blocks_prefetched(ctx, prefetch, progress_callback=progress_callback)
+    else:
+        it = _iter_blocks(ctx, progress_callback=progress_callback)
+    for block in it:
         yield _coerce_block(block, as_)
 
 
+class PreparedRender:
+    """Reusable render context for repeated renders of the same material.
+
+    Parameter-search tooling calls :func:`process_audio` hundreds of
+    times on one plugin + input with only the parameter values changing,
+    and rebuilding the render context each call (input coercion, buffer
+    allocation, MIDI event resolution, geometry computation) then
+    becomes a significant fraction of each iteration. This prepares
+    once; :meth:`run` executes only parameter application and the block
+    loop.
+
+    Everything that shapes the render geometry is fixed at
+    construction: audio, MIDI, sidechain, tail, block size, latency
+    compensation, transport. Per-run knobs are the parameter values
+    (``params``, ``param_changes``, ``morph``, ``curves``) and
+    ``normalize``.
+
+    Example:
+        >>> import minihost
+        >>> plugin = minihost.Plugin("filter.vst3", sample_rate=48000)
+        >>> audio, sr = minihost.read_audio("loop.wav")
+        >>> pr = minihost.PreparedRender(plugin, audio, block_size=1024)
+        >>> for cutoff in candidates:
+        ...     out = pr.run(params=[(3, cutoff)])
+        ...     score(out)
+    """
+
+    def __init__(
+        self,
+        plugin_or_chain: "PluginOrChain",
+        audio: Any | None = None,
+        *,
+        tail_seconds: float = 0.0,
+        block_size: int | str | None = None,
+        compensate_latency: bool = True,
+        midi: MidiInput | None = None,
+        sidechain: Any | None = None,
+        bpm: float | None = None,
+    ) -> None:
+        self._ctx = _prepare_render(
+            plugin_or_chain,
+            audio,
+            tail_seconds=tail_seconds,
+            block_size=block_size,
+            compensate_latency=compensate_latency,
+            midi=midi,
+            sidechain=sidechain,
+            param_changes=None,
+            bpm=bpm,
+        )
+
+    @property
+    def block_size(self) -> int:
+        """Resolved block size (after ``"auto"`` tuning, if requested)."""
+        return self._ctx.block
+
+    @property
+    def out_frames(self) -> int:
+        """Frame count of each run's output buffer."""
+        return self._ctx.out_frames
+
+    def run(
+        self,
+        params: Any | None = None,
+        *,
+        param_changes: Sequence[ParamChangePlugin | ParamChangeChain] | None = None,
+        morph: MorphAutomation | None = None,
+        curves: KeyframeAutomation | None = None,
+        normalize: float | None = None,
+        reset: bool = True,
+    ) -> AudioBuffer:
+        """Render once with the prepared context.
+
+        Args:
+            params: Static parameter values for this run, applied as one
+                batched :meth:`Plugin.set_params` call before the block
+                loop. A ``{index: value}`` mapping or an iterable of
+                ``(index, value)`` pairs. Plugin only.
+            param_changes: Sample-accurate automation for this run (same
+                shapes as :func:`process_audio`).
+            morph: Optional :class:`minihost.MorphAutomation` applied
+                per block (Plugin only).
+            curves: Optional :class:`minihost.KeyframeAutomation`
+                evaluated per block (Plugin only).
+            normalize: If not None, peak-normalize the output to this
+                target in dBFS.
+            reset: When True (default), call ``reset()`` on the plugin
+                or chain first so runs are independent -- otherwise
+                delay lines and envelopes carry over from the previous
+                run. Parameter values are untouched by reset.
+
+        Returns:
+            A new :class:`AudioBuffer` of shape
+            ``(num_output_channels, out_frames)``.
+        """
+        ctx = self._ctx
+        plugin_or_chain = ctx.plugin_or_chain
+        is_chain = isinstance(plugin_or_chain, PluginChain)
+        if params is not None and is_chain:
+            raise ValueError(
+                "params is only supported for Plugin, not PluginChain "
+                "(use 4-tuple param_changes to address chain plugins)."
+            )
+        if morph is not None and is_chain:
+            raise ValueError(
+                "morph automation is only supported for Plugin, not "
+                "PluginChain (snapshots are per-plugin parameter sets)."
+            )
+        if curves is not None and is_chain:
+            raise ValueError(
+                "keyframe-curve automation is only supported for Plugin, "
+                "not PluginChain (curves address per-plugin parameter "
+                "indices)."
+            )
+
+        if reset:
+            plugin_or_chain.reset()
+        if params is not None:
+            pairs = params.items() if hasattr(params, "items") else params
+            cast(Plugin, plugin_or_chain).set_params(
+                [(int(i), float(v)) for i, v in pairs]
+            )
+
+        # The context is reused across runs; only the per-run automation
+        # slots change. Cursor state lives in _iter_blocks locals, so
+        # nothing else needs resetting.
+        ctx.auto_list = list(param_changes) if param_changes else []
+        ctx.has_auto = bool(param_changes)
+        ctx.morph = morph
+        ctx.curves = curves
+
+        # Same fast path as process_audio: a plain Plugin render with no
+        # sidechain / morph / curves goes through the native block loop.
+        if (
+            isinstance(plugin_or_chain, Plugin)
+            and not ctx.has_sidechain
+            and morph is None
+            and curves is None
+        ):
+            output = plugin_or_chain.render_blocks(
+                ctx.src,
+                ctx.out_frames,
+                ctx.block,
+                latency=ctx.latency,
+                midi_in=ctx.midi_events,
+                param_changes=ctx.auto_list,
+            )
+        else:
+            output = AudioBuffer(ctx.out_ch, ctx.out_frames)
+            written = 0
+            for block in _iter_blocks(ctx, copy=False):
+                n = block.frames
+                output[:, written : written + n] = block
+                written += n
+
+        if normalize is not None:
+            _normalize_peak(output, float(normalize))
+        return output
+
+
+def process_audio_multibus(
+    plugin: Plugin,
+    audio: Any | None = None,
+    tail_seconds: float = 0.0,
+    block_size: int | None = None,
+    compensate_latency: bool = True,
+    *,
+    midi: MidiInput | None = None,
+    output_paths: Sequence[str | None] | None = None,
+    bit_depth: int = 24,
+    progress_callback: ProgressCallback | None = None,
+) -> list[AudioBuffer | None]:
+    """Capture every output bus of a multi-out plugin in one pass.
+
+    Multitimbral instruments (16-out drum samplers and the like) expose
+    several output buses; :func:`process_audio` only returns the
+    combined channel set, so splitting per bus used to mean one full
+    render per soloed bus. This renders once through
+    :meth:`Plugin.process_multibus`, demultiplexing each enabled bus
+    into its own buffer as blocks complete.
+
+    Args:
+        plugin: A :class:`minihost.Plugin` (chains have no bus surface).
+        audio: Optional main-bus input of shape ``(channels, frames)``;
+            ``None`` (the usual case for instruments) feeds silence and
+            derives the length from ``midi`` plus ``tail_seconds``.
+        tail_seconds: Extra silent input rendered after the source /
+            last MIDI event so decaying tails are captured.
+        block_size: Audio block size used for the internal process loop.
+        compensate_latency: When True (default), render
+            ``plugin.latency_samples`` extra frames and discard the
+            matching number of leading output frames on every bus.
+        midi: Optional MIDI driver, same accepted forms as
+            :func:`process_audio`.
+        output_paths: Optional per-bus output file paths, parallel to
+            the bus list; non-None entries are written via
+            :func:`minihost.write_audio`. A path for a disabled bus
+            raises.
+        bit_depth: Bit depth for files written via ``output_paths``.
+        progress_callback: ``(processed_frames, total_frames)`` callback
+            invoked once per block.
+
+    Returns:
+        A list with one entry per output bus, in bus order: an
+        :class:`AudioBuffer` of shape ``(bus_channels, total_frames)``
+        for each enabled bus, ``None`` for disabled buses.
+    """
+    if not isinstance(plugin, Plugin):
+        raise TypeError(
+            "process_audio_multibus requires a Plugin; chains do not "
+            "expose per-bus outputs"
+        )
+    num_buses = plugin.num_output_buses
+    if num_buses < 1:
+        raise ValueError("plugin reports no output buses")
+    buses = [plugin.get_bus_info(False, b) for b in range(num_buses)]
+    active = [
+        b["is_enabled"] and b["num_channels"] > 0 for b in buses
+    ]
+    if not any(active):
+        raise ValueError("plugin has no enabled output buses")
+    if output_paths is not None:
+        if len(output_paths) != num_buses:
+            raise ValueError(
+                f"output_paths must have one entry per output bus "
+                f"({num_buses}), got {len(output_paths)}"
+            )
+        for b, path in enumerate(output_paths):
+            if path is not None and not active[b]:
+                raise ValueError(
+                    f"output_paths[{b}] names a file but bus "
+                    f"'{buses[b]['name']}' is disabled"
+                )
+
+    block = _resolve_block_size(block_size)
+    sample_rate = float(plugin.sample_rate)
+    in_ch_required = plugin.num_input_channels
+
+    src = _to_audiobuffer(audio, in_ch_required) if audio is not None else None
+    src_frames = src.frames if src is not None else 0
+    midi_events: list[MidiEvent] = []
+    midi_end = 0
+    if midi is not None:
+        midi_events, midi_end = _load_midi_events(midi, sample_rate)
+    content = max(src_frames, midi_end + 1 if midi_events else 0)
+    out_frames = content + int(tail_seconds * sample_rate)
+    latency = max(0, int(plugin.latency_samples)) if compensate_latency else 0
+    render_frames = out_frames + latency
+
+    results: list[AudioBuffer | None] = [
+        AudioBuffer(buses[b]["num_channels"], out_frames) if active[b] else None
+        for b in range(num_buses)
+    ]
+    if out_frames > 0:
+        # Persistent full-size scratch blocks, one per enabled bus.
+        scratch = [
+            AudioBuffer(buses[b]["num_channels"], block) if active[b] else None
+            for b in range(num_buses)
+        ]
+        in_block = AudioBuffer(src.channels, block) if src is not None else None
+
+        pos = 0
+        event_idx = 0
+        while pos < render_frames:
+            n = min(block, render_frames - pos)
+            if n < block:
+                outs: list[AudioBuffer | None] = [
+                    AudioBuffer(buses[b]["num_channels"], n) if active[b] else None
+                    for b in range(num_buses)
+                ]
+                in_blk = AudioBuffer(src.channels, n) if src is not None else None
+            else:
+                outs = scratch
+                in_blk = in_block
+            if src is not None and in_blk is not None:
+                in_blk.clear()
+                avail = min(n, src_frames - pos)
+                if avail > 0:
+                    in_blk[:, :avail] = cast(
+                        AudioBuffer, src[:, pos : pos + avail]
+                    )
+            block_events, event_idx = _slice_block_events(
+                midi_events, event_idx, pos, pos + n
+            )
+            plugin.process_multibus(
+                outs, input=in_blk, midi_in=block_events or None
+            )
+
+            # Latency compensation: discard the first `latency` output
+            # frames, writing the remainder at the compensated position.
+            keep_from = max(0, latency - pos)
+            if keep_from < n:
+                dest = pos + keep_from - latency
+                take = min(n - keep_from, out_frames - dest)
+                if take > 0:
+                    for b in range(num_buses):
+                        buf = results[b]
+                        if buf is not None:
+                            out_blk = cast(AudioBuffer, outs[b])
+                            buf[:, dest : dest + take] = cast(
+                                AudioBuffer,
+                                out_blk[:, keep_from : keep_from + take],
+                            )
+            pos += n
+            if progress_callback is not None:
+                progress_callback(min(pos, render_frames), render_frames)
+
+    if output_paths is not None:
+        for b, path in enumerate(output_paths):
+            if path is not None:
+                write_audio(
+                    path,
+                    cast(AudioBuffer, results[b]),
+                    int(sample_rate),
+                    bit_depth=bit_depth,
+                )
+
+    return results
+
+
+@dataclass
+class BatchResult:
+    """Outcome of one :func:`batch_process` job.
+
+    ``error`` is ``None`` on success, otherwise the stringified
+    exception from the worker that processed the job. ``cached`` is True
+    when the output came from a :class:`RenderCache` hit instead of a
+    render.
+    """
+
+    input: str | None
+    output: str
+    error: str | None = None
+    cached: bool = False
+
+    @property
+    def ok(self) -> bool:
+        return self.error is None
+
+
+# Per-worker-process target built once by _batch_worker_init and reused
+# for every job the worker pulls. Module globals are the standard way to
+# carry state across multiprocessing.Pool task invocations.
+_batch_target: "PluginOrChain | None" = None
+_batch_opts: dict = {}
+
+
+def _capture_batch_spec(source: Any, sample_rate: int | None) -> tuple[dict, int]:
+    """Reduce ``source`` to a picklable spec workers can rebuild from.
+
+    Live Plugin / PluginChain objects cannot cross a process boundary,
+    so their configured state is captured here -- once, in the parent --
+    as (path, state-blob) pairs and replayed in each worker.
+    """
+    if isinstance(source, Plugin):
+        if not source.path:
+            raise ValueError(
+                "Plugin has no path (e.g. opened from an AU descriptor); "
+                "batch workers cannot reconstruct it. Pass a plugin path "
+                "or chain spec file instead."
+            )
+        sr = int(sample_rate if sample_rate is not None else source.sample_rate)
+        return {"kind": "plugins", "plugins": [(source.path, source.get_state())]}, sr
+    if isinstance(source, PluginChain):
+        owned = getattr(source, "_owned_plugins", None)
+        if not owned:
+            raise ValueError(
+                "PluginChain does not expose its plugins (build it with "
+                "minihost.load_chain, or pass the chain spec file "
+                "directly)."
+            )
+        for p in owned:
+            if not p.path:
+                raise ValueError(
+                    "Chain contains a plugin with no path; batch workers "
+                    "cannot reconstruct it."
+                )
+        sr = int(sample_rate if sample_rate is not None else source.sample_rate)
+        # Batch capture: one hop to the plugin thread for the whole
+        # chain, instead of a round trip per plugin.
+        states = capture_states(list(owned))
+        return {
+            "kind": "plugins",
+            "plugins": [(p.path, s) for p, s in zip(owned, states)],
+        }, sr
+    path = str(source)
+    sr = int(sample_rate) if sample_rate is not None else 48000
+    if path.lower().endswith((".json", ".yaml", ".yml")):
+        # The spec file may set its own sample_rate; only override it
+        # when the caller asked for a rate explicitly.
+        return {
+            "kind": "chain_spec",
+            "spec_path": path,
+            "sample_rate": int(sample_rate) if sample_rate is not None else None,
+        }, sr
+    return {"kind": "plugins", "plugins": [(path, None)]}, sr
+
+
+def _build_batch_target(
+    spec: dict, sample_rate: int, block_size: int
+) -> "PluginOrChain":
+    """Rebuild the plugin or chain a batch spec describes."""
+    if spec["kind"] == "chain_spec":
+        from minihost.chain import load_chain
+
+        return load_chain(
+            spec["spec_path"],
+            sample_rate=spec["sample_rate"],
+            block_size=block_size,
+        )
+
+    plugins: list[Plugin] = []
+    states: list[bytes | None] = []
+    for path, state in spec["plugins"]:
+        plugin = Plugin(path, sample_rate=sample_rate, max_block_size=block_size)
+        plugin.non_realtime = True
+        plugins.append(plugin)
+        states.append(state if state else None)
+    # Batch restore mirrors the batch capture above: one hop to the
+    # plugin thread for the whole chain (None entries are skipped).
+    if any(s is not None for s in states):
+        restore_states(plugins, states)
+    if len(plugins) == 1:
+        return plugins[0]
+    from minihost.chain import _OwningPluginChain
+
+    return _OwningPluginChain(plugins)
+
+
+def _batch_worker_init(spec: dict, opts: dict) -> None:
+    """Pool initializer: build this worker's plugin/chain instance once.
+
+    Runs in the worker process, where a fresh import of minihost brings
+    up the worker's own JUCE MessageManager (one per process -- see
+    mh_message_thread_init), so plugin instantiation here is isolated
+    from the parent and from sibling workers.
+    """
+    global _batch_target, _batch_opts
+    _batch_target = _build_batch_target(
+        spec, opts["sample_rate"], opts["block_size"]
+    )
+    _batch_opts = opts
+
+
+def _batch_worker_run(job: tuple[int, str, str]) -> tuple[int, str | None]:
+    """Process one (index, input, output) job on this worker's instance."""
+    index, input_path, output_path = job
+    assert _batch_target is not None
+    opts = _batch_opts
+    try:
+        _batch_target.reset()
+        process_audio_to_file(
+            _batch_target,
+            input_path,
+            output_path,
+            tail_seconds=opts["tail_seconds"],
+            block_size=opts["block_size"],
+            bit_depth=opts["bit_depth"],
+            resample_to_plugin_rate=opts["resample_to_plugin_rate"],
+            duplicate_to_stereo=opts["duplicate_to_stereo"],
+            normalize=opts["normalize"],
+        )
+    except Exception as e:  # worker boundary: report, don't kill the pool
+        return index, str(e)
+    return index, None
+
+
+# -- content-addressed render cache ----------------------------------- #
+
+# Plugin identity strings for cache keys, memoized on the bundle's
+# (path, mtime, size) so each distinct bundle is probed at most once per
+# process (and re-probed when the bundle changes on disk).
+_plugin_identity_cache: dict[tuple[str, int, int], str] = {}
+
+
+def _plugin_identity(path: str) -> str:
+    """Stable identity string for a plugin bundle, for cache keys.
+
+    ``unique_id:version`` from a metadata probe (the MH_PluginDesc
+    components) when the bundle can be probed; otherwise the path plus
+    file size/mtime, which still invalidates on an in-place update.
+    """
+    p = Path(path)
+    try:
+        st = p.stat()
+        stamp = (str(p), st.st_mtime_ns, st.st_size)
+    except OSError:
+        stamp = (str(p), 0, 0)
+    ident = _plugin_identity_cache.get(stamp)
+    if ident is None:
+        try:
+            desc = probe(str(p))
+            ident = f"{desc['unique_id']}:{desc['version']}"
+        except Exception:
+            ident = f"{stamp[0]}:{stamp[1]}:{stamp[2]}"
+        _plugin_identity_cache[stamp] = ident
+    return ident
+
+
+def _hash_update_file(h: "hashlib._Hash", path: str | Path) -> None:
+    """Feed a file's content into a running hash, in bounded chunks."""
+    with open(path, "rb") as f:
+        while True:
+            chunk = f.read(1 << 20)
+            if not chunk:
+                break
+            h.update(chunk)
+
+
+def _batch_cache_signature(spec: dict, opts: dict) -> str:
+    """Hash everything job-independent that determines a batch's output.
+
+    Covers the render target -- plugin identities (unique_id + version)
+    and captured state blobs, or the chain spec file's content for
+    spec-file targets -- plus every per-job render option. Per-job input
+    content is hashed separately in :meth:`RenderCache.job_key`. Batch
+    jobs carry no MIDI, sidechain, or automation (see
+    :func:`batch_process`), so there is no automation component.
+    """
+    h = hashlib.sha256()
+    h.update(b"minihost-batch-render-v1\0")
+    for key in sorted(opts):
+        h.update(f"{key}={opts[key]!r}\0".encode())
+    if spec["kind"] == "chain_spec":
+        h.update(f"chain_spec:{spec['sample_rate']!r}\0".encode())
+        _hash_update_file(h, spec["spec_path"])
+    else:
+        for path, state in spec["plugins"]:
+            h.update(_plugin_identity(path).encode())
+            h.update(b"\0")
+            h.update(state or b"")
+            h.update(b"\0")
+    return h.hexdigest()
+
+
+class RenderCache:
+    """Content-addressed local store of finished batch renders.
+
+    A render's cache key is a SHA-256 over everything that determines
+    its output: the input file's content, the target's plugin
+    unique_ids (+ versions) and state blobs, and the render options.
+    An unchanged (input, chain-state) job therefore costs one hash plus
+    one file copy instead of a render -- the point of the nightly-farm
+    use case, where most jobs repeat verbatim.
+
+    Objects live under ``<root>/objects/<key[:2]>/<key>`` with the
+    output suffix baked into the key (a ``.wav`` and a ``.flac`` render
+    of the same job are distinct objects). Inserts are atomic (temp
+    file + rename, last writer wins), so concurrent ``batch_process``
+    runs may share a store. ``hits`` / ``misses`` count lookups made
+    through this instance.
+
+    Example:
+        >>> cache = minihost.RenderCache("~/.cache/minihost-renders")
+        >>> results = minihost.batch_process(chain, jobs, cache=cache)
+        >>> print(f"{cache.hits} hits, {cache.misses} misses")
+    """
+
+    def __init__(self, root: str | Path):
+        self.root = Path(root).expanduser()
+        (self.root / "objects").mkdir(parents=True, exist_ok=True)
+        self.hits = 0
+        self.misses = 0
+
+    def job_key(self, signature: str, input_path: str, output_path: str) -> str:
+        """Cache key for one job under a batch signature.
+
+        ``signature`` is the job-independent half (see
+        ``_batch_cache_signature``); the input file's content and the
+        output suffix complete it. The rest of the output path does not
+        participate -- the same render written to a different location
+        is still a hit. Raises OSError if the input is unreadable.
+        """
+        h = hashlib.sha256()
+        h.update(signature.encode())
+        h.update(b"\0")
+        _hash_update_file(h, input_path)
+        return h.hexdigest() + Path(output_path).suffix.lower()
+
+    def _object_path(self, key: str) -> Path:
+        return self.root / "objects" / key[:2] / key
+
+    def fetch(self, key: str, output_path: str | Path) -> bool:
+        """Copy the object for ``key`` to ``output_path`` if present.
+
+        Returns True (and counts a hit) when the object exists; False
+        (a miss) otherwise.
+        """
+        obj = self._object_path(key)
+        if not obj.is_file():
+            self.misses += 1
+            return False
+        out = Path(output_path)
+        out.parent.mkdir(parents=True, exist_ok=True)
+        shutil.copyfile(obj, out)
+        self.hits += 1
+        return True
+
+    def store(self, key: str, output_path: str | Path) -> None:
+        """Insert a finished render into the store (atomic, last wins)."""
+        obj = self._object_path(key)
+        obj.parent.mkdir(parents=True, exist_ok=True)
+        tmp = obj.parent / f"{obj.name}.tmp{os.getpid()}"
+        shutil.copyfile(output_path, tmp)
+        tmp.replace(obj)
+
+    def prune(self, max_bytes: int) -> int:
+        """Evict oldest objects (by mtime) until the store fits
+        ``max_bytes``. Returns the number of objects removed. Intended
+        for a periodic housekeeping pass, not the render path."""
+        entries = []
+        total = 0
+        for obj in (self.root / "objects").glob("*/*"):
+            try:
+                st = obj.stat()
+            except OSError:
+                continue  # racing eviction by another run
+            entries.append((st.st_mtime_ns, st.st_size, obj))
+            total += st.st_size
+        entries.sort(key=lambda e: e[0])
+        removed = 0
+        for _mtime, size, obj in entries:
+            if total <= max_bytes:
+                break
+            try:
+                obj.unlink()
+            except OSError:
+                continue
+            total -= size
+            removed += 1
+        return removed
+
+
+def batch_process(
+    plugin_or_spec: "PluginOrChain | str | Path",
+    jobs: Sequence[tuple[str | Path, str | Path]],
+    workers: int | None = None,
+    *,
+    sample_rate: int | None = None,
+    block_size: int = 512,
+    tail_seconds: float = 0.0,
+    bit_depth: int = 24,
+    resample_to_plugin_rate: bool = True,
+    duplicate_to_stereo: bool = True,
+    normalize: float | None = None,
+    progress_callback: ProgressCallback | None = None,
+    cache: "RenderCache | str | Path | None" = None,
+) -> list[BatchResult]:
+    """Render multiple audio files across a pool of worker processes.
+
+    The API-level counterpart of ``minihost process --batch``: plugin
+    instantiation is amortized over the whole job list instead of paid
+    per file. Worker *processes* (not threads) sidestep both the GIL
+    and the one-MessageManager-per-process constraint documented on
+    ``mh_message_thread_init`` -- each worker imports minihost fresh,
+    brings up its own message thread, and builds its own plugin
+    instance once.
+
+    Args:
+        plugin_or_spec: What to render through. A plugin bundle path, a
+            ``.json`` / ``.yaml`` chain spec path, or a live configured
+            :class:`Plugin` / :class:`PluginChain` -- live objects have
+            their state captured once with ``get_state()`` and replayed
+            into each worker's instance (the objects themselves cannot
+            cross a process boundary). Chains must come from
+            :func:`load_chain` so their plugins are reachable.
+        jobs: ``(input_path, output_path)`` pairs. Covers the plain
+            audio-in / audio-out path; jobs needing MIDI, sidechain, or
+            automation should call :func:`process_audio_to_file`
+            directly.
+        workers: Pool size. Defaults to the CPU count, capped at the
+            number of jobs. ``1`` runs in-process with no pool.
+        sample_rate: Sample rate for worker plugin construction.
+            Defaults to a live object's rate, else 48000.
+        block_size, tail_seconds, bit_depth, resample_to_plugin_rate,
+        duplicate_to_stereo, normalize: Per-job render options, as in
+            :func:`process_audio_to_file`.
+        progress_callback: ``(completed_jobs, total_jobs)`` callback
+            fired in the parent as workers finish jobs.
+        cache: Optional :class:`RenderCache` (or a store directory path
+            to open one). Jobs whose key -- input content, plugin
+            identities + state blobs, render options -- already has an
+            object in the store are satisfied by a file copy and never
+            reach a worker; freshly rendered outputs are inserted for
+            the next run. Cache hits count as completed jobs in
+            ``progress_callback`` and are flagged ``cached`` on their
+            :class:`BatchResult`.
+
+    Returns:
+        One :class:`BatchResult` per job, in job order. A failed job
+        carries its error string; failures never abort the batch.
+
+    Notes:
+        Workers are spawned, not forked: the parent already runs JUCE's
+        message thread plus any audio/recorder threads, none of which
+        survive a fork coherently.
+    """
+    job_list = [(str(i), str(o)) for i, o in jobs]
+    results = [BatchResult(input=i, output=o) for i, o in job_list]
+    if not job_list:
+        return results
+
+    spec, sr = _capture_batch_spec(plugin_or_spec, sample_rate)
+    opts = {
+        "sample_rate": sr,
+        "block_size": int(block_size),
+        "tail_seconds": float(tail_seconds),
+        "bit_depth": int(bit_depth),
+        "resample_to_plugin_rate": resample_to_plugin_rate,
+        "duplicate_to_stereo": duplicate_to_stereo,
+        "normalize": normalize,
+    }
+
+    indexed = [(i, inp, out) for i, (inp, out) in enumerate(job_list)]
+    total_jobs = len(job_list)
+    done = 0
+
+    # Cache pass: satisfy repeat jobs from the object store up front,
+    # so only misses are dispatched (and sized for) below.
+    store: RenderCache | None = None
+    job_keys: dict[int, str] = {}
+    if cache is not None:
+        store = cache if isinstance(cache, RenderCache) else RenderCache(cache)
+        signature = _batch_cache_signature(spec, opts)
+        remaining = []
+        for index, inp, out in indexed:
+            try:
+                key = store.job_key(signature, inp, out)
+            except OSError:
+                # Unreadable input: let the render path report the error.
+                remaining.append((index, inp, out))
+                continue
+            job_keys[index] = key
+            if store.fetch(key, out):
+                results[index].cached = True
+                done += 1
+                if progress_callback is not None:
+                    progress_callback(done, total_jobs)
+            else:
+                remaining.append((index, inp, out))
+        indexed = remaining
+        if not indexed:
+            return results
+
+    def record(index: int, error: str | None) -> None:
+        results[index].error = error
+        if store is not None and error is None and index in job_keys:
+            try:
+                store.store(job_keys[index], results[index].output)
+            except OSError:
+                pass  # a full or read-only store never fails the job
+
+    if workers is None:
+        workers = os.cpu_count() or 1
+    workers = max(1, min(int(workers), len(indexed)))
+
+    if workers == 1:
+        # In-process fallback: reuse a live object directly, avoid the
+        # spawn + re-instantiation cost for a single worker.
+        if isinstance(plugin_or_spec, (Plugin, PluginChain)):
+            target = plugin_or_spec
+        else:
+            target = _build_batch_target(spec, sr, opts["block_size"])
+        global _batch_target, _batch_opts
+        saved = (_batch_target, _batch_opts)
+        _batch_target, _batch_opts = target, opts
+        try:
+            for job in indexed:
+                index, error = _batch_worker_run(job)
+                record(index, error)
+                done += 1
+                if progress_callback is not None:
+                    progress_callback(done, total_jobs)
+        finally:
+            _batch_target, _batch_opts = saved
+        return results
+
+    import multiprocessing
+
+    ctx = multiprocessing.get_context("spawn")
+    with ctx.Pool(
+        processes=workers, initializer=_batch_worker_init, initargs=(spec, opts)
+    ) as pool:
+        for index, error in pool.imap_unordered(_batch_worker_run, indexed):
+            record(index, error)
+            done += 1
+            if progress_callback is not None:
+                progress_callback(done, total_jobs)
+    return results
+
+
 def _read_optional_audio(
     source: Any,
     plugin_sr: int,
@@ -671,7 +1739,7 @@ def process_audio_to_file(
     input_path: str | Path | None = None,
     output_path: str | Path = "",
     tail_seconds: float = 0.0,
-    block_size: int | None = None,
+    block_size: int | str | None = None,
     bit_depth: int = 24,
     resample_to_plugin_rate: bool = True,
     duplicate_to_stereo: bool = True,
@@ -683,6 +1751,7 @@ def process_audio_to_file(
     sidechain: str | Path | AudioBuffer | Any | None = None,
     param_changes: Sequence[ParamChangePlugin | ParamChangeChain] | None = None,
     bpm: float | None = None,
+    unbuffered: bool = False,
 ) -> int:
     """Process an audio file through a plugin or chain and write the result.
 
@@ -699,6 +1768,10 @@ def process_audio_to_file(
         output_path: Destination file (.wav or .flac).
         tail_seconds: Extra silent input rendered after the source.
         block_size: Audio block size for the internal process loop.
+            Pass ``"auto"`` to probe a few candidate sizes on the
+            first second of material and use the fastest (see
+            :func:`autotune_block_size`; the winner is cached per
+            plugin, so later auto runs skip the probe).
         bit_depth: Output bit depth (16/24/32 for WAV; 16/24 for FLAC).
         resample_to_plugin_rate: Resample mismatched inputs to the
             plugin's sample rate when True (default).
@@ -715,6 +1788,11 @@ def process_audio_to_file(
             Plugin only; PluginChain has no sidechain method.
         param_changes: Sample-accurate parameter automation.
         bpm: Transport tempo (Plugin only).
+        unbuffered: Write the output with direct I/O (WAV only),
+            bypassing the OS page cache so large bounces do not evict
+            other working sets on shared render nodes. Ignored when
+            ``normalize`` is set (that path materializes the render and
+            writes in one shot).
 
     Returns:
         Number of frames written.
@@ -757,18 +1835,50 @@ def process_audio_to_file(
                 "Sidechain",
             )
 
-    output = process_audio(
+    if normalize is not None:
+        # Peak normalization needs the full output's peak, so this path
+        # materializes the whole render before writing.
+        output = process_audio(
+            plugin_or_chain,
+            main_src,
+            tail_seconds=tail_seconds,
+            block_size=block_size,
+            compensate_latency=compensate_latency,
+            normalize=normalize,
+            progress_callback=progress_callback,
+            midi=midi,
+            sidechain=sc_src,
+            param_changes=param_changes,
+            bpm=bpm,
+        )
+        write_audio(output_path, output, plugin_sr, bit_depth=bit_depth)
+        return output.frames
+
+    # Streaming path: hand each finished block to the native writer,
+    # whose background thread encodes block N-1 while block N renders.
+    # The render finishes in max(render, encode) time instead of the
+    # sum, and the full output is never held in memory.
+    ctx = _prepare_render(
         plugin_or_chain,
         main_src,
         tail_seconds=tail_seconds,
         block_size=block_size,
         compensate_latency=compensate_latency,
-        normalize=normalize,
-        progress_callback=progress_callback,
         midi=midi,
         sidechain=sc_src,
         param_changes=param_changes,
         bpm=bpm,
     )
-    write_audio(output_path, output, plugin_sr, bit_depth=bit_depth)
-    return output.frames
+    with AudioFileWriter(
+        str(output_path),
+        ctx.out_ch,
+        plugin_sr,
+        bit_depth=bit_depth,
+        unbuffered=unbuffered,
+    ) as writer:
+        # copy=False: writer.write() copies the block into its queue
+        # before returning, so the reused internal buffer is safe.
+        for block in _iter_blocks(ctx, progress_callback=progress_callback, copy=False):
+            writer.write(block)
+        frames = writer.frames_written
+    return frames
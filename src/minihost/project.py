@@ -33,8 +33,23 @@ Schema notes:
     - Output nodes have a `sink` path (WAV/FLAC). Optional `bit_depth`
       (default 24).
     - Plugin nodes have a `path`. Optional `state_b64` for persisted
-      plugin state. Plugin's I/O channel counts are read from the
-      plugin itself; the schema does not duplicate them.
+      plugin state. Optional `state_file`: a path (relative to the
+      project file) to a zlib-compressed sidecar holding the raw state
+      bytes -- used for large states so the JSON topology stays small
+      and parses instantly (a sampler-heavy project is otherwise
+      hundreds of MB of base64 inside the document). `save_project`
+      moves big states to sidecars automatically; `state_b64` wins if
+      both are present. Plugin's I/O channel counts are read from the
+      plugin itself; the schema does not duplicate them. Optional
+      `automation`: a list of `[sample_offset, param_index, value]`
+      keyframes (absolute offsets, compiled param indices -- the output
+      of the automation tooling, not the name-keyed authoring format).
+      Keyframes are handed straight to the graph's native curve
+      renderer at load (`set_node_automation_curves`); nothing is
+      expanded to per-block change lists, so a project carries
+      hour-long curves in a few KB and loads without an expansion
+      pass. In the binary container the keyframes live in a packed
+      `automation` section instead of the topology JSON.
     - Mix nodes have `num_inputs` and `channels`. Optional `gains` array
       of length num_inputs (default all 1.0).
     - MIDI routing uses a second edge class and dedicated node kinds:
@@ -58,25 +73,35 @@ Schema notes:
       Used by the desktop app's node-graph canvas to remember user-
       edited node positions. Missing entries auto-layout; old project
       files without `layout` continue to parse unchanged.
+    - Optional `graph_plan_b64`: a compiled-schedule snapshot
+      (`PluginGraph.export_plan` bytes) embedded at save time so an
+      unchanged project skips graph validation and the topological
+      sort at load. Stale snapshots are ignored by the graph.
 
 MIDI routing (input/output/filter/transpose/velocity-curve/merge nodes and
 `"kind": "midi"` edges) is supported; the schema mirrors what the desktop
 app already understands, so projects round-trip between the two. Still
-omitted: parameter automation and plugin sidechain buses (tracked in
+omitted: plugin sidechain buses (tracked in
 docs/dev/desktop_app_todo.md).
+
+The same topology schema also ships in a binary container with lazily
+loaded plugin-state sections (see `minihost.project_binary`);
+`load_project` sniffs the magic and accepts either format.
 """
 
 from __future__ import annotations
 
 import base64
 import json
+import zlib
+from concurrent.futures import ThreadPoolExecutor
 from dataclasses import dataclass, field
 from pathlib import Path
 from typing import Any
 
 import minihost
 from minihost import audio_io
-from minihost.render import midi_file_to_events
+from minihost.render import _chase_events, midi_file_to_events
 
 
 def _np():
@@ -127,9 +152,22 @@ class _PluginNode:
     id: str
     path: Path | None = None
     state_b64: str | None = None
+    # Resolved path of a zlib-compressed state sidecar (schema
+    # `state_file`, stored relative to the project file).
+    state_file: Path | None = None
     # base64-encoded juce::PluginDescription XML. Set for plugins with no
     # usable file path (AudioUnits); loaded via Plugin.from_descriptor.
     descriptor: str | None = None
+    # Zero-argument callable returning raw state bytes, set by the
+    # binary-container loader so state sections are fetched lazily at
+    # plugin-instantiation time. Takes precedence over state_b64 /
+    # state_file when present.
+    state_loader: Any = field(repr=False, default=None)
+    # Compiled automation keyframes (absolute sample_offset, param
+    # index, value), staged as native curves after the graph compiles.
+    automation: list[tuple[int, int, float]] = field(
+        default_factory=list, repr=False
+    )
     plugin: minihost.Plugin | None = field(repr=False, default=None)
 
 
@@ -219,11 +257,44 @@ def load_project(project_path: str | Path) -> LoadedProject:
     project_path = Path(project_path)
     if not project_path.exists():
         raise FileNotFoundError(project_path)
+
+    # Binary container? (see minihost.project_binary). Sniffed by magic
+    # so render_project and the CLI accept either format transparently.
+    from minihost import project_binary
+
+    if project_binary.is_binary_project(project_path):
+        return project_binary.load_project_binary(project_path)
+
     try:
         doc = json.loads(project_path.read_text())
     except json.JSONDecodeError as exc:
         raise ProjectError(f"invalid JSON: {exc}") from exc
 
+    return _load_project_doc(doc, project_path.parent)
+
+
+def _load_project_doc(
+    doc: dict,
+    project_dir: Path,
+    state_loaders: "dict[str, Any] | None" = None,
+    graph_plan: bytes | None = None,
+) -> LoadedProject:
+    """Build a `LoadedProject` from an already-parsed topology document.
+
+    Shared by the JSON loader and the binary-container loader.
+    `state_loaders` optionally maps plugin node ids to zero-argument
+    callables returning raw state bytes; when present for a node it
+    takes precedence over `state_b64` / `state_file`, and is only
+    invoked at plugin-instantiation time (the binary loader uses this
+    to fetch state sections lazily from the mmap).
+
+    `graph_plan` optionally carries a compiled-schedule snapshot
+    (PluginGraph.export_plan bytes); when absent, the document's
+    `graph_plan_b64` field is used. The plan is staged before compile
+    so an unchanged project skips graph validation and the topological
+    sort; a stale plan is ignored by the graph, so an edited project
+    still compiles correctly.
+    """
     _require_field(doc, "minihost_project_version", int)
     if doc["minihost_project_version"] != SCHEMA_VERSION:
         raise ProjectError(
@@ -240,8 +311,6 @@ def load_project(project_path: str | Path) -> LoadedProject:
     if duration_seconds is not None and not isinstance(duration_seconds, (int, float)):
         raise ProjectError("duration_seconds must be a number")
 
-    project_dir = project_path.parent
-
     # First pass: parse nodes by kind.
     inputs: list[_InputNode] = []
     outputs: list[_OutputNode] = []
@@ -278,6 +347,7 @@ def load_project(project_path: str | Path) -> LoadedProject:
             node_by_id[nid] = ("output", out_node)
         elif kind == "plugin":
             descriptor = raw.get("descriptor")
+            state_file = raw.get("state_file")
             if descriptor:
                 # Descriptor-based (AudioUnit): path is optional.
                 path_val = raw.get("path")
@@ -285,6 +355,9 @@ def load_project(project_path: str | Path) -> LoadedProject:
                     id=nid,
                     path=Path(path_val) if path_val else None,
                     state_b64=raw.get("state_b64"),
+                    state_file=(project_dir / state_file).resolve()
+                    if state_file
+                    else None,
                     descriptor=descriptor,
                 )
             else:
@@ -292,7 +365,13 @@ def load_project(project_path: str | Path) -> LoadedProject:
                     id=nid,
                     path=Path(_require_field(raw, "path", str)),
                     state_b64=raw.get("state_b64"),
+                    state_file=(project_dir / state_file).resolve()
+                    if state_file
+                    else None,
                 )
+            auto_raw = raw.get("automation")
+            if auto_raw is not None:
+                pl_node.automation = _parse_automation_keyframes(nid, auto_raw)
             plugins.append(pl_node)
             node_by_id[nid] = ("plugin", pl_node)
         elif kind == "mix":
@@ -369,6 +448,10 @@ def load_project(project_path: str | Path) -> LoadedProject:
     if not outputs:
         raise ProjectError("project has no output nodes")
 
+    if state_loaders:
+        for pl in plugins:
+            pl.state_loader = state_loaders.get(pl.id)
+
     # Load input audio so we can validate sample rates and decide the
     # render duration before building the graph. numpy is loaded lazily
     # to preserve the numpy-optional invariant for users who never
@@ -420,8 +503,12 @@ def load_project(project_path: str | Path) -> LoadedProject:
 
     # Open plugin instances. Descriptor-based nodes (AudioUnits, which have
     # no file path) open via Plugin.from_descriptor; path-based nodes open by
-    # path.
-    for pl in plugins:
+    # path. Opens run concurrently: the expensive half of a plugin load
+    # (dlopen, module scan, binary read) happens on the calling thread with
+    # the GIL released, and only the JUCE-affine construction serializes on
+    # the plugin thread -- so a many-plugin project loads in roughly the
+    # time of its slowest plugin.
+    def _open_plugin(pl: _PluginNode) -> None:
         try:
             if pl.descriptor:
                 pd_xml = base64.b64decode(pl.descriptor).decode("utf-8")
@@ -442,8 +529,25 @@ def load_project(project_path: str | Path) -> LoadedProject:
             raise
         except Exception as exc:
             raise ProjectError(f"plugin {pl.id!r} failed to open: {exc}") from exc
-        if pl.state_b64:
-            pl.plugin.set_state(base64.b64decode(pl.state_b64))
+        # Batched restore entry point: everything the project persists
+        # for the plugin is applied in a single hop to the plugin
+        # thread (today that is the state blob; program / parameter
+        # writes ride the same call once the schema grows them).
+        if pl.state_loader is not None:
+            pl.plugin.restore(state=pl.state_loader())
+        elif pl.state_b64:
+            pl.plugin.restore(state=base64.b64decode(pl.state_b64))
+        elif pl.state_file is not None:
+            pl.plugin.restore(state=_read_state_sidecar(pl.state_file))
+
+    if len(plugins) > 1:
+        with ThreadPoolExecutor(max_workers=min(8, len(plugins))) as pool:
+            futures = [pool.submit(_open_plugin, pl) for pl in plugins]
+            for fut in futures:
+                fut.result()  # re-raises the first failure
+    else:
+        for pl in plugins:
+            _open_plugin(pl)
 
     # Build the graph.
     g = minihost.PluginGraph(block, float(sr))
@@ -493,8 +597,26 @@ def load_project(project_path: str | Path) -> LoadedProject:
         else:
             raise ProjectError(f'edge kind must be "audio" or "midi", got {ekind!r}')
 
+    if graph_plan is None:
+        plan_b64 = doc.get("graph_plan_b64")
+        if isinstance(plan_b64, str):
+            try:
+                graph_plan = base64.b64decode(plan_b64)
+            except Exception:
+                graph_plan = None  # corrupt snapshot: compile in full
+    if graph_plan:
+        try:
+            g.set_plan(graph_plan)
+        except RuntimeError:
+            pass  # undersized/garbage snapshot: compile in full
     g.compile()
 
+    # Hand compiled automation curves straight to the native renderer:
+    # keyframes stay sparse, evaluation is per block inside the graph.
+    for pl in plugins:
+        if pl.automation:
+            g.set_node_automation_curves(id_to_nodeid[pl.id], pl.automation)
+
     # Parse optional layout. Unknown ids are dropped silently;
     # missing-or-malformed entries become auto-layout fallbacks.
     layout: dict[str, tuple[float, float]] = {}
@@ -541,11 +663,19 @@ def save_project(
     midi_nodes: list[dict] | None = None,
     edges: list[dict],
     layout: dict[str, tuple[float, float]] | None = None,
+    graph_plan: bytes | None = None,
 ) -> None:
     """Write a project JSON file. Caller supplies node and edge dicts
     in the schema format (see module docstring). Atomic write via a
     .tmp file + rename.
 
+    `graph_plan` optionally embeds a compiled-schedule snapshot
+    (`loaded.graph.export_plan()` from a previous load of this same
+    topology) as `graph_plan_b64`; a later load + render of the
+    unchanged project then skips graph validation and the topological
+    sort. Editing the project invalidates the snapshot harmlessly --
+    the graph ignores a plan that no longer matches its shape.
+
     `midi_nodes` is a list of MIDI node dicts; unlike the other node
     lists each entry must carry its own `kind` (one of `midi_input`,
     `midi_output`, `midi_filter`, `midi_transpose`,
@@ -555,7 +685,14 @@ def save_project(
     `layout` is the optional canvas position map (see module docstring).
     Pass `None` (default) to omit; an empty dict writes an empty
     `layout: {}` for readers that prefer the field to be present.
+
+    Plugin state handling: a plugin node whose decoded `state_b64` blob
+    exceeds a small threshold is rewritten to reference a
+    zlib-compressed sidecar file (`state_file`, under
+    `<project>.states/` next to the project file) so the JSON itself
+    stays small and fast to parse. Small states stay inline.
     """
+    project_path = Path(project_path)
     doc: dict[str, Any] = {
         "minihost_project_version": SCHEMA_VERSION,
         "sample_rate": int(sample_rate),
@@ -569,7 +706,9 @@ def save_project(
     for n in input_nodes:
         doc["nodes"].append({"kind": "input", **n})
     for n in plugin_nodes:
-        doc["nodes"].append({"kind": "plugin", **n})
+        doc["nodes"].append(
+            _externalize_plugin_state({"kind": "plugin", **n}, project_path)
+        )
     for n in mix_nodes or []:
         doc["nodes"].append({"kind": "mix", **n})
     for n in midi_nodes or []:
@@ -584,12 +723,59 @@ def save_project(
             nid: {"x": float(x), "y": float(y)} for nid, (x, y) in layout.items()
         }
 
-    project_path = Path(project_path)
+    if graph_plan:
+        doc["graph_plan_b64"] = base64.b64encode(graph_plan).decode("ascii")
+
     tmp = project_path.with_suffix(project_path.suffix + ".tmp")
     tmp.write_text(json.dumps(doc, indent=2) + "\n")
     tmp.replace(project_path)
 
 
+# -- plugin state sidecars --------------------------------------------- #
+
+# Plugin states at or below this many raw (decoded) bytes stay inline as
+# state_b64; larger ones move to a compressed sidecar at save time.
+_STATE_INLINE_MAX = 4096
+
+
+def _state_sidecar_name(node_id: str) -> str:
+    """Filesystem-safe sidecar file name for a plugin node id."""
+    safe = "".join(c if c.isalnum() or c in "-_" else "_" for c in node_id)
+    return f"{safe}.stz"
+
+
+def _read_state_sidecar(path: Path) -> bytes:
+    """Read and decompress a plugin state sidecar (zlib / deflate)."""
+    if not path.exists():
+        raise ProjectError(f"plugin state sidecar not found: {path}")
+    try:
+        return zlib.decompress(path.read_bytes())
+    except zlib.error as exc:
+        raise ProjectError(f"corrupt plugin state sidecar {path}: {exc}") from exc
+
+
+def _externalize_plugin_state(node: dict, project_path: Path) -> dict:
+    """Move a large inline state_b64 blob to a compressed sidecar,
+    returning the (possibly rewritten) node dict. The sidecar lives in
+    `<project stem>.states/` next to the project file and is written
+    before the JSON, so a crash mid-save never leaves a document
+    pointing at a missing state. Small blobs are left inline."""
+    b64 = node.get("state_b64")
+    if not b64:
+        return node
+    state = base64.b64decode(b64)
+    if len(state) <= _STATE_INLINE_MAX:
+        return node
+    state_dir = project_path.parent / (project_path.stem + ".states")
+    state_dir.mkdir(parents=True, exist_ok=True)
+    fname = _state_sidecar_name(str(node.get("id", "plugin")))
+    (state_dir / fname).write_bytes(zlib.compress(state, 6))
+    node = dict(node)
+    del node["state_b64"]
+    node["state_file"] = f"{state_dir.name}/{fname}"
+    return node
+
+
 # -- renderer -------------------------------------------------------- #
 
 
@@ -597,19 +783,71 @@ def render_project(
     project_path: str | Path,
     *,
     progress_callback=None,
+    start_seconds: float | None = None,
+    end_seconds: float | None = None,
+    progress_interval: float = 0.0,
 ) -> LoadedProject:
     """Load, render, and write all output sinks. Returns the
-    `LoadedProject` for inspection / further use."""
+    `LoadedProject` for inspection / further use.
+
+    `start_seconds` / `end_seconds` restrict the render to a window of
+    the project timeline -- a preview knob for spot-checking a passage
+    without rendering everything before it. The renderer seeks straight
+    to the window: audio inputs are read at their absolute positions and
+    each MIDI input's pre-window events are chased (collapsed to held
+    notes plus the last CC / program change / pitch bend per channel,
+    delivered at the first block) rather than replayed. Plugin-internal
+    state from before the window (reverb tails, envelopes) is NOT
+    reproduced, so this is an audition facility, not a bit-exact excerpt
+    of the full render; sinks receive only the window.
+
+    `progress_interval` throttles `progress_callback` to at most one
+    call per that many seconds of rendered audio (plus the final call);
+    0 keeps the per-block default."""
     p = load_project(project_path)
-    _render_loaded(p, progress_callback=progress_callback)
+    _render_loaded(
+        p,
+        progress_callback=progress_callback,
+        start_seconds=start_seconds,
+        end_seconds=end_seconds,
+        progress_interval=progress_interval,
+    )
     return p
 
 
-def _render_loaded(p: LoadedProject, *, progress_callback=None) -> None:
+def _render_loaded(
+    p: LoadedProject,
+    *,
+    progress_callback=None,
+    start_seconds: float | None = None,
+    end_seconds: float | None = None,
+    progress_interval: float = 0.0,
+) -> None:
     np = _np()
     block = p.block_size
     frames_total = p.duration_frames
 
+    # Optional render window [frame, frames_total) in absolute frames.
+    if start_seconds is not None:
+        start_frame = max(0, int(float(start_seconds) * p.sample_rate))
+    else:
+        start_frame = 0
+    if end_seconds is not None:
+        frames_total = min(frames_total, int(float(end_seconds) * p.sample_rate))
+    if (start_frame > 0 or end_seconds is not None) and start_frame >= frames_total:
+        raise ProjectError(
+            f"empty render range: start {start_frame / p.sample_rate:g}s is "
+            f"not before end {frames_total / p.sample_rate:g}s"
+        )
+
+    # Automation curves ride an absolute playhead inside the graph;
+    # align it with the render window and reconstruct parameter state
+    # at the start, so a partial render begins from the state a replay
+    # from zero would have reached (and a re-render starts from the
+    # top).
+    if any(pl.automation for pl in p.plugins):
+        p.graph.seek_automation_state(start_frame)
+
     # Pre-allocate scratch buffers (one per input/output node).
     in_bufs: list = []
     for n in p.inputs:
@@ -620,16 +858,35 @@ def _render_loaded(p: LoadedProject, *, progress_callback=None) -> None:
 
     # Accumulate the whole output in memory for v1. Streaming write is
     # an optimisation for later (mh_audio_write doesn't currently
-    # expose a streaming API at the Python layer).
+    # expose a streaming API at the Python layer). Sinks hold only the
+    # render window, so accumulators are window-sized and indexed
+    # relative to start_frame.
     out_accum: list = [
-        np.zeros((n.channels, frames_total), dtype=np.float32) for n in p.outputs
+        np.zeros((n.channels, frames_total - start_frame), dtype=np.float32)
+        for n in p.outputs
     ]
 
     # Per-input cursors into each MIDI source's (sorted) event list, so
-    # staging a block is a forward walk rather than a rescan.
-    midi_cursors = [0] * len(p.midi_inputs)
+    # staging a block is a forward walk rather than a rescan. For a
+    # windowed render, pre-window events collapse into a chase set
+    # (held notes, last CC / program / pitch bend per channel) injected
+    # at the first block; the cursor then starts at the window.
+    midi_cursors = []
+    midi_chase = []
+    for mi in p.midi_inputs:
+        cur = 0
+        while cur < len(mi.events) and mi.events[cur][0] < start_frame:
+            cur += 1
+        midi_cursors.append(cur)
+        midi_chase.append(
+            _chase_events(mi.events, start_frame) if start_frame > 0 else []
+        )
+
+    # Progress throttling (0 = every block, the historical behaviour).
+    interval_frames = int(progress_interval * p.sample_rate)
+    next_report = start_frame + max(1, interval_frames)
 
-    frame = 0
+    frame = start_frame
     while frame < frames_total:
         n_frames = min(block, frames_total - frame)
         # Stage audio inputs.
@@ -645,7 +902,8 @@ def _render_loaded(p: LoadedProject, *, progress_callback=None) -> None:
         for ci, mi in enumerate(p.midi_inputs):
             events = mi.events
             cur = midi_cursors[ci]
-            block_events = []
+            block_events = midi_chase[ci]
+            midi_chase[ci] = []  # chase rides the first block only
             while cur < len(events) and events[cur][0] < block_end:
                 off, status, d1, d2 = events[cur]
                 block_events.append((off - frame, status, d1, d2))
@@ -656,14 +914,19 @@ def _render_loaded(p: LoadedProject, *, progress_callback=None) -> None:
         p.graph.render_block(in_bufs, out_scratch, n_frames)
         # Capture audio outputs.
         for accum, scratch in zip(out_accum, out_scratch):
-            accum[:, frame : frame + n_frames] = scratch[:, :n_frames]
-        # Drain MIDI outputs, restoring absolute sample offsets.
+            dest = frame - start_frame
+            accum[:, dest : dest + n_frames] = scratch[:, :n_frames]
+        # Drain MIDI outputs, restoring absolute sample offsets rebased
+        # to the render window (sinks hold only the window).
         for mo in p.midi_outputs:
             for off, status, d1, d2 in p.graph.get_midi_output_events(mo.node_id):
-                mo.captured.append((off + frame, status, d1, d2))
+                mo.captured.append((off + frame - start_frame, status, d1, d2))
         frame += n_frames
-        if progress_callback is not None:
-            progress_callback(frame, frames_total)
+        if progress_callback is not None and (
+            interval_frames <= 0 or frame >= next_report or frame >= frames_total
+        ):
+            progress_callback(frame - start_frame, frames_total - start_frame)
+            next_report = frame + interval_frames
 
     # Write audio sinks.
     for out_node, accum in zip(p.outputs, out_accum):
@@ -726,6 +989,34 @@ def _write_midi_events(
     mf.save(str(path))
 
 
+def _parse_automation_keyframes(nid: str, spec: Any) -> list[tuple[int, int, float]]:
+    """Validate a plugin node's `automation` list: each entry is a
+    `[sample_offset, param_index, value]` keyframe with an absolute
+    sample offset and a compiled parameter index."""
+    if not isinstance(spec, list):
+        raise ProjectError(f"plugin {nid!r}: automation must be a list of keyframes")
+    out: list[tuple[int, int, float]] = []
+    for kf in spec:
+        if (
+            not isinstance(kf, (list, tuple))
+            or len(kf) != 3
+            or not isinstance(kf[0], int)
+            or not isinstance(kf[1], int)
+            or not isinstance(kf[2], (int, float))
+        ):
+            raise ProjectError(
+                f"plugin {nid!r}: each automation keyframe must be "
+                f"[sample_offset, param_index, value]"
+            )
+        if kf[0] < 0 or kf[1] < 0:
+            raise ProjectError(
+                f"plugin {nid!r}: automation keyframe offsets and "
+                f"param indices must be >= 0"
+            )
+        out.append((kf[0], kf[1], float(kf[2])))
+    return out
+
+
 def _require_field(d: dict, key: str, expected_type) -> Any:
     if not isinstance(d, dict) or key not in d:
         raise ProjectError(f"missing required field {key!r}")
@@ -0,0 +1,378 @@
+"""Binary project container with lazy section loading.
+
+The JSON project format (see `minihost.project`) keeps topology and
+plugin state in one document, so merely opening a project to look at its
+topology decodes every state blob -- for a sampler-heavy project that is
+hundreds of MB of base64 for no reason. The binary container splits the
+file into independently addressable sections behind a fixed header and
+table of contents, and the loader maps the file with `mmap`: topology is
+the only section parsed up front, and each plugin's state section is
+fetched (and decompressed) lazily, at plugin-instantiation time.
+
+Layout (all integers little-endian):
+
+    offset 0   magic     8 bytes   b"MHPROJB1"
+    offset 8   u32       section count
+    then, per section (the TOC):
+               u16       name length in bytes
+               name      UTF-8
+               u64       absolute offset of the section's payload
+               u64       payload size in bytes
+    section payloads follow the TOC, in TOC order.
+
+Section names:
+
+    "topology"          UTF-8 JSON: the schema-v1 document from
+                        `minihost.project`, except plugin nodes carry
+                        `state_section` (a section name) instead of
+                        `state_b64` / `state_file`.
+    "state/<node id>"   zlib-compressed raw plugin state bytes (same
+                        encoding as the JSON format's .stz sidecars).
+    "automation"        packed per-plugin automation keyframes in the
+                        native curve representation (never expanded to
+                        per-block change lists): u32 plugin count, then
+                        per plugin a u16 node-id length, the id UTF-8,
+                        a u32 keyframe count and that many 16-byte
+                        `<qif` (sample_offset, param_index, value)
+                        records. Kept out of the topology JSON so dense
+                        curves neither bloat nor slow topology parsing.
+    "graph_plan"        optional compiled-schedule snapshot
+                        (PluginGraph.export_plan bytes); staged before
+                        compile so an unchanged project skips graph
+                        validation and the topological sort.
+
+`load_project` in `minihost.project` sniffs the magic, so every consumer
+of the JSON format (render_project, the CLI render command) accepts the
+binary container unchanged.
+"""
+
+from __future__ import annotations
+
+import base64
+import json
+import mmap
+import struct
+import zlib
+from pathlib import Path
+from typing import Any
+
+from minihost.project import (
+    LoadedProject,
+    ProjectError,
+    SCHEMA_VERSION,
+    _load_project_doc,
+)
+
+MAGIC = b"MHPROJB1"
+
+_TOPOLOGY_SECTION = "topology"
+_STATE_SECTION_PREFIX = "state/"
+_GRAPH_PLAN_SECTION = "graph_plan"
+_AUTOMATION_SECTION = "automation"
+
+
+def is_binary_project(path: str | Path) -> bool:
+    """True when the file starts with the binary-container magic."""
+    try:
+        with open(path, "rb") as f:
+            return f.read(len(MAGIC)) == MAGIC
+    except OSError:
+        return False
+
+
+# -- reading ----------------------------------------------------------- #
+
+
+def _read_toc(mm: mmap.mmap) -> dict[str, tuple[int, int]]:
+    """Parse the header + TOC. Returns {name: (offset, size)}."""
+    if len(mm) < len(MAGIC) + 4:
+        raise ProjectError("binary project truncated before TOC")
+    if mm[: len(MAGIC)] != MAGIC:
+        raise ProjectError("not a binary minihost project (bad magic)")
+    (count,) = struct.unpack_from("<I", mm, len(MAGIC))
+    pos = len(MAGIC) + 4
+    toc: dict[str, tuple[int, int]] = {}
+    for _ in range(count):
+        if pos + 2 > len(mm):
+            raise ProjectError("binary project truncated inside TOC")
+        (name_len,) = struct.unpack_from("<H", mm, pos)
+        pos += 2
+        if pos + name_len + 16 > len(mm):
+            raise ProjectError("binary project truncated inside TOC")
+        name = mm[pos : pos + name_len].decode("utf-8")
+        pos += name_len
+        offset, size = struct.unpack_from("<QQ", mm, pos)
+        pos += 16
+        if offset + size > len(mm):
+            raise ProjectError(
+                f"binary project section {name!r} extends past end of file"
+            )
+        if name in toc:
+            raise ProjectError(f"binary project has duplicate section {name!r}")
+        toc[name] = (offset, size)
+    return toc
+
+
+def _parse_automation_section(buf: bytes) -> dict[str, list[list]]:
+    """Unpack the automation section into {node id: keyframe list},
+    keyframes in the schema's [sample_offset, param_index, value]
+    shape (so the shared doc loader validates them like JSON ones)."""
+    if len(buf) < 4:
+        raise ProjectError("binary project automation section truncated")
+    (count,) = struct.unpack_from("<I", buf, 0)
+    pos = 4
+    curves: dict[str, list[list]] = {}
+    for _ in range(count):
+        if pos + 2 > len(buf):
+            raise ProjectError("binary project automation section truncated")
+        (id_len,) = struct.unpack_from("<H", buf, pos)
+        pos += 2
+        if pos + id_len + 4 > len(buf):
+            raise ProjectError("binary project automation section truncated")
+        nid = buf[pos : pos + id_len].decode("utf-8")
+        pos += id_len
+        (n_kf,) = struct.unpack_from("<I", buf, pos)
+        pos += 4
+        if pos + n_kf * 16 > len(buf):
+            raise ProjectError("binary project automation section truncated")
+        keyframes: list[list] = []
+        for _ in range(n_kf):
+            sample, param, value = struct.unpack_from("<qif", buf, pos)
+            pos += 16
+            keyframes.append([sample, param, value])
+        curves[nid] = keyframes
+    return curves
+
+
+def read_topology(project_path: str | Path) -> dict:
+    """Return the parsed topology document without touching any state
+    or automation section, and without instantiating plugins. Works on
+    both formats: for a JSON project this is just the parsed document.
+
+    The cheap way to inspect a project (node kinds, edges, layout) --
+    no plugin opens, no state decode.
+    """
+    project_path = Path(project_path)
+    if not project_path.exists():
+        raise FileNotFoundError(project_path)
+    if not is_binary_project(project_path):
+        try:
+            return json.loads(project_path.read_text())
+        except json.JSONDecodeError as exc:
+            raise ProjectError(f"invalid JSON: {exc}") from exc
+    with open(project_path, "rb") as f:
+        with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mm:
+            toc = _read_toc(mm)
+            if _TOPOLOGY_SECTION not in toc:
+                raise ProjectError("binary project has no topology section")
+            offset, size = toc[_TOPOLOGY_SECTION]
+            try:
+                return json.loads(mm[offset : offset + size].decode("utf-8"))
+            except (UnicodeDecodeError, json.JSONDecodeError) as exc:
+                raise ProjectError(f"corrupt topology section: {exc}") from exc
+
+
+def load_project_binary(project_path: str | Path) -> LoadedProject:
+    """Load a binary project and build a compiled `PluginGraph`.
+
+    Same result as `minihost.project.load_project` on the JSON form.
+    Only the topology section is parsed eagerly; each plugin's state
+    section is read from the mapping and decompressed lazily, when that
+    plugin is instantiated.
+    """
+    project_path = Path(project_path)
+    if not project_path.exists():
+        raise FileNotFoundError(project_path)
+
+    f = open(project_path, "rb")
+    try:
+        mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    except ValueError as exc:  # zero-length file
+        f.close()
+        raise ProjectError(f"binary project is empty: {exc}") from exc
+
+    try:
+        toc = _read_toc(mm)
+        if _TOPOLOGY_SECTION not in toc:
+            raise ProjectError("binary project has no topology section")
+        t_off, t_size = toc[_TOPOLOGY_SECTION]
+        try:
+            doc = json.loads(mm[t_off : t_off + t_size].decode("utf-8"))
+        except (UnicodeDecodeError, json.JSONDecodeError) as exc:
+            raise ProjectError(f"corrupt topology section: {exc}") from exc
+
+        # Rewrite plugin nodes: validate their state_section references
+        # and hand _load_project_doc a lazy fetcher per node. The
+        # fetchers close over the mapping; it stays open until the last
+        # fetcher is dropped (plugins instantiated / project released).
+        state_loaders: dict[str, Any] = {}
+        for raw in doc.get("nodes", []):
+            if not isinstance(raw, dict) or raw.get("kind") != "plugin":
+                continue
+            section = raw.pop("state_section", None)
+            nid = raw.get("id")
+            if section is None or not isinstance(nid, str):
+                continue  # malformed ids fail schema validation below
+            if section not in toc:
+                raise ProjectError(
+                    f"plugin {nid!r} references missing "
+                    f"state section {section!r}"
+                )
+            s_off, s_size = toc[section]
+
+            def _fetch(s_off: int = s_off, s_size: int = s_size) -> bytes:
+                try:
+                    return zlib.decompress(mm[s_off : s_off + s_size])
+                except zlib.error as exc:
+                    raise ProjectError(
+                        f"corrupt plugin state section: {exc}"
+                    ) from exc
+
+            state_loaders[nid] = _fetch
+
+        # Automation keyframes live in their own packed section; hand
+        # them back to the plugin node dicts so the shared doc loader
+        # treats both formats identically (native curves, no expansion).
+        if _AUTOMATION_SECTION in toc:
+            a_off, a_size = toc[_AUTOMATION_SECTION]
+            curves = _parse_automation_section(bytes(mm[a_off : a_off + a_size]))
+            for raw in doc.get("nodes", []):
+                if not isinstance(raw, dict) or raw.get("kind") != "plugin":
+                    continue
+                keyframes = curves.get(raw.get("id"))
+                if keyframes:
+                    raw["automation"] = keyframes
+
+        # Compiled-schedule snapshot (small, so fetched eagerly; the
+        # graph validates and possibly discards it at compile).
+        graph_plan = None
+        if _GRAPH_PLAN_SECTION in toc:
+            p_off, p_size = toc[_GRAPH_PLAN_SECTION]
+            graph_plan = bytes(mm[p_off : p_off + p_size])
+
+        return _load_project_doc(
+            doc, project_path.parent, state_loaders, graph_plan
+        )
+    finally:
+        # The mmap object stays alive through the fetcher closures; this
+        # only drops the load-time file handle (the mapping keeps its
+        # own reference to the underlying file).
+        f.close()
+
+
+# -- writing ----------------------------------------------------------- #
+
+
+def save_project_binary(
+    project_path: str | Path,
+    *,
+    sample_rate: int,
+    block_size: int,
+    duration_seconds: float | None = None,
+    input_nodes: list[dict],
+    output_nodes: list[dict],
+    plugin_nodes: list[dict],
+    mix_nodes: list[dict] | None = None,
+    midi_nodes: list[dict] | None = None,
+    edges: list[dict],
+    layout: dict[str, tuple[float, float]] | None = None,
+    graph_plan: bytes | None = None,
+) -> None:
+    """Write a binary project container. Same keyword surface as
+    `minihost.project.save_project`; plugin `state_b64` blobs are moved
+    to per-node state sections (there is no inline threshold and no
+    sidecar directory -- every state gets a section), and plugin
+    `automation` keyframes are packed into the shared `automation`
+    section. Atomic write via a .tmp file + rename.
+
+    `graph_plan` optionally embeds a compiled-schedule snapshot
+    (`loaded.graph.export_plan()`) as its own section, so load + render
+    of the unchanged project skips graph validation and the topological
+    sort; a stale snapshot is ignored by the graph.
+    """
+    project_path = Path(project_path)
+    doc: dict[str, Any] = {
+        "minihost_project_version": SCHEMA_VERSION,
+        "sample_rate": int(sample_rate),
+        "block_size": int(block_size),
+        "nodes": [],
+        "edges": list(edges),
+    }
+    if duration_seconds is not None:
+        doc["duration_seconds"] = float(duration_seconds)
+
+    sections: list[tuple[str, bytes]] = []
+    automation: list[tuple[str, list]] = []
+    for n in input_nodes:
+        doc["nodes"].append({"kind": "input", **n})
+    for n in plugin_nodes:
+        node = {"kind": "plugin", **n}
+        b64 = node.pop("state_b64", None)
+        node.pop("state_file", None)  # states always go to sections here
+        if b64:
+            if "id" not in node:
+                raise ProjectError("plugin node with state_b64 has no 'id'")
+            section = f"{_STATE_SECTION_PREFIX}{node['id']}"
+            sections.append((section, zlib.compress(base64.b64decode(b64), 6)))
+            node["state_section"] = section
+        keyframes = node.pop("automation", None)
+        if keyframes:
+            if "id" not in node:
+                raise ProjectError("plugin node with automation has no 'id'")
+            automation.append((node["id"], keyframes))
+        doc["nodes"].append(node)
+    for n in mix_nodes or []:
+        doc["nodes"].append({"kind": "mix", **n})
+    for n in midi_nodes or []:
+        if "kind" not in n:
+            raise ProjectError("each midi_nodes entry must include a 'kind'")
+        doc["nodes"].append(dict(n))
+    for n in output_nodes:
+        doc["nodes"].append({"kind": "output", **n})
+
+    if layout is not None:
+        doc["layout"] = {
+            nid: {"x": float(x), "y": float(y)} for nid, (x, y) in layout.items()
+        }
+
+    if automation:
+        # Native keyframe curves, packed (16 bytes each) -- the load
+        # path hands them straight to the graph's curve renderer, so
+        # there is no expansion step on either side.
+        parts_a: list[bytes] = [struct.pack("<I", len(automation))]
+        for nid, keyframes in automation:
+            nid_b = nid.encode("utf-8")
+            parts_a.append(struct.pack("<H", len(nid_b)))
+            parts_a.append(nid_b)
+            parts_a.append(struct.pack("<I", len(keyframes)))
+            for sample, param, value in keyframes:
+                parts_a.append(
+                    struct.pack("<qif", int(sample), int(param), float(value))
+                )
+        sections.append((_AUTOMATION_SECTION, b"".join(parts_a)))
+
+    if graph_plan:
+        sections.append((_GRAPH_PLAN_SECTION, bytes(graph_plan)))
+
+    topology = json.dumps(doc).encode("utf-8")
+    sections.insert(0, (_TOPOLOGY_SECTION, topology))
+
+    # Lay out the TOC, then the payloads in TOC order.
+    toc_size = 0
+    for name, _ in sections:
+        toc_size += 2 + len(name.encode("utf-8")) + 16
+    pos = len(MAGIC) + 4 + toc_size
+
+    parts: list[bytes] = [MAGIC, struct.pack("<I", len(sections))]
+    for name, payload in sections:
+        name_b = name.encode("utf-8")
+        parts.append(struct.pack("<H", len(name_b)))
+        parts.append(name_b)
+        parts.append(struct.pack("<QQ", pos, len(payload)))
+        pos += len(payload)
+    for _, payload in sections:
+        parts.append(payload)
+
+    tmp = project_path.with_suffix(project_path.suffix + ".tmp")
+    tmp.write_bytes(b"".join(parts))
+    tmp.replace(project_path)
@@ -13,7 +13,14 @@ from typing import TYPE_CHECKING, Any, Callable, Iterator, Optional, Union, cast
 if TYPE_CHECKING:
     import numpy as np
 
-from minihost._core import AudioBuffer, Plugin, PluginChain, MidiFile
+from minihost._core import (
+    AudioBuffer,
+    AudioFileWriter,
+    BufferPool,
+    Plugin,
+    PluginChain,
+    MidiFile,
+)
 
 # Type alias for plugin or chain
 PluginOrChain = Union[Plugin, PluginChain]
@@ -172,17 +179,59 @@ def midi_file_to_events(
     else:
         mf = midi_file
 
-    tempo_map = _build_tempo_map(mf)
-    tpq = mf.ticks_per_quarter
-    events: list[tuple[int, int, int, int]] = []
-    for event in _collect_midi_events(mf):
-        seconds = _tick_to_seconds(event["tick"], tempo_map, tpq)
-        offset = _seconds_to_samples(seconds, sample_rate)
-        tup = _event_to_midi_tuple(event, offset)
-        if tup is not None:
-            events.append(tup)
-    events.sort(key=lambda e: e[0])
-    return events
+    # The conversion (tempo map, tick -> sample, filtering, sorting) runs
+    # natively; to_list() materializes the packed timeline as tuples.
+    return mf.sample_events(sample_rate).to_list()
+
+
+def _chase_events(
+    events: list[tuple[int, int, int, int]], start_sample: int
+) -> list[tuple[int, int, int, int]]:
+    """Collapse events before ``start_sample`` into a state-establishing set.
+
+    Sequencer-style locate chase: instead of replaying everything in
+    ``[0, start_sample)``, reduce it to the last program change, pitch
+    bend and per-controller CC value on each channel, plus note-ons
+    still sounding at the seek point (note-ons without a matching
+    note-off before ``start_sample``). The result is a list of
+    ``(0, status, data1, data2)`` tuples to deliver in one pre-roll
+    block; rendering can then start mid-timeline. ``events`` must be
+    sorted by sample offset (as :func:`midi_file_to_events` returns).
+    """
+    programs: dict[int, int] = {}
+    bends: dict[int, tuple[int, int]] = {}
+    controllers: dict[tuple[int, int], int] = {}
+    held: dict[tuple[int, int], int] = {}
+
+    for off, status, d1, d2 in events:
+        if off >= start_sample:
+            break
+        kind = status & 0xF0
+        channel = status & 0x0F
+        if kind == 0x90 and d2 > 0:
+            held[(channel, d1)] = d2
+        elif kind == 0x80 or (kind == 0x90 and d2 == 0):
+            held.pop((channel, d1), None)
+        elif kind == 0xB0:
+            controllers[(channel, d1)] = d2
+        elif kind == 0xC0:
+            programs[channel] = d1
+        elif kind == 0xE0:
+            bends[channel] = (d1, d2)
+
+    # Configuration before notes, so held notes sound through the chased
+    # program/controller state. Sorted for a deterministic order.
+    chase: list[tuple[int, int, int, int]] = []
+    for channel in sorted(programs):
+        chase.append((0, 0xC0 | channel, programs[channel], 0))
+    for (channel, controller) in sorted(controllers):
+        chase.append((0, 0xB0 | channel, controller, controllers[(channel, controller)]))
+    for channel in sorted(bends):
+        lsb, msb = bends[channel]
+        chase.append((0, 0xE0 | channel, lsb, msb))
+    for (channel, pitch) in sorted(held):
+        chase.append((0, 0x90 | channel, pitch, held[(channel, pitch)]))
+    return chase
 
 
 def _is_auto_tail(tail_seconds: object) -> bool:
@@ -300,6 +349,347 @@ def render_midi(
     return renderer.render_all(dtype=dtype, as_=as_)
 
 
+def render_preview(
+    plugin: PluginOrChain,
+    midi_file: Union[MidiFile, str],
+    start_seconds: float = 0.0,
+    end_seconds: Optional[float] = None,
+    block_size: int = 512,
+    decimate: int = 1,
+    progress_callback: Optional[Callable[[int, int], None]] = None,
+    progress_interval: float = 0.5,
+    as_: type | None = None,
+) -> "AudioBuffer | np.ndarray":
+    """Fast-forward render for auditioning -- not a mastering path.
+
+    Renders a window ``[start_seconds, end_seconds)`` of the MIDI
+    timeline as quickly as possible: the plugin's non-realtime flag is
+    set for the duration (offline hosts may trade latency for speed),
+    no tail is rendered past the window, pre-window MIDI state is
+    chased instead of replayed (see :class:`MidiRenderer`'s
+    ``start_seconds``), and the progress callback is throttled.
+    Spot-checking bar 140 of a ten-minute piece therefore costs
+    rendering bar 140, not bars 1-139 first.
+
+    Args:
+        plugin: Plugin or PluginChain instance to render through.
+        midi_file: MidiFile object or path to MIDI file.
+        start_seconds: Window start on the MIDI timeline.
+        end_seconds: Window end (exclusive). None renders to the end of
+            the MIDI content (no tail either way).
+        block_size: Audio block size in samples.
+        decimate: Keep every Nth output sample. Played back at the
+            original sample rate the preview runs N times faster --
+            a crude time-compressed audition with no anti-alias filter,
+            which is fine for "is the automation ramp where I put it"
+            checks. Values > 1 require numpy.
+        progress_callback: Optional ``(rendered_frames, total_frames)``
+            callable, invoked at most once per ``progress_interval``
+            seconds of rendered audio (plus once at the end) instead of
+            once per block.
+        progress_interval: Minimum rendered-audio time between progress
+            callbacks, in seconds.
+        as_: Container type for the returned audio, as in
+            :func:`render_midi`.
+
+    Returns:
+        An ``AudioBuffer`` or ``numpy.ndarray`` of shape
+        ``(channels, ceil(window_samples / decimate))``.
+    """
+    if decimate < 1:
+        raise ValueError("decimate must be >= 1")
+
+    renderer = MidiRenderer(
+        plugin,
+        midi_file,
+        block_size=block_size,
+        tail_seconds=0,
+        start_seconds=start_seconds,
+        end_seconds=end_seconds,
+    )
+
+    # Non-realtime hint for the duration of the preview, restored after
+    # (chains only expose a setter, so they restore to the offline
+    # default of False).
+    if isinstance(plugin, Plugin):
+        prev_non_realtime = plugin.non_realtime
+        plugin.non_realtime = True
+    else:
+        prev_non_realtime = False
+        plugin.set_non_realtime(True)
+
+    total = renderer.total_samples
+    interval = max(1, int(progress_interval * float(plugin.sample_rate)))
+    out = AudioBuffer(renderer.channels, total)
+    written = 0
+    next_report = interval
+    try:
+        while not renderer.is_finished:
+            block = renderer.render_block()
+            if block is None:
+                continue
+            n = block.frames
+            if written + n > total:
+                n = total - written
+                if n <= 0:
+                    break
+                block = cast(AudioBuffer, block[:, :n])
+            out[:, written : written + n] = block
+            written += n
+            if progress_callback is not None and written >= next_report:
+                progress_callback(min(written, total), total)
+                next_report = written + interval
+    finally:
+        if isinstance(plugin, Plugin):
+            plugin.non_realtime = prev_non_realtime
+        else:
+            plugin.set_non_realtime(prev_non_realtime)
+
+    if written < total:
+        out = cast(AudioBuffer, out[:, :written])  # trim
+    if progress_callback is not None:
+        progress_callback(written, written)
+
+    if decimate > 1:
+        try:
+            import numpy as np
+        except ImportError as e:
+            raise ImportError(
+                "render_preview(decimate > 1) requires numpy. Install "
+                "minihost with: 'pip install minihost[numpy]'."
+            ) from e
+        arr = np.ascontiguousarray(np.asarray(out)[:, ::decimate])
+        decimated = AudioBuffer(renderer.channels, arr.shape[1])
+        decimated[:, :] = arr
+        out = decimated
+
+    return _coerce_block(out, as_)
+
+
+def _partition_segments(
+    total_samples: int, workers: int, overlap_samples: int
+) -> list[tuple[int, int]]:
+    """Split ``[0, total_samples)`` into per-worker segments.
+
+    Returns a list of ``(start, end)`` half-open ranges covering the
+    timeline exactly once. The worker count is reduced until every
+    segment is at least ``2 * overlap_samples`` long, so each segment has
+    room for a warm-in pre-roll and a crossfade region that do not
+    overrun its neighbours; the result may therefore have fewer entries
+    than ``workers``. A single-entry result means "render sequentially".
+    """
+    if total_samples <= 0:
+        return [(0, max(0, total_samples))]
+    n = max(1, workers)
+    min_len = max(1, 2 * overlap_samples)
+    while n > 1 and total_samples // n < min_len:
+        n -= 1
+    seg_len = -(-total_samples // n)  # ceil division
+    segments = []
+    start = 0
+    while start < total_samples:
+        end = min(start + seg_len, total_samples)
+        segments.append((start, end))
+        start = end
+    return segments
+
+
+def render_midi_parallel(
+    plugin: Plugin,
+    midi_file: Union[MidiFile, str],
+    block_size: int = 512,
+    tail_seconds: Optional[float] = None,
+    workers: Optional[int] = None,
+    overlap_seconds: float = 1.0,
+    verify_tolerance: float = 1e-4,
+    on_mismatch: str = "fallback",
+    as_: type | None = None,
+) -> "AudioBuffer | np.ndarray":
+    """Render a MIDI file across several plugin instances in parallel.
+
+    For an instrument render the input is silence and the output is a
+    pure function of the MIDI timeline, so the timeline is partitionable:
+    each worker opens its own instance of the plugin (state cloned from
+    the template via get_state/set_state), warms in over an
+    ``overlap_seconds`` pre-roll before its segment, and renders its
+    segment plus ``overlap_seconds`` past the end. Adjacent segments thus
+    render the overlap region twice; the two versions are compared
+    sample-for-sample (the A/B check) and then crossfaded. Workers run as
+    threads -- process calls release the GIL, so the render scales with
+    cores.
+
+    The pre-roll cannot reproduce state older than itself (a note held
+    since long before the segment, a slow LFO), which is exactly what the
+    A/B check catches: divergent overlap regions mean the partition
+    assumption failed for this plugin/arrangement.
+
+    Args:
+        plugin: Template Plugin (not a chain) opened from a file path;
+            its current state is cloned into every worker instance.
+        midi_file: MidiFile object or path to MIDI file.
+        block_size: Audio block size in samples.
+        tail_seconds: Extra time after MIDI ends for tails. ``None`` uses
+            the plugin's reported tail like :class:`MidiRenderer`;
+            ``"auto"`` is not supported here (tail detection is
+            inherently sequential).
+        workers: Worker/segment count. Default ``os.cpu_count()``.
+            Reduced automatically when segments would be shorter than
+            twice the overlap.
+        overlap_seconds: Pre-roll and crossfade length per boundary.
+        verify_tolerance: Peak absolute difference allowed between the
+            two renders of an overlap region before the partition is
+            considered unsound.
+        on_mismatch: ``"fallback"`` (default) re-renders sequentially
+            when the A/B check fails, guaranteeing a correct result;
+            ``"raise"`` raises RuntimeError instead.
+        as_: Container type for the returned audio, as in
+            :func:`render_midi`.
+
+    Returns:
+        An ``AudioBuffer`` or ``numpy.ndarray`` of shape
+        ``(channels, total_samples)``, identical (within
+        ``verify_tolerance`` over crossfade regions) to
+        :func:`render_midi` output.
+    """
+    import os
+    from concurrent.futures import ThreadPoolExecutor
+
+    if on_mismatch not in ("fallback", "raise"):
+        raise ValueError("on_mismatch must be 'fallback' or 'raise'")
+    if _is_auto_tail(tail_seconds):
+        raise ValueError(
+            "tail_seconds='auto' is not supported by render_midi_parallel; "
+            "tail detection needs the sequential renderer"
+        )
+    if not isinstance(plugin, Plugin):
+        raise TypeError(
+            "render_midi_parallel requires a Plugin; chains carry "
+            "cross-plugin state that cannot be partitioned"
+        )
+    if not plugin.path:
+        raise ValueError(
+            "render_midi_parallel needs the plugin's file path to open "
+            "worker instances"
+        )
+
+    # The sequential renderer is the source of truth for the timeline,
+    # durations and latency policy; reuse it for the bookkeeping (and as
+    # the fallback path).
+    template = MidiRenderer(
+        plugin, midi_file, block_size=block_size, tail_seconds=tail_seconds
+    )
+    sample_rate = float(plugin.sample_rate)
+    total = template.total_samples
+    overlap = max(int(overlap_seconds * sample_rate), block_size)
+    segments = _partition_segments(
+        total, workers if workers is not None else (os.cpu_count() or 1), overlap
+    )
+
+    if len(segments) <= 1:
+        return template.render_all(as_=as_)
+
+    state = plugin.get_state()
+    path = plugin.path
+    timeline = template._timeline
+    in_channels = template._in_channels
+    out_channels = template._out_channels
+
+    def render_segment(index: int) -> AudioBuffer:
+        """Render segment `index` plus its trailing overlap extension."""
+        start, end = segments[index]
+        preroll = overlap if index > 0 else 0
+        extension = overlap if index < len(segments) - 1 else 0
+
+        worker = Plugin(
+            path, sample_rate=sample_rate, max_block_size=block_size
+        )
+        if state:
+            worker.set_state(state)
+        latency = max(0, int(worker.latency_samples))
+
+        kept = end + extension - start
+        out = AudioBuffer(out_channels, kept)
+        in_buf = AudioBuffer(in_channels, block_size)
+        out_buf = AudioBuffer(out_channels, block_size)
+
+        # Input range: warm-in pre-roll, the segment, the overlap
+        # extension, plus the plugin's pre-roll latency; the first
+        # preroll + latency output samples are discarded.
+        pos = start - preroll
+        stop = end + extension + latency
+        skip = preroll + latency
+        written = 0
+        while pos < stop:
+            n = min(block_size, stop - pos)
+            if n < block_size:
+                in_blk = AudioBuffer(in_channels, n)
+                out_blk = AudioBuffer(out_channels, n)
+            else:
+                in_buf.clear()
+                in_blk, out_blk = in_buf, out_buf
+            worker.process_midi_timeline(in_blk, out_blk, timeline, pos)
+            keep_from = max(0, skip - written)
+            if keep_from < n:
+                take = min(n - keep_from, kept - (written + keep_from - skip))
+                if take > 0:
+                    dest = written + keep_from - skip
+                    out[:, dest : dest + take] = cast(
+                        AudioBuffer, out_blk[:, keep_from : keep_from + take]
+                    )
+            written += n
+            pos += n
+        return out
+
+    with ThreadPoolExecutor(max_workers=len(segments)) as pool:
+        rendered = list(pool.map(render_segment, range(len(segments))))
+
+    # A/B check: each boundary's overlap was rendered by both neighbours
+    # (segment i's extension vs segment i+1's warmed-in head). Any
+    # divergence beyond tolerance means the partition assumption failed.
+    for i in range(len(segments) - 1):
+        seg_len = segments[i][1] - segments[i][0]
+        a = cast(AudioBuffer, rendered[i][:, seg_len : seg_len + overlap])
+        b = rendered[i + 1]
+        for ch in range(out_channels):
+            a.add_from(ch, 0, b, ch, 0, overlap, -1.0)
+        peak = a.magnitude()
+        if peak > verify_tolerance:
+            if on_mismatch == "raise":
+                raise RuntimeError(
+                    f"parallel render A/B check failed at boundary "
+                    f"{segments[i][1]} (peak diff {peak:.3g} > "
+                    f"{verify_tolerance:.3g}); the plugin carries state "
+                    f"across segments -- use render_midi"
+                )
+            template.reset()
+            return template.render_all(as_=as_)
+
+    # Assemble: plain copy of each segment body, linear crossfade over
+    # each boundary's overlap region. The crossfade regions are skipped
+    # by the body copies, so they are still zero and two ramped adds
+    # build the fade in place.
+    result = AudioBuffer(out_channels, total)
+    for i, (start, end) in enumerate(segments):
+        body_from = overlap if i > 0 else 0
+        result[:, start + body_from : end] = cast(
+            AudioBuffer, rendered[i][:, body_from : end - start]
+        )
+    for i in range(len(segments) - 1):
+        boundary = segments[i][1]
+        seg_len = boundary - segments[i][0]
+        for ch in range(out_channels):
+            # Outgoing segment's extension ramps 1 -> 0, incoming
+            # segment's warmed-in head ramps 0 -> 1.
+            result.add_from_with_ramp(
+                ch, boundary, rendered[i], ch, seg_len, overlap, 1.0, 0.0
+            )
+            result.add_from_with_ramp(
+                ch, boundary, rendered[i + 1], ch, 0, overlap, 0.0, 1.0
+            )
+
+    return _coerce_block(result, as_)
+
+
 def render_midi_to_file(
     plugin: PluginOrChain,
     midi_file: Union[MidiFile, str],
@@ -325,7 +715,10 @@ def render_midi_to_file(
         tail_threshold: Peak amplitude threshold for auto-tail detection (linear).
         max_tail_seconds: Maximum tail duration for auto mode (safety cap).
         normalize: If not None, peak-normalize the rendered audio to this
-            target in dBFS (0.0 = full scale).
+            target in dBFS (0.0 = full scale). Normalization needs the
+            whole render's peak before any sample is written, so this
+            path buffers the full output in memory; leave it None for
+            bounded-memory streaming.
         progress_callback: Optional callable ``(rendered_frames,
             total_frames)`` invoked once per block.
 
@@ -337,15 +730,9 @@ def render_midi_to_file(
         >>> samples = minihost.render_midi_to_file(plugin, "song.mid", "output.wav")
         >>> print(f"Wrote {samples} samples")
     """
-    from minihost.audio_io import write_audio
-
     if bit_depth not in (16, 24, 32):
         raise ValueError("bit_depth must be 16, 24, or 32")
 
-    # Use MidiRenderer directly so we can pre-allocate the output AudioBuffer
-    # against its known total_samples upper bound. AudioBuffer slice
-    # assignment (which accepts AudioBuffer sources via DLPack) replaces the
-    # previous numpy-view approach and removes numpy from this code path.
     renderer = MidiRenderer(
         plugin,
         midi_file,
@@ -358,42 +745,62 @@ def render_midi_to_file(
     out_channels = renderer.channels
     total = renderer.total_samples
 
-    if total == 0:
-        write_audio(
-            output_path, AudioBuffer(out_channels, 0), sample_rate, bit_depth=bit_depth
-        )
-        return 0
-
-    audio = AudioBuffer(out_channels, total)
-    written = 0
-    while not renderer.is_finished:
-        block = renderer.render_block()
-        if block is None:
-            continue
-        n = block.frames
-        # Defensive: never write past the pre-allocated extent.
-        if written + n > total:
-            n = total - written
-            if n <= 0:
-                break
-            block = cast(AudioBuffer, block[:, :n])
-        audio[:, written : written + n] = block
-        written += n
-        if progress_callback is not None:
-            progress_callback(min(written, total), total)
-
-    if written < total:
-        audio = cast(AudioBuffer, audio[:, :written])  # trim
-
-    if progress_callback is not None:
-        progress_callback(audio.frames, audio.frames)
-
     if normalize is not None:
+        # Peak normalization needs the full render's peak before any
+        # sample is written, so this path pre-allocates the whole output
+        # and encodes in one shot at the end.
+        from minihost.audio_io import write_audio
         from minihost.process import _normalize_peak
 
+        audio = AudioBuffer(out_channels, total)
+        written = 0
+        while not renderer.is_finished:
+            block = renderer.render_block()
+            if block is None:
+                continue
+            n = block.frames
+            if written + n > total:
+                n = total - written
+                if n <= 0:
+                    break
+                block = cast(AudioBuffer, block[:, :n])
+            audio[:, written : written + n] = block
+            written += n
+            if progress_callback is not None:
+                progress_callback(min(written, total), total)
+        if written < total:
+            audio = cast(AudioBuffer, audio[:, :written])  # trim
+        if progress_callback is not None:
+            progress_callback(audio.frames, audio.frames)
         _normalize_peak(audio, float(normalize))
+        write_audio(output_path, audio, sample_rate, bit_depth=bit_depth)
+        return written
+
+    # Streaming path: each rendered block goes straight to the encoder,
+    # which encodes on a background thread and bounds its queue, so peak
+    # memory stays at a few blocks regardless of duration. render_block
+    # already trims the latency-compensation pre-roll on the fly.
+    with AudioFileWriter(
+        output_path, out_channels, sample_rate, bit_depth=bit_depth
+    ) as writer:
+        while not renderer.is_finished:
+            block = renderer.render_block()
+            if block is None:
+                continue
+            n = block.frames
+            # Defensive: never write past the reported total extent.
+            if writer.frames_written + n > total:
+                n = total - writer.frames_written
+                if n <= 0:
+                    break
+                block = cast(AudioBuffer, block[:, :n])
+            writer.write(block)
+            if progress_callback is not None:
+                progress_callback(min(writer.frames_written, total), total)
+        written = writer.frames_written
 
-    write_audio(output_path, audio, sample_rate, bit_depth=bit_depth)
+    if progress_callback is not None:
+        progress_callback(written, written)
     return written
 
 
@@ -422,6 +829,9 @@ class MidiRenderer:
         tail_seconds: Optional[Union[float, str]] = None,
         tail_threshold: float = _AUTO_TAIL_THRESHOLD,
         max_tail_seconds: float = _AUTO_TAIL_MAX_SECONDS,
+        start_seconds: float = 0.0,
+        end_seconds: Optional[float] = None,
+        buffer_pool: Optional[BufferPool] = None,
     ):
         """Initialize renderer.
 
@@ -433,6 +843,24 @@ class MidiRenderer:
                          "auto" = detect tail by monitoring output level.
             tail_threshold: Peak amplitude threshold for auto-tail detection.
             max_tail_seconds: Maximum tail duration for auto mode.
+            start_seconds: Render only from this timeline position. The
+                renderer seeks the native event timeline to the start
+                sample and chases pre-start MIDI state (held notes, last
+                CC / program change / pitch bend per channel) through
+                one discarded silent block, so spot-checking bar 140
+                does not replay bars 1-139. Plugin-internal state
+                (reverb tails, compressor envelopes) is NOT reproduced
+                -- this is a preview/audition facility, not a
+                bit-identical excerpt of a full render.
+            end_seconds: Stop rendering at this timeline position
+                (exclusive). None renders to the end including the
+                tail. The range end is clamped to the total extent.
+            buffer_pool: Optional :class:`BufferPool` of shape
+                (channels, block_size) that full-size output blocks are
+                drawn from instead of being copied into fresh
+                AudioBuffers -- release() each returned block back to
+                the pool when done with it. Must match the renderer's
+                output channel count and block size.
         """
         self.plugin = plugin
         self.block_size = block_size
@@ -450,7 +878,6 @@ class MidiRenderer:
 
         # Get parameters
         self.sample_rate = plugin.sample_rate
-        self._tpq = self._midi_file.ticks_per_quarter
         # Input is silence for a MIDI-driven render, so provisioning a
         # generous stereo-minimum input buffer is harmless. Output, however,
         # should match the plugin's real channel count: a genuine mono plugin
@@ -471,27 +898,51 @@ class MidiRenderer:
             effective_tail = float(tail_seconds)
         self._tail_seconds = effective_tail
 
-        # Build tempo map and collect events
-        self._tempo_map = _build_tempo_map(self._midi_file)
-        all_events = _collect_midi_events(self._midi_file)
-
-        # Find total duration
-        if all_events:
-            last_tick = max(e["tick"] for e in all_events)
-            self._midi_duration = _tick_to_seconds(
-                last_tick, self._tempo_map, self._tpq
-            )
-        else:
-            self._midi_duration = 0.0
-
-        self._midi_end_samples = _seconds_to_samples(
-            self._midi_duration, self.sample_rate
-        )
+        # Packed native event timeline: the tempo map and tick -> sample
+        # conversion happen once in C++ (MidiFile caches the tempo map),
+        # and render_block binary-searches into the timeline natively
+        # instead of re-slicing a Python list of event dicts per block.
+        self._timeline = self._midi_file.sample_events(float(self.sample_rate))
+        # Bucket index keyed to our block size: each block's event
+        # lookup becomes one array fetch instead of a binary search
+        # over the whole timeline (noticeable with 100k+ events at
+        # small block sizes).
+        self._timeline.build_block_index(self.block_size)
+        self._midi_duration = self._timeline.max_seconds
+        self._midi_end_samples = self._timeline.max_sample
         self._total_duration = self._midi_duration + self._tail_seconds
         self._total_samples = _seconds_to_samples(
             self._total_duration, self.sample_rate
         )
 
+        # Optional render range [start_seconds, end_seconds). Applied
+        # after the full extent is known: _total_samples becomes the
+        # range length, _start_sample offsets every timeline lookup, and
+        # pre-start MIDI state is chased in one pre-roll block (see
+        # _run_chase). The rest of the renderer is range-agnostic --
+        # _current_sample counts samples rendered within the range.
+        start = _seconds_to_samples(
+            max(0.0, float(start_seconds)), self.sample_rate
+        )
+        if end_seconds is None:
+            end = self._total_samples
+        else:
+            end = min(
+                self._total_samples,
+                _seconds_to_samples(float(end_seconds), self.sample_rate),
+            )
+        if (start > 0 or end_seconds is not None) and start >= end:
+            raise ValueError(
+                f"empty render range: start {start / self.sample_rate:g}s "
+                f"is not before end {end / self.sample_rate:g}s "
+                f"(total extent {self._total_duration:g}s)"
+            )
+        self._start_sample = start
+        self._total_samples = end - start
+        self._chase = (
+            _chase_events(self._timeline.to_list(), start) if start > 0 else []
+        )
+
         # Latency compensation: a plugin reporting N samples of latency emits
         # the response to a MIDI event at input sample T at output sample T+N.
         # To time-align the rendered audio with MIDI tempo positions, we
@@ -511,14 +962,6 @@ class MidiRenderer:
         self._render_samples = self._total_samples + self._latency
         self._skip_remaining = self._latency
 
-        # Convert events to sample positions
-        self._events_with_samples = []
-        for event in all_events:
-            tick = event["tick"]
-            seconds = _tick_to_seconds(tick, self._tempo_map, self._tpq)
-            sample_pos = _seconds_to_samples(seconds, self.sample_rate)
-            self._events_with_samples.append((sample_pos, event))
-
         # Create buffers
         # Persistent block-sized scratch buffers. AudioBuffers are
         # zero-initialized on construction; clear() is invoked per-block
@@ -527,10 +970,24 @@ class MidiRenderer:
         self._input_buffer = AudioBuffer(self._in_channels, block_size)
         self._output_buffer = AudioBuffer(self._out_channels, block_size)
 
+        # Optional recycling pool for the blocks handed back to the
+        # caller (full-size blocks only; partial/trimmed blocks are
+        # fresh AudioBuffers regardless).
+        if buffer_pool is not None and (
+            buffer_pool.channels != self._out_channels
+            or buffer_pool.frames != block_size
+        ):
+            raise ValueError(
+                "buffer_pool shape "
+                f"({buffer_pool.channels}, {buffer_pool.frames}) does not "
+                f"match renderer output ({self._out_channels}, {block_size})"
+            )
+        self._buffer_pool = buffer_pool
+
         # State
         self._current_sample = 0
-        self._event_idx = 0
         self._auto_tail_finished = False
+        self._run_chase()
 
     @property
     def duration_seconds(self) -> float:
@@ -549,13 +1006,18 @@ class MidiRenderer:
 
     @property
     def current_sample(self) -> int:
-        """Current sample position."""
-        return self._current_sample
+        """Current absolute timeline position in samples.
+
+        Includes the ``start_seconds`` offset for ranged renders, so the
+        value always points at the same musical position as the MIDI
+        file.
+        """
+        return self._start_sample + self._current_sample
 
     @property
     def current_time(self) -> float:
-        """Current time in seconds."""
-        return self._current_sample / self.sample_rate
+        """Current absolute timeline position in seconds."""
+        return (self._start_sample + self._current_sample) / self.sample_rate
 
     @property
     def progress(self) -> float:
@@ -591,11 +1053,25 @@ class MidiRenderer:
     def reset(self):
         """Reset renderer to beginning."""
         self._current_sample = 0
-        self._event_idx = 0
         self._consecutive_silent = 0
         self._auto_tail_finished = False
         self._skip_remaining = self._latency
         self.plugin.reset()
+        self._run_chase()
+
+    def _run_chase(self):
+        """Deliver chased pre-start MIDI state in one discarded block.
+
+        No-op for renders from the beginning. The block's input is
+        silence and its output is thrown away; it exists only so the
+        plugin registers the program/CC/pitch-bend state and held notes
+        in effect at the seek point before the first range block.
+        """
+        if not self._chase:
+            return
+        self._input_buffer.clear()
+        scratch = AudioBuffer(self._out_channels, self.block_size)
+        self.plugin.process_midi(self._input_buffer, scratch, self._chase)
 
     def render_block(self) -> Optional[AudioBuffer]:
         """Render next block of audio.
@@ -617,52 +1093,58 @@ class MidiRenderer:
         remaining = self._render_samples - self._current_sample
         this_block_size = min(self.block_size, remaining)
 
-        # Collect MIDI events for this block
-        block_events = []
-        while self._event_idx < len(self._events_with_samples):
-            sample_pos, event = self._events_with_samples[self._event_idx]
-            if sample_pos >= self._current_sample + this_block_size:
-                break
-
-            offset = sample_pos - self._current_sample
-            offset = max(0, min(offset, this_block_size - 1))
-
-            midi_tuple = _event_to_midi_tuple(event, offset)
-            if midi_tuple:
-                block_events.append(midi_tuple)
-
-            self._event_idx += 1
-
         # Clear the persistent input buffer (zero silent input for this block).
         self._input_buffer.clear()
 
+        # This block's MIDI events are binary-searched out of the native
+        # timeline inside process_midi_timeline -- no per-block Python
+        # event bookkeeping. Timeline positions are absolute; the range
+        # start offsets the range-relative render cursor.
+        timeline_pos = self._start_sample + self._current_sample
         if this_block_size < self.block_size:
             # Last (partial) block: allocate fresh AudioBuffers of the
-            # correct size. Plugin.process_midi consumes them via DLPack.
+            # correct size. The plugin consumes them via DLPack.
             in_slice = AudioBuffer(self._in_channels, this_block_size)
             out_slice = AudioBuffer(self._out_channels, this_block_size)
-            self.plugin.process_midi(in_slice, out_slice, block_events)
+            self.plugin.process_midi_timeline(
+                in_slice, out_slice, self._timeline, timeline_pos
+            )
             result = out_slice
         else:
             # Full block: reuse the persistent buffers.
-            self.plugin.process_midi(
-                self._input_buffer, self._output_buffer, block_events
+            self.plugin.process_midi_timeline(
+                self._input_buffer,
+                self._output_buffer,
+                self._timeline,
+                timeline_pos,
             )
-            # Copy the output before the next iteration overwrites it.
-            result = self._output_buffer.copy()
+            # Copy the output before the next iteration overwrites it --
+            # into a recycled pool buffer when the caller provided one.
+            if self._buffer_pool is not None:
+                result = cast(AudioBuffer, self._buffer_pool.acquire())
+                result[:, :] = self._output_buffer
+            else:
+                result = self._output_buffer.copy()
 
         self._current_sample += this_block_size
 
         # Latency compensation: discard the first _latency samples of output.
         # If this whole block falls inside the skip region, return None and
         # let the caller loop again. Otherwise trim the leading skip portion.
+        # Trimmed/discarded full-size blocks go back to the pool here; only
+        # full-size untrimmed blocks ever reach the caller from the pool.
         if self._skip_remaining > 0:
             n = result.frames
             if n <= self._skip_remaining:
                 self._skip_remaining -= n
+                if self._buffer_pool is not None and n == self.block_size:
+                    self._buffer_pool.release(result)
                 return None
             # AudioBuffer slice (copy) -- always contiguous, always c_contig.
-            result = cast(AudioBuffer, result[:, self._skip_remaining :])
+            trimmed = cast(AudioBuffer, result[:, self._skip_remaining :])
+            if self._buffer_pool is not None and result.frames == self.block_size:
+                self._buffer_pool.release(result)
+            result = trimmed
             self._skip_remaining = 0
 
         # Auto-tail detection runs against the post-skip (user-visible)
@@ -671,7 +1153,8 @@ class MidiRenderer:
         # user-visible timeline. magnitude() is JUCE-backed (no numpy).
         if (
             self._auto_tail
-            and self._current_sample > self._midi_end_samples + self._latency
+            and self._start_sample + self._current_sample
+            > self._midi_end_samples + self._latency
         ):
             peak = result.magnitude()
             if peak < self._tail_threshold:
@@ -714,13 +1197,23 @@ class MidiRenderer:
             if block is None:
                 continue
             n = block.frames
+            pooled_block = (
+                block
+                if self._buffer_pool is not None
+                and block.frames == self.block_size
+                else None
+            )
             if written + n > remaining:
                 n = remaining - written
                 if n <= 0:
+                    if pooled_block is not None:
+                        self._buffer_pool.release(pooled_block)
                     break
                 block = cast(AudioBuffer, block[:, :n])
             out[:, written : written + n] = block
             written += n
+            if pooled_block is not None:
+                self._buffer_pool.release(pooled_block)
 
         if written < remaining:
             out = cast(AudioBuffer, out[:, :written])  # trim
@@ -34,6 +34,32 @@ class VstPreset:
         self.controller_state = controller_state
 
 
+class VstPresetInfo:
+    """Metadata of a .vstpreset file, read without loading its state chunks.
+
+    Attributes:
+        path: Path to the preset file, as a string.
+        class_id: The processor component's FUID (32-char ASCII string).
+        file_size: Total file size in bytes.
+        component_size: Size of the 'Comp' chunk in bytes, or None if absent.
+        controller_size: Size of the 'Cont' chunk in bytes, or None if absent.
+    """
+
+    def __init__(
+        self,
+        path: str,
+        class_id: str,
+        file_size: int,
+        component_size: int | None,
+        controller_size: int | None,
+    ):
+        self.path = path
+        self.class_id = class_id
+        self.file_size = file_size
+        self.component_size = component_size
+        self.controller_size = controller_size
+
+
 def read_vstpreset(path: str | Path) -> VstPreset:
     """Read and parse a .vstpreset file.
 
@@ -61,6 +87,88 @@ def read_vstpreset(path: str | Path) -> VstPreset:
     return VstPreset(class_id=class_id, component_state=comp, controller_state=cont)
 
 
+def read_vstpreset_info(path: str | Path) -> VstPresetInfo:
+    """Read a .vstpreset file's metadata without loading its state chunks.
+
+    Only the 48-byte header and the chunk list are read (the file is mapped
+    and the state chunks are never touched), so this is much cheaper than
+    :func:`read_vstpreset` when only the class ID or chunk sizes are needed
+    — e.g. when indexing a preset library.
+
+    Args:
+        path: Path to the .vstpreset file.
+
+    Returns:
+        VstPresetInfo with the class_id, file size and chunk sizes.
+
+    Raises:
+        FileNotFoundError: If the file does not exist.
+        ValueError: If the file is not a valid .vstpreset.
+    """
+    from . import _core
+
+    path = Path(path)
+    if not path.exists():
+        raise FileNotFoundError(f"Preset file not found: {path}")
+
+    try:
+        class_id, file_size, comp_size, cont_size = _core.vstpreset_read_info(
+            str(path)
+        )
+    except RuntimeError as e:
+        raise ValueError(str(e)) from e
+
+    return VstPresetInfo(
+        path=str(path),
+        class_id=class_id,
+        file_size=file_size,
+        component_size=None if comp_size < 0 else comp_size,
+        controller_size=None if cont_size < 0 else cont_size,
+    )
+
+
+def index_vstpreset_dir(directory: str | Path) -> list[VstPresetInfo]:
+    """Index every .vstpreset file directly in a directory.
+
+    The scan is non-recursive, matches the ``.vstpreset`` suffix
+    case-insensitively, and returns entries sorted by file name. Only header
+    and chunk-list metadata is read (with batched readahead on POSIX), so
+    indexing large preset libraries stays fast. Files that fail to parse as
+    .vstpreset are silently skipped.
+
+    Args:
+        directory: Path to the directory to scan.
+
+    Returns:
+        A list of VstPresetInfo, one per valid preset file.
+
+    Raises:
+        FileNotFoundError: If the directory does not exist.
+        ValueError: If the directory cannot be scanned.
+    """
+    from . import _core
+
+    directory = Path(directory)
+    if not directory.is_dir():
+        raise FileNotFoundError(f"Preset directory not found: {directory}")
+
+    try:
+        rows = _core.vstpreset_index_dir(str(directory))
+    except RuntimeError as e:
+        raise ValueError(str(e)) from e
+
+    return [
+        VstPresetInfo(
+            path=path,
+            class_id=class_id,
+            file_size=file_size,
+            component_size=None if comp_size < 0 else comp_size,
+            controller_size=None if cont_size < 0 else cont_size,
+        )
+        for path, class_id, file_size, comp_size, cont_size in rows
+    ]
+
+
 def load_vstpreset(path: str | Path, plugin) -> None:
     """Load a .vstpreset file into a plugin.
 
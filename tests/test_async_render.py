@@ -0,0 +1,144 @@
+"""Tests for the asyncio entry points (aopen / aprocess_audio /
+aprocess_audio_stream).
+
+These exercise the event-loop mechanics with monkeypatched stubs -- no real
+plugin or render needed -- and use plain ``asyncio.run`` so no pytest-asyncio
+dependency is introduced. The real render path underneath is the same
+``process_audio`` / ``process_audio_stream`` covered elsewhere.
+"""
+
+import asyncio
+import threading
+
+import pytest
+
+import minihost
+
+
+class _StubPlugin:
+    def __init__(self, path, **kwargs):
+        self.path = path
+        self.kwargs = kwargs
+
+
+def test_aopen_resolves_to_plugin(monkeypatch):
+    monkeypatch.setattr("minihost._core.Plugin", _StubPlugin)
+
+    async def main():
+        return await minihost.aopen("whatever.vst3", sample_rate=44100.0)
+
+    plugin = asyncio.run(main())
+    assert isinstance(plugin, _StubPlugin)
+    assert plugin.path == "whatever.vst3"
+    assert plugin.kwargs["sample_rate"] == 44100.0
+
+
+def test_aopen_propagates_load_errors(monkeypatch):
+    class _Raising:
+        def __init__(self, path, **kwargs):
+            raise ValueError(f"cannot load {path}")
+
+    monkeypatch.setattr("minihost._core.Plugin", _Raising)
+
+    async def main():
+        await minihost.aopen("bad.vst3")
+
+    with pytest.raises(ValueError, match="cannot load bad.vst3"):
+        asyncio.run(main())
+
+
+def test_aprocess_audio_runs_off_loop_and_forwards_kwargs(monkeypatch):
+    seen = {}
+
+    def fake_process_audio(plugin_or_chain, audio, **kwargs):
+        seen["thread"] = threading.get_ident()
+        seen["plugin"] = plugin_or_chain
+        seen["kwargs"] = kwargs
+        return "rendered"
+
+    monkeypatch.setattr("minihost.process.process_audio", fake_process_audio)
+
+    async def main():
+        return await minihost.aprocess_audio("p", "a", tail_seconds=2.0)
+
+    assert asyncio.run(main()) == "rendered"
+    assert seen["plugin"] == "p"
+    assert seen["kwargs"]["tail_seconds"] == 2.0
+    assert seen["thread"] != threading.get_ident()  # ran on the pool
+
+
+def test_aprocess_audio_progress_fires_on_event_loop(monkeypatch):
+    def fake_process_audio(plugin_or_chain, audio, progress_callback=None, **kw):
+        # Simulate the per-block callback from a worker thread.
+        progress_callback(256, 512)
+        progress_callback(512, 512)
+        return "rendered"
+
+    monkeypatch.setattr("minihost.process.process_audio", fake_process_audio)
+    events = []
+    loop_thread = {}
+
+    async def main():
+        loop_thread["ident"] = threading.get_ident()
+
+        def on_progress(done, total):
+            events.append((done, total, threading.get_ident()))
+
+        result = await minihost.aprocess_audio("p", "a", progress_callback=on_progress)
+        # call_soon_threadsafe callbacks drain before the run finishes.
+        await asyncio.sleep(0)
+        return result
+
+    assert asyncio.run(main()) == "rendered"
+    assert [(d, t) for d, t, _ in events] == [(256, 512), (512, 512)]
+    # Cooperative progress: every event fired on the event-loop thread.
+    assert all(ident == loop_thread["ident"] for _, _, ident in events)
+
+
+def test_aprocess_audio_stream_yields_all_blocks(monkeypatch):
+    def fake_stream(plugin_or_chain, audio, **kwargs):
+        yield from ["b0", "b1", "b2"]
+
+    monkeypatch.setattr("minihost.process.process_audio_stream", fake_stream)
+
+    async def main():
+        blocks = []
+        async for block in minihost.aprocess_audio_stream("p", "a"):
+            blocks.append(block)
+        return blocks
+
+    assert asyncio.run(main()) == ["b0", "b1", "b2"]
+
+
+def test_aprocess_audio_stream_closes_generator_on_break(monkeypatch):
+    closed = {"value": False}
+
+    def fake_stream(plugin_or_chain, audio, **kwargs):
+        try:
+            yield from ["b0", "b1", "b2"]
+        finally:
+            closed["value"] = True
+
+    monkeypatch.setattr("minihost.process.process_audio_stream", fake_stream)
+
+    async def main():
+        async for block in minihost.aprocess_audio_stream("p", "a"):
+            break  # abandon mid-stream
+
+    asyncio.run(main())
+    assert closed["value"]
+
+
+def test_aprocess_audio_stream_propagates_render_errors(monkeypatch):
+    def fake_stream(plugin_or_chain, audio, **kwargs):
+        yield "b0"
+        raise RuntimeError("render blew up")
+
+    monkeypatch.setattr("minihost.process.process_audio_stream", fake_stream)
+
+    async def main():
+        async for _ in minihost.aprocess_audio_stream("p", "a"):
+            pass
+
+    with pytest.raises(RuntimeError, match="render blew up"):
+        asyncio.run(main())
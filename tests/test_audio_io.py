@@ -252,3 +252,282 @@ class TestResample:
         down = resample(up, 48000, 44100)
         # Allow small rounding differences
         assert abs(down.shape[1] - 44100) <= 2
+
+    def test_parallel_matches_serial(self):
+        """num_threads > 1 splits channels across workers; output is identical."""
+        data = np.random.randn(8, 44100).astype(np.float32) * 0.3
+        serial = resample(data, 44100, 48000)
+        parallel = resample(data, 44100, 48000, num_threads=4)
+        np.testing.assert_array_equal(parallel, serial)
+
+    def test_quality_presets(self):
+        """All presets convert; length is preset-independent."""
+        data = np.random.randn(1, 44100).astype(np.float32) * 0.3
+        outs = [resample(data, 44100, 48000, quality=q) for q in (0, 1, 2)]
+        assert all(o.shape == outs[0].shape for o in outs)
+        with pytest.raises(ValueError, match="quality must be"):
+            resample(data, 44100, 48000, quality=9)
+
+
+class TestAudioFileReader:
+    """Streaming decode via minihost.AudioFileReader."""
+
+    def test_block_reads_reconstruct_whole_file(self, tmp_path):
+        import minihost
+
+        rng = np.random.default_rng(5)
+        data = (rng.standard_normal((2, 10000)) * 0.5).astype(np.float32)
+        path = tmp_path / "stream.wav"
+        write_audio(str(path), data, 48000, bit_depth=32)
+
+        whole, sr = read_audio(str(path))
+        blocks = []
+        with minihost.AudioFileReader(str(path)) as reader:
+            assert reader.channels == 2
+            assert reader.sample_rate == 48000
+            assert reader.frames == 10000
+            buf = minihost.AudioBuffer(reader.channels, 4096)
+            while True:
+                got = reader.read_into(buf)
+                if got == 0:
+                    break
+                blocks.append(np.asarray(buf)[:, :got].copy())
+        streamed = np.concatenate(blocks, axis=1)
+        np.testing.assert_array_equal(streamed, whole)
+
+    def test_seek_and_closed_reader_raises(self, tmp_path):
+        import minihost
+
+        data = np.tile(
+            np.arange(100, dtype=np.float32)[np.newaxis, :] / 100.0, (1, 1)
+        )
+        path = tmp_path / "seek.wav"
+        write_audio(str(path), data, 48000, bit_depth=32)
+
+        reader = minihost.AudioFileReader(str(path))
+        reader.seek(50)
+        buf = minihost.AudioBuffer(1, 10)
+        assert reader.read_into(buf) == 10
+        np.testing.assert_allclose(
+            np.asarray(buf)[0], np.arange(50, 60, dtype=np.float32) / 100.0
+        )
+        reader.close()
+        reader.close()  # idempotent
+        with pytest.raises(RuntimeError):
+            reader.read_into(buf)
+
+    def test_open_nonexistent_raises(self):
+        import minihost
+
+        with pytest.raises(RuntimeError):
+            minihost.AudioFileReader("/nonexistent/file.wav")
+
+
+class TestCaptureModeWriter:
+    """Crash-safe WAV capture mode (AudioFileWriter flush_interval)."""
+
+    def test_capture_round_trip(self, tmp_path):
+        import minihost
+
+        rng = np.random.default_rng(7)
+        data = rng.uniform(-0.5, 0.5, size=(2, 12000)).astype(np.float32)
+        path = tmp_path / "capture.wav"
+
+        with minihost.AudioFileWriter(
+            str(path), 2, 48000, bit_depth=32, flush_interval=0.05
+        ) as writer:
+            for start in range(0, 12000, 1000):
+                writer.write(np.ascontiguousarray(data[:, start : start + 1000]))
+
+        result, sr = read_audio(path)
+        assert sr == 48000
+        np.testing.assert_array_equal(result, data)
+
+    def test_capture_header_covers_flushed_audio_before_close(self, tmp_path):
+        import shutil
+        import time
+
+        import minihost
+
+        data = np.zeros((1, 48000), dtype=np.float32)
+        data[0] = np.sin(np.linspace(0, 200 * np.pi, 48000)).astype(np.float32) * 0.25
+        path = tmp_path / "rig.wav"
+
+        writer = minihost.AudioFileWriter(
+            str(path), 1, 48000, bit_depth=16, flush_interval=0.05
+        )
+        try:
+            writer.write(data)
+            # The encode thread drains asynchronously; give it a moment,
+            # then snapshot the file as a crash would leave it.
+            deadline = time.monotonic() + 5.0
+            while writer.frames_written < 48000 and time.monotonic() < deadline:
+                time.sleep(0.01)
+            time.sleep(0.2)
+            snapshot = tmp_path / "crashed.wav"
+            shutil.copy(str(path), str(snapshot))
+
+            # The un-finalized snapshot is a readable WAV covering at
+            # least everything up to the last completed flush interval.
+            result, sr = read_audio(snapshot)
+            assert sr == 48000
+            assert result.shape[1] >= 48000 - 2400
+            np.testing.assert_array_equal(result, data[:, : result.shape[1]])
+        finally:
+            writer.close()
+
+    def test_capture_rejects_flac(self, tmp_path):
+        import minihost
+
+        with pytest.raises(RuntimeError, match="WAV only"):
+            minihost.AudioFileWriter(
+                str(tmp_path / "x.flac"), 2, 48000, flush_interval=1.0
+            )
+
+
+class TestUnbufferedWriter:
+    """Direct-I/O WAV writing (AudioFileWriter unbuffered=True)."""
+
+    def test_unbuffered_round_trip(self, tmp_path):
+        import minihost
+
+        rng = np.random.default_rng(11)
+        data = rng.uniform(-0.5, 0.5, size=(2, 48000)).astype(np.float32)
+        path = tmp_path / "direct.wav"
+
+        with minihost.AudioFileWriter(
+            str(path), 2, 48000, bit_depth=32, unbuffered=True
+        ) as writer:
+            for start in range(0, 48000, 4099):
+                writer.write(np.ascontiguousarray(data[:, start : start + 4099]))
+
+        result, sr = read_audio(path)
+        assert sr == 48000
+        np.testing.assert_array_equal(result, data)
+
+    def test_unbuffered_excludes_flush_interval(self, tmp_path):
+        import minihost
+
+        with pytest.raises(RuntimeError, match="mutually exclusive"):
+            minihost.AudioFileWriter(
+                str(tmp_path / "x.wav"),
+                2,
+                48000,
+                flush_interval=1.0,
+                unbuffered=True,
+            )
+
+
+class TestDecodedAudioCache:
+    """Opt-in decoded-audio cache behind read_audio."""
+
+    def test_cache_hit_serves_identical_audio(self, tmp_path):
+        import minihost
+
+        data = np.linspace(-0.5, 0.5, 4800, dtype=np.float32)[None, :]
+        path = tmp_path / "stem.wav"
+        write_audio(path, data, 48000, bit_depth=32)
+
+        minihost.audio_cache_set_budget(8 * 1024 * 1024)
+        try:
+            before = minihost.audio_cache_stats()
+            first, sr1 = read_audio(path)
+            second, sr2 = read_audio(path)
+            after = minihost.audio_cache_stats()
+
+            assert (sr1, sr2) == (48000, 48000)
+            np.testing.assert_array_equal(np.asarray(first), np.asarray(second))
+            assert after["hits"] >= before["hits"] + 1
+            assert after["entries"] >= 1
+
+            # Served copies are independent: mutating one read must not
+            # leak into the next.
+            np.asarray(first)[:] = 0.0
+            third, _ = read_audio(path)
+            np.testing.assert_array_equal(np.asarray(third), np.asarray(second))
+        finally:
+            minihost.audio_cache_set_budget(0)
+
+    def test_cache_invalidates_on_file_change(self, tmp_path):
+        import os
+
+        import minihost
+
+        path = tmp_path / "changing.wav"
+        write_audio(path, np.full((1, 100), 0.25, dtype=np.float32), 48000, bit_depth=32)
+
+        minihost.audio_cache_set_budget(8 * 1024 * 1024)
+        try:
+            first, _ = read_audio(path)
+            write_audio(path, np.full((1, 100), -0.25, dtype=np.float32), 48000, bit_depth=32)
+            # Force a distinct mtime even on coarse-resolution filesystems.
+            st = path.stat()
+            os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns + 1_000_000_000))
+
+            second, _ = read_audio(path)
+            assert np.asarray(second)[0, 0] == pytest.approx(-0.25)
+        finally:
+            minihost.audio_cache_set_budget(0)
+
+    def test_cache_disabled_by_default(self, tmp_path):
+        import minihost
+
+        path = tmp_path / "plain.wav"
+        write_audio(path, np.zeros((1, 100), dtype=np.float32), 48000)
+        before = minihost.audio_cache_stats()["entries"]
+        read_audio(path)
+        assert minihost.audio_cache_stats()["entries"] == before
+
+
+class TestDither:
+    """Dither modes on the 16/24-bit write paths."""
+
+    def _make_test_signal(self, samples=4800):
+        t = np.linspace(0, 1, samples, dtype=np.float32)
+        return 0.5 * np.sin(2 * np.pi * 440.0 * t).reshape(1, -1)
+
+    def test_dither_none_is_deterministic(self, tmp_path):
+        data = self._make_test_signal()
+        a = tmp_path / "a.wav"
+        b = tmp_path / "b.wav"
+        write_audio(a, data, 48000, bit_depth=16, dither="none")
+        write_audio(b, data, 48000, bit_depth=16, dither="none")
+        assert a.read_bytes() == b.read_bytes()
+
+    def test_dither_shaped_round_trips_within_lsb_budget(self, tmp_path):
+        data = self._make_test_signal()
+        path = tmp_path / "shaped.wav"
+        write_audio(path, data, 48000, bit_depth=16, dither="shaped")
+        result, _ = read_audio(path)
+        # Shaped dither trades total noise for spectral placement; the
+        # second-order error feedback can swing a few LSBs per sample.
+        np.testing.assert_allclose(
+            np.asarray(result), data, atol=8.0 / 32768
+        )
+
+    def test_dither_shaped_24bit_flac(self, tmp_path):
+        data = self._make_test_signal()
+        path = tmp_path / "shaped.flac"
+        write_audio(path, data, 48000, bit_depth=24, dither="shaped")
+        result, _ = read_audio(path)
+        np.testing.assert_allclose(
+            np.asarray(result), data, atol=8.0 / 8388608
+        )
+
+    def test_invalid_dither_rejected(self, tmp_path):
+        data = self._make_test_signal()
+        with pytest.raises(RuntimeError, match="dither"):
+            write_audio(tmp_path / "x.wav", data, 48000, dither="cosine")
+
+    def test_streaming_writer_accepts_dither(self, tmp_path):
+        from minihost import AudioFileWriter
+
+        data = self._make_test_signal()
+        path = tmp_path / "stream.wav"
+        w = AudioFileWriter(str(path), 1, 48000, bit_depth=16, dither="shaped")
+        w.write(data)
+        w.close()
+        result, _ = read_audio(path)
+        np.testing.assert_allclose(
+            np.asarray(result), data, atol=8.0 / 32768
+        )
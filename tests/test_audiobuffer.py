@@ -207,3 +207,297 @@ def test_audiobuffer_mixed_with_numpy_in_process():
     out_np = np.zeros((plugin.num_output_channels, 256), dtype=np.float32)
     plugin.process(inp, out_np)
     assert np.isfinite(out_np).all()
+
+
+# ---------------------------------------------------------------------------#
+# BufferPool
+# ---------------------------------------------------------------------------#
+
+
+def test_buffer_pool_recycles_buffers():
+    pool = minihost.BufferPool(2, 64, capacity=2)
+    assert pool.channels == 2
+    assert pool.frames == 64
+    assert pool.available == 2
+    assert pool.total == 2
+
+    a = pool.acquire()
+    assert isinstance(a, AudioBuffer)
+    assert (a.channels, a.frames) == (2, 64)
+    assert pool.available == 1
+
+    pool.release(a)
+    assert pool.available == 2
+    # The same object comes back out -- recycled, not reconstructed.
+    b = pool.acquire()
+    assert b is a
+
+
+def test_buffer_pool_grows_when_exhausted():
+    pool = minihost.BufferPool(1, 16, capacity=1)
+    a = pool.acquire()
+    b = pool.acquire()  # pool empty: grows by one
+    assert pool.total == 2
+    assert pool.available == 0
+    pool.release(a)
+    pool.release(b)
+    assert pool.available == 2
+
+
+def test_buffer_pool_release_validates():
+    pool = minihost.BufferPool(2, 64, capacity=1)
+    wrong_shape = AudioBuffer(2, 32)
+    with pytest.raises(ValueError, match="does not match"):
+        pool.release(wrong_shape)
+    a = pool.acquire()
+    pool.release(a)
+    with pytest.raises(ValueError, match="already released"):
+        pool.release(a)
+
+
+def test_buffer_pool_keeps_contents_until_overwritten():
+    pool = minihost.BufferPool(1, 8, capacity=1)
+    a = pool.acquire()
+    a[0, :] = np.arange(8, dtype=np.float32)
+    pool.release(a)
+    b = pool.acquire()
+    # Recycled dirty by contract; callers overwrite or clear.
+    np.testing.assert_array_equal(
+        np.asarray(b)[0], np.arange(8, dtype=np.float32)
+    )
+
+
+# ---------------------------------------------------------------------------#
+# frame_view (zero-copy frame-range views)
+# ---------------------------------------------------------------------------#
+
+
+def test_frame_view_shape_values_and_write_through():
+    buf = AudioBuffer(2, 16)
+    buf.as_ndarray()[:] = np.arange(32, dtype=np.float32).reshape(2, 16)
+    view = buf.frame_view(4, 8)
+    assert view.shape == (2, 8)
+    assert view[0, 0] == 4.0
+    assert view[1, 7] == 16.0 + 11.0
+    # Write through the view -> visible in the parent, and vice versa.
+    view[0, 0] = -1.0
+    assert buf[0, 4] == -1.0
+    buf[1, 5] = 99.0
+    assert view[1, 1] == 99.0
+
+
+def test_frame_view_numpy_export_is_strided_zero_copy():
+    buf = AudioBuffer(3, 64)
+    buf.as_ndarray()[:] = np.random.default_rng(7).standard_normal(
+        (3, 64)
+    ).astype(np.float32)
+    view = buf.frame_view(10, 20)
+    arr = np.asarray(view)
+    np.testing.assert_array_equal(arr, np.asarray(buf)[:, 10:30])
+    # The export carries the parent's row stride, so it aliases rather
+    # than copies: writes through the numpy view land in the parent.
+    assert arr.strides[0] == 64 * arr.itemsize
+    arr[2, 0] = 0.5
+    assert buf[2, 10] == pytest.approx(0.5)
+
+
+def test_frame_view_copy_is_contiguous_and_independent():
+    buf = AudioBuffer(2, 32)
+    buf.as_ndarray()[:] = np.arange(64, dtype=np.float32).reshape(2, 32)
+    cp = buf.frame_view(8, 8).copy()
+    arr = np.asarray(cp)
+    assert arr.flags["C_CONTIGUOUS"]
+    np.testing.assert_array_equal(arr, np.asarray(buf)[:, 8:16])
+    cp[0, 0] = -5.0
+    assert buf[0, 8] == pytest.approx(8.0)  # parent untouched
+
+
+def test_frame_view_of_channel_view():
+    buf = AudioBuffer(4, 16)
+    buf.as_ndarray()[:] = np.arange(64, dtype=np.float32).reshape(4, 16)
+    inner = buf.channel_view(1, 2).frame_view(3, 5)
+    assert inner.shape == (2, 5)
+    assert inner[0, 0] == buf[1, 3]
+    inner[1, 4] = -2.0
+    assert buf[2, 7] == -2.0  # transitive aliasing back to the root
+
+
+@pytest.mark.parametrize("start,count", [(-1, 1), (0, 0), (8, 1), (7, 2), (0, 9)])
+def test_frame_view_out_of_bounds_raises(start, count):
+    buf = AudioBuffer(2, 8)
+    with pytest.raises(ValueError):
+        buf.frame_view(start, count)
+
+
+def test_frame_view_keeps_parent_alive():
+    view = AudioBuffer(2, 64).frame_view(16, 16)
+    import gc
+
+    gc.collect()
+    view[0, 0] = 3.0
+    assert view[0, 0] == 3.0
+
+
+# ---------------------------------------------------------------------------#
+# BufferOp fused batches
+# ---------------------------------------------------------------------------#
+
+
+def test_apply_fused_matches_separate_passes():
+    rng = np.random.default_rng(3)
+    data = rng.standard_normal((2, 512)).astype(np.float32)
+    fused = AudioBuffer.from_numpy(data)
+    ref = AudioBuffer.from_numpy(data)
+
+    result = fused.apply(
+        [
+            minihost.BufferOp.gain(0.5),
+            minihost.BufferOp.gain_ramp(100, 200, 1.0, 0.25),
+        ]
+    )
+    assert result is None  # no measure op in the batch
+    ref.apply_gain(0.5)
+    ref.apply_gain_ramp(100, 200, 1.0, 0.25)
+    np.testing.assert_allclose(np.asarray(fused), np.asarray(ref), rtol=1e-6)
+
+
+def test_apply_fades_match_gain_ramps():
+    rng = np.random.default_rng(4)
+    data = rng.standard_normal((1, 64)).astype(np.float32)
+    fused = AudioBuffer.from_numpy(data)
+    ref = AudioBuffer.from_numpy(data)
+
+    fused.apply(
+        [minihost.BufferOp.fade_in(16), minihost.BufferOp.fade_out(16)]
+    )
+    ref.apply_gain_ramp(0, 16, 0.0, 1.0)
+    ref.apply_gain_ramp(48, 16, 1.0, 0.0)
+    np.testing.assert_allclose(np.asarray(fused), np.asarray(ref), rtol=1e-6)
+
+
+def test_apply_measure_values_and_order():
+    buf = AudioBuffer(2, 4)
+    buf.as_ndarray()[:] = np.array(
+        [[1.0, -2.0, 0.5, 0.0], [0.0, 1.0, -1.0, 3.0]], dtype=np.float32
+    )
+    expected_rms = float(np.sqrt(np.mean(np.square(np.asarray(buf)))))
+    # Measure placed before the gain observes the raw signal...
+    pre = buf.copy().apply(
+        [minihost.BufferOp.measure(peak=True, rms=True),
+         minihost.BufferOp.gain(0.5)]
+    )
+    assert pre["peak"] == pytest.approx(3.0)
+    assert pre["rms"] == pytest.approx(expected_rms, rel=1e-6)
+    # ...and placed after it observes the scaled signal.
+    post = buf.copy().apply(
+        [minihost.BufferOp.gain(0.5), minihost.BufferOp.measure(peak=True)]
+    )
+    assert post["peak"] == pytest.approx(1.5)
+    assert "rms" not in post
+
+
+def test_apply_validation():
+    buf = AudioBuffer(1, 32)
+    with pytest.raises(ValueError):
+        buf.apply([minihost.BufferOp.measure(), minihost.BufferOp.measure()])
+    with pytest.raises(ValueError):
+        buf.apply([minihost.BufferOp.fade_out(33)])
+    with pytest.raises(ValueError):
+        buf.apply([minihost.BufferOp.gain_ramp(16, 17, 1.0, 0.0)])
+    with pytest.raises(ValueError):
+        minihost.BufferOp.gain_ramp(0, -1, 1.0, 0.0)
+
+
+# ---------------------------------------------------------------------------
+# Shared memory (create_shared / attach_shared / unlink_shared)
+# ---------------------------------------------------------------------------
+
+
+def _shm_name(request):
+    """A per-test shm token that is cleaned up even when the test fails."""
+    import uuid
+
+    name = f"mh-test-{uuid.uuid4().hex[:12]}"
+
+    def cleanup():
+        try:
+            AudioBuffer.unlink_shared(name)
+        except RuntimeError:
+            pass  # already unlinked (or never created)
+
+    request.addfinalizer(cleanup)
+    return name
+
+
+def test_shared_create_attach_round_trip(request):
+    name = _shm_name(request)
+    a = AudioBuffer.create_shared(name, 2, 256)
+    assert a.shape == (2, 256)
+    assert (np.asarray(a) == 0).all()  # zero-initialized like the ctor
+
+    a[0, 10] = 0.5
+    a[1, 20] = -0.25
+
+    b = AudioBuffer.attach_shared(name)
+    assert b.shape == (2, 256)
+    assert b[0, 10] == pytest.approx(0.5)
+    assert b[1, 20] == pytest.approx(-0.25)
+
+    # Same block, both directions: writes through either mapping are
+    # visible through the other.
+    b[0, 30] = 1.0
+    assert a[0, 30] == pytest.approx(1.0)
+
+
+def test_shared_buffer_is_a_normal_buffer(request):
+    name = _shm_name(request)
+    buf = AudioBuffer.create_shared(name, 2, 64)
+    arr = np.asarray(buf)  # DLPack/ndarray export works unchanged
+    assert arr.shape == (2, 64)
+    arr[:] = 0.5
+    assert buf.magnitude() == pytest.approx(0.5)
+
+
+def test_shared_create_existing_name_raises(request):
+    name = _shm_name(request)
+    AudioBuffer.create_shared(name, 1, 16)
+    with pytest.raises(RuntimeError):
+        AudioBuffer.create_shared(name, 1, 16)
+
+
+def test_shared_attach_missing_raises():
+    with pytest.raises(RuntimeError):
+        AudioBuffer.attach_shared("mh-test-does-not-exist")
+
+
+def test_shared_attach_dtype_mismatch_raises(request):
+    name = _shm_name(request)
+    AudioBuffer.create_shared(name, 1, 8)
+    with pytest.raises(RuntimeError, match="float32"):
+        minihost.AudioBufferD.attach_shared(name)
+
+
+def test_shared_unlink_then_attach_raises(request):
+    name = _shm_name(request)
+    buf = AudioBuffer.create_shared(name, 1, 8)
+    AudioBuffer.unlink_shared(name)
+    # The creator's mapping stays valid after unlink...
+    buf[0, 0] = 1.0
+    # ...but the name is gone.
+    with pytest.raises(RuntimeError):
+        AudioBuffer.attach_shared(name)
+
+
+def test_shared_cross_process_visibility(request):
+    import subprocess
+    import sys
+
+    name = _shm_name(request)
+    buf = AudioBuffer.create_shared(name, 1, 4)
+    code = (
+        "from minihost import AudioBuffer\n"
+        f"b = AudioBuffer.attach_shared({name!r})\n"
+        "b[0, 0] = 0.75\n"
+    )
+    subprocess.run([sys.executable, "-c", code], check=True)
+    assert buf[0, 0] == pytest.approx(0.75)
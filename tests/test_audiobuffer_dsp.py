@@ -251,3 +251,72 @@ def test_reverse_bounds():
         buf.reverse_channel(5)
     with pytest.raises(ValueError, match="out of bounds"):
         buf.reverse_channel(0, 95, 10)
+
+
+# -- fade_in / fade_out / crossfade_from ------------------------------
+
+
+def test_fade_in_linear_matches_gain_ramp():
+    buf = AudioBuffer(2, 100)
+    buf[:, :] = 1.0
+    buf.fade_in(40)
+
+    ref = AudioBuffer(2, 100)
+    ref[:, :] = 1.0
+    ref.apply_gain_ramp(0, 40, 0.0, 1.0)
+    assert np.array_equal(np.asarray(buf), np.asarray(ref))
+
+
+def test_fade_out_equal_power_matches_numpy_reference():
+    # Default start: the fade covers the tail of the buffer.
+    buf = AudioBuffer(1, 100)
+    buf[:, :] = 1.0
+    buf.fade_out(50, shape="equal_power")
+
+    t = np.arange(50, dtype=np.float64) / 50.0
+    gains = np.sin((1.0 - t) * np.pi / 2.0).astype(np.float32)
+    arr = np.asarray(buf)
+    assert (arr[0, :50] == 1.0).all()
+    assert np.allclose(arr[0, 50:], gains, atol=1e-6)
+
+
+def test_crossfade_from_equal_power_matches_numpy_reference():
+    rng = np.random.default_rng(3)
+    a = rng.standard_normal((2, 80)).astype(np.float32)
+    b = rng.standard_normal((2, 80)).astype(np.float32)
+    buf = AudioBuffer.from_numpy(a)
+    src = AudioBuffer.from_numpy(b)
+    buf.crossfade_from(src, 60, start=10, source_start=5)
+
+    t = np.arange(60, dtype=np.float64) / 60.0
+    gin = np.sin(t * np.pi / 2.0).astype(np.float32)
+    gout = np.sin((1.0 - t) * np.pi / 2.0).astype(np.float32)
+    expected = a.copy()
+    expected[:, 10:70] = a[:, 10:70] * gout[None, :] + b[:, 5:65] * gin[None, :]
+    assert np.allclose(np.asarray(buf), expected, atol=1e-6)
+
+
+def test_crossfade_from_linear_is_two_ramps():
+    a = np.ones((1, 50), dtype=np.float32)
+    b = np.full((1, 50), 3.0, dtype=np.float32)
+    buf = AudioBuffer.from_numpy(a)
+    buf.crossfade_from(AudioBuffer.from_numpy(b), shape="linear")
+
+    # out[i] = 1*(1 - i/50) + 3*(i/50); midpoint frame 25 mixes evenly.
+    t = np.arange(50, dtype=np.float32) / 50.0
+    expected = 1.0 * (1.0 - t) + 3.0 * t
+    assert np.allclose(np.asarray(buf)[0], expected, atol=1e-5)
+
+
+def test_fade_and_crossfade_argument_errors():
+    buf = AudioBuffer(2, 100)
+    with pytest.raises(ValueError, match="out of bounds"):
+        buf.fade_in(101)
+    with pytest.raises(ValueError, match="out of bounds"):
+        buf.fade_out(10, start=95)
+    with pytest.raises(ValueError, match="linear"):
+        buf.fade_in(10, shape="cosine")
+    with pytest.raises(ValueError, match="channel"):
+        buf.crossfade_from(AudioBuffer(1, 100))
+    with pytest.raises(ValueError, match="out of bounds"):
+        buf.crossfade_from(AudioBuffer(2, 100), 50, start=60)
@@ -287,6 +287,76 @@ class TestParseAutomationFile:
         assert offsets == sorted(offsets)
 
 
+# -- Tests for KeyframeAutomation / parse_automation_curves --
+# (need the built extension for the native object, but no real plugin)
+
+
+class TestKeyframeAutomation:
+    def test_lerp_and_clamp(self):
+        from minihost import KeyframeAutomation
+
+        curves = KeyframeAutomation([(0, 0, 0.0), (1000, 0, 1.0)])
+        assert len(curves) == 1
+        assert curves.param_indices == [0]
+        assert curves.value_at(0, -100) == 0.0  # clamp before span
+        assert abs(curves.value_at(0, 500) - 0.5) < 1e-6
+        assert curves.value_at(0, 5000) == 1.0  # clamp after span
+
+    def test_multiple_params_sorted_unsorted_input(self):
+        from minihost import KeyframeAutomation
+
+        # Keyframes arrive interleaved and out of order per param.
+        curves = KeyframeAutomation(
+            [(1000, 2, 1.0), (0, 0, 0.5), (0, 2, 0.0)]
+        )
+        assert curves.param_indices == [0, 2]
+        assert curves.value_at(0, 999999) == 0.5  # single key = static
+        assert abs(curves.value_at(2, 500) - 0.5) < 1e-6
+
+    def test_no_curve_for_param_raises(self):
+        from minihost import KeyframeAutomation
+
+        curves = KeyframeAutomation([(0, 1, 0.5)])
+        with pytest.raises(ValueError):
+            curves.value_at(0, 0)
+
+    def test_empty_keyframes_raises(self):
+        from minihost import KeyframeAutomation
+
+        with pytest.raises(ValueError):
+            KeyframeAutomation([])
+
+
+class TestParseAutomationCurves:
+    def test_keyframes_stay_sparse(self, tmp_path):
+        from minihost import parse_automation_curves
+
+        plugin = _make_mock_plugin()
+        auto_file = tmp_path / "auto.json"
+        auto_file.write_text(
+            json.dumps(
+                {
+                    "Mix": {"0": 0.0, "1.0s": 1.0},
+                    "Feedback": 0.5,
+                }
+            )
+        )
+
+        curves = parse_automation_curves(auto_file, plugin, 48000, 96000)
+        assert len(curves) == 2
+        assert curves.param_indices == [0, 1]
+        # Lazy interpolation matches the dense expansion's values.
+        assert abs(curves.value_at(0, 24000) - 0.5) < 1e-6
+        assert curves.value_at(1, 0) == 0.5
+
+    def test_file_not_found(self):
+        from minihost import parse_automation_curves
+
+        plugin = _make_mock_plugin()
+        with pytest.raises(FileNotFoundError):
+            parse_automation_curves("/nonexistent/auto.json", plugin, 48000, 96000)
+
+
 # -- Integration tests (require real plugin) --
 
 
@@ -0,0 +1,210 @@
+"""Tests for the process-pool batch renderer (minihost.batch_process)."""
+
+from __future__ import annotations
+
+import os
+
+import pytest
+
+import minihost
+from minihost.process import BatchResult, _capture_batch_spec
+
+PLUGIN = (
+    os.environ.get("MINIHOST_TEST_PLUGIN") or "/Library/Audio/Plug-Ins/VST3/Dexed.vst3"
+)
+INPUT_WAV = "tests/_wav/piano.wav"
+
+skip_if_no_plugin = pytest.mark.skipif(
+    not os.path.exists(PLUGIN),
+    reason=f"test plugin not found at {PLUGIN}",
+)
+skip_if_no_input = pytest.mark.skipif(
+    not os.path.exists(INPUT_WAV),
+    reason=f"test wav not found at {INPUT_WAV}",
+)
+
+
+def test_batch_process_empty_jobs_returns_empty_list():
+    # Returns before any plugin construction, so a fake path is fine.
+    assert minihost.batch_process("/nonexistent.vst3", []) == []
+
+
+def test_batch_result_ok():
+    assert BatchResult(input="a.wav", output="b.wav").ok
+    assert not BatchResult(input="a.wav", output="b.wav", error="boom").ok
+
+
+def test_capture_spec_plugin_path_has_no_state_blob():
+    spec, sr = _capture_batch_spec("/some/plugin.vst3", None)
+    assert spec == {"kind": "plugins", "plugins": [("/some/plugin.vst3", None)]}
+    assert sr == 48000
+
+
+def test_capture_spec_chain_file_defers_sample_rate_to_spec():
+    spec, _ = _capture_batch_spec("chain.json", None)
+    assert spec["kind"] == "chain_spec"
+    assert spec["sample_rate"] is None
+    spec, sr = _capture_batch_spec("chain.yaml", 44100)
+    assert spec["sample_rate"] == 44100
+    assert sr == 44100
+
+
+@skip_if_no_plugin
+def test_capture_spec_live_plugin_snapshots_state():
+    plugin = minihost.Plugin(PLUGIN, sample_rate=44100, max_block_size=512)
+    spec, sr = _capture_batch_spec(plugin, None)
+    assert sr == 44100
+    [(path, state)] = spec["plugins"]
+    assert path == plugin.path
+    assert state == plugin.get_state()
+
+
+@skip_if_no_plugin
+@skip_if_no_input
+def test_batch_process_single_worker_in_process(tmp_path):
+    jobs = [
+        (INPUT_WAV, str(tmp_path / "a.wav")),
+        (INPUT_WAV, str(tmp_path / "b.wav")),
+    ]
+    seen = []
+    results = minihost.batch_process(
+        PLUGIN,
+        jobs,
+        workers=1,
+        progress_callback=lambda done, total: seen.append((done, total)),
+    )
+    assert [r.ok for r in results] == [True, True]
+    assert all(os.path.exists(out) for _, out in jobs)
+    assert seen == [(1, 2), (2, 2)]
+
+
+@skip_if_no_plugin
+@skip_if_no_input
+def test_batch_process_reports_per_job_failures(tmp_path):
+    jobs = [
+        ("/nonexistent/input.wav", str(tmp_path / "a.wav")),
+        (INPUT_WAV, str(tmp_path / "b.wav")),
+    ]
+    results = minihost.batch_process(PLUGIN, jobs, workers=1)
+    assert not results[0].ok
+    assert results[1].ok
+
+
+# -- content-addressed render cache ----------------------------------- #
+
+
+def _fake_render(path, content=b"RIFFfake-audio-bytes"):
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_bytes(content)
+    return str(path)
+
+
+def test_render_cache_store_fetch_roundtrip(tmp_path):
+    from minihost.process import RenderCache
+
+    cache = RenderCache(tmp_path / "store")
+    rendered = _fake_render(tmp_path / "rendered.wav")
+    cache.store("ab" + "0" * 62 + ".wav", rendered)
+
+    out = tmp_path / "restored.wav"
+    assert cache.fetch("ab" + "0" * 62 + ".wav", out)
+    assert out.read_bytes() == (tmp_path / "rendered.wav").read_bytes()
+    assert (cache.hits, cache.misses) == (1, 0)
+
+
+def test_render_cache_miss_counts(tmp_path):
+    from minihost.process import RenderCache
+
+    cache = RenderCache(tmp_path / "store")
+    assert not cache.fetch("cd" + "0" * 62 + ".wav", tmp_path / "out.wav")
+    assert (cache.hits, cache.misses) == (0, 1)
+    assert not (tmp_path / "out.wav").exists()
+
+
+def test_job_key_tracks_input_content_not_output_location(tmp_path):
+    from minihost.process import RenderCache
+
+    cache = RenderCache(tmp_path / "store")
+    a = _fake_render(tmp_path / "a.wav", b"one")
+    b = _fake_render(tmp_path / "b.wav", b"two")
+    b_copy = _fake_render(tmp_path / "sub" / "b2.wav", b"two")
+
+    key_a = cache.job_key("sig", a, "out/x.wav")
+    key_b = cache.job_key("sig", b, "out/x.wav")
+    assert key_a != key_b
+    # Same content, different path / output name: still the same object.
+    assert cache.job_key("sig", b_copy, "elsewhere/y.wav") == key_b
+    # The output *suffix* is part of the key (different codec).
+    assert cache.job_key("sig", b, "out/x.flac") != key_b
+    # A different batch signature separates otherwise identical jobs.
+    assert cache.job_key("sig2", a, "out/x.wav") != key_a
+
+
+def test_batch_signature_covers_state_and_options():
+    from minihost.process import _batch_cache_signature
+
+    spec = {"kind": "plugins", "plugins": [("/no/such/plug.vst3", b"state-1")]}
+    opts = {"sample_rate": 48000, "tail_seconds": 0.0}
+    sig = _batch_cache_signature(spec, opts)
+    assert sig == _batch_cache_signature(spec, dict(opts))  # deterministic
+
+    restate = {"kind": "plugins", "plugins": [("/no/such/plug.vst3", b"state-2")]}
+    assert _batch_cache_signature(restate, opts) != sig
+    assert _batch_cache_signature(spec, {**opts, "tail_seconds": 1.0}) != sig
+
+
+def test_batch_process_all_hits_skips_plugin_entirely(tmp_path):
+    # When every job hits the cache, batch_process returns before any
+    # plugin is built -- a nonexistent bundle path proves it.
+    from minihost.process import (
+        RenderCache,
+        _batch_cache_signature,
+        _capture_batch_spec,
+    )
+
+    inp = _fake_render(tmp_path / "in.wav", b"input-bytes")
+    out = tmp_path / "out" / "result.wav"
+    cache = RenderCache(tmp_path / "store")
+
+    spec, sr = _capture_batch_spec("/nonexistent.vst3", None)
+    opts = {
+        "sample_rate": sr,
+        "block_size": 512,
+        "tail_seconds": 0.0,
+        "bit_depth": 24,
+        "resample_to_plugin_rate": True,
+        "duplicate_to_stereo": True,
+        "normalize": None,
+    }
+    key = cache.job_key(_batch_cache_signature(spec, opts), inp, str(out))
+    cache.store(key, _fake_render(tmp_path / "seed.wav", b"cached-render"))
+
+    seen = []
+    results = minihost.batch_process(
+        "/nonexistent.vst3",
+        [(inp, str(out))],
+        cache=cache,
+        progress_callback=lambda done, total: seen.append((done, total)),
+    )
+    assert results[0].ok and results[0].cached
+    assert out.read_bytes() == b"cached-render"
+    assert seen == [(1, 1)]
+    assert (cache.hits, cache.misses) == (1, 0)
+
+
+def test_render_cache_prune_evicts_oldest(tmp_path):
+    import os as _os
+
+    from minihost.process import RenderCache
+
+    cache = RenderCache(tmp_path / "store")
+    for i, age in enumerate((300, 200, 100)):
+        key = f"{i:02d}" + "0" * 62 + ".wav"
+        cache.store(key, _fake_render(tmp_path / f"r{i}.wav", b"x" * 100))
+        obj = cache._object_path(key)
+        _os.utime(obj, (obj.stat().st_atime, obj.stat().st_mtime - age))
+
+    removed = cache.prune(max_bytes=150)
+    assert removed == 2
+    # The newest object survives.
+    assert cache._object_path("02" + "0" * 62 + ".wav").is_file()
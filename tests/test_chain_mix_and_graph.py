@@ -130,6 +130,223 @@ def test_chain_set_mix_rejects_mismatched_channels():
         chain.close()
 
 
+# ---------------------------------------------------------------------------
+# PluginChain per-plugin bypass
+# ---------------------------------------------------------------------------
+
+
+@skip_if_no_fx
+def test_chain_default_is_not_bypassed():
+    chain, _p = _make_chain()
+    try:
+        assert chain.get_bypass(0) is False
+    finally:
+        chain.close()
+
+
+@skip_if_no_fx
+def test_chain_bypass_is_identity_passthrough():
+    chain, _p = _make_chain()
+    try:
+        chain.set_bypass(0, True)
+        assert chain.get_bypass(0) is True
+        inp = np.full((2, 256), 0.25, dtype=np.float32)
+        out = np.zeros((2, 256), dtype=np.float32)
+        chain.process(inp, out)
+        # A bypassed stage copies its input through untouched.
+        assert np.array_equal(out, inp)
+        chain.set_bypass(0, False)
+        assert chain.get_bypass(0) is False
+    finally:
+        chain.close()
+
+
+@skip_if_no_fx
+def test_chain_bypass_leaves_mix_intact():
+    # Bypass and mix share one packed control word; flipping one must
+    # not disturb the other.
+    chain, _p = _make_chain()
+    try:
+        chain.set_mix(0, 0.3)
+        chain.set_bypass(0, True)
+        chain.set_bypass(0, False)
+        assert chain.get_mix(0) == pytest.approx(0.3, abs=1e-6)
+    finally:
+        chain.close()
+
+
+def test_chain_set_bypass_rejects_mismatched_channels():
+    SYNTH = (
+        os.environ.get("MINIHOST_TEST_PLUGIN")
+        or "/Library/Audio/Plug-Ins/VST3/Dexed.vst3"
+    )
+    if not os.path.exists(SYNTH):
+        pytest.skip(f"synth plugin not found at {SYNTH}")
+    p = minihost.Plugin(SYNTH, sample_rate=48000)
+    if p.num_input_channels == p.num_output_channels:
+        p.close()
+        pytest.skip("synth has matching channel counts; cannot test rejection")
+    chain = minihost.PluginChain([p])
+    try:
+        with pytest.raises(RuntimeError, match="must match"):
+            chain.set_bypass(0, True)
+    finally:
+        chain.close()
+
+
+# ---------------------------------------------------------------------------
+# PluginChain gapless plugin replacement
+# ---------------------------------------------------------------------------
+
+
+def _chain_buffers(chain, nframes=512):
+    x = np.zeros((chain.num_input_channels, nframes), dtype=np.float32)
+    y = np.zeros((chain.num_output_channels, nframes), dtype=np.float32)
+    return x, y
+
+
+@skip_if_no_fx
+def test_chain_replace_plugin_crossfades_to_new_instance():
+    chain, _p = _make_chain()
+    try:
+        p2 = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+        x, y = _chain_buffers(chain)
+        chain.process(x, y)
+        chain.replace_plugin(0, p2)
+        assert chain.replace_pending()
+        # The crossfade spans 1024 samples; two 512-frame blocks land it.
+        chain.process(x, y)
+        chain.process(x, y)
+        assert not chain.replace_pending()
+    finally:
+        chain.close()
+
+
+@skip_if_no_fx
+def test_chain_replace_plugin_rejects_bad_index():
+    chain, _p = _make_chain()
+    try:
+        p2 = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+        with pytest.raises(RuntimeError, match="out of range"):
+            chain.replace_plugin(3, p2)
+    finally:
+        chain.close()
+
+
+@skip_if_no_fx
+def test_chain_replace_plugin_refuses_second_in_flight():
+    chain, _p = _make_chain()
+    try:
+        p2 = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+        p3 = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+        chain.replace_plugin(0, p2)
+        with pytest.raises(RuntimeError, match="still in flight"):
+            chain.replace_plugin(0, p3)
+    finally:
+        chain.close()
+
+
+# ---------------------------------------------------------------------------
+# Shared scratch arena
+# ---------------------------------------------------------------------------
+
+
+def _make_two_stage_chain():
+    """Two FX stages so the chain actually holds inter-stage scratch
+    (a single-plugin chain has none to share)."""
+    p1 = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+    p2 = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+    return minihost.PluginChain([p1, p2])
+
+
+def test_arena_starts_empty():
+    arena = minihost.ChainScratchArena()
+    assert arena.bytes == 0
+
+
+@skip_if_no_fx
+def test_chain_arena_output_matches_private_scratch():
+    """Borrowed scratch is a memory optimization, not a behavior change:
+    the same chain renders identically before and after attaching."""
+    chain = _make_two_stage_chain()
+    try:
+        x = np.zeros((chain.num_input_channels, 512), dtype=np.float32)
+        x[:, 0] = 0.25
+        y_private = np.zeros((chain.num_output_channels, 512), dtype=np.float32)
+        chain.process(x, y_private)
+        chain.reset()
+
+        arena = minihost.ChainScratchArena()
+        chain.set_scratch_arena(arena)
+        assert arena.bytes > 0
+        y_shared = np.zeros((chain.num_output_channels, 512), dtype=np.float32)
+        chain.process(x, y_shared)
+
+        assert np.allclose(y_shared, y_private, atol=1e-6)
+    finally:
+        chain.close()
+
+
+@skip_if_no_fx
+def test_arena_is_sized_for_one_chain_not_the_sum():
+    """Attaching a second same-shaped chain reuses the region instead of
+    growing it -- the whole point of sharing."""
+    a = _make_two_stage_chain()
+    b = _make_two_stage_chain()
+    try:
+        arena = minihost.ChainScratchArena()
+        a.set_scratch_arena(arena)
+        after_one = arena.bytes
+        b.set_scratch_arena(arena)
+        assert arena.bytes == after_one
+
+        # Alternating (never concurrent) processing through the shared
+        # region keeps both chains correct.
+        x = np.zeros((a.num_input_channels, 256), dtype=np.float32)
+        x[:, 0] = 0.25
+        ya = np.zeros((a.num_output_channels, 256), dtype=np.float32)
+        yb = np.zeros((b.num_output_channels, 256), dtype=np.float32)
+        a.process(x, ya)
+        b.process(x, yb)
+        assert np.allclose(ya, yb, atol=1e-6)
+    finally:
+        a.close()
+        b.close()
+
+
+@skip_if_no_fx
+def test_chain_detaches_back_to_private_scratch():
+    chain = _make_two_stage_chain()
+    try:
+        arena = minihost.ChainScratchArena()
+        chain.set_scratch_arena(arena)
+        chain.clear_scratch_arena()
+        x, y = _chain_buffers(chain, 256)
+        x[:, 0] = 0.25
+        chain.process(x, y)  # private scratch again; must not crash
+        assert np.all(np.isfinite(y))
+    finally:
+        chain.close()
+
+
+@skip_if_no_fx
+def test_arena_freed_before_chain_reverts_it():
+    """Dropping the arena while a chain is attached reverts the chain to
+    private scratch (the binding also keeps the arena alive via the
+    chain, so this exercises the C-side fallback through close order)."""
+    chain = _make_two_stage_chain()
+    try:
+        arena = minihost.ChainScratchArena()
+        chain.set_scratch_arena(arena)
+        del arena
+        x, y = _chain_buffers(chain, 256)
+        x[:, 0] = 0.25
+        chain.process(x, y)
+        assert np.all(np.isfinite(y))
+    finally:
+        chain.close()
+
+
 # ---------------------------------------------------------------------------
 # PluginBus
 # ---------------------------------------------------------------------------
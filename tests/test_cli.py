@@ -227,6 +227,12 @@ class TestArgParsingPlay:
         args = _parse(["play", "/path/to/synth.vst3", "--virtual-midi-out", "Out"])
         assert args.virtual_midi_out == "Out"
 
+    def test_no_warmup_flag(self):
+        args = _parse(["play", "/path/to/synth.vst3", "--no-warmup"])
+        assert args.no_warmup is True
+        args = _parse(["play", "/path/to/synth.vst3"])
+        assert args.no_warmup is False
+
     def test_missing_plugin(self):
         with pytest.raises(SystemExit):
             _parse(["play"])
@@ -823,7 +829,7 @@ class TestCmdPlayLoopFlags:
         )
         ret = cmd_play(args)
         assert ret == 1
-        assert "both write to the input ring buffer" in capsys.readouterr().err
+        assert "both provide the plugin's audio input" in capsys.readouterr().err
 
 
 class TestCmdProcessErrors:
@@ -1800,3 +1806,77 @@ class TestMorphCommand:
             ret = cmd_morph(self._args())
         assert ret == 1
         assert "load failed" in capsys.readouterr().err
+
+
+class TestLazyImports:
+    """The package loads lazily (PEP 562) so short CLI invocations don't
+    pay the native-module import cost. Run in a subprocess so this suite's
+    own imports can't contaminate sys.modules."""
+
+    def _run(self, code):
+        import subprocess
+
+        return subprocess.run(
+            [sys.executable, "-c", code],
+            stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+            text=True,
+        )
+
+    def test_import_minihost_does_not_load_core(self):
+        out = self._run(
+            "import sys, minihost\n"
+            "print(minihost.__version__)\n"
+            "print('minihost._core' in sys.modules)\n"
+        )
+        assert out.returncode == 0, out.stderr
+        version, core_loaded = out.stdout.split()
+        assert version == "0.4.2"
+        assert core_loaded == "False"
+
+    def test_cli_help_does_not_load_core(self):
+        out = self._run(
+            "import sys\n"
+            "sys.argv = ['minihost', '--help']\n"
+            "from minihost import cli\n"
+            "try:\n"
+            "    cli.main()\n"
+            "except SystemExit:\n"
+            "    pass\n"
+            "print('minihost._core' in sys.modules, file=sys.stderr)\n"
+        )
+        assert out.returncode == 0
+        assert "usage:" in out.stdout
+        assert out.stderr.strip().endswith("False")
+
+    def test_pure_python_attrs_resolve_without_core(self):
+        out = self._run(
+            "import sys, minihost\n"
+            "print(minihost.VstPreset.__name__)\n"
+            "print(minihost.plugincache.cache_file() is not None)\n"
+            "print('minihost._core' in sys.modules)\n"
+        )
+        assert out.returncode == 0, out.stderr
+        assert out.stdout.split() == ["VstPreset", "True", "False"]
+
+    def test_native_attr_loads_core(self):
+        out = self._run(
+            "import sys, minihost\n"
+            "minihost.Plugin\n"
+            "print('minihost._core' in sys.modules)\n"
+        )
+        assert out.returncode == 0, out.stderr
+        assert out.stdout.strip() == "True"
+
+    def test_unknown_attribute_raises(self):
+        with pytest.raises(AttributeError, match="no attribute"):
+            import minihost
+
+            minihost.definitely_not_a_real_export
+
+    def test_dir_includes_lazy_exports(self):
+        import minihost
+
+        names = dir(minihost)
+        assert "Plugin" in names
+        assert "read_vstpreset_info" in names
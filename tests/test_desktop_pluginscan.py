@@ -151,6 +151,29 @@ def test_scan_oop_finds_real_plugin(tmp_path):
     ]
 
 
+@skip_if_no_desktop
+def test_rescan_selftest(tmp_path):
+    """The incremental library refresh honors its stat-compare contract.
+
+    ``--rescan-selftest`` runs BackgroundPluginRescan::refreshPass (the
+    core of the startup background rescan) against fake bundles: an entry
+    whose stored mod time matches the file must be kept *without* probing
+    (probing a fake would fail and lose it), and an entry whose file
+    vanished must be dropped. Hermetic -- no real plugins involved.
+    """
+    scratch = tmp_path / "rescan"
+    res = subprocess.run(
+        [str(DESKTOP_BIN), f"--rescan-selftest={scratch}"],
+        capture_output=True,
+        text=True,
+        timeout=120,
+    )
+    assert res.returncode == 0, (
+        f"rescan selftest failed:\nstdout:{res.stdout}\nstderr:{res.stderr}"
+    )
+    assert "rescan-selftest OK" in res.stderr
+
+
 @skip_if_no_desktop
 def test_scan_default_path_survives_shutdown(tmp_path):
     """A scan to the default library path is not clobbered on shutdown.
@@ -19,6 +19,7 @@ Three families of tests:
 
 from __future__ import annotations
 
+import json
 import os
 
 import numpy as np
@@ -99,6 +100,47 @@ def test_cycle_detected_at_compile():
         g.compile()
 
 
+def test_feedback_edge_port_exclusivity():
+    g = minihost.PluginGraph(64, 48000.0)
+    inp = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    g.connect_feedback(mix, mix, dst_port=1)
+    with pytest.raises(RuntimeError, match="feedback edge"):
+        g.connect(inp, mix, dst_port=1)
+    # The reverse exclusion, too: a forward-driven port cannot also be
+    # fed back into.
+    g.connect(inp, mix, dst_port=0)
+    with pytest.raises(RuntimeError, match="forward edge"):
+        g.connect_feedback(mix, mix, dst_port=0)
+
+
+def test_feedback_source_must_be_processing_node():
+    g = minihost.PluginGraph(64, 48000.0)
+    inp = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    with pytest.raises(RuntimeError, match="processing node"):
+        g.connect_feedback(inp, mix, dst_port=1)
+
+
+def test_modulation_target_must_be_plugin():
+    g = minihost.PluginGraph(64, 48000.0)
+    lfo = g.add_input(1)
+    mix = g.add_mix(2, 2)
+    with pytest.raises(RuntimeError, match="plugin node"):
+        g.connect_modulation(lfo, 0, mix, 0)
+
+
+def test_modulation_interval_is_precompile_config():
+    g = minihost.PluginGraph(64, 48000.0)
+    inp = g.add_input(2)
+    out = g.add_output(2)
+    g.connect(inp, out)
+    g.set_modulation_interval(16)
+    g.compile()
+    with pytest.raises(RuntimeError, match="set_modulation_interval"):
+        g.set_modulation_interval(8)
+
+
 def test_post_compile_mutation_rejected():
     g = minihost.PluginGraph(64, 48000.0)
     inp = g.add_input(2)
@@ -137,17 +179,722 @@ def test_identity_input_to_output_copies_samples():
     g.connect(inp, out)
     g.compile()
 
-    rng = np.random.default_rng(0)
-    src = rng.standard_normal((2, F)).astype(np.float32)
-    dst = np.full((2, F), -7.0, dtype=np.float32)
-    g.render_block([src], [dst], F)
-    np.testing.assert_array_equal(dst, src)
+    rng = np.random.default_rng(0)
+    src = rng.standard_normal((2, F)).astype(np.float32)
+    dst = np.full((2, F), -7.0, dtype=np.float32)
+    g.render_block([src], [dst], F)
+    np.testing.assert_array_equal(dst, src)
+
+
+def test_mix_node_sums_with_per_input_gain():
+    """mix(2,2) with gains (1.0, 0.5) on inputs (a, b) emits a + 0.5*b."""
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inA = g.add_input(2)
+    inB = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    out = g.add_output(2)
+    g.connect(inA, mix, dst_port=0)
+    g.connect(inB, mix, dst_port=1)
+    g.connect(mix, out)
+    g.set_mix_gain(mix, 1, 0.5)
+    g.compile()
+
+    a = np.tile(np.array([1.0, 2.0], dtype=np.float32)[:, None], (1, F))
+    b = np.tile(np.array([4.0, 8.0], dtype=np.float32)[:, None], (1, F))
+    dst = np.zeros((2, F), dtype=np.float32)
+    g.render_block([a, b], [dst], F)
+    expected = a + 0.5 * b
+    np.testing.assert_array_almost_equal(dst, expected, decimal=6)
+
+
+def test_feedback_edge_delivers_previous_block():
+    """Self-feedback on a mix node is a one-block echo.
+
+    mix(2,2) with port 0 driven by the input and port 1 by its own
+    previous-block output (unit gains): block 1 passes the input through
+    unchanged (the holding buffer starts silent), block 2 emits
+    in2 + out1. Unit-gain float adds are exact, so compare exactly.
+    """
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    out = g.add_output(2)
+    g.connect(inp, mix, dst_port=0)
+    g.connect_feedback(mix, mix, dst_port=1)
+    g.connect(mix, out)
+    g.compile()
+
+    rng = np.random.default_rng(3)
+    in1 = rng.standard_normal((2, F)).astype(np.float32)
+    in2 = rng.standard_normal((2, F)).astype(np.float32)
+    out1 = np.zeros((2, F), dtype=np.float32)
+    out2 = np.zeros((2, F), dtype=np.float32)
+
+    g.render_block([in1], [out1], F)
+    np.testing.assert_array_equal(out1, in1)
+
+    g.render_block([in2], [out2], F)
+    np.testing.assert_array_equal(out2, in2 + out1)
+
+    # Recompiling resets the loop to silence.
+    g.begin_edit()
+    g.compile()
+    out3 = np.zeros((2, F), dtype=np.float32)
+    g.render_block([in1], [out3], F)
+    np.testing.assert_array_equal(out3, in1)
+
+
+def test_gain_change_takes_effect_without_recompile():
+    F = 8
+    g = minihost.PluginGraph(F, 48000.0)
+    inA = g.add_input(2)
+    inB = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    out = g.add_output(2)
+    g.connect(inA, mix, dst_port=0)
+    g.connect(inB, mix, dst_port=1)
+    g.connect(mix, out)
+    g.compile()
+
+    a = np.ones((2, F), dtype=np.float32)
+    b = np.full((2, F), 2.0, dtype=np.float32)
+    dst = np.zeros((2, F), dtype=np.float32)
+
+    g.render_block([a, b], [dst], F)
+    np.testing.assert_array_almost_equal(dst, a + b, decimal=6)
+
+    g.set_mix_gain(mix, 1, 0.25)
+    g.render_block([a, b], [dst], F)
+    np.testing.assert_array_almost_equal(dst, a + 0.25 * b, decimal=6)
+
+
+def test_fan_out_with_mix_reconvergence():
+    """One input fanned to both inputs of a mix is summed by the gains."""
+    F = 8
+    g = minihost.PluginGraph(F, 48000.0)
+    src = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    out = g.add_output(2)
+    g.connect(src, mix, dst_port=0)
+    g.connect(src, mix, dst_port=1)
+    g.connect(mix, out)
+    g.set_mix_gain(mix, 0, 0.4)
+    g.set_mix_gain(mix, 1, 0.6)
+    g.compile()
+
+    s = np.tile(np.arange(F, dtype=np.float32), (2, 1))
+    dst = np.zeros((2, F), dtype=np.float32)
+    g.render_block([s], [dst], F)
+    np.testing.assert_array_almost_equal(dst, s, decimal=6)
+
+
+def test_profiling_stats_accumulate_and_reset():
+    """Per-node profiling counts blocks once enabled; reset zeroes."""
+    F = 32
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(2)
+    out = g.add_output(2)
+    g.connect(inp, out)
+    g.compile()
+    assert not g.profiling
+    g.profiling = True
+
+    src = np.zeros((2, F), dtype=np.float32)
+    dst = np.zeros((2, F), dtype=np.float32)
+    for _ in range(10):
+        g.render_block([src], [dst], F)
+
+    s = g.node_stats(out)
+    assert s["blocks"] == 10
+    assert s["mean_us"] >= 0.0
+    assert s["max_us"] >= s["mean_us"]
+    assert s["p99_us"] > 0.0
+    assert s["denormal_hits"] == 0  # built-in node, no plugin counter
+    assert g.node_stats(inp)["blocks"] == 10
+
+    g.reset_node_stats()
+    s = g.node_stats(out)
+    assert s["blocks"] == 0
+    assert s["max_us"] == 0.0
+
+
+def test_profiling_disabled_records_nothing():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+
+    buf = np.zeros((1, F), dtype=np.float32)
+    dst = np.zeros((1, F), dtype=np.float32)
+    g.render_block([buf], [dst], F)
+    assert g.node_stats(out)["blocks"] == 0
+
+
+def test_node_stats_bad_id_raises():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+    with pytest.raises(RuntimeError, match="node_stats"):
+        g.node_stats(99)
+
+
+def test_node_meter_reports_peak_and_rms():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(2)
+    out = g.add_output(2)
+    g.connect(inp, out)
+    g.compile()
+    g.set_node_meter(out, True)
+
+    buf = np.zeros((2, F), dtype=np.float32)
+    buf[0, :] = 0.5          # constant: peak == rms == 0.5
+    buf[1, 0] = -1.0         # single full-scale sample
+    dst = np.zeros((2, F), dtype=np.float32)
+    g.render_block([buf], [dst], F)
+
+    peaks, rms = g.node_meter(out)
+    assert peaks[0] == pytest.approx(0.5)
+    assert rms[0] == pytest.approx(0.5)
+    assert peaks[1] == pytest.approx(1.0)
+    assert rms[1] == pytest.approx(1.0 / np.sqrt(F))
+
+
+def test_node_meter_disabled_raises():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+
+    buf = np.zeros((1, F), dtype=np.float32)
+    dst = np.zeros((1, F), dtype=np.float32)
+    g.render_block([buf], [dst], F)
+    with pytest.raises(RuntimeError, match="node_meter"):
+        g.node_meter(out)
+
+    # Re-enabling after a disable picks metering back up.
+    g.set_node_meter(out, True)
+    g.set_node_meter(out, False)
+    with pytest.raises(RuntimeError, match="node_meter"):
+        g.node_meter(out)
+
+
+def test_node_audio_tap_views_rendered_block():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(2)
+    mix = g.add_mix(1, 2)
+    out = g.add_output(2)
+    g.connect(inp, mix, dst_port=0)
+    g.connect(mix, out)
+    g.set_node_tap(mix)
+    g.compile()
+
+    # Before the first render the view is empty but well-formed.
+    view = g.node_audio(mix)
+    assert view.shape == (2, 0)
+
+    buf = np.zeros((2, F), dtype=np.float32)
+    buf[0, :] = 0.25
+    buf[1, :] = np.linspace(-1.0, 1.0, F, dtype=np.float32)
+    dst = np.zeros((2, F), dtype=np.float32)
+    g.render_block([buf], [dst], F)
+
+    view = g.node_audio(mix)
+    assert view.dtype == np.float32
+    assert view.shape == (2, F)
+    assert np.array_equal(view, buf)
+
+    # Zero-copy: the view aliases the graph's own buffer, so the next
+    # render overwrites it in place.
+    buf2 = np.full((2, F), 0.5, dtype=np.float32)
+    g.render_block([buf2], [dst], F)
+    assert np.array_equal(view, buf2)
+
+
+def test_node_audio_tap_validation():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    mix = g.add_mix(1, 1)
+    out = g.add_output(1)
+    g.connect(inp, mix, dst_port=0)
+    g.connect(mix, out)
+
+    # Input and output nodes carry the caller's audio, not pool audio.
+    with pytest.raises(RuntimeError, match="set_node_tap"):
+        g.set_node_tap(inp)
+    with pytest.raises(RuntimeError, match="set_node_tap"):
+        g.set_node_tap(out)
+
+    g.compile()
+    # Tapping is pre-compile configuration.
+    with pytest.raises(RuntimeError, match="set_node_tap"):
+        g.set_node_tap(mix)
+    # And borrowing an untapped node fails.
+    with pytest.raises(RuntimeError, match="node_audio"):
+        g.node_audio(mix)
+
+
+def test_trace_dump_writes_perfetto_json(tmp_path):
+    F = 16
+    n_blocks = 5
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+    g.set_tracing(1024)
+
+    buf = np.zeros((1, F), dtype=np.float32)
+    dst = np.zeros((1, F), dtype=np.float32)
+    for _ in range(n_blocks):
+        g.render_block([buf], [dst], F)
+
+    path = tmp_path / "trace.json"
+    g.trace_dump(str(path))
+
+    doc = json.loads(path.read_text())
+    events = doc["traceEvents"]
+    # One span per node per block (input and output nodes both render).
+    assert len(events) == 2 * n_blocks
+    for ev in events:
+        assert ev["ph"] == "X"
+        assert ev["dur"] >= 0
+        assert 1 <= ev["args"]["block"] <= n_blocks
+    names = {ev["name"] for ev in events}
+    assert names == {"node0:input", "node1:output"}
+
+
+def test_trace_ring_keeps_most_recent_spans(tmp_path):
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+    # Room for two blocks' worth of spans; render five blocks so the
+    # ring wraps and only the newest spans survive.
+    g.set_tracing(4)
+
+    buf = np.zeros((1, F), dtype=np.float32)
+    dst = np.zeros((1, F), dtype=np.float32)
+    for _ in range(5):
+        g.render_block([buf], [dst], F)
+
+    path = tmp_path / "trace.json"
+    g.trace_dump(str(path))
+    events = json.loads(path.read_text())["traceEvents"]
+    assert len(events) == 4
+    assert min(ev["args"]["block"] for ev in events) >= 4
+
+
+def test_trace_dump_without_tracing_raises(tmp_path):
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+    with pytest.raises(RuntimeError, match="tracing not enabled"):
+        g.trace_dump(str(tmp_path / "trace.json"))
+
+
+def test_silence_skip_only_affects_plugin_nodes():
+    # Skip targets plugin nodes; passthrough/mix topologies must render
+    # identically with it enabled, silent input or not.
+    F = 32
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(2)
+    out = g.add_output(2)
+    g.connect(inp, out)
+    g.compile()
+    g.set_silence_skip(True)
+
+    src = np.random.default_rng(seed=3).standard_normal((2, F)).astype(np.float32)
+    dst = np.zeros((2, F), dtype=np.float32)
+    g.render_block([src], [dst], F)
+    np.testing.assert_array_equal(dst, src)
+
+    silent = np.zeros((2, F), dtype=np.float32)
+    g.render_block([silent], [dst], F)
+    np.testing.assert_array_equal(dst, silent)
+
+
+def test_freeze_mix_node_replays_cached_blocks():
+    # Record a pass through a frozen mix node, then replay with
+    # different input: the output must reproduce the recorded material,
+    # proving the cache plays back instead of processing.
+    F = 32
+    n_blocks = 4
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(2)
+    mix = g.add_mix(1, 2)
+    out = g.add_output(2)
+    g.connect(inp, mix, dst_port=0)
+    g.connect(mix, out)
+    g.compile()
+
+    rng = np.random.default_rng(seed=11)
+    recorded = [rng.standard_normal((2, F)).astype(np.float32) for _ in range(n_blocks)]
+    dst = np.zeros((2, F), dtype=np.float32)
+
+    g.freeze_node(mix)
+    for src in recorded:
+        g.render_block([src], [dst], F)
+    g.freeze_finish(mix)
+
+    g.freeze_rewind()
+    silent = np.zeros((2, F), dtype=np.float32)
+    for src in recorded:
+        g.render_block([silent], [dst], F)
+        np.testing.assert_array_equal(dst, src)
+
+    # Unfreeze: live input flows again.
+    g.unfreeze_node(mix)
+    g.render_block([recorded[0]], [dst], F)
+    np.testing.assert_array_equal(dst, recorded[0])
+
+
+def test_freeze_replay_exhausted_cache_fails():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    mix = g.add_mix(1, 1)
+    out = g.add_output(1)
+    g.connect(inp, mix, dst_port=0)
+    g.connect(mix, out)
+    g.compile()
+
+    src = np.ones((1, F), dtype=np.float32)
+    dst = np.zeros((1, F), dtype=np.float32)
+    g.freeze_node(mix)
+    g.render_block([src], [dst], F)
+    g.freeze_finish(mix)
+
+    g.freeze_rewind()
+    g.render_block([src], [dst], F)
+    with pytest.raises(RuntimeError, match="render_block failed"):
+        g.render_block([src], [dst], F)  # one block cached, two asked
+
+
+def test_freeze_rejects_non_freezable_nodes():
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+    with pytest.raises(RuntimeError, match="only plugin and mix nodes"):
+        g.freeze_node(inp)
+    with pytest.raises(RuntimeError, match="only plugin and mix nodes"):
+        g.freeze_finish(out)
+
+
+def test_begin_edit_reopens_compiled_graph():
+    F = 32
+    g = minihost.PluginGraph(F, 48000.0)
+    a = g.add_input(2)
+    b = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    out = g.add_output(2)
+    g.connect(a, mix, dst_port=0)
+    g.connect(b, mix, dst_port=1)
+    g.connect(mix, out)
+    g.compile()
+
+    rng = np.random.default_rng(7)
+    buf_a = rng.standard_normal((2, F)).astype(np.float32)
+    buf_b = rng.standard_normal((2, F)).astype(np.float32)
+    out_buf = np.zeros((2, F), dtype=np.float32)
+    g.render_block([buf_a, buf_b], [out_buf], F)
+    np.testing.assert_allclose(out_buf, buf_a + buf_b, rtol=1e-6)
+
+    # Reopen, add a third input, and rewire mix port 1 to it (connect
+    # overwrites the existing edge for that dst port).
+    g.begin_edit()
+    c = g.add_input(2)
+    g.connect(c, mix, dst_port=1)
+    g.compile()
+
+    buf_c = rng.standard_normal((2, F)).astype(np.float32)
+    out_buf[:] = 0.0
+    g.render_block([buf_a, buf_b, buf_c], [out_buf], F)
+    np.testing.assert_allclose(out_buf, buf_a + buf_c, rtol=1e-6)
+
+
+def test_begin_edit_requires_compiled_graph():
+    g = minihost.PluginGraph(32, 48000.0)
+    g.add_input(2)
+    with pytest.raises(RuntimeError, match="not compiled"):
+        g.begin_edit()
+
+
+def _mix_graph(F=16):
+    """in(a) + 0.5*in(b) -> out, used by the plan-snapshot tests."""
+    g = minihost.PluginGraph(F, 48000.0)
+    inA = g.add_input(2)
+    inB = g.add_input(2)
+    mix = g.add_mix(2, 2)
+    out = g.add_output(2)
+    g.connect(inA, mix, dst_port=0)
+    g.connect(inB, mix, dst_port=1)
+    g.connect(mix, out)
+    g.set_mix_gain(mix, 1, 0.5)
+    return g
+
+
+def test_plan_snapshot_round_trip():
+    """A plan exported from one graph compiles an identical rebuild and
+    renders the same values."""
+    F = 16
+    g1 = _mix_graph(F)
+    g1.compile()
+    plan = g1.export_plan()
+    assert isinstance(plan, bytes) and len(plan) > 0
+
+    g2 = _mix_graph(F)
+    g2.set_plan(plan)
+    g2.compile()
+
+    a = np.tile(np.array([1.0, 2.0], dtype=np.float32)[:, None], (1, F))
+    b = np.tile(np.array([4.0, 8.0], dtype=np.float32)[:, None], (1, F))
+    dst = np.zeros((2, F), dtype=np.float32)
+    g2.render_block([a, b], [dst], F)
+    np.testing.assert_array_almost_equal(dst, a + 0.5 * b, decimal=6)
+
+
+def test_stale_plan_is_ignored():
+    """A plan from a different shape must not bypass validation: a
+    cyclic graph still fails compile with the plan staged."""
+    g1 = _mix_graph()
+    g1.compile()
+    plan = g1.export_plan()
+
+    g2 = minihost.PluginGraph(16, 48000.0)
+    m1 = g2.add_mix(1, 2)
+    m2 = g2.add_mix(1, 2)
+    out = g2.add_output(2)
+    g2.connect(m1, m2)
+    g2.connect(m2, m1)
+    g2.connect(m2, out)
+    g2.set_plan(plan)
+    with pytest.raises(RuntimeError, match="cycle"):
+        g2.compile()
+
+
+def test_plan_requires_compiled_graph():
+    g = minihost.PluginGraph(16, 48000.0)
+    g.add_input(2)
+    with pytest.raises(RuntimeError, match="not compiled"):
+        g.export_plan()
+
+
+def test_set_plan_rejects_garbage_and_post_compile():
+    g = _mix_graph()
+    with pytest.raises(RuntimeError):
+        g.set_plan(b"short")
+    g.compile()
+    with pytest.raises(RuntimeError):
+        g.set_plan(b"\x00" * 64)
+
+
+def test_resample_unity_ratio_is_passthrough():
+    """source_rate == graph rate: step is exactly 1.0, so every output
+    sample lands on an integer FIFO position and comes out bit-exact."""
+    F = 64
+    g = minihost.PluginGraph(F, 48000.0)
+    rs = g.add_resample(2, 48000.0)
+    out = g.add_output(2)
+    g.connect(rs, out)
+    g.compile()
+
+    rng = np.random.default_rng(11)
+    src = rng.standard_normal((2, F)).astype(np.float32)
+    assert g.resample_frames_needed(rs, F) == F + 1
+    # Prime one frame beyond the block: the last output sample
+    # interpolates between source frames F-1 and F.
+    g.resample_write(rs, src)
+    g.resample_write(rs, np.zeros((2, 1), dtype=np.float32))
+
+    out_buf = np.zeros((2, F), dtype=np.float32)
+    g.render_block([], [out_buf], F)
+    np.testing.assert_array_equal(out_buf, src)
+    assert g.resample_frames_needed(rs, F) == F
+
+
+def test_resample_2to1_matches_numpy_interp():
+    """96k source into a 48k graph: step 2.0, linear interpolation
+    between the bracketing source frames."""
+    F = 32
+    g = minihost.PluginGraph(F, 48000.0)
+    rs = g.add_resample(1, 96000.0)
+    out = g.add_output(1)
+    g.connect(rs, out)
+    g.compile()
+
+    n_src = g.resample_frames_needed(rs, F)
+    assert n_src == 2 * (F - 1) + 2
+    src = np.linspace(0.0, 1.0, int(n_src), dtype=np.float32)
+    g.resample_write(rs, src[np.newaxis, :])
+
+    out_buf = np.zeros((1, F), dtype=np.float32)
+    g.render_block([], [out_buf], F)
+
+    ref = np.interp(np.arange(F) * 2.0, np.arange(int(n_src)),
+                    src.astype(np.float64)).astype(np.float32)
+    np.testing.assert_allclose(out_buf[0], ref, atol=1e-6)
+
+
+def test_resample_underrun_emits_silence_and_advances():
+    """An unprimed node renders zeros; the read position still moves,
+    so late writes do not shift the timeline."""
+    F = 16
+    g = minihost.PluginGraph(F, 48000.0)
+    rs = g.add_resample(1, 48000.0)
+    out = g.add_output(1)
+    g.connect(rs, out)
+    g.compile()
+
+    out_buf = np.ones((1, F), dtype=np.float32)
+    g.render_block([], [out_buf], F)
+    np.testing.assert_array_equal(out_buf, np.zeros((1, F), dtype=np.float32))
+    # The skipped block is gone for good: the node now wants frames
+    # for positions F .. 2F, not 0 .. F.
+    assert g.resample_frames_needed(rs, F) == 2 * F + 1
+
+
+def test_resample_write_validates_shape_and_capacity():
+    F = 32
+    g = minihost.PluginGraph(F, 48000.0)
+    rs = g.add_resample(2, 48000.0)
+    out = g.add_output(2)
+    g.connect(rs, out)
+    g.compile()
+
+    with pytest.raises(RuntimeError, match="resample_write failed"):
+        g.resample_write(rs, np.zeros((1, F), dtype=np.float32))  # 1ch into 2ch node
+    # FIFO holds four graph blocks (plus interpolation slack); a fifth
+    # unread block must be refused rather than clobber queued audio.
+    for _ in range(4):
+        g.resample_write(rs, np.zeros((2, F), dtype=np.float32))
+    with pytest.raises(RuntimeError, match="resample_write failed"):
+        g.resample_write(rs, np.zeros((2, F), dtype=np.float32))
+
+
+def test_convolve_identity_ir_delays_by_one_partition():
+    """A one-tap unity IR makes the node a pure delay of one partition
+    (the FFT buffering latency, reported via latency_samples)."""
+    F = 64
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    cv = g.add_convolve(1, np.array([[1.0]], dtype=np.float32))
+    out = g.add_output(1)
+    g.connect(inp, cv)
+    g.connect(cv, out)
+    g.compile()
+    assert g.latency_samples == F  # partition == max_block_size here
+
+    rng = np.random.default_rng(3)
+    x = rng.standard_normal((1, F)).astype(np.float32)
+    out_buf = np.zeros((1, F), dtype=np.float32)
+    g.render_block([x], [out_buf], F)
+    np.testing.assert_allclose(out_buf, np.zeros((1, F)), atol=1e-6)
+
+    g.render_block([np.zeros((1, F), dtype=np.float32)], [out_buf], F)
+    np.testing.assert_allclose(out_buf, x, atol=1e-5)
+
+
+def test_convolve_matches_numpy_convolve():
+    """Multi-partition IR, block size below the partition hop (48 < 64):
+    partial hops must still line up with a direct np.convolve."""
+    F = 48
+    g = minihost.PluginGraph(F, 48000.0)
+    rng = np.random.default_rng(17)
+    ir = rng.standard_normal((1, 100)).astype(np.float32)  # 2 partitions
+    inp = g.add_input(1)
+    cv = g.add_convolve(1, ir)
+    out = g.add_output(1)
+    g.connect(inp, cv)
+    g.connect(cv, out)
+    g.compile()
+    lat = g.latency_samples
+    assert lat == 64  # next pow2 above the 48-frame block size
+
+    x = rng.standard_normal(4 * F).astype(np.float32)
+    got = np.zeros(4 * F, dtype=np.float32)
+    out_buf = np.zeros((1, F), dtype=np.float32)
+    for b in range(4):
+        xb = x[b * F:(b + 1) * F][np.newaxis, :].copy()
+        g.render_block([xb], [out_buf], F)
+        got[b * F:(b + 1) * F] = out_buf[0]
+
+    ref = np.convolve(x.astype(np.float64), ir[0].astype(np.float64))
+    np.testing.assert_allclose(got[lat:], ref[:4 * F - lat], atol=1e-3)
+    np.testing.assert_allclose(got[:lat], np.zeros(lat), atol=1e-6)
+
+
+def test_node_bypass_rejects_non_plugin_nodes():
+    g = minihost.PluginGraph(32, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    with pytest.raises(RuntimeError, match="set_node_bypass failed"):
+        g.set_node_bypass(inp, True)  # not compiled yet
+    g.compile()
+    with pytest.raises(RuntimeError, match="set_node_bypass failed"):
+        g.set_node_bypass(inp, True)  # not a plugin node
+    assert not g.get_node_bypass(inp)
+
+
+def test_governor_config_validation():
+    g = minihost.PluginGraph(32, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    with pytest.raises(RuntimeError, match="set_governor failed"):
+        g.set_governor()  # not compiled yet
+    g.compile()
+
+    # Shed ranks only apply to plugin nodes
+    with pytest.raises(RuntimeError, match="set_node_sacrificial failed"):
+        g.set_node_sacrificial(inp, 0)
+    assert g.get_node_sacrificial(inp) == -1
+
+    # release_load must sit below engage_load (hysteresis gap)
+    with pytest.raises(RuntimeError, match="set_governor failed"):
+        g.set_governor(engage_load=0.8, release_load=0.9)
+    with pytest.raises(RuntimeError, match="set_governor failed"):
+        g.set_governor(engage_blocks=0)
+
+    g.set_governor()
+    assert g.governor_shed_count() == 0
 
+    # A trivial graph never overloads: rendering sheds nothing
+    x = np.zeros((1, 32), dtype=np.float32)
+    dst = np.zeros((1, 32), dtype=np.float32)
+    for _ in range(32):
+        g.render_block([x], [dst], 32)
+    assert g.governor_shed_count() == 0
 
-def test_mix_node_sums_with_per_input_gain():
-    """mix(2,2) with gains (1.0, 0.5) on inputs (a, b) emits a + 0.5*b."""
+    g.clear_governor()
+    assert g.governor_shed_count() == 0
+
+
+def test_pool_huge_pages_renders_identically():
+    """Huge-page arena backing is a layout hint; output must not change."""
     F = 16
     g = minihost.PluginGraph(F, 48000.0)
+    g.set_pool_huge_pages(True)
     inA = g.add_input(2)
     inB = g.add_input(2)
     mix = g.add_mix(2, 2)
@@ -162,13 +909,18 @@ def test_mix_node_sums_with_per_input_gain():
     b = np.tile(np.array([4.0, 8.0], dtype=np.float32)[:, None], (1, F))
     dst = np.zeros((2, F), dtype=np.float32)
     g.render_block([a, b], [dst], F)
-    expected = a + 0.5 * b
-    np.testing.assert_array_almost_equal(dst, expected, decimal=6)
+    np.testing.assert_array_almost_equal(dst, a + 0.5 * b, decimal=6)
 
+    # Once compiled the flag is frozen for this compile cycle.
+    with pytest.raises(RuntimeError, match="set_pool_huge_pages failed"):
+        g.set_pool_huge_pages(False)
 
-def test_gain_change_takes_effect_without_recompile():
-    F = 8
+
+def test_lock_memory_renders_identically():
+    """Arena residency is best-effort and must not change the output."""
+    F = 16
     g = minihost.PluginGraph(F, 48000.0)
+    g.set_lock_memory(True)
     inA = g.add_input(2)
     inB = g.add_input(2)
     mix = g.add_mix(2, 2)
@@ -176,38 +928,58 @@ def test_gain_change_takes_effect_without_recompile():
     g.connect(inA, mix, dst_port=0)
     g.connect(inB, mix, dst_port=1)
     g.connect(mix, out)
+    g.set_mix_gain(mix, 1, 0.5)
     g.compile()
 
-    a = np.ones((2, F), dtype=np.float32)
-    b = np.full((2, F), 2.0, dtype=np.float32)
-    dst = np.zeros((2, F), dtype=np.float32)
+    # 0 is legal (RLIMIT_MEMLOCK refusal is the graceful fallback);
+    # what must hold is that the figure is reported, not guessed.
+    assert g.locked_bytes >= 0
 
+    a = np.tile(np.array([1.0, 2.0], dtype=np.float32)[:, None], (1, F))
+    b = np.tile(np.array([4.0, 8.0], dtype=np.float32)[:, None], (1, F))
+    dst = np.zeros((2, F), dtype=np.float32)
     g.render_block([a, b], [dst], F)
-    np.testing.assert_array_almost_equal(dst, a + b, decimal=6)
+    np.testing.assert_array_almost_equal(dst, a + 0.5 * b, decimal=6)
 
-    g.set_mix_gain(mix, 1, 0.25)
-    g.render_block([a, b], [dst], F)
-    np.testing.assert_array_almost_equal(dst, a + 0.25 * b, decimal=6)
+    # Once compiled the flag is frozen for this compile cycle.
+    with pytest.raises(RuntimeError, match="set_lock_memory failed"):
+        g.set_lock_memory(False)
 
 
-def test_fan_out_with_mix_reconvergence():
-    """One input fanned to both inputs of a mix is summed by the gains."""
-    F = 8
+def test_render_block_into_matches_render_block():
+    """The AudioBuffer fast path renders the same samples as render_block."""
+    F = 16
     g = minihost.PluginGraph(F, 48000.0)
-    src = g.add_input(2)
+    inA = g.add_input(2)
+    inB = g.add_input(2)
     mix = g.add_mix(2, 2)
     out = g.add_output(2)
-    g.connect(src, mix, dst_port=0)
-    g.connect(src, mix, dst_port=1)
+    g.connect(inA, mix, dst_port=0)
+    g.connect(inB, mix, dst_port=1)
     g.connect(mix, out)
-    g.set_mix_gain(mix, 0, 0.4)
-    g.set_mix_gain(mix, 1, 0.6)
+    g.set_mix_gain(mix, 1, 0.5)
     g.compile()
 
-    s = np.tile(np.arange(F, dtype=np.float32), (2, 1))
+    a = np.tile(np.array([1.0, 2.0], dtype=np.float32)[:, None], (1, F))
+    b = np.tile(np.array([4.0, 8.0], dtype=np.float32)[:, None], (1, F))
     dst = np.zeros((2, F), dtype=np.float32)
-    g.render_block([s], [dst], F)
-    np.testing.assert_array_almost_equal(dst, s, decimal=6)
+    g.render_block([a, b], [dst], F)
+
+    buf_a = minihost.AudioBuffer(2, F)
+    buf_b = minihost.AudioBuffer(2, F)
+    buf_out = minihost.AudioBuffer(2, F)
+    buf_a[:, :] = a
+    buf_b[:, :] = b
+    g.render_block_into([buf_a, buf_b], [buf_out], F)
+    np.testing.assert_array_equal(buf_out.as_ndarray(), dst)
+
+
+def test_convolve_validates_ir_shape():
+    g = minihost.PluginGraph(32, 48000.0)
+    with pytest.raises(RuntimeError, match="IR must have 1 channel or match"):
+        g.add_convolve(2, np.zeros((3, 10), dtype=np.float32))
+    with pytest.raises(RuntimeError, match="non-empty IR"):
+        g.add_convolve(2, np.zeros((1, 0), dtype=np.float32))
 
 
 # -------------------------------------------------------------------- #
@@ -306,6 +1078,546 @@ def test_graph_automation_matches_plugin_process_auto():
     np.testing.assert_allclose(out_g, out_ref, atol=1e-5, rtol=1e-5)
 
 
+@skip_if_no_plugin
+def test_graph_modulation_matches_equivalent_automation():
+    """A modulation edge sampled every 64 frames must render identically
+    to feeding the equivalent points through process_auto by hand (the
+    event-flood pattern modulation edges replace).
+    """
+    sr = 48000
+    block = 256
+    step = 64
+
+    p_ref = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+    in_ch = p_ref.num_input_channels
+    out_ch = p_ref.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    if p_ref.num_params == 0:
+        pytest.skip("plugin has no params")
+
+    rng = np.random.default_rng(7)
+    in_buf = (rng.standard_normal((in_ch, block)) * 0.05).astype(np.float32)
+    # Bipolar LFO ramp fed in as an extra graph input.
+    lfo = np.linspace(-1.0, 1.0, block, dtype=np.float32)[None, :]
+
+    # Reference: the points a linear curve with base=0, depth=1 should
+    # synthesize, applied through process_auto.
+    points = [
+        (off, 0, float(np.clip(0.5 * lfo[0, off] + 0.5, 0.0, 1.0)))
+        for off in range(0, block, step)
+    ]
+    out_ref = np.zeros((out_ch, block), dtype=np.float32)
+    p_ref.process_auto(in_buf, out_ref, [], points)
+
+    p_graph = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+    g = minihost.PluginGraph(block, float(sr))
+    in_node = g.add_input(in_ch)
+    lfo_node = g.add_input(1)
+    pl_node = g.add_plugin(p_graph)
+    out_node = g.add_output(out_ch)
+    g.connect(in_node, pl_node)
+    g.connect(pl_node, out_node)
+    g.connect_modulation(lfo_node, 0, pl_node, 0)
+    g.set_modulation_interval(step)
+    g.compile()
+    out_g = np.zeros((out_ch, block), dtype=np.float32)
+    g.render_block([in_buf, lfo], [out_g], block)
+
+    np.testing.assert_allclose(out_g, out_ref, atol=1e-5, rtol=1e-5)
+
+
+@skip_if_no_plugin
+def test_graph_automation_timeline_matches_per_block_staging():
+    """A whole-render timeline (absolute offsets, set once) must render
+    identically to staging the same changes block by block with
+    block-local offsets via set_node_automation.
+    """
+    sr = 48000
+    block = 256
+    blocks = 4
+
+    probe = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+    in_ch = probe.num_input_channels
+    out_ch = probe.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    if probe.num_params == 0:
+        pytest.skip("plugin has no params")
+
+    rng = np.random.default_rng(41)
+    audio = (rng.standard_normal((in_ch, block * blocks)) * 0.05).astype(
+        np.float32
+    )
+    # Absolute offsets spanning three different blocks (none in block 2).
+    timeline = [(50, 0, 0.7), (block + 10, 0, 0.2), (3 * block + 200, 0, 0.9)]
+
+    def make_graph():
+        p = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+        g = minihost.PluginGraph(block, float(sr))
+        in_node = g.add_input(in_ch)
+        pl_node = g.add_plugin(p)
+        out_node = g.add_output(out_ch)
+        g.connect(in_node, pl_node)
+        g.connect(pl_node, out_node)
+        g.compile()
+        return p, g, pl_node
+
+    def render(g, pl_node, stage_block):
+        out = np.zeros((out_ch, block * blocks), dtype=np.float32)
+        out_buf = np.zeros((out_ch, block), dtype=np.float32)
+        for b in range(blocks):
+            stage_block(g, pl_node, b)
+            start = b * block
+            g.render_block([audio[:, start : start + block]], [out_buf], block)
+            out[:, start : start + block] = out_buf
+        return out
+
+    # Reference: slice the timeline per block in Python (the pattern the
+    # timeline API replaces).
+    def stage_slice(g, pl_node, b):
+        lo, hi = b * block, (b + 1) * block
+        g.set_node_automation(
+            pl_node, [(off - lo, idx, v) for off, idx, v in timeline if lo <= off < hi]
+        )
+
+    p1, g1, n1 = make_graph()
+    ref = render(g1, n1, stage_slice)
+
+    p2, g2, n2 = make_graph()
+    g2.set_node_automation_timeline(n2, timeline)
+    actual = render(g2, n2, lambda *_: None)
+
+    np.testing.assert_allclose(actual, ref, atol=1e-5, rtol=1e-5)
+
+    # Seeking back and re-rendering replays the timeline from the top.
+    g2.seek_automation(0)
+    replay = render(g2, n2, lambda *_: None)
+    assert np.all(np.isfinite(replay))
+
+
+@skip_if_no_plugin
+def test_graph_automation_curves_match_per_block_evaluation():
+    """Native keyframe curves (set once, evaluated per block in the
+    graph) must render identically to evaluating the same piecewise-
+    linear curve in Python per block and staging the value at offset 0
+    via set_node_automation.
+    """
+    sr = 48000
+    block = 256
+    blocks = 6
+
+    probe = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+    in_ch = probe.num_input_channels
+    out_ch = probe.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    if probe.num_params == 0:
+        pytest.skip("plugin has no params")
+
+    rng = np.random.default_rng(43)
+    audio = (rng.standard_normal((in_ch, block * blocks)) * 0.05).astype(
+        np.float32
+    )
+    # A ramp spanning several blocks, then a plateau past the last
+    # keyframe (clamped).
+    keyframes = [(0, 0, 0.1), (3 * block, 0, 0.9), (4 * block, 0, 0.5)]
+
+    def value_at(frame):
+        pts = [(s, v) for s, _, v in keyframes]
+        if frame <= pts[0][0]:
+            return pts[0][1]
+        if frame >= pts[-1][0]:
+            return pts[-1][1]
+        for (s0, v0), (s1, v1) in zip(pts, pts[1:]):
+            if s0 <= frame < s1:
+                return v0 + (frame - s0) / (s1 - s0) * (v1 - v0)
+        return pts[-1][1]
+
+    def make_graph():
+        p = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+        g = minihost.PluginGraph(block, float(sr))
+        in_node = g.add_input(in_ch)
+        pl_node = g.add_plugin(p)
+        out_node = g.add_output(out_ch)
+        g.connect(in_node, pl_node)
+        g.connect(pl_node, out_node)
+        g.compile()
+        return p, g, pl_node
+
+    def render(g, pl_node, stage_block):
+        out = np.zeros((out_ch, block * blocks), dtype=np.float32)
+        out_buf = np.zeros((out_ch, block), dtype=np.float32)
+        for b in range(blocks):
+            stage_block(g, pl_node, b)
+            start = b * block
+            g.render_block([audio[:, start : start + block]], [out_buf], block)
+            out[:, start : start + block] = out_buf
+        return out
+
+    # Reference: evaluate the curve at each block start in Python (the
+    # expansion pattern the native curves replace).
+    def stage_eval(g, pl_node, b):
+        g.set_node_automation(pl_node, [(0, 0, float(value_at(b * block)))])
+
+    p1, g1, n1 = make_graph()
+    ref = render(g1, n1, stage_eval)
+
+    p2, g2, n2 = make_graph()
+    g2.set_node_automation_curves(n2, list(keyframes))
+    actual = render(g2, n2, lambda *_: None)
+
+    np.testing.assert_allclose(actual, ref, atol=1e-5, rtol=1e-5)
+
+    # Seeking into the plateau re-establishes the clamped value.
+    g2.seek_automation(5 * block)
+    tail = render(g2, n2, lambda *_: None)
+    assert np.all(np.isfinite(tail))
+
+
+@skip_if_no_plugin
+def test_seek_automation_state_reconstructs_timeline_value():
+    """seek_automation_state(frame) must leave the plugin in the state
+    a replay from zero would have reached. With all timeline changes
+    landing before the seek point, a plain seek would render with stale
+    parameter state; the state seek must match a fresh graph where the
+    replayed end-state is applied by hand.
+    """
+    sr = 48000
+    block = 256
+    blocks = 6
+
+    probe = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+    in_ch = probe.num_input_channels
+    out_ch = probe.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    if probe.num_params == 0:
+        pytest.skip("plugin has no params")
+
+    rng = np.random.default_rng(44)
+    audio = (rng.standard_normal((in_ch, block * blocks)) * 0.05).astype(
+        np.float32
+    )
+    # Both changes land before the seek point, so only state
+    # reconstruction can account for them.
+    timeline = [(10, 0, 0.9), (block + 20, 0, 0.25)]
+    seek_block = 3
+
+    def make_graph():
+        p = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+        g = minihost.PluginGraph(block, float(sr))
+        in_node = g.add_input(in_ch)
+        pl_node = g.add_plugin(p)
+        out_node = g.add_output(out_ch)
+        g.connect(in_node, pl_node)
+        g.connect(pl_node, out_node)
+        g.compile()
+        g.set_node_automation_timeline(pl_node, timeline)
+        return p, g, pl_node
+
+    def render(g, b0, b1):
+        out = np.zeros((out_ch, block * (b1 - b0)), dtype=np.float32)
+        out_buf = np.zeros((out_ch, block), dtype=np.float32)
+        for i, b in enumerate(range(b0, b1)):
+            start = b * block
+            g.render_block([audio[:, start : start + block]], [out_buf], block)
+            out[:, i * block : (i + 1) * block] = out_buf
+        return out
+
+    # Reference: fresh graph, plain seek, last timeline value applied
+    # by hand -- exactly the state a replay would have left behind.
+    p1, g1, n1 = make_graph()
+    g1.seek_automation(seek_block * block)
+    p1.set_param(0, 0.25)
+    ref = render(g1, seek_block, blocks)
+
+    p2, g2, n2 = make_graph()
+    g2.seek_automation_state(seek_block * block)
+    tail = render(g2, seek_block, blocks)
+
+    np.testing.assert_allclose(tail, ref, atol=1e-5, rtol=1e-5)
+
+
+@skip_if_no_plugin
+def test_watchdog_supervised_render():
+    """With a generous watchdog timeout a well-behaved plugin renders
+    normally through the supervision thread: no trips, no failed
+    nodes, finite audio. Also covers the failed-flag round trip and
+    argument validation.
+    """
+    sr = 48000
+    block = 256
+    p = minihost.Plugin(PLUGIN, sample_rate=sr, max_block_size=block)
+    in_ch = p.num_input_channels
+    out_ch = p.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    g = minihost.PluginGraph(block, float(sr))
+    in_node = g.add_input(in_ch)
+    pl_node = g.add_plugin(p)
+    out_node = g.add_output(out_ch)
+    g.connect(in_node, pl_node)
+    g.connect(pl_node, out_node)
+    g.compile()
+
+    with pytest.raises(RuntimeError):
+        g.set_watchdog(-1)
+    g.set_watchdog(5000)
+
+    rng = np.random.default_rng(45)
+    audio = (rng.standard_normal((in_ch, block)) * 0.1).astype(np.float32)
+    out_buf = np.zeros((out_ch, block), dtype=np.float32)
+    for _ in range(4):
+        g.render_block([audio], [out_buf], block)
+        assert np.all(np.isfinite(out_buf))
+
+    assert g.watchdog_trips == 0
+    assert not g.node_failed(pl_node)
+    with pytest.raises(RuntimeError):
+        g.node_failed(999)
+    g.clear_node_failed(pl_node)
+    assert not g.node_failed(pl_node)
+
+    # Disabling puts processing back on the render thread.
+    g.set_watchdog(0)
+    g.render_block([audio], [out_buf], block)
+    assert np.all(np.isfinite(out_buf))
+
+
+def _hash_graph():
+    """input -> mix -> output: deterministic built-in nodes, so two
+    identical runs must produce identical digests without a plugin."""
+    F = 64
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(2)
+    mix = g.add_mix(1, 2)
+    out = g.add_output(2)
+    g.connect(inp, mix)
+    g.connect(mix, out)
+    g.compile()
+    return g, mix, F
+
+
+def test_hashing_digests_match_across_identical_runs():
+    g, _mix, F = _hash_graph()
+    rng = np.random.default_rng(46)
+    src = rng.standard_normal((2, F)).astype(np.float32)
+    dst = np.zeros((2, F), dtype=np.float32)
+
+    g.set_hashing(1)
+    assert g.hashing == 1
+    for _ in range(4):
+        g.render_block([src], [dst], F)
+    first = g.render_digest
+    assert first != 0
+
+    # set_hashing restarts the run; an identical block sequence must
+    # land on an identical digest.
+    g.set_hashing(1)
+    assert g.render_digest == 0
+    for _ in range(4):
+        g.render_block([src], [dst], F)
+    assert g.render_digest == first
+
+
+def test_hashing_digest_detects_divergence():
+    g, _mix, F = _hash_graph()
+    rng = np.random.default_rng(47)
+    src = rng.standard_normal((2, F)).astype(np.float32)
+    dst = np.zeros((2, F), dtype=np.float32)
+
+    g.set_hashing(1)
+    g.render_block([src], [dst], F)
+    clean = g.render_digest
+
+    diverged = src.copy()
+    diverged[0, 13] += 1e-7  # one sample, one ULP-ish nudge
+    g.set_hashing(1)
+    g.render_block([diverged], [dst], F)
+    assert g.render_digest != clean
+
+
+def test_hashing_mode2_localizes_per_node():
+    """Paranoid mode: every audio node carries its own digest, and a
+    divergence shows up in each node downstream of (and including)
+    where it entered."""
+    g, mix, F = _hash_graph()
+    rng = np.random.default_rng(48)
+    src = rng.standard_normal((2, F)).astype(np.float32)
+    dst = np.zeros((2, F), dtype=np.float32)
+
+    g.set_hashing(2)
+    g.render_block([src], [dst], F)
+    baseline = g.node_digest(mix)
+    assert baseline != 0
+
+    g.set_hashing(2)
+    g.render_block([src], [dst], F)
+    assert g.node_digest(mix) == baseline
+
+    diverged = src.copy()
+    diverged[1, 0] = -diverged[1, 0]
+    g.set_hashing(2)
+    g.render_block([diverged], [dst], F)
+    assert g.node_digest(mix) != baseline
+
+
+def test_hashing_argument_validation():
+    g, _mix, _F = _hash_graph()
+    assert g.hashing == 0
+    with pytest.raises(RuntimeError):
+        g.set_hashing(3)
+    with pytest.raises(RuntimeError):
+        g.set_hashing(-1)
+    with pytest.raises(RuntimeError):
+        g.node_digest(999)
+    g.set_hashing(0)
+
+
+@skip_if_no_plugin
+def test_oversampled_plugin_node_renders():
+    """A 2x-oversampled plugin node compiles, reports the wrapper's
+    filter delay in latency_samples, and renders finite audio. (The
+    plugin must be opened at 2x the graph rate and block size.)"""
+    F = 128
+    p = minihost.Plugin(PLUGIN, sample_rate=96000, max_block_size=2 * F)
+    in_ch = p.num_input_channels
+    out_ch = p.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(in_ch)
+    node = g.add_plugin_oversampled(p, 2)
+    out = g.add_output(out_ch)
+    g.connect(inp, node)
+    g.connect(node, out)
+    g.compile()
+    assert g.latency_samples >= 60  # the 2x wrapper's FIR group delay
+
+    rng = np.random.default_rng(23)
+    in_buf = (0.1 * rng.standard_normal((in_ch, F))).astype(np.float32)
+    out_buf = np.zeros((out_ch, F), dtype=np.float32)
+    g.render_block([in_buf], [out_buf], F)
+    g.render_block([in_buf], [out_buf], F)
+    assert np.all(np.isfinite(out_buf))
+
+
+@skip_if_no_plugin
+def test_node_bypass_passes_dry_signal_through():
+    """A bypassed plugin node forwards its input untouched (delayed by
+    the node's compiled latency so toggling stays phase-aligned)."""
+    F = 256
+    p = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=F)
+    in_ch = p.num_input_channels
+    out_ch = p.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    if in_ch != out_ch:
+        pytest.skip("bypass passthrough test wants matching widths")
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(in_ch)
+    node = g.add_plugin(p)
+    out = g.add_output(out_ch)
+    g.connect(inp, node)
+    g.connect(node, out)
+    g.compile()
+
+    g.set_node_bypass(node, True)
+    assert g.get_node_bypass(node)
+
+    lat = g.latency_samples
+    blocks = lat // F + 2
+    rng = np.random.default_rng(29)
+    x = rng.standard_normal((in_ch, blocks * F)).astype(np.float32)
+    got = np.zeros((out_ch, blocks * F), dtype=np.float32)
+    out_buf = np.zeros((out_ch, F), dtype=np.float32)
+    for b in range(blocks):
+        xb = np.ascontiguousarray(x[:, b * F:(b + 1) * F])
+        g.render_block([xb], [out_buf], F)
+        got[:, b * F:(b + 1) * F] = out_buf
+    # Dry passthrough: exact copy, shifted by the compiled latency.
+    np.testing.assert_array_equal(got[:, lat:], x[:, :blocks * F - lat])
+
+    g.set_node_bypass(node, False)
+    assert not g.get_node_bypass(node)
+    g.render_block([np.zeros((in_ch, F), dtype=np.float32)], [out_buf], F)
+    assert np.all(np.isfinite(out_buf))
+
+
+@skip_if_no_plugin
+def test_node_mix_full_dry_reproduces_input():
+    """mix=0.0 blends the node's output entirely back to its dry input
+    (read live from the input buffers, no latency shift), and the mix
+    round-trips through get_node_mix."""
+    F = 256
+    p = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=F)
+    in_ch = p.num_input_channels
+    out_ch = p.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    if in_ch != out_ch:
+        pytest.skip("node mix wants matching widths")
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(in_ch)
+    node = g.add_plugin(p)
+    out = g.add_output(out_ch)
+    g.connect(inp, node)
+    g.connect(node, out)
+
+    with pytest.raises(RuntimeError, match="set_node_mix failed"):
+        g.set_node_mix(node, 0.5)  # not compiled yet
+    g.compile()
+    with pytest.raises(RuntimeError, match="set_node_mix failed"):
+        g.set_node_mix(inp, 0.5)  # not a plugin node
+    with pytest.raises(ValueError):
+        g.set_node_mix(node, 1.5)
+
+    assert g.get_node_mix(node) == pytest.approx(1.0)
+    g.set_node_mix(node, 0.3)
+    assert g.get_node_mix(node) == pytest.approx(0.3, abs=1e-6)
+
+    g.set_node_mix(node, 0.0)
+    rng = np.random.default_rng(31)
+    in_buf = (0.1 * rng.standard_normal((in_ch, F))).astype(np.float32)
+    out_buf = np.zeros((out_ch, F), dtype=np.float32)
+    g.render_block([in_buf], [out_buf], F)
+    np.testing.assert_array_equal(out_buf, in_buf)
+
+    g.set_node_mix(node, 1.0)
+    g.render_block([in_buf], [out_buf], F)
+    assert np.all(np.isfinite(out_buf))
+
+
+@skip_if_no_plugin
+def test_node_sidechain_port_introspection():
+    """A plugin opened without a sidechain bus exposes no sidechain
+    port: get_node_sidechain_port reports -1 and connect rejects the
+    out-of-range dst_port. (Wiring a live key signal needs a
+    sidechain-capable plugin, which the test plugin is not.)"""
+    F = 256
+    p = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=F)
+    in_ch = p.num_input_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(in_ch)
+    node = g.add_plugin(p)
+    assert g.get_node_sidechain_port(node) == -1
+    assert g.get_node_sidechain_port(inp) == -1
+    assert g.get_node_sidechain_port(999) == -1
+    with pytest.raises(RuntimeError, match="out of range"):
+        g.connect(inp, node, dst_port=1)
+
+
+@skip_if_no_plugin
+def test_add_plugin_oversampled_rejects_bad_factor():
+    p = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=256)
+    g = minihost.PluginGraph(256, 48000.0)
+    with pytest.raises(RuntimeError, match="factor must be 1, 2 or 4"):
+        g.add_plugin_oversampled(p, 3)
+
+
 @skip_if_no_plugin
 def test_plugin_node_keeps_plugin_alive():
     """The graph holds a Python reference to the Plugin so dropping
@@ -331,3 +1643,66 @@ def test_plugin_node_keeps_plugin_alive():
     in_buf = np.zeros((in_ch, 256), dtype=np.float32)
     out_buf = np.zeros((out_ch, 256), dtype=np.float32)
     g.render_block([in_buf], [out_buf], 256)
+
+
+# -------------------------------------------------------------------- #
+# Graph-level transport                                                 #
+# -------------------------------------------------------------------- #
+
+
+def test_set_transport_without_plugins_renders_fine():
+    """Transport on a plugin-free graph is a no-op broadcast: rendering
+    still works and the position advance has nobody to observe it."""
+    F = 32
+    g = minihost.PluginGraph(F, 48000.0)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+
+    g.set_transport(bpm=120.0, is_playing=True)
+    src = np.ones((1, F), dtype=np.float32)
+    dst = np.zeros((1, F), dtype=np.float32)
+    for _ in range(4):  # advances the shared position each block
+        g.render_block([src], [dst], F)
+    np.testing.assert_array_equal(dst, src)
+
+    g.clear_transport()
+    g.render_block([src], [dst], F)
+    np.testing.assert_array_equal(dst, src)
+
+
+def test_set_transport_before_compile_is_allowed():
+    """set_transport may precede compile; plugin nodes added later are
+    attached by the compile itself."""
+    g = minihost.PluginGraph(64, 48000.0)
+    g.set_transport(bpm=90.0, is_playing=False)
+    inp = g.add_input(1)
+    out = g.add_output(1)
+    g.connect(inp, out)
+    g.compile()
+
+
+@skip_if_no_plugin
+def test_graph_transport_reaches_plugin_nodes():
+    """A graph with a plugin node accepts the broadcast and renders."""
+    g = minihost.PluginGraph(256, 48000.0)
+    p = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=256)
+    in_ch = p.num_input_channels
+    out_ch = p.num_output_channels
+    if in_ch == 0:
+        pytest.skip("synth-only plugin")
+    inp = g.add_input(in_ch)
+    node = g.add_plugin(p)
+    out = g.add_output(out_ch)
+    g.connect(inp, node)
+    g.connect(node, out)
+    g.compile()
+
+    g.set_transport(bpm=140.0, position_samples=0, is_playing=True,
+                    is_looping=True, loop_start=0, loop_end=512)
+    in_buf = np.zeros((in_ch, 256), dtype=np.float32)
+    out_buf = np.zeros((out_ch, 256), dtype=np.float32)
+    for _ in range(4):  # crosses the loop end; the wrap must not blow up
+        g.render_block([in_buf], [out_buf], 256)
+    g.clear_transport()
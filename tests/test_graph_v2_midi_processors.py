@@ -258,6 +258,41 @@ def test_midi_merge_concatenates_two_sources_sorted_by_sample_offset():
     ]
 
 
+def test_midi_merge_same_offset_events_keep_port_order():
+    # The stability guarantee: events landing on the same sample_offset
+    # come out in port order (port 0 first), every render, so same-frame
+    # note-off/note-on interleavings are reproducible.
+    g, F, ch = _setup()
+    inputs = [g.add_midi_input() for _ in range(4)]
+    merge = g.add_midi_merge(num_inputs=4)
+    mo = g.add_midi_output()
+    for port, mi in enumerate(inputs):
+        g.connect_midi_port(mi, merge, port)
+    g.connect_midi(merge, mo)
+    g.compile()
+
+    for trial in range(3):
+        for port, mi in enumerate(inputs):
+            g.set_midi_input_events(
+                mi,
+                [
+                    (3, 0x90, 60 + port, 100),
+                    (3, 0x80, 60 + port, 0),
+                ],
+            )
+        g.render_block(
+            [np.zeros((ch, F), dtype=np.float32)],
+            [np.zeros((ch, F), dtype=np.float32)],
+            F,
+        )
+        drained = g.get_midi_output_events(mo)
+        assert drained == [
+            (3, status, 60 + port, vel)
+            for port in range(4)
+            for status, vel in ((0x90, 100), (0x80, 0))
+        ], f"trial {trial} broke same-offset ordering"
+
+
 def test_midi_merge_rejects_dst_port_out_of_range():
     g, _F, _ch = _setup()
     mi = g.add_midi_input()
@@ -340,3 +375,182 @@ def test_processor_chain_filter_then_transpose():
         (1, 0x90, 48, 100),
         (2, 0x90, 53, 100),
     ]
+
+
+def test_velocity_curve_gamma_change_after_compile_takes_effect():
+    # The curve is baked into a lookup table when params are set; a
+    # post-compile gamma change must rebake it.
+    g, F, ch = _setup()
+    mi = g.add_midi_input()
+    proc = g.add_midi_processor(dict(op=OP_VELOCITY_CURVE, velocity_gamma=1.0))
+    mo = g.add_midi_output()
+    g.connect_midi(mi, proc)
+    g.connect_midi(proc, mo)
+    g.compile()
+
+    g.set_midi_processor_params(
+        proc, dict(op=OP_VELOCITY_CURVE, velocity_gamma=0.5)
+    )
+    g.set_midi_input_events(mi, [(0, 0x90, 60, 64)])
+    g.render_block(
+        [np.zeros((ch, F), dtype=np.float32)], [np.zeros((ch, F), dtype=np.float32)], F
+    )
+    expected = round(((64 / 127.0) ** 0.5) * 127)
+    assert g.get_midi_output_events(mo) == [(0, 0x90, 60, expected)]
+
+
+def test_processor_stack_of_three_applies_stages_in_order():
+    """Filter -> transpose -> transpose, fused into one pass at compile."""
+    g, F, ch = _setup()
+    mi = g.add_midi_input()
+    flt = g.add_midi_processor(
+        dict(op=OP_FILTER, min_note=60, max_note=72, channel_mask=0xFFFF)
+    )
+    up = g.add_midi_processor(dict(op=OP_TRANSPOSE, transpose_semitones=12))
+    down = g.add_midi_processor(dict(op=OP_TRANSPOSE, transpose_semitones=-5))
+    mo = g.add_midi_output()
+    g.connect_midi(mi, flt)
+    g.connect_midi(flt, up)
+    g.connect_midi(up, down)
+    g.connect_midi(down, mo)
+    g.compile()
+
+    g.set_midi_input_events(
+        mi,
+        [
+            (0, 0x90, 59, 100),  # filtered out
+            (1, 0x90, 60, 100),  # 60 -> 72 -> 67
+            (2, 0x90, 121, 100),  # filtered out (> max_note)
+            (3, 0x90, 70, 100),  # 70 -> 82 -> 77
+        ],
+    )
+    g.render_block(
+        [np.zeros((ch, F), dtype=np.float32)], [np.zeros((ch, F), dtype=np.float32)], F
+    )
+    assert g.get_midi_output_events(mo) == [
+        (1, 0x90, 67, 100),
+        (3, 0x90, 77, 100),
+    ]
+
+
+def test_processor_with_two_consumers_feeds_both():
+    """A shared intermediate stream cannot be fused away: both readers
+    must still see the first processor's output."""
+    g, F, ch = _setup()
+    mi = g.add_midi_input()
+    tr = g.add_midi_processor(dict(op=OP_TRANSPOSE, transpose_semitones=2))
+    tr2 = g.add_midi_processor(dict(op=OP_TRANSPOSE, transpose_semitones=10))
+    mo_direct = g.add_midi_output()
+    mo_chained = g.add_midi_output()
+    g.connect_midi(mi, tr)
+    g.connect_midi(tr, mo_direct)
+    g.connect_midi(tr, tr2)
+    g.connect_midi(tr2, mo_chained)
+    g.compile()
+
+    g.set_midi_input_events(mi, [(0, 0x90, 60, 100)])
+    g.render_block(
+        [np.zeros((ch, F), dtype=np.float32)], [np.zeros((ch, F), dtype=np.float32)], F
+    )
+    assert g.get_midi_output_events(mo_direct) == [(0, 0x90, 62, 100)]
+    assert g.get_midi_output_events(mo_chained) == [(0, 0x90, 72, 100)]
+
+
+def test_set_params_on_upstream_of_fused_pair_takes_effect():
+    """Changing a stage that was folded into its consumer at compile
+    must still land: the fused handler is re-selected."""
+    g, F, ch = _setup()
+    mi = g.add_midi_input()
+    up = g.add_midi_processor(dict(op=OP_TRANSPOSE, transpose_semitones=1))
+    down = g.add_midi_processor(dict(op=OP_TRANSPOSE, transpose_semitones=1))
+    mo = g.add_midi_output()
+    g.connect_midi(mi, up)
+    g.connect_midi(up, down)
+    g.connect_midi(down, mo)
+    g.compile()
+
+    # Swap the upstream stage to a filter that rejects the note.
+    g.set_midi_processor_params(
+        up, dict(op=OP_FILTER, min_note=0, max_note=59, channel_mask=0xFFFF)
+    )
+    g.set_midi_input_events(mi, [(0, 0x90, 60, 100), (1, 0x90, 50, 100)])
+    g.render_block(
+        [np.zeros((ch, F), dtype=np.float32)], [np.zeros((ch, F), dtype=np.float32)], F
+    )
+    assert g.get_midi_output_events(mo) == [(1, 0x90, 51, 100)]
+
+
+# -------------------------------------------------------------------- #
+# zero-copy drain                                                      #
+# -------------------------------------------------------------------- #
+
+
+def test_borrow_midi_output_events_matches_copying_drain():
+    g, F, ch = _setup()
+    mi = g.add_midi_input()
+    mo = g.add_midi_output()
+    g.connect_midi(mi, mo)
+    g.compile()
+
+    events = [(0, 0x90, 60, 100), (3, 0xB0, 7, 80), (5, 0x80, 60, 0)]
+    g.set_midi_input_events(mi, events)
+    g.render_block(
+        [np.zeros((ch, F), dtype=np.float32)], [np.zeros((ch, F), dtype=np.float32)], F
+    )
+
+    raw = g.borrow_midi_output_events(mo)
+    assert raw.dtype == np.uint8
+    assert raw.nbytes == len(events) * minihost.MIDI_EVENT_SIZE
+    rec = raw.view(minihost.midi_event_dtype())
+    got = [
+        (int(e["sample_offset"]), int(e["status"]), int(e["data1"]), int(e["data2"]))
+        for e in rec
+    ]
+    assert got == events == g.get_midi_output_events(mo)
+
+    # The borrow views internal storage: the next render overwrites it
+    # in place, so a fresh borrow reflects the new block.
+    g.set_midi_input_events(mi, [(2, 0x90, 64, 90)])
+    g.render_block(
+        [np.zeros((ch, F), dtype=np.float32)], [np.zeros((ch, F), dtype=np.float32)], F
+    )
+    rec2 = g.borrow_midi_output_events(mo).view(minihost.midi_event_dtype())
+    assert len(rec2) == 1
+    assert int(rec2[0]["data1"]) == 64
+
+    # Non-MIDI_OUTPUT nodes are rejected.
+    with pytest.raises(RuntimeError):
+        g.borrow_midi_output_events(mi)
+
+
+def test_output_fanout_from_processor_drains_identically():
+    """Two outputs fed by the same processor read one shared per-block
+    stream: both drains (copying and borrowing) see identical events."""
+    g, F, ch = _setup()
+    mi = g.add_midi_input()
+    tr = g.add_midi_processor(dict(op=OP_TRANSPOSE, transpose_semitones=3))
+    mo_a = g.add_midi_output()
+    mo_b = g.add_midi_output()
+    g.connect_midi(mi, tr)
+    g.connect_midi(tr, mo_a)
+    g.connect_midi(tr, mo_b)
+    g.compile()
+
+    events = [(0, 0x90, 60, 100), (4, 0x80, 60, 0)]
+    g.set_midi_input_events(mi, events)
+    g.render_block(
+        [np.zeros((ch, F), dtype=np.float32)], [np.zeros((ch, F), dtype=np.float32)], F
+    )
+
+    expected = [(0, 0x90, 63, 100), (4, 0x80, 63, 0)]
+    assert g.get_midi_output_events(mo_a) == expected
+    assert g.get_midi_output_events(mo_b) == expected
+    rec_a = g.borrow_midi_output_events(mo_a).view(minihost.midi_event_dtype())
+    rec_b = g.borrow_midi_output_events(mo_b).view(minihost.midi_event_dtype())
+    assert len(rec_a) == len(rec_b) == len(expected)
+    for rec in (rec_a, rec_b):
+        got = [
+            (int(e["sample_offset"]), int(e["status"]), int(e["data1"]), int(e["data2"]))
+            for e in rec
+        ]
+        assert got == expected
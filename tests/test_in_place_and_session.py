@@ -238,3 +238,164 @@ def test_session_context_manager():
         assert info["name"]
     # After context exit close is called; calling again is a no-op.
     s.close()
+
+
+# ---------------------------------------------------------------------------
+# Standby instances (Session.standby / Plugin.swap_standby)
+# ---------------------------------------------------------------------------
+
+
+@skip_if_no_fx
+def test_session_standby_clones_layout():
+    with minihost.Session() as s:
+        active = s.open(FX_PLUGIN, sample_rate=48000)
+        standby = s.standby(active)
+        try:
+            assert standby.num_input_channels == active.num_input_channels
+            assert standby.num_output_channels == active.num_output_channels
+            assert standby.num_params == active.num_params
+        finally:
+            standby.close()
+            active.close()
+
+
+@skip_if_no_fx
+def test_standby_swap_exchanges_engine_state():
+    """Stage a standby holding a different parameter value; after the
+    next process call the active handle reads the standby's value and
+    the displaced engine (with the original value) lands in the
+    standby handle."""
+    with minihost.Session() as s:
+        active = s.open(FX_PLUGIN, sample_rate=48000)
+        standby = s.standby(active)
+        if active.num_params == 0:
+            standby.close()
+            active.close()
+            pytest.skip("plugin exposes no parameters")
+        v0 = active.get_param(0)
+        target = 0.25 if abs(v0 - 0.25) > 0.1 else 0.75
+        standby.set_param(0, target)
+
+        active.swap_standby(standby)
+        assert active.swap_pending()
+
+        # Adoption happens at the next block boundary.
+        inp = np.zeros((2, 256), dtype=np.float32)
+        out = np.zeros((2, 256), dtype=np.float32)
+        active.process(inp, out)
+        assert not active.swap_pending()
+        assert abs(active.get_param(0) - target) < 0.01
+        assert abs(standby.get_param(0) - v0) < 0.01
+        standby.close()
+        active.close()
+
+
+@skip_if_no_fx
+def test_standby_swap_rejects_mismatched_block_size():
+    with minihost.Session() as s:
+        active = s.open(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+        other = s.open(FX_PLUGIN, sample_rate=48000, max_block_size=256)
+        with pytest.raises(RuntimeError, match="block size"):
+            active.swap_standby(other)
+        other.close()
+        active.close()
+
+
+# ---------------------------------------------------------------------------
+# Typed per-format opens (Session.open(format=...) / refresh_formats)
+# ---------------------------------------------------------------------------
+
+
+def test_session_refresh_formats_is_idempotent():
+    with minihost.Session() as s:
+        s.refresh_formats()
+        s.refresh_formats()
+
+
+def test_session_open_rejects_unknown_format():
+    with minihost.Session() as s:
+        with pytest.raises(RuntimeError, match="format"):
+            s.open(FX_PLUGIN, format="vst2")
+
+
+@skip_if_no_fx
+def test_session_open_typed_vst3():
+    with minihost.Session() as s:
+        plugin = s.open(FX_PLUGIN, format="vst3")
+        assert plugin.num_output_channels > 0
+        plugin.close()
+
+
+@skip_if_no_fx
+def test_session_open_typed_mismatch_fails():
+    # A .vst3 bundle must not open through a typed LV2 request.
+    with minihost.Session() as s:
+        with pytest.raises(RuntimeError, match="LV2 support|No compatible"):
+            s.open(FX_PLUGIN, format="lv2")
+
+
+# ---------------------------------------------------------------------------
+# Instance pooling (Session.acquire / Session.release)
+# ---------------------------------------------------------------------------
+
+
+def test_pool_starts_empty_and_rejects_negative_limits():
+    with minihost.Session() as s:
+        s.set_pool(4, 0)
+        assert s.pool_size() == 0
+        with pytest.raises(RuntimeError):
+            s.set_pool(-1)
+
+
+@skip_if_no_fx
+def test_release_parks_and_acquire_reuses():
+    with minihost.Session() as s:
+        s.set_pool(4, 0)
+        p = s.acquire(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+        n_params = p.num_params
+        s.release(p)
+        assert s.pool_size() == 1
+        q = s.acquire(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+        # Served from the pool, not opened fresh.
+        assert s.pool_size() == 0
+        assert q.num_params == n_params
+        s.release(q)
+
+
+@skip_if_no_fx
+def test_release_with_pool_disabled_closes():
+    with minihost.Session() as s:
+        p = s.acquire(FX_PLUGIN)
+        s.release(p)
+        assert s.pool_size() == 0
+        with pytest.raises(RuntimeError):
+            s.release(p)
+
+
+@skip_if_no_fx
+def test_acquire_restores_birth_state():
+    with minihost.Session() as s:
+        s.set_pool(2, 0)
+        p = s.acquire(FX_PLUGIN)
+        if p.num_params == 0:
+            s.release(p)
+            pytest.skip("plugin exposes no parameters")
+        v0 = p.get_param(0)
+        p.set_param(0, 0.25 if abs(v0 - 0.25) > 0.1 else 0.75)
+        s.release(p)
+        q = s.acquire(FX_PLUGIN)
+        assert abs(q.get_param(0) - v0) < 0.01
+        s.release(q)
+
+
+@skip_if_no_fx
+def test_shrinking_pool_evicts_oldest():
+    with minihost.Session() as s:
+        s.set_pool(2, 0)
+        a = s.acquire(FX_PLUGIN)
+        b = s.acquire(FX_PLUGIN)
+        s.release(a)
+        s.release(b)
+        assert s.pool_size() == 2
+        s.set_pool(1, 0)
+        assert s.pool_size() == 1
@@ -0,0 +1,127 @@
+"""Tests for the native measurement module (measure_peak_rms, LoudnessMeter).
+
+Peak/RMS results are verified against direct numpy references; the
+loudness meter is checked against the BS.1770 calibration signal (a
+full-scale 997 Hz sine measures -3.01 LUFS per channel) and for
+streaming consistency (many small blocks vs one large block).
+"""
+
+from __future__ import annotations
+
+import math
+
+import numpy as np
+import pytest
+
+from minihost import LoudnessMeter, measure_peak_rms
+
+
+def _sine(freq, rate, frames, amplitude=1.0):
+    t = np.arange(frames, dtype=np.float64) / rate
+    return (amplitude * np.sin(2.0 * math.pi * freq * t)).astype(np.float32)
+
+
+# -- measure_peak_rms --------------------------------------------------
+
+
+def test_peak_rms_matches_numpy_reference():
+    rng = np.random.default_rng(1234)
+    block = rng.uniform(-0.8, 0.8, size=(2, 4096)).astype(np.float32)
+
+    peaks, rms = measure_peak_rms(block)
+
+    assert len(peaks) == 2 and len(rms) == 2
+    for c in range(2):
+        assert peaks[c] == pytest.approx(np.max(np.abs(block[c])), abs=1e-6)
+        assert rms[c] == pytest.approx(
+            math.sqrt(np.mean(block[c].astype(np.float64) ** 2)), abs=1e-6
+        )
+
+
+def test_peak_rms_sine_levels():
+    # A full-scale sine has peak 1.0 and RMS 1/sqrt(2).
+    block = _sine(440.0, 48000, 48000)[None, :]
+    peaks, rms = measure_peak_rms(block)
+    assert peaks[0] == pytest.approx(1.0, abs=1e-4)
+    assert rms[0] == pytest.approx(1.0 / math.sqrt(2.0), abs=1e-4)
+
+
+def test_peak_rms_empty_block():
+    peaks, rms = measure_peak_rms(np.zeros((2, 0), dtype=np.float32))
+    assert peaks == [0.0, 0.0]
+    assert rms == [0.0, 0.0]
+
+
+def test_peak_rms_rejects_non_contiguous_frames():
+    # A transposed array has stride > 1 along the frame axis; the scan
+    # requires contiguous frames rather than silently copying.
+    block = np.zeros((64, 2), dtype=np.float32).T
+    with pytest.raises(RuntimeError, match="contiguous"):
+        measure_peak_rms(block)
+
+
+# -- LoudnessMeter -----------------------------------------------------
+
+
+def test_loudness_full_scale_sine_per_bs1770():
+    # BS.1770 calibration: a 0 dBFS 997 Hz sine in a single channel
+    # reads -3.01 LUFS.
+    rate = 48000
+    meter = LoudnessMeter(1, rate)
+    meter.process(_sine(997.0, rate, rate * 4)[None, :])
+
+    assert meter.integrated() == pytest.approx(-3.01, abs=0.1)
+    assert meter.shortterm() == pytest.approx(-3.01, abs=0.1)
+    assert meter.sample_peak(0) == pytest.approx(1.0, abs=1e-4)
+
+
+def test_loudness_streaming_matches_single_block():
+    rate = 48000
+    rng = np.random.default_rng(99)
+    audio = rng.uniform(-0.5, 0.5, size=(2, rate * 2)).astype(np.float32)
+
+    whole = LoudnessMeter(2, rate)
+    whole.process(audio)
+
+    chunked = LoudnessMeter(2, rate)
+    # Deliberately awkward block size so hops straddle block edges.
+    step = 1023
+    for start in range(0, audio.shape[1], step):
+        chunked.process(np.ascontiguousarray(audio[:, start : start + step]))
+
+    assert chunked.integrated() == pytest.approx(whole.integrated(), abs=1e-6)
+    assert chunked.shortterm() == pytest.approx(whole.shortterm(), abs=1e-6)
+
+
+def test_loudness_silence_and_reset():
+    rate = 48000
+    meter = LoudnessMeter(1, rate)
+
+    # Nothing processed yet: both measures are -inf.
+    assert meter.integrated() == float("-inf")
+    assert meter.shortterm() == float("-inf")
+
+    # Silence never passes the -70 LUFS absolute gate.
+    meter.process(np.zeros((1, rate), dtype=np.float32))
+    assert meter.integrated() == float("-inf")
+
+    meter.process(_sine(997.0, rate, rate)[None, :])
+    assert meter.integrated() > -10.0
+
+    meter.reset()
+    assert meter.integrated() == float("-inf")
+    assert meter.sample_peak(0) == 0.0
+
+
+def test_loudness_validates_arguments():
+    with pytest.raises(RuntimeError):
+        LoudnessMeter(0, 48000)
+    with pytest.raises(RuntimeError):
+        LoudnessMeter(2, 4000)
+
+    meter = LoudnessMeter(2, 48000)
+    assert meter.channels == 2
+    with pytest.raises(RuntimeError, match="channel"):
+        meter.process(np.zeros((3, 64), dtype=np.float32))
+    with pytest.raises(RuntimeError):
+        meter.sample_peak(2)
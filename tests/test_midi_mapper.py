@@ -297,3 +297,77 @@ def test_concurrent_remap_and_dispatch_does_not_crash():
     for c in plugin.set_param.call_args_list:
         assert c.args[0] in (0, 2)
         assert 0.0 <= c.args[1] <= 1.0
+
+
+# -- native mode (attach_device) --------------------------------------
+
+
+def _make_device() -> MagicMock:
+    """Mock AudioDevice recording set_cc_map/clear_cc_map calls."""
+    device = MagicMock()
+    device.set_cc_map = MagicMock()
+    device.clear_cc_map = MagicMock()
+    return device
+
+
+def test_attach_device_pushes_compiled_table():
+    plugin = _make_plugin()
+    mapper = MidiMapper(plugin)
+    mapper.map_cc(channel=0, cc=7, param="Volume")
+    mapper.map_cc(channel=1, cc=10, param="Pan", value_range=(-1.0, 1.0))
+
+    device = _make_device()
+    mapper.attach_device(device, plugin_index=3)
+
+    (mappings,) = device.set_cc_map.call_args.args
+    assert sorted(m[:4] for m in mappings) == [(0, 7, 3, 0), (1, 10, 3, 1)]
+    for m in mappings:
+        assert len(m[4]) == 128
+
+    # LUT endpoints span the mapping's value_range (linear curve).
+    pan_lut = next(m[4] for m in mappings if m[1] == 10)
+    assert pan_lut[0] == pytest.approx(-1.0)
+    assert pan_lut[127] == pytest.approx(1.0)
+
+
+def test_native_lut_matches_python_normalize():
+    """The compiled LUT must agree with the Python dispatch path's
+    per-event curve evaluation for every CC value and curve."""
+    from minihost.control import _CCMapping, _compile_lut
+
+    for curve in ("linear", "exp", "log"):
+        mapping = _CCMapping("x", 0, (0.25, 0.75), curve)
+        lut = _compile_lut((0.25, 0.75), curve)
+        for v in range(128):
+            assert lut[v] == pytest.approx(mapping.normalize(v))
+
+
+def test_mapping_edits_repush_while_attached():
+    plugin = _make_plugin()
+    mapper = MidiMapper(plugin)
+    device = _make_device()
+    mapper.attach_device(device)
+    device.set_cc_map.reset_mock()
+
+    mapper.map_cc(0, 7, "Volume")
+    mapper.unmap_cc(0, 7)
+    mapper.unmap_cc(0, 7)  # already gone: no extra push
+    mapper.clear()
+    assert device.set_cc_map.call_count == 3
+
+    # The final pushes were the empty table (map cleared).
+    (mappings,) = device.set_cc_map.call_args.args
+    assert mappings == []
+
+
+def test_detach_device_clears_and_stops_tracking():
+    plugin = _make_plugin()
+    mapper = MidiMapper(plugin)
+    device = _make_device()
+    mapper.attach_device(device)
+    mapper.detach_device()
+
+    device.clear_cc_map.assert_called_once()
+    device.set_cc_map.reset_mock()
+    mapper.map_cc(0, 7, "Volume")  # no longer attached
+    device.set_cc_map.assert_not_called()
@@ -27,6 +27,57 @@ def test_module_has_midi_functions():
     assert callable(minihost.midi_get_output_ports)
 
 
+def test_module_has_metrics_functions():
+    """Test that the metrics registry surface is exported."""
+    assert hasattr(minihost, "metrics_snapshot")
+    assert hasattr(minihost, "metrics_reset")
+    assert callable(minihost.metrics_snapshot)
+    assert callable(minihost.metrics_reset)
+
+
+def test_metrics_snapshot_shape():
+    """Snapshot returns (name, kind, value) tuples and includes the
+    built-in pull metrics without any plugin/chain/graph activity."""
+    snap = minihost.metrics_snapshot()
+    assert isinstance(snap, list)
+    names = set()
+    for name, kind, value in snap:
+        assert kind in ("counter", "gauge")
+        assert isinstance(value, float)
+        names.add(name)
+    assert "rt_audit.hits" in names
+
+
+def test_set_thread_policy_validates_arguments():
+    """Role/priority names are checked; a valid policy round-trips."""
+    with pytest.raises(ValueError):
+        minihost.set_thread_policy("bogus", "default")
+    with pytest.raises(ValueError):
+        minihost.set_thread_policy("loader", "bogus")
+    # Setting a policy only stores it (applied at thread spawn), so
+    # this is safe regardless of scheduling privileges.
+    minihost.set_thread_policy("loader", "low")
+    minihost.set_thread_policy("loader", "default")
+
+
+def test_message_pumps_configurable_before_first_load():
+    """Pump count can be (re)configured until the pumps start, and
+    get_message_pumps reflects the last setting. Once any plugin has
+    loaded in this process the pins are fixed and configuring raises."""
+    assert hasattr(minihost, "set_message_pumps")
+    try:
+        minihost.set_message_pumps(2)
+    except RuntimeError:
+        # Another test already loaded a plugin in this process; the
+        # error itself is the documented behavior.
+        return
+    assert minihost.get_message_pumps() == 2
+    # Leave the default (0) behind so later tests that do load plugins
+    # see single-thread behavior.
+    minihost.set_message_pumps(0)
+    assert minihost.get_message_pumps() == 0
+
+
 def test_module_has_probe_function():
     """Test that probe function is exported."""
     assert hasattr(minihost, "probe")
@@ -68,6 +119,8 @@ def test_audio_device_class_has_expected_methods():
     expected_methods = [
         "start",
         "stop",
+        "set_input_drift_comp",
+        "input_drift_stats",
     ]
     for method in expected_methods:
         assert hasattr(minihost.AudioDevice, method), (
@@ -108,6 +161,24 @@ def test_audio_device_class_has_midi_methods():
         )
 
 
+def test_audio_device_class_has_playlist_methods():
+    """Test that AudioDevice class has gapless-playlist methods."""
+    expected_methods = [
+        "playlist_add_audio",
+        "playlist_add_midi",
+        "playlist_set_crossfade",
+        "playlist_clear",
+    ]
+    for method in expected_methods:
+        assert hasattr(minihost.AudioDevice, method), (
+            f"AudioDevice missing method: {method}"
+        )
+    for prop in ["playlist_index", "playlist_count"]:
+        assert hasattr(minihost.AudioDevice, prop), (
+            f"AudioDevice missing property: {prop}"
+        )
+
+
 def test_audio_device_class_has_virtual_midi_properties():
     """Test that AudioDevice class has virtual MIDI properties."""
     expected_props = [
@@ -160,6 +231,8 @@ def test_plugin_class_has_expected_methods():
         "process_sidechain",
         "process_double",
         "reset",
+        "warmup",
+        "set_lock_memory",
         "get_program_name",
         "get_bus_info",
         "check_buses_layout",
@@ -170,6 +243,10 @@ def test_plugin_class_has_expected_methods():
         "set_change_callback",
         "set_param_value_callback",
         "set_param_gesture_callback",
+        "start_param_recording",
+        "stop_param_recording",
+        "fetch_param_records",
+        "param_records_dropped",
         "set_track_properties",
     ]
     for method in expected_methods:
@@ -180,9 +257,13 @@ def test_plugin_chain_class_has_expected_methods():
     """Test that PluginChain class has expected methods."""
     expected_methods = [
         "get_plugin",
+        "get_bypass",
         "process",
         "process_midi",
         "reset",
+        "set_bypass",
+        "seek_automation",
+        "set_automation_timeline",
         "set_non_realtime",
     ]
     for method in expected_methods:
@@ -229,6 +310,8 @@ def test_plugin_class_has_expected_properties():
         "tail_seconds",
         "bypass",
         "non_realtime",
+        "denormal_control",
+        "denormal_hits",
         "num_programs",
         "program",
         "sidechain_channels",
@@ -332,6 +415,21 @@ def test_probe_wrong_file_type_raises():
         os.unlink(temp_path)
 
 
+def test_probe_batch_empty_list():
+    """Empty path list returns an empty result list."""
+    assert minihost.probe_batch([]) == []
+
+
+def test_probe_batch_reports_per_entry_errors():
+    """Bad paths become {'path', 'error'} entries, in input order."""
+    paths = ["/nonexistent/a.vst3", "", "/nonexistent/b.vst3"]
+    results = minihost.probe_batch(paths, concurrency=2)
+    assert len(results) == len(paths)
+    for path, result in zip(paths, results):
+        assert result["path"] == path
+        assert "error" in result and result["error"]
+
+
 def test_scan_directory_nonexistent_raises():
     """Test that scanning nonexistent directory raises RuntimeError."""
     with pytest.raises(RuntimeError, match="Failed to scan directory"):
@@ -440,6 +538,50 @@ class TestPluginIntegration:
         if len(state) > 0:
             plugin.set_state(state)
 
+    def test_batched_restore(self, plugin):
+        """restore() applies state + program + params in one call."""
+        state = plugin.get_state()
+        params = [(0, 0.5)] if plugin.num_params > 0 else []
+        program = 0 if plugin.num_programs > 0 else -1
+        plugin.restore(
+            state=state if len(state) > 0 else None,
+            program=program,
+            params=params,
+        )
+        if params:
+            assert abs(plugin.get_param(0) - 0.5) < 0.01
+
+    def test_batched_restore_empty_is_noop(self, plugin):
+        """restore() with nothing to apply succeeds."""
+        plugin.restore()
+
+    def test_batched_restore_bad_program(self, plugin):
+        """restore() rejects an out-of-range program index."""
+        with pytest.raises(RuntimeError):
+            plugin.restore(program=plugin.num_programs + 10)
+
+    def test_batch_capture_restore(self, plugin):
+        """capture_states / restore_states round-trip a batch in one
+        plugin-thread hop."""
+        states = minihost.capture_states([plugin])
+        assert len(states) == 1
+        if states[0] is not None:
+            assert isinstance(states[0], bytes)
+            assert states[0] == plugin.get_state()
+            assert minihost.restore_states([plugin], states) == 1
+        # None entries are skipped, not applied.
+        assert minihost.restore_states([plugin], [None]) == 0
+
+    def test_batch_restore_length_mismatch(self, plugin):
+        """restore_states requires parallel lists."""
+        with pytest.raises(RuntimeError):
+            minihost.restore_states([plugin], [])
+
+    def test_batch_capture_empty(self, plugin):
+        """An empty batch is a no-op, not an error."""
+        assert minihost.capture_states([]) == []
+        assert minihost.restore_states([], []) == 0
+
     def test_process_audio(self, plugin):
         """Test audio processing."""
         import numpy as np
@@ -452,6 +594,54 @@ class TestPluginIntegration:
 
         plugin.process(input_audio, output_audio)
 
+    def test_process_into(self, plugin):
+        """AudioBuffer-to-AudioBuffer fast path processes without error."""
+        import numpy as np
+
+        import minihost
+
+        in_ch = max(plugin.num_input_channels, 2)
+        out_ch = max(plugin.num_output_channels, 2)
+
+        in_buf = minihost.AudioBuffer(in_ch, 512)
+        out_buf = minihost.AudioBuffer(out_ch, 512)
+        plugin.process_into(in_buf, out_buf)
+        assert np.all(np.isfinite(out_buf.as_ndarray()))
+
+    def test_process_interleaved(self, plugin):
+        """Interleaved [frames, channels] processing matches the planar path."""
+        import numpy as np
+
+        channels = max(plugin.num_input_channels, plugin.num_output_channels, 2)
+        frames = 512
+
+        rng = np.random.default_rng(42)
+        planar_in = rng.standard_normal((channels, frames)).astype(np.float32) * 0.1
+
+        # Reference: planar process (extra channels beyond the plugin's
+        # buses are ignored/zeroed by both paths)
+        plugin.reset()
+        planar_out = np.zeros((max(plugin.num_output_channels, 1), frames), dtype=np.float32)
+        plugin.process(planar_in[: max(plugin.num_input_channels, 1)], planar_out)
+
+        plugin.reset()
+
+        # Interleaved: same samples as [frames, channels]
+        inter_in = np.ascontiguousarray(planar_in.T)
+        inter_out = np.zeros((frames, channels), dtype=np.float32)
+        plugin.process_interleaved(inter_in, inter_out)
+
+        assert np.all(np.isfinite(inter_out))
+        for ch in range(min(channels, plugin.num_output_channels)):
+            np.testing.assert_allclose(inter_out[:, ch], planar_out[ch], atol=1e-5)
+        # Channels beyond the plugin's outputs are zero-filled
+        for ch in range(plugin.num_output_channels, channels):
+            assert np.all(inter_out[:, ch] == 0.0)
+
+        # Shape mismatch is rejected
+        with pytest.raises(ValueError):
+            plugin.process_interleaved(inter_in, np.zeros((frames, channels + 1), dtype=np.float32))
+
     def test_process_with_midi(self, plugin):
         """Test audio processing with MIDI."""
         import numpy as np
@@ -545,6 +735,16 @@ class TestPluginIntegration:
             assert isinstance(text_50, str)
             assert isinstance(text_100, str)
 
+    def test_params_to_text_bulk_matches_per_call(self, plugin):
+        """Batched text conversion matches per-call param_to_text."""
+        if plugin.num_params > 0:
+            requests = [(0, 0.0), (0, 0.5), (0, 1.0)]
+            bulk = plugin.params_to_text(requests)
+            assert bulk == [plugin.param_to_text(i, v) for i, v in requests]
+            # Out-of-range indices yield empty strings, not errors.
+            assert plugin.params_to_text([(plugin.num_params, 0.5)]) == [""]
+        assert plugin.params_to_text([]) == []
+
     def test_param_from_text(self, plugin):
         """Test text to parameter value conversion."""
         if plugin.num_params > 0:
@@ -587,6 +787,29 @@ class TestPluginIntegration:
                 # Restore original
                 plugin.program = current
 
+    def test_preset_bank_prefetch(self, plugin):
+        """Prefetched program bank enables fast switching."""
+        num_programs = plugin.num_programs
+        if num_programs > 0:
+            cached = plugin.prefetch_programs()
+            assert cached == num_programs
+            # Switch through the bank from the cache; some plugins
+            # have programs with empty state, which report failure.
+            for i in range(min(num_programs, 5)):
+                try:
+                    plugin.set_program_fast(i)
+                except RuntimeError:
+                    pass
+            with pytest.raises(RuntimeError):
+                plugin.set_program_fast(num_programs)
+            plugin.clear_program_cache()
+            # After clearing, the fast path reports failure.
+            with pytest.raises(RuntimeError):
+                plugin.set_program_fast(0)
+        else:
+            with pytest.raises(RuntimeError):
+                plugin.prefetch_programs()
+
     def test_bus_layout(self, plugin):
         """Test bus layout query."""
         # Check number of buses
@@ -892,6 +1115,98 @@ class TestPluginIntegration:
         # Clear callback
         plugin.set_param_value_callback(None)
 
+    def test_param_value_coalescing(self, plugin):
+        """Coalescing mode sprays changes but delivers at most last-writer-wins."""
+        if plugin.num_params == 0:
+            return
+
+        received = []
+
+        def on_param_change(idx, val):
+            received.append((idx, val))
+
+        plugin.set_param_value_callback(on_param_change)
+        plugin.set_param_value_coalescing(10)
+
+        # Spray many changes to one parameter; disabling flushes pending
+        # changes, so the final value must come through even if no flush
+        # tick fired in between.
+        for i in range(200):
+            plugin.set_param(0, (i % 100) / 100.0)
+        plugin.set_param(0, 0.75)
+
+        plugin.set_param_value_coalescing(0)
+        plugin.poll_callbacks()
+
+        for_param0 = [v for (i, v) in received if i == 0]
+        if for_param0:  # listener delivery is plugin-dependent
+            assert len(for_param0) < 201, "coalescing did not reduce event volume"
+            assert abs(for_param0[-1] - 0.75) < 1e-6
+
+        plugin.set_param_value_callback(None)
+
+    def test_param_change_recording(self, plugin):
+        """Armed recording captures each change with a timestamp."""
+        if plugin.num_params == 0:
+            return
+
+        assert not plugin.param_recording_armed()
+        plugin.start_param_recording(1024)
+        assert plugin.param_recording_armed()
+
+        plugin.set_param(0, 0.2)
+        plugin.set_param(0, 0.8)
+        plugin.stop_param_recording()
+        assert not plugin.param_recording_armed()
+
+        records = plugin.fetch_param_records()
+        assert plugin.param_records_dropped() == 0
+        for_param0 = [(t, v) for (t, i, v) in records if i == 0]
+        if for_param0:  # listener delivery is plugin-dependent
+            times = [t for (t, _) in for_param0]
+            assert times == sorted(times)
+            assert abs(for_param0[-1][1] - 0.8) < 1e-6
+        # Drained: a second fetch returns nothing.
+        assert plugin.fetch_param_records() == []
+
+    def test_param_smoothing(self, plugin):
+        """Smoothing config round-trips and smoothed process_auto is stable."""
+        import numpy as np
+
+        if plugin.num_params == 0:
+            return
+
+        # Default: no smoothing configured
+        ramp_ms, mode = plugin.get_param_smoothing(0)
+        assert ramp_ms == 0.0
+
+        plugin.set_param_smoothing(0, 50.0)
+        ramp_ms, mode = plugin.get_param_smoothing(0)
+        assert abs(ramp_ms - 50.0) < 1e-6
+        assert mode == minihost.MH_SMOOTH_EXPONENTIAL
+
+        plugin.set_param_smoothing(0, 20.0, minihost.MH_SMOOTH_LINEAR)
+        ramp_ms, mode = plugin.get_param_smoothing(0)
+        assert abs(ramp_ms - 20.0) < 1e-6
+        assert mode == minihost.MH_SMOOTH_LINEAR
+
+        # A change on the smoothed param becomes a ramp target; the block
+        # must process without splitting and stay finite.
+        in_ch = max(plugin.num_input_channels, 1)
+        out_ch = max(plugin.num_output_channels, 1)
+        input_audio = np.zeros((in_ch, 512), dtype=np.float32)
+        output_audio = np.zeros((out_ch, 512), dtype=np.float32)
+        plugin.process_auto(input_audio, output_audio, [], [(0, 0, 1.0)])
+        assert np.all(np.isfinite(output_audio))
+
+        # Disable again; in-flight ramps jump to target on the next block
+        plugin.set_param_smoothing(0, 0.0)
+        ramp_ms, _ = plugin.get_param_smoothing(0)
+        assert ramp_ms == 0.0
+
+        with pytest.raises(ValueError):
+            plugin.set_param_smoothing(-1, 10.0)
+
     def test_param_gesture_callback(self, plugin):
         """Test parameter gesture notification from plugin side."""
         if plugin.num_params == 0:
@@ -1136,6 +1451,67 @@ class TestMidiFile:
         assert isinstance(events, list)
         assert len(events) == 0
 
+    def test_midifile_lazy_load_matches_eager(self, tmp_path):
+        """load_lazy decodes tracks on demand but yields the same
+        events, stats and duration as a full load."""
+        mf = minihost.MidiFile()
+        mf.add_tempo(0, 0, 120.0)
+        track = mf.add_track()
+        mf.add_note_on(0, 0, 0, 60, 100)
+        mf.add_note_off(0, 480, 0, 60, 0)
+        mf.add_note_on(track, 240, 1, 64, 90)
+        mf.add_note_off(track, 960, 1, 64, 0)
+        path = str(tmp_path / "lazy.mid")
+        assert mf.save(path) is True
+
+        eager = minihost.MidiFile()
+        assert eager.load(path) is True
+        lazy = minihost.MidiFile()
+        assert lazy.load_lazy(path) is True
+
+        assert lazy.num_tracks == eager.num_tracks
+        assert lazy.ticks_per_quarter == eager.ticks_per_quarter
+        assert lazy.duration_seconds == pytest.approx(eager.duration_seconds)
+
+        for t in range(eager.num_tracks):
+            # Stats come from a boundary walk, not an event decode.
+            stats = lazy.track_stats(t)
+            assert stats["event_count"] == len(eager.get_events(t))
+            # Decode on first access must match the eager parse.
+            assert lazy.get_events(t) == eager.get_events(t)
+
+        with pytest.raises(IndexError):
+            lazy.track_stats(999)
+
+    def test_midifile_lazy_mutation_falls_back_to_full_parse(self, tmp_path):
+        """Whole-file operations on a lazily loaded file transparently
+        promote to a full parse."""
+        mf = minihost.MidiFile()
+        mf.add_tempo(0, 0, 120.0)
+        mf.add_note_on(0, 0, 0, 60, 100)
+        mf.add_note_off(0, 480, 0, 60, 0)
+        path = str(tmp_path / "promote.mid")
+        assert mf.save(path) is True
+
+        lazy = minihost.MidiFile()
+        assert lazy.load_lazy(path) is True
+        lazy.add_note_on(0, 960, 0, 62, 100)
+        lazy.add_note_off(0, 1440, 0, 62, 0)
+        out = str(tmp_path / "promoted.mid")
+        assert lazy.save(out) is True
+
+        check = minihost.MidiFile()
+        assert check.load(out) is True
+        pitches = [
+            e["pitch"] for e in check.get_events(0) if e["type"] == "note_on"
+        ]
+        assert pitches == [60, 62]
+
+    def test_midifile_load_lazy_nonexistent(self):
+        """load_lazy on a missing file returns False."""
+        mf = minihost.MidiFile()
+        assert mf.load_lazy("/nonexistent/path/to/file.mid") is False
+
 
 class TestMidiRendering:
     """Tests for MIDI rendering functions (require a plugin)."""
@@ -1352,6 +1728,24 @@ class TestPluginChain:
 
         chain.process(input_audio, output_audio)
 
+    def test_chain_subblocks_small_plugin(self, plugin_path):
+        """A plugin prepared with a small max still renders large chain blocks."""
+        import numpy as np
+
+        small = minihost.Plugin(plugin_path, sample_rate=48000, max_block_size=256)
+        chain = minihost.PluginChain([small])
+
+        in_ch = max(chain.num_input_channels, 2)
+        out_ch = max(chain.num_output_channels, 2)
+
+        # 1024 > the plugin's prepared 256: the library sub-blocks
+        # internally instead of failing, so one chain serves both live
+        # and offline block sizes.
+        input_audio = np.zeros((in_ch, 1024), dtype=np.float32)
+        output_audio = np.zeros((out_ch, 1024), dtype=np.float32)
+        chain.process(input_audio, output_audio)
+        assert np.all(np.isfinite(output_audio))
+
     def test_chain_process_midi(self, plugin):
         """Test processing audio with MIDI through chain."""
         import numpy as np
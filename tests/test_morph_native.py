@@ -111,6 +111,100 @@ def test_morph_length_mismatch_raises(plugin):
         plugin.morph([0.1], [0.2], 0.5)
 
 
+class TestMorphAutomation:
+    """MorphAutomation curve logic is pure native math -- no plugin needed."""
+
+    def test_t_at_interpolates_between_points(self):
+        ma = minihost.MorphAutomation([0.0], [1.0], [(0, 0.0), (1000, 1.0)])
+        assert ma.t_at(0) == pytest.approx(0.0)
+        assert ma.t_at(500) == pytest.approx(0.5)
+        assert ma.t_at(1000) == pytest.approx(1.0)
+
+    def test_t_at_clamps_outside_curve_span(self):
+        ma = minihost.MorphAutomation([0.0], [1.0], [(100, 0.2), (200, 0.8)])
+        assert ma.t_at(-50) == pytest.approx(0.2)
+        assert ma.t_at(0) == pytest.approx(0.2)
+        assert ma.t_at(5000) == pytest.approx(0.8)
+
+    def test_curve_is_sorted_internally(self):
+        ma = minihost.MorphAutomation(
+            [0.0], [1.0], [(1000, 1.0), (0, 0.0)]
+        )
+        assert ma.t_at(250) == pytest.approx(0.25)
+
+    def test_len_is_parameter_count(self):
+        ma = minihost.MorphAutomation([0.1] * 5, [0.9] * 5, [(0, 0.0)])
+        assert len(ma) == 5
+
+    def test_snapshot_length_mismatch_raises(self):
+        with pytest.raises(ValueError):
+            minihost.MorphAutomation([0.1, 0.2], [0.3], [(0, 0.0)])
+
+    def test_empty_curve_raises(self):
+        with pytest.raises(ValueError):
+            minihost.MorphAutomation([0.1], [0.2], [])
+
+
+@skip_if_no_plugin
+def test_apply_morph_matches_one_shot_morph(plugin):
+    n = plugin.num_params
+    a = [0.2] * n
+    b = [0.8] * n
+    ma = minihost.MorphAutomation(a, b, [(0, 0.0), (48000, 1.0)])
+    t = plugin.apply_morph(ma, 24000)
+    assert t == pytest.approx(0.5)
+    via_automation = plugin.morph_capture()
+    expected = plugin.morph(a, b, 0.5)
+    assert via_automation == pytest.approx(expected, abs=1e-4)
+
+
+@skip_if_no_plugin
+def test_apply_morph_length_mismatch_raises(plugin):
+    ma = minihost.MorphAutomation([0.5], [0.6], [(0, 0.0)])
+    if plugin.num_params == 1:
+        pytest.skip("plugin has exactly 1 parameter")
+    with pytest.raises(ValueError):
+        plugin.apply_morph(ma, 0)
+
+
+@skip_if_no_plugin
+def test_params_diff_empty_when_unchanged(plugin):
+    baseline = plugin.morph_capture()
+    assert plugin.params_diff(baseline) == []
+
+
+@skip_if_no_plugin
+def test_params_diff_reports_only_the_edit(plugin):
+    baseline = plugin.morph_capture()
+    if plugin.num_params < 1:
+        pytest.skip("plugin has no parameters")
+    target = 0.0 if baseline[0] > 0.5 else 1.0
+    plugin.set_param(0, target)
+    diff = plugin.params_diff(baseline)
+    assert [idx for idx, _ in diff] == [0]
+    assert diff[0][1] == pytest.approx(plugin.get_param(0))
+
+
+@skip_if_no_plugin
+def test_params_diff_feeds_set_params_to_restore(plugin):
+    if plugin.num_params < 1:
+        pytest.skip("plugin has no parameters")
+    edited = plugin.morph_capture()
+    # Revert to a nudged-away baseline, then replay the diff: only the
+    # edited parameter gets written and the edit comes back.
+    plugin.set_param(0, 0.0 if edited[0] > 0.5 else 1.0)
+    baseline = plugin.morph_capture()
+    plugin.set_params([(0, edited[0])])
+    assert [idx for idx, _ in plugin.params_diff(baseline)] == [0]
+    assert plugin.get_param(0) == pytest.approx(edited[0], abs=1e-4)
+
+
+@skip_if_no_plugin
+def test_params_diff_length_mismatch_raises(plugin):
+    with pytest.raises(ValueError):
+        plugin.params_diff([0.5])
+
+
 @skip_if_no_plugin
 def test_native_matches_pure_python_module(plugin):
     """The C-backed methods and the pure-Python module agree on the math."""
@@ -123,3 +217,57 @@ def test_native_matches_pure_python_module(plugin):
     native = plugin.morph(a, b, t)  # lerp + apply, returns snapshot
     pure = pymorph.lerp(a, b, t)  # pure-Python lerp
     assert native == pytest.approx(pure)
+
+class TestMorphPair:
+    """MorphPair active-set construction is pure native math -- no plugin
+    needed."""
+
+    def test_active_set_is_only_the_differences(self):
+        mp = minihost.MorphPair([0.1, 0.5, 0.9], [0.1, 0.6, 0.9])
+        assert len(mp) == 1
+        assert mp.active_count == 1
+
+    def test_identical_snapshots_have_empty_active_set(self):
+        mp = minihost.MorphPair([0.2] * 100, [0.2] * 100)
+        assert mp.active_count == 0
+
+    def test_epsilon_widens_the_unchanged_band(self):
+        a = [0.5, 0.5]
+        b = [0.5005, 0.7]
+        assert minihost.MorphPair(a, b).active_count == 2
+        assert minihost.MorphPair(a, b, epsilon=0.01).active_count == 1
+
+    def test_negative_epsilon_raises(self):
+        with pytest.raises(ValueError):
+            minihost.MorphPair([0.1], [0.2], epsilon=-1.0)
+
+    def test_snapshot_length_mismatch_raises(self):
+        with pytest.raises(ValueError):
+            minihost.MorphPair([0.1, 0.2], [0.3])
+
+
+@skip_if_no_plugin
+def test_apply_morph_pair_matches_full_morph(plugin):
+    if plugin.num_params < 2:
+        pytest.skip("plugin has < 2 parameters")
+    a = plugin.morph_capture()
+    # B differs from A in exactly one parameter.
+    b = list(a)
+    b[1] = 0.0 if a[1] > 0.5 else 1.0
+    mp = minihost.MorphPair(a, b)
+    assert mp.active_count == 1
+
+    t = 0.5
+    plugin.apply_morph_pair(mp, t)
+    after = plugin.morph_capture()
+    expected = [min(1.0, max(0.0, x + (y - x) * t)) for x, y in zip(a, b)]
+    assert after == pytest.approx(expected, abs=1e-4)
+
+
+@skip_if_no_plugin
+def test_apply_morph_pair_count_mismatch_raises(plugin):
+    if plugin.num_params == 1:
+        pytest.skip("plugin has exactly 1 parameter")
+    mp = minihost.MorphPair([0.1], [0.9])
+    with pytest.raises(RuntimeError):
+        plugin.apply_morph_pair(mp, 0.5)
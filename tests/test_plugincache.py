@@ -236,7 +236,117 @@ def test_corrupt_cache_file_is_ignored(cache_env):
     plugins, calls = cache_env
     _touch_plugin(plugins, "synthA.vst3")
     plugincache.scan(plugins)
-    # Corrupt the JSON; the cache must degrade to empty, not crash.
+    # Corrupt the store; the cache must degrade to empty, not crash.
     plugincache.cache_file().write_text("{ not valid json ]")
     res = plugincache.scan(plugins)  # re-probes since cache unreadable
     assert {d["name"] for d in res} == {"synthA"}
+
+
+def test_truncated_tail_is_ignored_and_repaired(cache_env):
+    plugins, calls = cache_env
+    a = _touch_plugin(plugins, "synthA.vst3")
+    plugincache.scan(plugins)
+    # Simulate a crash mid-append: garbage after the last good record.
+    with open(plugincache.cache_file(), "ab") as f:
+        f.write(b"\x09\x00\x00\x00partial")
+    assert plugincache.info(a)["name"] == "synthA"  # still served from cache
+    assert len(calls) == 1
+    # The next write truncates the bad tail; the store stays readable.
+    _touch_plugin(plugins, "fxB.vst3")
+    plugincache.scan(plugins)
+    assert plugincache.stats()["total"] == 2
+
+
+def test_updates_append_and_prune_compacts(cache_env):
+    plugins, calls = cache_env
+    a = _touch_plugin(plugins, "synthA.vst3")
+    plugincache.scan(plugins)
+    # Re-probing appends a superseding record (the file only grows)...
+    size_one = os.path.getsize(plugincache.cache_file())
+    plugincache.scan(plugins, refresh=True)
+    assert os.path.getsize(plugincache.cache_file()) > size_one
+    assert plugincache.stats()["total"] == 1  # last record wins
+    assert plugincache.info(a)["name"] == "synthA"
+    # ...and prune() compacts superseded records away.
+    plugincache.prune()
+    assert os.path.getsize(plugincache.cache_file()) == size_one
+    assert plugincache.stats()["total"] == 1
+
+
+# -- negotiated-layout cache ------------------------------------------ #
+
+
+def test_layout_cache_roundtrip_and_merge(cache_env, monkeypatch):
+    import minihost
+
+    monkeypatch.setattr(
+        minihost, "layout_cache_export", lambda: "1 synthA|1.0|i:2|o:2\n"
+    )
+    imported = []
+    monkeypatch.setattr(minihost, "layout_cache_import", imported.append)
+
+    assert plugincache.save_layout_cache() == 1
+    # A second process saved a different key; merging keeps both.
+    with open(plugincache.layout_cache_file(), "a", encoding="utf-8") as f:
+        f.write("0 fxB|2.1|i:2|o:2\n")
+    assert plugincache.save_layout_cache() == 2
+
+    plugincache.load_layout_cache()
+    assert len(imported) == 1
+    assert sorted(imported[0].splitlines()) == [
+        "0 fxB|2.1|i:2|o:2",
+        "1 synthA|1.0|i:2|o:2",
+    ]
+
+
+def test_layout_cache_save_prefers_this_process(cache_env, monkeypatch):
+    import minihost
+
+    plugincache.layout_cache_file().parent.mkdir(parents=True, exist_ok=True)
+    plugincache.layout_cache_file().write_text("0 synthA|1.0|i:2|o:2\n")
+    # This process re-probed and got a different answer; it supersedes disk.
+    monkeypatch.setattr(
+        minihost, "layout_cache_export", lambda: "1 synthA|1.0|i:2|o:2\n"
+    )
+    assert plugincache.save_layout_cache() == 1
+    assert plugincache.layout_cache_file().read_text() == "1 synthA|1.0|i:2|o:2\n"
+
+
+def test_layout_cache_load_without_file_is_a_noop(cache_env, monkeypatch):
+    import minihost
+
+    def boom(_blob):
+        raise AssertionError("import should not run without a file")
+
+    monkeypatch.setattr(minihost, "layout_cache_import", boom)
+    assert plugincache.load_layout_cache() == 0
+
+
+# -- auto-tuned block size -------------------------------------------- #
+
+
+def test_tuned_block_size_roundtrip(cache_env):
+    plugins, _calls = cache_env
+    a = _touch_plugin(plugins, "synthA.vst3")
+    assert plugincache.tuned_block_size(a) is None
+    plugincache.set_tuned_block_size(a, 2048)
+    assert plugincache.tuned_block_size(a) == 2048
+    # Piggybacks on the existing entry: probe metadata survives.
+    assert plugincache.info(a)["name"] == "synthA"
+
+
+def test_tuned_block_size_dropped_when_plugin_changes(cache_env):
+    plugins, _calls = cache_env
+    a = _touch_plugin(plugins, "synthA.vst3")
+    plugincache.set_tuned_block_size(a, 1024)
+    assert plugincache.tuned_block_size(a) == 1024
+    # A changed binary (new fingerprint) invalidates the recording.
+    os.utime(a, ns=(1, 1))
+    assert plugincache.tuned_block_size(a) is None
+
+
+def test_set_tuned_block_size_rejects_nonpositive(cache_env):
+    plugins, _calls = cache_env
+    a = _touch_plugin(plugins, "synthA.vst3")
+    with pytest.raises(ValueError):
+        plugincache.set_tuned_block_size(a, 0)
@@ -49,6 +49,27 @@ def test_process_audio_with_tail_extends_output():
     assert out_tail.frames - out_no_tail.frames == int(0.5 * 48000)
 
 
+@skip_if_no_plugin
+def test_native_render_loop_matches_python_loop():
+    # A progress_callback forces the per-block Python loop; without one the
+    # render goes through Plugin.render_blocks. Same block geometry and
+    # latency handling, so fresh plugin instances must agree closely (not
+    # exactly -- plugins may carry nondeterministic internals).
+    rng = np.random.default_rng(7)
+    fast_p = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    src = rng.standard_normal(
+        (max(fast_p.num_input_channels, 1), 4800)
+    ).astype(np.float32)
+    fast = minihost.process_audio(fast_p, src, block_size=64)
+    slow_p = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    slow = minihost.process_audio(
+        slow_p, src, block_size=64, progress_callback=lambda done, total: None
+    )
+    assert fast.channels == slow.channels
+    assert fast.frames == slow.frames
+    assert np.allclose(np.asarray(fast), np.asarray(slow), atol=1e-4)
+
+
 @skip_if_no_plugin
 def test_process_audio_accepts_numpy_input():
     plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
@@ -122,3 +143,66 @@ def test_process_audio_to_file_duplicates_mono_to_required_channels(tmp_path):
     )
     info = minihost.get_audio_info(str(out_path))
     assert info["channels"] == plugin.num_output_channels
+
+
+@skip_if_no_plugin
+def test_autotune_block_size_picks_candidate_and_caches(tmp_path, monkeypatch):
+    monkeypatch.setenv("MINIHOST_CACHE_DIR", str(tmp_path / "cache"))
+    from minihost import plugincache
+
+    plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=4096)
+    src = minihost.AudioBuffer(max(plugin.num_input_channels, 1), 9600)
+    candidates = (512, 1024)
+    chosen = minihost.autotune_block_size(
+        plugin, src, candidates=candidates, probe_seconds=0.1
+    )
+    assert chosen in candidates
+    assert plugincache.tuned_block_size(PLUGIN) == chosen
+
+    # The recording short-circuits later probes (different candidates
+    # would otherwise win).
+    assert minihost.autotune_block_size(plugin, src, candidates=(256,)) == chosen
+
+    # And block_size="auto" renders end to end using it.
+    out = minihost.process_audio(
+        plugin, src, block_size="auto", compensate_latency=False
+    )
+    assert out.channels == plugin.num_output_channels
+    assert out.frames == src.frames
+
+
+@skip_if_no_plugin
+def test_prepared_render_matches_process_audio():
+    rng = np.random.default_rng(11)
+    plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    src = rng.standard_normal(
+        (max(plugin.num_input_channels, 1), 4800)
+    ).astype(np.float32)
+    ref = minihost.process_audio(
+        plugin, src, block_size=512, compensate_latency=False
+    )
+
+    pr = minihost.PreparedRender(
+        plugin, src, block_size=512, compensate_latency=False
+    )
+    assert pr.block_size == 512
+    assert pr.out_frames == 4800
+    first = pr.run()
+    again = pr.run()
+    assert np.allclose(np.asarray(first), np.asarray(ref), atol=1e-4)
+    # reset=True between runs makes repeated runs reproducible.
+    assert np.allclose(np.asarray(again), np.asarray(first), atol=1e-4)
+
+
+@skip_if_no_plugin
+def test_prepared_render_applies_per_run_params():
+    plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    if plugin.num_params == 0:
+        pytest.skip("plugin exposes no parameters")
+    src = minihost.AudioBuffer(max(plugin.num_input_channels, 1), 4800)
+    pr = minihost.PreparedRender(
+        plugin, src, block_size=512, compensate_latency=False
+    )
+    out = pr.run(params={0: 0.25})
+    assert out.frames == 4800
+    assert abs(plugin.get_param(0) - 0.25) < 0.01
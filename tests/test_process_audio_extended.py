@@ -296,3 +296,64 @@ def test_process_audio_to_file_requires_output_path():
             input_path="x.wav",
             output_path="",
         )
+
+
+# ---------------------------------------------------------------------------
+# process_audio_multibus
+# ---------------------------------------------------------------------------
+
+
+def test_process_audio_multibus_rejects_non_plugin():
+    # Plugin-less check: the isinstance guard fires before any bus work.
+    with pytest.raises(TypeError, match="requires a Plugin"):
+        minihost.process_audio_multibus(None)  # type: ignore[arg-type]
+
+
+@skip_if_no_plugin
+def test_process_audio_multibus_matches_main_render(tmp_path):
+    """Bus 0 of a one-pass multibus render equals the plain render."""
+    plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    events = [(0, 0x90, 60, 100), (4799, 0x80, 60, 0)]
+
+    results = minihost.process_audio_multibus(
+        plugin, midi=events, tail_seconds=0.1, compensate_latency=False
+    )
+    assert len(results) == plugin.num_output_buses
+    main = results[0]
+    assert main is not None
+    assert main.channels == plugin.get_bus_info(False, 0)["num_channels"]
+    assert main.frames == 4800 + int(0.1 * 48000)
+
+    plugin.reset()
+    reference = minihost.process_audio(
+        plugin, midi=events, tail_seconds=0.1, compensate_latency=False
+    )
+    np = pytest.importorskip("numpy")
+    np.testing.assert_allclose(
+        np.asarray(main),
+        np.asarray(reference)[: main.channels],
+        atol=1e-6,
+    )
+
+
+@skip_if_no_plugin
+def test_process_audio_multibus_writes_per_bus_files(tmp_path):
+    plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    events = [(0, 0x90, 60, 100), (4799, 0x80, 60, 0)]
+    paths = [None] * plugin.num_output_buses
+    paths[0] = str(tmp_path / "bus0.wav")
+    minihost.process_audio_multibus(
+        plugin, midi=events, tail_seconds=0.1, output_paths=paths
+    )
+    assert (tmp_path / "bus0.wav").exists()
+
+
+@skip_if_no_plugin
+def test_process_audio_multibus_output_paths_length_checked():
+    plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    with pytest.raises(ValueError, match="one entry per output bus"):
+        minihost.process_audio_multibus(
+            plugin,
+            midi=[(0, 0x90, 60, 100)],
+            output_paths=["too.wav"] * (plugin.num_output_buses + 1),
+        )
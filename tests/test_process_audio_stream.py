@@ -9,6 +9,7 @@ several routing paths (plain effect, MIDI, sidechain, synth mode).
 from __future__ import annotations
 
 import os
+import threading
 
 import numpy as np
 import pytest
@@ -229,6 +230,69 @@ def test_stream_rejects_sidechain_for_chain():
     chain.close()
 
 
+# ---------------------------------------------------------------------------
+# Prefetch mode
+# ---------------------------------------------------------------------------
+
+
+@skip_if_no_fx
+def test_stream_prefetch_concat_matches_synchronous():
+    """prefetch=N changes scheduling, not output: the streamed blocks
+    concatenate to exactly the synchronous stream's result."""
+    p_pre = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+    src = minihost.AudioBuffer(p_pre.num_input_channels, 4096)
+    for ch in range(src.channels):
+        src[ch, 0] = 0.25
+        src[ch, 2048] = -0.25
+    prefetched = _concat(
+        list(
+            minihost.process_audio_stream(
+                p_pre, src, compensate_latency=False, prefetch=4
+            )
+        )
+    )
+    p_pre.close()
+
+    p_ref = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=512)
+    src2 = minihost.AudioBuffer(p_ref.num_input_channels, 4096)
+    for ch in range(src2.channels):
+        src2[ch, 0] = 0.25
+        src2[ch, 2048] = -0.25
+    sync = _concat(
+        list(minihost.process_audio_stream(p_ref, src2, compensate_latency=False))
+    )
+    p_ref.close()
+
+    assert prefetched.shape == sync.shape
+    assert np.allclose(prefetched, sync, atol=1e-6)
+
+
+@skip_if_no_fx
+def test_stream_prefetch_negative_raises():
+    plugin = minihost.Plugin(FX_PLUGIN, sample_rate=48000)
+    src = minihost.AudioBuffer(plugin.num_input_channels, 512)
+    with pytest.raises(ValueError, match="prefetch"):
+        list(minihost.process_audio_stream(plugin, src, prefetch=-1))
+    plugin.close()
+
+
+@skip_if_no_fx
+def test_stream_prefetch_abandoned_generator_stops_worker():
+    """Breaking out of a prefetched stream must stop the render worker
+    before control returns, so the plugin can be closed safely."""
+    plugin = minihost.Plugin(FX_PLUGIN, sample_rate=48000, max_block_size=256)
+    src = minihost.AudioBuffer(plugin.num_input_channels, 8192)
+    gen = minihost.process_audio_stream(
+        plugin, src, block_size=256, compensate_latency=False, prefetch=2
+    )
+    first = next(gen)
+    assert first.frames > 0
+    gen.close()
+    # The worker joined during close(); no render is in flight now.
+    assert not any(t.name == "minihost-prefetch" for t in threading.enumerate())
+    plugin.close()
+
+
 # ---------------------------------------------------------------------------
 # Lazy / generator behavior
 # ---------------------------------------------------------------------------
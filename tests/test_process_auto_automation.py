@@ -115,3 +115,90 @@ class TestProcessAutoMultiChange:
             [(0, idx, 0.0), (128, idx, 0.0), (300, idx, 1.0)],
         )
         self._assert_last_change_wins(plugin, idx, lo, hi)
+
+
+class TestChainAutomationTimeline:
+    """Precompiled chain timeline (set_automation_timeline): changes use
+    absolute offsets and must land on the block that covers them, via the
+    per-plugin lanes rather than the per-call flat array."""
+
+    BLOCK = 512
+
+    def _chain(self, plugin):
+        return minihost.PluginChain([plugin])
+
+    def _process_blocks(self, chain, nblocks):
+        in_ch = chain.num_input_channels
+        out_ch = chain.num_output_channels
+        inp = np.zeros((in_ch, self.BLOCK), dtype=np.float32)
+        out = np.zeros((out_ch, self.BLOCK), dtype=np.float32)
+        for _ in range(nblocks):
+            chain.process(inp, out)
+
+    def test_change_in_second_block_lands(self, plugin):
+        """A change addressed past the first block must apply when the
+        covering block is processed, not before."""
+        found = _find_varying_param(plugin)
+        if found is None:
+            pytest.skip("no parameter with distinguishable 0.0/1.0 read-back")
+        idx, lo, hi = found
+        plugin.reset()
+        plugin.set_param(idx, 0.0)
+        chain = self._chain(plugin)
+        chain.set_automation_timeline([(self.BLOCK + 100, 0, idx, 1.0)])
+
+        self._process_blocks(chain, 1)
+        got = plugin.get_param(idx)
+        assert abs(got - lo) < abs(got - hi), (
+            f"param {idx} read back {got:.4f} after one block; the change "
+            f"at offset {self.BLOCK + 100} fired early"
+        )
+
+        self._process_blocks(chain, 1)
+        got = plugin.get_param(idx)
+        assert abs(got - hi) < abs(got - lo), (
+            f"param {idx} read back {got:.4f} after two blocks; the "
+            f"timeline change was not applied"
+        )
+
+    def test_seek_skips_earlier_changes(self, plugin):
+        """After seeking past a change it must not replay."""
+        found = _find_varying_param(plugin)
+        if found is None:
+            pytest.skip("no parameter with distinguishable 0.0/1.0 read-back")
+        idx, lo, hi = found
+        plugin.reset()
+        plugin.set_param(idx, 0.0)
+        chain = self._chain(plugin)
+        chain.set_automation_timeline([(100, 0, idx, 1.0)])
+        chain.seek_automation(self.BLOCK)
+
+        self._process_blocks(chain, 1)
+        got = plugin.get_param(idx)
+        assert abs(got - lo) < abs(got - hi), (
+            f"param {idx} read back {got:.4f}; the change behind the "
+            f"seek position replayed"
+        )
+
+    def test_bad_plugin_index_rejected(self, plugin):
+        chain = self._chain(plugin)
+        with pytest.raises(RuntimeError):
+            chain.set_automation_timeline([(0, 5, 0, 1.0)])
+
+    def test_clear_with_empty_list(self, plugin):
+        found = _find_varying_param(plugin)
+        if found is None:
+            pytest.skip("no parameter with distinguishable 0.0/1.0 read-back")
+        idx, lo, hi = found
+        plugin.reset()
+        plugin.set_param(idx, 0.0)
+        chain = self._chain(plugin)
+        chain.set_automation_timeline([(100, 0, idx, 1.0)])
+        chain.set_automation_timeline([])
+
+        self._process_blocks(chain, 1)
+        got = plugin.get_param(idx)
+        assert abs(got - lo) < abs(got - hi), (
+            f"param {idx} read back {got:.4f}; a cleared timeline still "
+            f"applied its change"
+        )
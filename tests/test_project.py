@@ -348,6 +348,50 @@ def test_layout_drops_unknown_ids(tmp_path):
     assert loaded.layout == {"in": (10.0, 20.0)}
 
 
+def test_save_moves_large_plugin_state_to_sidecar(tmp_path):
+    """A plugin state beyond the inline threshold must be written as a
+    zlib sidecar (keeping the JSON small) and decompress back exactly;
+    a tiny state stays inline as state_b64."""
+    import base64
+    import zlib
+
+    from minihost import project as project_mod
+
+    proj = tmp_path / "proj.json"
+    big_state = bytes(range(256)) * 1024  # 256 KiB, compressible
+    minihost.save_project(
+        proj,
+        sample_rate=48000,
+        block_size=256,
+        duration_seconds=1.0,
+        input_nodes=[],
+        plugin_nodes=[
+            {
+                "id": "fx",
+                "path": "A.vst3",
+                "state_b64": base64.b64encode(big_state).decode(),
+            },
+            {"id": "tiny", "path": "B.vst3", "state_b64": base64.b64encode(b"x").decode()},
+        ],
+        output_nodes=[{"id": "out", "channels": 2, "sink": "o.wav"}],
+        edges=[],
+    )
+
+    doc = json.loads(proj.read_text())
+    plugin_nodes = {n["id"]: n for n in doc["nodes"] if n["kind"] == "plugin"}
+    assert "state_b64" not in plugin_nodes["fx"]
+    assert plugin_nodes["fx"]["state_file"] == "proj.states/fx.stz"
+    assert "state_file" not in plugin_nodes["tiny"]
+
+    sidecar = tmp_path / "proj.states" / "fx.stz"
+    assert sidecar.exists()
+    assert sidecar.stat().st_size < len(big_state)  # actually compressed
+    assert zlib.decompress(sidecar.read_bytes()) == big_state
+    assert project_mod._read_state_sidecar(sidecar) == big_state
+    # The topology document itself stays tiny.
+    assert proj.stat().st_size < 2048
+
+
 def test_save_load_round_trip(tmp_path):
     in_wav = tmp_path / "in.wav"
     _write_input_wav(in_wav, frames=2048)
@@ -0,0 +1,269 @@
+"""Tests for the binary project container (`minihost.project_binary`).
+
+Two families:
+
+1. Container format: round-trip through save_project_binary /
+   load_project_binary, magic sniffing via load_project, topology
+   inspection without state decode, truncation / corruption errors.
+
+2. Laziness: a corrupt or huge state section must not affect
+   read_topology, which only touches the topology section.
+"""
+
+from __future__ import annotations
+
+import base64
+import json
+import struct
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+import minihost
+from minihost import audio_io, project_binary
+
+
+def _write_input_wav(path: Path, *, frames: int = 4096, sr: int = 48000) -> None:
+    rng = np.random.default_rng(0)
+    data = (rng.standard_normal((2, frames)) * 0.1).astype(np.float32)
+    audio_io.write_audio(str(path), data, sr, bit_depth=24)
+
+
+def _identity_binary_project(tmp_path: Path) -> tuple[Path, Path, Path]:
+    """A no-plugin binary project: in.wav -> out.wav."""
+    in_wav = tmp_path / "in.wav"
+    out_wav = tmp_path / "out.wav"
+    proj = tmp_path / "project.mhp"
+    _write_input_wav(in_wav)
+    minihost.save_project_binary(
+        proj,
+        sample_rate=48000,
+        block_size=256,
+        input_nodes=[{"id": "in", "channels": 2, "source": str(in_wav)}],
+        output_nodes=[
+            {"id": "out", "channels": 2, "sink": str(out_wav), "bit_depth": 24}
+        ],
+        plugin_nodes=[],
+        edges=[{"src": "in", "dst": "out"}],
+    )
+    return proj, in_wav, out_wav
+
+
+def test_magic_sniffing(tmp_path):
+    proj, _, _ = _identity_binary_project(tmp_path)
+    assert minihost.is_binary_project(proj)
+    json_proj = tmp_path / "p.json"
+    json_proj.write_text("{}")
+    assert not minihost.is_binary_project(json_proj)
+    assert not minihost.is_binary_project(tmp_path / "missing.mhp")
+
+
+def test_identity_round_trip_and_render(tmp_path):
+    proj, in_wav, out_wav = _identity_binary_project(tmp_path)
+    # load_project sniffs the magic, so the JSON entry point works.
+    loaded = minihost.load_project(proj)
+    assert loaded.sample_rate == 48000
+    assert loaded.block_size == 256
+    assert len(loaded.inputs) == 1 and len(loaded.outputs) == 1
+    minihost.render_project(proj)
+    out, out_sr = audio_io.read_audio(str(out_wav), as_=np.ndarray)
+    ref, _ = audio_io.read_audio(str(in_wav), as_=np.ndarray)
+    assert out_sr == 48000
+    np.testing.assert_allclose(out, ref, atol=1e-4)
+
+
+def test_read_topology_binary(tmp_path):
+    proj, _, _ = _identity_binary_project(tmp_path)
+    doc = minihost.read_topology(proj)
+    assert doc["minihost_project_version"] == 1
+    kinds = {n["id"]: n["kind"] for n in doc["nodes"]}
+    assert kinds == {"in": "input", "out": "output"}
+
+
+def test_read_topology_json(tmp_path):
+    json_proj = tmp_path / "p.json"
+    json_proj.write_text(
+        json.dumps({"minihost_project_version": 1, "nodes": [], "edges": []})
+    )
+    doc = minihost.read_topology(json_proj)
+    assert doc["nodes"] == []
+
+
+def test_state_goes_to_section_not_topology(tmp_path):
+    """Plugin state lives in its own section; the topology JSON stays
+    small and read_topology never touches the blob."""
+    proj = tmp_path / "p.mhp"
+    state = bytes(range(256)) * 1024  # 256 KiB, incompressible-ish
+    minihost.save_project_binary(
+        proj,
+        sample_rate=48000,
+        block_size=256,
+        duration_seconds=0.1,
+        input_nodes=[],
+        output_nodes=[{"id": "out", "channels": 2, "sink": "out.wav"}],
+        plugin_nodes=[
+            {
+                "id": "fx",
+                "path": "/nonexistent/Plug.vst3",
+                "state_b64": base64.b64encode(state).decode("ascii"),
+            }
+        ],
+        edges=[{"src": "fx", "dst": "out"}],
+    )
+    doc = minihost.read_topology(proj)
+    (fx,) = [n for n in doc["nodes"] if n["kind"] == "plugin"]
+    assert fx["state_section"] == "state/fx"
+    assert "state_b64" not in fx
+
+
+def test_read_topology_ignores_corrupt_state_section(tmp_path):
+    """Laziness: trashing the state payload must not affect topology
+    inspection (it is only decompressed at plugin instantiation)."""
+    proj = tmp_path / "p.mhp"
+    minihost.save_project_binary(
+        proj,
+        sample_rate=48000,
+        block_size=256,
+        duration_seconds=0.1,
+        input_nodes=[],
+        output_nodes=[{"id": "out", "channels": 2, "sink": "out.wav"}],
+        plugin_nodes=[
+            {
+                "id": "fx",
+                "path": "/nonexistent/Plug.vst3",
+                "state_b64": base64.b64encode(b"x" * 65536).decode("ascii"),
+            }
+        ],
+        edges=[{"src": "fx", "dst": "out"}],
+    )
+    raw = bytearray(proj.read_bytes())
+    # Corrupt the last byte of the file: state sections are written
+    # after the topology section, so this lands inside the state blob.
+    raw[-1] ^= 0xFF
+    proj.write_bytes(bytes(raw))
+    doc = minihost.read_topology(proj)
+    assert any(n["kind"] == "plugin" for n in doc["nodes"])
+
+
+def test_graph_plan_round_trip(tmp_path):
+    """A compiled-schedule snapshot embedded at save time is staged on
+    the rebuilt graph, and the project still renders identically."""
+    proj, in_wav, out_wav = _identity_binary_project(tmp_path)
+    loaded = minihost.load_project(proj)
+    plan = loaded.graph.export_plan()
+
+    minihost.save_project_binary(
+        proj,
+        sample_rate=48000,
+        block_size=256,
+        input_nodes=[{"id": "in", "channels": 2, "source": str(in_wav)}],
+        output_nodes=[
+            {"id": "out", "channels": 2, "sink": str(out_wav), "bit_depth": 24}
+        ],
+        plugin_nodes=[],
+        edges=[{"src": "in", "dst": "out"}],
+        graph_plan=plan,
+    )
+    minihost.render_project(proj)
+    out, _ = audio_io.read_audio(str(out_wav), as_=np.ndarray)
+    ref, _ = audio_io.read_audio(str(in_wav), as_=np.ndarray)
+    np.testing.assert_allclose(out, ref, atol=1e-4)
+
+
+def test_truncated_file_errors(tmp_path):
+    proj, _, _ = _identity_binary_project(tmp_path)
+    truncated = tmp_path / "trunc.mhp"
+    truncated.write_bytes(proj.read_bytes()[:10])
+    with pytest.raises(minihost.ProjectError):
+        minihost.read_topology(truncated)
+
+
+def test_bad_magic_errors(tmp_path):
+    bogus = tmp_path / "bogus.mhp"
+    bogus.write_bytes(b"NOTAPROJ" + struct.pack("<I", 0))
+    # Sniffed as non-binary, then fails JSON parsing.
+    with pytest.raises(minihost.ProjectError):
+        minihost.load_project(bogus)
+
+
+def test_missing_state_section_errors(tmp_path):
+    """A topology referencing a section absent from the TOC fails."""
+    proj = tmp_path / "p.mhp"
+    doc = {
+        "minihost_project_version": 1,
+        "sample_rate": 48000,
+        "block_size": 256,
+        "duration_seconds": 0.1,
+        "nodes": [
+            {
+                "id": "fx",
+                "kind": "plugin",
+                "path": "/nonexistent/Plug.vst3",
+                "state_section": "state/ghost",
+            },
+            {"id": "out", "kind": "output", "channels": 2, "sink": "out.wav"},
+        ],
+        "edges": [{"src": "fx", "dst": "out"}],
+    }
+    topology = json.dumps(doc).encode()
+    name = b"topology"
+    toc = struct.pack("<H", len(name)) + name
+    header_len = len(project_binary.MAGIC) + 4 + len(toc) + 16
+    blob = (
+        project_binary.MAGIC
+        + struct.pack("<I", 1)
+        + toc
+        + struct.pack("<QQ", header_len, len(topology))
+        + topology
+    )
+    proj.write_bytes(blob)
+    with pytest.raises(minihost.ProjectError, match="state section"):
+        minihost.load_project(proj)
+
+
+def test_automation_goes_to_section_not_topology(tmp_path):
+    """Plugin automation keyframes land in the packed automation
+    section, not the topology JSON, and unpack back to the schema's
+    keyframe shape."""
+    proj = tmp_path / "p.mhp"
+    keyframes = [[0, 3, 0.25], [48000, 3, 0.75], [96000, 1, 1.0]]
+    minihost.save_project_binary(
+        proj,
+        sample_rate=48000,
+        block_size=256,
+        duration_seconds=0.1,
+        input_nodes=[],
+        output_nodes=[{"id": "out", "channels": 2, "sink": "out.wav"}],
+        plugin_nodes=[
+            {
+                "id": "fx",
+                "path": "/nonexistent/Plug.vst3",
+                "automation": keyframes,
+            }
+        ],
+        edges=[{"src": "fx", "dst": "out"}],
+    )
+    doc = minihost.read_topology(proj)
+    (fx,) = [n for n in doc["nodes"] if n["kind"] == "plugin"]
+    assert "automation" not in fx
+
+    # The section round-trips through the packed representation.
+    import mmap as _mmap
+
+    with open(proj, "rb") as f:
+        with _mmap.mmap(f.fileno(), 0, access=_mmap.ACCESS_READ) as mm:
+            toc = project_binary._read_toc(mm)
+            assert "automation" in toc
+            off, size = toc["automation"]
+            curves = project_binary._parse_automation_section(
+                bytes(mm[off : off + size])
+            )
+    assert set(curves) == {"fx"}
+    got = [[s, p, pytest.approx(v)] for s, p, v in curves["fx"]]
+    assert got == keyframes
+
+
+def test_truncated_automation_section_errors(tmp_path):
+    with pytest.raises(minihost.ProjectError):
+        project_binary._parse_automation_section(b"\x01\x00\x00\x00\x02")
@@ -8,8 +8,10 @@ from minihost.render import (
     _AUTO_TAIL_THRESHOLD,
     _build_tempo_map,
     _collect_midi_events,
+    _chase_events,
     _event_to_midi_tuple,
     _is_auto_tail,
+    _partition_segments,
     _seconds_to_samples,
     _tick_to_seconds,
 )
@@ -480,3 +482,201 @@ class TestAutoTail:
 
     def test_silent_blocks_is_positive(self):
         assert _AUTO_TAIL_SILENT_BLOCKS >= 1
+
+
+# ---------------------------------------------------------------------------
+# MidiEventTimeline (native counterpart of the helpers above)
+# ---------------------------------------------------------------------------
+
+
+class TestMidiEventTimeline:
+    """MidiFile.sample_events must match the pure-Python pipeline."""
+
+    def _make_arrangement(self):
+        mf = _make_midi(tpq=480)
+        t = mf.add_track()
+        mf.add_tempo(t, 0, 120.0)
+        mf.add_tempo(t, 1920, 60.0)
+        mf.add_note_on(t, 0, 0, 60, 100)
+        mf.add_control_change(t, 240, 1, 7, 90)
+        mf.add_note_off(t, 480, 0, 60, 0)
+        mf.add_program_change(t, 960, 2, 5)
+        mf.add_pitch_bend(t, 1920, 0, 9000)
+        mf.add_note_on(t, 2400, 0, 64, 80)
+        mf.add_note_off(t, 2880, 0, 64, 0)
+        return mf
+
+    def test_matches_python_pipeline(self):
+        mf = self._make_arrangement()
+        tempo_map = _build_tempo_map(mf)
+        expected = []
+        for event in _collect_midi_events(mf):
+            seconds = _tick_to_seconds(event["tick"], tempo_map, 480)
+            tup = _event_to_midi_tuple(event, _seconds_to_samples(seconds, 48000.0))
+            if tup is not None:
+                expected.append(tup)
+        expected.sort(key=lambda e: e[0])
+
+        timeline = mf.sample_events(48000.0)
+        assert timeline.to_list() == expected
+        assert len(timeline) == len(expected)
+        assert timeline.max_sample == expected[-1][0]
+
+    def test_slice_bounds(self):
+        mf = self._make_arrangement()
+        timeline = mf.sample_events(48000.0)
+        all_events = timeline.to_list()
+        mid = all_events[3][0]
+        head = timeline.slice(0, mid)
+        tail = timeline.slice(mid, timeline.max_sample + 1)
+        assert head + tail == all_events
+        assert timeline.slice(timeline.max_sample + 1, 10**9) == []
+
+    def test_tempo_cache_invalidated_by_mutation(self):
+        """Adding a tempo event after sample_events must be reflected in
+        the next timeline (the cached tempo map is rebuilt)."""
+        mf = _make_midi(tpq=480)
+        t = mf.add_track()
+        mf.add_tempo(t, 0, 120.0)
+        mf.add_note_on(t, 480, 0, 60, 100)
+        before = mf.sample_events(48000.0)
+        assert before.max_sample == 24000  # one beat at 120 BPM
+
+        mf.add_tempo(t, 0, 60.0)
+        after = mf.sample_events(48000.0)
+        assert after.max_sample == 48000  # one beat at 60 BPM
+
+    def test_empty_file(self):
+        mf = _make_midi()
+        mf.add_track()
+        timeline = mf.sample_events(48000.0)
+        assert len(timeline) == 0
+        assert timeline.max_sample == 0
+        assert timeline.max_seconds == 0.0
+        assert timeline.to_list() == []
+
+    def test_block_index_preserves_slice_results(self):
+        """slice() answers are identical with and without the bucket
+        index; the index only changes how lower_bound is found."""
+        mf = self._make_arrangement()
+        timeline = mf.sample_events(48000.0)
+        assert timeline.indexed_block_size == 0
+        # Cover every block window (plus unaligned starts) at two
+        # block sizes, against an unindexed reference timeline.
+        reference = mf.sample_events(48000.0)
+        for block_size in (64, 512):
+            timeline.build_block_index(block_size)
+            assert timeline.indexed_block_size == block_size
+            for start in range(0, timeline.max_sample + block_size, block_size):
+                assert timeline.slice(start, start + block_size) == reference.slice(
+                    start, start + block_size
+                )
+            # Unaligned start inside an indexed bucket.
+            assert timeline.slice(33, 9_000_000) == reference.slice(33, 9_000_000)
+        # Past the indexed range.
+        assert timeline.slice(timeline.max_sample + 1, 10**9) == []
+
+    def test_block_index_validates_block_size(self):
+        mf = self._make_arrangement()
+        timeline = mf.sample_events(48000.0)
+        with pytest.raises(ValueError):
+            timeline.build_block_index(0)
+
+    def test_block_index_on_empty_timeline(self):
+        mf = _make_midi()
+        mf.add_track()
+        timeline = mf.sample_events(48000.0)
+        timeline.build_block_index(64)
+        assert timeline.slice(0, 64) == []
+
+
+# ---------------------------------------------------------------------------
+# _partition_segments (render_midi_parallel)
+# ---------------------------------------------------------------------------
+
+
+class TestPartitionSegments:
+    """Tests for the parallel renderer's timeline partitioning."""
+
+    def test_covers_timeline_exactly_once(self):
+        segs = _partition_segments(100_000, 4, 2_000)
+        assert segs[0][0] == 0
+        assert segs[-1][1] == 100_000
+        for (_, a_end), (b_start, _) in zip(segs, segs[1:]):
+            assert a_end == b_start
+
+    def test_worker_count_reduced_for_short_timelines(self):
+        # 10k samples with 4k overlap: segments must be >= 8k, so at
+        # most one segment fits.
+        segs = _partition_segments(10_000, 8, 4_000)
+        assert segs == [(0, 10_000)]
+
+    def test_every_segment_fits_preroll_and_crossfade(self):
+        overlap = 3_000
+        segs = _partition_segments(1_000_000, 16, overlap)
+        assert len(segs) > 1
+        for start, end in segs:
+            assert end - start >= 2 * overlap
+
+    def test_single_worker_is_one_segment(self):
+        assert _partition_segments(50_000, 1, 1_000) == [(0, 50_000)]
+
+    def test_empty_timeline(self):
+        assert _partition_segments(0, 4, 1_000) == [(0, 0)]
+
+
+# ---------------------------------------------------------------------------
+# _chase_events (seek support for ranged/preview renders)
+# ---------------------------------------------------------------------------
+
+
+class TestChaseEvents:
+    """Tests for the locate-chase used by ranged renders."""
+
+    def test_empty_before_start(self):
+        events = [(1000, 0x90, 60, 100)]
+        assert _chase_events(events, 500) == []
+
+    def test_held_note_survives(self):
+        # Note-on before the seek point with no matching note-off.
+        events = [(100, 0x90, 60, 100), (200, 0x90, 64, 90), (300, 0x80, 64, 0)]
+        chase = _chase_events(events, 1000)
+        assert chase == [(0, 0x90, 60, 100)]
+
+    def test_note_on_velocity_zero_releases(self):
+        # Running-status style note-off (note-on with velocity 0).
+        events = [(100, 0x90, 60, 100), (200, 0x90, 60, 0)]
+        assert _chase_events(events, 1000) == []
+
+    def test_last_controller_value_wins(self):
+        events = [(100, 0xB0, 7, 40), (500, 0xB0, 7, 90)]
+        assert _chase_events(events, 1000) == [(0, 0xB0, 7, 90)]
+
+    def test_events_at_or_past_start_ignored(self):
+        events = [(100, 0xB0, 7, 40), (1000, 0xB0, 7, 90)]
+        # The event at exactly start_sample belongs to the range itself.
+        assert _chase_events(events, 1000) == [(0, 0xB0, 7, 40)]
+
+    def test_program_and_bend_chased_before_notes(self):
+        events = [
+            (100, 0x90, 60, 100),
+            (200, 0xC0, 5, 0),
+            (300, 0xE0, 0x00, 0x50),
+        ]
+        chase = _chase_events(events, 1000)
+        assert chase == [
+            (0, 0xC0, 5, 0),
+            (0, 0xE0, 0x00, 0x50),
+            (0, 0x90, 60, 100),
+        ]
+
+    def test_per_channel_state_is_independent(self):
+        events = [
+            (100, 0xB0 | 0, 1, 10),
+            (200, 0xB0 | 3, 1, 20),
+            (300, 0x90 | 3, 48, 80),
+        ]
+        chase = _chase_events(events, 1000)
+        assert (0, 0xB0 | 0, 1, 10) in chase
+        assert (0, 0xB0 | 3, 1, 20) in chase
+        assert (0, 0x90 | 3, 48, 80) in chase
@@ -1,12 +1,18 @@
 """Regression tests: hot audio paths must not allocate after warm-up.
 
-We don't run a malloc interceptor here (that needs a custom allocator hook).
-What we can do cheaply is exercise the paths that previously allocated per
-call -- mh_process_double and mh_chain_process_auto -- and verify that they
-remain stable and correct over many iterations and varying input sizes.
-A pre-fix path that allocates per call would still pass these tests, but
-they catch the more common follow-on bugs (stale buffer state, off-by-one
-in the persistent-vector reuse pattern).
+Two layers of coverage:
+
+1. Behavioral: exercise the paths that previously allocated per call --
+   mh_process_double and mh_chain_process_auto -- and verify that they
+   remain stable and correct over many iterations and varying input
+   sizes. Catches the common follow-on bugs of the persistent-vector
+   reuse pattern (stale buffer state, off-by-ones).
+
+2. Audit mode: with MINIHOST_RT_AUDIT=1 in the environment, the native
+   library interposes operator new and traps any allocation made inside
+   the audio entry points, queryable via rt_audit_report(). The
+   audit-mode tests run only when that variable was set before the
+   interpreter started (the flag is latched at library load).
 """
 
 from __future__ import annotations
@@ -96,3 +102,43 @@ def test_chain_process_auto_with_midi_events():
     for _ in range(30):
         chain.process_auto(inp, out, midi, changes)
         assert np.isfinite(out).all()
+
+
+# --------------------------------------------------------------------- #
+# RT-safety audit mode (MINIHOST_RT_AUDIT=1)                             #
+# --------------------------------------------------------------------- #
+
+skip_if_no_audit = pytest.mark.skipif(
+    not minihost.rt_audit_enabled(),
+    reason="audit mode off (set MINIHOST_RT_AUDIT=1 before starting pytest)",
+)
+
+
+def test_rt_audit_api_inert_when_disabled():
+    # Without the env var the API exists but records nothing; report is
+    # still well-formed.
+    if minihost.rt_audit_enabled():
+        pytest.skip("audit mode is on in this run")
+    count, text = minihost.rt_audit_report()
+    assert count == 0
+    assert "rt-audit" in text
+    minihost.rt_audit_reset()  # no-op, must not raise
+
+
+@skip_if_no_audit
+@skip_if_no_plugin
+def test_rt_audit_process_after_warmup_is_clean():
+    plugin = minihost.Plugin(PLUGIN, sample_rate=48000, max_block_size=512)
+    inp = np.zeros((plugin.num_input_channels, 256), dtype=np.float32)
+    out = np.zeros((plugin.num_output_channels, 256), dtype=np.float32)
+
+    # Warm-up blocks: plugins may lazily allocate on their first calls.
+    for _ in range(10):
+        plugin.process(inp, out)
+
+    minihost.rt_audit_reset()
+    for _ in range(100):
+        plugin.process(inp, out)
+
+    count, text = minihost.rt_audit_report()
+    assert count == 0, f"audio path allocated after warm-up:\n{text}"
@@ -6,9 +6,11 @@ import pytest
 
 from minihost.vstpreset import (
     VstPreset,
+    index_vstpreset_dir,
     load_vstpreset,
     read_class_id_from_bundle,
     read_vstpreset,
+    read_vstpreset_info,
     save_vstpreset,
     write_vstpreset,
 )
@@ -164,6 +166,125 @@ class TestReadVstPreset:
             read_vstpreset(path)
 
 
+class TestReadVstPresetInfo:
+    """Tests for the metadata-only (lazy) preset reader."""
+
+    def test_matches_full_read(self, tmp_path):
+        comp = b"component_bytes"
+        cont = b"cont"
+        data = _build_vstpreset(component_state=comp, controller_state=cont)
+        path = tmp_path / "test.vstpreset"
+        path.write_bytes(data)
+
+        info = read_vstpreset_info(path)
+
+        assert info.path == str(path)
+        assert info.class_id == "A" * 32
+        assert info.file_size == len(data)
+        assert info.component_size == len(comp)
+        assert info.controller_size == len(cont)
+
+    def test_absent_controller_is_none(self, tmp_path):
+        data = _build_vstpreset(component_state=b"xyz")
+        path = tmp_path / "test.vstpreset"
+        path.write_bytes(data)
+
+        info = read_vstpreset_info(path)
+        assert info.component_size == 3
+        assert info.controller_size is None
+
+    def test_empty_component_state(self, tmp_path):
+        data = _build_vstpreset(component_state=b"")
+        path = tmp_path / "test.vstpreset"
+        path.write_bytes(data)
+
+        # A present but empty chunk reports size 0, not None.
+        info = read_vstpreset_info(path)
+        assert info.component_size == 0
+
+    def test_file_not_found(self):
+        with pytest.raises(FileNotFoundError):
+            read_vstpreset_info("/nonexistent/path/preset.vstpreset")
+
+    def test_invalid_magic(self, tmp_path):
+        path = tmp_path / "bad.vstpreset"
+        path.write_bytes(b"NOPE" + b"\x00" * 100)
+
+        with pytest.raises(ValueError, match="Invalid .vstpreset magic"):
+            read_vstpreset_info(path)
+
+
+class TestIndexVstPresetDir:
+    """Tests for the bulk directory indexer."""
+
+    def test_indexes_and_sorts(self, tmp_path):
+        (tmp_path / "b.vstpreset").write_bytes(
+            _build_vstpreset(class_id="B" * 32, component_state=b"bb")
+        )
+        (tmp_path / "a.vstpreset").write_bytes(
+            _build_vstpreset(class_id="C" * 32, component_state=b"ccc", controller_state=b"d")
+        )
+
+        infos = index_vstpreset_dir(tmp_path)
+
+        assert [i.path for i in infos] == [
+            str(tmp_path / "a.vstpreset"),
+            str(tmp_path / "b.vstpreset"),
+        ]
+        assert infos[0].class_id == "C" * 32
+        assert infos[0].component_size == 3
+        assert infos[0].controller_size == 1
+        assert infos[1].class_id == "B" * 32
+        assert infos[1].component_size == 2
+        assert infos[1].controller_size is None
+
+    def test_suffix_match_is_case_insensitive(self, tmp_path):
+        (tmp_path / "loud.VSTPRESET").write_bytes(
+            _build_vstpreset(component_state=b"x")
+        )
+        infos = index_vstpreset_dir(tmp_path)
+        assert len(infos) == 1
+        assert infos[0].path.endswith("loud.VSTPRESET")
+
+    def test_skips_non_presets_and_malformed_files(self, tmp_path):
+        (tmp_path / "good.vstpreset").write_bytes(
+            _build_vstpreset(component_state=b"ok")
+        )
+        (tmp_path / "notes.txt").write_text("not a preset")
+        (tmp_path / "corrupt.vstpreset").write_bytes(b"garbage" * 20)
+
+        infos = index_vstpreset_dir(tmp_path)
+        assert [i.path for i in infos] == [str(tmp_path / "good.vstpreset")]
+
+    def test_empty_directory(self, tmp_path):
+        assert index_vstpreset_dir(tmp_path) == []
+
+    def test_missing_directory_raises(self, tmp_path):
+        with pytest.raises(FileNotFoundError):
+            index_vstpreset_dir(tmp_path / "nope")
+
+    def test_not_recursive(self, tmp_path):
+        sub = tmp_path / "sub"
+        sub.mkdir()
+        (sub / "nested.vstpreset").write_bytes(
+            _build_vstpreset(component_state=b"x")
+        )
+        assert index_vstpreset_dir(tmp_path) == []
+
+    def test_many_files_exercise_readahead_batching(self, tmp_path):
+        # More files than one readahead batch (64), so both phases of the
+        # pipeline run more than once.
+        for i in range(70):
+            (tmp_path / f"p{i:03d}.vstpreset").write_bytes(
+                _build_vstpreset(component_state=bytes([i]))
+            )
+        infos = index_vstpreset_dir(tmp_path)
+        assert len(infos) == 70
+        assert infos[0].path.endswith("p000.vstpreset")
+        assert infos[-1].path.endswith("p069.vstpreset")
+        assert all(i.component_size == 1 for i in infos)
+
+
 class TestLoadVstPreset:
     def test_applies_state_to_plugin(self, tmp_path):
         from unittest.mock import MagicMock
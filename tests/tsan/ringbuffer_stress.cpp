@@ -142,6 +142,118 @@ long stress_midi_pop_all(long N) {
     return fails;
 }
 
+// --- MIDI ring buffer via the timestamped API: same delivery guarantee,
+// and additionally checks each event's receipt stamp survives intact
+// (a torn double would corrupt the sample-offset conversion downstream).
+long stress_midi_timed(long N) {
+    MH_MidiRingBuffer* rb = mh_midi_ringbuffer_create(1024);
+    if (!rb) {
+        std::fprintf(stderr, "FAIL: midi ringbuffer create (timed)\n");
+        return 1;
+    }
+    long fails = 0;
+
+    std::thread producer([&] {
+        for (long i = 0; i < N; ++i) {
+            MH_MidiEvent e = encode_midi(i);
+            while (!mh_midi_ringbuffer_push_timed(rb, &e,
+                                                  static_cast<double>(i) * 1e-6)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([&] {
+        long expect = 0;
+        MH_MidiTimedEvent batch[64];
+        while (expect < N) {
+            int n = mh_midi_ringbuffer_pop_all_timed(rb, batch, 64);
+            for (int k = 0; k < n; ++k) {
+                if (!midi_matches(batch[k].event, expect)
+                    || batch[k].time_sec != static_cast<double>(expect) * 1e-6) {
+                    ++fails;
+                }
+                ++expect;
+            }
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    mh_midi_ringbuffer_free(rb);
+    return fails;
+}
+
+// --- MIDI ring buffer via the bulk producer APIs: the producer
+// alternates push_n_timed with reserve/commit in-place writes; the
+// consumer drains with pop_all_timed. Same exactly-once in-order
+// guarantee, with whole runs published under one release store.
+long stress_midi_bulk(long N) {
+    MH_MidiRingBuffer* rb = mh_midi_ringbuffer_create(1024);
+    if (!rb) {
+        std::fprintf(stderr, "FAIL: midi ringbuffer create (bulk)\n");
+        return 1;
+    }
+    long fails = 0;
+
+    std::thread producer([&] {
+        long i = 0;
+        bool use_reserve = false;
+        while (i < N) {
+            int want = static_cast<int>(N - i < 48 ? N - i : 48);
+            if (use_reserve) {
+                MH_MidiTimedEvent* seg1; int n1;
+                MH_MidiTimedEvent* seg2; int n2;
+                int got = mh_midi_ringbuffer_reserve(rb, want,
+                                                     &seg1, &n1, &seg2, &n2);
+                if (got == 0) { std::this_thread::yield(); continue; }
+                for (int k = 0; k < n1; ++k) {
+                    seg1[k].event = encode_midi(i + k);
+                    seg1[k].time_sec = static_cast<double>(i + k) * 1e-6;
+                }
+                for (int k = 0; k < n2; ++k) {
+                    seg2[k].event = encode_midi(i + n1 + k);
+                    seg2[k].time_sec = static_cast<double>(i + n1 + k) * 1e-6;
+                }
+                mh_midi_ringbuffer_commit(rb, got);
+                i += got;
+            } else {
+                MH_MidiTimedEvent batch[48];
+                for (int k = 0; k < want; ++k) {
+                    batch[k].event = encode_midi(i + k);
+                    batch[k].time_sec = static_cast<double>(i + k) * 1e-6;
+                }
+                int got = mh_midi_ringbuffer_push_n_timed(rb, batch, want);
+                if (got == 0) { std::this_thread::yield(); continue; }
+                i += got;
+            }
+            use_reserve = !use_reserve;
+        }
+    });
+
+    std::thread consumer([&] {
+        long expect = 0;
+        MH_MidiTimedEvent batch[64];
+        while (expect < N) {
+            int n = mh_midi_ringbuffer_pop_all_timed(rb, batch, 64);
+            for (int k = 0; k < n; ++k) {
+                if (!midi_matches(batch[k].event, expect)
+                    || batch[k].time_sec != static_cast<double>(expect) * 1e-6) {
+                    ++fails;
+                }
+                ++expect;
+            }
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    mh_midi_ringbuffer_free(rb);
+    return fails;
+}
+
 // --- Audio ring buffer: producer pushes N single-frame writes carrying a
 // strictly increasing value (1..N, same on every channel). Consumer reads in
 // chunks and checks (a) channels agree within a frame (no interleave tearing)
@@ -190,6 +302,110 @@ long stress_audio(long N) {
     return fails;
 }
 
+// --- Audio ring buffer via push_planar(): producer pushes planar
+// chunks (partial accepts advance by offset, exercising the wraparound
+// interleave runs); consumer and checks as in stress_audio.
+long stress_audio_planar(long N) {
+    const int CH = 2;
+    MH_AudioRingBuffer* rb = mh_audio_ringbuffer_create(CH, 2048);
+    if (!rb) {
+        std::fprintf(stderr, "FAIL: audio ringbuffer create (planar)\n");
+        return 1;
+    }
+    long fails = 0;
+
+    std::thread producer([&] {
+        float ch0[48], ch1[48];
+        long i = 1;
+        while (i <= N) {
+            int want = static_cast<int>(N - i + 1 < 48 ? N - i + 1 : 48);
+            for (int f = 0; f < want; ++f) {
+                ch0[f] = static_cast<float>(i + f);
+                ch1[f] = static_cast<float>(i + f);
+            }
+            int sent = 0;
+            while (sent < want) {
+                const float* bufs[CH] = {ch0 + sent, ch1 + sent};
+                int got = mh_audio_ringbuffer_push_planar(rb, bufs, CH, want - sent);
+                if (got == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                sent += got;
+            }
+            i += want;
+        }
+    });
+
+    std::thread consumer([&] {
+        float ch0[64], ch1[64];
+        float* bufs[CH] = {ch0, ch1};
+        long got = 0;
+        double last = 0.0;
+        while (got < N) {
+            int n = mh_audio_ringbuffer_read_into(rb, bufs, 64, CH);
+            for (int f = 0; f < n; ++f) {
+                float v = ch0[f];
+                if (ch1[f] != v) ++fails;
+                if (!(static_cast<double>(v) > last)) ++fails;
+                last = v;
+                ++got;
+            }
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    mh_audio_ringbuffer_free(rb);
+    return fails;
+}
+
+// --- Audio ring buffer via read_interleaved(): same producer as above;
+// the consumer drains raw interleaved chunks (the disk-recorder path)
+// and checks channel agreement and strict frame-value increase.
+long stress_audio_interleaved(long N) {
+    const int CH = 2;
+    MH_AudioRingBuffer* rb = mh_audio_ringbuffer_create(CH, 2048);
+    if (!rb) {
+        std::fprintf(stderr, "FAIL: audio ringbuffer create (interleaved)\n");
+        return 1;
+    }
+    long fails = 0;
+
+    std::thread producer([&] {
+        for (long i = 1; i <= N; ++i) {
+            float frame[CH];
+            for (int c = 0; c < CH; ++c) frame[c] = static_cast<float>(i);
+            while (mh_audio_ringbuffer_push(rb, frame, 1) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([&] {
+        float chunk[64 * CH];
+        long got = 0;
+        double last = 0.0;
+        while (got < N) {
+            int n = mh_audio_ringbuffer_read_interleaved(rb, chunk, 64);
+            for (int f = 0; f < n; ++f) {
+                float v = chunk[f * CH];
+                if (chunk[f * CH + 1] != v) ++fails;            // interleave tear
+                if (!(static_cast<double>(v) > last)) ++fails;  // reorder/dup
+                last = v;
+                ++got;
+            }
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    mh_audio_ringbuffer_free(rb);
+    return fails;
+}
+
 }  // namespace
 
 int main() {
@@ -205,10 +421,26 @@ int main() {
     f = stress_midi_pop_all(N);    fails += f;
     std::printf(" %s\n", f ? "FAIL" : "ok");
 
+    std::printf("  midi (timed)....."); std::fflush(stdout);
+    f = stress_midi_timed(N);      fails += f;
+    std::printf(" %s\n", f ? "FAIL" : "ok");
+
+    std::printf("  midi (bulk)......"); std::fflush(stdout);
+    f = stress_midi_bulk(N);       fails += f;
+    std::printf(" %s\n", f ? "FAIL" : "ok");
+
     std::printf("  audio............"); std::fflush(stdout);
     f = stress_audio(N);           fails += f;
     std::printf(" %s\n", f ? "FAIL" : "ok");
 
+    std::printf("  audio (planar)..."); std::fflush(stdout);
+    f = stress_audio_planar(N);    fails += f;
+    std::printf(" %s\n", f ? "FAIL" : "ok");
+
+    std::printf("  audio (ileaved).."); std::fflush(stdout);
+    f = stress_audio_interleaved(N); fails += f;
+    std::printf(" %s\n", f ? "FAIL" : "ok");
+
     if (fails) {
         std::fprintf(stderr, "\n%ld functional failure(s)\n", fails);
         return 1;